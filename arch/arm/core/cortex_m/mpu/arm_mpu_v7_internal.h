@@ -18,6 +18,53 @@ static void mpu_init(void)
 	/* No specific configuration at init for ARMv7-M MPU. */
 }
 
+#if defined(CONFIG_ARM_MPU_REGION_CACHE)
+/* ARMv7-M MPUs implement at most 16 regions. */
+#define MPU_REGION_CACHE_NUM 16
+
+/* Last values written to the RBAR and RASR of each region, valid for the
+ * regions set in mpu_region_cache_valid. On a context switch the regions
+ * whose configuration does not change, such as the partitions of a memory
+ * domain shared by the two threads, are not written again.
+ */
+static struct {
+	u32_t rbar;
+	u32_t rasr;
+} mpu_region_cache[MPU_REGION_CACHE_NUM];
+static u32_t mpu_region_cache_valid;
+
+/* Returns whether the region is known to hold the given configuration,
+ * and records it as such otherwise.
+ */
+static bool region_cache_hit(const u32_t index, u32_t rbar, u32_t rasr)
+{
+	if (index >= MPU_REGION_CACHE_NUM) {
+		return false;
+	}
+
+	if ((mpu_region_cache_valid & BIT(index)) &&
+	    (mpu_region_cache[index].rbar == rbar) &&
+	    (mpu_region_cache[index].rasr == rasr)) {
+		return true;
+	}
+
+	mpu_region_cache[index].rbar = rbar;
+	mpu_region_cache[index].rasr = rasr;
+	mpu_region_cache_valid |= BIT(index);
+
+	return false;
+}
+#else
+static inline bool region_cache_hit(const u32_t index, u32_t rbar, u32_t rasr)
+{
+	ARG_UNUSED(index);
+	ARG_UNUSED(rbar);
+	ARG_UNUSED(rasr);
+
+	return false;
+}
+#endif /* CONFIG_ARM_MPU_REGION_CACHE */
+
 /* This internal function performs MPU region initialization.
  *
  * Note:
@@ -26,12 +73,19 @@ static void mpu_init(void)
 static void region_init(const u32_t index,
 	const struct arm_mpu_region *region_conf)
 {
+	u32_t rbar = (region_conf->base & MPU_RBAR_ADDR_Msk)
+				| MPU_RBAR_VALID_Msk | index;
+	u32_t rasr = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+
+	if (region_cache_hit(index, rbar, rasr)) {
+		return;
+	}
+
 	/* Select the region you want to access */
 	MPU->RNR = index;
 	/* Configure the region */
-	MPU->RBAR = (region_conf->base & MPU_RBAR_ADDR_Msk)
-				| MPU_RBAR_VALID_Msk | index;
-	MPU->RASR = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+	MPU->RBAR = rbar;
+	MPU->RASR = rasr;
 	LOG_DBG("[%d] 0x%08x 0x%08x",
 		index, region_conf->base, region_conf->attr.rasr);
 }
@@ -252,6 +306,21 @@ static inline int mpu_buffer_validate(void *addr, size_t size, int write)
 static int mpu_configure_region(const u8_t index,
 	const struct k_mem_partition *new_region);
 
+/* This internal function disables an MPU region.
+ *
+ * Note:
+ *   The caller must provide a valid region index.
+ */
+static void region_clear(const u32_t index)
+{
+	/* A disabled region is cached with a zero RASR. */
+	if (region_cache_hit(index, index, 0U)) {
+		return;
+	}
+
+	ARM_MPU_ClrRegion(index);
+}
+
 /* This internal function programs a set of given MPU regions
  * over a background memory area, optionally performing a
  * sanity check of the memory regions to be programmed.
@@ -341,7 +410,7 @@ static int mpu_configure_dynamic_mpu_regions(const struct k_mem_partition
 
 		/* Disable the non-programmed MPU regions. */
 		for (int i = mpu_reg_index; i < get_num_regions(); i++) {
-			ARM_MPU_ClrRegion(i);
+			region_clear(i);
 		}
 	}
 
@@ -24,6 +24,10 @@
 #include <irq.h>
 #include <kernel_structs.h>
 #include <tracing.h>
+#include <misc/printk.h>
+#include <init.h>
+#include <string.h>
+#include <errno.h>
 
 extern void __reserved(void);
 
@@ -177,6 +181,145 @@ void _arch_isr_direct_pm(void)
 }
 #endif
 
+#ifdef CONFIG_ARM_IRQ_STATS
+/* Interrupts nest at most once per priority level */
+#define IRQ_STATS_NESTING_MAX BIT(DT_NUM_IRQ_PRIO_BITS)
+
+static struct arm_irq_stats irq_stats[CONFIG_NUM_IRQS];
+
+/* Timestamps of the interrupts being served, innermost at depth - 1. A
+ * nested interrupt always completes before the one it preempted resumes,
+ * so the stack needs no locking.
+ */
+static u32_t entry_time[IRQ_STATS_NESTING_MAX];
+static u32_t handler_time[IRQ_STATS_NESTING_MAX];
+static unsigned int depth;
+
+static inline unsigned int irq_stats_bucket(u32_t cycles)
+{
+	unsigned int n = 31 - __builtin_clz(cycles | 1);
+
+	return MIN(n, ARM_IRQ_STATS_BUCKETS - 1);
+}
+
+static inline void irq_stats_hist_add(u16_t *hist, u32_t cycles)
+{
+	unsigned int n = irq_stats_bucket(cycles);
+
+	if (hist[n] != UINT16_MAX) {
+		hist[n]++;
+	}
+}
+
+void z_arm_irq_stats_enter(void)
+{
+	u32_t now = DWT->CYCCNT;
+
+	if (depth < IRQ_STATS_NESTING_MAX) {
+		entry_time[depth] = now;
+	}
+	depth++;
+}
+
+void z_arm_irq_stats_handler(void)
+{
+	unsigned int level = depth - 1;
+	struct arm_irq_stats *stats = &irq_stats[__get_IPSR() - 16];
+	u32_t latency;
+
+	if (level >= IRQ_STATS_NESTING_MAX) {
+		return;
+	}
+
+	handler_time[level] = DWT->CYCCNT;
+	latency = handler_time[level] - entry_time[level];
+
+	stats->latency_max = MAX(stats->latency_max, latency);
+	irq_stats_hist_add(stats->latency_hist, latency);
+}
+
+void z_arm_irq_stats_exit(void)
+{
+	unsigned int level = --depth;
+	struct arm_irq_stats *stats = &irq_stats[__get_IPSR() - 16];
+	u32_t duration;
+
+	if (level >= IRQ_STATS_NESTING_MAX) {
+		return;
+	}
+
+	duration = DWT->CYCCNT - handler_time[level];
+
+	stats->count++;
+	stats->duration_total += duration;
+	stats->duration_max = MAX(stats->duration_max, duration);
+	irq_stats_hist_add(stats->duration_hist, duration);
+}
+
+int arm_irq_stats_get(unsigned int irq, struct arm_irq_stats *stats)
+{
+	unsigned int key;
+
+	if (irq >= CONFIG_NUM_IRQS) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = irq_stats[irq];
+	irq_unlock(key);
+
+	return 0;
+}
+
+void arm_irq_stats_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	(void)memset(irq_stats, 0, sizeof(irq_stats));
+	irq_unlock(key);
+}
+
+void arm_irq_stats_show(void)
+{
+	struct arm_irq_stats stats;
+	unsigned int irq, n;
+
+	printk("IRQ stats in cycles (count, latency max, duration avg/max):\n");
+
+	for (irq = 0; irq < CONFIG_NUM_IRQS; irq++) {
+		(void)arm_irq_stats_get(irq, &stats);
+		if (stats.count == 0U) {
+			continue;
+		}
+
+		printk("  %3u: %u, %u, %u/%u\n", irq, stats.count,
+		       stats.latency_max,
+		       (u32_t)(stats.duration_total / stats.count),
+		       stats.duration_max);
+
+		printk("     duration hist:");
+		for (n = 0; n < ARM_IRQ_STATS_BUCKETS; n++) {
+			printk(" %u", stats.duration_hist[n]);
+		}
+		printk("\n");
+	}
+}
+
+static int arm_irq_stats_init(struct device *arg)
+{
+	ARG_UNUSED(arg);
+
+	/* Start the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	return 0;
+}
+
+SYS_INIT(arm_irq_stats_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_ARM_IRQ_STATS */
+
 void z_arch_isr_direct_header(void)
 {
 	z_sys_trace_isr_enter();
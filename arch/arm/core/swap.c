@@ -45,7 +45,7 @@ extern const int _k_neg_eagain;
  * z_set_thread_return_value()
  *
  */
-int __swap(int key)
+__hotfunc(__swap) int __swap(int key)
 {
 #ifdef CONFIG_EXECUTION_BENCHMARKING
 	read_timer_start_of_swap();
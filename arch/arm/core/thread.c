@@ -20,6 +20,11 @@
 extern u8_t *z_priv_stack_find(void *obj);
 #endif
 
+#ifdef CONFIG_ARM_FP_LAZY_SWITCH
+/* Thread whose callee-saved FP registers are live in the FPU, if any */
+struct k_thread *z_arm_fp_owner;
+#endif
+
 /**
  *
  * @brief Initialize a new thread from its stack space
@@ -133,6 +138,13 @@ void z_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 	thread->callee_saved.psp = (u32_t)pInitCtx;
 	thread->arch.basepri = 0;
 
+#ifdef CONFIG_ARM_FP_LAZY_SWITCH
+	/* The thread object may be reused from a thread that owned them */
+	if (z_arm_fp_owner == thread) {
+		z_arm_fp_owner = NULL;
+	}
+#endif
+
 #if defined(CONFIG_USERSPACE) || defined(CONFIG_FP_SHARING)
 	thread->arch.mode = 0;
 #if defined(CONFIG_USERSPACE)
@@ -14,6 +14,7 @@ from elftools.elf.elffile import ELFFile
 from elftools.elf.sections import SymbolTableSection
 
 ISR_FLAG_DIRECT = (1 << 0)
+ISR_FLAG_TRAMPOLINE = (1 << 1)
 
 # The below few hardware independent magic numbers represent various
 # levels of interrupts in a multi-level interrupt system.
@@ -301,6 +302,16 @@ def main():
 
             swt[table_index] = (param, func)
 
+            # The trampoline of the IRQ line loads the ISR and its
+            # parameter from this very table entry, so it only works for
+            # interrupts going straight to the processor
+            if flags & ISR_FLAG_TRAMPOLINE and vt:
+                if table_index == irq - offset:
+                    vt[table_index] = "Z_ISR_TRAMPOLINE({})".format(table_index)
+                else:
+                    debug("IRQ {} is not a first level interrupt, "
+                          "ignoring its trampoline flag".format(irq))
+
     with open(args.output_source, "w") as fp:
         write_source_file(fp, vt, swt, intlist, syms)
 
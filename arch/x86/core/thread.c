@@ -161,11 +161,9 @@ void _x86_swap_update_page_tables(struct k_thread *incoming,
 	if (incoming->mem_domain_info.mem_domain !=
 	   outgoing->mem_domain_info.mem_domain){
 
-		 /* Ensure that the outgoing mem domain configuration
-		  * is set back to default state.
-		  */
-		z_arch_mem_domain_destroy(outgoing->mem_domain_info.mem_domain);
-		z_arch_mem_domain_configure(incoming);
+		z_x86_mem_domain_pages_switch(
+			outgoing->mem_domain_info.mem_domain,
+			incoming->mem_domain_info.mem_domain);
 	}
 }
 
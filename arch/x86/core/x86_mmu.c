@@ -49,6 +49,17 @@ void z_x86_mmu_get_flags(struct x86_mmu_pdpt *pdpt, void *addr,
 			x86_page_entry_data_t *pde_flags,
 			x86_page_entry_data_t *pte_flags)
 {
+	union x86_mmu_pde_pt *pde = X86_MMU_GET_PDE(pdpt, addr);
+
+	if (pde->p != 0 && pde->ps != 0) {
+		/* A 2MB page holds the page flags in the PDE */
+		*pde_flags = (x86_page_entry_data_t)(pde->value &
+			~(x86_page_entry_data_t)MMU_2MB_PDE_ADDR_MASK);
+		*pte_flags = *pde_flags & ~(x86_page_entry_data_t)
+			MMU_PDE_PS_MASK;
+		return;
+	}
+
 	*pde_flags =
 		(x86_page_entry_data_t)(X86_MMU_GET_PDE(pdpt, addr)->value &
 			~(x86_page_entry_data_t)MMU_PDE_PAGE_TABLE_MASK);
@@ -115,6 +126,11 @@ int z_arch_buffer_validate(void *addr, size_t size, int write)
 				goto out;
 			}
 
+			/* A 2MB page has no page table to check */
+			if (pde_value.ps != 0) {
+				continue;
+			}
+
 			pte_address = (struct x86_mmu_pt *)
 				(pde_value.pt << MMU_PAGE_SHIFT);
 
@@ -185,26 +201,50 @@ void z_x86_mmu_set_flags(struct x86_mmu_pdpt *pdpt, void *ptr,
 			x86_page_entry_data_t flags,
 			x86_page_entry_data_t mask)
 {
+	union x86_mmu_pde_pt *pde;
 	union x86_mmu_pte *pte;
+	x86_page_entry_data_t pde_mask;
 
 	u32_t addr = (u32_t)ptr;
 
 	__ASSERT((addr & MMU_PAGE_MASK) == 0U, "unaligned address provided");
 	__ASSERT((size & MMU_PAGE_MASK) == 0U, "unaligned size provided");
 
+	/* The page size bit of a 2MB PDE is the PAT bit of a PTE */
+	pde_mask = mask & ~MMU_PDE_PS_MASK;
+
 	/* L1TF mitigation: non-present PTEs will have address fields
 	 * zeroed. Expand the mask to include address bits if we are changing
 	 * the present bit.
 	 */
 	if ((mask & MMU_PTE_P_MASK) != 0) {
 		mask |= MMU_PTE_PAGE_MASK;
+		pde_mask |= MMU_2MB_PDE_ADDR_MASK;
 	}
 
 	while (size != 0) {
 		x86_page_entry_data_t cur_flags = flags;
 
-		/* TODO we're not generating 2MB entries at the moment */
-		__ASSERT(X86_MMU_GET_PDE(pdpt, addr)->ps != 1, "2MB PDE found");
+		pde = X86_MMU_GET_PDE(pdpt, addr);
+		if (pde->ps != 0) {
+			__ASSERT((addr & MMU_2MB_PAGE_MASK) == 0U &&
+				 size >= MMU_2MB_PAGE_SIZE,
+				 "partial update of a 2MB page");
+
+			cur_flags &= ~MMU_PDE_PS_MASK;
+			if (((mask & MMU_PTE_P_MASK) != 0) &&
+			    ((flags & MMU_ENTRY_PRESENT) != 0)) {
+				cur_flags |= addr;
+			}
+
+			pde->value = (pde->value & ~pde_mask) | cur_flags;
+			tlb_flush_page((void *)addr);
+
+			size -= MMU_2MB_PAGE_SIZE;
+			addr += MMU_2MB_PAGE_SIZE;
+			continue;
+		}
+
 		pte = X86_MMU_GET_PTE(pdpt, addr);
 
 		/* If we're setting the present bit, restore the address
@@ -224,6 +264,80 @@ void z_x86_mmu_set_flags(struct x86_mmu_pdpt *pdpt, void *ptr,
 	}
 }
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+/* Page table entry bits the processor updates */
+#define PTE_HW_UPDATED_MASK (MMU_PTE_A_MASK | MMU_PTE_D_MASK)
+
+/* Replace the page tables of the 2MB areas in the region, mapped
+ * contiguously with the same flags, by 2MB pages.
+ */
+static void large_pages_map(struct x86_mmu_pdpt *pdpt, u32_t start,
+			    u32_t size)
+{
+	u32_t addr = ROUND_UP(start, MMU_2MB_PAGE_SIZE);
+	u32_t end = ROUND_DOWN(start + size, MMU_2MB_PAGE_SIZE);
+
+	for (; addr < end; addr += MMU_2MB_PAGE_SIZE) {
+		union x86_mmu_pde_pt *pde = X86_MMU_GET_PDE(pdpt, addr);
+		struct x86_mmu_pt *pt;
+		x86_page_entry_data_t flags;
+		u32_t i;
+
+		if (pde->p == 0 || pde->ps != 0) {
+			continue;
+		}
+
+		pt = X86_MMU_GET_PT_ADDR(pdpt, addr);
+		flags = pt->entry[0].value &
+			~(MMU_PTE_PAGE_MASK | PTE_HW_UPDATED_MASK);
+
+		/* The PAT bit of a PTE is elsewhere in a 2MB PDE */
+		if ((flags & (MMU_ENTRY_PRESENT | MMU_PTE_PAT_MASK)) !=
+		    MMU_ENTRY_PRESENT) {
+			continue;
+		}
+
+		for (i = 0U; i < MMU_ENTRIES_PER_PGT; i++) {
+			if ((pt->entry[i].value & ~PTE_HW_UPDATED_MASK) !=
+			    (flags | (addr + PAGES(i)))) {
+				break;
+			}
+		}
+
+		if (i == MMU_ENTRIES_PER_PGT) {
+			pde->value = flags | addr | MMU_PDE_PS_MASK;
+		}
+	}
+}
+
+static int large_pages_init(struct device *arg)
+{
+	ARG_UNUSED(arg);
+
+	/* Text and rodata keep their permissions at runtime, unlike the
+	 * RAM whose pages are granted to threads one at a time.
+	 */
+	large_pages_map(&z_x86_kernel_pdpt, (u32_t)&_image_text_start,
+			(u32_t)&_image_text_size);
+	large_pages_map(&z_x86_kernel_pdpt, (u32_t)&_image_rodata_start,
+			(u32_t)&_image_rodata_size);
+#ifdef CONFIG_X86_KPTI
+	large_pages_map(&z_x86_user_pdpt, (u32_t)&_image_text_start,
+			(u32_t)&_image_text_size);
+	large_pages_map(&z_x86_user_pdpt, (u32_t)&_image_rodata_start,
+			(u32_t)&_image_rodata_size);
+#endif
+
+	/* Drop the TLB entries of the replaced page tables */
+	__asm__ volatile ("movl %%cr3, %%eax\n\t"
+			  "movl %%eax, %%cr3" ::: "eax", "memory");
+
+	return 0;
+}
+
+SYS_INIT(large_pages_init, PRE_KERNEL_1, 0);
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 #ifdef CONFIG_X86_USERSPACE
 void z_x86_reset_pages(void *start, size_t size)
 {
@@ -306,6 +420,84 @@ out:
 	return;
 }
 
+static bool partition_in_domain(struct k_mem_partition *partition,
+				struct k_mem_domain *domain)
+{
+	u32_t i;
+
+	for (i = 0U; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
+		if (domain->partitions[i].size != 0U &&
+		    domain->partitions[i].start == partition->start &&
+		    domain->partitions[i].size == partition->size &&
+		    domain->partitions[i].attr == partition->attr) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool partitions_overlap(struct k_mem_partition *a,
+			       struct k_mem_partition *b)
+{
+	return a->start < b->start + b->size && b->start < a->start + a->size;
+}
+
+/* Whether a partition of the domain is reset when switching to another
+ * one, which holds the same partitions as the first or not.
+ */
+static bool partition_reset_overlaps(struct k_mem_partition *partition,
+				     struct k_mem_domain *from,
+				     struct k_mem_domain *to)
+{
+	u32_t i;
+
+	for (i = 0U; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
+		struct k_mem_partition *reset = &from->partitions[i];
+
+		if (reset->size != 0U && partitions_overlap(reset, partition) &&
+		    !partition_in_domain(reset, to)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void z_x86_mem_domain_pages_switch(struct k_mem_domain *from,
+				   struct k_mem_domain *to)
+{
+	struct k_mem_partition *partition;
+	u32_t i;
+
+	if (from == NULL || to == NULL) {
+		x86_mem_domain_pages_update(from, X86_MEM_DOMAIN_RESET_PAGES);
+		x86_mem_domain_pages_update(to, X86_MEM_DOMAIN_SET_PAGES);
+		return;
+	}
+
+	/* The partitions common to both domains keep their pages, unless
+	 * a partition reset overlaps theirs.
+	 */
+	for (i = 0U; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
+		partition = &from->partitions[i];
+		if (partition->size != 0U &&
+		    !partition_in_domain(partition, to)) {
+			z_x86_reset_pages((void *)partition->start,
+					  partition->size);
+		}
+	}
+
+	for (i = 0U; i < CONFIG_MAX_DOMAIN_PARTITIONS; i++) {
+		partition = &to->partitions[i];
+		if (partition->size != 0U &&
+		    (!partition_in_domain(partition, from) ||
+		     partition_reset_overlaps(partition, from, to))) {
+			activate_partition(partition);
+		}
+	}
+}
+
 /* Load the partitions of the thread. */
 void z_arch_mem_domain_configure(struct k_thread *thread)
 {
@@ -58,6 +58,10 @@
 #define MMU_2MB_PDE_PAGE_MASK       0xffc00000ULL
 #define MMU_2MB_PDE_CLEAR_PS        0x00000000ULL
 #define MMU_2MB_PDE_SET_PS          0x00000080ULL
+#define MMU_2MB_PDE_ADDR_MASK       0x00000000ffe00000ULL
+
+#define MMU_2MB_PAGE_SIZE           0x00200000U
+#define MMU_2MB_PAGE_MASK           0x001fffffU
 
 
 /*
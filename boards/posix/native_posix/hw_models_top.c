@@ -21,6 +21,9 @@
 #include "posix_soc_if.h"
 #include "posix_arch_internal.h"
 #include "sdl_events.h"
+#ifdef CONFIG_NATIVE_POSIX_TIME_SYNC
+#include "time_sync.h"
+#endif
 #include <misc/util.h>
 
 
@@ -97,6 +100,9 @@ void hwm_set_sig_handler(void)
 static void hwm_sleep_until_next_timer(void)
 {
 	if (next_timer_time >= simu_time) { /* LCOV_EXCL_BR_LINE */
+#ifdef CONFIG_NATIVE_POSIX_TIME_SYNC
+		hw_sync_until(next_timer_time);
+#endif
 		simu_time = next_timer_time;
 	} else {
 		/* LCOV_EXCL_START */
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Synchronization of the simulated time of several native_posix processes
+ *
+ * The processes of a simulation share a file mapped in memory, holding a
+ * time horizon. Each process runs its events due before the horizon as fast
+ * as it can, and then waits for all the others. Once they all have, the
+ * horizon moves one quantum past the earliest next event among them, so
+ * periods idle in all the processes are skipped together.
+ *
+ * Processes exchanging data (over sockets, pipes..) with a latency of at
+ * least one quantum of simulated time then see each other's data at the
+ * same simulated time on every run, however fast each of them runs.
+ *
+ * The process with id 0 creates the file, the others wait for it.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "hw_models_top.h"
+#include "time_sync.h"
+#include "zephyr/types.h"
+#include "posix_trace.h"
+#include "posix_arch_internal.h"
+#include "misc/util.h"
+#include "cmdline.h"
+#include "soc.h"
+
+#define HW_SYNC_MAGIC 0x5a53594e
+#define HW_SYNC_MAX_INSTANCES 256
+
+struct hw_sync_shared {
+	u32_t magic;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	/* Processes not exited yet, and those of them waiting */
+	u32_t active;
+	u32_t arrived;
+	u32_t generation;
+	/* Events due before it may run */
+	u64_t horizon;
+	/* Next event of each waiting process */
+	u64_t next[HW_SYNC_MAX_INSTANCES];
+};
+
+static struct {
+	char *file;
+	unsigned int id;
+	unsigned int count;
+	unsigned int quantum;
+} args = {
+	.quantum = 1000,
+};
+
+static struct hw_sync_shared *shared;
+static u64_t horizon; /* Local copy, to not lock for each event */
+static bool joined;
+
+/* Called with the mutex locked, by the last process to wait */
+static void hw_sync_release(void)
+{
+	u64_t next = NEVER;
+
+	for (unsigned int i = 0; i < args.count; i++) {
+		next = MIN(next, shared->next[i]);
+	}
+
+	if (next == NEVER) {
+		shared->horizon = NEVER;
+	} else {
+		shared->horizon = MAX(shared->horizon, next) + args.quantum;
+	}
+
+	shared->arrived = 0U;
+	shared->generation++;
+
+	PC_SAFE_CALL(pthread_cond_broadcast(&shared->cond));
+}
+
+/**
+ * Wait until all the processes of the simulation may run an event at time
+ */
+void hw_sync_until(u64_t time)
+{
+	u32_t generation;
+
+	if (!joined || time < horizon) {
+		return;
+	}
+
+	PC_SAFE_CALL(pthread_mutex_lock(&shared->mutex));
+
+	while (time >= shared->horizon) {
+		generation = shared->generation;
+		shared->next[args.id] = time;
+
+		if (++shared->arrived == shared->active) {
+			hw_sync_release();
+			continue;
+		}
+
+		while (generation == shared->generation) {
+			PC_SAFE_CALL(pthread_cond_wait(&shared->cond,
+						       &shared->mutex));
+		}
+	}
+
+	horizon = shared->horizon;
+
+	PC_SAFE_CALL(pthread_mutex_unlock(&shared->mutex));
+}
+
+static void hw_sync_init_shared(void)
+{
+	pthread_mutexattr_t mutex_attr;
+	pthread_condattr_t cond_attr;
+
+	memset(shared, 0, sizeof(*shared));
+
+	PC_SAFE_CALL(pthread_mutexattr_init(&mutex_attr));
+	PC_SAFE_CALL(pthread_mutexattr_setpshared(&mutex_attr,
+						  PTHREAD_PROCESS_SHARED));
+	PC_SAFE_CALL(pthread_mutex_init(&shared->mutex, &mutex_attr));
+	PC_SAFE_CALL(pthread_mutexattr_destroy(&mutex_attr));
+
+	PC_SAFE_CALL(pthread_condattr_init(&cond_attr));
+	PC_SAFE_CALL(pthread_condattr_setpshared(&cond_attr,
+						 PTHREAD_PROCESS_SHARED));
+	PC_SAFE_CALL(pthread_cond_init(&shared->cond, &cond_attr));
+	PC_SAFE_CALL(pthread_condattr_destroy(&cond_attr));
+
+	for (unsigned int i = 0; i < args.count; i++) {
+		shared->next[i] = NEVER;
+	}
+
+	shared->active = args.count;
+	shared->horizon = args.quantum;
+
+	__atomic_store_n(&shared->magic, HW_SYNC_MAGIC, __ATOMIC_RELEASE);
+}
+
+static int hw_sync_open(void)
+{
+	int fd;
+
+	if (args.id == 0U) {
+		fd = open(args.file, O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (fd == -1) {
+			posix_print_error_and_exit("Failed to create time sync "
+						   "file %s: %s\n", args.file,
+						   strerror(errno));
+		}
+
+		if (ftruncate(fd, sizeof(*shared)) == -1) {
+			posix_print_error_and_exit("Failed to resize time sync "
+						   "file %s: %s\n", args.file,
+						   strerror(errno));
+		}
+
+		return fd;
+	}
+
+	/* Created by the process with id 0, which may start after us */
+	while ((fd = open(args.file, O_RDWR)) == -1) {
+		if (errno != ENOENT) {
+			posix_print_error_and_exit("Failed to open time sync "
+						   "file %s: %s\n", args.file,
+						   strerror(errno));
+		}
+
+		usleep(1000);
+	}
+
+	return fd;
+}
+
+static void hw_sync_join(void)
+{
+	struct stat st;
+	int fd;
+
+	if (args.file == NULL) {
+		return;
+	}
+
+	if (args.count == 0U || args.count > HW_SYNC_MAX_INSTANCES ||
+	    args.id >= args.count || args.quantum == 0U) {
+		posix_print_error_and_exit("Invalid time sync id %u of %u "
+					   "processes (at most %u), quantum "
+					   "%u\n", args.id, args.count,
+					   HW_SYNC_MAX_INSTANCES,
+					   args.quantum);
+	}
+
+	fd = hw_sync_open();
+
+	do {
+		PC_SAFE_CALL(fstat(fd, &st));
+	} while ((size_t)st.st_size < sizeof(*shared) && usleep(1000) == 0);
+
+	shared = mmap(NULL, sizeof(*shared), PROT_READ | PROT_WRITE,
+		      MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (shared == MAP_FAILED) {
+		posix_print_error_and_exit("Failed to map time sync file %s: "
+					   "%s\n", args.file, strerror(errno));
+	}
+
+	if (args.id == 0U) {
+		hw_sync_init_shared();
+	}
+
+	while (__atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE) !=
+	       HW_SYNC_MAGIC) {
+		usleep(1000);
+	}
+
+	horizon = 0U;
+	joined = true;
+}
+
+static void hw_sync_leave(void)
+{
+	if (!joined) {
+		return;
+	}
+
+	joined = false;
+
+	/* The others no longer wait for our events */
+	PC_SAFE_CALL(pthread_mutex_lock(&shared->mutex));
+
+	shared->next[args.id] = NEVER;
+	shared->active--;
+
+	if (shared->active && shared->arrived == shared->active) {
+		hw_sync_release();
+	}
+
+	PC_SAFE_CALL(pthread_mutex_unlock(&shared->mutex));
+
+	if (args.id == 0U) {
+		unlink(args.file);
+	}
+
+	munmap(shared, sizeof(*shared));
+}
+
+static void hw_sync_add_options(void)
+{
+	static struct args_struct_t sync_options[] = {
+		/*
+		 * Fields:
+		 * manual, mandatory, switch,
+		 * option_name, var_name ,type,
+		 * destination, callback,
+		 * description
+		 */
+		{false, false, false,
+		"sync-file", "path", 's',
+		(void *)&args.file, NULL,
+		"Synchronize the simulated time with other processes through "
+		"this file. The process with id 0 creates it, it must not "
+		"exist beforehand"},
+
+		{false, false, false,
+		"sync-id", "id", 'u',
+		(void *)&args.id, NULL,
+		"Id of this process among the synchronized ones, from 0"},
+
+		{false, false, false,
+		"sync-count", "count", 'u',
+		(void *)&args.count, NULL,
+		"Number of synchronized processes"},
+
+		{false, false, false,
+		"sync-quantum", "time", 'u',
+		(void *)&args.quantum, NULL,
+		"Simulated time, in microseconds, the synchronized processes "
+		"may run ahead of each other (1000 by default). It should not "
+		"exceed the latency of their exchanges"},
+
+		ARG_TABLE_ENDMARKER};
+
+	native_add_command_line_opts(sync_options);
+}
+
+NATIVE_TASK(hw_sync_add_options, PRE_BOOT_1, 2);
+NATIVE_TASK(hw_sync_join, PRE_BOOT_2, 1);
+NATIVE_TASK(hw_sync_leave, ON_EXIT, 1);
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _NATIVE_POSIX_TIME_SYNC_H
+#define _NATIVE_POSIX_TIME_SYNC_H
+
+#include "hw_models_top.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void hw_sync_until(u64_t time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NATIVE_POSIX_TIME_SYNC_H */
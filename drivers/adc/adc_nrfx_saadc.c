@@ -7,6 +7,16 @@
 #define ADC_CONTEXT_USES_KERNEL_TIMER
 #include "adc_context.h"
 #include <hal/nrf_saadc.h>
+#ifdef CONFIG_ADC_NRFX_SAADC_CONTINUOUS
+#include <nrfx_ppi.h>
+#include <hal/nrf_timer.h>
+
+#define SAADC_TIMER NRFX_CONCAT_2(NRF_TIMER, \
+				  CONFIG_ADC_NRFX_SAADC_CONTINUOUS_TIMER)
+
+/* Width of the RESULT.MAXCNT register */
+#define SAADC_MAXCNT_MAX 0x7FFF
+#endif
 
 #define LOG_LEVEL CONFIG_ADC_LOG_LEVEL
 #include <logging/log.h>
@@ -16,6 +26,18 @@ struct driver_data {
 	struct adc_context ctx;
 
 	u8_t positive_inputs[NRF_SAADC_CHANNEL_COUNT];
+
+#ifdef CONFIG_ADC_NRFX_SAADC_CONTINUOUS
+	adc_continuous_callback continuous_cb;
+	void *continuous_user_data;
+	nrf_saadc_value_t *halves[2];
+	u16_t half_samplings;
+	/* Half latched by the next START, and half filled at the next END */
+	u8_t next_half;
+	u8_t done_half;
+	nrf_ppi_channel_t ppi_sample;
+	nrf_ppi_channel_t ppi_restart;
+#endif
 };
 
 static struct driver_data m_data = {
@@ -247,7 +269,9 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
-static int start_read(struct device *dev, const struct adc_sequence *sequence)
+/* Enable the channels selected for the sequence and apply its settings. */
+static int setup_sequence(const struct adc_sequence *sequence,
+			  u8_t *p_active_channels)
 {
 	int error;
 	u32_t selected_channels = sequence->channels;
@@ -313,6 +337,20 @@ static int start_read(struct device *dev, const struct adc_sequence *sequence)
 		return error;
 	}
 
+	*p_active_channels = active_channels;
+	return 0;
+}
+
+static int start_read(struct device *dev, const struct adc_sequence *sequence)
+{
+	int error;
+	u8_t active_channels;
+
+	error = setup_sequence(sequence, &active_channels);
+	if (error) {
+		return error;
+	}
+
 	error = check_buffer_size(sequence, active_channels);
 	if (error) {
 		return error;
@@ -356,10 +394,171 @@ static int adc_nrfx_read_async(struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_NRFX_SAADC_CONTINUOUS
+static int ppi_channel_setup(nrf_ppi_channel_t *channel, u32_t eep, u32_t tep)
+{
+	if (nrfx_ppi_channel_alloc(channel) != NRFX_SUCCESS) {
+		LOG_ERR("No free PPI channel");
+		return -EBUSY;
+	}
+
+	(void)nrfx_ppi_channel_assign(*channel, eep, tep);
+	(void)nrfx_ppi_channel_enable(*channel);
+
+	return 0;
+}
+
+static void ppi_channel_release(nrf_ppi_channel_t channel)
+{
+	(void)nrfx_ppi_channel_disable(channel);
+	(void)nrfx_ppi_channel_free(channel);
+}
+
+/* Implementation of the ADC driver API function: adc_continuous_start. */
+static int adc_nrfx_continuous_start(struct device *dev,
+				     const struct adc_continuous_config *config)
+{
+	const struct adc_sequence *sequence = config->sequence;
+	u8_t active_channels;
+	size_t half_len;
+	int error;
+
+	if (config->callback == NULL || config->interval_us == 0U ||
+	    sequence->options != NULL) {
+		return -EINVAL;
+	}
+
+	adc_context_lock(&m_data.ctx, false, NULL);
+
+	error = setup_sequence(sequence, &active_channels);
+	if (error) {
+		goto unlock;
+	}
+
+	m_data.half_samplings = MIN(sequence->buffer_size / 2U /
+				    sizeof(nrf_saadc_value_t),
+				    SAADC_MAXCNT_MAX) / active_channels;
+	if (m_data.half_samplings == 0U) {
+		LOG_ERR("Provided buffer is too small (%u)",
+			sequence->buffer_size);
+		error = -ENOMEM;
+		goto unlock;
+	}
+
+	half_len = m_data.half_samplings * active_channels;
+	m_data.halves[0] = (nrf_saadc_value_t *)sequence->buffer;
+	m_data.halves[1] = m_data.halves[0] + half_len;
+	m_data.next_half = 1U;
+	m_data.done_half = 0U;
+
+	error = ppi_channel_setup(&m_data.ppi_sample,
+		(u32_t)nrf_timer_event_address_get(SAADC_TIMER,
+						   NRF_TIMER_EVENT_COMPARE0),
+		nrf_saadc_task_address_get(NRF_SAADC_TASK_SAMPLE));
+	if (error) {
+		goto unlock;
+	}
+
+	/* Restart immediately into the buffer latched at the previous START */
+	error = ppi_channel_setup(&m_data.ppi_restart,
+		nrf_saadc_event_address_get(NRF_SAADC_EVENT_END),
+		nrf_saadc_task_address_get(NRF_SAADC_TASK_START));
+	if (error) {
+		ppi_channel_release(m_data.ppi_sample);
+		goto unlock;
+	}
+
+	nrf_timer_task_trigger(SAADC_TIMER, NRF_TIMER_TASK_STOP);
+	nrf_timer_task_trigger(SAADC_TIMER, NRF_TIMER_TASK_CLEAR);
+	nrf_timer_mode_set(SAADC_TIMER, NRF_TIMER_MODE_TIMER);
+	nrf_timer_bit_width_set(SAADC_TIMER, NRF_TIMER_BIT_WIDTH_32);
+	nrf_timer_frequency_set(SAADC_TIMER, NRF_TIMER_FREQ_16MHz);
+	nrf_timer_cc_write(SAADC_TIMER, NRF_TIMER_CC_CHANNEL0,
+			   nrf_timer_us_to_ticks(config->interval_us,
+						 NRF_TIMER_FREQ_16MHz));
+	nrf_timer_shorts_enable(SAADC_TIMER,
+				NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK);
+
+	m_data.continuous_user_data = config->user_data;
+	m_data.continuous_cb = config->callback;
+
+	nrf_saadc_buffer_init(m_data.halves[0], half_len);
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_int_enable(NRF_SAADC_INT_STARTED);
+
+	nrf_saadc_enable();
+	nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+	nrf_timer_task_trigger(SAADC_TIMER, NRF_TIMER_TASK_START);
+
+	/* The context stays locked until adc_continuous_stop() */
+	return 0;
+
+unlock:
+	adc_context_release(&m_data.ctx, error);
+	return error;
+}
+
+/* Implementation of the ADC driver API function: adc_continuous_stop. */
+static int adc_nrfx_continuous_stop(struct device *dev)
+{
+	if (m_data.continuous_cb == NULL) {
+		return -EALREADY;
+	}
+
+	nrf_timer_task_trigger(SAADC_TIMER, NRF_TIMER_TASK_STOP);
+	ppi_channel_release(m_data.ppi_sample);
+	ppi_channel_release(m_data.ppi_restart);
+
+	nrf_saadc_int_disable(NRF_SAADC_INT_END | NRF_SAADC_INT_STARTED);
+	nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+	while (!nrf_saadc_event_check(NRF_SAADC_EVENT_STOPPED)) {
+		/* STOPPED follows within a conversion time */
+	}
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+	nrf_saadc_disable();
+
+	m_data.continuous_cb = NULL;
+	nrf_saadc_int_enable(NRF_SAADC_INT_END);
+
+	adc_context_release(&m_data.ctx, 0);
+
+	return 0;
+}
+
+static void saadc_continuous_irq_handler(struct device *dev)
+{
+	if (nrf_saadc_event_check(NRF_SAADC_EVENT_STARTED)) {
+		nrf_saadc_event_clear(NRF_SAADC_EVENT_STARTED);
+
+		/* RESULT.PTR is latched, set the buffer of the next START */
+		nrf_saadc_buffer_pointer_set(m_data.halves[m_data.next_half]);
+		m_data.next_half ^= 1U;
+	}
+
+	if (nrf_saadc_event_check(NRF_SAADC_EVENT_END)) {
+		nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
+
+		m_data.continuous_cb(dev, m_data.halves[m_data.done_half],
+				     m_data.half_samplings,
+				     m_data.continuous_user_data);
+		m_data.done_half ^= 1U;
+	}
+}
+#endif /* CONFIG_ADC_NRFX_SAADC_CONTINUOUS */
+
 static void saadc_irq_handler(void *param)
 {
 	struct device *dev = (struct device *)param;
 
+#ifdef CONFIG_ADC_NRFX_SAADC_CONTINUOUS
+	if (m_data.continuous_cb) {
+		saadc_continuous_irq_handler(dev);
+		return;
+	}
+#endif
+
 	if (nrf_saadc_event_check(NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
 
@@ -406,6 +605,10 @@ static const struct adc_driver_api adc_nrfx_driver_api = {
 #ifdef CONFIG_ADC_ASYNC
 	.read_async    = adc_nrfx_read_async,
 #endif
+#ifdef CONFIG_ADC_NRFX_SAADC_CONTINUOUS
+	.continuous_start = adc_nrfx_continuous_start,
+	.continuous_stop  = adc_nrfx_continuous_stop,
+#endif
 };
 
 #ifdef CONFIG_ADC_0
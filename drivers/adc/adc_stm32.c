@@ -23,6 +23,20 @@ LOG_MODULE_REGISTER(adc_stm32);
 
 #include <clock_control/stm32_clock_control.h>
 
+#ifdef CONFIG_ADC_STM32_CONTINUOUS
+#include <dma.h>
+#include <stm32f4xx_ll_tim.h>
+
+/* ADC1 requests on DMA2 stream 0, channel 0 */
+#define ADC_STM32_DMA_NAME	CONFIG_DMA_2_NAME
+#define ADC_STM32_DMA_STREAM	0
+#define ADC_STM32_DMA_SLOT	0
+
+/* TIM2 is a 32-bit timer whose TRGO can trigger regular conversions */
+#define ADC_STM32_TIM		TIM2
+#define ADC_STM32_TIM_TRIG	LL_ADC_REG_TRIG_EXT_TIM2_TRGO
+#endif
+
 #if !defined(CONFIG_SOC_SERIES_STM32F0X) && \
 	!defined(CONFIG_SOC_SERIES_STM32L0X)
 #define RANK(n)		LL_ADC_REG_RANK_##n
@@ -175,6 +189,15 @@ struct adc_stm32_data {
 #if defined(CONFIG_SOC_SERIES_STM32F0X) || defined(CONFIG_SOC_SERIES_STM32L0X)
 	s8_t acq_time_index;
 #endif
+#ifdef CONFIG_ADC_STM32_CONTINUOUS
+	struct device *dma;
+	adc_continuous_callback continuous_cb;
+	void *continuous_user_data;
+	u16_t *continuous_buffer;
+	size_t half_samplings;
+	/* Half of the buffer filled at the next DMA callback */
+	u8_t done_half;
+#endif
 };
 
 struct adc_stm32_cfg {
@@ -223,13 +246,14 @@ static void adc_stm32_start_conversion(struct device *dev)
 #endif
 }
 
-static int start_read(struct device *dev, const struct adc_sequence *sequence)
+/* Select the channel and the resolution of the sequence. */
+static int setup_sequence(struct device *dev,
+			  const struct adc_sequence *sequence)
 {
 	const struct adc_stm32_cfg *config = dev->config->config_info;
 	struct adc_stm32_data *data = dev->driver_data;
 	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
 	u8_t resolution;
-	int err;
 
 	switch (sequence->resolution) {
 #if !defined(CONFIG_SOC_SERIES_STM32F1X)
@@ -267,14 +291,29 @@ static int start_read(struct device *dev, const struct adc_sequence *sequence)
 #endif
 	data->channel_count = 1;
 
-	err = check_buffer_size(sequence, data->channel_count);
+#if !defined(CONFIG_SOC_SERIES_STM32F1X)
+	LL_ADC_SetResolution(adc, resolution);
+#endif
+
+	return 0;
+}
+
+static int start_read(struct device *dev, const struct adc_sequence *sequence)
+{
+	const struct adc_stm32_cfg *config = dev->config->config_info;
+	struct adc_stm32_data *data = dev->driver_data;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+	int err;
+
+	err = check_buffer_size(sequence, 1);
 	if (err) {
 		return err;
 	}
 
-#if !defined(CONFIG_SOC_SERIES_STM32F1X)
-	LL_ADC_SetResolution(adc, resolution);
-#endif
+	err = setup_sequence(dev, sequence);
+	if (err) {
+		return err;
+	}
 
 #if defined(CONFIG_SOC_SERIES_STM32F0X) || \
 	defined(CONFIG_SOC_SERIES_STM32F3X) || \
@@ -357,6 +396,174 @@ static int adc_stm32_read_async(struct device *dev,
 }
 #endif
 
+#ifdef CONFIG_ADC_STM32_CONTINUOUS
+static void adc_stm32_dma_callback(void *arg, u32_t channel, int status)
+{
+	struct device *dev = arg;
+	struct adc_stm32_data *data = dev->driver_data;
+	u16_t *half;
+
+	ARG_UNUSED(channel);
+
+	if (status < 0) {
+		LOG_ERR("DMA transfer error (%d)", status);
+		return;
+	}
+
+	/* Half transfer then transfer complete callbacks, in turn */
+	half = data->continuous_buffer + data->done_half * data->half_samplings;
+	data->done_half ^= 1U;
+
+	data->continuous_cb(dev, half, data->half_samplings,
+			    data->continuous_user_data);
+}
+
+static int adc_stm32_timer_setup(u32_t interval_us)
+{
+	struct device *clk = device_get_binding(STM32_CLOCK_CONTROL_NAME);
+	struct stm32_pclken pclken = {
+		.bus = STM32_CLOCK_BUS_APB1,
+		.enr = LL_APB1_GRP1_PERIPH_TIM2,
+	};
+	u32_t tim_clk;
+	u64_t ticks;
+
+	if (clock_control_on(clk, (clock_control_subsys_t *)&pclken) != 0 ||
+	    clock_control_get_rate(clk, (clock_control_subsys_t *)&pclken,
+				   &tim_clk) < 0) {
+		return -EIO;
+	}
+
+	/* Timers run at twice the APB clock when it is prescaled */
+	if (CONFIG_CLOCK_STM32_APB1_PRESCALER != 1U) {
+		tim_clk *= 2U;
+	}
+
+	ticks = (u64_t)tim_clk * interval_us / USEC_PER_SEC;
+	if (ticks < 2 || ticks > UINT32_MAX) {
+		LOG_ERR("Interval of %u us not supported", interval_us);
+		return -EINVAL;
+	}
+
+	LL_TIM_DisableCounter(ADC_STM32_TIM);
+	LL_TIM_SetPrescaler(ADC_STM32_TIM, 0);
+	LL_TIM_SetAutoReload(ADC_STM32_TIM, (u32_t)ticks - 1);
+	LL_TIM_SetCounter(ADC_STM32_TIM, 0);
+	LL_TIM_SetTriggerOutput(ADC_STM32_TIM, LL_TIM_TRGO_UPDATE);
+
+	return 0;
+}
+
+static int adc_stm32_continuous_start(struct device *dev,
+				      const struct adc_continuous_config *cfg)
+{
+	const struct adc_stm32_cfg *config = dev->config->config_info;
+	struct adc_stm32_data *data = dev->driver_data;
+	const struct adc_sequence *sequence = cfg->sequence;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+	struct dma_block_config blk_cfg = { 0 };
+	struct dma_config dma_cfg = { 0 };
+	int err;
+
+	if (cfg->callback == NULL || sequence->options != NULL) {
+		return -EINVAL;
+	}
+
+	adc_context_lock(&data->ctx, false, NULL);
+
+	data->half_samplings = MIN(sequence->buffer_size / 2U / sizeof(u16_t),
+				   0xFFFF / 2);
+	if (data->half_samplings == 0U) {
+		LOG_ERR("Provided buffer is too small (%u)",
+			sequence->buffer_size);
+		err = -ENOMEM;
+		goto unlock;
+	}
+
+	err = setup_sequence(dev, sequence);
+	if (err) {
+		goto unlock;
+	}
+
+	err = adc_stm32_timer_setup(cfg->interval_us);
+	if (err) {
+		goto unlock;
+	}
+
+	data->continuous_buffer = sequence->buffer;
+	data->continuous_user_data = cfg->user_data;
+	data->continuous_cb = cfg->callback;
+	data->done_half = 0U;
+
+	blk_cfg.source_address = LL_ADC_DMA_GetRegAddr(adc,
+					LL_ADC_DMA_REG_REGULAR_DATA);
+	blk_cfg.dest_address = (u32_t)sequence->buffer;
+	blk_cfg.block_size = data->half_samplings * 2U;
+	blk_cfg.dest_reload_en = 1;
+
+	dma_cfg.dma_slot = ADC_STM32_DMA_SLOT;
+	dma_cfg.channel_direction = PERIPHERAL_TO_MEMORY;
+	dma_cfg.complete_callback_en = 1; /* each half is a block */
+	dma_cfg.source_data_size = 1; /* 16bit, see dma_width_index() */
+	dma_cfg.dest_data_size = 1;
+	dma_cfg.source_burst_length = 1; /* SINGLE transfer */
+	dma_cfg.dest_burst_length = 1;
+	dma_cfg.block_count = 1;
+	dma_cfg.head_block = &blk_cfg;
+	dma_cfg.callback_arg = dev;
+	dma_cfg.dma_callback = adc_stm32_dma_callback;
+
+	err = dma_config(data->dma, ADC_STM32_DMA_STREAM, &dma_cfg);
+	if (!err) {
+		err = dma_start(data->dma, ADC_STM32_DMA_STREAM);
+	}
+	if (err) {
+		data->continuous_cb = NULL;
+		goto unlock;
+	}
+
+	LL_ADC_DisableIT_EOCS(adc);
+	LL_ADC_REG_SetDMATransfer(adc, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+	LL_ADC_REG_SetTriggerSource(adc, ADC_STM32_TIM_TRIG);
+	LL_ADC_REG_StartConversionExtTrig(adc, LL_ADC_REG_TRIG_EXT_RISING);
+
+	LL_TIM_EnableCounter(ADC_STM32_TIM);
+
+	/* The context stays locked until adc_continuous_stop() */
+	return 0;
+
+unlock:
+	adc_context_release(&data->ctx, err);
+	return err;
+}
+
+static int adc_stm32_continuous_stop(struct device *dev)
+{
+	const struct adc_stm32_cfg *config = dev->config->config_info;
+	struct adc_stm32_data *data = dev->driver_data;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+
+	if (data->continuous_cb == NULL) {
+		return -EALREADY;
+	}
+
+	LL_TIM_DisableCounter(ADC_STM32_TIM);
+	LL_ADC_REG_StopConversionExtTrig(adc);
+	LL_ADC_REG_SetTriggerSource(adc, LL_ADC_REG_TRIG_SOFTWARE);
+	LL_ADC_REG_SetDMATransfer(adc, LL_ADC_REG_DMA_TRANSFER_NONE);
+
+	dma_stop(data->dma, ADC_STM32_DMA_STREAM);
+	data->continuous_cb = NULL;
+
+	/* a conversion may have completed after the last DMA request */
+	LL_ADC_ClearFlag_OVR(adc);
+
+	adc_context_release(&data->ctx, 0);
+
+	return 0;
+}
+#endif /* CONFIG_ADC_STM32_CONTINUOUS */
+
 static int adc_stm32_check_acq_time(u16_t acq_time)
 {
 	for (int i = 0; i < 8; i++) {
@@ -587,6 +794,21 @@ static int adc_stm32_init(struct device *dev)
 
 	config->irq_cfg_func();
 
+#ifdef CONFIG_ADC_STM32_CONTINUOUS
+	data->dma = device_get_binding(ADC_STM32_DMA_NAME);
+	if (!data->dma) {
+		LOG_ERR("%s device not found", ADC_STM32_DMA_NAME);
+		return -ENODEV;
+	}
+
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	if (dma_request_channel(data->dma, ADC_STM32_DMA_STREAM) < 0) {
+		LOG_ERR("%s stream in use", ADC_STM32_DMA_NAME);
+		return -EBUSY;
+	}
+#endif
+#endif
+
 #ifdef CONFIG_SOC_SERIES_STM32F1X
 	/* Calibration of F1 must starts after two cycles after ADON is set. */
 	LL_ADC_StartCalibration(adc);
@@ -603,6 +825,10 @@ static const struct adc_driver_api api_stm32_driver_api = {
 #ifdef CONFIG_ADC_ASYNC
 	.read_async = adc_stm32_read_async,
 #endif
+#ifdef CONFIG_ADC_STM32_CONTINUOUS
+	.continuous_start = adc_stm32_continuous_start,
+	.continuous_stop = adc_stm32_continuous_stop,
+#endif
 };
 
 #define STM32_ADC_INIT(index)						\
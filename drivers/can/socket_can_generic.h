@@ -99,10 +99,53 @@ static inline int socket_can_setsockopt(struct device *dev, void *obj,
 	return 0;
 }
 
+static inline int socket_can_send_frame(struct device *dev,
+					const struct zcan_frame *frame,
+					s32_t timeout)
+{
+	struct socket_can_context *socket_context = dev->driver_data;
+	int ret;
+
+	ret = can_send(socket_context->can_dev, (struct zcan_frame *)frame,
+		       timeout, tx_irq_callback, "socket_can_send_frame");
+	if (ret == CAN_TIMEOUT) {
+		return -EAGAIN;
+	}
+
+	return ret ? -EIO : 0;
+}
+
+static inline int socket_can_attach_isr(struct device *dev,
+					can_rx_callback_t isr,
+					void *callback_arg,
+					const struct zcan_filter *filter)
+{
+	struct socket_can_context *socket_context = dev->driver_data;
+	int ret;
+
+	ret = can_attach_isr(socket_context->can_dev, isr, callback_arg,
+			     filter);
+	if (ret == CAN_NO_FREE_FILTER) {
+		return -ENOSPC;
+	}
+
+	return ret;
+}
+
+static inline void socket_can_detach(struct device *dev, int filter_id)
+{
+	struct socket_can_context *socket_context = dev->driver_data;
+
+	can_detach(socket_context->can_dev, filter_id);
+}
+
 static struct canbus_api socket_can_api = {
 	.iface_api.init = socket_can_iface_init,
 	.send = socket_can_send,
 	.setsockopt = socket_can_setsockopt,
+	.send_frame = socket_can_send_frame,
+	.attach_isr = socket_can_attach_isr,
+	.detach = socket_can_detach,
 };
 
 static struct socket_can_context socket_can_context_1;
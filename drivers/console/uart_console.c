@@ -150,6 +150,7 @@ static u8_t (*completion_cb)(char *line, u8_t len);
 #define ANSI_HOME          'H'
 #define ANSI_DEL           '~'
 
+#ifndef CONFIG_UART_CONSOLE_ASYNC
 static int read_uart(struct device *uart, u8_t *buf, unsigned int size)
 {
 	int rx;
@@ -164,6 +165,7 @@ static int read_uart(struct device *uart, u8_t *buf, unsigned int size)
 
 	return rx;
 }
+#endif
 
 static inline void cursor_forward(unsigned int count)
 {
@@ -450,111 +452,167 @@ static bool handle_mcumgr(struct console_input *cmd, uint8_t byte)
 
 #endif /* CONFIG_UART_CONSOLE_MCUMGR */
 
-void uart_console_isr(struct device *unused)
+static void handle_input_byte(u8_t byte)
 {
-	ARG_UNUSED(unused);
-
-	while (uart_irq_update(uart_console_dev) &&
-	       uart_irq_is_pending(uart_console_dev)) {
-		static struct console_input *cmd;
-		u8_t byte;
-		int rx;
-
-		if (!uart_irq_rx_ready(uart_console_dev)) {
-			continue;
-		}
-
-		/* Character(s) have been received */
-
-		rx = read_uart(uart_console_dev, &byte, 1);
-		if (rx < 0) {
-			return;
-		}
+	static struct console_input *cmd;
 
 #ifdef CONFIG_UART_CONSOLE_DEBUG_SERVER_HOOKS
-		if (debug_hook_in != NULL && debug_hook_in(byte) != 0) {
-			/*
-			 * The input hook indicates that no further processing
-			 * should be done by this handler.
-			 */
-			return;
-		}
+	if (debug_hook_in != NULL && debug_hook_in(byte) != 0) {
+		/*
+		 * The input hook indicates that no further processing
+		 * should be done by this handler.
+		 */
+		return;
+	}
 #endif
 
+	if (!cmd) {
+		cmd = k_fifo_get(avail_queue, K_NO_WAIT);
 		if (!cmd) {
-			cmd = k_fifo_get(avail_queue, K_NO_WAIT);
-			if (!cmd) {
-				return;
-			}
+			return;
 		}
+	}
 
 #ifdef CONFIG_UART_CONSOLE_MCUMGR
-		/* Divert this byte from normal console handling if it is part
-		 * of an mcumgr frame.
-		 */
-		if (handle_mcumgr(cmd, byte)) {
-			continue;
-		}
+	/* Divert this byte from normal console handling if it is part
+	 * of an mcumgr frame.
+	 */
+	if (handle_mcumgr(cmd, byte)) {
+		return;
+	}
 #endif          /* CONFIG_UART_CONSOLE_MCUMGR */
 
-		/* Handle ANSI escape mode */
-		if (atomic_test_bit(&esc_state, ESC_ANSI)) {
-			handle_ansi(byte, cmd->line);
-			continue;
+	/* Handle ANSI escape mode */
+	if (atomic_test_bit(&esc_state, ESC_ANSI)) {
+		handle_ansi(byte, cmd->line);
+		return;
+	}
+
+	/* Handle escape mode */
+	if (atomic_test_and_clear_bit(&esc_state, ESC_ESC)) {
+		if (byte == ANSI_ESC) {
+			atomic_set_bit(&esc_state, ESC_ANSI);
+			atomic_set_bit(&esc_state, ESC_ANSI_FIRST);
 		}
 
-		/* Handle escape mode */
-		if (atomic_test_and_clear_bit(&esc_state, ESC_ESC)) {
-			if (byte == ANSI_ESC) {
-				atomic_set_bit(&esc_state, ESC_ANSI);
-				atomic_set_bit(&esc_state, ESC_ANSI_FIRST);
+		return;
+	}
+
+	/* Handle special control characters */
+	if (!isprint(byte)) {
+		switch (byte) {
+		case BS:
+		case DEL:
+			if (cur > 0) {
+				del_char(&cmd->line[--cur], end);
 			}
+			break;
+		case ESC:
+			atomic_set_bit(&esc_state, ESC_ESC);
+			break;
+		case '\r':
+			cmd->line[cur + end] = '\0';
+			uart_poll_out(uart_console_dev, '\r');
+			uart_poll_out(uart_console_dev, '\n');
+			cur = 0U;
+			end = 0U;
+			k_fifo_put(lines_queue, cmd);
+			cmd = NULL;
+			break;
+		case '\t':
+			if (completion_cb && !end) {
+				cur += completion_cb(cmd->line, cur);
+			}
+			break;
+		default:
+			break;
+		}
 
-			continue;
+		return;
+	}
+
+	/* Ignore characters if there's no more buffer space */
+	if (cur + end < sizeof(cmd->line) - 1) {
+		insert_char(&cmd->line[cur++], byte, end);
+	}
+}
+
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+/* Input is handed over after this time without reception, in ms */
+#define CONSOLE_RX_TIMEOUT 1
+
+static u8_t console_rx_buf[2][CONFIG_UART_CONSOLE_ASYNC_RX_BUF_SIZE];
+static u8_t console_rx_buf_idx;
+
+static void console_rx_enable(void)
+{
+	console_rx_buf_idx = 0U;
+	(void)uart_rx_enable(uart_console_dev, console_rx_buf[0],
+			     sizeof(console_rx_buf[0]), CONSOLE_RX_TIMEOUT);
+}
+
+static void uart_console_callback(struct uart_event *evt, void *user_data)
+{
+	size_t i;
+
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		for (i = 0; i < evt->data.rx.len; i++) {
+			handle_input_byte(evt->data.rx.buf[evt->data.rx.offset +
+							   i]);
 		}
+		break;
 
-		/* Handle special control characters */
-		if (!isprint(byte)) {
-			switch (byte) {
-			case BS:
-			case DEL:
-				if (cur > 0) {
-					del_char(&cmd->line[--cur], end);
-				}
-				break;
-			case ESC:
-				atomic_set_bit(&esc_state, ESC_ESC);
-				break;
-			case '\r':
-				cmd->line[cur + end] = '\0';
-				uart_poll_out(uart_console_dev, '\r');
-				uart_poll_out(uart_console_dev, '\n');
-				cur = 0U;
-				end = 0U;
-				k_fifo_put(lines_queue, cmd);
-				cmd = NULL;
-				break;
-			case '\t':
-				if (completion_cb && !end) {
-					cur += completion_cb(cmd->line, cur);
-				}
-				break;
-			default:
-				break;
-			}
+	case UART_RX_BUF_REQUEST:
+		console_rx_buf_idx ^= 1U;
+		(void)uart_rx_buf_rsp(uart_console_dev,
+				      console_rx_buf[console_rx_buf_idx],
+				      sizeof(console_rx_buf[0]));
+		break;
 
+	case UART_RX_DISABLED:
+		/* stopped on a line error, or the next buffer was late */
+		console_rx_enable();
+		break;
+
+	default:
+		break;
+	}
+}
+#else
+void uart_console_isr(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	while (uart_irq_update(uart_console_dev) &&
+	       uart_irq_is_pending(uart_console_dev)) {
+		u8_t byte;
+		int rx;
+
+		if (!uart_irq_rx_ready(uart_console_dev)) {
 			continue;
 		}
 
-		/* Ignore characters if there's no more buffer space */
-		if (cur + end < sizeof(cmd->line) - 1) {
-			insert_char(&cmd->line[cur++], byte, end);
+		/* Character(s) have been received */
+
+		rx = read_uart(uart_console_dev, &byte, 1);
+		if (rx < 0) {
+			return;
 		}
+
+		handle_input_byte(byte);
 	}
 }
+#endif /* CONFIG_UART_CONSOLE_ASYNC */
 
 static void console_input_init(void)
 {
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+	uart_callback_set(uart_console_dev, uart_console_callback, NULL);
+	console_rx_enable();
+#else
 	u8_t c;
 
 	uart_irq_rx_disable(uart_console_dev);
@@ -568,6 +626,7 @@ static void console_input_init(void)
 	}
 
 	uart_irq_rx_enable(uart_console_dev);
+#endif
 }
 
 void uart_register_input(struct k_fifo *avail, struct k_fifo *lines,
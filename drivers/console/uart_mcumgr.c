@@ -58,6 +58,7 @@ void uart_mcumgr_free_rx_buf(struct uart_mcumgr_rx_buf *rx_buf)
 	k_mem_slab_free(&uart_mcumgr_slab, &block);
 }
 
+#ifndef CONFIG_UART_MCUMGR_ASYNC
 /**
  * Reads a chunk of received data from the UART.
  */
@@ -69,7 +70,41 @@ static int uart_mcumgr_read_chunk(void *buf, int capacity)
 
 	return uart_fifo_read(uart_mcumgr_dev, buf, capacity);
 }
+#endif
+
+#ifdef CONFIG_MCUMGR_SMP_UART_BINARY
+static struct mcumgr_serial_bin_rx uart_mcumgr_bin_rx;
 
+/**
+ * Processes a single incoming byte of a binary stream.  Fragments end with
+ * the frames, or when their buffer is full.
+ */
+static struct uart_mcumgr_rx_buf *uart_mcumgr_rx_byte(u8_t byte)
+{
+	struct uart_mcumgr_rx_buf *rx_buf;
+	bool end;
+
+	end = mcumgr_serial_bin_rx_byte(&uart_mcumgr_bin_rx, byte);
+
+	if (uart_mcumgr_cur_buf == NULL) {
+		uart_mcumgr_cur_buf = uart_mcumgr_alloc_rx_buf();
+		if (uart_mcumgr_cur_buf == NULL) {
+			/* Insufficient buffers; the frame's CRC fails. */
+			return NULL;
+		}
+	}
+
+	rx_buf = uart_mcumgr_cur_buf;
+	rx_buf->data[rx_buf->length++] = byte;
+
+	if (end || rx_buf->length == sizeof(rx_buf->data)) {
+		uart_mcumgr_cur_buf = NULL;
+		return rx_buf;
+	}
+
+	return NULL;
+}
+#else
 /**
  * Processes a single incoming byte.
  */
@@ -111,7 +146,64 @@ static struct uart_mcumgr_rx_buf *uart_mcumgr_rx_byte(u8_t byte)
 
 	return NULL;
 }
+#endif /* CONFIG_MCUMGR_SMP_UART_BINARY */
+
+#ifdef CONFIG_UART_MCUMGR_ASYNC
+static u8_t uart_mcumgr_async_buf[2][CONFIG_UART_MCUMGR_ASYNC_BUF_SIZE];
+static u8_t uart_mcumgr_async_buf_idx;
+
+/** Signals the end of the transmission of a chunk. */
+static K_SEM_DEFINE(uart_mcumgr_tx_sem, 0, 1);
+
+static void uart_mcumgr_rx_enable(void)
+{
+	uart_mcumgr_async_buf_idx = 0U;
+	(void)uart_rx_enable(uart_mcumgr_dev, uart_mcumgr_async_buf[0],
+			     sizeof(uart_mcumgr_async_buf[0]), 1);
+}
 
+/**
+ * Asynchronous UART event handler.
+ */
+static void uart_mcumgr_async(struct uart_event *evt, void *user_data)
+{
+	struct uart_mcumgr_rx_buf *rx_buf;
+	size_t i;
+
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&uart_mcumgr_tx_sem);
+		break;
+
+	case UART_RX_RDY:
+		for (i = 0; i < evt->data.rx.len; i++) {
+			rx_buf = uart_mcumgr_rx_byte(
+				evt->data.rx.buf[evt->data.rx.offset + i]);
+			if (rx_buf != NULL) {
+				uart_mgumgr_recv_cb(rx_buf);
+			}
+		}
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		uart_mcumgr_async_buf_idx ^= 1U;
+		(void)uart_rx_buf_rsp(uart_mcumgr_dev,
+			uart_mcumgr_async_buf[uart_mcumgr_async_buf_idx],
+			sizeof(uart_mcumgr_async_buf[0]));
+		break;
+
+	case UART_RX_DISABLED:
+		uart_mcumgr_rx_enable();
+		break;
+
+	default:
+		break;
+	}
+}
+#else
 /**
  * ISR that is called when UART bytes are received.
  */
@@ -140,12 +232,26 @@ static void uart_mcumgr_isr(struct device *unused)
 		}
 	}
 }
+#endif /* CONFIG_UART_MCUMGR_ASYNC */
 
 /**
  * Sends raw data over the UART.
  */
 static int uart_mcumgr_send_raw(const void *data, int len, void *arg)
 {
+#ifdef CONFIG_UART_MCUMGR_ASYNC
+	int rc;
+
+	/* The data only lives until this returns */
+	rc = uart_tx(uart_mcumgr_dev, data, len, K_FOREVER);
+	if (rc != 0) {
+		return rc;
+	}
+
+	k_sem_take(&uart_mcumgr_tx_sem, K_FOREVER);
+
+	return 0;
+#else
 	const u8_t *u8p;
 
 	u8p = data;
@@ -154,15 +260,24 @@ static int uart_mcumgr_send_raw(const void *data, int len, void *arg)
 	}
 
 	return 0;
+#endif
 }
 
 int uart_mcumgr_send(const u8_t *data, int len)
 {
+#ifdef CONFIG_MCUMGR_SMP_UART_BINARY
+	return mcumgr_serial_tx_pkt_bin(data, len, uart_mcumgr_send_raw, NULL);
+#else
 	return mcumgr_serial_tx_pkt(data, len, uart_mcumgr_send_raw, NULL);
+#endif
 }
 
 static void uart_mcumgr_setup(struct device *uart)
 {
+#ifdef CONFIG_UART_MCUMGR_ASYNC
+	uart_callback_set(uart, uart_mcumgr_async, NULL);
+	uart_mcumgr_rx_enable();
+#else
 	u8_t c;
 
 	uart_irq_rx_disable(uart);
@@ -176,6 +291,7 @@ static void uart_mcumgr_setup(struct device *uart)
 	uart_irq_callback_set(uart, uart_mcumgr_isr);
 
 	uart_irq_rx_enable(uart);
+#endif
 }
 
 void uart_mcumgr_register(uart_mcumgr_recv_fn *cb)
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Software alarms multiplexed on a counter channel
+ *
+ * Any number of alarms share a single counter channel: they are queued
+ * sorted by expiry and the channel is set, with a relative alarm, for the
+ * earliest one only. The counter interrupt calls all the expired alarms
+ * before setting the channel again.
+ */
+
+#include <kernel.h>
+#include <counter.h>
+#include <counter_mux.h>
+#include <errno.h>
+
+#define LOG_LEVEL CONFIG_COUNTER_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(counter_mux);
+
+/* Called with interrupts locked */
+static u64_t mux_now(struct counter_mux *mux)
+{
+	u32_t cnt = counter_read(mux->dev);
+	u32_t delta;
+
+	if (!counter_is_counting_up(mux->dev)) {
+		cnt = mux->top - cnt;
+	}
+
+	if (cnt >= mux->last) {
+		delta = cnt - mux->last;
+	} else {
+		/* Wrapped, which the guard alarm ensures happens once */
+		delta = mux->top - mux->last + cnt + 1U;
+	}
+
+	mux->last = cnt;
+	mux->now += delta;
+
+	return mux->now;
+}
+
+static void mux_isr(struct device *dev, u8_t chan_id, u32_t ticks,
+		    void *user_data);
+
+/* Called with interrupts locked */
+static int mux_program(struct counter_mux *mux)
+{
+	struct counter_mux_alarm *head;
+	struct counter_alarm_cfg cfg = {
+		.callback = mux_isr,
+		.user_data = mux,
+		.absolute = false,
+	};
+	u64_t now = mux_now(mux);
+	int err;
+
+	head = SYS_DLIST_PEEK_HEAD_CONTAINER(&mux->alarms, head, node);
+
+	if (head != NULL && head->expiry <= now) {
+		/* Expired while being queued, as soon as possible */
+		cfg.ticks = 1U;
+	} else if (head != NULL && head->expiry - now <= mux->guard) {
+		cfg.ticks = head->expiry - now;
+	} else {
+		cfg.ticks = mux->guard;
+	}
+
+	if (mux->armed) {
+		(void)counter_cancel_channel_alarm(mux->dev, mux->chan_id);
+	}
+
+	err = counter_set_channel_alarm(mux->dev, mux->chan_id, &cfg);
+	mux->armed = (err == 0);
+
+	if (err != 0) {
+		LOG_ERR("Failed to set channel %u (%d)", mux->chan_id, err);
+	}
+
+	return err;
+}
+
+static void mux_isr(struct device *dev, u8_t chan_id, u32_t ticks,
+		    void *user_data)
+{
+	struct counter_mux *mux = user_data;
+	struct counter_mux_alarm *alarm;
+	unsigned int key;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(chan_id);
+	ARG_UNUSED(ticks);
+
+	key = irq_lock();
+
+	/* The channel is free again in its handler */
+	mux->armed = false;
+	mux->dispatching = true;
+
+	/* Alarms started by the callbacks are called in this pass too */
+	while ((alarm = SYS_DLIST_PEEK_HEAD_CONTAINER(&mux->alarms, alarm,
+						      node)) != NULL &&
+	       alarm->expiry <= mux_now(mux)) {
+		sys_dlist_remove(&alarm->node);
+		alarm->callback(alarm, alarm->user_data);
+	}
+
+	mux->dispatching = false;
+	(void)mux_program(mux);
+
+	irq_unlock(key);
+}
+
+int counter_mux_init(struct counter_mux *mux, struct device *dev,
+		     u8_t chan_id)
+{
+	unsigned int key;
+	int err;
+
+	if (chan_id >= counter_get_num_of_channels(dev)) {
+		return -ENOTSUP;
+	}
+
+	mux->dev = dev;
+	mux->chan_id = chan_id;
+	mux->top = counter_get_top_value(dev);
+	mux->guard = counter_get_max_relative_alarm(dev) / 2U;
+	mux->now = 0U;
+	mux->armed = false;
+	mux->dispatching = false;
+	sys_dlist_init(&mux->alarms);
+
+	err = counter_start(dev);
+	if (err != 0) {
+		return err;
+	}
+
+	key = irq_lock();
+
+	/* Count from the current counter value */
+	mux->last = 0U;
+	(void)mux_now(mux);
+	mux->now = 0U;
+	err = mux_program(mux);
+
+	irq_unlock(key);
+
+	return err;
+}
+
+u64_t counter_mux_read(struct counter_mux *mux)
+{
+	unsigned int key = irq_lock();
+	u64_t now = mux_now(mux);
+
+	irq_unlock(key);
+
+	return now;
+}
+
+int counter_mux_alarm_start(struct counter_mux *mux,
+			    struct counter_mux_alarm *alarm,
+			    u64_t ticks, bool absolute)
+{
+	struct counter_mux_alarm *next;
+	unsigned int key;
+	bool first = true;
+	int err = 0;
+
+	key = irq_lock();
+
+	if (sys_dnode_is_linked(&alarm->node)) {
+		sys_dlist_remove(&alarm->node);
+	}
+
+	alarm->expiry = absolute ? ticks : mux_now(mux) + ticks;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&mux->alarms, next, node) {
+		if (next->expiry > alarm->expiry) {
+			sys_dlist_insert(&next->node, &alarm->node);
+			break;
+		}
+
+		first = false;
+	}
+
+	if (!sys_dnode_is_linked(&alarm->node)) {
+		sys_dlist_append(&mux->alarms, &alarm->node);
+	}
+
+	/* The interrupt sets the channel once done with the callbacks */
+	if (first && !mux->dispatching) {
+		err = mux_program(mux);
+	}
+
+	irq_unlock(key);
+
+	return err;
+}
+
+int counter_mux_alarm_cancel(struct counter_mux *mux,
+			     struct counter_mux_alarm *alarm)
+{
+	unsigned int key = irq_lock();
+	int err = -EINVAL;
+
+	/* The channel may still fire for it, finding nothing to call */
+	if (sys_dnode_is_linked(&alarm->node)) {
+		sys_dlist_remove(&alarm->node);
+		err = 0;
+	}
+
+	irq_unlock(key);
+
+	return err;
+}
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief AES driver for the ECB block of the nRF5 SoCs
+ *
+ * The ECB block encrypts a single AES-128 block at a time, from a key and
+ * clear text it reads from RAM. On top of it the driver provides the ECB
+ * encryption and the CTR encryption and decryption.
+ *
+ * Requests of all sessions are queued in the driver and run back to back
+ * from the ENDECB interrupt, one block each, so that a batch of requests
+ * only wakes up the app to complete them. The key is reloaded when the
+ * request of another session comes. Synchronous operations queue a request
+ * and wait for it.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <string.h>
+#include <soc.h>
+#include <crypto/cipher.h>
+#include <hal/nrf_ecb.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(crypto_nrf_ecb);
+
+#define ECB_AES_KEY_SIZE 16
+#define ECB_AES_BLOCK_SIZE 16
+
+#define CRYPTO_MAX_SESSION CONFIG_CRYPTO_NRF_ECB_MAX_SESSION
+
+struct ecb_data {
+	u8_t key[ECB_AES_KEY_SIZE];
+	u8_t clear_text[ECB_AES_BLOCK_SIZE];
+	u8_t cipher_text[ECB_AES_BLOCK_SIZE];
+} __packed;
+
+struct ecb_session {
+	bool in_use;
+	u8_t key[ECB_AES_KEY_SIZE];
+
+	/* Request of the cipher_xxx_op() of an async session */
+	struct cipher_req async_req;
+};
+
+struct ecb_sync_req {
+	struct cipher_req req;
+	struct k_sem done;
+	int status;
+};
+
+static struct {
+	/* Read by the ECB block, kept in RAM */
+	struct ecb_data data;
+
+	sys_slist_t queue;
+	struct cipher_req *cur;
+
+	/* Session whose key is loaded */
+	struct cipher_ctx *key_ctx;
+
+	/* Bytes of the current request done */
+	int offset;
+
+	/* Counter block of the current CTR request */
+	u8_t counter[ECB_AES_BLOCK_SIZE];
+
+	crypto_completion_cb async_cb;
+} ecb;
+
+static struct ecb_session ecb_sessions[CRYPTO_MAX_SESSION];
+
+static u8_t *ecb_out_buf(struct cipher_pkt *pkt)
+{
+	if (pkt->ctx->flags & CAP_INPLACE_OPS) {
+		return pkt->in_buf;
+	}
+
+	return pkt->out_buf;
+}
+
+static void ecb_counter_inc(u8_t *counter)
+{
+	int i;
+
+	/* 32 bit big endian counter, the last word of the block */
+	for (i = ECB_AES_BLOCK_SIZE - 1; i >= ECB_AES_BLOCK_SIZE - 4; i--) {
+		if (++counter[i] != 0U) {
+			break;
+		}
+	}
+}
+
+/* Called with the interrupts locked or from the ISR */
+static void ecb_block_start(void)
+{
+	struct cipher_req *req = ecb.cur;
+	struct cipher_ctx *ctx = req->ctx;
+
+	if (ecb.key_ctx != ctx) {
+		struct ecb_session *sessn = ctx->drv_sessn_state;
+
+		memcpy(ecb.data.key, sessn->key, sizeof(ecb.data.key));
+		ecb.key_ctx = ctx;
+	}
+
+	if (ctx->ops.cipher_mode == CRYPTO_CIPHER_MODE_ECB) {
+		memcpy(ecb.data.clear_text, req->pkt->in_buf,
+		       ECB_AES_BLOCK_SIZE);
+	} else {
+		memcpy(ecb.data.clear_text, ecb.counter, ECB_AES_BLOCK_SIZE);
+	}
+
+	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ENDECB);
+	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ERRORECB);
+	nrf_ecb_task_trigger(NRF_ECB, NRF_ECB_TASK_STARTECB);
+}
+
+/* Called with the interrupts locked or from the ISR */
+static void ecb_req_start(void)
+{
+	struct cipher_req *req;
+	struct cipher_ctx *ctx;
+	sys_snode_t *node;
+	int ivlen;
+
+	node = sys_slist_get(&ecb.queue);
+	if (node == NULL) {
+		ecb.cur = NULL;
+		return;
+	}
+
+	req = CONTAINER_OF(node, struct cipher_req, node);
+	ecb.cur = req;
+	ecb.offset = 0;
+
+	ctx = req->ctx;
+	if (ctx->ops.cipher_mode == CRYPTO_CIPHER_MODE_CTR) {
+		/* Split counter iv:ctr, the counter starting at 0 */
+		ivlen = ctx->keylen - (ctx->mode_params.ctr_info.ctr_len >> 3);
+
+		(void)memset(ecb.counter, 0, sizeof(ecb.counter));
+		memcpy(ecb.counter, req->iv, ivlen);
+	}
+
+	ecb_block_start();
+}
+
+static void ecb_req_done(int status)
+{
+	struct cipher_req *req = ecb.cur;
+
+	req->pkt->out_len = (status == 0) ? req->pkt->in_len : 0;
+
+	ecb_req_start();
+
+	req->cb(req, status);
+}
+
+static void ecb_isr(void *arg)
+{
+	struct cipher_req *req = ecb.cur;
+	struct cipher_pkt *pkt;
+	u8_t *out;
+	int len;
+	int i;
+
+	ARG_UNUSED(arg);
+
+	if (nrf_ecb_event_check(NRF_ECB, NRF_ECB_EVENT_ERRORECB)) {
+		nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ERRORECB);
+		LOG_ERR("ECB block aborted");
+		ecb_req_done(-EIO);
+		return;
+	}
+
+	if (!nrf_ecb_event_check(NRF_ECB, NRF_ECB_EVENT_ENDECB)) {
+		return;
+	}
+
+	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ENDECB);
+
+	pkt = req->pkt;
+	out = ecb_out_buf(pkt) + ecb.offset;
+
+	if (req->ctx->ops.cipher_mode == CRYPTO_CIPHER_MODE_ECB) {
+		memcpy(out, ecb.data.cipher_text, ECB_AES_BLOCK_SIZE);
+		ecb_req_done(0);
+		return;
+	}
+
+	len = MIN(pkt->in_len - ecb.offset, ECB_AES_BLOCK_SIZE);
+	for (i = 0; i < len; i++) {
+		out[i] = pkt->in_buf[ecb.offset + i] ^
+			 ecb.data.cipher_text[i];
+	}
+
+	ecb.offset += len;
+	if (ecb.offset < pkt->in_len) {
+		ecb_counter_inc(ecb.counter);
+		ecb_block_start();
+	} else {
+		ecb_req_done(0);
+	}
+}
+
+static int ecb_submit(struct device *dev, struct cipher_req *req)
+{
+	struct cipher_ctx *ctx = req->ctx;
+	struct cipher_pkt *pkt = req->pkt;
+	unsigned int key;
+
+	ARG_UNUSED(dev);
+
+	if (req->cb == NULL || ctx->drv_sessn_state == NULL) {
+		return -EINVAL;
+	}
+
+	if (ctx->ops.cipher_mode == CRYPTO_CIPHER_MODE_ECB &&
+	    pkt->in_len != ECB_AES_BLOCK_SIZE) {
+		LOG_ERR("ECB operates on a single block");
+		return -EINVAL;
+	}
+
+	if (!(ctx->flags & CAP_INPLACE_OPS) &&
+	    pkt->out_buf_max < pkt->in_len) {
+		LOG_ERR("Output buffer too small");
+		return -EINVAL;
+	}
+
+	pkt->ctx = ctx;
+
+	key = irq_lock();
+
+	sys_slist_append(&ecb.queue, &req->node);
+	if (ecb.cur == NULL) {
+		ecb_req_start();
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void ecb_sync_done(struct cipher_req *req, int status)
+{
+	struct ecb_sync_req *sync = CONTAINER_OF(req, struct ecb_sync_req, req);
+
+	sync->status = status;
+	k_sem_give(&sync->done);
+}
+
+static void ecb_async_done(struct cipher_req *req, int status)
+{
+	/* The session may queue its next operation from the callback */
+	req->cb = NULL;
+
+	if (ecb.async_cb) {
+		ecb.async_cb(req->pkt, status);
+	}
+}
+
+static int ecb_op(struct cipher_ctx *ctx, struct cipher_pkt *pkt, u8_t *iv)
+{
+	struct ecb_session *sessn = ctx->drv_sessn_state;
+	struct ecb_sync_req sync;
+	int err;
+
+	if (ctx->flags & CAP_ASYNC_OPS) {
+		/* One operation in flight per session, as for the pkt */
+		if (sessn->async_req.cb != NULL) {
+			return -EBUSY;
+		}
+
+		sessn->async_req = (struct cipher_req) {
+			.ctx = ctx,
+			.pkt = pkt,
+			.iv = iv,
+			.cb = ecb_async_done,
+		};
+
+		err = ecb_submit(ctx->device, &sessn->async_req);
+		if (err) {
+			sessn->async_req.cb = NULL;
+		}
+
+		return err;
+	}
+
+	sync.req = (struct cipher_req) {
+		.ctx = ctx,
+		.pkt = pkt,
+		.iv = iv,
+		.cb = ecb_sync_done,
+	};
+	k_sem_init(&sync.done, 0, 1);
+
+	err = ecb_submit(ctx->device, &sync.req);
+	if (err) {
+		return err;
+	}
+
+	k_sem_take(&sync.done, K_FOREVER);
+
+	return sync.status;
+}
+
+static int ecb_block_op(struct cipher_ctx *ctx, struct cipher_pkt *pkt)
+{
+	return ecb_op(ctx, pkt, NULL);
+}
+
+static int ecb_session_setup(struct device *dev, struct cipher_ctx *ctx,
+			     enum cipher_algo algo, enum cipher_mode mode,
+			     enum cipher_op op_type)
+{
+	struct ecb_session *sessn = NULL;
+	unsigned int key;
+	int i;
+
+	ARG_UNUSED(dev);
+
+	if (algo != CRYPTO_CIPHER_ALGO_AES) {
+		LOG_ERR("Unsupported algo");
+		return -EINVAL;
+	}
+
+	if (ctx->keylen != ECB_AES_KEY_SIZE) {
+		LOG_ERR("Unsupported key size");
+		return -EINVAL;
+	}
+
+	switch (mode) {
+	case CRYPTO_CIPHER_MODE_ECB:
+		/* The block has no inverse cipher */
+		if (op_type != CRYPTO_CIPHER_OP_ENCRYPT) {
+			LOG_ERR("ECB decryption not supported");
+			return -EINVAL;
+		}
+		ctx->ops.block_crypt_hndlr = ecb_block_op;
+		break;
+	case CRYPTO_CIPHER_MODE_CTR:
+		if (ctx->mode_params.ctr_info.ctr_len != 32U) {
+			LOG_ERR("Only 32 bit counter supported");
+			return -EINVAL;
+		}
+		ctx->ops.ctr_crypt_hndlr = ecb_op;
+		break;
+	default:
+		LOG_ERR("Unsupported mode");
+		return -EINVAL;
+	}
+
+	ctx->ops.cipher_mode = mode;
+
+	key = irq_lock();
+
+	for (i = 0; i < CRYPTO_MAX_SESSION; i++) {
+		if (!ecb_sessions[i].in_use) {
+			sessn = &ecb_sessions[i];
+			sessn->in_use = true;
+			break;
+		}
+	}
+
+	irq_unlock(key);
+
+	if (sessn == NULL) {
+		LOG_ERR("Max sessions in progress");
+		return -ENOSPC;
+	}
+
+	memcpy(sessn->key, ctx->key.bit_stream, ECB_AES_KEY_SIZE);
+	sessn->async_req.cb = NULL;
+	ctx->drv_sessn_state = sessn;
+
+	return 0;
+}
+
+static int ecb_session_free(struct device *dev, struct cipher_ctx *ctx)
+{
+	struct ecb_session *sessn = ctx->drv_sessn_state;
+	unsigned int key;
+
+	ARG_UNUSED(dev);
+
+	key = irq_lock();
+
+	/* A session of the same address must not reuse the loaded key */
+	if (ecb.key_ctx == ctx) {
+		ecb.key_ctx = NULL;
+	}
+
+	(void)memset(sessn, 0, sizeof(*sessn));
+
+	irq_unlock(key);
+
+	ctx->drv_sessn_state = NULL;
+
+	return 0;
+}
+
+static int ecb_query_caps(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return (CAP_RAW_KEY | CAP_INPLACE_OPS | CAP_SEPARATE_IO_BUFS |
+		CAP_SYNC_OPS | CAP_ASYNC_OPS);
+}
+
+static int ecb_callback_set(struct device *dev, crypto_completion_cb cb)
+{
+	ARG_UNUSED(dev);
+
+	ecb.async_cb = cb;
+
+	return 0;
+}
+
+static int ecb_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	sys_slist_init(&ecb.queue);
+
+	nrf_ecb_data_pointer_set(NRF_ECB, &ecb.data);
+	nrf_ecb_int_enable(NRF_ECB, NRF_ECB_INT_ENDECB_MASK |
+				    NRF_ECB_INT_ERRORECB_MASK);
+
+	IRQ_CONNECT(NRF5_IRQ_ECB_IRQn, CONFIG_CRYPTO_NRF_ECB_IRQ_PRI,
+		    ecb_isr, NULL, 0);
+	irq_enable(NRF5_IRQ_ECB_IRQn);
+
+	return 0;
+}
+
+static const struct crypto_driver_api ecb_api = {
+	.begin_session = ecb_session_setup,
+	.free_session = ecb_session_free,
+	.crypto_async_callback_set = ecb_callback_set,
+	.query_hw_caps = ecb_query_caps,
+	.submit = ecb_submit,
+};
+
+DEVICE_AND_API_INIT(crypto_nrf_ecb, CONFIG_CRYPTO_NRF_ECB_DRV_NAME,
+		    &ecb_init, NULL, NULL,
+		    POST_KERNEL, CONFIG_CRYPTO_INIT_PRIORITY,
+		    (void *)&ecb_api);
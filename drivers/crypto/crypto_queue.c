@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Generic crypto request queue
+ *
+ * Requests submitted to the drivers without a request queue of their own
+ * are run in a thread with the synchronous handlers of their session, in
+ * the order they were submitted. The thread runs through all the queued
+ * requests before sleeping again, so that a batch of requests costs a
+ * single wakeup.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <crypto/cipher.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(crypto_queue);
+
+static K_FIFO_DEFINE(crypto_queue_fifo);
+
+static K_THREAD_STACK_DEFINE(crypto_queue_stack,
+			     CONFIG_CRYPTO_QUEUE_STACK_SIZE);
+static struct k_thread crypto_queue_thread;
+
+int crypto_queue_submit(struct cipher_req *req)
+{
+	if (req->ctx == NULL || req->cb == NULL) {
+		return -EINVAL;
+	}
+
+	k_fifo_put(&crypto_queue_fifo, req);
+
+	return 0;
+}
+
+static void crypto_queue_process(void *p1, void *p2, void *p3)
+{
+	struct cipher_req *req;
+	int status;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		req = k_fifo_get(&crypto_queue_fifo, K_FOREVER);
+
+		status = cipher_req_run(req);
+		if (status != 0) {
+			LOG_DBG("Request %p failed (%d)", req, status);
+		}
+
+		req->cb(req, status);
+	}
+}
+
+static int crypto_queue_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_thread_create(&crypto_queue_thread, crypto_queue_stack,
+			K_THREAD_STACK_SIZEOF(crypto_queue_stack),
+			crypto_queue_process, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(CONFIG_CRYPTO_QUEUE_THREAD_PRIO), 0,
+			K_NO_WAIT);
+	k_thread_name_set(&crypto_queue_thread, "crypto_queue");
+
+	return 0;
+}
+
+SYS_INIT(crypto_queue_init, POST_KERNEL, CONFIG_CRYPTO_INIT_PRIORITY);
@@ -39,6 +39,9 @@ struct ili9340_data {
 #define ILI9340_RGB_SIZE 3U
 #endif
 
+/* Rows of a strided buffer sent in a single SPI transaction */
+#define ILI9340_ROWS_PER_WRITE 16U
+
 static void ili9340_exit_sleep(struct ili9340_data *data)
 {
 	ili9340_transmit(data, ILI9340_CMD_EXIT_SLEEP, NULL, 0);
@@ -133,11 +136,12 @@ static int ili9340_write(const struct device *dev, const u16_t x,
 {
 	struct ili9340_data *data = (struct ili9340_data *)dev->driver_data;
 	const u8_t *write_data_start = (u8_t *) buf;
-	struct spi_buf tx_buf;
+	struct spi_buf tx_buf[ILI9340_ROWS_PER_WRITE];
 	struct spi_buf_set tx_bufs;
 	u16_t write_cnt;
 	u16_t nbr_of_writes;
 	u16_t write_h;
+	u16_t i;
 
 	__ASSERT(desc->width <= desc->pitch, "Pitch is smaller then width");
 	__ASSERT((desc->pitch * ILI9340_RGB_SIZE * desc->height) <= desc->bu_size,
@@ -159,15 +163,20 @@ static int ili9340_write(const struct device *dev, const u16_t x,
 			 (void *) write_data_start,
 			 desc->width * ILI9340_RGB_SIZE * write_h);
 
-	tx_bufs.buffers = &tx_buf;
-	tx_bufs.count = 1;
+	tx_bufs.buffers = tx_buf;
 
+	/* the remaining rows are gathered to save per transaction overhead */
 	write_data_start += (desc->pitch * ILI9340_RGB_SIZE);
-	for (write_cnt = 1U; write_cnt < nbr_of_writes; ++write_cnt) {
-		tx_buf.buf = (void *)write_data_start;
-		tx_buf.len = desc->width * ILI9340_RGB_SIZE * write_h;
+	for (write_cnt = 1U; write_cnt < nbr_of_writes; write_cnt += i) {
+		for (i = 0U; i < ILI9340_ROWS_PER_WRITE &&
+			     write_cnt + i < nbr_of_writes; i++) {
+			tx_buf[i].buf = (void *)write_data_start;
+			tx_buf[i].len = desc->width * ILI9340_RGB_SIZE * write_h;
+			write_data_start += (desc->pitch * ILI9340_RGB_SIZE);
+		}
+
+		tx_bufs.count = i;
 		spi_write(data->spi_dev, &data->spi_config, &tx_bufs);
-		write_data_start += (desc->pitch * ILI9340_RGB_SIZE);
 	}
 
 	return 0;
@@ -178,10 +178,11 @@ int ssd1306_suspend(const struct device *dev)
 				 SSD1306_DISPLAY_OFF);
 }
 
-int ssd1306_write_page(const struct device *dev, u8_t page, void const *data,
-		       size_t length)
+int ssd1306_write_page(const struct device *dev, u8_t page, u8_t col,
+		       void const *data, size_t length)
 {
 	struct ssd1306_data *driver = dev->driver_data;
+	u8_t seg = DT_SOLOMON_SSD1306FB_0_SEGMENT_OFFSET + col;
 	u8_t cmd_buf[] = {
 #ifdef OLED_PANEL_CONTROLLER_SSD1306
 		SSD1306_CONTROL_BYTE_CMD,
@@ -191,12 +192,10 @@ int ssd1306_write_page(const struct device *dev, u8_t page, void const *data,
 #endif
 		SSD1306_CONTROL_BYTE_CMD,
 		SSD1306_SET_LOWER_COL_ADDRESS |
-		(DT_SOLOMON_SSD1306FB_0_SEGMENT_OFFSET &
-		 SSD1306_SET_LOWER_COL_ADDRESS_MASK),
+		(seg & SSD1306_SET_LOWER_COL_ADDRESS_MASK),
 		SSD1306_CONTROL_BYTE_CMD,
 		SSD1306_SET_HIGHER_COL_ADDRESS |
-		((DT_SOLOMON_SSD1306FB_0_SEGMENT_OFFSET  >> 4) &
-		 SSD1306_SET_LOWER_COL_ADDRESS_MASK),
+		((seg >> 4) & SSD1306_SET_HIGHER_COL_ADDRESS_MASK),
 		SSD1306_CONTROL_LAST_BYTE_CMD,
 		SSD1306_SET_PAGE_START_ADDRESS | page
 	};
@@ -205,7 +204,7 @@ int ssd1306_write_page(const struct device *dev, u8_t page, void const *data,
 		return -1;
 	}
 
-	if (length > SSD1306_PANEL_NUMOF_COLUMS) {
+	if (col + length > SSD1306_PANEL_NUMOF_COLUMS) {
 		return -1;
 	}
 
@@ -223,6 +222,9 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 		  const struct display_buffer_descriptor *desc,
 		  const void *buf)
 {
+	u8_t first_page = y / 8U;
+	u8_t num_pages = desc->height / 8U;
+
 	if (desc->pitch < desc->width) {
 		LOG_ERR("Pitch is smaller then width");
 		return -1;
@@ -238,8 +240,12 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 		return -1;
 	}
 
-	if (x != 0U && y != 0U) {
-		LOG_ERR("Unsupported origin");
+	/* regions are whole pages, as the LVGL rounding callback ensures */
+	if ((y % 8U) != 0U || (desc->height % 8U) != 0U ||
+	    x + desc->width > DT_SOLOMON_SSD1306FB_0_WIDTH ||
+	    first_page + num_pages > SSD1306_PANEL_NUMOF_PAGES ||
+	    desc->buf_size < desc->width * num_pages) {
+		LOG_ERR("Unsupported region");
 		return -1;
 	}
 
@@ -254,15 +260,15 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 		SSD1306_CONTROL_BYTE_CMD,
 		SSD1306_SET_COLUMN_ADDRESS,
 		SSD1306_CONTROL_BYTE_CMD,
-		0,
+		x,
 		SSD1306_CONTROL_BYTE_CMD,
-		(SSD1306_PANEL_NUMOF_COLUMS - 1),
+		(x + desc->width - 1),
 		SSD1306_CONTROL_BYTE_CMD,
 		SSD1306_SET_PAGE_ADDRESS,
 		SSD1306_CONTROL_BYTE_CMD,
-		0,
+		first_page,
 		SSD1306_CONTROL_LAST_BYTE_CMD,
-		(SSD1306_PANEL_NUMOF_PAGES - 1)
+		(first_page + num_pages - 1)
 	};
 
 	if (i2c_write(driver->i2c, cmd_buf, sizeof(cmd_buf),
@@ -273,20 +279,15 @@ int ssd1306_write(const struct device *dev, const u16_t x, const u16_t y,
 
 	return i2c_burst_write(driver->i2c, DT_SOLOMON_SSD1306FB_0_BASE_ADDRESS,
 			       SSD1306_CONTROL_LAST_BYTE_DATA,
-			       (u8_t *)buf, desc->buf_size);
+			       (u8_t *)buf, desc->width * num_pages);
 
 #elif defined(CONFIG_SSD1306_SH1106_COMPATIBLE)
-	if (desc->buf_size !=
-	    (SSD1306_PANEL_NUMOF_PAGES * DT_SOLOMON_SSD1306FB_0_WIDTH)) {
-		return -1;
-	}
-
-	for (size_t pidx = 0; pidx < SSD1306_PANEL_NUMOF_PAGES; pidx++) {
-		if (ssd1306_write_page(dev, pidx, buf,
-		    DT_SOLOMON_SSD1306FB_0_WIDTH)) {
+	for (size_t pidx = 0; pidx < num_pages; pidx++) {
+		if (ssd1306_write_page(dev, first_page + pidx, x, buf,
+				       desc->width)) {
 			return -1;
 		}
-		buf = (u8_t *)buf + DT_SOLOMON_SSD1306FB_0_WIDTH;
+		buf = (u8_t *)buf + desc->width;
 	}
 #endif
 
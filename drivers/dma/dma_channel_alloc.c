@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <dma.h>
+#include <errno.h>
+
+/* Channels are tracked in a 32-bit mask per controller */
+#define DMA_ALLOC_MAX_CHANNELS 32
+
+struct dma_channel_table {
+	struct device *dev;
+	u32_t used;
+};
+
+static struct dma_channel_table tables[CONFIG_DMA_CHANNEL_ALLOC_CONTROLLERS];
+
+static struct dma_channel_table *table_get(struct device *dev, bool create)
+{
+	struct dma_channel_table *free = NULL;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(tables); i++) {
+		if (tables[i].dev == dev) {
+			return &tables[i];
+		}
+
+		if (tables[i].dev == NULL && free == NULL) {
+			free = &tables[i];
+		}
+	}
+
+	if (create && free) {
+		free->dev = dev;
+		free->used = 0U;
+	}
+
+	return create ? free : NULL;
+}
+
+static u32_t channel_count(struct device *dev)
+{
+	const struct dma_driver_api *api =
+		(const struct dma_driver_api *)dev->driver_api;
+
+	if (api->get_channel_count == NULL) {
+		return 0;
+	}
+
+	return MIN(api->get_channel_count(dev), DMA_ALLOC_MAX_CHANNELS);
+}
+
+int dma_request_channel(struct device *dev, int channel)
+{
+	struct dma_channel_table *table;
+	u32_t count = channel_count(dev);
+	unsigned int key;
+	u32_t free;
+
+	if (channel == DMA_CHANNEL_ANY && count == 0U) {
+		return -ENOTSUP;
+	}
+
+	if (channel != DMA_CHANNEL_ANY &&
+	    (channel < 0 || channel >= DMA_ALLOC_MAX_CHANNELS ||
+	     (count && channel >= count))) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	table = table_get(dev, true);
+	if (table == NULL) {
+		irq_unlock(key);
+		return -ENOMEM;
+	}
+
+	if (channel == DMA_CHANNEL_ANY) {
+		free = ~table->used;
+		if (count < DMA_ALLOC_MAX_CHANNELS) {
+			free &= BIT_MASK(count);
+		}
+		channel = free ? find_lsb_set(free) - 1 : -EBUSY;
+	} else if (table->used & BIT(channel)) {
+		channel = -EBUSY;
+	}
+
+	if (channel >= 0) {
+		table->used |= BIT(channel);
+	}
+
+	irq_unlock(key);
+
+	return channel;
+}
+
+void dma_release_channel(struct device *dev, u32_t channel)
+{
+	struct dma_channel_table *table;
+	unsigned int key;
+
+	if (channel >= DMA_ALLOC_MAX_CHANNELS) {
+		return;
+	}
+
+	key = irq_lock();
+
+	table = table_get(dev, false);
+	if (table) {
+		table->used &= ~BIT(channel);
+	}
+
+	irq_unlock(key);
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <dma.h>
+#include <errno.h>
+#include <string.h>
+#include <soc.h>
+
+#define LOG_LEVEL CONFIG_DMA_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(dma_memcpy);
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1)
+#define DCACHE_INVALIDATE(addr, size) \
+	SCB_InvalidateDCache_by_Addr((u32_t *)addr, size)
+#define DCACHE_CLEAN(addr, size) \
+	SCB_CleanDCache_by_Addr((u32_t *)addr, size)
+#else
+#define DCACHE_INVALIDATE(addr, size) {; }
+#define DCACHE_CLEAN(addr, size) {; }
+#endif
+
+static void dma_memcpy_callback(void *arg, u32_t channel, int status);
+
+static int dma_memcpy_block_start(struct dma_memcpy *copy)
+{
+	size_t len = MIN(copy->remaining, CONFIG_DMA_MEMCPY_BLOCK_SIZE);
+	int ret;
+
+	(void)memset(&copy->blk, 0, sizeof(copy->blk));
+	copy->blk.source_address = (u32_t)copy->src;
+	copy->blk.dest_address = (u32_t)copy->dst;
+	copy->blk.block_size = len;
+
+	ret = dma_config(copy->dev, copy->channel, &copy->cfg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return dma_start(copy->dev, copy->channel);
+}
+
+static void dma_memcpy_finish(struct dma_memcpy *copy, int result)
+{
+	dma_release_channel(copy->dev, copy->channel);
+	copy->callback(copy, result);
+}
+
+static void dma_memcpy_callback(void *arg, u32_t channel, int status)
+{
+	struct dma_memcpy *copy = arg;
+	size_t len = copy->blk.block_size;
+	int ret;
+
+	ARG_UNUSED(channel);
+
+	if (status) {
+		LOG_ERR("Copy failed on channel %u (%d)", copy->channel,
+			status);
+		dma_memcpy_finish(copy, -EIO);
+		return;
+	}
+
+	/* lines cached meanwhile, e.g. by speculative reads, are stale */
+	DCACHE_INVALIDATE(copy->dst, len);
+
+	copy->src += len;
+	copy->dst += len;
+	copy->remaining -= len;
+
+	if (copy->remaining == 0U) {
+		dma_memcpy_finish(copy, 0);
+		return;
+	}
+
+	ret = dma_memcpy_block_start(copy);
+	if (ret < 0) {
+		dma_memcpy_finish(copy, ret);
+	}
+}
+
+int dma_memcpy_async(struct device *dev, struct dma_memcpy *copy,
+		     void *dst, const void *src, size_t len)
+{
+	u32_t width;
+	int channel;
+	int ret;
+
+	if (len == 0U || copy->callback == NULL) {
+		return -EINVAL;
+	}
+
+	channel = dma_request_channel(dev, DMA_CHANNEL_ANY);
+	if (channel < 0) {
+		return channel;
+	}
+
+	width = (((u32_t)dst | (u32_t)src | len) & 3U) ? 1U : 4U;
+
+	copy->dev = dev;
+	copy->channel = channel;
+	copy->dst = dst;
+	copy->src = src;
+	copy->remaining = len;
+
+	(void)memset(&copy->cfg, 0, sizeof(copy->cfg));
+	copy->cfg.channel_direction = MEMORY_TO_MEMORY;
+	copy->cfg.error_callback_en = 1U;
+	copy->cfg.source_data_size = width;
+	copy->cfg.dest_data_size = width;
+	copy->cfg.source_burst_length = 1U;
+	copy->cfg.dest_burst_length = 1U;
+	copy->cfg.block_count = 1U;
+	copy->cfg.head_block = &copy->blk;
+	copy->cfg.callback_arg = copy;
+	copy->cfg.dma_callback = dma_memcpy_callback;
+
+	/* dirty source lines must reach memory, and so must destination
+	 * ones before the DMA writes behind the cache
+	 */
+	DCACHE_CLEAN(src, len);
+	DCACHE_CLEAN(dst, len);
+
+	ret = dma_memcpy_block_start(copy);
+	if (ret < 0) {
+		dma_release_channel(dev, channel);
+	}
+
+	return ret;
+}
+
+struct dma_memcpy_sync {
+	struct dma_memcpy copy;
+	struct k_sem done;
+	int result;
+};
+
+static void dma_memcpy_sync_callback(struct dma_memcpy *copy, int result)
+{
+	struct dma_memcpy_sync *sync =
+		CONTAINER_OF(copy, struct dma_memcpy_sync, copy);
+
+	sync->result = result;
+	k_sem_give(&sync->done);
+}
+
+int dma_memcpy(struct device *dev, void *dst, const void *src, size_t len)
+{
+	struct dma_memcpy_sync sync;
+	int ret;
+
+	if (k_is_in_isr()) {
+		return -EWOULDBLOCK;
+	}
+
+	k_sem_init(&sync.done, 0, 1);
+	sync.copy.callback = dma_memcpy_sync_callback;
+
+	ret = dma_memcpy_async(dev, &sync.copy, dst, src, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_sem_take(&sync.done, K_FOREVER);
+
+	return sync.result;
+}
@@ -338,10 +338,22 @@ static int sam_xdmac_initialize(struct device *dev)
 	return 0;
 }
 
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+static u32_t sam_xdmac_get_channel_count(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return DMA_CHANNELS_NO;
+}
+#endif
+
 static const struct dma_driver_api sam_xdmac_driver_api = {
 	.config = sam_xdmac_config,
 	.start = sam_xdmac_transfer_start,
 	.stop = sam_xdmac_transfer_stop,
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	.get_channel_count = sam_xdmac_get_channel_count,
+#endif
 };
 
 /* DMA0 */
@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(dma_stm32f4x);
 
 #define DMA_STM32_MAX_STREAMS	8	/* Number of streams per controller */
 #define DMA_STM32_MAX_DEVS	2	/* Number of controllers */
+#define DMA_STM32_DISABLE_RETRIES	1000	/* Polls of a stopping stream, in us */
 #define DMA_STM32_1		0	/* First  DMA controller */
 #define DMA_STM32_2		1	/* Second DMA controller */
 
@@ -239,16 +240,26 @@ static void dma_stm32_irq_handler(void *arg, u32_t id)
 	/* Silently ignore spurious transfer half complete IRQ */
 	if (irqstatus & DMA_STM32_HTI) {
 		dma_stm32_irq_clear(ddata, id, DMA_STM32_HTI);
+
+		/* unless each half is a block to be notified */
+		if (config & DMA_STM32_SCR_HTIE) {
+			stream->dma_callback(stream->callback_arg, id, 0);
+		}
 		return;
 	}
 
-	stream->busy = false;
-
 	if ((irqstatus & DMA_STM32_TCI) && (config & DMA_STM32_SCR_TCIE)) {
 		dma_stm32_irq_clear(ddata, id, DMA_STM32_TCI);
 
+		/* Circular transfers keep running until stopped */
+		if (!(config & DMA_STM32_SCR_CIRC)) {
+			stream->busy = false;
+		}
+
 		stream->dma_callback(stream->callback_arg, id, 0);
 	} else {
+		stream->busy = false;
+
 		LOG_ERR("Internal error: IRQ status: 0x%x\n", irqstatus);
 		dma_stm32_irq_clear(ddata, id, irqstatus);
 
@@ -274,12 +285,16 @@ static int dma_stm32_disable_stream(struct dma_stm32_device *ddata,
 		dma_stm32_write(ddata, DMA_STM32_SCR(id),
 				config &= ~DMA_STM32_SCR_EN);
 
-		/* After trying for 5 seconds, give up */
-		k_sleep(K_SECONDS(5));
-		if (count++ > (5 * 1000) / 50) {
+		/*
+		 * The stream stops once its current data item is moved, so
+		 * poll briefly, which also works from interrupt context.
+		 */
+		if (count++ > DMA_STM32_DISABLE_RETRIES) {
 			LOG_ERR("DMA error: Stream in use\n");
 			return -EBUSY;
 		}
+
+		k_busy_wait(1);
 	}
 
 	return ret;
@@ -324,6 +339,19 @@ static int dma_stm32_config_devcpy(struct device *dev, u32_t id,
 		return -EINVAL;
 	}
 
+	/* Reloading the memory address makes the transfer circular */
+	if ((direction == MEMORY_TO_PERIPHERAL &&
+	     config->head_block->source_reload_en) ||
+	    (direction == PERIPHERAL_TO_MEMORY &&
+	     config->head_block->dest_reload_en)) {
+		regs->scr |= DMA_STM32_SCR_CIRC;
+
+		/* Per block callbacks, the two halves being the blocks */
+		if (config->complete_callback_en) {
+			regs->scr |= DMA_STM32_SCR_HTIE;
+		}
+	}
+
 	if (src_burst_size == BURST_TRANS_LENGTH_1 &&
 	    dst_burst_size == BURST_TRANS_LENGTH_1) {
 		/* Enable 'direct' mode error IRQ, disable 'FIFO' error IRQ */
@@ -338,13 +366,24 @@ static int dma_stm32_config_devcpy(struct device *dev, u32_t id,
 	return 0;
 }
 
+/*
+ * Memory to memory transfers follow dma.h, with data sizes and block sizes
+ * in bytes, as used by generic clients such as the memcpy service.
+ */
+static u32_t dma_stm32_width_bytes_index(u32_t size)
+{
+	return (size == 4U) ? 2 : (size == 2U) ? 1 : 0;
+}
+
 static int dma_stm32_config_memcpy(struct device *dev, u32_t id,
 				   struct dma_config *config)
 {
 	struct dma_stm32_device *ddata = dev->driver_data;
 	struct dma_stm32_stream_reg *regs = &ddata->stream[id].regs;
-	u32_t src_bus_width  = dma_width_index(config->source_data_size);
-	u32_t dst_bus_width  = dma_width_index(config->dest_data_size);
+	u32_t src_bus_width  =
+		dma_stm32_width_bytes_index(config->source_data_size);
+	u32_t dst_bus_width  =
+		dma_stm32_width_bytes_index(config->dest_data_size);
 	u32_t src_burst_size = dma_burst_index(config->source_burst_length);
 	u32_t dst_burst_size = dma_burst_index(config->dest_burst_length);
 
@@ -371,6 +410,7 @@ static int dma_stm32_config(struct device *dev, u32_t id,
 	struct dma_stm32_device *ddata = dev->driver_data;
 	struct dma_stm32_stream *stream = &ddata->stream[id];
 	struct dma_stm32_stream_reg *regs = &ddata->stream[id].regs;
+	u32_t items = config->head_block->block_size;
 	int ret;
 
 	if (id >= DMA_STM32_MAX_STREAMS) {
@@ -381,7 +421,12 @@ static int dma_stm32_config(struct device *dev, u32_t id,
 		return -EBUSY;
 	}
 
-	if (config->head_block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
+	if (config->channel_direction == MEMORY_TO_MEMORY) {
+		items /= (1U << dma_stm32_width_bytes_index(
+				       config->source_data_size));
+	}
+
+	if (items > DMA_STM32_MAX_DATA_ITEMS) {
 		LOG_ERR("DMA error: Data size too big: %d\n",
 		       config->head_block->block_size);
 		return -EINVAL;
@@ -412,7 +457,7 @@ static int dma_stm32_config(struct device *dev, u32_t id,
 		ret = dma_stm32_config_devcpy(dev, id, config);
 	}
 
-	regs->sndtr = config->head_block->block_size;
+	regs->sndtr = items;
 
 	return ret;
 }
@@ -539,6 +584,15 @@ static int dma_stm32_get_status(struct device *dev, u32_t id,
 	return 0;
 }
 
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+static u32_t dma_stm32_get_channel_count(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return DMA_STM32_MAX_STREAMS;
+}
+#endif
+
 static int dma_stm32_init(struct device *dev)
 {
 	struct dma_stm32_device *ddata = dev->driver_data;
@@ -573,6 +627,9 @@ static const struct dma_driver_api dma_funcs = {
 	.start		 = dma_stm32_start,
 	.stop		 = dma_stm32_stop,
 	.get_status 	 = dma_stm32_get_status,
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	.get_channel_count = dma_stm32_get_channel_count,
+#endif
 };
 
 const struct dma_stm32_config dma_stm32_1_cdata = {
@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <net/net_pkt.h>
 #include <net/net_if.h>
 #include <net/ethernet.h>
+#include <net/net_napi.h>
 #include <ethernet/eth_stats.h>
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
@@ -87,6 +88,9 @@ struct eth_context {
 	u8_t mac_addr[6];
 	struct k_work phy_work;
 	struct k_delayed_work delayed_phy_work;
+#if defined(CONFIG_NET_NAPI)
+	struct net_napi napi;
+#endif
 	/* TODO: FIXME. This Ethernet frame sized buffer is used for
 	 * interfacing with MCUX. How it works is that hardware uses
 	 * DMA scatter buffers to receive a frame, and then public
@@ -549,7 +553,8 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
-static void eth_rx(struct device *iface)
+/* Receive one frame, returns -EAGAIN if there is none */
+static int eth_rx(struct device *iface)
 {
 	struct eth_context *context = iface->driver_data;
 	u16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
@@ -564,6 +569,10 @@ static void eth_rx(struct device *iface)
 
 	status = ENET_GetRxFrameSize(&context->enet_handle,
 				     (uint32_t *)&frame_length);
+	if (status == kStatus_ENET_RxFrameEmpty) {
+		return -EAGAIN;
+	}
+
 	if (status) {
 		enet_data_error_stats_t error_stats;
 
@@ -652,7 +661,7 @@ static void eth_rx(struct device *iface)
 		goto error;
 	}
 
-	return;
+	return 0;
 flush:
 	/* Flush the current read buffer.  This operation can
 	 * only report failure if there is no frame to flush,
@@ -662,7 +671,31 @@ flush:
 	assert(status == kStatus_Success);
 error:
 	eth_stats_update_errors_rx(get_iface(context, vlan_tag));
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_NAPI)
+static int eth_rx_poll(struct net_napi *napi, int budget)
+{
+	struct eth_context *context =
+		CONTAINER_OF(napi, struct eth_context, napi);
+	struct device *dev = net_if_get_device(context->iface);
+	int done = 0;
+
+	while (done < budget && eth_rx(dev) == 0) {
+		done++;
+	}
+
+	if (done < budget) {
+		/* A frame received from now on raises the interrupt again */
+		net_napi_complete(napi);
+		ENET_EnableInterrupts(ENET, kENET_RxFrameInterrupt);
+	}
+
+	return done;
 }
+#endif /* CONFIG_NET_NAPI */
 
 #if defined(CONFIG_PTP_CLOCK_MCUX)
 static inline void ts_register_tx_event(struct eth_context *context)
@@ -711,7 +744,12 @@ static void eth_callback(ENET_Type *base, enet_handle_t *handle,
 
 	switch (event) {
 	case kENET_RxEvent:
+#if defined(CONFIG_NET_NAPI)
+		ENET_DisableInterrupts(ENET, kENET_RxFrameInterrupt);
+		net_napi_schedule(&context->napi);
+#else
 		eth_rx(iface);
+#endif
 		break;
 	case kENET_TxEvent:
 #if defined(CONFIG_PTP_CLOCK_MCUX)
@@ -899,6 +937,13 @@ static void eth_iface_init(struct net_if *iface)
 			     sizeof(context->mac_addr),
 			     NET_LINK_ETHERNET);
 
+#if defined(CONFIG_NET_NAPI)
+	/* Once for the device, not for each VLAN interface */
+	if (!context->iface) {
+		net_napi_init(&context->napi, iface, eth_rx_poll);
+	}
+#endif
+
 	/* For VLAN, this value is only used to get the correct L2 driver */
 	context->iface = iface;
 
@@ -483,59 +483,52 @@ static void tx_completed(Gmac *gmac, struct gmac_queue *queue)
 #if GMAC_MULTIPLE_TX_PACKETS == 0
 	k_sem_give(&queue->tx_sem);
 #else
+	ARG_UNUSED(gmac);
+
+	/* The sent frames are released in bulk from a thread */
+	k_work_submit(&queue->tx_reap_work);
+#endif
+}
+
+#if GMAC_MULTIPLE_TX_PACKETS == 1
+/*
+ * Release the fragments of the sent frames
+ */
+static void tx_reap(struct k_work *work)
+{
+	struct gmac_queue *queue =
+		CONTAINER_OF(work, struct gmac_queue, tx_reap_work);
 	struct gmac_desc_list *tx_desc_list = &queue->tx_desc_list;
 	struct gmac_desc *tx_desc;
 	struct net_buf *frag;
-#if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
-	struct net_pkt *pkt;
-	u16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
-	struct gptp_hdr *hdr;
-	struct eth_sam_dev_data *dev_data =
-		CONTAINER_OF(queue, struct eth_sam_dev_data,
-			     queue_list[queue->que_idx]);
-#endif
-
-	__ASSERT(tx_desc_list->buf[tx_desc_list->tail].w1 & GMAC_TXW1_USED,
-		 "first buffer of a frame is not marked as own by GMAC");
-
-	while (tx_desc_list->tail != tx_desc_list->head) {
-
-		tx_desc = &tx_desc_list->buf[tx_desc_list->tail];
-		MODULO_INC(tx_desc_list->tail, tx_desc_list->len);
-		k_sem_give(&queue->tx_desc_sem);
-
-		/* Release net buffer to the buffer pool */
-		frag = UINT_TO_POINTER(ring_buf_get(&queue->tx_frag_list));
-		net_pkt_frag_unref(frag);
-		LOG_DBG("Dropping frag %p", frag);
-
-		if (tx_desc->w1 & GMAC_TXW1_LASTBUFFER) {
-#if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
-			/* Release net packet to the packet pool */
-			pkt = UINT_TO_POINTER(ring_buf_get(&queue->tx_frames));
-#if defined(CONFIG_NET_VLAN)
-			struct net_eth_hdr *eth_hdr = NET_ETH_HDR(pkt);
-
-			if (ntohs(eth_hdr->type) == NET_ETH_PTYPE_VLAN) {
-				vlan_tag = net_pkt_vlan_tag(pkt);
-			}
-#endif
-			hdr = check_gptp_msg(get_iface(dev_data, vlan_tag),
-					     pkt, true);
+	unsigned int key;
+	bool last;
 
-			timestamp_tx_pkt(gmac, hdr, pkt);
+	/* The list may be flushed by tx_error_handler() */
+	key = irq_lock();
 
-			if (hdr && need_timestamping(hdr)) {
-				net_if_add_tx_timestamp(pkt);
-			}
-			net_pkt_unref(pkt);
-			LOG_DBG("Dropping pkt %p", pkt);
-#endif
-			break;
-		}
+	/* GMAC sets the used bit of the first buffer of a frame when the
+	 * frame is sent, the frames waiting for transmission have it cleared.
+	 */
+	while (tx_desc_list->tail != tx_desc_list->head &&
+	       (tx_desc_list->buf[tx_desc_list->tail].w1 & GMAC_TXW1_USED)) {
+		do {
+			tx_desc = &tx_desc_list->buf[tx_desc_list->tail];
+			last = (tx_desc->w1 & GMAC_TXW1_LASTBUFFER) != 0U;
+			MODULO_INC(tx_desc_list->tail, tx_desc_list->len);
+			k_sem_give(&queue->tx_desc_sem);
+
+			/* Release net buffer to the buffer pool */
+			frag = UINT_TO_POINTER(
+				ring_buf_get(&queue->tx_frag_list));
+			net_pkt_frag_unref(frag);
+			LOG_DBG("Dropping frag %p", frag);
+		} while (!last && tx_desc_list->tail != tx_desc_list->head);
 	}
-#endif
+
+	irq_unlock(key);
 }
+#endif
 
 /*
  * Reset TX queue when errors are detected
@@ -959,6 +952,7 @@ static int nonpriority_queue_init(Gmac *gmac, struct gmac_queue *queue)
 	 */
 	k_sem_init(&queue->tx_desc_sem, queue->tx_desc_list.len - 1,
 		   queue->tx_desc_list.len - 1);
+	k_work_init(&queue->tx_reap_work, tx_reap);
 #endif
 
 	/* Set Receive Buffer Queue Pointer Register */
@@ -1019,6 +1013,7 @@ static int priority_queue_init(Gmac *gmac, struct gmac_queue *queue)
 #else
 	k_sem_init(&queue->tx_desc_sem, queue->tx_desc_list.len - 1,
 		   queue->tx_desc_list.len - 1);
+	k_work_init(&queue->tx_reap_work, tx_reap);
 #endif
 
 	/* Setup RX buffer size for DMA */
@@ -1258,6 +1253,9 @@ static void eth_rx(struct gmac_queue *queue)
 		}
 #endif /* CONFIG_PTP_CLOCK_SAM_GMAC */
 
+		/* Keep the frames of each hardware queue on one Rx queue */
+		net_pkt_set_rx_hash(rx_frame, queue->que_idx);
+
 		if (net_recv_data(get_iface(dev_data, vlan_tag),
 				  rx_frame) < 0) {
 			eth_stats_update_errors_rx(get_iface(dev_data,
@@ -1352,7 +1350,13 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 		dcache_clean((u32_t)frag_data, frag->size);
 
 #if GMAC_MULTIPLE_TX_PACKETS == 1
-		k_sem_take(&queue->tx_desc_sem, K_FOREVER);
+		if (k_sem_take(&queue->tx_desc_sem, K_NO_WAIT) != 0) {
+			/* The list is full of frames being sent or waiting
+			 * for the doorbell, start them and wait for one.
+			 */
+			gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+			k_sem_take(&queue->tx_desc_sem, K_FOREVER);
+		}
 
 		/* The following section becomes critical and requires IRQ lock
 		 * / unlock protection only due to the possibility of executing
@@ -1442,10 +1446,10 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 	 */
 	__DMB();  /* data memory barrier */
 
+#if GMAC_MULTIPLE_TX_PACKETS == 0
 	/* Start transmission */
 	gmac->GMAC_NCR |= GMAC_NCR_TSTART;
 
-#if GMAC_MULTIPLE_TX_PACKETS == 0
 	/* Wait until the packet is sent */
 	k_sem_take(&queue->tx_sem, K_FOREVER);
 
@@ -1471,6 +1475,19 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
+#if GMAC_MULTIPLE_TX_PACKETS == 1
+static void eth_tx_flush(struct device *dev)
+{
+	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
+	Gmac *gmac = cfg->regs;
+
+	/* Start transmission of the frames queued since the last flush,
+	 * on all the queues.
+	 */
+	gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+}
+#endif
+
 static void queue0_isr(void *arg)
 {
 	struct device *const dev = (struct device *const)arg;
@@ -1772,6 +1789,8 @@ static enum ethernet_hw_caps eth_sam_gmac_get_capabilities(struct device *dev)
 	ARG_UNUSED(dev);
 
 	return ETHERNET_HW_VLAN | ETHERNET_LINK_10BASE_T |
+		ETHERNET_HW_TX_CHKSUM_OFFLOAD |
+		ETHERNET_HW_RX_CHKSUM_OFFLOAD |
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 		ETHERNET_PTP |
 #endif
@@ -1926,6 +1945,9 @@ static const struct ethernet_api eth_api = {
 	.set_config = eth_sam_gmac_set_config,
 	.get_config = eth_sam_gmac_get_config,
 	.send = eth_tx,
+#if GMAC_MULTIPLE_TX_PACKETS == 1
+	.tx_flush = eth_tx_flush,
+#endif
 
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 	.get_ptp_clock = eth_sam_gmac_get_ptp_clock,
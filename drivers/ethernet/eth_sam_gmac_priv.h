@@ -13,11 +13,14 @@
 #include <zephyr/types.h>
 
 /* This option enables support to push multiple packets to the DMA engine.
- * This currently doesn't work given the current version of net_pkt or
- * net_buf does not allowed access from multiple threads. This option is
- * therefore currenlty disabled.
+ * The fragments of the sent packets are released from a thread, as net_pkt
+ * and net_buf do not allow access from interrupt context.
  */
+#if defined(CONFIG_ETH_SAM_GMAC_TX_BATCH)
+#define GMAC_MULTIPLE_TX_PACKETS 1
+#else
 #define GMAC_MULTIPLE_TX_PACKETS 0
+#endif
 
 #define GMAC_MTU NET_ETH_MTU
 #define GMAC_FRAME_SIZE_MAX (GMAC_MTU + 18)
@@ -173,6 +176,7 @@ struct gmac_queue {
 	struct gmac_desc_list tx_desc_list;
 #if GMAC_MULTIPLE_TX_PACKETS == 1
 	struct k_sem tx_desc_sem;
+	struct k_work tx_reap_work;
 #else
 	struct k_sem tx_sem;
 #endif
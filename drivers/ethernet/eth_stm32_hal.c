@@ -26,11 +26,80 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #include "eth_stm32_hal_priv.h"
 
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+#define ETH_RX_DESC_COUNT CONFIG_ETH_STM32_HAL_BUF_RX_COUNT
+
+BUILD_ASSERT_MSG(CONFIG_ETH_STM32_HAL_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE
+		 >= ETH_MAX_PACKET_SIZE,
+		 "ETH_STM32_HAL_BUF_RX_COUNT * NET_BUF_DATA_SIZE are not "
+		 "large enough to hold a full frame");
+BUILD_ASSERT_MSG(CONFIG_ETH_STM32_HAL_BUF_RX_COUNT < CONFIG_NET_BUF_RX_COUNT,
+		 "Not enough RX buffers left to the network stack");
+BUILD_ASSERT_MSG((CONFIG_NET_BUF_DATA_SIZE & 0x3) == 0,
+		 "NET_BUF_DATA_SIZE must be a multiple of 4 bytes for RX DMA");
+
+#if CONFIG_NET_BUF_DATA_SIZE & (ETH_DCACHE_ALIGNMENT - 1)
+#pragma message "CONFIG_NET_BUF_DATA_SIZE should be a multiple of 32 bytes " \
+	"due to the D-cache line size"
+#endif
+
+/* The RX descriptors are given the data areas of network buffers */
+static ETH_DMADescTypeDef dma_rx_desc_tab[ETH_RX_DESC_COUNT]
+	__nocache __aligned(4);
+static struct net_buf *rx_frag_list[ETH_RX_DESC_COUNT];
+#else
 static ETH_DMADescTypeDef dma_rx_desc_tab[ETH_RXBUFNB] __aligned(4);
-static ETH_DMADescTypeDef dma_tx_desc_tab[ETH_TXBUFNB] __aligned(4);
 static u8_t dma_rx_buffer[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __aligned(4);
+#endif
+static ETH_DMADescTypeDef dma_tx_desc_tab[ETH_TXBUFNB] __aligned(4);
 static u8_t dma_tx_buffer[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __aligned(4);
 
+/*
+ * Cache helpers
+ */
+
+#if defined(CONFIG_CPU_CORTEX_M7)
+static bool dcache_enabled;
+
+static inline void dcache_invalidate(u32_t addr, u32_t size)
+{
+	if (!dcache_enabled) {
+		return;
+	}
+
+	/* Make sure it is aligned to 32B */
+	u32_t start_addr = addr & (u32_t)~(ETH_DCACHE_ALIGNMENT - 1);
+	u32_t size_full = size + addr - start_addr;
+
+	SCB_InvalidateDCache_by_Addr((uint32_t *)start_addr, size_full);
+}
+
+static inline void dcache_clean(u32_t addr, u32_t size)
+{
+	if (!dcache_enabled) {
+		return;
+	}
+
+	/* Make sure it is aligned to 32B */
+	u32_t start_addr = addr & (u32_t)~(ETH_DCACHE_ALIGNMENT - 1);
+	u32_t size_full = size + addr - start_addr;
+
+	SCB_CleanDCache_by_Addr((uint32_t *)start_addr, size_full);
+}
+#else
+static inline void dcache_invalidate(u32_t addr, u32_t size)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+}
+
+static inline void dcache_clean(u32_t addr, u32_t size)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_CPU_CORTEX_M7 */
+
 static inline void disable_mcast_filter(ETH_HandleTypeDef *heth)
 {
 	__ASSERT_NO_MSG(heth != NULL);
@@ -92,6 +161,9 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 		goto error;
 	}
 
+	/* Assure cache coherency before DMA read operation */
+	dcache_clean((u32_t)dma_buffer, total_len);
+
 	if (HAL_ETH_TransmitFrame(heth, total_len) != HAL_OK) {
 		LOG_ERR("HAL_ETH_TransmitFrame failed");
 		res = -EIO;
@@ -117,6 +189,187 @@ error:
 	return res;
 }
 
+static void rx_resume(ETH_HandleTypeDef *heth)
+{
+	/* When Rx Buffer unavailable flag is set: clear it
+	 * and resume reception.
+	 */
+	if ((heth->Instance->DMASR & ETH_DMASR_RBUS) != (u32_t)RESET) {
+		/* Clear RBUS ETHERNET DMA flag */
+		heth->Instance->DMASR = ETH_DMASR_RBUS;
+		/* Resume DMA reception */
+		heth->Instance->DMARPDR = 0;
+	}
+}
+
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+/*
+ * Give a network buffer to the DMA through an RX descriptor
+ */
+static void rx_desc_post(__IO ETH_DMADescTypeDef *desc, struct net_buf *frag)
+{
+	__ASSERT(!((u32_t)frag->data & 0x3), "Misaligned RX buffer address");
+
+	/* No dirty line may be written back over the DMA data, and no line
+	 * loaded before may hide it.
+	 */
+	dcache_invalidate((u32_t)frag->data, CONFIG_NET_BUF_DATA_SIZE);
+
+	desc->Buffer1Addr = (u32_t)frag->data;
+	desc->ControlBufferSize = (desc->ControlBufferSize &
+				   ~ETH_DMARXDESC_RBS1) |
+				  CONFIG_NET_BUF_DATA_SIZE;
+
+	/* Guarantee that the buffer is set before the ownership is given */
+	__DMB();
+	desc->Status = ETH_DMARXDESC_OWN;
+}
+
+static void free_rx_bufs(void)
+{
+	for (int i = 0; i < ETH_RX_DESC_COUNT; i++) {
+		if (rx_frag_list[i]) {
+			net_buf_unref(rx_frag_list[i]);
+			rx_frag_list[i] = NULL;
+		}
+	}
+}
+
+/*
+ * Initialize the chained RX descriptor list with network buffers
+ */
+static int rx_descriptors_init(ETH_HandleTypeDef *heth)
+{
+	ETH_DMADescTypeDef *desc;
+	struct net_buf *frag;
+
+	for (int i = 0; i < ETH_RX_DESC_COUNT; i++) {
+		frag = net_pkt_get_reserve_rx_data(K_NO_WAIT);
+		if (frag == NULL) {
+			free_rx_bufs();
+			LOG_ERR("Failed to reserve data net buffers");
+			return -ENOBUFS;
+		}
+
+		rx_frag_list[i] = frag;
+
+		desc = &dma_rx_desc_tab[i];
+		/* Interrupt on completion, second address chained */
+		desc->ControlBufferSize = ETH_DMARXDESC_RCH;
+		desc->Buffer2NextDescAddr =
+			(u32_t)&dma_rx_desc_tab[(i + 1) % ETH_RX_DESC_COUNT];
+
+		rx_desc_post(desc, frag);
+	}
+
+	heth->RxDesc = dma_rx_desc_tab;
+	heth->Instance->DMARDLAR = (u32_t)dma_rx_desc_tab;
+
+	return 0;
+}
+
+/*
+ * Turn the network buffers of the next complete frame into a packet,
+ * replacing them in the descriptors with buffers from the RX pool. The
+ * frame is dropped if there are not enough of them left.
+ */
+static struct net_pkt *eth_rx(struct device *dev)
+{
+	struct eth_stm32_hal_dev_data *dev_data = DEV_DATA(dev);
+	ETH_HandleTypeDef *heth = &dev_data->heth;
+	__IO ETH_DMADescTypeDef *desc = heth->RxDesc;
+	struct net_buf *last_frag = NULL;
+	struct net_buf *new_frag;
+	struct net_buf *frag;
+	struct net_pkt *pkt = NULL;
+	bool complete = false;
+	u32_t seg_count = 0U;
+	u32_t status = 0U;
+	u32_t frame_len;
+	u32_t frag_len;
+	u32_t i;
+
+	/* Check if there exists a complete frame in RX descriptor list */
+	while (!complete && seg_count < ETH_RX_DESC_COUNT &&
+	       !(desc->Status & ETH_DMARXDESC_OWN)) {
+		status = desc->Status;
+		complete = (status & ETH_DMARXDESC_LS) != 0U;
+		desc = (ETH_DMADescTypeDef *)desc->Buffer2NextDescAddr;
+		seg_count++;
+	}
+
+	if (!complete) {
+		return NULL;
+	}
+
+	/* Frame length of the last segment, without the CRC */
+	frame_len = ((status & ETH_DMARXDESC_FL) >>
+		     ETH_DMARXDESC_FRAMELENGTHSHIFT) - 4;
+
+	desc = heth->RxDesc;
+
+	if ((desc->Status & ETH_DMARXDESC_FS) &&
+	    !(status & ETH_DMARXDESC_ES)) {
+		pkt = net_pkt_rx_alloc_on_iface(dev_data->iface, K_NO_WAIT);
+		if (!pkt) {
+			LOG_ERR("Failed to obtain RX packet");
+		}
+	} else {
+		LOG_DBG("Dropping frame with error status 0x%08x", status);
+	}
+
+	for (i = 0U; i < seg_count; i++) {
+		u32_t idx = desc - dma_rx_desc_tab;
+
+		frag = rx_frag_list[idx];
+		__ASSERT(desc->Buffer1Addr == (u32_t)frag->data,
+			 "RX descriptor and buffer list desynchronized");
+
+		frag_len = MIN(frame_len, CONFIG_NET_BUF_DATA_SIZE);
+		frame_len -= frag_len;
+
+		/* Link frame fragments only if RX packet is valid, the last
+		 * segment may only hold the CRC.
+		 */
+		if (pkt != NULL && frag_len > 0) {
+			/* Assure cache coherency after DMA write operation */
+			dcache_invalidate((u32_t)frag->data, frag_len);
+
+			new_frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+			if (new_frag == NULL) {
+				LOG_ERR("Failed to obtain RX buffer");
+				net_pkt_unref(pkt);
+				pkt = NULL;
+			} else {
+				net_buf_add(frag, frag_len);
+				if (!last_frag) {
+					net_pkt_frag_insert(pkt, frag);
+				} else {
+					net_buf_frag_insert(last_frag, frag);
+				}
+
+				last_frag = frag;
+				frag = new_frag;
+				rx_frag_list[idx] = frag;
+			}
+		}
+
+		rx_desc_post(desc, frag);
+
+		desc = (ETH_DMADescTypeDef *)desc->Buffer2NextDescAddr;
+	}
+
+	heth->RxDesc = (ETH_DMADescTypeDef *)desc;
+
+	rx_resume(heth);
+
+	if (!pkt) {
+		eth_stats_update_errors_rx(dev_data->iface);
+	}
+
+	return pkt;
+}
+#else
 static struct net_pkt *eth_rx(struct device *dev)
 {
 	struct eth_stm32_hal_dev_data *dev_data;
@@ -143,6 +396,9 @@ static struct net_pkt *eth_rx(struct device *dev)
 	total_len = heth->RxFrameInfos.length;
 	dma_buffer = (u8_t *)heth->RxFrameInfos.buffer;
 
+	/* Assure cache coherency after DMA write operation */
+	dcache_invalidate((u32_t)dma_buffer, total_len);
+
 	pkt = net_pkt_rx_alloc_with_buffer(dev_data->iface, total_len,
 					   AF_UNSPEC, 0, K_NO_WAIT);
 	if (!pkt) {
@@ -171,15 +427,7 @@ release_desc:
 	/* Clear Segment_Count */
 	heth->RxFrameInfos.SegCount = 0;
 
-	/* When Rx Buffer unavailable flag is set: clear it
-	 * and resume reception.
-	 */
-	if ((heth->Instance->DMASR & ETH_DMASR_RBUS) != (u32_t)RESET) {
-		/* Clear RBUS ETHERNET DMA flag */
-		heth->Instance->DMASR = ETH_DMASR_RBUS;
-		/* Resume DMA reception */
-		heth->Instance->DMARPDR = 0;
-	}
+	rx_resume(heth);
 
 	if (!pkt) {
 		eth_stats_update_errors_rx(dev_data->iface);
@@ -187,13 +435,50 @@ release_desc:
 
 	return pkt;
 }
+#endif /* CONFIG_ETH_STM32_HAL_RX_ZERO_COPY */
+
+static void rx_frame(struct eth_stm32_hal_dev_data *dev_data,
+		     struct net_pkt *pkt)
+{
+	int res;
+
+	net_pkt_print_frags(pkt);
+	res = net_recv_data(dev_data->iface, pkt);
+	if (res < 0) {
+		eth_stats_update_errors_rx(dev_data->iface);
+		LOG_ERR("Failed to enqueue frame into RX queue: %d", res);
+		net_pkt_unref(pkt);
+	}
+}
 
+#if defined(CONFIG_NET_NAPI)
+static int rx_poll(struct net_napi *napi, int budget)
+{
+	struct eth_stm32_hal_dev_data *dev_data =
+		CONTAINER_OF(napi, struct eth_stm32_hal_dev_data, napi);
+	struct device *dev = net_if_get_device(dev_data->iface);
+	struct net_pkt *pkt;
+	int done = 0;
+
+	while (done < budget && (pkt = eth_rx(dev)) != NULL) {
+		rx_frame(dev_data, pkt);
+		done++;
+	}
+
+	if (done < budget) {
+		/* A frame received from now on raises the interrupt again */
+		net_napi_complete(napi);
+		__HAL_ETH_DMA_ENABLE_IT(&dev_data->heth, ETH_DMA_IT_R);
+	}
+
+	return done;
+}
+#else
 static void rx_thread(void *arg1, void *unused1, void *unused2)
 {
 	struct device *dev;
 	struct eth_stm32_hal_dev_data *dev_data;
 	struct net_pkt *pkt;
-	int res;
 
 	__ASSERT_NO_MSG(arg1 != NULL);
 	ARG_UNUSED(unused1);
@@ -208,17 +493,11 @@ static void rx_thread(void *arg1, void *unused1, void *unused2)
 		k_sem_take(&dev_data->rx_int_sem, K_FOREVER);
 
 		while ((pkt = eth_rx(dev)) != NULL) {
-			net_pkt_print_frags(pkt);
-			res = net_recv_data(dev_data->iface, pkt);
-			if (res < 0) {
-				eth_stats_update_errors_rx(dev_data->iface);
-				LOG_ERR("Failed to enqueue frame "
-					"into RX queue: %d", res);
-				net_pkt_unref(pkt);
-			}
+			rx_frame(dev_data, pkt);
 		}
 	}
 }
+#endif /* CONFIG_NET_NAPI */
 
 static void eth_isr(void *arg)
 {
@@ -250,7 +529,12 @@ void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef *heth_handle)
 
 	__ASSERT_NO_MSG(dev_data != NULL);
 
+#if defined(CONFIG_NET_NAPI)
+	__HAL_ETH_DMA_DISABLE_IT(heth_handle, ETH_DMA_IT_R);
+	net_napi_schedule(&dev_data->napi);
+#else
 	k_sem_give(&dev_data->rx_int_sem);
+#endif
 }
 
 static int eth_initialize(struct device *dev)
@@ -345,6 +629,10 @@ static void eth_iface_init(struct net_if *iface)
 
 	/* Initialize semaphores */
 	k_mutex_init(&dev_data->tx_mutex);
+
+#if defined(CONFIG_NET_NAPI)
+	net_napi_init(&dev_data->napi, iface, rx_poll);
+#else
 	k_sem_init(&dev_data->rx_int_sem, 0, UINT_MAX);
 
 	/* Start interruption-poll thread */
@@ -353,11 +641,23 @@ static void eth_iface_init(struct net_if *iface)
 			rx_thread, (void *) dev, NULL, NULL,
 			K_PRIO_COOP(CONFIG_ETH_STM32_HAL_RX_THREAD_PRIO),
 			0, K_NO_WAIT);
+#endif
+
+#if defined(CONFIG_CPU_CORTEX_M7)
+	/* Check the status of data caches */
+	dcache_enabled = (SCB->CCR & SCB_CCR_DC_Msk);
+#endif
 
 	HAL_ETH_DMATxDescListInit(heth, dma_tx_desc_tab,
 		&dma_tx_buffer[0][0], ETH_TXBUFNB);
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+	if (rx_descriptors_init(heth) < 0) {
+		return;
+	}
+#else
 	HAL_ETH_DMARxDescListInit(heth, dma_rx_desc_tab,
 		&dma_rx_buffer[0][0], ETH_RXBUFNB);
+#endif
 
 	HAL_ETH_Start(heth);
 
@@ -380,7 +680,12 @@ static enum ethernet_hw_caps eth_stm32_hal_get_capabilities(struct device *dev)
 {
 	ARG_UNUSED(dev);
 
-	return ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T;
+	return ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T
+#if defined(CONFIG_ETH_STM32_HAL_HW_CHECKSUM)
+		| ETHERNET_HW_TX_CHKSUM_OFFLOAD
+		| ETHERNET_HW_RX_CHKSUM_OFFLOAD
+#endif
+		;
 }
 
 static const struct ethernet_api eth_api = {
@@ -418,7 +723,11 @@ static struct eth_stm32_hal_dev_data eth0_data = {
 			.AutoNegotiation = ETH_AUTONEGOTIATION_ENABLE,
 			.PhyAddress = CONFIG_ETH_STM32_HAL_PHY_ADDRESS,
 			.RxMode = ETH_RXINTERRUPT_MODE,
+#if defined(CONFIG_ETH_STM32_HAL_HW_CHECKSUM)
+			.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE,
+#else
 			.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE,
+#endif
 #if defined(CONFIG_ETH_STM32_HAL_MII)
 			.MediaInterface = ETH_MEDIA_INTERFACE_MII,
 #else
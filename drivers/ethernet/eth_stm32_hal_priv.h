@@ -8,6 +8,7 @@
 
 #include <kernel.h>
 #include <zephyr/types.h>
+#include <net/net_napi.h>
 
 #define ETH_STM32_HAL_MTU NET_ETH_MTU
 #define ETH_STM32_HAL_FRAME_SIZE_MAX (ETH_STM32_HAL_MTU + 18)
@@ -16,6 +17,8 @@
 #define ETH_RX_BUF_SIZE	ETH_MAX_PACKET_SIZE /* buffer size for receive */
 #define ETH_TX_BUF_SIZE	ETH_MAX_PACKET_SIZE /* buffer size for transmit */
 
+#define ETH_DCACHE_ALIGNMENT 32
+
 /* Device constant configuration parameters */
 struct eth_stm32_hal_dev_cfg {
 	void (*config_func)(void);
@@ -33,10 +36,14 @@ struct eth_stm32_hal_dev_data {
 	/* clock device */
 	struct device *clock;
 	struct k_mutex tx_mutex;
+#if defined(CONFIG_NET_NAPI)
+	struct net_napi napi;
+#else
 	struct k_sem rx_int_sem;
 	K_THREAD_STACK_MEMBER(rx_thread_stack,
 		CONFIG_ETH_STM32_HAL_RX_THREAD_STACK_SIZE);
 	struct k_thread rx_thread;
+#endif
 };
 
 #define DEV_CFG(dev) \
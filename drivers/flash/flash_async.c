@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <kernel.h>
+#include <device.h>
+#include <flash.h>
+
+static K_FIFO_DEFINE(flash_async_fifo);
+
+static int flash_async_exec(struct flash_async_op *op)
+{
+	switch (op->type) {
+	case FLASH_ASYNC_READ:
+		return flash_read(op->dev, op->offset, op->dst, op->len);
+	case FLASH_ASYNC_WRITE:
+		return flash_write(op->dev, op->offset, op->src, op->len);
+	case FLASH_ASYNC_ERASE:
+		return flash_erase(op->dev, op->offset, op->len);
+	default:
+		return -EINVAL;
+	}
+}
+
+static void flash_async_thread(void *p1, void *p2, void *p3)
+{
+	struct flash_async_op *op;
+	struct k_poll_signal *signal;
+	flash_async_cb_t cb;
+	int result;
+
+	while (1) {
+		op = k_fifo_get(&flash_async_fifo, K_FOREVER);
+
+		result = flash_async_exec(op);
+
+		/* the op may be reused as soon as its completion is seen */
+		cb = op->cb;
+		signal = op->signal;
+		op->result = result;
+
+		if (cb) {
+			cb(op->dev, op, result);
+		}
+
+#if defined(CONFIG_POLL)
+		if (signal) {
+			k_poll_signal_raise(signal, result);
+		}
+#endif
+	}
+}
+
+K_THREAD_DEFINE(flash_async_tid, CONFIG_FLASH_ASYNC_STACK_SIZE,
+		flash_async_thread, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(CONFIG_FLASH_ASYNC_THREAD_PRIO), 0, K_NO_WAIT);
+
+int flash_async_submit(struct device *dev, struct flash_async_op *op)
+{
+	if (op->type != FLASH_ASYNC_READ && op->type != FLASH_ASYNC_WRITE &&
+	    op->type != FLASH_ASYNC_ERASE) {
+		return -EINVAL;
+	}
+
+	if (op->result == -EINPROGRESS) {
+		return -EBUSY;
+	}
+
+	op->dev = dev;
+	op->result = -EINPROGRESS;
+	k_fifo_put(&flash_async_fifo, op);
+
+	return 0;
+}
@@ -11,6 +11,7 @@
 #include <spi.h>
 #include <init.h>
 #include <string.h>
+#include <misc/byteorder.h>
 #include "spi_nor.h"
 #include "flash_priv.h"
 
@@ -37,12 +38,33 @@
 		(x) & 0xFF,	    \
 	}
 
+#if defined(CONFIG_SPI_NOR_READ_FAST)
+#define SPI_NOR_READ_OPCODE SPI_NOR_CMD_READ_FAST
+#define SPI_NOR_READ_DUMMY  1
+#else
+#define SPI_NOR_READ_OPCODE SPI_NOR_CMD_READ
+#define SPI_NOR_READ_DUMMY  0
+#endif
+
+#if defined(CONFIG_SPI_NOR_READ_CACHE)
+#define SPI_NOR_CACHE_LINE_SIZE CONFIG_SPI_NOR_READ_CACHE_LINE_SIZE
+#define SPI_NOR_CACHE_NO_ADDR   (-1)
+
+struct spi_nor_cache_line {
+	off_t addr;
+	u8_t data[SPI_NOR_CACHE_LINE_SIZE];
+};
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
 /**
  * struct spi_nor_data - Structure for defining the SPI NOR access
  * @spi: The SPI device
  * @spi_cfg: The SPI configuration
  * @cs_ctrl: The GPIO pin used to emulate the SPI CS if required
  * @sem: The semaphore to access to the flash
+ * @page_size: The page size, from the configuration or SFDP
+ * @erase_types: The supported erase commands, from DT or SFDP
+ * @cache: The read cache lines, direct mapped
  */
 struct spi_nor_data {
 	struct device *spi;
@@ -51,6 +73,11 @@ struct spi_nor_data {
 	struct spi_cs_control cs_ctrl;
 #endif /* DT_JEDEC_SPI_NOR_0_CS_GPIO_CONTROLLER */
 	struct k_sem sem;
+	u32_t page_size;
+	struct spi_nor_erase_type erase_types[SPI_NOR_ERASE_TYPES];
+#if defined(CONFIG_SPI_NOR_READ_CACHE)
+	struct spi_nor_cache_line cache[CONFIG_SPI_NOR_READ_CACHE_LINES];
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 };
 
 #if defined(CONFIG_MULTITHREADING)
@@ -71,6 +98,7 @@ struct spi_nor_data {
  * @param opcode The command to send
  * @param is_addressed A flag to define if the command is addressed
  * @param addr The address to send
+ * @param dummy The number of dummy bytes sent after the address
  * @param data The buffer to store or read the value
  * @param length The size of the buffer
  * @param is_write A flag to define if it's a read or a write command
@@ -78,21 +106,23 @@ struct spi_nor_data {
  */
 static int spi_nor_access(const struct device *const dev,
 			  u8_t opcode, bool is_addressed, off_t addr,
-			  void *data, size_t length, bool is_write)
+			  size_t dummy, void *data, size_t length,
+			  bool is_write)
 {
 	struct spi_nor_data *const driver_data = dev->driver_data;
 
-	u8_t buf[4] = {
+	u8_t buf[5] = {
 		opcode,
 		(addr & 0xFF0000) >> 16,
 		(addr & 0xFF00) >> 8,
 		(addr & 0xFF),
+		0,
 	};
 
 	struct spi_buf spi_buf[2] = {
 		{
 			.buf = buf,
-			.len = (is_addressed) ? 4 : 1,
+			.len = ((is_addressed) ? 4 : 1) + dummy,
 		},
 		{
 			.buf = data,
@@ -119,13 +149,15 @@ static int spi_nor_access(const struct device *const dev,
 }
 
 #define spi_nor_cmd_read(dev, opcode, dest, length) \
-	spi_nor_access(dev, opcode, false, 0, dest, length, false)
+	spi_nor_access(dev, opcode, false, 0, 0, dest, length, false)
 #define spi_nor_cmd_addr_read(dev, opcode, addr, dest, length) \
-	spi_nor_access(dev, opcode, true, addr, dest, length, false)
+	spi_nor_access(dev, opcode, true, addr, 0, dest, length, false)
+#define spi_nor_cmd_addr_read_dummy(dev, opcode, addr, dest, length) \
+	spi_nor_access(dev, opcode, true, addr, 1, dest, length, false)
 #define spi_nor_cmd_write(dev, opcode) \
-	spi_nor_access(dev, opcode, false, 0, NULL, 0, true)
+	spi_nor_access(dev, opcode, false, 0, 0, NULL, 0, true)
 #define spi_nor_cmd_addr_write(dev, opcode, addr, src, length) \
-	spi_nor_access(dev, opcode, true, addr, src, length, true)
+	spi_nor_access(dev, opcode, true, addr, 0, src, length, true)
 
 /**
  * @brief Retrieve the Flash JEDEC ID and compare it with the one expected
@@ -169,34 +201,59 @@ static int spi_nor_wait_until_ready(struct device *dev)
 	return ret;
 }
 
-static int spi_nor_read(struct device *dev, off_t addr, void *dest,
-			size_t size)
+/**
+ * @brief Wait until the flash is ready, sleeping between status polls
+ *
+ * Erases take milliseconds, polling the status without sleeping would keep
+ * all lower priority threads from running meanwhile.
+ *
+ * @param dev The device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_wait_until_ready_sleep(struct device *dev)
 {
-	struct spi_nor_data *const driver_data = dev->driver_data;
-	const struct spi_nor_config *params = dev->config->config_info;
 	int ret;
-	int to_read;
+	u8_t reg;
 
-	/* should be between 0 and flash size */
-	if ((addr < 0) || (addr + size) >  (params->sector_size
-					   * params->n_sectors)) {
-		return -EINVAL;
+	while (1) {
+		ret = spi_nor_cmd_read(dev, SPI_NOR_CMD_RDSR, &reg, 1);
+		if (ret || !(reg & SPI_NOR_WIP_BIT)) {
+			break;
+		}
+
+		if (k_is_in_isr()) {
+			continue;
+		}
+
+		k_sleep(K_MSEC(1));
 	}
 
-	SYNC_LOCK();
+	return ret;
+}
+
+/**
+ * @brief Read from the flash, in transfers as large as allowed
+ *
+ * The caller holds the lock.
+ */
+static int spi_nor_read_raw(struct device *dev, off_t addr, void *dest,
+			    size_t size)
+{
+	size_t to_read;
+	int ret;
 
 	spi_nor_wait_until_ready(dev);
 
 	while (size) {
 		to_read = size;
-		if (size > params->page_size) {
-			to_read = params->page_size;
+		if (CONFIG_SPI_NOR_READ_CHUNK_SIZE &&
+		    size > CONFIG_SPI_NOR_READ_CHUNK_SIZE) {
+			to_read = CONFIG_SPI_NOR_READ_CHUNK_SIZE;
 		}
 
-		ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr,
-					    dest, to_read);
+		ret = spi_nor_access(dev, SPI_NOR_READ_OPCODE, true, addr,
+				     SPI_NOR_READ_DUMMY, dest, to_read, false);
 		if (ret != 0) {
-			SYNC_UNLOCK();
 			return ret;
 		}
 
@@ -205,10 +262,95 @@ static int spi_nor_read(struct device *dev, off_t addr, void *dest,
 		dest = (u8_t *)dest + to_read;
 	}
 
-	SYNC_UNLOCK();
 	return 0;
 }
 
+#if defined(CONFIG_SPI_NOR_READ_CACHE)
+static void spi_nor_cache_invalidate(struct spi_nor_data *data, off_t addr,
+				     size_t size)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(data->cache); i++) {
+		if (data->cache[i].addr != SPI_NOR_CACHE_NO_ADDR &&
+		    data->cache[i].addr < addr + size &&
+		    data->cache[i].addr + SPI_NOR_CACHE_LINE_SIZE > addr) {
+			data->cache[i].addr = SPI_NOR_CACHE_NO_ADDR;
+		}
+	}
+}
+
+/**
+ * @brief Read through the cache
+ *
+ * Small reads, such as the ones of a file system walking its metadata, are
+ * served from cache lines. Reads of a line or more go to the flash.
+ */
+static int spi_nor_read_cached(struct device *dev, off_t addr, void *dest,
+			       size_t size)
+{
+	struct spi_nor_data *const data = dev->driver_data;
+	struct spi_nor_cache_line *line;
+	off_t line_addr;
+	size_t off, len;
+	int ret;
+
+	if (size >= SPI_NOR_CACHE_LINE_SIZE) {
+		return spi_nor_read_raw(dev, addr, dest, size);
+	}
+
+	while (size) {
+		line_addr = addr & ~(SPI_NOR_CACHE_LINE_SIZE - 1);
+		line = &data->cache[(line_addr / SPI_NOR_CACHE_LINE_SIZE) %
+				    ARRAY_SIZE(data->cache)];
+
+		if (line->addr != line_addr) {
+			line->addr = SPI_NOR_CACHE_NO_ADDR;
+			ret = spi_nor_read_raw(dev, line_addr, line->data,
+					       SPI_NOR_CACHE_LINE_SIZE);
+			if (ret != 0) {
+				return ret;
+			}
+			line->addr = line_addr;
+		}
+
+		off = addr - line_addr;
+		len = MIN(size, SPI_NOR_CACHE_LINE_SIZE - off);
+		memcpy(dest, &line->data[off], len);
+
+		size -= len;
+		addr += len;
+		dest = (u8_t *)dest + len;
+	}
+
+	return 0;
+}
+#else
+#define spi_nor_cache_invalidate(data, addr, size)
+#define spi_nor_read_cached spi_nor_read_raw
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
+static int spi_nor_read(struct device *dev, off_t addr, void *dest,
+			size_t size)
+{
+	struct spi_nor_data *const driver_data = dev->driver_data;
+	const struct spi_nor_config *params = dev->config->config_info;
+	int ret;
+
+	/* should be between 0 and flash size */
+	if ((addr < 0) || (addr + size) >  (params->sector_size
+					   * params->n_sectors)) {
+		return -EINVAL;
+	}
+
+	SYNC_LOCK();
+
+	ret = spi_nor_read_cached(dev, addr, dest, size);
+
+	SYNC_UNLOCK();
+	return ret;
+}
+
 static int spi_nor_write(struct device *dev, off_t addr, const void *src,
 			 size_t size)
 {
@@ -225,13 +367,17 @@ static int spi_nor_write(struct device *dev, off_t addr, const void *src,
 
 	SYNC_LOCK();
 
+	spi_nor_cache_invalidate(driver_data, addr, size);
+
 	while (size) {
 		/* write enable */
 		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
 
-		to_write = size;
-		if (size >= params->page_size) {
-			to_write = params->page_size;
+		/* a page program must not cross a page boundary */
+		to_write = driver_data->page_size -
+			   (addr & (driver_data->page_size - 1));
+		if (size < to_write) {
+			to_write = size;
 		}
 
 		ret = spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_PP, addr,
@@ -252,10 +398,43 @@ static int spi_nor_write(struct device *dev, off_t addr, const void *src,
 	return 0;
 }
 
+/**
+ * @brief Pick the largest erase command aligned at addr and within size
+ *
+ * @return The erase type, or NULL if none fits
+ */
+static const struct spi_nor_erase_type *
+spi_nor_erase_type_pick(const struct spi_nor_data *data, off_t addr,
+			size_t size)
+{
+	const struct spi_nor_erase_type *best = NULL;
+	const struct spi_nor_erase_type *erase;
+	u32_t erase_size;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(data->erase_types); i++) {
+		erase = &data->erase_types[i];
+		if (!erase->size_exp) {
+			continue;
+		}
+
+		erase_size = BIT(erase->size_exp);
+		if (size < erase_size || (addr & (erase_size - 1)) ||
+		    (best && best->size_exp >= erase->size_exp)) {
+			continue;
+		}
+
+		best = erase;
+	}
+
+	return best;
+}
+
 static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 {
 	struct spi_nor_data *const driver_data = dev->driver_data;
 	const struct spi_nor_config *params = dev->config->config_info;
+	const struct spi_nor_erase_type *erase;
 
 	/* should be between 0 and flash size */
 	if ((addr < 0) || ((size + addr) >
@@ -265,6 +444,8 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 
 	SYNC_LOCK();
 
+	spi_nor_cache_invalidate(driver_data, addr, size);
+
 	while (size) {
 		/* write enable */
 		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
@@ -273,36 +454,23 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 			/* chip erase */
 			spi_nor_cmd_write(dev, SPI_NOR_CMD_CE);
 			size -= (params->sector_size * params->n_sectors);
-		} else if ((DT_JEDEC_SPI_NOR_0_ERASE_BLOCK_SIZE == SZ_64K)
-			  && (size >= SZ_64K)
-			  && ((addr & MASK_64K) == 0)) {
-			/* 64 KiB block erase */
-			spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_BE, addr,
-			NULL, 0);
-			addr += SZ_64K;
-			size -= SZ_64K;
-		} else if ((DT_JEDEC_SPI_NOR_0_ERASE_BLOCK_SIZE == SZ_32K)
-			  && (size >= SZ_32K)
-			  && ((addr & MASK_32K) == 0)) {
-			/* 32 KiB block erase */
-			spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_BE_32K, addr,
-					       NULL, 0);
-			addr += SZ_32K;
-			size -= SZ_32K;
-		} else if ((size >= params->sector_size) &&
-			  ((addr & (params->sector_size - 1)) == 0)) {
-			/* sector erase */
-			spi_nor_cmd_addr_write(dev, SPI_NOR_CMD_SE, addr,
-					       NULL, 0);
-			addr += params->sector_size;
-			size -= params->sector_size;
 		} else {
-			/* minimal erase size is at least a sector size */
-			SYNC_UNLOCK();
-			return -EINVAL;
+			/* fewest erase commands: largest block that fits */
+			erase = spi_nor_erase_type_pick(driver_data, addr,
+							size);
+			if (!erase) {
+				/* minimal erase size is a sector size */
+				SYNC_UNLOCK();
+				return -EINVAL;
+			}
+
+			spi_nor_cmd_addr_write(dev, erase->opcode, addr,
+					       NULL, 0);
+			addr += BIT(erase->size_exp);
+			size -= BIT(erase->size_exp);
 		}
 
-		spi_nor_wait_until_ready(dev);
+		spi_nor_wait_until_ready_sleep(dev);
 	}
 
 	SYNC_UNLOCK();
@@ -327,6 +495,95 @@ static int spi_nor_write_protection_set(struct device *dev, bool write_protect)
 	return ret;
 }
 
+/**
+ * @brief Set the parameters the flash is known to support without SFDP
+ *
+ * @param dev The flash device structure
+ */
+static void spi_nor_params_default(struct device *dev)
+{
+	struct spi_nor_data *data = dev->driver_data;
+	const struct spi_nor_config *params = dev->config->config_info;
+	int n = 0;
+
+	data->page_size = params->page_size;
+
+	data->erase_types[n].opcode = SPI_NOR_CMD_SE;
+	data->erase_types[n++].size_exp = find_lsb_set(params->sector_size) - 1;
+
+	if (DT_JEDEC_SPI_NOR_0_ERASE_BLOCK_SIZE == SZ_32K) {
+		data->erase_types[n].opcode = SPI_NOR_CMD_BE_32K;
+		data->erase_types[n++].size_exp = 15;
+	}
+
+	if (DT_JEDEC_SPI_NOR_0_ERASE_BLOCK_SIZE == SZ_64K) {
+		data->erase_types[n].opcode = SPI_NOR_CMD_BE;
+		data->erase_types[n++].size_exp = 16;
+	}
+}
+
+#if defined(CONFIG_SPI_NOR_SFDP)
+/**
+ * @brief Discover the page size and erase commands with SFDP (JESD216)
+ *
+ * Only the Basic Flash Parameter Table is used. The flash size and layout
+ * remain the ones of the device tree.
+ *
+ * @param dev The flash device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_sfdp_probe(struct device *dev)
+{
+	struct spi_nor_data *data = dev->driver_data;
+	u32_t bfpt[SPI_NOR_SFDP_BFPT_DWORDS];
+	u8_t hdr[16];
+	size_t n_dwords;
+	u32_t dword;
+	int ret;
+	int i;
+
+	/* SFDP header followed by the first parameter header */
+	ret = spi_nor_cmd_addr_read_dummy(dev, SPI_NOR_CMD_RDSFDP, 0, hdr,
+					  sizeof(hdr));
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (sys_get_le32(&hdr[0]) != SPI_NOR_SFDP_SIGNATURE) {
+		return -ENOTSUP;
+	}
+
+	/* the first parameter table is the Basic Flash Parameter Table */
+	n_dwords = MIN(hdr[11], ARRAY_SIZE(bfpt));
+	if (hdr[8] != 0x00 || n_dwords < 9) {
+		return -ENOTSUP;
+	}
+
+	ret = spi_nor_cmd_addr_read_dummy(dev, SPI_NOR_CMD_RDSFDP,
+					  sys_get_le32(&hdr[12]) & 0xFFFFFF,
+					  bfpt, n_dwords * sizeof(u32_t));
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* 8th and 9th DWORDs: size exponent and opcode of 4 erase types */
+	(void)memset(data->erase_types, 0, sizeof(data->erase_types));
+	for (i = 0; i < SPI_NOR_ERASE_TYPES; i++) {
+		dword = sys_le32_to_cpu(bfpt[7 + i / 2]) >> ((i % 2) * 16);
+		data->erase_types[i].size_exp = dword & 0xFF;
+		data->erase_types[i].opcode = (dword >> 8) & 0xFF;
+	}
+
+	/* 11th DWORD, from JESD216A on: page size exponent */
+	if (n_dwords >= 11) {
+		dword = sys_le32_to_cpu(bfpt[10]);
+		data->page_size = BIT((dword >> 4) & 0xF);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SPI_NOR_SFDP */
+
 /**
  * @brief Configure the flash
  *
@@ -366,6 +623,19 @@ static int spi_nor_configure(struct device *dev)
 		return -ENODEV;
 	}
 
+	spi_nor_params_default(dev);
+
+#if defined(CONFIG_SPI_NOR_SFDP)
+	/* keep the defaults for a flash without SFDP */
+	if (spi_nor_sfdp_probe(dev) != 0) {
+		spi_nor_params_default(dev);
+	}
+#endif /* CONFIG_SPI_NOR_SFDP */
+
+#if defined(CONFIG_SPI_NOR_READ_CACHE)
+	spi_nor_cache_invalidate(data, 0, params->sector_size *
+				 params->n_sectors);
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 
 	return 0;
 }
@@ -18,6 +18,18 @@ struct spi_nor_config {
 	u32_t n_sectors;
 };
 
+/* Erase command, of 2^size_exp bytes, size_exp 0 if unused */
+struct spi_nor_erase_type {
+	u8_t opcode;
+	u8_t size_exp;
+};
+
+#define SPI_NOR_ERASE_TYPES	4
+
+/* SFDP (JESD216) */
+#define SPI_NOR_SFDP_SIGNATURE	0x50444653 /* "SFDP" */
+#define SPI_NOR_SFDP_BFPT_DWORDS	16
+
 /* Status register bits */
 #define SPI_NOR_WIP_BIT         BIT(0)  /* Write in progress */
 #define SPI_NOR_WEL_BIT         BIT(1)  /* Write enable latch */
@@ -26,6 +38,11 @@ struct spi_nor_config {
 #define SPI_NOR_CMD_WRSR        0x01    /* Write status register */
 #define SPI_NOR_CMD_RDSR        0x05    /* Read status register */
 #define SPI_NOR_CMD_READ        0x03    /* Read data */
+#define SPI_NOR_CMD_READ_FAST   0x0B    /* Read data, 1 dummy byte */
+#define SPI_NOR_CMD_DREAD       0x3B    /* Read data, 1-1-2 */
+#define SPI_NOR_CMD_2READ       0xBB    /* Read data, 1-2-2 */
+#define SPI_NOR_CMD_QREAD       0x6B    /* Read data, 1-1-4 */
+#define SPI_NOR_CMD_4READ       0xEB    /* Read data, 1-4-4 */
 #define SPI_NOR_CMD_WREN        0x06    /* Write enable */
 #define SPI_NOR_CMD_WRDI        0x04    /* Write disable */
 #define SPI_NOR_CMD_PP          0x02    /* Page program */
@@ -34,5 +51,6 @@ struct spi_nor_config {
 #define SPI_NOR_CMD_BE          0xD8    /* Block erase */
 #define SPI_NOR_CMD_CE          0xC7    /* Chip erase */
 #define SPI_NOR_CMD_RDID        0x9F    /* Read JEDEC ID */
+#define SPI_NOR_CMD_RDSFDP      0x5A    /* Read SFDP, 1 dummy byte */
 
 #endif /*__SPI_NOR_H__*/
@@ -43,3 +43,33 @@ Z_SYSCALL_HANDLER(gpio_get_pending_int, port)
 {
 	return z_impl_gpio_get_pending_int((struct device *)port);
 }
+
+Z_SYSCALL_HANDLER(gpio_pins_configure, port, pins, flags)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_GPIO(port, config));
+	return z_impl_gpio_pins_configure((struct device *)port, pins, flags);
+}
+
+Z_SYSCALL_HANDLER(gpio_port_set_masked, port, mask, value)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_GPIO(port, write));
+	return z_impl_gpio_port_set_masked((struct device *)port, mask, value);
+}
+
+Z_SYSCALL_HANDLER(gpio_port_set_bits, port, pins)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_GPIO(port, write));
+	return z_impl_gpio_port_set_bits((struct device *)port, pins);
+}
+
+Z_SYSCALL_HANDLER(gpio_port_clear_bits, port, pins)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_GPIO(port, write));
+	return z_impl_gpio_port_clear_bits((struct device *)port, pins);
+}
+
+Z_SYSCALL_HANDLER(gpio_port_toggle_bits, port, pins)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_GPIO(port, write));
+	return z_impl_gpio_port_toggle_bits((struct device *)port, pins);
+}
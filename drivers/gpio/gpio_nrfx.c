@@ -123,16 +123,13 @@ static int gpiote_pin_int_cfg(struct device *port, u32_t pin)
 	return res;
 }
 
-static int gpio_nrfx_config(struct device *port, int access_op,
-			    u32_t pin, int flags)
+static int gpio_nrfx_config_pins(struct device *port, u32_t pins, int flags)
 {
 	struct gpio_nrfx_data *data = get_port_data(port);
 	nrf_gpio_pin_pull_t pull;
 	nrf_gpio_pin_drive_t drive;
 	nrf_gpio_pin_dir_t dir;
 	nrf_gpio_pin_input_t input;
-	u8_t from_pin;
-	u8_t to_pin;
 
 	switch (flags & (GPIO_DS_LOW_MASK | GPIO_DS_HIGH_MASK)) {
 	case GPIO_DS_DFLT_LOW | GPIO_DS_DFLT_HIGH:
@@ -182,17 +179,13 @@ static int gpio_nrfx_config(struct device *port, int access_op,
 		? NRF_GPIO_PIN_INPUT_CONNECT
 		: NRF_GPIO_PIN_INPUT_DISCONNECT;
 
-	if (access_op == GPIO_ACCESS_BY_PORT) {
-		from_pin = 0U;
-		to_pin   = 31U;
-	} else {
-		from_pin = pin;
-		to_pin   = pin;
-	}
-
-	for (u8_t curr_pin = from_pin; curr_pin <= to_pin; ++curr_pin) {
+	for (u8_t curr_pin = 0U; curr_pin < 32; ++curr_pin) {
 		int res;
 
+		if ((pins & BIT(curr_pin)) == 0U) {
+			continue;
+		}
+
 		nrf_gpio_cfg(NRF_GPIO_PIN_MAP(get_port_cfg(port)->port_num,
 					      curr_pin),
 			     dir, input, pull, drive, NRF_GPIO_PIN_NOSENSE);
@@ -214,6 +207,14 @@ static int gpio_nrfx_config(struct device *port, int access_op,
 	return 0;
 }
 
+static int gpio_nrfx_config(struct device *port, int access_op,
+			    u32_t pin, int flags)
+{
+	u32_t pins = (access_op == GPIO_ACCESS_BY_PORT) ? UINT32_MAX : BIT(pin);
+
+	return gpio_nrfx_config_pins(port, pins, flags);
+}
+
 static int gpio_nrfx_write(struct device *port, int access_op,
 			   u32_t pin, u32_t value)
 {
@@ -233,6 +234,60 @@ static int gpio_nrfx_write(struct device *port, int access_op,
 	return 0;
 }
 
+static int gpio_nrfx_port_set_masked(struct device *port, u32_t mask,
+				     u32_t value)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	u32_t out = value ^ get_port_data(port)->inverted;
+
+	nrf_gpio_port_out_set(reg, out & mask);
+	nrf_gpio_port_out_clear(reg, ~out & mask);
+
+	return 0;
+}
+
+static int gpio_nrfx_port_set_bits(struct device *port, u32_t pins)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	u32_t inverted = get_port_data(port)->inverted;
+
+	if ((pins & ~inverted) != 0U) {
+		nrf_gpio_port_out_set(reg, pins & ~inverted);
+	}
+	if ((pins & inverted) != 0U) {
+		nrf_gpio_port_out_clear(reg, pins & inverted);
+	}
+
+	return 0;
+}
+
+static int gpio_nrfx_port_clear_bits(struct device *port, u32_t pins)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	u32_t inverted = get_port_data(port)->inverted;
+
+	if ((pins & ~inverted) != 0U) {
+		nrf_gpio_port_out_clear(reg, pins & ~inverted);
+	}
+	if ((pins & inverted) != 0U) {
+		nrf_gpio_port_out_set(reg, pins & inverted);
+	}
+
+	return 0;
+}
+
+static int gpio_nrfx_port_toggle_bits(struct device *port, u32_t pins)
+{
+	NRF_GPIO_Type *reg = get_port_cfg(port)->port;
+	u32_t out = nrf_gpio_port_out_read(reg);
+
+	/* OUTSET and OUTCLR leave concurrent updates of other pins intact */
+	nrf_gpio_port_out_set(reg, ~out & pins);
+	nrf_gpio_port_out_clear(reg, out & pins);
+
+	return 0;
+}
+
 static int gpio_nrfx_read(struct device *port, int access_op,
 			  u32_t pin, u32_t *value)
 {
@@ -311,7 +366,12 @@ static const struct gpio_driver_api gpio_nrfx_drv_api_funcs = {
 	.read = gpio_nrfx_read,
 	.manage_callback = gpio_nrfx_manage_callback,
 	.enable_callback = gpio_nrfx_pin_enable_callback,
-	.disable_callback = gpio_nrfx_pin_disable_callback
+	.disable_callback = gpio_nrfx_pin_disable_callback,
+	.config_pins = gpio_nrfx_config_pins,
+	.port_set_masked = gpio_nrfx_port_set_masked,
+	.port_set_bits = gpio_nrfx_port_set_bits,
+	.port_clear_bits = gpio_nrfx_port_clear_bits,
+	.port_toggle_bits = gpio_nrfx_port_toggle_bits,
 };
 
 static inline u32_t get_level_pins(struct device *port)
@@ -350,6 +350,75 @@ static int gpio_stm32_read(struct device *dev, int access_op,
 	return 0;
 }
 
+/**
+ * @brief Configure a set of pins
+ */
+static int gpio_stm32_config_pins(struct device *dev, u32_t pins, int flags)
+{
+	u32_t pin;
+	int ret;
+
+	for (pin = 0U; pins != 0U; pin++, pins >>= 1) {
+		if ((pins & 1U) == 0U) {
+			continue;
+		}
+
+		ret = gpio_stm32_config(dev, GPIO_ACCESS_BY_PIN, pin, flags);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Set and reset pins of the port in one BSRR write
+ */
+static int gpio_stm32_port_set_masked(struct device *dev, u32_t mask,
+				      u32_t value)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
+
+	mask &= 0xFFFF;
+	WRITE_REG(gpio->BSRR, (value & mask) | ((~value & mask) << 16));
+
+	return 0;
+}
+
+static int gpio_stm32_port_set_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
+
+	WRITE_REG(gpio->BSRR, pins & 0xFFFF);
+
+	return 0;
+}
+
+static int gpio_stm32_port_clear_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
+
+	WRITE_REG(gpio->BSRR, (pins & 0xFFFF) << 16);
+
+	return 0;
+}
+
+static int gpio_stm32_port_toggle_bits(struct device *dev, u32_t pins)
+{
+	const struct gpio_stm32_config *cfg = dev->config->config_info;
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)cfg->base;
+	u32_t odr = LL_GPIO_ReadOutputPort(gpio);
+
+	pins &= 0xFFFF;
+	WRITE_REG(gpio->BSRR, (~odr & pins) | ((odr & pins) << 16));
+
+	return 0;
+}
+
 static int gpio_stm32_manage_callback(struct device *dev,
 				      struct gpio_callback *callback,
 				      bool set)
@@ -394,7 +463,11 @@ static const struct gpio_driver_api gpio_stm32_driver = {
 	.manage_callback = gpio_stm32_manage_callback,
 	.enable_callback = gpio_stm32_enable_callback,
 	.disable_callback = gpio_stm32_disable_callback,
-
+	.config_pins = gpio_stm32_config_pins,
+	.port_set_masked = gpio_stm32_port_set_masked,
+	.port_set_bits = gpio_stm32_port_set_bits,
+	.port_clear_bits = gpio_stm32_port_clear_bits,
+	.port_toggle_bits = gpio_stm32_port_toggle_bits,
 };
 
 /**
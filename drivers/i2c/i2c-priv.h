@@ -35,6 +35,31 @@ static inline u32_t i2c_map_dt_bitrate(u32_t bitrate)
 	return 0;
 }
 
+#ifdef CONFIG_I2C_ASYNC
+/* Queue of the asynchronous transactions of a bus */
+struct i2c_async_queue {
+	sys_slist_t pending;
+	struct i2c_transaction *current;
+};
+
+/*
+ * Append a transaction, returns true if it became current and the driver
+ * must start it.
+ */
+bool i2c_async_queue_submit(struct i2c_async_queue *queue,
+			    struct i2c_transaction *t);
+
+/*
+ * Complete the current transaction, returns the next one the driver must
+ * start, or NULL if the queue is empty.
+ */
+struct i2c_transaction *i2c_async_queue_complete(struct i2c_async_queue *queue,
+						 int result);
+
+/* Notify the completion of a transaction */
+void i2c_transaction_done(struct i2c_transaction *t, int result);
+#endif /* CONFIG_I2C_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <i2c.h>
+#include "i2c-priv.h"
+
+void i2c_transaction_done(struct i2c_transaction *t, int result)
+{
+	struct k_poll_signal *signal = t->signal;
+
+	/* the callback may reuse the transaction */
+	if (t->callback != NULL) {
+		t->callback(t->dev, t, result);
+	}
+
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, result);
+	}
+}
+
+bool i2c_async_queue_submit(struct i2c_async_queue *queue,
+			    struct i2c_transaction *t)
+{
+	unsigned int key = irq_lock();
+	bool start = false;
+
+	if (queue->current == NULL) {
+		queue->current = t;
+		start = true;
+	} else {
+		sys_slist_append(&queue->pending, &t->node);
+	}
+
+	irq_unlock(key);
+
+	return start;
+}
+
+struct i2c_transaction *i2c_async_queue_complete(struct i2c_async_queue *queue,
+						 int result)
+{
+	struct i2c_transaction *done;
+	struct i2c_transaction *next;
+	sys_snode_t *node;
+	unsigned int key = irq_lock();
+
+	done = queue->current;
+	node = sys_slist_get(&queue->pending);
+	next = node ? CONTAINER_OF(node, struct i2c_transaction, node) : NULL;
+	queue->current = next;
+
+	irq_unlock(key);
+
+	if (done != NULL) {
+		i2c_transaction_done(done, result);
+	}
+
+	return next;
+}
+
+/*
+ * Fallback for drivers without native support: transactions are executed
+ * in order by the system workqueue.
+ */
+static void i2c_transfer_async_handler(struct k_work *work)
+{
+	struct i2c_transaction *t =
+		CONTAINER_OF(work, struct i2c_transaction, work);
+	const struct i2c_driver_api *api =
+		(const struct i2c_driver_api *)t->dev->driver_api;
+	int result;
+
+	result = api->transfer(t->dev, t->msgs, t->num_msgs, t->addr);
+	i2c_transaction_done(t, result);
+}
+
+int z_i2c_transfer_async_work(struct device *dev, struct i2c_transaction *t)
+{
+	ARG_UNUSED(dev);
+
+	k_work_init(&t->work, i2c_transfer_async_handler);
+	k_work_submit(&t->work);
+
+	return 0;
+}
@@ -45,14 +45,22 @@ static void i2c_gpio_set_scl(void *io_context, int state)
 {
 	struct i2c_gpio_context *context = io_context;
 
-	gpio_pin_write(context->gpio, context->scl_pin, state);
+	if (state) {
+		gpio_port_set_bits(context->gpio, BIT(context->scl_pin));
+	} else {
+		gpio_port_clear_bits(context->gpio, BIT(context->scl_pin));
+	}
 }
 
 static void i2c_gpio_set_sda(void *io_context, int state)
 {
 	struct i2c_gpio_context *context = io_context;
 
-	gpio_pin_write(context->gpio, context->sda_pin, state);
+	if (state) {
+		gpio_port_set_bits(context->gpio, BIT(context->sda_pin));
+	} else {
+		gpio_port_clear_bits(context->gpio, BIT(context->sda_pin));
+	}
 }
 
 static int i2c_gpio_get_sda(void *io_context)
@@ -8,6 +8,7 @@
 #include <i2c.h>
 #include <dt-bindings/i2c/i2c.h>
 #include <nrfx_twim.h>
+#include "i2c-priv.h"
 
 #define LOG_DOMAIN "i2c_nrfx_twim"
 #define LOG_LEVEL CONFIG_I2C_LOG_LEVEL
@@ -18,6 +19,13 @@ struct i2c_nrfx_twim_data {
 	struct k_sem transfer_sync;
 	struct k_sem completion_sync;
 	volatile nrfx_err_t res;
+#ifdef CONFIG_I2C_ASYNC
+	struct i2c_async_queue queue;
+	/* index of the next message of the current transaction */
+	u8_t msg_idx;
+	/* number of messages in the ongoing DMA transfer */
+	u8_t msg_cnt;
+#endif
 };
 
 struct i2c_nrfx_twim_config {
@@ -35,6 +43,168 @@ const struct i2c_nrfx_twim_config *get_dev_config(struct device *dev)
 	return dev->config->config_info;
 }
 
+#ifdef CONFIG_I2C_ASYNC
+/*
+ * Start the DMA transfer of the next messages of the current transaction.
+ * A write without stop followed by a read is executed as one TXRX transfer,
+ * the read starting with a repeated start from the LASTTX shortcut.
+ */
+static int twim_async_xfer_start(struct device *dev)
+{
+	struct i2c_nrfx_twim_data *data = get_dev_data(dev);
+	struct i2c_transaction *t = data->queue.current;
+	struct i2c_msg *msg = &t->msgs[data->msg_idx];
+	nrfx_twim_xfer_desc_t xfer = {
+		.p_primary_buf	= msg->buf,
+		.primary_length	= msg->len,
+		.address	= t->addr,
+		.type		= (msg->flags & I2C_MSG_READ) ?
+				  NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX
+	};
+	u32_t flags = 0U;
+	nrfx_err_t res;
+
+	data->msg_cnt = 1U;
+
+	if (xfer.type == NRFX_TWIM_XFER_TX && !(msg->flags & I2C_MSG_STOP)) {
+		if ((data->msg_idx + 1U < t->num_msgs) &&
+		    (msg[1].flags & I2C_MSG_READ)) {
+			xfer.type		= NRFX_TWIM_XFER_TXRX;
+			xfer.p_secondary_buf	= msg[1].buf;
+			xfer.secondary_length	= msg[1].len;
+			data->msg_cnt = 2U;
+		} else {
+			flags = NRFX_TWIM_FLAG_TX_NO_STOP;
+		}
+	}
+
+	res = nrfx_twim_xfer(&get_dev_config(dev)->twim, &xfer, flags);
+	if (res != NRFX_SUCCESS) {
+		return (res == NRFX_ERROR_BUSY) ? -EBUSY : -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * Start the transaction made current by the caller, and the following ones
+ * if it fails, until one is in progress or the queue is empty.
+ */
+static void twim_async_start(struct device *dev, struct i2c_transaction *t)
+{
+	struct i2c_nrfx_twim_data *data = get_dev_data(dev);
+	unsigned int key;
+	int ret;
+
+	while (t != NULL) {
+		data->msg_idx = 0U;
+		ret = twim_async_xfer_start(dev);
+		if (ret == 0) {
+			return;
+		}
+
+		t = i2c_async_queue_complete(&data->queue, ret);
+	}
+
+	/* a transaction submitted from a callback is started by its submitter */
+	key = irq_lock();
+	if (data->queue.current == NULL) {
+		nrfx_twim_disable(&get_dev_config(dev)->twim);
+	}
+	irq_unlock(key);
+}
+
+static void twim_async_event(struct device *dev, nrfx_err_t res)
+{
+	struct i2c_nrfx_twim_data *data = get_dev_data(dev);
+	struct i2c_transaction *t = data->queue.current;
+	int ret;
+
+	if (res == NRFX_SUCCESS) {
+		data->msg_idx += data->msg_cnt;
+		if (data->msg_idx < t->num_msgs) {
+			ret = twim_async_xfer_start(dev);
+			if (ret == 0) {
+				return;
+			}
+		} else {
+			ret = 0;
+		}
+	} else {
+		LOG_ERR("Error %d occurred for message %d", res,
+			data->msg_idx);
+		ret = -EIO;
+	}
+
+	twim_async_start(dev, i2c_async_queue_complete(&data->queue, ret));
+}
+
+static int i2c_nrfx_twim_transfer_async(struct device *dev,
+					struct i2c_transaction *t)
+{
+	struct i2c_nrfx_twim_data *data = get_dev_data(dev);
+
+	for (size_t i = 0; i < t->num_msgs; i++) {
+		if (I2C_MSG_ADDR_10_BITS & t->msgs[i].flags) {
+			return -ENOTSUP;
+		}
+	}
+
+	if (i2c_async_queue_submit(&data->queue, t)) {
+		nrfx_twim_enable(&get_dev_config(dev)->twim);
+		twim_async_start(dev, t);
+	}
+
+	return 0;
+}
+
+struct twim_sync_ctx {
+	struct k_sem sem;
+	int result;
+};
+
+static void twim_sync_callback(struct device *dev, struct i2c_transaction *t,
+			       int result)
+{
+	struct twim_sync_ctx *ctx = t->user_data;
+
+	ARG_UNUSED(dev);
+
+	ctx->result = result;
+	k_sem_give(&ctx->sem);
+}
+
+/* Synchronous transfers are queued behind the asynchronous ones */
+static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
+				  u8_t num_msgs, u16_t addr)
+{
+	struct twim_sync_ctx ctx;
+	struct i2c_transaction t = {
+		.dev = dev,
+		.msgs = msgs,
+		.num_msgs = num_msgs,
+		.addr = addr,
+		.callback = twim_sync_callback,
+		.user_data = &ctx,
+	};
+	int ret;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	k_sem_init(&ctx.sem, 0, 1);
+
+	ret = i2c_nrfx_twim_transfer_async(dev, &t);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_sem_take(&ctx.sem, K_FOREVER);
+
+	return ctx.result;
+}
+#else
 static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
 				  u8_t num_msgs, u16_t addr)
 {
@@ -85,6 +255,7 @@ static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
 
 	return ret;
 }
+#endif /* CONFIG_I2C_ASYNC */
 
 static void event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
 {
@@ -106,7 +277,11 @@ static void event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
 		break;
 	}
 
+#ifdef CONFIG_I2C_ASYNC
+	twim_async_event(dev, dev_data->res);
+#else
 	k_sem_give(&dev_data->completion_sync);
+#endif
 }
 
 static int i2c_nrfx_twim_configure(struct device *dev, u32_t dev_config)
@@ -135,6 +310,9 @@ static int i2c_nrfx_twim_configure(struct device *dev, u32_t dev_config)
 static const struct i2c_driver_api i2c_nrfx_twim_driver_api = {
 	.configure = i2c_nrfx_twim_configure,
 	.transfer  = i2c_nrfx_twim_transfer,
+#ifdef CONFIG_I2C_ASYNC
+	.transfer_async = i2c_nrfx_twim_transfer_async,
+#endif
 };
 
 static int init_twim(struct device *dev, const nrfx_twim_config_t *config)
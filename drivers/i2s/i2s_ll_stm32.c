@@ -652,6 +652,16 @@ static int i2s_stm32_initialize(struct device *dev)
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	if (dma_request_channel(dev_data->dev_dma,
+				dev_data->rx.dma_channel) < 0 ||
+	    dma_request_channel(dev_data->dev_dma,
+				dev_data->tx.dma_channel) < 0) {
+		LOG_ERR("%s streams in use", dev_data->dma_name);
+		return -EBUSY;
+	}
+#endif
+
 	LOG_INF("%s inited", dev->config->name);
 
 	return 0;
@@ -924,6 +924,16 @@ static int i2s_sam_initialize(struct device *dev)
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	if (dma_request_channel(dev_data->dev_dma,
+				dev_data->rx.dma_channel) < 0 ||
+	    dma_request_channel(dev_data->dev_dma,
+				dev_data->tx.dma_channel) < 0) {
+		LOG_ERR("%s channels in use", CONFIG_I2S_SAM_SSC_DMA_NAME);
+		return -EBUSY;
+	}
+#endif
+
 	/* Connect pins to the peripheral */
 	soc_gpio_list_configure(dev_cfg->pin_list, dev_cfg->pin_list_size);
 
@@ -33,6 +33,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #include <misc/byteorder.h>
 #include <string.h>
+#include <stdlib.h>
 #include <random/rand32.h>
 
 #include <net/ieee802154_radio.h>
@@ -49,6 +50,15 @@ static struct nrf5_802154_data nrf5_data;
 
 #define ACK_TIMEOUT K_MSEC(10)
 
+/* nrf5_tx() may wait behind all the queued frames */
+#define TX_TIMEOUT (ACK_TIMEOUT * (CONFIG_IEEE802154_NRF5_TX_QUEUE_SIZE + 1))
+
+#if defined(CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES)
+#define TX_ASYNC_RETRIES (CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES - 1)
+#else
+#define TX_ASYNC_RETRIES 0
+#endif
+
 /* Convenience defines for RADIO */
 #define NRF5_802154_DATA(dev) \
 	((struct nrf5_802154_data * const)(dev)->driver_data)
@@ -61,13 +71,77 @@ static void nrf5_get_eui64(u8_t *mac)
 	memcpy(mac, (const u32_t *)&NRF_FICR->DEVICEID, 8);
 }
 
+#if defined(CONFIG_IEEE802154_NRF5_RX_ZERO_COPY)
+/* Radio buffer wrapped by each buffer of nrf5_rx_pool */
+static u8_t *nrf5_rx_psdu[NRF_802154_RX_BUFFERS];
+
+static void nrf5_rx_destroy(struct net_buf *buf)
+{
+	u8_t *psdu = nrf5_rx_psdu[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+
+	nrf_802154_buffer_free_raw(psdu);
+}
+
+NET_BUF_POOL_DEFINE(nrf5_rx_pool, NRF_802154_RX_BUFFERS, 0, 0,
+		    nrf5_rx_destroy);
+
+/* The packet takes over the radio buffer, released with the packet */
+static struct net_pkt *nrf5_rx_pkt(struct nrf5_802154_data *nrf5_radio,
+				   u8_t *psdu, u8_t pkt_len)
+{
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	pkt = net_pkt_rx_alloc_on_iface(nrf5_radio->iface, K_NO_WAIT);
+	if (!pkt) {
+		nrf_802154_buffer_free_raw(psdu);
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(&nrf5_rx_pool, psdu + 1, pkt_len,
+				      K_NO_WAIT);
+	if (!buf) {
+		nrf_802154_buffer_free_raw(psdu);
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	nrf5_rx_psdu[net_buf_id(buf)] = psdu;
+	net_pkt_frag_add(pkt, buf);
+
+	return pkt;
+}
+#else
+static struct net_pkt *nrf5_rx_pkt(struct nrf5_802154_data *nrf5_radio,
+				   u8_t *psdu, u8_t pkt_len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(nrf5_radio->iface, pkt_len,
+					AF_UNSPEC, 0, K_NO_WAIT);
+	if (pkt && net_pkt_write(pkt, psdu + 1, pkt_len)) {
+		net_pkt_unref(pkt);
+		pkt = NULL;
+	}
+
+	nrf_802154_buffer_free_raw(psdu);
+
+	return pkt;
+}
+#endif /* CONFIG_IEEE802154_NRF5_RX_ZERO_COPY */
+
 static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 {
 	struct device *dev = (struct device *)arg1;
 	struct nrf5_802154_data *nrf5_radio = NRF5_802154_DATA(dev);
 	struct net_pkt *pkt;
 	struct nrf5_802154_rx_frame *rx_frame;
+	u8_t *psdu;
 	u8_t pkt_len;
+	u8_t lqi;
+	s8_t rssi;
 
 	ARG_UNUSED(arg2);
 	ARG_UNUSED(arg3);
@@ -97,47 +171,37 @@ static void nrf5_rx_thread(void *arg1, void *arg2, void *arg3)
 
 		LOG_DBG("Frame received");
 
-		pkt = net_pkt_alloc_with_buffer(nrf5_radio->iface, pkt_len,
-						AF_UNSPEC, 0, K_NO_WAIT);
+		/* Either copied or wrapped, the frame no longer needs its
+		 * entry of rx_frames, the radio callbacks may reuse it.
+		 */
+		psdu = rx_frame->psdu;
+		lqi = rx_frame->lqi;
+		rssi = rx_frame->rssi;
+		rx_frame->psdu = NULL;
+
+		pkt = nrf5_rx_pkt(nrf5_radio, psdu, pkt_len);
 		if (!pkt) {
 			LOG_ERR("No pkt available");
-			goto drop;
-		}
-
-		if (net_pkt_write(pkt, rx_frame->psdu + 1, pkt_len)) {
-			goto drop;
+			continue;
 		}
 
-		net_pkt_set_ieee802154_lqi(pkt, rx_frame->lqi);
-		net_pkt_set_ieee802154_rssi(pkt, rx_frame->rssi);
+		net_pkt_set_ieee802154_lqi(pkt, lqi);
+		net_pkt_set_ieee802154_rssi(pkt, rssi);
 
-		LOG_DBG("Caught a packet (%u) (LQI: %u)",
-			 pkt_len, rx_frame->lqi);
+		LOG_DBG("Caught a packet (%u) (LQI: %u)", pkt_len, lqi);
 
 		if (net_recv_data(nrf5_radio->iface, pkt) < 0) {
 			LOG_ERR("Packet dropped by NET stack");
-			goto drop;
+			net_pkt_unref(pkt);
+			continue;
 		}
 
-		nrf_802154_buffer_free_raw(rx_frame->psdu);
-		rx_frame->psdu = NULL;
-
 		if (LOG_LEVEL >= LOG_LEVEL_DBG) {
 			net_analyze_stack(
 				"nRF5 rx stack",
 				Z_THREAD_STACK_BUFFER(nrf5_radio->rx_stack),
 				K_THREAD_STACK_SIZEOF(nrf5_radio->rx_stack));
 		}
-
-		continue;
-
-drop:
-		nrf_802154_buffer_free_raw(rx_frame->psdu);
-		rx_frame->psdu = NULL;
-
-		if (pkt) {
-			net_pkt_unref(pkt);
-		}
 	}
 }
 
@@ -146,7 +210,8 @@ drop:
 static enum ieee802154_hw_caps nrf5_get_capabilities(struct device *dev)
 {
 	return IEEE802154_HW_FCS | IEEE802154_HW_2_4_GHZ |
-	       IEEE802154_HW_TX_RX_ACK | IEEE802154_HW_FILTER;
+	       IEEE802154_HW_TX_RX_ACK | IEEE802154_HW_FILTER |
+	       IEEE802154_HW_TX_ASYNC;
 }
 
 
@@ -257,55 +322,159 @@ static int nrf5_set_txpower(struct device *dev, s16_t dbm)
 	return 0;
 }
 
+static void nrf5_tx_start(struct nrf5_802154_tx_frame *frame)
+{
+	if (frame->csma_ca) {
+		nrf_802154_transmit_csma_ca_raw(frame->psdu);
+	} else if (!nrf_802154_transmit_raw(frame->psdu, false)) {
+		LOG_ERR("Cannot send frame");
+		nrf_802154_transmit_failed(frame->psdu,
+					   NRF_802154_TX_ERROR_ABORTED);
+	}
+}
+
+static int nrf5_tx_queue(struct device *dev, struct net_buf *frag,
+			 bool csma_ca, u8_t retries,
+			 ieee802154_tx_done_t done_cb, void *user_data)
+{
+	struct nrf5_802154_data *nrf5_radio = NRF5_802154_DATA(dev);
+	struct nrf5_802154_tx_frame *frame;
+	u8_t payload_len = frag->len;
+	unsigned int key;
+	bool start;
+
+	if (payload_len > NRF5_PSDU_LENGTH) {
+		return -EMSGSIZE;
+	}
+
+	k_sem_take(&nrf5_radio->tx_slots, K_FOREVER);
+	k_mutex_lock(&nrf5_radio->tx_lock, K_FOREVER);
+
+	/* The radio callbacks advance tx_head and decrease tx_count
+	 * together, so the free entry behind the queue does not move.
+	 */
+	frame = &nrf5_radio->tx_frames[(nrf5_radio->tx_head +
+					nrf5_radio->tx_count) %
+				       CONFIG_IEEE802154_NRF5_TX_QUEUE_SIZE];
+
+	frame->psdu[0] = payload_len + NRF5_FCS_LENGTH;
+	memcpy(frame->psdu + 1, frag->data, payload_len);
+	frame->done_cb = done_cb;
+	frame->user_data = user_data;
+	frame->retries = retries;
+	frame->csma_ca = csma_ca;
+
+	key = irq_lock();
+	start = (nrf5_radio->tx_count++ == 0U);
+	irq_unlock(key);
+
+	k_mutex_unlock(&nrf5_radio->tx_lock);
+
+	LOG_DBG("Queued frame %p (%u)%s", frame, payload_len,
+		start ? ", sending" : "");
+
+	/* Otherwise the radio callbacks start it after the previous one */
+	if (start) {
+		nrf5_tx_start(frame);
+	}
+
+	return 0;
+}
+
+static int nrf5_tx_async(struct device *dev,
+			 struct net_buf *frag,
+			 ieee802154_tx_done_t done_cb,
+			 void *user_data)
+{
+	return nrf5_tx_queue(dev, frag, true, TX_ASYNC_RETRIES,
+			     done_cb, user_data);
+}
+
+static void nrf5_tx_done(int result, void *user_data)
+{
+	struct nrf5_802154_data *nrf5_radio = user_data;
+
+	nrf5_radio->tx_result = result;
+
+	k_sem_give(&nrf5_radio->tx_wait);
+}
+
+static void nrf5_handle_ack(struct nrf5_802154_data *nrf5_radio)
+{
+	struct net_pkt *ack_pkt;
+	u8_t ack_len;
+
+	if (IS_ENABLED(CONFIG_IEEE802154_RAW_MODE) ||
+	    IS_ENABLED(CONFIG_NET_L2_OPENTHREAD)) {
+		ack_len = nrf5_radio->ack_psdu[0];
+	} else {
+		ack_len = nrf5_radio->ack_psdu[0] - NRF5_FCS_LENGTH;
+	}
+
+	ack_pkt = net_pkt_alloc_with_buffer(nrf5_radio->iface, ack_len,
+					    AF_UNSPEC, 0, K_NO_WAIT);
+	if (!ack_pkt) {
+		LOG_ERR("No free packet available.");
+		return;
+	}
+
+	if (net_pkt_write(ack_pkt, nrf5_radio->ack_psdu + 1, ack_len)) {
+		goto out;
+	}
+
+	net_pkt_set_ieee802154_lqi(ack_pkt, nrf5_radio->ack_lqi);
+	net_pkt_set_ieee802154_rssi(ack_pkt, nrf5_radio->ack_rssi);
+
+	net_pkt_cursor_init(ack_pkt);
+
+	if (ieee802154_radio_handle_ack(nrf5_radio->iface,
+					ack_pkt) != NET_OK) {
+		LOG_DBG("ACK packet not handled");
+	}
+
+out:
+	net_pkt_unref(ack_pkt);
+}
+
 static int nrf5_tx(struct device *dev,
 		   struct net_pkt *pkt,
 		   struct net_buf *frag)
 {
 	struct nrf5_802154_data *nrf5_radio = NRF5_802154_DATA(dev);
-	u8_t payload_len = frag->len;
-	u8_t *payload = frag->data;
+	int ret;
 
-	LOG_DBG("%p (%u)", payload, payload_len);
-
-	nrf5_radio->tx_psdu[0] = payload_len + NRF5_FCS_LENGTH;
-	memcpy(nrf5_radio->tx_psdu + 1, payload, payload_len);
+	LOG_DBG("%p (%u)", frag->data, frag->len);
 
 	/* Reset semaphore in case ACK was received after timeout */
 	k_sem_reset(&nrf5_radio->tx_wait);
+	nrf5_radio->ack_psdu[0] = 0U;
 
-	if (!nrf_802154_transmit_raw(nrf5_radio->tx_psdu, false)) {
-		LOG_ERR("Cannot send frame");
-		return -EIO;
+	ret = nrf5_tx_queue(dev, frag, false, 0, nrf5_tx_done, nrf5_radio);
+	if (ret) {
+		return ret;
 	}
 
 	LOG_DBG("Sending frame (ch:%d, txpower:%d)",
 		nrf_802154_channel_get(), nrf_802154_tx_power_get());
 
 	/* Wait for ack to be received */
-	if (k_sem_take(&nrf5_radio->tx_wait, ACK_TIMEOUT)) {
+	if (k_sem_take(&nrf5_radio->tx_wait, TX_TIMEOUT)) {
 		LOG_DBG("ACK not received");
 
-		if (!nrf_802154_receive()) {
-			LOG_ERR("Failed to switch back to receive state");
-		}
-
 		return -EIO;
 	}
 
-	LOG_DBG("Result: %d", nrf5_data.tx_result);
+	LOG_DBG("Result: %d", nrf5_radio->tx_result);
 
-	if (nrf5_radio->tx_result == NRF_802154_TX_ERROR_NONE) {
-		/* ACK frame not used currently. */
-		if (nrf5_radio->ack != NULL) {
-			nrf_802154_buffer_free_raw(nrf5_radio->ack);
-		}
-
-		nrf5_radio->ack = NULL;
+	if (nrf5_radio->tx_result) {
+		return -EIO;
+	}
 
-		return 0;
+	if (nrf5_radio->ack_psdu[0] != 0U && nrf5_radio->iface) {
+		nrf5_handle_ack(nrf5_radio);
 	}
 
-	return -EIO;
+	return 0;
 }
 
 static int nrf5_start(struct device *dev)
@@ -361,6 +530,12 @@ static int nrf5_init(struct device *dev)
 	k_fifo_init(&nrf5_radio->rx_fifo);
 	k_sem_init(&nrf5_radio->tx_wait, 0, 1);
 	k_sem_init(&nrf5_radio->cca_wait, 0, 1);
+	k_sem_init(&nrf5_radio->tx_slots, CONFIG_IEEE802154_NRF5_TX_QUEUE_SIZE,
+		   CONFIG_IEEE802154_NRF5_TX_QUEUE_SIZE);
+	k_mutex_init(&nrf5_radio->tx_lock);
+
+	/* Seeds the CSMA-CA backoffs of the radio driver */
+	srand(sys_rand32_get());
 
 	nrf_802154_init();
 
@@ -459,17 +634,65 @@ void nrf_802154_receive_failed(nrf_802154_rx_error_t error)
 	/* Intentionally empty. */
 }
 
+static void nrf5_tx_complete(nrf_802154_tx_error_t error)
+{
+	struct nrf5_802154_tx_frame *frame =
+		&nrf5_data.tx_frames[nrf5_data.tx_head];
+	ieee802154_tx_done_t done_cb = frame->done_cb;
+	void *user_data = frame->user_data;
+	unsigned int key;
+	bool next;
+
+	if ((error == NRF_802154_TX_ERROR_NO_ACK ||
+	     error == NRF_802154_TX_ERROR_BUSY_CHANNEL) && frame->retries) {
+		frame->retries--;
+		nrf5_tx_start(frame);
+		return;
+	}
+
+	key = irq_lock();
+	nrf5_data.tx_head = (nrf5_data.tx_head + 1) %
+			    CONFIG_IEEE802154_NRF5_TX_QUEUE_SIZE;
+	next = (--nrf5_data.tx_count > 0U);
+	irq_unlock(key);
+
+	/* Keep the radio busy before reporting this frame */
+	if (next) {
+		nrf5_tx_start(&nrf5_data.tx_frames[nrf5_data.tx_head]);
+	}
+
+	k_sem_give(&nrf5_data.tx_slots);
+
+	if (done_cb) {
+		done_cb(error == NRF_802154_TX_ERROR_NONE ? 0 :
+			error == NRF_802154_TX_ERROR_BUSY_CHANNEL ? -EBUSY :
+			-EIO, user_data);
+	}
+}
+
 void nrf_802154_transmitted_raw(const uint8_t *frame, uint8_t *ack,
 				int8_t power, uint8_t lqi)
 {
+	struct nrf5_802154_tx_frame *tx_frame =
+		&nrf5_data.tx_frames[nrf5_data.tx_head];
+
 	ARG_UNUSED(frame);
-	ARG_UNUSED(power);
-	ARG_UNUSED(lqi);
 
-	nrf5_data.tx_result = NRF_802154_TX_ERROR_NONE;
-	nrf5_data.ack = ack;
+	if (ack != NULL) {
+		/* Kept for nrf5_tx(), the L2 has no use of the ACKs of
+		 * the frames sent with tx_async.
+		 */
+		if (tx_frame->done_cb == nrf5_tx_done) {
+			memcpy(nrf5_data.ack_psdu, ack,
+			       MIN(ack[0] + 1U, sizeof(nrf5_data.ack_psdu)));
+			nrf5_data.ack_rssi = power;
+			nrf5_data.ack_lqi = lqi;
+		}
 
-	k_sem_give(&nrf5_data.tx_wait);
+		nrf_802154_buffer_free_immediately_raw(ack);
+	}
+
+	nrf5_tx_complete(NRF_802154_TX_ERROR_NONE);
 }
 
 void nrf_802154_transmit_failed(const uint8_t *frame,
@@ -477,9 +700,7 @@ void nrf_802154_transmit_failed(const uint8_t *frame,
 {
 	ARG_UNUSED(frame);
 
-	nrf5_data.tx_result = error;
-
-	k_sem_give(&nrf5_data.tx_wait);
+	nrf5_tx_complete(error);
 }
 
 void nrf_802154_cca_done(bool channel_free)
@@ -513,6 +734,7 @@ static struct ieee802154_radio_api nrf5_radio_api = {
 	.start = nrf5_start,
 	.stop = nrf5_stop,
 	.tx = nrf5_tx,
+	.tx_async = nrf5_tx_async,
 	.configure = nrf5_configure,
 };
 
@@ -21,6 +21,15 @@ struct nrf5_802154_rx_frame {
 	s8_t rssi; /* Last received frame RSSI value. */
 };
 
+struct nrf5_802154_tx_frame {
+	/* First byte is PHR (length), remaining bytes are MPDU data. */
+	u8_t psdu[NRF5_PHR_LENGTH + NRF5_PSDU_LENGTH + NRF5_FCS_LENGTH];
+	ieee802154_tx_done_t done_cb; /* Called with the result. */
+	void *user_data; /* Passed to done_cb. */
+	u8_t retries; /* Transmissions left after a failed one. */
+	bool csma_ca; /* Whether CSMA-CA precedes the transmission. */
+};
+
 struct nrf5_802154_data {
 	/* Pointer to the network interface. */
 	struct net_if *iface;
@@ -48,23 +57,33 @@ struct nrf5_802154_data {
 	/* CCA result. Holds information whether channel is free or not. */
 	bool channel_free;
 
-	/* TX synchronization semaphore. Unlocked when frame has been
-	 * sent or send procedure failed.
+	/* TX synchronization semaphore. Unlocked when a frame sent by
+	 * nrf5_tx() has been sent or send procedure failed.
 	 */
 	struct k_sem tx_wait;
 
-	/* TX buffer. First byte is PHR (length), remaining bytes are
-	 * MPDU data.
-	 */
-	u8_t tx_psdu[NRF5_PHR_LENGTH + NRF5_PSDU_LENGTH + NRF5_FCS_LENGTH];
+	/* Result of the last frame sent by nrf5_tx(). */
+	int tx_result;
 
-	/* TX result, updated in radio transmit callbacks. */
-	u8_t tx_result;
+	/* ACK received for the last frame sent by nrf5_tx(), handed to
+	 * the L2 once sent. First byte is PHR (length), 0 if no ACK.
+	 */
+	u8_t ack_psdu[NRF5_PHR_LENGTH + NRF5_PSDU_LENGTH + NRF5_FCS_LENGTH];
+	u8_t ack_lqi;
+	s8_t ack_rssi;
 
-	/* A pointer to the received ACK frame. May be NULL if no ACK was
-	 * requested/received.
+	/* TX queue, frames are sent back to back from the radio callbacks.
+	 * tx_head is the frame in progress, tx_count the number queued.
 	 */
-	u8_t *ack;
+	struct nrf5_802154_tx_frame tx_frames[CONFIG_IEEE802154_NRF5_TX_QUEUE_SIZE];
+	u8_t tx_head;
+	u8_t tx_count;
+
+	/* Free TX queue entries. */
+	struct k_sem tx_slots;
+
+	/* Serializes the producers of the TX queue. */
+	struct k_mutex tx_lock;
 };
 
 #endif /* ZEPHYR_DRIVERS_IEEE802154_IEEE802154_NRF5_H_ */
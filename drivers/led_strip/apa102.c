@@ -8,16 +8,37 @@
 #include <led_strip.h>
 #include <spi.h>
 
+static const u8_t zeros[] = {0, 0, 0, 0};
+static const u8_t ones[] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+#ifdef CONFIG_LED_STRIP_ASYNC
+/*
+ * Frame transmitted asynchronously, from the pixels of the caller. The
+ * signal is the one of the transmission in flight, if any.
+ */
+struct apa102_frame {
+	struct spi_buf bufs[3];
+	struct spi_buf_set tx;
+	struct k_poll_signal done;
+	struct k_poll_signal *signal;
+#ifdef CONFIG_SPI_QUEUE
+	struct spi_transaction t;
+#endif
+};
+#endif
+
 struct apa102_data {
 	struct device *spi;
 	struct spi_config cfg;
+#ifdef CONFIG_LED_STRIP_ASYNC
+	struct apa102_frame frames[2];
+	u8_t next;
+#endif
 };
 
 static int apa102_update(struct device *dev, void *buf, size_t size)
 {
 	struct apa102_data *data = dev->driver_data;
-	static const u8_t zeros[] = {0, 0, 0, 0};
-	static const u8_t ones[] = {0xFF, 0xFF, 0xFF, 0xFF};
 	const struct spi_buf tx_bufs[] = {
 		{
 			/* Start frame: at least 32 zeros */
@@ -46,15 +67,14 @@ static int apa102_update(struct device *dev, void *buf, size_t size)
 	return spi_write(data->spi, &data->cfg, &tx);
 }
 
-static int apa102_update_rgb(struct device *dev, struct led_rgb *pixels,
-			     size_t count)
+/* Rewrite to the on-wire format, in place */
+static void apa102_encode(struct led_rgb *pixels, size_t count)
 {
 	u8_t *p = (u8_t *)pixels;
 	size_t i;
 	/* SOF (3 bits) followed by the 0 to 31 global dimming level */
 	u8_t prefix = 0xE0 | 31;
 
-	/* Rewrite to the on-wire format */
 	for (i = 0; i < count; i++) {
 		u8_t r = pixels[i].r;
 		u8_t g = pixels[i].g;
@@ -65,11 +85,80 @@ static int apa102_update_rgb(struct device *dev, struct led_rgb *pixels,
 		*p++ = g;
 		*p++ = r;
 	}
+}
+
+static int apa102_update_rgb(struct device *dev, struct led_rgb *pixels,
+			     size_t count)
+{
+	apa102_encode(pixels, count);
 
 	BUILD_ASSERT(sizeof(struct led_rgb) == 4);
 	return apa102_update(dev, pixels, sizeof(struct led_rgb) * count);
 }
 
+#ifdef CONFIG_LED_STRIP_ASYNC
+/*
+ * The frame is sent from the pixels, which must stay untouched until it
+ * has been transmitted; the caller alternates between two of them.
+ */
+static int apa102_update_rgb_async(struct device *dev,
+				   struct led_rgb *pixels, size_t count,
+				   struct k_poll_signal *signal)
+{
+	struct apa102_data *data = dev->driver_data;
+	struct apa102_frame *frame = &data->frames[data->next];
+	unsigned int signaled;
+	int result;
+	int rc;
+
+	if (frame->signal != NULL) {
+		k_poll_signal_check(frame->signal, &signaled, &result);
+		if (signaled == 0U) {
+			return -EBUSY;
+		}
+	}
+
+	apa102_encode(pixels, count);
+
+	frame->bufs[0].buf = (u8_t *)zeros;
+	frame->bufs[0].len = sizeof(zeros);
+	frame->bufs[1].buf = pixels;
+	frame->bufs[1].len = sizeof(struct led_rgb) * count;
+	frame->bufs[2].buf = (u8_t *)ones;
+	frame->bufs[2].len = sizeof(ones);
+	frame->tx.buffers = frame->bufs;
+	frame->tx.count = ARRAY_SIZE(frame->bufs);
+
+	if (signal == NULL) {
+		k_poll_signal_init(&frame->done);
+		signal = &frame->done;
+	}
+
+#ifdef CONFIG_SPI_QUEUE
+	frame->t.config = &data->cfg;
+	frame->t.tx_bufs = &frame->tx;
+	frame->t.rx_bufs = NULL;
+	frame->t.signal = signal;
+
+	rc = spi_transceive_queued(data->spi, &frame->t);
+	if (rc == -ENOTSUP) {
+		rc = spi_write_async(data->spi, &data->cfg, &frame->tx,
+				     signal);
+	}
+#else
+	rc = spi_write_async(data->spi, &data->cfg, &frame->tx, signal);
+#endif
+	if (rc) {
+		return rc;
+	}
+
+	frame->signal = signal;
+	data->next ^= 1U;
+
+	return 0;
+}
+#endif /* CONFIG_LED_STRIP_ASYNC */
+
 static int apa102_update_channels(struct device *dev, u8_t *channels,
 				  size_t num_channels)
 {
@@ -99,6 +188,9 @@ static struct apa102_data apa102_data_0;
 static const struct led_strip_driver_api apa102_api = {
 	.update_rgb = apa102_update_rgb,
 	.update_channels = apa102_update_channels,
+#ifdef CONFIG_LED_STRIP_ASYNC
+	.update_rgb_async = apa102_update_rgb_async,
+#endif
 };
 
 DEVICE_AND_API_INIT(apa102_0, DT_APA_APA102_0_LABEL, apa102_init,
@@ -54,10 +54,35 @@ LOG_MODULE_REGISTER(ws2812);
 #define PX_BUF_PER_PX 24
 #endif
 
+#ifdef CONFIG_LED_STRIP_ASYNC
+/*
+ * Frame transmitted asynchronously, followed by the strip reset. The
+ * signal is the one of the transmission in flight, if any.
+ */
+struct ws2812_frame {
+	u8_t px_buf[PX_BUF_PER_PX * CONFIG_WS2812_STRIP_MAX_PIXELS];
+	struct spi_buf bufs[2];
+	struct spi_buf_set tx;
+	struct k_poll_signal done;
+	struct k_poll_signal *signal;
+#ifdef CONFIG_SPI_QUEUE
+	struct spi_transaction t;
+#endif
+};
+
+static const u8_t reset_frames[RESET_NFRAMES];
+#endif /* CONFIG_LED_STRIP_ASYNC */
+
 struct ws2812_data {
 	struct device *spi;
 	struct spi_config config;
+#ifdef CONFIG_LED_STRIP_ASYNC
+	/* Double buffered, the next one is encoded during a transmission */
+	struct ws2812_frame frames[2];
+	u8_t next;
+#else
 	u8_t px_buf[PX_BUF_PER_PX * CONFIG_WS2812_STRIP_MAX_PIXELS];
+#endif
 };
 
 /*
@@ -107,6 +132,107 @@ static int ws2812_reset_strip(struct ws2812_data *data)
 	return spi_write(data->spi, &data->config, &tx);
 }
 
+#ifdef CONFIG_LED_STRIP_ASYNC
+static bool ws2812_frame_busy(struct ws2812_frame *frame)
+{
+	unsigned int signaled;
+	int result;
+
+	if (frame->signal == NULL) {
+		return false;
+	}
+
+	k_poll_signal_check(frame->signal, &signaled, &result);
+
+	return signaled == 0U;
+}
+
+static int ws2812_strip_update_rgb_async(struct device *dev,
+					 struct led_rgb *pixels,
+					 size_t num_pixels,
+					 struct k_poll_signal *signal)
+{
+	struct ws2812_data *drv_data = dev->driver_data;
+	struct ws2812_frame *frame = &drv_data->frames[drv_data->next];
+	size_t i;
+	int rc;
+
+	if (num_pixels > CONFIG_WS2812_STRIP_MAX_PIXELS) {
+		return -ENOMEM;
+	}
+
+	if (ws2812_frame_busy(frame)) {
+		return -EBUSY;
+	}
+
+	for (i = 0; i < num_pixels; i++) {
+		ws2812_serialize_pixel(&frame->px_buf[PX_BUF_PER_PX * i],
+				       &pixels[i]);
+	}
+
+	frame->bufs[0].buf = frame->px_buf;
+	frame->bufs[0].len = PX_BUF_PER_PX * num_pixels;
+	frame->bufs[1].buf = (u8_t *)reset_frames;
+	frame->bufs[1].len = sizeof(reset_frames);
+	frame->tx.buffers = frame->bufs;
+	frame->tx.count = ARRAY_SIZE(frame->bufs);
+
+	if (signal == NULL) {
+		k_poll_signal_init(&frame->done);
+		signal = &frame->done;
+	}
+
+#ifdef CONFIG_SPI_QUEUE
+	frame->t.config = &drv_data->config;
+	frame->t.tx_bufs = &frame->tx;
+	frame->t.rx_bufs = NULL;
+	frame->t.signal = signal;
+
+	rc = spi_transceive_queued(drv_data->spi, &frame->t);
+	if (rc == -ENOTSUP) {
+		rc = spi_write_async(drv_data->spi, &drv_data->config,
+				     &frame->tx, signal);
+	}
+#else
+	rc = spi_write_async(drv_data->spi, &drv_data->config, &frame->tx,
+			     signal);
+#endif
+	if (rc) {
+		return rc;
+	}
+
+	frame->signal = signal;
+	drv_data->next ^= 1U;
+
+	return 0;
+}
+
+static int ws2812_strip_update_rgb(struct device *dev, struct led_rgb *pixels,
+				   size_t num_pixels)
+{
+	struct ws2812_data *drv_data = dev->driver_data;
+	struct ws2812_frame *frame = &drv_data->frames[drv_data->next];
+	struct k_poll_event event;
+	int rc;
+
+	/* Waiting on a signal of the caller could race with the caller */
+	if (ws2812_frame_busy(&drv_data->frames[0]) ||
+	    ws2812_frame_busy(&drv_data->frames[1])) {
+		return -EBUSY;
+	}
+
+	rc = ws2812_strip_update_rgb_async(dev, pixels, num_pixels, NULL);
+	if (rc) {
+		return rc;
+	}
+
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &frame->done);
+	(void)k_poll(&event, 1, K_FOREVER);
+
+	return frame->done.result;
+}
+#else
 static int ws2812_strip_update_rgb(struct device *dev, struct led_rgb *pixels,
 				   size_t num_pixels)
 {
@@ -140,6 +266,7 @@ static int ws2812_strip_update_rgb(struct device *dev, struct led_rgb *pixels,
 
 	return ws2812_reset_strip(drv_data);
 }
+#endif /* CONFIG_LED_STRIP_ASYNC */
 
 static int ws2812_strip_update_channels(struct device *dev, u8_t *channels,
 					size_t num_channels)
@@ -201,6 +328,9 @@ static struct ws2812_data ws2812_strip_data;
 static const struct led_strip_driver_api ws2812_strip_api = {
 	.update_rgb = ws2812_strip_update_rgb,
 	.update_channels = ws2812_strip_update_channels,
+#ifdef CONFIG_LED_STRIP_ASYNC
+	.update_rgb_async = ws2812_strip_update_rgb_async,
+#endif
 };
 
 DEVICE_AND_API_INIT(ws2812_strip, DT_WORLDSEMI_WS2812_0_LABEL,
@@ -20,6 +20,9 @@ LOG_MODULE_REGISTER(ws2812b_sw);
 
 #define BLOCKING ((void *)1)
 
+/* Bytes sent with interrupts locked, one GRB pixel */
+#define BYTES_PER_LOCK 3
+
 static int send_buf(u8_t *buf, size_t len)
 {
 	/* Address of OUTSET. OUTCLR is OUTSET + 4 */
@@ -42,56 +45,68 @@ static int send_buf(u8_t *buf, size_t len)
 	 * the 16 MHz clock enabled.
 	 */
 	clock_control_on(clock, BLOCKING);
-	key = irq_lock();
-
-	while (len--) {
-		u32_t b = *buf++;
-
-		/* Generate signal out of the bits, MSB. 1-bit should be
-		 * roughly 0.85us high, 0.4us low, whereas a 0-bit should be
-		 * roughly 0.4us high, 0.85us low.
-		 */
-		__asm volatile ("movs %[i], #8\n" /* i = 8 */
-				".start_bit:\n"
-
-				/* OUTSET = BIT(LED_PIN) */
-				"strb %[p], [%[r], #0]\n"
-
-				/* if (b & 0x80) goto .long */
-				"tst %[b], %[m]\n"
-				"bne .long\n"
-
-				/* 0-bit */
-				"nop\nnop\n"
-				/* OUTCLR = BIT(LED_PIN) */
-				"strb %[p], [%[r], #4]\n"
-				"nop\nnop\nnop\n"
-				"b .next_bit\n"
-
-				/* 1-bit */
-				".long:\n"
-				"nop\nnop\nnop\nnop\nnop\nnop\nnop\n"
-				/* OUTCLR = BIT(LED_PIN) */
-				"strb %[p], [%[r], #4]\n"
-
-				".next_bit:\n"
-				/* b <<= 1 */
-				"lsl %[b], #1\n"
-				/* i-- */
-				"sub %[i], #1\n"
-				/* if (i > 0) goto .start_bit */
-				"bne .start_bit\n"
-				:
-				[i] "+r" (i)
-				:
-				[b] "l" (b),
-				[m] "l" (0x80),
-				[r] "l" (base),
-				[p] "r" (pin)
-				:);
+
+	/* Interrupts are only locked for a pixel at a time, about 30 us.
+	 * The line idles low in between, which the strip only takes for
+	 * a reset after 50 us: interrupts may run between two pixels as
+	 * long as they are shorter than that.
+	 */
+	while (len) {
+		size_t n = MIN(len, BYTES_PER_LOCK);
+
+		len -= n;
+		key = irq_lock();
+
+		while (n--) {
+			u32_t b = *buf++;
+
+			/* Generate signal out of the bits, MSB. 1-bit should
+			 * be roughly 0.85us high, 0.4us low, whereas a 0-bit
+			 * should be roughly 0.4us high, 0.85us low.
+			 */
+			__asm volatile ("movs %[i], #8\n" /* i = 8 */
+					".start_bit:\n"
+
+					/* OUTSET = BIT(LED_PIN) */
+					"strb %[p], [%[r], #0]\n"
+
+					/* if (b & 0x80) goto .long */
+					"tst %[b], %[m]\n"
+					"bne .long\n"
+
+					/* 0-bit */
+					"nop\nnop\n"
+					/* OUTCLR = BIT(LED_PIN) */
+					"strb %[p], [%[r], #4]\n"
+					"nop\nnop\nnop\n"
+					"b .next_bit\n"
+
+					/* 1-bit */
+					".long:\n"
+					"nop\nnop\nnop\nnop\nnop\nnop\nnop\n"
+					/* OUTCLR = BIT(LED_PIN) */
+					"strb %[p], [%[r], #4]\n"
+
+					".next_bit:\n"
+					/* b <<= 1 */
+					"lsl %[b], #1\n"
+					/* i-- */
+					"sub %[i], #1\n"
+					/* if (i > 0) goto .start_bit */
+					"bne .start_bit\n"
+					:
+					[i] "+r" (i)
+					:
+					[b] "l" (b),
+					[m] "l" (0x80),
+					[r] "l" (base),
+					[p] "r" (pin)
+					:);
+		}
+
+		irq_unlock(key);
 	}
 
-	irq_unlock(key);
 	clock_control_off(clock, NULL);
 
 	return 0;
@@ -134,6 +149,8 @@ static int ws2812b_sw_init(struct device *dev)
 		return -ENODEV;
 	}
 
+	/* the line idles low, a high level would be taken for a bit */
+	gpio_port_clear_bits(gpio, BIT(CONFIG_WS2812B_SW_GPIO_PIN));
 	gpio_pin_configure(gpio, CONFIG_WS2812B_SW_GPIO_PIN, GPIO_DIR_OUT);
 
 	return 0;
@@ -0,0 +1,262 @@
+/** @file
+ * @brief Modem AT command pipeline
+ *
+ * Commands are queued and written to the modem one after the other, the
+ * next one as soon as the final result code of the previous one has been
+ * parsed. Received data is split into lines straight from the receiver
+ * ring buffer, a contiguous chunk at a time.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include <logging/log.h>
+
+LOG_MODULE_REGISTER(mdm_cmd_pipeline, CONFIG_MODEM_LOG_LEVEL);
+
+#include <drivers/modem/modem_cmd_pipeline.h>
+
+#define CME_ERROR	"+CME ERROR: "
+#define CMS_ERROR	"+CMS ERROR: "
+
+static const struct mdm_cmd_match *match_find(const struct mdm_cmd_match *m,
+					      size_t count, const char *line)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		if (!strncmp(line, m[i].prefix, strlen(m[i].prefix))) {
+			return &m[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void send_next(struct mdm_cmd_pipeline *pipe)
+{
+	sys_snode_t *node;
+	struct mdm_cmd *cmd;
+
+	if (pipe->current) {
+		return;
+	}
+
+	node = sys_slist_get(&pipe->queue);
+	if (!node) {
+		return;
+	}
+
+	cmd = CONTAINER_OF(node, struct mdm_cmd, node);
+	cmd->error = 0;
+	pipe->current = cmd;
+
+	LOG_DBG("-> %s", log_strdup(cmd->cmd));
+
+	mdm_receiver_send(pipe->mdm_ctx, (const u8_t *)cmd->cmd,
+			  strlen(cmd->cmd));
+	mdm_receiver_send(pipe->mdm_ctx, (const u8_t *)"\r", 1);
+
+	if (cmd->timeout != K_FOREVER) {
+		pipe->deadline = k_uptime_get() + cmd->timeout;
+		k_delayed_work_submit(&pipe->timeout_work, cmd->timeout);
+	}
+}
+
+static void complete(struct mdm_cmd_pipeline *pipe, int result)
+{
+	struct mdm_cmd *cmd = pipe->current;
+
+	k_delayed_work_cancel(&pipe->timeout_work);
+	pipe->current = NULL;
+
+	/* the modem works on the next command while we run the callback */
+	send_next(pipe);
+
+	if (cmd->done) {
+		cmd->done(cmd, result);
+	}
+}
+
+static void timeout_handler(struct k_work *work)
+{
+	struct mdm_cmd_pipeline *pipe =
+		CONTAINER_OF(work, struct mdm_cmd_pipeline, timeout_work);
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+
+	/* a late run of a cancelled timeout must not hit the next command */
+	if (pipe->current && pipe->current->timeout != K_FOREVER &&
+	    k_uptime_get() >= pipe->deadline) {
+		LOG_WRN("%s timed out", log_strdup(pipe->current->cmd));
+		complete(pipe, -ETIMEDOUT);
+	}
+
+	k_mutex_unlock(&pipe->lock);
+}
+
+static void handle_line(struct mdm_cmd_pipeline *pipe, char *line, size_t len)
+{
+	struct mdm_cmd *cmd = pipe->current;
+	const struct mdm_cmd_match *match;
+
+	LOG_DBG("<- %s", log_strdup(line));
+
+	if (cmd) {
+		if (!strcmp(line, "OK")) {
+			complete(pipe, 0);
+			return;
+		}
+
+		if (!strcmp(line, "ERROR")) {
+			complete(pipe, -EIO);
+			return;
+		}
+
+		if (!strncmp(line, CME_ERROR, sizeof(CME_ERROR) - 1) ||
+		    !strncmp(line, CMS_ERROR, sizeof(CMS_ERROR) - 1)) {
+			cmd->error = strtol(line + sizeof(CME_ERROR) - 1,
+					    NULL, 10);
+			complete(pipe, -EIO);
+			return;
+		}
+
+		match = match_find(cmd->matches, cmd->match_count, line);
+		if (match) {
+			size_t plen = strlen(match->prefix);
+
+			match->cb(cmd, line + plen, len - plen);
+			return;
+		}
+	}
+
+	match = match_find(pipe->urcs, pipe->urc_count, line);
+	if (match) {
+		size_t plen = strlen(match->prefix);
+
+		match->cb(NULL, line + plen, len - plen);
+	}
+}
+
+static void parse(struct mdm_cmd_pipeline *pipe, const u8_t *data,
+		  size_t len)
+{
+	const u8_t *end = data + len;
+	const u8_t *eol;
+	size_t seg;
+
+	while (data < end) {
+		/* find the end of the line in the chunk */
+		for (eol = data; eol < end && *eol != '\r' && *eol != '\n';
+		     eol++) {
+		}
+
+		seg = eol - data;
+		if (pipe->line_len + seg < sizeof(pipe->line)) {
+			memcpy(pipe->line + pipe->line_len, data, seg);
+			pipe->line_len += seg;
+		} else {
+			pipe->line_overflow = true;
+		}
+
+		if (eol == end) {
+			/* line continues in a later chunk */
+			return;
+		}
+
+		data = eol + 1;
+
+		if (pipe->line_overflow) {
+			LOG_WRN("Line too long, dropped");
+		} else if (pipe->line_len > 0) {
+			pipe->line[pipe->line_len] = '\0';
+			handle_line(pipe, pipe->line, pipe->line_len);
+		}
+
+		pipe->line_len = 0;
+		pipe->line_overflow = false;
+	}
+}
+
+void mdm_cmd_pipeline_process(struct mdm_cmd_pipeline *pipe)
+{
+	struct ring_buf *rb = &pipe->mdm_ctx->rx_rb;
+	u8_t *data;
+	u32_t len;
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+
+	while ((len = ring_buf_get_claim(rb, &data, rb->size)) > 0) {
+		parse(pipe, data, len);
+		ring_buf_get_finish(rb, len);
+	}
+
+	k_mutex_unlock(&pipe->lock);
+}
+
+int mdm_cmd_pipeline_submit(struct mdm_cmd_pipeline *pipe,
+			    struct mdm_cmd *cmd)
+{
+	if (!pipe || !cmd || !cmd->cmd) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+
+	sys_slist_append(&pipe->queue, &cmd->node);
+	send_next(pipe);
+
+	k_mutex_unlock(&pipe->lock);
+
+	return 0;
+}
+
+void mdm_cmd_pipeline_flush(struct mdm_cmd_pipeline *pipe)
+{
+	sys_snode_t *node;
+	struct mdm_cmd *cmd;
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+
+	/* drop the queue first so that complete() does not send */
+	while ((node = sys_slist_get(&pipe->queue)) != NULL) {
+		cmd = CONTAINER_OF(node, struct mdm_cmd, node);
+		if (cmd->done) {
+			cmd->done(cmd, -ECANCELED);
+		}
+	}
+
+	if (pipe->current) {
+		complete(pipe, -ECANCELED);
+	}
+
+	k_mutex_unlock(&pipe->lock);
+}
+
+void mdm_cmd_pipeline_init(struct mdm_cmd_pipeline *pipe,
+			   struct mdm_receiver_context *mdm_ctx,
+			   const struct mdm_cmd_match *urcs,
+			   size_t urc_count)
+{
+	__ASSERT(pipe, "invalid pipe");
+	__ASSERT(mdm_ctx, "invalid mdm_ctx");
+
+	pipe->mdm_ctx = mdm_ctx;
+	pipe->urcs = urcs;
+	pipe->urc_count = urcs ? urc_count : 0;
+	pipe->current = NULL;
+	pipe->line_len = 0;
+	pipe->line_overflow = false;
+
+	sys_slist_init(&pipe->queue);
+	k_mutex_init(&pipe->lock);
+	k_delayed_work_init(&pipe->timeout_work, timeout_handler);
+}
@@ -13,6 +13,7 @@
 
 #include <kernel.h>
 #include <init.h>
+#include <string.h>
 #include <uart.h>
 
 #include <logging/log.h>
@@ -70,6 +71,80 @@ static int mdm_receiver_get(struct mdm_receiver_context *ctx)
 	return -ENOMEM;
 }
 
+#if defined(CONFIG_MODEM_RECEIVER_UART_ASYNC)
+/**
+ * @brief  Starts DMA reception into the first buffer.
+ *
+ * @param  *ctx: receiver context.
+ *
+ * @retval None.
+ */
+static void mdm_receiver_rx_start(struct mdm_receiver_context *ctx)
+{
+	int ret;
+
+	ctx->rx_dma_next = 1U;
+	ret = uart_rx_enable(ctx->uart_dev, ctx->rx_dma_buf[0],
+			     sizeof(ctx->rx_dma_buf[0]),
+			     CONFIG_MODEM_RECEIVER_UART_ASYNC_TIMEOUT);
+	if (ret < 0) {
+		LOG_ERR("Cannot enable rx: %d", ret);
+	}
+}
+
+/**
+ * @brief  Receiver UART event handler.
+ *
+ * @note   Copies each received chunk into the contexts ring buffer at
+ *         once, instead of reading the UART FIFO byte by byte.
+ *         When ring buffer is full the data is discarded.
+ *
+ * @param  *evt: UART event.
+ * @param  *user_data: receiver context.
+ *
+ * @retval None.
+ */
+static void mdm_receiver_uart_cb(struct uart_event *evt, void *user_data)
+{
+	struct mdm_receiver_context *ctx = user_data;
+	u8_t *buf;
+	int ret;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&ctx->tx_sem);
+		break;
+
+	case UART_RX_RDY:
+		ret = ring_buf_put(&ctx->rx_rb,
+				   evt->data.rx.buf + evt->data.rx.offset,
+				   evt->data.rx.len);
+		if (ret != evt->data.rx.len) {
+			LOG_ERR("Rx buffer doesn't have enough space. "
+				"Bytes pending: %d, written: %d",
+				evt->data.rx.len, ret);
+		}
+
+		k_sem_give(&ctx->rx_sem);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		buf = ctx->rx_dma_buf[ctx->rx_dma_next];
+		ctx->rx_dma_next ^= 1U;
+		uart_rx_buf_rsp(ctx->uart_dev, buf, sizeof(ctx->rx_dma_buf[0]));
+		break;
+
+	case UART_RX_DISABLED:
+		/* stopped by an error or because no buffer was given */
+		mdm_receiver_rx_start(ctx);
+		break;
+
+	default:
+		break;
+	}
+}
+#else
 /**
  * @brief  Drains UART.
  *
@@ -131,6 +206,7 @@ static void mdm_receiver_isr(struct device *uart_dev)
 		}
 	}
 }
+#endif /* CONFIG_MODEM_RECEIVER_UART_ASYNC */
 
 /**
  * @brief  Configures receiver context and assigned device.
@@ -143,11 +219,18 @@ static void mdm_receiver_setup(struct mdm_receiver_context *ctx)
 {
 	__ASSERT(ctx, "invalid ctx");
 
+#if defined(CONFIG_MODEM_RECEIVER_UART_ASYNC)
+	k_sem_init(&ctx->tx_sem, 0, 1);
+	k_mutex_init(&ctx->tx_lock);
+	uart_callback_set(ctx->uart_dev, mdm_receiver_uart_cb, ctx);
+	mdm_receiver_rx_start(ctx);
+#else
 	uart_irq_rx_disable(ctx->uart_dev);
 	uart_irq_tx_disable(ctx->uart_dev);
 	mdm_receiver_flush(ctx);
 	uart_irq_callback_set(ctx->uart_dev, mdm_receiver_isr);
 	uart_irq_rx_enable(ctx->uart_dev);
+#endif
 }
 
 struct mdm_receiver_context *mdm_receiver_context_from_id(int id)
@@ -186,9 +269,33 @@ int mdm_receiver_send(struct mdm_receiver_context *ctx,
 		return 0;
 	}
 
+#if defined(CONFIG_MODEM_RECEIVER_UART_ASYNC)
+	k_mutex_lock(&ctx->tx_lock, K_FOREVER);
+
+	while (size > 0) {
+		size_t len = MIN(size, sizeof(ctx->tx_dma_buf));
+		int ret;
+
+		memcpy(ctx->tx_dma_buf, buf, len);
+
+		ret = uart_tx(ctx->uart_dev, ctx->tx_dma_buf, len, K_FOREVER);
+		if (ret < 0) {
+			k_mutex_unlock(&ctx->tx_lock);
+			return ret;
+		}
+
+		k_sem_take(&ctx->tx_sem, K_FOREVER);
+
+		buf += len;
+		size -= len;
+	}
+
+	k_mutex_unlock(&ctx->tx_lock);
+#else
 	do {
 		uart_poll_out(ctx->uart_dev, *buf++);
 	} while (--size);
+#endif
 
 	return 0;
 }
@@ -48,6 +48,28 @@ static struct intel_gna_config_desc __aligned(GNA_PG_SIZE_IN_BYTES)
 static struct intel_gna_page_table __aligned(GNA_PG_SIZE_IN_BYTES)
 	gna_page_table[GNA_NUM_PG_TABLES_NEEDED];
 
+static void intel_gna_start(struct intel_gna_data *gna,
+		struct intel_gna_pending_req *req);
+
+static void intel_gna_update_stats(struct intel_gna_data *gna,
+		struct intel_gna_pending_req *req,
+		struct intel_gna_pending_resp *resp)
+{
+	struct gna_stats *stats = &gna->stats;
+	u32_t latency_us;
+
+	latency_us = SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() -
+			req->submit_cycles) / NSEC_PER_USEC;
+
+	stats->inferences++;
+	if (resp->response.result != GNA_RESULT_INFERENCE_COMPLETE) {
+		stats->errors++;
+	}
+	stats->total_cycles += resp->response.stats.total_cycles;
+	stats->total_latency_us += latency_us;
+	stats->max_latency_us = MAX(stats->max_latency_us, latency_us);
+}
+
 static void intel_gna_interrupt_handler(struct device *dev)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
@@ -56,6 +78,8 @@ static void intel_gna_interrupt_handler(struct device *dev)
 	struct intel_gna_pending_resp pending_resp;
 	struct intel_gna_pending_req pending_req;
 
+	pending_resp.response.result = GNA_RESULT_GENERIC_ERROR;
+
 	/* check for generic / virtual address out of range error */
 	if (regs->gnasts & (GNA_STS_VIRT_ADDR_OOR | GNA_STS_ERROR)) {
 		pending_resp.response.result = GNA_RESULT_GENERIC_ERROR;
@@ -99,6 +123,8 @@ static void intel_gna_interrupt_handler(struct device *dev)
 			pending_resp.response.stats.stall_cycles = 0U;
 		}
 
+		intel_gna_update_stats(gna, &pending_req, &pending_resp);
+
 		k_msgq_put(&gna->response_queue, &pending_resp, K_NO_WAIT);
 
 		k_work_submit(&gna->gna_work);
@@ -106,7 +132,13 @@ static void intel_gna_interrupt_handler(struct device *dev)
 
 	/* clear GNA operation and disable interrupt */
 	regs->gnactrl |= GNA_CTRL_INTR_DISABLE | GNA_CTRL_ABORT_CLEAR;
-	gna->state = GNA_STATE_IDLE;
+
+	/* start the next pending request right away */
+	if (k_msgq_peek(&gna->request_queue, &pending_req) == 0) {
+		intel_gna_start(gna, &pending_req);
+	} else {
+		gna->state = GNA_STATE_IDLE;
+	}
 }
 
 static void gna_work_handler(struct k_work *work)
@@ -225,7 +257,8 @@ static int intel_gna_configure(struct device *dev, struct gna_config *cfg)
 	struct intel_gna_data *const gna = DEV_DATA(dev);
 	volatile struct intel_gna_regs *regs = gna->regs;
 
-	if (gna->state != GNA_STATE_INITIALIZED) {
+	if ((gna->state != GNA_STATE_INITIALIZED) &&
+			(gna->state != GNA_STATE_IDLE)) {
 		LOG_ERR("Configuration attempt in invalid state (%u)",
 			gna->state);
 		return -EINVAL;
@@ -275,15 +308,61 @@ static int intel_gna_configure(struct device *dev, struct gna_config *cfg)
 	return 0;
 }
 
+/* map the model at its virtual base, for the requests to run on it */
+static void intel_gna_map_model(struct intel_gna_data *gna,
+		struct intel_gna_model *gna_model)
+{
+	struct gna_model_info *model = &gna_model->model;
+
+	if (gna->mapped == gna_model) {
+		return;
+	}
+
+	/* setup page table entries for RW region */
+	if (gna_model->rw_size) {
+		intel_gna_setup_page_table(model->rw_region,
+				gna_model->rw_size, gna_model->vabase);
+	}
+
+	/* setup page table entries for RO region */
+	intel_gna_setup_page_table(gna_model->ro_region, gna_model->ro_size,
+			(void *)((u32_t)gna_model->vabase +
+				gna_model->rw_size));
+
+	SOC_DCACHE_FLUSH(gna_page_table, sizeof(gna_page_table));
+
+	gna->mapped = gna_model;
+}
+
+static struct intel_gna_model *intel_gna_find_model(
+		struct intel_gna_data *gna, struct gna_model_info *model)
+{
+	for (int i = 0; i < GNA_MAX_NUM_MODELS; i++) {
+		struct intel_gna_model *gna_model = &gna->models[i];
+
+		if (gna_model->registered &&
+				(gna_model->model.header == model->header) &&
+				(gna_model->model.rw_region ==
+				 model->rw_region) &&
+				(gna_model->model.ro_region ==
+				 model->ro_region)) {
+			return gna_model;
+		}
+	}
+
+	return NULL;
+}
+
 static int intel_gna_register_model(struct device *dev,
 		struct gna_model_info *model, void **model_handle)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
 	struct intel_gna_model *gna_model;
 	struct gna_model_header *header;
-	u32_t ro_size, rw_size;
+	u32_t ro_size, rw_size = 0U;
 	void *virtual_base;
 	void *ro_region;
+	unsigned int key;
 
 	if ((gna->state != GNA_STATE_IDLE) &&
 			(gna->state != GNA_STATE_ACTIVE)) {
@@ -308,6 +387,15 @@ static int intel_gna_register_model(struct device *dev,
 		return -EINVAL;
 	}
 
+	/* the model is already set up, share it */
+	gna_model = intel_gna_find_model(gna, model);
+	if (gna_model != NULL) {
+		gna_model->refs++;
+		LOG_DBG("returning cached model handle: %p", gna_model);
+		*model_handle = (void *)gna_model;
+		return 0;
+	}
+
 	if (k_mem_slab_alloc(&gna->model_slab, (void **)&gna_model,
 				K_NO_WAIT)) {
 		LOG_ERR("No memory to register model");
@@ -323,7 +411,6 @@ static int intel_gna_register_model(struct device *dev,
 	LOG_INF("model_size: %u rw_region_size: %u", header->model_size,
 			header->rw_region_size);
 
-	/* setup page table entries for RW region */
 	if (model->rw_region && header->rw_region_size) {
 		/* calculate layer descriptor size */
 		rw_size = header->layer_count *
@@ -333,8 +420,6 @@ static int intel_gna_register_model(struct device *dev,
 		/* add the input rw_region_size to get total rw_region_size */
 		rw_size += header->rw_region_size;
 
-		intel_gna_setup_page_table(model->rw_region, rw_size,
-				virtual_base);
 		SOC_DCACHE_FLUSH(model->rw_region, rw_size);
 	}
 
@@ -349,24 +434,34 @@ static int intel_gna_register_model(struct device *dev,
 	LOG_INF("rw_region: %p (%u) ro_region: %p (%u)",
 			model->rw_region, rw_size, ro_region, ro_size);
 
-	/* setup page table entries for RO region */
-	intel_gna_setup_page_table(ro_region, ro_size,
-			(void *)((u32_t)virtual_base + rw_size));
-
 	SOC_DCACHE_FLUSH(ro_region, ro_size);
-	SOC_DCACHE_FLUSH(gna_page_table, sizeof(gna_page_table));
 
 	/* copy the model pointers */
 	gna_model->model = *model;
 	gna_model->vabase = virtual_base;
+	gna_model->ro_region = ro_region;
+	gna_model->rw_size = rw_size;
+	gna_model->ro_size = ro_size;
 	gna_model->input = (void *)((u32_t)model->rw_region +
 			*(u32_t *)((u32_t)model->rw_region +
 				header->input_ptr_offset));
 	gna_model->output = (void *)((u32_t)model->rw_region +
 			*(u32_t *)((u32_t)model->rw_region +
 				header->output_ptr_offset));
+	gna_model->refs = 1U;
 	gna_model->registered = true;
 
+	/*
+	 * All models share the same virtual base, those registered remain
+	 * set up and only get mapped again when switching between them.
+	 * Mapping while a request runs would change its model.
+	 */
+	key = irq_lock();
+	if (gna->state == GNA_STATE_IDLE) {
+		intel_gna_map_model(gna, gna_model);
+	}
+	irq_unlock(key);
+
 	LOG_INF("model->rw_region: %p", model->rw_region);
 	LOG_INF("input offset: %u",
 		*(u32_t *)((u32_t)model->rw_region + header->input_ptr_offset));
@@ -384,6 +479,7 @@ static int intel_gna_deregister_model(struct device *dev, void *model_handle)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
 	struct intel_gna_model *gna_model;
+	unsigned int key;
 
 	if (model_handle == NULL) {
 		LOG_ERR("model_handle is NULL");
@@ -391,22 +487,57 @@ static int intel_gna_deregister_model(struct device *dev, void *model_handle)
 	}
 
 	gna_model = (struct intel_gna_model *)model_handle;
+
+	if (--gna_model->refs > 0) {
+		return 0;
+	}
+
+	key = irq_lock();
 	gna_model->registered = false;
+	if (gna->mapped == gna_model) {
+		gna->mapped = NULL;
+	}
+	irq_unlock(key);
+
 	k_mem_slab_free(&gna->model_slab, &model_handle);
 
 	return 0;
 }
 
+/* called with interrupts locked, or from the interrupt handler */
+static void intel_gna_start(struct intel_gna_data *gna,
+		struct intel_gna_pending_req *req)
+{
+	volatile struct intel_gna_regs *regs = gna->regs;
+	struct intel_gna_model *handle = req->model;
+	struct gna_model_header *header = handle->model.header;
+
+	intel_gna_map_model(gna, handle);
+
+	/* copy input */
+	memcpy(handle->input, req->input, req->input_len);
+	SOC_DCACHE_FLUSH(handle->input, req->input_len);
+
+	/* assign layer descriptor base address to configuration descriptor */
+	gna_config_desc.labase = (u32_t)handle->vabase;
+	gna_config_desc.lacnt = (u16_t)header->layer_count;
+	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+
+	gna->state = GNA_STATE_ACTIVE;
+	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
+		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
+}
+
 static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 		gna_callback callback)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
-	volatile struct intel_gna_regs *regs = gna->regs;
 	struct intel_gna_pending_req pending_req;
 	struct gna_model_header *header;
 	struct intel_gna_model *handle;
 	struct gna_model_info *model;
-	size_t input_size;
+	unsigned int key;
+	u32_t pending;
 	int ret;
 
 	LOG_DBG("device %p", dev);
@@ -439,37 +570,51 @@ static int intel_gna_infer(struct device *dev, struct gna_inference_req *req,
 
 	model = &handle->model;
 	header = model->header;
-	input_size = header->bytes_per_input * header->num_input_nodes;
 
 	pending_req.model = handle;
+	pending_req.input = req->input;
+	pending_req.input_len = header->bytes_per_input *
+		header->num_input_nodes;
 	pending_req.output = req->output;
 	pending_req.output_len = header->bytes_per_output *
 		header->num_output_nodes;
 	pending_req.callback = callback;
+	pending_req.submit_cycles = k_cycle_get_32();
+
+	/* the interrupt handler starts the requests queued while busy */
+	key = irq_lock();
 
 	ret = k_msgq_put(&gna->request_queue, &pending_req, K_NO_WAIT);
 	if (ret) {
+		irq_unlock(key);
 		LOG_ERR("Unable to queue request (code %d)", ret);
 		return ret;
 	}
 
-	if (gna->state != GNA_STATE_IDLE) {
-		/* multiple pending requests are not yet supported */
-		return -EBUSY;
+	pending = k_msgq_num_used_get(&gna->request_queue);
+	gna->stats.max_pending = MAX(gna->stats.max_pending, pending);
+
+	if (gna->state == GNA_STATE_IDLE) {
+		intel_gna_start(gna, &pending_req);
 	}
 
-	/* copy input */
-	memcpy(handle->input, req->input, input_size);
-	SOC_DCACHE_FLUSH(handle->input, input_size);
+	irq_unlock(key);
 
-	/* assign layer descriptor base address to configuration descriptor */
-	gna_config_desc.labase = (u32_t)handle->vabase;
-	gna_config_desc.lacnt = (u16_t)header->layer_count;
-	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+	return 0;
+}
 
-	gna->state = GNA_STATE_ACTIVE;
-	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
-		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
+static int intel_gna_get_stats(struct device *dev, struct gna_stats *stats)
+{
+	struct intel_gna_data *const gna = DEV_DATA(dev);
+	unsigned int key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = gna->stats;
+	irq_unlock(key);
 
 	return 0;
 }
@@ -512,6 +657,7 @@ static const struct gna_driver_api gna_driver_api = {
 	.register_model		= intel_gna_register_model,
 	.deregister_model	= intel_gna_deregister_model,
 	.infer			= intel_gna_infer,
+	.get_stats		= intel_gna_get_stats,
 };
 
 static struct intel_gna_config intel_gna_config;
@@ -158,14 +158,21 @@ struct intel_gna_model {
 	void			*input;
 	void			*output;
 	void			*vabase;
+	void			*ro_region;
+	u32_t			rw_size;
+	u32_t			ro_size;
+	u8_t			refs;
 	bool			registered;
 };
 
 struct intel_gna_pending_req {
 	struct intel_gna_model	*model;
+	void			*input;
+	size_t			input_len;
 	void			*output;
 	size_t			output_len;
 	gna_callback		callback;
+	u32_t			submit_cycles;
 };
 
 struct intel_gna_pending_resp {
@@ -194,6 +201,9 @@ struct intel_gna_data {
 	struct k_msgq			response_queue;
 	struct intel_gna_pending_resp	responses[GNA_REQUEST_QUEUE_LEN];
 	enum gna_state			state;
+	/* model the page tables currently map */
+	struct intel_gna_model		*mapped;
+	struct gna_stats		stats;
 };
 
 #ifdef __cplusplus
@@ -310,6 +310,10 @@ static const struct sensor_driver_api lis2dh_driver_api = {
 #endif
 	.sample_fetch = lis2dh_sample_fetch,
 	.channel_get = lis2dh_channel_get,
+#ifdef CONFIG_LIS2DH_STREAM
+	.stream_start = lis2dh_stream_start,
+	.stream_stop = lis2dh_stream_stop,
+#endif
 };
 
 int lis2dh_init(struct device *dev)
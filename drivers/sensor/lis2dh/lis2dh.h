@@ -95,6 +95,8 @@
 #define LIS2DH_REG_CTRL3		0x22
 #define LIS2DH_EN_DRDY1_INT1_SHIFT	4
 #define LIS2DH_EN_DRDY1_INT1		BIT(LIS2DH_EN_DRDY1_INT1_SHIFT)
+#define LIS2DH_EN_WTM_INT1_SHIFT	2
+#define LIS2DH_EN_WTM_INT1		BIT(LIS2DH_EN_WTM_INT1_SHIFT)
 
 #define LIS2DH_REG_CTRL4		0x23
 #define LIS2DH_FS_SHIFT			4
@@ -118,6 +120,8 @@
 #define LIS2DH_REG_CTRL5		0x24
 #define LIS2DH_LIR_INT2_SHIFT		1
 #define LIS2DH_EN_LIR_INT2		BIT(LIS2DH_LIR_INT2_SHIFT)
+#define LIS2DH_FIFO_EN_SHIFT		6
+#define LIS2DH_FIFO_EN			BIT(LIS2DH_FIFO_EN_SHIFT)
 
 #define LIS2DH_REG_CTRL6		0x25
 #define LIS2DH_EN_INT2_INT2_SHIFT	5
@@ -144,6 +148,21 @@
 #define LIS2DH_REG_ACCEL_Y_MSB		0x2B
 #define LIS2DH_REG_ACCEL_Z_MSB		0x2D
 
+#define LIS2DH_REG_FIFO_CTRL		0x2E
+#define LIS2DH_FIFO_MODE_SHIFT		6
+#define LIS2DH_FIFO_MODE_BYPASS		(0 << LIS2DH_FIFO_MODE_SHIFT)
+#define LIS2DH_FIFO_MODE_STREAM		(2 << LIS2DH_FIFO_MODE_SHIFT)
+#define LIS2DH_FIFO_FTH_MASK		BIT_MASK(5)
+
+#define LIS2DH_REG_FIFO_SRC		0x2F
+#define LIS2DH_FIFO_SRC_WTM		BIT(7)
+#define LIS2DH_FIFO_SRC_OVRN		BIT(6)
+#define LIS2DH_FIFO_SRC_EMPTY		BIT(5)
+#define LIS2DH_FIFO_SRC_FSS_MASK	BIT_MASK(5)
+
+/* FIFO depth in xyz samples */
+#define LIS2DH_FIFO_SIZE		32
+
 #define LIS2DH_REG_INT1_CFG		0x30
 #define LIS2DH_REG_INT2_CFG		0x34
 #define LIS2DH_AOI_CFG			BIT(7)
@@ -223,6 +242,17 @@ struct lis2dh_data {
 	struct device *dev;
 #endif
 
+#if defined(CONFIG_LIS2DH_STREAM)
+	sensor_stream_handler_t stream_handler;
+	void *stream_user_data;
+	u8_t *stream_buf;
+	size_t stream_buf_size;
+	u8_t stream_watermark;
+	u32_t stream_period;
+	u32_t stream_irq_time;
+	struct sensor_stream_chan stream_chans[3];
+#endif
+
 #endif /* CONFIG_LIS2DH_TRIGGER */
 };
 
@@ -348,4 +378,11 @@ int lis2dh_acc_slope_config(struct device *dev, enum sensor_attribute attr,
 			    const struct sensor_value *val);
 #endif
 
+#ifdef CONFIG_LIS2DH_STREAM
+int lis2dh_stream_start(struct device *dev,
+			const struct sensor_stream_config *cfg);
+int lis2dh_stream_stop(struct device *dev);
+void lis2dh_stream_handle(struct device *dev);
+#endif
+
 #endif /* __SENSOR_LIS2DH__ */
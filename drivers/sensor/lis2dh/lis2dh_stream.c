@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <misc/util.h>
+#include <kernel.h>
+
+#define LOG_LEVEL CONFIG_SENSOR_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_DECLARE(lis2dh);
+#include "lis2dh.h"
+
+#define LIS2DH_FIFO_FRAME_SIZE		6
+
+/* output data rates in Hz, indexed by ODR value, normal / low power */
+static const u16_t lis2dh_odr_hz[] = {0, 1, 10, 25, 50, 100, 200, 400, 1620,
+				      1344};
+#define LIS2DH_ODR_9_LP_HZ		5376
+
+static int lis2dh_stream_odr_get(struct device *dev, u32_t *freq)
+{
+	u8_t ctrl1;
+	u8_t odr;
+	int status;
+
+	status = lis2dh_reg_read_byte(dev, LIS2DH_REG_CTRL1, &ctrl1);
+	if (status < 0) {
+		return status;
+	}
+
+	odr = (ctrl1 & LIS2DH_ODR_MASK) >> LIS2DH_ODR_SHIFT;
+	if (odr == 0U || odr >= ARRAY_SIZE(lis2dh_odr_hz)) {
+		return -EINVAL;
+	}
+
+	if (odr == LIS2DH_ODR_9 && (ctrl1 & LIS2DH_LP_EN_BIT_MASK) != 0U) {
+		*freq = LIS2DH_ODR_9_LP_HZ;
+	} else {
+		*freq = lis2dh_odr_hz[odr];
+	}
+
+	return 0;
+}
+
+int lis2dh_stream_start(struct device *dev,
+			const struct sensor_stream_config *cfg)
+{
+	static const enum sensor_channel chans[] = {
+		SENSOR_CHAN_ACCEL_X, SENSOR_CHAN_ACCEL_Y, SENSOR_CHAN_ACCEL_Z,
+	};
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	u32_t freq;
+	int status;
+	int i;
+
+	/* the watermark interrupt fires above the threshold */
+	if (cfg->handler == NULL || cfg->watermark == 0U ||
+	    cfg->watermark >= LIS2DH_FIFO_SIZE ||
+	    cfg->buf_size < cfg->watermark * LIS2DH_FIFO_FRAME_SIZE) {
+		return -EINVAL;
+	}
+
+	status = lis2dh_stream_odr_get(dev, &freq);
+	if (status < 0) {
+		return status;
+	}
+
+	gpio_pin_disable_callback(lis2dh->gpio_int1, DT_LIS2DH_INT1_GPIO_PIN);
+
+	/* bypass mode empties the FIFO */
+	status = lis2dh_reg_write_byte(dev, LIS2DH_REG_FIFO_CTRL,
+				       LIS2DH_FIFO_MODE_BYPASS);
+	if (status < 0) {
+		return status;
+	}
+
+	status = lis2dh_reg_field_update(dev, LIS2DH_REG_CTRL5,
+					 LIS2DH_FIFO_EN_SHIFT,
+					 LIS2DH_FIFO_EN, 1);
+	if (status < 0) {
+		return status;
+	}
+
+	/* route the watermark instead of data ready to int1 */
+	status = lis2dh_reg_field_update(dev, LIS2DH_REG_CTRL3, 0,
+					 LIS2DH_EN_DRDY1_INT1 |
+					 LIS2DH_EN_WTM_INT1,
+					 LIS2DH_EN_WTM_INT1);
+	if (status < 0) {
+		return status;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(chans); i++) {
+		lis2dh->stream_chans[i].chan = chans[i];
+		lis2dh->stream_chans[i].range = lis2dh->scale * 32768U;
+	}
+
+	lis2dh->stream_period = sys_clock_hw_cycles_per_sec() / freq;
+	lis2dh->stream_watermark = cfg->watermark;
+	lis2dh->stream_buf = cfg->buf;
+	lis2dh->stream_buf_size = cfg->buf_size;
+	lis2dh->stream_user_data = cfg->user_data;
+	lis2dh->stream_handler = cfg->handler;
+
+	status = lis2dh_reg_write_byte(dev, LIS2DH_REG_FIFO_CTRL,
+				       LIS2DH_FIFO_MODE_STREAM |
+				       (cfg->watermark & LIS2DH_FIFO_FTH_MASK));
+	if (status < 0) {
+		lis2dh->stream_handler = NULL;
+		return status;
+	}
+
+	gpio_pin_enable_callback(lis2dh->gpio_int1, DT_LIS2DH_INT1_GPIO_PIN);
+
+	return 0;
+}
+
+int lis2dh_stream_stop(struct device *dev)
+{
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	int status;
+
+	gpio_pin_disable_callback(lis2dh->gpio_int1, DT_LIS2DH_INT1_GPIO_PIN);
+
+	lis2dh->stream_handler = NULL;
+
+	status = lis2dh_reg_field_update(dev, LIS2DH_REG_CTRL3,
+					 LIS2DH_EN_WTM_INT1_SHIFT,
+					 LIS2DH_EN_WTM_INT1, 0);
+	if (status < 0) {
+		return status;
+	}
+
+	status = lis2dh_reg_write_byte(dev, LIS2DH_REG_FIFO_CTRL,
+				       LIS2DH_FIFO_MODE_BYPASS);
+	if (status < 0) {
+		return status;
+	}
+
+	/* data ready is re-enabled by setting its trigger again */
+	return lis2dh_reg_field_update(dev, LIS2DH_REG_CTRL5,
+				       LIS2DH_FIFO_EN_SHIFT,
+				       LIS2DH_FIFO_EN, 0);
+}
+
+void lis2dh_stream_handle(struct device *dev)
+{
+	struct lis2dh_data *lis2dh = dev->driver_data;
+	struct sensor_stream_data batch;
+	u8_t fifo_src;
+	u16_t frames;
+	int status;
+
+	status = lis2dh_reg_read_byte(dev, LIS2DH_REG_FIFO_SRC, &fifo_src);
+	if (status < 0) {
+		LOG_ERR("FIFO status read failed (%d)", status);
+		return;
+	}
+
+	/* FSS saturates at 31 unread samples on overrun */
+	frames = fifo_src & LIS2DH_FIFO_SRC_FSS_MASK;
+	if ((fifo_src & LIS2DH_FIFO_SRC_OVRN) != 0U) {
+		frames = LIS2DH_FIFO_SIZE;
+	}
+
+	frames = MIN(frames, lis2dh->stream_buf_size / LIS2DH_FIFO_FRAME_SIZE);
+	if (frames == 0U) {
+		return;
+	}
+
+	/* the output registers wrap to X_L on burst reads in FIFO mode */
+	status = lis2dh_burst_read(dev, LIS2DH_REG_ACCEL_X_LSB,
+				   lis2dh->stream_buf,
+				   frames * LIS2DH_FIFO_FRAME_SIZE);
+	if (status < 0) {
+		LOG_ERR("FIFO read failed (%d)", status);
+		return;
+	}
+
+	batch.buf = lis2dh->stream_buf;
+	batch.chans = lis2dh->stream_chans;
+	batch.chan_count = ARRAY_SIZE(lis2dh->stream_chans);
+	batch.frame_count = frames;
+	batch.overrun = (fifo_src & LIS2DH_FIFO_SRC_OVRN) != 0U;
+	batch.period = lis2dh->stream_period;
+	batch.timestamp = lis2dh->stream_irq_time +
+			  (s32_t)(frames - lis2dh->stream_watermark - 1) *
+			  lis2dh->stream_period;
+
+	lis2dh->stream_handler(dev, &batch, lis2dh->stream_user_data);
+}
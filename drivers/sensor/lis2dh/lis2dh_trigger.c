@@ -221,6 +221,9 @@ static void lis2dh_gpio_int1_callback(struct device *dev,
 
 	ARG_UNUSED(pins);
 
+#if defined(CONFIG_LIS2DH_STREAM)
+	lis2dh->stream_irq_time = k_cycle_get_32();
+#endif
 	atomic_set_bit(&lis2dh->trig_flags, TRIGGED_INT1);
 
 #if defined(CONFIG_LIS2DH_TRIGGER_OWN_THREAD)
@@ -284,6 +287,13 @@ static void lis2dh_thread_cb(void *arg)
 			.chan = lis2dh->chan_drdy,
 		};
 
+#if defined(CONFIG_LIS2DH_STREAM)
+		if (lis2dh->stream_handler != NULL) {
+			lis2dh_stream_handle(dev);
+			return;
+		}
+#endif
+
 		if (likely(lis2dh->handler_drdy != NULL)) {
 			lis2dh->handler_drdy(dev, &drdy_trigger);
 		}
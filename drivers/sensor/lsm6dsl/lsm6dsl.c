@@ -701,6 +701,10 @@ static const struct sensor_driver_api lsm6dsl_api_funcs = {
 #endif
 	.sample_fetch = lsm6dsl_sample_fetch,
 	.channel_get = lsm6dsl_channel_get,
+#if defined(CONFIG_LSM6DSL_STREAM)
+	.stream_start = lsm6dsl_stream_start,
+	.stream_stop = lsm6dsl_stream_stop,
+#endif
 };
 
 static int lsm6dsl_init_chip(struct device *dev)
@@ -368,7 +368,7 @@
 #define LSM6DSL_MASK_FIFO_STATUS3_FIFO_PATTERN		0x0F
 #define LSM6DSL_SHIFT_FIFO_STATUS3_FIFO_PATTERN		0
 
-#define LSM6DSL_REG_FIFO_STATUS4			0x3C
+#define LSM6DSL_REG_FIFO_STATUS4			0x3D
 #define LSM6DSL_MASK_FIFO_STATUS4_FIFO_PATTERN		(BIT(1) | BIT(0))
 #define LSM6DSL_SHIFT_FIFO_STATUS4_FIFO_PATTERN		0
 
@@ -665,6 +665,17 @@ struct lsm6dsl_data {
 	struct device *dev;
 #endif
 
+#if defined(CONFIG_LSM6DSL_STREAM)
+	sensor_stream_handler_t stream_handler;
+	void *stream_user_data;
+	u8_t *stream_buf;
+	size_t stream_buf_size;
+	u16_t stream_watermark;
+	u32_t stream_period;
+	u32_t stream_irq_time;
+	struct sensor_stream_chan stream_chans[6];
+#endif
+
 #endif /* CONFIG_LSM6DSL_TRIGGER */
 };
 
@@ -681,6 +692,13 @@ int lsm6dsl_trigger_set(struct device *dev,
 			sensor_trigger_handler_t handler);
 
 int lsm6dsl_init_interrupt(struct device *dev);
+
+#if defined(CONFIG_LSM6DSL_STREAM)
+int lsm6dsl_stream_start(struct device *dev,
+			 const struct sensor_stream_config *cfg);
+int lsm6dsl_stream_stop(struct device *dev);
+void lsm6dsl_stream_handle(struct device *dev);
+#endif
 #endif
 
 #endif /* ZEPHYR_DRIVERS_SENSOR_LSM6DSL_LSM6DSL_H_ */
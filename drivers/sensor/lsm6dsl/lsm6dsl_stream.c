@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2018 STMicroelectronics
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <device.h>
+#include <misc/util.h>
+#include <kernel.h>
+#include <sensor.h>
+
+#include "lsm6dsl.h"
+
+#define LOG_LEVEL CONFIG_SENSOR_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_DECLARE(LSM6DSL);
+
+/* A FIFO frame holds the gyro data set, then the accel data set */
+#define LSM6DSL_FIFO_FRAME_WORDS	6
+#define LSM6DSL_FIFO_FRAME_SIZE		(LSM6DSL_FIFO_FRAME_WORDS * 2)
+#define LSM6DSL_FIFO_FTH_MAX		0x7FF
+
+/* FIFO_CTRL5 FIFO_MODE values */
+#define LSM6DSL_FIFO_MODE_BYPASS	0
+#define LSM6DSL_FIFO_MODE_CONTINUOUS	6
+
+/* Largest burst read, a multiple of the frame size */
+#define LSM6DSL_FIFO_BURST_SIZE		240
+
+/* Output data rates in 0.1 Hz, indexed by ODR register value */
+static const u32_t lsm6dsl_odr_dhz[] = {0, 125, 260, 520, 1040, 2080, 4160,
+					8330, 16600, 33300, 66600};
+
+static int lsm6dsl_fifo_mode_set(struct lsm6dsl_data *data, u8_t odr,
+				 u8_t mode)
+{
+	return data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL5,
+				       LSM6DSL_MASK_FIFO_CTRL5_ODR_FIFO |
+				       LSM6DSL_MASK_FIFO_CTRL5_FIFO_MODE,
+				       (odr << LSM6DSL_SHIFT_FIFO_CTRL5_ODR_FIFO) |
+				       (mode << LSM6DSL_SHIFT_FIFO_CTRL5_FIFO_MODE));
+}
+
+static void lsm6dsl_stream_chans_init(struct lsm6dsl_data *data)
+{
+	static const enum sensor_channel chans[] = {
+		SENSOR_CHAN_GYRO_X, SENSOR_CHAN_GYRO_Y, SENSOR_CHAN_GYRO_Z,
+		SENSOR_CHAN_ACCEL_X, SENSOR_CHAN_ACCEL_Y, SENSOR_CHAN_ACCEL_Z,
+	};
+	/* sensitivities are in mdps/LSB and mg/LSB */
+	u32_t gyro_range = (u32_t)(32768.0 * data->gyro_sensitivity *
+				   SENSOR_PI / 180 / 1000);
+	u32_t accel_range = (u32_t)(32768.0 * data->accel_sensitivity *
+				    SENSOR_G / 1000);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(chans); i++) {
+		data->stream_chans[i].chan = chans[i];
+		data->stream_chans[i].range = (i < 3) ? gyro_range :
+							accel_range;
+	}
+}
+
+int lsm6dsl_stream_start(struct device *dev,
+			 const struct sensor_stream_config *cfg)
+{
+	struct lsm6dsl_data *data = dev->driver_data;
+	u32_t fth = cfg->watermark * LSM6DSL_FIFO_FRAME_WORDS;
+	u8_t ctrl1_xl, odr, val;
+
+	if (cfg->handler == NULL || cfg->watermark == 0U ||
+	    fth > LSM6DSL_FIFO_FTH_MAX ||
+	    cfg->buf_size < cfg->watermark * LSM6DSL_FIFO_FRAME_SIZE) {
+		return -EINVAL;
+	}
+
+	/* both sensors must feed the FIFO at the same rate */
+	if (data->accel_freq != data->gyro_freq) {
+		LOG_ERR("Accel and gyro ODR differ.");
+		return -EINVAL;
+	}
+
+	if (data->hw_tf->read_reg(data, LSM6DSL_REG_CTRL1_XL, &ctrl1_xl) < 0) {
+		return -EIO;
+	}
+
+	odr = (ctrl1_xl & LSM6DSL_MASK_CTRL1_XL_ODR_XL) >>
+	      LSM6DSL_SHIFT_CTRL1_XL_ODR_XL;
+	if (odr == 0U || odr >= ARRAY_SIZE(lsm6dsl_odr_dhz)) {
+		return -EINVAL;
+	}
+
+	gpio_pin_disable_callback(data->gpio, DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
+
+	/* bypass mode empties the FIFO */
+	if (lsm6dsl_fifo_mode_set(data, 0, LSM6DSL_FIFO_MODE_BYPASS) < 0) {
+		goto err;
+	}
+
+	val = fth & LSM6DSL_MASK_FIFO_CTRL1_FTH;
+	if (data->hw_tf->write_data(data, LSM6DSL_REG_FIFO_CTRL1,
+				    &val, 1) < 0 ||
+	    data->hw_tf->update_reg(data, LSM6DSL_REG_FIFO_CTRL2,
+				    LSM6DSL_MASK_FIFO_CTRL2_FTH,
+				    fth >> 8) < 0) {
+		goto err;
+	}
+
+	/* no decimation of gyro and accel data sets */
+	val = (1 << LSM6DSL_SHIFT_FIFO_CTRL3_DEC_FIFO_GYRO) |
+	      (1 << LSM6DSL_SHIFT_FIFO_CTRL3_DEC_FIFO_XL);
+	if (data->hw_tf->write_data(data, LSM6DSL_REG_FIFO_CTRL3,
+				    &val, 1) < 0) {
+		goto err;
+	}
+
+	/* route the FIFO threshold instead of data-ready to int1 */
+	if (data->hw_tf->update_reg(data, LSM6DSL_REG_INT1_CTRL,
+				    LSM6DSL_MASK_INT1_FTH |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_XL |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_G,
+				    LSM6DSL_MASK_INT1_FTH) < 0) {
+		goto err;
+	}
+
+	lsm6dsl_stream_chans_init(data);
+	data->stream_period = (u32_t)(sys_clock_hw_cycles_per_sec() * 10ULL /
+				      lsm6dsl_odr_dhz[odr]);
+	data->stream_watermark = cfg->watermark;
+	data->stream_buf = cfg->buf;
+	data->stream_buf_size = cfg->buf_size;
+	data->stream_user_data = cfg->user_data;
+	data->stream_handler = cfg->handler;
+
+	if (lsm6dsl_fifo_mode_set(data, odr,
+				  LSM6DSL_FIFO_MODE_CONTINUOUS) < 0) {
+		data->stream_handler = NULL;
+		goto err;
+	}
+
+	gpio_pin_enable_callback(data->gpio, DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
+
+	return 0;
+
+err:
+	LOG_ERR("Could not configure FIFO.");
+	gpio_pin_enable_callback(data->gpio, DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
+	return -EIO;
+}
+
+int lsm6dsl_stream_stop(struct device *dev)
+{
+	struct lsm6dsl_data *data = dev->driver_data;
+	int ret = 0;
+
+	gpio_pin_disable_callback(data->gpio, DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
+
+	data->stream_handler = NULL;
+
+	if (lsm6dsl_fifo_mode_set(data, 0, LSM6DSL_FIFO_MODE_BYPASS) < 0 ||
+	    data->hw_tf->update_reg(data, LSM6DSL_REG_INT1_CTRL,
+				    LSM6DSL_MASK_INT1_FTH |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_XL |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_G,
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_XL |
+				    LSM6DSL_MASK_INT1_CTRL_DRDY_G) < 0) {
+		ret = -EIO;
+	}
+
+	gpio_pin_enable_callback(data->gpio, DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
+
+	return ret;
+}
+
+static int lsm6dsl_fifo_read(struct lsm6dsl_data *data, u8_t *buf,
+			     size_t len)
+{
+	u8_t chunk;
+
+	while (len > 0) {
+		chunk = MIN(len, LSM6DSL_FIFO_BURST_SIZE);
+		if (data->hw_tf->read_data(data, LSM6DSL_REG_FIFO_DATA_OUT_L,
+					   buf, chunk) < 0) {
+			return -EIO;
+		}
+
+		buf += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+void lsm6dsl_stream_handle(struct device *dev)
+{
+	struct lsm6dsl_data *data = dev->driver_data;
+	struct sensor_stream_data batch;
+	u8_t status[4];
+	u16_t words, pattern, frames;
+
+	if (data->hw_tf->read_data(data, LSM6DSL_REG_FIFO_STATUS1,
+				   status, sizeof(status)) < 0) {
+		LOG_ERR("Could not read FIFO status.");
+		return;
+	}
+
+	words = status[0] | ((status[1] & LSM6DSL_MASK_FIFO_STATUS2_DIFF_FIFO)
+			     << 8);
+	pattern = status[2] | ((status[3] &
+				LSM6DSL_MASK_FIFO_STATUS4_FIFO_PATTERN) << 8);
+
+	/* after an overrun the next word may not start a frame */
+	if (pattern != 0U) {
+		u8_t skip = (LSM6DSL_FIFO_FRAME_WORDS - pattern) * 2;
+
+		if (skip > words * 2 ||
+		    lsm6dsl_fifo_read(data, data->stream_buf, skip) < 0) {
+			return;
+		}
+
+		words -= skip / 2;
+	}
+
+	frames = MIN(words / LSM6DSL_FIFO_FRAME_WORDS,
+		     data->stream_buf_size / LSM6DSL_FIFO_FRAME_SIZE);
+	if (frames == 0U) {
+		return;
+	}
+
+	if (lsm6dsl_fifo_read(data, data->stream_buf,
+			      frames * LSM6DSL_FIFO_FRAME_SIZE) < 0) {
+		LOG_ERR("Could not read FIFO.");
+		return;
+	}
+
+	/* the threshold interrupt fired on sample number watermark */
+	batch.buf = data->stream_buf;
+	batch.chans = data->stream_chans;
+	batch.chan_count = LSM6DSL_FIFO_FRAME_WORDS;
+	batch.frame_count = frames;
+	batch.overrun = (status[1] & LSM6DSL_MASK_FIFO_STATUS2_OVER_RUN) != 0U;
+	batch.period = data->stream_period;
+	batch.timestamp = data->stream_irq_time +
+			  (s32_t)(frames - data->stream_watermark) *
+			  data->stream_period;
+
+	data->stream_handler(dev, &batch, data->stream_user_data);
+}
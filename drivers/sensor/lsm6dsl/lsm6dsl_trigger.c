@@ -47,6 +47,10 @@ static void lsm6dsl_gpio_callback(struct device *dev,
 
 	ARG_UNUSED(pins);
 
+#if defined(CONFIG_LSM6DSL_STREAM)
+	drv_data->stream_irq_time = k_cycle_get_32();
+#endif
+
 	gpio_pin_disable_callback(dev, DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
 
 #if defined(CONFIG_LSM6DSL_TRIGGER_OWN_THREAD)
@@ -61,6 +65,15 @@ static void lsm6dsl_thread_cb(void *arg)
 	struct device *dev = arg;
 	struct lsm6dsl_data *drv_data = dev->driver_data;
 
+#if defined(CONFIG_LSM6DSL_STREAM)
+	if (drv_data->stream_handler != NULL) {
+		lsm6dsl_stream_handle(dev);
+		gpio_pin_enable_callback(drv_data->gpio,
+					 DT_ST_LSM6DSL_0_IRQ_GPIOS_PIN);
+		return;
+	}
+#endif
+
 	if (drv_data->data_ready_handler != NULL) {
 		drv_data->data_ready_handler(dev,
 					     &drv_data->data_ready_trigger);
@@ -49,6 +49,11 @@ struct mcp9808_data {
 	struct device *dev;
 #endif
 
+#ifdef CONFIG_MCP9808_TRIGGER_DISPATCH
+	struct sensor_trigger_work trigger_work;
+	struct device *dev;
+#endif
+
 #ifdef CONFIG_MCP9808_TRIGGER
 	struct sensor_trigger trig;
 	sensor_trigger_handler_t trigger_handler;
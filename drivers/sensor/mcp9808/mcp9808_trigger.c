@@ -132,6 +132,30 @@ static void mcp9808_thread_main(int arg1, int arg2)
 
 static K_THREAD_STACK_DEFINE(mcp9808_thread_stack, CONFIG_MCP9808_THREAD_STACK_SIZE);
 static struct k_thread mcp9808_thread;
+#elif defined(CONFIG_MCP9808_TRIGGER_DISPATCH)
+
+static void mcp9808_gpio_cb(struct device *dev,
+			    struct gpio_callback *cb, u32_t pins)
+{
+	struct mcp9808_data *data =
+		CONTAINER_OF(cb, struct mcp9808_data, gpio_cb);
+
+	ARG_UNUSED(pins);
+
+	sensor_trigger_work_submit(&data->trigger_work);
+}
+
+static void mcp9808_trigger_work_cb(struct sensor_trigger_work *tw)
+{
+	struct mcp9808_data *data =
+		CONTAINER_OF(tw, struct mcp9808_data, trigger_work);
+	struct device *dev = data->dev;
+
+	data->trigger_handler(dev, &data->trig);
+	mcp9808_reg_update(data, MCP9808_REG_CONFIG,
+			   MCP9808_INT_CLEAR, MCP9808_INT_CLEAR);
+}
+
 #else /* CONFIG_MCP9808_TRIGGER_GLOBAL_THREAD */
 
 static void mcp9808_gpio_cb(struct device *dev,
@@ -176,6 +200,11 @@ void mcp9808_setup_interrupt(struct device *dev)
 			CONFIG_MCP9808_THREAD_STACK_SIZE,
 			(k_thread_entry_t)mcp9808_thread_main, dev, 0, NULL,
 			K_PRIO_COOP(CONFIG_MCP9808_THREAD_PRIORITY), 0, 0);
+#elif defined(CONFIG_MCP9808_TRIGGER_DISPATCH)
+	sensor_trigger_work_init(&data->trigger_work, mcp9808_trigger_work_cb,
+				 data->i2c_master,
+				 CONFIG_MCP9808_DISPATCH_QUEUE);
+	data->dev = dev;
 #else /* CONFIG_MCP9808_TRIGGER_GLOBAL_THREAD */
 	data->work.handler = mcp9808_gpio_thread_cb;
 	data->dev = dev;
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Shared sensor trigger dispatcher
+ *
+ * The interrupt handling of the sensor drivers runs in a few shared work
+ * queues instead of a thread and stack per driver. Each queue keeps a
+ * list of the pending trigger works and a single work item running them:
+ * after a handler, those pending on the same bus are run first.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <sensor.h>
+
+#define QUEUES	CONFIG_SENSOR_TRIGGER_DISPATCH_QUEUES
+#define PRIORITY	CONFIG_SENSOR_TRIGGER_DISPATCH_PRIORITY
+
+struct dispatch_queue {
+	struct k_work_q work_q;
+	struct k_work work;
+	sys_slist_t pending;
+};
+
+static struct dispatch_queue queues[QUEUES];
+
+static K_THREAD_STACK_ARRAY_DEFINE(dispatch_stacks, QUEUES,
+				   CONFIG_SENSOR_TRIGGER_DISPATCH_STACK_SIZE);
+
+void sensor_trigger_work_init(struct sensor_trigger_work *tw,
+			      sensor_trigger_work_handler_t handler,
+			      struct device *bus, unsigned int queue)
+{
+	tw->handler = handler;
+	tw->bus = bus;
+	tw->queue = MIN(queue, QUEUES - 1);
+	atomic_clear(&tw->pending);
+}
+
+void sensor_trigger_work_submit(struct sensor_trigger_work *tw)
+{
+	struct dispatch_queue *dq = &queues[tw->queue];
+	unsigned int key;
+
+	if (atomic_set(&tw->pending, 1) != 0) {
+		return;
+	}
+
+	key = irq_lock();
+	sys_slist_append(&dq->pending, &tw->node);
+	irq_unlock(key);
+
+	k_work_submit_to_queue(&dq->work_q, &dq->work);
+}
+
+/* The first pending work on bus, or on any bus if NULL */
+static struct sensor_trigger_work *dispatch_next(struct dispatch_queue *dq,
+						 struct device *bus)
+{
+	struct sensor_trigger_work *tw;
+	sys_snode_t *prev = NULL;
+	unsigned int key;
+
+	key = irq_lock();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&dq->pending, tw, node) {
+		if (bus == NULL || tw->bus == bus) {
+			sys_slist_remove(&dq->pending, prev, &tw->node);
+			irq_unlock(key);
+			return tw;
+		}
+
+		prev = &tw->node;
+	}
+
+	irq_unlock(key);
+
+	return NULL;
+}
+
+static void dispatch_work_cb(struct k_work *work)
+{
+	struct dispatch_queue *dq =
+		CONTAINER_OF(work, struct dispatch_queue, work);
+	struct sensor_trigger_work *tw;
+	struct device *bus = NULL;
+
+	while (true) {
+		tw = dispatch_next(dq, bus);
+		if (tw == NULL) {
+			if (bus == NULL) {
+				break;
+			}
+
+			/* Done with this bus, on to the oldest pending */
+			bus = NULL;
+			continue;
+		}
+
+		bus = tw->bus;
+
+		/* Interrupts raised from now on run the handler again */
+		atomic_clear(&tw->pending);
+		tw->handler(tw);
+	}
+}
+
+static int sensor_trigger_dispatch_init(struct device *dev)
+{
+	int i;
+
+	ARG_UNUSED(dev);
+
+	for (i = 0; i < QUEUES; i++) {
+		sys_slist_init(&queues[i].pending);
+		k_work_init(&queues[i].work, dispatch_work_cb);
+
+		k_work_q_start(&queues[i].work_q, dispatch_stacks[i],
+			       K_THREAD_STACK_SIZEOF(dispatch_stacks[i]),
+			       K_PRIO_COOP(PRIORITY + i));
+	}
+
+	return 0;
+}
+
+SYS_INIT(sensor_trigger_dispatch_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
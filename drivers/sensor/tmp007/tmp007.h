@@ -54,6 +54,9 @@ struct tmp007_data {
 #elif defined(CONFIG_TMP007_TRIGGER_GLOBAL_THREAD)
 	struct k_work work;
 	struct device *dev;
+#elif defined(CONFIG_TMP007_TRIGGER_DISPATCH)
+	struct sensor_trigger_work trigger_work;
+	struct device *dev;
 #endif
 
 #endif /* CONFIG_TMP007_TRIGGER */
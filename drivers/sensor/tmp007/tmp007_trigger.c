@@ -62,6 +62,8 @@ static void tmp007_gpio_callback(struct device *dev,
 	k_sem_give(&drv_data->gpio_sem);
 #elif defined(CONFIG_TMP007_TRIGGER_GLOBAL_THREAD)
 	k_work_submit(&drv_data->work);
+#elif defined(CONFIG_TMP007_TRIGGER_DISPATCH)
+	sensor_trigger_work_submit(&drv_data->trigger_work);
 #endif
 }
 
@@ -113,6 +115,16 @@ static void tmp007_work_cb(struct k_work *work)
 }
 #endif
 
+#ifdef CONFIG_TMP007_TRIGGER_DISPATCH
+static void tmp007_trigger_work_cb(struct sensor_trigger_work *tw)
+{
+	struct tmp007_data *drv_data =
+		CONTAINER_OF(tw, struct tmp007_data, trigger_work);
+
+	tmp007_thread_cb(drv_data->dev);
+}
+#endif
+
 int tmp007_trigger_set(struct device *dev,
 		       const struct sensor_trigger *trig,
 		       sensor_trigger_handler_t handler)
@@ -176,6 +188,11 @@ int tmp007_init_interrupt(struct device *dev)
 #elif defined(CONFIG_TMP007_TRIGGER_GLOBAL_THREAD)
 	drv_data->work.handler = tmp007_work_cb;
 	drv_data->dev = dev;
+#elif defined(CONFIG_TMP007_TRIGGER_DISPATCH)
+	sensor_trigger_work_init(&drv_data->trigger_work,
+				 tmp007_trigger_work_cb, drv_data->i2c,
+				 CONFIG_TMP007_DISPATCH_QUEUE);
+	drv_data->dev = dev;
 #endif
 
 	return 0;
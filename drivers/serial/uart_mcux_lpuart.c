@@ -11,12 +11,16 @@
 #include <fsl_lpuart.h>
 #include <soc.h>
 
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
+#define MCUX_LPUART_HAS_IRQ
+#endif
+
 struct mcux_lpuart_config {
 	LPUART_Type *base;
 	char *clock_name;
 	clock_control_subsys_t clock_subsys;
 	u32_t baud_rate;
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 	void (*irq_config_func)(struct device *dev);
 #endif
 };
@@ -26,6 +30,26 @@ struct mcux_lpuart_data {
 	uart_irq_callback_user_data_t callback;
 	void *cb_data;
 #endif
+#ifdef CONFIG_UART_ASYNC_API
+	struct device *dev;
+	uart_callback_t async_cb;
+	void *async_user_data;
+	/* transfer in flight, tx_len is 0 when idle */
+	const u8_t *tx_buf;
+	size_t tx_len;
+	size_t tx_pos;
+	struct k_delayed_work tx_timeout_work;
+	/* rx_buf is NULL when reception is disabled */
+	u8_t *rx_buf;
+	size_t rx_len;
+	size_t rx_offset;
+	size_t rx_reported;
+	u8_t *rx_next_buf;
+	size_t rx_next_len;
+	s32_t rx_timeout;
+	struct k_delayed_work rx_timeout_work;
+	u32_t rx_water_saved;
+#endif
 };
 
 static int mcux_lpuart_poll_in(struct device *dev, unsigned char *c)
@@ -34,6 +58,14 @@ static int mcux_lpuart_poll_in(struct device *dev, unsigned char *c)
 	u32_t flags = LPUART_GetStatusFlags(config->base);
 	int ret = -1;
 
+#ifdef CONFIG_UART_ASYNC_API
+	struct mcux_lpuart_data *data = dev->driver_data;
+
+	if (data->rx_buf != NULL) {
+		return -EBUSY;
+	}
+#endif
+
 	if (flags & kLPUART_RxDataRegFullFlag) {
 		*c = LPUART_ReadByte(config->base);
 		ret = 0;
@@ -218,16 +250,500 @@ static void mcux_lpuart_irq_callback_set(struct device *dev,
 	data->cb_data = cb_data;
 }
 
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#ifdef CONFIG_UART_ASYNC_API
+
+#define MCUX_LPUART_RX_IRQS (kLPUART_RxDataRegFullInterruptEnable | \
+			     kLPUART_IdleLineInterruptEnable | \
+			     kLPUART_RxOverrunInterruptEnable | \
+			     kLPUART_FramingErrorInterruptEnable | \
+			     kLPUART_ParityErrorInterruptEnable)
+
+#if defined(FSL_FEATURE_LPUART_HAS_FIFO) && FSL_FEATURE_LPUART_HAS_FIFO
+static size_t mcux_lpuart_rx_count(LPUART_Type *base)
+{
+	return (base->WATER & LPUART_WATER_RXCOUNT_MASK) >>
+		LPUART_WATER_RXCOUNT_SHIFT;
+}
+
+static size_t mcux_lpuart_tx_space(LPUART_Type *base)
+{
+	return FSL_FEATURE_LPUART_FIFO_SIZEn(base) -
+		((base->WATER & LPUART_WATER_TXCOUNT_MASK) >>
+		 LPUART_WATER_TXCOUNT_SHIFT);
+}
+#else
+static size_t mcux_lpuart_rx_count(LPUART_Type *base)
+{
+	return (LPUART_GetStatusFlags(base) & kLPUART_RxDataRegFullFlag) ?
+		1 : 0;
+}
+
+static size_t mcux_lpuart_tx_space(LPUART_Type *base)
+{
+	return (LPUART_GetStatusFlags(base) & kLPUART_TxDataRegEmptyFlag) ?
+		1 : 0;
+}
+#endif
+
+static void mcux_lpuart_async_evt(struct mcux_lpuart_data *data,
+				  struct uart_event *evt)
+{
+	if (data->async_cb) {
+		data->async_cb(evt, data->async_user_data);
+	}
+}
+
+static int mcux_lpuart_callback_set(struct device *dev,
+				    uart_callback_t callback, void *user_data)
+{
+	struct mcux_lpuart_data *data = dev->driver_data;
+
+	data->async_cb = callback;
+	data->async_user_data = user_data;
+
+	return 0;
+}
+
+static int mcux_lpuart_tx(struct device *dev, const u8_t *buf, size_t len,
+			  u32_t timeout)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	unsigned int key;
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->tx_len != 0U) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	data->tx_buf = buf;
+	data->tx_len = len;
+	data->tx_pos = 0;
+
+	if (timeout != K_FOREVER) {
+		k_delayed_work_submit(&data->tx_timeout_work, timeout);
+	}
+
+	/* the FIFO is filled from the interrupt */
+	LPUART_EnableInterrupts(config->base,
+				kLPUART_TxDataRegEmptyInterruptEnable);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int mcux_lpuart_tx_halt(struct device *dev)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+	};
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->tx_len == 0U) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	LPUART_DisableInterrupts(config->base,
+				 kLPUART_TxDataRegEmptyInterruptEnable |
+				 kLPUART_TransmissionCompleteInterruptEnable);
+
+	evt.data.tx.buf = data->tx_buf;
+	evt.data.tx.len = data->tx_pos;
+	data->tx_buf = NULL;
+	data->tx_len = 0U;
+
+	irq_unlock(key);
+
+	mcux_lpuart_async_evt(data, &evt);
+
+	return 0;
+}
+
+static void mcux_lpuart_tx_timeout(struct k_work *work)
+{
+	struct mcux_lpuart_data *data = CONTAINER_OF(work,
+						     struct mcux_lpuart_data,
+						     tx_timeout_work);
+
+	mcux_lpuart_tx_halt(data->dev);
+}
+
+static int mcux_lpuart_tx_abort(struct device *dev)
+{
+	struct mcux_lpuart_data *data = dev->driver_data;
+
+	k_delayed_work_cancel(&data->tx_timeout_work);
+
+	return mcux_lpuart_tx_halt(dev);
+}
+
+static void mcux_lpuart_tx_isr(struct device *dev)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	u32_t enabled = LPUART_GetEnabledInterrupts(config->base);
+	u32_t flags = LPUART_GetStatusFlags(config->base);
+	struct uart_event evt = {
+		.type = UART_TX_DONE,
+	};
+	size_t space;
+
+	if (data->tx_len == 0U) {
+		return;
+	}
+
+	if ((enabled & kLPUART_TxDataRegEmptyInterruptEnable) &&
+	    (flags & kLPUART_TxDataRegEmptyFlag)) {
+		space = mcux_lpuart_tx_space(config->base);
+		while (space-- > 0 && data->tx_pos < data->tx_len) {
+			LPUART_WriteByte(config->base,
+					 data->tx_buf[data->tx_pos++]);
+		}
+
+		if (data->tx_pos == data->tx_len) {
+			LPUART_DisableInterrupts(config->base,
+				kLPUART_TxDataRegEmptyInterruptEnable);
+			LPUART_EnableInterrupts(config->base,
+				kLPUART_TransmissionCompleteInterruptEnable);
+		}
+	} else if ((enabled & kLPUART_TransmissionCompleteInterruptEnable) &&
+		   (flags & kLPUART_TransmissionCompleteFlag)) {
+		LPUART_DisableInterrupts(config->base,
+			kLPUART_TransmissionCompleteInterruptEnable);
+		k_delayed_work_cancel(&data->tx_timeout_work);
+
+		evt.data.tx.buf = data->tx_buf;
+		evt.data.tx.len = data->tx_len;
+		data->tx_buf = NULL;
+		data->tx_len = 0U;
+
+		mcux_lpuart_async_evt(data, &evt);
+	}
+}
+
+/*
+ * The functions below run with interrupts locked.
+ */
+
+static void mcux_lpuart_rx_report(struct mcux_lpuart_data *data)
+{
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx = {
+			.buf = data->rx_buf,
+			.offset = data->rx_reported,
+			.len = data->rx_offset - data->rx_reported,
+		},
+	};
+
+	if (evt.data.rx.len == 0U) {
+		return;
+	}
+
+	data->rx_reported = data->rx_offset;
+
+	mcux_lpuart_async_evt(data, &evt);
+}
+
+static void mcux_lpuart_rx_release(struct mcux_lpuart_data *data,
+				   u8_t *buf)
+{
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+		.data.rx_buf.buf = buf,
+	};
+
+	mcux_lpuart_async_evt(data, &evt);
+}
+
+static void mcux_lpuart_rx_stop(struct device *dev)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx = {
+			.buf = data->rx_buf,
+			.offset = data->rx_reported,
+			.len = data->rx_offset - data->rx_reported,
+		},
+	};
+	u8_t *buf = data->rx_buf;
+	u8_t *next_buf = data->rx_next_buf;
+
+	LPUART_DisableInterrupts(config->base, MCUX_LPUART_RX_IRQS);
+#if defined(FSL_FEATURE_LPUART_HAS_FIFO) && FSL_FEATURE_LPUART_HAS_FIFO
+	config->base->WATER = data->rx_water_saved;
+#endif
+	k_delayed_work_cancel(&data->rx_timeout_work);
+
+	/* cleared first, the callbacks may enable reception again */
+	data->rx_buf = NULL;
+	data->rx_next_buf = NULL;
+
+	if (evt.data.rx.len != 0U) {
+		mcux_lpuart_async_evt(data, &evt);
+	}
+
+	if (buf != NULL) {
+		mcux_lpuart_rx_release(data, buf);
+	}
+
+	if (next_buf != NULL) {
+		mcux_lpuart_rx_release(data, next_buf);
+	}
+
+	evt.type = UART_RX_DISABLED;
+	mcux_lpuart_async_evt(data, &evt);
+}
+
+static void mcux_lpuart_rx_switch(struct device *dev)
+{
+	struct mcux_lpuart_data *data = dev->driver_data;
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	u8_t *buf = data->rx_buf;
+
+	if (data->rx_next_buf == NULL) {
+		mcux_lpuart_rx_stop(dev);
+		return;
+	}
+
+	mcux_lpuart_rx_report(data);
+	if (data->rx_buf != buf) {
+		/* reception disabled from the callback */
+		return;
+	}
+
+	data->rx_buf = data->rx_next_buf;
+	data->rx_len = data->rx_next_len;
+	data->rx_offset = 0;
+	data->rx_reported = 0;
+	data->rx_next_buf = NULL;
+
+	mcux_lpuart_rx_release(data, buf);
+	mcux_lpuart_async_evt(data, &evt);
+}
+
+/* Move the content of the RX FIFO to the user buffers */
+static void mcux_lpuart_rx_drain(struct device *dev)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	size_t count = mcux_lpuart_rx_count(config->base);
+
+	while (data->rx_buf != NULL && count-- > 0) {
+		data->rx_buf[data->rx_offset++] = LPUART_ReadByte(config->base);
+
+		if (data->rx_offset == data->rx_len) {
+			mcux_lpuart_rx_switch(dev);
+		}
+	}
+}
+
+static void mcux_lpuart_rx_isr(struct device *dev)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	u32_t flags;
+	int err;
+
+	if (data->rx_buf == NULL) {
+		return;
+	}
+
+	flags = LPUART_GetStatusFlags(config->base);
+
+	mcux_lpuart_rx_drain(dev);
+
+	err = mcux_lpuart_err_check(dev);
+	if (err != 0 && data->rx_buf != NULL) {
+		struct uart_event evt = {
+			.type = UART_RX_STOPPED,
+			.data.rx_stop.reason = err,
+		};
+
+		mcux_lpuart_rx_report(data);
+
+		if (data->rx_buf != NULL) {
+			evt.data.rx_stop.data.buf = data->rx_buf;
+			evt.data.rx_stop.data.offset = data->rx_offset;
+			mcux_lpuart_async_evt(data, &evt);
+			mcux_lpuart_rx_stop(dev);
+		}
+	} else if ((flags & kLPUART_IdleLineFlag) && data->rx_buf != NULL) {
+		/*
+		 * The line is idle after data, possibly left in the FIFO
+		 * below the watermark.
+		 */
+		LPUART_ClearStatusFlags(config->base, kLPUART_IdleLineFlag);
+
+		mcux_lpuart_rx_drain(dev);
+
+		if (data->rx_timeout == 0) {
+			mcux_lpuart_rx_report(data);
+		} else if (data->rx_timeout != K_FOREVER) {
+			k_delayed_work_submit(&data->rx_timeout_work,
+					      data->rx_timeout);
+		}
+	}
+}
+
+static void mcux_lpuart_rx_timeout(struct k_work *work)
+{
+	struct mcux_lpuart_data *data = CONTAINER_OF(work,
+						     struct mcux_lpuart_data,
+						     rx_timeout_work);
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->rx_buf != NULL) {
+		mcux_lpuart_rx_drain(data->dev);
+		mcux_lpuart_rx_report(data);
+	}
+
+	irq_unlock(key);
+}
+
+static int mcux_lpuart_rx_enable(struct device *dev, u8_t *buf, size_t len,
+				 u32_t timeout)
+{
+	const struct mcux_lpuart_config *config = dev->config->config_info;
+	struct mcux_lpuart_data *data = dev->driver_data;
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	unsigned int key;
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_buf != NULL) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	data->rx_buf = buf;
+	data->rx_len = len;
+	data->rx_offset = 0;
+	data->rx_reported = 0;
+	data->rx_next_buf = NULL;
+	data->rx_timeout = timeout;
+
+#if defined(FSL_FEATURE_LPUART_HAS_FIFO) && FSL_FEATURE_LPUART_HAS_FIFO
+	/* One interrupt per half FIFO, the idle line catches the rest */
+	data->rx_water_saved = config->base->WATER;
+	config->base->WATER = (data->rx_water_saved &
+			       ~LPUART_WATER_RXWATER_MASK) |
+			      LPUART_WATER_RXWATER(
+				      FSL_FEATURE_LPUART_FIFO_SIZEn(config->base) /
+				      2);
+#endif
+
+	LPUART_ClearStatusFlags(config->base, kLPUART_IdleLineFlag |
+					      kLPUART_RxOverrunFlag |
+					      kLPUART_ParityErrorFlag |
+					      kLPUART_FramingErrorFlag);
+	LPUART_EnableInterrupts(config->base, MCUX_LPUART_RX_IRQS);
+
+	mcux_lpuart_async_evt(data, &evt);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int mcux_lpuart_rx_buf_rsp(struct device *dev, u8_t *buf, size_t len)
+{
+	struct mcux_lpuart_data *data = dev->driver_data;
+	unsigned int key;
+	int ret = 0;
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_buf == NULL) {
+		ret = -EACCES;
+	} else if (data->rx_next_buf != NULL) {
+		ret = -EBUSY;
+	} else {
+		data->rx_next_buf = buf;
+		data->rx_next_len = len;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int mcux_lpuart_rx_disable(struct device *dev)
+{
+	struct mcux_lpuart_data *data = dev->driver_data;
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->rx_buf == NULL) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	mcux_lpuart_rx_drain(dev);
+
+	if (data->rx_buf != NULL) {
+		mcux_lpuart_rx_stop(dev);
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+#endif /* CONFIG_UART_ASYNC_API */
+
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_isr(void *arg)
 {
 	struct device *dev = arg;
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	struct mcux_lpuart_data *data = dev->driver_data;
 
 	if (data->callback) {
 		data->callback(data->cb_data);
 	}
+#endif
+#ifdef CONFIG_UART_ASYNC_API
+	unsigned int key = irq_lock();
+
+	mcux_lpuart_rx_isr(dev);
+	mcux_lpuart_tx_isr(dev);
+
+	irq_unlock(key);
+#endif
 }
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif
 
 static int mcux_lpuart_init(struct device *dev)
 {
@@ -253,7 +769,15 @@ static int mcux_lpuart_init(struct device *dev)
 
 	LPUART_Init(config->base, &uart_config, clock_freq);
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef CONFIG_UART_ASYNC_API
+	struct mcux_lpuart_data *data = dev->driver_data;
+
+	data->dev = dev;
+	k_delayed_work_init(&data->tx_timeout_work, mcux_lpuart_tx_timeout);
+	k_delayed_work_init(&data->rx_timeout_work, mcux_lpuart_rx_timeout);
+#endif
+
+#ifdef MCUX_LPUART_HAS_IRQ
 	config->irq_config_func(dev);
 #endif
 
@@ -280,11 +804,19 @@ static const struct uart_driver_api mcux_lpuart_driver_api = {
 	.irq_update = mcux_lpuart_irq_update,
 	.irq_callback_set = mcux_lpuart_irq_callback_set,
 #endif
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = mcux_lpuart_callback_set,
+	.tx = mcux_lpuart_tx,
+	.tx_abort = mcux_lpuart_tx_abort,
+	.rx_enable = mcux_lpuart_rx_enable,
+	.rx_buf_rsp = mcux_lpuart_rx_buf_rsp,
+	.rx_disable = mcux_lpuart_rx_disable,
+#endif
 };
 
 #ifdef CONFIG_UART_MCUX_LPUART_0
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_0(struct device *dev);
 #endif
 
@@ -294,7 +826,7 @@ static const struct mcux_lpuart_config mcux_lpuart_0_config = {
 	.clock_subsys =
 		(clock_control_subsys_t)DT_UART_MCUX_LPUART_0_CLOCK_SUBSYS,
 	.baud_rate = DT_UART_MCUX_LPUART_0_BAUD_RATE,
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 	.irq_config_func = mcux_lpuart_config_func_0,
 #endif
 };
@@ -307,7 +839,7 @@ DEVICE_AND_API_INIT(uart_0, DT_UART_MCUX_LPUART_0_NAME,
 		    PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
 		    &mcux_lpuart_driver_api);
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_0(struct device *dev)
 {
 	IRQ_CONNECT(DT_UART_MCUX_LPUART_0_IRQ_0,
@@ -330,7 +862,7 @@ static void mcux_lpuart_config_func_0(struct device *dev)
 
 #ifdef CONFIG_UART_MCUX_LPUART_1
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_1(struct device *dev);
 #endif
 
@@ -340,7 +872,7 @@ static const struct mcux_lpuart_config mcux_lpuart_1_config = {
 	.clock_subsys =
 		(clock_control_subsys_t)DT_UART_MCUX_LPUART_1_CLOCK_SUBSYS,
 	.baud_rate = DT_UART_MCUX_LPUART_1_BAUD_RATE,
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 	.irq_config_func = mcux_lpuart_config_func_1,
 #endif
 };
@@ -353,7 +885,7 @@ DEVICE_AND_API_INIT(uart_1, DT_UART_MCUX_LPUART_1_NAME,
 		    PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
 		    &mcux_lpuart_driver_api);
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_1(struct device *dev)
 {
 	IRQ_CONNECT(DT_UART_MCUX_LPUART_1_IRQ_0,
@@ -376,7 +908,7 @@ static void mcux_lpuart_config_func_1(struct device *dev)
 
 #ifdef CONFIG_UART_MCUX_LPUART_2
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_2(struct device *dev);
 #endif
 
@@ -386,7 +918,7 @@ static const struct mcux_lpuart_config mcux_lpuart_2_config = {
 	.clock_subsys =
 		(clock_control_subsys_t)DT_UART_MCUX_LPUART_2_CLOCK_SUBSYS,
 	.baud_rate = DT_UART_MCUX_LPUART_2_BAUD_RATE,
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 	.irq_config_func = mcux_lpuart_config_func_2,
 #endif
 };
@@ -399,7 +931,7 @@ DEVICE_AND_API_INIT(uart_2, DT_UART_MCUX_LPUART_2_NAME,
 		    PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
 		    &mcux_lpuart_driver_api);
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_2(struct device *dev)
 {
 	IRQ_CONNECT(DT_UART_MCUX_LPUART_2_IRQ_0,
@@ -422,7 +954,7 @@ static void mcux_lpuart_config_func_2(struct device *dev)
 
 #ifdef CONFIG_UART_MCUX_LPUART_3
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_3(struct device *dev);
 #endif
 
@@ -432,7 +964,7 @@ static const struct mcux_lpuart_config mcux_lpuart_3_config = {
 	.clock_subsys =
 		(clock_control_subsys_t)DT_UART_MCUX_LPUART_3_CLOCK_SUBSYS,
 	.baud_rate = DT_UART_MCUX_LPUART_3_BAUD_RATE,
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 	.irq_config_func = mcux_lpuart_config_func_3,
 #endif
 };
@@ -445,7 +977,7 @@ DEVICE_AND_API_INIT(uart_3, DT_UART_MCUX_LPUART_3_NAME,
 		    PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
 		    &mcux_lpuart_driver_api);
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef MCUX_LPUART_HAS_IRQ
 static void mcux_lpuart_config_func_3(struct device *dev)
 {
 	IRQ_CONNECT(DT_UART_MCUX_LPUART_3_IRQ_0,
@@ -19,6 +19,10 @@
 #include <init.h>
 #include <uart.h>
 #include <clock_control.h>
+#include <string.h>
+#ifdef CONFIG_UART_STM32_DMA
+#include <dma.h>
+#endif
 
 #include <linker/sections.h>
 #include <clock_control/stm32_clock_control.h>
@@ -372,6 +376,12 @@ static int uart_stm32_poll_in(struct device *dev, unsigned char *c)
 {
 	USART_TypeDef *UartInstance = UART_STRUCT(dev);
 
+#ifdef CONFIG_UART_STM32_DMA
+	if (DEV_DATA(dev)->rx_buf != NULL) {
+		return -EBUSY;
+	}
+#endif
+
 	/* Clear overrun error flag */
 	if (LL_USART_IsActiveFlag_ORE(UartInstance)) {
 		LL_USART_ClearFlag_ORE(UartInstance);
@@ -452,6 +462,560 @@ static inline void __uart_stm32_get_clock(struct device *dev)
 	data->clock = clk;
 }
 
+#ifdef CONFIG_UART_STM32_DMA
+
+static void uart_stm32_async_evt(struct uart_stm32_data *data,
+				 struct uart_event *evt)
+{
+	if (data->async_cb) {
+		data->async_cb(evt, data->async_user_data);
+	}
+}
+
+static int uart_stm32_callback_set(struct device *dev,
+				   uart_callback_t callback, void *user_data)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	data->async_cb = callback;
+	data->async_user_data = user_data;
+
+	return 0;
+}
+
+static int uart_stm32_dma_stream_start(struct device *dev, u32_t channel,
+				       u32_t slot, u32_t direction,
+				       struct dma_block_config *blk_cfg,
+				       void (*callback)(void *arg, u32_t id,
+							int error_code))
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_config dma_cfg = {
+		.dma_slot = slot,
+		.channel_direction = direction,
+		.source_data_size = 0, /* 8bit, see dma_width_index() */
+		.dest_data_size = 0,
+		.source_burst_length = 1, /* SINGLE transfer */
+		.dest_burst_length = 1,
+		/* for the circular RX transfer, a callback on each half */
+		.complete_callback_en = 1,
+		.block_count = 1,
+		.head_block = blk_cfg,
+		.callback_arg = dev,
+		.dma_callback = callback,
+	};
+	int ret;
+
+	ret = dma_config(data->dma, channel, &dma_cfg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return dma_start(data->dma, channel);
+}
+
+static void uart_stm32_dma_tx_callback(void *arg, u32_t id, int error_code)
+{
+	struct device *dev = arg;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+	struct uart_event evt = {
+		.type = UART_TX_DONE,
+		.data.tx = {
+			.buf = data->tx_buf,
+			.len = data->tx_len,
+		},
+	};
+
+	if (data->tx_len == 0U) {
+		return;
+	}
+
+	k_delayed_work_cancel(&data->tx_timeout_work);
+	LL_USART_DisableDMAReq_TX(UART_STRUCT(dev));
+
+	if (error_code != 0) {
+		evt.type = UART_TX_ABORTED;
+		if (dma_get_status(data->dma, id, &stat) == 0) {
+			evt.data.tx.len -= stat.pending_length;
+		}
+	}
+
+	data->tx_buf = NULL;
+	data->tx_len = 0U;
+
+	uart_stm32_async_evt(data, &evt);
+}
+
+static int uart_stm32_tx(struct device *dev, const u8_t *buf, size_t len,
+			 u32_t timeout)
+{
+	const struct uart_stm32_config *config = DEV_CFG(dev);
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct dma_block_config blk_cfg = {
+		.source_address = (u32_t)buf,
+		.dest_address = LL_USART_DMA_GetRegAddr(UartInstance),
+		.block_size = len,
+	};
+	unsigned int key;
+	int ret;
+
+	if (data->dma == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->tx_len != 0U) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	data->tx_buf = buf;
+	data->tx_len = len;
+
+	irq_unlock(key);
+
+	ret = uart_stm32_dma_stream_start(dev, config->dma_tx_channel,
+					  config->dma_tx_slot,
+					  MEMORY_TO_PERIPHERAL, &blk_cfg,
+					  uart_stm32_dma_tx_callback);
+	if (ret < 0) {
+		data->tx_buf = NULL;
+		data->tx_len = 0U;
+		return ret;
+	}
+
+	LL_USART_EnableDMAReq_TX(UartInstance);
+
+	/*
+	 * Without flow control the transfer cannot stall, the timeout only
+	 * bounds how long the peer may hold CTS. Skip it if the transfer
+	 * completed already.
+	 */
+	if (timeout != K_FOREVER &&
+	    uart_stm32_get_hwctrl(dev) == LL_USART_HWCONTROL_RTS_CTS) {
+		key = irq_lock();
+		if (data->tx_buf == buf) {
+			k_delayed_work_submit(&data->tx_timeout_work, timeout);
+		}
+		irq_unlock(key);
+	}
+
+	return 0;
+}
+
+static int uart_stm32_tx_halt(struct device *dev)
+{
+	const struct uart_stm32_config *config = DEV_CFG(dev);
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+	};
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->tx_len == 0U) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	LL_USART_DisableDMAReq_TX(UART_STRUCT(dev));
+	dma_stop(data->dma, config->dma_tx_channel);
+
+	evt.data.tx.buf = data->tx_buf;
+	evt.data.tx.len = data->tx_len;
+	if (dma_get_status(data->dma, config->dma_tx_channel, &stat) == 0) {
+		evt.data.tx.len -= stat.pending_length;
+	}
+
+	data->tx_buf = NULL;
+	data->tx_len = 0U;
+
+	irq_unlock(key);
+
+	uart_stm32_async_evt(data, &evt);
+
+	return 0;
+}
+
+static void uart_stm32_tx_timeout(struct k_work *work)
+{
+	struct uart_stm32_data *data = CONTAINER_OF(work,
+						    struct uart_stm32_data,
+						    tx_timeout_work);
+
+	uart_stm32_tx_halt(data->dev);
+}
+
+static int uart_stm32_tx_abort(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	if (data->dma == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_delayed_work_cancel(&data->tx_timeout_work);
+
+	return uart_stm32_tx_halt(dev);
+}
+
+/*
+ * The functions below run with interrupts locked, as they are called from
+ * both the USART and the DMA interrupts.
+ */
+
+static void uart_stm32_rx_report(struct uart_stm32_data *data)
+{
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx = {
+			.buf = data->rx_buf,
+			.offset = data->rx_reported,
+			.len = data->rx_offset - data->rx_reported,
+		},
+	};
+
+	if (evt.data.rx.len == 0U) {
+		return;
+	}
+
+	data->rx_reported = data->rx_offset;
+
+	uart_stm32_async_evt(data, &evt);
+}
+
+static void uart_stm32_rx_release(struct uart_stm32_data *data, u8_t *buf)
+{
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+		.data.rx_buf.buf = buf,
+	};
+
+	uart_stm32_async_evt(data, &evt);
+}
+
+static void uart_stm32_rx_stop(struct device *dev)
+{
+	const struct uart_stm32_config *config = DEV_CFG(dev);
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx = {
+			.buf = data->rx_buf,
+			.offset = data->rx_reported,
+			.len = data->rx_offset - data->rx_reported,
+		},
+	};
+	u8_t *buf = data->rx_buf;
+	u8_t *next_buf = data->rx_next_buf;
+
+	LL_USART_DisableIT_IDLE(UartInstance);
+	LL_USART_DisableIT_ERROR(UartInstance);
+	LL_USART_DisableIT_PE(UartInstance);
+	LL_USART_DisableDMAReq_RX(UartInstance);
+	dma_stop(data->dma, config->dma_rx_channel);
+	k_delayed_work_cancel(&data->rx_timeout_work);
+
+	/* cleared first, the callbacks may enable reception again */
+	data->rx_buf = NULL;
+	data->rx_next_buf = NULL;
+
+	if (evt.data.rx.len != 0U) {
+		uart_stm32_async_evt(data, &evt);
+	}
+
+	if (buf != NULL) {
+		uart_stm32_rx_release(data, buf);
+	}
+
+	if (next_buf != NULL) {
+		uart_stm32_rx_release(data, next_buf);
+	}
+
+	evt.type = UART_RX_DISABLED;
+	uart_stm32_async_evt(data, &evt);
+}
+
+static void uart_stm32_rx_switch(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	u8_t *buf = data->rx_buf;
+
+	if (data->rx_next_buf == NULL) {
+		uart_stm32_rx_stop(dev);
+		return;
+	}
+
+	uart_stm32_rx_report(data);
+	if (data->rx_buf != buf) {
+		/* reception disabled from the callback */
+		return;
+	}
+
+	data->rx_buf = data->rx_next_buf;
+	data->rx_len = data->rx_next_len;
+	data->rx_offset = 0;
+	data->rx_reported = 0;
+	data->rx_next_buf = NULL;
+
+	uart_stm32_rx_release(data, buf);
+	uart_stm32_async_evt(data, &evt);
+}
+
+/*
+ * Copy what the DMA stored in the ring since the last call to the user
+ * buffers.
+ */
+static void uart_stm32_rx_drain(struct device *dev)
+{
+	const struct uart_stm32_config *config = DEV_CFG(dev);
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+	size_t head, len;
+
+	if (dma_get_status(data->dma, config->dma_rx_channel, &stat) < 0) {
+		return;
+	}
+
+	/* NDTR counts down from the ring size and reloads at zero */
+	head = (sizeof(data->rx_ring) - stat.pending_length) %
+	       sizeof(data->rx_ring);
+
+	while (data->rx_buf != NULL && data->rx_ring_pos != head) {
+		len = ((head > data->rx_ring_pos) ? head :
+		       sizeof(data->rx_ring)) - data->rx_ring_pos;
+		len = MIN(len, data->rx_len - data->rx_offset);
+
+		memcpy(data->rx_buf + data->rx_offset,
+		       &data->rx_ring[data->rx_ring_pos], len);
+
+		data->rx_offset += len;
+		data->rx_ring_pos = (data->rx_ring_pos + len) %
+				    sizeof(data->rx_ring);
+
+		if (data->rx_offset == data->rx_len) {
+			uart_stm32_rx_switch(dev);
+		}
+	}
+}
+
+static void uart_stm32_dma_rx_callback(void *arg, u32_t id, int error_code)
+{
+	struct device *dev = arg;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	unsigned int key;
+
+	ARG_UNUSED(id);
+
+	/* the USART interrupt may have another priority */
+	key = irq_lock();
+
+	if (data->rx_buf != NULL) {
+		uart_stm32_rx_drain(dev);
+
+		if (error_code != 0 && data->rx_buf != NULL) {
+			uart_stm32_rx_stop(dev);
+		}
+	}
+
+	irq_unlock(key);
+}
+
+static void uart_stm32_rx_timeout(struct k_work *work)
+{
+	struct uart_stm32_data *data = CONTAINER_OF(work,
+						    struct uart_stm32_data,
+						    rx_timeout_work);
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->rx_buf != NULL) {
+		uart_stm32_rx_drain(data->dev);
+		uart_stm32_rx_report(data);
+	}
+
+	irq_unlock(key);
+}
+
+static void uart_stm32_async_isr(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	unsigned int key;
+	int err;
+
+	key = irq_lock();
+
+	if (data->rx_buf == NULL) {
+		irq_unlock(key);
+		return;
+	}
+
+	err = uart_stm32_err_check(dev);
+	if (err != 0) {
+		struct uart_event evt = {
+			.type = UART_RX_STOPPED,
+			.data.rx_stop.reason = err,
+		};
+
+		uart_stm32_rx_drain(dev);
+		uart_stm32_rx_report(data);
+
+		if (data->rx_buf != NULL) {
+			evt.data.rx_stop.data.buf = data->rx_buf;
+			evt.data.rx_stop.data.offset = data->rx_offset;
+			uart_stm32_async_evt(data, &evt);
+			uart_stm32_rx_stop(dev);
+		}
+	} else if (LL_USART_IsActiveFlag_IDLE(UartInstance)) {
+		/* The line is idle for a character time after data */
+		LL_USART_ClearFlag_IDLE(UartInstance);
+
+		uart_stm32_rx_drain(dev);
+
+		if (data->rx_timeout == 0) {
+			uart_stm32_rx_report(data);
+		} else if (data->rx_timeout != K_FOREVER) {
+			k_delayed_work_submit(&data->rx_timeout_work,
+					      data->rx_timeout);
+		}
+	}
+
+	irq_unlock(key);
+}
+
+static int uart_stm32_rx_enable(struct device *dev, u8_t *buf, size_t len,
+				u32_t timeout)
+{
+	const struct uart_stm32_config *config = DEV_CFG(dev);
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct dma_block_config blk_cfg = {
+		.source_address = LL_USART_DMA_GetRegAddr(UartInstance),
+		.dest_address = (u32_t)data->rx_ring,
+		.block_size = sizeof(data->rx_ring),
+		/* circular transfer */
+		.dest_reload_en = 1,
+	};
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+	unsigned int key;
+	int ret;
+
+	if (data->dma == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_buf != NULL) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	/* Reading SR then DR drops stale data and clears the error flags */
+	LL_USART_ClearFlag_ORE(UartInstance);
+
+	ret = uart_stm32_dma_stream_start(dev, config->dma_rx_channel,
+					  config->dma_rx_slot,
+					  PERIPHERAL_TO_MEMORY, &blk_cfg,
+					  uart_stm32_dma_rx_callback);
+	if (ret < 0) {
+		irq_unlock(key);
+		return ret;
+	}
+
+	data->rx_buf = buf;
+	data->rx_len = len;
+	data->rx_offset = 0;
+	data->rx_reported = 0;
+	data->rx_next_buf = NULL;
+	data->rx_timeout = timeout;
+	data->rx_ring_pos = 0;
+
+	LL_USART_EnableDMAReq_RX(UartInstance);
+	LL_USART_EnableIT_IDLE(UartInstance);
+	/* framing, overrun and noise errors while DMA requests are enabled */
+	LL_USART_EnableIT_ERROR(UartInstance);
+	LL_USART_EnableIT_PE(UartInstance);
+
+	uart_stm32_async_evt(data, &evt);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int uart_stm32_rx_buf_rsp(struct device *dev, u8_t *buf, size_t len)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	unsigned int key;
+	int ret = 0;
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_buf == NULL) {
+		ret = -EACCES;
+	} else if (data->rx_next_buf != NULL) {
+		ret = -EBUSY;
+	} else {
+		data->rx_next_buf = buf;
+		data->rx_next_len = len;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int uart_stm32_rx_disable(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->rx_buf == NULL) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	uart_stm32_rx_drain(dev);
+
+	if (data->rx_buf != NULL) {
+		uart_stm32_rx_stop(dev);
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+#endif /* CONFIG_UART_STM32_DMA */
+
 #ifdef CONFIG_UART_INTERRUPT_DRIVEN
 
 static int uart_stm32_fifo_fill(struct device *dev, const u8_t *tx_data,
@@ -599,17 +1163,24 @@ static void uart_stm32_irq_callback_set(struct device *dev,
 	data->user_data = cb_data;
 }
 
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_STM32_DMA)
 static void uart_stm32_isr(void *arg)
 {
 	struct device *dev = arg;
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	struct uart_stm32_data *data = DEV_DATA(dev);
 
 	if (data->user_cb) {
 		data->user_cb(data->user_data);
 	}
+#endif
+#ifdef CONFIG_UART_STM32_DMA
+	uart_stm32_async_isr(dev);
+#endif
 }
-
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif
 
 static const struct uart_driver_api uart_stm32_driver_api = {
 	.poll_in = uart_stm32_poll_in,
@@ -633,6 +1204,14 @@ static const struct uart_driver_api uart_stm32_driver_api = {
 	.irq_update = uart_stm32_irq_update,
 	.irq_callback_set = uart_stm32_irq_callback_set,
 #endif	/* CONFIG_UART_INTERRUPT_DRIVEN */
+#ifdef CONFIG_UART_STM32_DMA
+	.callback_set = uart_stm32_callback_set,
+	.tx = uart_stm32_tx,
+	.tx_abort = uart_stm32_tx_abort,
+	.rx_enable = uart_stm32_rx_enable,
+	.rx_buf_rsp = uart_stm32_rx_buf_rsp,
+	.rx_disable = uart_stm32_rx_disable,
+#endif
 };
 
 /**
@@ -691,14 +1270,37 @@ static int uart_stm32_init(struct device *dev)
 		;
 #endif /* !USART_ISR_REACK */
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef CONFIG_UART_STM32_DMA
+	data->dev = dev;
+	k_delayed_work_init(&data->tx_timeout_work, uart_stm32_tx_timeout);
+	k_delayed_work_init(&data->rx_timeout_work, uart_stm32_rx_timeout);
+
+	/* The controller is only used once it is initialized, at POST_KERNEL */
+	if (config->dma_name != NULL) {
+		data->dma = device_get_binding(config->dma_name);
+		if (data->dma == NULL) {
+			return -ENODEV;
+		}
+
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+		if (dma_request_channel(data->dma,
+					config->dma_rx_channel) < 0 ||
+		    dma_request_channel(data->dma,
+					config->dma_tx_channel) < 0) {
+			return -EBUSY;
+		}
+#endif
+	}
+#endif
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_STM32_DMA)
 	config->uconf.irq_config_func(dev);
 #endif
 	return 0;
 }
 
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_STM32_DMA)
 #define STM32_UART_IRQ_HANDLER_DECL(name)				\
 	static void uart_stm32_irq_config_func_##name(struct device *dev)
 #define STM32_UART_IRQ_HANDLER_FUNC(name)				\
@@ -729,7 +1331,8 @@ static const struct uart_stm32_config uart_stm32_cfg_##name = {		\
 	.pclken = { .bus = DT_UART_STM32_##name##_CLOCK_BUS,	\
 		    .enr = DT_UART_STM32_##name##_CLOCK_BITS	\
 	},								\
-	.hw_flow_control = DT_UART_STM32_##name##_HW_FLOW_CONTROL	\
+	.hw_flow_control = DT_UART_STM32_##name##_HW_FLOW_CONTROL,	\
+	UART_STM32_DMA_CFG(name)					\
 };									\
 									\
 static struct uart_stm32_data uart_stm32_data_##name = {		\
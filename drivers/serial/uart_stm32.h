@@ -12,6 +12,79 @@
 #ifndef ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_
 #define ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_
 
+#ifdef CONFIG_UART_STM32_DMA
+/* DMA streams and channels of the STM32F4 request mapping */
+#define USART_1_DMA_NAME	CONFIG_DMA_2_NAME
+#define USART_1_DMA_CHAN_RX	2
+#define USART_1_DMA_SLOT_RX	4
+#define USART_1_DMA_CHAN_TX	7
+#define USART_1_DMA_SLOT_TX	4
+
+#define USART_2_DMA_NAME	CONFIG_DMA_1_NAME
+#define USART_2_DMA_CHAN_RX	5
+#define USART_2_DMA_SLOT_RX	4
+#define USART_2_DMA_CHAN_TX	6
+#define USART_2_DMA_SLOT_TX	4
+
+#define USART_3_DMA_NAME	CONFIG_DMA_1_NAME
+#define USART_3_DMA_CHAN_RX	1
+#define USART_3_DMA_SLOT_RX	4
+#define USART_3_DMA_CHAN_TX	3
+#define USART_3_DMA_SLOT_TX	4
+
+#define UART_4_DMA_NAME		CONFIG_DMA_1_NAME
+#define UART_4_DMA_CHAN_RX	2
+#define UART_4_DMA_SLOT_RX	4
+#define UART_4_DMA_CHAN_TX	4
+#define UART_4_DMA_SLOT_TX	4
+
+#define UART_5_DMA_NAME		CONFIG_DMA_1_NAME
+#define UART_5_DMA_CHAN_RX	0
+#define UART_5_DMA_SLOT_RX	4
+#define UART_5_DMA_CHAN_TX	7
+#define UART_5_DMA_SLOT_TX	4
+
+#define USART_6_DMA_NAME	CONFIG_DMA_2_NAME
+#define USART_6_DMA_CHAN_RX	1
+#define USART_6_DMA_SLOT_RX	5
+#define USART_6_DMA_CHAN_TX	6
+#define USART_6_DMA_SLOT_TX	5
+
+#define UART_7_DMA_NAME		CONFIG_DMA_1_NAME
+#define UART_7_DMA_CHAN_RX	3
+#define UART_7_DMA_SLOT_RX	5
+#define UART_7_DMA_CHAN_TX	1
+#define UART_7_DMA_SLOT_TX	5
+
+#define UART_8_DMA_NAME		CONFIG_DMA_1_NAME
+#define UART_8_DMA_CHAN_RX	6
+#define UART_8_DMA_SLOT_RX	5
+#define UART_8_DMA_CHAN_TX	0
+#define UART_8_DMA_SLOT_TX	5
+
+/* No DMA mapping known, the asynchronous API is not supported */
+#define UART_9_DMA_NAME		NULL
+#define UART_9_DMA_CHAN_RX	0
+#define UART_9_DMA_SLOT_RX	0
+#define UART_9_DMA_CHAN_TX	0
+#define UART_9_DMA_SLOT_TX	0
+
+#define UART_10_DMA_NAME	NULL
+#define UART_10_DMA_CHAN_RX	0
+#define UART_10_DMA_SLOT_RX	0
+#define UART_10_DMA_CHAN_TX	0
+#define UART_10_DMA_SLOT_TX	0
+
+#define UART_STM32_DMA_CFG(name)				\
+	.dma_name = name##_DMA_NAME,				\
+	.dma_rx_channel = name##_DMA_CHAN_RX,			\
+	.dma_rx_slot = name##_DMA_SLOT_RX,			\
+	.dma_tx_channel = name##_DMA_CHAN_TX,			\
+	.dma_tx_slot = name##_DMA_SLOT_TX,
+#else
+#define UART_STM32_DMA_CFG(name)
+#endif /* CONFIG_UART_STM32_DMA */
+
 /* device config */
 struct uart_stm32_config {
 	struct uart_device_config uconf;
@@ -19,6 +92,13 @@ struct uart_stm32_config {
 	struct stm32_pclken pclken;
 	/* initial hardware flow control, 1 for RTS/CTS */
 	bool hw_flow_control;
+#ifdef CONFIG_UART_STM32_DMA
+	const char *dma_name;
+	u8_t dma_rx_channel;
+	u8_t dma_rx_slot;
+	u8_t dma_tx_channel;
+	u8_t dma_tx_slot;
+#endif
 };
 
 /* driver data */
@@ -31,6 +111,30 @@ struct uart_stm32_data {
 	uart_irq_callback_user_data_t user_cb;
 	void *user_data;
 #endif
+#ifdef CONFIG_UART_STM32_DMA
+	struct device *dev;
+	struct device *dma;
+	uart_callback_t async_cb;
+	void *async_user_data;
+	/* transfer in flight, tx_len is 0 when idle */
+	const u8_t *tx_buf;
+	size_t tx_len;
+	struct k_delayed_work tx_timeout_work;
+	/* buffers the received data is copied to, rx_buf is NULL when
+	 * reception is disabled
+	 */
+	u8_t *rx_buf;
+	size_t rx_len;
+	size_t rx_offset;
+	size_t rx_reported;
+	u8_t *rx_next_buf;
+	size_t rx_next_len;
+	s32_t rx_timeout;
+	struct k_delayed_work rx_timeout_work;
+	/* circular DMA buffer and the position read up to */
+	size_t rx_ring_pos;
+	u8_t rx_ring[CONFIG_UART_STM32_DMA_RX_RING_SIZE];
+#endif
 };
 
 #endif	/* ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_ */
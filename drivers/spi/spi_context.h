@@ -35,6 +35,12 @@ struct spi_context {
 	struct k_poll_signal *signal;
 	bool asynchronous;
 #endif /* CONFIG_SPI_ASYNC */
+#ifdef CONFIG_SPI_QUEUE
+	/* Transactions waiting for the lock */
+	sys_slist_t queue;
+	/* Driver hook starting a transaction once it holds the lock */
+	void (*queue_start)(struct spi_transaction *t);
+#endif /* CONFIG_SPI_QUEUE */
 	const struct spi_buf *current_tx;
 	size_t tx_count;
 	const struct spi_buf *current_rx;
@@ -79,6 +85,62 @@ static inline void spi_context_lock(struct spi_context *ctx,
 #endif /* CONFIG_SPI_ASYNC */
 }
 
+/*
+ * Give the lock back, or hand it over to the next queued transaction and
+ * start it through the driver hook.
+ */
+static inline void spi_context_unlock(struct spi_context *ctx)
+{
+#ifdef CONFIG_SPI_QUEUE
+	struct spi_transaction *t;
+	unsigned int key;
+	sys_snode_t *node;
+
+	key = irq_lock();
+	node = sys_slist_get(&ctx->queue);
+	if (!node) {
+		k_sem_give(&ctx->lock);
+		irq_unlock(key);
+		return;
+	}
+	irq_unlock(key);
+
+	t = CONTAINER_OF(node, struct spi_transaction, node);
+	ctx->asynchronous = true;
+	ctx->signal = t->signal;
+	ctx->queue_start(t);
+#else
+	k_sem_give(&ctx->lock);
+#endif /* CONFIG_SPI_QUEUE */
+}
+
+#ifdef CONFIG_SPI_QUEUE
+/*
+ * Take the lock for a queued transaction, or append it to the queue.
+ * Returns true if the caller must start it.
+ */
+static inline bool spi_context_queue_submit(struct spi_context *ctx,
+					    struct spi_transaction *t)
+{
+	unsigned int key;
+	bool start;
+
+	key = irq_lock();
+	start = (k_sem_take(&ctx->lock, K_NO_WAIT) == 0);
+	if (!start) {
+		sys_slist_append(&ctx->queue, &t->node);
+	}
+	irq_unlock(key);
+
+	if (start) {
+		ctx->asynchronous = true;
+		ctx->signal = t->signal;
+	}
+
+	return start;
+}
+#endif /* CONFIG_SPI_QUEUE */
+
 static inline void spi_context_release(struct spi_context *ctx, int status)
 {
 #ifdef CONFIG_SPI_SLAVE
@@ -89,10 +151,10 @@ static inline void spi_context_release(struct spi_context *ctx, int status)
 
 #ifdef CONFIG_SPI_ASYNC
 	if (!ctx->asynchronous || (status < 0)) {
-		k_sem_give(&ctx->lock);
+		spi_context_unlock(ctx);
 	}
 #else
-	k_sem_give(&ctx->lock);
+	spi_context_unlock(ctx);
 #endif /* CONFIG_SPI_ASYNC */
 }
 
@@ -138,7 +200,7 @@ static inline void spi_context_complete(struct spi_context *ctx, int status)
 		}
 
 		if (!(ctx->config->operation & SPI_LOCK_ON)) {
-			k_sem_give(&ctx->lock);
+			spi_context_unlock(ctx);
 		}
 	}
 #else
@@ -14,6 +14,9 @@ LOG_MODULE_REGISTER(spi_ll_stm32);
 #include <errno.h>
 #include <spi.h>
 #include <toolchain.h>
+#ifdef CONFIG_SPI_STM32_DMA
+#include <dma.h>
+#endif
 
 #include <clock_control/stm32_clock_control.h>
 #include <clock_control.h>
@@ -44,6 +47,11 @@ LOG_MODULE_REGISTER(spi_ll_stm32);
 /* Value to shift out when no application data needs transmitting. */
 #define SPI_STM32_TX_NOP 0x00
 
+/* Completion is signaled from an interrupt, as needed by async and queue */
+#if defined(CONFIG_SPI_STM32_INTERRUPT) || defined(CONFIG_SPI_STM32_DMA)
+#define SPI_STM32_IRQ_COMPLETION
+#endif
+
 static bool spi_stm32_transfer_ongoing(struct spi_stm32_data *data)
 {
 	return spi_context_tx_on(&data->ctx) || spi_context_rx_on(&data->ctx);
@@ -199,7 +207,7 @@ static void spi_stm32_complete(struct spi_stm32_data *data, SPI_TypeDef *spi,
 
 	LL_SPI_Disable(spi);
 
-#ifdef CONFIG_SPI_STM32_INTERRUPT
+#ifdef SPI_STM32_IRQ_COMPLETION
 	spi_context_complete(&data->ctx, status);
 #endif
 }
@@ -358,34 +366,167 @@ static int spi_stm32_release(struct device *dev,
 	return 0;
 }
 
-static int transceive(struct device *dev,
-		      const struct spi_config *config,
-		      const struct spi_buf_set *tx_bufs,
-		      const struct spi_buf_set *rx_bufs,
-		      bool asynchronous, struct k_poll_signal *signal)
+#ifdef CONFIG_SPI_STM32_DMA
+/* Frames shifted out, or received, when a direction has no buffer. */
+#define SPI_STM32_DMA_DUMMY_SIZE 64
+static u8_t spi_stm32_dma_tx_nop[SPI_STM32_DMA_DUMMY_SIZE];
+static u8_t spi_stm32_dma_rx_sink[SPI_STM32_DMA_DUMMY_SIZE];
+
+static void spi_stm32_dma_callback(void *arg, u32_t channel, int status);
+
+static int spi_stm32_dma_stream_start(struct device *dev, u32_t channel,
+				      u32_t slot, u32_t direction,
+				      u32_t src, u32_t dst, size_t len)
+{
+	struct spi_stm32_data *data = DEV_DATA(dev);
+	struct dma_block_config blk_cfg = {
+		.source_address = src,
+		.dest_address = dst,
+		.block_size = len,
+	};
+	struct dma_config dma_cfg = {
+		.dma_slot = slot,
+		.channel_direction = direction,
+		.source_data_size = 0, /* 8bit, see dma_width_index() */
+		.dest_data_size = 0,
+		.source_burst_length = 1, /* SINGLE transfer */
+		.dest_burst_length = 1,
+		.block_count = 1,
+		.head_block = &blk_cfg,
+		.callback_arg = dev,
+		.dma_callback = spi_stm32_dma_callback,
+	};
+	int ret;
+
+	ret = dma_config(data->dma, channel, &dma_cfg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return dma_start(data->dma, channel);
+}
+
+/*
+ * Start the DMA transfer of the longest chunk both directions can move from
+ * their current buffers.
+ */
+static int spi_stm32_dma_start(struct device *dev)
 {
 	const struct spi_stm32_config *cfg = DEV_CFG(dev);
 	struct spi_stm32_data *data = DEV_DATA(dev);
 	SPI_TypeDef *spi = cfg->spi;
+	u32_t dr = LL_SPI_DMA_GetRegAddr(spi);
+	const u8_t *tx = data->ctx.tx_buf;
+	u8_t *rx = data->ctx.rx_buf;
+	size_t len = spi_context_longest_current_buf(&data->ctx);
 	int ret;
 
-	if (!tx_bufs && !rx_bufs) {
-		return 0;
+	if (!spi_context_tx_buf_on(&data->ctx)) {
+		tx = spi_stm32_dma_tx_nop;
+		len = MIN(len, sizeof(spi_stm32_dma_tx_nop));
 	}
 
-#ifndef CONFIG_SPI_STM32_INTERRUPT
-	if (asynchronous) {
-		return -ENOTSUP;
+	if (!spi_context_rx_buf_on(&data->ctx)) {
+		rx = spi_stm32_dma_rx_sink;
+		len = MIN(len, sizeof(spi_stm32_dma_rx_sink));
 	}
-#endif
 
-	spi_context_lock(&data->ctx, asynchronous, signal);
+	data->dma_len = len;
+	data->dma_pending = 2U;
+	data->dma_status = 0;
+
+	/* RX first, so that no frame is missed once TX starts */
+	ret = spi_stm32_dma_stream_start(dev, cfg->dma_rx_channel,
+					 cfg->dma_rx_slot,
+					 PERIPHERAL_TO_MEMORY,
+					 dr, (u32_t)rx, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	LL_SPI_EnableDMAReq_RX(spi);
+
+	ret = spi_stm32_dma_stream_start(dev, cfg->dma_tx_channel,
+					 cfg->dma_tx_slot,
+					 MEMORY_TO_PERIPHERAL,
+					 (u32_t)tx, dr, len);
+	if (ret < 0) {
+		dma_stop(data->dma, cfg->dma_rx_channel);
+		return ret;
+	}
+
+	LL_SPI_EnableDMAReq_TX(spi);
+
+	return 0;
+}
+
+static void spi_stm32_dma_callback(void *arg, u32_t channel, int status)
+{
+	struct device *dev = arg;
+	const struct spi_stm32_config *cfg = DEV_CFG(dev);
+	struct spi_stm32_data *data = DEV_DATA(dev);
+	SPI_TypeDef *spi = cfg->spi;
+	unsigned int key;
+	u8_t pending;
+
+	ARG_UNUSED(channel);
+
+	key = irq_lock();
+	if (status < 0) {
+		data->dma_status = status;
+	}
+	pending = --data->dma_pending;
+	irq_unlock(key);
+
+	/* wait for both the TX and RX streams */
+	if (pending) {
+		return;
+	}
+
+	if (!data->dma_status) {
+		spi_context_update_tx(&data->ctx, 1, data->dma_len);
+		spi_context_update_rx(&data->ctx, 1, data->dma_len);
+
+		if (spi_stm32_transfer_ongoing(data)) {
+			data->dma_status = spi_stm32_dma_start(dev);
+			if (!data->dma_status) {
+				return;
+			}
+		}
+	}
+
+	LL_SPI_DisableDMAReq_TX(spi);
+	LL_SPI_DisableDMAReq_RX(spi);
+
+	spi_stm32_complete(data, spi, data->dma_status);
+}
+#endif /* CONFIG_SPI_STM32_DMA */
+
+/*
+ * Configure the bus for config, assert CS and start shifting the buffers.
+ * Completion is signaled by spi_stm32_complete() in interrupt driven modes.
+ */
+static int spi_stm32_start(struct device *dev,
+			   const struct spi_config *config,
+			   const struct spi_buf_set *tx_bufs,
+			   const struct spi_buf_set *rx_bufs)
+{
+	const struct spi_stm32_config *cfg = DEV_CFG(dev);
+	struct spi_stm32_data *data = DEV_DATA(dev);
+	SPI_TypeDef *spi = cfg->spi;
+	int ret;
 
 	ret = spi_stm32_configure(dev, config);
 	if (ret) {
 		return ret;
 	}
 
+#ifdef CONFIG_SPI_STM32_DMA
+	if (SPI_WORD_SIZE_GET(config->operation) != 8) {
+		return -ENOTSUP;
+	}
+#endif
+
 	/* Set buffers info */
 	spi_context_buffers_setup(&data->ctx, tx_bufs, rx_bufs, 1);
 
@@ -401,7 +542,14 @@ static int transceive(struct device *dev,
 	/* This is turned off in spi_stm32_complete(). */
 	spi_context_cs_control(&data->ctx, true);
 
-#ifdef CONFIG_SPI_STM32_INTERRUPT
+#if defined(CONFIG_SPI_STM32_DMA)
+	ret = spi_stm32_dma_start(dev);
+	if (ret) {
+		LL_SPI_DisableDMAReq_RX(spi);
+		spi_context_cs_control(&data->ctx, false);
+		LL_SPI_Disable(spi);
+	}
+#elif defined(CONFIG_SPI_STM32_INTERRUPT)
 	LL_SPI_EnableIT_ERR(spi);
 
 	if (rx_bufs) {
@@ -409,7 +557,42 @@ static int transceive(struct device *dev,
 	}
 
 	LL_SPI_EnableIT_TXE(spi);
+#endif
+
+	return ret;
+}
+
+static int transceive(struct device *dev,
+		      const struct spi_config *config,
+		      const struct spi_buf_set *tx_bufs,
+		      const struct spi_buf_set *rx_bufs,
+		      bool asynchronous, struct k_poll_signal *signal)
+{
+	struct spi_stm32_data *data = DEV_DATA(dev);
+#ifndef SPI_STM32_IRQ_COMPLETION
+	SPI_TypeDef *spi = DEV_CFG(dev)->spi;
+#endif
+	int ret;
+
+	if (!tx_bufs && !rx_bufs) {
+		return 0;
+	}
+
+#ifndef SPI_STM32_IRQ_COMPLETION
+	if (asynchronous) {
+		return -ENOTSUP;
+	}
+#endif
 
+	spi_context_lock(&data->ctx, asynchronous, signal);
+
+	ret = spi_stm32_start(dev, config, tx_bufs, rx_bufs);
+	if (ret) {
+		spi_context_release(&data->ctx, ret);
+		return ret;
+	}
+
+#ifdef SPI_STM32_IRQ_COMPLETION
 	ret = spi_context_wait_for_completion(&data->ctx);
 #else
 	do {
@@ -450,12 +633,44 @@ static int spi_stm32_transceive_async(struct device *dev,
 }
 #endif /* CONFIG_SPI_ASYNC */
 
+#if defined(CONFIG_SPI_QUEUE) && defined(SPI_STM32_IRQ_COMPLETION)
+#define SPI_STM32_QUEUE
+
+/* Called with the context lock held, possibly from interrupt context */
+static void spi_stm32_queue_start(struct spi_transaction *t)
+{
+	struct spi_stm32_data *data = DEV_DATA(t->dev);
+	int ret;
+
+	ret = spi_stm32_start(t->dev, t->config, t->tx_bufs, t->rx_bufs);
+	if (ret) {
+		/* signals the error and starts the next transaction */
+		spi_context_complete(&data->ctx, ret);
+	}
+}
+
+static int spi_stm32_transceive_queued(struct device *dev,
+				       struct spi_transaction *t)
+{
+	struct spi_stm32_data *data = DEV_DATA(dev);
+
+	if (spi_context_queue_submit(&data->ctx, t)) {
+		spi_stm32_queue_start(t);
+	}
+
+	return 0;
+}
+#endif
+
 static const struct spi_driver_api api_funcs = {
 	.transceive = spi_stm32_transceive,
 #ifdef CONFIG_SPI_ASYNC
 	.transceive_async = spi_stm32_transceive_async,
 #endif
 	.release = spi_stm32_release,
+#ifdef SPI_STM32_QUEUE
+	.transceive_queued = spi_stm32_transceive_queued,
+#endif
 };
 
 static int spi_stm32_init(struct device *dev)
@@ -475,6 +690,26 @@ static int spi_stm32_init(struct device *dev)
 	cfg->irq_config(dev);
 #endif
 
+#ifdef CONFIG_SPI_STM32_DMA
+	data->dma = device_get_binding(cfg->dma_name);
+	if (!data->dma) {
+		LOG_ERR("%s device not found", cfg->dma_name);
+		return -ENODEV;
+	}
+
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	if (dma_request_channel(data->dma, cfg->dma_rx_channel) < 0 ||
+	    dma_request_channel(data->dma, cfg->dma_tx_channel) < 0) {
+		LOG_ERR("%s streams in use", cfg->dma_name);
+		return -EBUSY;
+	}
+#endif
+#endif
+
+#ifdef SPI_STM32_QUEUE
+	data->ctx.queue_start = spi_stm32_queue_start;
+#endif
+
 	spi_context_unlock_unconditionally(&data->ctx);
 
 	return 0;
@@ -495,6 +730,7 @@ static const struct spi_stm32_config spi_stm32_cfg_1 = {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	.irq_config = spi_stm32_irq_config_func_1,
 #endif
+	SPI_STM32_DMA_CFG(1)
 };
 
 static struct spi_stm32_data spi_stm32_dev_data_1 = {
@@ -533,6 +769,7 @@ static const struct spi_stm32_config spi_stm32_cfg_2 = {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	.irq_config = spi_stm32_irq_config_func_2,
 #endif
+	SPI_STM32_DMA_CFG(2)
 };
 
 static struct spi_stm32_data spi_stm32_dev_data_2 = {
@@ -571,6 +808,7 @@ static const  struct spi_stm32_config spi_stm32_cfg_3 = {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	.irq_config = spi_stm32_irq_config_func_3,
 #endif
+	SPI_STM32_DMA_CFG(3)
 };
 
 static struct spi_stm32_data spi_stm32_dev_data_3 = {
@@ -609,6 +847,7 @@ static const  struct spi_stm32_config spi_stm32_cfg_4 = {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	.irq_config = spi_stm32_irq_config_func_4,
 #endif
+	SPI_STM32_DMA_CFG(4)
 };
 
 static struct spi_stm32_data spi_stm32_dev_data_4 = {
@@ -647,6 +886,7 @@ static const  struct spi_stm32_config spi_stm32_cfg_5 = {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	.irq_config = spi_stm32_irq_config_func_5,
 #endif
+	SPI_STM32_DMA_CFG(5)
 };
 
 static struct spi_stm32_data spi_stm32_dev_data_5 = {
@@ -685,6 +925,7 @@ static const  struct spi_stm32_config spi_stm32_cfg_6 = {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	.irq_config = spi_stm32_irq_config_func_6,
 #endif
+	SPI_STM32_DMA_CFG(6)
 };
 
 static struct spi_stm32_data spi_stm32_dev_data_6 = {
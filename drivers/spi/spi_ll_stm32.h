@@ -9,6 +9,54 @@
 
 #include "spi_context.h"
 
+#ifdef CONFIG_SPI_STM32_DMA
+/* DMA streams and channels of the STM32F4 request mapping */
+#define SPI1_DMA_NAME		CONFIG_DMA_2_NAME
+#define SPI1_DMA_CHAN_RX	0
+#define SPI1_DMA_SLOT_RX	3
+#define SPI1_DMA_CHAN_TX	3
+#define SPI1_DMA_SLOT_TX	3
+
+#define SPI2_DMA_NAME		CONFIG_DMA_1_NAME
+#define SPI2_DMA_CHAN_RX	3
+#define SPI2_DMA_SLOT_RX	0
+#define SPI2_DMA_CHAN_TX	4
+#define SPI2_DMA_SLOT_TX	0
+
+#define SPI3_DMA_NAME		CONFIG_DMA_1_NAME
+#define SPI3_DMA_CHAN_RX	0
+#define SPI3_DMA_SLOT_RX	0
+#define SPI3_DMA_CHAN_TX	5
+#define SPI3_DMA_SLOT_TX	0
+
+#define SPI4_DMA_NAME		CONFIG_DMA_2_NAME
+#define SPI4_DMA_CHAN_RX	0
+#define SPI4_DMA_SLOT_RX	4
+#define SPI4_DMA_CHAN_TX	1
+#define SPI4_DMA_SLOT_TX	4
+
+#define SPI5_DMA_NAME		CONFIG_DMA_2_NAME
+#define SPI5_DMA_CHAN_RX	3
+#define SPI5_DMA_SLOT_RX	2
+#define SPI5_DMA_CHAN_TX	4
+#define SPI5_DMA_SLOT_TX	2
+
+#define SPI6_DMA_NAME		CONFIG_DMA_2_NAME
+#define SPI6_DMA_CHAN_RX	6
+#define SPI6_DMA_SLOT_RX	1
+#define SPI6_DMA_CHAN_TX	5
+#define SPI6_DMA_SLOT_TX	1
+
+#define SPI_STM32_DMA_CFG(n)					\
+	.dma_name = SPI##n##_DMA_NAME,				\
+	.dma_rx_channel = SPI##n##_DMA_CHAN_RX,			\
+	.dma_rx_slot = SPI##n##_DMA_SLOT_RX,			\
+	.dma_tx_channel = SPI##n##_DMA_CHAN_TX,			\
+	.dma_tx_slot = SPI##n##_DMA_SLOT_TX,
+#else
+#define SPI_STM32_DMA_CFG(n)
+#endif /* CONFIG_SPI_STM32_DMA */
+
 typedef void (*irq_config_func_t)(struct device *port);
 
 struct spi_stm32_config {
@@ -17,10 +65,24 @@ struct spi_stm32_config {
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	irq_config_func_t irq_config;
 #endif
+#ifdef CONFIG_SPI_STM32_DMA
+	const char *dma_name;
+	u8_t dma_rx_channel;
+	u8_t dma_rx_slot;
+	u8_t dma_tx_channel;
+	u8_t dma_tx_slot;
+#endif
 };
 
 struct spi_stm32_data {
 	struct spi_context ctx;
+#ifdef CONFIG_SPI_STM32_DMA
+	struct device *dma;
+	/* frames of the chunk in flight, and its DMA streams still busy */
+	size_t dma_len;
+	u8_t dma_pending;
+	int dma_status;
+#endif
 };
 
 #endif	/* ZEPHYR_DRIVERS_SPI_SPI_LL_STM32_H_ */
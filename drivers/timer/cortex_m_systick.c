@@ -44,6 +44,9 @@ static u32_t last_load;
 
 static u32_t cycle_count;
 
+/* Wraps of cycle_count, for the 64 bit cycle counter */
+static u32_t cycle_count_hi;
+
 static u32_t announced_cycles;
 
 static volatile u32_t overflow_cyc;
@@ -82,13 +85,23 @@ static u32_t elapsed(void)
 	return (last_load - val) + overflow_cyc;
 }
 
+static void cycle_count_add(u32_t cyc)
+{
+	u32_t prev = cycle_count;
+
+	cycle_count += cyc;
+	if (cycle_count < prev) {
+		cycle_count_hi++;
+	}
+}
+
 /* Callout out of platform assembly, not hooked via IRQ_CONNECT... */
 void z_clock_isr(void *arg)
 {
 	ARG_UNUSED(arg);
 	u32_t dticks;
 
-	cycle_count += last_load;
+	cycle_count_add(last_load);
 	dticks = (cycle_count - announced_cycles) / CYC_PER_TICK;
 	announced_cycles += dticks * CYC_PER_TICK;
 
@@ -136,7 +149,7 @@ void z_clock_set_timeout(s32_t ticks, bool idle)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	cycle_count += elapsed();
+	cycle_count_add(elapsed());
 
 	/* Round delay up to next tick boundary */
 	delay = delay + (cycle_count - announced_cycles);
@@ -173,6 +186,15 @@ u32_t z_timer_cycle_get_32(void)
 	return ret;
 }
 
+u64_t z_timer_cycle_get_64(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u64_t ret = (((u64_t)cycle_count_hi << 32) | cycle_count) + elapsed();
+
+	k_spin_unlock(&lock, key);
+	return ret;
+}
+
 void z_clock_idle_exit(void)
 {
 	if (last_load == TIMER_STOPPED) {
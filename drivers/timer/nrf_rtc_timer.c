@@ -26,6 +26,9 @@ static struct k_spinlock lock;
 
 static u32_t last_count;
 
+/* Wraps of last_count, for the 64 bit cycle counter */
+static u32_t last_count_hi;
+
 static u32_t counter_sub(u32_t a, u32_t b)
 {
 	return (a - b) & COUNTER_MAX;
@@ -59,6 +62,9 @@ void rtc1_nrf_isr(void *arg)
 	u32_t dticks = counter_sub(t, last_count) / CYC_PER_TICK;
 
 	last_count += dticks * CYC_PER_TICK;
+	if (last_count < dticks * CYC_PER_TICK) {
+		last_count_hi++;
+	}
 
 	if (!IS_ENABLED(CONFIG_TICKLESS_KERNEL)) {
 		u32_t next = last_count + CYC_PER_TICK;
@@ -155,3 +161,13 @@ u32_t z_timer_cycle_get_32(void)
 	k_spin_unlock(&lock, key);
 	return ret;
 }
+
+u64_t z_timer_cycle_get_64(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u64_t ret = (((u64_t)last_count_hi << 32) | last_count) +
+		    counter_sub(counter(), last_count);
+
+	k_spin_unlock(&lock, key);
+	return ret;
+}
@@ -42,6 +42,7 @@ LOG_MODULE_REGISTER(usb_nrfx);
 
 #define MAX_EP_BUF_SZ           64UL
 #define MAX_ISO_EP_BUF_SZ       1024UL
+#define MAX_EP_XFERS            2
 
 #define USBD_EPSTATUS_EPIN_MASK         (0x1FF << USBD_EPSTATUS_EPIN0_Pos)
 #define USBD_EPSTATUS_EPOUT_MASK        (0x1FF << USBD_EPSTATUS_EPOUT0_Pos)
@@ -117,6 +118,23 @@ struct nrf_usbd_ep_buf {
 	u8_t *curr;
 };
 
+/**
+ * @brief Multi-packet transfer, moved by EasyDMA to or from the buffer
+ *
+ * @param data   Transfer buffer.
+ * @param len    Length of the buffer.
+ * @param flags  Transfer flags (USB_DC_XFER_ZLP).
+ * @param cb     Completion callback.
+ * @param priv   Data passed to the callback.
+ */
+struct nrf_usbd_xfer {
+	u8_t *data;
+	u32_t len;
+	unsigned int flags;
+	usb_dc_ep_xfer_callback cb;
+	void *priv;
+};
+
 /**
  * @brief Endpoint context
  *
@@ -126,6 +144,8 @@ struct nrf_usbd_ep_buf {
  * @param read_pending		A flag indicating that the Host has requested a data transfer.
  * @param write_in_progress	A flag indicating that write operation has been scheduled.
  * @param write_fragmented	A flag indicating that IN transfer has been fragmented.
+ * @param xfer			Queued transfers, the first one in progress.
+ * @param xfer_count		Number of queued transfers.
  */
 struct nrf_usbd_ep_ctx {
 	struct nrf_usbd_ep_cfg cfg;
@@ -134,6 +154,8 @@ struct nrf_usbd_ep_ctx {
 	volatile bool read_pending;
 	volatile bool write_in_progress;
 	bool write_fragmented;
+	struct nrf_usbd_xfer xfer[MAX_EP_XFERS];
+	u8_t xfer_count;
 };
 
 /**
@@ -642,6 +664,7 @@ static void ep_ctx_reset(struct nrf_usbd_ep_ctx *ep_ctx)
 	ep_ctx->read_complete = true;
 	ep_ctx->read_pending = false;
 	ep_ctx->write_in_progress = false;
+	ep_ctx->xfer_count = 0U;
 }
 
 /**
@@ -1030,11 +1053,91 @@ static void usbd_event_transfer_ctrl(nrfx_usbd_evt_t const *const p_event)
 	}
 }
 
+static nrfx_err_t usbd_xfer_start(struct nrf_usbd_ep_ctx *ep_ctx)
+{
+	struct nrf_usbd_xfer *xfer = &ep_ctx->xfer[0];
+	nrfx_usbd_ep_t ep = ep_addr_to_nrfx(ep_ctx->cfg.addr);
+
+	if (NRF_USBD_EPIN_CHECK(ep_ctx->cfg.addr)) {
+		NRFX_USBD_TRANSFER_IN(transfer, xfer->data, xfer->len,
+				      (xfer->flags & USB_DC_XFER_ZLP) ?
+				      NRFX_USBD_TRANSFER_ZLP_FLAG : 0);
+		return nrfx_usbd_ep_transfer(ep, &transfer);
+	}
+
+	NRFX_USBD_TRANSFER_OUT(transfer, xfer->data, xfer->len);
+	return nrfx_usbd_ep_transfer(ep, &transfer);
+}
+
+/* Hands the endpoint back to the packet API once no transfer is queued */
+static void usbd_xfer_idle(struct nrf_usbd_ep_ctx *ep_ctx)
+{
+	if (NRF_USBD_EPIN_CHECK(ep_ctx->cfg.addr)) {
+		ep_ctx->write_in_progress = false;
+	} else {
+		ep_ctx->buf.len = 0U;
+		ep_ctx->buf.curr = ep_ctx->buf.data;
+		ep_ctx->read_complete = true;
+	}
+}
+
+/*
+ * Called in the USBD interrupt when the transfer in progress ends. The
+ * next one is started before the callback of this one, so that the
+ * endpoint keeps moving data.
+ */
+static void usbd_xfer_done(struct nrf_usbd_ep_ctx *ep_ctx,
+			   nrfx_usbd_ep_status_t status)
+{
+	struct nrf_usbd_xfer done;
+	size_t len = 0;
+	int err;
+
+	if (status == NRFX_USBD_EP_WAITING) {
+		/* the transfer already waits for the data */
+		return;
+	}
+
+	(void)nrfx_usbd_ep_status_get(ep_addr_to_nrfx(ep_ctx->cfg.addr),
+				      &len);
+
+	do {
+		if (status == NRFX_USBD_EP_OK) {
+			err = 0;
+		} else if (status == NRFX_USBD_EP_ABORTED) {
+			err = -ECANCELED;
+		} else {
+			LOG_ERR("transfer error %d, ep 0x%02x", status,
+				ep_ctx->cfg.addr);
+			err = -EIO;
+		}
+
+		done = ep_ctx->xfer[0];
+		ep_ctx->xfer[0] = ep_ctx->xfer[1];
+		ep_ctx->xfer_count--;
+
+		if (!ep_ctx->xfer_count) {
+			usbd_xfer_idle(ep_ctx);
+		} else if (usbd_xfer_start(ep_ctx) != NRFX_SUCCESS) {
+			/* fail the next one as well */
+			status = NRFX_USBD_EP_BUSY;
+		}
+
+		done.cb(ep_ctx->cfg.addr, err, len, done.priv);
+		len = 0;
+	} while (status == NRFX_USBD_EP_BUSY && ep_ctx->xfer_count);
+}
+
 static void usbd_event_transfer_data(nrfx_usbd_evt_t const *const p_event)
 {
 	struct nrf_usbd_ep_ctx *ep_ctx =
 		endpoint_ctx(p_event->data.eptransfer.ep);
 
+	if (ep_ctx->xfer_count) {
+		usbd_xfer_done(ep_ctx, p_event->data.eptransfer.status);
+		return;
+	}
+
 	if (NRF_USBD_EPIN_CHECK(p_event->data.eptransfer.ep)) {
 		switch (p_event->data.eptransfer.status) {
 		case NRFX_USBD_EP_OK: {
@@ -1849,6 +1952,114 @@ int usb_dc_ep_mps(const u8_t ep)
 	return ep_ctx->cfg.max_sz;
 }
 
+int usb_dc_ep_xfer(u8_t ep, u8_t *data, u32_t len, unsigned int flags,
+		   usb_dc_ep_xfer_callback cb, void *priv)
+{
+	struct nrf_usbd_ep_ctx *ep_ctx;
+	struct nrf_usbd_xfer *xfer;
+	unsigned int key;
+	int ret = 0;
+
+	if (!dev_attached() || !dev_ready()) {
+		return -ENODEV;
+	}
+
+	ep_ctx = endpoint_ctx(ep);
+	if (!ep_ctx || !cb) {
+		return -EINVAL;
+	}
+
+	if ((ep_ctx->cfg.type != USB_DC_EP_BULK) &&
+	    (ep_ctx->cfg.type != USB_DC_EP_INTERRUPT)) {
+		return -ENOTSUP;
+	}
+
+	/* a packet larger than the room left would overflow the buffer */
+	if (NRF_USBD_EPOUT_CHECK(ep) && (!len || (len % ep_ctx->cfg.max_sz))) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+
+	if (ep_ctx->xfer_count == MAX_EP_XFERS) {
+		ret = -EBUSY;
+		goto done;
+	}
+
+	/* the packet API must be done with the endpoint */
+	if (!ep_ctx->xfer_count &&
+	    (NRF_USBD_EPIN_CHECK(ep) ? ep_ctx->write_in_progress :
+	     !ep_ctx->read_complete || ep_ctx->buf.len)) {
+		ret = -EAGAIN;
+		goto done;
+	}
+
+	xfer = &ep_ctx->xfer[ep_ctx->xfer_count++];
+	xfer->data = data;
+	xfer->len = len;
+	xfer->flags = flags;
+	xfer->cb = cb;
+	xfer->priv = priv;
+
+	if (ep_ctx->xfer_count > 1) {
+		/* started when the one in progress completes */
+		goto done;
+	}
+
+	if (NRF_USBD_EPIN_CHECK(ep)) {
+		ep_ctx->write_in_progress = true;
+	} else {
+		ep_ctx->read_complete = false;
+		ep_ctx->read_pending = false;
+	}
+
+	if (usbd_xfer_start(ep_ctx) != NRFX_SUCCESS) {
+		ep_ctx->xfer_count = 0U;
+		usbd_xfer_idle(ep_ctx);
+		ret = -EIO;
+	}
+
+done:
+	irq_unlock(key);
+	return ret;
+}
+
+int usb_dc_ep_xfer_cancel(u8_t ep)
+{
+	struct nrf_usbd_xfer xfer[MAX_EP_XFERS];
+	struct nrf_usbd_ep_ctx *ep_ctx;
+	unsigned int key;
+	u8_t count;
+
+	if (!dev_attached()) {
+		return -ENODEV;
+	}
+
+	ep_ctx = endpoint_ctx(ep);
+	if (!ep_ctx) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	count = ep_ctx->xfer_count;
+	memcpy(xfer, ep_ctx->xfer, sizeof(xfer));
+	ep_ctx->xfer_count = 0U;
+
+	if (count) {
+		nrfx_usbd_ep_abort(ep_addr_to_nrfx(ep));
+		usbd_xfer_idle(ep_ctx);
+	}
+
+	irq_unlock(key);
+
+	for (u8_t i = 0; i < count; i++) {
+		xfer[i].cb(ep, -ECANCELED, 0, xfer[i].priv);
+	}
+
+	return 0;
+}
+
 int usb_dc_wakeup_request(void)
 {
 	bool res = nrfx_usbd_wakeup_req();
@@ -135,6 +135,18 @@ LOG_MODULE_REGISTER(usb_dc_stm32);
 #define EP_IS_IN(ep) (((ep) & USB_EP_DIR_MASK) == USB_EP_DIR_IN)
 #define EP_IS_OUT(ep) (((ep) & USB_EP_DIR_MASK) == USB_EP_DIR_OUT)
 
+/* Transfers queued per endpoint, the first one in progress */
+#define MAX_EP_XFERS 2
+
+/* Multi-packet transfer, split into packets by the HAL */
+struct usb_dc_stm32_xfer {
+	u8_t *data;	/** Transfer buffer */
+	u32_t len;	/** Length of the buffer */
+	unsigned int flags;	/** Transfer flags (USB_DC_XFER_ZLP) */
+	usb_dc_ep_xfer_callback cb;	/** Completion callback */
+	void *priv;	/** Data passed to the callback */
+};
+
 /* Endpoint state */
 struct usb_dc_stm32_ep_state {
 	u16_t ep_mps;	/** Endpoint max packet size */
@@ -144,6 +156,9 @@ struct usb_dc_stm32_ep_state {
 	u32_t read_count;	/** Number of bytes in read buffer  */
 	u32_t read_offset;	/** Current offset in read buffer */
 	struct k_sem write_sem;	/** Write boolean semaphore */
+	struct usb_dc_stm32_xfer xfer[MAX_EP_XFERS];	/** Queued transfers */
+	u8_t xfer_count;	/** Number of queued transfers */
+	bool xfer_zlp;	/** Sending the zero-length packet of a transfer */
 };
 
 /* Driver state */
@@ -881,6 +896,175 @@ int usb_dc_ep_mps(const u8_t ep)
 	return ep_state->ep_mps;
 }
 
+static HAL_StatusTypeDef usb_dc_stm32_xfer_start(u8_t ep,
+				struct usb_dc_stm32_ep_state *ep_state)
+{
+	struct usb_dc_stm32_xfer *xfer = &ep_state->xfer[0];
+
+	ep_state->xfer_zlp = false;
+
+	if (EP_IS_IN(ep)) {
+		return HAL_PCD_EP_Transmit(&usb_dc_stm32_state.pcd, ep,
+					   xfer->data, xfer->len);
+	}
+
+	return HAL_PCD_EP_Receive(&usb_dc_stm32_state.pcd, ep, xfer->data,
+				  xfer->len);
+}
+
+/* Hands the endpoint back to the packet API once no transfer is queued */
+static void usb_dc_stm32_xfer_idle(u8_t ep,
+				   struct usb_dc_stm32_ep_state *ep_state)
+{
+	if (EP_IS_IN(ep)) {
+		k_sem_give(&ep_state->write_sem);
+	} else {
+		usb_dc_ep_start_read(ep, usb_dc_stm32_state.ep_buf[EP_IDX(ep)],
+				     EP_MPS);
+	}
+}
+
+/*
+ * Called from the HAL callbacks when the transfer in progress ends. The
+ * next one is started before the callback of this one, so that the
+ * endpoint keeps moving data.
+ */
+static void usb_dc_stm32_xfer_done(u8_t ep,
+				   struct usb_dc_stm32_ep_state *ep_state)
+{
+	struct usb_dc_stm32_xfer done = ep_state->xfer[0];
+	struct usb_dc_stm32_xfer next;
+	u32_t len;
+
+	if (EP_IS_IN(ep)) {
+		if ((done.flags & USB_DC_XFER_ZLP) && !ep_state->xfer_zlp) {
+			ep_state->xfer_zlp = true;
+			HAL_PCD_EP_Transmit(&usb_dc_stm32_state.pcd, ep,
+					    NULL, 0);
+			return;
+		}
+
+		len = done.len;
+	} else {
+		len = HAL_PCD_EP_GetRxCount(&usb_dc_stm32_state.pcd, ep);
+	}
+
+	ep_state->xfer[0] = ep_state->xfer[1];
+	ep_state->xfer_count--;
+
+	if (!ep_state->xfer_count) {
+		usb_dc_stm32_xfer_idle(ep, ep_state);
+	} else if (usb_dc_stm32_xfer_start(ep, ep_state) != HAL_OK) {
+		next = ep_state->xfer[0];
+		ep_state->xfer_count = 0U;
+		usb_dc_stm32_xfer_idle(ep, ep_state);
+		done.cb(ep, 0, len, done.priv);
+		next.cb(ep, -EIO, 0, next.priv);
+		return;
+	}
+
+	done.cb(ep, 0, len, done.priv);
+}
+
+int usb_dc_ep_xfer(u8_t ep, u8_t *data, u32_t len, unsigned int flags,
+		   usb_dc_ep_xfer_callback cb, void *priv)
+{
+	struct usb_dc_stm32_ep_state *ep_state = usb_dc_stm32_get_ep_state(ep);
+	struct usb_dc_stm32_xfer *xfer;
+	unsigned int key;
+	int ret = 0;
+
+	LOG_DBG("ep 0x%02x, len %u", ep, len);
+
+	if (!ep_state || !EP_IDX(ep) || !cb) {
+		return -EINVAL;
+	}
+
+	if ((ep_state->ep_type != EP_TYPE_BULK) &&
+	    (ep_state->ep_type != EP_TYPE_INTR)) {
+		return -ENOTSUP;
+	}
+
+	/* the HAL copies whole packets, they must fit in the buffer */
+	if (EP_IS_OUT(ep) && (!len || (len % ep_state->ep_mps))) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+
+	if (ep_state->xfer_count == MAX_EP_XFERS) {
+		ret = -EBUSY;
+		goto done;
+	}
+
+	/* the packet API must be done with the endpoint */
+	if (!ep_state->xfer_count) {
+		if (EP_IS_IN(ep) &&
+		    k_sem_take(&ep_state->write_sem, K_NO_WAIT) != 0) {
+			ret = -EAGAIN;
+			goto done;
+		}
+
+		if (EP_IS_OUT(ep) && ep_state->read_count) {
+			ret = -EAGAIN;
+			goto done;
+		}
+	}
+
+	xfer = &ep_state->xfer[ep_state->xfer_count++];
+	xfer->data = data;
+	xfer->len = len;
+	xfer->flags = flags;
+	xfer->cb = cb;
+	xfer->priv = priv;
+
+	/* a second one is started when the one in progress completes */
+	if (ep_state->xfer_count == 1 &&
+	    usb_dc_stm32_xfer_start(ep, ep_state) != HAL_OK) {
+		ep_state->xfer_count = 0U;
+		usb_dc_stm32_xfer_idle(ep, ep_state);
+		ret = -EIO;
+	}
+
+done:
+	irq_unlock(key);
+	return ret;
+}
+
+int usb_dc_ep_xfer_cancel(u8_t ep)
+{
+	struct usb_dc_stm32_ep_state *ep_state = usb_dc_stm32_get_ep_state(ep);
+	struct usb_dc_stm32_xfer xfer[MAX_EP_XFERS];
+	unsigned int key;
+	u8_t count;
+
+	if (!ep_state) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	count = ep_state->xfer_count;
+	memcpy(xfer, ep_state->xfer, sizeof(xfer));
+	ep_state->xfer_count = 0U;
+
+	if (count) {
+		/* reopening the endpoint drops the HAL transfer state */
+		HAL_PCD_EP_Close(&usb_dc_stm32_state.pcd, ep);
+		HAL_PCD_EP_Open(&usb_dc_stm32_state.pcd, ep, ep_state->ep_mps,
+				ep_state->ep_type);
+		usb_dc_stm32_xfer_idle(ep, ep_state);
+	}
+
+	irq_unlock(key);
+
+	for (u8_t i = 0; i < count; i++) {
+		xfer[i].cb(ep, -ECANCELED, 0, xfer[i].priv);
+	}
+
+	return 0;
+}
+
 int usb_dc_detach(void)
 {
 	LOG_ERR("Not implemented");
@@ -990,6 +1174,11 @@ void HAL_PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, u8_t epnum)
 	LOG_DBG("epnum 0x%02x, rx_count %u", epnum,
 		HAL_PCD_EP_GetRxCount(&usb_dc_stm32_state.pcd, epnum));
 
+	if (ep_state->xfer_count) {
+		usb_dc_stm32_xfer_done(ep, ep_state);
+		return;
+	}
+
 	/* Transaction complete, data is now stored in the buffer and ready
 	 * for the upper stack (usb_dc_ep_read to retrieve).
 	 */
@@ -1009,6 +1198,11 @@ void HAL_PCD_DataInStageCallback(PCD_HandleTypeDef *hpcd, u8_t epnum)
 
 	LOG_DBG("epnum 0x%02x", epnum);
 
+	if (ep_state->xfer_count) {
+		usb_dc_stm32_xfer_done(ep, ep_state);
+		return;
+	}
+
 	k_sem_give(&ep_state->write_sem);
 
 	if (ep_state->cb) {
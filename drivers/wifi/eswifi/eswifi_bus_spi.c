@@ -46,10 +46,11 @@ static int eswifi_spi_wait_cmddata_ready(struct eswifi_spi_data *spi)
 {
 	unsigned int max_retries = 60 * 1000; /* 1 minute */
 
-	do {
+	/* The module is often ready already, do not sleep then */
+	while (!eswifi_spi_cmddata_ready(spi) && --max_retries) {
 		/* allow other threads to be scheduled */
 		k_sleep(1);
-	} while (!eswifi_spi_cmddata_ready(spi) && --max_retries);
+	}
 
 	return max_retries ? 0 : -ETIMEDOUT;
 }
@@ -356,7 +356,7 @@ static void eswifi_off_send_work(struct k_work *work)
 	void *user_data;
 	int err;
 
-	socket = CONTAINER_OF(work, struct eswifi_off_socket, connect_work);
+	socket = CONTAINER_OF(work, struct eswifi_off_socket, send_work);
 	eswifi = eswifi_socket_to_dev(socket);
 
 	eswifi_lock(eswifi);
@@ -375,6 +375,114 @@ static void eswifi_off_send_work(struct k_work *work)
 	}
 }
 
+#if defined(CONFIG_WIFI_ESWIFI_TX_AGGREGATION)
+static int __eswifi_off_flush(struct eswifi_dev *eswifi,
+			      struct eswifi_off_socket *socket)
+{
+	int err, offset;
+
+	if (!socket->tx_len) {
+		return 0;
+	}
+
+	__select_socket(eswifi, socket->index);
+
+	/* header */
+	snprintf(eswifi->buf, sizeof(eswifi->buf), "S3=%u\r", socket->tx_len);
+	offset = strlen(eswifi->buf);
+
+	/* copy payload */
+	memcpy(&eswifi->buf[offset], socket->tx_buf, socket->tx_len);
+	offset += socket->tx_len;
+	socket->tx_len = 0U;
+
+	err = eswifi_request(eswifi, eswifi->buf, offset + 1,
+			     eswifi->buf, sizeof(eswifi->buf));
+	if (err < 0) {
+		LOG_ERR("Unable to send data");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void eswifi_off_flush_work(struct k_work *work)
+{
+	struct eswifi_off_socket *socket;
+	struct eswifi_dev *eswifi;
+	int err;
+
+	socket = CONTAINER_OF(work, struct eswifi_off_socket, flush_work);
+	eswifi = eswifi_socket_to_dev(socket);
+
+	eswifi_lock(eswifi);
+
+	if (socket->state == ESWIFI_SOCKET_STATE_CONNECTED) {
+		err = __eswifi_off_flush(eswifi, socket);
+		if (err) {
+			socket->tx_err = err;
+		}
+	}
+
+	eswifi_unlock(eswifi);
+}
+
+/*
+ * Appends the packet to the write buffer of the socket, sending the buffer
+ * once full. Packets larger than the buffer are sent on their own, after
+ * the data buffered before them.
+ */
+static int __eswifi_off_aggregate(struct eswifi_dev *eswifi,
+				  struct eswifi_off_socket *socket,
+				  struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	int err;
+
+	/* Reported to the next write, the previous ones have completed */
+	if (socket->tx_err) {
+		err = socket->tx_err;
+		socket->tx_err = 0;
+		return err;
+	}
+
+	if (socket->tx_len + len > sizeof(socket->tx_buf)) {
+		err = __eswifi_off_flush(eswifi, socket);
+		if (err) {
+			return err;
+		}
+	}
+
+	if (len > sizeof(socket->tx_buf)) {
+		socket->tx_pkt = pkt;
+		err = __eswifi_off_send_pkt(eswifi, socket);
+		socket->tx_pkt = NULL;
+		return err;
+	}
+
+	if (net_pkt_read(pkt, &socket->tx_buf[socket->tx_len], len)) {
+		return -ENOBUFS;
+	}
+
+	socket->tx_len += len;
+	net_pkt_unref(pkt);
+
+	if (socket->tx_len == sizeof(socket->tx_buf)) {
+		k_delayed_work_cancel(&socket->flush_work);
+		return __eswifi_off_flush(eswifi, socket);
+	}
+
+	/* The first buffered write bounds the delay of the others */
+	if (!k_delayed_work_remaining_get(&socket->flush_work)) {
+		k_delayed_work_submit_to_queue(&eswifi->work_q,
+				&socket->flush_work,
+				K_MSEC(CONFIG_WIFI_ESWIFI_TX_AGGREGATION_MS));
+	}
+
+	return 0;
+}
+#endif /* CONFIG_WIFI_ESWIFI_TX_AGGREGATION */
+
 static int eswifi_off_send(struct net_pkt *pkt,
 			   net_context_send_cb_t cb,
 			   s32_t timeout,
@@ -393,6 +501,17 @@ static int eswifi_off_send(struct net_pkt *pkt,
 		return -ENOTCONN;
 	}
 
+#if defined(CONFIG_WIFI_ESWIFI_TX_AGGREGATION)
+	err = __eswifi_off_aggregate(eswifi, socket, pkt);
+
+	eswifi_unlock(eswifi);
+
+	if (cb) {
+		cb(socket->context, err, user_data);
+	}
+
+	return err;
+#else
 	if (socket->tx_pkt) {
 		eswifi_unlock(eswifi);
 		return -EBUSY;
@@ -420,6 +539,7 @@ static int eswifi_off_send(struct net_pkt *pkt,
 	}
 
 	return err;
+#endif /* CONFIG_WIFI_ESWIFI_TX_AGGREGATION */
 }
 
 static int eswifi_off_sendto(struct net_pkt *pkt,
@@ -484,6 +604,16 @@ static int eswifi_off_put(struct net_context *context)
 
 	k_delayed_work_cancel(&socket->read_work);
 
+#if defined(CONFIG_WIFI_ESWIFI_TX_AGGREGATION)
+	k_delayed_work_cancel(&socket->flush_work);
+
+	if (__eswifi_off_flush(eswifi, socket)) {
+		LOG_ERR("Unable to send buffered data");
+	}
+
+	socket->tx_err = 0;
+#endif
+
 	socket->context = NULL;
 	socket->state = ESWIFI_SOCKET_STATE_NONE;
 
@@ -545,6 +675,11 @@ static int eswifi_off_get(sa_family_t family,
 	k_work_init(&socket->send_work, eswifi_off_send_work);
 	k_delayed_work_init(&socket->read_work, eswifi_off_read_work);
 	k_sem_init(&socket->read_sem, 1, 1);
+#if defined(CONFIG_WIFI_ESWIFI_TX_AGGREGATION)
+	k_delayed_work_init(&socket->flush_work, eswifi_off_flush_work);
+	socket->tx_len = 0U;
+	socket->tx_err = 0;
+#endif
 
 	err = __select_socket(eswifi, socket->index);
 	if (err < 0) {
@@ -41,6 +41,12 @@ struct eswifi_off_socket {
 	struct k_delayed_work read_work;
 	struct sockaddr peer_addr;
 	struct k_sem read_sem;
+#if defined(CONFIG_WIFI_ESWIFI_TX_AGGREGATION)
+	struct k_delayed_work flush_work;
+	char tx_buf[CONFIG_WIFI_ESWIFI_TX_AGGREGATION_SIZE];
+	u16_t tx_len;
+	int tx_err;
+#endif
 };
 
 #endif
@@ -17,7 +17,11 @@
 #define MBEDTLS_MEMORY_BUFFER_ALLOC_C
 #define MBEDTLS_PLATFORM_EXIT_ALT
 #define MBEDTLS_NO_PLATFORM_ENTROPY
+
+/* The entropy driver is the only default source */
+#if !defined(CONFIG_MBEDTLS_ENTROPY_HARDWARE)
 #define MBEDTLS_NO_DEFAULT_ENTROPY_SOURCES
+#endif
 
 #if defined(CONFIG_MBEDTLS_HAVE_ASM)
 #define MBEDTLS_HAVE_ASM
@@ -126,6 +130,10 @@
 #define MBEDTLS_AES_ROM_TABLES
 #endif
 
+#if defined(CONFIG_MBEDTLS_AES_CRYPTO_DEVICE)
+#define MBEDTLS_AES_ENCRYPT_HOOK
+#endif
+
 #if defined(CONFIG_MBEDTLS_CIPHER_CAMELLIA_ENABLED)
 #define MBEDTLS_CAMELLIA_C
 #endif
@@ -282,10 +290,22 @@
 #define MBEDTLS_ENTROPY_C
 #endif
 
+#if defined(CONFIG_MBEDTLS_ENTROPY_HARDWARE)
+#define MBEDTLS_ENTROPY_HARDWARE_ALT
+#endif
+
 #if defined(CONFIG_MBEDTLS_SSL_EXPORT_KEYS)
 #define MBEDTLS_SSL_EXPORT_KEYS
 #endif
 
+#if defined(CONFIG_MBEDTLS_SSL_CACHE)
+#define MBEDTLS_SSL_CACHE_C
+#endif
+
+#if defined(CONFIG_MBEDTLS_SSL_SESSION_TICKETS)
+#define MBEDTLS_SSL_SESSION_TICKETS
+#endif
+
 /* Automatic dependencies */
 
 #if defined(MBEDTLS_SSL_PROTO_TLS1) || \
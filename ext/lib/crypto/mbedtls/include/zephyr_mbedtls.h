@@ -0,0 +1,51 @@
+/** @file
+ * @brief mbed TLS hardware acceleration
+ *
+ * Paths of mbed TLS run by Zephyr drivers rather than in software, as
+ * enabled by Kconfig. Those which can be switched off at runtime, to
+ * compare the hardware and software performance on a board, are switched
+ * on at boot.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_MBEDTLS_H
+#define ZEPHYR_MBEDTLS_H
+
+#include <zephyr/types.h>
+#include <misc/util.h>
+
+/** AES-128 block encryption, by CONFIG_MBEDTLS_AES_CRYPTO_DEVICE_NAME */
+#define ZEPHYR_MBEDTLS_ACCEL_AES BIT(0)
+/** Entropy source, by the entropy driver CONFIG_ENTROPY_NAME */
+#define ZEPHYR_MBEDTLS_ACCEL_ENTROPY BIT(1)
+
+/**
+ * @brief Get the accelerated paths
+ *
+ * @return Mask of ZEPHYR_MBEDTLS_ACCEL_* of the paths enabled and switched
+ *	   on.
+ */
+u32_t zephyr_mbedtls_accel_get(void);
+
+/**
+ * @brief Switch accelerated paths on or off
+ *
+ * The paths not enabled in Kconfig, and the entropy source, registered
+ * when an entropy context is initialized, are left as they are.
+ *
+ * @param mask Mask of ZEPHYR_MBEDTLS_ACCEL_* of the paths to switch on,
+ *	       the others being switched off.
+ */
+void zephyr_mbedtls_accel_set(u32_t mask);
+
+/**
+ * @brief Print the accelerated and software paths
+ */
+void zephyr_mbedtls_accel_report(void);
+
+#endif /* ZEPHYR_MBEDTLS_H */
@@ -865,6 +865,13 @@ int mbedtls_aes_xts_setkey_dec( mbedtls_aes_xts_context *ctx,
  * AES-ECB block encryption
  */
 #if !defined(MBEDTLS_AES_ENCRYPT_ALT)
+#if defined(MBEDTLS_AES_ENCRYPT_HOOK)
+/* Encrypts the block in hardware, returning non-zero when it cannot */
+int mbedtls_aes_encrypt_hook( mbedtls_aes_context *ctx,
+                              const unsigned char input[16],
+                              unsigned char output[16] );
+#endif
+
 int mbedtls_internal_aes_encrypt( mbedtls_aes_context *ctx,
                                   const unsigned char input[16],
                                   unsigned char output[16] )
@@ -872,6 +879,11 @@ int mbedtls_internal_aes_encrypt( mbedtls_aes_context *ctx,
     int i;
     uint32_t *RK, X0, X1, X2, X3, Y0, Y1, Y2, Y3;
 
+#if defined(MBEDTLS_AES_ENCRYPT_HOOK)
+    if( mbedtls_aes_encrypt_hook( ctx, input, output ) == 0 )
+        return( 0 );
+#endif
+
     RK = ctx->rk;
 
     GET_UINT32_LE( X0, input,  0 ); X0 ^= *RK++;
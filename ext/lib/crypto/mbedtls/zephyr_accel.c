@@ -0,0 +1,103 @@
+/** @file
+ * @brief mbed TLS hardware acceleration
+ *
+ * Entropy source of the entropy driver, and the switches and report of
+ * the accelerated paths.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <device.h>
+#include <entropy.h>
+#include <misc/printk.h>
+
+#if !defined(CONFIG_MBEDTLS_CFG_FILE)
+#include "mbedtls/config.h"
+#else
+#include CONFIG_MBEDTLS_CFG_FILE
+#endif /* CONFIG_MBEDTLS_CFG_FILE */
+
+#include <mbedtls/entropy.h>
+#include <mbedtls/entropy_poll.h>
+#include <zephyr_mbedtls.h>
+
+/* Paths which can be switched at runtime */
+#define ACCEL_SWITCHED (IS_ENABLED(CONFIG_MBEDTLS_AES_CRYPTO_DEVICE) ? \
+			ZEPHYR_MBEDTLS_ACCEL_AES : 0)
+
+#define ACCEL_FIXED (IS_ENABLED(CONFIG_MBEDTLS_ENTROPY_HARDWARE) ? \
+		     ZEPHYR_MBEDTLS_ACCEL_ENTROPY : 0)
+
+static u32_t accel_on = ACCEL_SWITCHED;
+
+u32_t zephyr_mbedtls_accel_get(void)
+{
+	return accel_on | ACCEL_FIXED;
+}
+
+void zephyr_mbedtls_accel_set(u32_t mask)
+{
+	accel_on = mask & ACCEL_SWITCHED;
+}
+
+static void report(const char *path, u32_t accel, const char *dev)
+{
+	if (zephyr_mbedtls_accel_get() & accel) {
+		printk("mbedTLS %-8s: hardware (%s)\n", path, dev);
+	} else {
+		printk("mbedTLS %-8s: software\n", path);
+	}
+}
+
+void zephyr_mbedtls_accel_report(void)
+{
+#if defined(CONFIG_MBEDTLS_AES_CRYPTO_DEVICE)
+	report("AES-128", ZEPHYR_MBEDTLS_ACCEL_AES,
+	       CONFIG_MBEDTLS_AES_CRYPTO_DEVICE_NAME);
+#else
+	report("AES-128", 0, NULL);
+#endif
+
+#if defined(CONFIG_MBEDTLS_ENTROPY_HARDWARE)
+	report("entropy", ZEPHYR_MBEDTLS_ACCEL_ENTROPY, CONFIG_ENTROPY_NAME);
+#else
+	report("entropy", 0, NULL);
+#endif
+
+	/* No SHA, ECC or RSA accelerator driver to run them yet */
+	report("SHA-256", 0, NULL);
+	report("ECP", 0, NULL);
+	report("RSA", 0, NULL);
+}
+
+#if defined(MBEDTLS_ENTROPY_HARDWARE_ALT)
+int mbedtls_hardware_poll(void *data, unsigned char *output, size_t len,
+			  size_t *olen)
+{
+	static struct device *dev;
+
+	ARG_UNUSED(data);
+
+	if (dev == NULL) {
+		dev = device_get_binding(CONFIG_ENTROPY_NAME);
+		if (dev == NULL) {
+			return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+		}
+	}
+
+	len = MIN(len, UINT16_MAX);
+
+	if (entropy_get_entropy(dev, output, len) != 0) {
+		return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+	}
+
+	*olen = len;
+
+	return 0;
+}
+#endif /* MBEDTLS_ENTROPY_HARDWARE_ALT */
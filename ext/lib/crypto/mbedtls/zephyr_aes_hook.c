@@ -0,0 +1,84 @@
+/** @file
+ * @brief mbed TLS AES block encryption with a crypto device
+ *
+ * The AES-128 blocks are encrypted with an ECB session of the crypto
+ * device, the other key sizes and the blocks encrypted from an ISR, where
+ * the device cannot be waited for, are left to software.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <device.h>
+#include <misc/byteorder.h>
+#include <crypto/cipher.h>
+
+#if !defined(CONFIG_MBEDTLS_CFG_FILE)
+#include "mbedtls/config.h"
+#else
+#include CONFIG_MBEDTLS_CFG_FILE
+#endif /* CONFIG_MBEDTLS_CFG_FILE */
+
+#include <mbedtls/aes.h>
+#include <zephyr_mbedtls.h>
+
+#define AES_128_ROUNDS 10
+
+int mbedtls_aes_encrypt_hook(mbedtls_aes_context *ctx,
+			     const unsigned char input[16],
+			     unsigned char output[16])
+{
+	static struct device *dev;
+	struct cipher_ctx cctx;
+	struct cipher_pkt pkt;
+	u8_t key[16];
+	int i, err;
+
+	if (ctx->nr != AES_128_ROUNDS || k_is_in_isr() ||
+	    !(zephyr_mbedtls_accel_get() & ZEPHYR_MBEDTLS_ACCEL_AES)) {
+		return -ENOTSUP;
+	}
+
+	if (dev == NULL) {
+		dev = device_get_binding(CONFIG_MBEDTLS_AES_CRYPTO_DEVICE_NAME);
+		if (dev == NULL) {
+			return -ENODEV;
+		}
+	}
+
+	/* The first round key is the key, loaded as little endian words */
+	for (i = 0; i < 4; i++) {
+		sys_put_le32(ctx->rk[i], &key[i * 4]);
+	}
+
+	cctx = (struct cipher_ctx) {
+		.keylen = sizeof(key),
+		.key.bit_stream = key,
+		.flags = CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS,
+	};
+
+	err = cipher_begin_session(dev, &cctx, CRYPTO_CIPHER_ALGO_AES,
+				   CRYPTO_CIPHER_MODE_ECB,
+				   CRYPTO_CIPHER_OP_ENCRYPT);
+	if (err) {
+		/* All sessions in use, or not supported by the device */
+		return err;
+	}
+
+	pkt = (struct cipher_pkt) {
+		.in_buf = (u8_t *)input,
+		.in_len = 16,
+		.out_buf = output,
+		.out_buf_max = 16,
+	};
+
+	err = cipher_block_op(&cctx, &pkt);
+
+	cipher_free_session(dev, &cctx);
+
+	return err;
+}
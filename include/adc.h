@@ -14,6 +14,7 @@
 #define ZEPHYR_INCLUDE_ADC_H_
 
 #include <device.h>
+#include <errno.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -291,6 +292,63 @@ typedef int (*adc_api_read_async)(struct device *dev,
 				  struct k_poll_signal *async);
 #endif
 
+#ifdef CONFIG_ADC_CONTINUOUS
+/**
+ * @brief Type definition of the callback function of continuous sampling.
+ *
+ * Called from the interrupt context each time one half of the buffer is
+ * filled. The samples in this half remain valid until the other half is
+ * filled, as the hardware keeps writing to the buffer meanwhile.
+ *
+ * @param dev        Pointer to the device structure for the driver instance.
+ * @param buffer     Pointer to the half of the buffer just filled.
+ * @param samplings  Number of samplings in that half.
+ * @param user_data  User data given in the continuous configuration.
+ */
+typedef void (*adc_continuous_callback)(struct device *dev, void *buffer,
+					size_t samplings, void *user_data);
+
+/**
+ * @brief Structure defining a continuous sampling.
+ *
+ * The samplings are triggered by a hardware timer and their results are
+ * transferred without CPU involvement into the two halves of the sequence
+ * buffer in turn, so that only one interrupt occurs per half buffer.
+ */
+struct adc_continuous_config {
+	/**
+	 * Channels, resolution, oversampling and buffer of the samplings.
+	 * The options must be NULL. The buffer size is split in two halves,
+	 * each holding the same number of samplings.
+	 */
+	const struct adc_sequence *sequence;
+
+	/** Interval between consecutive samplings (in microseconds). */
+	u32_t interval_us;
+
+	/** Callback function called each time a half buffer is filled. */
+	adc_continuous_callback callback;
+
+	/** User data passed to the callback. */
+	void *user_data;
+};
+
+/**
+ * @brief Type definition of ADC API function for starting a continuous
+ *        sampling.
+ * See adc_continuous_start() for argument descriptions.
+ */
+typedef int (*adc_api_continuous_start)(struct device *dev,
+				const struct adc_continuous_config *config);
+
+/**
+ * @brief Type definition of ADC API function for stopping a continuous
+ *        sampling.
+ * See adc_continuous_stop() for argument descriptions.
+ */
+typedef int (*adc_api_continuous_stop)(struct device *dev);
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 /**
  * @brief ADC driver API
  *
@@ -302,6 +360,10 @@ struct adc_driver_api {
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
 #endif
+#ifdef CONFIG_ADC_CONTINUOUS
+	adc_api_continuous_start continuous_start;
+	adc_api_continuous_stop  continuous_stop;
+#endif
 };
 
 /**
@@ -394,6 +456,60 @@ static inline int z_impl_adc_read_async(struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_CONTINUOUS
+/**
+ * @brief Start a continuous sampling.
+ *
+ * The ADC keeps sampling at the given interval until adc_continuous_stop()
+ * is called, and it cannot be used for other reads meanwhile.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param config  Continuous sampling configuration.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided,
+ *                  e.g. an interval not achievable by the hardware.
+ * @retval -ENOMEM  If the buffer cannot hold one sampling per half.
+ * @retval -ENOTSUP If the driver does not support continuous sampling.
+ */
+static inline int adc_continuous_start(struct device *dev,
+				const struct adc_continuous_config *config)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->driver_api;
+
+	if (api->continuous_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->continuous_start(dev, config);
+}
+
+/**
+ * @brief Stop a continuous sampling.
+ *
+ * No callback is called once this function returns. The half buffer being
+ * filled is discarded.
+ *
+ * @param dev  Pointer to the device structure for the driver instance.
+ *
+ * @retval 0         On success.
+ * @retval -EALREADY If no continuous sampling is running.
+ * @retval -ENOTSUP  If the driver does not support continuous sampling.
+ */
+static inline int adc_continuous_stop(struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->driver_api;
+
+	if (api->continuous_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->continuous_stop(dev);
+}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 #include <syscalls/adc.h>
 
 /**
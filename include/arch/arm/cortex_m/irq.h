@@ -57,6 +57,32 @@ extern void z_irq_priority_set(unsigned int irq, unsigned int prio,
 #define IRQ_ZERO_LATENCY	BIT(0)
 #endif
 
+#ifdef CONFIG_ARM_ISR_TRAMPOLINES
+/**
+ * Dispatch this interrupt through its own trampoline, which calls the ISR
+ * with its parameter without going through the common _isr_wrapper table
+ * lookup.
+ */
+#define IRQ_TRAMPOLINE		BIT(1)
+
+#if defined(CONFIG_ARM_ISR_TRAMPOLINES_ALL)
+#define Z_ARM_ISR_FLAGS(flags_p) ISR_FLAG_TRAMPOLINE
+#elif defined(CONFIG_ZERO_LATENCY_IRQS)
+#define Z_ARM_ISR_FLAGS(flags_p) \
+	((((flags_p) & (IRQ_TRAMPOLINE | IRQ_ZERO_LATENCY)) != 0) ? \
+	 ISR_FLAG_TRAMPOLINE : 0)
+#else
+#define Z_ARM_ISR_FLAGS(flags_p) \
+	((((flags_p) & IRQ_TRAMPOLINE) != 0) ? ISR_FLAG_TRAMPOLINE : 0)
+#endif
+
+/* arch/arm/core/isr_wrapper.S: one 16 byte trampoline per IRQ line */
+extern void _isr_trampolines(void);
+#define Z_ISR_TRAMPOLINE(irq) ((u32_t)&_isr_trampolines + (irq) * 16)
+#else
+#define Z_ARM_ISR_FLAGS(flags_p) 0
+#endif
+
 
 /**
  * Configure a static interrupt.
@@ -81,7 +107,7 @@ extern void z_irq_priority_set(unsigned int irq, unsigned int prio,
  */
 #define Z_ARCH_IRQ_CONNECT(irq_p, priority_p, isr_p, isr_param_p, flags_p) \
 ({ \
-	Z_ISR_DECLARE(irq_p, 0, isr_p, isr_param_p); \
+	Z_ISR_DECLARE(irq_p, Z_ARM_ISR_FLAGS(flags_p), isr_p, isr_param_p); \
 	z_irq_priority_set(irq_p, priority_p, flags_p); \
 	irq_p; \
 })
@@ -153,6 +179,55 @@ extern void z_irq_spurious(void *unused);
 extern void _isr_wrapper(void);
 #endif
 
+#ifdef CONFIG_ARM_IRQ_STATS
+/** Histogram bucket n counts values of 2^n to 2^(n+1) - 1 cycles, the last
+ * bucket all larger values.
+ */
+#define ARM_IRQ_STATS_BUCKETS 16
+
+/**
+ * @brief Statistics of one IRQ line, in DWT cycles
+ *
+ * The entry latency is measured from the entry of _isr_wrapper (or of the
+ * IRQ trampoline) to the call of the ISR, the duration is the time spent
+ * in the ISR, including any higher priority interrupts nested in it.
+ * Histogram counters saturate.
+ */
+struct arm_irq_stats {
+	u32_t count;
+	u32_t latency_max;
+	u32_t duration_max;
+	u64_t duration_total;
+	u16_t latency_hist[ARM_IRQ_STATS_BUCKETS];
+	u16_t duration_hist[ARM_IRQ_STATS_BUCKETS];
+};
+
+/* hooks called from _isr_wrapper */
+extern void z_arm_irq_stats_enter(void);
+extern void z_arm_irq_stats_handler(void);
+extern void z_arm_irq_stats_exit(void);
+
+/**
+ * @brief Get the statistics of an IRQ line
+ *
+ * @param irq IRQ line
+ * @param stats Copy of the statistics
+ *
+ * @return 0 on success, -EINVAL if irq is not a valid IRQ line
+ */
+extern int arm_irq_stats_get(unsigned int irq, struct arm_irq_stats *stats);
+
+/**
+ * @brief Reset the statistics of all IRQ lines
+ */
+extern void arm_irq_stats_reset(void);
+
+/**
+ * @brief Print the statistics of the IRQ lines which fired
+ */
+extern void arm_irq_stats_show(void);
+#endif /* CONFIG_ARM_IRQ_STATS */
+
 #endif /* _ASMLANGUAGE */
 
 #ifdef __cplusplus
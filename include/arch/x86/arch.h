@@ -691,6 +691,17 @@ void z_x86_mmu_set_flags(struct x86_mmu_pdpt *pdpt, void *ptr,
 
 void z_x86_reset_pages(void *start, size_t size);
 
+/**
+ * @brief Switch the user page tables from a memory domain to another
+ *
+ * Only the partitions differing between the two domains are updated.
+ *
+ * @param from Domain of the outgoing thread, or NULL
+ * @param to Domain of the incoming thread, or NULL
+ */
+void z_x86_mem_domain_pages_switch(struct k_mem_domain *from,
+				   struct k_mem_domain *to);
+
 #endif /* CONFIG_X86_MMU */
 
 #endif /* !_ASMLANGUAGE */
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for audio streaming over I2S and DMIC drivers
+ *
+ * Audio blocks come from a memory slab shared with the drivers, so the
+ * blocks received from a DMIC or I2S input can be processed in place and
+ * handed to an I2S output without copies. A reference count per block
+ * lets several consumers share a block.
+ *
+ * Samples are signed 16-bit PCM, channels interleaved.
+ */
+
+#ifndef ZEPHYR_INCLUDE_AUDIO_STREAM_H_
+#define ZEPHYR_INCLUDE_AUDIO_STREAM_H_
+
+#include <kernel.h>
+#include <device.h>
+#include <atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Audio Stream Interface
+ * @defgroup audio_stream_interface Audio Stream Interface
+ * @ingroup audio_interface
+ * @{
+ */
+
+/** Unity gain of audio_gain_s16() */
+#define AUDIO_GAIN_UNITY	0x1000
+
+/**
+ * @brief Pool of reference counted audio blocks
+ *
+ * The slab is the one given to the drivers in i2s_config::mem_slab or
+ * pcm_stream_cfg::mem_slab.
+ */
+struct audio_pool {
+	struct k_mem_slab *slab;
+	atomic_t *refs;
+};
+
+/**
+ * @brief Statically define an audio block pool
+ *
+ * @param name Name of the pool, its slab is name_slab.
+ * @param block_size Size of a block in bytes.
+ * @param num_blocks Number of blocks.
+ */
+#define AUDIO_POOL_DEFINE(name, block_size, num_blocks)			\
+	K_MEM_SLAB_DEFINE(name##_slab, block_size, num_blocks, 4);	\
+	static atomic_t _audio_pool_refs_##name[num_blocks];		\
+	struct audio_pool name = {					\
+		.slab = &name##_slab,					\
+		.refs = _audio_pool_refs_##name,			\
+	}
+
+/**
+ * @brief Allocate a block with a reference count of one
+ *
+ * @param pool Pool of the block.
+ * @param timeout Time to wait for a free block, in ms.
+ *
+ * @return The block, or NULL on timeout.
+ */
+void *audio_block_alloc(struct audio_pool *pool, s32_t timeout);
+
+/**
+ * @brief Take ownership of a block allocated by a driver
+ *
+ * Blocks returned by i2s_read() or dmic_read() are allocated from the slab
+ * directly, this gives them a reference count of one.
+ *
+ * @param pool Pool of the block.
+ * @param block Block received from a driver.
+ */
+void audio_block_adopt(struct audio_pool *pool, void *block);
+
+/**
+ * @brief Add a reference to a block
+ *
+ * @param pool Pool of the block.
+ * @param block Block.
+ */
+void audio_block_ref(struct audio_pool *pool, void *block);
+
+/**
+ * @brief Drop a reference to a block, freeing it with the last one
+ *
+ * @param pool Pool of the block.
+ * @param block Block.
+ */
+void audio_block_unref(struct audio_pool *pool, void *block);
+
+/**
+ * @brief Check if a block has other owners
+ *
+ * @param pool Pool of the block.
+ * @param block Block.
+ *
+ * @return true if the block must not be modified in place.
+ */
+bool audio_block_shared(struct audio_pool *pool, void *block);
+
+/**
+ * @brief Get a block that can be modified in place
+ *
+ * @param pool Pool of the block.
+ * @param block Block, replaced with a private copy if shared.
+ * @param size Bytes of data in the block.
+ * @param timeout Time to wait for a free block, in ms.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if no block could be allocated for the copy.
+ */
+int audio_block_writable(struct audio_pool *pool, void **block, size_t size,
+			 s32_t timeout);
+
+/**
+ * @brief Mix samples into a buffer with saturation
+ *
+ * @param dst Buffer holding the first input and receiving the mix.
+ * @param src Second input.
+ * @param samples Number of samples, of all channels.
+ */
+void audio_mix_s16(s16_t *dst, const s16_t *src, size_t samples);
+
+/**
+ * @brief Scale samples in place with saturation
+ *
+ * @param buf Samples.
+ * @param samples Number of samples, of all channels.
+ * @param gain Gain in 4.12 fixed point, see AUDIO_GAIN_UNITY.
+ */
+void audio_gain_s16(s16_t *buf, size_t samples, u16_t gain);
+
+/** Maximum number of channels of a resampler */
+#define AUDIO_RESAMPLE_CHANNELS_MAX	2
+
+/**
+ * @brief Linear interpolating sample rate converter
+ */
+struct audio_resampler {
+	/** Input frames per output frame in 16.16 fixed point */
+	u32_t step;
+	/** Position of the next output frame after the last input frame */
+	u32_t phase;
+	u8_t channels;
+	/** Last input frame of the previous call */
+	s16_t last[AUDIO_RESAMPLE_CHANNELS_MAX];
+};
+
+/**
+ * @brief Initialize a resampler
+ *
+ * @param rs Resampler.
+ * @param in_rate Input sample rate in Hz.
+ * @param out_rate Output sample rate in Hz.
+ * @param channels Number of interleaved channels.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL on unsupported rates or channels.
+ */
+int audio_resampler_init(struct audio_resampler *rs, u32_t in_rate,
+			 u32_t out_rate, u8_t channels);
+
+/**
+ * @brief Convert the sample rate of a run of frames
+ *
+ * The state carries over between calls, so consecutive blocks of a stream
+ * are converted without discontinuities.
+ *
+ * @param rs Resampler.
+ * @param in Input frames.
+ * @param in_frames Number of input frames.
+ * @param out Output frames.
+ * @param out_frames Capacity of out in frames.
+ *
+ * @return Number of frames written to out.
+ */
+size_t audio_resample_s16(struct audio_resampler *rs, const s16_t *in,
+			  size_t in_frames, s16_t *out, size_t out_frames);
+
+struct audio_node;
+
+/**
+ * @typedef audio_node_process_t
+ * @brief Process a block of a pipeline
+ *
+ * The node either modifies the block in place or replaces it, dropping its
+ * reference to the input.
+ *
+ * @param node Node.
+ * @param block Block, updated if replaced.
+ * @param size Bytes of data in the block, updated if changed.
+ *
+ * @return 0 on success, a negative error code on failure.
+ */
+typedef int (*audio_node_process_t)(struct audio_node *node, void **block,
+				    size_t *size);
+
+/**
+ * @brief Processing stage of an audio pipeline
+ */
+struct audio_node {
+	audio_node_process_t process;
+	/** Pool of the blocks passed through the node */
+	struct audio_pool *pool;
+};
+
+/**
+ * @brief Node scaling the samples
+ */
+struct audio_gain_node {
+	struct audio_node node;
+	/** Gain in 4.12 fixed point */
+	u16_t gain;
+};
+
+/**
+ * @brief Node mixing in the blocks of a second source
+ *
+ * Blocks of the second source are queued with audio_mix_node_feed(), one
+ * of them is mixed into each block passing through. Blocks pass unchanged
+ * when the queue is empty. Chain several nodes to mix more sources.
+ */
+struct audio_mix_node {
+	struct audio_node node;
+	/** Queue of block pointers of the second source */
+	struct k_msgq *queue;
+};
+
+/**
+ * @brief Node converting the sample rate
+ */
+struct audio_resample_node {
+	struct audio_node node;
+	struct audio_resampler rs;
+};
+
+/**
+ * @brief Initialize a gain node
+ *
+ * @param gn Node.
+ * @param pool Pool of the blocks.
+ * @param gain Gain in 4.12 fixed point.
+ */
+void audio_gain_node_init(struct audio_gain_node *gn, struct audio_pool *pool,
+			  u16_t gain);
+
+/**
+ * @brief Initialize a mix node
+ *
+ * @param mn Node.
+ * @param pool Pool of the blocks, of both sources.
+ * @param queue Message queue of void * entries.
+ */
+void audio_mix_node_init(struct audio_mix_node *mn, struct audio_pool *pool,
+			 struct k_msgq *queue);
+
+/**
+ * @brief Queue a block of the second source of a mix node
+ *
+ * The node takes over the reference of the caller.
+ *
+ * @param mn Node.
+ * @param block Block, of the size of the blocks of the first source.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMSG if the queue is full, the block is released.
+ */
+int audio_mix_node_feed(struct audio_mix_node *mn, void *block);
+
+/**
+ * @brief Initialize a sample rate conversion node
+ *
+ * The blocks of the pool must hold the converted data.
+ *
+ * @param rn Node.
+ * @param pool Pool of the blocks.
+ * @param in_rate Input sample rate in Hz.
+ * @param out_rate Output sample rate in Hz.
+ * @param channels Number of interleaved channels.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL on unsupported rates or channels.
+ */
+int audio_resample_node_init(struct audio_resample_node *rn,
+			     struct audio_pool *pool, u32_t in_rate,
+			     u32_t out_rate, u8_t channels);
+
+/**
+ * @brief Pass a block through a chain of nodes
+ *
+ * On failure the reference to the block is dropped.
+ *
+ * @param nodes Nodes, in processing order.
+ * @param num_nodes Number of nodes.
+ * @param block Block, updated to the output block.
+ * @param size Bytes of data in the block, updated to the output size.
+ *
+ * @return 0 on success, the error of the failing node otherwise.
+ */
+int audio_pipeline_process(struct audio_node *const *nodes, size_t num_nodes,
+			   void **block, size_t *size);
+
+/**
+ * @brief Read a decimated block from a DMIC into a pool
+ *
+ * The stream must have been configured with the slab of the pool.
+ *
+ * @param dmic DMIC device.
+ * @param stream Stream identifier.
+ * @param pool Pool of the stream.
+ * @param block Received block, with a reference count of one.
+ * @param size Bytes of data in the block.
+ * @param timeout Time to wait for data, in ms.
+ *
+ * @return 0 on success, a negative error code on failure.
+ */
+int audio_dmic_read(struct device *dmic, u8_t stream, struct audio_pool *pool,
+		    void **block, size_t *size, s32_t timeout);
+
+/**
+ * @brief Read a block from an I2S input into a pool
+ *
+ * The RX direction must have been configured with the slab of the pool.
+ *
+ * @param i2s I2S device.
+ * @param pool Pool of the RX direction.
+ * @param block Received block, with a reference count of one.
+ * @param size Bytes of data in the block.
+ *
+ * @return 0 on success, a negative error code on failure.
+ */
+int audio_i2s_read(struct device *i2s, struct audio_pool *pool, void **block,
+		   size_t *size);
+
+/**
+ * @brief Queue a block to an I2S output
+ *
+ * The TX direction must have been configured with the slab of the pool.
+ * The block is handed to the driver if the caller holds the only
+ * reference, otherwise it is copied first. In both cases the reference of
+ * the caller is consumed.
+ *
+ * @param i2s I2S device.
+ * @param pool Pool of the TX direction.
+ * @param block Block.
+ * @param size Bytes of data in the block.
+ *
+ * @return 0 on success, a negative error code on failure.
+ */
+int audio_i2s_write(struct device *i2s, struct audio_pool *pool, void *block,
+		    size_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_AUDIO_STREAM_H_ */
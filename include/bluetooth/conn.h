@@ -184,6 +184,33 @@ int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 int bt_conn_le_param_update(struct bt_conn *conn,
 			    const struct bt_le_conn_param *param);
 
+/** @brief Update the PHYs of the connection.
+ *
+ *  Only requests the update, which the controller may refuse or complete
+ *  with other PHYs.
+ *
+ *  @param conn Connection object.
+ *  @param tx_phys Preferred transmitter PHYs, BT_HCI_LE_PHY_PREFER_* bits.
+ *  @param rx_phys Preferred receiver PHYs, BT_HCI_LE_PHY_PREFER_* bits.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_conn_le_phy_update(struct bt_conn *conn, u8_t tx_phys, u8_t rx_phys);
+
+/** @brief Update the data length of the connection.
+ *
+ *  Only requests the update, the data length in use is negotiated by the
+ *  controllers.
+ *
+ *  @param conn Connection object.
+ *  @param tx_octets Maximum payload of the transmitted PDUs, 27 to 251.
+ *  @param tx_time Maximum air time of the transmitted PDUs in microseconds.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_conn_le_data_len_update(struct bt_conn *conn, u16_t tx_octets,
+			       u16_t tx_time);
+
 /** @brief Disconnect from a remote device or cancel pending connection.
  *
  *  Disconnect an active connection with the specified reason code or cancel
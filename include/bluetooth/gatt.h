@@ -791,6 +791,61 @@ static inline int bt_gatt_notify(struct bt_conn *conn,
 	return bt_gatt_notify_cb(conn, attr, data, len, NULL, NULL);
 }
 
+/** @brief Notify attribute value change, coalescing with other values.
+ *
+ *  Queue a notification of attribute value change on the given connection.
+ *  If the peer has enabled Multiple Handle Value Notifications in its
+ *  Client Supported Features, queued values are sent together in PDUs of
+ *  up to the ATT MTU, either once a PDU is full, after
+ *  CONFIG_BT_GATT_NOTIFY_MULTIPLE_TIMEOUT or when calling
+ *  @ref bt_gatt_notify_batch_flush. Otherwise the value is sent right
+ *  away as with @ref bt_gatt_notify.
+ *
+ *  @param conn Connection object.
+ *  @param attr Characteristic or Characteristic Value attribute.
+ *  @param data Pointer to Attribute data.
+ *  @param len Attribute value length.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_gatt_notify_batch(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			 const void *data, u16_t len);
+
+/** @brief Send the notifications queued by @ref bt_gatt_notify_batch.
+ *
+ *  @param conn Connection object.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_gatt_notify_batch_flush(struct bt_conn *conn);
+
+/** @brief Notification statistics of a connection. */
+struct bt_gatt_notify_stats {
+	/** Number of notified values */
+	u32_t notifications;
+	/** Number of notification PDUs sent */
+	u32_t pdus;
+	/** Number of notified value bytes */
+	u32_t bytes;
+	/** Time since the connection was established in milliseconds */
+	u32_t duration;
+};
+
+/** @brief Get the notification statistics of a connection.
+ *
+ *  The throughput of a connection is given by bytes over duration, the
+ *  coalescing ratio by notifications over pdus. The statistics of a
+ *  connection are kept after it is disconnected, until the connection
+ *  object is reused.
+ *
+ *  @param conn Connection object.
+ *  @param stats Statistics to fill in.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_gatt_notify_stats_get(struct bt_conn *conn,
+			     struct bt_gatt_notify_stats *stats);
+
 /** @typedef bt_gatt_indicate_func_t
  *  @brief Indication complete result callback.
  *
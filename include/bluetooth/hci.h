@@ -1937,6 +1937,37 @@ typedef bool bt_hci_vnd_evt_cb_t(struct net_buf_simple *buf);
   */
 int bt_hci_register_vnd_evt_cb(bt_hci_vnd_evt_cb_t cb);
 
+/** HCI RX lanes, see CONFIG_BT_RX_LANES */
+enum {
+	/** HCI events */
+	BT_HCI_RX_LANE_EVT,
+	/** ACL data */
+	BT_HCI_RX_LANE_ACL,
+
+	BT_HCI_RX_LANE_NUM,
+};
+
+/** Latency statistics of an HCI RX lane */
+struct bt_hci_rx_lane_stats {
+	/** Number of buffers handled */
+	u32_t count;
+	/** Longest time from reception to handling in microseconds */
+	u32_t max_us;
+	/** Sum of the times from reception to handling in microseconds */
+	u64_t total_us;
+};
+
+/** Get the latency statistics of an HCI RX lane
+  *
+  * Requires CONFIG_BT_RX_LANES_STATS.
+  *
+  * @param lane  BT_HCI_RX_LANE_EVT or BT_HCI_RX_LANE_ACL.
+  * @param stats Statistics to fill in.
+  *
+  * @return 0 on success or negative error value on failure.
+  */
+int bt_hci_rx_lane_stats_get(u8_t lane, struct bt_hci_rx_lane_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
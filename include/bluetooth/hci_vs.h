@@ -129,6 +129,35 @@ struct bt_hci_cp_vs_set_scan_req_reports {
 	u8_t  enable;
 } __packed;
 
+#define BT_HCI_VS_PROF_ROLE_ADV                 0x00
+#define BT_HCI_VS_PROF_ROLE_SCAN                0x01
+#define BT_HCI_VS_PROF_ROLE_CONN                0x02
+#define BT_HCI_VS_PROF_ROLE_COUNT               0x03
+
+#define BT_HCI_VS_PROF_MAYFLY_COUNT             0x04
+
+#define BT_HCI_OP_VS_READ_CTLR_PROF             BT_OP(BT_OGF_VS, 0x000e)
+struct bt_hci_cp_vs_read_ctlr_prof {
+	u8_t  reset;
+} __packed;
+
+struct bt_hci_vs_prof_role {
+	u32_t events;
+	u32_t radio_us;
+	u32_t aborted;
+	u32_t skipped;
+} __packed;
+
+struct bt_hci_rp_vs_read_ctlr_prof {
+	u8_t   status;
+	struct bt_hci_vs_prof_role role[BT_HCI_VS_PROF_ROLE_COUNT];
+	u8_t   mayfly_max[BT_HCI_VS_PROF_MAYFLY_COUNT];
+	u8_t   prep_max;
+	u8_t   tx_ack_max;
+	u8_t   done_free_min;
+	u8_t   rx_free_min;
+} __packed;
+
 /* Events */
 
 struct bt_hci_evt_vs {
@@ -127,6 +127,12 @@ struct bt_l2cap_le_chan {
 	/** Segment SDU packet from upper layer */
 	struct net_buf			*_sdu;
 	u16_t				_sdu_len;
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+	/* Credits already returned for the SDU being received */
+	u16_t				_sdu_credits;
+	/* SDUs the application has not completed yet */
+	atomic_t			_rx_pending;
+#endif
 };
 
 /** @def BT_L2CAP_LE_CHAN(_ch)
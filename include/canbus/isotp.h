@@ -0,0 +1,250 @@
+/**
+ * @file
+ * @brief Public API for ISO-TP (ISO 15765-2)
+ *
+ * ISO-TP is a transport protocol carrying messages of up to 4095 bytes over
+ * CAN frames, used e.g. by diagnostic services (UDS, OBD).
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_CANBUS_ISOTP_H_
+#define ZEPHYR_INCLUDE_CANBUS_ISOTP_H_
+
+/**
+ * @brief CAN ISO-TP Interface
+ * @defgroup can_isotp CAN ISO-TP Interface
+ * @ingroup io_interfaces
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <can.h>
+#include <net/buf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * N_Result values of ISO 15765-2, returned as negative error numbers.
+ */
+
+/** Completed successfully */
+#define ISOTP_N_OK              0
+/** Timeout waiting for the transmission of a frame (N_As / N_Ar) */
+#define ISOTP_N_TIMEOUT_A      -1
+/** Timeout waiting for a flow control frame (N_Bs) */
+#define ISOTP_N_TIMEOUT_BS     -2
+/** Timeout waiting for a consecutive frame (N_Cr) */
+#define ISOTP_N_TIMEOUT_CR     -3
+/** Consecutive frame with an unexpected sequence number */
+#define ISOTP_N_WRONG_SN       -4
+/** Flow control frame with an invalid flow status */
+#define ISOTP_N_INVALID_FS     -5
+/** Unexpected PDU received */
+#define ISOTP_N_UNEXP_PDU      -6
+/** Too many flow control frames with wait status */
+#define ISOTP_N_WFT_OVRN       -7
+/** Message too long for the receiver */
+#define ISOTP_N_BUFFER_OVERFLW -8
+/** Other error, e.g. on the CAN bus */
+#define ISOTP_N_ERROR          -9
+
+/* Implementation specific errors */
+
+/** No free CAN filter left to bind or send */
+#define ISOTP_NO_FREE_FILTER   -10
+/** Context already in use */
+#define ISOTP_BUSY             -11
+/** Invalid parameter */
+#define ISOTP_INVALID_PARAM    -12
+/** No complete message received before the timeout */
+#define ISOTP_RECV_TIMEOUT     -13
+
+/** Maximum message length that can be announced in a first frame */
+#define ISOTP_MSG_LEN_MAX      4095
+
+/**
+ * @brief ISO-TP addressing of one direction
+ *
+ * With extended addressing, the first data byte of every frame holds
+ * ext_addr.
+ */
+struct isotp_msg_id {
+	union {
+		u32_t std_id  : 11;
+		u32_t ext_id  : 29;
+	};
+	/** Use can_ide enum for assignment */
+	u8_t id_type;
+	u8_t ext_addr;
+	u8_t use_ext_addr;
+};
+
+/**
+ * @brief Flow control options of a receiver
+ */
+struct isotp_fc_opts {
+	/** Block size, consecutive frames between flow controls, 0 for all */
+	u8_t bs;
+	/** Minimum separation time between consecutive frames, encoded as in
+	 * ISO 15765-2: 0x00 - 0x7F in ms, 0xF1 - 0xF9 in 100 us steps.
+	 */
+	u8_t stmin;
+};
+
+/**
+ * @typedef isotp_tx_callback_t
+ * @brief Completion callback of an asynchronous send
+ *
+ * @param error_nr ISOTP_N_OK or a negative ISOTP_* error.
+ * @param arg      Argument given to isotp_send().
+ */
+typedef void (*isotp_tx_callback_t)(int error_nr, void *arg);
+
+/** @cond INTERNAL_HIDDEN */
+
+struct isotp_send_ctx {
+	struct device *can_dev;
+	struct isotp_msg_id tx_addr;
+	struct isotp_msg_id rx_addr;
+	const u8_t *data;
+	size_t len;
+	size_t pos;
+	isotp_tx_callback_t cb;
+	void *cb_arg;
+	struct k_sem fin_sem;
+	struct k_timer timer;
+	struct k_work work;
+	int filter_id;
+	int error;
+	s32_t stmin;
+	u8_t bs;
+	u8_t bs_left;
+	u8_t sn;
+	u8_t wft;
+	u8_t state;
+	u8_t busy;
+	u8_t pending;
+};
+
+struct isotp_recv_ctx {
+	struct device *can_dev;
+	struct isotp_msg_id rx_addr;
+	struct isotp_msg_id tx_addr;
+	struct isotp_fc_opts opts;
+	struct k_fifo fifo;
+	struct net_buf *buf;
+	struct net_buf *frag;
+	struct k_timer timer;
+	int filter_id;
+	int error;
+	size_t remaining;
+	u8_t sn_expected;
+	u8_t bs_left;
+	u8_t state;
+};
+
+/** @endcond */
+
+/**
+ * @brief Bind a receive context to an address
+ *
+ * Attaches a CAN filter for rx_addr. Messages are reassembled from the
+ * filter callback, flow control frames are sent to tx_addr, and completed
+ * messages are queued until read with isotp_recv() or isotp_recv_net().
+ *
+ * @param ctx     Receive context, kept in use until isotp_unbind().
+ * @param can_dev CAN device.
+ * @param rx_addr Address the messages are received on.
+ * @param tx_addr Address flow control frames are sent to.
+ * @param opts    Flow control options sent to the peer.
+ *
+ * @retval ISOTP_N_OK on success.
+ * @retval ISOTP_NO_FREE_FILTER if no CAN filter is left.
+ */
+int isotp_bind(struct isotp_recv_ctx *ctx, struct device *can_dev,
+	       const struct isotp_msg_id *rx_addr,
+	       const struct isotp_msg_id *tx_addr,
+	       const struct isotp_fc_opts *opts);
+
+/**
+ * @brief Unbind a receive context
+ *
+ * Detaches the CAN filter and releases messages not read yet.
+ *
+ * @param ctx Receive context.
+ */
+void isotp_unbind(struct isotp_recv_ctx *ctx);
+
+/**
+ * @brief Get the next complete message as a buffer chain
+ *
+ * The message data is not copied, the caller owns the returned buffer and
+ * must release it with net_buf_unref().
+ *
+ * @param ctx     Receive context.
+ * @param buffer  Head of the fragment chain holding the message.
+ * @param timeout Timeout in ms, K_NO_WAIT or K_FOREVER.
+ *
+ * @return Message length, or ISOTP_RECV_TIMEOUT.
+ */
+int isotp_recv_net(struct isotp_recv_ctx *ctx, struct net_buf **buffer,
+		   s32_t timeout);
+
+/**
+ * @brief Copy the next complete message
+ *
+ * @param ctx     Receive context.
+ * @param data    Destination, the message is truncated to len bytes.
+ * @param len     Size of data.
+ * @param timeout Timeout in ms, K_NO_WAIT or K_FOREVER.
+ *
+ * @return Number of bytes copied, or ISOTP_RECV_TIMEOUT.
+ */
+int isotp_recv(struct isotp_recv_ctx *ctx, u8_t *data, size_t len,
+	       s32_t timeout);
+
+/**
+ * @brief Send a message
+ *
+ * Segments data into a single frame or a first frame and consecutive
+ * frames, paced by the flow control frames of the receiver. Consecutive
+ * frames with a separation time of zero are sent back-to-back from the CAN
+ * transmit completion.
+ *
+ * @param ctx         Send context, zero initialized before its first use,
+ *                    in use until the send completes.
+ * @param can_dev     CAN device.
+ * @param data        Message, must remain valid until the send completes.
+ * @param len         Message length, up to ISOTP_MSG_LEN_MAX.
+ * @param tx_addr     Address the message is sent to.
+ * @param rx_addr     Address flow control frames are received on.
+ * @param complete_cb Completion callback, called from the system workqueue.
+ *                    If NULL, the call blocks until the send completes.
+ * @param cb_arg      Argument of complete_cb.
+ *
+ * @return ISOTP_N_OK or a negative ISOTP_* error. When complete_cb is set
+ *         this only reports errors starting the send.
+ */
+int isotp_send(struct isotp_send_ctx *ctx, struct device *can_dev,
+	       const u8_t *data, size_t len,
+	       const struct isotp_msg_id *tx_addr,
+	       const struct isotp_msg_id *rx_addr,
+	       isotp_tx_callback_t complete_cb, void *cb_arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_CANBUS_ISOTP_H_ */
@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_CBOR_CODEC_H_
+#define ZEPHYR_INCLUDE_CBOR_CODEC_H_
+
+/**
+ * @defgroup cbor CBOR
+ * @ingroup structured_data
+ * @{
+ */
+
+#include <misc/util.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <net/buf.h>
+
+/* CBOR major types (RFC 7049) */
+#define CBOR_MAJOR_UINT		0
+#define CBOR_MAJOR_NINT		1
+#define CBOR_MAJOR_BSTR		2
+#define CBOR_MAJOR_TSTR		3
+#define CBOR_MAJOR_ARRAY	4
+#define CBOR_MAJOR_MAP		5
+#define CBOR_MAJOR_TAG		6
+#define CBOR_MAJOR_SIMPLE	7
+
+/* additional information of the initial byte */
+#define CBOR_AI_UINT8		24
+#define CBOR_AI_UINT16		25
+#define CBOR_AI_UINT32		26
+#define CBOR_AI_UINT64		27
+#define CBOR_AI_FLOAT16		25
+#define CBOR_AI_FLOAT32		26
+#define CBOR_AI_FLOAT64		27
+#define CBOR_AI_INDEFINITE	31
+
+#define CBOR_FALSE		0xf4
+#define CBOR_TRUE		0xf5
+#define CBOR_NULL		0xf6
+#define CBOR_BREAK		0xff
+
+/** Number of items of an indefinite-length array or map */
+#define CBOR_INDEFINITE		SIZE_MAX
+
+struct cbor_writer;
+
+/**
+ * @brief Function pointer type to append encoded bytes to the output
+ *
+ * @param writer Writer the bytes are appended through
+ * @param data Encoded bytes
+ * @param len Number of bytes in @a data
+ *
+ * @return 0 on success, a negative error code if the bytes could not be
+ * appended entirely.
+ */
+typedef int (*cbor_write_t)(struct cbor_writer *writer, const u8_t *data,
+			    size_t len);
+
+/**
+ * @brief CBOR encoder
+ *
+ * Items are written straight into the output, there is no intermediate
+ * buffer. The first error is latched: later writes fail with it and
+ * nothing more is appended, so a sequence of writes can be checked once
+ * at the end.
+ */
+struct cbor_writer {
+	cbor_write_t write;
+	void *user_data;
+	union {
+		struct {
+			u8_t *data;
+			size_t size;
+		} buf;
+		struct {
+			net_buf_allocator_cb allocate_cb;
+			void *allocate_data;
+		} net_buf;
+	};
+	/* Number of bytes written */
+	size_t len;
+	int err;
+};
+
+/**
+ * @brief CBOR decoder, iterating in place over the encoded data
+ */
+struct cbor_reader {
+	const u8_t *pos;
+	const u8_t *end;
+};
+
+/** A text or byte string, pointing into the decoded data */
+struct cbor_str {
+	const u8_t *data;
+	size_t len;
+};
+
+/**
+ * @brief Initializes a writer calling a custom output function
+ *
+ * @param writer Writer to initialize
+ * @param write Function appending the encoded bytes
+ * @param user_data User-provided pointer, available in the writer
+ */
+void cbor_writer_init(struct cbor_writer *writer, cbor_write_t write,
+		      void *user_data);
+
+/**
+ * @brief Initializes a writer encoding into a flat buffer
+ *
+ * @param writer Writer to initialize
+ * @param buf Output buffer
+ * @param size Size of @a buf, -ENOMEM is returned when it is exceeded
+ */
+void cbor_writer_init_buf(struct cbor_writer *writer, u8_t *buf,
+			  size_t size);
+
+/**
+ * @brief Initializes a writer appending to a net_buf chain
+ *
+ * The bytes are added to the last fragment of the chain. When it is full,
+ * fragments obtained from @a allocate_cb are appended to the chain, without
+ * waiting. If @a allocate_cb is NULL, only the last fragment is filled.
+ *
+ * @param writer Writer to initialize
+ * @param buf Head of the chain
+ * @param allocate_cb Allocator of new fragments, or NULL
+ * @param allocate_data User data passed to @a allocate_cb
+ */
+void cbor_writer_init_net_buf(struct cbor_writer *writer,
+			      struct net_buf *buf,
+			      net_buf_allocator_cb allocate_cb,
+			      void *allocate_data);
+
+/**
+ * @brief Writes the initial bytes of an item
+ *
+ * @param writer Writer
+ * @param major Major type of the item, CBOR_MAJOR_*
+ * @param value Argument of the head: value, length or number of items
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int cbor_write_head(struct cbor_writer *writer, u8_t major, u64_t value);
+
+/** @brief Writes an unsigned integer */
+int cbor_write_uint(struct cbor_writer *writer, u64_t value);
+
+/** @brief Writes a signed integer */
+int cbor_write_int(struct cbor_writer *writer, s64_t value);
+
+/** @brief Writes a byte string */
+int cbor_write_bstr(struct cbor_writer *writer, const void *data,
+		    size_t len);
+
+/** @brief Writes a text string of @a len bytes, not NUL terminated */
+int cbor_write_tstr(struct cbor_writer *writer, const char *str, size_t len);
+
+/** @brief Writes a boolean */
+int cbor_write_bool(struct cbor_writer *writer, bool value);
+
+/** @brief Writes a null */
+int cbor_write_null(struct cbor_writer *writer);
+
+/**
+ * @brief Writes a floating point number
+ *
+ * The value is written in single precision when that is exact, in double
+ * precision otherwise.
+ */
+int cbor_write_double(struct cbor_writer *writer, double value);
+
+/**
+ * @brief Starts an array
+ *
+ * @param writer Writer
+ * @param count Number of items, CBOR_INDEFINITE for an array ended by
+ * cbor_write_break()
+ */
+int cbor_write_array_start(struct cbor_writer *writer, size_t count);
+
+/**
+ * @brief Starts a map
+ *
+ * @param writer Writer
+ * @param count Number of key and value pairs, CBOR_INDEFINITE for a map
+ * ended by cbor_write_break()
+ */
+int cbor_write_map_start(struct cbor_writer *writer, size_t count);
+
+/** @brief Ends an indefinite-length array or map */
+int cbor_write_break(struct cbor_writer *writer);
+
+/**
+ * @brief Initializes a reader
+ *
+ * @param reader Reader to initialize
+ * @param data Encoded data, which must stay valid while items read from
+ * it are in use
+ * @param len Length of @a data
+ */
+void cbor_reader_init(struct cbor_reader *reader, const void *data,
+		      size_t len);
+
+/**
+ * @brief Reads the initial bytes of an item
+ *
+ * @param reader Reader
+ * @param major Major type of the item
+ * @param ai Additional information of the initial byte
+ * @param value Argument of the head, 0 for an indefinite length, the raw
+ * bits of a float
+ *
+ * @return 0 on success, -ENODATA at the end of the data, -EINVAL if the
+ * head is malformed.
+ */
+int cbor_read_head(struct cbor_reader *reader, u8_t *major, u8_t *ai,
+		   u64_t *value);
+
+/**
+ * @brief Returns the initial byte of the next item without consuming it
+ *
+ * @return The initial byte, -ENODATA at the end of the data.
+ */
+int cbor_peek(const struct cbor_reader *reader);
+
+/** @brief Reads an unsigned integer */
+int cbor_read_uint(struct cbor_reader *reader, u64_t *value);
+
+/** @brief Reads a signed integer, -ERANGE if it does not fit in s64_t */
+int cbor_read_int(struct cbor_reader *reader, s64_t *value);
+
+/**
+ * @brief Reads a byte string in place
+ *
+ * Indefinite-length strings are split in chunks and cannot be read in
+ * place, -ENOTSUP is returned for them.
+ */
+int cbor_read_bstr(struct cbor_reader *reader, struct cbor_str *str);
+
+/** @brief Reads a text string in place, see cbor_read_bstr() */
+int cbor_read_tstr(struct cbor_reader *reader, struct cbor_str *str);
+
+/** @brief Reads a boolean */
+int cbor_read_bool(struct cbor_reader *reader, bool *value);
+
+/** @brief Reads a null */
+int cbor_read_null(struct cbor_reader *reader);
+
+/** @brief Reads a floating point number of any precision, or an integer */
+int cbor_read_double(struct cbor_reader *reader, double *value);
+
+/**
+ * @brief Starts reading an array
+ *
+ * @param reader Reader
+ * @param count Number of items, CBOR_INDEFINITE if the array is ended by
+ * a break, see cbor_read_break()
+ */
+int cbor_read_array_start(struct cbor_reader *reader, size_t *count);
+
+/**
+ * @brief Starts reading a map
+ *
+ * @param reader Reader
+ * @param count Number of key and value pairs, CBOR_INDEFINITE if the map
+ * is ended by a break, see cbor_read_break()
+ */
+int cbor_read_map_start(struct cbor_reader *reader, size_t *count);
+
+/**
+ * @brief Consumes the break ending an indefinite-length array or map
+ *
+ * @return true if the next item was a break, false if there is another
+ * item.
+ */
+bool cbor_read_break(struct cbor_reader *reader);
+
+/**
+ * @brief Skips the next item, including the items it contains
+ *
+ * Arrays and maps can nest up to CONFIG_CBOR_MAX_DEPTH levels in a skipped
+ * item, -E2BIG is returned otherwise.
+ */
+int cbor_skip(struct cbor_reader *reader);
+
+enum cbor_types {
+	CBOR_TYPE_INT = 1,	/* s32_t */
+	CBOR_TYPE_INT64,	/* s64_t */
+	CBOR_TYPE_UINT,		/* u32_t */
+	CBOR_TYPE_BOOL,		/* bool */
+	CBOR_TYPE_DOUBLE,	/* double */
+	CBOR_TYPE_TSTR,		/* struct cbor_str */
+	CBOR_TYPE_BSTR,		/* struct cbor_str */
+	CBOR_TYPE_OBJECT,	/* struct, a map */
+	CBOR_TYPE_ARRAY,	/* array of one of the types above */
+};
+
+/**
+ * @brief Descriptor of a struct field mapped to a CBOR map entry
+ *
+ * Set up like struct json_obj_descr, with the CBOR_OBJ_DESCR_* macros. The
+ * key of the entry is a text string, or an integer label when @a name is
+ * NULL.
+ */
+struct cbor_obj_descr {
+	const char *name;
+	s16_t label;
+	u8_t name_len;
+	u8_t type : 4;
+	/* log2 of the alignment of the struct holding the field */
+	u8_t align_shift : 2;
+	u16_t offset;
+	union {
+		struct {
+			const struct cbor_obj_descr *sub_descr;
+			size_t sub_descr_len;
+		} object;
+		struct {
+			const struct cbor_obj_descr *element_descr;
+			size_t n_elements;
+		} array;
+	};
+};
+
+#define Z_CBOR_ALIGN_SHIFT(type)	(__alignof__(type) == 1 ? 0 : \
+					 __alignof__(type) == 2 ? 1 : \
+					 __alignof__(type) == 4 ? 2 : 3)
+
+/**
+ * @brief Descriptor of a primitive value with a text key
+ *
+ * @param struct_ Struct packing the values
+ * @param field_name_ Field name in the struct, and key
+ * @param type_ One of the CBOR_TYPE_* primitive types
+ */
+#define CBOR_OBJ_DESCR_PRIM(struct_, field_name_, type_) \
+	CBOR_OBJ_DESCR_PRIM_NAMED(struct_, #field_name_, field_name_, type_)
+
+/**
+ * @brief Variant of CBOR_OBJ_DESCR_PRIM for a key differing from the
+ * field name
+ */
+#define CBOR_OBJ_DESCR_PRIM_NAMED(struct_, cbor_field_name_, \
+				  struct_field_name_, type_) \
+	{ \
+		.name = (cbor_field_name_), \
+		.name_len = sizeof(cbor_field_name_) - 1, \
+		.offset = offsetof(struct_, struct_field_name_), \
+		.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+		.type = type_, \
+	}
+
+/**
+ * @brief Variant of CBOR_OBJ_DESCR_PRIM for an integer key
+ */
+#define CBOR_OBJ_DESCR_PRIM_LABEL(struct_, label_, struct_field_name_, \
+				  type_) \
+	{ \
+		.label = (label_), \
+		.offset = offsetof(struct_, struct_field_name_), \
+		.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+		.type = type_, \
+	}
+
+/**
+ * @brief Descriptor of a nested struct
+ *
+ * @param struct_ Struct packing the values
+ * @param field_name_ Field name in the struct, and key
+ * @param sub_descr_ Array of cbor_obj_descr describing the nested struct
+ */
+#define CBOR_OBJ_DESCR_OBJECT(struct_, field_name_, sub_descr_) \
+	{ \
+		.name = (#field_name_), \
+		.name_len = sizeof(#field_name_) - 1, \
+		.offset = offsetof(struct_, field_name_), \
+		.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+		.type = CBOR_TYPE_OBJECT, \
+		.object = { \
+			.sub_descr = sub_descr_, \
+			.sub_descr_len = ARRAY_SIZE(sub_descr_), \
+		}, \
+	}
+
+/**
+ * @brief Descriptor of an array of primitives
+ *
+ * @param struct_ Struct packing the values
+ * @param field_name_ Field name in the struct, and key
+ * @param max_len_ Maximum number of elements in the array
+ * @param len_field_ Field name in the struct for the number of elements
+ * @param elem_type_ Element type, one of the CBOR_TYPE_* primitive types
+ */
+#define CBOR_OBJ_DESCR_ARRAY(struct_, field_name_, max_len_, len_field_, \
+			     elem_type_) \
+	{ \
+		.name = (#field_name_), \
+		.name_len = sizeof(#field_name_) - 1, \
+		.offset = offsetof(struct_, field_name_), \
+		.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+		.type = CBOR_TYPE_ARRAY, \
+		.array = { \
+			.element_descr = &(struct cbor_obj_descr) { \
+				.type = elem_type_, \
+				.offset = offsetof(struct_, len_field_), \
+				.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+			}, \
+			.n_elements = (max_len_), \
+		}, \
+	}
+
+/**
+ * @brief Descriptor of an array of structs
+ *
+ * @param struct_ Struct packing the values
+ * @param field_name_ Field name in the struct, and key
+ * @param max_len_ Maximum number of elements in the array
+ * @param len_field_ Field name in the struct for the number of elements
+ * @param elem_descr_ Array of cbor_obj_descr describing an element
+ * @param elem_descr_len_ Number of elements in @a elem_descr_
+ */
+#define CBOR_OBJ_DESCR_OBJ_ARRAY(struct_, field_name_, max_len_, \
+				 len_field_, elem_descr_, elem_descr_len_) \
+	{ \
+		.name = (#field_name_), \
+		.name_len = sizeof(#field_name_) - 1, \
+		.offset = offsetof(struct_, field_name_), \
+		.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+		.type = CBOR_TYPE_ARRAY, \
+		.array = { \
+			.element_descr = &(struct cbor_obj_descr) { \
+				.type = CBOR_TYPE_OBJECT, \
+				.object = { \
+					.sub_descr = elem_descr_, \
+					.sub_descr_len = elem_descr_len_, \
+				}, \
+				.offset = offsetof(struct_, len_field_), \
+				.align_shift = Z_CBOR_ALIGN_SHIFT(struct_), \
+			}, \
+			.n_elements = (max_len_), \
+		}, \
+	}
+
+/**
+ * @brief Encodes a struct as a map, one entry per descriptor
+ *
+ * @param writer Writer
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int cbor_obj_encode(struct cbor_writer *writer,
+		    const struct cbor_obj_descr *descr, size_t descr_len,
+		    const void *val);
+
+/**
+ * @brief Decodes a map into a struct
+ *
+ * Entries without a descriptor are skipped. Strings point into the data
+ * of the reader.
+ *
+ * @param reader Reader
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array, less than
+ * 31
+ * @param val Struct to hold the decoded values
+ *
+ * @return < 0 if error, bitmap of decoded fields on success (bit 0 is set
+ * if the first field in the descriptor has been decoded, etc).
+ */
+int cbor_obj_decode(struct cbor_reader *reader,
+		    const struct cbor_obj_descr *descr, size_t descr_len,
+		    void *val);
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_CBOR_CODEC_H_ */
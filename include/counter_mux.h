@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Software alarms multiplexed on a counter channel
+ */
+
+#ifndef ZEPHYR_INCLUDE_COUNTER_MUX_H_
+#define ZEPHYR_INCLUDE_COUNTER_MUX_H_
+
+/**
+ * @brief Counter Alarm Multiplexer
+ * @defgroup counter_mux Counter Alarm Multiplexer
+ * @ingroup counter_interface
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <device.h>
+#include <misc/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct counter_mux_alarm;
+
+/** @brief Alarm callback, called from the counter interrupt.
+ *
+ * The alarm may be started again from the callback.
+ *
+ * @param alarm     Expired alarm.
+ * @param user_data User data given to @ref counter_mux_alarm_init.
+ */
+typedef void (*counter_mux_alarm_callback_t)(struct counter_mux_alarm *alarm,
+					     void *user_data);
+
+/** @brief Software alarm. The members are private. */
+struct counter_mux_alarm {
+	sys_dnode_t node;
+	u64_t expiry;
+	counter_mux_alarm_callback_t callback;
+	void *user_data;
+};
+
+/** @brief Alarms sharing one channel of a counter. The members are private.
+ *
+ * The alarms are kept sorted by expiry, and the channel set for the
+ * earliest one. Counter values are extended to 64 bits, the channel is
+ * therefore also set at least twice per counter wrap.
+ */
+struct counter_mux {
+	struct device *dev;
+	sys_dlist_t alarms;
+	u64_t now;
+	u32_t last;
+	u32_t top;
+	u32_t guard;
+	u8_t chan_id;
+	bool armed;
+	bool dispatching;
+};
+
+/**
+ * @brief Initialize a multiplexer and start its counter.
+ *
+ * The counter is left at its top value, which must not change afterwards.
+ *
+ * @param mux		Multiplexer to initialize.
+ * @param dev		Counter device.
+ * @param chan_id	Counter channel dedicated to the multiplexer.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOTSUP if the counter has no such channel.
+ * @retval Negative errno code if the counter failed to start.
+ */
+int counter_mux_init(struct counter_mux *mux, struct device *dev,
+		     u8_t chan_id);
+
+/**
+ * @brief Read the counter of a multiplexer, extended to 64 bits.
+ *
+ * @param mux	Multiplexer.
+ *
+ * @return Ticks counted since @ref counter_mux_init.
+ */
+u64_t counter_mux_read(struct counter_mux *mux);
+
+/**
+ * @brief Initialize an alarm.
+ *
+ * @param alarm		Alarm to initialize.
+ * @param callback	Callback called when the alarm expires.
+ * @param user_data	User data passed to the callback.
+ */
+static inline void counter_mux_alarm_init(struct counter_mux_alarm *alarm,
+					  counter_mux_alarm_callback_t callback,
+					  void *user_data)
+{
+	sys_dnode_init(&alarm->node);
+	alarm->callback = callback;
+	alarm->user_data = user_data;
+}
+
+/**
+ * @brief Start an alarm.
+ *
+ * An alarm already started is restarted. Alarms expiring on the same tick
+ * are called in the order they were started. Callable from interrupt
+ * context.
+ *
+ * @param mux		Multiplexer.
+ * @param alarm		Alarm to start.
+ * @param ticks		Ticks to expire in, or at if absolute is set, as
+ *			read with @ref counter_mux_read.
+ * @param absolute	Whether ticks is a counter value.
+ *
+ * @retval 0 If successful.
+ * @retval Negative errno code if the counter channel could not be set.
+ */
+int counter_mux_alarm_start(struct counter_mux *mux,
+			    struct counter_mux_alarm *alarm,
+			    u64_t ticks, bool absolute);
+
+/**
+ * @brief Cancel an alarm.
+ *
+ * Callable from interrupt context.
+ *
+ * @param mux	Multiplexer.
+ * @param alarm	Alarm to cancel.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL if the alarm was not started, or already expired.
+ */
+int counter_mux_alarm_cancel(struct counter_mux *mux,
+			     struct counter_mux_alarm *alarm);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_COUNTER_MUX_H_ */
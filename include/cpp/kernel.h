@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief C++ wrappers of kernel objects
+ *
+ * Semaphores, message queues and timers with constexpr constructors, so
+ * that a static object is initialized by the compiler as with
+ * K_SEM_DEFINE() and friends, without a constructor run at boot. Placed
+ * with CPP_KOBJ_SECTION(), the objects land in the same linker sections as
+ * those of the C macros. Each wrapper holds the C object and nothing else,
+ * and its methods are inline calls of the C API.
+ *
+ * Message queues are typed and sized by template parameters, timers and
+ * threads call their handlers through trampolines instantiated for each
+ * handler, which the compiler can inline into.
+ *
+ * The wrappers are neither copyable nor movable, as the kernel keeps
+ * pointers into the objects: pass them by reference.
+ *
+ * @code
+ * struct sample {
+ *	u32_t value;
+ * };
+ *
+ * static void on_tick(zephyr::timer &timer);
+ *
+ * zephyr::sem ready CPP_KOBJ_SECTION(k_sem, ready) = { 0, 1 };
+ * zephyr::timer tick CPP_KOBJ_SECTION(k_timer, tick) = {
+ *	zephyr::timer::handler<on_tick> };
+ * CPP_MSGQ_DEFINE(samples, sample, 8);
+ * @endcode
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_KERNEL_H_
+#define ZEPHYR_INCLUDE_CPP_KERNEL_H_
+
+#if !defined(__cplusplus) || (__cplusplus < 201103L)
+#error "C++11 or later header included from another language"
+#endif
+
+#include <stddef.h>
+#include <kernel.h>
+
+/**
+ * @brief Place a kernel object in the section of its type
+ *
+ * The section the K_<type>_DEFINE() macros use, for the kernel to
+ * find the statically defined objects.
+ *
+ * @param type C type of the object, k_sem, k_msgq or k_timer
+ * @param name Name of the object
+ */
+#define CPP_KOBJ_SECTION(type, name) __in_section(_##type, static, name)
+
+namespace zephyr {
+
+/**
+ * @brief Semaphore
+ *
+ * @see k_sem_init()
+ */
+class sem {
+public:
+	/**
+	 * @param initial Initial count
+	 * @param limit Maximum count, not 0 and not less than @a initial
+	 */
+	constexpr sem(unsigned int initial, unsigned int limit)
+		: sem_ Z_SEM_INITIALIZER(sem_, initial, limit)
+	{
+		static_assert(sizeof(sem) == sizeof(struct k_sem),
+			      "not laid out as a k_sem");
+	}
+
+	sem(const sem &) = delete;
+	sem &operator=(const sem &) = delete;
+
+	/** @see k_sem_take() */
+	int take(s32_t timeout = K_FOREVER)
+	{
+		return k_sem_take(&sem_, timeout);
+	}
+
+	/** @see k_sem_give() */
+	void give() { k_sem_give(&sem_); }
+
+	/** @see k_sem_reset() */
+	void reset() { k_sem_reset(&sem_); }
+
+	/** @see k_sem_count_get() */
+	unsigned int count() { return k_sem_count_get(&sem_); }
+
+	/** The C object, for the APIs not wrapped here such as k_poll() */
+	struct k_sem *native() { return &sem_; }
+
+private:
+	struct k_sem sem_;
+};
+
+/**
+ * @brief Buffer of a message queue of @a N messages of type @a T
+ *
+ * Kept out of the queue object, which is laid out as a k_msgq.
+ */
+template <typename T, size_t N>
+struct msgq_buffer {
+	alignas(T) char data[N * sizeof(T)];
+};
+
+/**
+ * @brief Message queue of @a N messages of type @a T
+ *
+ * The messages are copied in and out of the queue, @a T must be trivially
+ * copyable.
+ *
+ * @see k_msgq_init()
+ */
+template <typename T, size_t N>
+class msgq {
+public:
+	constexpr msgq(msgq_buffer<T, N> &buffer)
+		: msgq_ _K_MSGQ_INITIALIZER(msgq_, buffer.data, sizeof(T), N)
+	{
+		static_assert(__is_trivially_copyable(T),
+			      "messages are copied as bytes");
+		static_assert(N > 0, "no room for a message");
+		static_assert(sizeof(msgq) == sizeof(struct k_msgq),
+			      "not laid out as a k_msgq");
+	}
+
+	msgq(const msgq &) = delete;
+	msgq &operator=(const msgq &) = delete;
+
+	/** @see k_msgq_put() */
+	int put(const T &msg, s32_t timeout = K_NO_WAIT)
+	{
+		return k_msgq_put(&msgq_, const_cast<T *>(&msg), timeout);
+	}
+
+	/** @see k_msgq_put_many() */
+	int put(const T *msgs, u32_t num_msgs, s32_t timeout = K_NO_WAIT)
+	{
+		return k_msgq_put_many(&msgq_, msgs, num_msgs, timeout);
+	}
+
+	/** @see k_msgq_get() */
+	int get(T &msg, s32_t timeout = K_FOREVER)
+	{
+		return k_msgq_get(&msgq_, &msg, timeout);
+	}
+
+	/** @see k_msgq_get_many() */
+	int get(T *msgs, u32_t num_msgs, s32_t timeout = K_FOREVER)
+	{
+		return k_msgq_get_many(&msgq_, msgs, num_msgs, timeout);
+	}
+
+	/** @see k_msgq_peek() */
+	int peek(T &msg) { return k_msgq_peek(&msgq_, &msg); }
+
+	/** @see k_msgq_purge() */
+	void purge() { k_msgq_purge(&msgq_); }
+
+	/** @see k_msgq_num_used_get() */
+	u32_t num_used() { return k_msgq_num_used_get(&msgq_); }
+
+	/** @see k_msgq_num_free_get() */
+	u32_t num_free() { return k_msgq_num_free_get(&msgq_); }
+
+	static constexpr size_t capacity() { return N; }
+
+	struct k_msgq *native() { return &msgq_; }
+
+private:
+	struct k_msgq msgq_;
+};
+
+/**
+ * @brief Define a message queue and its buffer
+ *
+ * @param name Name of the queue
+ * @param type Type of the messages
+ * @param max_msgs Number of messages the queue holds
+ */
+#define CPP_MSGQ_DEFINE(name, type, max_msgs)				\
+	static zephyr::msgq_buffer<type, max_msgs> __noinit		\
+		_k_cpp_msgq_buf_##name;					\
+	zephyr::msgq<type, max_msgs> name CPP_KOBJ_SECTION(k_msgq, name) = \
+		{ _k_cpp_msgq_buf_##name }
+
+/**
+ * @brief Timer
+ *
+ * The expiry and stop functions are given as handler<fn> or, for a member
+ * function of the object set with user_data_set(), as
+ * member_handler<class, &class::fn>.
+ *
+ * @see k_timer_init()
+ */
+class timer {
+public:
+	/** Expiry or stop function of a timer */
+	template <void (*Fn)(timer &)>
+	static void handler(struct k_timer *t)
+	{
+		Fn(*from(t));
+	}
+
+	/** Expiry or stop member function of the timer's user data */
+	template <typename T, void (T::*Fn)(timer &)>
+	static void member_handler(struct k_timer *t)
+	{
+		(static_cast<T *>(t->user_data)->*Fn)(*from(t));
+	}
+
+	constexpr timer(k_timer_expiry_t expiry = nullptr,
+			k_timer_stop_t stop = nullptr)
+		: timer_ Z_TIMER_INITIALIZER(timer_, expiry, stop)
+	{
+		static_assert(sizeof(timer) == sizeof(struct k_timer),
+			      "not laid out as a k_timer");
+	}
+
+	timer(const timer &) = delete;
+	timer &operator=(const timer &) = delete;
+
+	/** @see k_timer_start() */
+	void start(s32_t duration, s32_t period = 0)
+	{
+		k_timer_start(&timer_, duration, period);
+	}
+
+	/** @see k_timer_stop() */
+	void stop() { k_timer_stop(&timer_); }
+
+	/** @see k_timer_status_get() */
+	u32_t status_get() { return k_timer_status_get(&timer_); }
+
+	/** @see k_timer_status_sync() */
+	u32_t status_sync() { return k_timer_status_sync(&timer_); }
+
+	/** @see k_timer_remaining_get() */
+	u32_t remaining_get() { return k_timer_remaining_get(&timer_); }
+
+	/** @see k_timer_user_data_set() */
+	template <typename T>
+	void user_data_set(T *data) { k_timer_user_data_set(&timer_, data); }
+
+	/** @see k_timer_user_data_get() */
+	template <typename T>
+	T *user_data_get()
+	{
+		return static_cast<T *>(k_timer_user_data_get(&timer_));
+	}
+
+	struct k_timer *native() { return &timer_; }
+
+private:
+	static timer *from(struct k_timer *t)
+	{
+		return reinterpret_cast<timer *>(t);
+	}
+
+	struct k_timer timer_;
+};
+
+/**
+ * @brief Thread with a stack of @a StackSize bytes
+ *
+ * The thread and its stack are one object, zero-initialized as static
+ * objects are. The entry point is given as a template argument of
+ * start(), and takes a typed argument.
+ *
+ * @see k_thread_create()
+ */
+template <size_t StackSize>
+class thread {
+public:
+	thread() = default;
+
+	thread(const thread &) = delete;
+	thread &operator=(const thread &) = delete;
+
+	/**
+	 * @brief Start the thread in Fn(arg)
+	 *
+	 * @return ID of the thread.
+	 */
+	template <typename T, void (*Fn)(T &)>
+	k_tid_t start(T &arg, int prio, u32_t options = 0,
+		      s32_t delay = K_NO_WAIT)
+	{
+		return k_thread_create(&thread_, stack_,
+				       K_THREAD_STACK_SIZEOF(stack_),
+				       entry<T, Fn>, &arg, NULL, NULL,
+				       prio, options, delay);
+	}
+
+	/** @brief Start the thread in Fn() */
+	template <void (*Fn)()>
+	k_tid_t start(int prio, u32_t options = 0, s32_t delay = K_NO_WAIT)
+	{
+		return k_thread_create(&thread_, stack_,
+				       K_THREAD_STACK_SIZEOF(stack_),
+				       entry<Fn>, NULL, NULL, NULL,
+				       prio, options, delay);
+	}
+
+	/** @see k_thread_abort() */
+	void abort() { k_thread_abort(&thread_); }
+
+	k_tid_t tid() { return &thread_; }
+
+private:
+	template <typename T, void (*Fn)(T &)>
+	static void entry(void *p1, void *p2, void *p3)
+	{
+		Fn(*static_cast<T *>(p1));
+	}
+
+	template <void (*Fn)()>
+	static void entry(void *p1, void *p2, void *p3)
+	{
+		Fn();
+	}
+
+	struct k_thread thread_;
+	K_THREAD_STACK_MEMBER(stack_, StackSize);
+};
+
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_INCLUDE_CPP_KERNEL_H_ */
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Memory resources for C++ allocations
+ *
+ * The global operator new of C++ applications takes its memory from the
+ * system heap, with k_malloc(). A memory resource, modelled on
+ * std::pmr::memory_resource, lets containers and classes take theirs from
+ * a dedicated memory slab, memory pool or buffer instead:
+ *
+ * - slab_resource hands out the blocks of a k_mem_slab, in constant time,
+ *   for objects of a single size.
+ * - pool_resource allocates from a k_mem_pool other than the system heap.
+ * - monotonic_buffer_resource carves a buffer and frees it all at once,
+ *   for objects that live and die together.
+ *
+ * A container uses one through polymorphic_allocator, a class through
+ * CPP_MEMORY_RESOURCE_NEW(). No resource waits for memory: allocate()
+ * returns nullptr when there is none, as the global operator new does.
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_H_
+#define ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_H_
+
+#ifndef __cplusplus
+#error "C++ header included from a C file"
+#endif
+
+#include <stddef.h>
+#include <kernel.h>
+
+namespace zephyr {
+
+/**
+ * @brief Source of memory for allocations
+ *
+ * Derived classes implement do_allocate(), do_deallocate() and
+ * do_is_equal(), as for std::pmr::memory_resource.
+ */
+class memory_resource {
+public:
+	/** Alignment used when none is given, that of any scalar type */
+	static constexpr size_t default_align = __alignof__(long long) >
+						__alignof__(void *) ?
+						__alignof__(long long) :
+						__alignof__(void *);
+
+	virtual ~memory_resource() {}
+
+	/**
+	 * @brief Allocate memory
+	 *
+	 * @param bytes Size of the allocation
+	 * @param align Alignment of the allocation, a power of two
+	 *
+	 * @return The allocation, nullptr if there is no memory.
+	 */
+	void *allocate(size_t bytes, size_t align = default_align)
+	{
+		return do_allocate(bytes, align);
+	}
+
+	/**
+	 * @brief Free memory
+	 *
+	 * @param p Allocation returned by allocate(), or nullptr
+	 * @param bytes Size passed to allocate()
+	 * @param align Alignment passed to allocate()
+	 */
+	void deallocate(void *p, size_t bytes, size_t align = default_align)
+	{
+		if (p != nullptr) {
+			do_deallocate(p, bytes, align);
+		}
+	}
+
+	/**
+	 * @brief Check whether memory from a resource can be freed by another
+	 */
+	bool is_equal(const memory_resource &other) const noexcept
+	{
+		return do_is_equal(other);
+	}
+
+private:
+	virtual void *do_allocate(size_t bytes, size_t align) = 0;
+	virtual void do_deallocate(void *p, size_t bytes, size_t align) = 0;
+
+	virtual bool do_is_equal(const memory_resource &other) const noexcept
+	{
+		return this == &other;
+	}
+};
+
+inline bool operator==(const memory_resource &a, const memory_resource &b)
+{
+	return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource &a, const memory_resource &b)
+{
+	return !(a == b);
+}
+
+/**
+ * @brief Memory resource of the blocks of a memory slab
+ *
+ * Allocations larger than the blocks of the slab fail, smaller ones use a
+ * whole block.
+ */
+class slab_resource : public memory_resource {
+public:
+	explicit slab_resource(struct k_mem_slab *slab) : slab_(slab) {}
+
+	struct k_mem_slab *slab() const { return slab_; }
+
+private:
+	void *do_allocate(size_t bytes, size_t align) override;
+	void do_deallocate(void *p, size_t bytes, size_t align) override;
+
+	struct k_mem_slab *slab_;
+};
+
+/**
+ * @brief Memory resource of a memory pool
+ *
+ * As k_mem_pool_malloc(), but for the requested alignment, as long as the
+ * pool's own alignment allows it.
+ */
+class pool_resource : public memory_resource {
+public:
+	explicit pool_resource(struct k_mem_pool *pool) : pool_(pool) {}
+
+	struct k_mem_pool *pool() const { return pool_; }
+
+private:
+	void *do_allocate(size_t bytes, size_t align) override;
+	void do_deallocate(void *p, size_t bytes, size_t align) override;
+
+	struct k_mem_pool *pool_;
+};
+
+/**
+ * @brief Memory resource carving a buffer
+ *
+ * Allocating moves a cursor along the buffer, freeing does nothing: the
+ * whole buffer is freed at once by release(). Allocations fail once the
+ * buffer is exhausted, there is no upstream resource. Not thread safe.
+ */
+class monotonic_buffer_resource : public memory_resource {
+public:
+	monotonic_buffer_resource(void *buffer, size_t size)
+		: buffer_(static_cast<char *>(buffer)), size_(size), used_(0) {}
+
+	monotonic_buffer_resource(const monotonic_buffer_resource &) = delete;
+	monotonic_buffer_resource &
+	operator=(const monotonic_buffer_resource &) = delete;
+
+	/** Free all the allocations */
+	void release() { used_ = 0; }
+
+	/** Number of bytes allocated, with alignment padding */
+	size_t used() const { return used_; }
+
+private:
+	void *do_allocate(size_t bytes, size_t align) override;
+	void do_deallocate(void *, size_t, size_t) override {}
+
+	char *buffer_;
+	size_t size_;
+	size_t used_;
+};
+
+/**
+ * @brief Allocator of a memory resource, for the standard containers
+ *
+ * As std::pmr::polymorphic_allocator: copies, including those rebound to
+ * other types by the containers, allocate from the same resource. Without
+ * exceptions, a failed allocation returns nullptr rather than throwing.
+ */
+template <typename T>
+class polymorphic_allocator {
+public:
+	typedef T value_type;
+
+	polymorphic_allocator(memory_resource *resource) noexcept
+		: resource_(resource) {}
+
+	template <typename U>
+	polymorphic_allocator(const polymorphic_allocator<U> &other) noexcept
+		: resource_(other.resource()) {}
+
+	T *allocate(size_t n)
+	{
+		if (n > (size_t)-1 / sizeof(T)) {
+			return nullptr;
+		}
+
+		return static_cast<T *>(resource_->allocate(n * sizeof(T),
+							    __alignof__(T)));
+	}
+
+	void deallocate(T *p, size_t n)
+	{
+		resource_->deallocate(p, n * sizeof(T), __alignof__(T));
+	}
+
+	memory_resource *resource() const noexcept { return resource_; }
+
+private:
+	memory_resource *resource_;
+};
+
+template <typename T, typename U>
+inline bool operator==(const polymorphic_allocator<T> &a,
+		       const polymorphic_allocator<U> &b) noexcept
+{
+	return *a.resource() == *b.resource();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const polymorphic_allocator<T> &a,
+		       const polymorphic_allocator<U> &b) noexcept
+{
+	return !(a == b);
+}
+
+} /* namespace zephyr */
+
+/**
+ * @brief Class-specific operator new and delete from a memory resource
+ *
+ * Used in the public section of a class, so that new and delete of its
+ * objects, and of those of derived classes unless they declare their own,
+ * allocate from the resource rather than from the system heap. The operators do not
+ * throw: new returns nullptr when the resource is exhausted, and the
+ * object is not constructed.
+ *
+ * @code
+ * K_MEM_SLAB_DEFINE(msg_slab, sizeof(msg), 8, 4);
+ * static zephyr::slab_resource msg_resource(&msg_slab);
+ *
+ * class msg {
+ * public:
+ *	CPP_MEMORY_RESOURCE_NEW(msg_resource)
+ *	...
+ * };
+ * @endcode
+ *
+ * @param res Memory resource, an lvalue of static storage duration
+ */
+#define CPP_MEMORY_RESOURCE_NEW(res)					\
+	static void *operator new(size_t size) noexcept			\
+	{								\
+		return (res).allocate(size);				\
+	}								\
+	static void operator delete(void *p, size_t size) noexcept	\
+	{								\
+		(res).deallocate(p, size);				\
+	}								\
+	static void *operator new[](size_t size) = delete;		\
+	static void operator delete[](void *p) = delete;
+
+#endif /* ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_H_ */
@@ -38,8 +38,18 @@ struct crypto_driver_api {
 	/* Register async crypto op completion callback with the driver*/
 	int (*crypto_async_callback_set)(struct device *dev,
 					 crypto_completion_cb cb);
+
+	/* Queue a request, optional for drivers with a request queue of
+	 * their own in hardware or in the driver.
+	 */
+	int (*submit)(struct device *dev, struct cipher_req *req);
 };
 
+#ifdef CONFIG_CRYPTO_QUEUE
+/* Queue a request in the generic request queue, see crypto_queue.c */
+extern int crypto_queue_submit(struct cipher_req *req);
+#endif
+
 /* Following are the calls an app could make to get cipher stuff done.
  * The first two relates to crypto "session" setup / tear down.
  * Further we have four mode specific (CTR, CCM, CBC ...) calls to perform the
@@ -268,4 +278,67 @@ static inline int cipher_ccm_op(struct cipher_ctx *ctx,
 	return ctx->ops.ccm_crypt_hndlr(ctx, pkt, nonce);
 }
 
+/*
+ * @brief Perform the crypto operation of a request synchronously
+ *
+ * Invokes the cipher_xxx_op() of the session mode, for the drivers and
+ * queues running requests through the synchronous handlers.
+ *
+ * @param[in/out]  req   Request of the operation.
+ *
+ * @return 0 on success, negative errno code on fail.
+ */
+static inline int cipher_req_run(struct cipher_req *req)
+{
+	struct cipher_ctx *ctx = req->ctx;
+
+	switch (ctx->ops.cipher_mode) {
+	case CRYPTO_CIPHER_MODE_ECB:
+		return cipher_block_op(ctx, req->pkt);
+	case CRYPTO_CIPHER_MODE_CBC:
+		return cipher_cbc_op(ctx, req->pkt, req->iv);
+	case CRYPTO_CIPHER_MODE_CTR:
+		return cipher_ctr_op(ctx, req->pkt, req->iv);
+	case CRYPTO_CIPHER_MODE_CCM:
+		return cipher_ccm_op(ctx, req->aead_pkt, req->iv);
+	default:
+		return -EINVAL;
+	}
+}
+
+/*
+ * @brief Queue a crypto operation
+ *
+ * The request is queued to the driver of its session if it has a request
+ * queue, or else to the generic request queue when CONFIG_CRYPTO_QUEUE is
+ * enabled, which performs the operations with the synchronous handlers of
+ * the session in a thread. Requests are completed in the order they were
+ * submitted, and the callback of the request is invoked on completion.
+ * Requests of a session may then be submitted back to back, the queue
+ * running through them without waking up the app in between.
+ *
+ * @param[in/out]  req   Request of the operation. The session, packet, iv
+ *			  and callback are to be populated by the app.
+ *
+ * @return 0 if queued, -ENOTSUP if no queue is available for the driver,
+ *			  negative errno code on fail.
+ */
+static inline int cipher_req_submit(struct cipher_req *req)
+{
+	struct device *dev = req->ctx->device;
+	struct crypto_driver_api *api;
+
+	api = (struct crypto_driver_api *) dev->driver_api;
+
+	if (api->submit) {
+		return api->submit(dev, req);
+	}
+
+#ifdef CONFIG_CRYPTO_QUEUE
+	return crypto_queue_submit(req);
+#else
+	return -ENOTSUP;
+#endif
+}
+
 #endif /* ZEPHYR_INCLUDE_CRYPTO_CIPHER_H_ */
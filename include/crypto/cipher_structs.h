@@ -19,6 +19,7 @@
 
 #include <device.h>
 #include <misc/util.h>
+#include <misc/slist.h>
 
 enum cipher_algo {
 	CRYPTO_CIPHER_ALGO_AES = 1,
@@ -243,4 +244,39 @@ struct cipher_aead_pkt {
  */
 typedef void (*crypto_completion_cb)(struct cipher_pkt *completed, int status);
 
+struct cipher_req;
+
+/* Prototype for the function to be invoked on completion of a request
+ * submitted with cipher_req_submit(). Depending on the driver, this may be
+ * invoked from an ISR context.
+ */
+typedef void (*cipher_req_cb)(struct cipher_req *req, int status);
+
+/* Structure encoding a crypto operation queued with cipher_req_submit().
+ * To be populated by the app, and left untouched until the completion
+ * callback is invoked.
+ */
+struct cipher_req {
+	/* Reserved for the queue the request waits in */
+	sys_snode_t node;
+
+	/* Session of the operation */
+	struct cipher_ctx *ctx;
+
+	/* IO buffers, an AEAD packet for ccm ops */
+	union {
+		struct cipher_pkt *pkt;
+		struct cipher_aead_pkt *aead_pkt;
+	};
+
+	/* IV, counter or nonce of the operation, as for cipher_xxx_op() */
+	u8_t *iv;
+
+	/* Invoked with the status of the operation on completion */
+	cipher_req_cb cb;
+
+	/* Totally managed by the app */
+	void *user_data;
+};
+
 #endif /* ZEPHYR_INCLUDE_CRYPTO_CIPHER_STRUCTS_H_ */
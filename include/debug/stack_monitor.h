@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Thread stack high-water monitor
+ *
+ * The monitor samples the stack painting done with CONFIG_INIT_STACKS for
+ * all threads and keeps the highest usage seen for each, so a thread stack
+ * can be sized from the usage observed at run time instead of a guess.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_STACK_MONITOR_H_
+#define ZEPHYR_INCLUDE_DEBUG_STACK_MONITOR_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Stack figures of a monitored thread */
+struct stack_monitor_info {
+	/** Monitored thread, may have exited since */
+	const struct k_thread *thread;
+	/** Name of the thread, or NULL */
+	const char *name;
+	/** Size of the stack, in bytes */
+	size_t size;
+	/** Highest stack usage seen, in bytes */
+	size_t max_used;
+	/** Whether the thread is still running */
+	bool alive;
+};
+
+/**
+ * @typedef stack_monitor_cb_t
+ * @brief Callback invoked with the figures of a monitored thread
+ */
+typedef void (*stack_monitor_cb_t)(const struct stack_monitor_info *info,
+				   void *user_data);
+
+/**
+ * @brief Sample the stack usage of all threads now
+ *
+ * The monitor also does this periodically, every
+ * CONFIG_STACK_MONITOR_PERIOD milliseconds.
+ */
+void stack_monitor_sample(void);
+
+/**
+ * @brief Iterate over the monitored threads
+ *
+ * The callback is invoked with the monitor locked, it must not call into
+ * the monitor.
+ *
+ * @param cb Callback invoked for each monitored thread
+ * @param user_data Pointer passed to the callback
+ */
+void stack_monitor_foreach(stack_monitor_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the recommended stack size of a monitored thread
+ *
+ * This is the highest usage seen, plus CONFIG_STACK_MONITOR_MARGIN
+ * percent, rounded up to 16 bytes and capped to the current size. It
+ * is only meaningful once the thread went through its worst case path.
+ *
+ * @param info Figures of the thread
+ * @return Recommended size to pass to K_THREAD_STACK_DEFINE(), in bytes
+ */
+size_t stack_monitor_recommended_size(const struct stack_monitor_info *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_STACK_MONITOR_H_ */
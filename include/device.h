@@ -99,32 +99,28 @@ extern "C" {
  * @details The driver api is also set here, eliminating the need to do that
  * during initialization.
  */
-#ifndef CONFIG_DEVICE_POWER_MANAGEMENT
 #define DEVICE_AND_API_INIT(dev_name, drv_name, init_fn, data, cfg_info,  \
 			    level, prio, api)				  \
-	static struct device_config _CONCAT(__config_, dev_name) __used	  \
-	__attribute__((__section__(".devconfig.init"))) = {		  \
-		.name = drv_name, .init = (init_fn),			  \
-		.config_info = (cfg_info)				  \
-	};								  \
-	static struct device _CONCAT(__device_, dev_name) __used	  \
-	__attribute__((__section__(".init_" #level STRINGIFY(prio)))) = { \
-		.config = &_CONCAT(__config_, dev_name),		  \
-		.driver_api = api,					  \
-		.driver_data = data					  \
-	}
-#else
-/*
- * Use the default device_pm_control for devices that do not call the
- * DEVICE_DEFINE macro so that caller of hook functions
- * need not check device_pm_control != NULL.
- */
-#define DEVICE_AND_API_INIT(dev_name, drv_name, init_fn, data, cfg_info, \
-			    level, prio, api)				 \
-	DEVICE_DEFINE(dev_name, drv_name, init_fn,			 \
-		      device_pm_control_nop, data, cfg_info, level,	 \
-		      prio, api)
-#endif
+	Z_DEVICE_DEFINE(dev_name, drv_name, init_fn,			  \
+			device_pm_control_nop, data, cfg_info, level,	  \
+			prio, api, 0)
+
+/**
+ * @def DEVICE_AND_API_INIT_FLAGS
+ *
+ * @brief Create device object and set it up for boot time initialization,
+ * with the option to set driver_api and initialization flags.
+ *
+ * @copydetails DEVICE_AND_API_INIT
+ * @param flags Initialization flags, a combination of
+ * DEVICE_INIT_FLAG_PARALLEL and DEVICE_INIT_FLAG_LAZY. Flags for features
+ * which are not enabled are ignored.
+ */
+#define DEVICE_AND_API_INIT_FLAGS(dev_name, drv_name, init_fn, data,	  \
+				  cfg_info, level, prio, api, flags)	  \
+	Z_DEVICE_DEFINE(dev_name, drv_name, init_fn,			  \
+			device_pm_control_nop, data, cfg_info, level,	  \
+			prio, api, flags)
 
 /**
  * @def DEVICE_DEFINE
@@ -138,14 +134,54 @@ extern "C" {
  * @param pm_control_fn Pointer to device_pm_control function.
  * Can be empty function (device_pm_control_nop) if not implemented.
  */
-#ifndef CONFIG_DEVICE_POWER_MANAGEMENT
 #define DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	 \
 		      data, cfg_info, level, prio, api)			 \
-	DEVICE_AND_API_INIT(dev_name, drv_name, init_fn, data, cfg_info, \
-			    level, prio, api)
+	Z_DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	 \
+			data, cfg_info, level, prio, api, 0)
+
+/**
+ * @brief The device may be initialized in parallel
+ *
+ * The init function of the device does not use any other device of the
+ * same init level with the same or a lower priority which also has this
+ * flag. Only honored with CONFIG_DEVICE_INIT_PARALLEL, at the POST_KERNEL
+ * and APPLICATION levels.
+ */
+#define DEVICE_INIT_FLAG_PARALLEL	BIT(0)
+
+/**
+ * @brief The device is initialized on first lookup
+ *
+ * The device is not initialized at boot but by the first
+ * device_get_binding() call for it. Only honored with
+ * CONFIG_DEVICE_INIT_LAZY. The device must not be used through
+ * DEVICE_GET() before being looked up.
+ */
+#define DEVICE_INIT_FLAG_LAZY		BIT(1)
+
+#ifndef CONFIG_DEVICE_POWER_MANAGEMENT
+#define Z_DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	  \
+			data, cfg_info, level, prio, api, flags)	  \
+	static struct device_config _CONCAT(__config_, dev_name) __used	  \
+	__attribute__((__section__(".devconfig.init"))) = {		  \
+		.name = drv_name, .init = (init_fn),			  \
+		.config_info = (cfg_info),				  \
+		.init_flags = (flags)					  \
+	};								  \
+	static struct device _CONCAT(__device_, dev_name) __used	  \
+	__attribute__((__section__(".init_" #level STRINGIFY(prio)))) = { \
+		.config = &_CONCAT(__config_, dev_name),		  \
+		.driver_api = api,					  \
+		.driver_data = data					  \
+	}
 #else
-#define DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	  \
-		      data, cfg_info, level, prio, api)			  \
+/*
+ * Devices that do not call the DEVICE_DEFINE macro use the default
+ * device_pm_control_nop so that caller of hook functions need not check
+ * device_pm_control != NULL.
+ */
+#define Z_DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	  \
+			data, cfg_info, level, prio, api, flags)	  \
 	static struct device_pm _CONCAT(__pm_, dev_name) __used           \
 							= {               \
 		.usage = ATOMIC_INIT(0),                                  \
@@ -162,7 +198,8 @@ extern "C" {
 		.name = drv_name, .init = (init_fn),			  \
 		.device_pm_control = (pm_control_fn),			  \
 		.pm  = &_CONCAT(__pm_, dev_name),                         \
-		.config_info = (cfg_info)				  \
+		.config_info = (cfg_info),				  \
+		.init_flags = (flags)					  \
 	};								  \
 	static struct device _CONCAT(__device_, dev_name) __used	  \
 	__attribute__((__section__(".init_" #level STRINGIFY(prio)))) = { \
@@ -233,6 +270,8 @@ typedef void (*device_pm_cb)(struct device *dev,
  * @param enable device pm enable flag
  * @param usage device usage count
  * @param fsm_state device idle internal power state
+ * @param autosuspend_delay delay of the suspend after the last put, in ms
+ * @param work work item running the FSM
  * @param event event object to listen to the sync request events
  * @param signal signal to notify the Async API callers
  */
@@ -242,7 +281,8 @@ struct device_pm {
 	bool enable;
 	atomic_t usage;
 	atomic_t fsm_state;
-	struct k_work work;
+	u32_t autosuspend_delay;
+	struct k_delayed_work work;
 	struct k_poll_event event;
 	struct k_poll_signal signal;
 };
@@ -253,6 +293,7 @@ struct device_pm {
  * @param name name of the device
  * @param init init function for the driver
  * @param config_info address of driver instance config information
+ * @param init_flags DEVICE_INIT_FLAG_* initialization flags
  */
 struct device_config {
 	const char *name;
@@ -263,6 +304,7 @@ struct device_config {
 	struct device_pm *pm;
 #endif
 	const void *config_info;
+	u8_t init_flags;
 };
 
 /**
@@ -589,6 +631,21 @@ int device_pm_put(struct device *dev);
  * @retval Errno Negative errno code if failure.
  */
 int device_pm_put_sync(struct device *dev);
+
+/**
+ * @brief Set the delay of the suspend after the device is released
+ *
+ * Once the usage count drops to 0 through device_pm_put(), the device is
+ * suspended after the delay rather than immediately, so that a device
+ * used in bursts is not suspended and resumed between each use. A
+ * device_pm_get() within the delay cancels the suspend.
+ * device_pm_put_sync() does not wait for the delay.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param delay Delay in milliseconds, 0 for none.
+ */
+void device_pm_autosuspend_delay_set(struct device *dev, u32_t delay);
 #else
 static inline void device_pm_enable(struct device *dev) { }
 static inline void device_pm_disable(struct device *dev) { }
@@ -596,6 +653,8 @@ static inline int device_pm_get(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_get_sync(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put(struct device *dev) { return -ENOTSUP; }
 static inline int device_pm_put_sync(struct device *dev) { return -ENOTSUP; }
+static inline void device_pm_autosuspend_delay_set(struct device *dev,
+						   u32_t delay) { }
 #endif
 
 #endif
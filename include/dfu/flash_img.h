@@ -13,6 +13,15 @@ extern "C" {
 #endif
 
 #include <flash_map.h>
+#ifdef CONFIG_IMG_ERASE_AHEAD
+#include <kernel.h>
+#endif
+#ifdef CONFIG_IMG_HASH_SHA256
+#include <tinycrypt/sha256.h>
+#endif
+
+/** Size of the hash computed while the image is written */
+#define FLASH_IMG_HASH_SIZE 32
 
 struct flash_img_context {
 	u8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
@@ -22,6 +31,17 @@ struct flash_img_context {
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 	off_t off_last;
 #endif
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	struct k_work erase_work;
+	struct k_mutex flash_lock;	/* serializes writes and erases */
+	struct k_sem erase_sem;		/* given for each sector erased */
+	off_t erased_end;		/* slot is erased up to this offset */
+	off_t erase_target;		/* erase-ahead goal of the worker */
+	int erase_err;
+#endif
+#ifdef CONFIG_IMG_HASH_SHA256
+	struct tc_sha256_state_struct sha;
+#endif
 };
 
 /**
@@ -62,6 +82,23 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, u8_t *data,
 		    size_t len, bool flush);
 
+#ifdef CONFIG_IMG_HASH_SHA256
+/**
+ * @brief Get the SHA-256 of the image written.
+ *
+ * The hash is computed over the data passed to flash_img_buffered_write()
+ * as it is written, after each block was read back from flash and found
+ * identical, so the image does not need to be read again to be checked
+ * before requesting the upgrade.
+ *
+ * @param ctx context, after the final flush
+ * @param hash buffer of FLASH_IMG_HASH_SIZE bytes receiving the hash
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_hash_get(struct flash_img_context *ctx, u8_t *hash);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -189,12 +189,19 @@ typedef int (*dma_api_stop)(struct device *dev, u32_t channel);
 typedef int (*dma_api_get_status)(struct device *dev, u32_t channel,
 				  struct dma_status *status);
 
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+typedef u32_t (*dma_api_get_channel_count)(struct device *dev);
+#endif
+
 struct dma_driver_api {
 	dma_api_config config;
 	dma_api_reload reload;
 	dma_api_start start;
 	dma_api_stop stop;
 	dma_api_get_status get_status;
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+	dma_api_get_channel_count get_channel_count;
+#endif
 };
 /**
  * @endcond
@@ -320,6 +327,109 @@ static inline int dma_get_status(struct device *dev, u32_t channel,
 	return -ENOSYS;
 }
 
+#ifdef CONFIG_DMA_CHANNEL_ALLOC
+/** dma_request_channel() argument picking any free channel */
+#define DMA_CHANNEL_ANY (-1)
+
+/**
+ * @brief Request a DMA channel for exclusive use
+ *
+ * Drivers sharing a DMA controller request the channels they use, either
+ * a given one, e.g. the stream wired to their peripheral, or any free one.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param channel Channel to request, or DMA_CHANNEL_ANY.
+ *
+ * @retval Channel number if successful.
+ * @retval -EBUSY if the channel, or every channel, is in use.
+ * @retval -EINVAL if the channel does not exist.
+ * @retval -ENOTSUP if DMA_CHANNEL_ANY is requested from a driver not
+ *         reporting its channel count.
+ * @retval -ENOMEM if CONFIG_DMA_CHANNEL_ALLOC_CONTROLLERS is too small.
+ */
+int dma_request_channel(struct device *dev, int channel);
+
+/**
+ * @brief Release a DMA channel obtained with dma_request_channel()
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param channel Channel to release.
+ */
+void dma_release_channel(struct device *dev, u32_t channel);
+#endif /* CONFIG_DMA_CHANNEL_ALLOC */
+
+#ifdef CONFIG_DMA_MEMCPY
+struct dma_memcpy;
+
+/**
+ * @typedef dma_memcpy_callback_t
+ * @brief Completion callback of dma_memcpy_async(), called from the DMA
+ *        interrupt.
+ *
+ * @param copy   The completed copy.
+ * @param result 0 on success, negative errno code otherwise.
+ */
+typedef void (*dma_memcpy_callback_t)(struct dma_memcpy *copy, int result);
+
+/**
+ * @brief Memory to memory copy offloaded to a DMA controller
+ *
+ * Owned by the service from dma_memcpy_async() to the callback.
+ */
+struct dma_memcpy {
+	/** @cond INTERNAL_HIDDEN */
+	struct device *dev;
+	struct dma_config cfg;
+	struct dma_block_config blk;
+	u8_t *dst;
+	const u8_t *src;
+	size_t remaining;
+	u32_t channel;
+	/** @endcond */
+	/** Completion callback */
+	dma_memcpy_callback_t callback;
+	/** Free for use by the caller */
+	void *user_data;
+};
+
+/**
+ * @brief Copy memory with a DMA channel
+ *
+ * Requests any free channel of the controller and copies len bytes in
+ * blocks of up to CONFIG_DMA_MEMCPY_BLOCK_SIZE, using word transfers when
+ * the addresses and the length allow it. The data cache is maintained for
+ * both buffers.
+ *
+ * @param dev  DMA controller able to do memory to memory transfers.
+ * @param copy Copy context, with its callback set.
+ * @param dst  Destination.
+ * @param src  Source, must not be modified until the copy completes.
+ * @param len  Number of bytes to copy, not zero.
+ *
+ * @retval 0 if the copy started.
+ * @retval -EBUSY if no channel is free.
+ * @retval Negative errno code if failure.
+ */
+int dma_memcpy_async(struct device *dev, struct dma_memcpy *copy,
+		     void *dst, const void *src, size_t len);
+
+/**
+ * @brief Copy memory with a DMA channel and wait for the completion
+ *
+ * Callers may fall back to memcpy() on any error.
+ *
+ * @param dev DMA controller able to do memory to memory transfers.
+ * @param dst Destination.
+ * @param src Source.
+ * @param len Number of bytes to copy, not zero.
+ *
+ * @retval 0 if successful.
+ * @retval -EWOULDBLOCK if called from an ISR.
+ * @retval Negative errno code if failure.
+ */
+int dma_memcpy(struct device *dev, void *dst, const void *src, size_t len);
+#endif /* CONFIG_DMA_MEMCPY */
+
 /**
  * @brief Look-up generic width index to be used in registers
  *
@@ -0,0 +1,155 @@
+/** @file
+ * @brief Modem AT command pipeline header file.
+ *
+ * Queues AT commands for a modem receiver context and parses the
+ * responses line by line, dispatching each line to the match table of
+ * the command in progress or to the unsolicited result code table.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_MODEM_MODEM_CMD_PIPELINE_H_
+#define ZEPHYR_INCLUDE_DRIVERS_MODEM_MODEM_CMD_PIPELINE_H_
+
+#include <kernel.h>
+#include <misc/slist.h>
+#include <drivers/modem/modem_receiver.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct mdm_cmd;
+
+/**
+ * @typedef mdm_cmd_match_cb_t
+ * @brief Called for a response line matching a prefix.
+ *
+ * @param  *cmd: command in progress, NULL for unsolicited result codes.
+ * @param  *args: rest of the line after the prefix, NUL terminated.
+ * @param  len: length of args.
+ */
+typedef void (*mdm_cmd_match_cb_t)(struct mdm_cmd *cmd,
+				   const char *args, size_t len);
+
+/**
+ * @typedef mdm_cmd_done_cb_t
+ * @brief Called when a command completed.
+ *
+ * @param  *cmd: completed command, which may be submitted again.
+ * @param  result: 0 on OK, -EIO on ERROR (see error), -ETIMEDOUT or
+ *         -ECANCELED.
+ */
+typedef void (*mdm_cmd_done_cb_t)(struct mdm_cmd *cmd, int result);
+
+struct mdm_cmd_match {
+	const char *prefix;
+	mdm_cmd_match_cb_t cb;
+};
+
+#define MDM_CMD_MATCH(_prefix, _cb) { .prefix = (_prefix), .cb = (_cb) }
+
+struct mdm_cmd {
+	sys_snode_t node;
+
+	/* command without the trailing carriage return */
+	const char *cmd;
+
+	/* response lines handled while this command is in progress */
+	const struct mdm_cmd_match *matches;
+	size_t match_count;
+
+	mdm_cmd_done_cb_t done;
+	void *user_data;
+
+	/* time allowed for the final result code, K_FOREVER for none */
+	s32_t timeout;
+
+	/* value of a +CME ERROR or +CMS ERROR final result code */
+	int error;
+};
+
+struct mdm_cmd_pipeline {
+	struct mdm_receiver_context *mdm_ctx;
+
+	/* unsolicited result codes, handled at any time */
+	const struct mdm_cmd_match *urcs;
+	size_t urc_count;
+
+	sys_slist_t queue;
+	struct mdm_cmd *current;
+	struct k_mutex lock;
+
+	struct k_delayed_work timeout_work;
+	s64_t deadline;
+
+	/* line being assembled */
+	char line[CONFIG_MODEM_CMD_PIPELINE_LINE_SIZE];
+	size_t line_len;
+	bool line_overflow;
+};
+
+/**
+ * @brief  Initializes a command pipeline.
+ *
+ * @note   The pipeline becomes the only reader of the receiver contexts
+ *         ring buffer, mdm_receiver_recv() must not be used with it.
+ *
+ * @param  *pipe: pipeline to initialize.
+ * @param  *mdm_ctx: registered receiver context of the modem.
+ * @param  *urcs: unsolicited result code table, may be NULL.
+ * @param  urc_count: number of entries in urcs.
+ *
+ * @retval None.
+ */
+void mdm_cmd_pipeline_init(struct mdm_cmd_pipeline *pipe,
+			   struct mdm_receiver_context *mdm_ctx,
+			   const struct mdm_cmd_match *urcs,
+			   size_t urc_count);
+
+/**
+ * @brief  Queues a command.
+ *
+ * @note   The command is written to the modem as soon as the previous
+ *         one got its final result code, without waking the submitter.
+ *         cmd must stay valid until its done callback is called.
+ *
+ * @param  *pipe: command pipeline.
+ * @param  *cmd: command to queue.
+ *
+ * @retval 0 if ok, < 0 if error.
+ */
+int mdm_cmd_pipeline_submit(struct mdm_cmd_pipeline *pipe,
+			    struct mdm_cmd *cmd);
+
+/**
+ * @brief  Completes all queued commands with -ECANCELED.
+ *
+ * @param  *pipe: command pipeline.
+ *
+ * @retval None.
+ */
+void mdm_cmd_pipeline_flush(struct mdm_cmd_pipeline *pipe);
+
+/**
+ * @brief  Parses all data received so far.
+ *
+ * @note   To be called by the modem driver rx thread whenever the rx_sem
+ *         of the receiver context is given. Data is consumed straight
+ *         from the ring buffer, in contiguous chunks.
+ *
+ * @param  *pipe: command pipeline.
+ *
+ * @retval None.
+ */
+void mdm_cmd_pipeline_process(struct mdm_cmd_pipeline *pipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_MODEM_MODEM_CMD_PIPELINE_H_ */
@@ -28,6 +28,17 @@ struct mdm_receiver_context {
 	struct ring_buf rx_rb;
 	struct k_sem rx_sem;
 
+#if defined(CONFIG_MODEM_RECEIVER_UART_ASYNC)
+	/* DMA buffers, swapped on each UART_RX_BUF_REQUEST */
+	u8_t rx_dma_buf[2][CONFIG_MODEM_RECEIVER_UART_ASYNC_BUF_SIZE];
+	u8_t rx_dma_next;
+
+	/* tx data, uart_tx() needs a RAM buffer */
+	u8_t tx_dma_buf[CONFIG_MODEM_RECEIVER_UART_ASYNC_BUF_SIZE];
+	struct k_sem tx_sem;
+	struct k_mutex tx_lock;
+#endif
+
 	/* modem data */
 	char *data_manufacturer;
 	char *data_model;
@@ -123,6 +123,15 @@ extern void z_clock_announce(s32_t ticks);
  */
 extern u32_t z_clock_elapsed(void);
 
+/**
+ * @brief Hardware cycle counter extended to 64 bits
+ *
+ * Counts as z_timer_cycle_get_32(), which gives its low 32 bits.
+ * Implemented by the drivers selecting TIMER_HAS_64BIT_CYCLE_COUNTER,
+ * by the kernel for the others.
+ */
+extern u64_t z_timer_cycle_get_64(void);
+
 #ifdef __cplusplus
 }
 #endif
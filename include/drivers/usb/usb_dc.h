@@ -125,6 +125,21 @@ typedef void (*usb_dc_ep_callback)(u8_t ep,
 typedef void (*usb_dc_status_callback)(enum usb_dc_status_code cb_status,
 				       const u8_t *param);
 
+/**
+ * Callback function signature for the completion of an endpoint transfer
+ *
+ * @param ep Endpoint address
+ * @param status 0, or -ECANCELED if the transfer was cancelled, or another
+ *        negative errno code on error
+ * @param len Number of bytes transferred
+ * @param priv Data passed to usb_dc_ep_xfer()
+ */
+typedef void (*usb_dc_ep_xfer_callback)(u8_t ep, int status, u32_t len,
+					void *priv);
+
+/** Follow the data of an IN transfer with a zero-length packet */
+#define USB_DC_XFER_ZLP BIT(0)
+
 /**
  * @brief Attach USB for device connection
  *
@@ -390,6 +405,53 @@ int usb_dc_ep_read_continue(u8_t ep);
  */
 int usb_dc_ep_mps(u8_t ep);
 
+/**
+ * @brief Queue a multi-packet transfer on a bulk or interrupt endpoint
+ *
+ * The controller moves the data between the buffer and the bus itself,
+ * by DMA where it can, and calls @a cb once, when the whole buffer has
+ * been sent, or for an OUT endpoint when the buffer is full or a short
+ * packet was received. The endpoint callback is not called for the
+ * packets of the transfer. The buffer belongs to the driver until then.
+ *
+ * Each endpoint queues two transfers: the second starts from the
+ * completion interrupt of the first, so that the endpoint does not NAK
+ * the host while the completion callback runs.
+ *
+ * Only available if CONFIG_USB_DC_HAS_XFER is set.
+ *
+ * @param[in]  ep           Endpoint address corresponding to the one
+ *                          listed in the device configuration table
+ * @param[in]  data         Buffer, in RAM
+ * @param[in]  len          Length of the buffer, a multiple of the max
+ *                          packet size for an OUT endpoint
+ * @param[in]  flags        USB_DC_XFER_ZLP or 0
+ * @param[in]  cb           Function called on completion, possibly in
+ *                          interrupt context
+ * @param[in]  priv         Data passed to @a cb
+ *
+ * @retval 0 Transfer queued.
+ * @retval -EBUSY Two transfers are already queued on the endpoint.
+ * @retval -EAGAIN The endpoint holds packet data not read yet, read it
+ *                 with usb_dc_ep_read() first.
+ * @retval -ENOTSUP Not supported for this endpoint or length.
+ */
+int usb_dc_ep_xfer(u8_t ep, u8_t *data, u32_t len, unsigned int flags,
+		   usb_dc_ep_xfer_callback cb, void *priv);
+
+/**
+ * @brief Cancel the transfers queued on an endpoint
+ *
+ * The callbacks of the transfers are called with -ECANCELED before this
+ * function returns, and the driver no longer accesses their buffers.
+ *
+ * @param[in]  ep           Endpoint address corresponding to the one
+ *                          listed in the device configuration table
+ *
+ * @return 0 on success, negative errno code on fail.
+ */
+int usb_dc_ep_xfer_cancel(u8_t ep);
+
 /**
  * @brief Start the host wake up procedure.
  *
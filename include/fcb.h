@@ -65,6 +65,19 @@ struct fcb {
 
 	const struct flash_area *fap; /* Flash area used by the fcb instance */
 				     /* This can be transfer to FCB user    */
+#ifdef CONFIG_FCB_ELEM_INDEX
+	u16_t *f_sector_elem_cnt; /* Caller of fcb_init may fill this in */
+				  /* with an array of f_sector_cnt      */
+				  /* counters of valid elements, to     */
+				  /* seek without walking all elements  */
+#endif
+#ifdef CONFIG_FCB_READ_AHEAD
+	/* Window of flash read ahead when walking elements */
+	struct flash_sector *f_ra_sector; /* NULL when empty */
+	u32_t f_ra_off;
+	u16_t f_ra_len;
+	u8_t f_ra_buf[CONFIG_FCB_READ_AHEAD_SIZE];
+#endif
 };
 
 /*
@@ -129,6 +142,12 @@ int fcb_is_empty(struct fcb *fcb);
 int fcb_offset_last_n(struct fcb *fcb, u8_t entries,
 		      struct fcb_entry *last_n_entry);
 
+/*
+ * Element number *n* counted from the oldest one, 0 being the oldest.
+ * With f_sector_elem_cnt, whole sectors are skipped without reading them.
+ */
+int fcb_getnth(struct fcb *fcb, u32_t n, struct fcb_entry *loc);
+
 /*
  * Clears FCB passed to it
  */
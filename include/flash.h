@@ -270,6 +270,73 @@ static inline size_t z_impl_flash_get_write_block_size(struct device *dev)
 	return api->write_block_size;
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+/**
+ * @brief Type of a queued flash operation
+ */
+enum flash_async_type {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+struct flash_async_op;
+
+/**
+ * @brief Completion callback of a queued flash operation
+ *
+ * Called from the flash async thread once the operation is done. The
+ * operation may be submitted again from the callback.
+ *
+ * @param dev    flash device
+ * @param op     completed operation
+ * @param result 0 on success, negative errno code on fail
+ */
+typedef void (*flash_async_cb_t)(struct device *dev,
+				 struct flash_async_op *op, int result);
+
+/**
+ * @brief Queued flash operation
+ *
+ * Zero initialized before its first use. Owned by the flash async thread
+ * from flash_async_submit() until its completion is reported, through the
+ * callback, the signal, or both.
+ */
+struct flash_async_op {
+	void *fifo_reserved;	/* 1st word reserved for use by fifo */
+	struct device *dev;
+	enum flash_async_type type;
+	off_t offset;		/* offset of the operation */
+	union {
+		void *dst;	/* destination of a read */
+		const void *src;	/* source of a write */
+	};
+	size_t len;		/* bytes to read or write, size to erase */
+	flash_async_cb_t cb;	/* completion callback, may be NULL */
+	struct k_poll_signal *signal; /* raised with the result, may be NULL */
+	int result;		/* -EINPROGRESS until the operation is done */
+};
+
+/**
+ *  @brief  Queue a flash operation
+ *
+ *  Operations are executed one after the other, in submission order, by
+ *  the flash async thread, which blocks in the driver instead of the
+ *  caller. As for the synchronous API, the write protection needs to be
+ *  disabled before write and erase operations are executed.
+ *
+ *  This function can be called from an ISR, but not from user mode.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : operation, type, offset, buffer, len, cb and
+ *                            signal filled in by the caller
+ *
+ *  @return  0 if queued, -EINVAL for an invalid operation type, -EBUSY if
+ *           the operation is already queued.
+ */
+int flash_async_submit(struct device *dev, struct flash_async_op *op);
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,8 +11,10 @@
 extern "C" {
 #endif
 
-#ifdef CONFIG_FILE_SYSTEM_NFFS
+#if defined(CONFIG_FILE_SYSTEM_NFFS)
 #define MAX_FILE_NAME 256
+#elif defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+#define MAX_FILE_NAME 255 /* LFS_NAME_MAX */
 #else /* FAT_FS */
 #define MAX_FILE_NAME 12 /* Uses 8.3 SFN */
 #endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_FS_LITTLEFS_H_
+#define ZEPHYR_INCLUDE_FS_LITTLEFS_H_
+
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <flash_map.h>
+
+#include <lfs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Littlefs instance, passed as fs_data of a struct fs_mount_t
+ *
+ * The storage_dev of the mount point is the flash area ID the file system
+ * lives in, cast to a pointer.
+ *
+ * The cache sizes in cfg are set per mount: read_size and prog_size,
+ * cache_size (a multiple of both, at most CONFIG_FS_LITTLEFS_CACHE_SIZE,
+ * the size of the cache of each open file) and lookahead_size (a multiple
+ * of 8). read_buffer and prog_buffer hold cache_size bytes and
+ * lookahead_buffer lookahead_size bytes. The block device callbacks and
+ * geometry are filled in at mount, block_size from the flash page layout
+ * and block_cycles from CONFIG_FS_LITTLEFS_BLOCK_CYCLES unless set.
+ */
+struct fs_littlefs {
+	struct lfs_config cfg;
+
+	/* fields filled at mount */
+	struct lfs lfs;
+	const struct flash_area *area;
+	struct k_mutex mutex;
+};
+
+/**
+ * @brief Define a littlefs instance with the given cache sizes
+ *
+ * @param name         Name of the struct fs_littlefs defined.
+ * @param read_sz      Minimum size of a read.
+ * @param prog_sz      Minimum size of a program.
+ * @param cache_sz     Size of the read, program and file caches.
+ * @param lookahead_sz Size of the lookahead buffer, in bytes.
+ */
+#define FS_LITTLEFS_DECLARE_CUSTOM_CONFIG(name, read_sz, prog_sz, cache_sz, \
+					  lookahead_sz)			    \
+	static u8_t __aligned(4) name ## _read_buffer[cache_sz];	    \
+	static u8_t __aligned(4) name ## _prog_buffer[cache_sz];	    \
+	static u32_t name ## _lookahead_buffer[(lookahead_sz) /		    \
+					      sizeof(u32_t)];		    \
+	static struct fs_littlefs name = {				    \
+		.cfg = {						    \
+			.read_size = (read_sz),				    \
+			.prog_size = (prog_sz),				    \
+			.cache_size = (cache_sz),			    \
+			.lookahead_size = (lookahead_sz),		    \
+			.read_buffer = name ## _read_buffer,		    \
+			.prog_buffer = name ## _prog_buffer,		    \
+			.lookahead_buffer = name ## _lookahead_buffer,	    \
+		},							    \
+	}
+
+/**
+ * @brief Define a littlefs instance with the cache sizes of the Kconfig
+ *
+ * @param name Name of the struct fs_littlefs defined.
+ */
+#define FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(name)			\
+	FS_LITTLEFS_DECLARE_CUSTOM_CONFIG(name,				\
+					  CONFIG_FS_LITTLEFS_READ_SIZE,	\
+					  CONFIG_FS_LITTLEFS_PROG_SIZE,	\
+					  CONFIG_FS_LITTLEFS_CACHE_SIZE, \
+					  CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_FS_LITTLEFS_H_ */
@@ -17,6 +17,8 @@
 #ifndef __INCLUDE_GNA__
 #define __INCLUDE_GNA__
 
+#include <errno.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -77,6 +79,24 @@ struct gna_inference_stats {
 	u32_t cycles_per_sec;
 };
 
+/**
+ * Counters of the inferences performed since the device was initialized
+ */
+struct gna_stats {
+	/** Inferences completed, successfully or not */
+	u32_t inferences;
+	/** Inferences completed with an error */
+	u32_t errors;
+	/** Hardware cycles spent in the inferences */
+	u64_t total_cycles;
+	/** Sum of the latencies from request to completion, in microseconds */
+	u64_t total_latency_us;
+	/** Longest latency from request to completion, in microseconds */
+	u32_t max_latency_us;
+	/** Most requests ever pending at once */
+	u32_t max_pending;
+};
+
 /**
  * Result of an inference operation
  */
@@ -111,12 +131,14 @@ typedef int (*gna_api_register)(struct device *dev,
 typedef int (*gna_api_deregister)(struct device *dev, void *model_handle);
 typedef int (*gna_api_infer)(struct device *dev, struct gna_inference_req *req,
 		gna_callback callback);
+typedef int (*gna_api_stats)(struct device *dev, struct gna_stats *stats);
 
 struct gna_driver_api {
 	gna_api_config		configure;
 	gna_api_register	register_model;
 	gna_api_deregister	deregister_model;
 	gna_api_infer		infer;
+	gna_api_stats		get_stats;
 };
 
 /**
@@ -127,7 +149,8 @@ struct gna_driver_api {
  * @brief Configure the GNA device.
  *
  * Configure the GNA device. The GNA device must be configured before
- * registering a model or performing inference
+ * registering a model or performing inference. It may be configured again
+ * while no inference is in progress, the registered models remain so.
  *
  * @param dev Pointer to the device structure for the driver instance.
  * @param cfg Device configuration information
@@ -147,6 +170,8 @@ static inline int gna_configure(struct device *dev, struct gna_config *cfg)
  *
  * Register a neural network model with the GNA device
  * A model needs to be registered before it can be used to perform inference
+ * Registering a model already registered returns the same handle, which
+ * must then be de-registered as many times as it was registered
  *
  * @param dev Pointer to the device structure for the driver instance.
  * @param model Information about the neural network model
@@ -189,6 +214,9 @@ static inline int gna_deregister_model(struct device *dev, void *model)
  * Make an inference request on a previously registered model with an of
  * input data vector
  * A callback is provided for notification of inference completion
+ * Requests made while the device is busy are queued, each starting as soon
+ * as the previous one completes. The input buffer must remain valid until
+ * the request completes.
  *
  * @param dev Pointer to the device structure for the driver instance.
  * @param req Information required to perform inference on a neural network
@@ -205,6 +233,26 @@ static inline int gna_infer(struct device *dev, struct gna_inference_req *req,
 	return api->infer(dev, req, callback);
 }
 
+/**
+ * @brief Get the inference counters of the GNA device
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param stats Filled with the counters
+ *
+ * @retval 0 If the counters are returned
+ * @retval -ENOTSUP If the driver does not keep counters
+ */
+static inline int gna_get_stats(struct device *dev, struct gna_stats *stats)
+{
+	const struct gna_driver_api *api = dev->driver_api;
+
+	if (api->get_stats == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->get_stats(dev, stats);
+}
+
 #ifdef __cplusplus
 }
 #endif
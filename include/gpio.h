@@ -109,6 +109,13 @@ typedef int (*gpio_disable_callback_t)(struct device *port,
 				       int access_op,
 				       u32_t pin);
 typedef u32_t (*gpio_api_get_pending_int)(struct device *dev);
+typedef int (*gpio_config_pins_t)(struct device *port, u32_t pins,
+				  int flags);
+typedef int (*gpio_port_set_masked_t)(struct device *port, u32_t mask,
+				      u32_t value);
+typedef int (*gpio_port_set_bits_t)(struct device *port, u32_t pins);
+typedef int (*gpio_port_clear_bits_t)(struct device *port, u32_t pins);
+typedef int (*gpio_port_toggle_bits_t)(struct device *port, u32_t pins);
 
 struct gpio_driver_api {
 	gpio_config_t config;
@@ -118,6 +125,11 @@ struct gpio_driver_api {
 	gpio_enable_callback_t enable_callback;
 	gpio_disable_callback_t disable_callback;
 	gpio_api_get_pending_int get_pending_int;
+	gpio_config_pins_t config_pins;
+	gpio_port_set_masked_t port_set_masked;
+	gpio_port_set_bits_t port_set_bits;
+	gpio_port_clear_bits_t port_clear_bits;
+	gpio_port_toggle_bits_t port_toggle_bits;
 };
 
 __syscall int gpio_config(struct device *port, int access_op, u32_t pin,
@@ -156,6 +168,148 @@ static inline int z_impl_gpio_read(struct device *port, int access_op,
 	return api->read(port, access_op, pin, value);
 }
 
+/**
+ * @brief Configure a set of pins of a port alike.
+ *
+ * Drivers without a batched implementation configure the pins one by one.
+ *
+ * @param port Pointer to device structure for the driver instance.
+ * @param pins Mask of the pins to configure, bit 0 is pin 0.
+ * @param flags Flags for pin configuration. IN/OUT, interrupt ...
+ * @return 0 if successful, negative errno code on failure.
+ */
+__syscall int gpio_pins_configure(struct device *port, u32_t pins, int flags);
+
+static inline int z_impl_gpio_pins_configure(struct device *port, u32_t pins,
+					    int flags)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+	u32_t pin;
+	int ret;
+
+	if (api->config_pins != NULL) {
+		return api->config_pins(port, pins, flags);
+	}
+
+	for (pin = 0U; pins != 0U; pin++, pins >>= 1) {
+		if ((pins & 1U) == 0U) {
+			continue;
+		}
+
+		ret = api->config(port, GPIO_ACCESS_BY_PIN, pin, flags);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write the output of a set of pins of a port.
+ *
+ * Drivers update all pins with a single register write where the hardware
+ * allows it, the other pins of the port are left untouched. Drivers
+ * without a port implementation write the pins one by one.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param mask Mask of the pins to write, bit 0 is pin 0.
+ * @param value Values of the pins, bits outside mask are ignored.
+ * @return 0 if successful, negative errno code on failure.
+ */
+__syscall int gpio_port_set_masked(struct device *port, u32_t mask,
+				   u32_t value);
+
+static inline int z_impl_gpio_port_set_masked(struct device *port, u32_t mask,
+					     u32_t value)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+	u32_t pin;
+	int ret;
+
+	if (api->port_set_masked != NULL) {
+		return api->port_set_masked(port, mask, value);
+	}
+
+	for (pin = 0U; mask != 0U; pin++, mask >>= 1, value >>= 1) {
+		if ((mask & 1U) == 0U) {
+			continue;
+		}
+
+		ret = api->write(port, GPIO_ACCESS_BY_PIN, pin, value & 1U);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Set the output of a set of pins of a port to 1.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param pins Mask of the pins to set.
+ * @return 0 if successful, negative errno code on failure.
+ */
+__syscall int gpio_port_set_bits(struct device *port, u32_t pins);
+
+static inline int z_impl_gpio_port_set_bits(struct device *port, u32_t pins)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_set_bits != NULL) {
+		return api->port_set_bits(port, pins);
+	}
+
+	return z_impl_gpio_port_set_masked(port, pins, pins);
+}
+
+/**
+ * @brief Set the output of a set of pins of a port to 0.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param pins Mask of the pins to clear.
+ * @return 0 if successful, negative errno code on failure.
+ */
+__syscall int gpio_port_clear_bits(struct device *port, u32_t pins);
+
+static inline int z_impl_gpio_port_clear_bits(struct device *port, u32_t pins)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_clear_bits != NULL) {
+		return api->port_clear_bits(port, pins);
+	}
+
+	return z_impl_gpio_port_set_masked(port, pins, 0);
+}
+
+/**
+ * @brief Invert the output of a set of pins of a port.
+ *
+ * @param port Pointer to the device structure for the driver instance.
+ * @param pins Mask of the pins to toggle.
+ * @return 0 if successful, -ENOTSUP if the driver does not support it.
+ */
+__syscall int gpio_port_toggle_bits(struct device *port, u32_t pins);
+
+static inline int z_impl_gpio_port_toggle_bits(struct device *port, u32_t pins)
+{
+	const struct gpio_driver_api *api =
+		(const struct gpio_driver_api *)port->driver_api;
+
+	if (api->port_toggle_bits == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->port_toggle_bits(port, pins);
+}
+
 __syscall int gpio_enable_callback(struct device *port, int access_op,
 				   u32_t pin);
 
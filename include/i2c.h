@@ -21,6 +21,9 @@
 
 #include <zephyr/types.h>
 #include <device.h>
+#ifdef CONFIG_I2C_ASYNC
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -121,6 +124,56 @@ struct i2c_msg {
 	u8_t		flags;
 };
 
+#ifdef CONFIG_I2C_ASYNC
+struct i2c_transaction;
+
+/**
+ * @typedef i2c_callback_t
+ * @brief Completion callback of an asynchronous transfer.
+ *
+ * May be called from interrupt context. The transaction may be reused or
+ * submitted again from the callback.
+ *
+ * @param dev Pointer to the I2C bus device.
+ * @param t The completed transaction.
+ * @param result 0 if successful, negative errno code otherwise.
+ */
+typedef void (*i2c_callback_t)(struct device *dev, struct i2c_transaction *t,
+			       int result);
+
+/**
+ * @brief One asynchronous I2C transaction.
+ *
+ * A list of messages transferred to one target device, queued on its bus
+ * with i2c_transfer_async().
+ */
+struct i2c_transaction {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	struct k_work work;
+	struct device *dev;
+	/** @endcond */
+
+	/** Messages, must remain valid until completion */
+	struct i2c_msg *msgs;
+
+	/** Number of messages */
+	u8_t num_msgs;
+
+	/** Address of the I2C target device */
+	u16_t addr;
+
+	/** Completion callback, or NULL */
+	i2c_callback_t callback;
+
+	/** Signal raised with the result on completion, or NULL */
+	struct k_poll_signal *signal;
+
+	/** Argument for the callback */
+	void *user_data;
+};
+#endif /* CONFIG_I2C_ASYNC */
+
 /**
  * @cond INTERNAL_HIDDEN
  *
@@ -173,12 +226,19 @@ typedef int (*i2c_api_slave_register_t)(struct device *dev,
 					struct i2c_slave_config *cfg);
 typedef int (*i2c_api_slave_unregister_t)(struct device *dev,
 					  struct i2c_slave_config *cfg);
+#ifdef CONFIG_I2C_ASYNC
+typedef int (*i2c_api_transfer_async_t)(struct device *dev,
+					struct i2c_transaction *t);
+#endif
 
 struct i2c_driver_api {
 	i2c_api_configure_t configure;
 	i2c_api_full_io_t transfer;
 	i2c_api_slave_register_t slave_register;
 	i2c_api_slave_unregister_t slave_unregister;
+#ifdef CONFIG_I2C_ASYNC
+	i2c_api_transfer_async_t transfer_async;
+#endif
 };
 
 typedef int (*i2c_slave_api_register_t)(struct device *dev);
@@ -252,6 +312,53 @@ static inline int z_impl_i2c_transfer(struct device *dev,
 	return api->transfer(dev, msgs, num_msgs, addr);
 }
 
+#ifdef CONFIG_I2C_ASYNC
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+int z_i2c_transfer_async_work(struct device *dev, struct i2c_transaction *t);
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Queue a data transfer to another I2C device.
+ *
+ * Note: This function is asynchronous.
+ *
+ * The transaction is appended to the queue of the bus and executed once the
+ * transactions queued before it have completed, then t->callback is called
+ * and t->signal is raised with the result.  Drivers with DMA support execute
+ * the messages of a transaction back-to-back from interrupt context, others
+ * execute i2c_transfer() from the system workqueue.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param t Transaction, must remain valid until completion.
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -EINVAL If the transaction holds no message.
+ * @retval -ENOTSUP If a message is not supported by the driver.
+ */
+static inline int i2c_transfer_async(struct device *dev,
+				     struct i2c_transaction *t)
+{
+	const struct i2c_driver_api *api =
+		(const struct i2c_driver_api *)dev->driver_api;
+
+	if (t->num_msgs == 0U) {
+		return -EINVAL;
+	}
+
+	t->dev = dev;
+
+	if (api->transfer_async == NULL) {
+		return z_i2c_transfer_async_work(dev, t);
+	}
+
+	return api->transfer_async(dev, t);
+}
+#endif /* CONFIG_I2C_ASYNC */
+
 /**
  * @brief Registers the provided config as Slave device
  *
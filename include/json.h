@@ -22,6 +22,7 @@
  */
 
 #include <misc/util.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <zephyr/types.h>
 #include <sys/types.h>
@@ -41,6 +42,8 @@ enum json_tokens {
 	JSON_TOK_COLON = ':',
 	JSON_TOK_COMMA = ',',
 	JSON_TOK_NUMBER = '0',
+	JSON_TOK_INT64 = 'L',
+	JSON_TOK_FLOAT = '.',
 	JSON_TOK_TRUE = 't',
 	JSON_TOK_FALSE = 'f',
 	JSON_TOK_NULL = 'n',
@@ -48,25 +51,30 @@ enum json_tokens {
 	JSON_TOK_EOF = '\0',
 };
 
+#define Z_ALIGN_SHIFT(type)	(__alignof__(type) == 1 ? 0 : \
+				 __alignof__(type) == 2 ? 1 : \
+				 __alignof__(type) == 4 ? 2 : 3)
+
 struct json_obj_descr {
 	const char *field_name;
 
-	/* Alignment can never be 0 or more than 4.  The macros to create a
-	 * struct json_obj_descr will subtract 1 from the result of
-	 * __alignof__() calls in order to keep this value in the 0-3 range
-	 * and thus use only 2 bits.  1 is added back when rounding it up to
+	/* Alignment can never be 0 or more than 8, the 64-bit numbers and
+	 * doubles being aligned to 8 bytes on most architectures.  The
+	 * macros to create a struct json_obj_descr store the log2 of the
+	 * result of __alignof__() calls, in the 0-3 range, to use only 2
+	 * bits.  The alignment is recovered when rounding it up to
 	 * calculate the struct size while parsing an array or object.
 	 */
-	u32_t alignment : 2;
+	u32_t align_shift : 2;
 
 	/* 127 characters is more than enough for a field name. */
 	u32_t field_name_len : 7;
 
 	/* Valid values here (enum json_tokens): JSON_TOK_STRING,
-	 * JSON_TOK_NUMBER, JSON_TOK_TRUE, JSON_TOK_FALSE,
-	 * JSON_TOK_OBJECT_START, JSON_TOK_LIST_START.  (All others
-	 * ignored.) Maximum value is '}' (125), so this has to be 7 bits
-	 * long.
+	 * JSON_TOK_NUMBER, JSON_TOK_INT64, JSON_TOK_FLOAT, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE, JSON_TOK_OBJECT_START, JSON_TOK_LIST_START.  (All
+	 * others ignored.) Maximum value is '}' (125), so this has to be 7
+	 * bits long.
 	 */
 	u32_t type : 7;
 
@@ -111,7 +119,8 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
  *
  * @param type_ Token type for JSON value corresponding to a primitive
  * type. Must be one of: JSON_TOK_STRING for strings, JSON_TOK_NUMBER
- * for numbers, JSON_TOK_TRUE (or JSON_TOK_FALSE) for booleans.
+ * for s32_t numbers, JSON_TOK_INT64 for s64_t numbers, JSON_TOK_FLOAT
+ * for double numbers, JSON_TOK_TRUE (or JSON_TOK_FALSE) for booleans.
  *
  * Here's an example of use:
  *
@@ -128,7 +137,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (#field_name_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.offset = offsetof(struct_, field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = type_, \
 	}
 
@@ -162,7 +171,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (#field_name_), \
 		.field_name_len = (sizeof(#field_name_) - 1), \
 		.offset = offsetof(struct_, field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = JSON_TOK_OBJECT_START, \
 		.object = { \
 			.sub_descr = sub_descr_, \
@@ -201,13 +210,13 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (#field_name_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.offset = offsetof(struct_, field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = JSON_TOK_LIST_START, \
 		.array = { \
 			.element_descr = &(struct json_obj_descr) { \
 				.type = elem_type_, \
 				.offset = offsetof(struct_, len_field_), \
-				.alignment = __alignof__(struct_) - 1, \
+				.align_shift = Z_ALIGN_SHIFT(struct_), \
 			}, \
 			.n_elements = (max_len_), \
 		}, \
@@ -258,7 +267,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (#field_name_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.offset = offsetof(struct_, field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = JSON_TOK_LIST_START, \
 		.array = { \
 			.element_descr = &(struct json_obj_descr) { \
@@ -268,7 +277,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 					.sub_descr_len = elem_descr_len_, \
 				}, \
 				.offset = offsetof(struct_, len_field_), \
-				.alignment = __alignof__(struct_) - 1, \
+				.align_shift = Z_ALIGN_SHIFT(struct_), \
 			}, \
 			.n_elements = (max_len_), \
 		}, \
@@ -328,7 +337,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (#field_name_), \
 			.field_name_len = sizeof(#field_name_) - 1, \
 			.offset = offsetof(struct_, field_name_), \
-			.alignment = __alignof__(struct_) - 1, \
+			.align_shift = Z_ALIGN_SHIFT(struct_), \
 			.type = JSON_TOK_LIST_START, \
 			.array = { \
 			.element_descr = &(struct json_obj_descr) { \
@@ -338,7 +347,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 					.sub_descr_len = elem_descr_len_, \
 				}, \
 				.offset = offsetof(struct_, len_field_), \
-				.alignment = __alignof__(struct_) - 1, \
+				.align_shift = Z_ALIGN_SHIFT(struct_), \
 			}, \
 			.n_elements = (max_len_), \
 		}, \
@@ -367,7 +376,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (json_field_name_), \
 		.field_name_len = sizeof(json_field_name_) - 1, \
 		.offset = offsetof(struct_, struct_field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = type_, \
 	}
 
@@ -393,7 +402,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (json_field_name_), \
 		.field_name_len = (sizeof(json_field_name_) - 1), \
 		.offset = offsetof(struct_, struct_field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = JSON_TOK_OBJECT_START, \
 		.object = { \
 			.sub_descr = sub_descr_, \
@@ -429,13 +438,13 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = (json_field_name_), \
 		.field_name_len = sizeof(json_field_name_) - 1, \
 		.offset = offsetof(struct_, struct_field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = JSON_TOK_LIST_START, \
 		.array = { \
 			.element_descr = &(struct json_obj_descr) { \
 				.type = elem_type_, \
 				.offset = offsetof(struct_, len_field_), \
-				.alignment = __alignof__(struct_) - 1, \
+				.align_shift = Z_ALIGN_SHIFT(struct_), \
 			}, \
 			.n_elements = (max_len_), \
 		}, \
@@ -495,7 +504,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		.field_name = json_field_name_, \
 		.field_name_len = sizeof(json_field_name_) - 1, \
 		.offset = offsetof(struct_, struct_field_name_), \
-		.alignment = __alignof__(struct_) - 1, \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.type = JSON_TOK_LIST_START, \
 		.element_descr = &(struct json_obj_descr) { \
 			.type = JSON_TOK_OBJECT_START, \
@@ -504,7 +513,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				.sub_descr_len = elem_descr_len_, \
 			}, \
 			.offset = offsetof(struct_, len_field_), \
-			.alignment = __alignof__(struct_) - 1, \
+			.align_shift = Z_ALIGN_SHIFT(struct_), \
 		}, \
 		.n_elements = (max_len_), \
 	}
@@ -526,7 +535,8 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
  * (1) strings are not unescaped (but only valid escape sequences are
  * accepted);
  * (2) no UTF-8 validation is performed; and
- * (3) only integer numbers are supported (no strtod() in the minimal libc).
+ * (3) numbers decoded as double are not always correctly rounded, the
+ * result may be off by a few units in the last place.
  *
  * @param json Pointer to JSON-encoded value to be parsed
  *
@@ -547,6 +557,192 @@ int json_obj_parse(char *json, size_t len,
 	const struct json_obj_descr *descr, size_t descr_len,
 	void *val);
 
+/**
+ * @brief Callbacks of the streaming JSON tokenizer
+ *
+ * Every callback is optional. Returning a negative value stops the
+ * tokenizer, the value is returned by json_stream_feed().
+ *
+ * Keys, strings and numbers are passed as their raw text, strings without
+ * the quotes and not unescaped. The text points into the chunk being fed
+ * when the token is contained in it, and into the token buffer given to
+ * json_stream_init() when it spans chunks; it is only valid during the
+ * callback.
+ */
+struct json_stream_cb {
+	int (*object_start)(void *user_data);
+	int (*object_end)(void *user_data);
+	int (*array_start)(void *user_data);
+	int (*array_end)(void *user_data);
+	int (*key)(const char *key, size_t len, void *user_data);
+	int (*string)(const char *str, size_t len, void *user_data);
+	int (*number)(const char *num, size_t len, void *user_data);
+	int (*boolean)(bool value, void *user_data);
+	int (*null)(void *user_data);
+};
+
+/**
+ * @brief Streaming JSON tokenizer
+ *
+ * The contents are private, the structure is declared so it can be
+ * allocated by the caller.
+ */
+struct json_stream {
+	const struct json_stream_cb *cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t buf_len;
+	const char *tok;
+	const char *literal;
+	/* bit n is set when nesting level n is an object */
+	u32_t nesting;
+	u8_t depth;
+	u8_t state;
+	u8_t pos;
+	bool key;
+};
+
+/* Object or array being decoded by struct json_stream_obj */
+struct json_stream_obj_frame {
+	/* Field descriptors of an object, element descriptor of an array */
+	const struct json_obj_descr *descr;
+	/* Number of field descriptors, maximum number of elements */
+	size_t descr_len;
+	/* Struct holding the fields, first element */
+	void *field;
+	/* Struct holding the number of elements of an array */
+	void *val;
+	/* Bitmap of decoded fields */
+	s32_t decoded;
+	/* Field of the value following the last key, -1 if not decoded */
+	s8_t key;
+	/* JSON_TOK_OBJECT_START or JSON_TOK_LIST_START */
+	u8_t type;
+};
+
+/**
+ * @brief Streaming decoder of a JSON object into a struct
+ *
+ * The contents are private, the structure is declared so it can be
+ * allocated by the caller.
+ */
+struct json_stream_obj {
+	struct json_stream stream;
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+	struct json_stream_obj_frame frames[CONFIG_JSON_STREAM_MAX_DEPTH];
+	u8_t depth;
+	/* Nesting level of the containers in a skipped value */
+	u8_t skip;
+	int ret;
+};
+
+/**
+ * @brief Initializes a streaming JSON tokenizer
+ *
+ * The tokenizer accepts a JSON value fed in chunks of any size and calls
+ * the callbacks as tokens complete. It does not recurse, containers can
+ * nest up to CONFIG_JSON_STREAM_MAX_DEPTH levels.
+ *
+ * @param stream Tokenizer to initialize
+ *
+ * @param cb Callbacks to call on each token
+ *
+ * @param user_data User-provided pointer passed to the callbacks
+ *
+ * @param buf Buffer holding a key, string or number spanning chunks
+ *
+ * @param buf_size Size of @a buf, the longest such token accepted
+ */
+void json_stream_init(struct json_stream *stream,
+		      const struct json_stream_cb *cb, void *user_data,
+		      char *buf, size_t buf_size);
+
+/**
+ * @brief Feeds the next chunk of the JSON value to the tokenizer
+ *
+ * @param stream Tokenizer
+ *
+ * @param data Chunk of JSON-encoded data
+ *
+ * @param len Length of the chunk
+ *
+ * @return 0 if the chunk has been consumed, -EINVAL on invalid JSON,
+ * -ENOMEM if a token spanning chunks does not fit in the token buffer,
+ * -E2BIG if the value is nested too deep, or the error returned by a
+ * callback. Once an error has been returned, all further calls fail.
+ */
+int json_stream_feed(struct json_stream *stream, const char *data,
+		     size_t len);
+
+/**
+ * @brief Signals the end of the JSON value to the tokenizer
+ *
+ * A number at the end of the value is only recognized as complete here.
+ *
+ * @param stream Tokenizer
+ *
+ * @return 0 if a complete JSON value has been fed, a negative value
+ * otherwise.
+ */
+int json_stream_finish(struct json_stream *stream);
+
+/**
+ * @brief Initializes the streaming decoder of an object
+ *
+ * Decodes an object like json_obj_parse(), from chunks fed with
+ * json_stream_obj_feed(). Keys not in the descriptor are skipped with
+ * their value, whatever its type, and a null value leaves the field
+ * undecoded. Decoded strings are stored in @a buf, which also holds the
+ * tokens spanning chunks.
+ *
+ * @param obj Decoder to initialize
+ *
+ * @param descr Pointer to the descriptor array
+ *
+ * @param descr_len Number of elements in the descriptor array, less than
+ * 31 as for json_obj_parse()
+ *
+ * @param val Pointer to the struct to hold the decoded values
+ *
+ * @param buf Buffer holding the decoded strings
+ *
+ * @param buf_size Size of @a buf
+ */
+void json_stream_obj_init(struct json_stream_obj *obj,
+			  const struct json_obj_descr *descr,
+			  size_t descr_len, void *val,
+			  char *buf, size_t buf_size);
+
+/**
+ * @brief Feeds the next chunk of the object to the decoder
+ *
+ * @param obj Decoder
+ *
+ * @param data Chunk of JSON-encoded data
+ *
+ * @param len Length of the chunk
+ *
+ * @return 0 if the chunk has been decoded, a negative value as returned
+ * by json_stream_feed() otherwise. -ENOMEM is also returned when a string
+ * does not fit anymore in the buffer and -ENOSPC when an array has more
+ * elements than its descriptor.
+ */
+int json_stream_obj_feed(struct json_stream_obj *obj, const char *data,
+			 size_t len);
+
+/**
+ * @brief Completes the decoding of an object
+ *
+ * @param obj Decoder
+ *
+ * @return < 0 if error, bitmap of decoded fields on success as returned
+ * by json_obj_parse().
+ */
+int json_stream_obj_finish(struct json_stream_obj *obj);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
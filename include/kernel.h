@@ -17,6 +17,9 @@
 #include <kernel_includes.h>
 #include <errno.h>
 #include <stdbool.h>
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+#include <stats.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -171,6 +174,17 @@ struct _k_object_assignment {
 	void * const *objects;
 };
 
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+/* Per-thread cache of kernel objects which passed validation, see
+ * z_object_handle_find()
+ */
+struct _k_object_handle {
+	void *obj;
+	struct _k_object *ko;
+	u32_t gen;
+};
+#endif
+
 /**
  * @brief Grant a static thread access to a list of kernel objects
  *
@@ -391,6 +405,32 @@ struct __thread_entry {
 #endif
 
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Constant bandwidth server state, see k_thread_reservation_set() */
+struct _cbs {
+	/* fires at the end of every period */
+	struct _timeout period_timeout;
+
+	/* reservation, in ticks; period is 0 when there is none */
+	s32_t period;
+	s32_t budget;
+	s32_t remaining;
+
+	/* one bit per period, LSB most recent, set if missed */
+	u32_t window;
+	u32_t periods;
+	u32_t missed;
+
+	/* budget / period, per mille */
+	u16_t util;
+
+	/* out of budget until the next period: a scheduling state of
+	 * its own, not affected by k_thread_suspend()/k_thread_resume()
+	 */
+	u8_t throttled;
+};
+#endif
+
 struct _thread_base {
 
 	/* this thread's entry in a ready/wait queue */
@@ -404,6 +444,11 @@ struct _thread_base {
 	 */
 	_wait_q_t *pended_on;
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	/* mutex the thread is waiting for, to walk inheritance chains */
+	struct k_mutex *pended_mutex;
+#endif
+
 	/* user facing 'thread options'; values defined in include/kernel.h */
 	u8_t user_options;
 
@@ -441,13 +486,19 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	struct _cbs cbs;
+#endif
+
 	u32_t order_key;
 
 #ifdef CONFIG_SMP
 	/* True for the per-CPU idle threads */
 	u8_t is_idle;
 
-	/* CPU index on which thread was last run */
+	/* CPU index on which thread was last run, or whose ready
+	 * queue holds it with CONFIG_SCHED_CPU_RUNQ
+	 */
 	u8_t cpu;
 
 	/* Recursive count of irq_lock() calls */
@@ -505,6 +556,20 @@ struct _thread_userspace_local_data {
 };
 #endif
 
+#if defined(CONFIG_TRACING_THREAD_STATS)
+/* Runtime statistics, in hardware cycles */
+struct _thread_runtime_stats {
+	/** cycles spent running, interrupts excluded */
+	u64_t cycles;
+	/** number of times switched in */
+	u32_t switches;
+	/** time the thread was made ready, 0 if not waiting to run */
+	u32_t ready_time;
+	/** longest time from ready to running */
+	u32_t latency_max;
+};
+#endif
+
 /**
  * @ingroup thread_apis
  * Thread Structure
@@ -566,6 +631,11 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_USERSPACE_OBJ_HANDLES)
+	/** kernel objects already validated for this thread */
+	struct _k_object_handle obj_handles[CONFIG_USERSPACE_OBJ_HANDLES_NUM];
+#endif
+
 #if defined(CONFIG_USE_SWITCH)
 	/* When using __switch() a few previously arch-specific items
 	 * become part of the core OS
@@ -580,6 +650,20 @@ struct k_thread {
 	/** resource pool */
 	struct k_mem_pool *resource_pool;
 
+#if defined(CONFIG_TRACING_THREAD_STATS)
+	/** runtime statistics */
+	struct _thread_runtime_stats rt_stats;
+#endif
+
+#if defined(CONFIG_EVENTS)
+	/** events waited for, then the events that satisfied the wait */
+	u32_t events;
+	/** K_EVENT_WAIT_* options of the wait */
+	u32_t event_options;
+	/** next thread woken by the same post */
+	struct k_thread *next_event_link;
+#endif
+
 	/** arch-specifics: must always be at the end */
 	struct _thread_arch arch;
 };
@@ -1053,6 +1137,79 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Deadline statistics of a thread reservation
+ */
+struct k_thread_reservation_stats {
+	/** Periods elapsed since the reservation was set */
+	u32_t periods;
+	/** Deadlines missed since the reservation was set */
+	u32_t missed;
+	/** Number of periods covered by recent_missed (at most 32) */
+	u32_t recent_periods;
+	/** Deadlines missed in the last recent_periods periods */
+	u32_t recent_missed;
+};
+
+/**
+ * @brief Give a thread a periodic CPU reservation
+ *
+ * Turns @a thread into a constant bandwidth server: at the start
+ * of every @a period its budget is refilled to @a budget and its
+ * scheduler deadline is set to the end of the period, so threads
+ * with reservations at the same static priority are scheduled
+ * earliest deadline first.  A thread that runs through its budget
+ * is throttled (not scheduled) until the next period begins.
+ * Throttling is independent of k_thread_suspend(): resuming a
+ * throttled thread doesn't let it run before its next period, and a
+ * thread suspended across the end of a period stays suspended.
+ *
+ * A deadline counts as missed when the thread is still runnable or
+ * throttled at the end of its period, i.e. it did not block waiting
+ * for its next job in time.
+ *
+ * The request is rejected if it would push the total reserved
+ * utilization above CONFIG_SCHED_DEADLINE_CBS_MAX_UTIL per CPU.
+ * Setting a reservation on a thread that already has one replaces
+ * it and resets its statistics.
+ *
+ * @param thread Thread to reserve CPU time for
+ * @param period Reservation period in milliseconds
+ * @param budget CPU time granted per period in milliseconds
+ *
+ * @retval 0 Reservation admitted
+ * @retval -EINVAL Invalid period or budget
+ * @retval -EBUSY Admission control rejected the reservation
+ */
+extern int k_thread_reservation_set(k_tid_t thread, s32_t period,
+				    s32_t budget);
+
+/**
+ * @brief Remove a thread's CPU reservation
+ *
+ * The thread keeps its static priority and is no longer throttled.
+ *
+ * @param thread Thread whose reservation to remove
+ *
+ * @retval 0 Reservation removed
+ * @retval -EINVAL Thread has no reservation
+ */
+extern int k_thread_reservation_clear(k_tid_t thread);
+
+/**
+ * @brief Read the deadline statistics of a thread reservation
+ *
+ * @param thread Thread with a reservation
+ * @param stats Filled with the statistics
+ *
+ * @retval 0 Statistics retrieved
+ * @retval -EINVAL Thread has no reservation
+ */
+extern int k_thread_reservation_stats_get(k_tid_t thread,
+				struct k_thread_reservation_stats *stats);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1362,6 +1519,27 @@ __syscall const char *k_thread_name_get(k_tid_t thread_id);
  */
 #define K_FOREVER (-1)
 
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+/**
+ * @brief Generate absolute timeout deadline from ticks.
+ *
+ * This macro generates a timeout that instructs a kernel API to wait
+ * until the system uptime reaches @a t ticks (see k_uptime_ticks()),
+ * rather than for a duration.  A periodic loop waiting on deadlines one
+ * period apart therefore does not drift, whatever the time it spends
+ * between waits.  Deadlines already passed do not wait.
+ *
+ * Only the low 30 bits of @a t are kept: the deadline must be less than
+ * 2^29 ticks away from the time it is waited on.
+ *
+ * @param t Deadline, in ticks of uptime.
+ *
+ * @return Timeout delay value.
+ */
+#define K_TIMEOUT_ABS_TICKS(t) \
+	((s32_t)(Z_TIMEOUT_ABS_FLAG | ((u32_t)(t) & Z_TIMEOUT_ABS_MASK)))
+#endif /* CONFIG_TIMEOUT_ABSOLUTE */
+
 /**
  * @}
  */
@@ -1506,6 +1684,37 @@ extern void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     s32_t duration, s32_t period);
 
+/**
+ * @brief Start a timer which may expire late.
+ *
+ * This routine works like k_timer_start(), but allows each expiry of the
+ * timer to be delayed by up to @a slack milliseconds so that it can be
+ * handled in the same system timer interrupt as other timeouts.  Without
+ * CONFIG_TIMEOUT_SLACK the slack is ignored.
+ *
+ * @param timer     Address of timer.
+ * @param duration  Initial timer duration (in milliseconds).
+ * @param period    Timer period (in milliseconds).
+ * @param slack     Tolerated expiry delay (in milliseconds).
+ *
+ * @return N/A
+ */
+__syscall void k_timer_start_slack(struct k_timer *timer, s32_t duration,
+				   s32_t period, s32_t slack);
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Get the number of timer interrupts saved by timeout slack.
+ *
+ * Counts the expiry ticks which were not programmed into the system
+ * timer because the timeouts due on them had enough slack to be handled
+ * together with a later one.
+ *
+ * @return Number of avoided timer interrupts since boot.
+ */
+extern u32_t k_timeout_slack_wakeups_avoided(void);
+#endif
+
 /**
  * @brief Stop a timer.
  *
@@ -1638,6 +1847,16 @@ static inline void *z_impl_k_timer_user_data_get(struct k_timer *timer)
  */
 __syscall s64_t k_uptime_get(void);
 
+/**
+ * @brief Get system uptime in ticks.
+ *
+ * This routine returns the elapsed time since the system booted, in
+ * ticks of the system clock, the unit of K_TIMEOUT_ABS_TICKS().
+ *
+ * @return Current uptime in ticks.
+ */
+__syscall s64_t k_uptime_ticks(void);
+
 /**
  * @brief Enable clock always on in tickless kernel
  *
@@ -1735,6 +1954,38 @@ static inline u32_t k_uptime_delta_32(s64_t *reftime)
  */
 #define k_cycle_get_32()	z_arch_k_cycle_get_32()
 
+extern u64_t z_timer_cycle_get_64(void);
+
+/**
+ * @brief Read the hardware clock as a 64-bit counter.
+ *
+ * This routine returns the same count as k_cycle_get_32() in its low 32
+ * bits, extended so that it does not wrap over the lifetime of the system.
+ * It is meant for the timestamps and the measures of long intervals, for
+ * which k_cycle_get_32() wraps too soon on fast clocks.
+ *
+ * @return Current hardware clock up-counter (in cycles).
+ */
+#define k_cycle_get_64()	z_timer_cycle_get_64()
+
+/**
+ * @brief Convert hardware clock cycles to nanoseconds.
+ *
+ * Unlike SYS_CLOCK_HW_CYCLES_TO_NS64(), does not overflow for the counts
+ * of k_cycle_get_64().
+ *
+ * @param cycles Count of hardware clock cycles.
+ *
+ * @return Nanoseconds, rounded down.
+ */
+static inline u64_t k_cycle_to_ns_64(u64_t cycles)
+{
+	u64_t hz = sys_clock_hw_cycles_per_sec();
+
+	return (cycles / hz) * NSEC_PER_SEC +
+	       (cycles % hz) * NSEC_PER_SEC / hz;
+}
+
 /**
  * @}
  */
@@ -1752,6 +2003,13 @@ struct k_queue {
 		_POLL_EVENT;
 	};
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* items appended without the lock, newest first */
+	void *pending;
+	/* threads in k_queue_get() that may block */
+	atomic_t waiters;
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_queue)
 };
 
@@ -1767,6 +2025,15 @@ struct k_queue {
 
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+extern void z_queue_drain(struct k_queue *queue);
+#else
+static inline void z_queue_drain(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -1941,6 +2208,23 @@ extern void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 __syscall void *k_queue_get(struct k_queue *queue, s32_t timeout);
 
+/**
+ * @brief Get all elements from a queue.
+ *
+ * This routine removes every data item from @a queue in one operation
+ * and returns them as a NULL-terminated singly-linked list in queue
+ * order, the first 32 bits of each item pointing to the next one.  It
+ * never blocks.  Must not be used on queues that are fed with
+ * k_queue_alloc_append() or k_queue_alloc_prepend().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param queue Address of the queue.
+ *
+ * @return Head of the list of data items, or NULL if the queue was empty.
+ */
+extern void *k_queue_get_all(struct k_queue *queue);
+
 /**
  * @brief Remove an element from a queue.
  *
@@ -1957,6 +2241,7 @@ __syscall void *k_queue_get(struct k_queue *queue, s32_t timeout);
  */
 static inline bool k_queue_remove(struct k_queue *queue, void *data)
 {
+	z_queue_drain(queue);
 	return sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 }
 
@@ -1978,6 +2263,7 @@ static inline bool k_queue_unique_append(struct k_queue *queue, void *data)
 {
 	sys_sfnode_t *test;
 
+	z_queue_drain(queue);
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			return false;
@@ -2005,6 +2291,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (__atomic_load_n(&queue->pending, __ATOMIC_RELAXED) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -2021,6 +2312,7 @@ __syscall void *k_queue_peek_head(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	z_queue_drain(queue);
 	return z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 }
 
@@ -2037,6 +2329,7 @@ __syscall void *k_queue_peek_tail(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	z_queue_drain(queue);
 	return z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 }
 
@@ -2206,6 +2499,22 @@ struct k_fifo {
 #define k_fifo_get(fifo, timeout) \
 	k_queue_get((struct k_queue *) fifo, timeout)
 
+/**
+ * @brief Get all elements from a FIFO queue.
+ *
+ * This routine removes every data item from @a fifo in one operation,
+ * see k_queue_get_all().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param fifo Address of the FIFO queue.
+ *
+ * @return Head of a NULL-terminated list of data items in FIFO order,
+ * or NULL if the FIFO was empty.
+ */
+#define k_fifo_get_all(fifo) \
+	k_queue_get_all((struct k_queue *) fifo)
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -2546,9 +2855,25 @@ typedef void (*k_work_handler_t)(struct k_work *work);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+/* Histogram of the delay between submission and execution of items */
+STATS_SECT_START(k_work_q_latency)
+STATS_SECT_ENTRY32(lt_10us)
+STATS_SECT_ENTRY32(lt_100us)
+STATS_SECT_ENTRY32(lt_1ms)
+STATS_SECT_ENTRY32(lt_10ms)
+STATS_SECT_ENTRY32(lt_100ms)
+STATS_SECT_ENTRY32(ge_100ms)
+STATS_SECT_ENTRY32(max_us)
+STATS_SECT_END;
+#endif
+
 struct k_work_q {
 	struct k_queue queue;
 	struct k_thread thread;
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+	STATS_SECT_DECL(k_work_q_latency) latency;
+#endif
 };
 
 enum {
@@ -2559,6 +2884,9 @@ struct k_work {
 	void *_reserved;		/* Used by k_queue implementation. */
 	k_work_handler_t handler;
 	atomic_t flags[1];
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+	u32_t submit_cycles;
+#endif
 };
 
 struct k_delayed_work {
@@ -2567,8 +2895,29 @@ struct k_delayed_work {
 	struct k_work_q *work_q;
 };
 
+struct k_work_pool {
+	/* All workers take their items from this queue, its thread is
+	 * the first worker
+	 */
+	struct k_work_q work_q;
+	struct k_thread *threads;
+	k_thread_stack_t *stacks;
+	size_t stack_len;
+	size_t stack_size;
+	u8_t num_threads;
+};
+
 extern struct k_work_q k_sys_work_q;
 
+static inline void z_work_submitted(struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+	work->submit_cycles = k_cycle_get_32();
+#else
+	ARG_UNUSED(work);
+#endif
+}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2639,6 +2988,7 @@ static inline void k_work_submit_to_queue(struct k_work_q *work_q,
 					  struct k_work *work)
 {
 	if (!atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+		z_work_submitted(work);
 		k_queue_append(&work_q->queue, work);
 	}
 }
@@ -2670,6 +3020,7 @@ static inline int k_work_submit_to_user_queue(struct k_work_q *work_q,
 	int ret = -EBUSY;
 
 	if (!atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+		z_work_submitted(work);
 		ret = k_queue_alloc_append(&work_q->queue, work);
 
 		/* Couldn't insert into the queue. Clear the pending bit
@@ -2746,6 +3097,94 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/**
+ * @brief Statically define a workqueue pool.
+ *
+ * Defines a workqueue pool with its worker threads and their stacks. The
+ * pool must be started with k_work_pool_start() before use.
+ *
+ * @param name Name of the workqueue pool.
+ * @param nthreads Number of worker threads, at least 1.
+ * @param stack_sz Stack size of each worker thread.
+ */
+#define K_WORK_POOL_DEFINE(name, nthreads, stack_sz) \
+	K_THREAD_STACK_ARRAY_DEFINE(_k_work_pool_stack_##name, \
+				    nthreads, stack_sz); \
+	static struct k_thread _k_work_pool_thread_##name \
+		[(nthreads) > 1 ? (nthreads) - 1 : 1]; \
+	struct k_work_pool name = { \
+		.threads = _k_work_pool_thread_##name, \
+		.stacks = _k_work_pool_stack_##name[0], \
+		.stack_len = K_THREAD_STACK_LEN(stack_sz), \
+		.stack_size = K_THREAD_STACK_SIZEOF( \
+			_k_work_pool_stack_##name[0]), \
+		.num_threads = nthreads, \
+	}
+
+/** Run each worker of a workqueue pool on its own CPU */
+#define K_WORK_POOL_PIN_CPU BIT(0)
+
+/**
+ * @brief Start a workqueue pool.
+ *
+ * This routine spawns the worker threads of @a pool. All of them process
+ * the items of the same queue: an item is taken by whichever worker is
+ * idle first, so one long item only stalls the worker running it. Items
+ * are submitted with k_work_submit_to_queue() and k_delayed_work_submit_to_queue()
+ * on the pool's @a work_q member, or with k_work_pool_submit(), with the
+ * usual semantics. Items submitted to a pool may run concurrently with
+ * each other, though a given item never runs on two workers at once
+ * unless it is resubmitted while running.
+ *
+ * With K_WORK_POOL_PIN_CPU and CONFIG_SCHED_CPU_MASK, worker N is
+ * restricted to CPU N modulo the number of CPUs.
+ *
+ * @param pool Address of the pool, defined with K_WORK_POOL_DEFINE().
+ * @param prio Priority of the worker threads.
+ * @param flags Zero or K_WORK_POOL_PIN_CPU.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_start(struct k_work_pool *pool, int prio,
+			      u32_t flags);
+
+/**
+ * @brief Submit a work item to a workqueue pool.
+ *
+ * Same as k_work_submit_to_queue() on the pool's workqueue.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param pool Address of workqueue pool.
+ * @param work Address of work item.
+ *
+ * @return N/A
+ */
+static inline void k_work_pool_submit(struct k_work_pool *pool,
+				      struct k_work *work)
+{
+	k_work_submit_to_queue(&pool->work_q, work);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+/**
+ * @brief Publish the latency histogram of a workqueue.
+ *
+ * Registers the submit-to-start latency histogram of @a work_q with the
+ * stats subsystem under @a name. Only workqueues running in supervisor
+ * mode record latencies.
+ *
+ * @param work_q Address of a started workqueue.
+ * @param name Name of the stats group, must stay valid.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+extern int k_work_q_latency_stats_register(struct k_work_q *work_q,
+					   const char *name);
+#endif
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -2796,6 +3235,29 @@ extern int k_delayed_work_submit_to_queue(struct k_work_q *work_q,
 					  struct k_delayed_work *work,
 					  s32_t delay);
 
+/**
+ * @brief Submit a delayed work item which may be submitted late.
+ *
+ * This routine works like k_delayed_work_submit_to_queue(), but allows
+ * the countdown to complete up to @a slack milliseconds late so that it
+ * can be handled in the same system timer interrupt as other timeouts.
+ * Without CONFIG_TIMEOUT_SLACK the slack is ignored.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param work_q Address of workqueue.
+ * @param work Address of delayed work item.
+ * @param delay Delay before submitting the work item (in milliseconds).
+ * @param slack Tolerated extra delay (in milliseconds).
+ *
+ * @retval 0 Work item countdown started.
+ * @retval -EINVAL Work item is being processed or has completed its work.
+ * @retval -EADDRINUSE Work item is pending on a different workqueue.
+ */
+extern int k_delayed_work_submit_to_queue_slack(struct k_work_q *work_q,
+						struct k_delayed_work *work,
+						s32_t delay, s32_t slack);
+
 /**
  * @brief Cancel a delayed work item.
  *
@@ -2882,6 +3344,28 @@ static inline int k_delayed_work_submit(struct k_delayed_work *work,
 	return k_delayed_work_submit_to_queue(&k_sys_work_q, work, delay);
 }
 
+/**
+ * @brief Submit a delayed work item to the system workqueue, with slack.
+ *
+ * See k_delayed_work_submit_to_queue_slack().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param work Address of delayed work item.
+ * @param delay Delay before submitting the work item (in milliseconds).
+ * @param slack Tolerated extra delay (in milliseconds).
+ *
+ * @retval 0 Work item countdown started.
+ * @retval -EINVAL Work item is being processed or has completed its work.
+ * @retval -EADDRINUSE Work item is pending on a different workqueue.
+ */
+static inline int k_delayed_work_submit_slack(struct k_delayed_work *work,
+					      s32_t delay, s32_t slack)
+{
+	return k_delayed_work_submit_to_queue_slack(&k_sys_work_q, work,
+						    delay, slack);
+}
+
 /**
  * @brief Get time remaining before a delayed work gets scheduled.
  *
@@ -2906,6 +3390,19 @@ static inline s32_t k_delayed_work_remaining_get(struct k_delayed_work *work)
  * @{
  */
 
+/**
+ * Mutex contention statistics
+ * @ingroup mutex_apis
+ */
+struct k_mutex_stats {
+	/** Times the mutex was taken by a thread not already owning it */
+	u32_t acquisitions;
+	/** Acquisitions for which the thread had to wait */
+	u32_t contended;
+	/** Longest time the mutex was held, in hardware cycles */
+	u32_t max_hold_cycles;
+};
+
 /**
  * Mutex Structure
  * @ingroup mutex_apis
@@ -2917,6 +3414,11 @@ struct k_mutex {
 	u32_t lock_count;
 	int owner_orig_prio;
 
+#ifdef CONFIG_MUTEX_STATS
+	struct k_mutex_stats stats;
+	u32_t hold_start;
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mutex)
 };
 
@@ -3005,6 +3507,32 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, s32_t timeout);
  */
 __syscall void k_mutex_unlock(struct k_mutex *mutex);
 
+#ifdef CONFIG_MUTEX_STATS
+/**
+ * @brief Read the contention statistics of a mutex.
+ *
+ * Combined with the object tracing list of mutexes (see
+ * SYS_TRACING_HEAD()) this allows finding the most contended locks of a
+ * running system.
+ *
+ * @param mutex Address of the mutex.
+ * @param stats Filled with the statistics of @a mutex.
+ *
+ * @return N/A
+ */
+extern void k_mutex_stats_get(struct k_mutex *mutex,
+			      struct k_mutex_stats *stats);
+
+/**
+ * @brief Reset the contention statistics of a mutex.
+ *
+ * @param mutex Address of the mutex.
+ *
+ * @return N/A
+ */
+extern void k_mutex_stats_reset(struct k_mutex *mutex);
+#endif
+
 /**
  * @}
  */
@@ -3158,6 +3686,303 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+#ifdef CONFIG_EVENTS
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	struct k_spinlock lock;
+	u32_t events;
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0, \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/** Wait for any of the events, the default */
+#define K_EVENT_WAIT_ANY 0
+/** Wait for all the events */
+#define K_EVENT_WAIT_ALL BIT(0)
+/** Clear the waited events when the wait is satisfied */
+#define K_EVENT_WAIT_CLEAR BIT(1)
+
+/**
+ * @brief Initialize an event object.
+ *
+ * An event object holds a set of 32 events. Threads wait for any or all of
+ * some of them, and are woken directly by the post that satisfies their
+ * wait.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+extern void k_event_init(struct k_event *event);
+
+/**
+ * @brief Post events.
+ *
+ * Adds @a events to the events of @a event, and wakes the waiting threads
+ * whose wait is satisfied, in priority order. A woken thread that waited
+ * with K_EVENT_WAIT_CLEAR consumes its events before the next waiter is
+ * considered.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to post.
+ *
+ * @return The events of @a event once the woken threads consumed theirs.
+ */
+extern u32_t k_event_post(struct k_event *event, u32_t events);
+
+/**
+ * @brief Clear events.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to clear.
+ *
+ * @return The events of @a event before they were cleared.
+ */
+extern u32_t k_event_clear(struct k_event *event, u32_t events);
+
+/**
+ * @brief Wait for events.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Events to wait for, not 0.
+ * @param options K_EVENT_WAIT_ALL to wait for all of @a events rather than
+ *        any, and K_EVENT_WAIT_CLEAR to clear @a events once satisfied.
+ * @param timeout Waiting period, or one of the special values K_NO_WAIT
+ *        and K_FOREVER.
+ *
+ * @return The events of @a event that satisfied the wait, before they were
+ *         cleared, or 0 if the wait timed out.
+ */
+extern u32_t k_event_wait(struct k_event *event, u32_t events,
+			  u32_t options, s32_t timeout);
+
+/**
+ * @brief Get the events of an event object.
+ *
+ * @param event Address of the event object.
+ *
+ * @return The events of @a event.
+ */
+static inline u32_t k_event_get(struct k_event *event)
+{
+	return *(volatile u32_t *)&event->events;
+}
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	struct k_event name = Z_EVENT_INITIALIZER(name)
+
+/** @} */
+#endif /* CONFIG_EVENTS */
+
+#ifdef CONFIG_THREAD_POOL
+/**
+ * @defgroup thread_pool_apis Thread Pool APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/** Thread pool statistics */
+struct k_thread_pool_stats {
+	/** Threads spawned */
+	u32_t spawned;
+
+	/** Spawns that found no idle thread in time */
+	u32_t exhausted;
+
+	/** Threads running, or done but not joined yet */
+	u32_t busy;
+
+	/** Highest number of busy threads */
+	u32_t max_busy;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_thread_pool;
+
+struct k_thread_pool_worker {
+	struct k_thread thread;
+	struct k_thread_pool *pool;
+	sys_snode_t node;
+	struct k_sem start;
+	struct k_sem done;
+	atomic_t flags;
+	k_thread_entry_t entry;
+	void *p1;
+	void *p2;
+	void *p3;
+};
+
+struct k_thread_pool {
+	struct k_thread_pool_worker *workers;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	size_t stack_len;
+	int count;
+	struct k_spinlock lock;
+	sys_slist_t idle;
+	struct k_sem idle_count;
+	struct k_thread_pool_stats stats;
+};
+
+#define Z_THREAD_POOL_INITIALIZER(workers_, stacks_, count_, size_) \
+	{ \
+	.workers = workers_, \
+	.stacks = (k_thread_stack_t *)stacks_, \
+	.stack_size = size_, \
+	.stack_len = K_THREAD_STACK_LEN(size_), \
+	.count = count_, \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Start a thread pool.
+ *
+ * Creates all the threads of @a pool, which then wait to be spawned. Their
+ * stacks are set up once here, spawning a thread of the pool only hands it
+ * an entry point.
+ *
+ * @param pool Address of the thread pool, defined by K_THREAD_POOL_DEFINE().
+ * @param prio Priority of the threads while they are idle.
+ *
+ * @return N/A
+ */
+extern void k_thread_pool_start(struct k_thread_pool *pool, int prio);
+
+/**
+ * @brief Spawn a thread of a thread pool.
+ *
+ * An idle thread of @a pool runs @a entry, at priority @a prio. Once
+ * @a entry returns, the thread stays busy until it is joined, unless it
+ * was detached.
+ *
+ * The entry point must return rather than abort its thread, and must not
+ * leave the thread suspended or in a state the next entry point would not
+ * expect.
+ *
+ * @param pool Address of the thread pool.
+ * @param entry Thread entry function.
+ * @param p1 1st entry point parameter.
+ * @param p2 2nd entry point parameter.
+ * @param p3 3rd entry point parameter.
+ * @param prio Thread priority.
+ * @param timeout Waiting period for an idle thread, or one of the special
+ *        values K_NO_WAIT and K_FOREVER.
+ *
+ * @return ID of the thread, or NULL if no thread became idle in time.
+ */
+extern k_tid_t k_thread_pool_spawn(struct k_thread_pool *pool,
+				   k_thread_entry_t entry,
+				   void *p1, void *p2, void *p3,
+				   int prio, s32_t timeout);
+
+/**
+ * @brief Join a thread of a thread pool.
+ *
+ * Waits for the entry point of a spawned thread to return, then makes the
+ * thread idle again. A thread is joined only once.
+ *
+ * @param pool Address of the thread pool.
+ * @param thread ID of the thread, returned by k_thread_pool_spawn().
+ * @param timeout Waiting period, or one of the special values K_NO_WAIT
+ *        and K_FOREVER.
+ *
+ * @retval 0 Thread joined.
+ * @retval -EAGAIN Entry point still running after the waiting period.
+ * @retval -EINVAL Thread not busy, detached, or not of @a pool.
+ */
+extern int k_thread_pool_join(struct k_thread_pool *pool, k_tid_t thread,
+			      s32_t timeout);
+
+/**
+ * @brief Detach a thread of a thread pool.
+ *
+ * The thread becomes idle again as soon as its entry point returns, or at
+ * once if it already returned. It can no longer be joined.
+ *
+ * @param pool Address of the thread pool.
+ * @param thread ID of the thread, returned by k_thread_pool_spawn().
+ *
+ * @retval 0 Thread detached.
+ * @retval -EINVAL Thread not busy, already detached, or not of @a pool.
+ */
+extern int k_thread_pool_detach(struct k_thread_pool *pool, k_tid_t thread);
+
+/**
+ * @brief Get the statistics of a thread pool.
+ *
+ * @param pool Address of the thread pool.
+ * @param stats Filled with the statistics of @a pool.
+ *
+ * @return N/A
+ */
+extern void k_thread_pool_stats_get(struct k_thread_pool *pool,
+				    struct k_thread_pool_stats *stats);
+
+/**
+ * @brief Statically define a thread pool.
+ *
+ * The thread pool still has to be started with k_thread_pool_start(). It
+ * can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_thread_pool <name>; @endcode
+ *
+ * @param name Name of the thread pool.
+ * @param count Number of threads.
+ * @param stack_size Stack size of each thread, in bytes.
+ */
+#define K_THREAD_POOL_DEFINE(name, count, stack_size) \
+	K_THREAD_STACK_ARRAY_DEFINE(_k_thread_pool_stacks_##name, count, \
+				    stack_size); \
+	static struct k_thread_pool_worker \
+		_k_thread_pool_workers_##name[count]; \
+	struct k_thread_pool name = \
+		Z_THREAD_POOL_INITIALIZER(_k_thread_pool_workers_##name, \
+					  _k_thread_pool_stacks_##name, \
+					  count, stack_size)
+
+/** @} */
+#endif /* CONFIG_THREAD_POOL */
+
 /**
  * @defgroup msgq_apis Message Queue APIs
  * @ingroup kernel_apis
@@ -3332,6 +4157,58 @@ __syscall int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
  */
 __syscall int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a q, as if by as many calls to k_msgq_put(), in a
+ * single critical section: waiting receivers are handed messages first,
+ * then as many messages as fit are copied to the ring buffer, and the
+ * scheduler is invoked once. The routine only waits when not even one
+ * message can be sent.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Pointer to an array of messages.
+ * @param num_msgs Number of messages in @a data.
+ * @param timeout Waiting period to send at least one message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages sent (at least 1), or
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *q, const void *data,
+			      u32_t num_msgs, s32_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a q into @a data, in a "first in, first out" manner, as if by as many
+ * calls to k_msgq_get(), in a single critical section: messages are
+ * copied out of the ring buffer, the messages of waiting senders are
+ * moved into the freed space, and the scheduler is invoked once. The
+ * routine only waits when the queue is empty.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold up to @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive at least one message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages received (at least 1), or
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *q, void *data, u32_t num_msgs,
+			      s32_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -3469,9 +4346,26 @@ struct k_mbox_msg {
 #endif
 };
 
+/**
+ * @brief Asynchronous mailbox message descriptor
+ *
+ * Sends a message with k_mbox_async_msg_put() rather than one taken from
+ * the descriptors of CONFIG_NUM_MBOX_ASYNC_MSGS.
+ */
+struct k_mbox_async {
+	/** internal use only - dummy thread waiting on send */
+	struct _thread_base thread;
+	/** transmit message descriptor */
+	struct k_mbox_msg tx_msg;
+};
+
 struct k_mbox {
 	_wait_q_t tx_msg_queue;
 	_wait_q_t rx_msg_queue;
+#if (CONFIG_MBOX_TARGET_QUEUES > 0)
+	/* senders to a given thread, hashed on it */
+	_wait_q_t tx_target_queue[CONFIG_MBOX_TARGET_QUEUES];
+#endif
 	struct k_spinlock lock;
 
 	_OBJECT_TRACING_NEXT_PTR(k_mbox)
@@ -3562,6 +4456,26 @@ extern int k_mbox_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 extern void k_mbox_async_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 			     struct k_sem *sem);
 
+/**
+ * @brief Send a mailbox message asynchronously, from a given descriptor.
+ *
+ * This routine works as k_mbox_async_put(), but sends @a async rather than
+ * a copy of the message taken from the CONFIG_NUM_MBOX_ASYNC_MSGS
+ * descriptors, so it never waits for one of them to be free.
+ *
+ * @param mbox Address of the mailbox.
+ * @param async Address of the descriptor, whose tx_msg is set as for
+ *              k_mbox_async_put(). It must be left untouched until the
+ *              message has been received and processed.
+ * @param sem Address of a semaphore given once @a async can be reused, or
+ *            NULL if none is needed.
+ *
+ * @return N/A
+ */
+extern void k_mbox_async_msg_put(struct k_mbox *mbox,
+				 struct k_mbox_async *async,
+				 struct k_sem *sem);
+
 /**
  * @brief Receive a mailbox message.
  *
@@ -3659,6 +4573,11 @@ struct k_pipe {
 		_wait_q_t      writers; /**< Writer wait queue */
 	} wait_q;
 
+#ifdef CONFIG_PIPE_CLAIM
+	size_t         put_claimed;     /**< Bytes claimed by the writer */
+	size_t         get_claimed;     /**< Bytes claimed by the reader */
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_pipe)
 	u8_t	       flags;		/**< Flags */
 };
@@ -3823,20 +4742,133 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+#ifdef CONFIG_PIPE_CLAIM
+/**
+ * @brief Claim space in a pipe's buffer for writing in place.
+ *
+ * This routine provides the address and size of the largest contiguous
+ * free area of @a pipe's ring buffer, limited to @a size bytes, waiting
+ * for at least one byte to be free if needed. The data is written to
+ * that area and published to readers with k_pipe_put_finish().
+ *
+ * Readers using k_pipe_get() get the data copied once from the ring
+ * buffer, readers using k_pipe_get_claim() without any copy.
+ *
+ * Only one writer claim may be outstanding per pipe, and no other thread
+ * may write to the pipe until it is finished. Only available to
+ * supervisor threads, for pipes with a ring buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the start of the claimed space.
+ * @param size Maximum number of bytes to claim.
+ * @param claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for free space (in milliseconds), or one
+ *                of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space claimed, @a claimed is at least 1.
+ * @retval -EIO Returned without waiting; the buffer is full.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The pipe has no ring buffer.
+ */
+extern int k_pipe_put_claim(struct k_pipe *pipe, u8_t **data, size_t size,
+			    size_t *claimed, s32_t timeout);
+
+/**
+ * @brief Publish data written in place to a pipe.
+ *
+ * This routine makes the first @a size bytes of the area returned by
+ * k_pipe_put_claim() available to readers and ends the claim. Any waiting
+ * readers are served from the new data.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the number claimed.
+ *
+ * @retval 0 Data published.
+ * @retval -EINVAL @a size exceeds the claimed size.
+ */
+extern int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading in place.
+ *
+ * This routine provides the address and size of the largest contiguous
+ * area of data in @a pipe's ring buffer, limited to @a size bytes,
+ * waiting for at least one byte of data if needed. The data stays in the
+ * pipe until it is released with k_pipe_get_finish().
+ *
+ * Only one reader claim may be outstanding per pipe, and no other thread
+ * may read from the pipe until it is finished. Only available to
+ * supervisor threads, for pipes with a ring buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the start of the claimed data.
+ * @param size Maximum number of bytes to claim.
+ * @param claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for data (in milliseconds), or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data claimed, @a claimed is at least 1.
+ * @retval -EIO Returned without waiting; the buffer is empty.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The pipe has no ring buffer.
+ */
+extern int k_pipe_get_claim(struct k_pipe *pipe, u8_t **data, size_t size,
+			    size_t *claimed, s32_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe.
+ *
+ * This routine frees the first @a size bytes of the area returned by
+ * k_pipe_get_claim() and ends the claim. Any waiting writers are moved
+ * into the freed space.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the claimed size.
+ */
+extern int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+#endif /* CONFIG_PIPE_CLAIM */
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* per-CPU cache of free blocks, stolen from by other CPUs only when the
+ * slab runs out
+ */
+struct _mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	u32_t count;
+
+	/* statistics, see k_mem_slab_cache_stats_get() */
+	u32_t allocs;
+	u32_t hits;
+	u32_t refills;
+	u32_t flushes;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	u32_t num_blocks;
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+	/* blocks out of free_list, including the ones in CPU caches */
 	u32_t num_used;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* threads about to wait or waiting, frees bypass the caches */
+	atomic_t cache_waiters;
+	struct _mem_slab_cpu_cache cpu_cache[CONFIG_MP_NUM_CPUS];
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 };
 
@@ -3962,7 +4994,17 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	u32_t num_used = slab->num_used;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		num_used -= slab->cpu_cache[i].count;
+	}
+
+	return num_used;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -3978,9 +5020,38 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/**
+ * @brief Per-CPU cache statistics of a memory slab.
+ */
+struct k_mem_slab_cache_stats {
+	/** Blocks allocated */
+	u32_t allocs;
+	/** Allocations served from a CPU cache without refilling it */
+	u32_t hits;
+	/** Batches of blocks moved from the slab into a CPU cache */
+	u32_t refills;
+	/** Batches of blocks moved from a CPU cache back to the slab */
+	u32_t flushes;
+};
+
+/**
+ * @brief Get the per-CPU cache statistics of a memory slab.
+ *
+ * The counters of all CPUs are added up.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Filled with the statistics of @a slab.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				       struct k_mem_slab_cache_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -4162,6 +5233,10 @@ extern void *k_calloc(size_t nmemb, size_t size);
 struct _poller {
 	struct k_thread *thread;
 	volatile bool is_polling;
+#ifdef CONFIG_POLL_SET
+	/* poller is embedded in a struct k_poll_set */
+	bool is_set;
+#endif
 };
 
 /* private - types bit positions */
@@ -4457,6 +5532,97 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+#ifdef CONFIG_POLL_SET
+/* public - persistent poll set object */
+struct k_poll_set {
+	/* PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/* PRIVATE - DO NOT TOUCH */
+	struct _poller poller;
+
+	/* PRIVATE - events that fired since they were last collected */
+	sys_dlist_t ready;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is an alternative to k_poll() for threads that wait on the
+ * same, possibly large, group of events over and over.  Events are
+ * registered on their objects once, by k_poll_set_add(), and stay
+ * registered until k_poll_set_remove().  An object becoming available
+ * moves its event to the set's ready list, so k_poll_set_wait() only
+ * ever looks at events that fired.
+ *
+ * Events of a set only observe their objects: they never prevent a
+ * thread blocked in k_poll(), k_sem_take() or k_queue_get() from being
+ * woken up by the same object.
+ *
+ * @param set Address of the poll set.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized as for k_poll() and must not be
+ * part of another poll set or of an ongoing k_poll() call.  It belongs
+ * to @a set until it is removed with k_poll_set_remove().
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * This must be done before the event, or the object it refers to, goes
+ * out of scope.
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Events are level-triggered: an event is reported by every call for as
+ * long as its condition holds (semaphore count non-zero, queue not empty,
+ * signal raised), and is re-armed on its object once it does not.  A
+ * K_POLL_STATE_CANCELLED state is reported once.  The state field of a
+ * reported event holds the reason it is ready; it is reset by the kernel,
+ * so the caller does not need to clear it.
+ *
+ * When more than @a max events are ready, events that were reported are
+ * moved behind the ones that were not, so that all of them are reported
+ * in turn.
+ *
+ * Only one thread may wait on a given set at a time.
+ *
+ * @param set Address of the poll set.
+ * @param ready Array filled with the addresses of the ready events.
+ * @param max Number of entries in @a ready.
+ * @param timeout Waiting period in milliseconds, or one of the special
+ * values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of entries written to @a ready (at least one).
+ * @retval -EAGAIN No event became ready before the timeout expired.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready, int max,
+			   s32_t timeout);
+#endif /* CONFIG_POLL_SET */
+
 /**
  * @internal
  */
@@ -17,6 +17,7 @@
 
 #include <zephyr/types.h>
 #include <device.h>
+#include <errno.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +63,19 @@ typedef int (*led_api_update_rgb)(struct device *dev, struct led_rgb *pixels,
 typedef int (*led_api_update_channels)(struct device *dev, u8_t *channels,
 				       size_t num_channels);
 
+#ifdef CONFIG_LED_STRIP_ASYNC
+/**
+ * @typedef led_api_update_rgb_async
+ * @brief Callback API for updating an RGB LED strip without blocking
+ *
+ * @see led_strip_update_rgb_async() for argument descriptions.
+ */
+typedef int (*led_api_update_rgb_async)(struct device *dev,
+					struct led_rgb *pixels,
+					size_t num_pixels,
+					struct k_poll_signal *signal);
+#endif /* CONFIG_LED_STRIP_ASYNC */
+
 /**
  * @brief LED strip driver API
  *
@@ -70,6 +84,9 @@ typedef int (*led_api_update_channels)(struct device *dev, u8_t *channels,
 struct led_strip_driver_api {
 	led_api_update_rgb update_rgb;
 	led_api_update_channels update_channels;
+#ifdef CONFIG_LED_STRIP_ASYNC
+	led_api_update_rgb_async update_rgb_async;
+#endif
 };
 
 /**
@@ -122,6 +139,47 @@ static inline int led_strip_update_channels(struct device *dev,
 	return api->update_channels(dev, channels, num_channels);
 }
 
+#ifdef CONFIG_LED_STRIP_ASYNC
+/**
+ * @brief Start updating an LED strip made of RGB pixels
+ *
+ * This routine starts the transmission of the given pixels array to the
+ * strip, and returns without waiting for it to end. Drivers keep two
+ * frames, so that the next one can be prepared while the current one is
+ * being transmitted: a frame may be started while the previous one is in
+ * flight, and is then transmitted right after it.
+ *
+ * Whether @a pixels may be reused as soon as this routine returns, or
+ * only once the frame has been transmitted, depends on the driver: the
+ * drivers encoding the frame into a buffer of their own do not need it
+ * any longer.
+ *
+ * @param dev LED strip device
+ * @param pixels Array of pixel data
+ * @param num_pixels Length of pixels array
+ * @param signal Signal raised once the frame has been transmitted, with
+ *        its result, or NULL. It must not be reset before then.
+ * @return 0 on success, negative on error
+ * @retval -ENOTSUP if the driver cannot update the strip asynchronously
+ * @retval -EBUSY if two frames are already in flight
+ * @warning May overwrite @a pixels
+ */
+static inline int led_strip_update_rgb_async(struct device *dev,
+					     struct led_rgb *pixels,
+					     size_t num_pixels,
+					     struct k_poll_signal *signal)
+{
+	const struct led_strip_driver_api *api =
+		(const struct led_strip_driver_api *)dev->driver_api;
+
+	if (api->update_rgb_async == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->update_rgb_async(dev, pixels, num_pixels, signal);
+}
+#endif /* CONFIG_LED_STRIP_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
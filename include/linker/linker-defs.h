@@ -45,6 +45,23 @@
 #define DEVICE_BUSY_BITFIELD()
 #endif
 
+/*
+ * Space for storing per device "lazy initialization done" bitmap, in RAM as
+ * the device config structures may be in ROM.
+ */
+#ifdef CONFIG_DEVICE_INIT_LAZY
+#define DEV_LAZY_DONE_SZ \
+	((((__device_init_end - __device_init_start) / _DEVICE_STRUCT_SIZEOF \
+	   + 31) / 32) * 4)
+#define DEVICE_LAZY_DONE_BITFIELD()		\
+		FILL(0x00) ;			\
+		__device_lazy_done_start = .;	\
+		. = . + DEV_LAZY_DONE_SZ;	\
+		__device_lazy_done_end = .;
+#else
+#define DEVICE_LAZY_DONE_BITFIELD()
+#endif
+
 /*
  * generate a symbol to mark the start of the device initialization objects for
  * the specified level, then link all of those objects (sorted by priority);
@@ -70,6 +87,7 @@
 		DEVICE_INIT_LEVEL(APPLICATION)	\
 		__device_init_end = .;		\
 		DEVICE_BUSY_BITFIELD()		\
+		DEVICE_LAZY_DONE_BITFIELD()	\
 
 
 /* define a section for undefined device initialization levels */
@@ -239,6 +257,12 @@ extern char _nocache_ram_end[];
 extern char _nocache_ram_size[];
 #endif /* CONFIG_NOCACHE_MEMORY */
 
+/* Variables tagged '__lazy_bss', zeroed by the main thread. */
+#ifdef CONFIG_BSS_LAZY
+extern char _lazy_bss_start[];
+extern char _lazy_bss_end[];
+#endif /* CONFIG_BSS_LAZY */
+
 /* Memory owned by the kernel. Start and end will be aligned for memory
  * management/protection hardware for the target architecture.
  *
@@ -252,6 +276,12 @@ extern char _ramfunc_ram_size[];
 extern char _ramfunc_rom_start[];
 #endif /* CONFIG_ARCH_HAS_RAMFUNC_SUPPORT */
 
+/* The functions marked '__hotfunc' not placed in RAM. */
+#ifdef CONFIG_RAMFUNC_HOT_SECTIONS
+extern char _hottext_rom_start[];
+extern char _hottext_rom_end[];
+#endif /* CONFIG_RAMFUNC_HOT_SECTIONS */
+
 #endif /* ! _ASMLANGUAGE */
 
 #endif /* ZEPHYR_INCLUDE_LINKER_LINKER_DEFS_H_ */
@@ -33,6 +33,15 @@
 #define __nocache __in_section_unique(_NOCACHE_SECTION_NAME)
 #endif /* CONFIG_NOCACHE_MEMORY */
 
+/* Zeroed before the APPLICATION init level instead of at reset with
+ * CONFIG_BSS_LAZY, so not to be used by the earlier init levels.
+ */
+#if defined(CONFIG_BSS_LAZY)
+#define __lazy_bss __in_section_unique(_LAZY_BSS_SECTION_NAME)
+#else
+#define __lazy_bss
+#endif /* CONFIG_BSS_LAZY */
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* ZEPHYR_INCLUDE_LINKER_SECTION_TAGS_H_ */
@@ -67,6 +67,10 @@
 #define _NOCACHE_SECTION_NAME nocache
 #endif
 
+#ifdef CONFIG_BSS_LAZY
+#define _LAZY_BSS_SECTION_NAME lazy_bss
+#endif
+
 #include <linker/section_tags.h>
 
 #endif /* ZEPHYR_INCLUDE_LINKER_SECTIONS_H_ */
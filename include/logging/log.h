@@ -287,10 +287,27 @@ char *log_strdup(const char *str);
 #if !defined(CONFIG_LOG)
 #define _LOG_LEVEL_RESOLVE(...) LOG_LEVEL_NONE
 #else
-#define _LOG_LEVEL_RESOLVE(...) \
+#define Z_LOG_LEVEL_RESOLVE(...) \
 	Z_LOG_EVAL(LOG_LEVEL, \
 		  (GET_ARG2(__VA_ARGS__, LOG_LEVEL)), \
 		  (GET_ARG2(__VA_ARGS__, CONFIG_LOG_DEFAULT_LEVEL)))
+
+#ifdef CONFIG_LOG_STATIC_FILTERING
+/* Generated from CONFIG_LOG_STATIC_FILTER, defines LOG_STATIC_FILTER_<module>
+ * with the level of each module listed there.
+ */
+#include <log_static_filter.h>
+
+#define Z_LOG_STATIC_FILTER(_name) Z_LOG_STATIC_FILTER1(_name)
+#define Z_LOG_STATIC_FILTER1(_name) LOG_STATIC_FILTER_##_name
+
+/* Level from the static filter if the module is listed there. */
+#define _LOG_LEVEL_RESOLVE(...) \
+	Z_LOG_RESOLVED_LEVEL(Z_LOG_STATIC_FILTER(GET_ARG1(__VA_ARGS__)), \
+			     Z_LOG_LEVEL_RESOLVE(__VA_ARGS__))
+#else
+#define _LOG_LEVEL_RESOLVE(...) Z_LOG_LEVEL_RESOLVE(__VA_ARGS__)
+#endif
 #endif
 
 /* Return first argument */
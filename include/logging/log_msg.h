@@ -166,7 +166,21 @@ union log_msg_chunk {
 	struct log_msg_cont cont;
 };
 
+#ifdef CONFIG_LOG_MSG_RING
+/** @brief Size of a standard log message with nargs arguments stored in the
+ *	   message ring buffer, where the arguments directly follow the head.
+ */
+#define LOG_MSG_RING_STD_SIZE(nargs) \
+	(offsetof(struct log_msg, payload) + (nargs) * sizeof(u32_t))
+
+/** @brief Size of a hexdump log message with length bytes of data stored in
+ *	   the message ring buffer.
+ */
+#define LOG_MSG_RING_HEXDUMP_SIZE(length) \
+	(offsetof(struct log_msg, payload) + (length))
+#else
 extern struct k_mem_slab log_msg_pool;
+#endif
 
 /** @brief Function for initialization of the log message pool. */
 void log_msg_pool_init(void);
@@ -316,8 +330,25 @@ void log_msg_hexdump_data_get(struct log_msg *msg,
 
 union log_msg_chunk *log_msg_no_space_handle(void);
 
+#ifdef CONFIG_LOG_MSG_RING
+/** @brief Allocate a message of the given size from the message ring buffer.
+ *
+ *  @details When the buffer is full, the oldest messages are processed or
+ *	     new messages dropped depending on the log full strategy.
+ *
+ *  @param size Message size in bytes.
+ *
+ *  @return Allocated message or NULL.
+ */
+struct log_msg *log_msg_ring_alloc(size_t size);
+#endif
+
 static inline union log_msg_chunk *log_msg_chunk_alloc(void)
 {
+#ifdef CONFIG_LOG_MSG_RING
+	return (union log_msg_chunk *)
+		log_msg_ring_alloc(sizeof(union log_msg_chunk));
+#else
 	union log_msg_chunk *msg = NULL;
 	int err = k_mem_slab_alloc(&log_msg_pool, (void **)&msg, K_NO_WAIT);
 
@@ -326,16 +357,29 @@ static inline union log_msg_chunk *log_msg_chunk_alloc(void)
 	}
 
 	return msg;
+#endif
 }
 
-/** @brief Allocate chunk for standard log message.
+/** @brief Allocate standard log message for given number of arguments.
  *
- *  @return Allocated chunk of NULL.
+ *  @details With the message ring buffer only the space needed for the
+ *	     arguments is allocated, otherwise a whole chunk is.
+ *
+ *  @param nargs Number of arguments, up to LOG_MSG_NARGS_SINGLE_CHUNK unless
+ *		 the message ring buffer is used.
+ *
+ *  @return Allocated message or NULL.
  */
-static inline struct log_msg *z_log_msg_std_alloc(void)
+static inline struct log_msg *z_log_msg_std_alloc_n(u32_t nargs)
 {
+#ifdef CONFIG_LOG_MSG_RING
+	struct log_msg *msg = log_msg_ring_alloc(LOG_MSG_RING_STD_SIZE(nargs));
+#else
 	struct  log_msg *msg = (struct  log_msg *)log_msg_chunk_alloc();
 
+	ARG_UNUSED(nargs);
+#endif
+
 	if (msg != NULL) {
 		/* all fields reset to 0, reference counter to 1 */
 		msg->hdr.ref_cnt = 1;
@@ -346,6 +390,15 @@ static inline struct log_msg *z_log_msg_std_alloc(void)
 	return msg;
 }
 
+/** @brief Allocate chunk for standard log message.
+ *
+ *  @return Allocated chunk of NULL.
+ */
+static inline struct log_msg *z_log_msg_std_alloc(void)
+{
+	return z_log_msg_std_alloc_n(LOG_MSG_NARGS_SINGLE_CHUNK);
+}
+
 /** @brief Create standard log message with no arguments.
  *
  *  @details Function resets header and sets following fields:
@@ -356,7 +409,7 @@ static inline struct log_msg *z_log_msg_std_alloc(void)
  */
 static inline struct log_msg *log_msg_create_0(const char *str)
 {
-	struct log_msg *msg = z_log_msg_std_alloc();
+	struct log_msg *msg = z_log_msg_std_alloc_n(0);
 
 	if (msg != NULL) {
 		msg->str = str;
@@ -381,7 +434,7 @@ static inline struct log_msg *log_msg_create_0(const char *str)
 static inline struct log_msg *log_msg_create_1(const char *str,
 					       u32_t arg1)
 {
-	struct  log_msg *msg = z_log_msg_std_alloc();
+	struct  log_msg *msg = z_log_msg_std_alloc_n(1);
 
 	if (msg != NULL) {
 		msg->str = str;
@@ -410,7 +463,7 @@ static inline struct log_msg *log_msg_create_2(const char *str,
 					       u32_t arg1,
 					       u32_t arg2)
 {
-	struct  log_msg *msg = z_log_msg_std_alloc();
+	struct  log_msg *msg = z_log_msg_std_alloc_n(2);
 
 	if (msg != NULL) {
 		msg->str = str;
@@ -442,7 +495,7 @@ static inline struct log_msg *log_msg_create_3(const char *str,
 					       u32_t arg2,
 					       u32_t arg3)
 {
-	struct  log_msg *msg = z_log_msg_std_alloc();
+	struct  log_msg *msg = z_log_msg_std_alloc_n(3);
 
 	if (msg != NULL) {
 		msg->str = str;
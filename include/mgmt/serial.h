@@ -54,11 +54,25 @@
  * | ------------- | ------------- |
  * | Polynomial    | 0x1021        |
  * | Initial Value | 0             |
+ *
+ * ## Binary framing
+ *
+ * With CONFIG_MCUMGR_SMP_UART_BINARY, the UART transport sends each packet
+ * unencoded in a single frame instead, without the third of overhead of
+ * base64 and the newline of every 128 bytes:
+ *     offset 0:    0x05 0x0b
+ *     offset 2:    {16-bit frame-length}
+ *     offset 4:    {body}
+ *     offset ?:    {crc16}
+ *
+ * The frame length counts the body and the CRC. The receiver finds the
+ * next frame by its start byte pair after an invalid one.
  */
 
 #ifndef ZEPHYR_INCLUDE_MGMT_SERIAL_H_
 #define ZEPHYR_INCLUDE_MGMT_SERIAL_H_
 
+#include <stdbool.h>
 #include <zephyr/types.h>
 
 #ifdef __cplusplus
@@ -74,6 +88,23 @@ extern "C" {
 #define MCUMGR_SERIAL_HDR_FRAG_1    (MCUMGR_SERIAL_HDR_FRAG >> 8)
 #define MCUMGR_SERIAL_HDR_FRAG_2    (MCUMGR_SERIAL_HDR_FRAG & 0xff)
 
+#define MCUMGR_SERIAL_HDR_BIN       0x050b
+#define MCUMGR_SERIAL_HDR_BIN_1     (MCUMGR_SERIAL_HDR_BIN >> 8)
+#define MCUMGR_SERIAL_HDR_BIN_2     (MCUMGR_SERIAL_HDR_BIN & 0xff)
+#define MCUMGR_SERIAL_BIN_HDR_LEN   4
+
+/**
+ * @brief Tracks the frame boundaries of a binary serial stream.
+ */
+struct mcumgr_serial_bin_rx {
+	/* Start byte pair and length of the current frame. */
+	u8_t hdr[MCUMGR_SERIAL_BIN_HDR_LEN];
+	u8_t hdr_len;
+
+	/* Bytes of the current frame still to come, once its header is. */
+	u16_t rem;
+};
+
 /**
  * @brief Maintains state for an incoming mcumgr request packet.
  */
@@ -85,6 +116,11 @@ struct mcumgr_serial_rx_ctxt {
 
 	/* Length of full packet, as read from header. */
 	u16_t pkt_len;
+
+#ifdef CONFIG_MCUMGR_SMP_UART_BINARY
+	/* Framing state of a binary stream. */
+	struct mcumgr_serial_bin_rx bin;
+#endif
 };
 
 /** @typedef mcumgr_serial_tx_cb
@@ -134,6 +170,56 @@ struct net_buf *mcumgr_serial_process_frag(
 int mcumgr_serial_tx_pkt(const u8_t *data, int len, mcumgr_serial_tx_cb cb,
 			 void *arg);
 
+/**
+ * @brief Advances the framing of a binary serial stream by one byte.
+ *
+ * Does not keep the data: usable in the interrupt context, to find the end
+ * of the frames.
+ *
+ * @param bin                   The framing state of the stream.
+ * @param byte                  The received byte.
+ *
+ * @return                      true if the byte ends a frame;
+ *                              false otherwise.
+ */
+bool mcumgr_serial_bin_rx_byte(struct mcumgr_serial_bin_rx *bin, u8_t byte);
+
+/**
+ * @brief Processes received data of a binary serial stream.
+ *
+ * Processes the data until the end of a valid mcumgr request, which is then
+ * returned.  The remaining data is processed by calling the function again.
+ * It is the caller's responsibility to free the net_buf after it has been
+ * processed.
+ *
+ * @param rx_ctxt               The receive context of the serial transport.
+ * @param data                  The received data.
+ * @param len                   The length of the data, in bytes.
+ * @param out_used              On return, the number of bytes processed.
+ *
+ * @return                      A net_buf containing the request if a
+ *                                  complete and valid request has been
+ *                                  received.
+ *                              NULL if all the data was processed without
+ *                                  completing one.
+ */
+struct net_buf *mcumgr_serial_process_bin(
+	struct mcumgr_serial_rx_ctxt *rx_ctxt,
+	const u8_t *data, int len, int *out_used);
+
+/**
+ * @brief Transmits an mcumgr packet over serial in a binary frame.
+ *
+ * @param data                  The mcumgr packet data to send.
+ * @param len                   The length of the mcumgr packet.
+ * @param cb                    A callback used to transmit raw bytes.
+ * @param arg                   An optional argument to pass to the callback.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+int mcumgr_serial_tx_pkt_bin(const u8_t *data, int len,
+			     mcumgr_serial_tx_cb cb, void *arg);
+
 #ifdef __cplusplus
 }
 #endif
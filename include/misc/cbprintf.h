@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Formatted output through a character callback
+ *
+ * The formatting engine of printk() and of the log output. It supports the
+ * conversions documented for printk(), and formats arguments coming from a
+ * va_list, from a package or from an array of 32-bit words.
+ *
+ * A package is the format string followed by the arguments, each promoted
+ * as in a variadic call and copied without padding, so that the formatting
+ * can be done later and elsewhere. CBPRINTF_STATIC_PACKAGE() builds it from
+ * the types of the arguments, known at compile time, without parsing the
+ * format string. cbvprintf_package() builds it at runtime from a va_list.
+ *
+ * Strings passed for \%s are packaged by address: they must live until the
+ * package is formatted, see Z_CBPRINTF_STR_ARG_COUNT().
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_CBPRINTF_H_
+#define ZEPHYR_INCLUDE_MISC_CBPRINTF_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/types.h>
+#include <toolchain.h>
+#include <misc/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef cbprintf_cb
+ * @brief Character output callback
+ *
+ * @param c Character to output
+ * @param ctx Context passed to the formatting function
+ *
+ * @return The character, ignored.
+ */
+typedef int (*cbprintf_cb)(int c, void *ctx);
+
+/**
+ * @brief Format a string
+ *
+ * @param out Character output callback
+ * @param ctx Context passed to @a out
+ * @param fmt Format string, see printk()
+ *
+ * @return Number of characters output.
+ */
+__printf_like(3, 4) int cbprintf(cbprintf_cb out, void *ctx,
+				 const char *fmt, ...);
+
+/**
+ * @brief Format a string with a va_list
+ *
+ * @see cbprintf()
+ */
+__printf_like(3, 0) int cbvprintf(cbprintf_cb out, void *ctx,
+				  const char *fmt, va_list ap);
+
+/**
+ * @brief Format a package
+ *
+ * @param out Character output callback
+ * @param ctx Context passed to @a out
+ * @param package Package built by CBPRINTF_STATIC_PACKAGE() or
+ *        cbvprintf_package()
+ *
+ * @return Number of characters output.
+ */
+int cbpprintf(cbprintf_cb out, void *ctx, const void *package);
+
+/**
+ * @brief Package a format string and its arguments at runtime
+ *
+ * The format string is parsed to find the types of the arguments. Prefer
+ * CBPRINTF_STATIC_PACKAGE() when the arguments are known at compile time.
+ *
+ * @param packaged Buffer, or NULL to get the size of the package
+ * @param len Size of the buffer
+ * @param fmt Format string, see printk()
+ * @param ap Arguments
+ *
+ * @return Size of the package, -ENOSPC if the buffer is too small.
+ */
+__printf_like(3, 0) int cbvprintf_package(void *packaged, size_t len,
+					  const char *fmt, va_list ap);
+
+/**
+ * @brief Format arguments stored as 32-bit words
+ *
+ * Each conversion takes one word, whatever its length modifier, as in the
+ * messages of the logger. Missing arguments are taken as 0.
+ *
+ * @param out Character output callback
+ * @param ctx Context passed to @a out
+ * @param fmt Format string, see printk()
+ * @param args Arguments
+ * @param nargs Number of arguments
+ *
+ * @return Number of characters output.
+ */
+int z_cbprintf_words(cbprintf_cb out, void *ctx, const char *fmt,
+		     const u32_t *args, size_t nargs);
+
+#ifndef __cplusplus
+
+/*
+ * An argument promoted as in a variadic call, but for float: the integer
+ * promotions, and arrays decaying to pointers.
+ */
+#define Z_CBPRINTF_PROMOTE(v) (1 ? (v) : 0)
+
+#define Z_CBPRINTF_IS_FLOAT(v) _Generic((v), float : 1, default : 0)
+
+/**
+ * @brief Size of an argument in a package
+ */
+#define Z_CBPRINTF_ARG_SIZE(v) \
+	_Generic((v), float : sizeof(double), \
+		 default : sizeof(Z_CBPRINTF_PROMOTE(v)))
+
+/**
+ * @brief 1 if an argument is a character string, 0 otherwise
+ */
+#define Z_CBPRINTF_IS_STR(v) \
+	_Generic(Z_CBPRINTF_PROMOTE(v), \
+		 char * : 1, \
+		 const char * : 1, \
+		 volatile char * : 1, \
+		 const volatile char * : 1, \
+		 default : 0)
+
+#define Z_CBPRINTF_ARG_SIZE_PLUS(v) + Z_CBPRINTF_ARG_SIZE(v)
+#define Z_CBPRINTF_IS_STR_PLUS(v) + Z_CBPRINTF_IS_STR(v)
+
+/**
+ * @brief Number of arguments of a format string, a compile time constant
+ *
+ * @param ... Format string followed by its arguments
+ */
+#define Z_CBPRINTF_ARG_COUNT(...) NUM_VA_ARGS_LESS_1(__VA_ARGS__)
+
+/**
+ * @brief Number of character string arguments, a compile time constant
+ *
+ * A package of a format string with string arguments holds pointers to
+ * them, which a deferred user must copy if the strings may change.
+ *
+ * @param fmt Format string
+ * @param ... Arguments
+ */
+#define Z_CBPRINTF_STR_ARG_COUNT(fmt, ...) \
+	(0 MACRO_MAP(Z_CBPRINTF_IS_STR_PLUS, ##__VA_ARGS__))
+
+/**
+ * @brief Size of a package, a compile time constant
+ *
+ * @param fmt Format string
+ * @param ... Arguments
+ */
+#define CBPRINTF_STATIC_PACKAGE_SIZE(fmt, ...) \
+	(sizeof(const char *)						\
+	 MACRO_MAP(Z_CBPRINTF_ARG_SIZE_PLUS, ##__VA_ARGS__))
+
+#define Z_CBPRINTF_PACK_ARG(v)						\
+	{								\
+		__typeof__(Z_CBPRINTF_PROMOTE(v)) _v = (v);		\
+		double _d = _Generic(_v, float : _v, default : 0.0);	\
+									\
+		if (Z_CBPRINTF_IS_FLOAT(_v)) {				\
+			memcpy(_pos, &_d, sizeof(_d));			\
+		} else {						\
+			memcpy(_pos, &_v, sizeof(_v));			\
+		}							\
+		_pos += Z_CBPRINTF_ARG_SIZE(_v);			\
+	}
+
+/**
+ * @brief Package a format string and its arguments
+ *
+ * The layout of the package is computed at compile time from the types of
+ * the arguments, the format string is not parsed. Not available in C++.
+ *
+ * @param packaged Buffer, or NULL to get the size of the package
+ * @param inlen Size of the buffer
+ * @param outlen Variable set to the size of the package, -ENOSPC if the
+ *        buffer is too small
+ * @param fmt Format string, see printk()
+ * @param ... Arguments
+ */
+#define CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, fmt, ...)	\
+	do {								\
+		u8_t *_pos = (u8_t *)(packaged);			\
+		size_t _size =						\
+			CBPRINTF_STATIC_PACKAGE_SIZE(fmt, ##__VA_ARGS__); \
+									\
+		if (_pos == NULL) {					\
+			(outlen) = _size;				\
+		} else if (_size > (inlen)) {				\
+			(outlen) = -ENOSPC;				\
+		} else {						\
+			const char *_fmt = (fmt);			\
+									\
+			memcpy(_pos, &_fmt, sizeof(_fmt));		\
+			_pos += sizeof(_fmt);				\
+			MACRO_MAP(Z_CBPRINTF_PACK_ARG, ##__VA_ARGS__)	\
+			(outlen) = _size;				\
+		}							\
+	} while (false)
+
+#endif /* !__cplusplus */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_CBPRINTF_H_ */
@@ -100,6 +100,26 @@ void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err);
  */
 void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable);
 
+/**
+ * @brief Get underlying object pointer and vtable, holding a reference
+ *
+ * Lock-free. Until the reference is dropped with z_put_fd_obj(), the fd
+ * number is not reused, even if the fd is closed meanwhile.
+ *
+ * @param fd File descriptor previously returned by z_reserve_fd()
+ * @param vtable A pointer to a pointer variable to store the vtable
+ *
+ * @return Object pointer or NULL, with errno set
+ */
+void *z_get_fd_obj_ref(int fd, const struct fd_op_vtable **vtable);
+
+/**
+ * @brief Drop a reference taken with z_get_fd_obj_ref()
+ *
+ * @param fd File descriptor
+ */
+void z_put_fd_obj(int fd);
+
 /**
  * @brief Call ioctl vmethod on an object using varargs.
  *
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Fixed-capacity hash map
+ *
+ * An intrusive hash map with open addressing: the struct sys_hashmap_node
+ * handle is placed in the user's struct, and the map is an array of
+ * pointers to the nodes, provided with the map. Nothing is allocated.
+ *
+ * Collisions are resolved by linear probing, and removals shift the
+ * following nodes back instead of leaving tombstones, so lookups stay as
+ * fast after any number of removals. A lookup scans the slots from the
+ * home slot of the key to the first empty one, which is short as long as
+ * the map is kept at most three quarters full.
+ *
+ * The hash of the key is cached in the node, so the comparison callback
+ * only runs on nodes whose hash matches.
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_HASHMAP_H_
+#define ZEPHYR_INCLUDE_MISC_HASHMAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sys_hashmap_node {
+	u32_t hash;
+};
+
+/**
+ * @typedef sys_hashmap_hash_t
+ * @brief Hash function of the keys of a map
+ */
+typedef u32_t (*sys_hashmap_hash_t)(const void *key);
+
+/**
+ * @typedef sys_hashmap_eq_t
+ * @brief Key comparison predicate
+ *
+ * Returns true if the node, which is in the map, has the given key.
+ */
+typedef bool (*sys_hashmap_eq_t)(const struct sys_hashmap_node *node,
+				 const void *key);
+
+struct sys_hashmap {
+	struct sys_hashmap_node **slots;
+	/* number of slots, a power of two */
+	size_t capacity;
+	size_t size;
+	sys_hashmap_hash_t hash_fn;
+	sys_hashmap_eq_t eq_fn;
+};
+
+/**
+ * @brief Statically define and initialize a hash map
+ *
+ * @param name Name of the struct sys_hashmap
+ * @param capacity Number of slots, a power of two. The map holds up to
+ *        capacity - 1 nodes.
+ * @param hash Hash function of the keys
+ * @param eq Key comparison predicate
+ */
+#define SYS_HASHMAP_DEFINE(name, capacity, hash, eq)			\
+	BUILD_ASSERT_MSG(((capacity) & ((capacity) - 1)) == 0 &&	\
+			 (capacity) > 1,					\
+			 "hash map capacity must be a power of two");	\
+	static struct sys_hashmap_node *_CONCAT(name, _slots)[capacity]; \
+	struct sys_hashmap name = {					\
+		.slots = _CONCAT(name, _slots),				\
+		.capacity = (capacity),					\
+		.hash_fn = (hash),					\
+		.eq_fn = (eq),						\
+	}
+
+/**
+ * @brief Initialize a hash map
+ *
+ * @param map Map to initialize
+ * @param slots Array of @a capacity slot pointers, the storage of the map
+ * @param capacity Number of slots, a power of two. The map holds up to
+ *        capacity - 1 nodes.
+ * @param hash_fn Hash function of the keys
+ * @param eq_fn Key comparison predicate
+ */
+void sys_hashmap_init(struct sys_hashmap *map,
+		      struct sys_hashmap_node **slots, size_t capacity,
+		      sys_hashmap_hash_t hash_fn, sys_hashmap_eq_t eq_fn);
+
+/**
+ * @brief Insert a node
+ *
+ * @param map Map
+ * @param node Node to insert, not in any map
+ * @param key Key of the node
+ *
+ * @return 0 on success, -EEXIST if a node with the same key is in the map,
+ * -ENOSPC if the map is full.
+ */
+int sys_hashmap_insert(struct sys_hashmap *map, struct sys_hashmap_node *node,
+		       const void *key);
+
+/**
+ * @brief Look up the node of a key
+ *
+ * @return The node, NULL if the key is not in the map.
+ */
+struct sys_hashmap_node *sys_hashmap_get(const struct sys_hashmap *map,
+					 const void *key);
+
+/**
+ * @brief Remove a node
+ *
+ * @return true if the node was in the map, false otherwise.
+ */
+bool sys_hashmap_remove(struct sys_hashmap *map,
+			struct sys_hashmap_node *node);
+
+/**
+ * @brief Remove all nodes
+ */
+void sys_hashmap_clear(struct sys_hashmap *map);
+
+/**
+ * @brief Iterate over the nodes, in no particular order
+ *
+ * Start with *iter set to 0. The map must not be modified during the
+ * iteration.
+ *
+ * @return The next node, NULL after the last one.
+ */
+struct sys_hashmap_node *sys_hashmap_next(const struct sys_hashmap *map,
+					  size_t *iter);
+
+/**
+ * @brief Number of nodes in the map
+ */
+static inline size_t sys_hashmap_size(const struct sys_hashmap *map)
+{
+	return map->size;
+}
+
+/**
+ * @brief Returns true if no more nodes can be inserted
+ */
+static inline bool sys_hashmap_is_full(const struct sys_hashmap *map)
+{
+	return map->size == map->capacity - 1;
+}
+
+/**
+ * @brief Loop over the nodes of a map
+ *
+ * @param map A pointer to a struct sys_hashmap
+ * @param node The symbol name of a local struct sys_hashmap_node *
+ *             variable to use as the iterator
+ */
+#define SYS_HASHMAP_FOR_EACH(map, node)					\
+	for (size_t __i = 0; (node = sys_hashmap_next(map, &__i)) != NULL; \
+	     /**/)
+
+/**
+ * @brief FNV-1a hash of a buffer
+ */
+u32_t sys_hash32_fnv1a(const void *data, size_t len);
+
+/**
+ * @brief FNV-1a hash of a NUL-terminated string
+ */
+u32_t sys_hash32_str(const char *str);
+
+/**
+ * @brief Hash of a 32-bit integer
+ *
+ * The finalizer of MurmurHash3, mixing all bits of the value so that
+ * sequential identifiers spread over the table.
+ */
+static inline u32_t sys_hash32_u32(u32_t value)
+{
+	value ^= value >> 16;
+	value *= 0x85ebca6bU;
+	value ^= value >> 13;
+	value *= 0xc2b2ae35U;
+	value ^= value >> 16;
+
+	return value;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_HASHMAP_H_ */
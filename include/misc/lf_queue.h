@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free bounded queue
+ *
+ * A FIFO of pointers with a fixed, power of two capacity, safe to use
+ * concurrently from any number of producers and consumers (threads, ISRs
+ * or other CPUs) without any lock.  Each cell holds a sequence number
+ * telling whether it is ready to be written or read for a given position,
+ * so producers and consumers only contend on their own position counter
+ * with a compare-and-set.
+ *
+ * A producer or consumer interrupted between claiming a cell and
+ * completing it makes the cell look full or empty to others until it
+ * resumes; nobody ever waits for it.
+ *
+ * With CONFIG_ATOMIC_OPERATIONS_C the atomic operations themselves lock
+ * interrupts, so this only pays off on CPUs with native atomics.
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_LF_QUEUE_H_
+#define ZEPHYR_INCLUDE_MISC_LF_QUEUE_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <atomic.h>
+#include <toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sys_lf_queue_cell {
+	/* Sequence number minus the cell index, so that zeroed cells are
+	 * ready for the first lap
+	 */
+	atomic_t seq;
+	void *data;
+};
+
+struct sys_lf_queue {
+	atomic_t head;
+	atomic_t tail;
+	struct sys_lf_queue_cell *cells;
+	u32_t mask;
+};
+
+/**
+ * @brief Statically define and initialize a lock-free queue
+ *
+ * @param name Name of the queue
+ * @param n Capacity of the queue, a power of two
+ */
+#define SYS_LF_QUEUE_DEFINE(name, n)					\
+	BUILD_ASSERT_MSG(((n) & ((n) - 1)) == 0,			\
+			 "lock-free queue size must be a power of two"); \
+	static struct sys_lf_queue_cell _lf_queue_cells_##name[n];	\
+	struct sys_lf_queue name = {					\
+		.cells = _lf_queue_cells_##name,			\
+		.mask = (n) - 1,					\
+	}
+
+/**
+ * @brief Initialize a lock-free queue
+ *
+ * @param q Queue to initialize
+ * @param cells Array of @a n cells
+ * @param n Capacity of the queue, a power of two
+ */
+static inline void sys_lf_queue_init(struct sys_lf_queue *q,
+				     struct sys_lf_queue_cell *cells, u32_t n)
+{
+	u32_t i;
+
+	for (i = 0; i < n; i++) {
+		atomic_clear(&cells[i].seq);
+	}
+	atomic_clear(&q->head);
+	atomic_clear(&q->tail);
+	q->cells = cells;
+	q->mask = n - 1;
+}
+
+static inline u32_t z_lf_queue_seq(struct sys_lf_queue_cell *cell, u32_t idx)
+{
+	return (u32_t)atomic_get(&cell->seq) + idx;
+}
+
+/**
+ * @brief Append a value to a lock-free queue
+ *
+ * @param q Queue
+ * @param value Value to append
+ *
+ * @retval 0 on success
+ * @retval -ENOMEM if the queue is full
+ */
+static inline int sys_lf_queue_put(struct sys_lf_queue *q, void *value)
+{
+	struct sys_lf_queue_cell *cell;
+	u32_t pos, idx;
+	s32_t diff;
+
+	for (;;) {
+		pos = (u32_t)atomic_get(&q->tail);
+		idx = pos & q->mask;
+		cell = &q->cells[idx];
+		diff = (s32_t)(z_lf_queue_seq(cell, idx) - pos);
+
+		if (diff == 0) {
+			if (atomic_cas(&q->tail, pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return -ENOMEM;
+		}
+	}
+
+	cell->data = value;
+	atomic_set(&cell->seq, pos + 1 - idx);
+
+	return 0;
+}
+
+/**
+ * @brief Remove the oldest value from a lock-free queue
+ *
+ * @param q Queue
+ * @param value Where to store the value removed
+ *
+ * @retval 0 on success
+ * @retval -EAGAIN if the queue is empty
+ */
+static inline int sys_lf_queue_get(struct sys_lf_queue *q, void **value)
+{
+	struct sys_lf_queue_cell *cell;
+	u32_t pos, idx;
+	s32_t diff;
+
+	for (;;) {
+		pos = (u32_t)atomic_get(&q->head);
+		idx = pos & q->mask;
+		cell = &q->cells[idx];
+		diff = (s32_t)(z_lf_queue_seq(cell, idx) - (pos + 1));
+
+		if (diff == 0) {
+			if (atomic_cas(&q->head, pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return -EAGAIN;
+		}
+	}
+
+	*value = cell->data;
+	atomic_set(&cell->seq, pos + q->mask + 1 - idx);
+
+	return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_LF_QUEUE_H_ */
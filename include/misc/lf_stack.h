@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free bounded stack
+ *
+ * A stack of pointers with a fixed capacity, safe to use concurrently
+ * from threads, ISRs and other CPUs without any lock.  Values are kept
+ * in an array of slots; two lists of slot indices, the used slots (the
+ * stack itself) and the free slots, are updated with compare-and-set.
+ * Each list head holds a 16-bit modification tag next to the index, so a
+ * head popped and pushed back between the read and the compare-and-set
+ * of another context is noticed (the ABA problem).
+ *
+ * With CONFIG_ATOMIC_OPERATIONS_C the atomic operations themselves lock
+ * interrupts, so this only pays off on CPUs with native atomics.
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_LF_STACK_H_
+#define ZEPHYR_INCLUDE_MISC_LF_STACK_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* List head: tag in the upper half, index + 1 of the first slot in the
+ * lower half, 0 when empty
+ */
+#define Z_LF_TAG_INC	0x10000
+#define Z_LF_IDX_MASK	0xffff
+
+struct sys_lf_stack {
+	atomic_t used;
+	atomic_t free;
+	/* Slots never used yet, handed out before the free list exists */
+	atomic_t fresh;
+	/* Index + 1 of the next slot in the list, per slot */
+	u16_t *next;
+	void **data;
+	u16_t size;
+};
+
+/**
+ * @brief Statically define and initialize a lock-free stack
+ *
+ * @param name Name of the stack
+ * @param n Capacity of the stack, at most 65535
+ */
+#define SYS_LF_STACK_DEFINE(name, n)					\
+	static u16_t _lf_stack_next_##name[n];				\
+	static void *_lf_stack_data_##name[n];				\
+	struct sys_lf_stack name = {					\
+		.next = _lf_stack_next_##name,				\
+		.data = _lf_stack_data_##name,				\
+		.size = (n),						\
+	}
+
+/**
+ * @brief Initialize a lock-free stack
+ *
+ * @param s Stack to initialize
+ * @param next Array of @a n slot links
+ * @param data Array of @a n values
+ * @param n Capacity of the stack, at most 65535
+ */
+static inline void sys_lf_stack_init(struct sys_lf_stack *s, u16_t *next,
+				     void **data, u16_t n)
+{
+	atomic_clear(&s->used);
+	atomic_clear(&s->free);
+	atomic_clear(&s->fresh);
+	s->next = next;
+	s->data = data;
+	s->size = n;
+}
+
+static inline void z_lf_list_push(atomic_t *head, u16_t *next, u16_t idx)
+{
+	atomic_val_t old, new;
+
+	do {
+		old = atomic_get(head);
+		next[idx] = old & Z_LF_IDX_MASK;
+		new = ((old + Z_LF_TAG_INC) & ~Z_LF_IDX_MASK) | (idx + 1);
+	} while (!atomic_cas(head, old, new));
+}
+
+static inline bool z_lf_list_pop(atomic_t *head, u16_t *next, u16_t *idx)
+{
+	atomic_val_t old, new;
+	u16_t first;
+
+	do {
+		old = atomic_get(head);
+		first = old & Z_LF_IDX_MASK;
+		if (first == 0U) {
+			return false;
+		}
+		/* May read a link being rewritten if the slot was taken
+		 * meanwhile, the tag then makes the CAS fail
+		 */
+		new = ((old + Z_LF_TAG_INC) & ~Z_LF_IDX_MASK) |
+		      *(volatile u16_t *)&next[first - 1];
+	} while (!atomic_cas(head, old, new));
+
+	*idx = first - 1;
+	return true;
+}
+
+static inline bool z_lf_stack_slot_get(struct sys_lf_stack *s, u16_t *idx)
+{
+	atomic_val_t f;
+
+	if (z_lf_list_pop(&s->free, s->next, idx)) {
+		return true;
+	}
+
+	do {
+		f = atomic_get(&s->fresh);
+		if (f >= s->size) {
+			return false;
+		}
+	} while (!atomic_cas(&s->fresh, f, f + 1));
+
+	*idx = f;
+	return true;
+}
+
+/**
+ * @brief Push a value on a lock-free stack
+ *
+ * @param s Stack
+ * @param value Value to push
+ *
+ * @retval 0 on success
+ * @retval -ENOMEM if the stack is full
+ */
+static inline int sys_lf_stack_push(struct sys_lf_stack *s, void *value)
+{
+	u16_t idx;
+
+	if (!z_lf_stack_slot_get(s, &idx)) {
+		return -ENOMEM;
+	}
+
+	s->data[idx] = value;
+	z_lf_list_push(&s->used, s->next, idx);
+
+	return 0;
+}
+
+/**
+ * @brief Pop a value from a lock-free stack
+ *
+ * @param s Stack
+ * @param value Where to store the value popped
+ *
+ * @retval 0 on success
+ * @retval -EAGAIN if the stack is empty
+ */
+static inline int sys_lf_stack_pop(struct sys_lf_stack *s, void **value)
+{
+	u16_t idx;
+
+	if (!z_lf_list_pop(&s->used, s->next, &idx)) {
+		return -EAGAIN;
+	}
+
+	*value = s->data[idx];
+	z_lf_list_push(&s->free, s->next, idx);
+
+	return 0;
+}
+
+/**
+ * @brief Tell whether a lock-free stack is empty
+ *
+ * The answer may be stale by the time it is used, if other contexts use
+ * the stack concurrently.
+ *
+ * @param s Stack
+ * @return true if the stack holds no value
+ */
+static inline bool sys_lf_stack_is_empty(struct sys_lf_stack *s)
+{
+	return (atomic_get(&s->used) & Z_LF_IDX_MASK) == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_LF_STACK_H_ */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Fixed-capacity LRU cache
+ *
+ * A hash map of intrusive nodes, also linked in their order of use. The
+ * cache holds up to a fixed number of nodes and gives back the least
+ * recently used one to make room for a new entry, so the nodes can come
+ * from a static pool. Nothing is allocated.
+ *
+ * The hash and comparison callbacks of the map receive the struct
+ * sys_hashmap_node embedded in the struct sys_lru_node.
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_LRU_H_
+#define ZEPHYR_INCLUDE_MISC_LRU_H_
+
+#include <errno.h>
+#include <misc/dlist.h>
+#include <misc/hashmap.h>
+#include <misc/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sys_lru_node {
+	struct sys_hashmap_node hnode;
+	/* most recently used first */
+	sys_dnode_t lnode;
+};
+
+struct sys_lru {
+	struct sys_hashmap map;
+	sys_dlist_t list;
+	size_t max_entries;
+};
+
+/**
+ * @brief Initialize an LRU cache
+ *
+ * @param lru Cache to initialize
+ * @param slots Slots of the map, see sys_hashmap_init()
+ * @param capacity Number of slots, a power of two greater than
+ *        @a max_entries
+ * @param max_entries Maximum number of nodes in the cache
+ * @param hash_fn Hash function of the keys
+ * @param eq_fn Key comparison predicate
+ */
+static inline void sys_lru_init(struct sys_lru *lru,
+				struct sys_hashmap_node **slots,
+				size_t capacity, size_t max_entries,
+				sys_hashmap_hash_t hash_fn,
+				sys_hashmap_eq_t eq_fn)
+{
+	sys_hashmap_init(&lru->map, slots, capacity, hash_fn, eq_fn);
+	sys_dlist_init(&lru->list);
+	lru->max_entries = MIN(max_entries, capacity - 1);
+}
+
+/**
+ * @brief Look up a key, marking its node as the most recently used
+ *
+ * @return The node, NULL if the key is not cached.
+ */
+static inline struct sys_lru_node *sys_lru_get(struct sys_lru *lru,
+					       const void *key)
+{
+	struct sys_hashmap_node *hnode = sys_hashmap_get(&lru->map, key);
+	struct sys_lru_node *node;
+
+	if (!hnode) {
+		return NULL;
+	}
+
+	node = CONTAINER_OF(hnode, struct sys_lru_node, hnode);
+
+	if (!sys_dlist_is_head(&lru->list, &node->lnode)) {
+		sys_dlist_remove(&node->lnode);
+		sys_dlist_prepend(&lru->list, &node->lnode);
+	}
+
+	return node;
+}
+
+/**
+ * @brief Look up a key without changing the order of use
+ *
+ * @return The node, NULL if the key is not cached.
+ */
+static inline struct sys_lru_node *sys_lru_peek(const struct sys_lru *lru,
+						const void *key)
+{
+	struct sys_hashmap_node *hnode = sys_hashmap_get(&lru->map, key);
+
+	return hnode ? CONTAINER_OF(hnode, struct sys_lru_node, hnode) : NULL;
+}
+
+/**
+ * @brief Returns true if a node must be evicted before the next insertion
+ */
+static inline bool sys_lru_is_full(const struct sys_lru *lru)
+{
+	return sys_hashmap_size(&lru->map) >= lru->max_entries;
+}
+
+/**
+ * @brief Insert a node as the most recently used
+ *
+ * @param lru Cache
+ * @param node Node to insert, not in any cache
+ * @param key Key of the node
+ *
+ * @return 0 on success, -EEXIST if the key is cached, -ENOSPC if the cache
+ * is full, see sys_lru_evict().
+ */
+static inline int sys_lru_put(struct sys_lru *lru, struct sys_lru_node *node,
+			      const void *key)
+{
+	int ret;
+
+	if (sys_lru_is_full(lru)) {
+		return -ENOSPC;
+	}
+
+	ret = sys_hashmap_insert(&lru->map, &node->hnode, key);
+	if (ret < 0) {
+		return ret;
+	}
+
+	sys_dlist_prepend(&lru->list, &node->lnode);
+
+	return 0;
+}
+
+/**
+ * @brief Remove a node
+ */
+static inline void sys_lru_remove(struct sys_lru *lru,
+				  struct sys_lru_node *node)
+{
+	if (sys_hashmap_remove(&lru->map, &node->hnode)) {
+		sys_dlist_remove(&node->lnode);
+	}
+}
+
+/**
+ * @brief Remove the least recently used node
+ *
+ * @return The node, to be reused for a new entry, NULL if the cache is
+ * empty.
+ */
+static inline struct sys_lru_node *sys_lru_evict(struct sys_lru *lru)
+{
+	sys_dnode_t *lnode = sys_dlist_peek_tail(&lru->list);
+	struct sys_lru_node *node;
+
+	if (!lnode) {
+		return NULL;
+	}
+
+	node = CONTAINER_OF(lnode, struct sys_lru_node, lnode);
+	sys_lru_remove(lru, node);
+
+	return node;
+}
+
+/**
+ * @brief Remove all nodes
+ */
+static inline void sys_lru_clear(struct sys_lru *lru)
+{
+	sys_hashmap_clear(&lru->map);
+	sys_dlist_init(&lru->list);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_LRU_H_ */
@@ -38,6 +38,61 @@ struct sys_mem_pool_base {
 
 #define _ALIGN4(n) ((((n)+3)/4)*4)
 
+#ifdef CONFIG_SYS_MEM_POOL_TLSF
+
+/*
+ * With the TLSF backend the whole buffer is a single heap: there are no
+ * levels, and the area following the buffer holds the free list heads and
+ * bitmaps instead of the per-level bitfields.  Block sizes are rounded to
+ * 8 bytes; first level 0 covers the sizes below
+ * 2^(Z_TLSF_SMALL_SHIFT), then there is one first level per power of two.
+ */
+#define Z_TLSF_ALIGN_SHIFT	3
+#define Z_TLSF_SL_COUNT		(1 << CONFIG_SYS_MEM_POOL_TLSF_SL_BITS)
+#define Z_TLSF_SMALL_SHIFT	(CONFIG_SYS_MEM_POOL_TLSF_SL_BITS + \
+				 Z_TLSF_ALIGN_SHIFT)
+
+#define Z_TLSF_HAVE_FL(sz, l) (((sz) >> ((l) + Z_TLSF_SMALL_SHIFT)) != 0 ? 1 : 0)
+
+#define Z_TLSF_FL_COUNT(sz)		\
+	(1 +				\
+	Z_TLSF_HAVE_FL((sz), 0) +	\
+	Z_TLSF_HAVE_FL((sz), 1) +	\
+	Z_TLSF_HAVE_FL((sz), 2) +	\
+	Z_TLSF_HAVE_FL((sz), 3) +	\
+	Z_TLSF_HAVE_FL((sz), 4) +	\
+	Z_TLSF_HAVE_FL((sz), 5) +	\
+	Z_TLSF_HAVE_FL((sz), 6) +	\
+	Z_TLSF_HAVE_FL((sz), 7) +	\
+	Z_TLSF_HAVE_FL((sz), 8) +	\
+	Z_TLSF_HAVE_FL((sz), 9) +	\
+	Z_TLSF_HAVE_FL((sz), 10) +	\
+	Z_TLSF_HAVE_FL((sz), 11) +	\
+	Z_TLSF_HAVE_FL((sz), 12) +	\
+	Z_TLSF_HAVE_FL((sz), 13) +	\
+	Z_TLSF_HAVE_FL((sz), 14) +	\
+	Z_TLSF_HAVE_FL((sz), 15) +	\
+	Z_TLSF_HAVE_FL((sz), 16) +	\
+	Z_TLSF_HAVE_FL((sz), 17) +	\
+	Z_TLSF_HAVE_FL((sz), 18) +	\
+	Z_TLSF_HAVE_FL((sz), 19) +	\
+	Z_TLSF_HAVE_FL((sz), 20))
+
+/* Free list heads, then the first level bitmap and one second level
+ * bitmap per first level, plus room to align the heads
+ */
+#define Z_TLSF_CTRL_SIZE(sz)						\
+	(sizeof(void *) +						\
+	 sizeof(void *) * Z_TLSF_FL_COUNT(sz) * Z_TLSF_SL_COUNT +	\
+	 4 * (Z_TLSF_FL_COUNT(sz) + 1))
+
+#define Z_MPOOL_LVLS(maxsz, minsz) 1
+
+#define _MPOOL_BITS_SIZE(maxsz, minsz, n_max) \
+	Z_TLSF_CTRL_SIZE((maxsz) * (n_max))
+
+#else /* CONFIG_SYS_MEM_POOL_TLSF */
+
 #define Z_MPOOL_HAVE_LVL(maxsz, minsz, l) (((maxsz) >> (2*(l))) \
 					  >= (minsz) ? 1 : 0)
 
@@ -100,6 +155,8 @@ struct sys_mem_pool_base {
 	Z_MPOOL_LBIT_BYTES(maxsz, minsz, 14, n_max) +	\
 	Z_MPOOL_LBIT_BYTES(maxsz, minsz, 15, n_max))
 
+#endif /* CONFIG_SYS_MEM_POOL_TLSF */
+
 
 void z_sys_mem_pool_base_init(struct sys_mem_pool_base *p);
 
@@ -44,6 +44,7 @@
 #define ZEPHYR_INCLUDE_MISC_RB_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 
 struct rbnode {
 	struct rbnode *children[2];
@@ -75,6 +76,8 @@ typedef bool (*rb_lessthan_t)(struct rbnode *a, struct rbnode *b);
 
 struct rbtree {
 	struct rbnode *root;
+	/* leftmost node, maintained by insert and remove */
+	struct rbnode *min;
 	rb_lessthan_t lessthan_fn;
 	int max_depth;
 #ifdef CONFIG_MISRA_SANE
@@ -102,12 +105,26 @@ void rb_insert(struct rbtree *tree, struct rbnode *node);
  */
 void rb_remove(struct rbtree *tree, struct rbnode *node);
 
+/**
+ * @brief Build a tree from sorted nodes
+ *
+ * Replaces the contents of the tree with the nodes, in linear time. The
+ * nodes must be sorted per the lessthan callback of the tree.
+ *
+ * @param tree Tree, whose lessthan_fn is set
+ * @param nodes Array of the nodes, lowest-sorted first
+ * @param count Number of nodes
+ */
+void rb_build(struct rbtree *tree, struct rbnode **nodes, size_t count);
+
 /**
  * @brief Returns the lowest-sorted member of the tree
+ *
+ * The node is cached in the tree, this takes constant time.
  */
 static inline struct rbnode *rb_get_min(struct rbtree *tree)
 {
-	return z_rb_get_minmax(tree, 0);
+	return tree->min;
 }
 
 /**
@@ -118,6 +135,33 @@ static inline struct rbnode *rb_get_max(struct rbtree *tree)
 	return z_rb_get_minmax(tree, 1);
 }
 
+/**
+ * @brief Returns the member of the tree following a node
+ *
+ * The successor is found from the root by comparing against @a node, so
+ * no iteration state is kept and @a node need not be in the tree anymore:
+ * it is safe to remove the current node while iterating. Each step takes
+ * O(log2(N)). As for rb_remove(), nodes must not compare as equal.
+ *
+ * @param tree Tree
+ * @param node Current node, NULL to get the lowest-sorted member
+ *
+ * @return The next node, NULL after the highest-sorted member.
+ */
+struct rbnode *rb_next(struct rbtree *tree, struct rbnode *node);
+
+/**
+ * @brief Returns the member of the tree preceding a node
+ *
+ * The counterpart of rb_next(), with the same properties.
+ *
+ * @param tree Tree
+ * @param node Current node, NULL to get the highest-sorted member
+ *
+ * @return The previous node, NULL before the lowest-sorted member.
+ */
+struct rbnode *rb_prev(struct rbtree *tree, struct rbnode *node);
+
 /**
  * @brief Returns true if the given node is part of the tree
  *
@@ -180,7 +224,7 @@ struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f);
  * Note that the resulting loop is not safe against modifications to
  * the tree.  Changes to the tree structure during the loop will
  * produce incorrect results, as nodes may be skipped or duplicated.
- * Unlike linked lists, no _SAFE variant exists.
+ * See RB_FOR_EACH_SAFE for a loop tolerating them.
  *
  * Note also that the macro expands its arguments multiple times, so
  * they should not be expressions with side effects.
@@ -211,4 +255,19 @@ struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f);
 					 field) : NULL; }) != NULL;        \
 			 /**/)
 
+/**
+ * @brief Walk a tree in-order, without any stack
+ *
+ * As for RB_FOR_EACH(), but each step looks up the next node with
+ * rb_next(), in O(log2(N)) instead of amortized O(1).  In exchange no
+ * stack is allocated, whatever the depth of the tree, and the loop body
+ * may remove the current node or insert nodes.
+ *
+ * @param tree A pointer to a struct rbtree to walk
+ * @param node The symbol name of a local struct rbnode* variable to
+ *             use as the iterator
+ */
+#define RB_FOR_EACH_SAFE(tree, node) \
+	for (node = rb_get_min(tree); node != NULL; node = rb_next(tree, node))
+
 #endif /* ZEPHYR_INCLUDE_MISC_RB_H_ */
@@ -563,8 +563,28 @@ struct net_buf_pool {
 
 	/** Name of the pool. Used when printing pool information. */
 	const char *name;
+
+	/** Lowest amount of available buffers seen so far. */
+	s16_t min_avail_count;
+
+	/** Number of allocations which failed. */
+	u16_t alloc_failures;
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_POOL_GROUP)
+	/** Next pool of the group, NULL if the pool is not grouped. */
+	struct net_buf_pool *group_next;
+
+	/** Available buffers never lent to the other pools of the group. */
+	u16_t reserve;
+
+	/** Number of buffers taken from the other pools of the group. */
+	u16_t borrowed;
+
+	/** Number of buffers given to the other pools of the group. */
+	u16_t lent;
+#endif /* CONFIG_NET_BUF_POOL_GROUP */
+
 	/** Optional destroy callback when buffer is freed. */
 	void (*const destroy)(struct net_buf *buf);
 
@@ -585,6 +605,7 @@ struct net_buf_pool {
 		.buf_count = _count,                                         \
 		.uninit_count = _count,                                      \
 		.avail_count = _count,                                       \
+		.min_avail_count = _count,                                   \
 		.destroy = _destroy,                                         \
 		.name = STRINGIFY(_pool),                                    \
 	}
@@ -673,8 +694,29 @@ extern const struct net_buf_data_cb net_buf_fixed_cb;
  * @param _destroy   Optional destroy callback when buffer is freed.
  */
 #define NET_BUF_POOL_FIXED_DEFINE(_name, _count, _data_size, _destroy)        \
+	NET_BUF_POOL_FIXED_DEFINE_IN(_name, _count, _data_size, _destroy,     \
+				     __noinit)
+
+/**
+ * @def NET_BUF_POOL_FIXED_DEFINE_IN
+ * @brief Define a new pool for buffers based on fixed-size data, with the
+ * data placed with the given attribute
+ *
+ * Same as NET_BUF_POOL_FIXED_DEFINE(), but the data payload array of the
+ * buffers is declared with @a _data_attr, e.g. K_APP_BMEM() to place it in
+ * an application memory partition so that user mode threads can be given
+ * access to it.
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _data_size Maximum data payload per buffer.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ * @param _data_attr Attribute of the data payload array.
+ */
+#define NET_BUF_POOL_FIXED_DEFINE_IN(_name, _count, _data_size, _destroy,     \
+				     _data_attr)                              \
 	static struct net_buf net_buf_##_name[_count] __noinit;               \
-	static u8_t __noinit net_buf_data_##_name[_count][_data_size];        \
+	static u8_t _data_attr net_buf_data_##_name[_count][_data_size];      \
 	static const struct net_buf_pool_fixed net_buf_fixed_##_name = {      \
 		.data_size = _data_size,                                      \
 		.data_pool = (u8_t *)net_buf_data_##_name,                    \
@@ -761,6 +803,27 @@ extern const struct net_buf_data_cb net_buf_var_cb;
  */
 struct net_buf_pool *net_buf_pool_get(int id);
 
+#if defined(CONFIG_NET_BUF_POOL_GROUP)
+/**
+ * @brief Let a pool borrow buffers from other pools.
+ *
+ * Adds @a pool to the group of @a sibling. When a pool of a group has no
+ * free buffer, an allocation from it takes a buffer of another pool of
+ * the group which has more than its reserve of available buffers, before
+ * waiting. A borrowed buffer goes back to the pool it comes from when it
+ * is freed, and has the data size and destroy callback of that pool, so
+ * only pools with compatible buffers should be grouped.
+ *
+ * Meant to be called at init time, before the pools are used.
+ *
+ * @param pool Pool to add to the group.
+ * @param sibling Pool of the group, or alone so far.
+ * @param reserve Available buffers @a pool keeps for its own allocations.
+ */
+void net_buf_pool_join(struct net_buf_pool *pool,
+		       struct net_buf_pool *sibling, u16_t reserve);
+#endif /* CONFIG_NET_BUF_POOL_GROUP */
+
 /**
  * @brief Get a zero-based index for a buffer.
  *
@@ -199,6 +199,14 @@ struct coap_observer {
 /**
  * @brief Representation of a CoAP Packet.
  */
+/**
+ * @brief Position of an option in a parsed packet.
+ */
+struct coap_option_index {
+	u16_t num; /* Option number */
+	u16_t offset; /* Offset of the option header in the packet */
+};
+
 struct coap_packet {
 	u8_t *data; /* User allocated buffer */
 	u16_t offset; /* CoAP lib maintains offset while adding data */
@@ -206,6 +214,12 @@ struct coap_packet {
 	u8_t hdr_len; /* CoAP header length */
 	u16_t opt_len; /* Total options length (delta + len + value) */
 	u16_t delta; /* Used for delta calculation in CoAP packet */
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	/* Options of the packet, in order, set by coap_packet_parse() */
+	struct coap_option_index opt_index[CONFIG_COAP_OPTION_INDEX_SIZE];
+	u8_t opt_count; /* Number of options in opt_index */
+	bool opt_indexed; /* All the options are in opt_index */
+#endif
 };
 
 struct coap_option {
@@ -507,6 +521,74 @@ struct coap_block_context {
 	enum coap_block_size block_size;
 };
 
+/**
+ * @brief Block2 transfer with several blocks requested at once.
+ *
+ * The blocks of a resource are requested ahead, up to @a size of them
+ * (RFC 7959 section 2.5, with NSTART > 1). The blocks are delivered in
+ * order: a block received ahead of the next expected one is dropped and
+ * requested again.
+ */
+struct coap_block_window {
+	/** Block size, total size and offset of the next expected block */
+	struct coap_block_context ctx;
+	/** Offset of the next block to request */
+	size_t next;
+	/** Number of blocks requested ahead */
+	u8_t size;
+};
+
+/**
+ * @brief Initializes a window of block requests.
+ *
+ * @param win Window to be initialized
+ * @param block_size The size of the blocks requested
+ * @param size Number of blocks requested at once, once the total size is
+ * known. Until then, blocks are requested one at a time.
+ */
+void coap_block_window_init(struct coap_block_window *win,
+			    enum coap_block_size block_size, u8_t size);
+
+/**
+ * @brief Gets the next block to request.
+ *
+ * @param win Window of the transfer
+ * @param req Block context to append to the request with
+ * coap_append_block2_option()
+ *
+ * @return 0 if the block of @a req can be requested now, -EAGAIN if the
+ * window is full, -ENOENT if all the blocks were requested.
+ */
+int coap_block_window_next(struct coap_block_window *win,
+			   struct coap_block_context *req);
+
+/**
+ * @brief Processes the Block2 and Size2 options of a response.
+ *
+ * @param win Window of the transfer
+ * @param response Response received
+ * @param last Set to whether the block was the last one
+ *
+ * @return 0 if the payload of @a response is the next block of the
+ * resource, -EALREADY if it was already received, -EAGAIN if it was
+ * received ahead and dropped, -EINVAL if the block options are invalid.
+ */
+int coap_block_window_received(struct coap_block_window *win,
+			       const struct coap_packet *response,
+			       bool *last);
+
+/**
+ * @brief Requests again all the blocks not received yet.
+ *
+ * Used when a request timed out.
+ *
+ * @param win Window of the transfer
+ */
+static inline void coap_block_window_rewind(struct coap_block_window *win)
+{
+	win->next = win->ctx.current;
+}
+
 /**
  * @brief Initializes the context of a block-wise transfer.
  *
@@ -374,6 +374,50 @@ static inline int dns_cancel_addr_info(u16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @typedef dns_cache_cb_t
+ * @brief Callback used while iterating over the DNS cache entries.
+ *
+ * @param name Name that was resolved.
+ * @param type Query type of the entry.
+ * @param info Cached address, NULL if the entry records that the name
+ * has no address of this type (negative caching).
+ * @param ttl Remaining time to live of the entry, in seconds.
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*dns_cache_cb_t)(const char *name, enum dns_query_type type,
+			       const struct dns_addrinfo *info, u32_t ttl,
+			       void *user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Go through all the valid DNS cache entries.
+ *
+ * @details The callback is called once per cached address, or once for
+ * a negative entry.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ */
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove all the entries from the DNS cache, so that the next
+ * queries are sent to the DNS servers again.
+ */
+void dns_cache_flush(void);
+#else
+static inline void dns_cache_foreach(dns_cache_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+}
+
+static inline void dns_cache_flush(void)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @}
  */
@@ -125,6 +125,11 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload supported, TCP packets with a
+	 * net_pkt_tso_mss() are segmented and checksummed by the device
+	 */
+	ETHERNET_HW_TSO			= BIT(15),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -262,6 +267,14 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(struct device *dev, struct net_pkt *pkt);
+
+	/** Start the transmission of the packets queued by send. If set,
+	 * send only fills the TX descriptors of the packet without waiting
+	 * for it to be sent, and the IP stack calls this once it has handed
+	 * a burst of packets to send, so that a single doorbell is rung per
+	 * burst.
+	 */
+	void (*tx_flush)(struct device *dev);
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -652,6 +665,14 @@ void net_eth_carrier_on(struct net_if *iface);
  */
 void net_eth_carrier_off(struct net_if *iface);
 
+/**
+ * @brief Start the transmission of the packets the driver has queued.
+ * Called by the IP stack once a burst of packets has been sent.
+ *
+ * @param iface Network interface
+ */
+void net_eth_tx_flush(struct net_if *iface);
+
 /**
  * @brief Set promiscuous mode either ON or OFF.
  *
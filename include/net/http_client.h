@@ -0,0 +1,245 @@
+/** @file
+ * @brief HTTP client API
+ *
+ * An API for applications to send HTTP/1.1 requests over sockets.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_CLIENT_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_CLIENT_H_
+
+/**
+ * @brief HTTP client API
+ * @defgroup http_client HTTP client API
+ * @ingroup networking
+ * @{
+ */
+
+#include <kernel.h>
+#include <net/net_ip.h>
+#include <net/http_parser.h>
+#include <net/tls_credentials.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Is there more data to come */
+enum http_final_call {
+	HTTP_DATA_MORE = 0,  /**< More data will come */
+	HTTP_DATA_FINAL = 1, /**< End of the response */
+};
+
+struct http_response;
+
+/**
+ * @typedef http_response_cb_t
+ * @brief Callback used when data of the response is received.
+ *
+ * @details The body is not buffered: the callback is called for each
+ * fragment of the body as soon as it is received, with the chunked transfer
+ * encoding already removed. The fragment is only valid during the call.
+ *
+ * @param rsp Response, body_frag_start and body_frag_len describe the
+ * received fragment.
+ * @param final_data HTTP_DATA_FINAL once the whole response is received.
+ * @param user_data User data given in the request.
+ */
+typedef void (*http_response_cb_t)(struct http_response *rsp,
+				   enum http_final_call final_data,
+				   void *user_data);
+
+/**
+ * HTTP response, filled in while it is received.
+ */
+struct http_response {
+	/** Start of the received body fragment, NULL if none */
+	const u8_t *body_frag_start;
+
+	/** Length of the received body fragment */
+	size_t body_frag_len;
+
+	/** Value of the Content-Length header, 0 if absent */
+	size_t content_length;
+
+	/** Number of body bytes received so far */
+	size_t processed;
+
+	/** Numeric HTTP status code of the response, like 200 */
+	u16_t http_status_code;
+
+	/** Is the whole response received */
+	u8_t message_complete : 1;
+
+	/** Does the response use the chunked transfer encoding */
+	u8_t chunked : 1;
+};
+
+/**
+ * HTTP request. It must stay valid until its final callback.
+ */
+struct http_request {
+	/** Request method, like HTTP_GET */
+	enum http_method method;
+
+	/** URL of the resource, like "/index.html" */
+	const char *url;
+
+	/** Additional headers, NULL terminated array of strings. Each string
+	 * is a full header line, including the trailing "\r\n".
+	 */
+	const char **header_fields;
+
+	/** Value of the Content-Type header, NULL if there is no payload */
+	const char *content_type_value;
+
+	/** Request body */
+	const u8_t *payload;
+
+	/** Length of the request body */
+	size_t payload_len;
+
+	/** Response callback */
+	http_response_cb_t response;
+
+	/** User data of the response callback */
+	void *user_data;
+
+	/** Response state, passed to the response callback */
+	struct http_response rsp;
+};
+
+/**
+ * HTTP client connection, kept open between requests to the same host.
+ */
+struct http_client_conn {
+	/** Socket of the connection, -1 if closed */
+	int sock;
+
+	/** Host the connection is for */
+	char host[CONFIG_HTTP_CLIENT_HOST_LEN + 1];
+
+	/** Port the connection is for */
+	u16_t port;
+
+	/** Is the connection using TLS */
+	bool tls;
+
+	/** Is the connection used by the application */
+	bool in_use;
+
+	/** Can the connection be reused after the pending responses */
+	bool keep_alive;
+
+	/** Uptime in ms of the last response */
+	s64_t last_used;
+
+	/** Parser of the responses */
+	struct http_parser parser;
+
+	/** Requests sent and waiting for their response, oldest first */
+	struct http_request *pipeline[CONFIG_HTTP_CLIENT_PIPELINE_DEPTH];
+
+	/** Index of the oldest request in the pipeline */
+	u8_t pipeline_head;
+
+	/** Number of requests in the pipeline */
+	u8_t pipeline_count;
+
+	/** Buffer the responses are received in */
+	u8_t recv_buf[CONFIG_HTTP_CLIENT_RECV_BUF_SIZE];
+};
+
+/**
+ * @brief Get a connection to a host.
+ *
+ * @details An idle connection to the same host and port, kept alive after
+ * previous requests, is reused when the server did not close it meanwhile.
+ * Otherwise the host name is resolved and a new connection is opened.
+ *
+ * @param host Host name or numeric address of the server.
+ * @param port Port of the server.
+ * @param sec_tags Credentials of a TLS connection, NULL for a plain TCP
+ * connection.
+ * @param sec_tag_count Number of credentials.
+ * @param conn The connection is returned here.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int http_client_connect(const char *host, u16_t port,
+			const sec_tag_t *sec_tags, size_t sec_tag_count,
+			struct http_client_conn **conn);
+
+/**
+ * @brief Send a request on a connection.
+ *
+ * @details The request is sent without waiting for the responses of the
+ * previous requests (pipelining). Only idempotent requests should be
+ * pipelined, as they are lost if the server closes the connection.
+ *
+ * @param conn Connection returned by http_client_connect().
+ * @param req Request to send.
+ *
+ * @return 0 if ok, -EAGAIN if the pipeline is full, <0 if error.
+ */
+int http_client_send(struct http_client_conn *conn, struct http_request *req);
+
+/**
+ * @brief Receive the responses of the pending requests.
+ *
+ * @details The response callbacks are called from this function.
+ *
+ * @param conn Connection returned by http_client_connect().
+ * @param timeout Timeout in ms to wait for data, K_FOREVER to wait until
+ * all the responses are received.
+ *
+ * @return 0 once all the responses are received, -ETIMEDOUT if the
+ * timeout expired first, <0 if error.
+ */
+int http_client_process(struct http_client_conn *conn, s32_t timeout);
+
+/**
+ * @brief Release a connection.
+ *
+ * @details The connection is kept open for the next requests to the same
+ * host if the server allows it and all the responses were received,
+ * otherwise it is closed.
+ *
+ * @param conn Connection returned by http_client_connect().
+ */
+void http_client_release(struct http_client_conn *conn);
+
+/**
+ * @brief Send one request and receive its response.
+ *
+ * @details This is http_client_connect(), http_client_send(),
+ * http_client_process() and http_client_release() in a row.
+ *
+ * @param host Host name or numeric address of the server.
+ * @param port Port of the server.
+ * @param sec_tags Credentials of a TLS connection, NULL for a plain TCP
+ * connection.
+ * @param sec_tag_count Number of credentials.
+ * @param req Request to send.
+ * @param timeout Timeout in ms to wait for the response.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int http_client_req(const char *host, u16_t port,
+		    const sec_tag_t *sec_tags, size_t sec_tag_count,
+		    struct http_request *req, s32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_CLIENT_H_ */
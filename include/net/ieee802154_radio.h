@@ -34,8 +34,22 @@ enum ieee802154_hw_caps {
 	IEEE802154_HW_2_4_GHZ	= BIT(4), /* 2.4Ghz radio supported */
 	IEEE802154_HW_TX_RX_ACK = BIT(5), /* Handles ACK request on TX */
 	IEEE802154_HW_SUB_GHZ	= BIT(6), /* Sub-GHz radio supported */
+	IEEE802154_HW_TX_ASYNC	= BIT(7), /* Queued TX, see tx_async */
 };
 
+/**
+ * @typedef ieee802154_tx_done_t
+ * @brief Called by the radio driver when a frame queued with tx_async
+ *        has been sent, or could not be.
+ *
+ * @param result 0 if sent (and acknowledged when an ACK was requested),
+ *        -EBUSY if the channel stayed busy, -EIO otherwise.
+ * @param user_data User data given to tx_async.
+ *
+ * @note Called from the driver context, which may be an interrupt.
+ */
+typedef void (*ieee802154_tx_done_t)(int result, void *user_data);
+
 enum ieee802154_filter_type {
 	IEEE802154_FILTER_TYPE_IEEE_ADDR,
 	IEEE802154_FILTER_TYPE_SHORT_ADDR,
@@ -126,6 +140,18 @@ struct ieee802154_radio_api {
 		  struct net_pkt *pkt,
 		  struct net_buf *frag);
 
+	/** Queue a packet fragment (for IEEE802154_HW_TX_ASYNC)
+	 *
+	 * The fragment is copied, so it can be reused on return. CSMA-CA
+	 * and the ACK wait are done by the radio, which sends the queued
+	 * frames back to back and calls done_cb for each of them.
+	 * Only blocks while the queue of the driver is full.
+	 */
+	int (*tx_async)(struct device *dev,
+			struct net_buf *frag,
+			ieee802154_tx_done_t done_cb,
+			void *user_data);
+
 	/** Start the device */
 	int (*start)(struct device *dev);
 
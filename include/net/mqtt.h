@@ -79,7 +79,8 @@ enum mqtt_evt_type {
 /** @brief MQTT version protocol level. */
 enum mqtt_version {
 	MQTT_VERSION_3_1_0 = 3, /**< Protocol level for 3.1.0. */
-	MQTT_VERSION_3_1_1 = 4  /**< Protocol level for 3.1.1. */
+	MQTT_VERSION_3_1_1 = 4, /**< Protocol level for 3.1.1. */
+	MQTT_VERSION_5_0 = 5    /**< Protocol level for 5.0. */
 };
 
 /** @brief MQTT Quality of Service types. */
@@ -184,8 +185,16 @@ struct mqtt_connack_param {
 
 	/** The appropriate non-zero Connect return code indicates if the Server
 	 *  is unable to process a connection request for some reason.
+	 *  With MQTT 5.0, this is the Connect Reason Code.
 	 */
 	enum mqtt_conn_return_code return_code;
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	/** MQTT 5.0 Topic Alias Maximum of the Server, 0 if it does not
+	 *  accept topic aliases.
+	 */
+	u16_t topic_alias_maximum;
+#endif
 };
 
 /** @brief Parameters for MQTT publish acknowledgment (PUBACK). */
@@ -402,6 +411,28 @@ struct mqtt_transport {
 	};
 };
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/** @brief Topic of outgoing publishes, replaced by an MQTT 5.0 alias. */
+struct mqtt_topic_alias {
+	/** Internal. Copy of the topic. */
+	u8_t topic[CONFIG_MQTT_TOPIC_ALIAS_TOPIC_SIZE];
+
+	/** Internal. Size of the topic, 0 if the alias is not assigned. */
+	u16_t size;
+};
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0
+/** @brief QoS 1 or QoS 2 publish waiting for its acknowledgment. */
+struct mqtt_inflight {
+	/** Internal. Publish parameters, retransmitted on reconnect. */
+	struct mqtt_publish_param param;
+
+	/** Internal. Free, waiting for PUBACK/PUBREC or for PUBCOMP. */
+	u8_t state;
+};
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0 */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -420,6 +451,22 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	u32_t remaining_payload;
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0
+	/** Internal. Publishes not acknowledged yet by the broker. */
+	struct mqtt_inflight inflight[CONFIG_MQTT_INFLIGHT_WINDOW_SIZE];
+#endif
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	/** Internal. Topic Alias Maximum of the broker, from CONNACK. */
+	u16_t topic_alias_max;
+
+	/** Internal. Index of the alias reassigned when all are used. */
+	u16_t topic_alias_next;
+
+	/** Internal. Aliases of outgoing publishes, alias N at index N-1. */
+	struct mqtt_topic_alias topic_alias[CONFIG_MQTT_TOPIC_ALIAS_MAX];
+#endif
 };
 
 /**
@@ -513,7 +560,11 @@ void mqtt_client_init(struct mqtt_client *client);
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  *
  * @note Default protocol revision used for connection request is 3.1.1. Please
- *       set client.protocol_version = MQTT_VERSION_3_1_0 to use protocol 3.1.0.
+ *       set client.protocol_version = MQTT_VERSION_3_1_0 to use protocol 3.1.0,
+ *       or MQTT_VERSION_5_0 to use protocol 5.0 if
+ *       :option:`CONFIG_MQTT_VERSION_5_0` is enabled. With 5.0, the topics
+ *       of outgoing publishes are replaced by topic aliases automatically,
+ *       within the Topic Alias Maximum announced by the broker.
  * @note Please modify :option:`CONFIG_MQTT_KEEPALIVE` time to override default
  *       of 1 minute.
  */
@@ -528,6 +579,16 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *
+ * @note The MQTT header and the payload are sent in a single transport
+ *       write, the payload is not copied into the transmit buffer.
+ * @note With :option:`CONFIG_MQTT_INFLIGHT_WINDOW_SIZE` set, up to that many
+ *       QoS 1 and QoS 2 publishes may wait for their acknowledgment at the
+ *       same time, -EAGAIN is returned when the window is full. The
+ *       library then answers PUBREC with PUBREL itself, and sends the
+ *       publishes again after a reconnection. The topic and the payload of
+ *       such a publish shall stay valid until @ref MQTT_EVT_PUBACK or
+ *       @ref MQTT_EVT_PUBCOMP is notified for it.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
@@ -564,6 +625,9 @@ int mqtt_publish_qos2_receive(struct mqtt_client *client,
  * @brief API used by client to request release of QoS2 publish message.
  *        Should be called on reception of @ref MQTT_EVT_PUBREC.
  *
+ * @note For a publish of the inflight window, the release was sent already
+ *       by the library and this call does nothing.
+ *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
  * @param[in] param Identifies message being released.
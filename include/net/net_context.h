@@ -797,6 +797,32 @@ int net_context_sendto(struct net_context *context,
 		       s32_t timeout,
 		       void *user_data);
 
+/**
+ * @brief Send data gathered from several buffers in one packet.
+ *
+ * @details This function is similar to net_context_sendto(), except that
+ * the data is taken from the I/O vector of @a msghdr and written directly
+ * in the network packet. The destination address is the msg_name of
+ * @a msghdr, or the connected peer if there is none.
+ * This is similar as BSD sendmsg() function.
+ *
+ * @param context The network context to use.
+ * @param msghdr Message to send.
+ * @param flags Flags of the message, unused.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Timeout for the connection. Possible values
+ * are K_FOREVER, K_NO_WAIT, >0.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendmsg(struct net_context *context,
+			const struct msghdr *msghdr,
+			int flags,
+			net_context_send_cb_t cb,
+			s32_t timeout,
+			void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -78,7 +78,18 @@ struct net_if_addr {
 	/** Is this IP address usage limited to the subnet (mesh) or not */
 	u8_t is_mesh_local : 1;
 
-	u8_t _unused : 5;
+	/** Is this tentative IPv6 address usable during DAD (RFC 4429) */
+	u8_t is_optimistic : 1;
+
+	u8_t _unused : 4;
+
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+	/** Address lookup hash chain */
+	sys_snode_t hash_node;
+
+	/** Interface the address is set on */
+	struct net_if *iface;
+#endif
 };
 
 /**
@@ -97,6 +108,14 @@ struct net_if_mcast_addr {
 	u8_t is_joined : 1;
 
 	u8_t _unused : 6;
+
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+	/** Address lookup hash chain */
+	sys_snode_t hash_node;
+
+	/** Interface the group is joined on */
+	struct net_if *iface;
+#endif
 };
 
 /**
@@ -209,6 +228,25 @@ struct net_offload;
 #endif
 /* @endcond */
 
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+struct net_nbr;
+
+/** Destination cache entry, the neighbor packets to an address go to */
+struct net_if_ipv6_dst {
+	/** Destination address */
+	struct in6_addr addr;
+
+	/** Next hop neighbor */
+	struct net_nbr *nbr;
+
+	/** Interface of the neighbor */
+	struct net_if *iface;
+
+	/** Generation of the cache the entry was added in, 0 if unused */
+	u32_t gen;
+};
+#endif /* CONFIG_NET_IPV6_DST_CACHE */
+
 struct net_if_ipv6 {
 	/** Unicast IP addresses */
 	struct net_if_addr unicast[NET_IF_MAX_IPV6_ADDR];
@@ -231,6 +269,11 @@ struct net_if_ipv6 {
 	/** Retransmit timer (RFC 4861, page 52) */
 	u32_t retrans_timer;
 
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+	/** Destination cache, direct mapped on the destination address */
+	struct net_if_ipv6_dst dst_cache[CONFIG_NET_IPV6_DST_CACHE_SIZE];
+#endif
+
 	/** IPv6 hop limit */
 	u8_t hop_limit;
 
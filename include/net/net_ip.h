@@ -278,6 +278,23 @@ struct sockaddr {
 	char data[NET_SOCKADDR_MAX_SIZE - sizeof(sa_family_t)];
 };
 
+/** Buffer of a scatter/gather I/O vector */
+struct iovec {
+	void  *iov_base;
+	size_t iov_len;
+};
+
+/** Message header of sendmsg() and recvmsg() */
+struct msghdr {
+	void         *msg_name;       /* optional socket address */
+	socklen_t     msg_namelen;    /* size of socket address */
+	struct iovec *msg_iov;        /* scatter/gather array */
+	size_t        msg_iovlen;     /* number of elements in msg_iov */
+	void         *msg_control;    /* ancillary data, unused */
+	size_t        msg_controllen; /* ancillary data buffer len */
+	int           msg_flags;      /* flags on received message */
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 struct sockaddr_ptr {
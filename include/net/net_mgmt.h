@@ -301,6 +301,126 @@ static inline int net_mgmt_event_wait_on_iface(struct net_if *iface,
 }
 #endif
 
+/**
+ * @brief An event queued in a struct net_mgmt_event_ring
+ */
+struct net_mgmt_event_ring_entry {
+	/** The event code */
+	u32_t event;
+	/** The interface the event originated from, or NULL */
+	struct net_if *iface;
+	/** How many identical events this entry stands for, when the ring
+	 * coalesces repeated events.
+	 */
+	u16_t count;
+#if defined(CONFIG_NET_MGMT_EVENT_INFO) && defined(CONFIG_NET_MGMT_EVENT_RING)
+	/** Length of info, 0 if the event had none or it did not fit */
+	u16_t info_length;
+	/** Copy of the event information */
+	u8_t info[CONFIG_NET_MGMT_EVENT_RING_INFO_SIZE];
+#endif
+};
+
+/**
+ * @brief Network Management event ring
+ *
+ * Unlike a callback, which is run by the net_mgmt thread, a ring gets its
+ * events queued when they are notified, after filtering on its mask. The
+ * owner reads them at its pace with net_mgmt_event_ring_get(), or waits for
+ * them on the sem member with k_poll() (K_POLL_TYPE_SEM_AVAILABLE).
+ */
+struct net_mgmt_event_ring {
+	/** Meant to be used internally, to insert the ring into a list. */
+	sys_snode_t node;
+
+	/** Given once for each queued entry, can be polled on. */
+	struct k_sem sem;
+
+	/** Events to queue, matched like the event_mask of a callback. */
+	u32_t event_mask;
+
+	/** Number of events dropped because the ring was full. */
+	u32_t dropped;
+
+	struct net_mgmt_event_ring_entry *entries;
+	u16_t size;
+	u16_t head;
+	u16_t count;
+
+	/** Merge an event into the newest entry if it is identical to it. */
+	bool coalesce;
+};
+
+/**
+ * @brief Statically define a network management event ring
+ * @param name Name of the struct net_mgmt_event_ring variable.
+ * @param mgmt_event_mask A mask of relevant events.
+ * @param ring_size Number of events the ring can hold.
+ * @param do_coalesce Whether repeated identical events are merged.
+ */
+#define NET_MGMT_EVENT_RING_DEFINE(name, mgmt_event_mask, ring_size,	\
+				   do_coalesce)				\
+	static struct net_mgmt_event_ring_entry				\
+		_net_mgmt_ring_entries_##name[ring_size];		\
+	struct net_mgmt_event_ring name = {				\
+		.sem = Z_SEM_INITIALIZER(name.sem, 0, ring_size),	\
+		.event_mask = mgmt_event_mask,				\
+		.entries = _net_mgmt_ring_entries_##name,		\
+		.size = ring_size,					\
+		.coalesce = do_coalesce,				\
+	}
+
+#if defined(CONFIG_NET_MGMT_EVENT_RING)
+/**
+ * @brief Initialize a network management event ring
+ * @param ring A valid pointer on the ring to initialize.
+ * @param entries Storage for the queued events.
+ * @param size Number of entries.
+ * @param mgmt_event_mask A mask of relevant events.
+ * @param coalesce Whether repeated identical events are merged.
+ */
+void net_mgmt_event_ring_init(struct net_mgmt_event_ring *ring,
+			      struct net_mgmt_event_ring_entry *entries,
+			      u16_t size, u32_t mgmt_event_mask,
+			      bool coalesce);
+
+/**
+ * @brief Start queueing the matching events into a ring
+ * @param ring A valid pointer on an initialized ring.
+ */
+void net_mgmt_add_event_ring(struct net_mgmt_event_ring *ring);
+
+/**
+ * @brief Stop queueing events into a ring
+ * @param ring A valid pointer on a ring previously added.
+ */
+void net_mgmt_del_event_ring(struct net_mgmt_event_ring *ring);
+
+/**
+ * @brief Get the oldest event of a ring
+ * @param ring A valid pointer on a ring.
+ * @param entry Where to copy the event.
+ * @param timeout a delay in milliseconds to wait for an event, K_NO_WAIT
+ *        after a successful k_poll() on the sem member of the ring.
+ *
+ * @return 0 on success, -EAGAIN if no event came in time.
+ */
+int net_mgmt_event_ring_get(struct net_mgmt_event_ring *ring,
+			    struct net_mgmt_event_ring_entry *entry,
+			    s32_t timeout);
+#else
+#define net_mgmt_event_ring_init(...)
+#define net_mgmt_add_event_ring(...)
+#define net_mgmt_del_event_ring(...)
+
+static inline int net_mgmt_event_ring_get(struct net_mgmt_event_ring *ring,
+					  struct net_mgmt_event_ring_entry *entry,
+					  s32_t timeout)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_MGMT_EVENT_RING */
+
 /**
  * @brief Used by the core of the network stack to initialize the network
  *        event processing.
@@ -0,0 +1,162 @@
+/** @file
+ * @brief Polled reception for network drivers
+ *
+ * Interrupt mitigation for the Rx path of network drivers: on a receive
+ * interrupt the driver disables it and schedules the polling of the
+ * device, which then receives frames from a thread, a budget at a time,
+ * until the device is empty and the interrupt is enabled again.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_NET_NAPI_H_
+#define ZEPHYR_INCLUDE_NET_NET_NAPI_H_
+
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <atomic.h>
+#include <misc/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Polled reception for network drivers
+ * @defgroup net_napi Polled reception
+ * @ingroup networking
+ * @{
+ */
+
+struct net_if;
+struct net_napi;
+
+/**
+ * @typedef net_napi_poll_t
+ * @brief Receive frames from a device.
+ *
+ * @details Called from the polling thread. The callback passes at most
+ * @a budget frames to net_recv_data(). If it receives fewer frames than
+ * that, the device is empty: it calls net_napi_complete() and then
+ * enables its Rx interrupt again. Otherwise it is polled again later.
+ *
+ * @param napi Polling context of the device.
+ * @param budget Max number of frames to receive.
+ *
+ * @return Number of frames received.
+ */
+typedef int (*net_napi_poll_t)(struct net_napi *napi, int budget);
+
+/** Polling statistics of an interface */
+struct net_napi_stats {
+	/** Polls scheduled by an interrupt */
+	u32_t scheduled;
+	/** Calls of the poll callback */
+	u32_t polls;
+	/** Frames received by the poll callback */
+	u32_t frames;
+	/** Polls which used up the budget */
+	u32_t exhausted;
+};
+
+/**
+ * Polling context of a device, embedded in the driver data. The members
+ * should only be accessed through the functions below.
+ */
+struct net_napi {
+	sys_snode_t node;
+	struct k_work work;
+	net_napi_poll_t poll;
+	struct net_if *iface;
+	atomic_t scheduled;
+	u16_t budget;
+	struct net_napi_stats stats;
+};
+
+/**
+ * @brief Initialize the polling context of a device.
+ *
+ * @details Typically called from the init function of the interface.
+ * The budget is CONFIG_NET_NAPI_BUDGET.
+ *
+ * @param napi Polling context.
+ * @param iface Interface of the device.
+ * @param poll Callback receiving the frames.
+ */
+void net_napi_init(struct net_napi *napi, struct net_if *iface,
+		   net_napi_poll_t poll);
+
+/**
+ * @brief Schedule the polling of a device.
+ *
+ * @details Called from the Rx interrupt handler, with the Rx interrupt
+ * of the device disabled. Does nothing if the device is already
+ * scheduled.
+ *
+ * @param napi Polling context.
+ */
+void net_napi_schedule(struct net_napi *napi);
+
+/**
+ * @brief Stop polling a device.
+ *
+ * @details Called by the poll callback once the device is empty, just
+ * before it enables the Rx interrupt of the device again.
+ *
+ * @param napi Polling context.
+ */
+static inline void net_napi_complete(struct net_napi *napi)
+{
+	atomic_clear(&napi->scheduled);
+}
+
+/**
+ * @brief Set the number of frames received per poll.
+ *
+ * @param napi Polling context.
+ * @param budget Max number of frames per poll, at least 1.
+ */
+static inline void net_napi_set_budget(struct net_napi *napi, u16_t budget)
+{
+	napi->budget = MAX(budget, 1);
+}
+
+/**
+ * @brief Get the polling context of an interface.
+ *
+ * @param iface Network interface.
+ *
+ * @return Polling context, or NULL if the driver does not poll.
+ */
+struct net_napi *net_napi_get(struct net_if *iface);
+
+/**
+ * @typedef net_napi_cb_t
+ * @brief Callback used while iterating over the polling contexts.
+ *
+ * @param napi Polling context.
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*net_napi_cb_t)(struct net_napi *napi, void *user_data);
+
+/**
+ * @brief Go through all the polling contexts and call callback for each.
+ *
+ * @param cb User-supplied callback function to call
+ * @param user_data User specified data
+ */
+void net_napi_foreach(net_napi_cb_t cb, void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_NET_NAPI_H_ */
@@ -166,6 +166,46 @@ struct net_pkt {
 	u8_t priority;
 #endif
 
+#if defined(CONFIG_NET_UDP)
+	/* One's complement sum of the data written last with
+	 * net_pkt_write_chksum(), and its length
+	 */
+	u16_t data_chksum;
+	u16_t data_chksum_len;
+	u8_t data_chksum_valid : 1;
+#endif
+
+#if defined(CONFIG_NET_TCP_TSO)
+	/* Segment size of a TCP packet larger than the MTU, which is
+	 * segmented before being sent. 0 for other packets.
+	 */
+	u16_t tso_mss;
+#endif
+
+#if defined(CONFIG_NET_GRO)
+	/* Number of received TCP segments merged into this packet, whose
+	 * TCP checksums were verified when merging. 0 for other packets.
+	 */
+	u8_t gro_segs;
+#endif
+
+#if defined(CONFIG_NET_PKT_HDR_CACHE)
+	/* Start of the IP header of a received packet and length of the
+	 * data following it in the same buffer, set when the packet enters
+	 * L3 so that the L3 and L4 headers are read without the cursor.
+	 */
+	u8_t *hdr_cache;
+	u16_t hdr_cache_len;
+#endif
+
+#if NET_RX_FLOW_QUEUES > 1
+	/** Flow hash of a received packet, used to select its Rx queue */
+	u32_t rx_hash;
+
+	/** Is rx_hash valid, or does it need to be computed */
+	u8_t rx_hash_set : 1;
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -589,6 +629,135 @@ static inline u8_t net_pkt_priority(struct net_pkt *pkt)
 
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_UDP)
+static inline bool net_pkt_data_chksum_valid(struct net_pkt *pkt)
+{
+	return pkt->data_chksum_valid;
+}
+#else
+static inline bool net_pkt_data_chksum_valid(struct net_pkt *pkt)
+{
+	return false;
+}
+#endif
+
+#if defined(CONFIG_NET_TCP_TSO)
+static inline u16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	return pkt->tso_mss;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, u16_t mss)
+{
+	pkt->tso_mss = mss;
+}
+#else
+static inline u16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	return 0;
+}
+
+#define net_pkt_set_tso_mss(...)
+#endif /* CONFIG_NET_TCP_TSO */
+
+#if defined(CONFIG_NET_GRO)
+static inline u8_t net_pkt_gro_segs(struct net_pkt *pkt)
+{
+	return pkt->gro_segs;
+}
+
+static inline void net_pkt_set_gro_segs(struct net_pkt *pkt, u8_t segs)
+{
+	pkt->gro_segs = segs;
+}
+#else
+static inline u8_t net_pkt_gro_segs(struct net_pkt *pkt)
+{
+	return 0;
+}
+
+#define net_pkt_set_gro_segs(...)
+#endif /* CONFIG_NET_GRO */
+
+#if defined(CONFIG_NET_PKT_HDR_CACHE)
+/* Cache the data contiguous from the cursor in the first buffer */
+static inline void net_pkt_hdr_cache_set(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+
+	if (buf && buf == pkt->buffer && pkt->cursor.pos) {
+		pkt->hdr_cache = pkt->cursor.pos;
+		pkt->hdr_cache_len = buf->len - (pkt->cursor.pos - buf->data);
+	} else {
+		pkt->hdr_cache = NULL;
+		pkt->hdr_cache_len = 0U;
+	}
+}
+
+static inline void net_pkt_hdr_cache_clear(struct net_pkt *pkt)
+{
+	pkt->hdr_cache = NULL;
+	pkt->hdr_cache_len = 0U;
+}
+
+/* Header of @a size bytes at @a offset from the IP header, or NULL if it
+ * is not in the cache and must be read with net_pkt_get_data().
+ */
+static inline void *net_pkt_hdr_cache_get(struct net_pkt *pkt,
+					  size_t offset, size_t size)
+{
+	if (!pkt->hdr_cache || offset + size > pkt->hdr_cache_len) {
+		return NULL;
+	}
+
+	return pkt->hdr_cache + offset;
+}
+#else
+#define net_pkt_hdr_cache_set(...)
+#define net_pkt_hdr_cache_clear(...)
+
+static inline void *net_pkt_hdr_cache_get(struct net_pkt *pkt,
+					  size_t offset, size_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(offset);
+	ARG_UNUSED(size);
+
+	return NULL;
+}
+#endif /* CONFIG_NET_PKT_HDR_CACHE */
+
+#if NET_RX_FLOW_QUEUES > 1
+static inline bool net_pkt_rx_hash_is_set(struct net_pkt *pkt)
+{
+	return pkt->rx_hash_set;
+}
+
+static inline u32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+/**
+ * @brief Set the flow hash of a received packet
+ *
+ * Drivers of devices computing a flow hash (e.g. RSS), or receiving
+ * frames on several hardware queues, can call this before
+ * net_recv_data() to select the Rx queue of the packet instead of
+ * letting the stack compute the hash from the packet headers.
+ *
+ * @param pkt Network packet
+ * @param hash Flow hash, the same for all packets of a flow
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, u32_t hash)
+{
+	pkt->rx_hash = hash;
+	pkt->rx_hash_set = 1U;
+}
+#else /* NET_RX_FLOW_QUEUES == 1 */
+#define net_pkt_set_rx_hash(...)
+#endif /* NET_RX_FLOW_QUEUES > 1 */
+
 #if defined(CONFIG_NET_VLAN)
 static inline u16_t net_pkt_vlan_tag(struct net_pkt *pkt)
 {
@@ -1547,6 +1716,25 @@ int net_pkt_read_be32(struct net_pkt *pkt, u32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write the payload into a net_pkt and compute its checksum
+ *
+ * @details Same as net_pkt_write(), but the one's complement sum of the
+ *          data is computed while it is copied, and reused when the
+ *          UDP checksum of the packet is calculated instead of reading the
+ *          payload once more. The data must be the end of the packet, i.e.
+ *          nothing must be written after it.
+ *          Several calls can be made in a row to write the payload.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data,
+			 size_t length);
+
 /* Write u8_t data into a net_pkt. */
 static inline int net_pkt_write_u8(struct net_pkt *pkt, u8_t data)
 {
@@ -187,6 +187,29 @@ struct net_stats_ipv6_nd {
 	net_stats_t sent;
 };
 
+/**
+ * @brief IPv6 fragment reassembly statistics
+ */
+struct net_stats_ipv6_frag {
+	/** Number of packets reassembled */
+	net_stats_t reassembled;
+
+	/** Number of reassemblies that timed out */
+	net_stats_t timeout;
+
+	/** Number of reassemblies evicted to make room for new ones */
+	net_stats_t evicted;
+
+	/** Number of reassemblies dropped for an overlapping fragment */
+	net_stats_t overlap;
+
+	/** Number of duplicate fragments dropped */
+	net_stats_t duplicate;
+
+	/** Number of fragments dropped for lack of a slot or memory */
+	net_stats_t drop;
+};
+
 /**
  * @brief IPv6 multicast listener daemon statistics
  */
@@ -264,6 +287,11 @@ struct net_stats {
 	struct net_stats_ipv6_nd ipv6_nd;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+	/** IPv6 fragment reassembly statistics */
+	struct net_stats_ipv6_frag ipv6_frag;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	/** IPv6 MLD statistics */
 	struct net_stats_ipv6_mld ipv6_mld;
@@ -384,6 +412,7 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_UDP,
 	NET_REQUEST_STATS_CMD_GET_TCP,
 	NET_REQUEST_STATS_CMD_GET_ETHERNET,
+	NET_REQUEST_STATS_CMD_GET_IPV6_FRAG,
 };
 
 #define NET_REQUEST_STATS_GET_ALL				\
@@ -427,6 +456,13 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6);
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_ND);
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+#define NET_REQUEST_STATS_GET_IPV6_FRAG				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_IPV6_FRAG)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_FRAG);
+#endif /* CONFIG_NET_STATISTICS_IPV6_FRAGMENT */
+
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 #define NET_REQUEST_STATS_GET_ICMP				\
 	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_ICMP)
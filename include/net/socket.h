@@ -54,9 +54,19 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmsg: Datagram was truncated (output value only) */
+#define ZSOCK_MSG_TRUNC 0x20
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
 
+/** Message of zsock_sendmmsg() and zsock_recvmmsg() */
+struct zsock_mmsghdr {
+	/** Message to send or to receive into */
+	struct msghdr msg_hdr;
+	/** Number of bytes sent or received for the message */
+	unsigned int msg_len;
+};
+
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
  * respectively". Some software uses numeric values.
@@ -304,6 +314,136 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Send a message gathered from several buffers
+ *
+ * @details
+ * @rststar
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/sendmsg.html>`__
+ * for normative description. The buffers are written directly in the
+ * network packet, ancillary data is not supported.
+ * This function is also exposed as ``sendmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrststar
+ */
+__syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
+				int flags);
+
+/**
+ * @brief Receive a message scattered into several buffers
+ *
+ * @details
+ * @rststar
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description. Ancillary data is not supported, the only
+ * flag returned in msg_flags is ZSOCK_MSG_TRUNC.
+ * This function is also exposed as ``recvmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrststar
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Send several messages
+ *
+ * @details
+ * Same as calling zsock_sendmsg() for each message, but the socket is
+ * looked up, and user mode enters the kernel, only once. The msg_len of
+ * each message sent is set to the number of bytes sent.
+ * This function is also exposed as ``sendmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags applying to all the messages
+ *
+ * @return Number of messages sent, which is less than @a vlen if an error
+ *         occurred after the first message, -1 with errno set if the first
+ *         message could not be sent
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages
+ *
+ * @details
+ * Same as calling zsock_recvmsg() for each message, but the socket is
+ * looked up, and user mode enters the kernel, only once. Only the first
+ * message is waited for, according to @a flags; the call returns as soon
+ * as no more data is ready. The msg_len of each message received is set
+ * to the number of bytes received.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket
+ * @param msgvec Messages to receive into
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags applying to all the messages
+ *
+ * @return Number of messages received, -1 with errno set if none could be
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/** Segment of data received with zsock_recv_zc() */
+struct zsock_zc_seg {
+	/** Start of the data, in a network buffer */
+	const void *data;
+	/** Length of the data */
+	size_t len;
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * The socket must have the SO_ZEROCOPY option set. Instead of being
+ * copied, the received data is described by up to @a nsegs segments
+ * pointing into the network buffers. The buffers stay allocated to the
+ * caller until zsock_recv_zc_release() is called with the returned handle,
+ * which must be done as soon as possible as they are shared with the
+ * rest of the network stack.
+ *
+ * For a datagram socket, the data of a datagram not fitting in the
+ * segments is discarded. For a stream socket, it is returned by the next
+ * call. ZSOCK_MSG_PEEK is not supported.
+ *
+ * User mode callers need CONFIG_NET_SOCKETS_ZEROCOPY_USER, and the
+ * net_zc_partition memory partition in their memory domain to read the
+ * data.
+ *
+ * @param sock Socket
+ * @param segs Array of segments to fill
+ * @param nsegs Number of entries in @a segs, updated with the number of
+ *        segments filled
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param handle Where to store the handle to release the data with, 0 when
+ *        no data is returned
+ *
+ * @return Number of bytes received, -1 with errno set on error
+ */
+__syscall ssize_t zsock_recv_zc(int sock, struct zsock_zc_seg *segs,
+				int *nsegs, int flags, int *handle);
+
+/**
+ * @brief Release the data returned by zsock_recv_zc()
+ *
+ * @param handle Handle returned by zsock_recv_zc(), only valid for the
+ *        thread which made that call
+ *
+ * @return 0 on success, -1 with errno set on error
+ */
+__syscall int zsock_recv_zc_release(int handle);
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_USER)
+/** Memory partition holding the data of the received network buffers */
+extern struct k_mem_partition net_zc_partition;
+#endif
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -539,6 +679,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 #if !defined(CONFIG_NET_SOCKETS_OFFLOAD)
 static inline int socket(int family, int type, int proto)
@@ -603,6 +744,28 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t sendmsg(int sock, const struct msghdr *msg, int flags)
+{
+	return zsock_sendmsg(sock, msg, flags);
+}
+
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -702,6 +865,7 @@ static inline int inet_pton(sa_family_t family, const char *src, void *dst)
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -733,6 +897,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define SO_ERROR 4
 #define SO_RCVTIMEO 20
 #define SO_BINDTODEVICE 25
+/** sockopt: Enable zero-copy receive with zsock_recv_zc() */
+#define SO_ZEROCOPY 60
 
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
@@ -72,6 +72,17 @@ struct canbus_api {
 	/** Get socket CAN option */
 	int (*getsockopt)(struct device *dev, void *obj, int level, int optname,
 			  const void *optval, socklen_t *optlen);
+
+	/** Send a CAN frame by socket without a network packet */
+	int (*send_frame)(struct device *dev, const struct zcan_frame *frame,
+			  s32_t timeout);
+
+	/** Attach a receive callback for frames matching the filter */
+	int (*attach_isr)(struct device *dev, can_rx_callback_t isr,
+			  void *callback_arg, const struct zcan_filter *filter);
+
+	/** Detach a receive callback */
+	void (*detach)(struct device *dev, int filter_id);
 };
 
 /**
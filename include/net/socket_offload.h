@@ -140,6 +140,11 @@ static inline ssize_t sendto(int sock, const void *buf,
 	return socket_ops->sendto(sock, buf, len, flags, to, tolen);
 }
 
+static inline ssize_t sendmsg(int sock, const struct msghdr *msg, int flags)
+{
+	return socket_offload_sendmsg(sock, msg, flags);
+}
+
 static inline int getaddrinfo(const char *node, const char *service,
 			      const struct addrinfo *hints,
 			      struct addrinfo **res)
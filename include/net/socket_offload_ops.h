@@ -27,6 +27,17 @@ extern "C" {
 #include <net/net_ip.h>
 #include <net/socket.h>  /* needed for struct pollfd */
 
+/**
+ * @typedef socket_offload_cb_t
+ * @brief Completion callback of an asynchronous offloaded operation.
+ *
+ * @param sock Socket the operation was issued on.
+ * @param result Number of bytes transferred, or -errno on failure.
+ * @param user_data User data given when the operation was issued.
+ */
+typedef void (*socket_offload_cb_t)(int sock, ssize_t result,
+				    void *user_data);
+
 /**
  * @brief An offloaded Socket API interface
  *
@@ -59,6 +70,17 @@ struct socket_offload {
 			   struct addrinfo **res);
 	void (*freeaddrinfo)(struct addrinfo *res);
 	int (*fcntl)(int fd, int cmd, va_list args);
+
+	/* Optional extensions, NULL when not supported by the provider: */
+
+	/** Send all the buffers of @a msg in one transaction. */
+	ssize_t (*sendmsg)(int sock, const struct msghdr *msg, int flags);
+	/** Queue @a msg for sending, @a cb is called when it has been sent. */
+	int (*sendmsg_async)(int sock, const struct msghdr *msg, int flags,
+			     socket_offload_cb_t cb, void *user_data);
+	/** Queue a receive, @a cb is called when data has been received. */
+	int (*recv_async)(int sock, void *buf, size_t max_len, int flags,
+			  socket_offload_cb_t cb, void *user_data);
 };
 
 /**
@@ -68,6 +90,65 @@ struct socket_offload {
  */
 extern void socket_offload_register(const struct socket_offload *ops);
 
+/**
+ * @brief Send several buffers in one offloaded transaction.
+ *
+ * If the provider has no sendmsg operation, the buffers are copied into
+ * one buffer of CONFIG_NET_SOCKETS_OFFLOAD_BATCH_SIZE bytes and sent
+ * with a single send() or sendto(), so that a modem sees one command
+ * instead of one per buffer.
+ *
+ * @param sock Socket to send on.
+ * @param msg Buffers to send and, optionally, the destination address.
+ * @param flags Send flags.
+ *
+ * @return Number of bytes sent, or -1 with errno set on failure.
+ */
+extern ssize_t socket_offload_sendmsg(int sock, const struct msghdr *msg,
+				      int flags);
+
+#if defined(CONFIG_NET_SOCKETS_OFFLOAD_ASYNC)
+/**
+ * @brief Send several buffers without blocking the caller.
+ *
+ * If the provider has no sendmsg_async operation, the send is done by
+ * socket_offload_sendmsg() from the offload work queue. @a msg, its
+ * vector and its buffers must stay valid until @a cb is called.
+ *
+ * @param sock Socket to send on.
+ * @param msg Buffers to send and, optionally, the destination address.
+ * @param flags Send flags.
+ * @param cb Callback called when the buffers have been sent.
+ * @param user_data User data passed to @a cb.
+ *
+ * @return 0 if the send was queued, -EAGAIN if too many operations are
+ * pending, or a negative error from the provider.
+ */
+extern int socket_offload_sendmsg_async(int sock, const struct msghdr *msg,
+					int flags, socket_offload_cb_t cb,
+					void *user_data);
+
+/**
+ * @brief Receive without blocking the caller.
+ *
+ * If the provider has no recv_async operation, recv() is called from the
+ * offload work queue. @a buf must stay valid until @a cb is called.
+ *
+ * @param sock Socket to receive on.
+ * @param buf Buffer to receive into.
+ * @param max_len Size of @a buf.
+ * @param flags Receive flags.
+ * @param cb Callback called when data has been received.
+ * @param user_data User data passed to @a cb.
+ *
+ * @return 0 if the receive was queued, -EAGAIN if too many operations
+ * are pending, or a negative error from the provider.
+ */
+extern int socket_offload_recv_async(int sock, void *buf, size_t max_len,
+				     int flags, socket_offload_cb_t cb,
+				     void *user_data);
+#endif /* CONFIG_NET_SOCKETS_OFFLOAD_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,32 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection latency
+ *
+ * @param count Number of garbage collections
+ * @param time_max_us Longest garbage collection in us
+ * @param time_total_us Total time spent in garbage collection in us
+ */
+struct nvs_gc_time {
+	u32_t count;
+	u32_t time_max_us;
+	u32_t time_total_us;
+};
+
+/**
+ * @brief Non-volatile Storage statistics
+ *
+ * @param gc Garbage collections at sector close, done within nvs_write()
+ * @param gc_step Incremental garbage collection steps
+ * @param erase_count Number of sector erases since nvs_init()
+ */
+struct nvs_stats {
+	struct nvs_gc_time gc;
+	struct nvs_gc_time gc_step;
+	u32_t erase_count;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -42,6 +68,13 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Address of the most recent ate for each id hash
+ * @param gc_sector Sector of the pending incremental garbage collection
+ * @param gc_addr Next ate to collect in gc_sector
+ * @param gc_work Work item running incremental garbage collection when idle
+ * @param stats Statistics
+ * @param sector_erase_count Optional array of sector_count erase counters,
+ * provided by the application and incremented on every sector erase
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -56,6 +89,20 @@ struct nvs_fs {
 
 	struct k_mutex nvs_lock;
 	struct device *flash_device;
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	u32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#if defined(CONFIG_NVS_GC_INCREMENTAL)
+	u16_t gc_sector;
+	u32_t gc_addr;
+#if (CONFIG_NVS_GC_IDLE_DELAY > 0)
+	struct k_delayed_work gc_work;
+#endif
+#endif
+#if defined(CONFIG_NVS_STATS)
+	struct nvs_stats stats;
+	u32_t *sector_erase_count;
+#endif
 };
 
 /**
@@ -169,6 +216,34 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Run one step of incremental garbage collection, moving at most
+ * CONFIG_NVS_GC_STEP_ATES entries out of the sector that is collected at
+ * the next sector close. Once all its entries are moved the sector is
+ * erased, so that closing the write sector in nvs_write() neither copies
+ * nor erases.
+ *
+ * @param fs Pointer to file system
+ *
+ * @retval 0 No garbage collection left until the next sector close
+ * @retval 1 More steps are needed
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs);
+
+/**
+ * @brief nvs_stats_get
+ *
+ * Get the garbage collection latency and erase statistics.
+ *
+ * @param fs Pointer to file system
+ * @param stats Statistics
+ * @param reset Restart the latency statistics after reading them
+ */
+void nvs_stats_get(struct nvs_fs *fs, struct nvs_stats *stats, bool reset);
+
 /**
  * @}
  */
@@ -40,6 +40,10 @@ typedef struct mq_attr {
 #define O_NONBLOCK      (1 << O_NONBLOCK_POS)
 #endif /* _SYS_FCNTL_H_ */
 
+#ifndef MQ_PRIO_MAX
+#define MQ_PRIO_MAX 32
+#endif
+
 mqd_t mq_open(const char *name, int oflags, ...);
 int mq_close(mqd_t mqdes);
 int mq_unlink(const char *name);
@@ -55,6 +59,35 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 		 unsigned int msg_prio, const struct timespec *abstime);
 
+#ifdef CONFIG_POSIX_MQUEUE_LOAN
+/**
+ * @brief Receive a message without copying it
+ *
+ * Not a POSIX API. Receives as mq_timedreceive(), but sets @a msg_ptr to
+ * the message in the buffer of the queue instead of copying it. The slot
+ * of the message stays taken, and the queue holds one message less, until
+ * the message is given back with mq_loan_return().
+ *
+ * @param mqdes Message queue descriptor
+ * @param msg_ptr Set to the message
+ * @param msg_prio Set to the priority of the message if not NULL
+ * @param abstime Time limit, NULL to wait forever
+ *
+ * @return Length of the message, -1 on error with errno set.
+ */
+int mq_loan_receive(mqd_t mqdes, const char **msg_ptr, unsigned int *msg_prio,
+		    const struct timespec *abstime);
+
+/**
+ * @brief Give back a message received with mq_loan_receive()
+ *
+ * Not a POSIX API.
+ *
+ * @return 0 on success, -1 on error with errno set.
+ */
+int mq_loan_return(mqd_t mqdes, const char *msg_ptr);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
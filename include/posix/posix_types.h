@@ -45,6 +45,8 @@ typedef struct k_sem sem_t;
 
 /* Mutex */
 typedef struct pthread_mutex {
+	/* unlocked, locked, or locked with threads in wait_q */
+	atomic_t state;
 	pthread_t owner;
 	u16_t lock_count;
 	int type;
@@ -58,6 +60,8 @@ typedef struct pthread_mutexattr {
 /* Condition variables */
 typedef struct pthread_cond {
 	_wait_q_t wait_q;
+	/* threads in or about to enter wait_q */
+	atomic_t waiters;
 } pthread_cond_t;
 
 typedef struct pthread_condattr {
@@ -76,9 +80,9 @@ typedef struct pthread_barrierattr {
 typedef u32_t pthread_rwlockattr_t;
 
 typedef struct pthread_rwlock_obj {
-	struct k_sem rd_sem;
-	struct k_sem wr_sem;
-	struct k_sem reader_active;/* blocks WR till reader has acquired lock */
+	/* reader count, writer and waiter flags */
+	atomic_t state;
+	_wait_q_t wait_q;
 	s32_t status;
 	k_tid_t wr_owner;
 } pthread_rwlock_t;
@@ -72,6 +72,7 @@ struct posix_thread {
 #define PTHREAD_COND_DEFINE(name)					\
 	struct pthread_cond name = {					\
 		.wait_q = Z_WAIT_Q_INIT(&name.wait_q),			\
+		.waiters = ATOMIC_INIT(0),				\
 	}
 
 /**
@@ -84,6 +85,7 @@ static inline int pthread_cond_init(pthread_cond_t *cv,
 {
 	ARG_UNUSED(att);
 	z_waitq_init(&cv->wait_q);
+	atomic_set(&cv->waiters, 0);
 	return 0;
 }
 
@@ -163,6 +165,7 @@ static inline int pthread_condattr_destroy(pthread_condattr_t *att)
 	struct pthread_mutex name \
 		__in_section(_k_mutex, static, name) = \
 	{ \
+		.state = ATOMIC_INIT(0), \
 		.lock_count = 0, \
 		.wait_q = Z_WAIT_Q_INIT(&name.wait_q),	\
 		.owner = NULL, \
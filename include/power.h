@@ -169,7 +169,9 @@ extern void sys_set_power_state(enum power_states state);
 /**
  * @brief Dump Low Power states related debug info
  *
- * Dump Low Power states debug info like LPS entry count and residencies.
+ * Dump Low Power states debug info like LPS entry count, the number of
+ * entries ended by an interrupt before the next kernel timeout, and
+ * residencies.
  */
 extern void sys_pm_dump_debug_info(void);
 
@@ -311,6 +313,22 @@ extern void sys_pm_notify_power_state_entry(enum power_states state);
  */
 extern void sys_pm_notify_power_state_exit(enum power_states state);
 
+#ifdef CONFIG_SYS_PM_POLICY_PREDICTIVE
+/**
+ * @brief Application defined function identifying the wakeup source
+ *
+ * Called by the predictive PM policy when a power state is exited before
+ * the next kernel timeout, after the interrupt that ended it was handled,
+ * to learn the intervals between the wakeups of each source separately.
+ * The default implementation returns 0, all the interrupts then being a
+ * single source.
+ *
+ * @return Index of the source, less than
+ *	   CONFIG_SYS_PM_POLICY_PREDICTIVE_SOURCES.
+ */
+extern unsigned int sys_pm_wakeup_source_get(void);
+#endif
+
 /**
  * @}
  */
@@ -21,6 +21,7 @@
 #define ZEPHYR_INCLUDE_RANDOM_RAND32_H_
 
 #include <zephyr/types.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +29,21 @@ extern "C" {
 
 extern u32_t sys_rand32_get(void);
 
+/**
+ * @brief Fill a buffer with cryptographically secure random numbers
+ *
+ * Served from a generator seeded from the entropy driver, never waits and
+ * can be called from interrupt context. Available when CSPRNG_ENABLED is
+ * set.
+ *
+ * @param dst Buffer to fill.
+ * @param len Number of bytes to fill.
+ *
+ * @retval 0 on success.
+ * @retval -EIO if the generator is not seeded.
+ */
+extern int sys_csrand_get(void *dst, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
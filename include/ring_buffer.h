@@ -449,6 +449,212 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size);
  */
 u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size);
 
+#ifdef CONFIG_RING_BUFFER_CACHE_LINE_SIZE
+#define Z_RING_BUF_SPSC_ALIGN CONFIG_RING_BUFFER_CACHE_LINE_SIZE
+#else
+#define Z_RING_BUF_SPSC_ALIGN 4
+#endif
+
+/**
+ * @brief A lock-free single producer, single consumer byte ring buffer
+ *
+ * The producer only writes @a tail and the consumer only writes @a head, so
+ * one thread or ISR may put while another gets without any lock. The two
+ * indices are on separate cache lines, so that either side writing its
+ * index does not evict the other's line.
+ *
+ * The indices run freely and are masked with the power of two size, so the
+ * whole buffer is usable and no modulo nor wrap-around test is needed.
+ */
+struct ring_buf_spsc {
+	u8_t *buf;	/**< Memory region for stored bytes */
+	u32_t mask;	/**< Size of buf minus one */
+
+	/** Written by the producer only */
+	struct {
+		u32_t tail;	/**< Index after the last committed byte */
+		u32_t tmp_tail;	/**< Index after the last claimed byte */
+	} producer __aligned(Z_RING_BUF_SPSC_ALIGN);
+
+	/** Written by the consumer only */
+	struct {
+		u32_t head;	/**< Index of the first committed byte */
+		u32_t tmp_head;	/**< Index after the last claimed byte */
+	} consumer __aligned(Z_RING_BUF_SPSC_ALIGN);
+};
+
+/**
+ * @brief Statically define and initialize a lock-free SPSC ring buffer.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_spsc <name>; @endcode
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), a power of 2.
+ */
+#define RING_BUF_SPSC_DECLARE(name, size8) \
+	BUILD_ASSERT_MSG(((size8) & ((size8) - 1)) == 0 && (size8) > 0, \
+			 "SPSC ring buffer size must be a power of 2"); \
+	static u8_t _ring_buffer_data_##name[size8]; \
+	struct ring_buf_spsc name = { \
+		.buf = _ring_buffer_data_##name, \
+		.mask = (size8) - 1 \
+	}
+
+/**
+ * @brief Initialize a lock-free SPSC ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_SPSC_DECLARE.
+ *
+ * @param rb   Address of ring buffer.
+ * @param size Ring buffer size (in bytes), a power of 2.
+ * @param data Ring buffer data area (u8_t data[size]).
+ */
+static inline void ring_buf_spsc_init(struct ring_buf_spsc *rb, u32_t size,
+				      u8_t *data)
+{
+	__ASSERT(is_power_of_two(size) && size > 0,
+		 "SPSC ring buffer size must be a power of 2");
+
+	memset(rb, 0, sizeof(*rb));
+	rb->buf = data;
+	rb->mask = size - 1;
+}
+
+/**
+ * @brief Determine if a lock-free SPSC ring buffer is empty.
+ *
+ * Can be called by either side. The result may be stale as soon as it is
+ * returned if the other side is active.
+ *
+ * @param rb Address of ring buffer.
+ *
+ * @return true if the ring buffer is empty.
+ */
+static inline bool ring_buf_spsc_is_empty(struct ring_buf_spsc *rb)
+{
+	return __atomic_load_n(&rb->producer.tail, __ATOMIC_ACQUIRE) ==
+	       __atomic_load_n(&rb->consumer.head, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Determine free space in a lock-free SPSC ring buffer.
+ *
+ * Meant to be called by the producer, the space can only grow meanwhile.
+ *
+ * @param rb Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline u32_t ring_buf_spsc_space_get(struct ring_buf_spsc *rb)
+{
+	return rb->mask + 1 -
+	       (rb->producer.tail -
+		__atomic_load_n(&rb->consumer.head, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief Return lock-free SPSC ring buffer capacity.
+ *
+ * @param rb Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes).
+ */
+static inline u32_t ring_buf_spsc_capacity_get(struct ring_buf_spsc *rb)
+{
+	/* free-running indices tell a full buffer from an empty one */
+	return rb->mask + 1;
+}
+
+/**
+ * @brief Allocate buffer for writing data to a lock-free SPSC ring buffer.
+ *
+ * Same as @ref ring_buf_put_claim. Must only be called by the producer.
+ *
+ * @param[in]  rb   Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps.
+ */
+u32_t ring_buf_spsc_put_claim(struct ring_buf_spsc *rb, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Indicate number of bytes written to allocated buffers.
+ *
+ * Publishes the bytes to the consumer. Must only be called by the producer.
+ *
+ * @param  rb   Address of ring buffer.
+ * @param  size Number of valid bytes in the allocated buffers.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds free space in the ring buffer.
+ */
+int ring_buf_spsc_put_finish(struct ring_buf_spsc *rb, u32_t size);
+
+/**
+ * @brief Write (copy) data to a lock-free SPSC ring buffer.
+ *
+ * Must only be called by the producer.
+ *
+ * @param rb   Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+u32_t ring_buf_spsc_put(struct ring_buf_spsc *rb, const u8_t *data,
+			u32_t size);
+
+/**
+ * @brief Get address of a valid data in a lock-free SPSC ring buffer.
+ *
+ * Same as @ref ring_buf_get_claim. Must only be called by the consumer.
+ *
+ * @param[in]  rb   Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough data or buffer wraps.
+ */
+u32_t ring_buf_spsc_get_claim(struct ring_buf_spsc *rb, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer.
+ *
+ * Gives the space back to the producer. Must only be called by the
+ * consumer.
+ *
+ * @param  rb   Address of ring buffer.
+ * @param  size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds valid bytes in the ring buffer.
+ */
+int ring_buf_spsc_get_finish(struct ring_buf_spsc *rb, u32_t size);
+
+/**
+ * @brief Read data from a lock-free SPSC ring buffer.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param rb   Address of ring buffer.
+ * @param data Address of the output buffer.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written to the output buffer.
+ */
+u32_t ring_buf_spsc_get(struct ring_buf_spsc *rb, u8_t *data, u32_t size);
+
 /**
  * @}
  */
@@ -44,16 +44,25 @@ void z_priq_rb_add(struct _priq_rb *pq, struct k_thread *thread);
 void z_priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread);
 struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
 
-/* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
- * to the original Zephyr scheduler.  RAM requirements are
- * comparatively high, but performance is very fast.  Won't work with
- * features like deadline scheduling which need large priority spaces
- * to represet their requirements.
+/* Traditional/textbook "multi-queue" structure.  Separate lists for
+ * each fixed priority in the configured range, with a two-level
+ * bitmap of non-empty lists so the best priority is found with two
+ * count-trailing-zeros operations regardless of how many priorities
+ * exist.  This corresponds to the original Zephyr scheduler.  RAM
+ * requirements are comparatively high, but performance is very
+ * fast.  Won't work with features like deadline scheduling which
+ * need large priority spaces to represet their requirements.
  */
+#define PRIQ_MQ_NUM_PRIOS (CONFIG_NUM_COOP_PRIORITIES + \
+			   CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define PRIQ_MQ_BITMAP_WORDS ceiling_fraction(PRIQ_MQ_NUM_PRIOS, 32)
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
-	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
+	sys_dlist_t queues[PRIQ_MQ_NUM_PRIOS];
+	/* bit 1<<i of bits[w] set if queues[w * 32 + i] is non-empty */
+	u32_t bits[PRIQ_MQ_BITMAP_WORDS];
+	/* bit 1<<w set if bits[w] is non-zero */
+	u32_t bitmask;
 };
 
 void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
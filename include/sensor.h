@@ -22,6 +22,10 @@
 #include <zephyr/types.h>
 #include <device.h>
 #include <errno.h>
+#ifdef CONFIG_SENSOR_TRIGGER_DISPATCH
+#include <atomic.h>
+#include <misc/slist.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -314,11 +318,99 @@ typedef int (*sensor_channel_get_t)(struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+#ifdef CONFIG_SENSOR_STREAM
+/**
+ * @brief Description of one value of a streamed frame.
+ */
+struct sensor_stream_chan {
+	/** Channel of the value. */
+	enum sensor_channel chan;
+	/**
+	 * Value corresponding to a raw sample of 32768, i.e. to a q31 value
+	 * of 1.0, in micro units of the channel.
+	 */
+	u32_t range;
+};
+
+/**
+ * @brief Batch of frames read from a sensor FIFO.
+ *
+ * A frame holds one little endian, signed 16-bit raw sample per entry of
+ * chans.  Frames are equally spaced in time; use
+ * @ref sensor_stream_timestamp_get, @ref sensor_stream_q31_get and
+ * @ref sensor_stream_float_get to decode them.
+ */
+struct sensor_stream_data {
+	/** Raw frames, as read from the device. */
+	const u8_t *buf;
+	/** Layout of a frame. */
+	const struct sensor_stream_chan *chans;
+	/** Number of values in a frame. */
+	u8_t chan_count;
+	/** Number of frames in buf. */
+	u16_t frame_count;
+	/** Frames were lost since the previous batch, on FIFO overrun. */
+	bool overrun;
+	/** Time of the last frame, in hardware cycles (k_cycle_get_32()). */
+	u32_t timestamp;
+	/** Time between frames, in hardware cycles. */
+	u32_t period;
+};
+
+/**
+ * @typedef sensor_stream_handler_t
+ * @brief Handler of a batch of streamed frames.
+ *
+ * Called from the driver interrupt thread, the data is only valid during
+ * the call.
+ */
+typedef void (*sensor_stream_handler_t)(struct device *dev,
+					const struct sensor_stream_data *data,
+					void *user_data);
+
+/**
+ * @brief Configuration of a sensor stream.
+ */
+struct sensor_stream_config {
+	/** Number of frames per batch, the FIFO watermark. */
+	u16_t watermark;
+	/** Buffer the frames are read into, of at least watermark frames. */
+	u8_t *buf;
+	/** Size of buf, in bytes. */
+	size_t buf_size;
+	/** Handler of the batches. */
+	sensor_stream_handler_t handler;
+	/** Argument of the handler. */
+	void *user_data;
+};
+
+/**
+ * @typedef sensor_stream_start_t
+ * @brief Callback API for starting a stream
+ *
+ * See sensor_stream_start() for argument description
+ */
+typedef int (*sensor_stream_start_t)(struct device *dev,
+				     const struct sensor_stream_config *cfg);
+
+/**
+ * @typedef sensor_stream_stop_t
+ * @brief Callback API for stopping a stream
+ *
+ * See sensor_stream_stop() for argument description
+ */
+typedef int (*sensor_stream_stop_t)(struct device *dev);
+#endif /* CONFIG_SENSOR_STREAM */
+
 struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+#ifdef CONFIG_SENSOR_STREAM
+	sensor_stream_start_t stream_start;
+	sensor_stream_stop_t stream_stop;
+#endif
 };
 
 /**
@@ -471,6 +563,174 @@ static inline int z_impl_sensor_channel_get(struct device *dev,
 	return api->channel_get(dev, chan, val);
 }
 
+#ifdef CONFIG_SENSOR_STREAM
+/**
+ * @brief Start streaming frames from the sensor FIFO
+ *
+ * The FIFO is configured to raise an interrupt once it holds the
+ * watermark number of frames.  The driver then reads all available frames
+ * into the buffer in burst transfers and passes them to the handler.  The
+ * sampling frequency and full scale set with @ref sensor_attr_set apply.
+ * The pull API must not be used while streaming.
+ *
+ * @param dev Pointer to the sensor device
+ * @param cfg Stream configuration, only used during the call
+ *
+ * @retval 0 if successful.
+ * @retval -ENOTSUP if the driver has no FIFO support.
+ * @retval -EINVAL if the buffer is too small or the watermark too large.
+ */
+static inline int sensor_stream_start(struct device *dev,
+				      const struct sensor_stream_config *cfg)
+{
+	const struct sensor_driver_api *api = dev->driver_api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, cfg);
+}
+
+/**
+ * @brief Stop streaming frames
+ *
+ * @param dev Pointer to the sensor device
+ *
+ * @return 0 if successful, negative errno code if failure.
+ */
+static inline int sensor_stream_stop(struct device *dev)
+{
+	const struct sensor_driver_api *api = dev->driver_api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev);
+}
+
+/**
+ * @brief Get the raw sample of a streamed frame
+ *
+ * @param data Batch of frames
+ * @param frame Index of the frame
+ * @param idx Index of the value in the frame
+ *
+ * @return The raw sample.
+ */
+static inline s16_t
+sensor_stream_raw_get(const struct sensor_stream_data *data, u16_t frame,
+		      u8_t idx)
+{
+	const u8_t *p = &data->buf[(frame * data->chan_count + idx) * 2];
+
+	return (s16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief Get a value of a streamed frame in q31 format
+ *
+ * The value is a fraction of the range of its channel.
+ *
+ * @param data Batch of frames
+ * @param frame Index of the frame
+ * @param idx Index of the value in the frame
+ *
+ * @return The value, 1.0 being data->chans[idx].range.
+ */
+static inline s32_t
+sensor_stream_q31_get(const struct sensor_stream_data *data, u16_t frame,
+		      u8_t idx)
+{
+	return (s32_t)((u32_t)sensor_stream_raw_get(data, frame, idx) << 16);
+}
+
+/**
+ * @brief Get a value of a streamed frame in the unit of its channel
+ *
+ * @param data Batch of frames
+ * @param frame Index of the frame
+ * @param idx Index of the value in the frame
+ *
+ * @return The value, e.g. in m/s^2 for an acceleration.
+ */
+static inline float
+sensor_stream_float_get(const struct sensor_stream_data *data, u16_t frame,
+			u8_t idx)
+{
+	return (float)sensor_stream_raw_get(data, frame, idx) *
+	       ((float)data->chans[idx].range / (32768.0f * 1000000.0f));
+}
+
+/**
+ * @brief Get the time of a streamed frame
+ *
+ * @param data Batch of frames
+ * @param frame Index of the frame
+ *
+ * @return The time of the frame, in hardware cycles.
+ */
+static inline u32_t
+sensor_stream_timestamp_get(const struct sensor_stream_data *data, u16_t frame)
+{
+	return data->timestamp -
+	       (u32_t)(data->frame_count - 1 - frame) * data->period;
+}
+#endif /* CONFIG_SENSOR_STREAM */
+
+#ifdef CONFIG_SENSOR_TRIGGER_DISPATCH
+struct sensor_trigger_work;
+
+/**
+ * @typedef sensor_trigger_work_handler_t
+ * @brief Handler of the interrupts of a sensor, run by the dispatcher.
+ */
+typedef void (*sensor_trigger_work_handler_t)(struct sensor_trigger_work *tw);
+
+/**
+ * @brief Trigger work of a sensor driver, for the shared dispatcher.
+ *
+ * Drivers embed one in their data and submit it from their interrupt
+ * callback, instead of running a thread of their own.  The members are
+ * private to the dispatcher.
+ */
+struct sensor_trigger_work {
+	sys_snode_t node;
+	sensor_trigger_work_handler_t handler;
+	struct device *bus;
+	u8_t queue;
+	atomic_t pending;
+};
+
+/**
+ * @brief Initialize the trigger work of a sensor driver
+ *
+ * The dispatcher runs a few threads of decreasing priority.  Within one,
+ * the pending handlers of sensors on the same bus run back to back, so
+ * that interrupts raised together on a bus are served in a single burst
+ * of transfers.
+ *
+ * @param tw Trigger work to initialize
+ * @param handler Handler of the interrupts
+ * @param bus Bus the sensor is on, or NULL
+ * @param queue Dispatcher thread to run in, 0 being the highest priority
+ */
+void sensor_trigger_work_init(struct sensor_trigger_work *tw,
+			      sensor_trigger_work_handler_t handler,
+			      struct device *bus, unsigned int queue);
+
+/**
+ * @brief Have the handler of a trigger work run
+ *
+ * Callable from interrupt context.  Submitting a work not run yet is a
+ * no-op, such interrupts are served by a single run of the handler.
+ *
+ * @param tw Trigger work to submit
+ */
+void sensor_trigger_work_submit(struct sensor_trigger_work *tw);
+#endif /* CONFIG_SENSOR_TRIGGER_DISPATCH */
+
 /**
  * @brief The value of gravitational constant in micro m/s^2.
  */
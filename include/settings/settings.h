@@ -12,6 +12,7 @@
 #include <misc/util.h>
 #include <misc/slist.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -120,6 +121,19 @@ int settings_register(struct settings_handler *cf);
  */
 int settings_load(void);
 
+/**
+ * Load serialized items of a subtree from registered persistence sources,
+ * and commit the handlers of that subtree. Items outside of the subtree are
+ * skipped without reading their values, so a subsystem can load what it
+ * needs at init.
+ *
+ * @param subtree Name of the subtree, e.g. "bt" or "bt/keys". NULL loads
+ * all items, as settings_load() does.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_load_subtree(const char *subtree);
+
 /**
  * Save currently running serialized items. All serialized items which are different
  * from currently persisted values will be saved.
@@ -141,6 +155,35 @@ int settings_save(void);
  */
 int settings_save_one(const char *name, const void *value, size_t val_len);
 
+#ifdef CONFIG_SETTINGS_BATCH
+/**
+ * Start a batch of settings writes.
+ *
+ * Until the matching @ref settings_batch_commit, values written with
+ * @ref settings_save_one and @ref settings_delete are buffered in RAM,
+ * repeated writes of a name replacing each other. Batches may be nested,
+ * the outermost commit writes the values. Buffered values are not visible
+ * to @ref settings_load before the commit.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_batch_begin(void);
+
+/**
+ * Write the values buffered since @ref settings_batch_begin to persisted
+ * storage, as one burst of writes.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_batch_commit(void);
+
+/**
+ * Drop all values buffered since @ref settings_batch_begin and end the
+ * batch, including any outer batches.
+ */
+void settings_batch_abort(void);
+#endif /* CONFIG_SETTINGS_BATCH */
+
 /**
  * Delete a single serialized in persisted storage.
  *
@@ -161,6 +204,15 @@ int settings_delete(const char *name);
  */
 int settings_commit(void);
 
+/**
+ * Call commit for the settings handlers of a subtree.
+ *
+ * @param subtree Name of the subtree, NULL for all handlers.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_commit_subtree(const char *subtree);
+
 /**
  * @} settings
  */
@@ -297,6 +349,35 @@ int settings_runtime_commit(const char *name);
 
 #endif /* CONFIG_SETTINGS_RUNTIME */
 
+#ifdef CONFIG_SETTINGS_CBOR
+
+struct cbor_writer;
+
+/**
+ * Export the settings of a subtree in the binary format: a CBOR map of
+ * the names, as text strings, to the values, as byte strings.
+ *
+ * @param subtree Name of the subtree, NULL for all settings.
+ * @param writer CBOR writer the map is encoded with.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_cbor_export(const char *subtree, struct cbor_writer *writer);
+
+/**
+ * Set the values of a map in the format of @ref settings_cbor_export.
+ * A null value deletes the setting.
+ *
+ * @param data Encoded map.
+ * @param len Length of @p data.
+ * @param save Also write the values to persisted storage.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_cbor_import(const void *data, size_t len, bool save);
+
+#endif /* CONFIG_SETTINGS_CBOR */
+
 
 #ifdef __cplusplus
 }
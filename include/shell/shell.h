@@ -490,6 +490,19 @@ struct shell_transport_api {
 	 */
 	void (*update)(const struct shell_transport *transport);
 
+	/**
+	 * @brief Function for getting the free space of the TX buffer.
+	 *
+	 * Optional. When provided, pending log messages are only output
+	 * while the transport buffer has room, so that they do not block
+	 * the shell thread behind a busy transport.
+	 *
+	 * @param[in] transport Pointer to the transfer instance.
+	 *
+	 * @return Number of bytes that can be written without blocking.
+	 */
+	size_t (*tx_free_get)(const struct shell_transport *transport);
+
 };
 
 struct shell_transport {
@@ -524,6 +537,7 @@ struct shell_flags {
 	u32_t mode_delete :1; /*!< Operation mode of backspace key */
 	u32_t history_exit:1; /*!< Request to exit history mode */
 	u32_t cmd_ctx	  :1; /*!< Shell is executing command */
+	u32_t log_deferred:1; /*!< Log output waits for transport room */
 	u32_t last_nl     :8; /*!< Last received new line character */
 };
 
@@ -22,6 +22,9 @@
 #include <zephyr/types.h>
 #include <stddef.h>
 #include <device.h>
+#ifdef CONFIG_SPI_QUEUE
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -210,6 +213,39 @@ typedef int (*spi_api_io_async)(struct device *dev,
 				const struct spi_buf_set *rx_bufs,
 				struct k_poll_signal *async);
 
+#ifdef CONFIG_SPI_QUEUE
+/**
+ * @brief SPI transaction queued on a bus
+ *
+ * @param config Configuration of the target device, SPI_LOCK_ON is not
+ *        supported.
+ * @param tx_bufs Buffer array where data to be sent originates from,
+ *        or NULL if none.
+ * @param rx_bufs Buffer array where data to be read will be written to,
+ *        or NULL if none.
+ * @param signal A pointer to a valid and ready to be signaled
+ *        struct k_poll_signal, or NULL.
+ */
+struct spi_transaction {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	struct device *dev;
+	/** @endcond */
+	const struct spi_config *config;
+	const struct spi_buf_set *tx_bufs;
+	const struct spi_buf_set *rx_bufs;
+	struct k_poll_signal *signal;
+};
+
+/**
+ * @typedef spi_api_io_queued
+ * @brief Callback API for queued I/O
+ * See spi_transceive_queued() for argument descriptions
+ */
+typedef int (*spi_api_io_queued)(struct device *dev,
+				 struct spi_transaction *t);
+#endif /* CONFIG_SPI_QUEUE */
+
 /**
  * @typedef spi_api_release
  * @brief Callback API for unlocking SPI device.
@@ -229,6 +265,9 @@ struct spi_driver_api {
 	spi_api_io_async transceive_async;
 #endif /* CONFIG_SPI_ASYNC */
 	spi_api_release release;
+#ifdef CONFIG_SPI_QUEUE
+	spi_api_io_queued transceive_queued;
+#endif /* CONFIG_SPI_QUEUE */
 };
 
 /**
@@ -387,6 +426,46 @@ static inline int spi_write_async(struct device *dev,
 }
 #endif /* CONFIG_SPI_ASYNC */
 
+#ifdef CONFIG_SPI_QUEUE
+/**
+ * @brief Queue a transaction on the SPI bus.
+ *
+ * Note: This function is asynchronous and never blocks.
+ *
+ * Unlike spi_transceive_async(), which waits for the bus to be free, the
+ * transaction is appended to the queue of the bus.  Queued transactions,
+ * possibly to different devices, are started back-to-back from the
+ * completion interrupt of the previous one, the chip select of each being
+ * driven from its own config.  Their completion is notified through
+ * t->signal.
+ *
+ * @param dev Pointer to the device structure for the driver instance
+ * @param t Transaction, must remain valid until completion.
+ *
+ * @retval 0 If the transaction was queued.
+ * @retval -ENOTSUP If the driver does not support queuing.
+ * @retval -EINVAL If the config has SPI_LOCK_ON set.
+ */
+static inline int spi_transceive_queued(struct device *dev,
+					struct spi_transaction *t)
+{
+	const struct spi_driver_api *api =
+		(const struct spi_driver_api *)dev->driver_api;
+
+	if (api->transceive_queued == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (t->config->operation & SPI_LOCK_ON) {
+		return -EINVAL;
+	}
+
+	t->dev = dev;
+
+	return api->transceive_queued(dev, t);
+}
+#endif /* CONFIG_SPI_QUEUE */
+
 /**
  * @brief Release the SPI device locked on by the current config
  *
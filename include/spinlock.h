@@ -7,6 +7,7 @@
 #define ZEPHYR_INCLUDE_SPINLOCK_H_
 
 #include <atomic.h>
+#include <stdbool.h>
 
 /* These stubs aren't provided by the mocking framework, and I can't
  * find a proper place to put them as mocking seems not to have a
@@ -52,8 +53,28 @@ typedef struct k_spinlock_key k_spinlock_key_t;
 
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#if defined(CONFIG_SPIN_LOCK_TICKET)
+	/* Ticket being served, and next ticket to hand out */
+	atomic_t owner;
+	atomic_t next;
+#elif defined(CONFIG_SPIN_LOCK_MCS)
+	/* Index + 1 of the queue node at the tail, 0 if unlocked.  The
+	 * nodes belong to the CPUs, see kernel/smp.c
+	 */
+	atomic_t tail;
+#else
 	atomic_t locked;
 #endif
+#endif
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+	/* Number of acquisitions which had to wait */
+	u32_t contended;
+	/* Total number of wait loop iterations */
+	u32_t spins;
+	/* Longest wait, in cycles */
+	u32_t max_wait;
+#endif
 
 #ifdef SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
@@ -63,6 +84,65 @@ struct k_spinlock {
 #endif
 };
 
+#ifdef CONFIG_SMP
+/* Wait loops for a contended lock, in kernel/smp.c.  These also collect
+ * the contention statistics.
+ */
+void z_spin_lock_wait(struct k_spinlock *l, atomic_val_t ticket);
+void z_spin_mcs_lock(struct k_spinlock *l);
+void z_spin_mcs_unlock(struct k_spinlock *l);
+
+static ALWAYS_INLINE void z_spin_acquire(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPIN_LOCK_TICKET)
+	atomic_val_t ticket = atomic_inc(&l->next);
+
+	if (atomic_get(&l->owner) != ticket) {
+		z_spin_lock_wait(l, ticket);
+	}
+#elif defined(CONFIG_SPIN_LOCK_MCS)
+	z_spin_mcs_lock(l);
+#else
+	if (!atomic_cas(&l->locked, 0, 1)) {
+		z_spin_lock_wait(l, 0);
+	}
+#endif
+}
+
+static ALWAYS_INLINE void z_spin_release(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPIN_LOCK_TICKET)
+	/* Only the owner writes owner, but the increment has to be seen
+	 * by the other CPUs with a barrier, same as atomic_clear() below
+	 */
+	(void)atomic_inc(&l->owner);
+#elif defined(CONFIG_SPIN_LOCK_MCS)
+	z_spin_mcs_unlock(l);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+
+/* Internal function: tells whether some CPU holds the lock */
+static inline bool z_spin_is_locked(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPIN_LOCK_TICKET)
+	return atomic_get(&l->owner) != atomic_get(&l->next);
+#elif defined(CONFIG_SPIN_LOCK_MCS)
+	return atomic_get(&l->tail) != 0;
+#else
+	return atomic_get(&l->locked) != 0;
+#endif
+}
+#endif /* CONFIG_SMP */
+
 static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
@@ -79,8 +159,7 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
-	}
+	z_spin_acquire(l);
 #endif
 
 #ifdef SPIN_VALIDATE
@@ -98,14 +177,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_release(l);
 #endif
 	z_arch_irq_unlock(key.key);
 }
@@ -120,7 +192,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock!");
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_release(l);
 #endif
 }
 
@@ -46,6 +46,14 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * A histogram entry, declared with STATS_SECT_HIST(), is an array of
+ * 32-bit buckets and is named with STATS_NAME_HIST(); bucket k of
+ * histogram "name" is reported as "name_k".
+ *
+ * With CONFIG_STATS_PER_CPU, every CPU updates its own copy of the entries
+ * with its interrupts locked, and readers sum the copies with
+ * stats_value_get().  Entries can then no longer be read directly.
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_H_
@@ -53,6 +61,10 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#include <misc/util.h>
+#ifdef CONFIG_STATS_PER_CPU
+#include <kernel_structs.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -61,6 +73,8 @@ extern "C" {
 struct stats_name_map {
 	u16_t snm_off;
 	const char *snm_name;
+	/* number of histogram buckets, 0 for a plain entry */
+	u16_t snm_cnt;
 } __attribute__((packed));
 
 struct stats_hdr {
@@ -73,6 +87,9 @@ struct stats_hdr {
 	int s_map_cnt;
 #endif
 	struct stats_hdr *s_next;
+#ifdef CONFIG_STATS_BINARY
+	u32_t s_schema_id;
+#endif
 };
 
 /**
@@ -83,10 +100,23 @@ struct stats_hdr {
 #define STATS_SECT_DECL(group__) \
 	struct stats_ ## group__
 
+#ifdef CONFIG_STATS_PER_CPU
+#define Z_STATS_NUM_CPUS CONFIG_MP_NUM_CPUS
+/* Field of an entry in the copy of CPU 0 */
+#define Z_STATS_FIELD(var__) s_cpu[0].var__
+#else
+#define Z_STATS_NUM_CPUS 1
+#define Z_STATS_FIELD(var__) var__
+#endif
+
 /**
  * @brief Ends a stats group struct definition.
  */
+#if defined(CONFIG_STATS) && defined(CONFIG_STATS_PER_CPU)
+#define STATS_SECT_END } s_cpu[CONFIG_MP_NUM_CPUS]; }
+#else
 #define STATS_SECT_END }
+#endif
 
 /* The following macros depend on whether CONFIG_STATS is defined.  If it is
  * not defined, then invocations of these macros get compiled out.
@@ -98,9 +128,16 @@ struct stats_hdr {
  *
  * @param group__               The stats group struct name.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_SECT_START(group__)  \
+	STATS_SECT_DECL(group__) { \
+		struct stats_hdr s_hdr; \
+		struct {
+#else
 #define STATS_SECT_START(group__)  \
 	STATS_SECT_DECL(group__) { \
 		struct stats_hdr s_hdr;
+#endif
 
 /**
  * @brief Declares a 32-bit stat entry inside a group struct.
@@ -130,6 +167,17 @@ struct stats_hdr {
  */
 #define STATS_SECT_ENTRY64(var__) u64_t var__;
 
+/**
+ * @brief Declares a histogram of 32-bit buckets inside a group struct.
+ *
+ * Each bucket counts as one entry of the group, which must therefore use
+ * 32-bit entries.
+ *
+ * @param var__                 The name to assign to the histogram.
+ * @param n__                   The number of buckets.
+ */
+#define STATS_SECT_HIST(var__, n__) u32_t var__[n__];
+
 /**
  * @brief Increases a statistic entry by the specified amount.
  *
@@ -140,8 +188,17 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to increase the statistic entry by.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_INCN(group__, var__, n__)	do {				\
+	unsigned int key__ = z_arch_irq_lock();				\
+									\
+	(group__).s_cpu[_current_cpu->id].var__ += (n__);		\
+	z_arch_irq_unlock(key__);					\
+} while (false)
+#else
 #define STATS_INCN(group__, var__, n__)	\
 	((group__).var__ += (n__))
+#endif
 
 /**
  * @brief Increments a statistic entry.
@@ -164,8 +221,54 @@ struct stats_hdr {
  * @param group__               The group containing the entry to clear.
  * @param var__                 The statistic entry to clear.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_CLEAR(group__, var__) do {				\
+	for (int cpu__ = 0; cpu__ < CONFIG_MP_NUM_CPUS; cpu__++) {	\
+		(group__).s_cpu[cpu__].var__ = 0;			\
+	}								\
+} while (false)
+#else
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
+#endif
+
+/**
+ * @brief Increments a histogram bucket.
+ *
+ * Buckets past the last one are counted in the last one.
+ *
+ * @param group__               The group containing the histogram.
+ * @param var__                 The histogram.
+ * @param bucket__              The bucket to increment.
+ */
+#define STATS_HIST_INC(group__, var__, bucket__)			\
+	STATS_INCN(group__,						\
+		   var__[z_stats_bucket((bucket__),			\
+			ARRAY_SIZE((group__).Z_STATS_FIELD(var__)))], 1)
+
+/**
+ * @brief Counts a value in a histogram of powers of two.
+ *
+ * Bucket 0 counts the value 0 and bucket k the values of 2^(k-1) to
+ * 2^k - 1.
+ *
+ * @param group__               The group containing the histogram.
+ * @param var__                 The histogram.
+ * @param val__                 The 32-bit value to count.
+ */
+#define STATS_HIST_LOG2(group__, var__, val__)				\
+	STATS_HIST_INC(group__, var__, z_stats_log2_bucket(val__))
+
+static inline unsigned int z_stats_bucket(unsigned int bucket,
+					  unsigned int cnt)
+{
+	return MIN(bucket, cnt - 1);
+}
+
+static inline unsigned int z_stats_log2_bucket(u32_t val)
+{
+	return val ? 32 - __builtin_clz(val) : 0;
+}
 
 #define STATS_SIZE_16 (sizeof(u16_t))
 #define STATS_SIZE_32 (sizeof(u32_t))
@@ -173,7 +276,8 @@ struct stats_hdr {
 
 #define STATS_SIZE_INIT_PARMS(group__, size__) \
 	(size__),			       \
-	((sizeof(group__)) - sizeof(struct stats_hdr)) / (size__)
+	((sizeof(group__)) - sizeof(struct stats_hdr)) / (size__) /	\
+	Z_STATS_NUM_CPUS
 
 /**
  * @brief Initializes and registers a statistics group.
@@ -193,7 +297,8 @@ struct stats_hdr {
 	stats_init_and_reg(						 \
 		&(group__).s_hdr,					 \
 		(size__),						 \
-		(sizeof(group__) - sizeof(struct stats_hdr)) / (size__), \
+		(sizeof(group__) - sizeof(struct stats_hdr)) / (size__) / \
+		Z_STATS_NUM_CPUS,					 \
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
@@ -336,6 +441,56 @@ struct stats_hdr *stats_group_get_next(const struct stats_hdr *cur);
  */
 struct stats_hdr *stats_group_find(const char *name);
 
+/**
+ * @brief Reads a statistic entry.
+ *
+ * With CONFIG_STATS_PER_CPU, returns the sum of the copies of all CPUs.
+ *
+ * @param hdr                   The group containing the entry.
+ * @param off                   The offset of the entry, as passed to a
+ *                                  stats_walk_fn.
+ *
+ * @return                      The value of the entry.
+ */
+u64_t stats_value_get(const struct stats_hdr *hdr, u16_t off);
+
+#ifdef CONFIG_STATS_BINARY
+/**
+ * @brief Encodes the schema of a statistics group.
+ *
+ * The schema is sent once to a client, which then only polls the values
+ * encoded by stats_values_encode(); both carry the schema ID so that a
+ * client can detect a stale schema.  All fields are little endian:
+ *
+ * - u32_t schema ID, u8_t entry size, u16_t entry count,
+ * - one record per entry or histogram: u16_t number of entries covered,
+ *   u8_t name length, name without terminator.
+ *
+ * @param hdr                   The statistics group.
+ * @param buf                   The destination buffer.
+ * @param len                   The size of buf.
+ *
+ * @return                      The encoded length on success;
+ *                              -ENOMEM if buf is too small.
+ */
+int stats_schema_encode(const struct stats_hdr *hdr, u8_t *buf, size_t len);
+
+/**
+ * @brief Encodes the values of a statistics group.
+ *
+ * The encoding is the u32_t schema ID followed by the value of every entry,
+ * in the entry size of the group, all little endian.
+ *
+ * @param hdr                   The statistics group.
+ * @param buf                   The destination buffer.
+ * @param len                   The size of buf.
+ *
+ * @return                      The encoded length on success;
+ *                              -ENOMEM if buf is too small.
+ */
+int stats_values_encode(const struct stats_hdr *hdr, u8_t *buf, size_t len);
+#endif /* CONFIG_STATS_BINARY */
+
 #else /* CONFIG_STATS */
 
 #define STATS_SECT_START(group__) \
@@ -345,11 +500,14 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_SECT_ENTRY16(var__)
 #define STATS_SECT_ENTRY32(var__)
 #define STATS_SECT_ENTRY64(var__)
+#define STATS_SECT_HIST(var__, n__)
 #define STATS_RESET(var__)
 #define STATS_SIZE_INIT_PARMS(group__, size__)
 #define STATS_INCN(group__, var__, n__)
 #define STATS_INC(group__, var__)
 #define STATS_CLEAR(group__, var__)
+#define STATS_HIST_INC(group__, var__, bucket__)
+#define STATS_HIST_LOG2(group__, var__, val__)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
 
 #endif /* !CONFIG_STATS */
@@ -362,7 +520,14 @@ struct stats_hdr *stats_group_find(const char *name);
 	const struct stats_name_map STATS_NAME_MAP_NAME(sectname__)[] = {
 
 #define STATS_NAME(sectname__, entry__)	\
-	{ offsetof(STATS_SECT_DECL(sectname__), entry__), #entry__ },
+	{ offsetof(STATS_SECT_DECL(sectname__), Z_STATS_FIELD(entry__)), \
+	  #entry__ },
+
+#define STATS_NAME_HIST(sectname__, entry__)				\
+	{ offsetof(STATS_SECT_DECL(sectname__), Z_STATS_FIELD(entry__)), \
+	  #entry__,							\
+	  ARRAY_SIZE(((STATS_SECT_DECL(sectname__) *)0)->		\
+		     Z_STATS_FIELD(entry__)) },
 
 #define STATS_NAME_END(sectname__) }
 
@@ -374,6 +539,7 @@ struct stats_hdr *stats_group_find(const char *name);
 
 #define STATS_NAME_START(name__)
 #define STATS_NAME(name__, entry__)
+#define STATS_NAME_HIST(name__, entry__)
 #define STATS_NAME_END(name__)
 #define STATS_NAME_INIT_PARMS(name__) NULL, 0
 
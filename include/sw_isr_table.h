@@ -57,6 +57,10 @@ struct _isr_list {
 
 /** This interrupt gets put directly in the vector table */
 #define ISR_FLAG_DIRECT BIT(0)
+/* Regular ISR, but dispatched through an arch-specific per-IRQ
+ * trampoline placed in the vector table, see Z_ISR_TRAMPOLINE()
+ */
+#define ISR_FLAG_TRAMPOLINE BIT(1)
 
 #define _MK_ISR_NAME(x, y) __isr_ ## x ## _irq_ ## y
 
@@ -228,6 +228,39 @@ s64_t z_tick_get(void);
 #define z_tick_get_32() (0)
 #endif
 
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+/* Absolute timeouts carry the low 30 bits of their deadline tick */
+#define Z_TIMEOUT_ABS_FLAG 0x80000000U
+#define Z_TIMEOUT_ABS_MASK 0x3fffffffU
+
+static inline bool z_timeout_is_abs(s32_t timeout)
+{
+	/* Below K_FOREVER, not a valid relative timeout */
+	return timeout < -1;
+}
+
+/* Ticks left until an absolute timeout, zero or negative once passed */
+static inline s32_t z_timeout_abs_ticks_left(s32_t timeout)
+{
+	u32_t delta = ((u32_t)timeout - z_tick_get_32()) & Z_TIMEOUT_ABS_MASK;
+
+	/* Sign extend from 30 bits, deadlines are within 2^29 ticks */
+	return (s32_t)(delta << 2) >> 2;
+}
+#endif /* CONFIG_TIMEOUT_ABSOLUTE */
+
+/* Ticks to pass z_add_timeout() for a timeout other than K_FOREVER */
+static inline s32_t z_timeout_to_ticks(s32_t timeout)
+{
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+	if (z_timeout_is_abs(timeout)) {
+		return MAX(z_timeout_abs_ticks_left(timeout), 0);
+	}
+#endif
+
+	return _TICK_ALIGN + z_ms_to_ticks(timeout);
+}
+
 /* timeouts */
 
 struct _timeout;
@@ -237,6 +270,14 @@ struct _timeout {
 	sys_dnode_t node;
 	s32_t dticks;
 	_timeout_func_t fn;
+#ifdef CONFIG_TIMEOUT_WHEEL
+	/* Absolute expiry tick, wheel slots are derived from it */
+	u64_t expiry;
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be delayed to batch it with others */
+	s32_t slack;
+#endif
 };
 
 #ifdef __cplusplus
@@ -128,6 +128,18 @@ do {                                                                    \
 			__attribute__((long_call, section(".ramfunc")))
 #endif /* !CONFIG_XIP */
 
+/* '__hotfunc(fn)' marks the function fn as a candidate for RAM placement.
+ * Its calls are counted with CONFIG_TRACING_HOT_FUNCTIONS, and the ones
+ * listed in the linker fragment of CONFIG_RAMFUNC_HOT_LD are executed
+ * from RAM, the others from FLASH.
+ */
+#if defined(CONFIG_RAMFUNC_HOT_SECTIONS)
+#define __hotfunc(fn)	__attribute__((noinline))			\
+			__attribute__((long_call, section(".hottext." #fn)))
+#else
+#define __hotfunc(fn)
+#endif /* CONFIG_RAMFUNC_HOT_SECTIONS */
+
 #ifndef __packed
 #define __packed        __attribute__((__packed__))
 #endif
@@ -28,11 +28,15 @@
 #define ACM_SUBCLASS			0x02
 #define ECM_SUBCLASS			0x06
 #define EEM_SUBCLASS			0x0c
+#define NCM_SUBCLASS			0x0d
 
 /** Communications Class Protocol Codes */
 #define AT_CMD_V250_PROTOCOL		0x01
 #define EEM_PROTOCOL			0x07
 
+/** Data Class Protocol Codes */
+#define NCM_DATA_PROTOCOL		0x01
+
 /**
  * @brief Data Class Interface Codes
  * @note CDC120-20101103-track.pdf, 4.5, Table 6
@@ -56,6 +60,7 @@
 #define ACM_FUNC_DESC			0x02
 #define UNION_FUNC_DESC			0x06
 #define ETHERNET_FUNC_DESC		0x0F
+#define NCM_FUNC_DESC			0x1A
 
 /**
  * @brief PSTN Subclass Specific Requests
@@ -101,6 +106,29 @@
 #define SET_ETHERNET_PACKET_FILTER	0x43
 #define GET_ETHERNET_STATISTIC		0x44
 
+/**
+ * @brief Class-Specific Request Codes for NCM subclass
+ * @note NCM10.pdf, 6.2, Table 6-2
+ */
+#define GET_NTB_PARAMETERS		0x80
+#define GET_NET_ADDRESS			0x81
+#define SET_NET_ADDRESS			0x82
+#define GET_NTB_FORMAT			0x83
+#define SET_NTB_FORMAT			0x84
+#define GET_NTB_INPUT_SIZE		0x85
+#define SET_NTB_INPUT_SIZE		0x86
+#define GET_MAX_DATAGRAM_SIZE		0x87
+#define SET_MAX_DATAGRAM_SIZE		0x88
+#define GET_CRC_MODE			0x89
+#define SET_CRC_MODE			0x8A
+
+/**
+ * @brief Class-Specific Notification Codes for Ethernet and NCM subclasses
+ * @note ECM120.pdf, 6.3, Table 11
+ */
+#define NETWORK_CONNECTION		0x00
+#define CONNECTION_SPEED_CHANGE		0x2A
+
 /** Ethernet Packet Filter Bitmap */
 #define PACKET_TYPE_MULTICAST		0x10
 #define PACKET_TYPE_BROADCAST		0x08
@@ -172,4 +200,29 @@ struct cdc_ecm_descriptor {
 	u8_t bNumberPowerFilters;
 } __packed;
 
+/** NCM Functional Descriptor */
+struct cdc_ncm_descriptor {
+	u8_t bFunctionLength;
+	u8_t bDescriptorType;
+	u8_t bDescriptorSubtype;
+	u16_t bcdNcmVersion;
+	u8_t bmNetworkCapabilities;
+} __packed;
+
+/** Data structure for GET_NTB_PARAMETERS class request */
+struct cdc_ncm_ntb_parameters {
+	u16_t wLength;
+	u16_t bmNtbFormatsSupported;
+	u32_t dwNtbInMaxSize;
+	u16_t wNdpInDivisor;
+	u16_t wNdpInPayloadRemainder;
+	u16_t wNdpInAlignment;
+	u16_t wReserved;
+	u32_t dwNtbOutMaxSize;
+	u16_t wNdpOutDivisor;
+	u16_t wNdpOutPayloadRemainder;
+	u16_t wNdpOutAlignment;
+	u16_t wNtbOutMaxDatagrams;
+} __packed;
+
 #endif /* ZEPHYR_INCLUDE_USB_CLASS_USB_CDC_H_ */
@@ -38,6 +38,8 @@
 
 #include <drivers/usb/usb_dc.h>
 #include <usb/usbstruct.h>
+
+struct net_buf;
 #include <logging/log.h>
 
 #ifdef __cplusplus
@@ -364,6 +366,11 @@ void usb_transfer_ep_callback(u8_t ep, enum usb_dc_ep_cb_status_code);
  * and can be executed in IRQ context. The provided callback will be called
  * on transfer completion (or error) in thread context.
  *
+ * On controllers with CONFIG_USB_DC_HAS_XFER, the whole buffer is moved by
+ * the controller, with no interrupt per packet, and a second transfer on
+ * the endpoint is queued behind the ongoing one. Reads whose size is not a
+ * multiple of the endpoint's maximum packet size are moved packet by packet.
+ *
  * @param[in]  ep           Endpoint address corresponding to the one
  *                          listed in the device configuration table
  * @param[in]  data         Pointer to data buffer to write-to/read-from
@@ -377,6 +384,26 @@ void usb_transfer_ep_callback(u8_t ep, enum usb_dc_ep_cb_status_code);
 int usb_transfer(u8_t ep, u8_t *data, size_t dlen, unsigned int flags,
 		 usb_transfer_callback cb, void *priv);
 
+/**
+ * @brief Start a transfer of a network buffer
+ *
+ * As usb_transfer(), writing the data of the buffer, or reading into its
+ * tailroom, which the read data is then added to. The buffer is passed to
+ * the callback as @a priv, and belongs to the stack until then, or until
+ * it is unreferenced if the transfer is cancelled. If an error is returned,
+ * the buffer still belongs to the caller.
+ *
+ * @param[in]  ep           Endpoint address corresponding to the one
+ *                          listed in the device configuration table
+ * @param[in]  buf          Buffer to write or to read into
+ * @param[in]  flags        Transfer flags (USB_TRANS_READ, USB_TRANS_WRITE...)
+ * @param[in]  cb           Function called on transfer completion/failure
+ *
+ * @return 0 on success, negative errno code on fail.
+ */
+int usb_transfer_buf(u8_t ep, struct net_buf *buf, unsigned int flags,
+		     usb_transfer_callback cb);
+
 /**
  * @brief Start a transfer and block-wait for completion
  *
@@ -9,6 +9,11 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <kernel.h>
+
+#ifdef CONFIG_JWT_SIGN_RSA
+#include <mbedtls/pk.h>
+#endif
 
 /**
  * @brief JSON Web Token (JWT)
@@ -89,6 +94,162 @@ static inline size_t jwt_payload_len(struct jwt_builder *builder)
 	return (builder->buf - builder->base);
 }
 
+#ifdef CONFIG_JWT_SIGN_ECDSA
+/*
+ * Precomputed ECDSA nonce: r of the nonce point and the inverse of the
+ * nonce.  Used for a single signature.
+ */
+struct jwt_ecdsa_presig {
+	u32_t r[8];
+	u32_t k_inv[8];
+};
+#endif
+
+/**
+ * @brief JWT signing context.
+ *
+ * Keeps the key ready for signing tokens, so that reconnecting to a
+ * server does not parse it again.  With ECDSA, the nonces of the next
+ * signatures are precomputed, leaving only a few modular operations to
+ * sign a token.  Initialize it with jwt_signer_init().
+ */
+struct jwt_signer {
+	struct k_mutex lock;
+
+#ifdef CONFIG_JWT_SIGN_RSA
+	/* The parsed key. */
+	mbedtls_pk_context pk;
+#endif
+
+#ifdef CONFIG_JWT_SIGN_ECDSA
+	/* The P-256 private key. */
+	u8_t key[32];
+
+	/* Precomputed nonces, the first count of them valid. */
+	struct jwt_ecdsa_presig presig[CONFIG_JWT_ECDSA_PRESIGN];
+	unsigned int count;
+
+	/* Refills the precomputed nonces in the system workqueue. */
+	struct k_work refill;
+#endif
+};
+
+/**
+ * @brief Initialize a JWT signing context.
+ *
+ * @param signer The signing context to initialize.
+ * @param key The key, in DER format for RSA or the raw 32 byte private
+ * key for ECDSA, as for jwt_sign().  The key is parsed or copied, and
+ * need not be kept.
+ * @param key_len The length of the key.
+ *
+ * @retval 0 Success
+ * @retval -EINVAL The key is invalid
+ */
+int jwt_signer_init(struct jwt_signer *signer,
+		    const char *key,
+		    size_t key_len);
+
+/**
+ * @brief Precompute the ECDSA nonces of a signing context.
+ *
+ * Fills up the precomputed nonces, each costing the scalar
+ * multiplication of an ECDSA signature.  Call it ahead of signing, such
+ * as before connecting, the nonces being refilled in the system
+ * workqueue afterwards when CONFIG_JWT_ECDSA_PRESIGN_WORKQUEUE is set.
+ * Nothing to do with RSA.
+ *
+ * @param signer The signing context.
+ *
+ * @retval 0 Success
+ * @retval -EIO Random number generation failed
+ */
+int jwt_signer_precompute(struct jwt_signer *signer);
+
+/**
+ * @brief Sign the JWT token with a signing context.
+ *
+ * As jwt_sign(), with the key of the signing context.
+ */
+int jwt_signer_sign(struct jwt_signer *signer,
+		    struct jwt_builder *builder);
+
+/**
+ * @brief Release a JWT signing context.
+ *
+ * Clears the key and the precomputed nonces.  No refill may be pending.
+ */
+void jwt_signer_free(struct jwt_signer *signer);
+
+/**
+ * @brief Cache of a signed JWT token.
+ *
+ * Keeps the last token built by jwt_cache_get() for as long as it is
+ * valid.  Initialize it with jwt_cache_init().
+ */
+struct jwt_cache {
+	/** The buffer holding the token, NULL terminated. */
+	char *buf;
+
+	/** The size of this buffer. */
+	size_t size;
+
+	/** The length of the token. */
+	size_t len;
+
+	/** Expiration time of the token, 0 when there is none. */
+	s32_t exp;
+
+	/* Audience of the token. */
+	const char *aud;
+};
+
+/**
+ * @brief Initialize a JWT token cache.
+ *
+ * @param cache The cache to initialize.
+ * @param buffer The buffer to write the tokens to.
+ * @param buffer_size The size of this buffer.
+ */
+void jwt_cache_init(struct jwt_cache *cache,
+		    char *buffer,
+		    size_t buffer_size);
+
+/**
+ * @brief Get a valid JWT token.
+ *
+ * Returns the cached token when it is for the same audience and still
+ * valid CONFIG_JWT_CACHE_MARGIN seconds from now, or else builds and
+ * signs a new one.
+ *
+ * @param cache The token cache, holding the token in cache->buf on
+ * success.
+ * @param signer The signing context of new tokens.
+ * @param now The current time, the issue time of a new token.
+ * @param lifetime The time a new token is valid for, in seconds.
+ * @param aud The audience of the token, which must be kept as long as
+ * the token is cached.
+ *
+ * @retval 0 Success
+ * @retval -ENOMEM The buffer is too small for the token
+ * @retval <0 Signing the token failed
+ */
+int jwt_cache_get(struct jwt_cache *cache,
+		  struct jwt_signer *signer,
+		  s32_t now,
+		  s32_t lifetime,
+		  const char *aud);
+
+/**
+ * @brief Drop the cached JWT token.
+ *
+ * Such as when the server rejected it.
+ */
+static inline void jwt_cache_invalidate(struct jwt_cache *cache)
+{
+	cache->exp = 0;
+}
+
 /**
  * @}
  */
@@ -7,7 +7,9 @@
 #include <errno.h>
 #include <string.h>
 #include <device.h>
+#include <init.h>
 #include <misc/util.h>
+#include <misc/__assert.h>
 #include <atomic.h>
 #include <syscall_handler.h>
 
@@ -25,6 +27,272 @@ extern u32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+#ifdef CONFIG_BOOT_TIME_PROFILE
+/* Cycle counter at the start and the end of each init level */
+u32_t z_init_level_cycles[_SYS_INIT_LEVEL_APPLICATION + 1][2];
+
+/* Cycle counter at the start of the initialization of each device, and the
+ * cycles it took, in the order of the devices in memory
+ */
+u32_t z_device_init_cycles[CONFIG_BOOT_TIME_PROFILE_DEVICES][2];
+
+static inline void boot_profile_device(struct device *info, u32_t start)
+{
+	size_t i = info - __device_init_start;
+
+	if (i < ARRAY_SIZE(z_device_init_cycles)) {
+		z_device_init_cycles[i][0] = start;
+		z_device_init_cycles[i][1] = k_cycle_get_32() - start;
+	}
+}
+#endif
+
+static void device_init(struct device *info)
+{
+	struct device_config *device_conf = info->config;
+	int retval;
+#ifdef CONFIG_BOOT_TIME_PROFILE
+	u32_t start = k_cycle_get_32();
+#endif
+
+	retval = device_conf->init(info);
+#ifdef CONFIG_BOOT_TIME_PROFILE
+	boot_profile_device(info, start);
+#endif
+	if (retval != 0) {
+		/* Initialization failed. Clear the API struct so that
+		 * device_get_binding() will not succeed for it.
+		 */
+		info->driver_api = NULL;
+	} else {
+		z_object_init(info);
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_LAZY
+/* One bit per device, set once a lazy device went through initialization */
+extern u32_t __device_lazy_done_start[];
+
+static K_MUTEX_DEFINE(lazy_init_lock);
+static bool lazy_init_lock_usable;
+
+static inline bool device_is_lazy(struct device *info)
+{
+	return (info->config->init_flags & DEVICE_INIT_FLAG_LAZY) != 0U &&
+	       !atomic_test_bit((const atomic_t *)__device_lazy_done_start,
+				info - __device_init_start);
+}
+
+/* Before the kernel is up there is only one context, the lock is only
+ * needed from the POST_KERNEL level on.
+ */
+static struct device *device_lazy_init(struct device *info)
+{
+	if (lazy_init_lock_usable) {
+		__ASSERT(!k_is_in_isr(), "lazy device looked up from ISR");
+		k_mutex_lock(&lazy_init_lock, K_FOREVER);
+	}
+
+	if (device_is_lazy(info)) {
+		device_init(info);
+		atomic_set_bit((atomic_t *)__device_lazy_done_start,
+			       info - __device_init_start);
+	}
+
+	if (lazy_init_lock_usable) {
+		k_mutex_unlock(&lazy_init_lock);
+	}
+
+	return info->driver_api != NULL ? info : NULL;
+}
+#else
+static inline bool device_is_lazy(struct device *info)
+{
+	return false;
+}
+
+static inline struct device *device_lazy_init(struct device *info)
+{
+	return info;
+}
+#endif /* CONFIG_DEVICE_INIT_LAZY */
+
+#ifdef CONFIG_DEVICE_NAME_HASH
+#define NAME_HASH_SIZE	CONFIG_DEVICE_NAME_HASH_SIZE
+
+BUILD_ASSERT_MSG((NAME_HASH_SIZE & (NAME_HASH_SIZE - 1)) == 0,
+		 "DEVICE_NAME_HASH_SIZE must be a power of two");
+
+/* Open addressing table of the index + 1 of each device, by name hash.
+ * Devices of the same name are probed in their order in memory, as the
+ * linear search would find them.
+ */
+static u16_t name_hash_table[NAME_HASH_SIZE];
+static bool name_hash_ready;
+
+static u32_t name_hash(const char *name)
+{
+	u32_t hash = 5381U;
+
+	while (*name != '\0') {
+		hash = (hash * 33U) ^ (u8_t)*name++;
+	}
+
+	return hash;
+}
+
+/* Devices are never added after link time, the table is built once */
+static void name_hash_build(void)
+{
+	size_t count = __device_init_end - __device_init_start;
+	size_t i;
+	u32_t slot;
+
+	if (count >= NAME_HASH_SIZE) {
+		/* Keep the linear search, the table would not have room */
+		return;
+	}
+
+	for (i = 0; i < count; i++) {
+		slot = name_hash(__device_init_start[i].config->name);
+
+		while (name_hash_table[slot & (NAME_HASH_SIZE - 1)] != 0U) {
+			slot++;
+		}
+
+		name_hash_table[slot & (NAME_HASH_SIZE - 1)] = i + 1;
+	}
+
+	name_hash_ready = true;
+}
+
+/* Devices whose init failed are not found, those not initialized yet are */
+static inline bool device_is_usable(struct device *info)
+{
+	return info->driver_api != NULL || device_is_lazy(info);
+}
+
+static struct device *name_hash_lookup(const char *name)
+{
+	u32_t slot = name_hash(name);
+	struct device *info;
+	u16_t index;
+
+	while ((index = name_hash_table[slot & (NAME_HASH_SIZE - 1)]) != 0U) {
+		info = &__device_init_start[index - 1];
+
+		if (device_is_usable(info) &&
+		    (info->config->name == name ||
+		     strcmp(name, info->config->name) == 0)) {
+			return device_is_lazy(info) ?
+				device_lazy_init(info) : info;
+		}
+
+		slot++;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define INIT_THREADS	CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, INIT_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[INIT_THREADS];
+static K_SEM_DEFINE(init_start, 0, INIT_THREADS);
+static K_SEM_DEFINE(init_done, 0, INIT_THREADS);
+static bool init_threads_started;
+
+/* Run of consecutive parallel devices being initialized */
+static struct device *batch_start;
+static atomic_t batch_next;
+static atomic_val_t batch_len;
+
+static void batch_work(void)
+{
+	atomic_val_t i;
+
+	while ((i = atomic_inc(&batch_next)) < batch_len) {
+		device_init(&batch_start[i]);
+	}
+}
+
+static void init_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&init_start, K_FOREVER);
+		batch_work();
+		k_sem_give(&init_done);
+	}
+}
+
+/* The caller takes part in the batch, then waits for the threads to be
+ * done with it, so that every device of the batch is initialized when
+ * this returns.
+ */
+static void init_batch_run(struct device *start, struct device *end)
+{
+	int i;
+
+	if (end - start == 1) {
+		device_init(start);
+		return;
+	}
+
+	if (!init_threads_started) {
+		for (i = 0; i < INIT_THREADS; i++) {
+			k_thread_create(&init_threads[i], init_stacks[i],
+					K_THREAD_STACK_SIZEOF(init_stacks[i]),
+					init_thread_entry, NULL, NULL, NULL,
+					k_thread_priority_get(k_current_get()),
+					0, K_NO_WAIT);
+			k_thread_name_set(&init_threads[i], "devinit");
+		}
+		init_threads_started = true;
+	}
+
+	batch_start = start;
+	batch_len = end - start;
+	atomic_set(&batch_next, 0);
+
+	for (i = 0; i < INIT_THREADS; i++) {
+		k_sem_give(&init_start);
+	}
+
+	batch_work();
+
+	for (i = 0; i < INIT_THREADS; i++) {
+		k_sem_take(&init_done, K_FOREVER);
+	}
+}
+
+static void init_threads_stop(void)
+{
+	int i;
+
+	if (!init_threads_started) {
+		return;
+	}
+
+	for (i = 0; i < INIT_THREADS; i++) {
+		k_thread_abort(&init_threads[i]);
+	}
+	init_threads_started = false;
+}
+
+static inline bool device_is_parallel(struct device *info, s32_t level)
+{
+	return level >= _SYS_INIT_LEVEL_POST_KERNEL &&
+		(info->config->init_flags & DEVICE_INIT_FLAG_PARALLEL) != 0U;
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the device initialization functions at a given level
  *
@@ -34,6 +302,11 @@ extern u32_t __device_busy_end[];
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, runs of consecutive devices flagged
+ * DEVICE_INIT_FLAG_PARALLEL are initialized concurrently, and complete
+ * before the next device is initialized. Devices flagged
+ * DEVICE_INIT_FLAG_LAZY are skipped with CONFIG_DEVICE_INIT_LAZY.
+ *
  * @param level init level to run.
  */
 void z_sys_device_do_config_level(s32_t level)
@@ -48,45 +321,99 @@ void z_sys_device_do_config_level(s32_t level)
 		__device_init_end,
 	};
 
+#ifdef CONFIG_BOOT_TIME_PROFILE
+	z_init_level_cycles[level][0] = k_cycle_get_32();
+#endif
+
+#ifdef CONFIG_DEVICE_INIT_LAZY
+	if (level >= _SYS_INIT_LEVEL_POST_KERNEL) {
+		lazy_init_lock_usable = true;
+	}
+#endif
+
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (level == _SYS_INIT_LEVEL_PRE_KERNEL_1) {
+		name_hash_build();
+	}
+#endif
+
 	for (info = config_levels[level]; info < config_levels[level+1];
 								info++) {
-		int retval;
-		struct device_config *device_conf = info->config;
+		if (device_is_lazy(info)) {
+			continue;
+		}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if (device_is_parallel(info, level)) {
+			struct device *end = info + 1;
 
-		retval = device_conf->init(info);
-		if (retval != 0) {
-			/* Initialization failed. Clear the API struct so that
-			 * device_get_binding() will not succeed for it.
+			/* Lazy devices inside a run are left alone by
+			 * stopping the run there
 			 */
-			info->driver_api = NULL;
-		} else {
-			z_object_init(info);
+			while (end < config_levels[level+1] &&
+			       device_is_parallel(end, level) &&
+			       !device_is_lazy(end)) {
+				end++;
+			}
+
+			init_batch_run(info, end);
+			info = end - 1;
+			continue;
 		}
+#endif
+
+		device_init(info);
 	}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if (level == _SYS_INIT_LEVEL_APPLICATION) {
+		init_threads_stop();
+	}
+#endif
+
+#ifdef CONFIG_BOOT_TIME_PROFILE
+	z_init_level_cycles[level][1] = k_cycle_get_32();
+#endif
 }
 
 struct device *z_impl_device_get_binding(const char *name)
 {
 	struct device *info;
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (name_hash_ready) {
+		return name_hash_lookup(name);
+	}
+#endif
+
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
 	 * performed.  Reserve string comparisons for a fallback.
 	 */
 	for (info = __device_init_start; info != __device_init_end; info++) {
-		if ((info->driver_api != NULL) &&
-		    (info->config->name == name)) {
+		if (info->config->name != name) {
+			continue;
+		}
+
+		if (device_is_lazy(info)) {
+			return device_lazy_init(info);
+		}
+
+		if (info->driver_api != NULL) {
 			return info;
 		}
 	}
 
 	for (info = __device_init_start; info != __device_init_end; info++) {
-		if (info->driver_api == NULL) {
+		if (info->driver_api == NULL && !device_is_lazy(info)) {
 			continue;
 		}
 
 		if (strcmp(name, info->config->name) == 0) {
+			if (device_is_lazy(info)) {
+				return device_lazy_init(info);
+			}
 			return info;
 		}
 	}
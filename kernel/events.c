@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel event object.
+ *
+ * A set of 32 events that threads wait for, any or all of them. The
+ * poster checks the waiters itself and wakes exactly those whose wait it
+ * satisfies, so a woken thread does not have to recheck the events and
+ * wait again.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+#include <ksched.h>
+
+static bool wait_satisfied(u32_t events, u32_t wanted, u32_t options)
+{
+	u32_t match = events & wanted;
+
+	if ((options & K_EVENT_WAIT_ALL) != 0U) {
+		return match == wanted;
+	}
+
+	return match != 0U;
+}
+
+void k_event_init(struct k_event *event)
+{
+	event->events = 0U;
+	z_waitq_init(&event->wait_q);
+}
+
+u32_t k_event_post(struct k_event *event, u32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+	struct k_thread *woken = NULL, *thread, **tail = &woken;
+	u32_t seen, ret;
+
+	event->events |= events;
+
+	/* the waiters are visited in priority order, a waiter consuming its
+	 * events leaves them to none of those after it
+	 */
+	_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
+		if (!wait_satisfied(event->events, thread->events,
+				    thread->event_options)) {
+			continue;
+		}
+
+		seen = event->events;
+		if ((thread->event_options & K_EVENT_WAIT_CLEAR) != 0U) {
+			event->events &= ~thread->events;
+		}
+
+		thread->events = seen;
+		*tail = thread;
+		tail = &thread->next_event_link;
+	}
+
+	*tail = NULL;
+	ret = event->events;
+
+	/* the wait queue is not walked while threads leave it */
+	for (thread = woken; thread != NULL; thread = thread->next_event_link) {
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		z_set_thread_return_value(thread, 0);
+	}
+
+	z_reschedule(&event->lock, key);
+
+	return ret;
+}
+
+u32_t k_event_clear(struct k_event *event, u32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+	u32_t ret = event->events;
+
+	event->events &= ~events;
+	k_spin_unlock(&event->lock, key);
+
+	return ret;
+}
+
+u32_t k_event_wait(struct k_event *event, u32_t events, u32_t options,
+		   s32_t timeout)
+{
+	k_spinlock_key_t key;
+	u32_t ret;
+
+	__ASSERT(((z_is_in_isr() == false) || (timeout == K_NO_WAIT)), "");
+	__ASSERT(events != 0U, "no event to wait for");
+
+	key = k_spin_lock(&event->lock);
+
+	ret = event->events;
+	if (wait_satisfied(ret, events, options)) {
+		if ((options & K_EVENT_WAIT_CLEAR) != 0U) {
+			event->events &= ~events;
+		}
+
+		k_spin_unlock(&event->lock, key);
+		return ret;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&event->lock, key);
+		return 0U;
+	}
+
+	/* k_event_post() replaces them with the events it found */
+	_current->events = events;
+	_current->event_options = options;
+
+	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) != 0) {
+		return 0U;
+	}
+
+	return _current->events;
+}
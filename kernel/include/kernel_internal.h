@@ -28,6 +28,7 @@ extern "C" {
 void z_bss_zero(void);
 #ifdef CONFIG_XIP
 void z_data_copy(void);
+void z_early_memcpy(void *dst, const void *src, size_t n);
 #else
 static inline void z_data_copy(void)
 {
@@ -110,6 +110,14 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	u8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* threads queued to run on this CPU */
+	struct _ready_q ready_q;
+
+	/* protects ready_q and the queued state of its threads */
+	struct k_spinlock runq_lock;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -57,6 +57,7 @@ struct k_thread *z_find_first_thread_to_unpend(_wait_q_t *wait_q,
 void idle(void *a, void *b, void *c);
 void z_time_slice(int ticks);
 void z_sched_abort(struct k_thread *thread);
+void z_thread_reservation_abort(struct k_thread *thread);
 void z_sched_ipi(void);
 
 static inline void z_pend_curr_unlocked(_wait_q_t *wait_q, s32_t timeout)
@@ -90,12 +91,26 @@ static inline bool z_is_thread_pending(struct k_thread *thread)
 	return (thread->base.thread_state & _THREAD_PENDING) != 0U;
 }
 
+/* Ran out of its reservation budget, kept apart from _THREAD_SUSPENDED
+ * so k_thread_suspend() and k_thread_resume() don't interfere with it
+ */
+static inline bool z_is_thread_throttled(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	return thread->base.cbs.throttled != 0U;
+#else
+	ARG_UNUSED(thread);
+	return false;
+#endif
+}
+
 static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 {
 	u8_t state = thread->base.thread_state;
 
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
-			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
+			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U ||
+		z_is_thread_throttled(thread);
 
 }
 
@@ -16,6 +16,9 @@
 #include <misc/math_extras.h>
 #include <kernel_internal.h>
 #include <stdbool.h>
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+#include <kernel_structs.h>
+#endif
 
 extern const _k_syscall_handler_t _k_syscall_table[K_SYSCALL_LIMIT];
 
@@ -412,8 +415,80 @@ static inline int z_obj_validation_check(struct _k_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+/* Bumped whenever some permission is revoked or an object is freed,
+ * which invalidates every thread's handle table at once
+ */
+extern u32_t z_object_handles_gen;
+
+static inline struct _k_object_handle *z_object_handle_slot(void *obj)
+{
+	return &_current->obj_handles[((uintptr_t)obj >> 2) &
+				      (CONFIG_USERSPACE_OBJ_HANDLES_NUM - 1)];
+}
+
+/**
+ * Look up a kernel object in the calling thread's handle table
+ *
+ * @param obj Untrusted kernel object pointer
+ * @return Metadata of the object if the calling thread already passed a
+ *         permission check on it and nothing has been revoked since, NULL
+ *         otherwise
+ */
+static inline struct _k_object *z_object_handle_find(void *obj)
+{
+	struct _k_object_handle *h = z_object_handle_slot(obj);
+
+	if (likely(h->obj == obj && h->gen == z_object_handles_gen)) {
+		return h->ko;
+	}
+
+	return NULL;
+}
+#endif
+
+/* Validate a kernel object, from the calling thread's handle table when
+ * it is there.  Handles only vouch for the permission check: type and
+ * initialization state are checked on every call.
+ */
+static inline int z_obj_handle_validation_check(void *obj,
+						enum k_objects otype,
+						enum _obj_init_check init)
+{
+	struct _k_object *ko;
+	int ret;
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+	u32_t gen = z_object_handles_gen;
+
+	ko = z_object_handle_find(obj);
+	if (likely(ko != NULL && init == _OBJ_INIT_TRUE &&
+		   (otype == K_OBJ_ANY || ko->type == otype) &&
+		   (ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U)) {
+		return 0;
+	}
+#endif
+
+	ko = z_object_find(obj);
+	ret = z_obj_validation_check(ko, obj, otype, init);
+
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+	if (ret == 0) {
+		struct _k_object_handle *h = z_object_handle_slot(obj);
+
+		/* gen was sampled before the permission check, so a revoke
+		 * racing with it makes this entry stale right away
+		 */
+		h->obj = obj;
+		h->ko = ko;
+		h->gen = gen;
+	}
+#endif
+
+	return ret;
+}
+
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
-	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(z_object_find((void *)ptr), (void *)ptr, \
+	Z_SYSCALL_VERIFY_MSG(z_obj_handle_validation_check((void *)ptr, \
 				   type, init) == 0, "access denied")
 
 /**
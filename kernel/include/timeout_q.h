@@ -29,6 +29,30 @@ static inline void z_init_timeout(struct _timeout *t, _timeout_func_t fn)
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn,
+			 s32_t ticks, s32_t slack);
+
+static inline s32_t z_timeout_slack(struct _timeout *to)
+{
+	return to->slack;
+}
+#else
+static inline void z_add_timeout_slack(struct _timeout *to,
+				       _timeout_func_t fn, s32_t ticks,
+				       s32_t slack)
+{
+	ARG_UNUSED(slack);
+	z_add_timeout(to, fn, ticks);
+}
+
+static inline s32_t z_timeout_slack(struct _timeout *to)
+{
+	ARG_UNUSED(to);
+	return 0;
+}
+#endif
+
 int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(struct _timeout *t)
@@ -69,6 +69,9 @@ LOG_MODULE_REGISTER(kernel);
 u64_t __noinit __start_time_stamp; /* timestamp when kernel starts */
 u64_t __noinit __main_time_stamp;  /* timestamp when main task starts */
 u64_t __noinit __idle_time_stamp;  /* timestamp when CPU goes idle */
+/* cycles spent initializing devices at the POST_KERNEL/APPLICATION levels */
+u64_t __noinit __post_kernel_init_cycles;
+u64_t __noinit __application_init_cycles;
 #endif
 
 /* init/main and idle threads */
@@ -165,6 +168,21 @@ extern volatile uintptr_t __stack_chk_guard;
 
 
 #ifdef CONFIG_XIP
+/**
+ *
+ * @brief Copy a section from ROM to RAM at boot
+ *
+ * SoCs with a DMA controller usable before the kernel is initialized may
+ * override this routine to copy the data sections faster than the CPU.
+ * The copy must be complete on return.
+ *
+ * @return N/A
+ */
+void __weak z_early_memcpy(void *dst, const void *src, size_t n)
+{
+	(void)memcpy(dst, src, n);
+}
+
 /**
  *
  * @brief Copy the data section from ROM to RAM
@@ -175,14 +193,14 @@ extern volatile uintptr_t __stack_chk_guard;
  */
 void z_data_copy(void)
 {
-	(void)memcpy(&__data_ram_start, &__data_rom_start,
+	z_early_memcpy(&__data_ram_start, &__data_rom_start,
 		 __data_ram_end - __data_ram_start);
 #ifdef CONFIG_ARCH_HAS_RAMFUNC_SUPPORT
-	(void)memcpy(&_ramfunc_ram_start, &_ramfunc_rom_start,
+	z_early_memcpy(&_ramfunc_ram_start, &_ramfunc_rom_start,
 		 (uintptr_t) &_ramfunc_ram_size);
 #endif /* CONFIG_ARCH_HAS_RAMFUNC_SUPPORT */
 #ifdef DT_CCM_BASE_ADDRESS
-	(void)memcpy(&__ccm_data_start, &__ccm_data_rom_start,
+	z_early_memcpy(&__ccm_data_start, &__ccm_data_rom_start,
 		 __ccm_data_end - __ccm_data_start);
 #endif
 #ifdef CONFIG_CODE_DATA_RELOCATION
@@ -210,7 +228,7 @@ void z_data_copy(void)
 	}
 	__stack_chk_guard = guard_copy;
 #else
-	(void)memcpy(&_app_smem_start, &_app_smem_rom_start,
+	z_early_memcpy(&_app_smem_start, &_app_smem_rom_start,
 		 _app_smem_end - _app_smem_start);
 #endif /* CONFIG_STACK_CANARIES */
 #endif /* CONFIG_USERSPACE */
@@ -238,7 +256,14 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	static const unsigned int boot_delay;
 #endif
 
+#ifdef CONFIG_BOOT_TIME_MEASUREMENT
+	u32_t level_start = k_cycle_get_32();
+#endif
+
 	z_sys_device_do_config_level(_SYS_INIT_LEVEL_POST_KERNEL);
+#ifdef CONFIG_BOOT_TIME_MEASUREMENT
+	__post_kernel_init_cycles = k_cycle_get_32() - level_start;
+#endif
 #if CONFIG_STACK_POINTER_RANDOM
 	z_stack_adjust_initialized = 1;
 #endif
@@ -249,8 +274,19 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	}
 	PRINT_BOOT_BANNER();
 
+#ifdef CONFIG_BSS_LAZY
+	/* Left for after the devices needed by the system are initialized */
+	(void)memset(_lazy_bss_start, 0, _lazy_bss_end - _lazy_bss_start);
+#endif
+
 	/* Final init level before app starts */
+#ifdef CONFIG_BOOT_TIME_MEASUREMENT
+	level_start = k_cycle_get_32();
+#endif
 	z_sys_device_do_config_level(_SYS_INIT_LEVEL_APPLICATION);
+#ifdef CONFIG_BOOT_TIME_MEASUREMENT
+	__application_init_cycles = k_cycle_get_32() - level_start;
+#endif
 
 #ifdef CONFIG_CPLUSPLUS
 	/* Process the .ctors and .init_array sections */
@@ -17,14 +17,12 @@
 #include <wait_q.h>
 #include <misc/dlist.h>
 #include <init.h>
+#include <ksched.h>
 
 #if (CONFIG_NUM_MBOX_ASYNC_MSGS > 0)
 
-/* asynchronous message descriptor type */
-struct k_mbox_async {
-	struct _thread_base thread;		/* dummy thread object */
-	struct k_mbox_msg tx_msg;	/* transmit message descriptor */
-};
+/* array of asynchronous message descriptors */
+static struct k_mbox_async __noinit async_msg[CONFIG_NUM_MBOX_ASYNC_MSGS];
 
 /* stack of unused asynchronous message descriptors */
 K_STACK_DEFINE(async_msg_free, CONFIG_NUM_MBOX_ASYNC_MSGS);
@@ -41,8 +39,48 @@ static inline void mbox_async_free(struct k_mbox_async *async)
 	k_stack_push(&async_msg_free, (u32_t)async);
 }
 
+/* check if an asynchronous message descriptor is one of the array */
+static inline bool mbox_async_is_pooled(struct k_mbox_async *async)
+{
+	return async >= async_msg &&
+	       async < async_msg + CONFIG_NUM_MBOX_ASYNC_MSGS;
+}
+
 #endif /* CONFIG_NUM_MBOX_ASYNC_MSGS > 0 */
 
+#if (CONFIG_MBOX_TARGET_QUEUES > 0)
+static void mbox_target_queues_init(struct k_mbox *mbox)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_MBOX_TARGET_QUEUES; i++) {
+		z_waitq_init(&mbox->tx_target_queue[i]);
+	}
+}
+
+/* get the queue of the senders to a given thread */
+static inline _wait_q_t *mbox_target_queue(struct k_mbox *mbox,
+					   k_tid_t thread)
+{
+	return &mbox->tx_target_queue[((uintptr_t)thread /
+				       sizeof(struct k_thread)) %
+				      CONFIG_MBOX_TARGET_QUEUES];
+}
+#endif /* CONFIG_MBOX_TARGET_QUEUES > 0 */
+
+/* get the queue a sender waits on for a receiver */
+static inline _wait_q_t *mbox_tx_queue(struct k_mbox *mbox,
+				       struct k_mbox_msg *tx_msg)
+{
+#if (CONFIG_MBOX_TARGET_QUEUES > 0)
+	if (tx_msg->tx_target_thread != (k_tid_t)K_ANY) {
+		return mbox_target_queue(mbox, tx_msg->tx_target_thread);
+	}
+#endif
+
+	return &mbox->tx_msg_queue;
+}
+
 extern struct k_mbox _k_mbox_list_start[];
 extern struct k_mbox _k_mbox_list_end[];
 
@@ -51,6 +89,7 @@ struct k_mbox *_trace_list_k_mbox;
 #endif	/* CONFIG_OBJECT_TRACING */
 
 #if (CONFIG_NUM_MBOX_ASYNC_MSGS > 0) || \
+	(CONFIG_MBOX_TARGET_QUEUES > 0) || \
 	defined(CONFIG_OBJECT_TRACING)
 
 /*
@@ -60,9 +99,6 @@ static int init_mbox_module(struct device *dev)
 {
 	ARG_UNUSED(dev);
 
-	/* array of asynchronous message descriptors */
-	static struct k_mbox_async __noinit async_msg[CONFIG_NUM_MBOX_ASYNC_MSGS];
-
 #if (CONFIG_NUM_MBOX_ASYNC_MSGS > 0)
 	/*
 	 * Create pool of asynchronous message descriptors.
@@ -86,25 +122,33 @@ static int init_mbox_module(struct device *dev)
 
 	/* Complete initialization of statically defined mailboxes. */
 
-#ifdef CONFIG_OBJECT_TRACING
+#if (CONFIG_MBOX_TARGET_QUEUES > 0) || defined(CONFIG_OBJECT_TRACING)
 	struct k_mbox *mbox;
 
 	for (mbox = _k_mbox_list_start; mbox < _k_mbox_list_end; mbox++) {
+#if (CONFIG_MBOX_TARGET_QUEUES > 0)
+		mbox_target_queues_init(mbox);
+#endif
 		SYS_TRACING_OBJ_INIT(k_mbox, mbox);
 	}
-#endif /* CONFIG_OBJECT_TRACING */
+#endif /* CONFIG_MBOX_TARGET_QUEUES > 0 || CONFIG_OBJECT_TRACING */
 
 	return 0;
 }
 
 SYS_INIT(init_mbox_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
-#endif /* CONFIG_NUM_MBOX_ASYNC_MSGS or CONFIG_OBJECT_TRACING */
+#endif /* CONFIG_NUM_MBOX_ASYNC_MSGS, CONFIG_MBOX_TARGET_QUEUES or
+	* CONFIG_OBJECT_TRACING
+	*/
 
 void k_mbox_init(struct k_mbox *mbox_ptr)
 {
 	z_waitq_init(&mbox_ptr->tx_msg_queue);
 	z_waitq_init(&mbox_ptr->rx_msg_queue);
+#if (CONFIG_MBOX_TARGET_QUEUES > 0)
+	mbox_target_queues_init(mbox_ptr);
+#endif
 	mbox_ptr->lock = (struct k_spinlock) {};
 	SYS_TRACING_OBJ_INIT(k_mbox, mbox_ptr);
 }
@@ -112,6 +156,23 @@ void k_mbox_init(struct k_mbox *mbox_ptr)
 /**
  * @brief Check compatibility of sender's and receiver's message descriptors.
  *
+ * @param tx_msg Pointer to transmit message descriptor.
+ * @param rx_msg Pointer to receive message descriptor.
+ *
+ * @return true if the descriptors are compatible, otherwise false.
+ */
+static bool mbox_message_compatible(struct k_mbox_msg *tx_msg,
+				    struct k_mbox_msg *rx_msg)
+{
+	return ((tx_msg->tx_target_thread == (k_tid_t)K_ANY) ||
+		(tx_msg->tx_target_thread == rx_msg->tx_target_thread)) &&
+	       ((rx_msg->rx_source_thread == (k_tid_t)K_ANY) ||
+		(rx_msg->rx_source_thread == tx_msg->rx_source_thread));
+}
+
+/**
+ * @brief Match sender's and receiver's message descriptors.
+ *
  * Compares sender's and receiver's message descriptors to see if they are
  * compatible. If so, the descriptor fields are updated to reflect that a
  * match has occurred.
@@ -126,10 +187,7 @@ static int mbox_message_match(struct k_mbox_msg *tx_msg,
 {
 	u32_t temp_info;
 
-	if (((tx_msg->tx_target_thread == (k_tid_t)K_ANY) ||
-	     (tx_msg->tx_target_thread == rx_msg->tx_target_thread)) &&
-	    ((rx_msg->rx_source_thread == (k_tid_t)K_ANY) ||
-	     (rx_msg->rx_source_thread == tx_msg->rx_source_thread))) {
+	if (mbox_message_compatible(tx_msg, rx_msg)) {
 
 		/* update thread identifier fields for both descriptors */
 		rx_msg->rx_source_thread = tx_msg->rx_source_thread;
@@ -205,9 +263,14 @@ static void mbox_message_dispose(struct k_mbox_msg *rx_msg)
 	 * dummy thread pair, then give semaphore (if needed)
 	 */
 	if ((sending_thread->base.thread_state & _THREAD_DUMMY) != 0U) {
+		struct k_mbox_async *async =
+			(struct k_mbox_async *)sending_thread;
 		struct k_sem *async_sem = tx_msg->_async_sem;
 
-		mbox_async_free((struct k_mbox_async *)sending_thread);
+		if (mbox_async_is_pooled(async)) {
+			mbox_async_free(async);
+		}
+
 		if (async_sem != NULL) {
 			k_sem_give(async_sem);
 		}
@@ -222,6 +285,85 @@ static void mbox_message_dispose(struct k_mbox_msg *rx_msg)
 	z_reschedule_unlocked();
 }
 
+/**
+ * @brief Find a compatible receiver for a message.
+ *
+ * A message to a given thread can only be received by that thread, which
+ * is checked directly rather than searched for in the rx queue.
+ *
+ * @param mbox Pointer to the mailbox object.
+ * @param tx_msg Pointer to transmit message descriptor.
+ *
+ * @return Receiving thread, or NULL if none is compatible.
+ */
+static struct k_thread *mbox_receiver_find(struct k_mbox *mbox,
+					   struct k_mbox_msg *tx_msg)
+{
+	struct k_thread *receiving_thread = tx_msg->tx_target_thread;
+
+	if (receiving_thread != (k_tid_t)K_ANY) {
+		if (receiving_thread->base.pended_on == &mbox->rx_msg_queue &&
+		    mbox_message_compatible(tx_msg,
+					    receiving_thread->base.swap_data)) {
+			return receiving_thread;
+		}
+
+		return NULL;
+	}
+
+	_WAIT_Q_FOR_EACH(&mbox->rx_msg_queue, receiving_thread) {
+		if (mbox_message_compatible(tx_msg,
+					    receiving_thread->base.swap_data)) {
+			return receiving_thread;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Find a compatible sender for a receiver.
+ *
+ * Only the senders to any thread, and those to the receiver if they are
+ * queued apart, are looked through. The first compatible one of each
+ * queue is found, and the one of higher priority is taken.
+ *
+ * @param mbox Pointer to the mailbox object.
+ * @param rx_msg Pointer to receive message descriptor.
+ *
+ * @return Sending thread (actual or dummy), or NULL if none is compatible.
+ */
+static struct k_thread *mbox_sender_find(struct k_mbox *mbox,
+					 struct k_mbox_msg *rx_msg)
+{
+	struct k_thread *sending_thread, *found = NULL;
+
+	_WAIT_Q_FOR_EACH(&mbox->tx_msg_queue, sending_thread) {
+		if (mbox_message_compatible(sending_thread->base.swap_data,
+					    rx_msg)) {
+			found = sending_thread;
+			break;
+		}
+	}
+
+#if (CONFIG_MBOX_TARGET_QUEUES > 0)
+	_WAIT_Q_FOR_EACH(mbox_target_queue(mbox, rx_msg->tx_target_thread),
+			 sending_thread) {
+		if (mbox_message_compatible(sending_thread->base.swap_data,
+					    rx_msg)) {
+			if (found == NULL ||
+			    !z_is_t1_higher_prio_than_t2(found,
+							 sending_thread)) {
+				found = sending_thread;
+			}
+			break;
+		}
+	}
+#endif
+
+	return found;
+}
+
 /**
  * @brief Send a mailbox message.
  *
@@ -254,39 +396,37 @@ static int mbox_message_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 	/* search mailbox's rx queue for a compatible receiver */
 	key = k_spin_lock(&mbox->lock);
 
-	_WAIT_Q_FOR_EACH(&mbox->rx_msg_queue, receiving_thread) {
+	receiving_thread = mbox_receiver_find(mbox, tx_msg);
+	if (receiving_thread != NULL) {
 		rx_msg = (struct k_mbox_msg *)receiving_thread->base.swap_data;
+		(void)mbox_message_match(tx_msg, rx_msg);
 
-		if (mbox_message_match(tx_msg, rx_msg) == 0) {
-			/* take receiver out of rx queue */
-			z_unpend_thread(receiving_thread);
+		/* take receiver out of rx queue */
+		z_unpend_thread(receiving_thread);
 
-			/* ready receiver for execution */
-			z_set_thread_return_value(receiving_thread, 0);
-			z_ready_thread(receiving_thread);
+		/* ready receiver for execution */
+		z_set_thread_return_value(receiving_thread, 0);
+		z_ready_thread(receiving_thread);
 
 #if (CONFIG_NUM_MBOX_ASYNC_MSGS > 0)
-			/*
-			 * asynchronous send: swap out current thread
-			 * if receiver has priority, otherwise let it continue
-			 *
-			 * note: dummy sending thread sits (unqueued)
-			 * until the receiver consumes the message
-			 */
-			if ((sending_thread->base.thread_state & _THREAD_DUMMY)
-			    != 0U) {
-				z_reschedule(&mbox->lock, key);
-				return 0;
-			}
+		/*
+		 * asynchronous send: swap out current thread
+		 * if receiver has priority, otherwise let it continue
+		 *
+		 * note: dummy sending thread sits (unqueued)
+		 * until the receiver consumes the message
+		 */
+		if ((sending_thread->base.thread_state & _THREAD_DUMMY) != 0U) {
+			z_reschedule(&mbox->lock, key);
+			return 0;
+		}
 #endif
 
-			/*
-			 * synchronous send: pend current thread (unqueued)
-			 * until the receiver consumes the message
-			 */
-			return z_pend_curr(&mbox->lock, key, NULL, K_FOREVER);
-
-		}
+		/*
+		 * synchronous send: pend current thread (unqueued)
+		 * until the receiver consumes the message
+		 */
+		return z_pend_curr(&mbox->lock, key, NULL, K_FOREVER);
 	}
 
 	/* didn't find a matching receiver: don't wait for one */
@@ -298,14 +438,16 @@ static int mbox_message_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 #if (CONFIG_NUM_MBOX_ASYNC_MSGS > 0)
 	/* asynchronous send: dummy thread waits on tx queue for receiver */
 	if ((sending_thread->base.thread_state & _THREAD_DUMMY) != 0U) {
-		z_pend_thread(sending_thread, &mbox->tx_msg_queue, K_FOREVER);
+		z_pend_thread(sending_thread, mbox_tx_queue(mbox, tx_msg),
+			      K_FOREVER);
 		k_spin_unlock(&mbox->lock, key);
 		return 0;
 	}
 #endif
 
 	/* synchronous send: sender waits on tx queue for receiver or timeout */
-	return z_pend_curr(&mbox->lock, key, &mbox->tx_msg_queue, timeout);
+	return z_pend_curr(&mbox->lock, key, mbox_tx_queue(mbox, tx_msg),
+			   timeout);
 }
 
 int k_mbox_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg, s32_t timeout)
@@ -336,6 +478,18 @@ void k_mbox_async_put(struct k_mbox *mbox, struct k_mbox_msg *tx_msg,
 
 	(void)mbox_message_put(mbox, &async->tx_msg, K_FOREVER);
 }
+
+void k_mbox_async_msg_put(struct k_mbox *mbox, struct k_mbox_async *async,
+			  struct k_sem *sem)
+{
+	z_init_thread_base(&async->thread, _current->base.prio, _THREAD_DUMMY,
+			   0);
+
+	async->tx_msg._syncing_thread = (struct k_thread *)&async->thread;
+	async->tx_msg._async_sem = sem;
+
+	(void)mbox_message_put(mbox, &async->tx_msg, K_FOREVER);
+}
 #endif
 
 void k_mbox_data_get(struct k_mbox_msg *rx_msg, void *buffer)
@@ -433,18 +587,18 @@ int k_mbox_get(struct k_mbox *mbox, struct k_mbox_msg *rx_msg, void *buffer,
 	/* search mailbox's tx queue for a compatible sender */
 	key = k_spin_lock(&mbox->lock);
 
-	_WAIT_Q_FOR_EACH(&mbox->tx_msg_queue, sending_thread) {
+	sending_thread = mbox_sender_find(mbox, rx_msg);
+	if (sending_thread != NULL) {
 		tx_msg = (struct k_mbox_msg *)sending_thread->base.swap_data;
+		(void)mbox_message_match(tx_msg, rx_msg);
 
-		if (mbox_message_match(tx_msg, rx_msg) == 0) {
-			/* take sender out of mailbox's tx queue */
-			z_unpend_thread(sending_thread);
+		/* take sender out of mailbox's tx queue */
+		z_unpend_thread(sending_thread);
 
-			k_spin_unlock(&mbox->lock, key);
+		k_spin_unlock(&mbox->lock, key);
 
-			/* consume message data immediately, if needed */
-			return mbox_message_data_check(rx_msg, buffer);
-		}
+		/* consume message data immediately, if needed */
+		return mbox_message_data_check(rx_msg, buffer);
 	}
 
 	/* didn't find a matching sender */
@@ -13,6 +13,7 @@
 #include <misc/dlist.h>
 #include <ksched.h>
 #include <init.h>
+#include <string.h>
 
 extern struct k_mem_slab _k_mem_slab_list_start[];
 extern struct k_mem_slab _k_mem_slab_list_end[];
@@ -72,6 +73,244 @@ static int init_mem_slab_module(struct device *dev)
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+/*
+ * The cache of a CPU is used by that CPU with local interrupts locked,
+ * so the thread can't migrate meanwhile, and under its own lock, which
+ * only an allocation waiting on an empty slab takes from another CPU, to
+ * steal the blocks.  The slab lock is taken to move a batch of blocks
+ * between a cache and the slab, and never while holding a cache lock.
+ *
+ * A thread about to wait counts itself in slab->cache_waiters and steals
+ * the blocks of all caches first.  A free seeing a waiter goes to the slab
+ * instead of the cache, and blocks moved while the count was read as 0
+ * are handed to the waiters when they reach the slab, so no thread waits
+ * while blocks are free.
+ */
+static inline struct _mem_slab_cpu_cache *cpu_cache(struct k_mem_slab *slab)
+{
+	return &slab->cpu_cache[_current_cpu->id];
+}
+
+/*
+ * Returns a chain of blocks to the slab, giving them to waiting threads
+ * first.  Called with the slab lock held, which it releases.
+ */
+static void slab_put_chain(struct k_mem_slab *slab, char *chain, u32_t count,
+			   k_spinlock_key_t key)
+{
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	while (chain != NULL) {
+		char *block = chain;
+
+		chain = *(char **)block;
+
+		pending_thread = z_unpend_first_thread(&slab->wait_q);
+		if (pending_thread != NULL) {
+			/* stays used, by the thread */
+			z_set_thread_return_value_with_data(pending_thread, 0,
+							    block);
+			z_ready_thread(pending_thread);
+			woken = true;
+			count--;
+		} else {
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+		}
+	}
+
+	slab->num_used -= count;
+
+	if (woken) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+}
+
+/* Takes up to max blocks off a cache, must be called with its lock held */
+static char *cache_take_chain(struct _mem_slab_cpu_cache *cache, u32_t max,
+			      u32_t *count)
+{
+	char *chain = cache->free_list;
+	char **tail = &chain;
+	u32_t n;
+
+	for (n = 0U; n < max && *tail != NULL; n++) {
+		tail = (char **)*tail;
+	}
+
+	cache->free_list = *tail;
+	*tail = NULL;
+	cache->count -= n;
+	*count = n;
+
+	return chain;
+}
+
+/*
+ * Moves the blocks of all CPU caches to the slab, for an allocation that
+ * found it empty.  Must be called with the slab lock held.
+ */
+static void cache_steal_all(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct _mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+		u32_t count;
+		char *chain = cache_take_chain(cache, UINT32_MAX, &count);
+
+		k_spin_unlock(&cache->lock, key);
+
+		while (chain != NULL) {
+			char *block = chain;
+
+			chain = *(char **)block;
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+		}
+
+		slab->num_used -= count;
+	}
+}
+
+/* must be called with local interrupts locked */
+static char *cache_refill(struct k_mem_slab *slab, u32_t *count)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	char *chain = NULL;
+	u32_t moved = 0U;
+
+	while (slab->free_list != NULL && moved < CACHE_BATCH) {
+		char *block = slab->free_list;
+
+		slab->free_list = *(char **)block;
+		*(char **)block = chain;
+		chain = block;
+		moved++;
+	}
+
+	slab->num_used += moved;
+	k_spin_unlock(&lock, key);
+
+	*count = moved;
+
+	return chain;
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = z_arch_irq_lock();
+	struct _mem_slab_cpu_cache *cache = cpu_cache(slab);
+	k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+	char *chain = NULL;
+	u32_t count = 0U;
+
+	if (cache->count != 0U) {
+		cache->hits++;
+	} else {
+		k_spin_unlock(&cache->lock, ckey);
+		chain = cache_refill(slab, &count);
+		ckey = k_spin_lock(&cache->lock);
+
+		if (chain != NULL) {
+			char **tail = &chain;
+
+			while (*tail != NULL) {
+				tail = (char **)*tail;
+			}
+
+			*tail = cache->free_list;
+			cache->free_list = chain;
+			cache->count += count;
+			cache->refills++;
+		}
+	}
+
+	if (cache->count == 0U) {
+		k_spin_unlock(&cache->lock, ckey);
+		z_arch_irq_unlock(key);
+		return false;
+	}
+
+	*mem = cache->free_list;
+	cache->free_list = *(char **)(cache->free_list);
+	cache->count--;
+	cache->allocs++;
+
+	/* a thread started waiting while the batch was on its way here */
+	chain = NULL;
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		chain = cache_take_chain(cache, UINT32_MAX, &count);
+	}
+
+	k_spin_unlock(&cache->lock, ckey);
+	z_arch_irq_unlock(key);
+
+	/* the chain is ours, the CPU does not matter anymore */
+	if (chain != NULL) {
+		slab_put_chain(slab, chain, count, k_spin_lock(&lock));
+	}
+
+	return true;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = z_arch_irq_lock();
+	struct _mem_slab_cpu_cache *cache = cpu_cache(slab);
+	k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+	char *chain = NULL;
+	u32_t count = 0U;
+
+	/* waiting threads are served by the slab itself */
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		k_spin_unlock(&cache->lock, ckey);
+		z_arch_irq_unlock(key);
+		return false;
+	}
+
+	if (cache->count == CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		chain = cache_take_chain(cache, CACHE_BATCH, &count);
+		cache->flushes++;
+	}
+
+	**(char ***)mem = cache->free_list;
+	cache->free_list = *(char **)mem;
+	cache->count++;
+
+	k_spin_unlock(&cache->lock, ckey);
+	z_arch_irq_unlock(key);
+
+	/* the chain is ours, the CPU does not matter anymore */
+	if (chain != NULL) {
+		slab_put_chain(slab, chain, count, k_spin_lock(&lock));
+	}
+
+	return true;
+}
+
+void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				struct k_mem_slab_cache_stats *stats)
+{
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct _mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		stats->allocs += cache->allocs;
+		stats->hits += cache->hits;
+		stats->refills += cache->refills;
+		stats->flushes += cache->flushes;
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, u32_t num_blocks)
 {
@@ -83,6 +322,10 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0U;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_clear(&slab->cache_waiters);
+	(void)memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif
 	create_free_list(slab);
 	z_waitq_init(&slab->wait_q);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
@@ -92,19 +335,43 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
-	int result;
-
 	/* block size must be word aligned */
 	__ASSERT((slab->block_size & (sizeof(void *) - 1)) == 0,
 		 "block size not word aligned");
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		return 0;
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int result;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	bool waiter = false;
+
+	if (slab->free_list == NULL) {
+		/* counted first, so that frees go to the slab from now on */
+		if (timeout != K_NO_WAIT) {
+			(void)atomic_inc(&slab->cache_waiters);
+			waiter = true;
+		}
+		cache_steal_all(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
 		result = 0;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		if (waiter) {
+			(void)atomic_dec(&slab->cache_waiters);
+		}
+#endif
 	} else if (timeout == K_NO_WAIT) {
 		/* don't wait for a free block to become available */
 		*mem = NULL;
@@ -115,6 +382,9 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 		if (result == 0) {
 			*mem = _current->base.swap_data;
 		}
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		(void)atomic_dec(&slab->cache_waiters);
+#endif
 		return result;
 	}
 
@@ -125,6 +395,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_free(slab, mem)) {
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
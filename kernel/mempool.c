@@ -95,6 +95,16 @@ int k_mem_pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 
 		z_pend_curr_unlocked(&p->wait_q, timeout);
 
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+		if (z_timeout_is_abs(timeout)) {
+			if (z_timeout_abs_ticks_left(timeout) <= 0) {
+				break;
+			}
+
+			continue;
+		}
+#endif
+
 		if (timeout != K_FOREVER) {
 			timeout = end - z_tick_get();
 
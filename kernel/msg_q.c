@@ -247,6 +247,210 @@ Z_SYSCALL_HANDLER(k_msgq_get, msgq_p, data, timeout)
 }
 #endif
 
+/* Copy @a n messages to the ring buffer, which must have room for them */
+static void msgq_ring_put(struct k_msgq *q, const char *src, u32_t n)
+{
+	size_t len = n * q->msg_size;
+	size_t run = MIN(len, (size_t)(q->buffer_end - q->write_ptr));
+
+	(void)memcpy(q->write_ptr, src, run);
+	(void)memcpy(q->buffer_start, src + run, len - run);
+
+	q->write_ptr = (run < len) ? q->buffer_start + (len - run) :
+		       q->write_ptr + run;
+	if (q->write_ptr == q->buffer_end) {
+		q->write_ptr = q->buffer_start;
+	}
+	q->used_msgs += n;
+}
+
+/* Copy the @a n oldest messages out of the ring buffer */
+static void msgq_ring_get(struct k_msgq *q, char *dest, u32_t n)
+{
+	size_t len = n * q->msg_size;
+	size_t run = MIN(len, (size_t)(q->buffer_end - q->read_ptr));
+
+	(void)memcpy(dest, q->read_ptr, run);
+	(void)memcpy(dest + run, q->buffer_start, len - run);
+
+	q->read_ptr = (run < len) ? q->buffer_start + (len - run) :
+		      q->read_ptr + run;
+	if (q->read_ptr == q->buffer_end) {
+		q->read_ptr = q->buffer_start;
+	}
+	q->used_msgs -= n;
+}
+
+/* Sends what can be sent without waiting, with the lock held.  Threads
+ * pending on a queue which isn't full are receivers, and the queue is
+ * then empty, so they get the first messages.
+ */
+static u32_t msgq_put_batch(struct k_msgq *q, const char *data, u32_t num,
+			    bool *woken)
+{
+	struct k_thread *pending_thread;
+	u32_t n = 0U, room;
+
+	while (n < num && q->used_msgs < q->max_msgs &&
+	       (pending_thread = z_unpend_first_thread(&q->wait_q)) != NULL) {
+		(void)memcpy(pending_thread->base.swap_data,
+			     data + n * q->msg_size, q->msg_size);
+		z_set_thread_return_value(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		*woken = true;
+		n++;
+	}
+
+	room = MIN(num - n, q->max_msgs - q->used_msgs);
+	if (room > 0) {
+		msgq_ring_put(q, data + n * q->msg_size, room);
+		n += room;
+	}
+
+	return n;
+}
+
+/* Receives what is available, with the lock held, then moves the
+ * messages of waiting senders into the freed space
+ */
+static u32_t msgq_get_batch(struct k_msgq *q, char *data, u32_t num,
+			    bool *woken)
+{
+	struct k_thread *pending_thread;
+	u32_t n = MIN(num, q->used_msgs);
+
+	if (n == 0U) {
+		return 0;
+	}
+
+	msgq_ring_get(q, data, n);
+
+	while (q->used_msgs < q->max_msgs &&
+	       (pending_thread = z_unpend_first_thread(&q->wait_q)) != NULL) {
+		msgq_ring_put(q, pending_thread->base.swap_data, 1);
+		z_set_thread_return_value(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		*woken = true;
+	}
+
+	return n;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *q, const void *data,
+			   u32_t num_msgs, s32_t timeout)
+{
+	__ASSERT(!z_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	bool woken = false;
+	u32_t n;
+	int ret;
+
+	if (num_msgs == 0U) {
+		k_spin_unlock(&q->lock, key);
+		return 0;
+	}
+
+	n = msgq_put_batch(q, data, num_msgs, &woken);
+	if (n == 0U) {
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&q->lock, key);
+			return -ENOMSG;
+		}
+
+		/* Wait to send the first one like k_msgq_put(), then
+		 * send whatever else fits
+		 */
+		_current->base.swap_data = (void *)data;
+		ret = z_pend_curr(&q->lock, key, &q->wait_q, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+
+		key = k_spin_lock(&q->lock);
+		n = 1U + msgq_put_batch(q, (const char *)data + q->msg_size,
+					num_msgs - 1U, &woken);
+	}
+
+	if (woken) {
+		z_reschedule(&q->lock, key);
+	} else {
+		k_spin_unlock(&q->lock, key);
+	}
+
+	return n;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_put_many, msgq_p, data, num_msgs, timeout)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_put_many(q, (const void *)data, num_msgs,
+				      timeout);
+}
+#endif
+
+int z_impl_k_msgq_get_many(struct k_msgq *q, void *data, u32_t num_msgs,
+			   s32_t timeout)
+{
+	__ASSERT(!z_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	bool woken = false;
+	u32_t n;
+	int ret;
+
+	if (num_msgs == 0U) {
+		k_spin_unlock(&q->lock, key);
+		return 0;
+	}
+
+	n = msgq_get_batch(q, data, num_msgs, &woken);
+	if (n == 0U) {
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&q->lock, key);
+			return -ENOMSG;
+		}
+
+		/* Wait for the first one like k_msgq_get(), then take
+		 * whatever else is there
+		 */
+		_current->base.swap_data = data;
+		ret = z_pend_curr(&q->lock, key, &q->wait_q, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+
+		key = k_spin_lock(&q->lock);
+		n = 1U + msgq_get_batch(q, (char *)data + q->msg_size,
+					num_msgs - 1U, &woken);
+	}
+
+	if (woken) {
+		z_reschedule(&q->lock, key);
+	} else {
+		k_spin_unlock(&q->lock, key);
+	}
+
+	return n;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_get_many, msgq_p, data, num_msgs, timeout)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_get_many(q, (void *)data, num_msgs, timeout);
+}
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *q, void *data)
 {
 	k_spinlock_key_t key = k_spin_lock(&q->lock);
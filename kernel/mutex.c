@@ -24,6 +24,10 @@
  * When releasing the mutex, thread A must release M2 before it releases M1.
  * Failure to follow this nested model may result in threads running at
  * unexpected priority levels (too high, or too low).
+ *
+ * If the owning thread is itself waiting on another mutex, the boost is
+ * passed on to the owner of that mutex, and so forth, for up to
+ * CONFIG_PRIORITY_INHERITANCE_DEPTH mutexes.
  */
 
 #include <kernel.h>
@@ -34,6 +38,7 @@
 #include <misc/dlist.h>
 #include <debug/object_tracing_common.h>
 #include <errno.h>
+#include <string.h>
 #include <init.h>
 #include <syscall_handler.h>
 #include <tracing.h>
@@ -71,11 +76,58 @@ SYS_INIT(init_mutex_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
 #endif /* CONFIG_OBJECT_TRACING */
 
+#ifdef CONFIG_MUTEX_STATS
+static inline void stats_acquired(struct k_mutex *mutex)
+{
+	mutex->stats.acquisitions++;
+	mutex->hold_start = k_cycle_get_32();
+}
+
+static inline void stats_released(struct k_mutex *mutex)
+{
+	u32_t held = k_cycle_get_32() - mutex->hold_start;
+
+	if (held > mutex->stats.max_hold_cycles) {
+		mutex->stats.max_hold_cycles = held;
+	}
+}
+
+void k_mutex_stats_get(struct k_mutex *mutex, struct k_mutex_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = mutex->stats;
+	k_spin_unlock(&lock, key);
+}
+
+void k_mutex_stats_reset(struct k_mutex *mutex)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)memset(&mutex->stats, 0, sizeof(mutex->stats));
+	k_spin_unlock(&lock, key);
+}
+#else
+static inline void stats_acquired(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+}
+
+static inline void stats_released(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+}
+#endif /* CONFIG_MUTEX_STATS */
+
 void z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
 
+#ifdef CONFIG_MUTEX_STATS
+	(void)memset(&mutex->stats, 0, sizeof(mutex->stats));
+#endif
+
 	sys_trace_void(SYS_TRACE_ID_MUTEX_INIT);
 
 	z_waitq_init(&mutex->wait_q);
@@ -117,6 +169,63 @@ static void adjust_owner_prio(struct k_mutex *mutex, s32_t new_prio)
 	}
 }
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+/*
+ * The priority of the owner of @a mutex changed: if that thread is waiting
+ * on another mutex, recompute the priority of that mutex's owner from its
+ * first waiter, and so on down the chain.  The walk is bounded, which also
+ * keeps a deadlock cycle from looping forever.
+ */
+static void adjust_chain_prio(struct k_mutex *mutex)
+{
+	for (int depth = 1; depth < CONFIG_PRIORITY_INHERITANCE_DEPTH;
+	     depth++) {
+		struct k_thread *blocked = mutex->owner;
+		struct k_mutex *next = blocked->base.pended_mutex;
+
+		if (next == NULL || blocked->base.pended_on != &next->wait_q) {
+			break;
+		}
+
+		struct k_thread *waiter = z_waitq_head(&next->wait_q);
+		s32_t new_prio = next->owner_orig_prio;
+
+		if (waiter != NULL) {
+			new_prio = new_prio_for_inheritance(waiter->base.prio,
+							    new_prio);
+		}
+
+		if (new_prio == next->owner->base.prio) {
+			break;
+		}
+
+		K_DEBUG("%p (chain depth %d) prio changed to %d\n",
+			next->owner, depth, new_prio);
+
+		adjust_owner_prio(next, new_prio);
+		mutex = next;
+	}
+}
+
+static inline void set_pended_mutex(struct k_thread *thread,
+				    struct k_mutex *mutex)
+{
+	thread->base.pended_mutex = mutex;
+}
+#else
+static inline void adjust_chain_prio(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+}
+
+static inline void set_pended_mutex(struct k_thread *thread,
+				    struct k_mutex *mutex)
+{
+	ARG_UNUSED(thread);
+	ARG_UNUSED(mutex);
+}
+#endif /* CONFIG_PRIORITY_INHERITANCE_DEPTH > 1 */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 {
 	int new_prio;
@@ -131,6 +240,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 					_current->base.prio :
 					mutex->owner_orig_prio;
 
+		if (mutex->lock_count == 0U) {
+			stats_acquired(mutex);
+		}
+
 		mutex->lock_count++;
 		mutex->owner = _current;
 
@@ -157,12 +270,21 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 
 	K_DEBUG("adjusting prio up on mutex %p\n", mutex);
 
+#ifdef CONFIG_MUTEX_STATS
+	mutex->stats.contended++;
+#endif
+
 	if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
 		adjust_owner_prio(mutex, new_prio);
+		adjust_chain_prio(mutex);
 	}
 
+	set_pended_mutex(_current, mutex);
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+	set_pended_mutex(_current, NULL);
+
 	K_DEBUG("on mutex %p got_mutex value: %d\n", mutex, got_mutex);
 
 	K_DEBUG("%p got mutex %p (y/n): %c\n", _current, mutex,
@@ -189,6 +311,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 
 	key = k_spin_lock(&lock);
 	adjust_owner_prio(mutex, new_prio);
+	adjust_chain_prio(mutex);
 	k_spin_unlock(&lock, key);
 
 	k_sched_unlock();
@@ -224,6 +347,8 @@ void z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
+	stats_released(mutex);
+
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
 
 	new_owner = z_unpend_first_thread(&mutex->wait_q);
@@ -234,6 +359,8 @@ void z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
 
 	if (new_owner != NULL) {
+		set_pended_mutex(new_owner, NULL);
+		stats_acquired(mutex);
 		z_ready_thread(new_owner);
 
 		k_spin_unlock(&lock, key);
@@ -140,6 +140,10 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->read_index = 0;
 	pipe->write_index = 0;
 	pipe->flags = 0;
+#ifdef CONFIG_PIPE_CLAIM
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
+#endif
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
 	SYS_TRACING_OBJ_INIT(k_pipe, pipe);
@@ -781,3 +785,228 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 				    bytes_to_write, K_FOREVER);
 }
 #endif
+
+#ifdef CONFIG_PIPE_CLAIM
+static size_t pipe_space_contig(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+static size_t pipe_data_contig(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+/**
+ * @brief Wait with the pipe locked until @a avail reports some bytes
+ *
+ * A claimer pends with an empty request. The other side then takes it
+ * into its working set, as any request it can fully satisfy, and readies
+ * it once it has moved data, so that the claimer can check again.
+ *
+ * @return 0, or -EIO / -EAGAIN if nothing became available in time
+ */
+static int pipe_claim_wait(struct k_pipe *pipe, _wait_q_t *wait_q,
+			   size_t (*avail)(struct k_pipe *),
+			   k_spinlock_key_t *key, s32_t timeout)
+{
+	struct k_pipe_desc desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	u32_t start = k_uptime_get_32();
+
+	while (avail(pipe) == 0U) {
+		s32_t left = timeout;
+
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+		if (z_timeout_is_abs(timeout)) {
+			if (z_timeout_abs_ticks_left(timeout) <= 0) {
+				return -EAGAIN;
+			}
+		} else
+#endif
+		if (timeout != K_FOREVER) {
+			left = timeout - (s32_t)(k_uptime_get_32() - start);
+			if (left <= 0) {
+				return (timeout == K_NO_WAIT) ? -EIO : -EAGAIN;
+			}
+		}
+
+		_current->base.swap_data = &desc;
+		(void)z_pend_curr(&pipe->lock, *key, wait_q, left);
+		*key = k_spin_lock(&pipe->lock);
+	}
+
+	return 0;
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, u8_t **data, size_t size,
+		     size_t *claimed, s32_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!z_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	if (pipe->size == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	__ASSERT(pipe->put_claimed == 0U, "pipe already claimed for writing");
+
+	ret = pipe_claim_wait(pipe, &pipe->wait_q.writers, pipe_space_contig,
+			      &key, timeout);
+	if (ret == 0) {
+		*data = pipe->buffer + pipe->write_index;
+		*claimed = MIN(size, pipe_space_contig(pipe));
+		pipe->put_claimed = *claimed;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread *reader, *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t xfer_list;
+	size_t bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/* Readers only wait on an empty buffer: hand them the new data */
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				0, pipe->bytes_used, 0, K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		z_ready_thread(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, u8_t **data, size_t size,
+		     size_t *claimed, s32_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!z_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	if (pipe->size == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	__ASSERT(pipe->get_claimed == 0U, "pipe already claimed for reading");
+
+	ret = pipe_claim_wait(pipe, &pipe->wait_q.readers, pipe_data_contig,
+			      &key, timeout);
+	if (ret == 0) {
+		*data = pipe->buffer + pipe->read_index;
+		*claimed = MIN(size, pipe_data_contig(pipe));
+		pipe->get_claimed = *claimed;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread *writer, *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t xfer_list;
+	size_t bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/* Writers only wait on a full buffer: move them into the space */
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				0, pipe->size - pipe->bytes_used, 0,
+				K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+#endif /* CONFIG_PIPE_CLAIM */
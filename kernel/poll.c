@@ -333,6 +333,34 @@ oops_free:
 }
 #endif
 
+static inline bool is_set_event(struct k_poll_event *event)
+{
+#ifdef CONFIG_POLL_SET
+	return (event->poller != NULL) && event->poller->is_set;
+#else
+	return false;
+#endif
+}
+
+#ifdef CONFIG_POLL_SET
+/* must be called with interrupts locked, event already off its object */
+static void signal_set_event(struct k_poll_event *event, u32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		z_set_thread_return_value(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+#endif
+
 /* must be called with interrupts locked */
 static int signal_poll_event(struct k_poll_event *event, u32_t state)
 {
@@ -340,6 +368,13 @@ static int signal_poll_event(struct k_poll_event *event, u32_t state)
 		goto ready_event;
 	}
 
+#ifdef CONFIG_POLL_SET
+	if (event->poller->is_set) {
+		signal_set_event(event, state);
+		return 0;
+	}
+#endif
+
 	struct k_thread *thread = event->poller->thread;
 
 	__ASSERT(event->poller->thread != NULL,
@@ -370,14 +405,21 @@ ready_event:
 	return 0;
 }
 
+/*
+ * Poll set events only observe the object, so keep going until the
+ * event of a k_poll() caller has been signaled as well.
+ */
 void z_handle_obj_poll_events(sys_dlist_t *events, u32_t state)
 {
 	struct k_poll_event *poll_event;
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(events);
-	if (poll_event != NULL) {
+	do {
+		poll_event = (struct k_poll_event *)sys_dlist_get(events);
+		if (poll_event == NULL) {
+			break;
+		}
 		(void) signal_poll_event(poll_event, state);
-	}
+	} while (is_set_event(poll_event));
 }
 
 void z_impl_k_poll_signal_init(struct k_poll_signal *signal)
@@ -433,6 +475,15 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *signal, int result)
 
 	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
 
+	while (is_set_event(poll_event)) {
+		poll_event = (struct k_poll_event *)
+			sys_dlist_get(&signal->poll_events);
+		if (poll_event == NULL) {
+			break;
+		}
+		rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	}
+
 	z_reschedule(&lock, key);
 	return rc;
 }
@@ -447,3 +498,145 @@ Z_SYSCALL_HANDLER1_SIMPLE_VOID(k_poll_signal_reset, K_OBJ_POLL_SIGNAL,
 			       struct k_poll_signal *);
 #endif
 
+#ifdef CONFIG_POLL_SET
+void k_poll_set_init(struct k_poll_set *set)
+{
+	z_waitq_init(&set->wait_q);
+	set->poller.thread = NULL;
+	set->poller.is_polling = false;
+	set->poller.is_set = true;
+	sys_dlist_init(&set->ready);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u32_t state;
+
+	__ASSERT(event->poller == NULL, "event already registered\n");
+
+	/* priority ordering on the object needs a thread to compare */
+	if (set->poller.thread == NULL) {
+		set->poller.thread = _current;
+	}
+
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		event->state = state;
+		sys_dlist_append(&set->ready, &event->_node);
+	} else {
+		event->state = K_POLL_STATE_NOT_READY;
+		(void)register_event(event, &set->poller);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(event->poller == &set->poller, "event not in this set\n");
+	ARG_UNUSED(set);
+
+	/* the node is either on its object or on the ready list */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+}
+
+/* must be called with interrupts locked */
+static int collect_ready_events(struct k_poll_set *set,
+				struct k_poll_event **ready, int max)
+{
+	struct k_poll_event *event, *next;
+	sys_dlist_t reported;
+	sys_dnode_t *node;
+	int num_ready = 0;
+
+	sys_dlist_init(&reported);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&set->ready, event, next, _node) {
+		u32_t state;
+
+		if (num_ready == max) {
+			break;
+		}
+
+		sys_dlist_remove(&event->_node);
+
+		if (is_condition_met(event, &state)) {
+			/* level-triggered: stays ready until drained */
+			event->state = state;
+			sys_dlist_append(&reported, &event->_node);
+			ready[num_ready++] = event;
+		} else if ((event->state & K_POLL_STATE_CANCELLED) != 0U) {
+			event->state = K_POLL_STATE_CANCELLED;
+			(void)register_event(event, &set->poller);
+			ready[num_ready++] = event;
+		} else {
+			event->state = K_POLL_STATE_NOT_READY;
+			(void)register_event(event, &set->poller);
+		}
+	}
+
+	/* report the others first next time */
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&set->ready, node);
+	}
+
+	return num_ready;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max, s32_t timeout)
+{
+	__ASSERT(!z_is_in_isr(), "");
+	__ASSERT(ready != NULL, "NULL ready array\n");
+	__ASSERT(max > 0, "zero events\n");
+
+	u32_t start = k_uptime_get_32();
+	s32_t remaining = timeout;
+	k_spinlock_key_t key;
+	int rc;
+
+	for (;;) {
+		key = k_spin_lock(&lock);
+
+		rc = collect_ready_events(set, ready, max);
+		if (rc > 0) {
+			k_spin_unlock(&lock, key);
+			return rc;
+		}
+
+		if (remaining == K_NO_WAIT) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		set->poller.thread = _current;
+		rc = z_pend_curr(&lock, key, &set->wait_q, remaining);
+		if (rc != 0) {
+			return rc;
+		}
+
+		/* woken up, but the event may have been consumed already */
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+		if (z_timeout_is_abs(timeout)) {
+			if (z_timeout_abs_ticks_left(timeout) <= 0) {
+				remaining = K_NO_WAIT;
+			}
+		} else
+#endif
+		if (timeout != K_FOREVER) {
+			remaining = timeout - (s32_t)(k_uptime_get_32() - start);
+			if (remaining < 0) {
+				remaining = K_NO_WAIT;
+			}
+		}
+	}
+}
+#endif /* CONFIG_POLL_SET */
@@ -86,6 +86,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 {
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	queue->pending = NULL;
+	atomic_clear(&queue->waiters);
+#endif
 	z_waitq_init(&queue->wait_q);
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
@@ -121,6 +125,103 @@ static inline void handle_poll_events(struct k_queue *queue, u32_t state)
 }
 #endif
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+/* Moves items appended by append_lockfree() onto data_q, oldest
+ * first.  Must be called with the queue lock held before data_q is
+ * looked at.
+ */
+static void drain_pending(struct k_queue *queue)
+{
+	void *node = __atomic_exchange_n(&queue->pending, NULL,
+					 __ATOMIC_SEQ_CST);
+	void *head = NULL, *tail = node;
+
+	if (node == NULL) {
+		return;
+	}
+
+	/* The pending stack is newest first, reverse it */
+	while (node != NULL) {
+		void *next = *(void **)node;
+
+		*(void **)node = head;
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+}
+
+void z_queue_drain(struct k_queue *queue)
+{
+	if (__atomic_load_n(&queue->pending, __ATOMIC_RELAXED) != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		drain_pending(queue);
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+static inline bool has_waiters(struct k_queue *queue)
+{
+#if defined(CONFIG_POLL)
+	/* Only allowed on uniprocessor builds, where registration
+	 * happens with interrupts locked
+	 */
+	return !sys_dlist_is_empty(&queue->poll_events);
+#else
+	return atomic_get(&queue->waiters) != 0;
+#endif
+}
+
+static void append_lockfree(struct k_queue *queue, void *data)
+{
+	void *head = __atomic_load_n(&queue->pending, __ATOMIC_RELAXED);
+
+	do {
+		*(void **)data = head;
+	} while (!__atomic_compare_exchange_n(&queue->pending, &head, data,
+					      true, __ATOMIC_SEQ_CST,
+					      __ATOMIC_RELAXED));
+}
+#endif /* CONFIG_QUEUE_LOCKFREE_APPEND */
+
+#if !defined(CONFIG_POLL) && defined(CONFIG_QUEUE_LOCKFREE_APPEND)
+/* Hands queued items to pending threads until either runs out, so
+ * that items a lock free append left behind are not overtaken.
+ */
+static void feed_waiters(struct k_queue *queue)
+{
+	struct k_thread *thread;
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+		prepare_thread_to_run(thread, z_queue_node_peek(
+			sys_sflist_get_not_empty(&queue->data_q), true));
+	}
+}
+#else
+static inline void feed_waiters(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif
+
+/* Takes the queue lock and brings data_q up to date */
+static inline k_spinlock_key_t queue_lock(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	drain_pending(queue);
+	feed_waiters(queue);
+#endif
+	return key;
+}
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
@@ -145,9 +246,13 @@ Z_SYSCALL_HANDLER1_SIMPLE_VOID(k_queue_cancel_wait, K_OBJ_QUEUE,
 #endif
 
 static s32_t queue_insert(struct k_queue *queue, void *prev, void *data,
-			  bool alloc)
+			  bool alloc, bool is_append)
 {
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	k_spinlock_key_t key = queue_lock(queue);
+
+	if (is_append) {
+		prev = sys_sflist_peek_tail(&queue->data_q);
+	}
 #if !defined(CONFIG_POLL)
 	struct k_thread *first_pending_thread;
 
@@ -187,24 +292,42 @@ static s32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 {
-	(void)queue_insert(queue, prev, data, false);
+	(void)queue_insert(queue, prev, data, false, false);
 }
 
 void k_queue_append(struct k_queue *queue, void *data)
 {
-	(void)queue_insert(queue, sys_sflist_peek_tail(&queue->data_q),
-			   data, false);
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (!has_waiters(queue)) {
+		append_lockfree(queue, data);
+
+		/* A consumer registers as a waiter before it drains and
+		 * blocks, so if it still isn't there it will see our
+		 * item.  Otherwise it may have drained before the push
+		 * and needs the item handed over.
+		 */
+		if (has_waiters(queue)) {
+			k_spinlock_key_t key = queue_lock(queue);
+
+#if defined(CONFIG_POLL)
+			handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+#endif
+			z_reschedule(&queue->lock, key);
+		}
+		return;
+	}
+#endif
+	(void)queue_insert(queue, NULL, data, false, true);
 }
 
 void k_queue_prepend(struct k_queue *queue, void *data)
 {
-	(void)queue_insert(queue, NULL, data, false);
+	(void)queue_insert(queue, NULL, data, false, false);
 }
 
 s32_t z_impl_k_queue_alloc_append(struct k_queue *queue, void *data)
 {
-	return queue_insert(queue, sys_sflist_peek_tail(&queue->data_q), data,
-			    true);
+	return queue_insert(queue, NULL, data, true, true);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -219,7 +342,7 @@ Z_SYSCALL_HANDLER(k_queue_alloc_append, queue, data)
 
 s32_t z_impl_k_queue_alloc_prepend(struct k_queue *queue, void *data)
 {
-	return queue_insert(queue, NULL, data, true);
+	return queue_insert(queue, NULL, data, true, false);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -236,7 +359,7 @@ void k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 {
 	__ASSERT(head && tail, "invalid head or tail");
 
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	k_spinlock_key_t key = queue_lock(queue);
 #if !defined(CONFIG_POLL)
 	struct k_thread *thread = NULL;
 
@@ -298,16 +421,28 @@ static void *k_queue_poll(struct k_queue *queue, s32_t timeout)
 	do {
 		event.state = K_POLL_STATE_NOT_READY;
 
-		err = k_poll(&event, 1, timeout - elapsed);
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+		if (z_timeout_is_abs(timeout)) {
+			err = k_poll(&event, 1, timeout);
+		} else
+#endif
+		{
+			err = k_poll(&event, 1, timeout - elapsed);
+		}
 
 		if (err && err != -EAGAIN) {
 			return NULL;
 		}
 
-		key = k_spin_lock(&queue->lock);
+		key = queue_lock(queue);
 		val = z_queue_node_peek(sys_sflist_get(&queue->data_q), true);
 		k_spin_unlock(&queue->lock, key);
 
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+		if ((val == NULL) && z_timeout_is_abs(timeout)) {
+			done = z_timeout_abs_ticks_left(timeout) <= 0;
+		} else
+#endif
 		if ((val == NULL) && (timeout != K_FOREVER)) {
 			elapsed = k_uptime_get_32() - start;
 			done = elapsed > timeout;
@@ -318,17 +453,43 @@ static void *k_queue_poll(struct k_queue *queue, s32_t timeout)
 }
 #endif /* CONFIG_POLL */
 
+#if !defined(CONFIG_POLL) && defined(CONFIG_QUEUE_LOCKFREE_APPEND)
+static inline void waiter_add(struct k_queue *queue, s32_t timeout)
+{
+	if (timeout != K_NO_WAIT) {
+		atomic_inc(&queue->waiters);
+	}
+}
+
+static inline void waiter_remove(struct k_queue *queue, s32_t timeout)
+{
+	if (timeout != K_NO_WAIT) {
+		atomic_dec(&queue->waiters);
+	}
+}
+#else
+#define waiter_add(queue, timeout) do {} while (false)
+#define waiter_remove(queue, timeout) do {} while (false)
+#endif
+
 void *z_impl_k_queue_get(struct k_queue *queue, s32_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
 
+	/* Must be visible to lock free appenders before we look at
+	 * the queue, see k_queue_append()
+	 */
+	waiter_add(queue, timeout);
+
+	k_spinlock_key_t key = queue_lock(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
 		node = sys_sflist_get_not_empty(&queue->data_q);
 		data = z_queue_node_peek(node, true);
 		k_spin_unlock(&queue->lock, key);
+		waiter_remove(queue, timeout);
 		return data;
 	}
 
@@ -345,10 +506,22 @@ void *z_impl_k_queue_get(struct k_queue *queue, s32_t timeout)
 #else
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
+	waiter_remove(queue, timeout);
 	return (ret != 0) ? NULL : _current->base.swap_data;
 #endif /* CONFIG_POLL */
 }
 
+void *k_queue_get_all(struct k_queue *queue)
+{
+	k_spinlock_key_t key = queue_lock(queue);
+	void *head = sys_sflist_peek_head(&queue->data_q);
+
+	sys_sflist_init(&queue->data_q);
+	k_spin_unlock(&queue->lock, key);
+
+	return head;
+}
+
 #ifdef CONFIG_USERSPACE
 Z_SYSCALL_HANDLER(k_queue_get, queue, timeout_p)
 {
@@ -52,6 +52,68 @@ static struct k_spinlock sched_spinlock;
 			!__i.key;					\
 			k_spin_unlock(lck, __key), __i.key = 1)
 
+/* With CONFIG_SCHED_CPU_RUNQ the ready queue of each CPU, and the
+ * queued state of the threads in it, is protected by the runq_lock of
+ * that CPU, so picking the next thread only takes the local lock.
+ * sched_spinlock still protects the wait queues and is always taken
+ * before a runq_lock.  No CPU ever holds two runq_locks.  Without
+ * per-CPU queues sched_spinlock protects everything.
+ */
+struct runq_key {
+	struct k_spinlock *lock;
+	k_spinlock_key_t key;
+};
+
+static ALWAYS_INLINE struct runq_key runq_lock(struct k_thread *thread)
+{
+	struct runq_key k;
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Only the holder of the lock of its queue moves a queued
+	 * thread to another CPU, retry if that happened while we
+	 * were spinning
+	 */
+	while (true) {
+		k.lock = &_kernel.cpus[thread->base.cpu].runq_lock;
+		k.key = k_spin_lock(k.lock);
+		if (k.lock == &_kernel.cpus[thread->base.cpu].runq_lock) {
+			break;
+		}
+		k_spin_unlock(k.lock, k.key);
+	}
+#else
+	k.lock = &sched_spinlock;
+	k.key = k_spin_lock(k.lock);
+#endif
+
+	return k;
+}
+
+static ALWAYS_INLINE void runq_unlock(struct runq_key k)
+{
+	k_spin_unlock(k.lock, k.key);
+}
+
+/* LOCKED() for the ready queue holding, or about to hold, a thread */
+#define LOCKED_RUNQ(th) for (struct runq_key __i = {},		\
+				     __k = runq_lock(th);		\
+			     __i.lock == NULL;				\
+			     runq_unlock(__k), __i.lock = __k.lock)
+
+/* The same, nested in a section holding sched_spinlock */
+#ifdef CONFIG_SCHED_CPU_RUNQ
+#define LOCKED_RUNQ_NESTED(th) LOCKED_RUNQ(th)
+#else
+#define LOCKED_RUNQ_NESTED(th)
+#endif
+
+/* Lock of the ready queue this CPU picks its threads from */
+#ifdef CONFIG_SCHED_CPU_RUNQ
+#define local_runq_lock (&_current_cpu->runq_lock)
+#else
+#define local_runq_lock (&sched_spinlock)
+#endif
+
 static inline int is_preempt(struct k_thread *thread)
 {
 #ifdef CONFIG_PREEMPT_ENABLED
@@ -176,6 +238,88 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+static ALWAYS_INLINE int runq_cpu(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* Stay where we last ran if allowed, otherwise pick the
+	 * lowest numbered CPU the mask permits
+	 */
+	if ((thread->base.cpu_mask & BIT(thread->base.cpu)) == 0U &&
+	    thread->base.cpu_mask != 0U) {
+		return __builtin_ctz(thread->base.cpu_mask);
+	}
+#endif
+	return thread->base.cpu;
+}
+#endif
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	_priq_run_add(&_kernel.cpus[thread->base.cpu].ready_q.runq, thread);
+#else
+	_priq_run_add(&_kernel.ready_q.runq, thread);
+#endif
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	_priq_run_remove(&_kernel.cpus[thread->base.cpu].ready_q.runq, thread);
+#else
+	_priq_run_remove(&_kernel.ready_q.runq, thread);
+#endif
+}
+
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return _priq_run_best(&_current_cpu->ready_q.runq);
+#else
+	return _priq_run_best(&_kernel.ready_q.runq);
+#endif
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Called with the local ready queue locked, when there is nothing to
+ * run from it.  Takes the best thread of the first peer having one
+ * this CPU may run.  The local lock is dropped meanwhile, as no CPU
+ * holds two runq_locks.
+ */
+static struct k_thread *runq_steal(void)
+{
+	struct _cpu *cpu = _current_cpu;
+	struct k_thread *th = NULL;
+
+	k_spin_release(&cpu->runq_lock);
+
+	for (int i = 1; i < CONFIG_MP_NUM_CPUS && th == NULL; i++) {
+		struct _cpu *peer = &_kernel.cpus[(cpu->id + i) %
+						  CONFIG_MP_NUM_CPUS];
+
+		LOCKED(&peer->runq_lock) {
+			th = _priq_run_best(&peer->ready_q.runq);
+
+			/* Its _current gets queued while pending */
+			if (th == peer->current) {
+				th = NULL;
+			}
+
+			if (th != NULL) {
+				_priq_run_remove(&peer->ready_q.runq, th);
+				z_mark_thread_as_not_queued(th);
+				th->base.cpu = cpu->id;
+			}
+		}
+	}
+
+	(void)k_spin_lock(&cpu->runq_lock);
+
+	return th;
+}
+#endif
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 #ifndef CONFIG_SMP
@@ -185,7 +329,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	 * responsible for putting it back in z_swap and ISR return!),
 	 * which makes this choice simple.
 	 */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
 
 	return th ? th : _current_cpu->idle_thread;
 #else
@@ -203,7 +347,14 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	int active = !z_is_thread_prevented_from_running(_current);
 
 	/* Choose the best thread that is not current */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Only look at the peers when there is nothing else to run */
+	if (th == NULL && (!active || is_idle(_current))) {
+		th = runq_steal();
+	}
+#endif
 	if (th == NULL) {
 		th = _current_cpu->idle_thread;
 	}
@@ -221,13 +372,13 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 
 	/* Put _current back into the queue */
 	if (th != _current && active && !is_idle(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_add(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(th)) {
-		_priq_run_remove(&_kernel.ready_q.runq, th);
+		runq_remove(th);
 	}
 	z_mark_thread_as_not_queued(th);
 
@@ -278,6 +429,49 @@ static inline int sliceable(struct k_thread *t)
 		&& !z_is_thread_timeout_active(t);
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static void update_cache(int preempt_ok);
+
+/* Charges _current's reservation and throttles it once the budget
+ * is gone.  Returns true if it was throttled.
+ */
+static bool cbs_charge(int ticks)
+{
+	struct _cbs *cbs = &_current->base.cbs;
+	bool throttled = false;
+
+	if (cbs->period == 0 || is_idle(_current)) {
+		return false;
+	}
+
+	LOCKED(&sched_spinlock) {
+		if (cbs->throttled == 0U && (cbs->remaining -= ticks) <= 0) {
+			LOCKED_RUNQ_NESTED(_current) {
+				cbs->throttled = 1U;
+				if (z_is_thread_queued(_current)) {
+					runq_remove(_current);
+					z_mark_thread_as_not_queued(_current);
+				}
+				update_cache(1);
+			}
+			throttled = true;
+		}
+	}
+
+	return throttled;
+}
+
+/* Makes sure the timer fires when @th will have used up its budget */
+static void cbs_arm(struct k_thread *th)
+{
+	if (th->base.cbs.period != 0 && th->base.cbs.throttled == 0U) {
+		z_set_timeout_expiry(MAX(th->base.cbs.remaining, 1), false);
+	}
+}
+#else
+static void cbs_arm(struct k_thread *th) { /* !CONFIG_SCHED_DEADLINE_CBS */ }
+#endif
+
 /* Called out of each timer interrupt */
 void z_time_slice(int ticks)
 {
@@ -289,6 +483,12 @@ void z_time_slice(int ticks)
 	pending_current = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (cbs_charge(ticks)) {
+		return;
+	}
+#endif
+
 	if (slice_time && sliceable(_current)) {
 		if (ticks >= _current_cpu->slice_ticks) {
 			z_move_thread_to_end_of_prio_q(_current);
@@ -300,6 +500,7 @@ void z_time_slice(int ticks)
 }
 #else
 static void reset_time_slice(void) { /* !CONFIG_TIMESLICING */ }
+static void cbs_arm(struct k_thread *th) { /* !CONFIG_TIMESLICING */ }
 #endif
 
 static void update_cache(int preempt_ok)
@@ -310,6 +511,7 @@ static void update_cache(int preempt_ok)
 	if (should_preempt(th, preempt_ok)) {
 		if (th != _current) {
 			reset_time_slice();
+			cbs_arm(th);
 		}
 		_kernel.ready_q.cache = th;
 	} else {
@@ -329,8 +531,13 @@ static void update_cache(int preempt_ok)
 
 void z_add_thread_to_ready_q(struct k_thread *thread)
 {
-	LOCKED(&sched_spinlock) {
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Nobody else moves it before it is queued */
+	thread->base.cpu = runq_cpu(thread);
+#endif
+
+	LOCKED_RUNQ(thread) {
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
 	}
@@ -338,9 +545,11 @@ void z_add_thread_to_ready_q(struct k_thread *thread)
 
 void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
-	LOCKED(&sched_spinlock) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+	LOCKED_RUNQ(thread) {
+		if (z_is_thread_queued(thread)) {
+			runq_remove(thread);
+		}
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(thread == _current);
 	}
@@ -348,9 +557,9 @@ void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 
 void z_remove_thread_from_ready_q(struct k_thread *thread)
 {
-	LOCKED(&sched_spinlock) {
+	LOCKED_RUNQ(thread) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		update_cache(thread == _current);
@@ -368,9 +577,7 @@ static void pend(struct k_thread *thread, _wait_q_t *wait_q, s32_t timeout)
 	}
 
 	if (timeout != K_FOREVER) {
-		s32_t ticks = _TICK_ALIGN + z_ms_to_ticks(timeout);
-
-		z_add_thread_timeout(thread, ticks);
+		z_add_thread_timeout(thread, z_timeout_to_ticks(timeout));
 	}
 
 	sys_trace_thread_pend(thread);
@@ -479,15 +686,34 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 	bool need_sched = 0;
 
 	LOCKED(&sched_spinlock) {
-		need_sched = z_is_thread_ready(thread);
-
-		if (need_sched) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
-			thread->base.prio = prio;
-			_priq_run_add(&_kernel.ready_q.runq, thread);
-			update_cache(1);
-		} else {
-			thread->base.prio = prio;
+		LOCKED_RUNQ_NESTED(thread) {
+			need_sched = z_is_thread_ready(thread);
+
+			if (need_sched) {
+				/* Under SMP _current is not queued */
+				if (z_is_thread_queued(thread)) {
+					runq_remove(thread);
+					thread->base.prio = prio;
+					runq_add(thread);
+				} else {
+					thread->base.prio = prio;
+				}
+				update_cache(1);
+			} else if (z_is_thread_pending(thread) &&
+				   thread->base.pended_on != NULL) {
+				/* keep wait queues sorted, priority
+				 * inheritance chains look at their first
+				 * waiter
+				 */
+				_priq_wait_remove(
+					&thread->base.pended_on->waitq,
+					thread);
+				thread->base.prio = prio;
+				z_priq_wait_add(&thread->base.pended_on->waitq,
+						thread);
+			} else {
+				thread->base.prio = prio;
+			}
 		}
 	}
 	sys_trace_thread_priority_set(thread);
@@ -562,7 +788,7 @@ struct k_thread *z_get_next_ready_thread(void)
 {
 	struct k_thread *ret = 0;
 
-	LOCKED(&sched_spinlock) {
+	LOCKED(local_runq_lock) {
 		ret = next_up();
 	}
 
@@ -590,11 +816,12 @@ void *z_get_next_switch_handle(void *interrupted)
 	z_check_stack_sentinel();
 
 #ifdef CONFIG_SMP
-	LOCKED(&sched_spinlock) {
+	LOCKED(local_runq_lock) {
 		struct k_thread *th = next_up();
 
 		if (_current != th) {
 			reset_time_slice();
+			cbs_arm(th);
 			_current_cpu->swap_ok = 0;
 			set_current(th);
 #ifdef SPIN_VALIDATE
@@ -603,7 +830,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			 * confused when the "wrong" thread tries to
 			 * release the lock.
 			 */
-			z_spin_lock_set_owner(&sched_spinlock);
+			z_spin_lock_set_owner(local_runq_lock);
 #endif
 		}
 	}
@@ -733,17 +960,19 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 }
 
 #ifdef CONFIG_SCHED_MULTIQ
-# if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
-# error Too many priorities for multiqueue scheduler (max 32)
+# if PRIQ_MQ_NUM_PRIOS > (32 * 32)
+# error Too many priorities for multiqueue scheduler (max 1024)
 # endif
 #endif
 
 ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 {
-	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int prio = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int word = prio / 32;
 
-	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
-	pq->bitmask |= BIT(priority_bit);
+	sys_dlist_append(&pq->queues[prio], &thread->base.qnode_dlist);
+	pq->bits[word] |= BIT(prio % 32);
+	pq->bitmask |= BIT(word);
 }
 
 ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
@@ -754,11 +983,15 @@ ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread
 		return;
 	}
 #endif
-	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int prio = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int word = prio / 32;
 
 	sys_dlist_remove(&thread->base.qnode_dlist);
-	if (sys_dlist_is_empty(&pq->queues[priority_bit])) {
-		pq->bitmask &= ~BIT(priority_bit);
+	if (sys_dlist_is_empty(&pq->queues[prio])) {
+		pq->bits[word] &= ~BIT(prio % 32);
+		if (pq->bits[word] == 0U) {
+			pq->bitmask &= ~BIT(word);
+		}
 	}
 }
 
@@ -769,7 +1002,8 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	}
 
 	struct k_thread *t = NULL;
-	sys_dlist_t *l = &pq->queues[__builtin_ctz(pq->bitmask)];
+	int word = __builtin_ctz(pq->bitmask);
+	sys_dlist_t *l = &pq->queues[word * 32 + __builtin_ctz(pq->bits[word])];
 	sys_dnode_t *n = sys_dlist_peek_head(l);
 
 	if (n != NULL) {
@@ -792,14 +1026,14 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -807,10 +1041,21 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
+	}
+#else
+	init_ready_q(&_kernel.ready_q);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	k_sched_time_slice_set(CONFIG_TIMESLICE_SIZE,
@@ -864,11 +1109,11 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 	struct k_thread *th = tid;
 
-	LOCKED(&sched_spinlock) {
+	LOCKED_RUNQ(th) {
 		th->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(th)) {
-			_priq_run_remove(&_kernel.ready_q.runq, th);
-			_priq_run_add(&_kernel.ready_q.runq, th);
+			runq_remove(th);
+			runq_add(th);
 		}
 	}
 }
@@ -887,6 +1132,166 @@ Z_SYSCALL_HANDLER(k_thread_deadline_set, thread_p, deadline)
 	return 0;
 }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Total admitted utilization, per mille */
+static u32_t cbs_total_util;
+
+/* Called with sched_spinlock held */
+static void cbs_set_deadline(struct k_thread *th)
+{
+	th->base.prio_deadline = k_cycle_get_32() +
+		th->base.cbs.period * sys_clock_hw_cycles_per_tick();
+	LOCKED_RUNQ_NESTED(th) {
+		if (z_is_thread_queued(th)) {
+			runq_remove(th);
+			runq_add(th);
+		}
+	}
+}
+
+static void cbs_period_expired(struct _timeout *to)
+{
+	struct _cbs *cbs = CONTAINER_OF(to, struct _cbs, period_timeout);
+	struct k_thread *th = CONTAINER_OF(cbs, struct k_thread, base.cbs);
+	bool wake = false;
+
+	LOCKED(&sched_spinlock) {
+		/* Period is zero if cleared while we were dispatched */
+		if (cbs->period != 0) {
+			u32_t missed = (cbs->throttled != 0U ||
+					z_is_thread_ready(th)) ? 1U : 0U;
+
+			cbs->window = (cbs->window << 1) | missed;
+			cbs->periods++;
+			cbs->missed += missed;
+			cbs->remaining = cbs->budget;
+			cbs_set_deadline(th);
+
+			if (cbs->throttled != 0U) {
+				cbs->throttled = 0U;
+				wake = true;
+			}
+
+			z_add_timeout(to, cbs_period_expired, cbs->period);
+		}
+	}
+
+	if (wake) {
+		z_ready_thread(th);
+	}
+}
+
+/* Drops the reservation, returns true if the thread was throttled */
+static bool cbs_clear(struct k_thread *th)
+{
+	struct _cbs *cbs = &th->base.cbs;
+	bool throttled = cbs->throttled != 0U;
+
+	(void)z_abort_timeout(&cbs->period_timeout);
+	cbs_total_util -= cbs->util;
+	*cbs = (struct _cbs) {};
+	z_init_timeout(&cbs->period_timeout, NULL);
+
+	return throttled;
+}
+
+int k_thread_reservation_set(k_tid_t thread, s32_t period, s32_t budget)
+{
+	s32_t period_ticks = z_ms_to_ticks(period);
+	s32_t budget_ticks = z_ms_to_ticks(budget);
+	u32_t util;
+	int ret = 0;
+	bool wake = false;
+
+	if (period_ticks <= 0 || budget_ticks <= 0 ||
+	    budget_ticks > period_ticks) {
+		return -EINVAL;
+	}
+
+	util = ceiling_fraction((u64_t)budget_ticks * 1000U, period_ticks);
+
+	LOCKED(&sched_spinlock) {
+		struct _cbs *cbs = &thread->base.cbs;
+
+		if (cbs_total_util - cbs->util + util >
+		    CONFIG_SCHED_DEADLINE_CBS_MAX_UTIL * CONFIG_MP_NUM_CPUS) {
+			ret = -EBUSY;
+		} else {
+			if (cbs->period != 0) {
+				wake = cbs_clear(thread);
+			}
+
+			cbs->period = period_ticks;
+			cbs->budget = budget_ticks;
+			cbs->remaining = budget_ticks;
+			cbs->util = util;
+			cbs_total_util += util;
+
+			cbs_set_deadline(thread);
+			z_add_timeout(&cbs->period_timeout, cbs_period_expired,
+				      period_ticks);
+		}
+	}
+
+	if (wake) {
+		z_ready_thread(thread);
+	}
+
+	return ret;
+}
+
+int k_thread_reservation_clear(k_tid_t thread)
+{
+	int ret = 0;
+	bool wake = false;
+
+	LOCKED(&sched_spinlock) {
+		if (thread->base.cbs.period == 0) {
+			ret = -EINVAL;
+		} else {
+			wake = cbs_clear(thread);
+		}
+	}
+
+	if (wake) {
+		z_ready_thread(thread);
+	}
+
+	return ret;
+}
+
+/* Drops the reservation of a thread being aborted, leaving it unready */
+void z_thread_reservation_abort(struct k_thread *thread)
+{
+	LOCKED(&sched_spinlock) {
+		if (thread->base.cbs.period != 0) {
+			(void)cbs_clear(thread);
+		}
+	}
+}
+
+int k_thread_reservation_stats_get(k_tid_t thread,
+				   struct k_thread_reservation_stats *stats)
+{
+	int ret = 0;
+
+	LOCKED(&sched_spinlock) {
+		struct _cbs *cbs = &thread->base.cbs;
+
+		if (cbs->period == 0) {
+			ret = -EINVAL;
+		} else {
+			stats->periods = cbs->periods;
+			stats->missed = cbs->missed;
+			stats->recent_periods = MIN(cbs->periods, 32);
+			stats->recent_missed = popcount(cbs->window);
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 #endif
 
 void z_impl_k_yield(void)
@@ -894,13 +1299,11 @@ void z_impl_k_yield(void)
 	__ASSERT(!z_is_in_isr(), "");
 
 	if (!is_idle(_current)) {
-		LOCKED(&sched_spinlock) {
+		LOCKED_RUNQ(_current) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
-				_priq_run_add(&_kernel.ready_q.runq,
-					      _current);
+				runq_remove(_current);
+				runq_add(_current);
 			}
 			update_cache(1);
 		}
@@ -912,7 +1315,7 @@ void z_impl_k_yield(void)
 Z_SYSCALL_HANDLER0_SIMPLE_VOID(k_yield);
 #endif
 
-static s32_t z_tick_sleep(s32_t ticks)
+static s32_t z_tick_sleep(s32_t ticks, bool absolute)
 {
 #ifdef CONFIG_MULTITHREADING
 	u32_t expected_wakeup_time;
@@ -927,7 +1330,9 @@ static s32_t z_tick_sleep(s32_t ticks)
 		return 0;
 	}
 
-	ticks += _TICK_ALIGN;
+	if (!absolute) {
+		ticks += _TICK_ALIGN;
+	}
 	expected_wakeup_time = ticks + z_tick_get_32();
 
 	/* Spinlock purely for local interrupt locking to prevent us
@@ -963,8 +1368,16 @@ s32_t z_impl_k_sleep(int ms)
 
 	__ASSERT(ms != K_FOREVER, "");
 
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+	if (z_timeout_is_abs(ms)) {
+		ticks = z_timeout_abs_ticks_left(ms);
+		ticks = z_tick_sleep(MAX(ticks, 0), true);
+		return __ticks_to_ms(ticks);
+	}
+#endif
+
 	ticks = z_ms_to_ticks(ms);
-	ticks = z_tick_sleep(ticks);
+	ticks = z_tick_sleep(ticks, false);
 	return __ticks_to_ms(ticks);
 }
 
@@ -986,7 +1399,7 @@ s32_t z_impl_k_usleep(int us)
 	s32_t ticks;
 
 	ticks = z_us_to_ticks(us);
-	ticks = z_tick_sleep(ticks);
+	ticks = z_tick_sleep(ticks, false);
 	return __ticks_to_us(ticks);
 }
 
@@ -1029,7 +1442,7 @@ void z_impl_k_wakeup(k_tid_t thread)
  */
 void z_sched_ipi(void)
 {
-	LOCKED(&sched_spinlock) {
+	LOCKED(local_runq_lock) {
 		if (_current->base.thread_state & _THREAD_ABORTING) {
 			_current->base.thread_state |= _THREAD_DEAD;
 			_current_cpu->swap_ok = true;
@@ -1057,10 +1470,10 @@ void z_sched_abort(struct k_thread *thread)
 	 * running on or because we caught it idle in the queue
 	 */
 	while ((thread->base.thread_state & _THREAD_DEAD) == 0U) {
-		LOCKED(&sched_spinlock) {
+		LOCKED_RUNQ(thread) {
 			if (z_is_thread_queued(thread)) {
 				thread->base.thread_state |= _THREAD_DEAD;
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				z_mark_thread_as_not_queued(thread);
 			}
 		}
@@ -60,6 +60,159 @@ void z_smp_release_global_lock(struct k_thread *thread)
 	}
 }
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+static inline u32_t spin_stats_start(void)
+{
+	return k_cycle_get_32();
+}
+
+/* Updated while holding the lock, no need for atomics */
+static inline void spin_stats_update(struct k_spinlock *l, u32_t spins,
+				     u32_t start)
+{
+	u32_t wait = k_cycle_get_32() - start;
+
+	l->contended++;
+	l->spins += spins;
+	if (wait > l->max_wait) {
+		l->max_wait = wait;
+	}
+}
+#else
+static inline u32_t spin_stats_start(void)
+{
+	return 0;
+}
+
+static inline void spin_stats_update(struct k_spinlock *l, u32_t spins,
+				     u32_t start)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(spins);
+	ARG_UNUSED(start);
+}
+#endif /* CONFIG_SPIN_LOCK_STATS */
+
+#ifndef CONFIG_SPIN_LOCK_MCS
+void z_spin_lock_wait(struct k_spinlock *l, atomic_val_t ticket)
+{
+	u32_t start = spin_stats_start();
+	u32_t spins = 0U;
+
+#ifdef CONFIG_SPIN_LOCK_TICKET
+	/* Only read the shared line while waiting, the ticket taken
+	 * already orders us among the waiters
+	 */
+	while (atomic_get(&l->owner) != ticket) {
+		spins++;
+	}
+#else
+	ARG_UNUSED(ticket);
+
+	/* Test and test-and-set: spin on a plain read, so that the
+	 * cache line stays shared until the lock looks free
+	 */
+	do {
+		while (atomic_get(&l->locked) != 0) {
+			spins++;
+		}
+	} while (!atomic_cas(&l->locked, 0, 1));
+#endif
+
+	spin_stats_update(l, spins, start);
+}
+#else
+/* MCS queue nodes.  Each CPU owns CONFIG_SPIN_LOCK_MCS_DEPTH of them,
+ * one per lock it holds or waits for, and only its own code allocates
+ * them with interrupts locked.  Locks refer to nodes by index + 1.
+ */
+struct mcs_node {
+	/* Index + 1 of the node queued after this one, 0 if none */
+	atomic_t next;
+	/* Cleared by the previous owner to hand the lock over */
+	atomic_t wait;
+	/* Lock the node is queued on, NULL when free */
+	struct k_spinlock *lock;
+};
+
+#define MCS_DEPTH CONFIG_SPIN_LOCK_MCS_DEPTH
+
+static struct mcs_node mcs_nodes[CONFIG_MP_NUM_CPUS][MCS_DEPTH];
+
+static inline struct mcs_node *mcs_node(atomic_val_t idx)
+{
+	return &mcs_nodes[(idx - 1) / MCS_DEPTH][(idx - 1) % MCS_DEPTH];
+}
+
+/* Returns the index + 1 of the node of this CPU queued on l, so a
+ * NULL l finds a free node.  Locks may be released in any order.
+ */
+static atomic_val_t mcs_find(int id, struct k_spinlock *l)
+{
+	for (int i = 0; i < MCS_DEPTH; i++) {
+		if (mcs_nodes[id][i].lock == l) {
+			return id * MCS_DEPTH + i + 1;
+		}
+	}
+
+	return 0;
+}
+
+void z_spin_mcs_lock(struct k_spinlock *l)
+{
+	atomic_val_t idx = mcs_find(_current_cpu->id, NULL);
+	struct mcs_node *node;
+	atomic_val_t prev;
+	u32_t start, spins = 0U;
+
+	__ASSERT(idx != 0, "Out of MCS nodes, raise SPIN_LOCK_MCS_DEPTH");
+	node = mcs_node(idx);
+	node->lock = l;
+	atomic_set(&node->next, 0);
+	atomic_set(&node->wait, 1);
+
+	prev = atomic_set(&l->tail, idx);
+	if (prev == 0) {
+		return;
+	}
+
+	/* Queue behind the previous tail and spin on our own node only */
+	start = spin_stats_start();
+	atomic_set(&mcs_node(prev)->next, idx);
+	while (atomic_get(&node->wait) != 0) {
+		spins++;
+	}
+
+	spin_stats_update(l, spins, start);
+}
+
+void z_spin_mcs_unlock(struct k_spinlock *l)
+{
+	atomic_val_t idx = mcs_find(_current_cpu->id, l);
+	struct mcs_node *node;
+	atomic_val_t next;
+
+	__ASSERT(idx != 0, "Not my spinlock!");
+	node = mcs_node(idx);
+	next = atomic_get(&node->next);
+
+	if (next == 0) {
+		if (atomic_cas(&l->tail, idx, 0)) {
+			node->lock = NULL;
+			return;
+		}
+
+		/* A CPU swapped the tail but has not linked itself yet */
+		while ((next = atomic_get(&node->next)) == 0) {
+		}
+	}
+
+	/* Nobody refers to our node past this point */
+	node->lock = NULL;
+	atomic_clear(&mcs_node(next)->wait);
+}
+#endif /* CONFIG_SPIN_LOCK_MCS */
+
 extern k_thread_stack_t _interrupt_stack1[];
 extern k_thread_stack_t _interrupt_stack2[];
 extern k_thread_stack_t _interrupt_stack3[];
@@ -27,6 +27,9 @@ static int k_sys_work_q_init(struct device *dev)
 		       K_THREAD_STACK_SIZEOF(sys_work_q_stack),
 		       CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
 	k_thread_name_set(&k_sys_work_q.thread, "sysworkq");
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+	(void)k_work_q_latency_stats_register(&k_sys_work_q, "sysworkq");
+#endif
 
 	return 0;
 }
@@ -31,6 +31,7 @@
 #include <init.h>
 #include <tracing.h>
 #include <stdbool.h>
+#include <string.h>
 
 extern struct _static_thread_data _static_thread_data_list_start[];
 extern struct _static_thread_data _static_thread_data_list_end[];
@@ -289,9 +290,7 @@ static void schedule_new_thread(struct k_thread *thread, s32_t delay)
 	if (delay == 0) {
 		k_thread_start(thread);
 	} else {
-		s32_t ticks = _TICK_ALIGN + z_ms_to_ticks(delay);
-
-		z_add_thread_timeout(thread, ticks);
+		z_add_thread_timeout(thread, z_timeout_to_ticks(delay));
 	}
 #else
 	ARG_UNUSED(delay);
@@ -393,6 +392,10 @@ void z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(new_thread);
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+	(void)memset(new_thread->obj_handles, 0,
+		     sizeof(new_thread->obj_handles));
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -581,6 +584,11 @@ void z_thread_single_abort(struct k_thread *thread)
 		thread->fn_abort();
 	}
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* Stop the period timer, the thread must not be readied */
+	z_thread_reservation_abort(thread);
+#endif
+
 	if (IS_ENABLED(CONFIG_SMP)) {
 		z_sched_abort(thread);
 	}
@@ -687,9 +695,23 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 	thread_base->sched_locked = 0U;
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	thread_base->pended_mutex = NULL;
+#endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* New threads are first queued on the CPU creating them */
+	thread_base->cpu = z_arch_curr_cpu()->id;
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread_base->cbs = (struct _cbs) {};
+	z_init_timeout(&thread_base->cbs.period_timeout, NULL);
+#endif
 }
 
 FUNC_NORETURN void k_thread_user_mode_enter(k_thread_entry_t entry,
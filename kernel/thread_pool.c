@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel thread pool.
+ *
+ * The threads of a pool are created once and loop forever: each waits for
+ * an entry point, runs it, and signals it returned. A thread is busy from
+ * its spawn until it is joined or detached, and idle threads are kept in a
+ * LIFO, so the stack most recently used is the next one used.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <ksched.h>
+#include <atomic.h>
+#include <errno.h>
+#include <string.h>
+
+/* Worker flags */
+#define WORKER_BUSY BIT(0)
+#define WORKER_EXITED BIT(1)
+#define WORKER_DETACHED BIT(2)
+
+static void worker_release(struct k_thread_pool_worker *worker)
+{
+	struct k_thread_pool *pool = worker->pool;
+	k_spinlock_key_t key;
+
+	/* given for a detached thread that was done already */
+	k_sem_reset(&worker->done);
+
+	key = k_spin_lock(&pool->lock);
+	atomic_clear(&worker->flags);
+	sys_slist_prepend(&pool->idle, &worker->node);
+	pool->stats.busy--;
+	k_spin_unlock(&pool->lock, key);
+
+	k_sem_give(&pool->idle_count);
+}
+
+static void worker_loop(void *p1, void *p2, void *p3)
+{
+	struct k_thread_pool_worker *worker = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&worker->start, K_FOREVER);
+
+		worker->entry(worker->p1, worker->p2, worker->p3);
+
+		/* either this thread or the detaching one releases it */
+		if ((atomic_or(&worker->flags, WORKER_EXITED) &
+		     WORKER_DETACHED) != 0) {
+			worker_release(worker);
+		} else {
+			k_sem_give(&worker->done);
+		}
+	}
+}
+
+static struct k_thread_pool_worker *pool_worker(struct k_thread_pool *pool,
+						k_tid_t thread)
+{
+	struct k_thread_pool_worker *worker =
+		CONTAINER_OF(thread, struct k_thread_pool_worker, thread);
+
+	if (worker < pool->workers || worker >= pool->workers + pool->count) {
+		return NULL;
+	}
+
+	return worker;
+}
+
+void k_thread_pool_start(struct k_thread_pool *pool, int prio)
+{
+	int i;
+
+	sys_slist_init(&pool->idle);
+	k_sem_init(&pool->idle_count, pool->count, pool->count);
+	(void)memset(&pool->stats, 0, sizeof(pool->stats));
+
+	for (i = 0; i < pool->count; i++) {
+		struct k_thread_pool_worker *worker = &pool->workers[i];
+
+		worker->pool = pool;
+		atomic_clear(&worker->flags);
+		k_sem_init(&worker->start, 0, 1);
+		k_sem_init(&worker->done, 0, 1);
+		sys_slist_append(&pool->idle, &worker->node);
+
+		(void)k_thread_create(&worker->thread,
+				      pool->stacks + i * pool->stack_len,
+				      pool->stack_size, worker_loop,
+				      worker, NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+}
+
+k_tid_t k_thread_pool_spawn(struct k_thread_pool *pool,
+			    k_thread_entry_t entry,
+			    void *p1, void *p2, void *p3,
+			    int prio, s32_t timeout)
+{
+	struct k_thread_pool_worker *worker;
+	k_spinlock_key_t key;
+
+	__ASSERT(_is_valid_prio(prio, NULL), "invalid priority (%d)", prio);
+
+	if (k_sem_take(&pool->idle_count, timeout) != 0) {
+		key = k_spin_lock(&pool->lock);
+		pool->stats.exhausted++;
+		k_spin_unlock(&pool->lock, key);
+
+		return NULL;
+	}
+
+	key = k_spin_lock(&pool->lock);
+	worker = CONTAINER_OF(sys_slist_get_not_empty(&pool->idle),
+			      struct k_thread_pool_worker, node);
+	atomic_set(&worker->flags, WORKER_BUSY);
+	pool->stats.spawned++;
+	pool->stats.busy++;
+	pool->stats.max_busy = MAX(pool->stats.max_busy, pool->stats.busy);
+	k_spin_unlock(&pool->lock, key);
+
+	worker->entry = entry;
+	worker->p1 = p1;
+	worker->p2 = p2;
+	worker->p3 = p3;
+	k_thread_priority_set(&worker->thread, prio);
+	k_sem_give(&worker->start);
+
+	return &worker->thread;
+}
+
+int k_thread_pool_join(struct k_thread_pool *pool, k_tid_t thread,
+		       s32_t timeout)
+{
+	struct k_thread_pool_worker *worker = pool_worker(pool, thread);
+
+	if (worker == NULL ||
+	    (atomic_get(&worker->flags) & (WORKER_BUSY | WORKER_DETACHED)) !=
+	    WORKER_BUSY) {
+		return -EINVAL;
+	}
+
+	if (k_sem_take(&worker->done, timeout) != 0) {
+		return -EAGAIN;
+	}
+
+	worker_release(worker);
+
+	return 0;
+}
+
+int k_thread_pool_detach(struct k_thread_pool *pool, k_tid_t thread)
+{
+	struct k_thread_pool_worker *worker = pool_worker(pool, thread);
+
+	if (worker == NULL ||
+	    (atomic_get(&worker->flags) & (WORKER_BUSY | WORKER_DETACHED)) !=
+	    WORKER_BUSY) {
+		return -EINVAL;
+	}
+
+	if ((atomic_or(&worker->flags, WORKER_DETACHED) & WORKER_EXITED) != 0) {
+		worker_release(worker);
+	}
+
+	return 0;
+}
+
+void k_thread_pool_stats_get(struct k_thread_pool *pool,
+			     struct k_thread_pool_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
+
+	*stats = pool->stats;
+	k_spin_unlock(&pool->lock, key);
+}
@@ -17,7 +17,9 @@
 
 static u64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -37,6 +39,177 @@ Z_SYSCALL_HANDLER(z_clock_hw_cycles_per_sec_runtime_get)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+
+/* Hierarchical timing wheel.  Ticks are split into WHEEL_BITS wide
+ * "digits".  A timeout lives on the level of the most significant
+ * digit in which its absolute expiry differs from curr_tick, in the
+ * slot given by its own digit at that level.  That slot is therefore
+ * always ahead of curr_tick, the earliest timeout always sits in the
+ * lowest occupied slot of the lowest non-empty level, and insert and
+ * remove never need to look at any other timeout.  As curr_tick
+ * enters an upper level slot, the contents are cascaded down a
+ * level.  Expiries beyond the top level go on an unsorted overflow
+ * list which is cascaded when curr_tick crosses a top level
+ * boundary.  Slot lists are only valid while their bitmap bit is
+ * set, which avoids having to initialize them all at boot.
+ */
+#define WHEEL_BITS CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS ((32 + WHEEL_BITS - 1) / WHEEL_BITS)
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+static u32_t wheel_bitmap[WHEEL_LEVELS];
+
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+static inline u32_t wheel_digit(u64_t tick, int lvl)
+{
+	return (u32_t)(tick >> (lvl * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+}
+
+/* Returns WHEEL_LEVELS for expiries that belong on the overflow list */
+static int wheel_level(u64_t expiry)
+{
+	u64_t diff = (expiry ^ curr_tick) >> WHEEL_BITS;
+	int lvl = 0;
+
+	while (diff != 0 && lvl < WHEEL_LEVELS) {
+		diff >>= WHEEL_BITS;
+		lvl++;
+	}
+
+	return lvl;
+}
+
+static void wheel_insert(struct _timeout *t)
+{
+	int lvl = wheel_level(t->expiry);
+	u32_t slot;
+
+	if (lvl == WHEEL_LEVELS) {
+		sys_dlist_append(&wheel_overflow, &t->node);
+		return;
+	}
+
+	slot = wheel_digit(t->expiry, lvl);
+	if ((wheel_bitmap[lvl] & BIT(slot)) == 0U) {
+		sys_dlist_init(&wheel[lvl][slot]);
+		wheel_bitmap[lvl] |= BIT(slot);
+	}
+	sys_dlist_append(&wheel[lvl][slot], &t->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	int lvl = wheel_level(t->expiry);
+	u32_t slot = wheel_digit(t->expiry, lvl);
+
+	sys_dlist_remove(&t->node);
+
+	if (lvl < WHEEL_LEVELS && sys_dlist_is_empty(&wheel[lvl][slot])) {
+		wheel_bitmap[lvl] &= ~BIT(slot);
+	}
+}
+
+/* Start tick of the earliest occupied slot.  This is exact for
+ * level zero and a lower bound otherwise.
+ */
+static bool wheel_next(u64_t *tick)
+{
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		u32_t d = wheel_digit(curr_tick, lvl);
+		u32_t ahead = wheel_bitmap[lvl] & ~(BIT(d) - 1);
+
+		if (ahead != 0U) {
+			u64_t mask = ((u64_t)WHEEL_SLOTS << (lvl * WHEEL_BITS)) - 1;
+
+			*tick = (curr_tick & ~mask) |
+				((u64_t)__builtin_ctz(ahead) << (lvl * WHEEL_BITS));
+			return true;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		*tick = ((curr_tick >> (WHEEL_LEVELS * WHEEL_BITS)) + 1)
+			<< (WHEEL_LEVELS * WHEEL_BITS);
+		return true;
+	}
+
+	return false;
+}
+
+/* Moves curr_tick forward to @tick, which must not be past any
+ * pending expiry, and cascades every slot whose range it entered.
+ */
+static void wheel_advance(u64_t tick)
+{
+	u64_t prev = curr_tick;
+	sys_dlist_t moved;
+	sys_dnode_t *node;
+
+	sys_dlist_init(&moved);
+
+	for (int lvl = 1; lvl < WHEEL_LEVELS; lvl++) {
+		int shift = lvl * WHEEL_BITS;
+		u32_t due;
+
+		if ((prev >> shift) == (tick >> shift)) {
+			break;
+		}
+
+		if ((prev >> (shift + WHEEL_BITS)) != (tick >> (shift + WHEEL_BITS))) {
+			due = wheel_bitmap[lvl];
+		} else {
+			u32_t d = wheel_digit(tick, lvl);
+
+			due = wheel_bitmap[lvl] & (BIT(d) | (BIT(d) - 1));
+		}
+
+		wheel_bitmap[lvl] &= ~due;
+		while (due != 0U) {
+			u32_t slot = __builtin_ctz(due);
+
+			due &= ~BIT(slot);
+			while ((node = sys_dlist_get(&wheel[lvl][slot])) != NULL) {
+				sys_dlist_append(&moved, node);
+			}
+		}
+	}
+
+	if ((prev >> (WHEEL_LEVELS * WHEEL_BITS)) !=
+	    (tick >> (WHEEL_LEVELS * WHEEL_BITS))) {
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&moved, node);
+		}
+	}
+
+	curr_tick = tick;
+
+	while ((node = sys_dlist_get(&moved)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		__ASSERT(t->expiry >= curr_tick, "wheel advanced past expiry");
+		wheel_insert(t);
+	}
+}
+
+/* A timeout due exactly at curr_tick, if any */
+static struct _timeout *wheel_expired(void)
+{
+	u32_t slot = wheel_digit(curr_tick, 0);
+
+	if ((wheel_bitmap[0] & BIT(slot)) == 0U) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(sys_dlist_peek_head(&wheel[0][slot]),
+			    struct _timeout, node);
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -60,6 +233,32 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Timer interrupts saved by expiring timeouts late, in a batch */
+static u32_t slack_wakeups_avoided;
+
+/* Ticks from curr_tick to the latest wakeup that does not delay any
+ * timeout by more than its slack.  Only the timeouts expiring before
+ * that point need to be looked at.
+ */
+static s32_t slack_wakeup(void)
+{
+	s32_t exp = 0, wake = INT_MAX;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		exp += t->dticks;
+		if (exp > wake) {
+			break;
+		}
+		wake = MIN(wake, exp + MIN(t->slack, INT_MAX - exp));
+	}
+
+	return wake;
+}
+#endif
+
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static s32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0;
@@ -68,8 +267,19 @@ static s32_t elapsed(void)
 static s32_t next_timeout(void)
 {
 	int maxw = can_wait_forever ? K_FOREVER : INT_MAX;
+#ifdef CONFIG_TIMEOUT_WHEEL
+	u64_t tick;
+	s32_t ret = !wheel_next(&tick) ? maxw :
+		MAX(0, (s32_t)MIN(tick - curr_tick, INT_MAX) - elapsed());
+#else
 	struct _timeout *to = first();
-	s32_t ret = to == NULL ? maxw : MAX(0, to->dticks - elapsed());
+#ifdef CONFIG_TIMEOUT_SLACK
+	s32_t wake = to == NULL ? 0 : slack_wakeup();
+#else
+	s32_t wake = to == NULL ? 0 : to->dticks;
+#endif
+	s32_t ret = to == NULL ? maxw : MAX(0, wake - elapsed());
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -79,14 +289,31 @@ static s32_t next_timeout(void)
 	return ret;
 }
 
-void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
+static void add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 {
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 	ticks = MAX(1, ticks);
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	LOCKED(&timeout_lock) {
+		u64_t prev, next;
+		bool was_empty = !wheel_next(&prev);
+
+		to->expiry = curr_tick + elapsed() + ticks;
+		wheel_insert(to);
+
+		(void)wheel_next(&next);
+		if (was_empty || next != prev) {
+			z_clock_set_timeout(next_timeout(), false);
+		}
+	}
+#else
 	LOCKED(&timeout_lock) {
 		struct _timeout *t;
+#ifdef CONFIG_TIMEOUT_SLACK
+		s32_t prev_wake = first() == NULL ? INT_MAX : slack_wakeup();
+#endif
 
 		to->dticks = ticks + elapsed();
 		for (t = first(); t != NULL; t = next(t)) {
@@ -104,12 +331,42 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 			sys_dlist_append(&timeout_list, &to->node);
 		}
 
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* A later timeout with little slack can move the wakeup
+		 * earlier, too
+		 */
+		if (to == first() || slack_wakeup() < prev_wake) {
+#else
 		if (to == first()) {
+#endif
 			z_clock_set_timeout(next_timeout(), false);
 		}
 	}
+#endif
+}
+
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = 0;
+#endif
+	add_timeout(to, fn, ticks);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn,
+			 s32_t ticks, s32_t slack)
+{
+	to->slack = MAX(slack, 0);
+	add_timeout(to, fn, ticks);
+}
+
+u32_t k_timeout_slack_wakeups_avoided(void)
+{
+	return slack_wakeups_avoided;
+}
+#endif
+
 int z_abort_timeout(struct _timeout *to)
 {
 	int ret = -EINVAL;
@@ -133,12 +390,16 @@ s32_t z_timeout_remaining(struct _timeout *timeout)
 	}
 
 	LOCKED(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_WHEEL
+		ticks = (s32_t)(timeout->expiry - curr_tick);
+#else
 		for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 			ticks += t->dticks;
 			if (timeout == t) {
 				break;
 			}
 		}
+#endif
 	}
 
 	return ticks - elapsed();
@@ -173,8 +434,35 @@ void z_set_timeout_expiry(s32_t ticks, bool idle)
 	}
 }
 
-void z_clock_announce(s32_t ticks)
+#ifndef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+static struct k_spinlock cycle_lock;
+static u32_t cycle_last;
+static u32_t cycle_hi;
+
+/* Counts the wraps of the 32 bit counter seen since the last call, which
+ * z_clock_announce() makes at least once per wrap.
+ */
+u64_t z_timer_cycle_get_64(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&cycle_lock);
+	u32_t now = k_cycle_get_32();
+
+	if (now < cycle_last) {
+		cycle_hi++;
+	}
+	cycle_last = now;
+
+	k_spin_unlock(&cycle_lock, key);
+	return ((u64_t)cycle_hi << 32) | now;
+}
+#endif
+
+__hotfunc(z_clock_announce) void z_clock_announce(s32_t ticks)
 {
+#ifndef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	(void)z_timer_cycle_get_64();
+#endif
+
 #ifdef CONFIG_TIMESLICING
 	z_time_slice(ticks);
 #endif
@@ -183,12 +471,50 @@ void z_clock_announce(s32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	u64_t target = curr_tick + ticks;
+	u64_t tick;
+
+	while (wheel_next(&tick) && tick <= target) {
+		struct _timeout *t;
+
+		wheel_advance(tick);
+		announce_remaining = target - curr_tick;
+
+		while ((t = wheel_expired()) != NULL) {
+			t->dticks = 0;
+			remove_timeout(t);
+
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+	}
+
+	wheel_advance(target);
+#else
+#ifdef CONFIG_TIMEOUT_SLACK
+	bool counted = false;
+#endif
+
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
 
 		curr_tick += dt;
 		announce_remaining -= dt;
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Each distinct tick that was only reached late, because
+		 * of slack, is an interrupt that did not happen
+		 */
+		if (dt != 0) {
+			counted = false;
+		}
+		if (!counted && t->slack > 0 && announce_remaining > 0) {
+			slack_wakeups_avoided++;
+			counted = true;
+		}
+#endif
 		t->dticks = 0;
 		remove_timeout(t);
 
@@ -202,6 +528,7 @@ void z_clock_announce(s32_t ticks)
 	}
 
 	curr_tick += announce_remaining;
+#endif
 	announce_remaining = 0;
 
 	z_clock_set_timeout(next_timeout(), false);
@@ -268,3 +595,19 @@ Z_SYSCALL_HANDLER(k_uptime_get, ret_p)
 	return 0;
 }
 #endif
+
+s64_t z_impl_k_uptime_ticks(void)
+{
+	return z_tick_get();
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_uptime_ticks, ret_p)
+{
+	u64_t *ret = (u64_t *)ret_p;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(ret, sizeof(*ret)));
+	*ret = z_impl_k_uptime_ticks();
+	return 0;
+}
+#endif
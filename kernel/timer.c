@@ -17,6 +17,17 @@ extern struct k_timer _k_timer_list_end[];
 
 static struct k_spinlock lock;
 
+/* Durations may also be absolute deadlines */
+static inline bool duration_is_abs(s32_t duration)
+{
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+	return z_timeout_is_abs(duration);
+#else
+	ARG_UNUSED(duration);
+	return false;
+#endif
+}
+
 #ifdef CONFIG_OBJECT_TRACING
 
 struct k_timer *_trace_list_k_timer;
@@ -57,8 +68,9 @@ void z_timer_expiration_handler(struct _timeout *t)
 	 * since we're already aligned to a tick boundary
 	 */
 	if (timer->period > 0) {
-		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-			     timer->period);
+		z_add_timeout_slack(&timer->timeout, z_timer_expiration_handler,
+				    timer->period,
+				    z_timeout_slack(&timer->timeout));
 	}
 
 	/* update timer's status */
@@ -109,21 +121,36 @@ void k_timer_init(struct k_timer *timer,
 }
 
 
-void z_impl_k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
+void z_impl_k_timer_start_slack(struct k_timer *timer, s32_t duration,
+				s32_t period, s32_t slack)
 {
-	__ASSERT(duration >= 0 && period >= 0 &&
-		 (duration != 0 || period != 0), "invalid parameters\n");
+	__ASSERT((duration >= 0 || duration_is_abs(duration)) &&
+		 period >= 0 && (duration != 0 || period != 0),
+		 "invalid parameters\n");
+	__ASSERT(slack >= 0, "invalid slack\n");
 
 	volatile s32_t period_in_ticks, duration_in_ticks;
 
 	period_in_ticks = z_ms_to_ticks(period);
 	duration_in_ticks = z_ms_to_ticks(duration);
 
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+	/* First expiry at a deadline, the next ones a period apart */
+	if (z_timeout_is_abs(duration)) {
+		duration_in_ticks = MAX(z_timeout_abs_ticks_left(duration), 0);
+	}
+#endif
+
 	(void)z_abort_timeout(&timer->timeout);
 	timer->period = period_in_ticks;
 	timer->status = 0U;
-	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-		     duration_in_ticks);
+	z_add_timeout_slack(&timer->timeout, z_timer_expiration_handler,
+			    duration_in_ticks, z_ms_to_ticks(slack));
+}
+
+void z_impl_k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
+{
+	z_impl_k_timer_start_slack(timer, duration, period, 0);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -134,12 +161,30 @@ Z_SYSCALL_HANDLER(k_timer_start, timer, duration_p, period_p)
 	duration = (s32_t)duration_p;
 	period = (s32_t)period_p;
 
-	Z_OOPS(Z_SYSCALL_VERIFY(duration >= 0 && period >= 0 &&
-				(duration != 0 || period != 0)));
+	Z_OOPS(Z_SYSCALL_VERIFY((duration >= 0 ||
+				 duration_is_abs(duration)) &&
+				period >= 0 && (duration != 0 || period != 0)));
 	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
 	z_impl_k_timer_start((struct k_timer *)timer, duration, period);
 	return 0;
 }
+
+Z_SYSCALL_HANDLER(k_timer_start_slack, timer, duration_p, period_p, slack_p)
+{
+	s32_t duration, period, slack;
+
+	duration = (s32_t)duration_p;
+	period = (s32_t)period_p;
+	slack = (s32_t)slack_p;
+
+	Z_OOPS(Z_SYSCALL_VERIFY((duration >= 0 || duration_is_abs(duration)) &&
+				period >= 0 && (duration != 0 || period != 0) &&
+				slack >= 0));
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_start_slack((struct k_timer *)timer, duration, period,
+				   slack);
+	return 0;
+}
 #endif
 
 void z_impl_k_timer_stop(struct k_timer *timer)
@@ -60,6 +60,23 @@ extern u8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 
 static void clear_perms_cb(struct _k_object *ko, void *ctx_ptr);
 
+#ifdef CONFIG_USERSPACE_OBJ_HANDLES
+BUILD_ASSERT_MSG((CONFIG_USERSPACE_OBJ_HANDLES_NUM &
+		  (CONFIG_USERSPACE_OBJ_HANDLES_NUM - 1)) == 0,
+		 "USERSPACE_OBJ_HANDLES_NUM must be a power of two");
+
+u32_t z_object_handles_gen;
+
+static inline void object_handles_invalidate(void)
+{
+	z_object_handles_gen++;
+}
+#else
+static inline void object_handles_invalidate(void)
+{
+}
+#endif
+
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -295,6 +312,7 @@ void k_object_free(void *obj)
 	if (dyn_obj != NULL) {
 		rb_remove(&obj_rb_tree, &dyn_obj->node);
 		sys_dlist_remove(&dyn_obj->obj_list);
+		object_handles_invalidate();
 
 		if (dyn_obj->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn_obj->kobj.data);
@@ -358,6 +376,7 @@ static void unref_check(struct _k_object *ko, int index)
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
 	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
+	object_handles_invalidate();
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
 	struct dyn_obj *dyn_obj =
@@ -604,6 +623,7 @@ void z_object_recycle(void *obj)
 
 	if (ko != NULL) {
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+		object_handles_invalidate();
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
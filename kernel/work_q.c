@@ -35,6 +35,61 @@ void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+static void work_pool_spawn(struct k_work_pool *pool, struct k_thread *thread,
+			    int idx, int prio, u32_t flags)
+{
+	k_thread_stack_t *stack = (k_thread_stack_t *)
+		((char *)pool->stacks + idx * pool->stack_len);
+
+	(void)k_thread_create(thread, stack, pool->stack_size, z_work_q_main,
+			      &pool->work_q, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_name_set(thread, WORKQUEUE_THREAD_NAME);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((flags & K_WORK_POOL_PIN_CPU) != 0U) {
+		(void)k_thread_cpu_mask_clear(thread);
+		(void)k_thread_cpu_mask_enable(thread,
+					       idx % CONFIG_MP_NUM_CPUS);
+	}
+#else
+	ARG_UNUSED(flags);
+#endif
+
+	k_thread_start(thread);
+}
+
+void k_work_pool_start(struct k_work_pool *pool, int prio, u32_t flags)
+{
+	__ASSERT(pool->num_threads > 0, "");
+
+	k_queue_init(&pool->work_q.queue);
+
+	work_pool_spawn(pool, &pool->work_q.thread, 0, prio, flags);
+	for (int i = 1; i < pool->num_threads; i++) {
+		work_pool_spawn(pool, &pool->threads[i - 1], i, prio, flags);
+	}
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+STATS_NAME_START(k_work_q_latency)
+	STATS_NAME(k_work_q_latency, lt_10us)
+	STATS_NAME(k_work_q_latency, lt_100us)
+	STATS_NAME(k_work_q_latency, lt_1ms)
+	STATS_NAME(k_work_q_latency, lt_10ms)
+	STATS_NAME(k_work_q_latency, lt_100ms)
+	STATS_NAME(k_work_q_latency, ge_100ms)
+	STATS_NAME(k_work_q_latency, max_us)
+STATS_NAME_END(k_work_q_latency);
+
+int k_work_q_latency_stats_register(struct k_work_q *work_q,
+				    const char *name)
+{
+	return STATS_INIT_AND_REG(work_q->latency, STATS_SIZE_32, name);
+}
+#endif /* CONFIG_WORKQUEUE_LATENCY_STATS */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
@@ -76,6 +131,13 @@ static int work_cancel(struct k_delayed_work *work)
 int k_delayed_work_submit_to_queue(struct k_work_q *work_q,
 				   struct k_delayed_work *work,
 				   s32_t delay)
+{
+	return k_delayed_work_submit_to_queue_slack(work_q, work, delay, 0);
+}
+
+int k_delayed_work_submit_to_queue_slack(struct k_work_q *work_q,
+					 struct k_delayed_work *work,
+					 s32_t delay, s32_t slack)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	int err = 0;
@@ -107,8 +169,8 @@ int k_delayed_work_submit_to_queue(struct k_work_q *work_q,
 	}
 
 	/* Add timeout */
-	z_add_timeout(&work->timeout, work_timeout,
-		     _TICK_ALIGN + z_ms_to_ticks(delay));
+	z_add_timeout_slack(&work->timeout, work_timeout,
+			    z_timeout_to_ticks(delay), z_ms_to_ticks(slack));
 
 done:
 	k_spin_unlock(&lock, key);
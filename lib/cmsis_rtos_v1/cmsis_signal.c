@@ -7,7 +7,6 @@
 #include <kernel_structs.h>
 #include <cmsis_os.h>
 
-#define NSEC_PER_MSEC		(NSEC_PER_USEC * USEC_PER_MSEC)
 #define MAX_VALID_SIGNAL_VAL	((1 << osFeature_Signals) - 1)
 
 void *k_thread_other_custom_data_get(struct k_thread *thread_id)
@@ -20,7 +19,7 @@ void *k_thread_other_custom_data_get(struct k_thread *thread_id)
  */
 int32_t osSignalSet(osThreadId thread_id, int32_t signals)
 {
-	int sig, key;
+	int sig;
 
 	if ((thread_id == NULL) || (!signals) ||
 		(signals & 0x80000000) || (signals > MAX_VALID_SIGNAL_VAL)) {
@@ -31,12 +30,8 @@ int32_t osSignalSet(osThreadId thread_id, int32_t signals)
 		(osThreadDef_t *)k_thread_other_custom_data_get(
 						(struct k_thread *)thread_id);
 
-	key = irq_lock();
-	sig = thread_def->signal_results;
-	thread_def->signal_results |= signals;
-	irq_unlock(key);
-
-	k_poll_signal_raise(thread_def->poll_signal, signals);
+	sig = k_event_get(thread_def->signals);
+	k_event_post(thread_def->signals, signals);
 
 	return sig;
 }
@@ -46,8 +41,6 @@ int32_t osSignalSet(osThreadId thread_id, int32_t signals)
  */
 int32_t osSignalClear(osThreadId thread_id, int32_t signals)
 {
-	int sig, key;
-
 	if (k_is_in_isr() || (thread_id == NULL) || (!signals) ||
 		(signals & 0x80000000) || (signals > MAX_VALID_SIGNAL_VAL)) {
 		return 0x80000000;
@@ -57,12 +50,7 @@ int32_t osSignalClear(osThreadId thread_id, int32_t signals)
 		(osThreadDef_t *)k_thread_other_custom_data_get(
 						(struct k_thread *)thread_id);
 
-	key = irq_lock();
-	sig = thread_def->signal_results;
-	thread_def->signal_results &= ~(signals);
-	irq_unlock(key);
-
-	return sig;
+	return k_event_clear(thread_def->signals, signals);
 }
 
 /**
@@ -71,10 +59,10 @@ int32_t osSignalClear(osThreadId thread_id, int32_t signals)
  */
 osEvent osSignalWait(int32_t signals, uint32_t millisec)
 {
-	int retval, key;
+	u32_t options = K_EVENT_WAIT_ALL | K_EVENT_WAIT_CLEAR;
+	s32_t timeout;
 	osEvent evt;
-	u32_t time_delta_ms, timeout = millisec;
-	u64_t time_stamp_start, hwclk_cycles_delta, time_delta_ns;
+	u32_t sig;
 
 	if (k_is_in_isr()) {
 		evt.status = osErrorISR;
@@ -89,75 +77,32 @@ osEvent osSignalWait(int32_t signals, uint32_t millisec)
 
 	osThreadDef_t *thread_def = k_thread_custom_data_get();
 
-	for (;;) {
-
-		time_stamp_start = (u64_t)k_cycle_get_32();
-
-		switch (millisec) {
-		case 0:
-			retval = k_poll(thread_def->poll_event, 1, K_NO_WAIT);
-			break;
-		case osWaitForever:
-			retval = k_poll(thread_def->poll_event, 1, K_FOREVER);
-			break;
-		default:
-			retval = k_poll(thread_def->poll_event, 1, timeout);
-			break;
-		}
-
-		switch (retval) {
-		case 0:
-			evt.status = osEventSignal;
-			break;
-		case -EAGAIN:
-			if (millisec == 0U) {
-				evt.status = osOK;
-			} else {
-				evt.status = osEventTimeout;
-			}
-			return evt;
-		default:
-			evt.status = osErrorValue;
-			return evt;
-		}
-
-		__ASSERT(thread_def->poll_event->state
-				== K_POLL_STATE_SIGNALED,
-			"event state not signalled!");
-		__ASSERT(thread_def->poll_event->signal->signaled == 1,
-			"event signaled is not 1");
-
-		/* Reset the states to facilitate the next trigger */
-		thread_def->poll_event->signal->signaled = 0;
-		thread_def->poll_event->state = K_POLL_STATE_NOT_READY;
-
-		/* Check if all events we are waiting on have been signalled */
-		if ((thread_def->signal_results & signals) == signals) {
-			break;
-		}
-
-		/* If we need to wait on more signals, we need to adjust the
-		 * timeout value accordingly based on the time that has
-		 * already elapsed.
-		 */
-		hwclk_cycles_delta = (u64_t)k_cycle_get_32() - time_stamp_start;
-		time_delta_ns =
-			(u32_t)SYS_CLOCK_HW_CYCLES_TO_NS(hwclk_cycles_delta);
-		time_delta_ms =	(u32_t)time_delta_ns/NSEC_PER_MSEC;
-
-		if (timeout > time_delta_ms) {
-			timeout -= time_delta_ms;
-		} else {
-			timeout = 0U;
-		}
+	/* 0 waits for any signal, and leaves them all set */
+	if (signals == 0) {
+		signals = MAX_VALID_SIGNAL_VAL;
+		options = K_EVENT_WAIT_ANY;
 	}
 
-	evt.value.signals = thread_def->signal_results;
+	switch (millisec) {
+	case 0:
+		timeout = K_NO_WAIT;
+		break;
+	case osWaitForever:
+		timeout = K_FOREVER;
+		break;
+	default:
+		timeout = millisec;
+		break;
+	}
+
+	sig = k_event_wait(thread_def->signals, signals, options, timeout);
+	if (sig == 0U) {
+		evt.status = (millisec == 0U) ? osOK : osEventTimeout;
+		return evt;
+	}
 
-	/* Clear signal flags as the thread is ready now */
-	key = irq_lock();
-	thread_def->signal_results &= ~(signals);
-	irq_unlock(key);
+	evt.status = osEventSignal;
+	evt.value.signals = sig;
 
 	return evt;
 }
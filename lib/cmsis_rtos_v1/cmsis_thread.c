@@ -72,9 +72,7 @@ osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *arg)
 		stacksz = CONFIG_CMSIS_THREAD_MAX_STACK_SIZE;
 	}
 
-	k_poll_signal_init(thread_def->poll_signal);
-	k_poll_event_init(thread_def->poll_event, K_POLL_TYPE_SIGNAL,
-			K_POLL_MODE_NOTIFY_ONLY, thread_def->poll_signal);
+	k_event_init(thread_def->signals);
 
 	cm_thread = thread_def->cm_thread;
 	atomic_dec((atomic_t *)&thread_def->instances);
@@ -16,9 +16,7 @@
 struct cv2_thread {
 	sys_dnode_t node;
 	struct k_thread z_thread;
-	struct k_poll_signal poll_signal;
-	struct k_poll_event poll_event;
-	u32_t signal_results;
+	struct k_event thread_flags;
 	char name[16];
 	u32_t attr_bits;
 	struct k_sem join_guard;
@@ -60,12 +58,39 @@ struct cv2_msgq {
 };
 
 struct cv2_event_flags {
-	struct k_poll_signal poll_signal;
-	struct k_poll_event poll_event;
-	u32_t signal_results;
+	struct k_event z_event;
 	char name[16];
 };
 
+/* Kernel timeout of a CMSIS timeout in ticks */
+static inline s32_t cv2_timeout(u32_t timeout)
+{
+	switch (timeout) {
+	case 0:
+		return K_NO_WAIT;
+	case osWaitForever:
+		return K_FOREVER;
+	default:
+		return __ticks_to_ms(timeout);
+	}
+}
+
+/* k_event_wait() options of osFlagsWait* options */
+static inline u32_t cv2_event_options(u32_t options)
+{
+	u32_t opts = K_EVENT_WAIT_ANY;
+
+	if ((options & osFlagsWaitAll) != 0U) {
+		opts |= K_EVENT_WAIT_ALL;
+	}
+
+	if ((options & osFlagsNoClear) == 0U) {
+		opts |= K_EVENT_WAIT_CLEAR;
+	}
+
+	return opts;
+}
+
 extern osThreadId_t get_cmsis_thread_id(k_tid_t tid);
 extern void *is_cmsis_rtos_v2_thread(void *thread_id);
 
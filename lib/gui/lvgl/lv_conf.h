@@ -77,14 +77,15 @@
 #define LV_VDB_PX_BPP	CONFIG_LVGL_BITS_PER_PIXEL
 #endif
 
-#ifdef CONFIG_LVGL_VDB_STATIC
+/* Non-cacheable buffers are allocated by lvgl.c and set at init */
+#if defined(CONFIG_LVGL_VDB_STATIC) && !defined(CONFIG_LVGL_VDB_NOCACHE)
 #define LV_VDB_ADR	0
 #else
 #define LV_VDB_ADR	LV_VDB_ADR_INV
 #endif
 
 #define LV_VDB_DOUBLE	CONFIG_LVGL_DOUBLE_VDB
-#ifdef CONFIG_LVGL_VDB_STATIC
+#if defined(CONFIG_LVGL_VDB_STATIC) && !defined(CONFIG_LVGL_VDB_NOCACHE)
 #define LV_VDB2_ADR	0
 #else
 #define LV_VDB2_ADR	LV_VDB_ADR_INV
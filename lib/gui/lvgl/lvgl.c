@@ -8,8 +8,11 @@
 #include <zephyr.h>
 #include <lvgl.h>
 #include <lv_core/lv_refr.h>
+#include <lv_core/lv_vdb.h>
+#include <linker/section_tags.h>
 #include "lvgl_color.h"
 #include "lvgl_fs.h"
+#include "lvgl_gpu.h"
 
 #define LOG_LEVEL CONFIG_LVGL_LOG_LEVEL
 #include <logging/log.h>
@@ -17,6 +20,85 @@ LOG_MODULE_REGISTER(lvgl);
 
 struct device *lvgl_display_dev;
 
+/* Panels needing each area twice, e.g. EPDs updating a second buffer */
+static bool lvgl_display_write_twice;
+
+static void lvgl_display_write(u16_t x, u16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf)
+{
+	display_write(lvgl_display_dev, x, y, desc, buf);
+	if (lvgl_display_write_twice) {
+		display_write(lvgl_display_dev, x, y, desc, buf);
+	}
+}
+
+#ifdef CONFIG_LVGL_VDB_NOCACHE
+#define LVGL_VDB_BYTES ((LV_VDB_SIZE * LV_VDB_PX_BPP + 7) / 8)
+
+static u8_t lvgl_vdb_buf[LVGL_VDB_BYTES] __nocache __aligned(4);
+#ifdef CONFIG_LVGL_DOUBLE_VDB
+static u8_t lvgl_vdb2_buf[LVGL_VDB_BYTES] __nocache __aligned(4);
+#else
+#define lvgl_vdb2_buf NULL
+#endif
+#endif /* CONFIG_LVGL_VDB_NOCACHE */
+
+#ifdef CONFIG_LVGL_ASYNC_FLUSH
+static struct {
+	struct display_buffer_descriptor desc;
+	const void *buf;
+	u16_t x;
+	u16_t y;
+} lvgl_flush_req;
+
+static K_SEM_DEFINE(lvgl_flush_start, 0, 1);
+static K_SEM_DEFINE(lvgl_flush_idle, 1, 1);
+
+static void lvgl_flush_thread(void)
+{
+	while (true) {
+		k_sem_take(&lvgl_flush_start, K_FOREVER);
+
+		lvgl_display_write(lvgl_flush_req.x, lvgl_flush_req.y,
+				   &lvgl_flush_req.desc, lvgl_flush_req.buf);
+
+		k_sem_give(&lvgl_flush_idle);
+		lv_flush_ready();
+	}
+}
+
+K_THREAD_DEFINE(lvgl_flush_tid, CONFIG_LVGL_FLUSH_THREAD_STACK_SIZE,
+		lvgl_flush_thread, NULL, NULL, NULL,
+		CONFIG_LVGL_FLUSH_THREAD_PRIORITY, 0, K_NO_WAIT);
+
+void lvgl_flush_area(u16_t x, u16_t y,
+		     const struct display_buffer_descriptor *desc,
+		     const void *buf)
+{
+	/*
+	 * lv_flush_ready() frees the first flushing buffer, so only one
+	 * area may be in flight to keep the two buffers in order.
+	 */
+	k_sem_take(&lvgl_flush_idle, K_FOREVER);
+
+	lvgl_flush_req.desc = *desc;
+	lvgl_flush_req.buf = buf;
+	lvgl_flush_req.x = x;
+	lvgl_flush_req.y = y;
+
+	k_sem_give(&lvgl_flush_start);
+}
+#else
+void lvgl_flush_area(u16_t x, u16_t y,
+		     const struct display_buffer_descriptor *desc,
+		     const void *buf)
+{
+	lvgl_display_write(x, y, desc, buf);
+	lv_flush_ready();
+}
+#endif /* CONFIG_LVGL_ASYNC_FLUSH */
+
 #if CONFIG_LVGL_LOG_LEVEL != 0
 static void lvgl_log(lv_log_level_t level, const char *file, uint32_t line,
 		const char *dsc)
@@ -49,6 +131,7 @@ static void lvgl_log(lv_log_level_t level, const char *file, uint32_t line,
 
 static int lvgl_init(struct device *dev)
 {
+	struct display_capabilities cap;
 	lv_disp_drv_t disp_drv;
 
 	ARG_UNUSED(dev);
@@ -60,12 +143,20 @@ static int lvgl_init(struct device *dev)
 		return -ENODEV;
 	}
 
+	display_get_capabilities(lvgl_display_dev, &cap);
+	lvgl_display_write_twice =
+		(cap.screen_info & SCREEN_INFO_DOUBLE_BUFFER) != 0U;
+
 #if CONFIG_LVGL_LOG_LEVEL != 0
 	lv_log_register_print(lvgl_log);
 #endif
 
 	lv_init();
 
+#ifdef CONFIG_LVGL_VDB_NOCACHE
+	lv_vdb_set_adr(lvgl_vdb_buf, lvgl_vdb2_buf);
+#endif
+
 #ifdef CONFIG_LVGL_FILESYSTEM
 	lvgl_fs_init();
 #endif
@@ -78,6 +169,13 @@ static int lvgl_init(struct device *dev)
 #if CONFIG_LVGL_VDB_SIZE != 0
 	disp_drv.vdb_wr = get_vdb_write();
 #endif
+
+#if defined(CONFIG_LVGL_GPU_STM32_DMA2D) || defined(CONFIG_LVGL_GPU_MCUX_PXP)
+	if (lvgl_gpu_init(&disp_drv) != 0) {
+		LOG_WRN("GPU not available, drawing with the CPU.");
+	}
+#endif
+
 	if (lv_disp_drv_register(&disp_drv) == NULL) {
 		LOG_ERR("Failed to register display device.");
 		return -EPERM;
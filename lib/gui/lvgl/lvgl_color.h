@@ -15,6 +15,18 @@ extern "C" {
 
 extern struct device *lvgl_display_dev;
 
+/**
+ * Write a rendered area to the display and signal LVGL once it is sent
+ *
+ * @param x x Coordinate of the upper left corner of the area
+ * @param y y Coordinate of the upper left corner of the area
+ * @param desc Layout of the area in buf
+ * @param buf Virtual display buffer holding the area
+ */
+void lvgl_flush_area(u16_t x, u16_t y,
+		     const struct display_buffer_descriptor *desc,
+		     const void *buf);
+
 void *get_disp_flush(void);
 void *get_vdb_write(void);
 void *get_round_func(void);
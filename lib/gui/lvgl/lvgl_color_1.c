@@ -15,22 +15,13 @@ static void zephyr_disp_flush(s32_t x1, s32_t y1, s32_t x2, s32_t y2,
 {
 	u16_t w = x2 - x1 + 1;
 	u16_t h = y2 - y1 + 1;
-	struct display_capabilities cap;
 	struct display_buffer_descriptor desc;
 
-	display_get_capabilities(lvgl_display_dev, &cap);
-
 	desc.buf_size = (w * h)/8U;
 	desc.width = w;
 	desc.pitch = w;
 	desc.height = h;
-	display_write(lvgl_display_dev, x1, y1, &desc, (void *) color_p);
-	if (cap.screen_info & SCREEN_INFO_DOUBLE_BUFFER) {
-		display_write(lvgl_display_dev, x1, y1, &desc,
-				(void *) color_p);
-	}
-
-	lv_flush_ready();
+	lvgl_flush_area(x1, y1, &desc, color_p);
 }
 
 void zephyr_vdb_write(u8_t *buf, lv_coord_t buf_w, lv_coord_t x,
@@ -21,9 +21,7 @@ static void zephyr_disp_flush(s32_t x1, s32_t y1, s32_t x2, s32_t y2,
 	desc.width = w;
 	desc.pitch = w;
 	desc.height = h;
-	display_write(lvgl_display_dev, x1, y1, &desc, (void *) color_p);
-
-	lv_flush_ready();
+	lvgl_flush_area(x1, y1, &desc, color_p);
 }
 
 #define zephyr_vdb_write NULL
@@ -41,9 +39,7 @@ static void zephyr_disp_flush(s32_t x1, s32_t y1, s32_t x2, s32_t y2,
 	desc.width = w;
 	desc.pitch = w;
 	desc.height = h;
-	display_write(lvgl_display_dev, x1, y1, &desc, (void *) color_p);
-
-	lv_flush_ready();
+	lvgl_flush_area(x1, y1, &desc, color_p);
 }
 
 static void zephyr_vdb_write(u8_t *buf, lv_coord_t buf_w, lv_coord_t x,
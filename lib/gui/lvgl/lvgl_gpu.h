@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_GUI_LVGL_LVGL_GPU_H_
+#define ZEPHYR_LIB_GUI_LVGL_LVGL_GPU_H_
+
+#include <zephyr.h>
+#include <soc.h>
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initialize the GPU and set the fill and blend hooks of a display driver
+ *
+ * @param disp_drv Display driver, before it is registered
+ * @return 0 on success, negative errno code if the GPU is not usable
+ */
+int lvgl_gpu_init(lv_disp_drv_t *disp_drv);
+
+/* Fallbacks for lines too short to be worth the GPU set up */
+static inline void lvgl_gpu_sw_fill(lv_color_t *dest, u32_t length,
+				    lv_color_t color)
+{
+	for (u32_t i = 0; i < length; i++) {
+		dest[i] = color;
+	}
+}
+
+static inline void lvgl_gpu_sw_blend(lv_color_t *dest, const lv_color_t *src,
+				     u32_t length, lv_opa_t opa)
+{
+	for (u32_t i = 0; i < length; i++) {
+		dest[i] = lv_color_mix(src[i], dest[i], opa);
+	}
+}
+
+#if defined(CONFIG_CPU_CORTEX_M7)
+#define LVGL_GPU_DCACHE_LINE 32U
+
+/* Write back a buffer read by the GPU */
+static inline void lvgl_gpu_dcache_clean(const void *buf, u32_t size)
+{
+	u32_t start = (u32_t)buf & ~(LVGL_GPU_DCACHE_LINE - 1U);
+
+	if (SCB->CCR & SCB_CCR_DC_Msk) {
+		SCB_CleanDCache_by_Addr((uint32_t *)start,
+					size + (u32_t)buf - start);
+	}
+}
+
+/*
+ * Write back and drop a buffer written by the GPU, before it starts and
+ * once it is done, as the CPU may fetch lines of it speculatively
+ */
+static inline void lvgl_gpu_dcache_flush(void *buf, u32_t size)
+{
+#ifndef CONFIG_LVGL_VDB_NOCACHE
+	u32_t start = (u32_t)buf & ~(LVGL_GPU_DCACHE_LINE - 1U);
+
+	if (SCB->CCR & SCB_CCR_DC_Msk) {
+		SCB_CleanInvalidateDCache_by_Addr((uint32_t *)start,
+						  size + (u32_t)buf - start);
+	}
+#endif
+}
+#else
+static inline void lvgl_gpu_dcache_clean(const void *buf, u32_t size) {}
+static inline void lvgl_gpu_dcache_flush(void *buf, u32_t size) {}
+#endif /* CONFIG_CPU_CORTEX_M7 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LIB_GUI_LVGL_LVGL_GPU_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * LVGL draws the virtual display buffer one line at a time through these
+ * hooks, each run as a one line operation of the PXP while the CPU waits
+ * for it. Fills output the process surface background color, with both
+ * surfaces disabled. Blends put the source on the alpha surface, over the
+ * destination on the process surface.
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <soc.h>
+#include <fsl_pxp.h>
+#include <lvgl.h>
+#include "lvgl_gpu.h"
+
+#if LV_COLOR_DEPTH == 32
+#define PXP_OUTPUT_FORMAT	kPXP_OutputPixelFormatARGB8888
+#define PXP_PS_FORMAT		kPXP_PsPixelFormatRGB888
+#define PXP_AS_FORMAT		kPXP_AsPixelFormatARGB8888
+#else
+#define PXP_OUTPUT_FORMAT	kPXP_OutputPixelFormatRGB565
+#define PXP_PS_FORMAT		kPXP_PsPixelFormatRGB565
+#define PXP_AS_FORMAT		kPXP_AsPixelFormatRGB565
+#endif
+
+/* Upper left corner past the lower right one */
+#define PXP_SURFACE_OFF		0xFFFFU, 0xFFFFU, 0U, 0U
+
+static void pxp_run(lv_color_t *dest, u32_t length)
+{
+	pxp_output_buffer_config_t out = {
+		.pixelFormat = PXP_OUTPUT_FORMAT,
+		.interlacedMode = kPXP_OutputProgressive,
+		.buffer0Addr = (u32_t)dest,
+		.pitchBytes = length * sizeof(lv_color_t),
+		.width = length,
+		.height = 1U,
+	};
+
+	PXP_SetOutputBufferConfig(PXP, &out);
+	PXP_Start(PXP);
+
+	while (!(PXP_GetStatusFlags(PXP) & kPXP_CompleteFlag)) {
+	}
+
+	PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+
+	lvgl_gpu_dcache_flush(dest, length * sizeof(lv_color_t));
+}
+
+static void pxp_mem_fill(lv_color_t *dest, u32_t length, lv_color_t color)
+{
+	if (length < CONFIG_LVGL_GPU_MIN_PIXELS) {
+		lvgl_gpu_sw_fill(dest, length, color);
+		return;
+	}
+
+	lvgl_gpu_dcache_flush(dest, length * sizeof(lv_color_t));
+
+	PXP_SetProcessSurfaceBackGroundColor(PXP, color.full);
+	PXP_SetProcessSurfacePosition(PXP, PXP_SURFACE_OFF);
+	PXP_SetAlphaSurfacePosition(PXP, PXP_SURFACE_OFF);
+	pxp_run(dest, length);
+}
+
+static void pxp_mem_blend(lv_color_t *dest, const lv_color_t *src,
+			  u32_t length, lv_opa_t opa)
+{
+	pxp_ps_buffer_config_t ps = {
+		.pixelFormat = PXP_PS_FORMAT,
+		.swapByte = false,
+		.bufferAddr = (u32_t)dest,
+		.pitchBytes = length * sizeof(lv_color_t),
+	};
+	pxp_as_buffer_config_t as = {
+		.pixelFormat = PXP_AS_FORMAT,
+		.bufferAddr = (u32_t)src,
+		.pitchBytes = length * sizeof(lv_color_t),
+	};
+	pxp_as_blend_config_t blend = {
+		.alpha = opa,
+		.invertAlpha = false,
+		.alphaMode = kPXP_AlphaOverride,
+	};
+
+	if (length < CONFIG_LVGL_GPU_MIN_PIXELS) {
+		lvgl_gpu_sw_blend(dest, src, length, opa);
+		return;
+	}
+
+	lvgl_gpu_dcache_clean(src, length * sizeof(lv_color_t));
+	lvgl_gpu_dcache_flush(dest, length * sizeof(lv_color_t));
+
+	PXP_SetProcessSurfaceBufferConfig(PXP, &ps);
+	PXP_SetProcessSurfacePosition(PXP, 0U, 0U, length - 1U, 0U);
+	PXP_SetAlphaSurfaceBufferConfig(PXP, &as);
+	PXP_SetAlphaSurfaceBlendConfig(PXP, &blend);
+	PXP_SetAlphaSurfacePosition(PXP, 0U, 0U, length - 1U, 0U);
+	pxp_run(dest, length);
+}
+
+int lvgl_gpu_init(lv_disp_drv_t *disp_drv)
+{
+	PXP_Init(PXP);
+	PXP_EnableCsc1(PXP, false);
+	PXP_SetProcessSurfaceScaler(PXP, 1U, 1U, 1U, 1U);
+	PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0,
+			    kPXP_FlipDisable);
+
+	disp_drv->mem_fill = pxp_mem_fill;
+	disp_drv->mem_blend = pxp_mem_blend;
+
+	return 0;
+}
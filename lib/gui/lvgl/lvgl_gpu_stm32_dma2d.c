@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * LVGL draws the virtual display buffer one line at a time through these
+ * hooks. The DMA2D fills a line in register to memory mode, and copies or
+ * blends one in memory to memory mode, while the CPU waits for it.
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <soc.h>
+#include <clock_control.h>
+#include <clock_control/stm32_clock_control.h>
+#include <lvgl.h>
+#include "lvgl_gpu.h"
+
+#if LV_COLOR_DEPTH == 32
+#define DMA2D_OUTPUT_MODE	LL_DMA2D_OUTPUT_MODE_ARGB8888
+#define DMA2D_INPUT_MODE	LL_DMA2D_INPUT_MODE_ARGB8888
+#else
+#define DMA2D_OUTPUT_MODE	LL_DMA2D_OUTPUT_MODE_RGB565
+#define DMA2D_INPUT_MODE	LL_DMA2D_INPUT_MODE_RGB565
+#endif
+
+/* Width of the pixel per line field */
+#define DMA2D_MAX_PIXELS	0x3FFFU
+
+static bool dma2d_usable(u32_t length)
+{
+	return length >= CONFIG_LVGL_GPU_MIN_PIXELS &&
+	       length <= DMA2D_MAX_PIXELS;
+}
+
+static void dma2d_run(lv_color_t *dest, u32_t length)
+{
+	LL_DMA2D_SetOutputMemAddr(DMA2D, (u32_t)dest);
+	LL_DMA2D_SetNbrOfPixelsPerLines(DMA2D, length);
+	LL_DMA2D_SetNbrOfLines(DMA2D, 1U);
+	LL_DMA2D_Start(DMA2D);
+
+	while (LL_DMA2D_IsTransferOngoing(DMA2D)) {
+	}
+
+	lvgl_gpu_dcache_flush(dest, length * sizeof(lv_color_t));
+}
+
+static void dma2d_mem_fill(lv_color_t *dest, u32_t length, lv_color_t color)
+{
+	if (!dma2d_usable(length)) {
+		lvgl_gpu_sw_fill(dest, length, color);
+		return;
+	}
+
+	lvgl_gpu_dcache_flush(dest, length * sizeof(lv_color_t));
+
+	LL_DMA2D_SetMode(DMA2D, LL_DMA2D_MODE_R2M);
+	LL_DMA2D_SetOutputColor(DMA2D, color.full);
+	dma2d_run(dest, length);
+}
+
+static void dma2d_mem_blend(lv_color_t *dest, const lv_color_t *src,
+			    u32_t length, lv_opa_t opa)
+{
+	if (!dma2d_usable(length)) {
+		lvgl_gpu_sw_blend(dest, src, length, opa);
+		return;
+	}
+
+	lvgl_gpu_dcache_clean(src, length * sizeof(lv_color_t));
+	lvgl_gpu_dcache_flush(dest, length * sizeof(lv_color_t));
+
+	LL_DMA2D_FGND_SetMemAddr(DMA2D, (u32_t)src);
+
+	if (opa >= LV_OPA_MAX) {
+		LL_DMA2D_SetMode(DMA2D, LL_DMA2D_MODE_M2M);
+	} else {
+		LL_DMA2D_SetMode(DMA2D, LL_DMA2D_MODE_M2M_BLEND);
+		LL_DMA2D_FGND_SetAlpha(DMA2D, opa);
+		LL_DMA2D_BGND_SetMemAddr(DMA2D, (u32_t)dest);
+	}
+
+	dma2d_run(dest, length);
+}
+
+int lvgl_gpu_init(lv_disp_drv_t *disp_drv)
+{
+	struct device *clk = device_get_binding(STM32_CLOCK_CONTROL_NAME);
+	struct stm32_pclken pclken = {
+		.bus = STM32_CLOCK_BUS_AHB1,
+		.enr = LL_AHB1_GRP1_PERIPH_DMA2D,
+	};
+
+	if (clk == NULL ||
+	    clock_control_on(clk, (clock_control_subsys_t *)&pclken) != 0) {
+		return -EIO;
+	}
+
+	LL_DMA2D_SetOutputColorMode(DMA2D, DMA2D_OUTPUT_MODE);
+	LL_DMA2D_SetLineOffset(DMA2D, 0U);
+
+	/* Blended as lv_color_mix() does, regardless of the pixel alpha */
+	LL_DMA2D_FGND_SetColorMode(DMA2D, DMA2D_INPUT_MODE);
+	LL_DMA2D_FGND_SetAlphaMode(DMA2D, LL_DMA2D_ALPHA_MODE_REPLACE);
+	LL_DMA2D_FGND_SetLineOffset(DMA2D, 0U);
+	LL_DMA2D_BGND_SetColorMode(DMA2D, DMA2D_INPUT_MODE);
+	LL_DMA2D_BGND_SetAlphaMode(DMA2D, LL_DMA2D_ALPHA_MODE_REPLACE);
+	LL_DMA2D_BGND_SetAlpha(DMA2D, LV_OPA_COVER);
+	LL_DMA2D_BGND_SetLineOffset(DMA2D, 0U);
+
+	disp_drv->mem_fill = dma2d_mem_fill;
+	disp_drv->mem_blend = dma2d_mem_blend;
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+/* malloc.h */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_LIBC_MINIMAL_INCLUDE_MALLOC_H_
+#define ZEPHYR_LIB_LIBC_MINIMAL_INCLUDE_MALLOC_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Usage of the malloc() arena
+ *
+ * used is what the callers asked for. arena_used - used is lost to
+ * headers, rounding to size classes and free objects kept in the size
+ * class caches. The rounding of the arena blocks themselves is not
+ * included, and an arena allocation shrunk in place by realloc() keeps
+ * counting its original size.
+ */
+struct malloc_stats {
+	/** Size of the arena in bytes */
+	size_t arena_size;
+	/** Bytes requested by the allocations in use */
+	size_t used;
+	/** Highest value of used */
+	size_t peak_used;
+	/** Bytes taken from the arena */
+	size_t arena_used;
+	/** Highest value of arena_used */
+	size_t peak_arena_used;
+	/** Bytes of free objects held by the size class caches */
+	size_t cached;
+	/** Number of failed allocations */
+	unsigned int failures;
+};
+
+/**
+ * @brief Get the usage of the malloc() arena
+ *
+ * Only available with CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES.
+ *
+ * @param stats Filled with the current usage.
+ *
+ * @return 0 on success.
+ */
+int malloc_stats_get(struct malloc_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* ZEPHYR_LIB_LIBC_MINIMAL_INCLUDE_MALLOC_H_ */
@@ -12,6 +12,9 @@
 #include <misc/mempool.h>
 #include <string.h>
 #include <app_memory/app_memdomain.h>
+#include <malloc.h>
+#include <spinlock.h>
+#include <kernel_structs.h>
 
 #define LOG_LEVEL CONFIG_KERNEL_LOG_LEVEL
 #include <logging/log.h>
@@ -28,6 +31,295 @@ K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 SYS_MEM_POOL_DEFINE(z_malloc_mem_pool, NULL, 16,
 		    CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE, 1, 4, POOL_SECTION);
 
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES
+
+/* Objects of 16, 32, 64, 128 and 256 bytes */
+#define CLASS_COUNT	5
+#define CLASS_MIN_SHIFT	4
+#define CLASS_MAX_SIZE	BIT(CLASS_MIN_SHIFT + CLASS_COUNT - 1)
+#define CLASS_SIZE(c)	BIT(CLASS_MIN_SHIFT + (c))
+
+/* Header in front of every allocation, after the pool block header of
+ * arena allocations.
+ */
+struct malloc_hdr {
+	/* size class + 1, 0 for arena allocations */
+	size_t cls;
+	/* size requested by the caller */
+	size_t size;
+};
+
+/* Free objects of each class, linked through their first word */
+struct malloc_cache {
+#ifndef CONFIG_USERSPACE
+	struct k_spinlock lock;
+#endif
+	void *free[CLASS_COUNT];
+};
+
+#ifdef CONFIG_USERSPACE
+/* user threads cannot lock interrupts, all CPUs share one cache */
+#define CACHE_COUNT	1
+Z_GENERIC_SECTION(POOL_SECTION) static struct sys_mutex z_malloc_cache_mutex;
+#else
+#define CACHE_COUNT	CONFIG_MP_NUM_CPUS
+#endif
+
+Z_GENERIC_SECTION(POOL_SECTION)
+static struct malloc_cache z_malloc_caches[CACHE_COUNT];
+
+Z_GENERIC_SECTION(POOL_SECTION) static atomic_t stat_used;
+Z_GENERIC_SECTION(POOL_SECTION) static atomic_t stat_peak_used;
+Z_GENERIC_SECTION(POOL_SECTION) static atomic_t stat_arena_used;
+Z_GENERIC_SECTION(POOL_SECTION) static atomic_t stat_peak_arena_used;
+Z_GENERIC_SECTION(POOL_SECTION) static atomic_t stat_cached;
+Z_GENERIC_SECTION(POOL_SECTION) static atomic_t stat_failures;
+
+static void stat_add(atomic_t *val, atomic_t *peak, size_t delta)
+{
+	atomic_val_t now = atomic_add(val, delta) + delta;
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(peak);
+	} while (now > old && !atomic_cas(peak, old, now));
+}
+
+#ifdef CONFIG_USERSPACE
+typedef int cache_key_t;
+
+static struct malloc_cache *cache_lock(cache_key_t *key)
+{
+	ARG_UNUSED(key);
+
+	sys_mutex_lock(&z_malloc_cache_mutex, K_FOREVER);
+
+	return &z_malloc_caches[0];
+}
+
+static void cache_unlock(struct malloc_cache *cache, cache_key_t key)
+{
+	ARG_UNUSED(cache);
+	ARG_UNUSED(key);
+
+	sys_mutex_unlock(&z_malloc_cache_mutex);
+}
+#else
+typedef k_spinlock_key_t cache_key_t;
+
+static struct malloc_cache *cache_lock(cache_key_t *key)
+{
+	/* after a migration the cache of the previous CPU is used, locked
+	 * like any other
+	 */
+	struct malloc_cache *cache = &z_malloc_caches[_current_cpu->id];
+
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void cache_unlock(struct malloc_cache *cache, cache_key_t key)
+{
+	k_spin_unlock(&cache->lock, key);
+}
+#endif /* CONFIG_USERSPACE */
+
+static int size_class(size_t size)
+{
+	if (size <= CLASS_SIZE(0)) {
+		return 0;
+	}
+
+	return 32 - __builtin_clz(size - 1) - CLASS_MIN_SHIFT;
+}
+
+/* Carve a chunk from the arena into objects of a class, one is returned */
+static struct malloc_hdr *class_refill(int cls)
+{
+	size_t obj_size = sizeof(struct malloc_hdr) + CLASS_SIZE(cls);
+	/* fill an arena block of the chunk size, pool header included */
+	size_t count = MAX(1, (CONFIG_MINIMAL_LIBC_MALLOC_CHUNK_SIZE -
+			       sizeof(struct sys_mem_pool_block)) / obj_size);
+	struct malloc_cache *cache;
+	struct malloc_hdr *hdr;
+	cache_key_t key;
+	u8_t *chunk;
+	size_t i;
+
+	chunk = sys_mem_pool_alloc(&z_malloc_mem_pool, count * obj_size);
+	if (chunk == NULL) {
+		return NULL;
+	}
+
+	stat_add(&stat_arena_used, &stat_peak_arena_used, count * obj_size);
+	atomic_add(&stat_cached, (count - 1) * CLASS_SIZE(cls));
+
+	/* link the objects after the first and splice them in */
+	for (i = 0; i < count; i++) {
+		hdr = (struct malloc_hdr *)(chunk + i * obj_size);
+		hdr->cls = cls + 1;
+		if (i > 0 && i < count - 1) {
+			*(void **)(hdr + 1) = chunk + (i + 1) * obj_size +
+					      sizeof(*hdr);
+		}
+	}
+
+	if (count > 1) {
+		cache = cache_lock(&key);
+		*(void **)(hdr + 1) = cache->free[cls];
+		cache->free[cls] = chunk + obj_size + sizeof(*hdr);
+		cache_unlock(cache, key);
+	}
+
+	return (struct malloc_hdr *)chunk;
+}
+
+static struct malloc_hdr *class_alloc(int cls)
+{
+	struct malloc_cache *cache;
+	struct malloc_hdr *hdr;
+	cache_key_t key;
+	void **obj;
+
+	cache = cache_lock(&key);
+	obj = cache->free[cls];
+	if (obj != NULL) {
+		cache->free[cls] = *obj;
+	}
+	cache_unlock(cache, key);
+
+	if (obj == NULL) {
+		return class_refill(cls);
+	}
+
+	hdr = (struct malloc_hdr *)obj - 1;
+	atomic_sub(&stat_cached, CLASS_SIZE(cls));
+
+	return hdr;
+}
+
+static void class_free(struct malloc_hdr *hdr)
+{
+	int cls = hdr->cls - 1;
+	struct malloc_cache *cache;
+	cache_key_t key;
+	void **obj = (void **)(hdr + 1);
+
+	atomic_add(&stat_cached, CLASS_SIZE(cls));
+
+	cache = cache_lock(&key);
+	*obj = cache->free[cls];
+	cache->free[cls] = obj;
+	cache_unlock(cache, key);
+}
+
+void *malloc(size_t size)
+{
+	struct malloc_hdr *hdr;
+	size_t total;
+
+	if (size <= CLASS_MAX_SIZE) {
+		hdr = class_alloc(size_class(size));
+	} else if (size_add_overflow(size, sizeof(*hdr), &total)) {
+		hdr = NULL;
+	} else {
+		hdr = sys_mem_pool_alloc(&z_malloc_mem_pool, total);
+		if (hdr != NULL) {
+			hdr->cls = 0;
+			stat_add(&stat_arena_used, &stat_peak_arena_used,
+				 total);
+		}
+	}
+
+	if (hdr == NULL) {
+		atomic_inc(&stat_failures);
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	hdr->size = size;
+	stat_add(&stat_used, &stat_peak_used, size);
+
+	return hdr + 1;
+}
+
+void free(void *ptr)
+{
+	struct malloc_hdr *hdr;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	hdr = (struct malloc_hdr *)ptr - 1;
+
+	atomic_sub(&stat_used, hdr->size);
+
+	if (hdr->cls != 0) {
+		class_free(hdr);
+	} else {
+		atomic_sub(&stat_arena_used, hdr->size + sizeof(*hdr));
+		sys_mem_pool_free(hdr);
+	}
+}
+
+void *realloc(void *ptr, size_t requested_size)
+{
+	struct malloc_hdr *hdr;
+	size_t capacity;
+	void *new_ptr;
+
+	if (ptr == NULL) {
+		return malloc(requested_size);
+	}
+
+	if (requested_size == 0) {
+		return NULL;
+	}
+
+	hdr = (struct malloc_hdr *)ptr - 1;
+
+	/* arena allocations are not rounded up to a class */
+	capacity = (hdr->cls != 0) ? CLASS_SIZE(hdr->cls - 1) : hdr->size;
+
+	if (capacity >= requested_size) {
+		/* Existing block large enough, nothing to do */
+		if (hdr->cls != 0) {
+			atomic_sub(&stat_used, hdr->size);
+			stat_add(&stat_used, &stat_peak_used, requested_size);
+			hdr->size = requested_size;
+		}
+
+		return ptr;
+	}
+
+	new_ptr = malloc(requested_size);
+	if (new_ptr == NULL) {
+		return NULL;
+	}
+
+	memcpy(new_ptr, ptr, hdr->size);
+	free(ptr);
+
+	return new_ptr;
+}
+
+int malloc_stats_get(struct malloc_stats *stats)
+{
+	stats->arena_size = CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE;
+	stats->used = atomic_get(&stat_used);
+	stats->peak_used = atomic_get(&stat_peak_used);
+	stats->arena_used = atomic_get(&stat_arena_used);
+	stats->peak_arena_used = atomic_get(&stat_peak_arena_used);
+	stats->cached = atomic_get(&stat_cached);
+	stats->failures = atomic_get(&stat_failures);
+
+	return 0;
+}
+
+#else
+
 void *malloc(size_t size)
 {
 	void *ret;
@@ -40,11 +332,17 @@ void *malloc(size_t size)
 	return ret;
 }
 
+#endif /* CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES */
+
 static int malloc_prepare(struct device *unused)
 {
 	ARG_UNUSED(unused);
 
 	sys_mem_pool_init(&z_malloc_mem_pool);
+#if defined(CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES) && \
+	defined(CONFIG_USERSPACE)
+	sys_mutex_init(&z_malloc_cache_mutex);
+#endif
 
 	return 0;
 }
@@ -62,10 +360,12 @@ void *malloc(size_t size)
 }
 #endif
 
+#ifndef CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES
 void free(void *ptr)
 {
 	sys_mem_pool_free(ptr);
 }
+#endif
 
 void *calloc(size_t nmemb, size_t size)
 {
@@ -85,6 +385,7 @@ void *calloc(size_t nmemb, size_t size)
 	return ret;
 }
 
+#ifndef CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES
 void *realloc(void *ptr, size_t requested_size)
 {
 	struct sys_mem_pool_block *blk;
@@ -129,6 +430,7 @@ void *realloc(void *ptr, size_t requested_size)
 
 	return new_ptr;
 }
+#endif /* !CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES */
 
 
 void *reallocarray(void *ptr, size_t nmemb, size_t size)
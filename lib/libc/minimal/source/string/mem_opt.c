@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * memcpy(), memmove() and memset() moving four words per iteration.
+ *
+ * The destination is aligned first. A source of a different alignment is
+ * read with unaligned loads where the core handles them in hardware, and
+ * with aligned loads shifted and merged otherwise, so misaligned copies
+ * never fall back to bytes. On x86 the string instructions are used.
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <toolchain.h>
+
+typedef unsigned int mem_word_t;
+
+#define WORD_SIZE	sizeof(mem_word_t)
+#define WORD_MASK	(WORD_SIZE - 1)
+#define BLOCK_SIZE	(4 * WORD_SIZE)
+
+#if defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+/* unaligned LDR/STR are handled by the core, only LDM/STM fault */
+#define MEM_UNALIGNED_LOADS 1
+#endif
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define MERGE(lo, hi, shift) \
+	(((lo) << (shift)) | ((hi) >> (8 * WORD_SIZE - (shift))))
+#else
+#define MERGE(lo, hi, shift) \
+	(((lo) >> (shift)) | ((hi) << (8 * WORD_SIZE - (shift))))
+#endif
+
+#if defined(CONFIG_X86)
+
+static inline void copy_fwd(unsigned char *d, const unsigned char *s,
+			    size_t n)
+{
+	size_t count = n / WORD_SIZE;
+
+	__asm__ volatile("rep movsl"
+			 : "+D" (d), "+S" (s), "+c" (count)
+			 :
+			 : "memory");
+
+	count = n & WORD_MASK;
+	__asm__ volatile("rep movsb"
+			 : "+D" (d), "+S" (s), "+c" (count)
+			 :
+			 : "memory");
+}
+
+#else
+
+/* copy n bytes, n a multiple of WORD_SIZE, to an aligned destination */
+static inline void copy_words(mem_word_t *d, const unsigned char *s, size_t n)
+{
+	if (((uintptr_t)s & WORD_MASK) == 0U) {
+		const mem_word_t *s_word = (const mem_word_t *)s;
+
+		/* consecutive loads and stores are combined in LDM/STM */
+		for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE) {
+			mem_word_t w0 = s_word[0], w1 = s_word[1];
+			mem_word_t w2 = s_word[2], w3 = s_word[3];
+
+			d[0] = w0;
+			d[1] = w1;
+			d[2] = w2;
+			d[3] = w3;
+			d += 4;
+			s_word += 4;
+		}
+
+		for (; n > 0; n -= WORD_SIZE) {
+			*d++ = *s_word++;
+		}
+
+		return;
+	}
+
+#ifdef MEM_UNALIGNED_LOADS
+	const mem_word_t *s_word = (const mem_word_t *)s;
+
+	for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE) {
+		mem_word_t w0 = UNALIGNED_GET(&s_word[0]);
+		mem_word_t w1 = UNALIGNED_GET(&s_word[1]);
+		mem_word_t w2 = UNALIGNED_GET(&s_word[2]);
+		mem_word_t w3 = UNALIGNED_GET(&s_word[3]);
+
+		d[0] = w0;
+		d[1] = w1;
+		d[2] = w2;
+		d[3] = w3;
+		d += 4;
+		s_word += 4;
+	}
+
+	for (; n > 0; n -= WORD_SIZE) {
+		*d++ = UNALIGNED_GET(s_word);
+		s_word++;
+	}
+#else
+	unsigned int shift = 8 * ((uintptr_t)s & WORD_MASK);
+	const mem_word_t *s_word = (const mem_word_t *)((uintptr_t)s &
+							~WORD_MASK);
+	mem_word_t lo, hi;
+
+	/* the aligned words read hold at least one byte of the source */
+	lo = *s_word++;
+
+	for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE) {
+		mem_word_t w0 = s_word[0], w1 = s_word[1];
+		mem_word_t w2 = s_word[2], w3 = s_word[3];
+
+		d[0] = MERGE(lo, w0, shift);
+		d[1] = MERGE(w0, w1, shift);
+		d[2] = MERGE(w1, w2, shift);
+		d[3] = MERGE(w2, w3, shift);
+		lo = w3;
+		d += 4;
+		s_word += 4;
+	}
+
+	for (; n > 0; n -= WORD_SIZE) {
+		hi = *s_word++;
+		*d++ = MERGE(lo, hi, shift);
+		lo = hi;
+	}
+#endif
+}
+
+static inline void copy_fwd(unsigned char *d, const unsigned char *s,
+			    size_t n)
+{
+	size_t words;
+
+	if (n >= BLOCK_SIZE) {
+		while (((uintptr_t)d & WORD_MASK) != 0U) {
+			*d++ = *s++;
+			n--;
+		}
+
+		words = n & ~WORD_MASK;
+		copy_words((mem_word_t *)d, s, words);
+		d += words;
+		s += words;
+		n -= words;
+	}
+
+	while (n > 0) {
+		*d++ = *s++;
+		n--;
+	}
+}
+
+#endif /* CONFIG_X86 */
+
+/**
+ *
+ * @brief Copy bytes in memory with overlapping areas
+ *
+ * @return pointer to start of destination buffer
+ */
+
+void *memmove(void *d, const void *s, size_t n)
+{
+	unsigned char *dest = d;
+	const unsigned char *src = s;
+
+	if ((size_t)(dest - src) >= n) {
+		/* the forward copy reads each word before it is written */
+		copy_fwd(dest, src, n);
+		return d;
+	}
+
+	/*
+	 * The <src> buffer overlaps with the start of the <dest> buffer.
+	 * Copy backwards to prevent the premature corruption of <src>.
+	 */
+	if ((((uintptr_t)dest ^ (uintptr_t)src) & WORD_MASK) == 0U) {
+		while (((uintptr_t)(dest + n) & WORD_MASK) != 0U) {
+			if (n == 0) {
+				return d;
+			}
+			n--;
+			dest[n] = src[n];
+		}
+
+		mem_word_t *d_word = (mem_word_t *)(dest + n);
+		const mem_word_t *s_word = (const mem_word_t *)(src + n);
+
+		while (n >= WORD_SIZE) {
+			*--d_word = *--s_word;
+			n -= WORD_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		n--;
+		dest[n] = src[n];
+	}
+
+	return d;
+}
+
+/**
+ *
+ * @brief Copy bytes in memory
+ *
+ * @return pointer to start of destination buffer
+ */
+
+void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
+{
+	copy_fwd(d, s, n);
+
+	return d;
+}
+
+/**
+ *
+ * @brief Set bytes in memory
+ *
+ * @return pointer to start of buffer
+ */
+
+void *memset(void *buf, int c, size_t n)
+{
+	unsigned char *d_byte = buf;
+	mem_word_t c_word = (unsigned char)c;
+
+	c_word |= c_word << 8;
+	c_word |= c_word << 16;
+
+#if defined(CONFIG_X86)
+	size_t count = n / WORD_SIZE;
+
+	__asm__ volatile("rep stosl"
+			 : "+D" (d_byte), "+c" (count)
+			 : "a" (c_word)
+			 : "memory");
+
+	count = n & WORD_MASK;
+	__asm__ volatile("rep stosb"
+			 : "+D" (d_byte), "+c" (count)
+			 : "a" (c_word)
+			 : "memory");
+#else
+	if (n >= BLOCK_SIZE) {
+		mem_word_t *d_word;
+
+		while (((uintptr_t)d_byte & WORD_MASK) != 0U) {
+			*d_byte++ = (unsigned char)c;
+			n--;
+		}
+
+		d_word = (mem_word_t *)d_byte;
+
+		for (; n >= BLOCK_SIZE; n -= BLOCK_SIZE) {
+			d_word[0] = c_word;
+			d_word[1] = c_word;
+			d_word[2] = c_word;
+			d_word[3] = c_word;
+			d_word += 4;
+		}
+
+		for (; n >= WORD_SIZE; n -= WORD_SIZE) {
+			*d_word++ = c_word;
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+
+	while (n > 0) {
+		*d_byte++ = (unsigned char)c;
+		n--;
+	}
+#endif
+
+	return buf;
+}
@@ -191,6 +191,8 @@ int memcmp(const void *m1, const void *m2, size_t n)
 	return *c1 - *c2;
 }
 
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM
+
 /**
  *
  * @brief Copy bytes in memory with overlapping areas
@@ -323,6 +325,8 @@ void *memset(void *buf, int c, size_t n)
 	return buf;
 }
 
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM */
+
 /**
  *
  * @brief Scan byte in memory
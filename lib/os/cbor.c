@@ -0,0 +1,1017 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <misc/util.h>
+#include <zephyr/types.h>
+
+#include <cbor_codec.h>
+
+static int writer_put(struct cbor_writer *writer, const u8_t *data,
+		      size_t len)
+{
+	int ret;
+
+	if (writer->err) {
+		return writer->err;
+	}
+
+	ret = writer->write(writer, data, len);
+	if (ret < 0) {
+		writer->err = ret;
+		return ret;
+	}
+
+	writer->len += len;
+
+	return 0;
+}
+
+void cbor_writer_init(struct cbor_writer *writer, cbor_write_t write,
+		      void *user_data)
+{
+	memset(writer, 0, sizeof(*writer));
+	writer->write = write;
+	writer->user_data = user_data;
+}
+
+static int write_to_buf(struct cbor_writer *writer, const u8_t *data,
+			size_t len)
+{
+	if (len > writer->buf.size - writer->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(writer->buf.data + writer->len, data, len);
+
+	return 0;
+}
+
+void cbor_writer_init_buf(struct cbor_writer *writer, u8_t *buf,
+			  size_t size)
+{
+	cbor_writer_init(writer, write_to_buf, NULL);
+	writer->buf.data = buf;
+	writer->buf.size = size;
+}
+
+#if defined(CONFIG_NET_BUF)
+static int write_to_net_buf(struct cbor_writer *writer, const u8_t *data,
+			    size_t len)
+{
+	struct net_buf *buf = writer->user_data;
+	struct net_buf *last;
+
+	if (writer->net_buf.allocate_cb) {
+		if (net_buf_append_bytes(buf, len, data, K_NO_WAIT,
+					 writer->net_buf.allocate_cb,
+					 writer->net_buf.allocate_data) < len) {
+			return -ENOMEM;
+		}
+
+		return 0;
+	}
+
+	last = net_buf_frag_last(buf);
+	if (len > net_buf_tailroom(last)) {
+		return -ENOMEM;
+	}
+
+	net_buf_add_mem(last, data, len);
+
+	return 0;
+}
+
+void cbor_writer_init_net_buf(struct cbor_writer *writer,
+			      struct net_buf *buf,
+			      net_buf_allocator_cb allocate_cb,
+			      void *allocate_data)
+{
+	cbor_writer_init(writer, write_to_net_buf, buf);
+	writer->net_buf.allocate_cb = allocate_cb;
+	writer->net_buf.allocate_data = allocate_data;
+}
+#endif
+
+int cbor_write_head(struct cbor_writer *writer, u8_t major, u64_t value)
+{
+	u8_t head[9];
+	size_t len, i;
+
+	if (value < CBOR_AI_UINT8) {
+		head[0] = (major << 5) | (u8_t)value;
+		return writer_put(writer, head, 1);
+	}
+
+	if (value <= UINT8_MAX) {
+		head[0] = (major << 5) | CBOR_AI_UINT8;
+		len = 1;
+	} else if (value <= UINT16_MAX) {
+		head[0] = (major << 5) | CBOR_AI_UINT16;
+		len = 2;
+	} else if (value <= UINT32_MAX) {
+		head[0] = (major << 5) | CBOR_AI_UINT32;
+		len = 4;
+	} else {
+		head[0] = (major << 5) | CBOR_AI_UINT64;
+		len = 8;
+	}
+
+	/* the argument follows in network byte order */
+	for (i = len; i > 0; i--) {
+		head[i] = (u8_t)value;
+		value >>= 8;
+	}
+
+	return writer_put(writer, head, len + 1);
+}
+
+int cbor_write_uint(struct cbor_writer *writer, u64_t value)
+{
+	return cbor_write_head(writer, CBOR_MAJOR_UINT, value);
+}
+
+int cbor_write_int(struct cbor_writer *writer, s64_t value)
+{
+	if (value < 0) {
+		/* -1 - value, without overflowing on INT64_MIN */
+		return cbor_write_head(writer, CBOR_MAJOR_NINT,
+				       ~(u64_t)value);
+	}
+
+	return cbor_write_head(writer, CBOR_MAJOR_UINT, (u64_t)value);
+}
+
+static int write_str(struct cbor_writer *writer, u8_t major,
+		     const void *data, size_t len)
+{
+	int ret;
+
+	ret = cbor_write_head(writer, major, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	return writer_put(writer, data, len);
+}
+
+int cbor_write_bstr(struct cbor_writer *writer, const void *data,
+		    size_t len)
+{
+	return write_str(writer, CBOR_MAJOR_BSTR, data, len);
+}
+
+int cbor_write_tstr(struct cbor_writer *writer, const char *str, size_t len)
+{
+	return write_str(writer, CBOR_MAJOR_TSTR, str, len);
+}
+
+static int write_byte(struct cbor_writer *writer, u8_t byte)
+{
+	return writer_put(writer, &byte, 1);
+}
+
+int cbor_write_bool(struct cbor_writer *writer, bool value)
+{
+	return write_byte(writer, value ? CBOR_TRUE : CBOR_FALSE);
+}
+
+int cbor_write_null(struct cbor_writer *writer)
+{
+	return write_byte(writer, CBOR_NULL);
+}
+
+int cbor_write_double(struct cbor_writer *writer, double value)
+{
+	float single = (float)value;
+	u8_t head[9];
+	u64_t bits;
+	size_t len, i;
+
+	if ((double)single == value || value != value) {
+		u32_t single_bits;
+
+		memcpy(&single_bits, &single, sizeof(single_bits));
+		head[0] = (CBOR_MAJOR_SIMPLE << 5) | CBOR_AI_FLOAT32;
+		bits = single_bits;
+		len = 4;
+	} else {
+		memcpy(&bits, &value, sizeof(bits));
+		head[0] = (CBOR_MAJOR_SIMPLE << 5) | CBOR_AI_FLOAT64;
+		len = 8;
+	}
+
+	for (i = len; i > 0; i--) {
+		head[i] = (u8_t)bits;
+		bits >>= 8;
+	}
+
+	return writer_put(writer, head, len + 1);
+}
+
+static int write_container(struct cbor_writer *writer, u8_t major,
+			   size_t count)
+{
+	if (count == CBOR_INDEFINITE) {
+		return write_byte(writer, (major << 5) | CBOR_AI_INDEFINITE);
+	}
+
+	return cbor_write_head(writer, major, count);
+}
+
+int cbor_write_array_start(struct cbor_writer *writer, size_t count)
+{
+	return write_container(writer, CBOR_MAJOR_ARRAY, count);
+}
+
+int cbor_write_map_start(struct cbor_writer *writer, size_t count)
+{
+	return write_container(writer, CBOR_MAJOR_MAP, count);
+}
+
+int cbor_write_break(struct cbor_writer *writer)
+{
+	return write_byte(writer, CBOR_BREAK);
+}
+
+void cbor_reader_init(struct cbor_reader *reader, const void *data,
+		      size_t len)
+{
+	reader->pos = data;
+	reader->end = reader->pos + len;
+}
+
+int cbor_read_head(struct cbor_reader *reader, u8_t *major, u8_t *ai,
+		   u64_t *value)
+{
+	const u8_t *pos = reader->pos;
+	size_t len, i;
+
+	if (pos >= reader->end) {
+		return -ENODATA;
+	}
+
+	*major = *pos >> 5;
+	*ai = *pos & 0x1f;
+	pos++;
+
+	if (*ai < CBOR_AI_UINT8) {
+		*value = *ai;
+		reader->pos = pos;
+		return 0;
+	}
+
+	if (*ai == CBOR_AI_INDEFINITE) {
+		/* only strings, arrays, maps and the break can be indefinite */
+		if (*major < CBOR_MAJOR_BSTR || *major == CBOR_MAJOR_TAG) {
+			return -EINVAL;
+		}
+
+		*value = 0;
+		reader->pos = pos;
+		return 0;
+	}
+
+	if (*ai > CBOR_AI_UINT64) {
+		return -EINVAL;
+	}
+
+	len = 1 << (*ai - CBOR_AI_UINT8);
+	if (len > reader->end - pos) {
+		return -EINVAL;
+	}
+
+	*value = 0;
+	for (i = 0; i < len; i++) {
+		*value = (*value << 8) | pos[i];
+	}
+
+	reader->pos = pos + len;
+
+	return 0;
+}
+
+int cbor_peek(const struct cbor_reader *reader)
+{
+	if (reader->pos >= reader->end) {
+		return -ENODATA;
+	}
+
+	return *reader->pos;
+}
+
+/* Reads a head of the given major type, leaves the reader unchanged if the
+ * next item is of another type.
+ */
+static int expect_head(struct cbor_reader *reader, u8_t major, u8_t *ai,
+		       u64_t *value)
+{
+	const u8_t *pos = reader->pos;
+	u8_t item_major;
+	int ret;
+
+	ret = cbor_read_head(reader, &item_major, ai, value);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (item_major != major) {
+		reader->pos = pos;
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int cbor_read_uint(struct cbor_reader *reader, u64_t *value)
+{
+	u8_t ai;
+
+	return expect_head(reader, CBOR_MAJOR_UINT, &ai, value);
+}
+
+int cbor_read_int(struct cbor_reader *reader, s64_t *value)
+{
+	const u8_t *pos = reader->pos;
+	u64_t arg;
+	u8_t major, ai;
+	int ret;
+
+	ret = cbor_read_head(reader, &major, &ai, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major != CBOR_MAJOR_UINT && major != CBOR_MAJOR_NINT) {
+		reader->pos = pos;
+		return -EINVAL;
+	}
+
+	if (arg > INT64_MAX) {
+		reader->pos = pos;
+		return -ERANGE;
+	}
+
+	*value = major == CBOR_MAJOR_UINT ? (s64_t)arg : -1 - (s64_t)arg;
+
+	return 0;
+}
+
+static int read_str(struct cbor_reader *reader, u8_t major,
+		    struct cbor_str *str)
+{
+	const u8_t *pos = reader->pos;
+	u64_t len;
+	u8_t ai;
+	int ret;
+
+	ret = expect_head(reader, major, &ai, &len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ai == CBOR_AI_INDEFINITE) {
+		reader->pos = pos;
+		return -ENOTSUP;
+	}
+
+	if (len > reader->end - reader->pos) {
+		reader->pos = pos;
+		return -EINVAL;
+	}
+
+	str->data = reader->pos;
+	str->len = (size_t)len;
+	reader->pos += len;
+
+	return 0;
+}
+
+int cbor_read_bstr(struct cbor_reader *reader, struct cbor_str *str)
+{
+	return read_str(reader, CBOR_MAJOR_BSTR, str);
+}
+
+int cbor_read_tstr(struct cbor_reader *reader, struct cbor_str *str)
+{
+	return read_str(reader, CBOR_MAJOR_TSTR, str);
+}
+
+int cbor_read_bool(struct cbor_reader *reader, bool *value)
+{
+	int byte = cbor_peek(reader);
+
+	if (byte < 0) {
+		return byte;
+	}
+
+	if (byte != CBOR_FALSE && byte != CBOR_TRUE) {
+		return -EINVAL;
+	}
+
+	*value = byte == CBOR_TRUE;
+	reader->pos++;
+
+	return 0;
+}
+
+int cbor_read_null(struct cbor_reader *reader)
+{
+	int byte = cbor_peek(reader);
+
+	if (byte < 0) {
+		return byte;
+	}
+
+	if (byte != CBOR_NULL) {
+		return -EINVAL;
+	}
+
+	reader->pos++;
+
+	return 0;
+}
+
+static double half_to_double(u16_t half)
+{
+	u32_t exp = (half >> 10) & 0x1f;
+	u32_t mant = half & 0x3ff;
+	u32_t bits;
+	float single;
+
+	if (exp == 0) {
+		/* zero and subnormals: mant * 2^-24 */
+		double value = (double)mant / (1 << 24);
+
+		return (half & 0x8000) ? -value : value;
+	}
+
+	if (exp == 0x1f) {
+		/* infinities and NaNs */
+		exp = 0xff;
+	} else {
+		exp += 127 - 15;
+	}
+
+	bits = ((u32_t)(half & 0x8000) << 16) | (exp << 23) | (mant << 13);
+	memcpy(&single, &bits, sizeof(single));
+
+	return single;
+}
+
+int cbor_read_double(struct cbor_reader *reader, double *value)
+{
+	const u8_t *pos = reader->pos;
+	u64_t arg;
+	u8_t major, ai;
+	int ret;
+
+	ret = cbor_read_head(reader, &major, &ai, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	switch (major) {
+	case CBOR_MAJOR_UINT:
+		*value = (double)arg;
+		return 0;
+	case CBOR_MAJOR_NINT:
+		*value = -1.0 - (double)arg;
+		return 0;
+	case CBOR_MAJOR_SIMPLE:
+		if (ai == CBOR_AI_FLOAT16) {
+			*value = half_to_double((u16_t)arg);
+			return 0;
+		}
+
+		if (ai == CBOR_AI_FLOAT32) {
+			u32_t bits = (u32_t)arg;
+			float single;
+
+			memcpy(&single, &bits, sizeof(single));
+			*value = single;
+			return 0;
+		}
+
+		if (ai == CBOR_AI_FLOAT64) {
+			memcpy(value, &arg, sizeof(*value));
+			return 0;
+		}
+
+		break;
+	default:
+		break;
+	}
+
+	reader->pos = pos;
+
+	return -EINVAL;
+}
+
+static int read_container(struct cbor_reader *reader, u8_t major,
+			  size_t *count)
+{
+	const u8_t *pos = reader->pos;
+	u64_t value;
+	u8_t ai;
+	int ret;
+
+	ret = expect_head(reader, major, &ai, &value);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ai == CBOR_AI_INDEFINITE) {
+		*count = CBOR_INDEFINITE;
+		return 0;
+	}
+
+	/* every item takes at least one byte */
+	if (value > reader->end - reader->pos) {
+		reader->pos = pos;
+		return -EINVAL;
+	}
+
+	*count = (size_t)value;
+
+	return 0;
+}
+
+int cbor_read_array_start(struct cbor_reader *reader, size_t *count)
+{
+	return read_container(reader, CBOR_MAJOR_ARRAY, count);
+}
+
+int cbor_read_map_start(struct cbor_reader *reader, size_t *count)
+{
+	return read_container(reader, CBOR_MAJOR_MAP, count);
+}
+
+bool cbor_read_break(struct cbor_reader *reader)
+{
+	if (cbor_peek(reader) != CBOR_BREAK) {
+		return false;
+	}
+
+	reader->pos++;
+
+	return true;
+}
+
+int cbor_skip(struct cbor_reader *reader)
+{
+	/* items left in each enclosing array or map */
+	size_t remaining[CONFIG_CBOR_MAX_DEPTH];
+	size_t depth = 0;
+	u64_t value;
+	u8_t major, ai;
+	int ret;
+
+	do {
+		if (depth > 0) {
+			size_t *left = &remaining[depth - 1];
+
+			if (*left == CBOR_INDEFINITE) {
+				if (cbor_read_break(reader)) {
+					depth--;
+					continue;
+				}
+			} else if (*left == 0) {
+				depth--;
+				continue;
+			} else {
+				(*left)--;
+			}
+		}
+
+		/* a tag is part of the item it precedes */
+		do {
+			ret = cbor_read_head(reader, &major, &ai, &value);
+			if (ret < 0) {
+				return ret == -ENODATA ? -EINVAL : ret;
+			}
+		} while (major == CBOR_MAJOR_TAG);
+
+		switch (major) {
+		case CBOR_MAJOR_BSTR:
+		case CBOR_MAJOR_TSTR:
+			if (ai != CBOR_AI_INDEFINITE) {
+				if (value > reader->end - reader->pos) {
+					return -EINVAL;
+				}
+
+				reader->pos += value;
+				break;
+			}
+
+			/* chunks follow until a break, like an array */
+			if (depth == CONFIG_CBOR_MAX_DEPTH) {
+				return -E2BIG;
+			}
+
+			remaining[depth++] = CBOR_INDEFINITE;
+			break;
+		case CBOR_MAJOR_ARRAY:
+		case CBOR_MAJOR_MAP:
+			if (depth == CONFIG_CBOR_MAX_DEPTH) {
+				return -E2BIG;
+			}
+
+			if (ai == CBOR_AI_INDEFINITE) {
+				remaining[depth++] = CBOR_INDEFINITE;
+				break;
+			}
+
+			if (major == CBOR_MAJOR_MAP) {
+				value *= 2U;
+			}
+
+			/* every item takes at least one byte */
+			if (value > reader->end - reader->pos) {
+				return -EINVAL;
+			}
+
+			remaining[depth++] = (size_t)value;
+			break;
+		case CBOR_MAJOR_SIMPLE:
+			/* a break outside of an indefinite-length item */
+			if (ai == CBOR_AI_INDEFINITE) {
+				return -EINVAL;
+			}
+
+			break;
+		default:
+			break;
+		}
+	} while (depth > 0);
+
+	return 0;
+}
+
+static ptrdiff_t get_elem_size(const struct cbor_obj_descr *descr)
+{
+	switch (descr->type) {
+	case CBOR_TYPE_INT:
+		return sizeof(s32_t);
+	case CBOR_TYPE_INT64:
+		return sizeof(s64_t);
+	case CBOR_TYPE_UINT:
+		return sizeof(u32_t);
+	case CBOR_TYPE_BOOL:
+		return sizeof(bool);
+	case CBOR_TYPE_DOUBLE:
+		return sizeof(double);
+	case CBOR_TYPE_TSTR:
+	case CBOR_TYPE_BSTR:
+		return sizeof(struct cbor_str);
+	case CBOR_TYPE_ARRAY:
+		return descr->array.n_elements *
+		       get_elem_size(descr->array.element_descr);
+	case CBOR_TYPE_OBJECT: {
+		const struct cbor_obj_descr *sub = descr->object.sub_descr;
+		ptrdiff_t total = 0;
+		size_t i;
+
+		/* the end of the last field, padded like the struct */
+		for (i = 0; i < descr->object.sub_descr_len; i++) {
+			ptrdiff_t end = sub[i].offset + get_elem_size(&sub[i]);
+
+			total = MAX(total, end);
+		}
+
+		if (descr->object.sub_descr_len == 0) {
+			return total;
+		}
+
+		return ROUND_UP(total, 1 << sub[0].align_shift);
+	}
+	default:
+		return -EINVAL;
+	}
+}
+
+static int encode(struct cbor_writer *writer,
+		  const struct cbor_obj_descr *descr, const void *val);
+
+static int arr_encode(struct cbor_writer *writer,
+		      const struct cbor_obj_descr *elem_descr,
+		      const void *field, const void *val)
+{
+	ptrdiff_t elem_size = get_elem_size(elem_descr);
+	/*
+	 * As in json.c, the offset of an element descriptor is the offset
+	 * of the field holding the number of elements.
+	 */
+	size_t n_elem = *(size_t *)((char *)val + elem_descr->offset);
+	size_t i;
+	int ret;
+
+	ret = cbor_write_array_start(writer, n_elem);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (i = 0; i < n_elem; i++) {
+		ret = encode(writer, elem_descr,
+			     (char *)field - elem_descr->offset);
+		if (ret < 0) {
+			return ret;
+		}
+
+		field = (char *)field + elem_size;
+	}
+
+	return 0;
+}
+
+static int encode(struct cbor_writer *writer,
+		  const struct cbor_obj_descr *descr, const void *val)
+{
+	const void *ptr = (const char *)val + descr->offset;
+
+	switch (descr->type) {
+	case CBOR_TYPE_INT:
+		return cbor_write_int(writer, *(const s32_t *)ptr);
+	case CBOR_TYPE_INT64:
+		return cbor_write_int(writer, *(const s64_t *)ptr);
+	case CBOR_TYPE_UINT:
+		return cbor_write_uint(writer, *(const u32_t *)ptr);
+	case CBOR_TYPE_BOOL:
+		return cbor_write_bool(writer, *(const bool *)ptr);
+	case CBOR_TYPE_DOUBLE:
+		return cbor_write_double(writer, *(const double *)ptr);
+	case CBOR_TYPE_TSTR: {
+		const struct cbor_str *str = ptr;
+
+		return cbor_write_tstr(writer, (const char *)str->data,
+				       str->len);
+	}
+	case CBOR_TYPE_BSTR: {
+		const struct cbor_str *str = ptr;
+
+		return cbor_write_bstr(writer, str->data, str->len);
+	}
+	case CBOR_TYPE_OBJECT:
+		return cbor_obj_encode(writer, descr->object.sub_descr,
+				       descr->object.sub_descr_len, ptr);
+	case CBOR_TYPE_ARRAY:
+		return arr_encode(writer, descr->array.element_descr, ptr,
+				  val);
+	default:
+		return -EINVAL;
+	}
+}
+
+int cbor_obj_encode(struct cbor_writer *writer,
+		    const struct cbor_obj_descr *descr, size_t descr_len,
+		    const void *val)
+{
+	size_t i;
+	int ret;
+
+	ret = cbor_write_map_start(writer, descr_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (i = 0; i < descr_len; i++) {
+		if (descr[i].name) {
+			ret = cbor_write_tstr(writer, descr[i].name,
+					      descr[i].name_len);
+		} else {
+			ret = cbor_write_int(writer, descr[i].label);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = encode(writer, &descr[i], val);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int obj_decode(struct cbor_reader *reader,
+		      const struct cbor_obj_descr *descr, size_t descr_len,
+		      void *val);
+
+static int decode_value(struct cbor_reader *reader,
+			const struct cbor_obj_descr *descr, void *field,
+			void *val);
+
+static int arr_decode(struct cbor_reader *reader,
+		      const struct cbor_obj_descr *elem_descr,
+		      size_t max_elements, void *field, void *val)
+{
+	ptrdiff_t elem_size = get_elem_size(elem_descr);
+	size_t *elements = (size_t *)((char *)val + elem_descr->offset);
+	size_t count;
+	int ret;
+
+	assert(elem_size > 0);
+
+	ret = cbor_read_array_start(reader, &count);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*elements = 0;
+
+	while (count == CBOR_INDEFINITE ? !cbor_read_break(reader) :
+	       *elements < count) {
+		if (*elements == max_elements) {
+			return -ENOSPC;
+		}
+
+		ret = decode_value(reader, elem_descr, field, val);
+		if (ret < 0) {
+			return ret;
+		}
+
+		(*elements)++;
+		field = (char *)field + elem_size;
+	}
+
+	return 0;
+}
+
+static int decode_value(struct cbor_reader *reader,
+			const struct cbor_obj_descr *descr, void *field,
+			void *val)
+{
+	u64_t uvalue;
+	s64_t value;
+	int ret;
+
+	switch (descr->type) {
+	case CBOR_TYPE_INT:
+		ret = cbor_read_int(reader, &value);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (value < INT32_MIN || value > INT32_MAX) {
+			return -ERANGE;
+		}
+
+		*(s32_t *)field = (s32_t)value;
+		return 0;
+	case CBOR_TYPE_INT64:
+		return cbor_read_int(reader, field);
+	case CBOR_TYPE_UINT:
+		ret = cbor_read_uint(reader, &uvalue);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (uvalue > UINT32_MAX) {
+			return -ERANGE;
+		}
+
+		*(u32_t *)field = (u32_t)uvalue;
+		return 0;
+	case CBOR_TYPE_BOOL:
+		return cbor_read_bool(reader, field);
+	case CBOR_TYPE_DOUBLE:
+		return cbor_read_double(reader, field);
+	case CBOR_TYPE_TSTR:
+		return cbor_read_tstr(reader, field);
+	case CBOR_TYPE_BSTR:
+		return cbor_read_bstr(reader, field);
+	case CBOR_TYPE_OBJECT:
+		ret = obj_decode(reader, descr->object.sub_descr,
+				 descr->object.sub_descr_len, field);
+		return ret < 0 ? ret : 0;
+	case CBOR_TYPE_ARRAY:
+		return arr_decode(reader, descr->array.element_descr,
+				  descr->array.n_elements, field, val);
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Returns the index of the descriptor of the next key, descr_len if the
+ * entry is not described.
+ */
+static int decode_key(struct cbor_reader *reader,
+		      const struct cbor_obj_descr *descr, size_t descr_len,
+		      size_t *index)
+{
+	struct cbor_str key;
+	s64_t label;
+	int byte, ret;
+	size_t i;
+
+	byte = cbor_peek(reader);
+	if (byte < 0) {
+		return -EINVAL;
+	}
+
+	*index = descr_len;
+
+	switch (byte >> 5) {
+	case CBOR_MAJOR_TSTR:
+		ret = cbor_read_tstr(reader, &key);
+		if (ret < 0) {
+			return ret;
+		}
+
+		for (i = 0; i < descr_len; i++) {
+			if (descr[i].name && key.len == descr[i].name_len &&
+			    !memcmp(key.data, descr[i].name, key.len)) {
+				*index = i;
+				break;
+			}
+		}
+
+		return 0;
+	case CBOR_MAJOR_UINT:
+	case CBOR_MAJOR_NINT:
+		ret = cbor_read_int(reader, &label);
+		if (ret == -ERANGE) {
+			return cbor_skip(reader);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		for (i = 0; i < descr_len; i++) {
+			if (!descr[i].name && label == descr[i].label) {
+				*index = i;
+				break;
+			}
+		}
+
+		return 0;
+	default:
+		return cbor_skip(reader);
+	}
+}
+
+static int obj_decode(struct cbor_reader *reader,
+		      const struct cbor_obj_descr *descr, size_t descr_len,
+		      void *val)
+{
+	s32_t decoded_fields = 0;
+	size_t count, n, i;
+	int ret;
+
+	ret = cbor_read_map_start(reader, &count);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (n = 0; count == CBOR_INDEFINITE ? !cbor_read_break(reader) :
+	     n < count; n++) {
+		ret = decode_key(reader, descr, descr_len, &i);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Unknown or already decoded field, skip */
+		if (i == descr_len || (decoded_fields & (1 << i))) {
+			ret = cbor_skip(reader);
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
+		}
+
+		ret = decode_value(reader, &descr[i],
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
+		}
+
+		decoded_fields |= 1 << i;
+	}
+
+	return decoded_fields;
+}
+
+int cbor_obj_decode(struct cbor_reader *reader,
+		    const struct cbor_obj_descr *descr, size_t descr_len,
+		    void *val)
+{
+	assert(descr_len < (sizeof(s32_t) * CHAR_BIT - 1));
+
+	return obj_decode(reader, descr, descr_len, val);
+}
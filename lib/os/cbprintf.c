@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2010, 2013-2014 Wind River Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <misc/cbprintf.h>
+#include <stdbool.h>
+
+enum pad_type {
+	PAD_NONE,
+	PAD_ZERO_BEFORE,
+	PAD_SPACE_BEFORE,
+	PAD_SPACE_AFTER,
+};
+
+/* What a conversion takes from the arguments */
+enum arg_class {
+	ARG_NONE,
+	ARG_INT,
+	ARG_LONG,
+	ARG_LLONG,
+	ARG_PTR,
+};
+
+struct conversion {
+	enum pad_type padding;
+	int min_width;
+	int long_ctr;
+	/* '\0' if the format string ends within the conversion */
+	char specifier;
+};
+
+enum arg_src_type {
+	SRC_VA_LIST,
+	SRC_PACKAGE,
+	SRC_WORDS,
+};
+
+struct arg_src {
+	enum arg_src_type type;
+	union {
+		va_list ap;
+		const u8_t *pos;
+		struct {
+			const u32_t *pos;
+			const u32_t *end;
+		} words;
+	} u;
+};
+
+/* Parses the conversion following a '%', returns the character after it */
+static const char *parse_conversion(const char *fmt, struct conversion *conv)
+{
+	conv->padding = PAD_NONE;
+	conv->min_width = -1;
+	conv->long_ctr = 0;
+
+	for (; *fmt; fmt++) {
+		switch (*fmt) {
+		case '-':
+			conv->padding = PAD_SPACE_AFTER;
+			continue;
+		case '0':
+			if (conv->min_width < 0 && conv->padding == PAD_NONE) {
+				conv->padding = PAD_ZERO_BEFORE;
+				continue;
+			}
+			/* Fall through */
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6':
+		case '7':
+		case '8':
+		case '9':
+			if (conv->min_width < 0) {
+				conv->min_width = *fmt - '0';
+			} else {
+				conv->min_width = 10 * conv->min_width +
+						  *fmt - '0';
+			}
+
+			if (conv->padding == PAD_NONE) {
+				conv->padding = PAD_SPACE_BEFORE;
+			}
+			continue;
+		case 'l':
+			conv->long_ctr++;
+			continue;
+		case 'z':
+			/* size_t is as wide as long on all supported targets */
+			conv->long_ctr = sizeof(size_t) == sizeof(long) ? 1 : 0;
+			continue;
+		case 'h':
+			continue;
+		default:
+			conv->specifier = *fmt;
+			return fmt + 1;
+		}
+	}
+
+	conv->specifier = '\0';
+
+	return fmt;
+}
+
+static enum arg_class arg_class_get(const struct conversion *conv)
+{
+	switch (conv->specifier) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'x':
+	case 'X':
+		if (conv->long_ctr == 0) {
+			return ARG_INT;
+		}
+
+		return conv->long_ctr == 1 ? ARG_LONG : ARG_LLONG;
+	case 'c':
+		return ARG_INT;
+	case 'p':
+	case 's':
+		return ARG_PTR;
+	default:
+		return ARG_NONE;
+	}
+}
+
+#define GET_PACKAGED(pos, type) ({		\
+	type _v;				\
+						\
+	memcpy(&_v, pos, sizeof(_v));		\
+	pos += sizeof(_v);			\
+	_v;					\
+})
+
+/* Raw bits of the next argument, of the given class */
+static unsigned long long arg_get(struct arg_src *src, enum arg_class class)
+{
+	switch (src->type) {
+	case SRC_VA_LIST:
+		switch (class) {
+		case ARG_INT:
+			return va_arg(src->u.ap, unsigned int);
+		case ARG_LONG:
+			return va_arg(src->u.ap, unsigned long);
+		case ARG_LLONG:
+			return va_arg(src->u.ap, unsigned long long);
+		case ARG_PTR:
+			return (uintptr_t)va_arg(src->u.ap, void *);
+		default:
+			return 0;
+		}
+	case SRC_PACKAGE:
+		switch (class) {
+		case ARG_INT:
+			return GET_PACKAGED(src->u.pos, unsigned int);
+		case ARG_LONG:
+			return GET_PACKAGED(src->u.pos, unsigned long);
+		case ARG_LLONG:
+			return GET_PACKAGED(src->u.pos, unsigned long long);
+		case ARG_PTR:
+			return (uintptr_t)GET_PACKAGED(src->u.pos, void *);
+		default:
+			return 0;
+		}
+	default:
+		if (src->u.words.pos == src->u.words.end) {
+			return 0;
+		}
+
+		return *src->u.words.pos++;
+	}
+}
+
+struct out_state {
+	cbprintf_cb out;
+	void *ctx;
+	int count;
+};
+
+static inline void out_char(struct out_state *st, int c)
+{
+	st->out(c, st->ctx);
+	st->count++;
+}
+
+static void print_err(struct out_state *st)
+{
+	out_char(st, 'E');
+	out_char(st, 'R');
+	out_char(st, 'R');
+}
+
+static void print_pad(struct out_state *st, int c, int count)
+{
+	while (count-- > 0) {
+		out_char(st, c);
+	}
+}
+
+/* Decimal output of num, padded to at most 10 characters before it */
+static void print_dec(struct out_state *st, u32_t num,
+		      enum pad_type padding, int min_width)
+{
+	char digits[10];
+	int len = 0;
+	int i;
+
+	/* make sure we don't skip if value is zero */
+	if (min_width <= 0) {
+		min_width = 1;
+	}
+
+	do {
+		digits[len++] = '0' + num % 10U;
+		num /= 10U;
+	} while (num);
+
+	if (padding == PAD_ZERO_BEFORE || padding == PAD_SPACE_BEFORE) {
+		print_pad(st, padding == PAD_ZERO_BEFORE ? '0' : ' ',
+			  MIN(min_width, 10) - len);
+	}
+
+	for (i = len; i > 0; i--) {
+		out_char(st, digits[i - 1]);
+	}
+
+	if (padding == PAD_SPACE_AFTER) {
+		print_pad(st, ' ', min_width - len);
+	}
+}
+
+/* Hexadecimal output of num, padded to at most 16 characters before it */
+static void print_hex(struct out_state *st, unsigned long long num,
+		      enum pad_type padding, int min_width)
+{
+	char digits[16];
+	int len = 0;
+	int nibble;
+	int i;
+
+	do {
+		nibble = num & 0xf;
+		digits[len++] = nibble + (nibble > 9 ? 87 : 48);
+		num >>= 4;
+	} while (num);
+
+	if (padding == PAD_ZERO_BEFORE || padding == PAD_SPACE_BEFORE) {
+		print_pad(st, padding == PAD_ZERO_BEFORE ? '0' : ' ',
+			  MIN(min_width, 16) - len);
+	}
+
+	for (i = len; i > 0; i--) {
+		out_char(st, digits[i - 1]);
+	}
+
+	if (padding == PAD_SPACE_AFTER) {
+		/* width counted in bytes, as printk always did */
+		print_pad(st, ' ', min_width * 2 - len);
+	}
+}
+
+static void print_conversion(struct out_state *st, struct conversion *conv,
+			     struct arg_src *src)
+{
+	enum arg_class class = arg_class_get(conv);
+	unsigned long long value = arg_get(src, class);
+	long long sval;
+	const char *s;
+	int len;
+
+	switch (conv->specifier) {
+	case 'd':
+	case 'i':
+		if (class == ARG_INT) {
+			sval = (int)value;
+		} else if (class == ARG_LONG) {
+			sval = (long)value;
+		} else {
+			sval = (long long)value;
+		}
+
+		if (sval > INT32_MAX || sval < INT32_MIN) {
+			print_err(st);
+			break;
+		}
+
+		if (sval < 0) {
+			out_char(st, '-');
+			sval = -sval;
+			conv->min_width--;
+		}
+
+		print_dec(st, sval, conv->padding, conv->min_width);
+		break;
+	case 'u':
+		/* long values were range checked as signed */
+		if (class == ARG_LONG && (long)value > INT32_MAX) {
+			print_err(st);
+			break;
+		}
+
+		if (class == ARG_LLONG && value > INT32_MAX) {
+			print_err(st);
+			break;
+		}
+
+		print_dec(st, value, conv->padding, conv->min_width);
+		break;
+	case 'p':
+		out_char(st, '0');
+		out_char(st, 'x');
+		/* left-pad pointers with zeros */
+		print_hex(st, value, PAD_ZERO_BEFORE, 8);
+		break;
+	case 'x':
+	case 'X':
+		print_hex(st, value, conv->padding, conv->min_width);
+		break;
+	case 's':
+		s = (const char *)(uintptr_t)value;
+		for (len = 0; s[len]; len++) {
+			out_char(st, s[len]);
+		}
+
+		if (conv->padding == PAD_SPACE_AFTER) {
+			print_pad(st, ' ', conv->min_width - len);
+		}
+		break;
+	case 'c':
+		out_char(st, (int)value);
+		break;
+	case '%':
+		out_char(st, '%');
+		break;
+	case '\0':
+		break;
+	default:
+		out_char(st, '%');
+		out_char(st, conv->specifier);
+		break;
+	}
+}
+
+static int format(cbprintf_cb out, void *ctx, const char *fmt,
+		  struct arg_src *src)
+{
+	struct out_state st = { out, ctx, 0 };
+	struct conversion conv;
+
+	while (*fmt) {
+		if (*fmt != '%') {
+			out_char(&st, *fmt++);
+			continue;
+		}
+
+		fmt = parse_conversion(fmt + 1, &conv);
+		print_conversion(&st, &conv, src);
+	}
+
+	return st.count;
+}
+
+int cbvprintf(cbprintf_cb out, void *ctx, const char *fmt, va_list ap)
+{
+	struct arg_src src = { .type = SRC_VA_LIST };
+	int count;
+
+	va_copy(src.u.ap, ap);
+	count = format(out, ctx, fmt, &src);
+	va_end(src.u.ap);
+
+	return count;
+}
+
+int cbprintf(cbprintf_cb out, void *ctx, const char *fmt, ...)
+{
+	va_list ap;
+	int count;
+
+	va_start(ap, fmt);
+	count = cbvprintf(out, ctx, fmt, ap);
+	va_end(ap);
+
+	return count;
+}
+
+int cbpprintf(cbprintf_cb out, void *ctx, const void *package)
+{
+	struct arg_src src = { .type = SRC_PACKAGE };
+	const char *fmt;
+
+	memcpy(&fmt, package, sizeof(fmt));
+	src.u.pos = (const u8_t *)package + sizeof(fmt);
+
+	return format(out, ctx, fmt, &src);
+}
+
+int z_cbprintf_words(cbprintf_cb out, void *ctx, const char *fmt,
+		     const u32_t *args, size_t nargs)
+{
+	struct arg_src src = { .type = SRC_WORDS };
+
+	src.u.words.pos = args;
+	src.u.words.end = args + nargs;
+
+	return format(out, ctx, fmt, &src);
+}
+
+/* Appends an argument at offset off of buf, if it fits in len bytes */
+#define PUT_PACKAGED(buf, len, off, type, val) do {		\
+	type _v = (val);					\
+								\
+	if (buf && off + sizeof(_v) <= len) {			\
+		memcpy(&buf[off], &_v, sizeof(_v));		\
+	}							\
+	off += sizeof(_v);					\
+} while (false)
+
+int cbvprintf_package(void *packaged, size_t len, const char *fmt,
+		      va_list ap)
+{
+	u8_t *buf = packaged;
+	struct conversion conv;
+	size_t size = 0;
+	va_list aq;
+
+	va_copy(aq, ap);
+
+	PUT_PACKAGED(buf, len, size, const char *, fmt);
+
+	while (*fmt) {
+		if (*fmt++ != '%') {
+			continue;
+		}
+
+		fmt = parse_conversion(fmt, &conv);
+
+		switch (arg_class_get(&conv)) {
+		case ARG_INT:
+			PUT_PACKAGED(buf, len, size, unsigned int,
+				     va_arg(aq, unsigned int));
+			break;
+		case ARG_LONG:
+			PUT_PACKAGED(buf, len, size, unsigned long,
+				     va_arg(aq, unsigned long));
+			break;
+		case ARG_LLONG:
+			PUT_PACKAGED(buf, len, size, unsigned long long,
+				     va_arg(aq, unsigned long long));
+			break;
+		case ARG_PTR:
+			PUT_PACKAGED(buf, len, size, void *,
+				     va_arg(aq, void *));
+			break;
+		default:
+			break;
+		}
+	}
+
+	va_end(aq);
+
+	if (buf && size > len) {
+		return -ENOSPC;
+	}
+
+	return size;
+}
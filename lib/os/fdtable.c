@@ -16,12 +16,24 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <kernel.h>
+#include <atomic.h>
 #include <misc/fdtable.h>
 #include <misc/speculation.h>
 
+/*
+ * Lookups do not lock anything. An entry is usable while its refcount is
+ * not 0 and FD_CLOSED is not set: the table holds one reference from
+ * z_finalize_fd() to z_free_fd(), and each z_get_fd_obj_ref() one more
+ * until z_put_fd_obj(). The fd number is only given out again once the
+ * last reference is dropped, so an operation racing with close() can never
+ * reach an object opened meanwhile under the same number.
+ */
+#define FD_CLOSED BIT(30)
+
 struct fd_entry {
 	void *obj;
 	const struct fd_op_vtable *vtable;
+	atomic_t refcount;
 };
 
 /* A few magic values for fd_entry::obj used in the code. */
@@ -41,20 +53,37 @@ static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
 	 * is unused and just should be !0 (random different values
 	 * are used to posisbly help with debugging).
 	 */
-	{FD_OBJ_STDIN,  &stdinout_fd_op_vtable},
-	{FD_OBJ_STDOUT, &stdinout_fd_op_vtable},
-	{FD_OBJ_STDERR, &stdinout_fd_op_vtable},
+	{FD_OBJ_STDIN,  &stdinout_fd_op_vtable, ATOMIC_INIT(1)},
+	{FD_OBJ_STDOUT, &stdinout_fd_op_vtable, ATOMIC_INIT(1)},
+	{FD_OBJ_STDERR, &stdinout_fd_op_vtable, ATOMIC_INIT(1)},
 #endif
 };
 
-static K_MUTEX_DEFINE(fdtable_lock);
+/* Bit set for each allocated entry, so that allocation is lock-free */
+static ATOMIC_DEFINE(fdtable_used, CONFIG_POSIX_MAX_FDS) = {
+#ifdef CONFIG_POSIX_API
+	ATOMIC_INIT(BIT(0) | BIT(1) | BIT(2)),
+#endif
+};
 
+/* Allocates the lowest free fd */
 static int _find_fd_entry(void)
 {
-	int fd;
-
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (fdtable[fd].obj == NULL) {
+	atomic_val_t used;
+	int i, bit, fd;
+
+	for (i = 0; i < ARRAY_SIZE(fdtable_used); i++) {
+		do {
+			used = atomic_get(&fdtable_used[i]);
+			bit = find_lsb_set(~used) - 1;
+			fd = i * ATOMIC_BITS + bit;
+			if (bit < 0 || fd >= ARRAY_SIZE(fdtable)) {
+				break;
+			}
+		} while (!atomic_cas(&fdtable_used[i], used,
+				     used | ATOMIC_MASK(bit)));
+
+		if (bit >= 0 && fd < ARRAY_SIZE(fdtable)) {
 			return fd;
 		}
 	}
@@ -63,8 +92,17 @@ static int _find_fd_entry(void)
 	return -1;
 }
 
+static void _release_fd_entry(int fd)
+{
+	fdtable[fd].obj = NULL;
+	atomic_clear(&fdtable[fd].refcount);
+	atomic_clear_bit(fdtable_used, fd);
+}
+
 static int _check_fd(int fd)
 {
+	atomic_val_t refcount;
+
 	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
 		errno = EBADF;
 		return -1;
@@ -72,7 +110,8 @@ static int _check_fd(int fd)
 
 	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
 
-	if (fdtable[fd].obj == NULL) {
+	refcount = atomic_get(&fdtable[fd].refcount);
+	if (refcount == 0 || (refcount & FD_CLOSED)) {
 		errno = EBADF;
 		return -1;
 	}
@@ -112,20 +151,50 @@ void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable)
 	return fd_entry->obj;
 }
 
+void *z_get_fd_obj_ref(int fd, const struct fd_op_vtable **vtable)
+{
+	struct fd_entry *fd_entry;
+	atomic_val_t refcount;
+
+	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
+	fd_entry = &fdtable[fd];
+
+	do {
+		refcount = atomic_get(&fd_entry->refcount);
+		if (refcount == 0 || (refcount & FD_CLOSED)) {
+			errno = EBADF;
+			return NULL;
+		}
+	} while (!atomic_cas(&fd_entry->refcount, refcount, refcount + 1));
+
+	*vtable = fd_entry->vtable;
+
+	return fd_entry->obj;
+}
+
+void z_put_fd_obj(int fd)
+{
+	/* Assumes fd was referenced by z_get_fd_obj_ref(). */
+	if (atomic_dec(&fdtable[fd].refcount) == (FD_CLOSED | 1)) {
+		_release_fd_entry(fd);
+	}
+}
+
 int z_reserve_fd(void)
 {
 	int fd;
 
-	(void)k_mutex_lock(&fdtable_lock, K_FOREVER);
-
 	fd = _find_fd_entry();
 	if (fd >= 0) {
 		/* Mark entry as used, z_finalize_fd() will fill it in. */
 		fdtable[fd].obj = FD_OBJ_RESERVED;
 	}
 
-	k_mutex_unlock(&fdtable_lock);
-
 	return fd;
 }
 
@@ -134,12 +203,35 @@ void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 	/* Assumes fd was already bounds-checked. */
 	fdtable[fd].obj = obj;
 	fdtable[fd].vtable = vtable;
+
+	/* Publish the entry, the atomic store orders the ones above. */
+	atomic_set(&fdtable[fd].refcount, 1);
 }
 
 void z_free_fd(int fd)
 {
+	atomic_val_t refcount;
+
 	/* Assumes fd was already bounds-checked. */
-	fdtable[fd].obj = NULL;
+	if (fdtable[fd].obj == FD_OBJ_RESERVED) {
+		/* Never finalized, nobody can hold a reference. */
+		_release_fd_entry(fd);
+		return;
+	}
+
+	/* Drop the reference of the table, refusing new ones. */
+	do {
+		refcount = atomic_get(&fdtable[fd].refcount);
+		if (refcount == 0 || (refcount & FD_CLOSED)) {
+			/* Already closed, the reference is gone. */
+			return;
+		}
+	} while (!atomic_cas(&fdtable[fd].refcount, refcount,
+			     (refcount | FD_CLOSED) - 1));
+
+	if (refcount == 1) {
+		_release_fd_entry(fd);
+	}
 }
 
 int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
@@ -158,34 +250,51 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 
 ssize_t read(int fd, void *buf, size_t sz)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj = z_get_fd_obj_ref(fd, &vtable);
+	ssize_t res;
+
+	if (obj == NULL) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->read(fdtable[fd].obj, buf, sz);
+	res = vtable->read(obj, buf, sz);
+	z_put_fd_obj(fd);
+
+	return res;
 }
 FUNC_ALIAS(read, _read, ssize_t);
 
 ssize_t write(int fd, const void *buf, size_t sz)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj = z_get_fd_obj_ref(fd, &vtable);
+	ssize_t res;
+
+	if (obj == NULL) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->write(fdtable[fd].obj, buf, sz);
+	res = vtable->write(obj, buf, sz);
+	z_put_fd_obj(fd);
+
+	return res;
 }
 FUNC_ALIAS(write, _write, ssize_t);
 
 int close(int fd)
 {
+	const struct fd_op_vtable *vtable;
+	void *obj = z_get_fd_obj_ref(fd, &vtable);
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (obj == NULL) {
 		return -1;
 	}
 
-	res = z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_CLOSE);
+	res = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_CLOSE);
 	z_free_fd(fd);
+	z_put_fd_obj(fd);
 
 	return res;
 }
@@ -193,36 +302,53 @@ FUNC_ALIAS(close, _close, int);
 
 int fsync(int fd)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj = z_get_fd_obj_ref(fd, &vtable);
+	int res;
+
+	if (obj == NULL) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_FSYNC);
+	res = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_FSYNC);
+	z_put_fd_obj(fd);
+
+	return res;
 }
 
 off_t lseek(int fd, off_t offset, int whence)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj = z_get_fd_obj_ref(fd, &vtable);
+	off_t res;
+
+	if (obj == NULL) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_LSEEK,
-			  offset, whence);
+	res = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_LSEEK, offset,
+				   whence);
+	z_put_fd_obj(fd);
+
+	return res;
 }
 FUNC_ALIAS(lseek, _lseek, off_t);
 
 int ioctl(int fd, unsigned long request, ...)
 {
+	const struct fd_op_vtable *vtable;
+	void *obj = z_get_fd_obj_ref(fd, &vtable);
 	va_list args;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (obj == NULL) {
 		return -1;
 	}
 
 	va_start(args, request);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, request, args);
+	res = vtable->ioctl(obj, request, args);
 	va_end(args);
+	z_put_fd_obj(fd);
 
 	return res;
 }
@@ -235,6 +361,8 @@ int ioctl(int fd, unsigned long request, ...)
 #ifndef CONFIG_SOC_FAMILY_TISIMPLELINK
 int fcntl(int fd, int cmd, ...)
 {
+	const struct fd_op_vtable *vtable;
+	void *obj;
 	va_list args;
 	int res;
 
@@ -251,9 +379,15 @@ int fcntl(int fd, int cmd, ...)
 	}
 
 	/* The rest of commands are per-fd, handled by ioctl vmethod. */
+	obj = z_get_fd_obj_ref(fd, &vtable);
+	if (obj == NULL) {
+		return -1;
+	}
+
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = vtable->ioctl(obj, cmd, args);
 	va_end(args);
+	z_put_fd_obj(fd);
 
 	return res;
 }
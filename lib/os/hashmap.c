@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <misc/__assert.h>
+#include <misc/hashmap.h>
+
+#define FNV1A_OFFSET_BASIS	2166136261U
+#define FNV1A_PRIME		16777619U
+
+void sys_hashmap_init(struct sys_hashmap *map,
+		      struct sys_hashmap_node **slots, size_t capacity,
+		      sys_hashmap_hash_t hash_fn, sys_hashmap_eq_t eq_fn)
+{
+	__ASSERT(capacity > 1 && (capacity & (capacity - 1)) == 0,
+		 "capacity must be a power of two");
+
+	map->slots = slots;
+	map->capacity = capacity;
+	map->hash_fn = hash_fn;
+	map->eq_fn = eq_fn;
+	sys_hashmap_clear(map);
+}
+
+void sys_hashmap_clear(struct sys_hashmap *map)
+{
+	memset(map->slots, 0, map->capacity * sizeof(map->slots[0]));
+	map->size = 0;
+}
+
+/* Index of the slot of the key, or of the empty slot ending its probe
+ * sequence. There is always an empty slot, as the map is never full.
+ */
+static size_t find_slot(const struct sys_hashmap *map, const void *key,
+			u32_t hash)
+{
+	size_t mask = map->capacity - 1;
+	size_t i = hash & mask;
+	struct sys_hashmap_node *node;
+
+	while ((node = map->slots[i]) != NULL) {
+		if (node->hash == hash && map->eq_fn(node, key)) {
+			break;
+		}
+
+		i = (i + 1) & mask;
+	}
+
+	return i;
+}
+
+int sys_hashmap_insert(struct sys_hashmap *map, struct sys_hashmap_node *node,
+		       const void *key)
+{
+	u32_t hash = map->hash_fn(key);
+	size_t i = find_slot(map, key, hash);
+
+	if (map->slots[i]) {
+		return -EEXIST;
+	}
+
+	/* keep one slot empty to end the probe sequences */
+	if (sys_hashmap_is_full(map)) {
+		return -ENOSPC;
+	}
+
+	node->hash = hash;
+	map->slots[i] = node;
+	map->size++;
+
+	return 0;
+}
+
+struct sys_hashmap_node *sys_hashmap_get(const struct sys_hashmap *map,
+					 const void *key)
+{
+	return map->slots[find_slot(map, key, map->hash_fn(key))];
+}
+
+bool sys_hashmap_remove(struct sys_hashmap *map,
+			struct sys_hashmap_node *node)
+{
+	size_t mask = map->capacity - 1;
+	size_t i = node->hash & mask;
+	size_t j, home;
+
+	while (map->slots[i] != node) {
+		if (!map->slots[i]) {
+			return false;
+		}
+
+		i = (i + 1) & mask;
+	}
+
+	/*
+	 * Shift back the following nodes of the cluster that would not be
+	 * found anymore past the hole, i.e. those whose home slot is not
+	 * cyclically in (i, j].
+	 */
+	for (j = (i + 1) & mask; map->slots[j]; j = (j + 1) & mask) {
+		home = map->slots[j]->hash & mask;
+
+		if (i <= j ? (i < home && home <= j) :
+			     (i < home || home <= j)) {
+			continue;
+		}
+
+		map->slots[i] = map->slots[j];
+		i = j;
+	}
+
+	map->slots[i] = NULL;
+	map->size--;
+
+	return true;
+}
+
+struct sys_hashmap_node *sys_hashmap_next(const struct sys_hashmap *map,
+					  size_t *iter)
+{
+	struct sys_hashmap_node *node;
+
+	while (*iter < map->capacity) {
+		node = map->slots[(*iter)++];
+		if (node) {
+			return node;
+		}
+	}
+
+	return NULL;
+}
+
+u32_t sys_hash32_fnv1a(const void *data, size_t len)
+{
+	const u8_t *bytes = data;
+	u32_t hash = FNV1A_OFFSET_BASIS;
+
+	while (len--) {
+		hash ^= *bytes++;
+		hash *= FNV1A_PRIME;
+	}
+
+	return hash;
+}
+
+u32_t sys_hash32_str(const char *str)
+{
+	u32_t hash = FNV1A_OFFSET_BASIS;
+
+	while (*str) {
+		hash ^= (u8_t)*str++;
+		hash *= FNV1A_PRIME;
+	}
+
+	return hash;
+}
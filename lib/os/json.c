@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
+#include <float.h>
 #include <limits.h>
 #include <misc/printk.h>
 #include <misc/util.h>
@@ -219,7 +220,8 @@ static void *lexer_number(struct lexer *lexer)
 	while (true) {
 		int chr = next(lexer);
 
-		if (isdigit(chr) || chr == '.') {
+		if (isdigit(chr) || chr == '.' || chr == 'e' || chr == 'E' ||
+		    chr == '+' || chr == '-') {
 			continue;
 		}
 
@@ -388,215 +390,1141 @@ static int arr_next(struct json_obj *json, struct token *value)
 	return element_token(value->type);
 }
 
-static int decode_num(const struct token *token, s32_t *num)
+static const char *skip_digits(const char *num, const char *end)
 {
-	/* FIXME: strtod() is not available in newlib/minimal libc,
-	 * so using strtol() here.
-	 */
-	char *endptr;
-	char prev_end;
+	while (num < end && isdigit((unsigned char)*num)) {
+		num++;
+	}
+
+	return num;
+}
+
+static bool number_valid(const char *num, size_t len)
+{
+	const char *end = num + len;
+	const char *digits;
+
+	if (num < end && *num == '-') {
+		num++;
+	}
+
+	if (num < end && *num == '0') {
+		num++;
+	} else {
+		digits = num;
+		num = skip_digits(num, end);
+		if (num == digits) {
+			return false;
+		}
+	}
+
+	if (num < end && *num == '.') {
+		digits = ++num;
+		num = skip_digits(num, end);
+		if (num == digits) {
+			return false;
+		}
+	}
+
+	if (num < end && (*num == 'e' || *num == 'E')) {
+		num++;
+		if (num < end && (*num == '+' || *num == '-')) {
+			num++;
+		}
+
+		digits = num;
+		num = skip_digits(num, end);
+		if (num == digits) {
+			return false;
+		}
+	}
+
+	return num == end;
+}
+
+static int parse_int64(const char *num, size_t len, s64_t *value)
+{
+	const char *end = num + len;
+	bool negative = false;
+	u64_t acc = 0U;
+	u64_t limit;
+
+	if (num < end && *num == '-') {
+		negative = true;
+		num++;
+	}
+
+	if (num == end) {
+		return -EINVAL;
+	}
+
+	limit = negative ? (u64_t)INT64_MAX + 1U : (u64_t)INT64_MAX;
+
+	for (; num < end; num++) {
+		unsigned int digit = *num - '0';
+
+		if (digit > 9U) {
+			return -EINVAL;
+		}
+
+		if (acc > (limit - digit) / 10U) {
+			return -ERANGE;
+		}
+
+		acc = acc * 10U + digit;
+	}
+
+	*value = negative ? -(s64_t)(acc - 1U) - 1 : (s64_t)acc;
+
+	return 0;
+}
+
+static const double pow10_table[] = {
+	1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256,
+};
+
+static double scale_pow10(double value, int exp10)
+{
+	unsigned int e = (exp10 < 0) ? -exp10 : exp10;
+	size_t i;
+
+	for (i = 0; e != 0U && i < ARRAY_SIZE(pow10_table); i++, e >>= 1) {
+		if (e & 1U) {
+			if (exp10 < 0) {
+				value /= pow10_table[i];
+			} else {
+				value *= pow10_table[i];
+			}
+		}
+	}
+
+	return value;
+}
+
+/*
+ * Up to 19 significant digits are accumulated in an integer, which is
+ * then scaled by the decimal exponent. The scaling is not correctly
+ * rounded, but strtod() is not available in the minimal libc.
+ */
+static int parse_double(const char *num, size_t len, double *value)
+{
+	const char *end = num + len;
+	bool negative = false;
+	bool exp_negative = false;
+	u64_t mantissa = 0U;
+	int digits = 0;
+	int exp10 = 0;
+	int exp = 0;
+
+	if (!number_valid(num, len)) {
+		return -EINVAL;
+	}
+
+	if (*num == '-') {
+		negative = true;
+		num++;
+	}
+
+	for (; num < end && isdigit((unsigned char)*num); num++) {
+		if (digits < 19) {
+			mantissa = mantissa * 10U + (*num - '0');
+			digits += (mantissa != 0U);
+		} else {
+			exp10++;
+		}
+	}
+
+	if (num < end && *num == '.') {
+		for (num++; num < end && isdigit((unsigned char)*num); num++) {
+			if (digits < 19) {
+				mantissa = mantissa * 10U + (*num - '0');
+				digits += (mantissa != 0U);
+				exp10--;
+			}
+		}
+	}
+
+	if (num < end) {
+		/* 'e' or 'E' */
+		num++;
+		if (*num == '+' || *num == '-') {
+			exp_negative = *num == '-';
+			num++;
+		}
+
+		for (; num < end; num++) {
+			if (exp < 10000) {
+				exp = exp * 10 + (*num - '0');
+			}
+		}
+	}
+
+	exp10 += exp_negative ? -exp : exp;
+	exp10 = MAX(MIN(exp10, 400), -400);
+
+	*value = scale_pow10((double)mantissa, exp10);
+	if (*value > DBL_MAX) {
+		return -ERANGE;
+	}
+
+	if (negative) {
+		*value = -*value;
+	}
+
+	return 0;
+}
+
+static int decode_num(const struct json_obj_descr *descr, const char *num,
+		      size_t len, void *field)
+{
+	s64_t value;
+	int ret;
+
+	switch (descr->type) {
+	case JSON_TOK_NUMBER:
+		ret = parse_int64(num, len, &value);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (value < INT32_MIN || value > INT32_MAX) {
+			return -ERANGE;
+		}
+
+		*(s32_t *)field = (s32_t)value;
+
+		return 0;
+	case JSON_TOK_INT64:
+		return parse_int64(num, len, field);
+	case JSON_TOK_FLOAT:
+		return parse_double(num, len, field);
+	default:
+		return -EINVAL;
+	}
+}
+
+static bool equivalent_types(enum json_tokens type1, enum json_tokens type2)
+{
+	if (type1 == JSON_TOK_TRUE || type1 == JSON_TOK_FALSE) {
+		return type2 == JSON_TOK_TRUE || type2 == JSON_TOK_FALSE;
+	}
+
+	if (type1 == JSON_TOK_NUMBER) {
+		return type2 == JSON_TOK_NUMBER || type2 == JSON_TOK_INT64 ||
+		       type2 == JSON_TOK_FLOAT;
+	}
+
+	return type1 == type2;
+}
+
+static int obj_parse(struct json_obj *obj,
+		     const struct json_obj_descr *descr, size_t descr_len,
+		     void *val);
+static int arr_parse(struct json_obj *obj,
+		     const struct json_obj_descr *elem_descr,
+		     size_t max_elements, void *field, void *val);
+
+static int decode_value(struct json_obj *obj,
+			const struct json_obj_descr *descr,
+			struct token *value, void *field, void *val)
+{
+
+	if (!equivalent_types(value->type, descr->type)) {
+		return -EINVAL;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_OBJECT_START:
+		return obj_parse(obj, descr->object.sub_descr,
+				 descr->object.sub_descr_len,
+				 field);
+	case JSON_TOK_LIST_START:
+		return arr_parse(obj, descr->array.element_descr,
+				 descr->array.n_elements, field, val);
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE: {
+		bool *v = field;
+
+		*v = value->type == JSON_TOK_TRUE;
+
+		return 0;
+	}
+	case JSON_TOK_NUMBER:
+	case JSON_TOK_INT64:
+	case JSON_TOK_FLOAT:
+		return decode_num(descr, value->start,
+				  (size_t)(value->end - value->start), field);
+	case JSON_TOK_STRING: {
+		char **str = field;
+
+		*value->end = '\0';
+		*str = value->start;
+
+		return 0;
+	}
+	default:
+		return -EINVAL;
+	}
+}
 
-	prev_end = *token->end;
-	*token->end = '\0';
+static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
+{
+	switch (descr->type) {
+	case JSON_TOK_NUMBER:
+		return sizeof(s32_t);
+	case JSON_TOK_INT64:
+		return sizeof(s64_t);
+	case JSON_TOK_FLOAT:
+		return sizeof(double);
+	case JSON_TOK_STRING:
+		return sizeof(char *);
+	case JSON_TOK_TRUE:
+	case JSON_TOK_FALSE:
+		return sizeof(bool);
+	case JSON_TOK_LIST_START:
+		return descr->array.n_elements * get_elem_size(descr->array.element_descr);
+	case JSON_TOK_OBJECT_START: {
+		ptrdiff_t total = 0;
+		size_t i;
+
+		for (i = 0; i < descr->object.sub_descr_len; i++) {
+			ptrdiff_t s = get_elem_size(&descr->object.sub_descr[i]);
+
+			total += ROUND_UP(s, 1 << descr->align_shift);
+		}
+
+		return total;
+	}
+	default:
+		return -EINVAL;
+	}
+}
+
+static int arr_parse(struct json_obj *obj,
+		     const struct json_obj_descr *elem_descr,
+		     size_t max_elements, void *field, void *val)
+{
+	ptrdiff_t elem_size = get_elem_size(elem_descr);
+	void *last_elem = (char *)field + elem_size * max_elements;
+	size_t *elements = (size_t *)((char *)val + elem_descr->offset);
+	struct token value;
+
+	assert(elem_size > 0);
+
+	*elements = 0;
+
+	while (!arr_next(obj, &value)) {
+		if (value.type == JSON_TOK_LIST_END) {
+			return 0;
+		}
+
+		if (field == last_elem) {
+			return -ENOSPC;
+		}
+
+		if (decode_value(obj, elem_descr, &value, field, val) < 0) {
+			return -EINVAL;
+		}
+
+		(*elements)++;
+		field = (char *)field + elem_size;
+	}
+
+	return -EINVAL;
+}
+
+static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
+		     size_t descr_len, void *val)
+{
+	struct json_obj_key_value kv;
+	s32_t decoded_fields = 0;
+	size_t i;
+	int ret;
+
+	while (!obj_next(obj, &kv)) {
+		if (kv.value.type == JSON_TOK_OBJECT_END) {
+			return decoded_fields;
+		}
+
+		for (i = 0; i < descr_len; i++) {
+			void *decode_field = (char *)val + descr[i].offset;
+
+			/* Field has been decoded already, skip */
+			if (decoded_fields & (1 << i)) {
+				continue;
+			}
+
+			/* Check if it's the i-th field */
+			if (kv.key_len != descr[i].field_name_len) {
+				continue;
+			}
+
+			if (memcmp(kv.key, descr[i].field_name,
+				   descr[i].field_name_len)) {
+				continue;
+			}
+
+			/* Store the decoded value */
+			ret = decode_value(obj, &descr[i], &kv.value,
+					   decode_field, val);
+			if (ret < 0) {
+				return ret;
+			}
+
+			decoded_fields |= 1<<i;
+			break;
+		}
+	}
+
+	return -EINVAL;
+}
+
+int json_obj_parse(char *payload, size_t len,
+		   const struct json_obj_descr *descr, size_t descr_len,
+		   void *val)
+{
+	struct json_obj obj;
+	int ret;
+
+	assert(descr_len < (sizeof(ret) * CHAR_BIT - 1));
+
+	ret = obj_init(&obj, payload, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return obj_parse(&obj, descr, descr_len, val);
+}
+
+enum json_stream_state {
+	STREAM_VALUE,
+	STREAM_ARRAY_FIRST,
+	STREAM_OBJECT_FIRST,
+	STREAM_KEY,
+	STREAM_COLON,
+	STREAM_NEXT,
+	STREAM_STRING,
+	STREAM_ESCAPE,
+	STREAM_UNICODE,
+	STREAM_NUMBER,
+	STREAM_LITERAL,
+	STREAM_DONE,
+	STREAM_ERROR,
+};
+
+void json_stream_init(struct json_stream *stream,
+		      const struct json_stream_cb *cb, void *user_data,
+		      char *buf, size_t buf_size)
+{
+	(void)memset(stream, 0, sizeof(*stream));
+
+	stream->cb = cb;
+	stream->user_data = user_data;
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+	stream->state = STREAM_VALUE;
+}
+
+static bool stream_in_token(struct json_stream *stream)
+{
+	return stream->state >= STREAM_STRING &&
+	       stream->state <= STREAM_NUMBER;
+}
+
+static bool stream_in_object(struct json_stream *stream)
+{
+	return (stream->nesting & BIT(stream->depth - 1)) != 0U;
+}
+
+/* Append the part of the token up to @a end to the token buffer */
+static int stream_flush(struct json_stream *stream, const char *end)
+{
+	size_t len = (size_t)(end - stream->tok);
+
+	if (len > stream->buf_size - stream->buf_len) {
+		return -ENOMEM;
+	}
+
+	memcpy(stream->buf + stream->buf_len, stream->tok, len);
+	stream->buf_len += len;
+	stream->tok = end;
+
+	return 0;
+}
+
+/*
+ * Locate the text of the token ending at @a end: in place in the chunk if
+ * it started there, in the token buffer otherwise.
+ */
+static int stream_token(struct json_stream *stream, const char *end,
+			const char **text, size_t *len)
+{
+	int ret;
+
+	if (stream->buf_len == 0) {
+		*text = stream->tok;
+		*len = (size_t)(end - stream->tok);
+
+		return 0;
+	}
+
+	ret = stream_flush(stream, end);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*text = stream->buf;
+	*len = stream->buf_len;
+
+	return 0;
+}
+
+static void stream_value_end(struct json_stream *stream)
+{
+	stream->buf_len = 0;
+	stream->state = stream->depth ? STREAM_NEXT : STREAM_DONE;
+}
+
+static int stream_open(struct json_stream *stream, enum json_tokens type)
+{
+	const struct json_stream_cb *cb = stream->cb;
+
+	if (stream->depth == CONFIG_JSON_STREAM_MAX_DEPTH) {
+		return -E2BIG;
+	}
+
+	if (type == JSON_TOK_OBJECT_START) {
+		stream->nesting |= BIT(stream->depth);
+		stream->state = STREAM_OBJECT_FIRST;
+	} else {
+		stream->nesting &= ~BIT(stream->depth);
+		stream->state = STREAM_ARRAY_FIRST;
+	}
+
+	stream->depth++;
+
+	if (type == JSON_TOK_OBJECT_START) {
+		return cb->object_start ?
+		       cb->object_start(stream->user_data) : 0;
+	}
+
+	return cb->array_start ? cb->array_start(stream->user_data) : 0;
+}
+
+static int stream_close(struct json_stream *stream, enum json_tokens type)
+{
+	const struct json_stream_cb *cb = stream->cb;
+
+	if (stream_in_object(stream) != (type == JSON_TOK_OBJECT_END)) {
+		return -EINVAL;
+	}
+
+	stream->depth--;
+	stream_value_end(stream);
+
+	if (type == JSON_TOK_OBJECT_END) {
+		return cb->object_end ? cb->object_end(stream->user_data) : 0;
+	}
+
+	return cb->array_end ? cb->array_end(stream->user_data) : 0;
+}
+
+static int stream_string_end(struct json_stream *stream, const char *end)
+{
+	const struct json_stream_cb *cb = stream->cb;
+	const char *text;
+	size_t len;
+	int ret;
+
+	ret = stream_token(stream, end, &text, &len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (stream->key) {
+		stream->buf_len = 0;
+		stream->state = STREAM_COLON;
+
+		return cb->key ? cb->key(text, len, stream->user_data) : 0;
+	}
+
+	stream_value_end(stream);
+
+	return cb->string ? cb->string(text, len, stream->user_data) : 0;
+}
+
+static int stream_number_end(struct json_stream *stream, const char *end)
+{
+	const struct json_stream_cb *cb = stream->cb;
+	const char *text;
+	size_t len;
+	int ret;
+
+	ret = stream_token(stream, end, &text, &len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!number_valid(text, len)) {
+		return -EINVAL;
+	}
+
+	stream_value_end(stream);
+
+	return cb->number ? cb->number(text, len, stream->user_data) : 0;
+}
+
+static int stream_literal_end(struct json_stream *stream)
+{
+	const struct json_stream_cb *cb = stream->cb;
+	char first = stream->literal[0];
+
+	stream_value_end(stream);
+
+	if (first == 'n') {
+		return cb->null ? cb->null(stream->user_data) : 0;
+	}
+
+	return cb->boolean ? cb->boolean(first == 't', stream->user_data) : 0;
+}
+
+static int stream_value_start(struct json_stream *stream, const char *pos)
+{
+	switch (*pos) {
+	case '{':
+		return stream_open(stream, JSON_TOK_OBJECT_START);
+	case '[':
+		return stream_open(stream, JSON_TOK_LIST_START);
+	case '"':
+		stream->key = false;
+		stream->tok = pos + 1;
+		stream->state = STREAM_STRING;
+		return 0;
+	case 't':
+		stream->literal = "true";
+		break;
+	case 'f':
+		stream->literal = "false";
+		break;
+	case 'n':
+		stream->literal = "null";
+		break;
+	default:
+		if (*pos != '-' && !isdigit((unsigned char)*pos)) {
+			return -EINVAL;
+		}
+
+		stream->tok = pos;
+		stream->state = STREAM_NUMBER;
+		return 0;
+	}
+
+	stream->pos = 1U;
+	stream->state = STREAM_LITERAL;
+
+	return 0;
+}
+
+/*
+ * Process the character at @a pos. Returns 1 when the character ended a
+ * number and has to be processed again in the new state.
+ */
+static int stream_char(struct json_stream *stream, const char *pos)
+{
+	char chr = *pos;
+	int ret;
+
+	switch (stream->state) {
+	case STREAM_STRING:
+		if (chr == '"') {
+			return stream_string_end(stream, pos);
+		}
+
+		if (chr == '\\') {
+			stream->state = STREAM_ESCAPE;
+		}
+
+		return 0;
+	case STREAM_ESCAPE:
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			stream->state = STREAM_STRING;
+			return 0;
+		case 'u':
+			stream->pos = 4U;
+			stream->state = STREAM_UNICODE;
+			return 0;
+		default:
+			return -EINVAL;
+		}
+	case STREAM_UNICODE:
+		if (!isxdigit((unsigned char)chr)) {
+			return -EINVAL;
+		}
+
+		if (--stream->pos == 0U) {
+			stream->state = STREAM_STRING;
+		}
+
+		return 0;
+	case STREAM_NUMBER:
+		if (isdigit((unsigned char)chr) || chr == '.' || chr == 'e' ||
+		    chr == 'E' || chr == '+' || chr == '-') {
+			return 0;
+		}
+
+		ret = stream_number_end(stream, pos);
+
+		return (ret < 0) ? ret : 1;
+	case STREAM_LITERAL:
+		if (chr != stream->literal[stream->pos]) {
+			return -EINVAL;
+		}
+
+		if (stream->literal[++stream->pos] == '\0') {
+			return stream_literal_end(stream);
+		}
+
+		return 0;
+	default:
+		break;
+	}
+
+	if (isspace((unsigned char)chr)) {
+		return 0;
+	}
+
+	switch (stream->state) {
+	case STREAM_OBJECT_FIRST:
+		if (chr == '}') {
+			return stream_close(stream, JSON_TOK_OBJECT_END);
+		}
+
+		/* fallthrough */
+	case STREAM_KEY:
+		if (chr != '"') {
+			return -EINVAL;
+		}
+
+		stream->key = true;
+		stream->tok = pos + 1;
+		stream->state = STREAM_STRING;
+		return 0;
+	case STREAM_COLON:
+		if (chr != ':') {
+			return -EINVAL;
+		}
+
+		stream->state = STREAM_VALUE;
+		return 0;
+	case STREAM_NEXT:
+		if (chr == ',') {
+			stream->state = stream_in_object(stream) ?
+					STREAM_KEY : STREAM_VALUE;
+			return 0;
+		}
+
+		if (chr == '}' || chr == ']') {
+			return stream_close(stream, (enum json_tokens)chr);
+		}
+
+		return -EINVAL;
+	case STREAM_ARRAY_FIRST:
+		if (chr == ']') {
+			return stream_close(stream, JSON_TOK_LIST_END);
+		}
+
+		/* fallthrough */
+	case STREAM_VALUE:
+		return stream_value_start(stream, pos);
+	default:
+		/* Only whitespace after the value */
+		return -EINVAL;
+	}
+}
+
+int json_stream_feed(struct json_stream *stream, const char *data,
+		     size_t len)
+{
+	const char *end = data + len;
+	const char *pos = data;
+	int ret;
+
+	if (stream->state == STREAM_ERROR) {
+		return -EINVAL;
+	}
+
+	/* A token continued from the previous chunk */
+	stream->tok = data;
+
+	while (pos < end) {
+		ret = stream_char(stream, pos);
+		if (ret < 0) {
+			stream->state = STREAM_ERROR;
+			return ret;
+		}
+
+		if (ret == 0) {
+			pos++;
+		}
+	}
+
+	if (stream_in_token(stream)) {
+		ret = stream_flush(stream, end);
+		if (ret < 0) {
+			stream->state = STREAM_ERROR;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int json_stream_finish(struct json_stream *stream)
+{
+	int ret;
+
+	if (stream->state == STREAM_NUMBER && stream->depth == 0) {
+		stream->tok = stream->buf + stream->buf_len;
+		ret = stream_number_end(stream, stream->tok);
+		if (ret < 0) {
+			stream->state = STREAM_ERROR;
+			return ret;
+		}
+	}
 
-	errno = 0;
-	*num = strtol(token->start, &endptr, 10);
+	return (stream->state == STREAM_DONE) ? 0 : -EINVAL;
+}
 
-	*token->end = prev_end;
+/*
+ * Locate the descriptor and the storage of a value starting in the
+ * innermost container. Returns 1 if the value is to be skipped.
+ */
+static int stream_obj_target(struct json_stream_obj *obj,
+			     const struct json_obj_descr **descr,
+			     void **field)
+{
+	struct json_stream_obj_frame *frame;
+	size_t *elements;
 
-	if (errno != 0) {
-		return -errno;
+	if (obj->skip) {
+		return 1;
 	}
 
-	if (endptr != token->end) {
+	/* The value decoded is an object */
+	if (obj->depth == 0) {
 		return -EINVAL;
 	}
 
+	frame = &obj->frames[obj->depth - 1];
+
+	if (frame->type == JSON_TOK_OBJECT_START) {
+		if (frame->key < 0) {
+			return 1;
+		}
+
+		*descr = &frame->descr[frame->key];
+		*field = (char *)frame->field + (*descr)->offset;
+
+		frame->decoded |= BIT(frame->key);
+		frame->key = -1;
+
+		return 0;
+	}
+
+	elements = (size_t *)((char *)frame->val + frame->descr->offset);
+	if (*elements == frame->descr_len) {
+		return -ENOSPC;
+	}
+
+	*descr = frame->descr;
+	*field = (char *)frame->field + *elements * get_elem_size(*descr);
+	(*elements)++;
+
 	return 0;
 }
 
-static bool equivalent_types(enum json_tokens type1, enum json_tokens type2)
+static void stream_obj_push(struct json_stream_obj *obj,
+			    const struct json_obj_descr *descr,
+			    size_t descr_len, void *field, void *val,
+			    enum json_tokens type)
 {
-	if (type1 == JSON_TOK_TRUE || type1 == JSON_TOK_FALSE) {
-		return type2 == JSON_TOK_TRUE || type2 == JSON_TOK_FALSE;
+	struct json_stream_obj_frame *frame = &obj->frames[obj->depth++];
+
+	frame->descr = descr;
+	frame->descr_len = descr_len;
+	frame->field = field;
+	frame->val = val;
+	frame->decoded = 0;
+	frame->key = -1;
+	frame->type = type;
+}
+
+static int stream_obj_object_start(void *user_data)
+{
+	struct json_stream_obj *obj = user_data;
+	const struct json_obj_descr *descr;
+	void *field;
+	int ret;
+
+	if (obj->depth == 0) {
+		stream_obj_push(obj, obj->frames[0].descr,
+				obj->frames[0].descr_len, obj->frames[0].field,
+				obj->frames[0].field, JSON_TOK_OBJECT_START);
+		return 0;
 	}
 
-	return type1 == type2;
-}
+	ret = stream_obj_target(obj, &descr, &field);
+	if (ret != 0) {
+		obj->skip += (ret > 0);
+		return (ret < 0) ? ret : 0;
+	}
 
-static int obj_parse(struct json_obj *obj,
-		     const struct json_obj_descr *descr, size_t descr_len,
-		     void *val);
-static int arr_parse(struct json_obj *obj,
-		     const struct json_obj_descr *elem_descr,
-		     size_t max_elements, void *field, void *val);
+	if (descr->type != JSON_TOK_OBJECT_START) {
+		return -EINVAL;
+	}
 
-static int decode_value(struct json_obj *obj,
-			const struct json_obj_descr *descr,
-			struct token *value, void *field, void *val)
+	stream_obj_push(obj, descr->object.sub_descr,
+			descr->object.sub_descr_len, field, field,
+			JSON_TOK_OBJECT_START);
+
+	return 0;
+}
+
+static int stream_obj_array_start(void *user_data)
 {
+	struct json_stream_obj *obj = user_data;
+	struct json_stream_obj_frame *parent;
+	const struct json_obj_descr *descr;
+	void *field;
+	void *val;
+	int ret;
 
-	if (!equivalent_types(value->type, descr->type)) {
+	if (obj->depth == 0) {
 		return -EINVAL;
 	}
 
-	switch (descr->type) {
-	case JSON_TOK_OBJECT_START:
-		return obj_parse(obj, descr->object.sub_descr,
-				 descr->object.sub_descr_len,
-				 field);
-	case JSON_TOK_LIST_START:
-		return arr_parse(obj, descr->array.element_descr,
-				 descr->array.n_elements, field, val);
-	case JSON_TOK_FALSE:
-	case JSON_TOK_TRUE: {
-		bool *v = field;
-
-		*v = value->type == JSON_TOK_TRUE;
+	parent = &obj->frames[obj->depth - 1];
 
-		return 0;
+	ret = stream_obj_target(obj, &descr, &field);
+	if (ret != 0) {
+		obj->skip += (ret > 0);
+		return (ret < 0) ? ret : 0;
 	}
-	case JSON_TOK_NUMBER: {
-		s32_t *num = field;
 
-		return decode_num(value, num);
+	if (descr->type != JSON_TOK_LIST_START) {
+		return -EINVAL;
 	}
-	case JSON_TOK_STRING: {
-		char **str = field;
 
-		*value->end = '\0';
-		*str = value->start;
+	/* The number of elements is stored next to the outermost array */
+	val = (parent->type == JSON_TOK_OBJECT_START) ?
+	      parent->field : parent->val;
+
+	stream_obj_push(obj, descr->array.element_descr,
+			descr->array.n_elements, field, val,
+			JSON_TOK_LIST_START);
+
+	*(size_t *)((char *)val + descr->array.element_descr->offset) = 0;
+
+	return 0;
+}
+
+static int stream_obj_end(void *user_data)
+{
+	struct json_stream_obj *obj = user_data;
 
+	if (obj->skip) {
+		obj->skip--;
 		return 0;
 	}
-	default:
-		return -EINVAL;
+
+	obj->depth--;
+	if (obj->depth == 0) {
+		obj->ret = obj->frames[0].decoded;
 	}
+
+	return 0;
 }
 
-static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
+static int stream_obj_key(const char *key, size_t len, void *user_data)
 {
-	switch (descr->type) {
-	case JSON_TOK_NUMBER:
-		return sizeof(s32_t);
-	case JSON_TOK_STRING:
-		return sizeof(char *);
-	case JSON_TOK_TRUE:
-	case JSON_TOK_FALSE:
-		return sizeof(bool);
-	case JSON_TOK_LIST_START:
-		return descr->array.n_elements * get_elem_size(descr->array.element_descr);
-	case JSON_TOK_OBJECT_START: {
-		ptrdiff_t total = 0;
-		size_t i;
+	struct json_stream_obj *obj = user_data;
+	struct json_stream_obj_frame *frame = &obj->frames[obj->depth - 1];
+	size_t i;
 
-		for (i = 0; i < descr->object.sub_descr_len; i++) {
-			ptrdiff_t s = get_elem_size(&descr->object.sub_descr[i]);
+	if (obj->skip) {
+		return 0;
+	}
 
-			total += ROUND_UP(s, descr->alignment + 1);
+	for (i = 0; i < frame->descr_len; i++) {
+		/* Field has been decoded already, skip */
+		if (frame->decoded & BIT(i)) {
+			continue;
 		}
 
-		return total;
-	}
-	default:
-		return -EINVAL;
+		if (len == frame->descr[i].field_name_len &&
+		    !memcmp(key, frame->descr[i].field_name, len)) {
+			frame->key = i;
+			return 0;
+		}
 	}
+
+	frame->key = -1;
+
+	return 0;
 }
 
-static int arr_parse(struct json_obj *obj,
-		     const struct json_obj_descr *elem_descr,
-		     size_t max_elements, void *field, void *val)
+static int stream_obj_string(const char *str, size_t len, void *user_data)
 {
-	ptrdiff_t elem_size = get_elem_size(elem_descr);
-	void *last_elem = (char *)field + elem_size * max_elements;
-	size_t *elements = (size_t *)((char *)val + elem_descr->offset);
-	struct token value;
+	struct json_stream_obj *obj = user_data;
+	const struct json_obj_descr *descr;
+	char *copy = obj->buf + obj->buf_used;
+	void *field;
+	int ret;
 
-	assert(elem_size > 0);
+	ret = stream_obj_target(obj, &descr, &field);
+	if (ret != 0) {
+		return (ret < 0) ? ret : 0;
+	}
 
-	*elements = 0;
+	if (descr->type != JSON_TOK_STRING) {
+		return -EINVAL;
+	}
 
-	while (!arr_next(obj, &value)) {
-		if (value.type == JSON_TOK_LIST_END) {
-			return 0;
-		}
+	if (len >= obj->buf_size - obj->buf_used) {
+		return -ENOMEM;
+	}
 
-		if (field == last_elem) {
-			return -ENOSPC;
-		}
+	/* A string spanning chunks is already in place */
+	memmove(copy, str, len);
+	copy[len] = '\0';
+	*(char **)field = copy;
 
-		if (decode_value(obj, elem_descr, &value, field, val) < 0) {
-			return -EINVAL;
-		}
+	/* The tokenizer uses the rest of the buffer */
+	obj->buf_used += len + 1;
+	obj->stream.buf = obj->buf + obj->buf_used;
+	obj->stream.buf_size = obj->buf_size - obj->buf_used;
 
-		(*elements)++;
-		field = (char *)field + elem_size;
+	return 0;
+}
+
+static int stream_obj_number(const char *num, size_t len, void *user_data)
+{
+	struct json_stream_obj *obj = user_data;
+	const struct json_obj_descr *descr;
+	void *field;
+	int ret;
+
+	ret = stream_obj_target(obj, &descr, &field);
+	if (ret != 0) {
+		return (ret < 0) ? ret : 0;
 	}
 
-	return -EINVAL;
+	return decode_num(descr, num, len, field);
 }
 
-static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
-		     size_t descr_len, void *val)
+static int stream_obj_boolean(bool value, void *user_data)
 {
-	struct json_obj_key_value kv;
-	s32_t decoded_fields = 0;
-	size_t i;
+	struct json_stream_obj *obj = user_data;
+	const struct json_obj_descr *descr;
+	void *field;
 	int ret;
 
-	while (!obj_next(obj, &kv)) {
-		if (kv.value.type == JSON_TOK_OBJECT_END) {
-			return decoded_fields;
-		}
+	ret = stream_obj_target(obj, &descr, &field);
+	if (ret != 0) {
+		return (ret < 0) ? ret : 0;
+	}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
+	if (!equivalent_types(JSON_TOK_TRUE, descr->type)) {
+		return -EINVAL;
+	}
 
-			/* Field has been decoded already, skip */
-			if (decoded_fields & (1 << i)) {
-				continue;
-			}
+	*(bool *)field = value;
 
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
+	return 0;
+}
 
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
+static int stream_obj_null(void *user_data)
+{
+	struct json_stream_obj *obj = user_data;
+	struct json_stream_obj_frame *frame;
 
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
-			if (ret < 0) {
-				return ret;
-			}
+	if (obj->skip) {
+		return 0;
+	}
 
-			decoded_fields |= 1<<i;
-			break;
-		}
+	if (obj->depth == 0) {
+		return -EINVAL;
 	}
 
-	return -EINVAL;
+	frame = &obj->frames[obj->depth - 1];
+
+	/* The field is left undecoded, an array element has no default */
+	if (frame->type == JSON_TOK_LIST_START) {
+		return -EINVAL;
+	}
+
+	frame->key = -1;
+
+	return 0;
 }
 
-int json_obj_parse(char *payload, size_t len,
-		   const struct json_obj_descr *descr, size_t descr_len,
-		   void *val)
+static const struct json_stream_cb stream_obj_cb = {
+	.object_start = stream_obj_object_start,
+	.object_end = stream_obj_end,
+	.array_start = stream_obj_array_start,
+	.array_end = stream_obj_end,
+	.key = stream_obj_key,
+	.string = stream_obj_string,
+	.number = stream_obj_number,
+	.boolean = stream_obj_boolean,
+	.null = stream_obj_null,
+};
+
+void json_stream_obj_init(struct json_stream_obj *obj,
+			  const struct json_obj_descr *descr,
+			  size_t descr_len, void *val,
+			  char *buf, size_t buf_size)
 {
-	struct json_obj obj;
-	int ret;
+	assert(descr_len < (sizeof(obj->ret) * CHAR_BIT - 1));
 
-	assert(descr_len < (sizeof(ret) * CHAR_BIT - 1));
+	(void)memset(obj, 0, sizeof(*obj));
 
-	ret = obj_init(&obj, payload, len);
+	json_stream_init(&obj->stream, &stream_obj_cb, obj, buf, buf_size);
+
+	obj->buf = buf;
+	obj->buf_size = buf_size;
+	obj->ret = -EINVAL;
+
+	/* Pushed when the object starts */
+	obj->frames[0].descr = descr;
+	obj->frames[0].descr_len = descr_len;
+	obj->frames[0].field = val;
+}
+
+int json_stream_obj_feed(struct json_stream_obj *obj, const char *data,
+			 size_t len)
+{
+	return json_stream_feed(&obj->stream, data, len);
+}
+
+int json_stream_obj_finish(struct json_stream_obj *obj)
+{
+	int ret;
+
+	ret = json_stream_finish(&obj->stream);
 	if (ret < 0) {
 		return ret;
 	}
 
-	return obj_parse(&obj, descr, descr_len, val);
+	return obj->ret;
 }
 
 static char escape_as(char chr)
@@ -790,6 +1718,119 @@ static int num_encode(const s32_t *num, json_append_bytes_t append_bytes,
 	return append_bytes(buf, (size_t)ret, data);
 }
 
+static int int64_encode(const s64_t *num, json_append_bytes_t append_bytes,
+			void *data)
+{
+	char buf[3 * sizeof(s64_t)];
+	int ret;
+
+	ret = snprintk(buf, sizeof(buf), "%lld", (long long)*num);
+	if (ret < 0) {
+		return ret;
+	}
+	if (ret >= (int)sizeof(buf)) {
+		return -ENOMEM;
+	}
+
+	return append_bytes(buf, (size_t)ret, data);
+}
+
+/*
+ * Numbers are written with 15 significant digits, in fixed notation for
+ * decimal exponents from -5 to 14 and in exponential notation otherwise.
+ */
+static int float_encode(const double *num, json_append_bytes_t append_bytes,
+			void *data)
+{
+	char digits[15];
+	char buf[32];
+	double value = *num;
+	double scaled;
+	u64_t mantissa;
+	int exp10 = 0;
+	int len = 0;
+	int n, i;
+
+	/* NaN and infinities have no JSON representation */
+	if (value != value || value > DBL_MAX || value < -DBL_MAX) {
+		return -EINVAL;
+	}
+
+	if (value == 0.0) {
+		return append_bytes("0", 1, data);
+	}
+
+	if (value < 0.0) {
+		buf[len++] = '-';
+		value = -value;
+	}
+
+	/* Decimal exponent of the leading digit */
+	for (i = ARRAY_SIZE(pow10_table) - 1; i >= 0; i--) {
+		if (value >= 1.0) {
+			if (value >= scale_pow10(1.0, exp10 + (1 << i))) {
+				exp10 += 1 << i;
+			}
+		} else if (value < scale_pow10(1.0, exp10 - (1 << i))) {
+			exp10 -= 1 << i;
+		}
+	}
+
+	if (value < 1.0) {
+		exp10--;
+	}
+
+	scaled = scale_pow10(value, 14 - exp10);
+	if (scaled < 1e14) {
+		scaled *= 10.0;
+		exp10--;
+	}
+
+	mantissa = (u64_t)(scaled + 0.5);
+	if (mantissa >= 1000000000000000ULL) {
+		mantissa /= 10U;
+		exp10++;
+	}
+
+	for (i = ARRAY_SIZE(digits) - 1; i >= 0; i--) {
+		digits[i] = '0' + (char)(mantissa % 10U);
+		mantissa /= 10U;
+	}
+
+	for (n = ARRAY_SIZE(digits); n > 1 && digits[n - 1] == '0'; n--) {
+	}
+
+	if (exp10 < -5 || exp10 >= 15) {
+		buf[len++] = digits[0];
+		if (n > 1) {
+			buf[len++] = '.';
+			memcpy(&buf[len], &digits[1], n - 1);
+			len += n - 1;
+		}
+
+		len += snprintk(&buf[len], sizeof(buf) - len, "e%d", exp10);
+	} else if (exp10 < 0) {
+		buf[len++] = '0';
+		buf[len++] = '.';
+		for (i = -1; i > exp10; i--) {
+			buf[len++] = '0';
+		}
+
+		memcpy(&buf[len], digits, n);
+		len += n;
+	} else {
+		for (i = 0; i <= exp10 || i < n; i++) {
+			if (i == exp10 + 1) {
+				buf[len++] = '.';
+			}
+
+			buf[len++] = (i < n) ? digits[i] : '0';
+		}
+	}
+
+	return append_bytes(buf, (size_t)len, data);
+}
+
 static int bool_encode(const bool *value, json_append_bytes_t append_bytes,
 		       void *data)
 {
@@ -820,6 +1861,10 @@ static int encode(const struct json_obj_descr *descr, const void *val,
 				       ptr, append_bytes, data);
 	case JSON_TOK_NUMBER:
 		return num_encode(ptr, append_bytes, data);
+	case JSON_TOK_INT64:
+		return int64_encode(ptr, append_bytes, data);
+	case JSON_TOK_FLOAT:
+		return float_encode(ptr, append_bytes, data);
 	default:
 		return -EINVAL;
 	}
@@ -10,6 +10,9 @@
 #include <misc/mempool_base.h>
 #include <misc/mempool.h>
 
+/* The TLSF backend in mempool_tlsf.c provides the block functions */
+#ifndef CONFIG_SYS_MEM_POOL_TLSF
+
 #ifdef CONFIG_MISRA_SANE
 #define LVL_ARRAY_SZ(n) (8 * sizeof(void *) / 2)
 #else
@@ -323,6 +326,8 @@ void z_sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 	block_free(p, level, lsizes, block);
 }
 
+#endif /* !CONFIG_SYS_MEM_POOL_TLSF */
+
 /*
  * Functions specific to user-mode blocks
  */
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * Two-level segregated fit (TLSF) backend for k_mem_pool and sys_mem_pool.
+ *
+ * The pool buffer is managed as one heap of variable sized blocks.  Free
+ * blocks are kept in segregated lists: the first level index is the power
+ * of two of the block size, the second level splits each power of two into
+ * Z_TLSF_SL_COUNT equal ranges.  Two bitmaps tell which lists are not
+ * empty, so finding a suitable block, splitting it and coalescing a freed
+ * block with its physical neighbours are all constant time.
+ *
+ * Every block starts with a header holding the address of the previous
+ * block in memory and the size of the block (including the header), with
+ * the "free" and "previous is free" flags in the low bits.  Free blocks
+ * also hold their free list links.  A used sentinel header at the end of
+ * the heap terminates the chain.
+ *
+ * The block id (level/block pair) handed out to the caller encodes the
+ * offset of the block in the heap, in units of the block alignment.
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <misc/__assert.h>
+#include <misc/mempool_base.h>
+#include <misc/mempool.h>
+
+#define ALIGN		BIT(Z_TLSF_ALIGN_SHIFT)
+#define SL_COUNT	Z_TLSF_SL_COUNT
+#define SMALL_SIZE	BIT(Z_TLSF_SMALL_SHIFT)
+
+#define BLOCK_FREE	BIT(0)
+#define PREV_FREE	BIT(1)
+#define SIZE_MASK	(~(size_t)(ALIGN - 1))
+
+/* Bits of the block id: level:4 and block:20 */
+#define ID_BLOCK_BITS	20
+#define ID_MAX_OFFSET	BIT(4 + ID_BLOCK_BITS)
+
+struct tlsf_block {
+	struct tlsf_block *prev_phys;
+	size_t size;
+
+	/* only valid in free blocks */
+	struct tlsf_block *next_free;
+	struct tlsf_block *prev_free;
+};
+
+#define HDR_SIZE	ROUND_UP(offsetof(struct tlsf_block, next_free), ALIGN)
+#define MIN_BLOCK	ROUND_UP(sizeof(struct tlsf_block), ALIGN)
+
+/* Control data lives right after the buffer, fl_count is kept in
+ * n_levels.
+ */
+static struct tlsf_block **heads(struct sys_mem_pool_base *p)
+{
+	size_t buflen = p->n_max * p->max_sz;
+
+	return (struct tlsf_block **)ROUND_UP((u8_t *)p->buf + buflen,
+					      sizeof(void *));
+}
+
+static u32_t *bitmaps(struct sys_mem_pool_base *p)
+{
+	return (u32_t *)(heads(p) + p->n_levels * SL_COUNT);
+}
+
+static u8_t *heap_start(struct sys_mem_pool_base *p)
+{
+	return (u8_t *)ROUND_UP(p->buf, ALIGN);
+}
+
+static inline size_t block_size(struct tlsf_block *b)
+{
+	return b->size & SIZE_MASK;
+}
+
+static inline struct tlsf_block *next_phys(struct tlsf_block *b)
+{
+	return (struct tlsf_block *)((u8_t *)b + block_size(b));
+}
+
+static inline int fls32(u32_t x)
+{
+	return 31 - __builtin_clz(x);
+}
+
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+	if (size < SMALL_SIZE) {
+		*fl = 0;
+		*sl = size >> Z_TLSF_ALIGN_SHIFT;
+	} else {
+		int f = fls32(size);
+
+		*sl = (size >> (f - CONFIG_SYS_MEM_POOL_TLSF_SL_BITS)) ^
+		      SL_COUNT;
+		*fl = f - Z_TLSF_SMALL_SHIFT + 1;
+	}
+}
+
+/* Round up to the next list boundary, so that any block of the list
+ * found is large enough.
+ */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+	if (size >= SMALL_SIZE) {
+		size += BIT(fls32(size) - CONFIG_SYS_MEM_POOL_TLSF_SL_BITS) - 1;
+	}
+
+	mapping_insert(size, fl, sl);
+}
+
+static void insert_free(struct sys_mem_pool_base *p, struct tlsf_block *b)
+{
+	struct tlsf_block **head;
+	u32_t *bits = bitmaps(p);
+	int fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	head = &heads(p)[fl * SL_COUNT + sl];
+
+	b->prev_free = NULL;
+	b->next_free = *head;
+	if (*head != NULL) {
+		(*head)->prev_free = b;
+	}
+	*head = b;
+
+	bits[0] |= BIT(fl);
+	bits[1 + fl] |= BIT(sl);
+}
+
+static void remove_free(struct sys_mem_pool_base *p, struct tlsf_block *b)
+{
+	u32_t *bits = bitmaps(p);
+	int fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+
+	if (b->next_free != NULL) {
+		b->next_free->prev_free = b->prev_free;
+	}
+
+	if (b->prev_free != NULL) {
+		b->prev_free->next_free = b->next_free;
+	} else {
+		struct tlsf_block **head = &heads(p)[fl * SL_COUNT + sl];
+
+		*head = b->next_free;
+		if (*head == NULL) {
+			bits[1 + fl] &= ~BIT(sl);
+			if (bits[1 + fl] == 0U) {
+				bits[0] &= ~BIT(fl);
+			}
+		}
+	}
+}
+
+/* When no list is guaranteed to fit, the head of the list the size
+ * itself maps to might still be large enough: checking it keeps large
+ * requests close to the heap size satisfiable.
+ */
+static struct tlsf_block *find_in_own_list(struct sys_mem_pool_base *p,
+					   size_t size)
+{
+	struct tlsf_block *b;
+	int fl, sl;
+
+	mapping_insert(size, &fl, &sl);
+	if (fl >= p->n_levels) {
+		return NULL;
+	}
+
+	b = heads(p)[fl * SL_COUNT + sl];
+	if (b != NULL && block_size(b) >= size) {
+		return b;
+	}
+
+	return NULL;
+}
+
+static struct tlsf_block *find_suitable(struct sys_mem_pool_base *p,
+					size_t size)
+{
+	u32_t *bits = bitmaps(p);
+	u32_t sl_map, fl_map;
+	int fl, sl;
+
+	mapping_search(size, &fl, &sl);
+	if (fl >= p->n_levels) {
+		return find_in_own_list(p, size);
+	}
+
+	sl_map = bits[1 + fl] & (~0U << sl);
+	if (sl_map == 0U) {
+		fl_map = (fl + 1 < 32) ? (bits[0] & (~0U << (fl + 1))) : 0U;
+		if (fl_map == 0U) {
+			return find_in_own_list(p, size);
+		}
+
+		fl = __builtin_ctz(fl_map);
+		sl_map = bits[1 + fl];
+	}
+
+	sl = __builtin_ctz(sl_map);
+
+	return heads(p)[fl * SL_COUNT + sl];
+}
+
+void z_sys_mem_pool_base_init(struct sys_mem_pool_base *p)
+{
+	size_t buflen = p->n_max * p->max_sz;
+	u8_t *start = heap_start(p);
+	u8_t *end = (u8_t *)ROUND_DOWN((u8_t *)p->buf + buflen, ALIGN);
+	struct tlsf_block *b, *sentinel;
+	int fl_count = 1;
+
+	/* Same computation as Z_TLSF_FL_COUNT() */
+	for (int l = 0; l <= 20; l++) {
+		if ((buflen >> (l + Z_TLSF_SMALL_SHIFT)) != 0U) {
+			fl_count++;
+		}
+	}
+
+	__ASSERT((size_t)(end - start) < ID_MAX_OFFSET * ALIGN,
+		 "pool too large");
+	__ASSERT((size_t)(end - start) >= MIN_BLOCK + HDR_SIZE,
+		 "pool too small");
+	__ASSERT(fl_count <= 32, "");
+
+	p->n_levels = fl_count;
+	p->max_inline_level = -1;
+	(void)memset(heads(p), 0,
+		     sizeof(void *) * fl_count * SL_COUNT +
+		     sizeof(u32_t) * (fl_count + 1));
+
+	b = (struct tlsf_block *)start;
+	sentinel = (struct tlsf_block *)(end - HDR_SIZE);
+
+	b->prev_phys = NULL;
+	b->size = ((u8_t *)sentinel - start) | BLOCK_FREE;
+	sentinel->prev_phys = b;
+	sentinel->size = PREV_FREE;
+
+	insert_free(p, b);
+}
+
+/* For k_mem_pools which are interrupt safe, every operation is constant
+ * time and short, so it is done with interrupts locked all along.  As
+ * with the buddy backend, sys_mem_pools are protected by their mutex.
+ */
+static inline int pool_irq_lock(struct sys_mem_pool_base *p)
+{
+	if (p->flags & SYS_MEM_POOL_KERNEL) {
+		return irq_lock();
+	} else {
+		return 0;
+	}
+}
+
+static inline void pool_irq_unlock(struct sys_mem_pool_base *p, int key)
+{
+	if (p->flags & SYS_MEM_POOL_KERNEL) {
+		irq_unlock(key);
+	}
+}
+
+int z_sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
+			      u32_t *level_p, u32_t *block_p, void **data_p)
+{
+	struct tlsf_block *b, *rest;
+	size_t need, have;
+	unsigned int key;
+	u32_t offset;
+
+	if (size > (p->n_max * p->max_sz)) {
+		*data_p = NULL;
+		return -ENOMEM;
+	}
+
+	need = MAX(ROUND_UP(size + HDR_SIZE, ALIGN), MIN_BLOCK);
+
+	key = pool_irq_lock(p);
+
+	b = find_suitable(p, need);
+	if (b == NULL) {
+		pool_irq_unlock(p, key);
+		*data_p = NULL;
+		return -ENOMEM;
+	}
+
+	remove_free(p, b);
+	have = block_size(b);
+
+	if (have - need >= MIN_BLOCK) {
+		/* split, the remainder stays free */
+		rest = (struct tlsf_block *)((u8_t *)b + need);
+		rest->prev_phys = b;
+		rest->size = (have - need) | BLOCK_FREE;
+		next_phys(rest)->prev_phys = rest;
+		insert_free(p, rest);
+
+		b->size = need | (b->size & PREV_FREE);
+	} else {
+		b->size &= ~BLOCK_FREE;
+		next_phys(b)->size &= ~PREV_FREE;
+	}
+
+	pool_irq_unlock(p, key);
+
+	offset = ((u8_t *)b - heap_start(p)) >> Z_TLSF_ALIGN_SHIFT;
+	*level_p = offset >> ID_BLOCK_BITS;
+	*block_p = offset & (BIT(ID_BLOCK_BITS) - 1);
+	*data_p = (u8_t *)b + HDR_SIZE;
+
+	return 0;
+}
+
+void z_sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
+			      u32_t block)
+{
+	u32_t offset = (level << ID_BLOCK_BITS) | block;
+	struct tlsf_block *b, *next;
+	unsigned int key;
+
+	b = (struct tlsf_block *)(heap_start(p) +
+				  (offset << Z_TLSF_ALIGN_SHIFT));
+
+	key = pool_irq_lock(p);
+
+	__ASSERT((b->size & BLOCK_FREE) == 0U, "double free");
+
+	if ((b->size & PREV_FREE) != 0U) {
+		struct tlsf_block *prev = b->prev_phys;
+
+		remove_free(p, prev);
+		prev->size += block_size(b);
+		b = prev;
+	}
+
+	next = next_phys(b);
+	if ((next->size & BLOCK_FREE) != 0U) {
+		remove_free(p, next);
+		b->size += block_size(next);
+		next = next_phys(b);
+	}
+
+	b->size |= BLOCK_FREE;
+	next->prev_phys = b;
+	next->size |= PREV_FREE;
+	insert_free(p, b);
+
+	pool_irq_unlock(p, key);
+}
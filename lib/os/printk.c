@@ -14,6 +14,7 @@
 
 #include <kernel.h>
 #include <misc/printk.h>
+#include <misc/cbprintf.h>
 #include <stdarg.h>
 #include <toolchain.h>
 #include <linker/sections.h>
@@ -22,20 +23,6 @@
 
 typedef int (*out_func_t)(int c, void *ctx);
 
-enum pad_type {
-	PAD_NONE,
-	PAD_ZERO_BEFORE,
-	PAD_SPACE_BEFORE,
-	PAD_SPACE_AFTER,
-};
-
-static void _printk_dec_ulong(out_func_t out, void *ctx,
-			      const unsigned long num, enum pad_type padding,
-			      int min_width);
-static void _printk_hex_ulong(out_func_t out, void *ctx,
-			      const unsigned long long num, enum pad_type padding,
-			      int min_width);
-
 /**
  * @brief Default character output routine that does nothing
  * @param c Character to swallow
@@ -82,13 +69,6 @@ void *__printk_get_hook(void)
 	return _char_out;
 }
 
-static void print_err(out_func_t out, void *ctx)
-{
-	out('E', ctx);
-	out('R', ctx);
-	out('R', ctx);
-}
-
 /**
  * @brief Printk internals
  *
@@ -100,175 +80,7 @@ static void print_err(out_func_t out, void *ctx)
  */
 void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 {
-	int might_format = 0; /* 1 if encountered a '%' */
-	enum pad_type padding = PAD_NONE;
-	int min_width = -1;
-	int long_ctr = 0;
-
-	/* fmt has already been adjusted if needed */
-
-	while (*fmt) {
-		if (!might_format) {
-			if (*fmt != '%') {
-				out((int)*fmt, ctx);
-			} else {
-				might_format = 1;
-				min_width = -1;
-				padding = PAD_NONE;
-				long_ctr = 0;
-			}
-		} else {
-			switch (*fmt) {
-			case '-':
-				padding = PAD_SPACE_AFTER;
-				goto still_might_format;
-			case '0':
-				if (min_width < 0 && padding == PAD_NONE) {
-					padding = PAD_ZERO_BEFORE;
-					goto still_might_format;
-				}
-				/* Fall through */
-			case '1':
-			case '2':
-			case '3':
-			case '4':
-			case '5':
-			case '6':
-			case '7':
-			case '8':
-				/* Fall through */
-			case '9':
-				if (min_width < 0) {
-					min_width = *fmt - '0';
-				} else {
-					min_width = 10 * min_width + *fmt - '0';
-				}
-
-				if (padding == PAD_NONE) {
-					padding = PAD_SPACE_BEFORE;
-				}
-				goto still_might_format;
-			case 'l':
-				long_ctr++;
-				/* Fall through */
-			case 'z':
-			case 'h':
-				/* FIXME: do nothing for these modifiers */
-				goto still_might_format;
-			case 'd':
-			case 'i': {
-				s32_t d;
-
-				if (long_ctr == 0) {
-					d = va_arg(ap, int);
-				} else if (long_ctr == 1) {
-					long ld = va_arg(ap, long);
-					if (ld > INT32_MAX || ld < INT32_MIN) {
-						print_err(out, ctx);
-						break;
-					}
-					d = (s32_t)ld;
-				} else {
-					long long lld = va_arg(ap, long long);
-					if (lld > INT32_MAX ||
-					    lld < INT32_MIN) {
-						print_err(out, ctx);
-						break;
-					}
-					d = (s32_t)lld;
-				}
-
-				if (d < 0) {
-					out((int)'-', ctx);
-					d = -d;
-					min_width--;
-				}
-				_printk_dec_ulong(out, ctx, d, padding,
-						  min_width);
-				break;
-			}
-			case 'u': {
-				u32_t u;
-
-				if (long_ctr == 0) {
-					u = va_arg(ap, unsigned int);
-				} else if (long_ctr == 1) {
-					long lu = va_arg(ap, unsigned long);
-					if (lu > INT32_MAX) {
-						print_err(out, ctx);
-						break;
-					}
-					u = (u32_t)lu;
-				} else {
-					unsigned long long llu =
-						va_arg(ap, unsigned long long);
-					if (llu > INT32_MAX) {
-						print_err(out, ctx);
-						break;
-					}
-					u = (u32_t)llu;
-				}
-
-				_printk_dec_ulong(out, ctx, u, padding,
-						  min_width);
-				break;
-			}
-			case 'p':
-				  out('0', ctx);
-				  out('x', ctx);
-				  /* left-pad pointers with zeros */
-				  padding = PAD_ZERO_BEFORE;
-				  min_width = 8;
-				  /* Fall through */
-			case 'x':
-			case 'X': {
-				unsigned long long x;
-
-				if (long_ctr < 2) {
-					x = va_arg(ap, unsigned long);
-				} else {
-					x = va_arg(ap, unsigned long long);
-				}
-
-				_printk_hex_ulong(out, ctx, x, padding,
-						  min_width);
-				break;
-			}
-			case 's': {
-				char *s = va_arg(ap, char *);
-				char *start = s;
-
-				while (*s)
-					out((int)(*s++), ctx);
-
-				if (padding == PAD_SPACE_AFTER) {
-					int remaining = min_width - (s - start);
-					while (remaining-- > 0) {
-						out(' ', ctx);
-					}
-				}
-				break;
-			}
-			case 'c': {
-				int c = va_arg(ap, int);
-
-				out(c, ctx);
-				break;
-			}
-			case '%': {
-				out((int)'%', ctx);
-				break;
-			}
-			default:
-				out((int)'%', ctx);
-				out((int)*fmt, ctx);
-				break;
-			}
-			might_format = 0;
-		}
-still_might_format:
-		++fmt;
-	}
+	(void)cbvprintf(out, ctx, fmt, ap);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -387,101 +199,6 @@ void printk(const char *fmt, ...)
 	va_end(ap);
 }
 
-/**
- * @brief Output an unsigned long long in hex format
- *
- * Output an unsigned long long on output installed by platform at init time.
- * Able to print full 64-bit values.
- * @param num Number to output
- *
- * @return N/A
- */
-static void _printk_hex_ulong(out_func_t out, void *ctx,
-			      const unsigned long long num,
-			      enum pad_type padding,
-			      int min_width)
-{
-	int size = sizeof(num) * 2;
-	int found_largest_digit = 0;
-	int remaining = 16; /* 16 digits max */
-	int digits = 0;
-
-	for (; size != 0; size--) {
-		char nibble = (num >> ((size - 1) << 2) & 0xf);
-
-		if (nibble != 0 || found_largest_digit != 0 || size == 1) {
-			found_largest_digit = 1;
-			nibble += nibble > 9 ? 87 : 48;
-			out((int)nibble, ctx);
-			digits++;
-			continue;
-		}
-
-		if (remaining-- <= min_width) {
-			if (padding == PAD_ZERO_BEFORE) {
-				out('0', ctx);
-			} else if (padding == PAD_SPACE_BEFORE) {
-				out(' ', ctx);
-			}
-		}
-	}
-
-	if (padding == PAD_SPACE_AFTER) {
-		remaining = min_width * 2 - digits;
-		while (remaining-- > 0) {
-			out(' ', ctx);
-		}
-	}
-}
-
-/**
- * @brief Output an unsigned long (32-bit) in decimal format
- *
- * Output an unsigned long on output installed by platform at init time. Only
- * works with 32-bit values.
- * @param num Number to output
- *
- * @return N/A
- */
-static void _printk_dec_ulong(out_func_t out, void *ctx,
-			      const unsigned long num, enum pad_type padding,
-			      int min_width)
-{
-	unsigned long pos = 999999999;
-	unsigned long remainder = num;
-	int found_largest_digit = 0;
-	int remaining = 10; /* 10 digits max */
-	int digits = 1;
-
-	/* make sure we don't skip if value is zero */
-	if (min_width <= 0) {
-		min_width = 1;
-	}
-
-	while (pos >= 9) {
-		if (found_largest_digit != 0 || remainder > pos) {
-			found_largest_digit = 1;
-			out((int)((remainder / (pos + 1)) + 48), ctx);
-			digits++;
-		} else if (remaining <= min_width
-				&& padding < PAD_SPACE_AFTER) {
-			out((int)(padding == PAD_ZERO_BEFORE ? '0' : ' '), ctx);
-			digits++;
-		}
-		remaining--;
-		remainder %= (pos + 1);
-		pos /= 10;
-	}
-	out((int)(remainder + 48), ctx);
-
-	if (padding == PAD_SPACE_AFTER) {
-		remaining = min_width - digits;
-		while (remaining-- > 0) {
-			out(' ', ctx);
-		}
-	}
-}
-
 struct str_context {
 	char *str;
 	int max;
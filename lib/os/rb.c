@@ -220,11 +220,17 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
 
 	if (tree->root == NULL) {
 		tree->root = node;
+		tree->min = node;
 		tree->max_depth = 1;
 		set_color(node, BLACK);
 		return;
 	}
 
+	/* Rotations keep the order, only a new leftmost node moves it */
+	if (tree->lessthan_fn(node, tree->min)) {
+		tree->min = node;
+	}
+
 #ifdef CONFIG_MISRA_SANE
 	struct rbnode **stack = &tree->iter_stack[0];
 #else
@@ -377,6 +383,21 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 		return;
 	}
 
+	/* The leftmost node has no left child, its successor is the
+	 * leftmost node of its right subtree, or else its parent.
+	 */
+	if (node == tree->min) {
+		tmp = get_child(node, 1);
+		if (tmp != NULL) {
+			while (get_child(tmp, 0) != NULL) {
+				tmp = get_child(tmp, 0);
+			}
+			tree->min = tmp;
+		} else {
+			tree->min = stacksz > 1 ? stack[stacksz - 2] : NULL;
+		}
+	}
+
 	/* We can only remove a node with zero or one child, if we
 	 * have two then pick the "biggest" child of side 0 (smallest
 	 * of 1 would work too) and swap our spot in the tree with
@@ -493,6 +514,51 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 	tree->root = stack[0];
 }
 
+/* Links nodes[lo..hi) as a perfectly balanced subtree, returning its
+ * root.  The subtrees of a node differ in size by at most one, so all
+ * the leaves are at depth red_depth - 1 or red_depth: the nodes at
+ * red_depth are colored red and every path holds red_depth black
+ * nodes.
+ */
+static struct rbnode *build(struct rbnode **nodes, size_t lo, size_t hi,
+			    int depth, int red_depth)
+{
+	size_t mid = lo + (hi - lo) / 2;
+	struct rbnode *n = nodes[mid];
+
+	set_child(n, 0, mid > lo ?
+		  build(nodes, lo, mid, depth + 1, red_depth) : NULL);
+	set_child(n, 1, mid + 1 < hi ?
+		  build(nodes, mid + 1, hi, depth + 1, red_depth) : NULL);
+	set_color(n, depth == red_depth ? RED : BLACK);
+
+	return n;
+}
+
+void rb_build(struct rbtree *tree, struct rbnode **nodes, size_t count)
+{
+	int full_levels = 0;
+
+	tree->root = NULL;
+	tree->min = NULL;
+	tree->max_depth = 0;
+
+	if (count == 0) {
+		return;
+	}
+
+	/* levels completely filled: floor(log2(count + 1)) */
+	while ((count + 1) >> (full_levels + 1) != 0) {
+		full_levels++;
+	}
+
+	tree->root = build(nodes, 0, count, 0, full_levels);
+	tree->min = nodes[0];
+	/* plus the incomplete level, unless count + 1 is a power of two */
+	tree->max_depth = ((count + 1) & count) == 0 ?
+			  full_levels : full_levels + 1;
+}
+
 #ifndef CONFIG_MISRA_SANE
 void z_rb_walk(struct rbnode *node, rb_visit_t visit_fn, void *cookie)
 {
@@ -525,6 +591,50 @@ bool rb_contains(struct rbtree *tree, struct rbnode *node)
 	return n == node;
 }
 
+struct rbnode *rb_next(struct rbtree *tree, struct rbnode *node)
+{
+	struct rbnode *n = tree->root;
+	struct rbnode *next = NULL;
+
+	if (node == NULL) {
+		return tree->min;
+	}
+
+	/* The lowest node sorted after "node" on its search path */
+	while (n != NULL) {
+		if (tree->lessthan_fn(node, n)) {
+			next = n;
+			n = get_child(n, 0);
+		} else {
+			n = get_child(n, 1);
+		}
+	}
+
+	return next;
+}
+
+struct rbnode *rb_prev(struct rbtree *tree, struct rbnode *node)
+{
+	struct rbnode *n = tree->root;
+	struct rbnode *prev = NULL;
+
+	if (node == NULL) {
+		return z_rb_get_minmax(tree, 1);
+	}
+
+	/* The highest node sorted before "node" on its search path */
+	while (n != NULL) {
+		if (tree->lessthan_fn(n, node)) {
+			prev = n;
+			n = get_child(n, 1);
+		} else {
+			n = get_child(n, 0);
+		}
+	}
+
+	return prev;
+}
+
 /* Pushes the node and its chain of left-side children onto the stack
  * in the foreach struct, returning the last node, which is the next
  * node to iterate.  By construction node will always be a right child
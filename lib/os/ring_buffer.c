@@ -217,3 +217,117 @@ u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size)
 
 	return total_size;
 }
+
+/*
+ * Lock-free SPSC mode. Each side owns its index and only reads the other
+ * one: the acquire load of the other index orders the accesses to the data
+ * after it, and the release store of its own index publishes the accesses
+ * made before it.
+ */
+
+u32_t ring_buf_spsc_put_claim(struct ring_buf_spsc *rb, u8_t **data,
+			      u32_t size)
+{
+	u32_t head = __atomic_load_n(&rb->consumer.head, __ATOMIC_ACQUIRE);
+	u32_t tmp_tail = rb->producer.tmp_tail;
+	u32_t offset = tmp_tail & rb->mask;
+	u32_t space = rb->mask + 1 - (tmp_tail - head);
+
+	/* Limit allocated size to available and trail size. */
+	size = MIN(size, MIN(space, rb->mask + 1 - offset));
+
+	*data = &rb->buf[offset];
+	rb->producer.tmp_tail = tmp_tail + size;
+
+	return size;
+}
+
+int ring_buf_spsc_put_finish(struct ring_buf_spsc *rb, u32_t size)
+{
+	u32_t tail = rb->producer.tail;
+
+	if (size > ring_buf_spsc_space_get(rb)) {
+		return -EINVAL;
+	}
+
+	tail += size;
+	rb->producer.tmp_tail = tail;
+	__atomic_store_n(&rb->producer.tail, tail, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+u32_t ring_buf_spsc_put(struct ring_buf_spsc *rb, const u8_t *data,
+			u32_t size)
+{
+	u8_t *dst;
+	u32_t partial_size;
+	u32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_spsc_put_claim(rb, &dst, size);
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	err = ring_buf_spsc_put_finish(rb, total_size);
+	__ASSERT_NO_MSG(err == 0);
+
+	return total_size;
+}
+
+u32_t ring_buf_spsc_get_claim(struct ring_buf_spsc *rb, u8_t **data,
+			      u32_t size)
+{
+	u32_t tail = __atomic_load_n(&rb->producer.tail, __ATOMIC_ACQUIRE);
+	u32_t tmp_head = rb->consumer.tmp_head;
+	u32_t offset = tmp_head & rb->mask;
+
+	/* Limit granted size to available and trail size. */
+	size = MIN(size, MIN(tail - tmp_head, rb->mask + 1 - offset));
+
+	*data = &rb->buf[offset];
+	rb->consumer.tmp_head = tmp_head + size;
+
+	return size;
+}
+
+int ring_buf_spsc_get_finish(struct ring_buf_spsc *rb, u32_t size)
+{
+	u32_t tail = __atomic_load_n(&rb->producer.tail, __ATOMIC_ACQUIRE);
+	u32_t head = rb->consumer.head;
+
+	if (size > tail - head) {
+		return -EINVAL;
+	}
+
+	head += size;
+	rb->consumer.tmp_head = head;
+	__atomic_store_n(&rb->consumer.head, head, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+u32_t ring_buf_spsc_get(struct ring_buf_spsc *rb, u8_t *data, u32_t size)
+{
+	u8_t *src;
+	u32_t partial_size;
+	u32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_spsc_get_claim(rb, &src, size);
+		memcpy(data, src, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	err = ring_buf_spsc_get_finish(rb, total_size);
+	__ASSERT_NO_MSG(err == 0);
+
+	return total_size;
+}
@@ -8,6 +8,43 @@
 #include <kernel.h>
 #define WORKQUEUE_THREAD_NAME	"workqueue"
 
+#ifdef CONFIG_WORKQUEUE_LATENCY_STATS
+static void record_latency(struct k_work_q *work_q, struct k_work *work)
+{
+	u32_t us;
+
+#ifdef CONFIG_USERSPACE
+	/* User mode workqueues can't write the stats in their k_work_q */
+	if (_is_user_context()) {
+		return;
+	}
+#endif
+
+	us = SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() -
+					 work->submit_cycles) / NSEC_PER_USEC;
+
+	if (us < 10) {
+		STATS_INC(work_q->latency, lt_10us);
+	} else if (us < 100) {
+		STATS_INC(work_q->latency, lt_100us);
+	} else if (us < 1000) {
+		STATS_INC(work_q->latency, lt_1ms);
+	} else if (us < 10000) {
+		STATS_INC(work_q->latency, lt_10ms);
+	} else if (us < 100000) {
+		STATS_INC(work_q->latency, lt_100ms);
+	} else {
+		STATS_INC(work_q->latency, ge_100ms);
+	}
+
+	if (us > work_q->latency.max_us) {
+		work_q->latency.max_us = us;
+	}
+}
+#else
+#define record_latency(work_q, work) do { } while (false)
+#endif
+
 void z_work_q_main(void *work_q_ptr, void *p2, void *p3)
 {
 	struct k_work_q *work_q = work_q_ptr;
@@ -29,6 +66,7 @@ void z_work_q_main(void *work_q_ptr, void *p2, void *p3)
 		/* Reset pending state so it can be resubmitted by handler */
 		if (atomic_test_and_clear_bit(work->flags,
 					      K_WORK_STATE_PENDING)) {
+			record_latency(work_q, work);
 			handler(work);
 		}
 
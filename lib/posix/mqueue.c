@@ -10,15 +10,38 @@
 #include <posix/time.h>
 #include <posix/mqueue.h>
 
+/* A message slot, followed by the message size of its queue in bytes */
+struct mqueue_msg {
+	sys_snode_t node;
+	size_t len;
+	unsigned int prio;
+	char data[];
+};
+
 typedef struct mqueue_object {
 	sys_snode_t snode;
 	char *mem_buffer;
 	char *mem_obj;
-	struct k_msgq queue;
+	struct k_spinlock lock;
+	/* FIFO of each priority, bit n of prio_map is set if prio_q[n]
+	 * holds messages
+	 */
+	sys_slist_t prio_q[MQ_PRIO_MAX];
+	u32_t prio_map;
+	sys_slist_t free_msgs;
+	/* count the free slots and the queued messages */
+	struct k_sem free_sem;
+	struct k_sem used_sem;
+	size_t msg_size;
+	size_t slot_size;
+	u32_t max_msgs;
+	u32_t used_msgs;
 	atomic_t ref_count;
 	char *name;
 } mqueue_object;
 
+BUILD_ASSERT(MQ_PRIO_MAX <= 32);
+
 typedef struct mqueue_desc {
 	char *mem_desc;
 	mqueue_object *mqueue;
@@ -32,12 +55,21 @@ sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
 
 s64_t timespec_to_timeoutms(const struct timespec *abstime);
 static mqueue_object *find_in_list(const char *name);
+static void init_queue(mqueue_object *msg_queue, size_t msg_size,
+		       u32_t max_msgs);
 static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  s32_t timeout);
+			  unsigned int msg_prio, s32_t timeout);
 static int receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   s32_t timeout);
+			   unsigned int *msg_prio, s32_t timeout);
+static struct mqueue_msg *get_message(mqueue_object *msg_queue,
+				      s32_t timeout);
+static void free_message(mqueue_object *msg_queue, struct mqueue_msg *msg);
 static void remove_mq(mqueue_object *msg_queue);
 
+/* Bytes taken by a message slot in the buffer of a queue */
+#define SLOT_SIZE(msg_size) \
+	ROUND_UP(sizeof(struct mqueue_msg) + (msg_size), sizeof(void *))
+
 /**
  * @brief Open a message queue.
  *
@@ -136,19 +168,17 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 		strcpy(msg_queue->name, name);
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(u8_t));
+		mq_buf_ptr = k_malloc(SLOT_SIZE(msg_size) * max_msgs);
 		if (mq_buf_ptr != NULL) {
 			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(u8_t));
+				     SLOT_SIZE(msg_size) * max_msgs);
 			msg_queue->mem_buffer = mq_buf_ptr;
 		} else {
 			goto free_mq_buffer;
 		}
 
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
+		init_queue(msg_queue, msg_size, max_msgs);
 		k_sem_take(&mq_sem, K_FOREVER);
 		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
@@ -225,7 +255,8 @@ int mq_unlink(const char *name)
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
+ * Messages are received highest priority first, and in sending order
+ * within a priority.
  *
  * See IEEE 1003.1
  */
@@ -235,14 +266,12 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	s32_t  timeout = K_FOREVER;
 
-	return send_message(mqd, msg_ptr, msg_len, timeout);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -252,13 +281,13 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	s32_t  timeout;
 
 	timeout = (s32_t) timespec_to_timeoutms(abstime);
-	return send_message(mqd, msg_ptr, msg_len, timeout);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The oldest of the messages of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -268,15 +297,13 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	s32_t  timeout = K_FOREVER;
 
-	return receive_message(mqd, msg_ptr, msg_len, timeout);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
@@ -286,7 +313,7 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	s32_t  timeout = K_NO_WAIT;
 
 	timeout = (s32_t) timespec_to_timeoutms(abstime);
-	return receive_message(mqd, msg_ptr, msg_len, timeout);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, timeout);
 }
 
 /**
@@ -297,7 +324,6 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
 
 	if (mqd == NULL) {
 		errno = EBADF;
@@ -305,11 +331,10 @@ int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 	}
 
 	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
+	mqstat->mq_maxmsg = mqd->mqueue->max_msgs;
+	mqstat->mq_msgsize = mqd->mqueue->msg_size;
+	mqstat->mq_curmsgs = mqd->mqueue->used_msgs;
 	k_sem_give(&mq_sem);
 	return 0;
 }
@@ -345,6 +370,82 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 	return 0;
 }
 
+#ifdef CONFIG_POSIX_MQUEUE_LOAN
+/**
+ * @brief Receive a message without copying it.
+ *
+ * Not a POSIX API: the message is left in the buffer of the queue, which is
+ * lent to the caller until mq_loan_return().
+ */
+int mq_loan_receive(mqd_t mqdes, const char **msg_ptr, unsigned int *msg_prio,
+		    const struct timespec *abstime)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	s32_t timeout = K_FOREVER;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		timeout = K_NO_WAIT;
+	} else if (abstime != NULL) {
+		timeout = (s32_t) timespec_to_timeoutms(abstime);
+	}
+
+	msg = get_message(mqd->mqueue, timeout);
+	if (msg == NULL) {
+		return -1;
+	}
+
+	*msg_ptr = msg->data;
+	if (msg_prio != NULL) {
+		*msg_prio = msg->prio;
+	}
+
+	return msg->len;
+}
+
+/**
+ * @brief Give back a message received with mq_loan_receive().
+ *
+ * Not a POSIX API.
+ */
+int mq_loan_return(mqd_t mqdes, const char *msg_ptr)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	mqueue_object *msg_queue;
+	size_t off;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg_queue = mqd->mqueue;
+	if (msg_ptr < msg_queue->mem_buffer + offsetof(struct mqueue_msg, data)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* offset of the slot, which must be one of the queue */
+	off = msg_ptr - msg_queue->mem_buffer - offsetof(struct mqueue_msg,
+							     data);
+	if (off >= msg_queue->slot_size * msg_queue->max_msgs ||
+	    off % msg_queue->slot_size != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	free_message(msg_queue,
+		     (struct mqueue_msg *)(msg_queue->mem_buffer + off));
+
+	return 0;
+}
+#endif /* CONFIG_POSIX_MQUEUE_LOAN */
+
 /* Internal functions */
 static mqueue_object *find_in_list(const char *name)
 {
@@ -365,9 +466,77 @@ static mqueue_object *find_in_list(const char *name)
 	return NULL;
 }
 
+static void init_queue(mqueue_object *msg_queue, size_t msg_size,
+		       u32_t max_msgs)
+{
+	u32_t i;
+
+	msg_queue->msg_size = msg_size;
+	msg_queue->slot_size = SLOT_SIZE(msg_size);
+	msg_queue->max_msgs = max_msgs;
+
+	for (i = 0U; i < MQ_PRIO_MAX; i++) {
+		sys_slist_init(&msg_queue->prio_q[i]);
+	}
+
+	sys_slist_init(&msg_queue->free_msgs);
+	for (i = 0U; i < max_msgs; i++) {
+		sys_slist_append(&msg_queue->free_msgs, (sys_snode_t *)
+				 (msg_queue->mem_buffer +
+				  i * msg_queue->slot_size));
+	}
+
+	k_sem_init(&msg_queue->free_sem, max_msgs, max_msgs);
+	k_sem_init(&msg_queue->used_sem, 0, max_msgs);
+}
+
+/* Takes the oldest message of the highest priority, NULL with errno set */
+static struct mqueue_msg *get_message(mqueue_object *msg_queue,
+				      s32_t timeout)
+{
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
+	unsigned int prio;
+
+	if (k_sem_take(&msg_queue->used_sem, timeout) != 0) {
+		errno = (timeout != K_NO_WAIT) ? ETIMEDOUT : EAGAIN;
+		return NULL;
+	}
+
+	key = k_spin_lock(&msg_queue->lock);
+
+	prio = find_msb_set(msg_queue->prio_map) - 1;
+	msg = (struct mqueue_msg *)
+		sys_slist_get_not_empty(&msg_queue->prio_q[prio]);
+	if (sys_slist_is_empty(&msg_queue->prio_q[prio])) {
+		msg_queue->prio_map &= ~BIT(prio);
+	}
+
+	msg_queue->used_msgs--;
+
+	k_spin_unlock(&msg_queue->lock, key);
+
+	return msg;
+}
+
+static void free_message(mqueue_object *msg_queue, struct mqueue_msg *msg)
+{
+	k_spinlock_key_t key = k_spin_lock(&msg_queue->lock);
+
+	/* the slot reused first is the one most likely in cache */
+	sys_slist_prepend(&msg_queue->free_msgs, &msg->node);
+
+	k_spin_unlock(&msg_queue->lock, key);
+
+	k_sem_give(&msg_queue->free_sem);
+}
+
 static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  s32_t timeout)
+			  unsigned int msg_prio, s32_t timeout)
 {
+	mqueue_object *msg_queue;
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
 	s32_t ret = -1;
 
 	if (mqd == NULL) {
@@ -379,22 +548,48 @@ static s32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
 		timeout = K_NO_WAIT;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
+	msg_queue = mqd->mqueue;
+
+	if (msg_len >  msg_queue->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
+	if (msg_prio >= MQ_PRIO_MAX) {
+		errno = EINVAL;
+		return ret;
+	}
+
+	if (k_sem_take(&msg_queue->free_sem, timeout) != 0) {
 		errno = (timeout == K_NO_WAIT) ?   EAGAIN : ETIMEDOUT;
 		return ret;
 	}
 
+	key = k_spin_lock(&msg_queue->lock);
+	msg = (struct mqueue_msg *)
+		sys_slist_get_not_empty(&msg_queue->free_msgs);
+	k_spin_unlock(&msg_queue->lock, key);
+
+	/* the slot is ours, copy without holding the lock */
+	(void)memcpy(msg->data, msg_ptr, msg_len);
+	msg->len = msg_len;
+	msg->prio = msg_prio;
+
+	key = k_spin_lock(&msg_queue->lock);
+	sys_slist_append(&msg_queue->prio_q[msg_prio], &msg->node);
+	msg_queue->prio_map |= BIT(msg_prio);
+	msg_queue->used_msgs++;
+	k_spin_unlock(&msg_queue->lock, key);
+
+	k_sem_give(&msg_queue->used_sem);
+
 	return 0;
 }
 
 static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     s32_t timeout)
+			     unsigned int *msg_prio, s32_t timeout)
 {
+	struct mqueue_msg *msg;
 	int ret = -1;
 
 	if (mqd == NULL) {
@@ -402,7 +597,7 @@ static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	if (msg_len < mqd->mqueue->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
@@ -411,10 +606,15 @@ static s32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		timeout = K_NO_WAIT;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = (timeout != K_NO_WAIT) ? ETIMEDOUT : EAGAIN;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
+	msg = get_message(mqd->mqueue, timeout);
+	if (msg != NULL) {
+		(void)memcpy(msg_ptr, msg->data, msg->len);
+		if (msg_prio != NULL) {
+			*msg_prio = msg->prio;
+		}
+
+		ret = msg->len;
+		free_message(mqd->mqueue, msg);
 	}
 
 	return ret;
@@ -9,16 +9,19 @@
 #include <wait_q.h>
 #include <posix/pthread.h>
 
+bool z_pthread_mutex_release(pthread_mutex_t *m);
+
 static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut, int timeout)
 {
 	__ASSERT(mut->lock_count == 1U, "");
 
 	int ret, key = irq_lock();
 
-	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
+	/* seen by signalers holding the mutex once we release it */
+	atomic_inc(&cv->waiters);
+	(void)z_pthread_mutex_release(mut);
 	ret = z_pend_curr_irqlock(key, &cv->wait_q, timeout);
+	atomic_dec(&cv->waiters);
 
 	/* FIXME: this extra lock (and the potential context switch it
 	 * can cause) could be optimized out.  At the point of the
@@ -46,7 +49,13 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut, int timeout)
 
 int pthread_cond_signal(pthread_cond_t *cv)
 {
-	int key = irq_lock();
+	int key;
+
+	if (atomic_get(&cv->waiters) == 0) {
+		return 0;
+	}
+
+	key = irq_lock();
 
 	_ready_one_thread(&cv->wait_q);
 	z_reschedule_irqlock(key);
@@ -56,7 +65,13 @@ int pthread_cond_signal(pthread_cond_t *cv)
 
 int pthread_cond_broadcast(pthread_cond_t *cv)
 {
-	int key = irq_lock();
+	int key;
+
+	if (atomic_get(&cv->waiters) == 0) {
+		return 0;
+	}
+
+	key = irq_lock();
 
 	while (z_waitq_head(&cv->wait_q)) {
 		_ready_one_thread(&cv->wait_q);
@@ -11,6 +11,16 @@
 
 #define MUTEX_MAX_REC_LOCK 32767
 
+/*
+ * Values of the state word. Locking and unlocking a free mutex are a
+ * single compare and swap on it, the wait queue and the interrupt lock
+ * are only used when a thread has to wait. Such a thread first moves the
+ * state to MUTEX_CONTENDED, which makes the unlock take the slow path.
+ */
+#define MUTEX_UNLOCKED 0
+#define MUTEX_LOCKED 1
+#define MUTEX_CONTENDED 2
+
 /*
  *  Default mutex attrs.
  */
@@ -18,17 +28,59 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
-static int acquire_mutex(pthread_mutex_t *m, int timeout)
+/*
+ * Releases a mutex whose owner dropped its last lock. If there are
+ * waiters, the first one becomes the owner and true is returned: the
+ * caller must reschedule. Can be called with interrupts locked.
+ */
+bool z_pthread_mutex_release(pthread_mutex_t *m)
 {
-	int rc = 0, key = irq_lock();
+	k_tid_t thread;
+	int key;
 
-	if (m->lock_count == 0U && m->owner == NULL) {
-		m->lock_count++;
-		m->owner = pthread_self();
+	m->owner = NULL;
+	m->lock_count = 0U;
+
+	if (likely(atomic_cas(&m->state, MUTEX_LOCKED, MUTEX_UNLOCKED))) {
+		return false;
+	}
 
+	key = irq_lock();
+
+	thread = z_unpend_first_thread(&m->wait_q);
+	if (thread == NULL) {
+		/* the waiters timed out */
+		atomic_set(&m->state, MUTEX_UNLOCKED);
 		irq_unlock(key);
+		return false;
+	}
+
+	m->owner = (pthread_t)thread;
+	m->lock_count = 1U;
+	if (z_waitq_head(&m->wait_q) == NULL) {
+		atomic_set(&m->state, MUTEX_LOCKED);
+	}
+
+	z_ready_thread(thread);
+	z_set_thread_return_value(thread, 0);
+	irq_unlock(key);
+
+	return true;
+}
+
+static int acquire_mutex(pthread_mutex_t *m, int timeout)
+{
+	atomic_val_t state;
+	int rc, key;
+
+	if (likely(atomic_cas(&m->state, MUTEX_UNLOCKED, MUTEX_LOCKED))) {
+		m->lock_count = 1U;
+		m->owner = pthread_self();
 		return 0;
-	} else if (m->owner == pthread_self()) {
+	}
+
+	/* only the owner can find itself in owner, no need to lock */
+	if (m->owner == pthread_self()) {
 		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
 		    m->lock_count < MUTEX_MAX_REC_LOCK) {
 			m->lock_count++;
@@ -39,15 +91,35 @@ static int acquire_mutex(pthread_mutex_t *m, int timeout)
 			rc = EINVAL;
 		}
 
-		irq_unlock(key);
 		return rc;
 	}
 
 	if (timeout == K_NO_WAIT) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
+	key = irq_lock();
+
+	/* flag the contention, unless the owner released it meanwhile */
+	for (;;) {
+		state = atomic_get(&m->state);
+		if (state == MUTEX_CONTENDED) {
+			break;
+		}
+
+		if (atomic_cas(&m->state, state, state == MUTEX_UNLOCKED ?
+			       MUTEX_LOCKED : MUTEX_CONTENDED)) {
+			if (state == MUTEX_UNLOCKED) {
+				m->lock_count = 1U;
+				m->owner = pthread_self();
+				irq_unlock(key);
+				return 0;
+			}
+			break;
+		}
+	}
+
+	/* z_pthread_mutex_release() makes us the owner before waking us */
 	rc = z_pend_curr_irqlock(key, &m->wait_q, timeout);
 	if (rc != 0) {
 		rc = ETIMEDOUT;
@@ -88,6 +160,7 @@ int pthread_mutex_init(pthread_mutex_t *m,
 {
 	const pthread_mutexattr_t *mattr;
 
+	atomic_set(&m->state, MUTEX_UNLOCKED);
 	m->owner = NULL;
 	m->lock_count = 0U;
 
@@ -118,36 +191,23 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *m)
 {
-	unsigned int key = irq_lock();
-
-	k_tid_t thread;
-
 	if (m->owner != pthread_self()) {
-		irq_unlock(key);
 		return EPERM;
 	}
 
 	if (m->lock_count == 0U) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
-	m->lock_count--;
-
-	if (m->lock_count == 0U) {
-		thread = z_unpend_first_thread(&m->wait_q);
-		if (thread) {
-			m->owner = (pthread_t)thread;
-			m->lock_count++;
-			z_ready_thread(thread);
-			z_set_thread_return_value(thread, 0);
-			z_reschedule_irqlock(key);
-			return 0;
-		}
-		m->owner = NULL;
+	if (m->lock_count > 1U) {
+		m->lock_count--;
+		return 0;
+	}
 
+	if (z_pthread_mutex_release(m)) {
+		z_reschedule_unlocked();
 	}
-	irq_unlock(key);
+
 	return 0;
 }
 
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <errno.h>
 #include <posix/time.h>
 #include <posix/posix_types.h>
@@ -11,7 +13,15 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
+/*
+ * The state word holds the number of readers and two flags. Taking and
+ * releasing an available lock is a compare and swap on it, the interrupt
+ * lock and the wait queue are only used to wait. Once a thread waits,
+ * new readers wait too, so that writers get the lock.
+ */
+#define RW_WRITER ((atomic_val_t)BIT(30))
+#define RW_WAITERS ((atomic_val_t)BIT(31))
+#define RW_READERS_MASK (RW_WRITER - 1)
 
 s64_t timespec_to_timeoutms(const struct timespec *abstime);
 static u32_t read_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout);
@@ -25,10 +35,8 @@ static u32_t write_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
+	atomic_set(&rwlock->state, 0);
+	z_waitq_init(&rwlock->wait_q);
 	rwlock->wr_owner = NULL;
 	rwlock->status = INITIALIZED;
 	return 0;
@@ -45,7 +53,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (rwlock->wr_owner != NULL) {
+	if (atomic_get(&rwlock->state) & ~RW_WAITERS) {
 		return EBUSY;
 	}
 
@@ -60,9 +68,6 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
@@ -77,9 +82,6 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
@@ -105,9 +107,6 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for reading immedately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -122,8 +121,8 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * A waiting writer holds back new readers, waiting threads get lock
+ * based on priority.
  *
  * See IEEE 1003.1
  */
@@ -139,8 +138,8 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * A waiting writer holds back new readers, waiting threads get lock
+ * based on priority.
  *
  * See IEEE 1003.1
  */
@@ -167,8 +166,8 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for writing immedately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * A waiting writer holds back new readers, waiting threads get lock
+ * based on priority.
  *
  * See IEEE 1003.1
  */
@@ -181,6 +180,23 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 	return write_lock_acquire(rwlock, K_NO_WAIT);
 }
 
+/* Releases the lock of its last holder and wakes all the waiters */
+static void wake_waiters(pthread_rwlock_t *rwlock)
+{
+	struct k_thread *thread;
+	int key = irq_lock();
+
+	/* waiting threads keep the flag set, nobody else changes the state */
+	atomic_set(&rwlock->state, 0);
+
+	while ((thread = z_unpend_first_thread(&rwlock->wait_q)) != NULL) {
+		z_ready_thread(thread);
+		z_set_thread_return_value(thread, 0);
+	}
+
+	z_reschedule_irqlock(key);
+}
+
 /**
  *
  * @brief Unlock a read-write lock object.
@@ -189,6 +205,8 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
+	atomic_val_t state, held;
+
 	if (rwlock->status == NOT_INITIALIZED) {
 		return EINVAL;
 	}
@@ -196,62 +214,100 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 	if (k_current_get() == rwlock->wr_owner) {
 		/* Write unlock */
 		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
+		held = RW_WRITER;
 	} else {
 		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
+		held = 1;
+	}
+
+	do {
+		state = atomic_get(&rwlock->state);
+		if (held == 1 && (state & RW_READERS_MASK) == 0) {
+			return EINVAL;
 		}
 
-		k_sem_give(&rwlock->rd_sem);
-	}
+		if (state == (held | RW_WAITERS)) {
+			/* last holder, the waiters retry */
+			wake_waiters(rwlock);
+			return 0;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state - held));
+
 	return 0;
 }
 
-
-static u32_t read_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+/* Takes the lock if it is available, without waiting */
+static bool lock_try(pthread_rwlock_t *rwlock, bool write)
 {
-	u32_t ret = 0U;
+	atomic_val_t state;
 
-	if (k_sem_take(&rwlock->wr_sem, timeout) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+	do {
+		state = atomic_get(&rwlock->state);
+		if (write ? (state & ~RW_WAITERS) != 0 :
+		    (state & (RW_WRITER | RW_WAITERS)) != 0) {
+			return false;
+		}
+	} while (!atomic_cas(&rwlock->state, state,
+			     write ? state | RW_WRITER : state + 1));
+
+	if (write) {
+		rwlock->wr_owner = k_current_get();
 	}
 
-	return ret;
+	return true;
 }
 
-static u32_t write_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+static u32_t lock_acquire(pthread_rwlock_t *rwlock, bool write,
+			  s32_t timeout)
 {
-	u32_t ret = 0U;
-	s64_t elapsed_time, st_time = k_uptime_get();
+	s64_t elapsed_time, st_time;
+	atomic_val_t state;
+	int key;
+
+	if (likely(lock_try(rwlock, write))) {
+		return 0U;
+	}
+
+	st_time = k_uptime_get();
+
+	for (;;) {
+		key = irq_lock();
+
+		/* flag a waiter, unless the lock got released meanwhile */
+		do {
+			if (lock_try(rwlock, write)) {
+				irq_unlock(key);
+				return 0U;
+			}
+
+			if (timeout == K_NO_WAIT) {
+				irq_unlock(key);
+				return EBUSY;
+			}
+
+			state = atomic_get(&rwlock->state);
+		} while ((state & RW_WAITERS) == 0 &&
+			 !atomic_cas(&rwlock->state, state, state | RW_WAITERS));
+
+		if (z_pend_curr_irqlock(key, &rwlock->wait_q, timeout) != 0) {
+			return EBUSY;
+		}
 
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, timeout) == 0) {
 		if (timeout > K_NO_WAIT) {
 			elapsed_time = k_uptime_get() - st_time;
 			timeout = timeout <= elapsed_time ? K_NO_WAIT :
 				  timeout - elapsed_time;
+			st_time += elapsed_time;
 		}
-
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
-		}
-
-	} else {
-		ret = EBUSY;
 	}
-	return ret;
 }
 
+static u32_t read_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+{
+	return lock_acquire(rwlock, false, timeout);
+}
 
+static u32_t write_lock_acquire(pthread_rwlock_t *rwlock, s32_t timeout)
+{
+	return lock_acquire(rwlock, true, timeout);
+}
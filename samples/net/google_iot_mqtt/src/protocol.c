@@ -218,7 +218,8 @@ void mqtt_startup(char *hostname, int port)
 	char pub_msg[64];
 	struct sockaddr_in *broker4 = (struct sockaddr_in *)&broker;
 	struct mqtt_client *client = &client_ctx;
-	struct jwt_builder jb;
+	static struct jwt_signer signer;
+	static struct jwt_cache jwt_cache;
 	static struct zsock_addrinfo hints;
 	struct zsock_addrinfo *haddr;
 	int res = 0;
@@ -233,6 +234,17 @@ void mqtt_startup(char *hostname, int port)
 		LOG_ERR("Failed to register public certificate: %d", err);
 	}
 
+	/* The key is parsed once, and a token reused until it expires */
+	res = jwt_signer_init(&signer, zepfull_private_der,
+			      zepfull_private_der_len);
+	if (res != 0) {
+		LOG_ERR("Error with JWT key");
+		return;
+	}
+
+	(void)jwt_signer_precompute(&signer);
+	jwt_cache_init(&jwt_cache, token, sizeof(token));
+
 	while (retries) {
 		hints.ai_family = AF_INET;
 		hints.ai_socktype = SOCK_STREAM;
@@ -255,22 +267,8 @@ void mqtt_startup(char *hostname, int port)
 
 		time_t now = my_k_time(NULL);
 
-		res = jwt_init_builder(&jb, token, sizeof(token));
-		if (res != 0) {
-			LOG_ERR("Error with JWT token");
-			return;
-		}
-
-		res = jwt_add_payload(&jb, now + 60 * 60, now,
-				      CONFIG_CLOUD_AUDIENCE);
-		if (res != 0) {
-			LOG_ERR("Error with JWT token");
-			return;
-		}
-
-		res = jwt_sign(&jb, zepfull_private_der,
-			       zepfull_private_der_len);
-
+		res = jwt_cache_get(&jwt_cache, &signer, now, 60 * 60,
+				    CONFIG_CLOUD_AUDIENCE);
 		if (res != 0) {
 			LOG_ERR("Error with JWT token");
 			return;
@@ -288,7 +286,7 @@ void mqtt_startup(char *hostname, int port)
 		client->client_id.utf8 = client_id;
 		client->client_id.size = strlen(client_id);
 		client->password = &password;
-		password.size = jwt_payload_len(&jb);
+		password.size = jwt_cache.len;
 		client->user_name = &username;
 		client->protocol_version = MQTT_VERSION_3_1_1;
 
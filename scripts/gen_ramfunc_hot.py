@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generate the linker fragment of the functions executed from RAM.
+
+Reads the call counts printed by hot_functions_dump() in a build with
+CONFIG_TRACING_HOT_FUNCTIONS, resolves the function addresses with the ELF
+file of that build, and lists the most called functions marked __hotfunc
+whose total size fits in the RAM budget. The fragment is used by
+CONFIG_RAMFUNC_HOT_LD, with CONFIG_RAMFUNC_HOT_BUDGET set to the same
+budget.
+"""
+
+import argparse
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+HOT_LINE = re.compile(r"hot 0x([0-9a-fA-F]+) (\d+)")
+
+# Functions are word aligned in the section
+ALIGN = 4
+
+
+def functions(elf):
+    """Name and size of the functions of the .hottext section by address,
+    ignoring the Thumb bit.
+    """
+    hottext = None
+    for index, section in enumerate(elf.iter_sections()):
+        if section.name == ".hottext":
+            hottext = index
+    if hottext is None:
+        sys.exit("no .hottext section, not built with "
+                 "CONFIG_TRACING_HOT_FUNCTIONS?")
+
+    funcs = {}
+    for section in elf.iter_sections():
+        if not isinstance(section, SymbolTableSection):
+            continue
+        for sym in section.iter_symbols():
+            if (sym["st_info"]["type"] == "STT_FUNC" and
+                    sym["st_shndx"] == hottext):
+                funcs[sym["st_value"] & ~1] = (sym.name, sym["st_size"])
+    return funcs
+
+
+def calls(path):
+    counts = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            match = HOT_LINE.search(line)
+            if match:
+                addr = int(match.group(1), 16) & ~1
+                counts[addr] = counts.get(addr, 0) + int(match.group(2))
+    return counts
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-e", "--elf", required=True,
+                        help="ELF file of the profiled build")
+    parser.add_argument("-p", "--profile", required=True,
+                        help="Output of hot_functions_dump()")
+    parser.add_argument("-b", "--budget", type=int, required=True,
+                        help="RAM budget of the functions, in bytes")
+    parser.add_argument("-o", "--output", required=True,
+                        help="Linker fragment to write")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(args.elf, "rb") as f:
+        funcs = functions(ELFFile(f))
+
+    hot = []
+    for addr, count in calls(args.profile).items():
+        if addr not in funcs:
+            sys.exit("no hot function at 0x%08x, not the profiled ELF "
+                     "file?" % addr)
+        name, size = funcs[addr]
+        hot.append((count, name, size))
+
+    # Most called first, skipping those beyond the remaining budget
+    hot.sort(key=lambda h: (-h[0], h[1]))
+    used = 0
+    selected = []
+    for count, name, size in hot:
+        size = (size + ALIGN - 1) & ~(ALIGN - 1)
+        if used + size <= args.budget:
+            used += size
+            selected.append((count, name, size))
+
+    with open(args.output, "w") as f:
+        f.write("/* Generated by gen_ramfunc_hot.py, do not edit.\n")
+        f.write(" *\n")
+        f.write(" * %u of %u bytes, calls size name:\n" %
+                (used, args.budget))
+        for count, name, size in selected:
+            f.write(" * %10u %6u %s\n" % (count, size, name))
+        f.write(" */\n")
+        for _, name, _ in selected:
+            f.write("\t*(.hottext.%s)\n" % name)
+
+    print("%d of %d hot functions in RAM, %u of %u bytes" %
+          (len(selected), len(hot), used, args.budget))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generate the dictionary used to decode dictionary based log output.
+
+Log records written with CONFIG_LOG_DICTIONARY refer to format strings by
+their address. This script extracts from the ELF file everything the
+decoder needs to turn them back into text: the read-only sections holding
+the strings, and the names of the log sources indexed by source ID.
+"""
+
+import argparse
+import base64
+import json
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+# sh_flags
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+
+LOG_CONST_PREFIX = "log_const_"
+
+
+def symbols(elf):
+    for section in elf.iter_sections():
+        if isinstance(section, SymbolTableSection):
+            yield from section.iter_symbols()
+
+
+def read(elf, addr, size):
+    """Read size bytes at addr from the section loaded there."""
+    for section in elf.iter_sections():
+        start = section["sh_addr"]
+        if (section["sh_type"] != "SHT_NOBITS" and
+                start <= addr and addr + size <= start + section["sh_size"]):
+            data = section.data()
+            return data[addr - start:addr - start + size]
+    return None
+
+
+def read_string(elf, addr):
+    for section in elf.iter_sections():
+        start = section["sh_addr"]
+        if (section["sh_type"] != "SHT_NOBITS" and
+                start <= addr < start + section["sh_size"]):
+            data = section.data()
+            end = data.find(b"\0", addr - start)
+            return data[addr - start:end].decode("utf-8", "replace")
+    return None
+
+
+def log_sources(elf):
+    """Names of the log sources, in source ID order.
+
+    The constant data of the sources is sorted by name into
+    log_const_sections, and the source ID is the index in that table.
+    """
+    ptr_size = elf.elfclass // 8
+    endian = "little" if elf.little_endian else "big"
+    entries = sorted((sym["st_value"], sym["st_size"], sym.name)
+                     for sym in symbols(elf)
+                     if sym.name.startswith(LOG_CONST_PREFIX) and
+                     sym["st_info"]["type"] == "STT_OBJECT")
+    names = []
+
+    for addr, _, sym_name in entries:
+        raw = read(elf, addr, ptr_size)
+        name = None
+        if raw is not None:
+            name = read_string(elf, int.from_bytes(raw, endian))
+        names.append(name or sym_name[len(LOG_CONST_PREFIX):])
+
+    return names
+
+
+def rodata(elf):
+    """Allocated read-only sections, where the strings are."""
+    for section in elf.iter_sections():
+        flags = section["sh_flags"]
+        if (section["sh_type"] == "SHT_PROGBITS" and
+                flags & SHF_ALLOC and not flags & SHF_WRITE and
+                section["sh_size"] > 0):
+            yield {
+                "name": section.name,
+                "addr": section["sh_addr"],
+                "data": base64.b64encode(section.data()).decode("ascii"),
+            }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("elf", help="Zephyr ELF file")
+    parser.add_argument("output", help="dictionary file to write")
+    args = parser.parse_args()
+
+    with open(args.elf, "rb") as f:
+        elf = ELFFile(f)
+        if not elf.little_endian:
+            sys.exit("dictionary logging supports little endian only")
+
+        dictionary = {
+            "version": 1,
+            "sources": log_sources(elf),
+            "sections": list(rodata(elf)),
+        }
+
+    with open(args.output, "w") as f:
+        json.dump(dictionary, f)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode dictionary based log output.
+
+Reads the binary records written by the logger with CONFIG_LOG_DICTIONARY,
+from a file or a serial port, and prints them as text using the dictionary
+generated at build time (log_dictionary.json in the build directory).
+"""
+
+import argparse
+import base64
+import json
+import re
+import struct
+import sys
+
+LOG_DICT_SYNC = 0xA5
+LOG_DICT_STD = 0x01
+LOG_DICT_HEXDUMP = 0x02
+LOG_DICT_RAW = 0x03
+LOG_DICT_DROPPED = 0x04
+
+LEVELS = [None, "err", "wrn", "inf", "dbg"]
+COLORS = [None, "\x1b[1;31m", "\x1b[1;33m", None, None]
+COLOR_DEFAULT = "\x1b[0m"
+
+HEXDUMP_BYTES_IN_LINE = 8
+
+# %[flags][width][.precision][length]conversion
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?"
+                        r"(hh|h|ll|l|j|z|t|L)?([diouxXcspeEfgGaAn%])")
+
+
+class Dictionary:
+    def __init__(self, path):
+        with open(path) as f:
+            data = json.load(f)
+
+        if data.get("version") != 1:
+            sys.exit("unsupported dictionary version")
+
+        self.sources = data["sources"]
+        self.sections = [(s["addr"], base64.b64decode(s["data"]))
+                         for s in data["sections"]]
+
+    def string(self, addr):
+        for start, data in self.sections:
+            if start <= addr < start + len(data):
+                end = data.find(b"\0", addr - start)
+                return data[addr - start:end].decode("utf-8", "replace")
+        return "<unknown string 0x%08x>" % addr
+
+    def source(self, source_id):
+        if source_id < len(self.sources):
+            return self.sources[source_id]
+        return "<source %d>" % source_id
+
+
+class Reader:
+    def __init__(self, stream):
+        self.stream = stream
+
+    def bytes(self, n):
+        data = b""
+        while len(data) < n:
+            chunk = self.stream.read(n - len(data))
+            if not chunk:
+                raise EOFError
+            data += chunk
+        return data
+
+    def u8(self):
+        return self.bytes(1)[0]
+
+    def u16(self):
+        return struct.unpack("<H", self.bytes(2))[0]
+
+    def u32(self):
+        return struct.unpack("<I", self.bytes(4))[0]
+
+    def cstring(self):
+        data = b""
+        while True:
+            c = self.bytes(1)
+            if c == b"\0":
+                return data.decode("utf-8", "replace")
+            data += c
+
+
+def s32(val):
+    return val - (1 << 32) if val & 0x80000000 else val
+
+
+def format_msg(fmt, args, strings):
+    """printf-like formatting of the 32-bit arguments of a message."""
+    args = list(args)
+    strings = list(strings)
+
+    def arg():
+        return args.pop(0) if args else 0
+
+    def convert(m):
+        flags, width, precision, length, conv = m.groups()
+
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(s32(arg()))
+        if precision == "*":
+            precision = str(s32(arg()))
+
+        spec = "%" + flags + (width or "")
+        if precision is not None:
+            spec += "." + precision
+
+        val = arg()
+        if conv == "s":
+            return (spec + "s") % (strings.pop(0) if strings else "")
+        if conv == "p":
+            return (spec + "s") % ("0x%08x" % val)
+        if conv == "c":
+            return (spec + "c") % chr(val & 0xff)
+        if conv in "di":
+            if length == "hh":
+                val = val & 0xff
+                val = val - 0x100 if val & 0x80 else val
+            elif length == "h":
+                val = val & 0xffff
+                val = val - 0x10000 if val & 0x8000 else val
+            else:
+                val = s32(val)
+            return (spec + "d") % val
+        if conv in "ouxX":
+            if length == "hh":
+                val &= 0xff
+            elif length == "h":
+                val &= 0xffff
+            return (spec + ("d" if conv == "u" else conv)) % val
+        if conv == "n":
+            return ""
+        # floating point arguments are not supported by the logger
+        return "<%s>" % m.group(0)
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, dictionary, args):
+        self.dictionary = dictionary
+        self.freq = args.timestamp_freq
+        self.colors = args.colors
+
+    def timestamp(self, ts):
+        if not self.freq:
+            return "[%08d]" % ts
+        us = ts * 1000000 // self.freq
+        return "[%02d:%02d:%02d.%03d,%03d]" % (
+            us // 3600000000, us // 60000000 % 60, us // 1000000 % 60,
+            us // 1000 % 1000, us % 1000)
+
+    def prefix(self, level, domain_id, source_id, ts):
+        color = ""
+        if self.colors and level < len(COLORS) and COLORS[level]:
+            color = COLORS[level]
+        level_name = LEVELS[level] if level < len(LEVELS) else str(level)
+        return "%s %s<%s> %s: " % (self.timestamp(ts), color, level_name,
+                                   self.dictionary.source(source_id))
+
+    def postfix(self, level):
+        if self.colors and level < len(COLORS) and COLORS[level]:
+            return COLOR_DEFAULT
+        return ""
+
+    def hdr(self, reader):
+        level = reader.u8()
+        domain_id = reader.u8()
+        source_id = reader.u16()
+        ts = reader.u32()
+        return level, domain_id, source_id, ts
+
+    def std(self, reader):
+        level, domain_id, source_id, ts = self.hdr(reader)
+        fmt = self.dictionary.string(reader.u32())
+        args = [reader.u32() for _ in range(reader.u8())]
+        n_strings = sum(1 for m in CONVERSION.finditer(fmt)
+                        if m.group(5) == "s")
+        strings = [reader.cstring() for _ in range(n_strings)]
+
+        return (self.prefix(level, domain_id, source_id, ts) +
+                format_msg(fmt, args, strings) + self.postfix(level))
+
+    def hexdump(self, reader):
+        level, domain_id, source_id, ts = self.hdr(reader)
+        metadata = self.dictionary.string(reader.u32())
+        data = reader.bytes(reader.u16())
+        prefix = self.prefix(level, domain_id, source_id, ts)
+        lines = [prefix + metadata]
+
+        for i in range(0, len(data), HEXDUMP_BYTES_IN_LINE):
+            line = data[i:i + HEXDUMP_BYTES_IN_LINE]
+            hexs = " ".join("%02x" % b for b in line)
+            chars = "".join(chr(b) if 32 <= b < 127 else "." for b in line)
+            lines.append(" " * len(prefix) + "%-*s |%s" % (
+                3 * HEXDUMP_BYTES_IN_LINE, hexs, chars))
+
+        return "\n".join(lines) + self.postfix(level)
+
+    def raw(self, reader):
+        return reader.bytes(reader.u16()).decode("utf-8", "replace")
+
+    def decode(self, stream, out):
+        reader = Reader(stream)
+        handlers = {
+            LOG_DICT_STD: self.std,
+            LOG_DICT_HEXDUMP: self.hexdump,
+        }
+
+        try:
+            while True:
+                if reader.u8() != LOG_DICT_SYNC:
+                    # lost sync, wait for the next record
+                    continue
+
+                rec_type = reader.u8()
+                if rec_type in handlers:
+                    out.write(handlers[rec_type](reader) + "\n")
+                elif rec_type == LOG_DICT_RAW:
+                    out.write(self.raw(reader))
+                elif rec_type == LOG_DICT_DROPPED:
+                    out.write("--- %d messages dropped ---\n" %
+                              reader.u32())
+                out.flush()
+        except EOFError:
+            pass
+
+
+def open_input(args):
+    if args.serial:
+        import serial
+        port = serial.Serial(args.input, args.baudrate)
+        return port
+    if args.input == "-":
+        return sys.stdin.buffer
+    return open(args.input, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("dictionary", help="log_dictionary.json")
+    parser.add_argument("input", help="binary log file, serial port with "
+                        "--serial, or - for stdin")
+    parser.add_argument("--serial", action="store_true",
+                        help="read from a serial port")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--timestamp-freq", type=int, default=0,
+                        help="timestamp frequency in Hz, raw timestamps "
+                        "are printed if not given")
+    parser.add_argument("--colors", action="store_true",
+                        help="color errors and warnings")
+    args = parser.parse_args()
+
+    dictionary = Dictionary(args.dictionary)
+    with open_input(args) as stream:
+        Decoder(dictionary, args).decode(stream, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * crc32_ieee_update() on the CRC calculation unit. The unit runs with its
+ * reset polynomial and size, 0x04C11DB7 on 32 bits, the bit reversal of
+ * input bytes and output gives the reflected IEEE CRC.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <soc.h>
+#include <crc.h>
+#include <misc/byteorder.h>
+#include <misc/util.h>
+
+/* Bytes processed per interrupt lock */
+#define CRC32_STM32_CHUNK_LEN	64
+
+static size_t crc32_stm32_feed(const u8_t *data, size_t len)
+{
+	size_t n = MIN(len, CRC32_STM32_CHUNK_LEN);
+	size_t i;
+
+	/* the unit takes the most significant byte of a word first */
+	for (i = 0; i + 4 <= n; i += 4) {
+		LL_CRC_FeedData32(CRC, sys_get_be32(&data[i]));
+	}
+
+	for (; i < n; i++) {
+		LL_CRC_FeedData8(CRC, data[i]);
+	}
+
+	return n;
+}
+
+u32_t crc32_ieee_update(u32_t crc, const u8_t *data, size_t len)
+{
+	unsigned int key;
+	size_t n;
+
+	crc = ~crc;
+
+	while (len > 0) {
+		key = irq_lock();
+
+		/* the initial value is loaded before the output reversal */
+		LL_CRC_SetInitialData(CRC, __RBIT(crc));
+		LL_CRC_ResetCRCCalculationUnit(CRC);
+
+		n = crc32_stm32_feed(data, len);
+		crc = LL_CRC_ReadData32(CRC);
+
+		irq_unlock(key);
+
+		data += n;
+		len -= n;
+	}
+
+	return (~crc);
+}
+
+static int crc32_stm32_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+	LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+	LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+
+	return 0;
+}
+
+SYS_INIT(crc32_stm32_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -64,6 +64,11 @@
 #include <stm32l0xx_ll_adc.h>
 #endif
 
+#ifdef CONFIG_CRC32_IEEE_STM32
+#include <stm32l0xx_ll_bus.h>
+#include <stm32l0xx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32L0_SOC_H_ */
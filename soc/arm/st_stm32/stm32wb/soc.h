@@ -43,6 +43,11 @@
 #include <stm32wbxx_ll_system.h>
 #endif /* CONFIG_CLOCK_CONTROL_STM32_CUBE */
 
+#ifdef CONFIG_CRC32_IEEE_STM32
+#include <stm32wbxx_ll_bus.h>
+#include <stm32wbxx_ll_crc.h>
+#endif
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* _STM32WBX_SOC_H_ */
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <misc/__assert.h>
+#include <misc/util.h>
+#include <i2s.h>
+#include <audio/dmic.h>
+#include <audio/stream.h>
+
+#if defined(CONFIG_ARM) && defined(__ARM_FEATURE_DSP)
+#include <arch/arm/cortex_m/cmsis.h>
+#define AUDIO_USE_DSP_EXT 1
+#endif
+
+static atomic_t *audio_block_ref_get(struct audio_pool *pool, void *block)
+{
+	size_t offset = (char *)block - pool->slab->buffer;
+
+	__ASSERT(offset < pool->slab->num_blocks * pool->slab->block_size &&
+		 (offset % pool->slab->block_size) == 0U,
+		 "block %p not from pool %p", block, pool);
+
+	return &pool->refs[offset / pool->slab->block_size];
+}
+
+void *audio_block_alloc(struct audio_pool *pool, s32_t timeout)
+{
+	void *block;
+
+	if (k_mem_slab_alloc(pool->slab, &block, timeout) != 0) {
+		return NULL;
+	}
+
+	atomic_set(audio_block_ref_get(pool, block), 1);
+
+	return block;
+}
+
+void audio_block_adopt(struct audio_pool *pool, void *block)
+{
+	atomic_set(audio_block_ref_get(pool, block), 1);
+}
+
+void audio_block_ref(struct audio_pool *pool, void *block)
+{
+	atomic_inc(audio_block_ref_get(pool, block));
+}
+
+void audio_block_unref(struct audio_pool *pool, void *block)
+{
+	/* atomic_dec() returns the previous value */
+	if (atomic_dec(audio_block_ref_get(pool, block)) == 1) {
+		k_mem_slab_free(pool->slab, &block);
+	}
+}
+
+bool audio_block_shared(struct audio_pool *pool, void *block)
+{
+	return atomic_get(audio_block_ref_get(pool, block)) > 1;
+}
+
+int audio_block_writable(struct audio_pool *pool, void **block, size_t size,
+			 s32_t timeout)
+{
+	void *copy;
+
+	if (!audio_block_shared(pool, *block)) {
+		return 0;
+	}
+
+	copy = audio_block_alloc(pool, timeout);
+	if (copy == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(copy, *block, size);
+	audio_block_unref(pool, *block);
+	*block = copy;
+
+	return 0;
+}
+
+static inline s16_t audio_sat16(s32_t val)
+{
+#ifdef AUDIO_USE_DSP_EXT
+	return (s16_t)__SSAT(val, 16);
+#else
+	return (s16_t)MIN(MAX(val, -32768), 32767);
+#endif
+}
+
+void audio_mix_s16(s16_t *dst, const s16_t *src, size_t samples)
+{
+#ifdef AUDIO_USE_DSP_EXT
+	/* two samples per saturating SIMD add on word aligned buffers */
+	if ((((uintptr_t)dst | (uintptr_t)src) & 0x3) == 0U) {
+		u32_t *dst32 = (u32_t *)dst;
+		const u32_t *src32 = (const u32_t *)src;
+		size_t i;
+
+		for (i = 0; i < samples / 2U; i++) {
+			dst32[i] = __QADD16(dst32[i], src32[i]);
+		}
+
+		dst += i * 2U;
+		src += i * 2U;
+		samples -= i * 2U;
+	}
+#endif
+
+	while (samples-- > 0) {
+		*dst = audio_sat16((s32_t)*dst + *src++);
+		dst++;
+	}
+}
+
+void audio_gain_s16(s16_t *buf, size_t samples, u16_t gain)
+{
+	while (samples-- > 0) {
+		*buf = audio_sat16(((s32_t)*buf * gain) >> 12);
+		buf++;
+	}
+}
+
+int audio_resampler_init(struct audio_resampler *rs, u32_t in_rate,
+			 u32_t out_rate, u8_t channels)
+{
+	u64_t step;
+
+	if (in_rate == 0U || out_rate == 0U || channels == 0U ||
+	    channels > AUDIO_RESAMPLE_CHANNELS_MAX) {
+		return -EINVAL;
+	}
+
+	/* ratios from 1/65536 up to 256 */
+	step = ((u64_t)in_rate << 16) / out_rate;
+	if (step == 0U || step >= (256ULL << 16)) {
+		return -EINVAL;
+	}
+
+	rs->step = (u32_t)step;
+	rs->phase = 0U;
+	rs->channels = channels;
+	(void)memset(rs->last, 0, sizeof(rs->last));
+
+	return 0;
+}
+
+size_t audio_resample_s16(struct audio_resampler *rs, const s16_t *in,
+			  size_t in_frames, s16_t *out, size_t out_frames)
+{
+	u8_t ch = rs->channels;
+	size_t n = 0;
+	size_t i;
+	u32_t frac;
+	s32_t a, b;
+	u8_t c;
+
+	if (in_frames == 0U) {
+		return 0;
+	}
+
+	/* frame 0 is the last frame of the previous call, i + 1 is in[i] */
+	while ((rs->phase >> 16) < in_frames && n < out_frames) {
+		i = rs->phase >> 16;
+		frac = rs->phase & 0xFFFF;
+
+		for (c = 0U; c < ch; c++) {
+			a = (i == 0U) ? rs->last[c] : in[(i - 1) * ch + c];
+			b = in[i * ch + c];
+			*out++ = (s16_t)(a + (((b - a) * (s32_t)frac) >> 16));
+		}
+
+		rs->phase += rs->step;
+		n++;
+	}
+
+	/* frames not fitting in out are dropped */
+	if (n == out_frames) {
+		rs->phase = MAX(rs->phase, (u32_t)in_frames << 16);
+	}
+
+	rs->phase -= (u32_t)in_frames << 16;
+	for (c = 0U; c < ch; c++) {
+		rs->last[c] = in[(in_frames - 1) * ch + c];
+	}
+
+	return n;
+}
+
+static int audio_gain_process(struct audio_node *node, void **block,
+			      size_t *size)
+{
+	struct audio_gain_node *gn = CONTAINER_OF(node, struct audio_gain_node,
+						  node);
+	int ret;
+
+	if (gn->gain == AUDIO_GAIN_UNITY) {
+		return 0;
+	}
+
+	ret = audio_block_writable(node->pool, block, *size, K_NO_WAIT);
+	if (ret != 0) {
+		return ret;
+	}
+
+	audio_gain_s16(*block, *size / sizeof(s16_t), gn->gain);
+
+	return 0;
+}
+
+void audio_gain_node_init(struct audio_gain_node *gn, struct audio_pool *pool,
+			  u16_t gain)
+{
+	gn->node.process = audio_gain_process;
+	gn->node.pool = pool;
+	gn->gain = gain;
+}
+
+static int audio_mix_process(struct audio_node *node, void **block,
+			     size_t *size)
+{
+	struct audio_mix_node *mn = CONTAINER_OF(node, struct audio_mix_node,
+						 node);
+	void *other;
+	int ret;
+
+	if (k_msgq_get(mn->queue, &other, K_NO_WAIT) != 0) {
+		return 0;
+	}
+
+	ret = audio_block_writable(node->pool, block, *size, K_NO_WAIT);
+	if (ret == 0) {
+		audio_mix_s16(*block, other, *size / sizeof(s16_t));
+	}
+
+	audio_block_unref(node->pool, other);
+
+	return ret;
+}
+
+void audio_mix_node_init(struct audio_mix_node *mn, struct audio_pool *pool,
+			 struct k_msgq *queue)
+{
+	mn->node.process = audio_mix_process;
+	mn->node.pool = pool;
+	mn->queue = queue;
+}
+
+int audio_mix_node_feed(struct audio_mix_node *mn, void *block)
+{
+	int ret;
+
+	ret = k_msgq_put(mn->queue, &block, K_NO_WAIT);
+	if (ret != 0) {
+		audio_block_unref(mn->node.pool, block);
+	}
+
+	return ret;
+}
+
+static int audio_resample_process(struct audio_node *node, void **block,
+				  size_t *size)
+{
+	struct audio_resample_node *rn =
+		CONTAINER_OF(node, struct audio_resample_node, node);
+	size_t frame_size = rn->rs.channels * sizeof(s16_t);
+	void *out;
+	size_t n;
+
+	out = audio_block_alloc(node->pool, K_NO_WAIT);
+	if (out == NULL) {
+		return -ENOMEM;
+	}
+
+	n = audio_resample_s16(&rn->rs, *block, *size / frame_size, out,
+			       node->pool->slab->block_size / frame_size);
+
+	audio_block_unref(node->pool, *block);
+	*block = out;
+	*size = n * frame_size;
+
+	return 0;
+}
+
+int audio_resample_node_init(struct audio_resample_node *rn,
+			     struct audio_pool *pool, u32_t in_rate,
+			     u32_t out_rate, u8_t channels)
+{
+	rn->node.process = audio_resample_process;
+	rn->node.pool = pool;
+
+	return audio_resampler_init(&rn->rs, in_rate, out_rate, channels);
+}
+
+int audio_pipeline_process(struct audio_node *const *nodes, size_t num_nodes,
+			   void **block, size_t *size)
+{
+	size_t i;
+	int ret;
+
+	for (i = 0; i < num_nodes; i++) {
+		ret = nodes[i]->process(nodes[i], block, size);
+		if (ret != 0) {
+			audio_block_unref(nodes[i]->pool, *block);
+			*block = NULL;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int audio_dmic_read(struct device *dmic, u8_t stream, struct audio_pool *pool,
+		    void **block, size_t *size, s32_t timeout)
+{
+	int ret;
+
+	ret = dmic_read(dmic, stream, block, size, timeout);
+	if (ret == 0) {
+		audio_block_adopt(pool, *block);
+	}
+
+	return ret;
+}
+
+int audio_i2s_read(struct device *i2s, struct audio_pool *pool, void **block,
+		   size_t *size)
+{
+	int ret;
+
+	ret = i2s_read(i2s, block, size);
+	if (ret == 0) {
+		audio_block_adopt(pool, *block);
+	}
+
+	return ret;
+}
+
+int audio_i2s_write(struct device *i2s, struct audio_pool *pool, void *block,
+		    size_t size)
+{
+	int ret;
+
+	ret = audio_block_writable(pool, &block, size, K_NO_WAIT);
+	if (ret != 0) {
+		audio_block_unref(pool, block);
+		return ret;
+	}
+
+	/* the driver frees the block to the slab once sent */
+	ret = i2s_write(i2s, block, size);
+	if (ret != 0) {
+		audio_block_unref(pool, block);
+	}
+
+	return ret;
+}
@@ -5,6 +5,7 @@
  */
 
 #include <soc.h>
+#include <random/rand32.h>
 
 #define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
 #define LOG_MODULE_NAME bt_ctlr_crypto
@@ -14,6 +15,9 @@
 
 int bt_rand(void *buf, size_t len)
 {
+#if defined(CONFIG_CSPRNG_ENABLED)
+	return sys_csrand_get(buf, len);
+#else
 	u8_t *buf8 = buf;
 
 	while (len) {
@@ -31,6 +35,7 @@ int bt_rand(void *buf, size_t len)
 	}
 
 	return 0;
+#endif
 }
 
 int bt_encrypt_le(const u8_t key[16], const u8_t plaintext[16],
@@ -59,12 +59,20 @@
 static u16_t _opcode;
 
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
+#define DUP_IDX_NONE 0xFFFF
+
 /* Scan duplicate filter */
 struct dup {
 	u8_t         mask;
 	bt_addr_le_t addr;
+	u16_t        next;
+#if defined(CONFIG_BT_CTLR_DUP_FILTER_AGE)
+	u32_t        timestamp;
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_AGE */
 };
 static struct dup dup_filter[CONFIG_BT_CTLR_DUP_FILTER_LEN];
+/* Heads of the per-bucket chains of entries in dup_filter */
+static u16_t dup_hash[CONFIG_BT_CTLR_DUP_FILTER_LEN];
 static s32_t dup_count;
 static u32_t dup_curr;
 #endif
@@ -1043,6 +1051,7 @@ static void le_set_scan_enable(struct net_buf *buf, struct net_buf **evt)
 	if (cmd->enable && cmd->filter_dup) {
 		dup_count = 0;
 		dup_curr = 0U;
+		(void)memset(dup_hash, 0xFF, sizeof(dup_hash));
 	} else {
 		dup_count = -1;
 	}
@@ -1843,6 +1852,10 @@ static void vs_read_supported_commands(struct net_buf *buf,
 	/* Read Static Addresses, Read Key Hierarchy Roots */
 	rp->commands[1] |= BIT(0) | BIT(1);
 #endif /* CONFIG_BT_HCI_VS_EXT */
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	/* Read Controller Profile */
+	rp->commands[1] |= BIT(5);
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 }
 
 static void vs_read_supported_features(struct net_buf *buf,
@@ -1976,6 +1989,32 @@ static void vs_read_key_hierarchy_roots(struct net_buf *buf,
 }
 #endif /* CONFIG_BT_HCI_VS_EXT */
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+static void vs_read_ctlr_prof(struct net_buf *buf, struct net_buf **evt)
+{
+	struct bt_hci_cp_vs_read_ctlr_prof *cmd = (void *)buf->data;
+	struct bt_hci_rp_vs_read_ctlr_prof *rp;
+	u32_t events, radio_us, aborted, skipped;
+	u8_t role;
+
+	rp = hci_cmd_complete(evt, sizeof(*rp));
+	rp->status = 0x00;
+
+	for (role = 0U; role < BT_HCI_VS_PROF_ROLE_COUNT; role++) {
+		ll_prof_role_get(role, &events, &radio_us, &aborted, &skipped,
+				 cmd->reset);
+
+		rp->role[role].events = sys_cpu_to_le32(events);
+		rp->role[role].radio_us = sys_cpu_to_le32(radio_us);
+		rp->role[role].aborted = sys_cpu_to_le32(aborted);
+		rp->role[role].skipped = sys_cpu_to_le32(skipped);
+	}
+
+	ll_prof_queue_get(rp->mayfly_max, &rp->prep_max, &rp->tx_ack_max,
+			  &rp->done_free_min, &rp->rx_free_min, cmd->reset);
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 static void mesh_get_opts(struct net_buf *buf, struct net_buf **evt)
 {
@@ -2162,6 +2201,12 @@ int hci_vendor_cmd_handle_common(u16_t ocf, struct net_buf *cmd,
 		break;
 #endif /* CONFIG_BT_HCI_VS_EXT */
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	case BT_OCF(BT_HCI_OP_VS_READ_CTLR_PROF):
+		vs_read_ctlr_prof(cmd, evt);
+		break;
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 	case BT_OCF(BT_HCI_OP_VS_MESH):
 		mesh_cmd_handle(cmd, evt);
@@ -2274,6 +2319,39 @@ static void data_buf_overflow(struct net_buf **buf)
 	ep->link_type = BT_OVERFLOW_LINK_ACL;
 }
 
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY)
+/* An in place data PDU is laid out in the headroom of the host buffer:
+ * the owning net_buf pointer, the node_tx link and the PDU header, with
+ * the L2CAP payload left where the host put it.
+ */
+static struct node_tx *acl_tx_node_in_place(struct net_buf *buf)
+{
+	struct net_buf **owner;
+	struct node_tx *node_tx;
+	u8_t *pdu;
+
+	pdu = buf->data - offsetof(struct pdu_data, lldata);
+	node_tx = (void *)(pdu - offsetof(struct node_tx, pdu));
+	owner = (void *)((u8_t *)node_tx - sizeof(*owner));
+
+	if ((u8_t *)owner < buf->__buf ||
+	    ((uintptr_t)owner & (sizeof(void *) - 1))) {
+		return NULL;
+	}
+
+	*owner = net_buf_ref(buf);
+
+	return node_tx;
+}
+
+void ll_tx_mem_ext_release(void *node_tx)
+{
+	struct net_buf **owner = (struct net_buf **)node_tx - 1;
+
+	net_buf_unref(*owner);
+}
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY */
+
 int hci_acl_handle(struct net_buf *buf, struct net_buf **evt)
 {
 	struct node_tx *node_tx;
@@ -2303,22 +2381,33 @@ int hci_acl_handle(struct net_buf *buf, struct net_buf **evt)
 	flags = bt_acl_flags(handle);
 	handle = bt_acl_handle(handle);
 
-	node_tx = ll_tx_mem_acquire();
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY)
+	node_tx = acl_tx_node_in_place(buf);
+#else
+	node_tx = NULL;
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY */
 	if (!node_tx) {
-		BT_ERR("Tx Buffer Overflow");
-		data_buf_overflow(evt);
-		return -ENOBUFS;
+		node_tx = ll_tx_mem_acquire();
+		if (!node_tx) {
+			BT_ERR("Tx Buffer Overflow");
+			data_buf_overflow(evt);
+			return -ENOBUFS;
+		}
+
+		pdu_data = (void *)node_tx->pdu;
+		memcpy(&pdu_data->lldata[0], buf->data, len);
 	}
 
 	pdu_data = (void *)node_tx->pdu;
 
+	/* host memory carries no LL state, start from a clean header */
+	(void)memset(pdu_data, 0, offsetof(struct pdu_data, lldata));
 	if (flags == BT_ACL_START_NO_FLUSH || flags == BT_ACL_START) {
 		pdu_data->ll_id = PDU_DATA_LLID_DATA_START;
 	} else {
 		pdu_data->ll_id = PDU_DATA_LLID_DATA_CONTINUE;
 	}
 	pdu_data->len = len;
-	memcpy(&pdu_data->lldata[0], buf->data, len);
 
 	if (ll_tx_mem_enqueue(handle, node_tx)) {
 		BT_ERR("Invalid Tx Enqueue");
@@ -2331,26 +2420,67 @@ int hci_acl_handle(struct net_buf *buf, struct net_buf **evt)
 #endif /* CONFIG_BT_CONN */
 
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
+static inline u16_t dup_hash_get(u8_t const *const addr, u8_t type)
+{
+	/* The least significant octets of both public and random device
+	 * addresses are well spread, use them as is.
+	 */
+	return (sys_get_le32(addr) ^ type) % CONFIG_BT_CTLR_DUP_FILTER_LEN;
+}
+
+static void dup_unlink(u16_t idx)
+{
+	struct dup *dup = &dup_filter[idx];
+	u16_t *p;
+
+	p = &dup_hash[dup_hash_get(&dup->addr.a.val[0], dup->addr.type)];
+	while (*p != idx) {
+		p = &dup_filter[*p].next;
+	}
+
+	*p = dup->next;
+}
+
 static inline bool dup_found(struct pdu_adv *adv)
 {
 	/* check for duplicate filtering */
 	if (dup_count >= 0) {
-		int i;
-
-		for (i = 0; i < dup_count; i++) {
-			if (!memcmp(&adv->adv_ind.addr[0],
-				    &dup_filter[i].addr.a.val[0],
-				    sizeof(bt_addr_t)) &&
-			    adv->tx_addr == dup_filter[i].addr.type) {
-
-				if (dup_filter[i].mask & BIT(adv->type)) {
-					/* duplicate found */
-					return true;
-				}
-				/* report different adv types */
-				dup_filter[i].mask |= BIT(adv->type);
-				return false;
+		u16_t hash;
+		u16_t i;
+
+		hash = dup_hash_get(&adv->adv_ind.addr[0], adv->tx_addr);
+
+		for (i = dup_hash[hash]; i != DUP_IDX_NONE;
+		     i = dup_filter[i].next) {
+			struct dup *dup = &dup_filter[i];
+
+			if (memcmp(&adv->adv_ind.addr[0], &dup->addr.a.val[0],
+				   sizeof(bt_addr_t)) ||
+			    adv->tx_addr != dup->addr.type) {
+				continue;
+			}
+
+#if defined(CONFIG_BT_CTLR_DUP_FILTER_AGE)
+			/* report again once the entry has aged out */
+			if ((k_uptime_get_32() - dup->timestamp) >
+			    CONFIG_BT_CTLR_DUP_FILTER_AGE) {
+				dup->timestamp = k_uptime_get_32();
+				dup->mask = 0U;
+			}
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_AGE */
+
+			if (dup->mask & BIT(adv->type)) {
+				/* duplicate found */
+				return true;
 			}
+			/* report different adv types */
+			dup->mask |= BIT(adv->type);
+			return false;
+		}
+
+		/* evict the oldest entry if the filter is full */
+		if (dup_count == CONFIG_BT_CTLR_DUP_FILTER_LEN) {
+			dup_unlink(dup_curr);
 		}
 
 		/* insert into the duplicate filter */
@@ -2358,6 +2488,12 @@ static inline bool dup_found(struct pdu_adv *adv)
 		       &adv->adv_ind.addr[0], sizeof(bt_addr_t));
 		dup_filter[dup_curr].addr.type = adv->tx_addr;
 		dup_filter[dup_curr].mask = BIT(adv->type);
+#if defined(CONFIG_BT_CTLR_DUP_FILTER_AGE)
+		dup_filter[dup_curr].timestamp = k_uptime_get_32();
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_AGE */
+
+		dup_filter[dup_curr].next = dup_hash[hash];
+		dup_hash[hash] = dup_curr;
 
 		if (dup_count < CONFIG_BT_CTLR_DUP_FILTER_LEN) {
 			dup_count++;
@@ -3081,13 +3217,15 @@ static void encode_control(struct node_rx_pdu *node_rx,
 
 #if defined(CONFIG_BT_CTLR_PROFILE_ISR)
 	case NODE_RX_TYPE_PROFILE:
-		BT_INFO("l: %d, %d, %d; t: %d, %d, %d.",
+		BT_INFO("l: %d, %d, %d; t: %d, %d, %d; j: %d, %d.",
 			pdu_data->profile.lcur,
 			pdu_data->profile.lmin,
 			pdu_data->profile.lmax,
 			pdu_data->profile.cur,
 			pdu_data->profile.min,
-			pdu_data->profile.max);
+			pdu_data->profile.max,
+			pdu_data->profile.tcur,
+			pdu_data->profile.tmax);
 		return;
 #endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 
@@ -3305,6 +3443,33 @@ static void encode_data_ctrl(struct node_rx_pdu *node_rx,
 }
 
 #if defined(CONFIG_BT_CONN)
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY)
+void hci_acl_encode_in_place(struct node_rx_pdu *node_rx)
+{
+	struct pdu_data *pdu_data = (void *)node_rx->pdu;
+	struct bt_hci_acl_hdr *acl;
+	u16_t handle_flags;
+	u8_t len;
+
+	if (pdu_data->ll_id == PDU_DATA_LLID_DATA_START) {
+		handle_flags = bt_acl_handle_pack(node_rx->hdr.handle,
+						  BT_ACL_START);
+	} else {
+		LL_ASSERT(pdu_data->ll_id == PDU_DATA_LLID_DATA_CONTINUE);
+		handle_flags = bt_acl_handle_pack(node_rx->hdr.handle,
+						  BT_ACL_CONT);
+	}
+	len = pdu_data->len;
+
+	/* The ACL header overwrites the PDU header and the tail of the rx
+	 * footer, neither is used once the node has been dequeued.
+	 */
+	acl = (void *)(pdu_data->lldata - sizeof(*acl));
+	acl->handle = sys_cpu_to_le16(handle_flags);
+	acl->len = sys_cpu_to_le16(len);
+}
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY */
+
 void hci_acl_encode(struct node_rx_pdu *node_rx, struct net_buf *buf)
 {
 	struct bt_hci_acl_hdr *acl;
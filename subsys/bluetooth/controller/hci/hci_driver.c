@@ -21,6 +21,7 @@
 #include <misc/byteorder.h>
 
 #include <bluetooth/bluetooth.h>
+#include <bluetooth/buf.h>
 #include <bluetooth/hci.h>
 #include <drivers/bluetooth/hci_driver.h>
 
@@ -70,6 +71,63 @@ static sys_slist_t hbuf_pend;
 static s32_t hbuf_count;
 #endif
 
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY) && \
+	!defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL)
+#define ACL_RX_IN_PLACE 1
+
+/* rx node held by each buffer of acl_rx_pool, its data is the node itself */
+static struct node_rx_pdu *acl_rx_node[CONFIG_BT_CTLR_RX_BUFFERS];
+
+static void acl_rx_destroy(struct net_buf *buf)
+{
+	struct node_rx_pdu *node_rx = acl_rx_node[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+
+	/* The host lets go of buffers from any thread, keep the release
+	 * from being preempted by recv_thread() doing the same.
+	 */
+	k_sched_lock();
+	node_rx->hdr.next = NULL;
+	ll_rx_mem_release((void **)&node_rx);
+	k_sched_unlock();
+}
+
+NET_BUF_POOL_DEFINE(acl_rx_pool, CONFIG_BT_CTLR_RX_BUFFERS, 0,
+		    BT_BUF_USER_DATA_MIN, acl_rx_destroy);
+
+static struct net_buf *acl_rx_in_place(struct node_rx_pdu *node_rx)
+{
+	struct pdu_data *pdu_data = (void *)node_rx->pdu;
+	struct net_buf *buf;
+
+	/* The host appends continuation fragments to the first one, only
+	 * PDUs carrying a complete L2CAP frame (4 octet basic header and
+	 * payload) can be passed up without tailroom.
+	 */
+	if (pdu_data->ll_id != PDU_DATA_LLID_DATA_START ||
+	    pdu_data->len < 4 ||
+	    sys_get_le16(&pdu_data->lldata[0]) + 4 != pdu_data->len) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(&acl_rx_pool,
+				      pdu_data->lldata -
+				      sizeof(struct bt_hci_acl_hdr),
+				      sizeof(struct bt_hci_acl_hdr) +
+				      pdu_data->len, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	acl_rx_node[net_buf_id(buf)] = node_rx;
+	bt_buf_set_type(buf, BT_BUF_ACL_IN);
+	hci_acl_encode_in_place(node_rx);
+
+	return buf;
+}
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY && !CONFIG_BT_HCI_ACL_FLOW_CONTROL */
+
 /**
  * @brief Handover from Controller thread to Host thread
  * @details Execution context: Controller thread
@@ -155,6 +213,14 @@ static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 		break;
 #if defined(CONFIG_BT_CONN)
 	case HCI_CLASS_ACL_DATA:
+#if defined(ACL_RX_IN_PLACE)
+		/* hand the node up as is, it is released with the buffer */
+		buf = acl_rx_in_place(node_rx);
+		if (buf) {
+			return buf;
+		}
+#endif /* ACL_RX_IN_PLACE */
+
 		/* generate ACL data */
 		buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
 		hci_acl_encode(node_rx, buf);
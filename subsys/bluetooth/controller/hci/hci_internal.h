@@ -34,6 +34,9 @@ s8_t hci_get_class(struct node_rx_pdu *node_rx);
 #if defined(CONFIG_BT_CONN)
 int hci_acl_handle(struct net_buf *acl, struct net_buf **evt);
 void hci_acl_encode(struct node_rx_pdu *node_rx, struct net_buf *buf);
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY)
+void hci_acl_encode_in_place(struct node_rx_pdu *node_rx);
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY */
 void hci_num_cmplt_encode(struct net_buf *buf, u16_t handle, u8_t num);
 #endif
 int hci_vendor_cmd_handle(u16_t ocf, struct net_buf *cmd,
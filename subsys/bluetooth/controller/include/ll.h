@@ -86,6 +86,9 @@ void ll_tx_pwr_get(s8_t *min, s8_t *max);
 
 u8_t ll_apto_get(u16_t handle, u16_t *apto);
 u8_t ll_apto_set(u16_t handle, u16_t apto);
+u8_t ll_link_policy_stats_get(u16_t handle, u32_t *events,
+			      u32_t *crc_err_events, u16_t *phy_updates,
+			      u16_t *length_updates);
 
 u32_t ll_length_req_send(u16_t handle, u16_t tx_octets, u16_t tx_time);
 void ll_length_default_get(u16_t *max_tx_octets, u16_t *max_tx_time);
@@ -101,6 +104,12 @@ u8_t ll_phy_req_send(u16_t handle, u8_t tx, u8_t flags, u8_t rx);
 void *ll_tx_mem_acquire(void);
 void ll_tx_mem_release(void *node_tx);
 int ll_tx_mem_enqueue(u16_t handle, void *node_tx);
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY)
+/* Provided by the HCI glue, releases a node_tx that was not acquired from
+ * the LL but laid out in the memory of the host buffer.
+ */
+void ll_tx_mem_ext_release(void *node_tx);
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY */
 
 /* Upstream - Num. Completes, Events and Data */
 u8_t ll_rx_get(void **node_rx, u16_t *handle);
@@ -111,3 +120,11 @@ void ll_rx_mem_release(void **node_rx);
 void ll_timeslice_ticker_id_get(u8_t * const instance_index, u8_t * const user_id);
 void ll_radio_state_abort(void);
 u32_t ll_radio_state_is_idle(void);
+
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+/* Profiling */
+void ll_prof_role_get(u8_t role, u32_t *events, u32_t *radio_us,
+		      u32_t *aborted, u32_t *skipped, u8_t reset);
+void ll_prof_queue_get(u8_t *mayfly_max, u8_t *prep_max, u8_t *tx_ack_max,
+		       u8_t *done_free_min, u8_t *rx_free_min, u8_t reset);
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
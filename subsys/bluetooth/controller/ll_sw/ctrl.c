@@ -3670,8 +3670,10 @@ static inline void isr_rx_conn(u8_t crc_ok, u8_t trx_done,
 	static u8_t s_lprv;
 	static u8_t s_max;
 	static u8_t s_prv;
+	static u32_t s_tmax;
 
 	u8_t latency, elapsed, prv;
+	u32_t t_cur, t_max;
 	u32_t radio_tmr_end = 0U;
 	u32_t sample;
 	u8_t chg = 0U;
@@ -3935,6 +3937,13 @@ isr_rx_conn_terminate_exit:
 		chg = 1U;
 	}
 
+	/* check for change in worst-case ticker job duration */
+	ticker_job_prof_get(RADIO_TICKER_INSTANCE_ID_RADIO, &t_cur, &t_max);
+	if (t_max != s_tmax) {
+		s_tmax = t_max;
+		chg = 1U;
+	}
+
 	/* generate event if any change */
 	if (chg) {
 		/* NOTE: enqueue only if rx buffer available, else ignore */
@@ -3949,6 +3958,8 @@ isr_rx_conn_terminate_exit:
 			pdu_data_rx->profile.cur = elapsed;
 			pdu_data_rx->profile.min = s_min;
 			pdu_data_rx->profile.max = s_max;
+			pdu_data_rx->profile.tcur = HAL_TICKER_TICKS_TO_US(t_cur);
+			pdu_data_rx->profile.tmax = HAL_TICKER_TICKS_TO_US(t_max);
 			packet_rx_enqueue();
 		}
 	}
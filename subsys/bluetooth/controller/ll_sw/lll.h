@@ -290,6 +290,23 @@ void lll_resume(void *param);
 void lll_disable(void *param);
 u32_t lll_radio_is_idle(void);
 
+enum {
+	LLL_PROF_ROLE_ADV,
+	LLL_PROF_ROLE_SCAN,
+	LLL_PROF_ROLE_CONN,
+
+	LLL_PROF_ROLE_COUNT
+};
+
+struct lll_prof_role {
+	u32_t events;   /* Events started */
+	u32_t radio_us; /* Time from event start until event done */
+	u32_t aborted;  /* Events aborted while in progress */
+	u32_t skipped;  /* Prepares cancelled before start (overruns) */
+};
+
+void lll_prof_role_get(u8_t role, struct lll_prof_role *stats, u8_t reset);
+
 int ull_prepare_enqueue(lll_is_abort_cb_t is_abort_cb,
 			       lll_abort_cb_t abort_cb,
 			       struct lll_prepare_param *prepare_param,
@@ -38,7 +38,7 @@ const u32_t z_bt_ctlr_used_nrf_ppi_groups   = HAL_USED_PPI_GROUPS;
 static radio_isr_cb_t isr_cb;
 static void           *isr_cb_param;
 
-void isr_radio(void)
+__hotfunc(isr_radio) void isr_radio(void)
 {
 	if (radio_has_disabled()) {
 		isr_cb(isr_cb_param);
@@ -22,6 +22,7 @@
 
 #include "lll.h"
 #include "lll_internal.h"
+#include "lll_prof_internal.h"
 
 #define LOG_MODULE_NAME bt_ctlr_llsw_nordic_lll
 #include "common/log.h"
@@ -254,6 +255,10 @@ int lll_done(void *param)
 		param = event.curr.param;
 		event.curr.param = NULL;
 
+		if (IS_ENABLED(CONFIG_BT_CTLR_PROFILE_ISR)) {
+			lll_prof_role_done();
+		}
+
 		if (param) {
 			ull = HDR_ULL(((struct lll_hdr *)param)->parent);
 		}
@@ -40,6 +40,7 @@ static void isr_race(void *param);
 static int isr_rx_pdu(struct lll_conn *lll, struct pdu_data *pdu_data_rx,
 		      struct node_tx **tx_release, u8_t *is_rx_enqueue);
 static struct pdu_data *empty_tx_enqueue(struct lll_conn *lll);
+static bool is_next_prepare_pending(void);
 
 static u16_t const sca_ppm_lut[] = {500, 250, 150, 100, 75, 50, 30, 20};
 static u8_t crc_expire;
@@ -110,6 +111,10 @@ void lll_conn_abort_cb(struct lll_prepare_param *prepare_param, void *param)
 {
 	int err;
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_PROFILE_ISR)) {
+		lll_prof_role_abort(LLL_PROF_ROLE_CONN, !prepare_param);
+	}
+
 	/* NOTE: This is not a prepare being cancelled */
 	if (!prepare_param) {
 		/* Perform event abort here.
@@ -215,6 +220,16 @@ void lll_conn_isr_rx(void *param)
 	is_done = is_crc_backoff || ((crc_ok) && (pdu_data_rx->md == 0) &&
 				     (pdu_data_tx->len == 0));
 
+	/* The event is extended into free air time as long as more data is
+	 * exchanged, close it once the next radio event is in the prepare
+	 * pipeline instead of having it aborted by the preempt timeout.
+	 */
+	if (!is_done && is_next_prepare_pending()) {
+		/* slave tells the master not to expect another PDU */
+		pdu_data_tx->md = 0U;
+		is_done = 1U;
+	}
+
 	if (is_done) {
 		radio_isr_set(isr_done, param);
 
@@ -615,6 +630,23 @@ static int init_reset(void)
 	return 0;
 }
 
+static bool is_next_prepare_pending(void)
+{
+	struct lll_event *next;
+	u8_t idx = UINT8_MAX;
+
+	next = ull_prepare_dequeue_iter(&idx);
+	while (next) {
+		if (!next->is_aborted) {
+			return true;
+		}
+
+		next = ull_prepare_dequeue_iter(&idx);
+	}
+
+	return false;
+}
+
 static void isr_done(void *param)
 {
 	struct event_done_extra *e;
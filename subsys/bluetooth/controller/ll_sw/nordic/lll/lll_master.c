@@ -26,6 +26,7 @@
 
 #include "lll_internal.h"
 #include "lll_tim_internal.h"
+#include "lll_prof_internal.h"
 
 #define LOG_MODULE_NAME bt_ctlr_llsw_nordic_lll_master
 #include "common/log.h"
@@ -91,6 +92,10 @@ static int prepare_cb(struct lll_prepare_param *prepare_param)
 
 	DEBUG_RADIO_START_M(1);
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_PROFILE_ISR)) {
+		lll_prof_role_start(LLL_PROF_ROLE_CONN);
+	}
+
 	/* TODO: Do the below in ULL ?  */
 
 	lazy = prepare_param->lazy;
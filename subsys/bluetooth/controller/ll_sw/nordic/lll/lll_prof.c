@@ -4,14 +4,19 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <toolchain.h>
 #include <zephyr/types.h>
 
 #include "hal/ccm.h"
 #include "hal/radio.h"
+#include "hal/ticker.h"
 
 #include "util/memq.h"
 
+#include "ticker/ticker.h"
+
 #include "pdu.h"
 
 #include "lll.h"
@@ -22,8 +27,13 @@ static u8_t latency_prev;
 static u8_t cputime_min = (u8_t) -1;
 static u8_t cputime_max;
 static u8_t cputime_prev;
+static u32_t ticker_job_max;
 static u32_t timestamp_latency;
 
+static struct lll_prof_role role_stats[LLL_PROF_ROLE_COUNT];
+static u8_t role_curr = LLL_PROF_ROLE_COUNT;
+static u32_t role_ticks_start;
+
 void lll_prof_latency_capture(void)
 {
 	/* sample the packet timer, use it to calculate ISR latency
@@ -60,6 +70,7 @@ void lll_prof_cputime_capture(void)
 void lll_prof_send(void)
 {
 	u8_t latency, cputime, prev;
+	u32_t job_cur, job_max;
 	u8_t chg = 0U;
 
 	/* calculate the elapsed time in us since on-air radio packet end
@@ -109,6 +120,15 @@ void lll_prof_send(void)
 		chg = 1U;
 	}
 
+	/* check for change in worst-case ticker job duration, which is what
+	 * bounds the scheduling of many simultaneous links.
+	 */
+	ticker_job_prof_get(TICKER_INSTANCE_ID_CTLR, &job_cur, &job_max);
+	if (job_max != ticker_job_max) {
+		ticker_job_max = job_max;
+		chg = 1U;
+	}
+
 	/* generate event if any change */
 	if (chg) {
 		struct node_rx_pdu *rx;
@@ -132,9 +152,56 @@ void lll_prof_send(void)
 			p->cur = cputime;
 			p->min = cputime_min;
 			p->max = cputime_max;
+			p->tcur = HAL_TICKER_TICKS_TO_US(job_cur);
+			p->tmax = HAL_TICKER_TICKS_TO_US(job_max);
 
 			ull_rx_put(rx->hdr.link, rx);
 			ull_rx_sched();
 		}
 	}
 }
+
+void lll_prof_role_start(u8_t role)
+{
+	/* event is now owning the radio, time it until LLL done */
+	role_curr = role;
+	role_ticks_start = ticker_ticks_now_get();
+
+	role_stats[role].events++;
+}
+
+void lll_prof_role_done(void)
+{
+	u32_t ticks;
+
+	/* prepare cancelled before start do not own the radio */
+	if (role_curr >= LLL_PROF_ROLE_COUNT) {
+		return;
+	}
+
+	ticks = ticker_ticks_diff_get(ticker_ticks_now_get(),
+				      role_ticks_start);
+	role_stats[role_curr].radio_us += HAL_TICKER_TICKS_TO_US(ticks);
+
+	role_curr = LLL_PROF_ROLE_COUNT;
+}
+
+void lll_prof_role_abort(u8_t role, u8_t is_started)
+{
+	if (is_started) {
+		/* preempted by higher priority event while in progress */
+		role_stats[role].aborted++;
+	} else {
+		/* overrun, pipelined prepare cancelled before its start */
+		role_stats[role].skipped++;
+	}
+}
+
+void lll_prof_role_get(u8_t role, struct lll_prof_role *stats, u8_t reset)
+{
+	*stats = role_stats[role];
+
+	if (reset) {
+		(void)memset(&role_stats[role], 0, sizeof(role_stats[role]));
+	}
+}
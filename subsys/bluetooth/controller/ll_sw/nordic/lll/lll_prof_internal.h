@@ -8,3 +8,6 @@ void lll_prof_latency_capture(void);
 void lll_prof_radio_end_backup(void);
 void lll_prof_cputime_capture(void);
 void lll_prof_send(void);
+void lll_prof_role_start(u8_t role);
+void lll_prof_role_done(void);
+void lll_prof_role_abort(u8_t role, u8_t is_started);
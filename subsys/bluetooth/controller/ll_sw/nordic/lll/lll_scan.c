@@ -125,6 +125,10 @@ static int prepare_cb(struct lll_prepare_param *prepare_param)
 
 	DEBUG_RADIO_START_O(1);
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_PROFILE_ISR)) {
+		lll_prof_role_start(LLL_PROF_ROLE_SCAN);
+	}
+
 	/* Check if stopped (on connection establishment race between LLL and
 	 * ULL.
 	 */
@@ -301,6 +305,10 @@ static void abort_cb(struct lll_prepare_param *prepare_param, void *param)
 {
 	int err;
 
+	if (IS_ENABLED(CONFIG_BT_CTLR_PROFILE_ISR)) {
+		lll_prof_role_abort(LLL_PROF_ROLE_SCAN, !prepare_param);
+	}
+
 	/* NOTE: This is not a prepare being cancelled */
 	if (!prepare_param) {
 		/* Perform event abort here.
@@ -503,6 +503,8 @@ struct profile {
 	u8_t cur;
 	u8_t min;
 	u8_t max;
+	u16_t tcur;
+	u16_t tmax;
 } __packed;
 #endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 
@@ -201,6 +201,18 @@ static MFIFO_DEFINE(tx_ack, sizeof(struct lll_tx),
 
 static void *mark;
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+/* Peak occupancy of the ULL FIFOs since last read with reset */
+static struct {
+	u8_t prep_max;
+	u8_t tx_ack_max;
+	u8_t done_free_min;
+	u8_t pdu_rx_free_min;
+} prof_fifo;
+
+static inline void prof_fifo_reset(void);
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 static inline int init_reset(void);
 static inline void done_alloc(void);
 static inline void rx_alloc(u8_t max);
@@ -892,6 +904,13 @@ void ll_tx_ack_put(u16_t handle, struct node_tx *node_tx)
 	tx->node = node_tx;
 
 	MFIFO_ENQUEUE(tx_ack, idx);
+
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	idx = MFIFO_AVAIL_COUNT_GET(tx_ack);
+	if (idx > prof_fifo.tx_ack_max) {
+		prof_fifo.tx_ack_max = idx;
+	}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 }
 #endif /* CONFIG_BT_CONN */
 
@@ -913,6 +932,40 @@ void ll_radio_state_abort(void)
 	LL_ASSERT(!ret);
 }
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+void ll_prof_role_get(u8_t role, u32_t *events, u32_t *radio_us,
+		      u32_t *aborted, u32_t *skipped, u8_t reset)
+{
+	struct lll_prof_role stats;
+
+	lll_prof_role_get(role, &stats, reset);
+
+	*events = stats.events;
+	*radio_us = stats.radio_us;
+	*aborted = stats.aborted;
+	*skipped = stats.skipped;
+}
+
+void ll_prof_queue_get(u8_t *mayfly_max, u8_t *prep_max, u8_t *tx_ack_max,
+		       u8_t *done_free_min, u8_t *rx_free_min, u8_t reset)
+{
+	u8_t callee_id;
+
+	for (callee_id = 0U; callee_id < MAYFLY_CALLEE_COUNT; callee_id++) {
+		mayfly_max[callee_id] = mayfly_depth_max_get(callee_id, reset);
+	}
+
+	*prep_max = prof_fifo.prep_max;
+	*tx_ack_max = prof_fifo.tx_ack_max;
+	*done_free_min = prof_fifo.done_free_min;
+	*rx_free_min = prof_fifo.pdu_rx_free_min;
+
+	if (reset) {
+		prof_fifo_reset();
+	}
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 u32_t ll_radio_state_is_idle(void)
 {
 	return lll_radio_is_idle();
@@ -1000,7 +1053,21 @@ void *ull_pdu_rx_alloc_peek_iter(u8_t *idx)
 
 void *ull_pdu_rx_alloc(void)
 {
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	void *rx;
+	u8_t avail;
+
+	rx = MFIFO_DEQUEUE(pdu_rx_free);
+
+	avail = MFIFO_AVAIL_COUNT_GET(pdu_rx_free);
+	if (avail < prof_fifo.pdu_rx_free_min) {
+		prof_fifo.pdu_rx_free_min = avail;
+	}
+
+	return rx;
+#else /* !CONFIG_BT_CTLR_PROFILE_ISR */
 	return MFIFO_DEQUEUE(pdu_rx_free);
+#endif /* !CONFIG_BT_CTLR_PROFILE_ISR */
 }
 
 void ull_rx_put(memq_link_t *link, void *rx)
@@ -1053,6 +1120,13 @@ int ull_prepare_enqueue(lll_is_abort_cb_t is_abort_cb,
 
 	MFIFO_ENQUEUE(prep, idx);
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	idx = MFIFO_AVAIL_COUNT_GET(prep);
+	if (idx > prof_fifo.prep_max) {
+		prof_fifo.prep_max = idx;
+	}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	return 0;
 }
 
@@ -1089,6 +1163,13 @@ void *ull_event_done(void *param)
 	 * struct node_rx_event_done
 	 */
 	evdone = MFIFO_DEQUEUE(done);
+
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	if (MFIFO_AVAIL_COUNT_GET(done) < prof_fifo.done_free_min) {
+		prof_fifo.done_free_min = MFIFO_AVAIL_COUNT_GET(done);
+	}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	if (!evdone) {
 		/* Not fatal if we can not obtain node, though
 		 * we will loose the packets in software stack.
@@ -1157,9 +1238,23 @@ static inline int init_reset(void)
 	mem_link_rx.quota_pdu = RX_CNT;
 	rx_alloc(UINT8_MAX);
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	prof_fifo_reset();
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	return 0;
 }
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+static inline void prof_fifo_reset(void)
+{
+	prof_fifo.prep_max = 0U;
+	prof_fifo.tx_ack_max = 0U;
+	prof_fifo.done_free_min = UINT8_MAX;
+	prof_fifo.pdu_rx_free_min = UINT8_MAX;
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 /**
  * @brief Allocate buffers for done events
  */
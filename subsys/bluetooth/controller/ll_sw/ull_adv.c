@@ -14,6 +14,7 @@
 #include "hal/ticker.h"
 
 #include "util/util.h"
+#include "util/mem.h"
 #include "util/memq.h"
 #include "util/mayfly.h"
 
@@ -463,8 +464,15 @@ u8_t ll_adv_enable(u8_t enable)
 
 		/* AdvA, fill here at enable */
 		if (h->adv_addr) {
-			memcpy(ptr, ll_addr_get(pdu_adv->tx_addr, NULL),
-			       BDADDR_SIZE);
+			u8_t *addr = ll_addr_get(pdu_adv->tx_addr, NULL);
+
+			/* Use the random address of the set, if one was set */
+			if (pdu_adv->tx_addr &&
+			    mem_nz(adv->rnd_addr, BDADDR_SIZE)) {
+				addr = adv->rnd_addr;
+			}
+
+			memcpy(ptr, addr, BDADDR_SIZE);
 		}
 
 		/* TODO: TargetA, fill here at enable */
@@ -616,6 +624,10 @@ u8_t ll_adv_enable(u8_t enable)
 
 		conn->common.fex_valid = 0;
 
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+		(void)memset(&conn->policy, 0, sizeof(conn->policy));
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
+
 		conn->llcp_req = conn->llcp_ack = conn->llcp_type = 0;
 		conn->llcp_rx = NULL;
 		conn->llcp_features = LL_FEAT;
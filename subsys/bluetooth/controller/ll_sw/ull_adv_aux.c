@@ -22,29 +22,54 @@
 #include "ull_adv_types.h"
 #include "ull_adv_internal.h"
 
+/* TODO: secondary channel advertising. Not implemented yet are the LLL
+ * AUX_ADV_IND and AUX_CHAIN_IND events that send ad_data and sr_data, the
+ * AuxPtr offset in the primary PDU (needs the free slot scheduling that
+ * ull_sched.c stubs), and periodic advertising with SyncInfo and
+ * AUX_SYNC_IND. The HCI layer does not route the extended advertising
+ * commands here yet either.
+ */
+
+static u8_t data_frag_add(u8_t *buf, u16_t *buf_len, u8_t op, u8_t len,
+			  u8_t *data);
+static void adi_did_update(struct ll_adv_set *adv);
+
 u8_t ll_adv_aux_random_addr_set(u8_t handle, u8_t *addr)
 {
-	/* TODO: store in adv set instance */
+	struct ll_adv_set *adv;
+
+	adv = ull_adv_set_get(handle);
+	if (!adv || adv->is_enabled) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	memcpy(adv->rnd_addr, addr, BDADDR_SIZE);
+
 	return 0;
 }
 
 u8_t *ll_adv_aux_random_addr_get(u8_t handle, u8_t *addr)
 {
-	/* TODO: copy adv set instance addr into addr and/or return reference */
-	return NULL;
+	struct ll_adv_set *adv;
+
+	adv = ull_adv_set_get(handle);
+	if (!adv) {
+		return NULL;
+	}
+
+	if (addr) {
+		memcpy(addr, adv->rnd_addr, BDADDR_SIZE);
+	}
+
+	return adv->rnd_addr;
 }
 
 u8_t ll_adv_aux_ad_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 			    u8_t *data)
 {
-	struct pdu_adv_com_ext_adv *p;
 	struct ll_adv_set *adv;
-	struct ext_adv_hdr *h;
 	struct pdu_adv *prev;
-	struct pdu_adv *pdu;
-	u8_t idx;
-
-	/* TODO: */
+	u8_t err;
 
 	adv = ull_adv_set_get(handle);
 	if (!adv) {
@@ -57,17 +82,25 @@ u8_t ll_adv_aux_ad_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 		return 0;
 	}
 
-	pdu = lll_adv_data_alloc(&adv->lll, &idx);
-	p = (void *)&pdu->adv_ext_ind;
-	h = (void *)p->ext_hdr_adi_adv_data;
+	/* Only complete data can be changed while advertising */
+	if (adv->is_enabled && (op != BT_HCI_LE_EXT_ADV_OP_COMPLETE_DATA) &&
+	    (op != BT_HCI_LE_EXT_ADV_OP_UNCHANGED_DATA)) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
 
-	if (!h->aux_ptr) {
-		if (!len) {
-			return 0;
-		}
+	err = data_frag_add(adv->ad_data, &adv->ad_data_len, op, len, data);
+	if (err) {
+		return err;
 	}
 
-	lll_adv_data_enqueue(&adv->lll, idx);
+	/* A new Advertising Data ID tells scanners the data has changed,
+	 * also when the host asked for it with unchanged data.
+	 */
+	if ((op == BT_HCI_LE_EXT_ADV_OP_LAST_FRAG) ||
+	    (op == BT_HCI_LE_EXT_ADV_OP_COMPLETE_DATA) ||
+	    (op == BT_HCI_LE_EXT_ADV_OP_UNCHANGED_DATA)) {
+		adi_did_update(adv);
+	}
 
 	return 0;
 }
@@ -75,32 +108,155 @@ u8_t ll_adv_aux_ad_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 u8_t ll_adv_aux_sr_data_set(u8_t handle, u8_t op, u8_t frag_pref, u8_t len,
 			    u8_t *data)
 {
-	/* TODO: */
-	return 0;
+	struct ll_adv_set *adv;
+
+	adv = ull_adv_set_get(handle);
+	if (!adv) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	/* Unchanged data is not allowed for scan response data */
+	if (op == BT_HCI_LE_EXT_ADV_OP_UNCHANGED_DATA) {
+		return BT_HCI_ERR_INVALID_PARAM;
+	}
+
+	if (adv->is_enabled && (op != BT_HCI_LE_EXT_ADV_OP_COMPLETE_DATA)) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	return data_frag_add(adv->sr_data, &adv->sr_data_len, op, len, data);
 }
 
 u16_t ll_adv_aux_max_data_length_get(void)
 {
-	/* TODO: return a Kconfig value */
+	/* TODO: return ULL_ADV_AUX_DATA_LEN_MAX once the AUX_ADV_IND and
+	 * AUX_CHAIN_IND radio events transmit the set data. Until then none
+	 * of it goes on air, so do not let the host count on it.
+	 */
 	return 0;
 }
 
 u8_t ll_adv_aux_set_count_get(void)
 {
-	/*  TODO: return a Kconfig value */
-	return 0;
+	return BT_CTLR_ADV_MAX;
 }
 
 u8_t ll_adv_aux_set_remove(u8_t handle)
 {
-	/* TODO: reset/release primary channel and Aux channel PDUs */
+	struct ll_adv_set *adv;
+	struct pdu_adv *pdu;
+
+	adv = ull_adv_set_get(handle);
+	if (!adv || adv->is_enabled) {
+		return BT_HCI_ERR_CMD_DISALLOWED;
+	}
+
+	adv->ad_data_len = 0U;
+	adv->sr_data_len = 0U;
+	(void)memset(adv->rnd_addr, 0, BDADDR_SIZE);
+
+	/* Back to an empty primary channel PDU, set up again by the next
+	 * parameter set.
+	 */
+	pdu = lll_adv_data_peek(&adv->lll);
+	pdu->len = 0U;
+	pdu = lll_adv_scan_rsp_peek(&adv->lll);
+	pdu->len = 0U;
+
 	return 0;
 }
 
 u8_t ll_adv_aux_set_clear(void)
 {
-	/* TODO: reset/release all adv set primary channel and  Aux channel
-	 * PDUs
-	 */
+	u8_t handle;
+
+	/* Sets can only be cleared when none of them is advertising */
+	for (handle = 0U; handle < BT_CTLR_ADV_MAX; handle++) {
+		if (ull_adv_is_enabled(handle)) {
+			return BT_HCI_ERR_CMD_DISALLOWED;
+		}
+	}
+
+	for (handle = 0U; handle < BT_CTLR_ADV_MAX; handle++) {
+		(void)ll_adv_aux_set_remove(handle);
+	}
+
 	return 0;
 }
+
+static u8_t data_frag_add(u8_t *buf, u16_t *buf_len, u8_t op, u8_t len,
+			  u8_t *data)
+{
+	u16_t offset;
+
+	switch (op) {
+	case BT_HCI_LE_EXT_ADV_OP_INTERM_FRAG:
+	case BT_HCI_LE_EXT_ADV_OP_LAST_FRAG:
+		offset = *buf_len;
+		break;
+
+	case BT_HCI_LE_EXT_ADV_OP_FIRST_FRAG:
+	case BT_HCI_LE_EXT_ADV_OP_COMPLETE_DATA:
+		offset = 0U;
+		break;
+
+	case BT_HCI_LE_EXT_ADV_OP_UNCHANGED_DATA:
+		if (len) {
+			return BT_HCI_ERR_INVALID_PARAM;
+		}
+		return 0;
+
+	default:
+		return BT_HCI_ERR_INVALID_PARAM;
+	}
+
+	if ((offset + len) > ULL_ADV_AUX_DATA_LEN_MAX) {
+		/* Drop the partial data, the host starts over */
+		*buf_len = 0U;
+
+		return BT_HCI_ERR_MEM_CAPACITY_EXCEEDED;
+	}
+
+	memcpy(&buf[offset], data, len);
+	*buf_len = offset + len;
+
+	return 0;
+}
+
+static void adi_did_update(struct ll_adv_set *adv)
+{
+	struct pdu_adv_com_ext_adv *p;
+	struct ext_adv_adi *adi;
+	struct ext_adv_hdr *h;
+	struct pdu_adv *prev;
+	struct pdu_adv *pdu;
+	u8_t *ptr;
+	u8_t idx;
+
+	prev = lll_adv_data_peek(&adv->lll);
+	p = (void *)&prev->adv_ext_ind;
+	h = (void *)p->ext_hdr_adi_adv_data;
+	if (!p->ext_hdr_len || !h->adi) {
+		return;
+	}
+
+	/* Double buffer the primary PDU, to not change it under the LLL */
+	pdu = lll_adv_data_alloc(&adv->lll, &idx);
+	memcpy(pdu, prev, PDU_AC_LL_HEADER_SIZE + prev->len);
+
+	p = (void *)&pdu->adv_ext_ind;
+	h = (void *)p->ext_hdr_adi_adv_data;
+	ptr = (u8_t *)h + sizeof(*h);
+
+	if (h->adv_addr) {
+		ptr += BDADDR_SIZE;
+	}
+	if (h->tgt_addr) {
+		ptr += BDADDR_SIZE;
+	}
+
+	adi = (void *)ptr;
+	adi->did = adi->did + 1;
+
+	lll_adv_data_enqueue(&adv->lll, idx);
+}
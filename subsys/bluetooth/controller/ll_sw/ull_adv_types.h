@@ -4,6 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#if defined(CONFIG_BT_CTLR_ADV_EXT)
+/* Host advertising or scan response data kept per set, AdvData of an
+ * AUX_ADV_IND plus one AUX_CHAIN_IND.
+ */
+#define ULL_ADV_AUX_DATA_LEN_MAX 496
+#endif /* CONFIG_BT_CTLR_ADV_EXT */
+
 struct ll_adv_set {
 	struct evt_hdr evt;
 	struct ull_hdr ull;
@@ -18,6 +25,16 @@ struct ll_adv_set {
 
 #if defined(CONFIG_BT_CTLR_ADV_EXT)
 	u32_t interval;
+
+	u8_t  rnd_addr[BDADDR_SIZE];
+
+	/* Host data, reassembled from HCI fragments, to be placed in the
+	 * AUX_ADV_IND and AUX_CHAIN_IND PDUs of the set.
+	 */
+	u16_t ad_data_len;
+	u8_t  ad_data[ULL_ADV_AUX_DATA_LEN_MAX];
+	u16_t sr_data_len;
+	u8_t  sr_data[ULL_ADV_AUX_DATA_LEN_MAX];
 #else /* !CONFIG_BT_CTLR_ADV_EXT */
 	u16_t interval;
 #endif /* !CONFIG_BT_CTLR_ADV_EXT */
@@ -56,6 +56,18 @@ static inline void event_ch_map_prep(struct ll_conn *conn,
 				     u16_t event_counter);
 static void terminate_ind_rx_enqueue(struct ll_conn *conn, u8_t reason);
 
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+/* Consecutive events ending with Tx data still queued, taken as bulk */
+#define LINK_POLICY_BULK_EVENTS    4
+/* Consecutive events without a valid CRC before falling back to Coded */
+#define LINK_POLICY_CRC_ERR_EVENTS 6
+/* Events to stay on the Coded PHY before upgrading again */
+#define LINK_POLICY_CODED_HOLD     1000
+
+static void link_policy(struct ll_conn *conn,
+			struct node_rx_event_done *done);
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
+
 #if defined(CONFIG_BT_CTLR_LE_ENC)
 static inline void event_enc_prep(struct ll_conn *conn);
 static int enc_rsp_send(struct ll_conn *conn);
@@ -181,6 +193,15 @@ void *ll_tx_mem_acquire(void)
 
 void ll_tx_mem_release(void *tx)
 {
+#if defined(CONFIG_BT_CTLR_ACL_ZERO_COPY)
+	/* data PDUs enqueued in place belong to the buffer they came in */
+	if ((u8_t *)tx < mem_conn_tx.pool ||
+	    (u8_t *)tx >= mem_conn_tx.pool + sizeof(mem_conn_tx.pool)) {
+		ll_tx_mem_ext_release(tx);
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_ACL_ZERO_COPY */
+
 	mem_release(tx, &mem_conn_tx.free);
 }
 
@@ -486,6 +507,34 @@ u8_t ll_phy_req_send(u16_t handle, u8_t tx, u8_t flags, u8_t rx)
 }
 #endif /* CONFIG_BT_CTLR_PHY */
 
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+u8_t ll_link_policy_stats_get(u16_t handle, u32_t *events,
+			      u32_t *crc_err_events, u16_t *phy_updates,
+			      u16_t *length_updates)
+{
+	volatile struct ll_conn *conn;
+	u8_t seq;
+
+	conn = ll_connected_get(handle);
+	if (!conn) {
+		return BT_HCI_ERR_UNKNOWN_CONN_ID;
+	}
+
+	/* The statistics are updated in ULL context, which preempts the
+	 * caller: read them again if an update happened meanwhile
+	 */
+	do {
+		seq = conn->policy.stats_seq;
+		*events = conn->policy.events;
+		*crc_err_events = conn->policy.crc_err_events;
+		*phy_updates = conn->policy.phy_updates;
+		*length_updates = conn->policy.length_updates;
+	} while (seq != conn->policy.stats_seq);
+
+	return 0;
+}
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
+
 #if defined(CONFIG_BT_CTLR_CONN_RSSI)
 u8_t ll_rssi_get(u16_t handle, u8_t *rssi)
 {
@@ -1107,6 +1156,10 @@ void ull_conn_done(struct node_rx_event_done *done)
 	}
 #endif /* CONFIG_BT_CTLR_CONN_RSSI */
 
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+	link_policy(conn, done);
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
+
 	/* break latency based on ctrl procedure pending */
 	if ((((conn->llcp_req - conn->llcp_ack) & 0x03) == 0x02) &&
 	    ((conn->llcp_type == LLCP_CONN_UPD) ||
@@ -1147,6 +1200,124 @@ void ull_conn_done(struct node_rx_event_done *done)
 	}
 }
 
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+#if defined(CONFIG_BT_CTLR_PHY)
+static void link_policy_phy_req(struct ll_conn *conn, u8_t phy)
+{
+	conn->llcp_phy.state = LLCP_PHY_STATE_REQ;
+	/* Have the host notified of the PHY Update Complete */
+	conn->llcp_phy.cmd = 1U;
+	conn->llcp_phy.tx = phy;
+	conn->llcp_phy.flags = 0U;
+	conn->llcp_phy.rx = phy;
+	conn->llcp_phy.req++;
+
+	conn->policy.phy_updates++;
+}
+#endif /* CONFIG_BT_CTLR_PHY */
+
+/* Use the longest packets and the 2M PHY while the link is busy, and fall
+ * back to the Coded PHY when nothing gets through for several events.
+ */
+static void link_policy(struct ll_conn *conn, struct node_rx_event_done *done)
+{
+	struct lll_conn *lll = &conn->lll;
+
+	/* All statistics updates happen below, see
+	 * ll_link_policy_stats_get()
+	 */
+	conn->policy.stats_seq++;
+	conn->policy.events++;
+
+	if (done->extra.crc_valid) {
+		conn->policy.crc_err_count = 0U;
+	} else {
+		conn->policy.crc_err_events++;
+		if (conn->policy.crc_err_count < UINT8_MAX) {
+			conn->policy.crc_err_count++;
+		}
+	}
+
+	if (memq_peek(lll->memq_tx.head, lll->memq_tx.tail, NULL)) {
+		if (conn->policy.bulk_count < UINT8_MAX) {
+			conn->policy.bulk_count++;
+		}
+	} else {
+		conn->policy.bulk_count = 0U;
+	}
+
+	if (conn->policy.coded_hold) {
+		conn->policy.coded_hold--;
+	}
+
+	/* Wait for the peer features and for no procedure in progress */
+	if (!conn->common.fex_valid || (conn->llcp_req != conn->llcp_ack)) {
+		return;
+	}
+
+#if defined(CONFIG_BT_CTLR_DATA_LENGTH)
+	if (conn->llcp_length.req != conn->llcp_length.ack) {
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_DATA_LENGTH */
+
+#if defined(CONFIG_BT_CTLR_PHY)
+	if (conn->llcp_phy.req != conn->llcp_phy.ack) {
+		return;
+	}
+
+#if defined(CONFIG_BT_CTLR_PHY_CODED)
+	if ((conn->policy.crc_err_count >= LINK_POLICY_CRC_ERR_EVENTS) &&
+	    (lll->phy_tx != BIT(2)) &&
+	    (conn->llcp_features & LL_FEAT_BIT_PHY_CODED)) {
+		link_policy_phy_req(conn, BIT(2));
+
+		conn->policy.crc_err_count = 0U;
+		conn->policy.coded_hold = LINK_POLICY_CODED_HOLD;
+		conn->policy.phy_2m_req = 0U;
+
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_PHY_CODED */
+#endif /* CONFIG_BT_CTLR_PHY */
+
+	if (conn->policy.bulk_count < LINK_POLICY_BULK_EVENTS) {
+		return;
+	}
+
+#if defined(CONFIG_BT_CTLR_DATA_LENGTH)
+	/* Only once per connection, the peer may not go any longer */
+	if (!conn->policy.length_req &&
+	    (lll->max_tx_octets < LL_LENGTH_OCTETS_RX_MAX) &&
+	    (conn->llcp_features & LL_FEAT_BIT_DLE)) {
+		conn->policy.length_req = 1U;
+		conn->policy.length_updates++;
+
+		conn->llcp_length.state = LLCP_LENGTH_STATE_REQ;
+		conn->llcp_length.tx_octets = LL_LENGTH_OCTETS_RX_MAX;
+#if defined(CONFIG_BT_CTLR_PHY)
+		conn->llcp_length.tx_time = PKT_US(LL_LENGTH_OCTETS_RX_MAX,
+						   BIT(2));
+#endif /* CONFIG_BT_CTLR_PHY */
+		conn->llcp_length.req++;
+
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_DATA_LENGTH */
+
+#if defined(CONFIG_BT_CTLR_PHY_2M)
+	/* Once per connection or per fall back to Coded */
+	if (!conn->policy.phy_2m_req && !conn->policy.coded_hold &&
+	    !conn->policy.crc_err_count && (lll->phy_tx != BIT(1)) &&
+	    (conn->llcp_features & LL_FEAT_BIT_PHY_2M)) {
+		conn->policy.phy_2m_req = 1U;
+
+		link_policy_phy_req(conn, BIT(1));
+	}
+#endif /* CONFIG_BT_CTLR_PHY_2M */
+}
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
+
 void ull_conn_tx_demux(u8_t count)
 {
 	do {
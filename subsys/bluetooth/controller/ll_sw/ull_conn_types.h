@@ -204,6 +204,22 @@ struct ll_conn {
 	struct node_tx *tx_data_last;
 
 	u8_t chm_updated;
+
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+	struct {
+		u8_t  bulk_count;       /* Events ending with Tx data queued */
+		u8_t  crc_err_count;    /* Events without a valid CRC */
+		u16_t coded_hold;       /* Events left to stay on Coded PHY */
+		u8_t  length_req:1;
+		u8_t  phy_2m_req:1;
+
+		u8_t  stats_seq;        /* Bumped on each update of the below */
+		u32_t events;
+		u32_t crc_err_events;
+		u16_t phy_updates;
+		u16_t length_updates;
+	} policy;
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
 };
 
 struct node_rx_cc {
@@ -186,6 +186,10 @@ u8_t ll_create_connection(u16_t scan_interval, u16_t scan_window,
 
 	conn->common.fex_valid = 0U;
 
+#if defined(CONFIG_BT_CTLR_LINK_POLICY)
+	(void)memset(&conn->policy, 0, sizeof(conn->policy));
+#endif /* CONFIG_BT_CTLR_LINK_POLICY */
+
 	conn->llcp_req = conn->llcp_ack = conn->llcp_type = 0U;
 	conn->llcp_rx = NULL;
 	conn->llcp_features = LL_FEAT;
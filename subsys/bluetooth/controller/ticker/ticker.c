@@ -6,7 +6,10 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 #include <zephyr/types.h>
+#include <misc/rb.h>
+#include <misc/util.h>
 #include <soc.h>
 
 #include "hal/cntr.h"
@@ -60,6 +63,22 @@ struct ticker_node {
 	u32_t remainder_current;	 /* Current sub-microsecond tick
 					  * remainder
 					  */
+	u32_t ticks_abs;		 /* Expiration on the unwrapped time
+					  * base of the instance, while
+					  * queued
+					  */
+	u32_t order;			 /* Enqueue order, sorts nodes
+					  * expiring at the same tick
+					  */
+	struct rbnode rb;		 /* Node in the tree of queued
+					  * nodes
+					  */
+	struct rbnode rb_slot;		 /* Node in the tree of queued nodes
+					  * reserving a slot
+					  */
+	s8_t  priority;			 /* Collision priority, the lower
+					  * value keeps its slot
+					  */
 };
 
 /* Operations to be performed in ticker_job.
@@ -71,6 +90,7 @@ struct ticker_node {
 #define TICKER_USER_OP_TYPE_START    3
 #define TICKER_USER_OP_TYPE_UPDATE   4
 #define TICKER_USER_OP_TYPE_STOP     5
+#define TICKER_USER_OP_TYPE_PRIORITY_SET 6
 
 /* User operation data structure for start opcode. Used for passing start
  * requests to ticker_job
@@ -117,6 +137,13 @@ struct ticker_user_op_slot_get {
 	u32_t *ticks_to_expire;
 };
 
+/* User operation data structure for priority_set opcode. Used for passing
+ * request to set ticker node priority via ticker_job
+ */
+struct ticker_user_op_priority_set {
+	s8_t priority;			/* Node priority */
+};
+
 /* User operation top level data structure. Used for passing requests to
  * ticker_job
  */
@@ -127,6 +154,7 @@ struct ticker_user_op {
 		struct ticker_user_op_start start;
 		struct ticker_user_op_update update;
 		struct ticker_user_op_slot_get slot_get;
+		struct ticker_user_op_priority_set priority_set;
 	} params;		   /* User operation parameters */
 	u32_t status;		   /* Operation result */
 	ticker_op_func fp_op_func; /* Operation completion callback */
@@ -163,6 +191,14 @@ struct ticker_instance {
 	u32_t ticks_current;	   /* Absolute ticks elapsed at last
 				    * ticker_job
 				    */
+	u32_t ticks_base;	   /* Unwrapped ticks from which the head
+				    * node's ticks_to_expire counts
+				    */
+	u32_t order_next;	   /* Enqueue order of the next node */
+	struct rbtree tree;	   /* Queued nodes, by expiration */
+	struct rbtree tree_slot;   /* Queued nodes reserving a slot, by
+				    * expiration
+				    */
 	u32_t ticks_slot_previous; /* Number of ticks previously reserved by a
 				    * ticker node (active air-time)
 				    */
@@ -181,6 +217,11 @@ struct ticker_instance {
 				    * requested
 				    */
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	u32_t ticks_job_cur;	   /* Duration of the last ticker_job */
+	u32_t ticks_job_max;	   /* Worst-case duration of ticker_job */
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	ticker_caller_id_get_cb_t caller_id_get_cb; /* Function for retrieving
 						     * the caller id from user
 						     * id
@@ -227,45 +268,64 @@ static inline void ticker_next_elapsed(u8_t *ticks_elapsed_index)
 }
 
 /**
- * @brief Get ticker expiring in a specific slot
+ * @brief Compare ticker node expirations
  *
- * @details Searches for a ticker which expires in a specific slot starting
- * at 'ticks_slot'.
+ * @details Orders queued nodes by expiration on the unwrapped time base of
+ * the instance. Of the nodes expiring at the same tick, the last enqueued
+ * sorts first.
  *
- * @param node           Pointer to ticker node array
- * @param ticker_id_head Id of initial ticker node
- * @param ticks_slot     Ticks indicating slot to get
+ * @param a Pointer to ticker node
+ * @param b Pointer to ticker node
  *
- * @return Id of ticker expiring within slot or TICKER_NULL
+ * @return true if node a sorts before node b
  * @internal
  */
-static u8_t ticker_by_slot_get(struct ticker_node *node, u8_t ticker_id_head,
-			       u32_t ticks_slot)
+static inline bool ticker_node_lessthan(struct ticker_node *a,
+					struct ticker_node *b)
 {
-	while (ticker_id_head != TICKER_NULL) {
-		struct ticker_node *ticker;
-		u32_t ticks_to_expire;
+	s32_t diff = a->ticks_abs - b->ticks_abs;
 
-		ticker = &node[ticker_id_head];
-		ticks_to_expire = ticker->ticks_to_expire;
+	if (diff != 0) {
+		return diff < 0;
+	}
 
-		if (ticks_slot <= ticks_to_expire) {
-			/* Next ticker expiration is outside the checked slot */
-			return TICKER_NULL;
-		}
+	return (s32_t)(a->order - b->order) > 0;
+}
 
-		if (ticker->ticks_slot) {
-			/* This ticker node has slot defined and expires within
-			 * checked slot
-			 */
-			break;
-		}
+static bool ticker_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return ticker_node_lessthan(CONTAINER_OF(a, struct ticker_node, rb),
+				    CONTAINER_OF(b, struct ticker_node, rb));
+}
 
-		ticks_slot -= ticks_to_expire;
-		ticker_id_head = ticker->next;
-	}
+static bool ticker_slot_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return ticker_node_lessthan(CONTAINER_OF(a, struct ticker_node,
+						 rb_slot),
+				    CONTAINER_OF(b, struct ticker_node,
+						 rb_slot));
+}
 
-	return ticker_id_head;
+/**
+ * @brief Remove ticker node from trees
+ *
+ * @details Removes a ticker node, which is being unlinked from the node
+ * list, from the trees indexing the list.
+ *
+ * @param instance Pointer to ticker instance
+ * @param ticker   Pointer to ticker node
+ *
+ * @internal
+ */
+static void ticker_tree_remove(struct ticker_instance *instance,
+			       struct ticker_node *ticker)
+{
+	rb_remove(&instance->tree, &ticker->rb);
+
+	/* Slot ticks only change while the node is not queued */
+	if (ticker->ticks_slot != 0U) {
+		rb_remove(&instance->tree_slot, &ticker->rb_slot);
+	}
 }
 
 /**
@@ -331,7 +391,8 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
  * @details Finds insertion point for new ticker node and inserts the
  * node in the linked node list. However, if the new ticker node collides
  * with an existing node or the expiration is inside the previous slot,
- * the node is not inserted.
+ * the node is not inserted. The insertion point and the neighbouring slot
+ * reservations are looked up in the trees, in O(log n).
  *
  * @param instance Pointer to ticker instance
  * @param id       Ticker node id to enqueue
@@ -342,82 +403,75 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
  */
 static u8_t ticker_enqueue(struct ticker_instance *instance, u8_t id)
 {
-	struct ticker_node *ticker_current;
 	struct ticker_node *ticker_new;
-	u32_t ticks_to_expire_current;
-	u8_t ticker_id_slot_previous;
-	u32_t ticks_slot_previous;
+	struct ticker_node *ticker;
 	struct ticker_node *node;
 	u32_t ticks_to_expire;
-	u8_t previous;
+	struct rbnode *rb;
 	u8_t current;
-	u8_t collide;
 
 	node = &instance->node[0];
 	ticker_new = &node[id];
 	ticks_to_expire = ticker_new->ticks_to_expire;
 
-	collide = ticker_id_slot_previous = TICKER_NULL;
-	current = instance->ticker_id_head;
-	previous = current;
-	ticks_slot_previous = instance->ticks_slot_previous;
+	ticker_new->ticks_abs = instance->ticks_base + ticks_to_expire;
+	ticker_new->order = instance->order_next++;
 
-	/* Find insertion point for new ticker node and adjust ticks_to_expire
-	 * relative to insertion point
-	 */
-	while ((current != TICKER_NULL) &&
-	       (ticks_to_expire >
-		(ticks_to_expire_current =
-		 (ticker_current = &node[current])->ticks_to_expire))) {
-		ticks_to_expire -= ticks_to_expire_current;
-
-		if (ticker_current->ticks_slot != 0U) {
-			ticks_slot_previous = ticker_current->ticks_slot;
-			ticker_id_slot_previous = current;
-		} else {
-			if (ticks_slot_previous > ticks_to_expire_current) {
-				ticks_slot_previous -= ticks_to_expire_current;
-			} else {
-				ticks_slot_previous = 0U;
+	if (ticker_new->ticks_slot != 0U) {
+		/* Check for collision with the last slot reservation before
+		 * the new node, or if none is queued, with the slot of the
+		 * last expired node
+		 */
+		rb = rb_prev(&instance->tree_slot, &ticker_new->rb_slot);
+		if (rb != NULL) {
+			ticker = CONTAINER_OF(rb, struct ticker_node, rb_slot);
+			if ((s32_t)(ticker->ticks_abs + ticker->ticks_slot -
+				    ticker_new->ticks_abs) > 0) {
+				return ticker - node;
 			}
+		} else if (instance->ticks_slot_previous > ticks_to_expire) {
+			return TICKER_NULL;
 		}
-		previous = current;
-		current = ticker_current->next;
-	}
-
-	/* Check for collision for new ticker node at insertion point */
-	collide = ticker_by_slot_get(&node[0], current,
-				     ticks_to_expire + ticker_new->ticks_slot);
 
-	if ((ticker_new->ticks_slot == 0U) ||
-	    ((ticks_slot_previous <= ticks_to_expire) &&
-	     (collide == TICKER_NULL))) {
-		/* New ticker node has no slot ticks or there is no collision -
-		 * link it in and adjust ticks_to_expire to relative value
+		/* Check for collision with the first slot reservation
+		 * starting before the new slot ends
 		 */
-		ticker_new->ticks_to_expire = ticks_to_expire;
-		ticker_new->next = current;
-
-		if (previous == current) {
-			instance->ticker_id_head = id;
-		} else {
-			node[previous].next = id;
+		rb = rb_next(&instance->tree_slot, &ticker_new->rb_slot);
+		if (rb != NULL) {
+			ticker = CONTAINER_OF(rb, struct ticker_node, rb_slot);
+			if ((s32_t)(ticker->ticks_abs -
+				    (ticker_new->ticks_abs +
+				     ticker_new->ticks_slot)) < 0) {
+				return ticker - node;
+			}
 		}
 
-		if (current != TICKER_NULL) {
-			node[current].ticks_to_expire -= ticks_to_expire;
-		}
+		rb_insert(&instance->tree_slot, &ticker_new->rb_slot);
+	}
+
+	/* No collision - link it in after the last node expiring before it,
+	 * and adjust ticks_to_expire to relative value
+	 */
+	rb = rb_prev(&instance->tree, &ticker_new->rb);
+	if (rb == NULL) {
+		current = instance->ticker_id_head;
+		instance->ticker_id_head = id;
 	} else {
-		/* Collision - no ticker node insertion, set id to that of
-		 * colliding node
-		 */
-		if (ticks_slot_previous > ticks_to_expire) {
-			id = ticker_id_slot_previous;
-		} else {
-			id = collide;
-		}
+		ticker = CONTAINER_OF(rb, struct ticker_node, rb);
+		ticks_to_expire = ticker_new->ticks_abs - ticker->ticks_abs;
+		current = ticker->next;
+		ticker->next = id;
 	}
 
+	ticker_new->ticks_to_expire = ticks_to_expire;
+	ticker_new->next = current;
+
+	if (current != TICKER_NULL) {
+		node[current].ticks_to_expire -= ticks_to_expire;
+	}
+
+	rb_insert(&instance->tree, &ticker_new->rb);
+
 	return id;
 }
 
@@ -439,57 +493,38 @@ static u32_t ticker_dequeue(struct ticker_instance *instance, u8_t id)
 {
 	struct ticker_node *ticker_current;
 	struct ticker_node *node;
-	u8_t previous;
-	u32_t timeout;
-	u8_t current;
-	u32_t total;
+	struct rbnode *rb;
 
-	/* Find the ticker's position in ticker node list while accumulating
-	 * ticks_to_expire
-	 */
 	node = &instance->node[0];
-	previous = instance->ticker_id_head;
-	current = previous;
-	total = 0U;
-	ticker_current = 0;
-	while (current != TICKER_NULL) {
-		ticker_current = &node[current];
-
-		if (current == id) {
-			break;
-		}
-
-		total += ticker_current->ticks_to_expire;
-		previous = current;
-		current = ticker_current->next;
-	}
-
-	if (current == TICKER_NULL) {
+	ticker_current = &node[id];
+	if (!rb_contains(&instance->tree, &ticker_current->rb)) {
 		/* Ticker not in active list */
 		return 0;
 	}
 
-	if (previous == current) {
-		/* Ticker is the first in the list */
-		instance->ticker_id_head = ticker_current->next;
-	}
-
-	/* Remaining timeout between next timeout */
-	timeout = ticker_current->ticks_to_expire;
-
 	/* Link previous ticker with next of this ticker
 	 * i.e. removing the ticker from list
 	 */
-	node[previous].next = ticker_current->next;
+	rb = rb_prev(&instance->tree, &ticker_current->rb);
+	if (rb == NULL) {
+		/* Ticker is the first in the list */
+		instance->ticker_id_head = ticker_current->next;
+	} else {
+		CONTAINER_OF(rb, struct ticker_node, rb)->next =
+			ticker_current->next;
+	}
 
 	/* If this is not the last ticker, increment the
 	 * next ticker by this ticker timeout
 	 */
 	if (ticker_current->next != TICKER_NULL) {
-		node[ticker_current->next].ticks_to_expire += timeout;
+		node[ticker_current->next].ticks_to_expire +=
+			ticker_current->ticks_to_expire;
 	}
 
-	return (total + timeout);
+	ticker_tree_remove(instance, ticker_current);
+
+	return ticker_current->ticks_abs - instance->ticks_base;
 }
 
 /**
@@ -926,6 +961,17 @@ static inline u8_t ticker_job_list_manage(struct ticker_instance *instance,
 				continue;
 			}
 
+			/* priority applies from the next insertion, whatever
+			 * the state of the node
+			 */
+			if (user_op->op == TICKER_USER_OP_TYPE_PRIORITY_SET) {
+				ticker->priority =
+					user_op->params.priority_set.priority;
+				ticker_job_op_cb(user_op,
+						 TICKER_STATUS_SUCCESS);
+				continue;
+			}
+
 			/* determine the ticker state */
 			state = (ticker->req - ticker->ack) & 0xff;
 
@@ -996,6 +1042,9 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 	struct ticker_node *node;
 	u32_t ticks_expired;
 
+	/* The list now counts from the current tick */
+	instance->ticks_base += ticks_elapsed;
+
 	node = &instance->node[0];
 	ticks_expired = 0U;
 	while (instance->ticker_id_head != TICKER_NULL) {
@@ -1037,6 +1086,7 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 
 		/* remove the expired ticker from head */
 		instance->ticker_id_head = ticker->next;
+		ticker_tree_remove(instance, ticker);
 
 		/* ticker will be restarted if periodic */
 		if (ticker->ticks_periodic != 0U) {
@@ -1107,7 +1157,8 @@ static inline void ticker_job_op_start(struct ticker_node *ticker,
  *
  * @details Called by ticker_job to insert a new ticker node. If node collides
  * with existing ticker nodes, either the new node is postponed, or colliding
- * node is un-scheduled. Decision is based on latency and the force-state of
+ * node is un-scheduled. Decision is based on the priority of the nodes, and
+ * between nodes of the same priority on latency and the force-state of
  * individual nodes.
  *
  * @param instance    Pointer to ticker instance
@@ -1158,8 +1209,10 @@ static inline u32_t ticker_job_insert(struct ticker_instance *instance,
 
 			/* Check if colliding node should be un-scheduled */
 			if (ticker_collide->ticks_periodic &&
-			    skip_collide <= skip &&
-			    ticker_collide->force < ticker->force) {
+			    ((ticker_collide->priority > ticker->priority) ||
+			     ((ticker_collide->priority == ticker->priority) &&
+			      skip_collide <= skip &&
+			      ticker_collide->force < ticker->force))) {
 				/* Dequeue and get the reminder of ticks
 				 * to expire.
 				 */
@@ -1472,6 +1525,9 @@ void ticker_job(void *param)
 	u8_t flag_elapsed;
 	u8_t pending;
 	u8_t flag_compare_update;
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	u32_t ticks_job_start = cntr_cnt_get();
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 
 	DEBUG_TICKER_JOB(1);
 
@@ -1560,6 +1616,17 @@ void ticker_job(void *param)
 				   instance);
 	}
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	/* Track the job duration, each insertion and removal takes time
+	 * logarithmic in the number of queued ticker nodes.
+	 */
+	instance->ticks_job_cur = ticker_ticks_diff_get(cntr_cnt_get(),
+							ticks_job_start);
+	if (instance->ticks_job_cur > instance->ticks_job_max) {
+		instance->ticks_job_max = instance->ticks_job_cur;
+	}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 	DEBUG_TICKER_JOB(0);
 }
 
@@ -1606,6 +1673,10 @@ u32_t ticker_init(u8_t instance_index, u8_t count_node, void *node,
 	instance->count_node = count_node;
 	instance->node = node;
 
+	while (count_node--) {
+		instance->node[count_node].priority = TICKER_PRIORITY_DEFAULT;
+	}
+
 	instance->count_user = count_user;
 	instance->user = user;
 
@@ -1630,6 +1701,12 @@ u32_t ticker_init(u8_t instance_index, u8_t count_node, void *node,
 	instance->ticker_id_slot_previous = TICKER_NULL;
 	instance->ticks_slot_previous = 0U;
 	instance->ticks_current = 0U;
+	instance->ticks_base = 0U;
+	instance->order_next = 0U;
+	(void)memset(&instance->tree, 0, sizeof(instance->tree));
+	instance->tree.lessthan_fn = ticker_lessthan;
+	(void)memset(&instance->tree_slot, 0, sizeof(instance->tree_slot));
+	instance->tree_slot.lessthan_fn = ticker_slot_lessthan;
 	instance->ticks_elapsed_first = 0U;
 	instance->ticks_elapsed_last = 0U;
 
@@ -1870,6 +1947,66 @@ u32_t ticker_stop(u8_t instance_index, u8_t user_id, u8_t ticker_id,
 	return user_op->status;
 }
 
+/**
+ * @brief Set ticker node priority
+ *
+ * @details Creates a new user operation of type
+ * TICKER_USER_OP_TYPE_PRIORITY_SET and schedules the ticker_job. When the
+ * slot of a periodic node collides with a node being inserted, the node
+ * with the lower priority value keeps its slot, and the other one skips to
+ * its next interval. Nodes of the same priority decide on latency and
+ * force-state. The priority is kept across stop and start of the node.
+ *
+ * @param instance_index     Index of ticker instance
+ * @param user_id	     Ticker user id. Used for indexing user operations
+ *			     and mapping to mayfly caller id
+ * @param ticker_id	     Id of ticker node
+ * @param priority	     Priority, TICKER_PRIORITY_DEFAULT initially
+ * @param fp_op_func	     Function pointer of user operation completion
+ *			     function
+ * @param op_context	     Context passed in operation completion call
+ *
+ * @return TICKER_STATUS_BUSY if request was successful but not yet completed.
+ * TICKER_STATUS_FAILURE is returned if there are no more user operations
+ * available, and TICKER_STATUS_SUCCESS is returned if ticker_job gets to run
+ * before exiting ticker_priority_set
+ */
+u32_t ticker_priority_set(u8_t instance_index, u8_t user_id, u8_t ticker_id,
+			  s8_t priority, ticker_op_func fp_op_func,
+			  void *op_context)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+	struct ticker_user_op *user_op;
+	struct ticker_user *user;
+	u8_t last;
+
+	user = &instance->user[user_id];
+
+	last = user->last + 1;
+	if (last >= user->count_user_op) {
+		last = 0U;
+	}
+
+	if (last == user->first) {
+		return TICKER_STATUS_FAILURE;
+	}
+
+	user_op = &user->user_op[user->last];
+	user_op->op = TICKER_USER_OP_TYPE_PRIORITY_SET;
+	user_op->id = ticker_id;
+	user_op->params.priority_set.priority = priority;
+	user_op->status = TICKER_STATUS_BUSY;
+	user_op->fp_op_func = fp_op_func;
+	user_op->op_context = op_context;
+
+	user->last = last;
+
+	instance->sched_cb(instance->caller_id_get_cb(user_id),
+			   TICKER_CALL_ID_JOB, 0, instance);
+
+	return user_op->status;
+}
+
 /**
  * @brief Get next ticker node slot
  *
@@ -1997,6 +2134,24 @@ void ticker_job_sched(u8_t instance_index, u8_t user_id)
 			   TICKER_CALL_ID_JOB, 0, instance);
 }
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+/**
+ * @brief Get ticker job duration
+ *
+ * @param instance_index Index of ticker instance
+ * @param ticks_cur	 Pointer to ticks taken by the last ticker_job
+ * @param ticks_max	 Pointer to worst-case ticks taken by ticker_job
+ */
+void ticker_job_prof_get(u8_t instance_index, u32_t *ticks_cur,
+			 u32_t *ticks_max)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+
+	*ticks_cur = instance->ticks_job_cur;
+	*ticks_max = instance->ticks_job_max;
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 /**
  * @brief Get current absolute tick count
  *
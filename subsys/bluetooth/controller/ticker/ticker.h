@@ -29,13 +29,14 @@
 #define TICKER_NULL_PERIOD	0
 #define TICKER_NULL_SLOT	0
 #define TICKER_NULL_LAZY	0
+#define TICKER_PRIORITY_DEFAULT	0
 /**
 * @}
 */
 
 /** \brief Timer node type size.
 */
-#define TICKER_NODE_T_SIZE	40
+#define TICKER_NODE_T_SIZE	68
 
 /** \brief Timer user type size.
 */
@@ -97,6 +98,9 @@ u32_t ticker_update(u8_t instance_index, u8_t user_id, u8_t ticker_id,
 		    u8_t force, ticker_op_func fp_op_func, void *op_context);
 u32_t ticker_stop(u8_t instance_index, u8_t user_id, u8_t ticker_id,
 		  ticker_op_func fp_op_func, void *op_context);
+u32_t ticker_priority_set(u8_t instance_index, u8_t user_id, u8_t ticker_id,
+			  s8_t priority, ticker_op_func fp_op_func,
+			  void *op_context);
 u32_t ticker_next_slot_get(u8_t instance_index, u8_t user_id,
 			   u8_t *ticker_id_head, u32_t *ticks_current,
 			   u32_t *ticks_to_expire,
@@ -104,5 +108,9 @@ u32_t ticker_next_slot_get(u8_t instance_index, u8_t user_id,
 u32_t ticker_job_idle_get(u8_t instance_index, u8_t user_id,
 			  ticker_op_func fp_op_func, void *op_context);
 void ticker_job_sched(u8_t instance_index, u8_t user_id);
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+void ticker_job_prof_get(u8_t instance_index, u32_t *ticks_cur,
+			 u32_t *ticks_max);
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 u32_t ticker_ticks_now_get(void);
 u32_t ticker_ticks_diff_get(u32_t ticks_now, u32_t ticks_old);
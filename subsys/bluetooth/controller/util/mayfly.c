@@ -18,6 +18,11 @@ static struct {
 	u8_t        enable_ack;
 	u8_t        disable_req;
 	u8_t        disable_ack;
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+	u8_t        enq_count;
+	u8_t        deq_count;
+	u8_t        depth_max;
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
 } mft[MAYFLY_CALLEE_COUNT][MAYFLY_CALLER_COUNT];
 
 static memq_link_t mfl[MAYFLY_CALLEE_COUNT][MAYFLY_CALLER_COUNT];
@@ -27,6 +32,33 @@ static u8_t mfp[MAYFLY_CALLEE_COUNT];
 static u8_t _state;
 #endif /* MAYFLY_UT */
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+/* Enqueue and dequeue counts are each written from a single execution
+ * context (caller and callee respectively), hence their difference is the
+ * queue depth without needing any locking.
+ */
+static void depth_enqueue(u8_t callee_id, u8_t caller_id)
+{
+	u8_t depth;
+
+	mft[callee_id][caller_id].enq_count++;
+
+	depth = mft[callee_id][caller_id].enq_count -
+		mft[callee_id][caller_id].deq_count;
+	if (depth > mft[callee_id][caller_id].depth_max) {
+		mft[callee_id][caller_id].depth_max = depth;
+	}
+}
+
+static void depth_dequeue(u8_t callee_id, u8_t caller_id)
+{
+	mft[callee_id][caller_id].deq_count++;
+}
+#else /* !CONFIG_BT_CTLR_PROFILE_ISR */
+#define depth_enqueue(...)
+#define depth_dequeue(...)
+#endif /* !CONFIG_BT_CTLR_PROFILE_ISR */
+
 void mayfly_init(void)
 {
 	u8_t callee_id;
@@ -107,6 +139,7 @@ u32_t mayfly_enqueue(u8_t caller_id, u8_t callee_id, u8_t chain,
 	/* new, add as ready in the queue */
 	m->_req = ack + 1;
 	memq_enqueue(m->_link, m, &mft[callee_id][caller_id].tail);
+	depth_enqueue(callee_id, caller_id);
 
 mayfly_enqueue_pend:
 	/* set mayfly callee pending */
@@ -145,6 +178,7 @@ static void dequeue(u8_t callee_id, u8_t caller_id, memq_link_t *link,
 		memq_dequeue(mft[callee_id][caller_id].tail,
 			     &mft[callee_id][caller_id].head,
 			     0);
+		depth_dequeue(callee_id, caller_id);
 
 		/* release link into dequeued mayfly struct */
 		m->_link = link;
@@ -161,6 +195,7 @@ static void dequeue(u8_t callee_id, u8_t caller_id, memq_link_t *link,
 
 			m->_ack = ack;
 			memq_enqueue(link, m, &mft[callee_id][callee_id].tail);
+			depth_enqueue(callee_id, callee_id);
 		}
 	}
 }
@@ -265,6 +300,27 @@ void mayfly_run(u8_t callee_id)
 	}
 }
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+u8_t mayfly_depth_max_get(u8_t callee_id, u8_t reset)
+{
+	u8_t depth_max = 0U;
+	u8_t caller_id;
+
+	caller_id = MAYFLY_CALLER_COUNT;
+	while (caller_id--) {
+		if (mft[callee_id][caller_id].depth_max > depth_max) {
+			depth_max = mft[callee_id][caller_id].depth_max;
+		}
+
+		if (reset) {
+			mft[callee_id][caller_id].depth_max = 0U;
+		}
+	}
+
+	return depth_max;
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 #if defined(MAYFLY_UT)
 #define MAYFLY_CALL_ID_CALLER MAYFLY_CALL_ID_0
 #define MAYFLY_CALL_ID_CALLEE MAYFLY_CALL_ID_2
@@ -26,6 +26,11 @@ u32_t mayfly_enqueue(u8_t caller_id, u8_t callee_id, u8_t chain,
 		     struct mayfly *m);
 void mayfly_run(u8_t callee_id);
 
+#if defined(CONFIG_BT_CTLR_PROFILE_ISR)
+/* Maximum number of mayflies seen queued to the callee since last reset */
+u8_t mayfly_depth_max_get(u8_t callee_id, u8_t reset);
+#endif /* CONFIG_BT_CTLR_PROFILE_ISR */
+
 extern void mayfly_enable_cb(u8_t caller_id, u8_t callee_id, u8_t enable);
 extern u32_t mayfly_is_enabled(u8_t caller_id, u8_t callee_id);
 extern u32_t mayfly_prio_is_equal(u8_t caller_id, u8_t callee_id);
@@ -1223,6 +1223,7 @@ static sys_snode_t *add_pending_tx(struct bt_conn *conn, bt_conn_tx_cb_t cb,
 
 	key = irq_lock();
 	sys_slist_append(&conn->tx_pending, node);
+	conn->tx_in_flight++;
 	irq_unlock(key);
 
 	return node;
@@ -1234,6 +1235,7 @@ static void remove_pending_tx(struct bt_conn *conn, sys_snode_t *node)
 
 	key = irq_lock();
 	sys_slist_find_and_remove(&conn->tx_pending, node);
+	conn->tx_in_flight--;
 	irq_unlock(key);
 
 	tx_free(CONTAINER_OF(node, struct bt_conn_tx, node));
@@ -1388,9 +1390,38 @@ static void conn_cleanup(struct bt_conn *conn)
 	bt_conn_unref(conn);
 }
 
+static bool conn_tx_queued(struct bt_conn *conn)
+{
+	return conn->state == BT_CONN_CONNECTED &&
+	       !k_fifo_is_empty(&conn->tx_queue);
+}
+
+/* Check whether a connection already has its share of the controller
+ * buffers, split evenly among the connections with data queued for them.
+ */
+static bool conn_tx_share_used(struct bt_conn *conn)
+{
+	struct k_sem *pkts = bt_conn_get_pkts(conn);
+	int i, busy = 0;
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conn_tx_queued(&conns[i]) &&
+		    bt_conn_get_pkts(&conns[i]) == pkts) {
+			busy++;
+		}
+	}
+
+	if (busy < 2) {
+		return false;
+	}
+
+	return conn->tx_in_flight >= MAX(1, pkts->limit / busy);
+}
+
 int bt_conn_prepare_events(struct k_poll_event events[])
 {
-	int i, ev_count = 0;
+	static u8_t first;
+	int i, n, ev_count = 0;
 
 	BT_DBG("");
 
@@ -1398,8 +1429,16 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 	k_poll_event_init(&events[ev_count++], K_POLL_TYPE_SIGNAL,
 			  K_POLL_MODE_NOTIFY_ONLY, &conn_change);
 
-	for (i = 0; i < ARRAY_SIZE(conns); i++) {
-		struct bt_conn *conn = &conns[i];
+	/* Connections are served in the order of the events, rotate the
+	 * first one so that no connection always goes last.
+	 */
+	first = (first + 1) % ARRAY_SIZE(conns);
+
+	for (n = 0; n < ARRAY_SIZE(conns); n++) {
+		struct bt_conn *conn;
+
+		i = (first + n) % ARRAY_SIZE(conns);
+		conn = &conns[i];
 
 		if (!atomic_get(&conn->ref)) {
 			continue;
@@ -1423,6 +1462,14 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 				  &conn->tx_notify);
 		events[ev_count++].tag = BT_EVENT_CONN_TX_NOTIFY;
 
+		/* Leave the queue alone until packets of the connection get
+		 * acknowledged, which raises its tx_notify event.
+		 */
+		if (conn_tx_share_used(conn)) {
+			BT_DBG("conn %p waits for its TX share", conn);
+			continue;
+		}
+
 		k_poll_event_init(&events[ev_count],
 				  K_POLL_TYPE_FIFO_DATA_AVAILABLE,
 				  K_POLL_MODE_NOTIFY_ONLY,
@@ -1475,6 +1522,49 @@ struct bt_conn *bt_conn_add_le(const bt_addr_le_t *peer)
 	return conn;
 }
 
+static struct bt_conn *conn_handle_index[CONFIG_BT_MAX_CONN];
+
+static inline bool conn_has_handle(bt_conn_state_t state)
+{
+	return state == BT_CONN_CONNECTED || state == BT_CONN_DISCONNECT;
+}
+
+static struct bt_conn **conn_handle_bucket(u16_t handle)
+{
+	return &conn_handle_index[handle % ARRAY_SIZE(conn_handle_index)];
+}
+
+static void conn_handle_index_add(struct bt_conn *conn)
+{
+	struct bt_conn **bucket = conn_handle_bucket(conn->handle);
+	unsigned int key;
+
+	key = irq_lock();
+	conn->handle_next = *bucket;
+	*bucket = conn;
+	irq_unlock(key);
+}
+
+static void conn_handle_index_del(struct bt_conn *conn)
+{
+	struct bt_conn **prev;
+	unsigned int key;
+
+	key = irq_lock();
+
+	for (prev = conn_handle_bucket(conn->handle); *prev;
+	     prev = &(*prev)->handle_next) {
+		if (*prev == conn) {
+			*prev = conn->handle_next;
+			break;
+		}
+	}
+
+	irq_unlock(key);
+
+	conn->handle_next = NULL;
+}
+
 static void process_unack_tx(struct bt_conn *conn)
 {
 	/* Return any unacknowledged packets */
@@ -1484,6 +1574,9 @@ static void process_unack_tx(struct bt_conn *conn)
 
 		key = irq_lock();
 		node = sys_slist_get(&conn->tx_pending);
+		if (node) {
+			conn->tx_in_flight--;
+		}
 		irq_unlock(key);
 
 		if (!node) {
@@ -1510,6 +1603,13 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 	old_state = conn->state;
 	conn->state = state;
 
+	/* Keep the handle lookup in line with the states having a handle */
+	if (!conn_has_handle(old_state) && conn_has_handle(state)) {
+		conn_handle_index_add(conn);
+	} else if (conn_has_handle(old_state) && !conn_has_handle(state)) {
+		conn_handle_index_del(conn);
+	}
+
 	/* Actions needed for exiting the old state */
 	switch (old_state) {
 	case BT_CONN_DISCONNECTED:
@@ -1538,6 +1638,7 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 		}
 		k_fifo_init(&conn->tx_queue);
 		k_fifo_init(&conn->tx_notify);
+		conn->tx_in_flight = 0U;
 		k_poll_signal_raise(&conn_change, 0);
 
 		sys_slist_init(&conn->channels);
@@ -1620,43 +1721,22 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 
 struct bt_conn *bt_conn_lookup_handle(u16_t handle)
 {
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(conns); i++) {
-		if (!atomic_get(&conns[i].ref)) {
-			continue;
-		}
+	struct bt_conn *conn;
+	unsigned int key;
 
-		/* We only care about connections with a valid handle */
-		if (conns[i].state != BT_CONN_CONNECTED &&
-		    conns[i].state != BT_CONN_DISCONNECT) {
-			continue;
-		}
+	key = irq_lock();
 
-		if (conns[i].handle == handle) {
-			return bt_conn_ref(&conns[i]);
+	for (conn = *conn_handle_bucket(handle); conn;
+	     conn = conn->handle_next) {
+		if (conn->handle == handle) {
+			bt_conn_ref(conn);
+			break;
 		}
 	}
 
-#if defined(CONFIG_BT_BREDR)
-	for (i = 0; i < ARRAY_SIZE(sco_conns); i++) {
-		if (!atomic_get(&sco_conns[i].ref)) {
-			continue;
-		}
-
-		/* We only care about connections with a valid handle */
-		if (sco_conns[i].state != BT_CONN_CONNECTED &&
-		    sco_conns[i].state != BT_CONN_DISCONNECT) {
-			continue;
-		}
-
-		if (sco_conns[i].handle == handle) {
-			return bt_conn_ref(&sco_conns[i]);
-		}
-	}
-#endif
+	irq_unlock(key);
 
-	return NULL;
+	return conn;
 }
 
 int bt_conn_addr_le_cmp(const struct bt_conn *conn, const bt_addr_le_t *peer)
@@ -1857,6 +1937,61 @@ int bt_conn_le_param_update(struct bt_conn *conn,
 	return 0;
 }
 
+int bt_conn_le_phy_update(struct bt_conn *conn, u8_t tx_phys, u8_t rx_phys)
+{
+	struct bt_hci_cp_le_set_phy *cp;
+	struct net_buf *buf;
+
+	if (!IS_ENABLED(CONFIG_BT_PHY_UPDATE)) {
+		return -ENOTSUP;
+	}
+
+	if (conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_LE_SET_PHY, sizeof(*cp));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(conn->handle);
+	cp->all_phys = 0U;
+	cp->tx_phys = tx_phys;
+	cp->rx_phys = rx_phys;
+	cp->phy_opts = BT_HCI_LE_PHY_CODED_ANY;
+
+	return bt_hci_cmd_send_sync(BT_HCI_OP_LE_SET_PHY, buf, NULL);
+}
+
+int bt_conn_le_data_len_update(struct bt_conn *conn, u16_t tx_octets,
+			       u16_t tx_time)
+{
+	struct bt_hci_cp_le_set_data_len *cp;
+	struct net_buf *buf;
+
+	if (!IS_ENABLED(CONFIG_BT_DATA_LEN_UPDATE)) {
+		return -ENOTSUP;
+	}
+
+	if (conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_LE_SET_DATA_LEN, sizeof(*cp));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(conn->handle);
+	cp->tx_octets = sys_cpu_to_le16(tx_octets);
+	cp->tx_time = sys_cpu_to_le16(tx_time);
+
+	return bt_hci_cmd_send_sync(BT_HCI_OP_LE_SET_DATA_LEN, buf, NULL);
+}
+
 int bt_conn_disconnect(struct bt_conn *conn, u8_t reason)
 {
 	/* Disconnection is initiated by us, so auto connection shall
@@ -115,8 +115,13 @@ struct bt_conn {
 	u16_t		        rx_len;
 	struct net_buf		*rx;
 
+	/* Next connection in the same handle lookup bucket */
+	struct bt_conn		*handle_next;
+
 	/* Sent but not acknowledged TX packets */
 	sys_slist_t		tx_pending;
+	/* Number of packets in tx_pending */
+	u16_t			tx_in_flight;
 	/* Acknowledged but not yet notified TX packets */
 	struct k_fifo		tx_notify;
 
@@ -70,6 +70,120 @@ static const u16_t gap_appearance = CONFIG_BT_DEVICE_APPEARANCE;
 static sys_slist_t db;
 static atomic_t init;
 
+#if defined(CONFIG_BT_GATT_HANDLE_INDEX)
+struct gatt_index_entry {
+	const struct bt_gatt_attr *attr;
+	u16_t handle;
+};
+
+/* All attributes sorted by handle, those of static services first. */
+static struct gatt_index_entry gatt_index[CONFIG_BT_GATT_HANDLE_INDEX_SIZE];
+static u16_t gatt_index_count;
+static u16_t gatt_index_static;
+static bool gatt_index_valid;
+
+static bool gatt_index_add(const struct bt_gatt_attr *attr, u16_t handle)
+{
+	u16_t i;
+
+	if (gatt_index_count == ARRAY_SIZE(gatt_index)) {
+		return false;
+	}
+
+	/* Attributes mostly come in handle order, shift the few others */
+	for (i = gatt_index_count;
+	     i > gatt_index_static && gatt_index[i - 1].handle > handle; i--) {
+		gatt_index[i] = gatt_index[i - 1];
+	}
+
+	gatt_index[i].attr = attr;
+	gatt_index[i].handle = handle;
+	gatt_index_count++;
+
+	return true;
+}
+
+static void gatt_index_rebuild(void)
+{
+	const struct bt_gatt_service_static *static_svc;
+	struct bt_gatt_service *svc;
+	u16_t handle;
+	int i;
+
+	gatt_index_valid = false;
+	gatt_index_count = 0U;
+	gatt_index_static = 0U;
+
+	for (static_svc = _bt_services_start, handle = 1;
+	     static_svc < _bt_services_end; static_svc++) {
+		for (i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (!gatt_index_add(&static_svc->attrs[i], handle)) {
+				goto full;
+			}
+		}
+	}
+
+	gatt_index_static = gatt_index_count;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		for (i = 0; i < svc->attr_count; i++) {
+			if (!gatt_index_add(&svc->attrs[i],
+					    svc->attrs[i].handle)) {
+				goto full;
+			}
+		}
+	}
+
+	gatt_index_valid = true;
+	return;
+
+full:
+	BT_WARN("Handle index full, looking attributes up by walking");
+}
+
+static void gatt_index_foreach(u16_t start_handle, u16_t end_handle,
+			       bt_gatt_attr_func_t func, void *user_data)
+{
+	u16_t lo = 0U, hi = gatt_index_count;
+
+	while (lo < hi) {
+		u16_t mid = (lo + hi) / 2U;
+
+		if (gatt_index[mid].handle < start_handle) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (; lo < gatt_index_count && gatt_index[lo].handle <= end_handle;
+	     lo++) {
+		const struct gatt_index_entry *entry = &gatt_index[lo];
+		u8_t ret;
+
+		if (lo < gatt_index_static) {
+			struct bt_gatt_attr attr;
+
+			/* Static attributes are const and have no handle */
+			memcpy(&attr, entry->attr, sizeof(attr));
+			attr.handle = entry->handle;
+
+			ret = func(&attr, user_data);
+		} else {
+			ret = func(entry->attr, user_data);
+		}
+
+		if (ret == BT_GATT_ITER_STOP) {
+			return;
+		}
+	}
+}
+#else
+static inline void gatt_index_rebuild(void)
+{
+}
+#endif /* CONFIG_BT_GATT_HANDLE_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, u16_t len, u16_t offset)
 {
@@ -201,6 +315,7 @@ enum {
 };
 
 #define CF_ROBUST_CACHING(_cfg) (_cfg->data[0] & BIT(0))
+#define CF_MULTI_NTF(_cfg) (_cfg->data[0] & BIT(2))
 
 struct gatt_cf_cfg {
 	u8_t                    id;
@@ -249,7 +364,7 @@ static bool cf_set_value(struct gatt_cf_cfg *cfg, const u8_t *value, u16_t len)
 {
 	u16_t i;
 	u8_t last_byte = 1U;
-	u8_t last_bit = 1U;
+	u8_t last_bit = IS_ENABLED(CONFIG_BT_GATT_NOTIFY_MULTIPLE) ? 3U : 1U;
 
 	/* Validate the bits */
 	for (i = 0U; i < len && i < last_byte; i++) {
@@ -572,6 +687,8 @@ populate:
 
 	sys_slist_append(&db, &svc->node);
 
+	gatt_index_rebuild();
+
 	return 0;
 }
 
@@ -706,6 +823,38 @@ static void ccc_delayed_store(struct k_work *work)
 }
 #endif
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+struct gatt_ntf_batch {
+	struct bt_conn *conn;
+	/* Multiple Handle Value Notification being filled */
+	struct net_buf *buf;
+	u8_t count;
+	struct k_delayed_work work;
+	u32_t start;
+	struct bt_gatt_notify_stats stats;
+};
+
+static struct gatt_ntf_batch ntf_batch[CONFIG_BT_MAX_CONN];
+static K_MUTEX_DEFINE(ntf_batch_lock);
+
+static void ntf_batch_timeout(struct k_work *work);
+
+static void ntf_stats_add(struct bt_conn *conn, u32_t pdus, size_t len)
+{
+	struct bt_gatt_notify_stats *stats;
+
+	stats = &ntf_batch[bt_conn_index(conn)].stats;
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+	stats->pdus += pdus;
+	stats->notifications++;
+	stats->bytes += len;
+	k_mutex_unlock(&ntf_batch_lock);
+}
+#else
+#define ntf_stats_add(...)
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
 void bt_gatt_init(void)
 {
 	const struct bt_gatt_service_static *svc;
@@ -718,6 +867,8 @@ void bt_gatt_init(void)
 		last_static_handle += svc->attr_count;
 	}
 
+	gatt_index_rebuild();
+
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 #if defined(CONFIG_BT_GATT_CACHING)
 	k_delayed_work_init(&db_hash_work, db_hash_process);
@@ -729,6 +880,11 @@ void bt_gatt_init(void)
 #if defined(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE)
 	k_delayed_work_init(&gatt_ccc_store.work, ccc_delayed_store);
 #endif
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	for (int i = 0; i < ARRAY_SIZE(ntf_batch); i++) {
+		k_delayed_work_init(&ntf_batch[i].work, ntf_batch_timeout);
+	}
+#endif
 }
 
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
@@ -837,6 +993,8 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	gatt_index_rebuild();
+
 	sc_indicate(&gatt_sc, svc->attrs[0].handle,
 		    svc->attrs[svc->attr_count - 1].handle);
 
@@ -998,6 +1156,13 @@ void bt_gatt_foreach_attr(u16_t start_handle, u16_t end_handle,
 	struct bt_gatt_service *svc;
 	int i;
 
+#if defined(CONFIG_BT_GATT_HANDLE_INDEX)
+	if (gatt_index_valid) {
+		gatt_index_foreach(start_handle, end_handle, func, user_data);
+		return;
+	}
+#endif /* CONFIG_BT_GATT_HANDLE_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		const struct bt_gatt_service_static *static_svc;
 		u16_t handle;
@@ -1300,6 +1465,8 @@ static int gatt_notify(struct bt_conn *conn, u16_t handle, const void *data,
 	net_buf_add(buf, len);
 	memcpy(nfy->value, data, len);
 
+	ntf_stats_add(conn, 1, len);
+
 	return bt_att_send(conn, buf, cb, user_data);
 }
 
@@ -1494,17 +1661,10 @@ static u8_t notify_cb(const struct bt_gatt_attr *attr, void *user_data)
 	return BT_GATT_ITER_CONTINUE;
 }
 
-int bt_gatt_notify_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
-		      const void *data, u16_t len,
-		      bt_gatt_complete_func_t func, void *user_data)
+static int notify_handle(const struct bt_gatt_attr *attr, u16_t *handle)
 {
-	struct notify_data nfy;
-	u16_t handle;
-
-	__ASSERT(attr, "invalid parameters\n");
-
-	handle = attr->handle ? : find_static_attr(attr);
-	if (!handle) {
+	*handle = attr->handle ? : find_static_attr(attr);
+	if (!*handle) {
 		return -ENOENT;
 	}
 
@@ -1516,7 +1676,25 @@ int bt_gatt_notify_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			return -EINVAL;
 		}
 
-		handle++;
+		(*handle)++;
+	}
+
+	return 0;
+}
+
+int bt_gatt_notify_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+		      const void *data, u16_t len,
+		      bt_gatt_complete_func_t func, void *user_data)
+{
+	struct notify_data nfy;
+	u16_t handle;
+	int err;
+
+	__ASSERT(attr, "invalid parameters\n");
+
+	err = notify_handle(attr, &handle);
+	if (err) {
+		return err;
 	}
 
 	if (conn) {
@@ -1536,6 +1714,201 @@ int bt_gatt_notify_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 	return nfy.err;
 }
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+static int ntf_batch_send(struct gatt_ntf_batch *batch)
+{
+	struct bt_att_notify_mult *nfy;
+	struct net_buf *buf = batch->buf;
+	int err;
+
+	if (!buf) {
+		return 0;
+	}
+
+	batch->buf = NULL;
+	k_delayed_work_cancel(&batch->work);
+
+	/* The multiple variant carries at least two values, a lone one is
+	 * turned into a regular Handle Value Notification.
+	 */
+	if (batch->count == 1U) {
+		nfy = (void *)(buf->data + sizeof(struct bt_att_hdr));
+		buf->data[0] = BT_ATT_OP_NOTIFY;
+		memmove(&nfy->len, nfy->value, sys_le16_to_cpu(nfy->len));
+		buf->len -= sizeof(nfy->len);
+	}
+
+	BT_DBG("conn %p count %u len %u", batch->conn, batch->count, buf->len);
+
+	batch->stats.pdus++;
+
+	err = bt_att_send(batch->conn, buf, NULL, NULL);
+	if (err) {
+		net_buf_unref(buf);
+	}
+
+	return err;
+}
+
+static void ntf_batch_timeout(struct k_work *work)
+{
+	struct gatt_ntf_batch *batch = CONTAINER_OF(work, struct gatt_ntf_batch,
+						    work);
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+	ntf_batch_send(batch);
+	k_mutex_unlock(&ntf_batch_lock);
+}
+
+int bt_gatt_notify_batch(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			 const void *data, u16_t len)
+{
+	struct bt_att_notify_mult *nfy;
+	struct gatt_ntf_batch *batch;
+	struct gatt_cf_cfg *cfg;
+	u16_t handle, mtu;
+	int err;
+
+	__ASSERT(conn, "invalid parameters\n");
+	__ASSERT(attr, "invalid parameters\n");
+
+	if (conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	err = notify_handle(attr, &handle);
+	if (err) {
+		return err;
+	}
+
+#if defined(CONFIG_BT_GATT_ENFORCE_CHANGE_UNAWARE)
+	if (!bt_gatt_change_aware(conn, false)) {
+		return -EAGAIN;
+	}
+#endif
+
+	batch = &ntf_batch[bt_conn_index(conn)];
+	mtu = bt_att_get_mtu(conn);
+	cfg = find_cf_cfg(conn);
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+
+	/* Send whatever is pending if the value cannot join it */
+	if (batch->buf && batch->buf->len + sizeof(*nfy) + len > mtu) {
+		err = ntf_batch_send(batch);
+		if (err) {
+			goto done;
+		}
+	}
+
+	if (!cfg || !CF_MULTI_NTF(cfg) ||
+	    sizeof(struct bt_att_hdr) + sizeof(*nfy) + len > mtu) {
+		/* Keep the order of the values already queued */
+		err = ntf_batch_send(batch);
+		if (!err) {
+			err = gatt_notify(conn, handle, data, len, NULL, NULL);
+		}
+		goto done;
+	}
+
+	if (!batch->buf) {
+		batch->buf = bt_att_create_pdu(conn, BT_ATT_OP_NOTIFY_MULT,
+					       mtu - sizeof(struct bt_att_hdr));
+		if (!batch->buf) {
+			BT_WARN("No buffer available to send notification");
+			err = -ENOMEM;
+			goto done;
+		}
+
+		batch->conn = conn;
+		batch->count = 0U;
+	}
+
+	BT_DBG("conn %p handle 0x%04x", conn, handle);
+
+	nfy = net_buf_add(batch->buf, sizeof(*nfy));
+	nfy->handle = sys_cpu_to_le16(handle);
+	nfy->len = sys_cpu_to_le16(len);
+	net_buf_add_mem(batch->buf, data, len);
+	batch->count++;
+
+	ntf_stats_add(conn, 0, len);
+
+	if (batch->buf->len + sizeof(*nfy) >= mtu) {
+		/* No room left for another value */
+		err = ntf_batch_send(batch);
+	} else if (batch->count == 1U) {
+		k_delayed_work_submit(&batch->work,
+				      CONFIG_BT_GATT_NOTIFY_MULTIPLE_TIMEOUT);
+	}
+
+done:
+	k_mutex_unlock(&ntf_batch_lock);
+
+	return err;
+}
+
+int bt_gatt_notify_batch_flush(struct bt_conn *conn)
+{
+	int err;
+
+	__ASSERT(conn, "invalid parameters\n");
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+	err = ntf_batch_send(&ntf_batch[bt_conn_index(conn)]);
+	k_mutex_unlock(&ntf_batch_lock);
+
+	return err;
+}
+
+int bt_gatt_notify_stats_get(struct bt_conn *conn,
+			     struct bt_gatt_notify_stats *stats)
+{
+	struct gatt_ntf_batch *batch;
+
+	if (!conn || !stats) {
+		return -EINVAL;
+	}
+
+	batch = &ntf_batch[bt_conn_index(conn)];
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+	*stats = batch->stats;
+	stats->duration = k_uptime_get_32() - batch->start;
+	k_mutex_unlock(&ntf_batch_lock);
+
+	return 0;
+}
+
+static void ntf_batch_drop(struct bt_conn *conn)
+{
+	struct gatt_ntf_batch *batch = &ntf_batch[bt_conn_index(conn)];
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+
+	k_delayed_work_cancel(&batch->work);
+
+	if (batch->buf) {
+		net_buf_unref(batch->buf);
+		batch->buf = NULL;
+	}
+
+	k_mutex_unlock(&ntf_batch_lock);
+}
+
+static void ntf_batch_reset(struct bt_conn *conn)
+{
+	struct gatt_ntf_batch *batch = &ntf_batch[bt_conn_index(conn)];
+
+	ntf_batch_drop(conn);
+
+	k_mutex_lock(&ntf_batch_lock, K_FOREVER);
+	(void)memset(&batch->stats, 0, sizeof(batch->stats));
+	batch->start = k_uptime_get_32();
+	k_mutex_unlock(&ntf_batch_lock);
+}
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
 int bt_gatt_indicate(struct bt_conn *conn,
 		     struct bt_gatt_indicate_params *params)
 {
@@ -3077,6 +3450,9 @@ void bt_gatt_connected(struct bt_conn *conn)
 {
 	BT_DBG("conn %p", conn);
 	bt_gatt_foreach_attr(0x0001, 0xffff, connected_cb, conn);
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	ntf_batch_reset(conn);
+#endif
 #if defined(CONFIG_BT_GATT_CLIENT)
 	add_subscriptions(conn);
 #endif /* CONFIG_BT_GATT_CLIENT */
@@ -3176,6 +3552,11 @@ void bt_gatt_disconnected(struct bt_conn *conn)
 	BT_DBG("conn %p", conn);
 	bt_gatt_foreach_attr(0x0001, 0xffff, disconnected_cb, conn);
 
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	/* Statistics are kept until the next connection using the slot */
+	ntf_batch_drop(conn);
+#endif
+
 #if defined(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE)
 	gatt_ccc_conn_unqueue(conn);
 
@@ -77,6 +77,9 @@ struct bt_dev bt_dev = {
 #if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
 	.rx_queue      = Z_FIFO_INITIALIZER(bt_dev.rx_queue),
 #endif
+#if defined(CONFIG_BT_RX_LANES)
+	.rx_acl_queue  = Z_FIFO_INITIALIZER(bt_dev.rx_acl_queue),
+#endif
 };
 
 static bt_ready_cb_t ready_cb;
@@ -227,10 +230,90 @@ static void report_completed_packet(struct net_buf *buf)
 	bt_hci_cmd_send(BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS, buf);
 }
 
+#define ACL_IN_DESTROY report_completed_packet
+#else
+#define ACL_IN_DESTROY NULL
+#endif /* CONFIG_BT_HCI_ACL_FLOW_CONTROL */
+
+#if defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL) || defined(CONFIG_BT_RX_LANES)
 #define ACL_IN_SIZE BT_L2CAP_BUF_SIZE(CONFIG_BT_L2CAP_RX_MTU)
 NET_BUF_POOL_DEFINE(acl_in_pool, CONFIG_BT_ACL_RX_COUNT, ACL_IN_SIZE,
-		    BT_BUF_USER_DATA_MIN, report_completed_packet);
-#endif /* CONFIG_BT_HCI_ACL_FLOW_CONTROL */
+		    BT_BUF_USER_DATA_MIN, ACL_IN_DESTROY);
+#endif /* CONFIG_BT_HCI_ACL_FLOW_CONTROL || CONFIG_BT_RX_LANES */
+
+#if defined(CONFIG_BT_RX_LANES_STATS)
+static struct {
+	/* Cycle count at which each buffer was queued */
+	u32_t evt_stamp[CONFIG_BT_RX_BUF_COUNT];
+	u32_t acl_stamp[CONFIG_BT_ACL_RX_COUNT];
+
+	struct bt_hci_rx_lane_stats stats[BT_HCI_RX_LANE_NUM];
+} rx_lanes;
+
+static u32_t *rx_lane_stamp(struct net_buf *buf, u8_t lane)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	/* Buffers from other pools, e.g. reused commands, are not timed */
+	if (lane == BT_HCI_RX_LANE_EVT && pool == &hci_rx_pool) {
+		return &rx_lanes.evt_stamp[net_buf_id(buf)];
+	}
+
+	if (lane == BT_HCI_RX_LANE_ACL && pool == &acl_in_pool) {
+		return &rx_lanes.acl_stamp[net_buf_id(buf)];
+	}
+
+	return NULL;
+}
+
+static void rx_lane_queued(struct net_buf *buf, u8_t lane)
+{
+	u32_t *stamp = rx_lane_stamp(buf, lane);
+
+	if (stamp) {
+		*stamp = k_cycle_get_32();
+	}
+}
+
+static void rx_lane_handled(struct net_buf *buf, u8_t lane)
+{
+	struct bt_hci_rx_lane_stats *stats = &rx_lanes.stats[lane];
+	u32_t *stamp = rx_lane_stamp(buf, lane);
+	unsigned int key;
+	u32_t us;
+
+	if (!stamp) {
+		return;
+	}
+
+	us = SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - *stamp) /
+	     NSEC_PER_USEC;
+
+	key = irq_lock();
+	stats->count++;
+	stats->total_us += us;
+	stats->max_us = MAX(stats->max_us, us);
+	irq_unlock(key);
+}
+
+int bt_hci_rx_lane_stats_get(u8_t lane, struct bt_hci_rx_lane_stats *stats)
+{
+	unsigned int key;
+
+	if (lane >= BT_HCI_RX_LANE_NUM || !stats) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = rx_lanes.stats[lane];
+	irq_unlock(key);
+
+	return 0;
+}
+#else
+#define rx_lane_queued(...)
+#define rx_lane_handled(...)
+#endif /* CONFIG_BT_RX_LANES_STATS */
 
 struct net_buf *bt_hci_cmd_create(u16_t opcode, u8_t param_len)
 {
@@ -602,6 +685,9 @@ static void hci_num_completed_packets(struct net_buf *buf)
 
 			key = irq_lock();
 			node = sys_slist_get(&conn->tx_pending);
+			if (node) {
+				conn->tx_in_flight--;
+			}
 			irq_unlock(key);
 
 			if (!node) {
@@ -695,6 +781,10 @@ static void hci_disconn_complete(struct net_buf *buf)
 		return;
 	}
 
+	if (conn->le.keys) {
+		bt_keys_store_flush(conn->le.keys);
+	}
+
 #if defined(CONFIG_BT_CENTRAL)
 	if (atomic_test_bit(conn->flags, BT_CONN_AUTO_CONNECT)) {
 		bt_conn_set_state(conn, BT_CONN_CONNECT_SCAN);
@@ -4575,6 +4665,9 @@ int bt_recv(struct net_buf *buf)
 	case BT_BUF_ACL_IN:
 #if defined(CONFIG_BT_RECV_IS_RX_THREAD)
 		hci_acl(buf);
+#elif defined(CONFIG_BT_RX_LANES)
+		rx_lane_queued(buf, BT_HCI_RX_LANE_ACL);
+		net_buf_put(&bt_dev.rx_acl_queue, buf);
 #else
 		net_buf_put(&bt_dev.rx_queue, buf);
 #endif
@@ -4584,6 +4677,7 @@ int bt_recv(struct net_buf *buf)
 #if defined(CONFIG_BT_RECV_IS_RX_THREAD)
 		hci_event(buf);
 #else
+		rx_lane_queued(buf, BT_HCI_RX_LANE_EVT);
 		net_buf_put(&bt_dev.rx_queue, buf);
 #endif
 		return 0;
@@ -4725,6 +4819,41 @@ static void init_work(struct k_work *work)
 }
 
 #if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
+#if defined(CONFIG_BT_RX_LANES)
+static struct net_buf *rx_lanes_get(void)
+{
+	static struct k_poll_event events[] = {
+		K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY,
+						&bt_dev.rx_queue, 0),
+		K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY,
+						&bt_dev.rx_acl_queue, 0),
+	};
+	struct net_buf *buf;
+	int err;
+
+	while (1) {
+		/* Pending events always go ahead of ACL data */
+		buf = net_buf_get(&bt_dev.rx_queue, K_NO_WAIT);
+		if (buf) {
+			return buf;
+		}
+
+		buf = net_buf_get(&bt_dev.rx_acl_queue, K_NO_WAIT);
+		if (buf) {
+			return buf;
+		}
+
+		err = k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+		BT_ASSERT(err == 0);
+
+		events[0].state = K_POLL_STATE_NOT_READY;
+		events[1].state = K_POLL_STATE_NOT_READY;
+	}
+}
+#endif /* CONFIG_BT_RX_LANES */
+
 static void hci_rx_thread(void)
 {
 	struct net_buf *buf;
@@ -4733,7 +4862,11 @@ static void hci_rx_thread(void)
 
 	while (1) {
 		BT_DBG("calling fifo_get_wait");
+#if defined(CONFIG_BT_RX_LANES)
+		buf = rx_lanes_get();
+#else
 		buf = net_buf_get(&bt_dev.rx_queue, K_FOREVER);
+#endif
 
 		BT_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf),
 		       buf->len);
@@ -4741,10 +4874,12 @@ static void hci_rx_thread(void)
 		switch (bt_buf_get_type(buf)) {
 #if defined(CONFIG_BT_CONN)
 		case BT_BUF_ACL_IN:
+			rx_lane_handled(buf, BT_HCI_RX_LANE_ACL);
 			hci_acl(buf);
 			break;
 #endif /* CONFIG_BT_CONN */
 		case BT_BUF_EVT:
+			rx_lane_handled(buf, BT_HCI_RX_LANE_EVT);
 			hci_event(buf);
 			break;
 		default:
@@ -5612,7 +5747,7 @@ struct net_buf *bt_buf_get_rx(enum bt_buf_type type, s32_t timeout)
 	__ASSERT(type == BT_BUF_EVT || type == BT_BUF_ACL_IN,
 		 "Invalid buffer type requested");
 
-#if defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL)
+#if defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL) || defined(CONFIG_BT_RX_LANES)
 	if (type == BT_BUF_EVT) {
 		buf = net_buf_alloc(&hci_rx_pool, timeout);
 	} else {
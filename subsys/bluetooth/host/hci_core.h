@@ -156,6 +156,11 @@ struct bt_dev {
 	struct k_fifo		rx_queue;
 #endif
 
+#if defined(CONFIG_BT_RX_LANES)
+	/* Queue for incoming ACL data, rx_queue only holds events */
+	struct k_fifo		rx_acl_queue;
+#endif
+
 	/* Queue for outgoing HCI commands */
 	struct k_fifo		cmd_tx_queue;
 
@@ -76,6 +76,63 @@ static struct {
 	};
 } ecc;
 
+#if CONFIG_BT_TINYCRYPT_ECC_KEY_POOL > 0
+static struct {
+	u8_t private_key[32];
+	u8_t pk[64];
+} key_pool[CONFIG_BT_TINYCRYPT_ECC_KEY_POOL];
+static u8_t key_pool_count;
+static bool key_pool_fail;
+
+/* Precomputing starts with the first key request, the random number
+ * generator is known to be seeded by then.
+ */
+static bool key_pool_used;
+
+static u8_t make_key(u8_t *pk, u8_t *private_key);
+
+/* Called from the ECC thread only, so no locking is needed */
+static void key_pool_fill(void)
+{
+	if (make_key(key_pool[key_pool_count].pk,
+		     key_pool[key_pool_count].private_key)) {
+		/* stop precomputing, keys are generated on demand */
+		key_pool_fail = true;
+		return;
+	}
+
+	key_pool_count++;
+
+	BT_DBG("%u precomputed keys", key_pool_count);
+}
+
+static bool key_pool_get(void)
+{
+	key_pool_used = true;
+
+	if (!key_pool_count) {
+		return false;
+	}
+
+	key_pool_count--;
+	memcpy(ecc.private_key, key_pool[key_pool_count].private_key, 32);
+	memcpy(ecc.pk, key_pool[key_pool_count].pk, 64);
+
+	/* don't leave the private key behind */
+	(void)memset(&key_pool[key_pool_count], 0,
+		     sizeof(key_pool[key_pool_count]));
+
+	return true;
+}
+
+#define key_pool_done() (!key_pool_used || key_pool_fail || \
+			 key_pool_count == ARRAY_SIZE(key_pool))
+#else
+#define key_pool_fill()
+#define key_pool_get() false
+#define key_pool_done() true
+#endif /* CONFIG_BT_TINYCRYPT_ECC_KEY_POOL > 0 */
+
 static void send_cmd_status(u16_t opcode, u8_t status)
 {
 	struct bt_hci_evt_cmd_status *evt;
@@ -99,26 +156,40 @@ static void send_cmd_status(u16_t opcode, u8_t status)
 	bt_recv_prio(buf);
 }
 
-static u8_t generate_keys(void)
-{
 #if !defined(CONFIG_BT_USE_DEBUG_KEYS)
+static u8_t make_key(u8_t *pk, u8_t *private_key)
+{
 	do {
 		int rc;
 
-		rc = uECC_make_key(ecc.pk, ecc.private_key, &curve_secp256r1);
+		rc = uECC_make_key(pk, private_key, &curve_secp256r1);
 		if (rc == TC_CRYPTO_FAIL) {
 			BT_ERR("Failed to create ECC public/private pair");
 			return BT_HCI_ERR_UNSPECIFIED;
 		}
 
 	/* make sure generated key isn't debug key */
-	} while (memcmp(ecc.private_key, debug_private_key, 32) == 0);
+	} while (memcmp(private_key, debug_private_key, 32) == 0);
+
+	return 0;
+}
+#endif /* !CONFIG_BT_USE_DEBUG_KEYS */
+
+static u8_t generate_keys(void)
+{
+#if !defined(CONFIG_BT_USE_DEBUG_KEYS)
+	if (key_pool_get()) {
+		return 0;
+	}
+
+	return make_key(ecc.pk, ecc.private_key);
 #else
 	sys_memcpy_swap(&ecc.pk, debug_public_key, 32);
 	sys_memcpy_swap(&ecc.pk[32], &debug_public_key[32], 32);
 	sys_memcpy_swap(ecc.private_key, debug_private_key, 32);
-#endif
+
 	return 0;
+#endif
 }
 
 static void emulate_le_p256_public_key_cmd(void)
@@ -207,7 +278,12 @@ static void emulate_le_generate_dhkey(void)
 static void ecc_thread(void *p1, void *p2, void *p3)
 {
 	while (true) {
-		k_sem_take(&cmd_sem, K_FOREVER);
+		/* Use the time without commands to precompute key pairs */
+		if (k_sem_take(&cmd_sem, key_pool_done() ? K_FOREVER :
+			       K_NO_WAIT)) {
+			key_pool_fill();
+			continue;
+		}
 
 		if (atomic_test_bit(flags, PENDING_PUB_KEY)) {
 			emulate_le_p256_public_key_cmd();
@@ -31,39 +31,111 @@
 
 static struct bt_keys key_pool[CONFIG_BT_MAX_PAIRED];
 
+/* Keys are looked up by address on every connection, so the entries in
+ * use are chained in buckets hashed by identity and address. Bucket heads
+ * and links hold the key_pool index plus one, zero ends a chain.
+ */
+static u8_t keys_index[CONFIG_BT_MAX_PAIRED];
+static u8_t keys_index_next[CONFIG_BT_MAX_PAIRED];
+
+#if CONFIG_BT_SETTINGS_KEYS_STORE_DELAY > 0
+/* Entries with a delayed store pending */
+static ATOMIC_DEFINE(keys_dirty, CONFIG_BT_MAX_PAIRED);
+#define keys_store_cancel(keys) atomic_clear_bit(keys_dirty, (keys) - key_pool)
+#else
+#define keys_store_cancel(keys)
+#endif
+
+static u8_t *keys_bucket(u8_t id, const bt_addr_le_t *addr)
+{
+	u32_t hash = id ^ addr->type;
+	int i;
+
+	for (i = 0; i < sizeof(addr->a.val); i++) {
+		hash = (hash * 31U) + addr->a.val[i];
+	}
+
+	return &keys_index[hash % ARRAY_SIZE(keys_index)];
+}
+
+static void keys_index_add(struct bt_keys *keys)
+{
+	u8_t *head = keys_bucket(keys->id, &keys->addr);
+	u8_t slot = keys - key_pool;
+
+	keys_index_next[slot] = *head;
+	*head = slot + 1;
+}
+
+static void keys_index_del(struct bt_keys *keys)
+{
+	u8_t *link = keys_bucket(keys->id, &keys->addr);
+	u8_t slot = keys - key_pool;
+
+	while (*link) {
+		if (*link == slot + 1) {
+			*link = keys_index_next[slot];
+			keys_index_next[slot] = 0U;
+			return;
+		}
+
+		link = &keys_index_next[*link - 1];
+	}
+}
+
+static struct bt_keys *keys_lookup(u8_t id, const bt_addr_le_t *addr)
+{
+	u8_t next = *keys_bucket(id, addr);
+
+	while (next) {
+		struct bt_keys *keys = &key_pool[next - 1];
+
+		if (keys->id == id && !bt_addr_le_cmp(&keys->addr, addr)) {
+			return keys;
+		}
+
+		next = keys_index_next[next - 1];
+	}
+
+	return NULL;
+}
+
 struct bt_keys *bt_keys_get_addr(u8_t id, const bt_addr_le_t *addr)
 {
 	struct bt_keys *keys;
 	int i;
-	size_t first_free_slot = ARRAY_SIZE(key_pool);
 
 	BT_DBG("%s", bt_addr_le_str(addr));
 
+	keys = keys_lookup(id, addr);
+	if (keys) {
+		return keys;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
 		keys = &key_pool[i];
 
-		if (keys->id == id && !bt_addr_le_cmp(&keys->addr, addr)) {
+		if (!bt_addr_le_cmp(&keys->addr, BT_ADDR_LE_ANY)) {
+			keys->id = id;
+			bt_addr_le_copy(&keys->addr, addr);
+			keys_index_add(keys);
+			BT_DBG("created %p for %s", keys, bt_addr_le_str(addr));
 			return keys;
 		}
-
-		if (first_free_slot == ARRAY_SIZE(key_pool) &&
-		    !bt_addr_le_cmp(&keys->addr, BT_ADDR_LE_ANY)) {
-			first_free_slot = i;
-		}
 	}
 
-	if (first_free_slot < ARRAY_SIZE(key_pool)) {
-		keys = &key_pool[first_free_slot];
-		keys->id = id;
-		bt_addr_le_copy(&keys->addr, addr);
-		BT_DBG("created %p for %s", keys, bt_addr_le_str(addr));
-		return keys;
-	}
 	BT_DBG("unable to create keys for %s", bt_addr_le_str(addr));
 
 	return NULL;
 }
 
+void bt_keys_addr_set(struct bt_keys *keys, const bt_addr_le_t *addr)
+{
+	keys_index_del(keys);
+	bt_addr_le_copy(&keys->addr, addr);
+	keys_index_add(keys);
+}
+
 void bt_foreach_bond(u8_t id, void (*func)(const struct bt_bond_info *info,
 					   void *user_data),
 		     void *user_data)
@@ -96,15 +168,13 @@ void bt_keys_foreach(int type, void (*func)(struct bt_keys *keys, void *data),
 
 struct bt_keys *bt_keys_find(int type, u8_t id, const bt_addr_le_t *addr)
 {
-	int i;
+	struct bt_keys *keys;
 
 	BT_DBG("type %d %s", type, bt_addr_le_str(addr));
 
-	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
-		if ((key_pool[i].keys & type) && key_pool[i].id == id &&
-		    !bt_addr_le_cmp(&key_pool[i].addr, addr)) {
-			return &key_pool[i];
-		}
+	keys = keys_lookup(id, addr);
+	if (keys && (keys->keys & type)) {
+		return keys;
 	}
 
 	return NULL;
@@ -182,18 +252,9 @@ struct bt_keys *bt_keys_find_irk(u8_t id, const bt_addr_le_t *addr)
 
 struct bt_keys *bt_keys_find_addr(u8_t id, const bt_addr_le_t *addr)
 {
-	int i;
-
 	BT_DBG("%s", bt_addr_le_str(addr));
 
-	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
-		if (key_pool[i].id == id &&
-		    !bt_addr_le_cmp(&key_pool[i].addr, addr)) {
-			return &key_pool[i];
-		}
-	}
-
-	return NULL;
+	return keys_lookup(id, addr);
 }
 
 void bt_keys_add_type(struct bt_keys *keys, int type)
@@ -224,10 +285,14 @@ void bt_keys_clear(struct bt_keys *keys)
 					       &keys->addr, NULL);
 		}
 
+		/* A pending delayed store must not bring the keys back */
+		keys_store_cancel(keys);
+
 		BT_DBG("Deleting key %s", key);
 		settings_delete(key);
 	}
 
+	keys_index_del(keys);
 	(void)memset(keys, 0, sizeof(*keys));
 }
 
@@ -250,7 +315,7 @@ void bt_keys_clear_all(u8_t id)
 }
 
 #if defined(CONFIG_BT_SETTINGS)
-int bt_keys_store(struct bt_keys *keys)
+static int keys_store(struct bt_keys *keys)
 {
 	char key[BT_SETTINGS_KEY_MAX];
 	int err;
@@ -277,6 +342,55 @@ int bt_keys_store(struct bt_keys *keys)
 	return 0;
 }
 
+#if CONFIG_BT_SETTINGS_KEYS_STORE_DELAY > 0
+/* Keys updated while connected are written to flash once, after a delay
+ * or at disconnection, instead of on every update.
+ */
+static struct k_delayed_work keys_store_work;
+static bool keys_store_work_init;
+
+static void keys_delayed_store(struct k_work *work)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		if (atomic_test_and_clear_bit(keys_dirty, i)) {
+			(void)keys_store(&key_pool[i]);
+		}
+	}
+}
+
+int bt_keys_store(struct bt_keys *keys)
+{
+	if (!keys_store_work_init) {
+		k_delayed_work_init(&keys_store_work, keys_delayed_store);
+		keys_store_work_init = true;
+	}
+
+	atomic_set_bit(keys_dirty, keys - key_pool);
+
+	/* Don't postpone the write when keys keep getting updated */
+	if (!k_delayed_work_remaining_get(&keys_store_work)) {
+		k_delayed_work_submit(&keys_store_work,
+				      CONFIG_BT_SETTINGS_KEYS_STORE_DELAY);
+	}
+
+	return 0;
+}
+
+void bt_keys_store_flush(struct bt_keys *keys)
+{
+	if (atomic_test_and_clear_bit(keys_dirty, keys - key_pool)) {
+		(void)keys_store(keys);
+	}
+}
+#else
+int bt_keys_store(struct bt_keys *keys)
+{
+	return keys_store(keys);
+}
+#endif /* CONFIG_BT_SETTINGS_KEYS_STORE_DELAY > 0 */
+
 static int keys_set(int argc, char **argv, size_t len_rd,
 		    settings_read_cb read_cb, void *cb_arg)
 {
@@ -315,6 +429,7 @@ static int keys_set(int argc, char **argv, size_t len_rd,
 	if (!len) {
 		keys = bt_keys_find(BT_KEYS_ALL, id, &addr);
 		if (keys) {
+			keys_index_del(keys);
 			(void)memset(keys, 0, sizeof(*keys));
 			BT_DBG("Cleared keys for %s", bt_addr_le_str(&addr));
 		} else {
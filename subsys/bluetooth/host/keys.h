@@ -74,6 +74,7 @@ struct bt_keys *bt_keys_find_irk(u8_t id, const bt_addr_le_t *addr);
 struct bt_keys *bt_keys_find_addr(u8_t id, const bt_addr_le_t *addr);
 
 void bt_keys_add_type(struct bt_keys *keys, int type);
+void bt_keys_addr_set(struct bt_keys *keys, const bt_addr_le_t *addr);
 void bt_keys_clear(struct bt_keys *keys);
 void bt_keys_clear_all(u8_t id);
 
@@ -86,6 +87,15 @@ static inline int bt_keys_store(struct bt_keys *keys)
 }
 #endif
 
+#if CONFIG_BT_SETTINGS_KEYS_STORE_DELAY > 0
+/* Write delayed updates of the keys to flash now */
+void bt_keys_store_flush(struct bt_keys *keys);
+#else
+static inline void bt_keys_store_flush(struct bt_keys *keys)
+{
+}
+#endif
+
 enum {
 	BT_LINK_KEY_AUTHENTICATED  = BIT(0),
 	BT_LINK_KEY_DEBUG          = BIT(1),
@@ -667,6 +667,11 @@ static void l2cap_chan_rx_init(struct bt_l2cap_le_chan *chan)
 	chan->rx.mps = MIN(chan->rx.mtu + 2, L2CAP_MAX_LE_MPS);
 	k_sem_init(&chan->rx.credits, 0, UINT_MAX);
 
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+	chan->_sdu_credits = 0U;
+	atomic_set(&chan->_rx_pending, 0);
+#endif
+
 	if (BT_DBG_ENABLED &&
 	    chan->rx.init_credits * chan->rx.mps < chan->rx.mtu + 2) {
 		BT_WARN("Not enough credits for a full packet");
@@ -1048,11 +1053,18 @@ static void le_disconn_rsp(struct bt_l2cap *l2cap, u8_t ident,
 	bt_l2cap_chan_del(&chan->chan);
 }
 
-static inline struct net_buf *l2cap_alloc_seg(struct net_buf *buf)
+static inline struct net_buf *l2cap_alloc_seg(struct net_buf *buf,
+					      sys_slist_t *segs)
 {
 	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
 	struct net_buf *seg;
 
+	/* Use segments allocated up front first */
+	seg = net_buf_slist_get(segs);
+	if (seg) {
+		return seg;
+	}
+
 	/* Try to use original pool if possible */
 	seg = net_buf_alloc(pool, K_NO_WAIT);
 	if (seg) {
@@ -1066,7 +1078,8 @@ static inline struct net_buf *l2cap_alloc_seg(struct net_buf *buf)
 
 static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 					     struct net_buf *buf,
-					     size_t sdu_hdr_len)
+					     size_t sdu_hdr_len,
+					     sys_slist_t *segs)
 {
 	struct net_buf *seg;
 	u16_t headroom;
@@ -1091,7 +1104,7 @@ static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 	}
 
 segment:
-	seg = l2cap_alloc_seg(buf);
+	seg = l2cap_alloc_seg(buf, segs);
 
 	if (sdu_hdr_len) {
 		net_buf_add_le16(seg, net_buf_frags_len(buf));
@@ -1121,7 +1134,7 @@ static void l2cap_chan_sdu_sent(struct bt_conn *conn, void *user_data)
 }
 
 static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch, struct net_buf *buf,
-			      u16_t sdu_hdr_len)
+			      u16_t sdu_hdr_len, sys_slist_t *segs)
 {
 	struct net_buf *seg;
 	int len;
@@ -1132,7 +1145,7 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch, struct net_buf *buf,
 		return -EAGAIN;
 	}
 
-	seg = l2cap_chan_create_seg(ch, buf, sdu_hdr_len);
+	seg = l2cap_chan_create_seg(ch, buf, sdu_hdr_len, segs);
 
 	/* Channel may have been disconnected while waiting for a buffer */
 	if (!ch->chan.conn) {
@@ -1168,11 +1181,48 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch, struct net_buf *buf,
 	return len;
 }
 
+#if CONFIG_BT_L2CAP_TX_SEG_PREFETCH > 0
+/* Allocate the segments that the available credits allow to send, so that
+ * the SDU goes out without waiting for buffers in between segments.
+ */
+static void l2cap_chan_le_prefetch(struct bt_l2cap_le_chan *ch,
+				   struct net_buf *buf, int len,
+				   sys_slist_t *segs)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	unsigned int count;
+	struct net_buf *seg;
+
+	count = ceiling_fraction(len, ch->tx.mps);
+
+	/* A single segment may not need a buffer of its own */
+	if (count < 2) {
+		return;
+	}
+
+	count = MIN(count, k_sem_count_get(&ch->tx.credits));
+	count = MIN(count, CONFIG_BT_L2CAP_TX_SEG_PREFETCH);
+
+	while (count--) {
+		seg = net_buf_alloc(pool, K_NO_WAIT);
+		if (!seg) {
+			break;
+		}
+
+		net_buf_reserve(seg, BT_L2CAP_CHAN_SEND_RESERVE);
+		net_buf_slist_put(segs, seg);
+	}
+}
+#else
+#define l2cap_chan_le_prefetch(...)
+#endif
+
 static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 				  struct net_buf **buf, int sent)
 {
 	int ret, total_len;
 	struct net_buf *frag;
+	sys_slist_t segs;
 
 	total_len = net_buf_frags_len(*buf) + sent;
 
@@ -1185,9 +1235,14 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 		frag = frag->frags;
 	}
 
+	sys_slist_init(&segs);
+	l2cap_chan_le_prefetch(ch, frag, total_len - sent +
+			       (sent ? 0 : BT_L2CAP_SDU_HDR_LEN), &segs);
+
 	if (!sent) {
 		/* Add SDU length for the first segment */
-		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_LEN);
+		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_LEN,
+					 &segs);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -1195,7 +1250,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 				       sizeof(sent));
 			}
 			*buf = frag;
-			return ret;
+			goto done;
 		}
 		sent = ret;
 	}
@@ -1207,7 +1262,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 			frag = net_buf_frag_del(NULL, frag);
 		}
 
-		ret = l2cap_chan_le_send(ch, frag, 0);
+		ret = l2cap_chan_le_send(ch, frag, 0, &segs);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -1215,7 +1270,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 				       sizeof(sent));
 			}
 			*buf = frag;
-			return ret;
+			goto done;
 		}
 	}
 
@@ -1224,6 +1279,12 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 
 	net_buf_unref(frag);
 
+done:
+	/* Release what the credits did not allow to send */
+	while ((frag = net_buf_slist_get(&segs))) {
+		net_buf_unref(frag);
+	}
+
 	return ret;
 }
 
@@ -1451,7 +1512,13 @@ int bt_l2cap_chan_recv_complete(struct bt_l2cap_chan *chan, struct net_buf *buf)
 	/* Restore credits used by packet */
 	memcpy(&credits, net_buf_user_data(buf), sizeof(credits));
 
-	l2cap_chan_send_credits(ch, buf, credits);
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+	atomic_dec(&ch->_rx_pending);
+#endif
+
+	if (credits) {
+		l2cap_chan_send_credits(ch, buf, credits);
+	}
 
 	net_buf_unref(buf);
 
@@ -1480,6 +1547,13 @@ static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 
 	BT_DBG("chan %p len %zu", chan, net_buf_frags_len(buf));
 
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+	/* Only the credits not returned while receiving are still owed */
+	seg -= chan->_sdu_credits;
+	chan->_sdu_credits = 0U;
+	memcpy(net_buf_user_data(buf), &seg, sizeof(seg));
+#endif
+
 	/* Receiving complete SDU, notify channel and reset SDU buf */
 	err = chan->chan.ops->recv(&chan->chan, buf);
 	if (err < 0) {
@@ -1488,13 +1562,45 @@ static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 			bt_l2cap_chan_disconnect(&chan->chan);
 			net_buf_unref(buf);
 		}
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+		if (err == -EINPROGRESS) {
+			atomic_inc(&chan->_rx_pending);
+		}
+#endif
 		return;
 	}
 
-	l2cap_chan_send_credits(chan, buf, seg);
+	if (seg) {
+		l2cap_chan_send_credits(chan, buf, seg);
+	}
+
 	net_buf_unref(buf);
 }
 
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+/* The segments are copied into the SDU, so their credits can be given back
+ * right away unless the application is lagging behind.
+ */
+static void l2cap_chan_auto_credits(struct bt_l2cap_le_chan *chan,
+				    struct net_buf *buf, u16_t seg)
+{
+	u16_t credits = seg - chan->_sdu_credits;
+
+	if (atomic_get(&chan->_rx_pending) >=
+	    CONFIG_BT_L2CAP_AUTO_CREDITS_BACKLOG) {
+		return;
+	}
+
+	/* Batch credits to keep the signaling overhead low */
+	if (credits < MAX(chan->rx.init_credits / 2U, 1)) {
+		return;
+	}
+
+	l2cap_chan_send_credits(chan, buf, credits);
+	chan->_sdu_credits += credits;
+}
+#endif /* CONFIG_BT_L2CAP_AUTO_CREDITS */
+
 static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 				   struct net_buf *buf)
 {
@@ -1528,6 +1634,9 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 	}
 
 	if (net_buf_frags_len(chan->_sdu) < chan->_sdu_len) {
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+		l2cap_chan_auto_credits(chan, buf, seg);
+#endif
 		/* Give more credits if remote has run out of them, this
 		 * should only happen if the remote cannot fully utilize the
 		 * MPS for some reason.
@@ -1583,6 +1692,9 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 			return;
 		}
 		chan->_sdu_len = sdu_len;
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+		chan->_sdu_credits = 0U;
+#endif
 		l2cap_chan_le_recv_seg(chan, buf);
 		return;
 	}
@@ -1593,6 +1705,11 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 			BT_ERR("err %d", err);
 			bt_l2cap_chan_disconnect(&chan->chan);
 		}
+#if defined(CONFIG_BT_L2CAP_AUTO_CREDITS)
+		if (err == -EINPROGRESS) {
+			atomic_inc(&chan->_rx_pending);
+		}
+#endif
 		return;
 	}
 
@@ -72,6 +72,158 @@ static struct bt_mesh_adv *adv_alloc(int id)
 	return &adv_pool[id];
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_SCHED)
+/* Interval over which the channel density is measured */
+#define RELAY_DENSITY_WINDOW_MS 1000
+
+static K_FIFO_DEFINE(relay_queue);
+
+NET_BUF_POOL_DEFINE(relay_buf_pool, CONFIG_BT_MESH_RELAY_BUF_COUNT,
+		    BT_MESH_ADV_DATA_SIZE, BT_MESH_ADV_USER_DATA_SIZE, NULL);
+
+static struct relay_adv {
+	struct bt_mesh_adv adv;
+	u64_t hash;
+	u8_t heard;
+} relay_adv_pool[CONFIG_BT_MESH_RELAY_BUF_COUNT];
+
+#define RELAY_ADV(buf) CONTAINER_OF(BT_MESH_ADV(buf), struct relay_adv, adv)
+
+static struct {
+	atomic_t rx_count;
+	u32_t window_start;
+	struct bt_mesh_adv_relay_stats stats;
+} relay;
+
+static struct bt_mesh_adv *relay_adv_alloc(int id)
+{
+	return &relay_adv_pool[id].adv;
+}
+
+static u16_t relay_density(void)
+{
+	u32_t now = k_uptime_get_32();
+	u32_t elapsed = now - relay.window_start;
+
+	if (elapsed >= RELAY_DENSITY_WINDOW_MS) {
+		relay.stats.density = MIN(atomic_clear(&relay.rx_count) *
+					  MSEC_PER_SEC / elapsed, 0xffff);
+		relay.window_start = now;
+	}
+
+	return relay.stats.density;
+}
+
+/* Returns false if the relay message should not be sent at all */
+static bool relay_prepare(struct net_buf *buf)
+{
+	struct bt_mesh_adv *adv = BT_MESH_ADV(buf);
+	u8_t count = BT_MESH_TRANSMIT_COUNT(adv->xmit);
+	u16_t density = relay_density();
+
+	if (CONFIG_BT_MESH_RELAY_SUPPRESS_COUNT &&
+	    RELAY_ADV(buf)->heard >= CONFIG_BT_MESH_RELAY_SUPPRESS_COUNT) {
+		BT_DBG("Suppressing relay, heard %u times",
+		       RELAY_ADV(buf)->heard);
+		relay.stats.suppressed++;
+		return false;
+	}
+
+	if (CONFIG_BT_MESH_RELAY_DENSITY && count &&
+	    density > CONFIG_BT_MESH_RELAY_DENSITY) {
+		count = count * CONFIG_BT_MESH_RELAY_DENSITY / density;
+		adv->xmit = BT_MESH_TRANSMIT(count,
+					     BT_MESH_TRANSMIT_INT(adv->xmit));
+		relay.stats.reduced++;
+	}
+
+	relay.stats.sent++;
+
+	return true;
+}
+
+struct net_buf *bt_mesh_adv_relay_create(u8_t xmit, u64_t hash)
+{
+	struct net_buf *buf;
+
+	buf = bt_mesh_adv_create_from_pool(&relay_buf_pool, relay_adv_alloc,
+					   BT_MESH_ADV_DATA, xmit, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	BT_MESH_ADV(buf)->relay = 1U;
+	RELAY_ADV(buf)->hash = hash;
+	RELAY_ADV(buf)->heard = 0U;
+
+	return buf;
+}
+
+void bt_mesh_adv_relay_heard(u64_t hash)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(relay_adv_pool); i++) {
+		struct relay_adv *adv = &relay_adv_pool[i];
+
+		if (adv->adv.busy && adv->hash == hash && adv->heard < 0xff) {
+			adv->heard++;
+		}
+	}
+}
+
+void bt_mesh_adv_relay_stats_get(struct bt_mesh_adv_relay_stats *stats)
+{
+	*stats = relay.stats;
+}
+
+static struct net_buf *adv_get(s32_t timeout)
+{
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &adv_queue),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &relay_queue),
+	};
+	struct net_buf *buf;
+
+	/* Locally originated messages always go first */
+	buf = net_buf_get(&adv_queue, K_NO_WAIT);
+	if (buf) {
+		return buf;
+	}
+
+	buf = net_buf_get(&relay_queue, K_NO_WAIT);
+	if (buf || timeout == K_NO_WAIT) {
+		return buf;
+	}
+
+	/* Fails also when bt_mesh_adv_update() cancels the wait */
+	if (k_poll(events, ARRAY_SIZE(events), timeout)) {
+		return NULL;
+	}
+
+	buf = net_buf_get(&adv_queue, K_NO_WAIT);
+	if (buf) {
+		return buf;
+	}
+
+	return net_buf_get(&relay_queue, K_NO_WAIT);
+}
+#else
+static inline bool relay_prepare(struct net_buf *buf)
+{
+	return true;
+}
+
+static inline struct net_buf *adv_get(s32_t timeout)
+{
+	return net_buf_get(&adv_queue, timeout);
+}
+#endif /* CONFIG_BT_MESH_RELAY_SCHED */
+
 static inline void adv_send_start(u16_t duration, int err,
 				  const struct bt_mesh_send_cb *cb,
 				  void *cb_data)
@@ -164,18 +316,18 @@ static void adv_thread(void *p1, void *p2, void *p3)
 		struct net_buf *buf;
 
 		if (IS_ENABLED(CONFIG_BT_MESH_PROXY)) {
-			buf = net_buf_get(&adv_queue, K_NO_WAIT);
+			buf = adv_get(K_NO_WAIT);
 			while (!buf) {
 				s32_t timeout;
 
 				timeout = bt_mesh_proxy_adv_start();
 				BT_DBG("Proxy Advertising up to %d ms",
 				       timeout);
-				buf = net_buf_get(&adv_queue, timeout);
+				buf = adv_get(timeout);
 				bt_mesh_proxy_adv_stop();
 			}
 		} else {
-			buf = net_buf_get(&adv_queue, K_FOREVER);
+			buf = adv_get(K_FOREVER);
 		}
 
 		if (!buf) {
@@ -185,7 +337,12 @@ static void adv_thread(void *p1, void *p2, void *p3)
 		/* busy == 0 means this was canceled */
 		if (BT_MESH_ADV(buf)->busy) {
 			BT_MESH_ADV(buf)->busy = 0U;
-			adv_send(buf);
+
+			if (BT_MESH_ADV(buf)->relay && !relay_prepare(buf)) {
+				net_buf_unref(buf);
+			} else {
+				adv_send(buf);
+			}
 		}
 
 		STACK_ANALYZE("adv stack", adv_thread_stack);
@@ -249,6 +406,13 @@ void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 	BT_MESH_ADV(buf)->cb_data = cb_data;
 	BT_MESH_ADV(buf)->busy = 1U;
 
+#if defined(CONFIG_BT_MESH_RELAY_SCHED)
+	if (BT_MESH_ADV(buf)->relay) {
+		net_buf_put(&relay_queue, net_buf_ref(buf));
+		return;
+	}
+#endif
+
 	net_buf_put(&adv_queue, net_buf_ref(buf));
 }
 
@@ -284,6 +448,9 @@ static void bt_mesh_scan_cb(const bt_addr_le_t *addr, s8_t rssi,
 
 		switch (type) {
 		case BT_DATA_MESH_MESSAGE:
+#if defined(CONFIG_BT_MESH_RELAY_SCHED)
+			atomic_inc(&relay.rx_count);
+#endif
 			bt_mesh_net_recv(buf, rssi, BT_MESH_NET_IF_ADV);
 			break;
 #if defined(CONFIG_BT_MESH_PB_ADV)
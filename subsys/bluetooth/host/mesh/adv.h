@@ -29,7 +29,8 @@ struct bt_mesh_adv {
 	void *cb_data;
 
 	u8_t      type:2,
-		  busy:1;
+		  busy:1,
+		  relay:1;
 	u8_t      xmit;
 
 	union {
@@ -59,6 +60,36 @@ void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 
 void bt_mesh_adv_update(void);
 
+struct bt_mesh_adv_relay_stats {
+	/* Relayed network PDUs sent out */
+	u32_t sent;
+	/* Relayed network PDUs dropped, already heard often enough */
+	u32_t suppressed;
+	/* Relayed network PDUs sent with fewer retransmissions */
+	u32_t reduced;
+	/* Received mesh messages per second, as last measured */
+	u16_t density;
+};
+
+#if defined(CONFIG_BT_MESH_RELAY_SCHED)
+/* Relay buffers come from their own pool and queue, so that relaying
+ * neither delays nor starves locally originated messages. hash is the
+ * Network Message Cache value of the relayed message.
+ */
+struct net_buf *bt_mesh_adv_relay_create(u8_t xmit, u64_t hash);
+
+void bt_mesh_adv_relay_heard(u64_t hash);
+
+void bt_mesh_adv_relay_stats_get(struct bt_mesh_adv_relay_stats *stats);
+#else
+static inline struct net_buf *bt_mesh_adv_relay_create(u8_t xmit, u64_t hash)
+{
+	return bt_mesh_adv_create(BT_MESH_ADV_DATA, xmit, K_NO_WAIT);
+}
+
+static inline void bt_mesh_adv_relay_heard(u64_t hash) {}
+#endif
+
 void bt_mesh_adv_init(void);
 
 int bt_mesh_scan_enable(void);
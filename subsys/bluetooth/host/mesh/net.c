@@ -73,6 +73,12 @@ static struct friend_cred friend_cred[FRIEND_CRED_COUNT];
 static u64_t msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static u16_t msg_cache_next;
 
+/* Open addressing index of the message cache, holding cache positions
+ * plus one. Twice the size of the cache to keep probe sequences short.
+ */
+#define MSG_CACHE_INDEX_SIZE (2 * CONFIG_BT_MESH_MSG_CACHE_SIZE)
+static u16_t msg_cache_index[MSG_CACHE_INDEX_SIZE];
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -124,21 +130,74 @@ static u64_t msg_hash(struct bt_mesh_net_rx *rx, struct net_buf_simple *pdu)
 	return (u64_t)hash1 << 32 | (u64_t)hash2;
 }
 
+static u32_t msg_cache_home(u64_t hash)
+{
+	u32_t h = (u32_t)hash ^ (u32_t)(hash >> 32);
+
+	return (h * 2654435761U) % MSG_CACHE_INDEX_SIZE;
+}
+
+/* Index slot holding the hash, or the empty slot ending its probe */
+static u32_t msg_cache_slot(u64_t hash)
+{
+	u32_t i = msg_cache_home(hash);
+
+	while (msg_cache_index[i] &&
+	       msg_cache[msg_cache_index[i] - 1] != hash) {
+		i = (i + 1) % MSG_CACHE_INDEX_SIZE;
+	}
+
+	return i;
+}
+
+/* Linear probing deletion, move later entries of the probe sequence
+ * back so that no lookup stops early at the freed slot.
+ */
+static void msg_cache_index_del(u32_t i)
+{
+	u32_t j = i;
+	u32_t k;
+
+	while (true) {
+		msg_cache_index[i] = 0U;
+
+		do {
+			j = (j + 1) % MSG_CACHE_INDEX_SIZE;
+			if (!msg_cache_index[j]) {
+				return;
+			}
+
+			k = msg_cache_home(msg_cache[msg_cache_index[j] - 1]);
+		} while ((i <= j) ? ((i < k) && (k <= j)) :
+				    ((i < k) || (k <= j)));
+
+		msg_cache_index[i] = msg_cache_index[j];
+		i = j;
+	}
+}
+
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 			    struct net_buf_simple *pdu)
 {
 	u64_t hash = msg_hash(rx, pdu);
-	u16_t i;
+	u32_t i;
 
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i] == hash) {
-			return true;
-		}
+	i = msg_cache_slot(hash);
+	if (msg_cache_index[i]) {
+		bt_mesh_adv_relay_heard(hash);
+		return true;
+	}
+
+	/* Evict the oldest entry, if its position is in use */
+	i = msg_cache_slot(msg_cache[msg_cache_next]);
+	if (msg_cache_index[i] == msg_cache_next + 1) {
+		msg_cache_index_del(i);
 	}
 
 	/* Add to the cache */
-	msg_cache[msg_cache_next++] = hash;
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
+	msg_cache[msg_cache_next] = hash;
+	msg_cache_index[msg_cache_slot(hash)] = msg_cache_next + 1;
+	msg_cache_next = (msg_cache_next + 1) % ARRAY_SIZE(msg_cache);
 
 	return false;
 }
@@ -449,6 +508,7 @@ int bt_mesh_net_create(u16_t idx, u8_t flags, const u8_t key[16],
 	BT_DBG("NetKey %s", bt_hex(key, 16));
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_index, 0, sizeof(msg_cache_index));
 	msg_cache_next = 0U;
 
 	sub = &bt_mesh.sub[0];
@@ -1019,89 +1079,148 @@ static int net_decrypt(struct bt_mesh_subnet *sub, const u8_t *enc,
 	return bt_mesh_net_decrypt(enc, buf, BT_MESH_NET_IVI_RX(rx), false);
 }
 
-#if (defined(CONFIG_BT_MESH_LOW_POWER) || \
-     defined(CONFIG_BT_MESH_FRIEND))
-static int friend_decrypt(struct bt_mesh_subnet *sub, const u8_t *data,
-			  size_t data_len, struct bt_mesh_net_rx *rx,
-			  struct net_buf_simple *buf)
+/* Network PDUs are decrypted by trying every credential with a matching
+ * NID. As the 7 bit NID often matches more than one subnet or friendship,
+ * the credentials that recently decrypted a PDU are tried first.
+ */
+#define NET_RX_CRED_CACHE 4
+
+struct net_rx_cred {
+	struct bt_mesh_subnet *sub;
+	struct friend_cred *frnd; /* NULL for the subnet credentials */
+	u8_t idx;                 /* Key index, 1 for the new key */
+};
+
+static struct net_rx_cred rx_cred_cache[NET_RX_CRED_CACHE];
+
+static bool rx_cred_eq(const struct net_rx_cred *a,
+		       const struct net_rx_cred *b)
 {
-	int i;
+	return a->sub == b->sub && a->frnd == b->frnd && a->idx == b->idx;
+}
 
-	BT_DBG("NID 0x%02x net_idx 0x%04x", NID(data), sub->net_idx);
+static int rx_cred_decrypt(const struct net_rx_cred *c, const u8_t *data,
+			   size_t data_len, struct bt_mesh_net_rx *rx,
+			   struct net_buf_simple *buf)
+{
+	struct bt_mesh_subnet *sub = c->sub;
+	const u8_t *enc, *priv;
+	u8_t nid;
 
-	for (i = 0; i < ARRAY_SIZE(friend_cred); i++) {
-		struct friend_cred *cred = &friend_cred[i];
+	/* Entries of the cache may have gone stale, check against the
+	 * current state of the subnet and credential.
+	 */
+	if (sub->net_idx == BT_MESH_KEY_UNUSED ||
+	    (c->idx && sub->kr_phase == BT_MESH_KR_NORMAL)) {
+		return -ENOENT;
+	}
 
-		if (cred->net_idx != sub->net_idx) {
-			continue;
+	if (c->frnd) {
+		if (c->frnd->net_idx != sub->net_idx) {
+			return -ENOENT;
 		}
 
-		if (NID(data) == cred->cred[0].nid &&
-		    !net_decrypt(sub, cred->cred[0].enc, cred->cred[0].privacy,
-				 data, data_len, rx, buf)) {
-			return 0;
-		}
+		nid = c->frnd->cred[c->idx].nid;
+		enc = c->frnd->cred[c->idx].enc;
+		priv = c->frnd->cred[c->idx].privacy;
+	} else {
+		nid = sub->keys[c->idx].nid;
+		enc = sub->keys[c->idx].enc;
+		priv = sub->keys[c->idx].privacy;
+	}
 
-		if (sub->kr_phase == BT_MESH_KR_NORMAL) {
-			continue;
-		}
+	if (NID(data) != nid ||
+	    net_decrypt(sub, enc, priv, data, data_len, rx, buf)) {
+		return -ENOENT;
+	}
 
-		if (NID(data) == cred->cred[1].nid &&
-		    !net_decrypt(sub, cred->cred[1].enc, cred->cred[1].privacy,
-				 data, data_len, rx, buf)) {
-			rx->new_key = 1U;
-			return 0;
+	rx->friend_cred = (c->frnd != NULL);
+	rx->new_key = c->idx;
+	rx->ctx.net_idx = sub->net_idx;
+	rx->sub = sub;
+
+	return 0;
+}
+
+static void rx_cred_cache_update(const struct net_rx_cred *c, int pos)
+{
+	/* Move to front, pos being the current entry or the last one */
+	if (pos >= ARRAY_SIZE(rx_cred_cache)) {
+		pos = ARRAY_SIZE(rx_cred_cache) - 1;
+	}
+
+	memmove(&rx_cred_cache[1], &rx_cred_cache[0],
+		pos * sizeof(rx_cred_cache[0]));
+	rx_cred_cache[0] = *c;
+}
+
+static bool rx_cred_try(const struct net_rx_cred *c, const u8_t *data,
+			size_t data_len, struct bt_mesh_net_rx *rx,
+			struct net_buf_simple *buf)
+{
+	int i;
+
+	/* Skip the credentials already tried from the cache */
+	for (i = 0; i < ARRAY_SIZE(rx_cred_cache); i++) {
+		if (rx_cred_cache[i].sub && rx_cred_eq(&rx_cred_cache[i], c)) {
+			return false;
 		}
 	}
 
-	return -ENOENT;
+	if (rx_cred_decrypt(c, data, data_len, rx, buf)) {
+		return false;
+	}
+
+	rx_cred_cache_update(c, ARRAY_SIZE(rx_cred_cache));
+
+	return true;
 }
-#endif
 
 static bool net_find_and_decrypt(const u8_t *data, size_t data_len,
 				 struct bt_mesh_net_rx *rx,
 				 struct net_buf_simple *buf)
 {
-	struct bt_mesh_subnet *sub;
+	struct net_rx_cred c;
 	int i;
 
 	BT_DBG("");
 
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.sub); i++) {
-		sub = &bt_mesh.sub[i];
-		if (sub->net_idx == BT_MESH_KEY_UNUSED) {
-			continue;
+	for (i = 0; i < ARRAY_SIZE(rx_cred_cache); i++) {
+		if (!rx_cred_cache[i].sub) {
+			break;
 		}
 
-#if (defined(CONFIG_BT_MESH_LOW_POWER) || \
-     defined(CONFIG_BT_MESH_FRIEND))
-		if (!friend_decrypt(sub, data, data_len, rx, buf)) {
-			rx->friend_cred = 1U;
-			rx->ctx.net_idx = sub->net_idx;
-			rx->sub = sub;
+		if (!rx_cred_decrypt(&rx_cred_cache[i], data, data_len, rx,
+				     buf)) {
+			c = rx_cred_cache[i];
+			rx_cred_cache_update(&c, i);
 			return true;
 		}
-#endif
+	}
 
-		if (NID(data) == sub->keys[0].nid &&
-		    !net_decrypt(sub, sub->keys[0].enc, sub->keys[0].privacy,
-				 data, data_len, rx, buf)) {
-			rx->ctx.net_idx = sub->net_idx;
-			rx->sub = sub;
-			return true;
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.sub); i++) {
+		c.sub = &bt_mesh.sub[i];
+		if (c.sub->net_idx == BT_MESH_KEY_UNUSED) {
+			continue;
 		}
 
-		if (sub->kr_phase == BT_MESH_KR_NORMAL) {
-			continue;
+#if FRIEND_CRED_COUNT > 0
+		for (c.frnd = friend_cred;
+		     c.frnd < &friend_cred[ARRAY_SIZE(friend_cred)]; c.frnd++) {
+			for (c.idx = 0U; c.idx < 2; c.idx++) {
+				if (rx_cred_try(&c, data, data_len, rx, buf)) {
+					return true;
+				}
+			}
 		}
+#endif
 
-		if (NID(data) == sub->keys[1].nid &&
-		    !net_decrypt(sub, sub->keys[1].enc, sub->keys[1].privacy,
-				 data, data_len, rx, buf)) {
-			rx->new_key = 1U;
-			rx->ctx.net_idx = sub->net_idx;
-			rx->sub = sub;
-			return true;
+		c.frnd = NULL;
+
+		for (c.idx = 0U; c.idx < 2; c.idx++) {
+			if (rx_cred_try(&c, data, data_len, rx, buf)) {
+				return true;
+			}
 		}
 	}
 
@@ -1169,7 +1288,12 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		transmit = bt_mesh_net_transmit_get();
 	}
 
-	buf = bt_mesh_adv_create(BT_MESH_ADV_DATA, transmit, K_NO_WAIT);
+	if (rx->net_if == BT_MESH_NET_IF_ADV) {
+		buf = bt_mesh_adv_relay_create(transmit, msg_hash(rx, sbuf));
+	} else {
+		buf = bt_mesh_adv_create(BT_MESH_ADV_DATA, transmit, K_NO_WAIT);
+	}
+
 	if (!buf) {
 		BT_ERR("Out of relay buffers");
 		return;
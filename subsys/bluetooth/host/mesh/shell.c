@@ -21,6 +21,7 @@
 #include <bluetooth/mesh.h>
 
 /* Private includes for raw Network & Transport layer access */
+#include "adv.h"
 #include "mesh.h"
 #include "net.h"
 #include "transport.h"
@@ -779,6 +780,22 @@ static int cmd_rpl_clear(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_SCHED)
+static int cmd_relay_stats(const struct shell *shell, size_t argc,
+			   char *argv[])
+{
+	struct bt_mesh_adv_relay_stats stats;
+
+	bt_mesh_adv_relay_stats_get(&stats);
+
+	shell_print(shell, "Relayed %u, suppressed %u, reduced %u",
+		    stats.sent, stats.suppressed, stats.reduced);
+	shell_print(shell, "Channel density %u msg/s", stats.density);
+
+	return 0;
+}
+#endif /* CONFIG_BT_MESH_RELAY_SCHED */
+
 static int cmd_beacon(const struct shell *shell, size_t argc, char *argv[])
 {
 	u8_t status;
@@ -1966,6 +1983,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(mesh_cmds,
 	SHELL_CMD_ARG(iv-update-test, NULL, "<value: off, on>",
 		      cmd_iv_update_test, 2, 0),
 	SHELL_CMD_ARG(rpl-clear, NULL, NULL, cmd_rpl_clear, 1, 0),
+#if defined(CONFIG_BT_MESH_RELAY_SCHED)
+	SHELL_CMD_ARG(relay-stats, NULL, NULL, cmd_relay_stats, 1, 0),
+#endif
 
 	/* Configuration Client Model operations */
 	SHELL_CMD_ARG(get-comp, NULL, "[page]", cmd_get_comp, 1, 1),
@@ -98,15 +98,14 @@ static struct seg_rx {
 	u32_t                    block;
 	u32_t                    last;
 	struct k_delayed_work    ack;
-	struct net_buf_simple    buf;
-} seg_rx[CONFIG_BT_MESH_RX_SEG_MSG_COUNT] = {
-	[0 ... (CONFIG_BT_MESH_RX_SEG_MSG_COUNT - 1)] = {
-		.buf.size = CONFIG_BT_MESH_RX_SDU_MAX,
-	},
-};
+	struct net_buf          *buf;           /* Only while in use */
+} seg_rx[CONFIG_BT_MESH_RX_SEG_MSG_COUNT];
 
-static u8_t __noinit seg_rx_buf_data[(CONFIG_BT_MESH_RX_SEG_MSG_COUNT *
-				      CONFIG_BT_MESH_RX_SDU_MAX)];
+/* Segments are placed straight at their final offset in the SDU, as the
+ * Upper Transport PDU needs to be contiguous for decryption.
+ */
+NET_BUF_POOL_FIXED_DEFINE(seg_rx_pool, CONFIG_BT_MESH_RX_SDU_BUF_COUNT,
+			  CONFIG_BT_MESH_RX_SDU_MAX, NULL);
 
 static u16_t hb_sub_dst = BT_MESH_ADDR_UNASSIGNED;
 
@@ -531,55 +530,144 @@ int bt_mesh_trans_resend(struct bt_mesh_net_tx *tx, struct net_buf_simple *msg,
 	return err;
 }
 
-static bool is_replay(struct bt_mesh_net_rx *rx)
+/* Open addressing index of bt_mesh.rpl, holding entry positions plus one.
+ * The list itself is also changed by IV Index updates, settings and
+ * resets, so a hit is only taken if the entry still has the address, and
+ * a miss falls back to searching the list. Once probing finds no free
+ * slot any more, the index is rebuilt from the list.
+ */
+#define RPL_INDEX_SIZE (2 * CONFIG_BT_MESH_CRPL)
+static u16_t rpl_index[RPL_INDEX_SIZE];
+
+static u32_t rpl_home(u16_t src)
+{
+	return ((u32_t)src * 2654435761U) % RPL_INDEX_SIZE;
+}
+
+static struct bt_mesh_rpl *rpl_index_find(u16_t src)
+{
+	u32_t i = rpl_home(src);
+	u32_t n;
+
+	for (n = 0U; n < RPL_INDEX_SIZE && rpl_index[i]; n++) {
+		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[rpl_index[i] - 1];
+
+		if (rpl->src == src) {
+			return rpl;
+		}
+
+		i = (i + 1) % RPL_INDEX_SIZE;
+	}
+
+	return NULL;
+}
+
+static bool rpl_index_insert(struct bt_mesh_rpl *rpl)
+{
+	u32_t i = rpl_home(rpl->src);
+	u32_t n;
+
+	for (n = 0U; n < RPL_INDEX_SIZE; n++) {
+		if (!rpl_index[i]) {
+			rpl_index[i] = rpl - bt_mesh.rpl + 1;
+			return true;
+		}
+
+		i = (i + 1) % RPL_INDEX_SIZE;
+	}
+
+	return false;
+}
+
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
 {
 	int i;
 
-	/* Don't bother checking messages from ourselves */
-	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
-		return false;
+	if (rpl_index_insert(rpl)) {
+		return;
 	}
 
+	/* Filled up with entries gone stale, start over from the list */
+	(void)memset(rpl_index, 0, sizeof(rpl_index));
+
 	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+		if (bt_mesh.rpl[i].src) {
+			(void)rpl_index_insert(&bt_mesh.rpl[i]);
+		}
+	}
+}
+
+static struct bt_mesh_rpl *rpl_get(u16_t src, bool *created)
+{
+	struct bt_mesh_rpl *rpl, *free_slot = NULL;
+	int i;
 
-		/* Empty slot */
-		if (!rpl->src) {
-			rpl->src = rx->ctx.addr;
-			rpl->seq = rx->seq;
-			rpl->old_iv = rx->old_iv;
+	*created = false;
 
-			if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-				bt_mesh_store_rpl(rpl);
-			}
+	rpl = rpl_index_find(src);
+	if (rpl) {
+		return rpl;
+	}
 
-			return false;
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		rpl = &bt_mesh.rpl[i];
+
+		/* Existing slot for given address, e.g. restored from
+		 * settings.
+		 */
+		if (rpl->src == src) {
+			rpl_index_add(rpl);
+			return rpl;
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		if (!rpl->src && !free_slot) {
+			free_slot = rpl;
+		}
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				rpl->seq = rx->seq;
-				rpl->old_iv = rx->old_iv;
+	if (free_slot) {
+		free_slot->src = src;
+		rpl_index_add(free_slot);
+		*created = true;
+	}
 
-				if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-					bt_mesh_store_rpl(rpl);
-				}
+	return free_slot;
+}
 
-				return false;
-			} else {
-				return true;
-			}
+static bool is_replay(struct bt_mesh_net_rx *rx)
+{
+	struct bt_mesh_rpl *rpl;
+	bool created;
+
+	/* Don't bother checking messages from ourselves */
+	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
+		return false;
+	}
+
+	rpl = rpl_get(rx->ctx.addr, &created);
+	if (!rpl) {
+		BT_ERR("RPL is full!");
+		return true;
+	}
+
+	if (!created) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
+
+		if ((rx->old_iv || !rpl->old_iv) && rpl->seq >= rx->seq) {
+			return true;
 		}
 	}
 
-	BT_ERR("RPL is full!");
-	return true;
+	rpl->seq = rx->seq;
+	rpl->old_iv = rx->old_iv;
+
+	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+		bt_mesh_store_rpl(rpl);
+	}
+
+	return false;
 }
 
 static int sdu_recv(struct bt_mesh_net_rx *rx, u32_t seq, u8_t hdr,
@@ -915,8 +1003,11 @@ static inline s32_t ack_timeout(struct seg_rx *rx)
 	 */
 	to = K_MSEC(150 + (ttl * 50U));
 
-	/* 100 ms for every not yet received segment */
-	to += K_MSEC(((rx->seg_n + 1) - popcount(rx->block)) * 100U);
+	/* 100 ms for every segment after the highest received one. Missing
+	 * segments below it got lost, so there's no point in waiting for
+	 * them before acking.
+	 */
+	to += K_MSEC(((rx->seg_n + 1) - find_msb_set(rx->block)) * 100U);
 
 	/* Make sure we don't send more frequently than the duration for
 	 * each packet (default is 300ms).
@@ -1016,6 +1107,11 @@ static void seg_rx_reset(struct seg_rx *rx, bool full_reset)
 
 	rx->in_use = 0U;
 
+	if (rx->buf) {
+		net_buf_unref(rx->buf);
+		rx->buf = NULL;
+	}
+
 	/* We don't always reset these values since we need to be able to
 	 * send an ack if we receive a segment after we've already received
 	 * the full SDU.
@@ -1136,8 +1232,13 @@ static struct seg_rx *seg_rx_alloc(struct bt_mesh_net_rx *net_rx,
 			continue;
 		}
 
+		rx->buf = net_buf_alloc(&seg_rx_pool, K_NO_WAIT);
+		if (!rx->buf) {
+			BT_WARN("No free buffers for incoming SDU");
+			return NULL;
+		}
+
 		rx->in_use = 1U;
-		net_buf_simple_reset(&rx->buf);
 		rx->sub = net_rx->sub;
 		rx->ctl = net_rx->ctl;
 		rx->seq_auth = *seq_auth;
@@ -1276,11 +1377,11 @@ found_rx:
 	 */
 	if (seg_o == seg_n) {
 		/* Set the expected final buffer length */
-		rx->buf.len = seg_n * seg_len(rx->ctl) + buf->len;
+		rx->buf->len = seg_n * seg_len(rx->ctl) + buf->len;
 		BT_DBG("Target len %u * %u + %u = %u", seg_n, seg_len(rx->ctl),
-		       buf->len, rx->buf.len);
+		       buf->len, rx->buf->len);
 
-		if (rx->buf.len > CONFIG_BT_MESH_RX_SDU_MAX) {
+		if (rx->buf->len > CONFIG_BT_MESH_RX_SDU_MAX) {
 			BT_ERR("Too large SDU len");
 			send_ack(net_rx->sub, net_rx->ctx.recv_dst,
 				 net_rx->ctx.addr, net_rx->ctx.send_ttl,
@@ -1298,19 +1399,26 @@ found_rx:
 	/* Reset the Incomplete Timer */
 	rx->last = k_uptime_get_32();
 
-	if (!k_delayed_work_remaining_get(&rx->ack) &&
-	    !bt_mesh_lpn_established()) {
-		k_delayed_work_submit(&rx->ack, ack_timeout(rx));
-	}
-
 	/* Location in buffer can be calculated based on seg_o & rx->ctl */
-	memcpy(rx->buf.data + (seg_o * seg_len(rx->ctl)), buf->data, buf->len);
+	memcpy(rx->buf->data + (seg_o * seg_len(rx->ctl)), buf->data,
+	       buf->len);
 
 	BT_DBG("Received %u/%u", seg_o, seg_n);
 
 	/* Mark segment as received */
 	rx->block |= BIT(seg_o);
 
+	if (!bt_mesh_lpn_established()) {
+		s32_t remaining = k_delayed_work_remaining_get(&rx->ack);
+
+		/* Ack sooner once a gap shows that segments got lost */
+		if (!remaining ||
+		    ((rx->block & BIT_MASK(seg_o)) != BIT_MASK(seg_o) &&
+		     remaining > ack_timeout(rx))) {
+			k_delayed_work_submit(&rx->ack, ack_timeout(rx));
+		}
+	}
+
 	if (rx->block != BLOCK_COMPLETE(seg_n)) {
 		*pdu_type = BT_MESH_FRIEND_PDU_PARTIAL;
 		return 0;
@@ -1333,10 +1441,10 @@ found_rx:
 		 net_rx->ctx.send_ttl, seq_auth, rx->block, rx->obo);
 
 	if (net_rx->ctl) {
-		err = ctl_recv(net_rx, *hdr, &rx->buf, seq_auth);
+		err = ctl_recv(net_rx, *hdr, &rx->buf->b, seq_auth);
 	} else {
 		err = sdu_recv(net_rx, (rx->seq_auth & 0xffffff), *hdr,
-			       ASZMIC(hdr), &rx->buf);
+			       ASZMIC(hdr), &rx->buf->b);
 	}
 
 	seg_rx_reset(rx, false);
@@ -1468,9 +1576,6 @@ void bt_mesh_trans_init(void)
 
 	for (i = 0; i < ARRAY_SIZE(seg_rx); i++) {
 		k_delayed_work_init(&seg_rx[i].ack, seg_ack);
-		seg_rx[i].buf.__buf = (seg_rx_buf_data +
-				       (i * CONFIG_BT_MESH_RX_SDU_MAX));
-		seg_rx[i].buf.data = seg_rx[i].buf.__buf;
 	}
 }
 
@@ -3226,7 +3226,7 @@ static u8_t smp_ident_addr_info(struct bt_smp *smp, struct net_buf *buf)
 			 * present before ie. due to re-pairing.
 			 */
 			if (!bt_addr_le_is_identity(&conn->le.dst)) {
-				bt_addr_le_copy(&keys->addr, &req->addr);
+				bt_keys_addr_set(keys, &req->addr);
 				bt_addr_le_copy(&conn->le.dst, &req->addr);
 
 				bt_conn_identity_resolved(conn);
@@ -23,6 +23,7 @@
 #include <settings/settings.h>
 
 #include <bluetooth/hci.h>
+#include <bluetooth/hci_vs.h>
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/conn.h>
 #include <bluetooth/rfcomm.h>
@@ -368,6 +369,58 @@ static int cmd_hci_cmd(const struct shell *shell, size_t argc, char *argv[])
 
 	return 0;
 }
+
+static int cmd_ctlr_prof(const struct shell *shell, size_t argc, char *argv[])
+{
+	static const char * const role_str[] = { "adv", "scan", "conn" };
+	struct bt_hci_cp_vs_read_ctlr_prof *cp;
+	struct bt_hci_rp_vs_read_ctlr_prof *rp;
+	struct net_buf *buf, *rsp;
+	int err;
+	u8_t i;
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_VS_READ_CTLR_PROF, sizeof(*cp));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->reset = (argc > 1 && !strcmp(argv[1], "reset")) ? 1U : 0U;
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_READ_CTLR_PROF, buf, &rsp);
+	if (err) {
+		shell_error(shell, "Read controller profile failed (err %d)",
+			    err);
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+	if (rsp->len < sizeof(*rp) || rp->status) {
+		shell_error(shell, "Controller profile not supported");
+		net_buf_unref(rsp);
+		return -ENOTSUP;
+	}
+
+	for (i = 0U; i < BT_HCI_VS_PROF_ROLE_COUNT; i++) {
+		shell_print(shell, "%-4s events %u radio %u us aborted %u "
+			    "skipped %u", role_str[i],
+			    sys_le32_to_cpu(rp->role[i].events),
+			    sys_le32_to_cpu(rp->role[i].radio_us),
+			    sys_le32_to_cpu(rp->role[i].aborted),
+			    sys_le32_to_cpu(rp->role[i].skipped));
+	}
+
+	shell_print(shell, "mayfly max depth lll %u ull_high %u ull_low %u "
+		    "thread %u", rp->mayfly_max[0], rp->mayfly_max[1],
+		    rp->mayfly_max[2], rp->mayfly_max[3]);
+	shell_print(shell, "prep max %u tx_ack max %u done free min %u "
+		    "rx free min %u", rp->prep_max, rp->tx_ack_max,
+		    rp->done_free_min, rp->rx_free_min);
+
+	net_buf_unref(rsp);
+
+	return 0;
+}
 #endif /* CONFIG_BT_HCI */
 
 static int cmd_name(const struct shell *shell, size_t argc, char *argv[])
@@ -1304,6 +1357,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bt_cmds,
 	SHELL_CMD_ARG(init, NULL, HELP_ADDR_LE, cmd_init, 1, 0),
 #if defined(CONFIG_BT_HCI)
 	SHELL_CMD_ARG(hci-cmd, NULL, "<ogf> <ocf> [data]", cmd_hci_cmd, 3, 1),
+	SHELL_CMD_ARG(ctlr-prof, NULL, "[reset]", cmd_ctlr_prof, 1, 1),
 #endif
 	SHELL_CMD_ARG(id-create, NULL, "[addr]", cmd_id_create, 1, 1),
 	SHELL_CMD_ARG(id-reset, NULL, "<id> [addr]", cmd_id_reset, 2, 1),
@@ -0,0 +1,785 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(isotp, CONFIG_ISOTP_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+#include <misc/util.h>
+#include <canbus/isotp.h>
+
+#include "isotp_internal.h"
+
+/* Received messages are reassembled in place into fragments of this pool
+ * and handed over to the application without copying.
+ */
+NET_BUF_POOL_FIXED_DEFINE(isotp_rx_pool, CONFIG_ISOTP_RX_BUF_COUNT,
+			  CONFIG_ISOTP_RX_BUF_SIZE, NULL);
+
+#define ISOTP_RX_LEN_MAX MIN(ISOTP_MSG_LEN_MAX, \
+			     CONFIG_ISOTP_RX_BUF_COUNT * \
+			     CONFIG_ISOTP_RX_BUF_SIZE)
+
+static void frame_prepare(struct zcan_frame *frame,
+			  const struct isotp_msg_id *addr, u8_t *pos)
+{
+	frame->id_type = addr->id_type;
+	frame->rtr = CAN_DATAFRAME;
+
+	if (addr->id_type == CAN_STANDARD_IDENTIFIER) {
+		frame->std_id = addr->std_id;
+	} else {
+		frame->ext_id = addr->ext_id;
+	}
+
+	*pos = 0U;
+	if (addr->use_ext_addr) {
+		frame->data[(*pos)++] = addr->ext_addr;
+	}
+}
+
+static void frame_finish(struct zcan_frame *frame, u8_t len)
+{
+#if defined(CONFIG_ISOTP_TX_PADDING)
+	(void)memset(&frame->data[len], ISOTP_PAD_BYTE, CAN_MAX_DLEN - len);
+	frame->dlc = CAN_MAX_DLEN;
+#else
+	frame->dlc = len;
+#endif
+}
+
+static void filter_prepare(struct zcan_filter *filter,
+			   const struct isotp_msg_id *addr)
+{
+	filter->id_type = addr->id_type;
+	filter->rtr = CAN_DATAFRAME;
+	filter->rtr_mask = 1U;
+
+	if (addr->id_type == CAN_STANDARD_IDENTIFIER) {
+		filter->std_id = addr->std_id;
+		filter->std_id_mask = CAN_STD_ID_MASK;
+	} else {
+		filter->ext_id = addr->ext_id;
+		filter->ext_id_mask = CAN_EXT_ID_MASK;
+	}
+}
+
+/* Start of the PCI in a received frame, or -1 if not addressed to us */
+static int frame_pci_pos(const struct zcan_frame *frame,
+			 const struct isotp_msg_id *addr)
+{
+	int pos = 0;
+
+	if (addr->use_ext_addr) {
+		if (!frame->dlc || frame->data[0] != addr->ext_addr) {
+			return -1;
+		}
+
+		pos = 1;
+	}
+
+	return (frame->dlc > pos) ? pos : -1;
+}
+
+static inline s32_t stmin_to_ms(u8_t stmin)
+{
+	if (stmin <= 0x7F) {
+		return stmin;
+	}
+
+	/* 100 - 900 us, rounded up to the timer resolution */
+	if (stmin >= 0xF1 && stmin <= 0xF9) {
+		return 1;
+	}
+
+	/* reserved values shall be handled as the longest separation time */
+	return 0x7F;
+}
+
+static void tx_ignore_cb(u32_t error_flags, void *arg)
+{
+	ARG_UNUSED(arg);
+
+	if (error_flags) {
+		LOG_DBG("Flow control not sent (%u)", error_flags);
+	}
+}
+
+/* Receive */
+
+static void recv_reset(struct isotp_recv_ctx *ctx)
+{
+	k_timer_stop(&ctx->timer);
+
+	if (ctx->buf) {
+		net_buf_unref(ctx->buf);
+		ctx->buf = NULL;
+	}
+
+	ctx->state = ISOTP_RX_STATE_IDLE;
+}
+
+static void recv_complete(struct isotp_recv_ctx *ctx)
+{
+	k_timer_stop(&ctx->timer);
+
+	net_buf_put(&ctx->fifo, ctx->buf);
+	ctx->buf = NULL;
+
+	ctx->state = ISOTP_RX_STATE_IDLE;
+}
+
+static void recv_send_fc(struct isotp_recv_ctx *ctx, u8_t fs)
+{
+	struct zcan_frame frame;
+	u8_t pos;
+	int ret;
+
+	frame_prepare(&frame, &ctx->tx_addr, &pos);
+	frame.data[pos++] = ISOTP_PCI_TYPE_FC | fs;
+	frame.data[pos++] = ctx->opts.bs;
+	frame.data[pos++] = ctx->opts.stmin;
+	frame_finish(&frame, pos);
+
+	ret = can_send(ctx->can_dev, &frame, K_NO_WAIT, tx_ignore_cb, NULL);
+	if (ret) {
+		LOG_ERR("Can't send flow control (%d)", ret);
+	}
+}
+
+static int recv_append(struct isotp_recv_ctx *ctx, const u8_t *data,
+		       size_t len)
+{
+	while (len) {
+		size_t chunk;
+
+		if (!net_buf_tailroom(ctx->frag)) {
+			struct net_buf *frag;
+
+			frag = net_buf_alloc(&isotp_rx_pool, K_NO_WAIT);
+			if (!frag) {
+				return -ENOMEM;
+			}
+
+			net_buf_frag_insert(ctx->frag, frag);
+			ctx->frag = frag;
+		}
+
+		chunk = MIN(len, net_buf_tailroom(ctx->frag));
+		net_buf_add_mem(ctx->frag, data, chunk);
+
+		data += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static void recv_sf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame,
+		    u8_t pos)
+{
+	u8_t len = frame->data[pos++] & ISOTP_PCI_SF_DL_MASK;
+
+	if (!len || len > frame->dlc - pos) {
+		LOG_DBG("Invalid single frame length %u", len);
+		return;
+	}
+
+	/* a single frame terminates any reception in progress */
+	recv_reset(ctx);
+
+	ctx->buf = net_buf_alloc(&isotp_rx_pool, K_NO_WAIT);
+	if (!ctx->buf) {
+		LOG_WRN("No buffer for single frame");
+		ctx->error = ISOTP_N_BUFFER_OVERFLW;
+		return;
+	}
+
+	net_buf_add_mem(ctx->buf, &frame->data[pos], len);
+
+	recv_complete(ctx);
+}
+
+static void recv_ff(struct isotp_recv_ctx *ctx, struct zcan_frame *frame,
+		    u8_t pos)
+{
+	size_t len;
+
+	/* a first frame always uses the whole frame */
+	if (frame->dlc != CAN_MAX_DLEN) {
+		LOG_DBG("Invalid first frame dlc %u", frame->dlc);
+		return;
+	}
+
+	len = (frame->data[pos] & ISOTP_PCI_FF_DL_MASK) << 8 |
+	      frame->data[pos + 1];
+	pos += ISOTP_FF_PCI_LEN;
+
+	if (len <= CAN_MAX_DLEN - pos) {
+		LOG_DBG("First frame length %u fits a single frame",
+			(unsigned int)len);
+		return;
+	}
+
+	recv_reset(ctx);
+
+	if (len > ISOTP_RX_LEN_MAX) {
+		LOG_WRN("Message length %u exceeds buffers",
+			(unsigned int)len);
+		ctx->error = ISOTP_N_BUFFER_OVERFLW;
+		recv_send_fc(ctx, ISOTP_PCI_FS_OVFLW);
+		return;
+	}
+
+	ctx->buf = net_buf_alloc(&isotp_rx_pool, K_NO_WAIT);
+	if (!ctx->buf) {
+		LOG_WRN("No buffer for first frame");
+		ctx->error = ISOTP_N_BUFFER_OVERFLW;
+		recv_send_fc(ctx, ISOTP_PCI_FS_OVFLW);
+		return;
+	}
+
+	ctx->frag = ctx->buf;
+	net_buf_add_mem(ctx->buf, &frame->data[pos], CAN_MAX_DLEN - pos);
+
+	ctx->remaining = len - (CAN_MAX_DLEN - pos);
+	ctx->sn_expected = 1U;
+	ctx->bs_left = ctx->opts.bs;
+	ctx->state = ISOTP_RX_STATE_WAIT_CF;
+
+	recv_send_fc(ctx, ISOTP_PCI_FS_CTS);
+
+	k_timer_start(&ctx->timer, ISOTP_CR, 0);
+}
+
+static void recv_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame,
+		    u8_t pos)
+{
+	size_t len;
+
+	if (ctx->state != ISOTP_RX_STATE_WAIT_CF) {
+		LOG_DBG("Unexpected consecutive frame");
+		return;
+	}
+
+	if ((frame->data[pos] & ISOTP_PCI_SN_MASK) != ctx->sn_expected) {
+		LOG_ERR("Sequence number %u, expected %u",
+			frame->data[pos] & ISOTP_PCI_SN_MASK,
+			ctx->sn_expected);
+		ctx->error = ISOTP_N_WRONG_SN;
+		recv_reset(ctx);
+		return;
+	}
+
+	pos += ISOTP_CF_PCI_LEN;
+	ctx->sn_expected = (ctx->sn_expected + 1) & ISOTP_PCI_SN_MASK;
+
+	len = MIN(ctx->remaining, frame->dlc - pos);
+	if (recv_append(ctx, &frame->data[pos], len)) {
+		LOG_WRN("Out of buffers, message dropped");
+		ctx->error = ISOTP_N_BUFFER_OVERFLW;
+		recv_reset(ctx);
+		return;
+	}
+
+	ctx->remaining -= len;
+	if (!ctx->remaining) {
+		recv_complete(ctx);
+		return;
+	}
+
+	if (ctx->opts.bs && !--ctx->bs_left) {
+		ctx->bs_left = ctx->opts.bs;
+		recv_send_fc(ctx, ISOTP_PCI_FS_CTS);
+	}
+
+	k_timer_start(&ctx->timer, ISOTP_CR, 0);
+}
+
+static void recv_can_cb(struct zcan_frame *frame, void *arg)
+{
+	struct isotp_recv_ctx *ctx = arg;
+	unsigned int key;
+	int pos;
+
+	pos = frame_pci_pos(frame, &ctx->rx_addr);
+	if (pos < 0) {
+		return;
+	}
+
+	key = irq_lock();
+
+	switch (frame->data[pos] & ISOTP_PCI_TYPE_MASK) {
+	case ISOTP_PCI_TYPE_SF:
+		recv_sf(ctx, frame, pos);
+		break;
+
+	case ISOTP_PCI_TYPE_FF:
+		recv_ff(ctx, frame, pos);
+		break;
+
+	case ISOTP_PCI_TYPE_CF:
+		recv_cf(ctx, frame, pos);
+		break;
+
+	default:
+		/* flow control frames are not for a receiver */
+		break;
+	}
+
+	irq_unlock(key);
+}
+
+static void recv_timeout(struct k_timer *timer)
+{
+	struct isotp_recv_ctx *ctx = CONTAINER_OF(timer, struct isotp_recv_ctx,
+						  timer);
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (ctx->state == ISOTP_RX_STATE_WAIT_CF) {
+		LOG_WRN("Timeout waiting for consecutive frame");
+		ctx->error = ISOTP_N_TIMEOUT_CR;
+		recv_reset(ctx);
+	}
+
+	irq_unlock(key);
+}
+
+int isotp_bind(struct isotp_recv_ctx *ctx, struct device *can_dev,
+	       const struct isotp_msg_id *rx_addr,
+	       const struct isotp_msg_id *tx_addr,
+	       const struct isotp_fc_opts *opts)
+{
+	struct zcan_filter filter;
+
+	if (!ctx || !can_dev || !rx_addr || !tx_addr || !opts) {
+		return ISOTP_INVALID_PARAM;
+	}
+
+	ctx->can_dev = can_dev;
+	ctx->rx_addr = *rx_addr;
+	ctx->tx_addr = *tx_addr;
+	ctx->opts = *opts;
+	ctx->buf = NULL;
+	ctx->error = ISOTP_N_OK;
+	ctx->state = ISOTP_RX_STATE_IDLE;
+
+	k_fifo_init(&ctx->fifo);
+	k_timer_init(&ctx->timer, recv_timeout, NULL);
+
+	filter_prepare(&filter, rx_addr);
+
+	ctx->filter_id = can_attach_isr(can_dev, recv_can_cb, ctx, &filter);
+	if (ctx->filter_id < 0) {
+		LOG_ERR("No free filter");
+		return ISOTP_NO_FREE_FILTER;
+	}
+
+	return ISOTP_N_OK;
+}
+
+void isotp_unbind(struct isotp_recv_ctx *ctx)
+{
+	struct net_buf *buf;
+	unsigned int key;
+
+	if (ctx->filter_id >= 0) {
+		can_detach(ctx->can_dev, ctx->filter_id);
+		ctx->filter_id = -1;
+	}
+
+	key = irq_lock();
+	recv_reset(ctx);
+	irq_unlock(key);
+
+	while ((buf = net_buf_get(&ctx->fifo, K_NO_WAIT)) != NULL) {
+		net_buf_unref(buf);
+	}
+}
+
+int isotp_recv_net(struct isotp_recv_ctx *ctx, struct net_buf **buffer,
+		   s32_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_get(&ctx->fifo, timeout);
+	if (!buf) {
+		return ISOTP_RECV_TIMEOUT;
+	}
+
+	*buffer = buf;
+
+	return net_buf_frags_len(buf);
+}
+
+int isotp_recv(struct isotp_recv_ctx *ctx, u8_t *data, size_t len,
+	       s32_t timeout)
+{
+	struct net_buf *buf, *frag;
+	size_t copied = 0;
+	int ret;
+
+	ret = isotp_recv_net(ctx, &buf, timeout);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (frag = buf; frag && copied < len; frag = frag->frags) {
+		size_t chunk = MIN(frag->len, len - copied);
+
+		memcpy(data + copied, frag->data, chunk);
+		copied += chunk;
+	}
+
+	net_buf_unref(buf);
+
+	return copied;
+}
+
+/* Send */
+
+static void send_process(struct isotp_send_ctx *ctx);
+
+static void send_finish(struct isotp_send_ctx *ctx, int error)
+{
+	k_timer_stop(&ctx->timer);
+
+	ctx->error = error;
+	ctx->state = ISOTP_TX_STATE_FIN;
+
+	/* the filter can not be detached from interrupt context */
+	k_work_submit(&ctx->work);
+}
+
+static void send_tx_cb(u32_t error_flags, void *arg)
+{
+	struct isotp_send_ctx *ctx = arg;
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (error_flags) {
+		LOG_ERR("Frame not sent (%u)", error_flags);
+
+		if (ctx->state != ISOTP_TX_STATE_FIN &&
+		    ctx->state != ISOTP_TX_STATE_IDLE) {
+			send_finish(ctx, ISOTP_N_ERROR);
+		}
+
+		irq_unlock(key);
+		return;
+	}
+
+	switch (ctx->state) {
+	case ISOTP_TX_STATE_WAIT_FIN:
+		send_finish(ctx, ISOTP_N_OK);
+		break;
+
+	case ISOTP_TX_STATE_WAIT_TX:
+		if (ctx->stmin) {
+			ctx->state = ISOTP_TX_STATE_WAIT_ST;
+			k_timer_start(&ctx->timer, ctx->stmin, 0);
+		} else {
+			ctx->state = ISOTP_TX_STATE_SEND_CF;
+			send_process(ctx);
+		}
+		break;
+
+	default:
+		/* first frame or last frame of a block, wait for the flow
+		 * control which may even have been received already.
+		 */
+		break;
+	}
+
+	irq_unlock(key);
+}
+
+static void send_frame(struct isotp_send_ctx *ctx)
+{
+	u8_t state = ctx->state;
+	u8_t bs_left = ctx->bs_left;
+	size_t pos_data = ctx->pos;
+	u8_t sn = ctx->sn;
+	struct zcan_frame frame;
+	size_t len;
+	u8_t pos;
+	int ret;
+
+	frame_prepare(&frame, &ctx->tx_addr, &pos);
+
+	switch (state) {
+	case ISOTP_TX_STATE_SEND_SF:
+		frame.data[pos++] = ISOTP_PCI_TYPE_SF | ctx->len;
+		memcpy(&frame.data[pos], ctx->data, ctx->len);
+		pos += ctx->len;
+		ctx->pos = ctx->len;
+		ctx->state = ISOTP_TX_STATE_WAIT_FIN;
+		break;
+
+	case ISOTP_TX_STATE_SEND_FF:
+		frame.data[pos++] = ISOTP_PCI_TYPE_FF | (ctx->len >> 8);
+		frame.data[pos++] = ctx->len & 0xFF;
+		len = CAN_MAX_DLEN - pos;
+		memcpy(&frame.data[pos], ctx->data, len);
+		pos += len;
+		ctx->pos = len;
+		ctx->sn = 1U;
+		ctx->state = ISOTP_TX_STATE_WAIT_FC;
+		break;
+
+	case ISOTP_TX_STATE_SEND_CF:
+		frame.data[pos++] = ISOTP_PCI_TYPE_CF | ctx->sn;
+		len = MIN(CAN_MAX_DLEN - pos, ctx->len - ctx->pos);
+		memcpy(&frame.data[pos], ctx->data + ctx->pos, len);
+		pos += len;
+		ctx->pos += len;
+		ctx->sn = (ctx->sn + 1) & ISOTP_PCI_SN_MASK;
+
+		if (ctx->pos == ctx->len) {
+			ctx->state = ISOTP_TX_STATE_WAIT_FIN;
+		} else if (ctx->bs && !--ctx->bs_left) {
+			ctx->state = ISOTP_TX_STATE_WAIT_FC;
+		} else {
+			ctx->state = ISOTP_TX_STATE_WAIT_TX;
+		}
+		break;
+
+	default:
+		return;
+	}
+
+	frame_finish(&frame, pos);
+
+	/* the state is advanced before sending as the transmit completion
+	 * and the flow control may be handled before can_send() returns.
+	 */
+	if (ctx->state == ISOTP_TX_STATE_WAIT_FC) {
+		k_timer_start(&ctx->timer, ISOTP_BS, 0);
+	}
+
+	ret = can_send(ctx->can_dev, &frame, K_NO_WAIT, send_tx_cb, ctx);
+	if (ret == CAN_TIMEOUT) {
+		/* no free mailbox, retry the same frame */
+		ctx->state = state;
+		ctx->bs_left = bs_left;
+		ctx->pos = pos_data;
+		ctx->sn = sn;
+		k_timer_start(&ctx->timer, ISOTP_TX_RETRY, 0);
+	} else if (ret) {
+		LOG_ERR("Can't send frame (%d)", ret);
+		send_finish(ctx, ISOTP_N_ERROR);
+	}
+}
+
+/* Frames are sent one at a time, so that controllers arbitrating their
+ * mailboxes by identifier do not reorder consecutive frames. Drivers may
+ * call back synchronously from can_send(), hence sending is serialized
+ * here instead of recursing.
+ */
+static void send_process(struct isotp_send_ctx *ctx)
+{
+	if (ctx->busy) {
+		ctx->pending = 1U;
+		return;
+	}
+
+	ctx->busy = 1U;
+
+	do {
+		ctx->pending = 0U;
+		send_frame(ctx);
+	} while (ctx->pending);
+
+	ctx->busy = 0U;
+}
+
+static void send_fc(struct isotp_send_ctx *ctx, struct zcan_frame *frame,
+		    u8_t pos)
+{
+	if (frame->dlc < pos + 3) {
+		LOG_DBG("Flow control too short");
+		return;
+	}
+
+	switch (frame->data[pos] & ISOTP_PCI_FS_MASK) {
+	case ISOTP_PCI_FS_CTS:
+		k_timer_stop(&ctx->timer);
+		ctx->bs = frame->data[pos + 1];
+		ctx->bs_left = ctx->bs;
+		ctx->stmin = stmin_to_ms(frame->data[pos + 2]);
+		ctx->wft = 0U;
+		ctx->state = ISOTP_TX_STATE_SEND_CF;
+		send_process(ctx);
+		break;
+
+	case ISOTP_PCI_FS_WAIT:
+		if (++ctx->wft > CONFIG_ISOTP_WFTMAX) {
+			LOG_ERR("Too many waits");
+			send_finish(ctx, ISOTP_N_WFT_OVRN);
+			break;
+		}
+
+		k_timer_start(&ctx->timer, ISOTP_BS, 0);
+		break;
+
+	case ISOTP_PCI_FS_OVFLW:
+		LOG_ERR("Message too long for the receiver");
+		send_finish(ctx, ISOTP_N_BUFFER_OVERFLW);
+		break;
+
+	default:
+		LOG_ERR("Invalid flow status");
+		send_finish(ctx, ISOTP_N_INVALID_FS);
+		break;
+	}
+}
+
+static void send_can_cb(struct zcan_frame *frame, void *arg)
+{
+	struct isotp_send_ctx *ctx = arg;
+	unsigned int key;
+	int pos;
+
+	pos = frame_pci_pos(frame, &ctx->rx_addr);
+	if (pos < 0 ||
+	    (frame->data[pos] & ISOTP_PCI_TYPE_MASK) != ISOTP_PCI_TYPE_FC) {
+		return;
+	}
+
+	key = irq_lock();
+
+	if (ctx->state == ISOTP_TX_STATE_WAIT_FC) {
+		send_fc(ctx, frame, pos);
+	} else {
+		LOG_DBG("Unexpected flow control");
+	}
+
+	irq_unlock(key);
+}
+
+static void send_timeout(struct k_timer *timer)
+{
+	struct isotp_send_ctx *ctx = CONTAINER_OF(timer, struct isotp_send_ctx,
+						  timer);
+	unsigned int key;
+
+	key = irq_lock();
+
+	switch (ctx->state) {
+	case ISOTP_TX_STATE_WAIT_FC:
+		LOG_ERR("Timeout waiting for flow control");
+		send_finish(ctx, ISOTP_N_TIMEOUT_BS);
+		break;
+
+	case ISOTP_TX_STATE_WAIT_ST:
+		ctx->state = ISOTP_TX_STATE_SEND_CF;
+		send_process(ctx);
+		break;
+
+	case ISOTP_TX_STATE_SEND_SF:
+	case ISOTP_TX_STATE_SEND_FF:
+	case ISOTP_TX_STATE_SEND_CF:
+		/* retry after no mailbox was free */
+		send_process(ctx);
+		break;
+
+	default:
+		break;
+	}
+
+	irq_unlock(key);
+}
+
+static void send_work_handler(struct k_work *item)
+{
+	struct isotp_send_ctx *ctx = CONTAINER_OF(item, struct isotp_send_ctx,
+						  work);
+
+	if (ctx->filter_id >= 0) {
+		can_detach(ctx->can_dev, ctx->filter_id);
+		ctx->filter_id = -1;
+	}
+
+	ctx->state = ISOTP_TX_STATE_IDLE;
+
+	if (ctx->cb) {
+		ctx->cb(ctx->error, ctx->cb_arg);
+	} else {
+		k_sem_give(&ctx->fin_sem);
+	}
+}
+
+int isotp_send(struct isotp_send_ctx *ctx, struct device *can_dev,
+	       const u8_t *data, size_t len,
+	       const struct isotp_msg_id *tx_addr,
+	       const struct isotp_msg_id *rx_addr,
+	       isotp_tx_callback_t complete_cb, void *cb_arg)
+{
+	unsigned int key;
+
+	if (!ctx || !can_dev || !data || !tx_addr || !rx_addr || !len ||
+	    len > ISOTP_MSG_LEN_MAX) {
+		return ISOTP_INVALID_PARAM;
+	}
+
+	if (ctx->state != ISOTP_TX_STATE_IDLE) {
+		return ISOTP_BUSY;
+	}
+
+	ctx->can_dev = can_dev;
+	ctx->tx_addr = *tx_addr;
+	ctx->rx_addr = *rx_addr;
+	ctx->data = data;
+	ctx->len = len;
+	ctx->pos = 0;
+	ctx->cb = complete_cb;
+	ctx->cb_arg = cb_arg;
+	ctx->error = ISOTP_N_OK;
+	ctx->filter_id = -1;
+	ctx->bs = 0U;
+	ctx->wft = 0U;
+	ctx->busy = 0U;
+	ctx->pending = 0U;
+
+	k_sem_init(&ctx->fin_sem, 0, 1);
+	k_timer_init(&ctx->timer, send_timeout, NULL);
+	k_work_init(&ctx->work, send_work_handler);
+
+	if (len > CAN_MAX_DLEN - ISOTP_SF_PCI_LEN - !!tx_addr->use_ext_addr) {
+		struct zcan_filter filter;
+
+		/* flow control frames must be received before sending the
+		 * first frame.
+		 */
+		filter_prepare(&filter, rx_addr);
+
+		ctx->filter_id = can_attach_isr(can_dev, send_can_cb, ctx,
+						&filter);
+		if (ctx->filter_id < 0) {
+			LOG_ERR("No free filter");
+			return ISOTP_NO_FREE_FILTER;
+		}
+
+		ctx->state = ISOTP_TX_STATE_SEND_FF;
+	} else {
+		ctx->state = ISOTP_TX_STATE_SEND_SF;
+	}
+
+	key = irq_lock();
+	send_process(ctx);
+	irq_unlock(key);
+
+	if (!complete_cb) {
+		k_sem_take(&ctx->fin_sem, K_FOREVER);
+		return ctx->error;
+	}
+
+	return ISOTP_N_OK;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_CANBUS_ISOTP_ISOTP_INTERNAL_H_
+#define ZEPHYR_SUBSYS_CANBUS_ISOTP_ISOTP_INTERNAL_H_
+
+/* Protocol control information, upper nibble of the first payload byte */
+#define ISOTP_PCI_TYPE_MASK  0xF0
+#define ISOTP_PCI_TYPE_SF    0x00
+#define ISOTP_PCI_TYPE_FF    0x10
+#define ISOTP_PCI_TYPE_CF    0x20
+#define ISOTP_PCI_TYPE_FC    0x30
+
+#define ISOTP_PCI_SF_DL_MASK 0x0F
+#define ISOTP_PCI_FF_DL_MASK 0x0F
+#define ISOTP_PCI_SN_MASK    0x0F
+#define ISOTP_PCI_FS_MASK    0x0F
+
+/* Flow status of a flow control frame */
+#define ISOTP_PCI_FS_CTS     0x00
+#define ISOTP_PCI_FS_WAIT    0x01
+#define ISOTP_PCI_FS_OVFLW   0x02
+
+/* Length of the PCI of single, first and consecutive frames */
+#define ISOTP_SF_PCI_LEN     1
+#define ISOTP_FF_PCI_LEN     2
+#define ISOTP_CF_PCI_LEN     1
+
+/* Timeouts of ISO 15765-2, waiting for flow control and consecutive frames */
+#define ISOTP_BS             K_MSEC(1000)
+#define ISOTP_CR             K_MSEC(1000)
+
+/* Retry interval when no transmit mailbox was free */
+#define ISOTP_TX_RETRY       K_MSEC(1)
+
+#define ISOTP_PAD_BYTE       0xCC
+
+enum isotp_tx_state {
+	ISOTP_TX_STATE_IDLE,
+	ISOTP_TX_STATE_SEND_SF,
+	ISOTP_TX_STATE_SEND_FF,
+	ISOTP_TX_STATE_SEND_CF,
+	ISOTP_TX_STATE_WAIT_TX,
+	ISOTP_TX_STATE_WAIT_ST,
+	ISOTP_TX_STATE_WAIT_FC,
+	ISOTP_TX_STATE_WAIT_FIN,
+	ISOTP_TX_STATE_FIN,
+};
+
+enum isotp_rx_state {
+	ISOTP_RX_STATE_IDLE,
+	ISOTP_RX_STATE_WAIT_CF,
+};
+
+#endif /* ZEPHYR_SUBSYS_CANBUS_ISOTP_ISOTP_INTERNAL_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpp/memory_resource.h>
+#include <misc/math_extras.h>
+#include <string.h>
+
+namespace zephyr {
+
+static inline bool is_aligned(const void *p, size_t align)
+{
+	return ((uintptr_t)p & (align - 1)) == 0;
+}
+
+void *slab_resource::do_allocate(size_t bytes, size_t align)
+{
+	void *p;
+
+	if (bytes > slab_->block_size) {
+		return nullptr;
+	}
+
+	if (k_mem_slab_alloc(slab_, &p, K_NO_WAIT) != 0) {
+		return nullptr;
+	}
+
+	/* blocks are aligned as the slab was defined */
+	if (!is_aligned(p, align)) {
+		k_mem_slab_free(slab_, &p);
+		return nullptr;
+	}
+
+	return p;
+}
+
+void slab_resource::do_deallocate(void *p, size_t bytes, size_t align)
+{
+	ARG_UNUSED(bytes);
+	ARG_UNUSED(align);
+
+	k_mem_slab_free(slab_, &p);
+}
+
+/*
+ * As in k_mem_pool_malloc(), the block descriptor is saved just before the
+ * allocation, which is moved further into the block for larger alignments.
+ */
+void *pool_resource::do_allocate(size_t bytes, size_t align)
+{
+	size_t offset = ROUND_UP(sizeof(struct k_mem_block_id), align);
+	struct k_mem_block block;
+	char *p;
+
+	if (size_add_overflow(bytes, offset, &bytes)) {
+		return nullptr;
+	}
+
+	if (k_mem_pool_alloc(pool_, &block, bytes, K_NO_WAIT) != 0) {
+		return nullptr;
+	}
+
+	p = (char *)block.data + offset;
+
+	/* blocks are aligned as the pool was defined */
+	if (!is_aligned(p, align)) {
+		k_mem_pool_free(&block);
+		return nullptr;
+	}
+
+	(void)memcpy(p - sizeof(struct k_mem_block_id), &block.id,
+		     sizeof(struct k_mem_block_id));
+
+	return p;
+}
+
+void pool_resource::do_deallocate(void *p, size_t bytes, size_t align)
+{
+	struct k_mem_block_id id;
+
+	ARG_UNUSED(bytes);
+	ARG_UNUSED(align);
+
+	(void)memcpy(&id, (char *)p - sizeof(id), sizeof(id));
+	k_mem_pool_free_id(&id);
+}
+
+void *monotonic_buffer_resource::do_allocate(size_t bytes, size_t align)
+{
+	uintptr_t start = ROUND_UP((uintptr_t)buffer_ + used_, align);
+	size_t offset = start - (uintptr_t)buffer_;
+
+	if (offset > size_ || bytes > size_ - offset) {
+		return nullptr;
+	}
+
+	used_ = offset + bytes;
+
+	return buffer_ + offset;
+}
+
+} /* namespace zephyr */
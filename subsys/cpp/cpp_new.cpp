@@ -9,6 +9,7 @@
 #endif // CONFIG_LIB_CPLUSPLUS
 #include <kernel.h>
 
+#if !defined(CONFIG_CPLUSPLUS_NO_GLOBAL_NEW)
 void* operator new(size_t size)
 {
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
@@ -38,6 +39,7 @@ void* operator new[](size_t size)
 	return NULL;
 #endif
 }
+#endif // !CONFIG_CPLUSPLUS_NO_GLOBAL_NEW
 
 void operator delete(void* ptr) noexcept
 {
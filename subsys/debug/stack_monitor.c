@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Thread stack high-water monitor
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <spinlock.h>
+#include <string.h>
+#include <misc/stack.h>
+#include <misc/util.h>
+#include <debug/stack_monitor.h>
+#include <stats.h>
+#include <shell/shell.h>
+
+#define STACK_MONITOR_ROUND 16
+
+static struct stack_monitor_info threads[CONFIG_STACK_MONITOR_MAX_THREADS];
+static int num_threads;
+static struct k_spinlock lock;
+
+#ifdef CONFIG_STATS
+STATS_SECT_START(stack_mon)
+	STATS_SECT_ENTRY32(samples)
+	STATS_SECT_ENTRY32(threads)
+	STATS_SECT_ENTRY32(max_pcnt)
+	STATS_SECT_ENTRY32(reclaimable)
+STATS_SECT_END;
+
+STATS_NAME_START(stack_mon)
+	STATS_NAME(stack_mon, samples)
+	STATS_NAME(stack_mon, threads)
+	STATS_NAME(stack_mon, max_pcnt)
+	STATS_NAME(stack_mon, reclaimable)
+STATS_NAME_END(stack_mon);
+
+static STATS_SECT_DECL(stack_mon) stack_mon_stats;
+#endif
+
+static struct stack_monitor_info *info_get(const struct k_thread *thread)
+{
+	int i;
+
+	for (i = 0; i < num_threads; i++) {
+		if (threads[i].thread == thread) {
+			return &threads[i];
+		}
+	}
+
+	if (num_threads == CONFIG_STACK_MONITOR_MAX_THREADS) {
+		/* Make room by forgetting an exited thread */
+		for (i = 0; i < num_threads; i++) {
+			if (!threads[i].alive) {
+				break;
+			}
+		}
+		if (i == num_threads) {
+			return NULL;
+		}
+	} else {
+		i = num_threads++;
+	}
+
+	(void)memset(&threads[i], 0, sizeof(threads[i]));
+	threads[i].thread = thread;
+
+	return &threads[i];
+}
+
+static void sample_thread(const struct k_thread *thread, void *user_data)
+{
+	struct stack_monitor_info *info;
+	size_t size = thread->stack_info.size;
+	size_t used;
+
+	ARG_UNUSED(user_data);
+
+	used = size - stack_unused_space_get((char *)thread->stack_info.start,
+					     size);
+
+	info = info_get(thread);
+	if (info == NULL) {
+		return;
+	}
+
+	/* The thread object may be reused by a new thread with another
+	 * stack, start over then
+	 */
+	if (info->size != size) {
+		info->size = size;
+		info->max_used = 0;
+	}
+	info->name = k_thread_name_get((k_tid_t)thread);
+	info->max_used = MAX(info->max_used, used);
+	info->alive = true;
+}
+
+size_t stack_monitor_recommended_size(const struct stack_monitor_info *info)
+{
+	size_t size;
+
+	size = info->max_used +
+	       (info->max_used * CONFIG_STACK_MONITOR_MARGIN) / 100U;
+	size = ROUND_UP(size, STACK_MONITOR_ROUND);
+
+	return MIN(size, info->size);
+}
+
+#ifdef CONFIG_STATS
+static void stats_update(void)
+{
+	u32_t max_pcnt = 0U;
+	u32_t reclaimable = 0U;
+	int i;
+
+	for (i = 0; i < num_threads; i++) {
+		struct stack_monitor_info *info = &threads[i];
+
+		if (info->size == 0) {
+			continue;
+		}
+		max_pcnt = MAX(max_pcnt, (info->max_used * 100U) / info->size);
+		reclaimable += info->size -
+			       stack_monitor_recommended_size(info);
+	}
+
+	STATS_INC(stack_mon_stats, samples);
+	stack_mon_stats.threads = num_threads;
+	stack_mon_stats.max_pcnt = max_pcnt;
+	stack_mon_stats.reclaimable = reclaimable;
+}
+#endif
+
+void stack_monitor_sample(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int i;
+
+	for (i = 0; i < num_threads; i++) {
+		threads[i].alive = false;
+	}
+
+	k_thread_foreach(sample_thread, NULL);
+
+#ifdef CONFIG_STATS
+	stats_update();
+#endif
+
+	k_spin_unlock(&lock, key);
+}
+
+void stack_monitor_foreach(stack_monitor_cb_t cb, void *user_data)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int i;
+
+	for (i = 0; i < num_threads; i++) {
+		cb(&threads[i], user_data);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+#if CONFIG_STACK_MONITOR_PERIOD > 0
+static struct k_delayed_work sample_work;
+
+static void sample_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	stack_monitor_sample();
+	k_delayed_work_submit(&sample_work, CONFIG_STACK_MONITOR_PERIOD);
+}
+#endif
+
+static int stack_monitor_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+#ifdef CONFIG_STATS
+	(void)STATS_INIT_AND_REG(stack_mon_stats, STATS_SIZE_32, "stack_mon");
+#endif
+
+#if CONFIG_STACK_MONITOR_PERIOD > 0
+	k_delayed_work_init(&sample_work, sample_work_handler);
+	k_delayed_work_submit(&sample_work, CONFIG_STACK_MONITOR_PERIOD);
+#endif
+
+	return 0;
+}
+
+SYS_INIT(stack_monitor_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#ifdef CONFIG_SHELL
+/* Copy the figures out so the shell does not print with the lock held */
+struct shell_snapshot {
+	struct stack_monitor_info info[CONFIG_STACK_MONITOR_MAX_THREADS];
+	int count;
+};
+
+static struct shell_snapshot snapshot;
+
+static void snapshot_add(const struct stack_monitor_info *info,
+			 void *user_data)
+{
+	struct shell_snapshot *s = user_data;
+
+	s->info[s->count++] = *info;
+}
+
+static void snapshot_take(void)
+{
+	stack_monitor_sample();
+	snapshot.count = 0;
+	stack_monitor_foreach(snapshot_add, &snapshot);
+}
+
+static int cmd_stacks_show(const struct shell *shell, size_t argc,
+			   char **argv)
+{
+	int i;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	snapshot_take();
+
+	for (i = 0; i < snapshot.count; i++) {
+		struct stack_monitor_info *info = &snapshot.info[i];
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "%s%p %-10s size %u, max used %u (%u %%)\n",
+			      info->alive ? " " : "x", info->thread,
+			      info->name ? info->name : "NA",
+			      (unsigned int)info->size,
+			      (unsigned int)info->max_used,
+			      info->size ?
+			      (unsigned int)((info->max_used * 100U) /
+					     info->size) : 0U);
+	}
+
+	return 0;
+}
+
+static int cmd_stacks_report(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	size_t total = 0;
+	size_t size;
+	int i;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	snapshot_take();
+
+	for (i = 0; i < snapshot.count; i++) {
+		struct stack_monitor_info *info = &snapshot.info[i];
+
+		size = stack_monitor_recommended_size(info);
+		total += info->size - size;
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "K_THREAD_STACK_DEFINE(%s, %u); /* was %u */\n",
+			      info->name ? info->name : "NA",
+			      (unsigned int)size, (unsigned int)info->size);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "%u bytes reclaimable\n",
+		      (unsigned int)total);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stacks,
+	SHELL_CMD(report, NULL, "Print recommended stack sizes.",
+		  cmd_stacks_report),
+	SHELL_CMD(show, NULL, "List stack high-water marks.", cmd_stacks_show),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(stacks, &sub_stacks, "Stack monitor commands", NULL);
+#endif /* CONFIG_SHELL */
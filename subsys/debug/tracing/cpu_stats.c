@@ -6,6 +6,7 @@
 
 #include <tracing_cpu_stats.h>
 #include <misc/printk.h>
+#include <string.h>
 
 enum cpu_state {
 	CPU_STATE_IDLE,
@@ -13,13 +14,29 @@ enum cpu_state {
 	CPU_STATE_SCHEDULER
 };
 
-static enum cpu_state last_cpu_state = CPU_STATE_SCHEDULER;
-static enum cpu_state cpu_state_before_interrupts;
+/* Accounting state of one CPU, only updated by that CPU. */
+struct cpu_stats_state {
+	enum cpu_state last_cpu_state;
+	enum cpu_state cpu_state_before_interrupts;
+	u64_t last_time;
+	struct cpu_stats stats_hw_tick;
+	int nested_interrupts;
+	struct k_thread *current_thread;
+#ifdef CONFIG_TRACING_THREAD_STATS
+	/* start of the running period of current_thread */
+	u64_t thread_start;
+#endif
+};
 
-static u32_t last_time;
-static struct cpu_stats stats_hw_tick;
-static int nested_interrupts;
-static struct k_thread *current_thread;
+static struct cpu_stats_state cpus[CONFIG_MP_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_NUM_CPUS - 1)] = {
+		.last_cpu_state = CPU_STATE_SCHEDULER,
+	},
+};
+
+#ifdef CONFIG_TRACING_THREAD_STATS
+static u32_t latency_hist[THREAD_STATS_LATENCY_BUCKETS];
+#endif
 
 #ifndef CONFIG_SMP
 extern k_tid_t const _idle_thread;
@@ -34,31 +51,38 @@ static int is_idle_thread(struct k_thread *thread)
 #endif
 }
 
-void update_counter(volatile u64_t *cnt)
+static inline struct cpu_stats_state *cpu_state_get(void)
 {
-	u32_t time = k_cycle_get_32();
+	return &cpus[_current_cpu->id];
+}
 
-	if (time >= last_time) {
-		(*cnt) += (time - last_time);
-	} else {
-		(*cnt) += (UINT32_MAX - last_time + 1 + time);
-	}
-	last_time = time;
+static u64_t cycles_since(u64_t start, u64_t time)
+{
+	/* the 64 bit counter does not wrap, however long the CPU idled */
+	return time - start;
 }
 
-static void cpu_stats_update_counters(void)
+static void update_counter(struct cpu_stats_state *cpu, volatile u64_t *cnt)
 {
-	switch (last_cpu_state) {
+	u64_t time = k_cycle_get_64();
+
+	(*cnt) += cycles_since(cpu->last_time, time);
+	cpu->last_time = time;
+}
+
+static void cpu_stats_update_counters(struct cpu_stats_state *cpu)
+{
+	switch (cpu->last_cpu_state) {
 	case CPU_STATE_IDLE:
-		update_counter(&stats_hw_tick.idle);
+		update_counter(cpu, &cpu->stats_hw_tick.idle);
 		break;
 
 	case CPU_STATE_NON_IDLE:
-		update_counter(&stats_hw_tick.non_idle);
+		update_counter(cpu, &cpu->stats_hw_tick.non_idle);
 		break;
 
 	case CPU_STATE_SCHEDULER:
-		update_counter(&stats_hw_tick.sched);
+		update_counter(cpu, &cpu->stats_hw_tick.sched);
 		break;
 
 	default:
@@ -68,89 +92,214 @@ static void cpu_stats_update_counters(void)
 	}
 }
 
-void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns)
+#ifdef CONFIG_TRACING_THREAD_STATS
+/* Charge the thread running on the CPU up to now. */
+static void thread_stats_charge(struct cpu_stats_state *cpu)
+{
+	u64_t time = k_cycle_get_64();
+
+	if (cpu->current_thread != NULL && cpu->nested_interrupts == 0) {
+		cpu->current_thread->rt_stats.cycles +=
+			cycles_since(cpu->thread_start, time);
+	}
+
+	cpu->thread_start = time;
+}
+
+static void thread_stats_switched_in(struct cpu_stats_state *cpu,
+				     struct k_thread *thread)
+{
+	struct _thread_runtime_stats *stats = &thread->rt_stats;
+	u32_t latency;
+	int bucket;
+
+	cpu->thread_start = k_cycle_get_64();
+	stats->switches++;
+
+	if (stats->ready_time != 0U) {
+		/* unsigned arithmetic handles the low word wrapping */
+		latency = (u32_t)cpu->thread_start - stats->ready_time;
+		stats->ready_time = 0U;
+		stats->latency_max = MAX(stats->latency_max, latency);
+
+		bucket = latency ? 32 - __builtin_clz(latency) : 0;
+		latency_hist[MIN(bucket, THREAD_STATS_LATENCY_BUCKETS - 1)]++;
+	}
+}
+
+void sys_trace_thread_ready(struct k_thread *thread)
+{
+	/* zero means not waiting to run */
+	thread->rt_stats.ready_time = k_cycle_get_32() | 1U;
+}
+
+void thread_stats_get(struct k_thread *thread, struct thread_stats *stats)
 {
 	int key = irq_lock();
 
-	cpu_stats_update_counters();
-	cpu_stats_ns->idle = SYS_CLOCK_HW_CYCLES_TO_NS(stats_hw_tick.idle);
-	cpu_stats_ns->non_idle = SYS_CLOCK_HW_CYCLES_TO_NS(
-					  stats_hw_tick.non_idle);
-	cpu_stats_ns->sched = SYS_CLOCK_HW_CYCLES_TO_NS(stats_hw_tick.sched);
+	if (thread == k_current_get()) {
+		thread_stats_charge(cpu_state_get());
+	}
+
+	stats->execution_ns = SYS_CLOCK_HW_CYCLES_TO_NS64(
+					  thread->rt_stats.cycles);
+	stats->switches = thread->rt_stats.switches;
+	stats->latency_max_ns = (u32_t)SYS_CLOCK_HW_CYCLES_TO_NS64(
+					  thread->rt_stats.latency_max);
 	irq_unlock(key);
 }
 
-u32_t cpu_stats_non_idle_and_sched_get_percent(void)
+void thread_stats_latency_hist_get(u32_t hist[THREAD_STATS_LATENCY_BUCKETS])
+{
+	int key = irq_lock();
+
+	memcpy(hist, latency_hist, sizeof(latency_hist));
+	irq_unlock(key);
+}
+
+static void thread_stats_reset(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+
+	thread->rt_stats.cycles = 0U;
+	thread->rt_stats.switches = 0U;
+	thread->rt_stats.latency_max = 0U;
+}
+#endif /* CONFIG_TRACING_THREAD_STATS */
+
+void cpu_stats_cpu_get_ns(unsigned int cpu_id, struct cpu_stats *cpu_stats_ns)
 {
+	struct cpu_stats_state *cpu = &cpus[cpu_id];
 	int key = irq_lock();
 
-	cpu_stats_update_counters();
+	if (cpu == cpu_state_get()) {
+		cpu_stats_update_counters(cpu);
+	}
+
+	cpu_stats_ns->idle = SYS_CLOCK_HW_CYCLES_TO_NS(cpu->stats_hw_tick.idle);
+	cpu_stats_ns->non_idle = SYS_CLOCK_HW_CYCLES_TO_NS(
+					  cpu->stats_hw_tick.non_idle);
+	cpu_stats_ns->sched = SYS_CLOCK_HW_CYCLES_TO_NS(
+					  cpu->stats_hw_tick.sched);
 	irq_unlock(key);
-	return ((stats_hw_tick.non_idle + stats_hw_tick.sched) * 100) /
-		(stats_hw_tick.idle + stats_hw_tick.non_idle +
-		 stats_hw_tick.sched);
+}
+
+void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns)
+{
+	struct cpu_stats stats;
+
+	cpu_stats_ns->idle = 0U;
+	cpu_stats_ns->non_idle = 0U;
+	cpu_stats_ns->sched = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cpu_stats_cpu_get_ns(i, &stats);
+		cpu_stats_ns->idle += stats.idle;
+		cpu_stats_ns->non_idle += stats.non_idle;
+		cpu_stats_ns->sched += stats.sched;
+	}
+}
+
+u32_t cpu_stats_non_idle_and_sched_get_percent(void)
+{
+	struct cpu_stats stats;
+	u64_t total;
+
+	cpu_stats_get_ns(&stats);
+	total = stats.idle + stats.non_idle + stats.sched;
+
+	return total ? ((stats.non_idle + stats.sched) * 100) / total : 0;
 }
 
 void cpu_stats_reset_counters(void)
 {
 	int key = irq_lock();
 
-	stats_hw_tick.idle = 0;
-	stats_hw_tick.non_idle = 0;
-	stats_hw_tick.sched = 0;
-	last_time = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cpus[i].stats_hw_tick.idle = 0;
+		cpus[i].stats_hw_tick.non_idle = 0;
+		cpus[i].stats_hw_tick.sched = 0;
+	}
+
+	cpu_state_get()->last_time = k_cycle_get_64();
+#ifdef CONFIG_TRACING_THREAD_STATS
+	(void)memset(latency_hist, 0, sizeof(latency_hist));
+	thread_stats_charge(cpu_state_get());
+#endif
 	irq_unlock(key);
+
+#ifdef CONFIG_TRACING_THREAD_STATS
+	k_thread_foreach(thread_stats_reset, NULL);
+#endif
 }
 
 void sys_trace_thread_switched_in(void)
 {
 	int key = irq_lock();
+	struct cpu_stats_state *cpu = cpu_state_get();
 
-	__ASSERT_NO_MSG(nested_interrupts == 0);
+	__ASSERT_NO_MSG(cpu->nested_interrupts == 0);
 
-	cpu_stats_update_counters();
-	current_thread = k_current_get();
-	if (is_idle_thread(current_thread)) {
-		last_cpu_state = CPU_STATE_IDLE;
+	cpu_stats_update_counters(cpu);
+	cpu->current_thread = k_current_get();
+	if (is_idle_thread(cpu->current_thread)) {
+		cpu->last_cpu_state = CPU_STATE_IDLE;
 	} else {
-		last_cpu_state = CPU_STATE_NON_IDLE;
+		cpu->last_cpu_state = CPU_STATE_NON_IDLE;
 	}
+#ifdef CONFIG_TRACING_THREAD_STATS
+	thread_stats_switched_in(cpu, cpu->current_thread);
+#endif
 	irq_unlock(key);
 }
 
 void sys_trace_thread_switched_out(void)
 {
 	int key = irq_lock();
+	struct cpu_stats_state *cpu = cpu_state_get();
 
-	__ASSERT_NO_MSG(nested_interrupts == 0);
-	__ASSERT_NO_MSG(current_thread == k_current_get());
+	__ASSERT_NO_MSG(cpu->nested_interrupts == 0);
+	__ASSERT_NO_MSG(cpu->current_thread == k_current_get());
 
-	cpu_stats_update_counters();
-	last_cpu_state = CPU_STATE_SCHEDULER;
+	cpu_stats_update_counters(cpu);
+	cpu->last_cpu_state = CPU_STATE_SCHEDULER;
+#ifdef CONFIG_TRACING_THREAD_STATS
+	thread_stats_charge(cpu);
+	cpu->current_thread = NULL;
+#endif
 	irq_unlock(key);
 }
 
 void sys_trace_isr_enter(void)
 {
 	int key = irq_lock();
+	struct cpu_stats_state *cpu = cpu_state_get();
 
-	if (nested_interrupts == 0) {
-		cpu_stats_update_counters();
-		cpu_state_before_interrupts = last_cpu_state;
-		last_cpu_state = CPU_STATE_NON_IDLE;
+	if (cpu->nested_interrupts == 0) {
+		cpu_stats_update_counters(cpu);
+#ifdef CONFIG_TRACING_THREAD_STATS
+		/* interrupts are not charged to the interrupted thread */
+		thread_stats_charge(cpu);
+#endif
+		cpu->cpu_state_before_interrupts = cpu->last_cpu_state;
+		cpu->last_cpu_state = CPU_STATE_NON_IDLE;
 	}
-	nested_interrupts++;
+	cpu->nested_interrupts++;
 	irq_unlock(key);
 }
 
 void sys_trace_isr_exit(void)
 {
 	int key = irq_lock();
-
-	nested_interrupts--;
-	if (nested_interrupts == 0) {
-		cpu_stats_update_counters();
-		last_cpu_state = cpu_state_before_interrupts;
+	struct cpu_stats_state *cpu = cpu_state_get();
+
+	cpu->nested_interrupts--;
+	if (cpu->nested_interrupts == 0) {
+		cpu_stats_update_counters(cpu);
+		cpu->last_cpu_state = cpu->cpu_state_before_interrupts;
+#ifdef CONFIG_TRACING_THREAD_STATS
+		cpu->thread_start = k_cycle_get_64();
+#endif
 	}
 	irq_unlock(key);
 }
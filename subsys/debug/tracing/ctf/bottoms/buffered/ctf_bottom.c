@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Events are copied to a buffer of the CPU they occur on, and a low priority
+ * thread drains the buffers to the transport. Each buffer has a single
+ * producer (its CPU, with interrupts locked) and a single consumer (the
+ * thread), so it needs no lock: the producer only moves head and the
+ * consumer only moves tail, both free running and published atomically
+ * once the data is in place.
+ */
+
+#include <zephyr.h>
+#include <kernel_structs.h>
+#include <atomic.h>
+#include <ctf_middle.h>
+#include "ctf_bottom.h"
+
+#define BUF_SIZE CONFIG_TRACING_CTF_BUFFER_SIZE
+
+BUILD_ASSERT_MSG((BUF_SIZE & (BUF_SIZE - 1)) == 0,
+		 "CTF buffer size must be a power of two");
+
+struct ctf_cpu_buf {
+	atomic_t head;
+	atomic_t tail;
+	atomic_t lost;
+	u8_t data[BUF_SIZE];
+};
+
+static struct ctf_cpu_buf cpu_bufs[CONFIG_MP_NUM_CPUS];
+static atomic_t lost_total;
+static bool started;
+
+void ctf_bottom_configure(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		atomic_set(&cpu_bufs[i].head, 0);
+		atomic_set(&cpu_bufs[i].tail, 0);
+		atomic_set(&cpu_bufs[i].lost, 0);
+	}
+
+	atomic_set(&lost_total, 0);
+}
+
+void ctf_bottom_start(void)
+{
+	started = true;
+}
+
+void ctf_bottom_emit(const void *ptr, size_t size)
+{
+	struct ctf_cpu_buf *buf = &cpu_bufs[_current_cpu->id];
+	u32_t head = (u32_t)atomic_get(&buf->head);
+	u32_t tail = (u32_t)atomic_get(&buf->tail);
+	u32_t idx = head & (BUF_SIZE - 1);
+	size_t part;
+
+	if (!started || BUF_SIZE - (head - tail) < size) {
+		atomic_inc(&buf->lost);
+		return;
+	}
+
+	part = MIN(size, BUF_SIZE - idx);
+	memcpy(&buf->data[idx], ptr, part);
+	memcpy(buf->data, (const u8_t *)ptr + part, size - part);
+
+	atomic_set(&buf->head, head + size);
+}
+
+u32_t ctf_bottom_lost_get(void)
+{
+	u32_t lost = (u32_t)atomic_get(&lost_total);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		lost += (u32_t)atomic_get(&cpu_bufs[i].lost);
+	}
+
+	return lost;
+}
+
+static void drain(unsigned int cpu)
+{
+	struct ctf_cpu_buf *buf = &cpu_bufs[cpu];
+	u32_t head = (u32_t)atomic_get(&buf->head);
+	u32_t tail = (u32_t)atomic_get(&buf->tail);
+	u32_t idx;
+	size_t len;
+
+	/* head only moves after whole events, so every write ends on an
+	 * event boundary
+	 */
+	while (tail != head) {
+		idx = tail & (BUF_SIZE - 1);
+		len = MIN(head - tail, BUF_SIZE - idx);
+
+		if (ctf_bottom_transport_write(cpu, &buf->data[idx], len)) {
+			/* the events in the dropped part are unknown */
+			atomic_inc(&lost_total);
+		}
+
+		tail += len;
+		atomic_set(&buf->tail, tail);
+	}
+}
+
+static void ctf_bottom_thread(void)
+{
+	u32_t lost;
+
+	if (ctf_bottom_transport_init()) {
+		return;
+	}
+
+	while (true) {
+		lost = 0U;
+
+		for (unsigned int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			drain(cpu);
+			lost += (u32_t)atomic_set(&cpu_bufs[cpu].lost, 0);
+		}
+
+		/* report lost events in-band, picked up by the next drain */
+		if (lost) {
+			atomic_add(&lost_total, lost);
+			ctf_middle_events_lost(lost);
+		}
+
+		k_sleep(CONFIG_TRACING_CTF_DRAIN_INTERVAL_MS);
+	}
+}
+
+K_THREAD_DEFINE(ctf_bottom_tid, CONFIG_TRACING_CTF_THREAD_STACK_SIZE,
+		ctf_bottom_thread, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_DEBUG_TRACING_BOTTOMS_BUFFERED_CTF_BOTTOM_H
+#define SUBSYS_DEBUG_TRACING_BOTTOMS_BUFFERED_CTF_BOTTOM_H
+
+#include <stddef.h>
+#include <string.h>
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <ctf_map.h>
+
+
+/* Obtain a field's size at compile-time.
+ * Internal to this bottom-layer.
+ */
+#define CTF_BOTTOM_INTERNAL_FIELD_SIZE(x)      + sizeof(x)
+
+/* Append a field to current event-packet.
+ * Internal to this bottom-layer.
+ */
+#define CTF_BOTTOM_INTERNAL_FIELD_APPEND(x)		 \
+	{						 \
+		memcpy(epacket_cursor, &(x), sizeof(x)); \
+		epacket_cursor += sizeof(x);		 \
+	}
+
+/* Gather fields to a contiguous event-packet, then emit it to the buffer of
+ * the current CPU. Used by middle-layer.
+ */
+#define CTF_BOTTOM_FIELDS(...)						    \
+{									    \
+	u8_t epacket[0 MAP(CTF_BOTTOM_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)]; \
+	u8_t *epacket_cursor = &epacket[0];				    \
+									    \
+	MAP(CTF_BOTTOM_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)		    \
+	ctf_bottom_emit(epacket, sizeof(epacket));			    \
+}
+
+/* Each CPU only writes to its own buffer, so disabling interrupts locally
+ * is enough to keep events whole. Used by middle-layer.
+ */
+#define CTF_BOTTOM_LOCK()	unsigned int ctf_bottom_key = z_arch_irq_lock()
+#define CTF_BOTTOM_UNLOCK()	z_arch_irq_unlock(ctf_bottom_key)
+
+/* Events are timestamped with the cycle counter. Used by middle-layer. */
+#define CTF_BOTTOM_TIMESTAMPED_INTERNALLY
+
+
+/* Configure initializes ctf_bottom context */
+void ctf_bottom_configure(void);
+
+/* Start a new trace stream */
+void ctf_bottom_start(void);
+
+/* Copy an event to the buffer of the current CPU, or count it as lost */
+void ctf_bottom_emit(const void *ptr, size_t size);
+
+/* Number of events lost since the start of the stream */
+u32_t ctf_bottom_lost_get(void);
+
+/* Transport of the buffered stream, implemented by the RTT or UART part.
+ * Write returns 0 once all data of the CPU stream is written, or a negative
+ * error code if it was dropped.
+ */
+int ctf_bottom_transport_init(void);
+int ctf_bottom_transport_write(unsigned int cpu, const u8_t *data,
+			       size_t len);
+
+#endif /* SUBSYS_DEBUG_TRACING_BOTTOMS_BUFFERED_CTF_BOTTOM_H */
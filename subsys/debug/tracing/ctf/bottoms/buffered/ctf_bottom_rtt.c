@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <SEGGER_RTT.h>
+#include "ctf_bottom.h"
+
+#define RTT_RETRY_CNT 10
+
+/* One up buffer per CPU, so each CPU is a separate CTF stream. */
+static u8_t rtt_bufs[CONFIG_MP_NUM_CPUS][CONFIG_TRACING_CTF_RTT_BUFFER_SIZE];
+
+int ctf_bottom_transport_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		SEGGER_RTT_ConfigUpBuffer(CONFIG_TRACING_CTF_RTT_BUFFER + i,
+					  "CTF", rtt_bufs[i],
+					  sizeof(rtt_bufs[i]),
+					  SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	}
+
+	return 0;
+}
+
+int ctf_bottom_transport_write(unsigned int cpu, const u8_t *data,
+			       size_t len)
+{
+	unsigned int chan = CONFIG_TRACING_CTF_RTT_BUFFER + cpu;
+	int retry = RTT_RETRY_CNT;
+
+	/* The whole chunk is written or skipped, so the stream stays made of
+	 * whole events. Give the host some time to read before skipping.
+	 */
+	while (SEGGER_RTT_Write(chan, data, len) == 0U) {
+		if (--retry == 0) {
+			return -EAGAIN;
+		}
+
+		k_sleep(1);
+	}
+
+	return 0;
+}
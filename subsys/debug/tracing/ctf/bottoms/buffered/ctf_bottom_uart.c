@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <uart.h>
+#include "ctf_bottom.h"
+
+static struct device *uart_dev;
+
+#ifdef CONFIG_TRACING_CTF_UART_ASYNC
+static K_SEM_DEFINE(tx_done, 0, 1);
+static int tx_result;
+
+static void uart_callback(struct uart_event *evt, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		tx_result = 0;
+		k_sem_give(&tx_done);
+		break;
+
+	case UART_TX_ABORTED:
+		tx_result = -EIO;
+		k_sem_give(&tx_done);
+		break;
+
+	default:
+		break;
+	}
+}
+#endif
+
+int ctf_bottom_transport_init(void)
+{
+	uart_dev = device_get_binding(CONFIG_TRACING_CTF_UART_DEV_NAME);
+	if (uart_dev == NULL) {
+		return -ENODEV;
+	}
+
+#ifdef CONFIG_TRACING_CTF_UART_ASYNC
+	return uart_callback_set(uart_dev, uart_callback, NULL);
+#else
+	return 0;
+#endif
+}
+
+/* All CPUs share the port, their streams are interleaved by whole events. */
+int ctf_bottom_transport_write(unsigned int cpu, const u8_t *data,
+			       size_t len)
+{
+	ARG_UNUSED(cpu);
+
+#ifdef CONFIG_TRACING_CTF_UART_ASYNC
+	int err;
+
+	/* The drain thread reuses the region once this returns */
+	err = uart_tx(uart_dev, data, len, K_FOREVER);
+	if (err != 0) {
+		return err;
+	}
+
+	k_sem_take(&tx_done, K_FOREVER);
+
+	return tx_result;
+#else
+	while (len--) {
+		uart_poll_out(uart_dev, *data++);
+	}
+
+	return 0;
+#endif
+}
@@ -69,7 +69,8 @@ typedef enum {
 	CTF_EVENT_ISR_EXIT_TO_SCHEDULER =  0x22,
 	CTF_EVENT_IDLE                  =  0x30,
 	CTF_EVENT_ID_START_CALL         =  0x41,
-	CTF_EVENT_ID_END_CALL           =  0x42
+	CTF_EVENT_ID_END_CALL           =  0x42,
+	CTF_EVENT_LOST                  =  0x50
 } ctf_event_t;
 
 
@@ -214,4 +215,12 @@ static inline void ctf_middle_end_call(u32_t id)
 		);
 }
 
+static inline void ctf_middle_events_lost(u32_t count)
+{
+	CTF_EVENT(
+		CTF_LITERAL(u8_t, CTF_EVENT_LOST),
+		count
+		);
+}
+
 #endif /* SUBSYS_DEBUG_TRACING_CTF_MIDDLE_H */
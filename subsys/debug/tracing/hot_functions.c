@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Call counts of the functions marked __hotfunc. With
+ * -finstrument-functions every function calls the entry hook below, which
+ * only counts the functions of the .hottext section. The counters are
+ * kept in an open addressing table indexed by the function address, and
+ * updated with atomic operations only, as the hook runs in any context.
+ *
+ * The hooks and everything they call must not be instrumented, including
+ * inline functions, hence no kernel API.
+ */
+
+#include <kernel.h>
+#include <linker/linker-defs.h>
+#include <misc/printk.h>
+#include <tracing_hot_functions.h>
+
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
+
+#define SLOTS CONFIG_TRACING_HOT_FUNCTIONS_SLOTS
+
+static struct {
+	uintptr_t fn;
+	u32_t calls;
+} hot_functions[SLOTS];
+
+/* Calls of the functions not counted, the table being full */
+static u32_t hot_functions_lost;
+
+NO_INSTRUMENT void __cyg_profile_func_enter(void *this_fn, void *call_site)
+{
+	uintptr_t fn = (uintptr_t)this_fn;
+	uintptr_t cur;
+	unsigned int i;
+	unsigned int n;
+
+	ARG_UNUSED(call_site);
+
+	if (fn < (uintptr_t)_hottext_rom_start ||
+	    fn >= (uintptr_t)_hottext_rom_end) {
+		return;
+	}
+
+	i = (fn >> 1) % SLOTS;
+
+	for (n = 0U; n < SLOTS; n++) {
+		cur = __atomic_load_n(&hot_functions[i].fn, __ATOMIC_RELAXED);
+
+		if (cur == 0U) {
+			/* Claim the free slot, unless taken meanwhile */
+			(void)__atomic_compare_exchange_n(&hot_functions[i].fn,
+							  &cur, fn, false,
+							  __ATOMIC_RELAXED,
+							  __ATOMIC_RELAXED);
+			if (cur == 0U) {
+				cur = fn;
+			}
+		}
+
+		if (cur == fn) {
+			__atomic_fetch_add(&hot_functions[i].calls, 1U,
+					   __ATOMIC_RELAXED);
+			return;
+		}
+
+		i = (i + 1U) % SLOTS;
+	}
+
+	__atomic_fetch_add(&hot_functions_lost, 1U, __ATOMIC_RELAXED);
+}
+
+NO_INSTRUMENT void __cyg_profile_func_exit(void *this_fn, void *call_site)
+{
+	ARG_UNUSED(this_fn);
+	ARG_UNUSED(call_site);
+}
+
+void hot_functions_dump(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < SLOTS; i++) {
+		if (hot_functions[i].fn != 0U) {
+			printk("hot 0x%08lx %u\n",
+			       (unsigned long)hot_functions[i].fn,
+			       hot_functions[i].calls);
+		}
+	}
+
+	if (hot_functions_lost != 0U) {
+		printk("hot lost %u\n", hot_functions_lost);
+	}
+}
+
+void hot_functions_reset(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < SLOTS; i++) {
+		__atomic_store_n(&hot_functions[i].calls, 0U, __ATOMIC_RELAXED);
+	}
+
+	__atomic_store_n(&hot_functions_lost, 0U, __ATOMIC_RELAXED);
+}
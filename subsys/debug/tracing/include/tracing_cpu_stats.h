@@ -23,9 +23,28 @@ void sys_trace_isr_exit(void);
 void sys_trace_idle(void);
 
 void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns);
+void cpu_stats_cpu_get_ns(unsigned int cpu_id, struct cpu_stats *cpu_stats_ns);
 u32_t cpu_stats_non_idle_and_sched_get_percent(void);
 void cpu_stats_reset_counters(void);
 
+#ifdef CONFIG_TRACING_THREAD_STATS
+/* Bucket n counts latencies of less than 2^n cycles, the last one the rest */
+#define THREAD_STATS_LATENCY_BUCKETS 32
+
+struct thread_stats {
+	u64_t execution_ns;
+	u32_t switches;
+	u32_t latency_max_ns;
+};
+
+void sys_trace_thread_ready(struct k_thread *thread);
+
+void thread_stats_get(struct k_thread *thread, struct thread_stats *stats);
+void thread_stats_latency_hist_get(u32_t hist[THREAD_STATS_LATENCY_BUCKETS]);
+#else
+#define sys_trace_thread_ready(thread)
+#endif
+
 #define sys_trace_isr_exit_to_scheduler()
 
 #define sys_trace_thread_priority_set(thread)
@@ -34,7 +53,6 @@ void cpu_stats_reset_counters(void);
 #define sys_trace_thread_abort(thread)
 #define sys_trace_thread_suspend(thread)
 #define sys_trace_thread_resume(thread)
-#define sys_trace_thread_ready(thread)
 #define sys_trace_thread_pend(thread)
 
 #define sys_trace_void(id)
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRACE_HOT_FUNCTIONS_H
+#define _TRACE_HOT_FUNCTIONS_H
+
+#include <zephyr/types.h>
+
+/**
+ * @brief Print the call counts of the functions marked __hotfunc
+ *
+ * One "hot <address> <calls>" line is printed per function called since
+ * boot or the last reset, the input of scripts/gen_ramfunc_hot.py.
+ */
+void hot_functions_dump(void);
+
+/** @brief Clear the call counts, e.g. once the system is initialized */
+void hot_functions_reset(void);
+
+#endif /* _TRACE_HOT_FUNCTIONS_H */
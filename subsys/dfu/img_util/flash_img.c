@@ -23,6 +23,10 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <flash.h>
 #endif
 
+#ifdef CONFIG_IMG_ERASE_AHEAD
+#include <init.h>
+#endif
+
 #if USE_PARTITION_MANAGER
 #include <pm_config.h>
 #define FLASH_AREA_IMAGE_SECONDARY  PM_MCUBOOT_SECONDARY_ID
@@ -81,9 +85,11 @@ static int flash_sector_from_off(struct flash_area const *fap, off_t off,
 
 	flash_dev = flash_area_get_device(fap);
 	if (flash_dev) {
-		rc = flash_get_page_info_by_offs(flash_dev, off, &page);
+		/* pages are looked up by device offset */
+		rc = flash_get_page_info_by_offs(flash_dev, fap->fa_off + off,
+						 &page);
 		if (rc == 0) {
-			sector->fs_off = page.start_offset;
+			sector->fs_off = page.start_offset - fap->fa_off;
 			sector->fs_size = page.size;
 		}
 	}
@@ -127,6 +133,95 @@ static int flash_progressive_erase(struct flash_img_context *ctx, off_t off)
 
 #endif /* CONFIG_IMG_ERASE_PROGRESSIVELY */
 
+#ifdef CONFIG_IMG_ERASE_AHEAD
+
+static K_THREAD_STACK_DEFINE(erase_ahead_stack,
+			     CONFIG_IMG_ERASE_AHEAD_STACK_SIZE);
+static struct k_work_q erase_ahead_q;
+
+/*
+ * Erase the sectors following the erased part of the slot, up to the
+ * erase-ahead target, while the writer waits for more data.
+ */
+static void flash_erase_ahead_work(struct k_work *work)
+{
+	struct flash_img_context *ctx =
+		CONTAINER_OF(work, struct flash_img_context, erase_work);
+	struct flash_sector sector;
+	int rc;
+
+	while (!ctx->erase_err && ctx->erased_end < ctx->erase_target &&
+	       ctx->erased_end < ctx->flash_area->fa_size) {
+		rc = flash_sector_from_off(ctx->flash_area, ctx->erased_end,
+					   &sector);
+		if (rc == 0) {
+			k_mutex_lock(&ctx->flash_lock, K_FOREVER);
+			LOG_DBG("Erasing sector at offset 0x%x", sector.fs_off);
+			rc = flash_area_erase(ctx->flash_area, sector.fs_off,
+					      sector.fs_size);
+			k_mutex_unlock(&ctx->flash_lock);
+		}
+
+		if (rc) {
+			LOG_ERR("Error %d while erasing sector", rc);
+			ctx->erase_err = rc;
+		} else {
+			ctx->erased_end = sector.fs_off + sector.fs_size;
+		}
+
+		k_sem_give(&ctx->erase_sem);
+	}
+}
+
+/*
+ * Make sure the slot is erased up to end, and have the worker erase
+ * further ahead.
+ */
+static int flash_erase_ahead(struct flash_img_context *ctx, off_t end)
+{
+	if (end > ctx->flash_area->fa_size) {
+		return -EFBIG;
+	}
+
+	ctx->erase_target = end + CONFIG_IMG_ERASE_AHEAD_SIZE;
+	k_work_submit_to_queue(&erase_ahead_q, &ctx->erase_work);
+
+	while (!ctx->erase_err && ctx->erased_end < end) {
+		k_sem_take(&ctx->erase_sem, K_FOREVER);
+	}
+
+	return ctx->erase_err;
+}
+
+/* Stop the worker, and wait until it let go of the context */
+static void flash_erase_ahead_stop(struct flash_img_context *ctx)
+{
+	ctx->erase_target = 0;
+
+	while (k_work_pending(&ctx->erase_work)) {
+		k_sleep(K_MSEC(1));
+	}
+
+	k_mutex_lock(&ctx->flash_lock, K_FOREVER);
+	k_mutex_unlock(&ctx->flash_lock);
+}
+
+static int flash_erase_ahead_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&erase_ahead_q, erase_ahead_stack,
+		       K_THREAD_STACK_SIZEOF(erase_ahead_stack),
+		       K_PRIO_PREEMPT(CONFIG_IMG_ERASE_AHEAD_THREAD_PRIO));
+
+	return 0;
+}
+
+SYS_INIT(flash_erase_ahead_init, APPLICATION,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_IMG_ERASE_AHEAD */
+
 static int flash_sync(struct flash_img_context *ctx)
 {
 	int rc = 0;
@@ -136,7 +231,15 @@ static int flash_sync(struct flash_img_context *ctx)
 			     CONFIG_IMG_BLOCK_BUF_SIZE - ctx->buf_bytes);
 	}
 
-#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+#if defined(CONFIG_IMG_ERASE_AHEAD)
+	rc = flash_erase_ahead(ctx, ctx->bytes_written +
+			       CONFIG_IMG_BLOCK_BUF_SIZE);
+	if (rc) {
+		return rc;
+	}
+
+	k_mutex_lock(&ctx->flash_lock, K_FOREVER);
+#elif defined(CONFIG_IMG_ERASE_PROGRESSIVELY)
 	flash_progressive_erase(ctx, ctx->bytes_written +
 				CONFIG_IMG_BLOCK_BUF_SIZE);
 #endif
@@ -146,14 +249,24 @@ static int flash_sync(struct flash_img_context *ctx)
 	if (rc) {
 		LOG_ERR("flash_write error %d offset=0x%08x", rc,
 			(u32_t)ctx->bytes_written);
-		return rc;
+	} else if (!flash_verify(ctx->flash_area, ctx->bytes_written,
+				 ctx->buf, CONFIG_IMG_BLOCK_BUF_SIZE)) {
+		rc = -EIO;
 	}
 
-	if (!flash_verify(ctx->flash_area, ctx->bytes_written, ctx->buf,
-			  CONFIG_IMG_BLOCK_BUF_SIZE)) {
-		return -EIO;
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	k_mutex_unlock(&ctx->flash_lock);
+#endif
+
+	if (rc) {
+		return rc;
 	}
 
+#ifdef CONFIG_IMG_HASH_SHA256
+	/* only the data, not the padding of the last block */
+	(void)tc_sha256_update(&ctx->sha, ctx->buf, ctx->buf_bytes);
+#endif
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
@@ -201,7 +314,16 @@ int flash_img_buffered_write(struct flash_img_context *ctx, u8_t *data,
 			return rc;
 		}
 	}
-#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	flash_erase_ahead_stop(ctx);
+
+	/* the trailer may be erased already, if it was close enough */
+	if (BOOT_TRAILER_IMG_STATUS_OFFS(ctx->flash_area) >= ctx->erased_end) {
+		ctx->off_last = -1;
+		flash_progressive_erase(ctx,
+				BOOT_TRAILER_IMG_STATUS_OFFS(ctx->flash_area));
+	}
+#elif defined(CONFIG_IMG_ERASE_PROGRESSIVELY)
 	/* erase the image trailer area if it was not erased */
 	flash_progressive_erase(ctx,
 				BOOT_TRAILER_IMG_STATUS_OFFS(ctx->flash_area));
@@ -218,12 +340,39 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx)
 	return ctx->bytes_written;
 }
 
+#ifdef CONFIG_IMG_HASH_SHA256
+int flash_img_hash_get(struct flash_img_context *ctx, u8_t *hash)
+{
+	if (ctx->flash_area) {
+		/* not flushed yet */
+		return -EBUSY;
+	}
+
+	if (tc_sha256_final(hash, &ctx->sha) != TC_CRYPTO_SUCCESS) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
 int flash_img_init(struct flash_img_context *ctx)
 {
 	ctx->bytes_written = 0;
 	ctx->buf_bytes = 0U;
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 	ctx->off_last = -1;
+#endif
+#ifdef CONFIG_IMG_ERASE_AHEAD
+	k_work_init(&ctx->erase_work, flash_erase_ahead_work);
+	k_mutex_init(&ctx->flash_lock);
+	k_sem_init(&ctx->erase_sem, 0, UINT_MAX);
+	ctx->erased_end = 0;
+	ctx->erase_target = 0;
+	ctx->erase_err = 0;
+#endif
+#ifdef CONFIG_IMG_HASH_SHA256
+	(void)tc_sha256_init(&ctx->sha);
 #endif
 	return flash_area_open(FLASH_AREA_IMAGE_SECONDARY,
 			       (const struct flash_area **)&(ctx->flash_area));
@@ -23,6 +23,243 @@ static sys_dlist_t disk_access_list;
 /* lock to protect storage layer registration */
 static struct k_mutex mutex;
 
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+#define DISK_CACHE_SECTOR_SIZE CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE
+
+/*
+ * Write-back cache of single sectors, shared by the disks whose sector size
+ * is DISK_CACHE_SECTOR_SIZE. File systems access their metadata, e.g. the
+ * FAT, one sector at a time, these accesses are served from the cache.
+ * Accesses to several contiguous sectors go to the disk in one burst.
+ */
+struct disk_cache_entry {
+	struct disk_info *disk;	/* NULL when unused */
+	u32_t sector;
+	u32_t last_use;
+	bool dirty;
+	u8_t data[DISK_CACHE_SECTOR_SIZE] __aligned(4);
+};
+
+static struct disk_cache_entry disk_cache[CONFIG_DISK_ACCESS_CACHE_SECTORS];
+static u32_t disk_cache_clock;
+static K_MUTEX_DEFINE(disk_cache_lock);
+
+static bool disk_cache_usable(struct disk_info *disk)
+{
+	u32_t sector_size;
+
+	if (disk->ops->ioctl == NULL || disk->ops->write == NULL ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+			     &sector_size) != 0) {
+		return false;
+	}
+
+	return sector_size == DISK_CACHE_SECTOR_SIZE;
+}
+
+static struct disk_cache_entry *disk_cache_find(struct disk_info *disk,
+						u32_t sector)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+		if (disk_cache[i].disk == disk &&
+		    disk_cache[i].sector == sector) {
+			return &disk_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int disk_cache_writeback(struct disk_cache_entry *entry)
+{
+	int rc;
+
+	if (!entry->dirty) {
+		return 0;
+	}
+
+	rc = entry->disk->ops->write(entry->disk, entry->data,
+				     entry->sector, 1);
+	if (rc == 0) {
+		entry->dirty = false;
+	}
+
+	return rc;
+}
+
+/* Get an unused entry, writing back the least recently used one if needed */
+static int disk_cache_evict(struct disk_cache_entry **evicted)
+{
+	struct disk_cache_entry *lru = NULL;
+	int rc;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+		if (disk_cache[i].disk == NULL) {
+			lru = &disk_cache[i];
+			break;
+		}
+
+		if (lru == NULL ||
+		    (s32_t)(disk_cache[i].last_use - lru->last_use) < 0) {
+			lru = &disk_cache[i];
+		}
+	}
+
+	if (lru->disk != NULL) {
+		rc = disk_cache_writeback(lru);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	lru->disk = NULL;
+	*evicted = lru;
+
+	return 0;
+}
+
+static int disk_cache_read(struct disk_info *disk, u8_t *data_buf,
+			   u32_t start_sector, u32_t num_sector)
+{
+	struct disk_cache_entry *entry;
+	int rc;
+	int i;
+
+	if (num_sector > 1) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		if (rc != 0) {
+			return rc;
+		}
+
+		/* sectors not written back yet are newer in the cache */
+		for (i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+			entry = &disk_cache[i];
+			if (entry->disk == disk && entry->dirty &&
+			    entry->sector - start_sector < num_sector) {
+				memcpy(&data_buf[(entry->sector - start_sector) *
+						 DISK_CACHE_SECTOR_SIZE],
+				       entry->data, DISK_CACHE_SECTOR_SIZE);
+			}
+		}
+
+		return 0;
+	}
+
+	entry = disk_cache_find(disk, start_sector);
+	if (entry == NULL) {
+		rc = disk_cache_evict(&entry);
+		if (rc != 0) {
+			return rc;
+		}
+
+		rc = disk->ops->read(disk, entry->data, start_sector, 1);
+		if (rc != 0) {
+			return rc;
+		}
+
+		entry->disk = disk;
+		entry->sector = start_sector;
+		entry->dirty = false;
+	}
+
+	entry->last_use = ++disk_cache_clock;
+	memcpy(data_buf, entry->data, DISK_CACHE_SECTOR_SIZE);
+
+	return 0;
+}
+
+static int disk_cache_write(struct disk_info *disk, const u8_t *data_buf,
+			    u32_t start_sector, u32_t num_sector)
+{
+	struct disk_cache_entry *entry;
+	int rc;
+	int i;
+
+	if (num_sector > 1) {
+		rc = disk->ops->write(disk, data_buf, start_sector,
+				      num_sector);
+		if (rc != 0) {
+			return rc;
+		}
+
+		/* cached copies are replaced by the data just written */
+		for (i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+			entry = &disk_cache[i];
+			if (entry->disk == disk &&
+			    entry->sector - start_sector < num_sector) {
+				memcpy(entry->data,
+				       &data_buf[(entry->sector - start_sector) *
+						 DISK_CACHE_SECTOR_SIZE],
+				       DISK_CACHE_SECTOR_SIZE);
+				entry->dirty = false;
+			}
+		}
+
+		return 0;
+	}
+
+	entry = disk_cache_find(disk, start_sector);
+	if (entry == NULL) {
+		rc = disk_cache_evict(&entry);
+		if (rc != 0) {
+			return rc;
+		}
+
+		entry->disk = disk;
+		entry->sector = start_sector;
+	}
+
+	memcpy(entry->data, data_buf, DISK_CACHE_SECTOR_SIZE);
+	entry->dirty = true;
+	entry->last_use = ++disk_cache_clock;
+
+	return 0;
+}
+
+/* Write back the dirty sectors of a disk, in ascending order */
+static int disk_cache_sync(struct disk_info *disk)
+{
+	struct disk_cache_entry *next;
+	int rc;
+	int i;
+
+	while (1) {
+		next = NULL;
+		for (i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+			if (disk_cache[i].disk == disk && disk_cache[i].dirty &&
+			    (next == NULL ||
+			     disk_cache[i].sector < next->sector)) {
+				next = &disk_cache[i];
+			}
+		}
+
+		if (next == NULL) {
+			return 0;
+		}
+
+		rc = disk_cache_writeback(next);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+}
+
+static void disk_cache_drop(struct disk_info *disk)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(disk_cache); i++) {
+		if (disk_cache[i].disk == disk) {
+			disk_cache[i].disk = NULL;
+			disk_cache[i].dirty = false;
+		}
+	}
+}
+#endif /* CONFIG_DISK_ACCESS_CACHE */
+
 struct disk_info *disk_access_get_di(const char *name)
 {
 	struct disk_info *disk = NULL, *itr;
@@ -87,6 +324,15 @@ int disk_access_read(const char *pdrv, u8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		if (disk_cache_usable(disk)) {
+			k_mutex_lock(&disk_cache_lock, K_FOREVER);
+			rc = disk_cache_read(disk, data_buf, start_sector,
+					     num_sector);
+			k_mutex_unlock(&disk_cache_lock);
+			return rc;
+		}
+#endif
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
 	}
 
@@ -101,6 +347,15 @@ int disk_access_write(const char *pdrv, const u8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		if (disk->ops->read != NULL && disk_cache_usable(disk)) {
+			k_mutex_lock(&disk_cache_lock, K_FOREVER);
+			rc = disk_cache_write(disk, data_buf, start_sector,
+					      num_sector);
+			k_mutex_unlock(&disk_cache_lock);
+			return rc;
+		}
+#endif
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
 	}
 
@@ -114,6 +369,16 @@ int disk_access_ioctl(const char *pdrv, u8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			k_mutex_lock(&disk_cache_lock, K_FOREVER);
+			rc = disk_cache_sync(disk);
+			k_mutex_unlock(&disk_cache_lock);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -161,6 +426,14 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#if defined(CONFIG_DISK_ACCESS_CACHE)
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+	if (disk_cache_sync(disk) != 0) {
+		LOG_WRN("disk interface(%s) cached data lost", disk->name);
+	}
+	disk_cache_drop(disk);
+	k_mutex_unlock(&disk_cache_lock);
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistred", disk->name);
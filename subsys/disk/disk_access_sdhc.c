@@ -101,6 +101,8 @@ struct sdhc_flag_map {
 	u8_t err;
 };
 
+static const u8_t sdhc_stop_tran = SDHC_TOKEN_STOP_TRAN;
+
 DEVICE_DECLARE(sdhc_0);
 
 /* The SD protocol requires sending ones while reading but Zephyr
@@ -614,14 +616,15 @@ static int sdhc_rx_block(struct sdhc_data *data, u8_t *buf, int len)
 	return 0;
 }
 
-/* Transmits a SDHC data block */
-static int sdhc_tx_block(struct sdhc_data *data, u8_t *send, int len)
+/* Transmits a SDHC data block, started by the given token */
+static int sdhc_tx_block(struct sdhc_data *data, u8_t token, u8_t *send,
+			 int len)
 {
 	u8_t buf[SDHC_CRC16_SIZE];
 	int err;
 
 	/* Start the block */
-	buf[0] = SDHC_TOKEN_SINGLE;
+	buf[0] = token;
 	err = sdhc_tx(data, buf, 1);
 	if (err != 0) {
 		return err;
@@ -857,31 +860,59 @@ static int sdhc_write(struct sdhc_data *data, const u8_t *buf, u32_t sector,
 
 	sdhc_set_cs(data, 0);
 
-	/* Write the blocks one-by-one */
-	for (; count != 0U; count--) {
+	if (count == 1U) {
 		err = sdhc_cmd_r1(data, SDHC_WRITE_BLOCK, sector);
 		if (err < 0) {
 			goto error;
 		}
 
-		err = sdhc_tx_block(data, (u8_t *)buf, SDHC_SECTOR_SIZE);
+		err = sdhc_tx_block(data, SDHC_TOKEN_SINGLE, (u8_t *)buf,
+				    SDHC_SECTOR_SIZE);
 		if (err != 0) {
 			goto error;
 		}
-
-		/* Wait for the card to finish programming */
-		err = sdhc_skip_until_ready(data);
-		if (err != 0) {
+	} else {
+		/* Stream contiguous blocks in a single command, sparing the
+		 * card a command and a status check per block.
+		 */
+		err = sdhc_cmd_r1(data, SDHC_WRITE_MULTIPLE_BLOCK, sector);
+		if (err < 0) {
 			goto error;
 		}
 
-		err = sdhc_cmd_r2(data, SDHC_SEND_STATUS, 0);
+		for (; count != 0U; count--) {
+			err = sdhc_tx_block(data, SDHC_TOKEN_MULTI_WRITE,
+					    (u8_t *)buf, SDHC_SECTOR_SIZE);
+			if (err != 0) {
+				break;
+			}
+
+			/* Wait for the card to finish programming */
+			err = sdhc_skip_until_ready(data);
+			if (err != 0) {
+				break;
+			}
+
+			buf += SDHC_SECTOR_SIZE;
+		}
+
+		/* End the transfer, also after an error */
+		sdhc_tx(data, &sdhc_stop_tran, 1);
 		if (err != 0) {
+			sdhc_skip_until_ready(data);
 			goto error;
 		}
+	}
 
-		buf += SDHC_SECTOR_SIZE;
-		sector++;
+	/* Wait for the card to finish programming */
+	err = sdhc_skip_until_ready(data);
+	if (err != 0) {
+		goto error;
+	}
+
+	err = sdhc_cmd_r2(data, SDHC_SEND_STATUS, 0);
+	if (err != 0) {
+		goto error;
 	}
 
 	err = 0;
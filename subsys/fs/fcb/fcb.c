@@ -113,6 +113,8 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		return FCB_ERR_ARGS;
 	}
 
+	fcb_read_ahead_invalidate(fcb);
+
 	/* Fill last used, first used */
 	for (i = 0; i < fcb->f_sector_cnt; i++) {
 		sector = &fcb->f_sectors[i];
@@ -163,7 +165,22 @@ fcb_init(int f_area_id, struct fcb *fcb)
 			break;
 		}
 	}
+	/* the window may hold erased flash after the last element */
+	fcb_read_ahead_invalidate(fcb);
 	k_mutex_init(&fcb->f_mtx);
+
+#ifdef CONFIG_FCB_ELEM_INDEX
+	if (!rc && fcb->f_sector_elem_cnt) {
+		struct fcb_entry loc;
+
+		(void)memset(fcb->f_sector_elem_cnt, 0,
+			     fcb->f_sector_cnt * sizeof(u16_t));
+		(void)memset(&loc, 0, sizeof(loc));
+		while (!fcb_getnext_nolock(fcb, &loc)) {
+			fcb_elem_cnt_inc(fcb, loc.fe_sector);
+		}
+	}
+#endif
 	return rc;
 }
 
@@ -295,6 +312,24 @@ fcb_offset_last_n(struct fcb *fcb, u8_t entries,
 		entries = 1U;
 	}
 
+#ifdef CONFIG_FCB_ELEM_INDEX
+	if (fcb->f_sector_elem_cnt) {
+		u32_t total = 0U;
+
+		for (i = 0; i < fcb->f_sector_cnt; i++) {
+			total += fcb->f_sector_elem_cnt[i];
+		}
+
+		if (!total) {
+			return -ENOENT;
+		}
+
+		i = fcb_getnth(fcb, (total > entries) ? total - entries : 0,
+			       last_n_entry);
+		return i ? -ENOENT : 0;
+	}
+#endif
+
 	i = 0;
 	(void)memset(&loc, 0, sizeof(loc));
 	while (!fcb_getnext(fcb, &loc)) {
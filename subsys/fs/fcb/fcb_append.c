@@ -53,6 +53,7 @@ fcb_append_to_scratch(struct fcb *fcb)
 	fcb->f_active.fe_sector = sector;
 	fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
 	fcb->f_active_id++;
+	fcb_elem_cnt_set(fcb, sector, 0);
 	return FCB_OK;
 }
 
@@ -91,8 +92,12 @@ fcb_append(struct fcb *fcb, u16_t len, struct fcb_entry *append_loc)
 		fcb->f_active.fe_sector = sector;
 		fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
 		fcb->f_active_id++;
+		fcb_elem_cnt_set(fcb, sector, 0);
 	}
 
+	/* the element is written outside of the fcb from now on */
+	fcb_read_ahead_invalidate(fcb);
+
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
 	if (rc) {
 		rc = FCB_ERR_FLASH;
@@ -121,15 +126,28 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 
 	(void)memset(crc8, 0xFF, sizeof(crc8));
 
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return FCB_ERR_ARGS;
+	}
+
+	/* the data may have been written after it was read ahead */
+	fcb_read_ahead_invalidate(fcb);
+
 	rc = fcb_elem_crc8(fcb, loc, &crc8[0]);
 	if (rc) {
-		return rc;
+		goto out;
 	}
 	off = loc->fe_data_off + fcb_len_in_flash(fcb, loc->fe_data_len);
 
 	rc = fcb_flash_write(fcb, loc->fe_sector, off, crc8, fcb->f_align);
+	fcb_read_ahead_invalidate(fcb);
 	if (rc) {
-		return FCB_ERR_FLASH;
+		rc = FCB_ERR_FLASH;
+		goto out;
 	}
-	return 0;
+	fcb_elem_cnt_inc(fcb, loc->fe_sector);
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
 }
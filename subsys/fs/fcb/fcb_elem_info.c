@@ -6,10 +6,50 @@
  */
 
 #include <crc.h>
+#include <string.h>
 
 #include "fcb.h"
 #include "fcb_priv.h"
 
+/*
+ * Read for parsing elements. Small reads are served from a window read ahead
+ * in one flash transaction, instead of each going to flash.
+ */
+static int
+fcb_elem_read(struct fcb *fcb, struct flash_sector *sector, off_t off,
+	      void *dst, size_t len)
+{
+#ifdef CONFIG_FCB_READ_AHEAD
+	size_t ra_len;
+	int rc;
+
+	if (len > sizeof(fcb->f_ra_buf) || off + len > sector->fs_size) {
+		return fcb_flash_read(fcb, sector, off, dst, len);
+	}
+
+	if (sector != fcb->f_ra_sector || off < fcb->f_ra_off ||
+	    off + len > fcb->f_ra_off + fcb->f_ra_len) {
+		ra_len = MIN(sizeof(fcb->f_ra_buf), sector->fs_size - off);
+
+		rc = fcb_flash_read(fcb, sector, off, fcb->f_ra_buf, ra_len);
+		if (rc) {
+			fcb->f_ra_sector = NULL;
+			return rc;
+		}
+
+		fcb->f_ra_sector = sector;
+		fcb->f_ra_off = off;
+		fcb->f_ra_len = ra_len;
+	}
+
+	memcpy(dst, &fcb->f_ra_buf[off - fcb->f_ra_off], len);
+
+	return 0;
+#else
+	return fcb_flash_read(fcb, sector, off, dst, len);
+#endif
+}
+
 /*
  * Given offset in flash sector, fill in rest of the fcb_entry, and crc8 over
  * the data.
@@ -29,7 +69,7 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
 	if (loc->fe_elem_off + 2 > loc->fe_sector->fs_size) {
 		return FCB_ERR_NOVAR;
 	}
-	rc = fcb_flash_read(fcb, loc->fe_sector, loc->fe_elem_off, tmp_str, 2);
+	rc = fcb_elem_read(fcb, loc->fe_sector, loc->fe_elem_off, tmp_str, 2);
 	if (rc) {
 		return FCB_ERR_FLASH;
 	}
@@ -52,7 +92,7 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *c8p)
 			blk_sz = sizeof(tmp_str);
 		}
 
-		rc = fcb_flash_read(fcb, loc->fe_sector, off, tmp_str, blk_sz);
+		rc = fcb_elem_read(fcb, loc->fe_sector, off, tmp_str, blk_sz);
 		if (rc) {
 			return FCB_ERR_FLASH;
 		}
@@ -76,7 +116,7 @@ int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 	}
 	off = loc->fe_data_off + fcb_len_in_flash(fcb, loc->fe_data_len);
 
-	rc = fcb_flash_read(fcb, loc->fe_sector, off, &fl_crc8, sizeof(fl_crc8));
+	rc = fcb_elem_read(fcb, loc->fe_sector, off, &fl_crc8, sizeof(fl_crc8));
 	if (rc) {
 		return FCB_ERR_FLASH;
 	}
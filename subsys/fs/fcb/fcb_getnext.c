@@ -105,6 +105,53 @@ next_sector:
 	return 0;
 }
 
+int
+fcb_getnth(struct fcb *fcb, u32_t n, struct fcb_entry *loc)
+{
+	int rc;
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return FCB_ERR_ARGS;
+	}
+
+	loc->fe_sector = fcb->f_oldest;
+	loc->fe_elem_off = 0U;
+
+#ifdef CONFIG_FCB_ELEM_INDEX
+	if (fcb->f_sector_elem_cnt) {
+		u16_t cnt;
+
+		/* skip the sectors before the one holding the element */
+		while (1) {
+			cnt = fcb->f_sector_elem_cnt[loc->fe_sector -
+						     fcb->f_sectors];
+			if (n < cnt) {
+				break;
+			}
+			if (loc->fe_sector == fcb->f_active.fe_sector) {
+				rc = FCB_ERR_NOVAR;
+				goto out;
+			}
+			n -= cnt;
+			loc->fe_sector = fcb_getnext_sector(fcb, loc->fe_sector);
+		}
+	}
+#endif
+
+	rc = fcb_getnext_nolock(fcb, loc);
+	while (!rc && n--) {
+		rc = fcb_getnext_nolock(fcb, loc);
+	}
+
+#ifdef CONFIG_FCB_ELEM_INDEX
+out:
+#endif
+	k_mutex_unlock(&fcb->f_mtx);
+
+	return rc;
+}
+
 int
 fcb_getnext(struct fcb *fcb, struct fcb_entry *loc)
 {
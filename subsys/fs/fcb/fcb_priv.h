@@ -44,6 +44,34 @@ struct flash_sector *fcb_getnext_sector(struct fcb *fcb,
 					struct flash_sector *sector);
 int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 
+static inline void fcb_read_ahead_invalidate(struct fcb *fcb)
+{
+#ifdef CONFIG_FCB_READ_AHEAD
+	fcb->f_ra_sector = NULL;
+#endif
+}
+
+static inline void fcb_elem_cnt_set(struct fcb *fcb,
+				    const struct flash_sector *sector,
+				    u16_t cnt)
+{
+#ifdef CONFIG_FCB_ELEM_INDEX
+	if (fcb->f_sector_elem_cnt) {
+		fcb->f_sector_elem_cnt[sector - fcb->f_sectors] = cnt;
+	}
+#endif
+}
+
+static inline void fcb_elem_cnt_inc(struct fcb *fcb,
+				    const struct flash_sector *sector)
+{
+#ifdef CONFIG_FCB_ELEM_INDEX
+	if (fcb->f_sector_elem_cnt) {
+		fcb->f_sector_elem_cnt[sector - fcb->f_sectors]++;
+	}
+#endif
+}
+
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, u8_t *crc8p);
 
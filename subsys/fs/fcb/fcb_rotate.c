@@ -19,11 +19,14 @@ fcb_rotate(struct fcb *fcb)
 		return FCB_ERR_ARGS;
 	}
 
+	fcb_read_ahead_invalidate(fcb);
+
 	rc = fcb_erase_sector(fcb, fcb->f_oldest);
 	if (rc) {
 		rc = FCB_ERR_FLASH;
 		goto out;
 	}
+	fcb_elem_cnt_set(fcb, fcb->f_oldest, 0);
 	if (fcb->f_oldest == fcb->f_active.fe_sector) {
 		/*
 		 * Need to create a new active area, as we're wiping
@@ -37,6 +40,7 @@ fcb_rotate(struct fcb *fcb)
 		fcb->f_active.fe_sector = sector;
 		fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
 		fcb->f_active_id++;
+		fcb_elem_cnt_set(fcb, sector, 0);
 	}
 	fcb->f_oldest = fcb_getnext_sector(fcb, fcb->f_oldest);
 out:
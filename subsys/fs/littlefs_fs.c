@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <errno.h>
+#include <init.h>
+#include <flash.h>
+#include <flash_map.h>
+#include <fs.h>
+#include <fs/littlefs.h>
+
+#define LOG_LEVEL CONFIG_FS_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_DECLARE(fs);
+
+struct lfs_file_data {
+	struct lfs_file file;
+	struct lfs_file_config config;
+	u8_t cache[CONFIG_FS_LITTLEFS_CACHE_SIZE] __aligned(4);
+};
+
+K_MEM_SLAB_DEFINE(lfs_file_pool, sizeof(struct lfs_file_data),
+		  CONFIG_FS_LITTLEFS_NUM_FILES, 4);
+K_MEM_SLAB_DEFINE(lfs_dir_pool, sizeof(struct lfs_dir),
+		  CONFIG_FS_LITTLEFS_NUM_DIRS, 4);
+
+#define LFS_FILEP(zfp) (&((struct lfs_file_data *)((zfp)->filep))->file)
+
+/* Littlefs errors are negated errno values, except for these two */
+static int lfs_to_errno(int error)
+{
+	if (error >= 0) {
+		return error;
+	}
+
+	switch (error) {
+	case LFS_ERR_IO:
+		return -EIO;
+	case LFS_ERR_CORRUPT:
+		return -EFAULT;
+	default:
+		return error;
+	}
+}
+
+static int errno_to_lfs(int error)
+{
+	return error ? LFS_ERR_IO : LFS_ERR_OK;
+}
+
+/*
+ * Block device on a flash area. Littlefs asks for the completion of each
+ * access before going on, so they stay synchronous.
+ */
+static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
+			lfs_off_t off, void *buffer, lfs_size_t size)
+{
+	const struct flash_area *fa = c->context;
+
+	return errno_to_lfs(flash_area_read(fa, block * c->block_size + off,
+					    buffer, size));
+}
+
+static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
+			lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+	const struct flash_area *fa = c->context;
+
+	return errno_to_lfs(flash_area_write(fa, block * c->block_size + off,
+					     buffer, size));
+}
+
+static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
+{
+	const struct flash_area *fa = c->context;
+
+	return errno_to_lfs(flash_area_erase(fa, block * c->block_size,
+					     c->block_size));
+}
+
+static int lfs_api_sync(const struct lfs_config *c)
+{
+	return LFS_ERR_OK;
+}
+
+static inline struct fs_littlefs *littlefs_get(const struct fs_mount_t *mp)
+{
+	return mp->fs_data;
+}
+
+static inline const char *littlefs_path(const struct fs_mount_t *mp,
+					const char *path)
+{
+	return &path[mp->mountp_len];
+}
+
+static void littlefs_lock(struct fs_littlefs *fs)
+{
+	k_mutex_lock(&fs->mutex, K_FOREVER);
+}
+
+static void littlefs_unlock(struct fs_littlefs *fs)
+{
+	k_mutex_unlock(&fs->mutex);
+}
+
+static int littlefs_open(struct fs_file_t *zfp, const char *file_name)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	struct lfs_file_data *fdp;
+	int rc;
+
+	if (k_mem_slab_alloc(&lfs_file_pool, &zfp->filep, K_NO_WAIT) != 0) {
+		zfp->filep = NULL;
+		return -ENOMEM;
+	}
+
+	fdp = zfp->filep;
+	(void)memset(fdp, 0, sizeof(*fdp));
+	fdp->config.buffer = fdp->cache;
+
+	littlefs_lock(fs);
+	rc = lfs_file_opencfg(&fs->lfs, &fdp->file,
+			      littlefs_path(zfp->mp, file_name),
+			      LFS_O_RDWR | LFS_O_CREAT, &fdp->config);
+	littlefs_unlock(fs);
+
+	if (rc < 0) {
+		k_mem_slab_free(&lfs_file_pool, &zfp->filep);
+		zfp->filep = NULL;
+	}
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_close(struct fs_file_t *zfp)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_file_close(&fs->lfs, LFS_FILEP(zfp));
+	littlefs_unlock(fs);
+
+	k_mem_slab_free(&lfs_file_pool, &zfp->filep);
+	zfp->filep = NULL;
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_unlink(struct fs_mount_t *mountp, const char *path)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_remove(&fs->lfs, littlefs_path(mountp, path));
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_rename(struct fs_mount_t *mountp, const char *from,
+			   const char *to)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_rename(&fs->lfs, littlefs_path(mountp, from),
+			littlefs_path(mountp, to));
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static ssize_t littlefs_read(struct fs_file_t *zfp, void *ptr, size_t len)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	ssize_t rc;
+
+	littlefs_lock(fs);
+	rc = lfs_file_read(&fs->lfs, LFS_FILEP(zfp), ptr, len);
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static ssize_t littlefs_write(struct fs_file_t *zfp, const void *ptr,
+			      size_t len)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	ssize_t rc;
+
+	littlefs_lock(fs);
+	rc = lfs_file_write(&fs->lfs, LFS_FILEP(zfp), ptr, len);
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_seek(struct fs_file_t *zfp, off_t off, int whence)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	int lfs_whence;
+	off_t rc;
+
+	switch (whence) {
+	case FS_SEEK_SET:
+		lfs_whence = LFS_SEEK_SET;
+		break;
+	case FS_SEEK_CUR:
+		lfs_whence = LFS_SEEK_CUR;
+		break;
+	case FS_SEEK_END:
+		lfs_whence = LFS_SEEK_END;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	littlefs_lock(fs);
+	rc = lfs_file_seek(&fs->lfs, LFS_FILEP(zfp), off, lfs_whence);
+	littlefs_unlock(fs);
+
+	return (rc < 0) ? lfs_to_errno(rc) : 0;
+}
+
+static off_t littlefs_tell(struct fs_file_t *zfp)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	off_t rc;
+
+	littlefs_lock(fs);
+	rc = lfs_file_tell(&fs->lfs, LFS_FILEP(zfp));
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_truncate(struct fs_file_t *zfp, off_t length)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_file_truncate(&fs->lfs, LFS_FILEP(zfp), length);
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_sync(struct fs_file_t *zfp)
+{
+	struct fs_littlefs *fs = littlefs_get(zfp->mp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_file_sync(&fs->lfs, LFS_FILEP(zfp));
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_mkdir(struct fs_mount_t *mountp, const char *path)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_mkdir(&fs->lfs, littlefs_path(mountp, path));
+	littlefs_unlock(fs);
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_opendir(struct fs_dir_t *zdp, const char *path)
+{
+	struct fs_littlefs *fs = littlefs_get(zdp->mp);
+	int rc;
+
+	if (k_mem_slab_alloc(&lfs_dir_pool, &zdp->dirp, K_NO_WAIT) != 0) {
+		zdp->dirp = NULL;
+		return -ENOMEM;
+	}
+
+	(void)memset(zdp->dirp, 0, sizeof(struct lfs_dir));
+
+	littlefs_lock(fs);
+	rc = lfs_dir_open(&fs->lfs, zdp->dirp, littlefs_path(zdp->mp, path));
+	littlefs_unlock(fs);
+
+	if (rc < 0) {
+		k_mem_slab_free(&lfs_dir_pool, &zdp->dirp);
+		zdp->dirp = NULL;
+	}
+
+	return lfs_to_errno(rc);
+}
+
+static void info_to_dirent(const struct lfs_info *info,
+			   struct fs_dirent *entry)
+{
+	entry->type = (info->type == LFS_TYPE_DIR) ?
+		      FS_DIR_ENTRY_DIR : FS_DIR_ENTRY_FILE;
+	entry->size = info->size;
+	strncpy(entry->name, info->name, sizeof(entry->name));
+	entry->name[sizeof(entry->name) - 1] = '\0';
+}
+
+static int littlefs_readdir(struct fs_dir_t *zdp, struct fs_dirent *entry)
+{
+	struct fs_littlefs *fs = littlefs_get(zdp->mp);
+	struct lfs_info info;
+	int rc;
+
+	littlefs_lock(fs);
+
+	/* skip the "." and ".." entries, the other backends do not have them */
+	do {
+		rc = lfs_dir_read(&fs->lfs, zdp->dirp, &info);
+	} while (rc > 0 && (!strcmp(info.name, ".") ||
+			    !strcmp(info.name, "..")));
+
+	littlefs_unlock(fs);
+
+	if (rc > 0) {
+		info_to_dirent(&info, entry);
+		rc = 0;
+	} else if (rc == 0) {
+		/* end of directory */
+		entry->name[0] = '\0';
+	}
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_closedir(struct fs_dir_t *zdp)
+{
+	struct fs_littlefs *fs = littlefs_get(zdp->mp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_dir_close(&fs->lfs, zdp->dirp);
+	littlefs_unlock(fs);
+
+	k_mem_slab_free(&lfs_dir_pool, &zdp->dirp);
+	zdp->dirp = NULL;
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_stat(struct fs_mount_t *mountp,
+			 const char *path, struct fs_dirent *entry)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	struct lfs_info info;
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_stat(&fs->lfs, littlefs_path(mountp, path), &info);
+	littlefs_unlock(fs);
+
+	if (rc >= 0) {
+		info_to_dirent(&info, entry);
+	}
+
+	return lfs_to_errno(rc);
+}
+
+static int littlefs_statvfs(struct fs_mount_t *mountp,
+			    const char *path, struct fs_statvfs *stat)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	lfs_ssize_t used;
+
+	littlefs_lock(fs);
+	used = lfs_fs_size(&fs->lfs);
+	littlefs_unlock(fs);
+
+	if (used < 0) {
+		return lfs_to_errno(used);
+	}
+
+	stat->f_bsize = fs->cfg.prog_size;
+	stat->f_frsize = fs->cfg.block_size;
+	stat->f_blocks = fs->cfg.block_count;
+	stat->f_bfree = fs->cfg.block_count - used;
+
+	return 0;
+}
+
+/* Block size from the flash pages: the largest page of the area */
+static lfs_size_t littlefs_block_size(const struct flash_area *fa)
+{
+	struct flash_sector sectors[8];
+	u32_t sector_cnt = ARRAY_SIZE(sectors);
+	lfs_size_t block_size = 0;
+	u32_t i;
+	int rc;
+
+	rc = flash_area_get_sectors(fa->fa_id, &sector_cnt, sectors);
+	if (rc != 0 && rc != -ENOMEM) {
+		return 0;
+	}
+
+	for (i = 0; i < sector_cnt; i++) {
+		block_size = MAX(block_size, sectors[i].fs_size);
+	}
+
+	return block_size;
+}
+
+static int littlefs_mount(struct fs_mount_t *mountp)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	struct lfs_config *lcp;
+	int rc;
+
+	if (!fs) {
+		return -EINVAL;
+	}
+
+	lcp = &fs->cfg;
+	if (!lcp->read_buffer || !lcp->prog_buffer || !lcp->lookahead_buffer ||
+	    lcp->cache_size > CONFIG_FS_LITTLEFS_CACHE_SIZE) {
+		return -EINVAL;
+	}
+
+	k_mutex_init(&fs->mutex);
+
+	rc = flash_area_open((uintptr_t)mountp->storage_dev, &fs->area);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (!lcp->block_size) {
+		lcp->block_size = littlefs_block_size(fs->area);
+	}
+
+	if (!lcp->block_size || fs->area->fa_size < 2 * lcp->block_size) {
+		LOG_ERR("littlefs: invalid block size %u",
+			(unsigned int)lcp->block_size);
+		rc = -EINVAL;
+		goto out;
+	}
+
+	if (!lcp->block_cycles) {
+		lcp->block_cycles = CONFIG_FS_LITTLEFS_BLOCK_CYCLES;
+	}
+
+	lcp->context = (void *)fs->area;
+	lcp->read = lfs_api_read;
+	lcp->prog = lfs_api_prog;
+	lcp->erase = lfs_api_erase;
+	lcp->sync = lfs_api_sync;
+	lcp->block_count = fs->area->fa_size / lcp->block_size;
+
+	littlefs_lock(fs);
+
+	rc = lfs_mount(&fs->lfs, lcp);
+	if (rc < 0) {
+		/* not formatted yet, or beyond repair */
+		LOG_WRN("littlefs: formatting %s", mountp->mnt_point);
+
+		rc = lfs_format(&fs->lfs, lcp);
+		if (rc >= 0) {
+			rc = lfs_mount(&fs->lfs, lcp);
+		}
+	}
+
+	littlefs_unlock(fs);
+
+	rc = lfs_to_errno(rc);
+out:
+	if (rc < 0) {
+		flash_area_close(fs->area);
+		fs->area = NULL;
+	}
+
+	return rc;
+}
+
+static int littlefs_unmount(struct fs_mount_t *mountp)
+{
+	struct fs_littlefs *fs = littlefs_get(mountp);
+	int rc;
+
+	littlefs_lock(fs);
+	rc = lfs_unmount(&fs->lfs);
+	littlefs_unlock(fs);
+
+	flash_area_close(fs->area);
+	fs->area = NULL;
+
+	return lfs_to_errno(rc);
+}
+
+/* File system interface */
+static struct fs_file_system_t littlefs_fs = {
+	.open = littlefs_open,
+	.close = littlefs_close,
+	.read = littlefs_read,
+	.write = littlefs_write,
+	.lseek = littlefs_seek,
+	.tell = littlefs_tell,
+	.truncate = littlefs_truncate,
+	.sync = littlefs_sync,
+	.opendir = littlefs_opendir,
+	.readdir = littlefs_readdir,
+	.closedir = littlefs_closedir,
+	.mount = littlefs_mount,
+	.unmount = littlefs_unmount,
+	.unlink = littlefs_unlink,
+	.rename = littlefs_rename,
+	.mkdir = littlefs_mkdir,
+	.stat = littlefs_stat,
+	.statvfs = littlefs_statvfs,
+};
+
+static int littlefs_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return fs_register(FS_LITTLEFS, &littlefs_fs);
+}
+
+SYS_INIT(littlefs_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
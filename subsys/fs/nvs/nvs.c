@@ -26,8 +26,32 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (fs->write_block_size - 1U)) & ~(fs->write_block_size - 1U);
 }
+
+#if defined(CONFIG_NVS_STATS)
+/* elapsed time in us since start, a value of k_cycle_get_32() */
+static inline u32_t nvs_stats_elapsed_us(u32_t start)
+{
+	return SYS_CLOCK_HW_CYCLES_TO_NS(k_cycle_get_32() - start) / 1000U;
+}
+
+static void nvs_stats_gc_update(struct nvs_gc_time *gc, u32_t time_us)
+{
+	gc->count++;
+	gc->time_total_us += time_us;
+	if (time_us > gc->time_max_us) {
+		gc->time_max_us = time_us;
+	}
+}
+#endif
 /* end basic routines */
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+static inline size_t nvs_lookup_cache_pos(u16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+#endif
+
 /* flash routines */
 /* basic aligned flash write to nvs address */
 static int nvs_flash_al_wrt(struct nvs_fs *fs, u32_t addr, const void *data,
@@ -103,6 +127,12 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	/* 0xFFFF is the id of sector close ate's, never looked up */
+	if (entry->id != 0xFFFF) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -241,6 +271,12 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, u32_t addr)
 		/* flash erase error */
 		return rc;
 	}
+#if defined(CONFIG_NVS_STATS)
+	fs->stats.erase_count++;
+	if (fs->sector_erase_count) {
+		fs->sector_erase_count[addr >> ADDR_SECT_SHIFT]++;
+	}
+#endif
 	(void) flash_write_protection_set(fs->flash_device, 1);
 	return 0;
 }
@@ -427,6 +463,137 @@ static int nvs_sector_close(struct nvs_fs *fs)
 }
 
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+/* rebuild the lookup cache by walking through all ate's, from newest to
+ * oldest, keeping the first valid ate found for each position.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	u32_t addr, ate_addr;
+	u32_t *cache_entry;
+	struct nvs_ate ate;
+
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+
+	addr = fs->ate_wra;
+
+	while (1) {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+
+		if ((ate.id != 0xFFFF) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    (!nvs_ate_crc8_check(&ate))) {
+			*cache_entry = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* drop the cache entries pointing into a sector that is erased. Any newer
+ * ate for the same position would have replaced them, so the position is
+ * left without entry.
+ */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, u32_t sector)
+{
+	u32_t *cache_entry = fs->lookup_cache;
+	u32_t *const cache_end =
+		&fs->lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+
+	for (; cache_entry < cache_end; ++cache_entry) {
+		if ((*cache_entry >> ADDR_SECT_SHIFT) == sector) {
+			*cache_entry = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
+
+/* nvs_gc_ate_live checks if the ate read at gc_addr is the most recent
+ * valid ate for its id and holds data, so it has to be kept by gc.
+ * returns 1 if live, 0 if not, errcode on error
+ */
+static int nvs_gc_ate_live(struct nvs_fs *fs, u32_t gc_addr,
+			   const struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	u32_t wlk_addr, wlk_prev_addr;
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate->id)];
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	while (1) {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (!nvs_ate_crc8_check(&wlk_ate))) {
+			break;
+		}
+	}
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == gc_addr) && gc_ate->len;
+}
+
+/* move the data of the ate read at gc_addr to the current write location
+ * and add a new ate for it.
+ */
+static int nvs_gc_ate_move(struct nvs_fs *fs, u32_t gc_addr,
+			   struct nvs_ate *gc_ate)
+{
+	int rc;
+	u32_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (gc_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (u16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
+/* erase a sector that has been garbage collected */
+static int nvs_gc_erase(struct nvs_fs *fs, u32_t sec_addr)
+{
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	nvs_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+	return nvs_flash_erase_sector(fs, sec_addr);
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -434,9 +601,8 @@ static int nvs_sector_close(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	u32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	u32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -472,60 +638,166 @@ static int nvs_gc(struct nvs_fs *fs)
 		if (rc) {
 			return rc;
 		}
-		wlk_addr = fs->ate_wra;
-		while (1) {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+		if (rc) {
+			/* copy needed */
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (!nvs_ate_crc8_check(&wlk_ate))) {
-				break;
-			}
 		}
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+		/* stop gc at end of the sector */
+		if (gc_prev_addr == stop_addr) {
+			break;
+		}
+	}
 
-			gc_ate.offset = (u16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+	return nvs_gc_erase(fs, sec_addr);
+}
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
+#if defined(CONFIG_NVS_GC_INCREMENTAL)
+/* incremental garbage collection: the sector that nvs_gc() collects at the
+ * next sector close is the one after the empty sector following the write
+ * sector. Its live entries are moved to the write sector ahead of time, a
+ * bounded number of ate's per step, and it is erased once all are moved.
+ * The moves are regular writes, so an interrupted step leaves a consistent
+ * file system and the gc at sector close only has the remainder to do.
+ * returns 0 if there is nothing left to do, 1 if more steps are needed,
+ * errcode on error.
+ */
+static int nvs_gc_step_locked(struct nvs_fs *fs, u16_t ate_count)
+{
+	int rc;
+	struct nvs_ate close_ate, gc_ate;
+	u32_t sec_addr, gc_prev_addr, stop_addr;
+	size_t ate_size;
+	u16_t sector;
+
+	if (fs->sector_count < 3) {
+		/* the sector to collect is the write sector itself */
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+	nvs_sector_advance(fs, &sec_addr);
+	sector = (u16_t)(sec_addr >> ADDR_SECT_SHIFT);
+	stop_addr = sec_addr + fs->sector_size - 2 * ate_size;
+
+	if (sector != fs->gc_sector) {
+		/* the write sector was closed, start on the next sector */
+		fs->gc_sector = sector;
+		rc = nvs_flash_ate_rd(fs, stop_addr + ate_size, &close_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!nvs_ate_cmp_const(&close_ate, 0xff)) {
+			/* sector not closed, nothing to collect */
+			fs->gc_addr = NVS_GC_ADDR_DONE;
+		} else {
+			fs->gc_addr = sec_addr + close_ate.offset;
+		}
+	}
+
+	while (fs->gc_addr != NVS_GC_ADDR_DONE) {
+		if (!ate_count--) {
+			return 1;
+		}
+
+		gc_prev_addr = fs->gc_addr;
+		rc = nvs_prev_ate(fs, &fs->gc_addr, &gc_ate);
+		if (rc) {
+			fs->gc_addr = gc_prev_addr;
+			return rc;
+		}
+
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			fs->gc_addr = gc_prev_addr;
+			return rc;
+		}
+		if (rc) {
+			/* leave space for delete ate, as nvs_write() does */
+			if ((fs->ate_wra - fs->data_wra) <
+			    nvs_al_size(fs, gc_ate.len) + ate_size) {
+				/* write sector full, nvs_gc() takes over */
+				fs->gc_addr = gc_prev_addr;
+				return 0;
 			}
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
+				fs->gc_addr = gc_prev_addr;
 				return rc;
 			}
 		}
 
-		/* stop gc at end of the sector */
 		if (gc_prev_addr == stop_addr) {
-			break;
+			/* all moved, the erase is not needed at close anymore */
+			fs->gc_addr = NVS_GC_ADDR_DONE;
+			return nvs_gc_erase(fs, sec_addr);
 		}
 	}
 
-	rc = nvs_flash_erase_sector(fs, sec_addr);
-	if (rc) {
-		return rc;
-	}
 	return 0;
 }
 
+/* run a step with the step latency accounted, fs->nvs_lock held */
+static int nvs_gc_step_timed(struct nvs_fs *fs)
+{
+	int rc;
+#if defined(CONFIG_NVS_STATS)
+	u32_t start = k_cycle_get_32();
+#endif
+
+	rc = nvs_gc_step_locked(fs, CONFIG_NVS_GC_STEP_ATES);
+#if defined(CONFIG_NVS_STATS)
+	nvs_stats_gc_update(&fs->stats.gc_step, nvs_stats_elapsed_us(start));
+#endif
+	return rc;
+}
+
+int nvs_gc_step(struct nvs_fs *fs)
+{
+	int rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	rc = nvs_gc_step_timed(fs);
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+}
+
+#if (CONFIG_NVS_GC_IDLE_DELAY > 0)
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	rc = nvs_gc_step(fs);
+	if (rc > 0) {
+		/* let other work items run between the steps */
+		(void)k_delayed_work_submit(&fs->gc_work, K_NO_WAIT);
+	} else if (rc < 0) {
+		LOG_ERR("Incremental gc failed (%d)", rc);
+	}
+}
+#endif
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -648,6 +920,13 @@ static int nvs_startup(struct nvs_fs *fs)
 		}
 	}
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	rc = nvs_lookup_cache_rebuild(fs);
+#endif
+#if defined(CONFIG_NVS_GC_INCREMENTAL)
+	fs->gc_sector = NVS_GC_SECTOR_NONE;
+#endif
+
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -670,6 +949,12 @@ int nvs_clear(struct nvs_fs *fs)
 			return rc;
 		}
 	}
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#endif
+#if defined(CONFIG_NVS_GC_INCREMENTAL)
+	fs->gc_sector = NVS_GC_SECTOR_NONE;
+#endif
 	return 0;
 }
 
@@ -680,6 +965,12 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	struct flash_pages_info info;
 
 	k_mutex_init(&fs->nvs_lock);
+#if defined(CONFIG_NVS_GC_INCREMENTAL) && (CONFIG_NVS_GC_IDLE_DELAY > 0)
+	k_delayed_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
+#if defined(CONFIG_NVS_STATS)
+	(void)memset(&fs->stats, 0, sizeof(fs->stats));
+#endif
 
 	fs->flash_device = device_get_binding(dev_name);
 	if (!fs->flash_device) {
@@ -738,6 +1029,9 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 	struct nvs_ate wlk_ate;
 	u32_t wlk_addr, rd_addr;
 	u16_t sector_freespace;
+#if defined(CONFIG_NVS_STATS)
+	u32_t gc_start;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -757,7 +1051,16 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		/* no entry with this id, skip the search */
+		wlk_addr = fs->ate_wra;
+		goto no_cached_entry;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (1) {
@@ -774,6 +1077,9 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 		}
 	}
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+no_cached_entry:
+#endif
 	if (wlk_addr != fs->ate_wra) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
@@ -817,6 +1123,9 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 			break;
 		}
 
+#if defined(CONFIG_NVS_STATS)
+		gc_start = k_cycle_get_32();
+#endif
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
@@ -827,7 +1136,21 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 			goto end;
 		}
 		gc_count++;
+#if defined(CONFIG_NVS_STATS)
+		nvs_stats_gc_update(&fs->stats.gc, nvs_stats_elapsed_us(gc_start));
+#endif
 	}
+
+#if defined(CONFIG_NVS_GC_INCREMENTAL)
+#if defined(CONFIG_NVS_GC_STEP_ON_WRITE)
+	/* the entry is written, a failing step is retried on the next one */
+	(void)nvs_gc_step_timed(fs);
+#endif
+#if (CONFIG_NVS_GC_IDLE_DELAY > 0)
+	(void)k_delayed_work_submit(&fs->gc_work,
+				    K_MSEC(CONFIG_NVS_GC_IDLE_DELAY));
+#endif
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -861,7 +1184,15 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -959,3 +1290,18 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+#if defined(CONFIG_NVS_STATS)
+void nvs_stats_get(struct nvs_fs *fs, struct nvs_stats *stats, bool reset)
+{
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	*stats = fs->stats;
+	if (reset) {
+		(void)memset(&fs->stats.gc, 0, sizeof(fs->stats.gc));
+		(void)memset(&fs->stats.gc_step, 0, sizeof(fs->stats.gc_step));
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif
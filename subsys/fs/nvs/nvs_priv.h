@@ -28,6 +28,13 @@ extern "C" {
 
 #define NVS_BLOCK_SIZE 32
 
+/* Lookup cache entry without any ate */
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+
+/* Incremental gc cursor once the sector has been collected */
+#define NVS_GC_ADDR_DONE 0xFFFFFFFF
+#define NVS_GC_SECTOR_NONE 0xFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	u16_t id;	/* data id */
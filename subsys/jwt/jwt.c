@@ -194,23 +194,11 @@ int jwt_add_payload(struct jwt_builder *builder,
 }
 
 #ifdef CONFIG_JWT_SIGN_RSA
-int jwt_sign(struct jwt_builder *builder,
-	     const char *der_key,
-	     size_t der_key_len)
+static int jwt_sign_rsa(mbedtls_pk_context *ctx, struct jwt_builder *builder)
 {
-	int res;
-	mbedtls_pk_context ctx;
-
-	mbedtls_pk_init(&ctx);
-
-	res = mbedtls_pk_parse_key(&ctx, der_key, der_key_len,
-				       NULL, 0);
-	if (res != 0) {
-		return res;
-	}
-
 	u8_t hash[32], sig[256];
 	size_t sig_len = sizeof(sig);
+	int res;
 
 	/*
 	 * The '0' indicates to mbedtls to do a SHA256, instead of
@@ -219,7 +207,7 @@ int jwt_sign(struct jwt_builder *builder,
 	mbedtls_sha256(builder->base, builder->buf - builder->base,
 		       hash, 0);
 
-	res = mbedtls_pk_sign(&ctx, MBEDTLS_MD_SHA256,
+	res = mbedtls_pk_sign(ctx, MBEDTLS_MD_SHA256,
 			      hash, sizeof(hash),
 			      sig, &sig_len,
 			      NULL, NULL);
@@ -233,6 +221,65 @@ int jwt_sign(struct jwt_builder *builder,
 
 	return builder->overflowed ? -ENOMEM : 0;
 }
+
+int jwt_sign(struct jwt_builder *builder,
+	     const char *der_key,
+	     size_t der_key_len)
+{
+	int res;
+	mbedtls_pk_context ctx;
+
+	mbedtls_pk_init(&ctx);
+
+	res = mbedtls_pk_parse_key(&ctx, der_key, der_key_len,
+				       NULL, 0);
+	if (res == 0) {
+		res = jwt_sign_rsa(&ctx, builder);
+	}
+
+	mbedtls_pk_free(&ctx);
+
+	return res;
+}
+
+int jwt_signer_init(struct jwt_signer *signer,
+		    const char *key,
+		    size_t key_len)
+{
+	k_mutex_init(&signer->lock);
+	mbedtls_pk_init(&signer->pk);
+
+	if (mbedtls_pk_parse_key(&signer->pk, key, key_len, NULL, 0) != 0) {
+		mbedtls_pk_free(&signer->pk);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int jwt_signer_precompute(struct jwt_signer *signer)
+{
+	ARG_UNUSED(signer);
+
+	return 0;
+}
+
+int jwt_signer_sign(struct jwt_signer *signer,
+		    struct jwt_builder *builder)
+{
+	int res;
+
+	k_mutex_lock(&signer->lock, K_FOREVER);
+	res = jwt_sign_rsa(&signer->pk, builder);
+	k_mutex_unlock(&signer->lock);
+
+	return res;
+}
+
+void jwt_signer_free(struct jwt_signer *signer)
+{
+	mbedtls_pk_free(&signer->pk);
+}
 #endif
 
 #ifdef CONFIG_JWT_SIGN_ECDSA
@@ -270,9 +317,113 @@ int default_CSPRNG(u8_t *dest, unsigned int size)
 	return res;
 }
 
-int jwt_sign(struct jwt_builder *builder,
-	     const char *der_key,
-	     size_t der_key_len)
+BUILD_ASSERT_MSG(sizeof(((struct jwt_ecdsa_presig *)0)->r) ==
+		 NUM_ECC_WORDS * sizeof(uECC_word_t),
+		 "Precomputed nonce not of the P-256 size");
+
+/*
+ * The offline half of uECC_sign(): a random nonce k, r from the point
+ * k.G, and 1/k, blinded against side channel analysis of the inversion
+ * as tinycrypt does.
+ */
+static int presig_compute(struct jwt_ecdsa_presig *ps)
+{
+	uECC_Curve curve = uECC_secp256r1();
+	wordcount_t num_words = curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	uECC_word_t _random[2 * NUM_ECC_WORDS];
+	uECC_word_t k[NUM_ECC_WORDS];
+	uECC_word_t tmp[NUM_ECC_WORDS];
+	uECC_word_t s[NUM_ECC_WORDS];
+	uECC_word_t *k2[2] = {tmp, s};
+	uECC_word_t p[NUM_ECC_WORDS * 2];
+	uECC_word_t carry;
+	int tries;
+
+	if (setup_prng() != 0) {
+		return -EIO;
+	}
+	uECC_set_rng(&default_CSPRNG);
+
+	for (tries = 0; tries < uECC_RNG_MAX_TRIES; tries++) {
+		if (!default_CSPRNG((u8_t *)_random, sizeof(_random))) {
+			return -EIO;
+		}
+
+		uECC_vli_mmod(k, _random, curve->n, num_n_words);
+
+		/* Make sure 0 < k < curve_n */
+		if (uECC_vli_isZero(k, num_words) ||
+		    uECC_vli_cmp(curve->n, k, num_n_words) != 1) {
+			continue;
+		}
+
+		carry = regularize_k(k, tmp, s, curve);
+		EccPoint_mult(p, curve->G, k2[!carry], 0,
+			      curve->num_n_bits + 1, curve);
+		if (uECC_vli_isZero(p, num_words)) {
+			continue;
+		}
+
+		if (!uECC_generate_random_int(tmp, curve->n, num_n_words)) {
+			return -EIO;
+		}
+
+		uECC_vli_modMult(k, k, tmp, curve->n, num_n_words);
+		uECC_vli_modInv(k, k, curve->n, num_n_words);
+		uECC_vli_modMult(k, k, tmp, curve->n, num_n_words);
+
+		uECC_vli_set(ps->r, p, num_words);
+		uECC_vli_set(ps->k_inv, k, num_n_words);
+
+		memset(k, 0, sizeof(k));
+		return 0;
+	}
+
+	return -EIO;
+}
+
+/*
+ * The online half of uECC_sign(): s = (e + r.d) / k.
+ */
+static int presig_sign(const u8_t *key, struct jwt_ecdsa_presig *ps,
+		       const u8_t *hash, u8_t *sig)
+{
+	uECC_Curve curve = uECC_secp256r1();
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	uECC_word_t tmp[NUM_ECC_WORDS];
+	uECC_word_t s[NUM_ECC_WORDS];
+
+	uECC_vli_nativeToBytes(sig, curve->num_bytes, ps->r);
+
+	uECC_vli_bytesToNative(tmp, key, BITS_TO_BYTES(curve->num_n_bits));
+	uECC_vli_set(s, ps->r, curve->num_words);
+	uECC_vli_modMult(s, tmp, s, curve->n, num_n_words);
+
+	/* The 256 bit hash is taken as is, reduced mod curve_n */
+	uECC_vli_bytesToNative(tmp, hash, curve->num_bytes);
+	if (uECC_vli_cmp_unsafe(curve->n, tmp, num_n_words) != 1) {
+		uECC_vli_sub(tmp, tmp, curve->n, num_n_words);
+	}
+
+	uECC_vli_modAdd(s, tmp, s, curve->n, num_n_words);
+	uECC_vli_modMult(s, s, ps->k_inv, curve->n, num_n_words);
+
+	/* A nonce is never used twice */
+	memset(ps, 0, sizeof(*ps));
+
+	if (uECC_vli_numBits(s, num_n_words) >
+	    (bitcount_t)curve->num_bytes * 8) {
+		return -EINVAL;
+	}
+
+	uECC_vli_nativeToBytes(sig + curve->num_bytes, curve->num_bytes, s);
+
+	return 0;
+}
+
+static int jwt_sign_ecdsa(const u8_t *key, struct jwt_ecdsa_presig *ps,
+			  struct jwt_builder *builder)
 {
 	struct tc_sha256_state_struct ctx;
 	u8_t hash[32], sig[64];
@@ -282,27 +433,180 @@ int jwt_sign(struct jwt_builder *builder,
 	tc_sha256_update(&ctx, builder->base, builder->buf - builder->base);
 	tc_sha256_final(hash, &ctx);
 
-	res = setup_prng();
+	if (ps != NULL) {
+		res = presig_sign(key, ps, hash, sig);
+		if (res != 0) {
+			return res;
+		}
+	} else {
+		res = setup_prng();
+
+		if (res != 0) {
+			return res;
+		}
+		uECC_set_rng(&default_CSPRNG);
+
+		/* Note that tinycrypt only supports P-256. */
+		res = uECC_sign(key, hash, sizeof(hash),
+				sig, &curve_secp256r1);
+		if (res != TC_CRYPTO_SUCCESS) {
+			return -EINVAL;
+		}
+	}
+
+	base64_outch(builder, '.');
+	base64_append_bytes(sig, sizeof(sig), builder);
+	base64_flush(builder);
+
+	return 0;
+}
+
+int jwt_sign(struct jwt_builder *builder,
+	     const char *der_key,
+	     size_t der_key_len)
+{
+	ARG_UNUSED(der_key_len);
+
+	return jwt_sign_ecdsa(der_key, NULL, builder);
+}
+
+static void jwt_signer_refill(struct k_work *work)
+{
+	struct jwt_signer *signer = CONTAINER_OF(work, struct jwt_signer,
+						 refill);
+
+	(void)jwt_signer_precompute(signer);
+}
+
+int jwt_signer_init(struct jwt_signer *signer,
+		    const char *key,
+		    size_t key_len)
+{
+	if (key_len != sizeof(signer->key)) {
+		return -EINVAL;
+	}
+
+	k_mutex_init(&signer->lock);
+	k_work_init(&signer->refill, jwt_signer_refill);
+	memcpy(signer->key, key, sizeof(signer->key));
+	signer->count = 0U;
+
+	return 0;
+}
+
+int jwt_signer_precompute(struct jwt_signer *signer)
+{
+	struct jwt_ecdsa_presig ps;
+	int res = 0;
+
+	k_mutex_lock(&signer->lock, K_FOREVER);
+
+	while (signer->count < ARRAY_SIZE(signer->presig)) {
+		/* The scalar multiplication is done unlocked */
+		k_mutex_unlock(&signer->lock);
+		res = presig_compute(&ps);
+		k_mutex_lock(&signer->lock, K_FOREVER);
+
+		if (res != 0) {
+			break;
+		}
+
+		if (signer->count < ARRAY_SIZE(signer->presig)) {
+			signer->presig[signer->count++] = ps;
+		}
+	}
+
+	k_mutex_unlock(&signer->lock);
+
+	memset(&ps, 0, sizeof(ps));
+
+	return res;
+}
+
+int jwt_signer_sign(struct jwt_signer *signer,
+		    struct jwt_builder *builder)
+{
+	struct jwt_ecdsa_presig ps;
+	bool found = false;
+	int res;
+
+	k_mutex_lock(&signer->lock, K_FOREVER);
+
+	if (signer->count > 0) {
+		signer->count--;
+		ps = signer->presig[signer->count];
+		memset(&signer->presig[signer->count], 0, sizeof(ps));
+		found = true;
+	}
+
+	k_mutex_unlock(&signer->lock);
+
+	res = jwt_sign_ecdsa(signer->key, found ? &ps : NULL, builder);
+
+	if (IS_ENABLED(CONFIG_JWT_ECDSA_PRESIGN_WORKQUEUE)) {
+		k_work_submit(&signer->refill);
+	}
+
+	return res;
+}
+
+void jwt_signer_free(struct jwt_signer *signer)
+{
+	memset(signer->key, 0, sizeof(signer->key));
+	memset(signer->presig, 0, sizeof(signer->presig));
+	signer->count = 0U;
+}
+#endif
 
+void jwt_cache_init(struct jwt_cache *cache,
+		    char *buffer,
+		    size_t buffer_size)
+{
+	cache->buf = buffer;
+	cache->size = buffer_size;
+	cache->len = 0;
+	cache->exp = 0;
+	cache->aud = NULL;
+}
+
+int jwt_cache_get(struct jwt_cache *cache,
+		  struct jwt_signer *signer,
+		  s32_t now,
+		  s32_t lifetime,
+		  const char *aud)
+{
+	struct jwt_builder builder;
+	int res;
+
+	if (cache->exp != 0 && now + CONFIG_JWT_CACHE_MARGIN < cache->exp &&
+	    strcmp(cache->aud, aud) == 0) {
+		return 0;
+	}
+
+	cache->exp = 0;
+
+	jwt_init_builder(&builder, cache->buf, cache->size);
+
+	res = jwt_add_payload(&builder, now + lifetime, now, aud);
 	if (res != 0) {
 		return res;
 	}
-	uECC_set_rng(&default_CSPRNG);
 
-	/* Note that tinycrypt only supports P-256. */
-	res = uECC_sign(der_key, hash, sizeof(hash),
-			sig, &curve_secp256r1);
-	if (res != TC_CRYPTO_SUCCESS) {
-		return -EINVAL;
+	res = jwt_signer_sign(signer, &builder);
+	if (res != 0) {
+		return res;
 	}
 
-	base64_outch(builder, '.');
-	base64_append_bytes(sig, sizeof(sig), builder);
-	base64_flush(builder);
+	if (builder.overflowed) {
+		return -ENOMEM;
+	}
+
+	cache->len = jwt_payload_len(&builder);
+	cache->exp = now + lifetime;
+	cache->aud = aud;
 
 	return 0;
 }
-#endif
 
 int jwt_init_builder(struct jwt_builder *builder,
 		     char *buffer,
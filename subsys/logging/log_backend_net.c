@@ -54,6 +54,56 @@ struct net_buf_pool *get_data_pool(void)
 	return &syslog_tx_bufs;
 }
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+/* Records are collected in a datagram until the next one does not fit or
+ * the batch timeout expires, batch_rec is where the current record starts.
+ */
+static u8_t batch_buf[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
+static size_t batch_len;
+static size_t batch_rec;
+static u32_t send_failed;
+static K_MUTEX_DEFINE(batch_lock);
+static struct k_delayed_work batch_work;
+
+static void batch_send(struct net_context *ctx, size_t len)
+{
+	int ret;
+
+	ret = net_context_send(ctx, batch_buf, len, NULL, K_NO_WAIT, NULL);
+	if (ret < 0) {
+		send_failed++;
+	}
+
+	batch_len -= len;
+	batch_rec -= MIN(batch_rec, len);
+	memmove(batch_buf, &batch_buf[len], batch_len);
+}
+
+static int line_out(u8_t *data, size_t length, void *output_ctx)
+{
+	struct net_context *ctx = (struct net_context *)output_ctx;
+	size_t len = MIN(length, sizeof(batch_buf));
+
+	if (ctx == NULL) {
+		return length;
+	}
+
+	if (batch_len + len > sizeof(batch_buf)) {
+		/* send the complete records, or the partial one if it
+		 * fills the datagram by itself
+		 */
+		batch_send(ctx, batch_rec ? batch_rec : batch_len);
+	}
+
+	memcpy(&batch_buf[batch_len], data, len);
+	batch_len += len;
+
+	DBG(data);
+
+	return len;
+}
+
+#else
 static int line_out(u8_t *data, size_t length, void *output_ctx)
 {
 	struct net_context *ctx = (struct net_context *)output_ctx;
@@ -72,9 +122,36 @@ static int line_out(u8_t *data, size_t length, void *output_ctx)
 fail:
 	return length;
 }
+#endif /* CONFIG_LOG_BACKEND_NET_BATCH */
 
 LOG_OUTPUT_DEFINE(log_output, line_out, output_buf, sizeof(output_buf));
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+/* Called with batch_lock held after each complete record. */
+static void batch_record_end(void)
+{
+	batch_rec = batch_len;
+
+	if (batch_len > 0 && !k_delayed_work_remaining_get(&batch_work)) {
+		(void)k_delayed_work_submit(&batch_work,
+				K_MSEC(CONFIG_LOG_BACKEND_NET_BATCH_TIMEOUT_MS));
+	}
+}
+
+static void batch_flush(struct k_work *work)
+{
+	struct net_context *ctx = log_output.control_block->ctx;
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	if (ctx != NULL && batch_len > 0) {
+		batch_send(ctx, batch_len);
+	}
+
+	k_mutex_unlock(&batch_lock);
+}
+#endif
+
 static int do_net_init(void)
 {
 	struct sockaddr *local_addr = NULL;
@@ -183,19 +260,57 @@ static void send_output(const struct log_backend *const backend,
 
 	log_msg_get(msg);
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	/* datagrams which could not be sent are reported in-band */
+	if (send_failed) {
+		u32_t cnt = send_failed;
+
+		send_failed = 0U;
+		log_output_dropped_process(&log_output, cnt);
+		batch_record_end();
+	}
+#endif
+
 	log_output_msg_process(&log_output, msg,
 			       LOG_OUTPUT_FLAG_FORMAT_SYSLOG |
 			       LOG_OUTPUT_FLAG_TIMESTAMP);
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+	batch_record_end();
+	k_mutex_unlock(&batch_lock);
+#endif
+
 	log_msg_put(msg);
 }
 
+static void dropped(const struct log_backend *const backend, u32_t cnt)
+{
+	if (panic_mode || !net_init_done) {
+		return;
+	}
+
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	log_output_dropped_process(&log_output, cnt);
+	batch_record_end();
+	k_mutex_unlock(&batch_lock);
+#else
+	log_output_dropped_process(&log_output, cnt);
+#endif
+}
+
 static void init_net(void)
 {
 	int ret;
 
 	net_sin(&server_addr)->sin_port = htons(514);
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+	k_delayed_work_init(&batch_work, batch_flush);
+#endif
+
 	ret = net_ipaddr_parse(CONFIG_LOG_BACKEND_NET_SERVER,
 			       sizeof(CONFIG_LOG_BACKEND_NET_SERVER) - 1,
 			       &server_addr);
@@ -240,6 +355,7 @@ const struct log_backend_api log_backend_net_api = {
 	 * this can be revisited if needed.
 	 */
 	.put_sync_hexdump = NULL,
+	.dropped = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : dropped,
 };
 
 /* Note that the backend can be activated only after we have networking
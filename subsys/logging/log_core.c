@@ -14,6 +14,10 @@
 #include <assert.h>
 #include <atomic.h>
 #include <ctype.h>
+#ifdef CONFIG_LOG_PER_CPU
+#include <spinlock.h>
+#include <kernel_structs.h>
+#endif
 
 LOG_MODULE_REGISTER(log);
 
@@ -54,7 +58,18 @@ struct k_mem_slab log_strdup_pool;
 static u8_t __noinit __aligned(sizeof(u32_t))
 		log_strdup_pool_buf[LOG_STRDUP_POOL_BUFFER_SIZE];
 
+#ifdef CONFIG_LOG_PER_CPU
+/* Messages are staged on the list of the CPU they were created on, so
+ * logging CPUs never contend with each other, only with the processing
+ * thread taking messages out.
+ */
+static struct log_cpu_list {
+	struct k_spinlock lock;
+	struct log_list_t list;
+} cpu_lists[CONFIG_MP_NUM_CPUS];
+#else
 static struct log_list_t list;
+#endif
 static atomic_t initialized;
 static bool panic_mode;
 static bool backend_attached;
@@ -188,21 +203,118 @@ static void detect_missed_strdup(struct log_msg *msg)
 #undef ERR_MSG
 }
 
-static inline void msg_finalize(struct log_msg *msg,
-				struct log_msg_ids src_level)
+#ifdef CONFIG_LOG_PER_CPU
+static void msg_list_init(void)
 {
-	unsigned int key;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		log_list_init(&cpu_lists[i].list);
+	}
+}
 
-	msg->hdr.ids = src_level;
+static void msg_list_add(struct log_msg *msg)
+{
+	struct log_cpu_list *cpu_list;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+
+	/* The local interrupt lock keeps the thread on this CPU. */
+	irq_key = z_arch_irq_lock();
+	cpu_list = &cpu_lists[_current_cpu->id];
+
+	key = k_spin_lock(&cpu_list->lock);
 	msg->hdr.timestamp = timestamp_func();
+	log_list_add_tail(&cpu_list->list, msg);
+	k_spin_unlock(&cpu_list->lock, key);
 
-	atomic_inc(&buffered_cnt);
+	z_arch_irq_unlock(irq_key);
+}
+
+/* Take the oldest message of all CPUs, merging them in timestamp order. */
+static struct log_msg *msg_list_get(void)
+{
+	struct log_cpu_list *oldest = NULL;
+	struct log_msg *msg;
+	k_spinlock_key_t key;
+	u32_t timestamp = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct log_cpu_list *cpu_list = &cpu_lists[i];
+
+		key = k_spin_lock(&cpu_list->lock);
+		msg = log_list_head_peek(&cpu_list->list);
+		if (msg != NULL && (oldest == NULL ||
+		    (s32_t)(msg->hdr.timestamp - timestamp) < 0)) {
+			oldest = cpu_list;
+			timestamp = msg->hdr.timestamp;
+		}
+		k_spin_unlock(&cpu_list->lock, key);
+	}
+
+	if (oldest == NULL) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&oldest->lock);
+	msg = log_list_head_get(&oldest->list);
+	k_spin_unlock(&oldest->lock, key);
+
+	return msg;
+}
+
+static bool msg_list_pending(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (log_list_head_peek(&cpu_lists[i].list) != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+static void msg_list_init(void)
+{
+	log_list_init(&list);
+}
+
+static void msg_list_add(struct log_msg *msg)
+{
+	unsigned int key;
+
+	msg->hdr.timestamp = timestamp_func();
 
 	key = irq_lock();
 
 	log_list_add_tail(&list, msg);
 
 	irq_unlock(key);
+}
+
+static struct log_msg *msg_list_get(void)
+{
+	struct log_msg *msg;
+	unsigned int key = irq_lock();
+
+	msg = log_list_head_get(&list);
+	irq_unlock(key);
+
+	return msg;
+}
+
+static bool msg_list_pending(void)
+{
+	return (log_list_head_peek(&list) != NULL);
+}
+#endif /* CONFIG_LOG_PER_CPU */
+
+static inline void msg_finalize(struct log_msg *msg,
+				struct log_msg_ids src_level)
+{
+	msg->hdr.ids = src_level;
+
+	atomic_inc(&buffered_cnt);
+
+	msg_list_add(msg);
 
 	if (panic_mode) {
 		(void)log_process(false);
@@ -403,7 +515,10 @@ void log_hexdump_sync(struct log_msg_ids src_level, const char *metadata,
 
 static u32_t timestamp_get(void)
 {
-	if (CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC > 1000000) {
+	if (IS_ENABLED(CONFIG_LOG_TIMESTAMP_US)) {
+		return (u32_t)(k_cycle_to_ns_64(k_cycle_get_64()) /
+			       NSEC_PER_USEC);
+	} else if (CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC > 1000000) {
 		return k_uptime_get_32();
 	} else {
 		return k_cycle_get_32();
@@ -415,9 +530,13 @@ void log_core_init(void)
 	u32_t freq = (CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC > 1000000) ?
 			1000 : CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 
+	if (IS_ENABLED(CONFIG_LOG_TIMESTAMP_US)) {
+		freq = USEC_PER_SEC;
+	}
+
 	if (!IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
 		log_msg_pool_init();
-		log_list_init(&list);
+		msg_list_init();
 
 		k_mem_slab_init(&log_strdup_pool, log_strdup_pool_buf,
 					sizeof(struct log_strdup_buf),
@@ -600,10 +719,8 @@ bool log_process(bool bypass)
 	if (!backend_attached && !bypass) {
 		return false;
 	}
-	unsigned int key = irq_lock();
 
-	msg = log_list_head_get(&list);
-	irq_unlock(key);
+	msg = msg_list_get();
 
 	if (msg != NULL) {
 		atomic_dec(&buffered_cnt);
@@ -614,7 +731,7 @@ bool log_process(bool bypass)
 		dropped_notify();
 	}
 
-	return (log_list_head_peek(&list) != NULL);
+	return msg_list_pending();
 }
 
 u32_t log_buffered_cnt(void)
@@ -8,6 +8,7 @@
 #include <logging/log_ctrl.h>
 #include <logging/log_core.h>
 #include <string.h>
+#include <spinlock.h>
 
 #ifndef CONFIG_LOG_BUFFER_SIZE
 #define CONFIG_LOG_BUFFER_SIZE 0
@@ -16,6 +17,131 @@
 #define MSG_SIZE sizeof(union log_msg_chunk)
 #define NUM_OF_MSGS (CONFIG_LOG_BUFFER_SIZE / MSG_SIZE)
 
+#ifdef CONFIG_LOG_MSG_RING
+/*
+ * Messages are allocated in place from a ring buffer of words, each one
+ * preceded by a header word holding its length in words and a free flag.
+ * Messages are usually freed in allocation order, but backends may hold
+ * messages, so a freed message is only flagged and the tail moves over
+ * every freed message it reaches. Space left at the end of the buffer when
+ * a message does not fit is covered by a free padding block. Allocating and
+ * freeing are a few operations under a spinlock, which keeps the buffer
+ * consistent on SMP as well.
+ */
+typedef uintptr_t ring_word_t;
+
+#define RING_WORDS (CONFIG_LOG_BUFFER_SIZE / sizeof(ring_word_t))
+#define RING_FREE  BIT(31)
+#define RING_LEN(hdr) ((hdr) & ~RING_FREE)
+
+static ring_word_t __noinit ring_buf[RING_WORDS];
+
+static struct {
+	struct k_spinlock lock;
+	u32_t head;	/* next allocation */
+	u32_t tail;	/* oldest message */
+	u32_t used;	/* words in use, including padding */
+} ring;
+
+void log_msg_pool_init(void)
+{
+	ring.head = 0U;
+	ring.tail = 0U;
+	ring.used = 0U;
+}
+
+static struct log_msg *ring_alloc(size_t size)
+{
+	u32_t len = 1U + ceiling_fraction(size, sizeof(ring_word_t));
+	struct log_msg *msg = NULL;
+	k_spinlock_key_t key;
+	u32_t end;
+
+	key = k_spin_lock(&ring.lock);
+
+	if (ring.used == 0U) {
+		ring.head = 0U;
+		ring.tail = 0U;
+	}
+
+	if (ring.head >= ring.tail && ring.used < RING_WORDS) {
+		/* free space at the end and at the start */
+		end = RING_WORDS - ring.head;
+
+		if (len > end && len <= ring.tail) {
+			ring_buf[ring.head] = RING_FREE | end;
+			ring.used += end;
+			ring.head = 0U;
+		}
+	}
+
+	end = (ring.head >= ring.tail && ring.used < RING_WORDS) ?
+	      RING_WORDS : ring.tail;
+
+	if (RING_WORDS - ring.used >= len && end - ring.head >= len) {
+		ring_buf[ring.head] = len;
+		msg = (struct log_msg *)&ring_buf[ring.head + 1];
+		ring.used += len;
+		ring.head = (ring.head + len) % RING_WORDS;
+	}
+
+	k_spin_unlock(&ring.lock, key);
+
+	return msg;
+}
+
+static void ring_free(struct log_msg *msg)
+{
+	ring_word_t *hdr = (ring_word_t *)msg - 1;
+	k_spinlock_key_t key;
+	u32_t len;
+
+	key = k_spin_lock(&ring.lock);
+
+	*hdr |= RING_FREE;
+
+	while (ring.used > 0U && (ring_buf[ring.tail] & RING_FREE)) {
+		len = RING_LEN(ring_buf[ring.tail]);
+		ring.used -= len;
+		ring.tail = (ring.tail + len) % RING_WORDS;
+	}
+
+	k_spin_unlock(&ring.lock, key);
+}
+
+struct log_msg *log_msg_ring_alloc(size_t size)
+{
+	struct log_msg *msg = ring_alloc(size);
+	bool more;
+
+	if (msg != NULL) {
+		return msg;
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW)) {
+		do {
+			more = log_process(true);
+			log_dropped();
+			msg = ring_alloc(size);
+		} while ((msg == NULL) && more);
+	} else {
+		log_dropped();
+	}
+
+	return msg;
+}
+
+/* Arguments and hexdump data directly follow the head of the message. */
+static inline u32_t *ring_args(struct log_msg *msg)
+{
+	return (u32_t *)&msg->payload;
+}
+
+static inline u8_t *ring_bytes(struct log_msg *msg)
+{
+	return (u8_t *)&msg->payload;
+}
+#else
 struct k_mem_slab log_msg_pool;
 static u8_t __noinit __aligned(sizeof(u32_t))
 		log_msg_pool_buf[CONFIG_LOG_BUFFER_SIZE];
@@ -24,12 +150,14 @@ void log_msg_pool_init(void)
 {
 	k_mem_slab_init(&log_msg_pool, log_msg_pool_buf, MSG_SIZE, NUM_OF_MSGS);
 }
+#endif /* CONFIG_LOG_MSG_RING */
 
 void log_msg_get(struct log_msg *msg)
 {
 	atomic_inc(&msg->hdr.ref_cnt);
 }
 
+#ifndef CONFIG_LOG_MSG_RING
 static void cont_free(struct log_msg_cont *cont)
 {
 	struct log_msg_cont *next;
@@ -40,6 +168,7 @@ static void cont_free(struct log_msg_cont *cont)
 		cont = next;
 	}
 }
+#endif
 
 static void msg_free(struct log_msg *msg)
 {
@@ -58,13 +187,18 @@ static void msg_free(struct log_msg *msg)
 		}
 	}
 
+#ifdef CONFIG_LOG_MSG_RING
+	ring_free(msg);
+#else
 	if (msg->hdr.params.generic.ext == 1) {
 		cont_free(msg->payload.ext.next);
 	}
 
 	k_mem_slab_free(&log_msg_pool, (void **)&msg);
+#endif
 }
 
+#ifndef CONFIG_LOG_MSG_RING
 union log_msg_chunk *log_msg_no_space_handle(void)
 {
 	union log_msg_chunk *msg = NULL;
@@ -85,6 +219,8 @@ union log_msg_chunk *log_msg_no_space_handle(void)
 	return msg;
 
 }
+#endif
+
 void log_msg_put(struct log_msg *msg)
 {
 	atomic_dec(&msg->hdr.ref_cnt);
@@ -99,6 +235,7 @@ u32_t log_msg_nargs_get(struct log_msg *msg)
 	return msg->hdr.params.std.nargs;
 }
 
+#ifndef CONFIG_LOG_MSG_RING
 static u32_t cont_arg_get(struct log_msg *msg, u32_t arg_idx)
 {
 	struct log_msg_cont *cont;
@@ -118,6 +255,7 @@ static u32_t cont_arg_get(struct log_msg *msg, u32_t arg_idx)
 
 	return cont->payload.args[arg_idx];
 }
+#endif
 
 u32_t log_msg_arg_get(struct log_msg *msg, u32_t arg_idx)
 {
@@ -128,11 +266,15 @@ u32_t log_msg_arg_get(struct log_msg *msg, u32_t arg_idx)
 		return 0;
 	}
 
+#ifdef CONFIG_LOG_MSG_RING
+	arg = ring_args(msg)[arg_idx];
+#else
 	if (msg->hdr.params.std.nargs <= LOG_MSG_NARGS_SINGLE_CHUNK) {
 		arg = msg->payload.single.args[arg_idx];
 	} else {
 		arg = cont_arg_get(msg, arg_idx);
 	}
+#endif
 
 	return arg;
 }
@@ -142,6 +284,7 @@ const char *log_msg_str_get(struct log_msg *msg)
 	return msg->str;
 }
 
+#ifndef CONFIG_LOG_MSG_RING
 /** @brief Allocate chunk for extended standard log message.
  *
  *  @details Extended standard log message is used when number of arguments
@@ -211,6 +354,7 @@ static void copy_args_to_msg(struct  log_msg *msg, u32_t *args, u32_t nargs)
 		cont = cont->next;
 	}
 }
+#endif
 
 struct log_msg *log_msg_create_n(const char *str, u32_t *args, u32_t nargs)
 {
@@ -218,6 +362,15 @@ struct log_msg *log_msg_create_n(const char *str, u32_t *args, u32_t nargs)
 
 	struct  log_msg *msg = NULL;
 
+#ifdef CONFIG_LOG_MSG_RING
+	msg = z_log_msg_std_alloc_n(nargs);
+
+	if (msg != NULL) {
+		msg->str = str;
+		msg->hdr.params.std.nargs = nargs;
+		(void)memcpy(ring_args(msg), args, nargs * sizeof(u32_t));
+	}
+#else
 	msg = msg_alloc(nargs);
 
 	if (msg != NULL) {
@@ -225,6 +378,7 @@ struct log_msg *log_msg_create_n(const char *str, u32_t *args, u32_t nargs)
 		msg->hdr.params.std.nargs = nargs;
 		copy_args_to_msg(msg, args, nargs);
 	}
+#endif
 
 	return msg;
 }
@@ -233,15 +387,30 @@ struct log_msg *log_msg_hexdump_create(const char *str,
 				       const u8_t *data,
 				       u32_t length)
 {
+#ifndef CONFIG_LOG_MSG_RING
 	struct log_msg_cont **prev_cont;
 	struct log_msg_cont *cont;
-	struct log_msg *msg;
 	u32_t chunk_length;
+#endif
+	struct log_msg *msg;
 
 	/* Saturate length. */
 	length = (length > LOG_MSG_HEXDUMP_MAX_LENGTH) ?
 		 LOG_MSG_HEXDUMP_MAX_LENGTH : length;
 
+#ifdef CONFIG_LOG_MSG_RING
+	msg = log_msg_ring_alloc(LOG_MSG_RING_HEXDUMP_SIZE(length));
+	if (msg == NULL) {
+		return NULL;
+	}
+
+	msg->hdr.ref_cnt = 1;
+	msg->hdr.params.raw = 0U;
+	msg->hdr.params.hexdump.type = LOG_MSG_TYPE_HEXDUMP;
+	msg->hdr.params.hexdump.length = length;
+	msg->str = str;
+	(void)memcpy(ring_bytes(msg), data, length);
+#else
 	msg = (struct log_msg *)log_msg_chunk_alloc();
 	if (msg == NULL) {
 		return NULL;
@@ -289,6 +458,7 @@ struct log_msg *log_msg_hexdump_create(const char *str,
 		data += chunk_length;
 		length -= chunk_length;
 	}
+#endif
 
 	return msg;
 }
@@ -317,6 +487,16 @@ static void log_msg_hexdump_data_op(struct log_msg *msg,
 
 	req_len = *length;
 
+#ifdef CONFIG_LOG_MSG_RING
+	if (put_op) {
+		(void)memcpy(&ring_bytes(msg)[offset], data, req_len);
+	} else {
+		(void)memcpy(data, &ring_bytes(msg)[offset], req_len);
+	}
+
+	return;
+#endif
+
 	if (available_len > LOG_MSG_HEXDUMP_BYTES_SINGLE_CHUNK) {
 		chunk_len = LOG_MSG_HEXDUMP_BYTES_HEAD_CHUNK;
 		head_data = msg->payload.ext.data.bytes;
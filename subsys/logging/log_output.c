@@ -12,6 +12,9 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+#include <misc/byteorder.h>
+#include <misc/cbprintf.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -19,6 +22,14 @@
 
 #define HEXDUMP_BYTES_IN_LINE 8
 
+/* Formatting with z_prf() of the minimal libc instead of cbprintf */
+#if !defined(CONFIG_NEWLIB_LIBC) && !defined(CONFIG_ARCH_POSIX) && \
+    defined(CONFIG_LOG_ENABLE_FANCY_OUTPUT_FORMATTING)
+#define LOG_FANCY_FORMATTING 1
+#else
+#define LOG_FANCY_FORMATTING 0
+#endif
+
 #define  DROPPED_COLOR_PREFIX \
 	Z_LOG_EVAL(CONFIG_LOG_BACKEND_SHOW_COLOR, (LOG_COLOR_CODE_RED), ())
 
@@ -47,8 +58,6 @@ static u32_t timestamp_div;
 typedef int (*out_func_t)(int c, void *ctx);
 
 extern int z_prf(int (*func)(), void *dest, char *format, va_list vargs);
-extern void z_vprintk(out_func_t out, void *log_output,
-		     const char *fmt, va_list ap);
 
 /* The RFC 5424 allows very flexible mapping and suggest the value 0 being the
  * highest severity and 7 to be the lowest (debugging level) severity.
@@ -114,11 +123,10 @@ static int print_formatted(const struct log_output *log_output,
 	int length = 0;
 
 	va_start(args, fmt);
-#if !defined(CONFIG_NEWLIB_LIBC) && !defined(CONFIG_ARCH_POSIX) && \
-    defined(CONFIG_LOG_ENABLE_FANCY_OUTPUT_FORMATTING)
+#if LOG_FANCY_FORMATTING
 	length = z_prf(out_func, (void *)log_output, (char *)fmt, args);
 #else
-	z_vprintk(out_func, (void *)log_output, fmt, args);
+	length = cbvprintf(out_func, (void *)log_output, fmt, args);
 #endif
 	va_end(args);
 
@@ -278,6 +286,13 @@ static void std_print(struct log_msg *msg,
 		args[i] = log_msg_arg_get(msg, i);
 	}
 
+	if (!LOG_FANCY_FORMATTING) {
+		/* The arguments are words, formatted without a variadic call */
+		z_cbprintf_words(out_func, (void *)log_output, str, args,
+				 nargs);
+		return;
+	}
+
 	switch (log_msg_nargs_get(msg)) {
 	case 0:
 		print_formatted(log_output, str);
@@ -494,6 +509,180 @@ static void postfix_print(const struct log_output *log_output,
 	newline_print(log_output, flags);
 }
 
+#ifdef CONFIG_LOG_DICTIONARY
+/*
+ * Dictionary mode: instead of formatting on the device, messages are written
+ * as binary records referring to strings by their address. The host decodes
+ * them with the dictionary generated from the ELF file at build time (see
+ * scripts/logging/dictionary). Records are little endian and start with
+ * LOG_DICT_SYNC and the record type:
+ *
+ * std:     level, domain_id, source_id (u16), timestamp (u32), format
+ *          string address (u32), nargs (u8), arguments (nargs * u32), then
+ *          the arguments of %s conversions as NUL terminated strings
+ * hexdump: level, domain_id, source_id (u16), timestamp (u32), metadata
+ *          string address (u32), length (u16), data
+ * raw:     length (u16), data (printk strings)
+ * dropped: count (u32)
+ */
+#define LOG_DICT_SYNC		0xA5
+#define LOG_DICT_STD		0x01
+#define LOG_DICT_HEXDUMP	0x02
+#define LOG_DICT_RAW		0x03
+#define LOG_DICT_DROPPED	0x04
+
+static void dict_put(const struct log_output *log_output,
+		     const void *data, size_t len)
+{
+	const u8_t *bytes = data;
+
+	while (len--) {
+		(void)out_func(*bytes++, (void *)log_output);
+	}
+}
+
+static void dict_put_u16(const struct log_output *log_output, u16_t val)
+{
+	u8_t buf[sizeof(val)];
+
+	sys_put_le16(val, buf);
+	dict_put(log_output, buf, sizeof(buf));
+}
+
+static void dict_put_u32(const struct log_output *log_output, u32_t val)
+{
+	u8_t buf[sizeof(val)];
+
+	sys_put_le32(val, buf);
+	dict_put(log_output, buf, sizeof(buf));
+}
+
+static void dict_hdr_put(const struct log_output *log_output, u8_t type,
+			 struct log_msg *msg)
+{
+	u8_t hdr[] = {
+		LOG_DICT_SYNC,
+		type,
+		(u8_t)log_msg_level_get(msg),
+		(u8_t)log_msg_domain_id_get(msg),
+	};
+
+	dict_put(log_output, hdr, sizeof(hdr));
+	dict_put_u16(log_output, (u16_t)log_msg_source_id_get(msg));
+	dict_put_u32(log_output, log_msg_timestamp_get(msg));
+}
+
+/*
+ * Strings passed with %s may be transient (log_strdup) and are the only
+ * data the host cannot look up, so they are copied into the record. This
+ * only needs to find the conversions, which is far cheaper than formatting.
+ */
+static void dict_strings_put(const struct log_output *log_output,
+			     struct log_msg *msg)
+{
+	const char *fmt = log_msg_str_get(msg);
+	u32_t nargs = log_msg_nargs_get(msg);
+	u32_t arg = 0U;
+
+	while (*fmt != '\0' && arg < nargs) {
+		if (*fmt++ != '%') {
+			continue;
+		}
+
+		if (*fmt == '%') {
+			fmt++;
+			continue;
+		}
+
+		/* flags, width, precision and length modifiers */
+		while (*fmt != '\0' && strchr("-+ #0123456789.*hlLjzt", *fmt)) {
+			if (*fmt == '*') {
+				arg++;
+			}
+			fmt++;
+		}
+
+		if (*fmt == 's') {
+			const char *str = (const char *)log_msg_arg_get(msg,
+									arg);
+
+			if (str == NULL) {
+				str = "(null)";
+			}
+			dict_put(log_output, str, strlen(str) + 1);
+		}
+
+		if (*fmt != '\0') {
+			fmt++;
+			arg++;
+		}
+	}
+}
+
+static void dict_std_put(const struct log_output *log_output,
+			 struct log_msg *msg)
+{
+	u32_t nargs = log_msg_nargs_get(msg);
+	u32_t i;
+
+	dict_hdr_put(log_output, LOG_DICT_STD, msg);
+	dict_put_u32(log_output, (u32_t)log_msg_str_get(msg));
+	dict_put(log_output, &(u8_t){nargs}, 1);
+
+	for (i = 0U; i < nargs; i++) {
+		dict_put_u32(log_output, log_msg_arg_get(msg, i));
+	}
+
+	dict_strings_put(log_output, msg);
+}
+
+static void dict_data_put(const struct log_output *log_output,
+			  struct log_msg *msg)
+{
+	u32_t offset = 0U;
+	u8_t buf[HEXDUMP_BYTES_IN_LINE];
+	size_t length;
+
+	dict_put_u16(log_output, msg->hdr.params.hexdump.length);
+
+	do {
+		length = sizeof(buf);
+		log_msg_hexdump_data_get(msg, buf, &length, offset);
+		dict_put(log_output, buf, length);
+		offset += length;
+	} while (length > 0);
+}
+
+static void dict_msg_process(const struct log_output *log_output,
+			     struct log_msg *msg)
+{
+	if (log_msg_is_std(msg)) {
+		dict_std_put(log_output, msg);
+	} else if (log_msg_level_get(msg) == LOG_LEVEL_INTERNAL_RAW_STRING) {
+		u8_t hdr[] = { LOG_DICT_SYNC, LOG_DICT_RAW };
+
+		dict_put(log_output, hdr, sizeof(hdr));
+		dict_data_put(log_output, msg);
+	} else {
+		dict_hdr_put(log_output, LOG_DICT_HEXDUMP, msg);
+		dict_put_u32(log_output, (u32_t)log_msg_str_get(msg));
+		dict_data_put(log_output, msg);
+	}
+
+	log_output_flush(log_output);
+}
+
+static void dict_dropped_process(const struct log_output *log_output,
+				 u32_t cnt)
+{
+	u8_t buf[] = { LOG_DICT_SYNC, LOG_DICT_DROPPED, 0, 0, 0, 0 };
+
+	sys_put_le32(cnt, &buf[2]);
+	buffer_write(log_output->func, buf, sizeof(buf),
+		     log_output->control_block->ctx);
+}
+#endif /* CONFIG_LOG_DICTIONARY */
+
 void log_output_msg_process(const struct log_output *log_output,
 			    struct log_msg *msg,
 			    u32_t flags)
@@ -506,6 +695,11 @@ void log_output_msg_process(const struct log_output *log_output,
 	bool raw_string = (level == LOG_LEVEL_INTERNAL_RAW_STRING);
 	int prefix_offset;
 
+#ifdef CONFIG_LOG_DICTIONARY
+	dict_msg_process(log_output, msg);
+	return;
+#endif
+
 	prefix_offset = raw_string ?
 			0 : prefix_print(log_output, flags, std_msg, timestamp,
 					 level, domain_id, source_id);
@@ -614,6 +808,11 @@ void log_output_dropped_process(const struct log_output *log_output, u32_t cnt)
 	log_output_func_t outf = log_output->func;
 	struct device *dev = (struct device *)log_output->control_block->ctx;
 
+#ifdef CONFIG_LOG_DICTIONARY
+	dict_dropped_process(log_output, cnt);
+	return;
+#endif
+
 	cnt = MIN(cnt, 9999);
 	len = snprintf(buf, sizeof(buf), "%d", cnt);
 
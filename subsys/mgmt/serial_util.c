@@ -330,3 +330,134 @@ int mcumgr_serial_tx_pkt(const u8_t *data, int len, mcumgr_serial_tx_cb cb,
 
 	return 0;
 }
+
+#ifdef CONFIG_MCUMGR_SMP_UART_BINARY
+bool mcumgr_serial_bin_rx_byte(struct mcumgr_serial_bin_rx *bin, u8_t byte)
+{
+	u16_t len;
+
+	if (bin->hdr_len == MCUMGR_SERIAL_BIN_HDR_LEN) {
+		if (--bin->rem == 0U) {
+			bin->hdr_len = 0U;
+			return true;
+		}
+		return false;
+	}
+
+	bin->hdr[bin->hdr_len++] = byte;
+
+	switch (bin->hdr_len) {
+	case 1:
+		if (byte != MCUMGR_SERIAL_HDR_BIN_1) {
+			bin->hdr_len = 0U;
+		}
+		break;
+
+	case 2:
+		if (byte != MCUMGR_SERIAL_HDR_BIN_2) {
+			/* Resynchronize on a start byte. */
+			bin->hdr_len = (byte == MCUMGR_SERIAL_HDR_BIN_1);
+		}
+		break;
+
+	case MCUMGR_SERIAL_BIN_HDR_LEN:
+		memcpy(&len, &bin->hdr[2], sizeof(len));
+		bin->rem = sys_be16_to_cpu(len);
+		if (bin->rem < 2U) {
+			/* Not even a CRC. */
+			bin->hdr_len = 0U;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+struct net_buf *mcumgr_serial_process_bin(
+	struct mcumgr_serial_rx_ctxt *rx_ctxt,
+	const u8_t *data, int len, int *out_used)
+{
+	struct mcumgr_serial_bin_rx *bin = &rx_ctxt->bin;
+	struct net_buf *nb;
+	bool body;
+	bool end;
+	int i;
+
+	for (i = 0; i < len; i++) {
+		body = bin->hdr_len == MCUMGR_SERIAL_BIN_HDR_LEN;
+		end = mcumgr_serial_bin_rx_byte(bin, data[i]);
+
+		if (!body) {
+			if (bin->hdr_len == MCUMGR_SERIAL_BIN_HDR_LEN) {
+				/* Start of a frame. */
+				if (rx_ctxt->nb == NULL) {
+					rx_ctxt->nb = mcumgr_buf_alloc();
+				} else {
+					net_buf_reset(rx_ctxt->nb);
+				}
+
+				if (rx_ctxt->nb != NULL &&
+				    bin->rem > net_buf_tailroom(rx_ctxt->nb)) {
+					mcumgr_serial_free_rx_ctxt(rx_ctxt);
+				}
+			}
+			continue;
+		}
+
+		/* Without a buffer, the frame is dropped. */
+		if (rx_ctxt->nb != NULL) {
+			net_buf_add_u8(rx_ctxt->nb, data[i]);
+		}
+
+		if (!end || rx_ctxt->nb == NULL) {
+			continue;
+		}
+
+		if (mcumgr_serial_calc_crc(rx_ctxt->nb->data,
+					   rx_ctxt->nb->len) != 0U) {
+			net_buf_reset(rx_ctxt->nb);
+			continue;
+		}
+
+		/* Packet is complete; strip the CRC. */
+		rx_ctxt->nb->len -= 2U;
+
+		nb = rx_ctxt->nb;
+		rx_ctxt->nb = NULL;
+		*out_used = i + 1;
+		return nb;
+	}
+
+	*out_used = len;
+	return NULL;
+}
+
+int mcumgr_serial_tx_pkt_bin(const u8_t *data, int len,
+			     mcumgr_serial_tx_cb cb, void *arg)
+{
+	u8_t hdr[MCUMGR_SERIAL_BIN_HDR_LEN];
+	u16_t crc;
+	int rc;
+
+	sys_put_be16(MCUMGR_SERIAL_HDR_BIN, &hdr[0]);
+	sys_put_be16(len + 2, &hdr[2]);
+
+	crc = mcumgr_serial_calc_crc(data, len);
+	crc = sys_cpu_to_be16(crc);
+
+	rc = cb(hdr, sizeof(hdr), arg);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = cb(data, len, arg);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return cb(&crc, sizeof(crc), arg);
+}
+#endif /* CONFIG_MCUMGR_SMP_UART_BINARY */
@@ -5,6 +5,8 @@
  */
 
 #include <zephyr.h>
+#include <init.h>
+#include <stats.h>
 #include "net/buf.h"
 #include "mgmt/mgmt.h"
 #include "mgmt/buf.h"
@@ -20,6 +22,36 @@ static mgmt_init_writer_fn zephyr_smp_init_writer;
 static mgmt_free_buf_fn zephyr_smp_free_buf;
 static smp_tx_rsp_fn zephyr_smp_tx_rsp;
 
+#ifdef CONFIG_STATS
+/* Time spent processing requests, for the throughput of the bytes received */
+STATS_SECT_START(smp)
+	STATS_SECT_ENTRY32(reqs)
+	STATS_SECT_ENTRY32(req_bytes)
+	STATS_SECT_ENTRY32(rsp_frags)
+	STATS_SECT_ENTRY32(rsp_bytes)
+	STATS_SECT_ENTRY32(proc_ms)
+	STATS_SECT_ENTRY32(queue_max)
+STATS_SECT_END;
+
+STATS_NAME_START(smp)
+	STATS_NAME(smp, reqs)
+	STATS_NAME(smp, req_bytes)
+	STATS_NAME(smp, rsp_frags)
+	STATS_NAME(smp, rsp_bytes)
+	STATS_NAME(smp, proc_ms)
+	STATS_NAME(smp, queue_max)
+STATS_NAME_END(smp);
+
+static STATS_SECT_DECL(smp) smp_stats;
+static atomic_t smp_queued;
+#endif
+
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+static K_THREAD_STACK_DEFINE(smp_work_q_stack,
+			     CONFIG_MCUMGR_SMP_WORKQUEUE_STACK_SIZE);
+static struct k_work_q smp_work_q;
+#endif
+
 static const struct mgmt_streamer_cfg zephyr_smp_cbor_cfg = {
 	.alloc_rsp = zephyr_smp_alloc_rsp,
 	.trim_front = zephyr_smp_trim_front,
@@ -187,6 +219,9 @@ zephyr_smp_tx_rsp(struct smp_streamer *ns, void *rsp, void *arg)
 			return MGMT_ERR_ENOMEM;
 		}
 
+		STATS_INC(smp_stats, rsp_frags);
+		STATS_INCN(smp_stats, rsp_bytes, frag->len);
+
 		rc = zst->zst_output(zst, frag);
 		if (rc != 0) {
 			return MGMT_ERR_EUNKNOWN;
@@ -274,7 +309,17 @@ zephyr_smp_handle_reqs(struct k_work *work)
 	zst = (void *)work;
 
 	while ((nb = k_fifo_get(&zst->zst_fifo, K_NO_WAIT)) != NULL) {
+#ifdef CONFIG_STATS
+		u32_t start = k_uptime_get_32();
+
+		STATS_INC(smp_stats, reqs);
+		STATS_INCN(smp_stats, req_bytes, nb->len);
+		zephyr_smp_process_packet(zst, nb);
+		STATS_INCN(smp_stats, proc_ms, k_uptime_get_32() - start);
+		atomic_dec(&smp_queued);
+#else
 		zephyr_smp_process_packet(zst, nb);
+#endif
 	}
 }
 
@@ -299,6 +344,35 @@ zephyr_smp_transport_init(struct zephyr_smp_transport *zst,
 void
 zephyr_smp_rx_req(struct zephyr_smp_transport *zst, struct net_buf *nb)
 {
+#ifdef CONFIG_STATS
+	atomic_val_t queued = atomic_inc(&smp_queued) + 1;
+
+	if (queued > smp_stats.queue_max) {
+		smp_stats.queue_max = queued;
+	}
+#endif
+
 	k_fifo_put(&zst->zst_fifo, nb);
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+	k_work_submit_to_queue(&smp_work_q, &zst->zst_work);
+#else
 	k_work_submit(&zst->zst_work);
+#endif
 }
+
+static int zephyr_smp_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+	k_work_q_start(&smp_work_q, smp_work_q_stack,
+		       K_THREAD_STACK_SIZEOF(smp_work_q_stack),
+		       K_PRIO_PREEMPT(CONFIG_MCUMGR_SMP_WORKQUEUE_THREAD_PRIO));
+	k_thread_name_set(&smp_work_q.thread, "smp");
+#endif
+
+	return STATS_INIT_AND_REG(smp_stats, STATS_SIZE_32, "smp");
+}
+
+/* Before the transports, initialized at the application level */
+SYS_INIT(zephyr_smp_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
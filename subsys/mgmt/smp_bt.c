@@ -9,13 +9,17 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include <zephyr.h>
 #include <init.h>
+#include <misc/byteorder.h>
 #include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
 #include <bluetooth/uuid.h>
 #include <bluetooth/gatt.h>
 
+#include <mgmt/mgmt.h>
 #include <mgmt/smp_bt.h>
 #include <mgmt/buf.h>
 
@@ -29,6 +33,13 @@ struct smp_bt_user_data {
 
 static struct zephyr_smp_transport smp_bt_transport;
 
+#ifdef CONFIG_MCUMGR_SMP_BT_REASSEMBLY
+/* Request whose first writes were received, waiting for the next ones */
+static struct net_buf *smp_bt_rx_pending;
+#endif
+
+static void smp_bt_ud_free(void *ud);
+
 /* SMP service.
  * {8D53DC1D-1DB7-4CD3-868B-8A527460AA84}
  */
@@ -43,6 +54,53 @@ static struct bt_uuid_128 smp_bt_chr_uuid = BT_UUID_INIT_128(
 	0x48, 0x7c, 0x99, 0x74, 0x11, 0x26, 0x9e, 0xae,
 	0x01, 0x4e, 0xce, 0xfb, 0x28, 0x78, 0x2e, 0xda);
 
+/**
+ * Frees a request that is not processed.
+ */
+static void smp_bt_rx_drop(struct net_buf *nb)
+{
+	smp_bt_ud_free(net_buf_user_data(nb));
+	mcumgr_buf_free(nb);
+}
+
+#ifdef CONFIG_MCUMGR_SMP_BT_REASSEMBLY
+/**
+ * Calculates the length of the SMP packet at the start of the specified
+ * request, from its header; the header itself until it is complete.
+ */
+static size_t smp_bt_pkt_len(const struct net_buf *nb)
+{
+	struct mgmt_hdr hdr;
+
+	if (nb->len < sizeof(hdr)) {
+		return sizeof(hdr);
+	}
+
+	memcpy(&hdr, nb->data, sizeof(hdr));
+
+	return sizeof(hdr) + sys_be16_to_cpu(hdr.nh_len);
+}
+
+static void smp_bt_disconnected(struct bt_conn *conn, u8_t reason)
+{
+	struct smp_bt_user_data *ud;
+
+	if (smp_bt_rx_pending == NULL) {
+		return;
+	}
+
+	ud = net_buf_user_data(smp_bt_rx_pending);
+	if (ud->conn == conn) {
+		smp_bt_rx_drop(smp_bt_rx_pending);
+		smp_bt_rx_pending = NULL;
+	}
+}
+
+static struct bt_conn_cb smp_bt_conn_cb = {
+	.disconnected = smp_bt_disconnected,
+};
+#endif
+
 /**
  * Write handler for the SMP characteristic; processes an incoming SMP request.
  */
@@ -52,13 +110,46 @@ static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 				u8_t flags)
 {
 	struct smp_bt_user_data *ud;
-	struct net_buf *nb;
+	struct net_buf *nb = NULL;
+
+#ifdef CONFIG_MCUMGR_SMP_BT_REASSEMBLY
+	nb = smp_bt_rx_pending;
+	smp_bt_rx_pending = NULL;
+
+	if (nb != NULL) {
+		ud = net_buf_user_data(nb);
+		if (ud->conn != conn) {
+			/* Left incomplete by another client. */
+			smp_bt_rx_drop(nb);
+			nb = NULL;
+		}
+	}
+#endif
+
+	if (nb == NULL) {
+		nb = mcumgr_buf_alloc();
+		if (nb == NULL) {
+			/* All buffers hold outstanding requests. */
+			return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+		}
+
+		ud = net_buf_user_data(nb);
+		ud->conn = bt_conn_ref(conn);
+	}
+
+	if (len > net_buf_tailroom(nb)) {
+		smp_bt_rx_drop(nb);
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+	}
 
-	nb = mcumgr_buf_alloc();
 	net_buf_add_mem(nb, buf, len);
 
-	ud = net_buf_user_data(nb);
-	ud->conn = bt_conn_ref(conn);
+#ifdef CONFIG_MCUMGR_SMP_BT_REASSEMBLY
+	if (nb->len < smp_bt_pkt_len(nb)) {
+		smp_bt_rx_pending = nb;
+		return len;
+	}
+#endif
 
 	zephyr_smp_rx_req(&smp_bt_transport, nb);
 
@@ -188,6 +279,9 @@ static int smp_bt_init(struct device *dev)
 	zephyr_smp_transport_init(&smp_bt_transport, smp_bt_tx_pkt,
 				  smp_bt_get_mtu, smp_bt_ud_copy,
 				  smp_bt_ud_free);
+#ifdef CONFIG_MCUMGR_SMP_BT_REASSEMBLY
+	bt_conn_cb_register(&smp_bt_conn_cb);
+#endif
 	return 0;
 }
 
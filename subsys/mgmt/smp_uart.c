@@ -35,6 +35,27 @@ static void smp_uart_process_frag(struct uart_mcumgr_rx_buf *rx_buf)
 {
 	struct net_buf *nb;
 
+#ifdef CONFIG_MCUMGR_SMP_UART_BINARY
+	const u8_t *data = rx_buf->data;
+	int len = rx_buf->length;
+	int used;
+
+	/* Append the data to the packet being received, passing each
+	 * complete one to SMP for processing.
+	 */
+	while (len > 0) {
+		nb = mcumgr_serial_process_bin(&smp_uart_rx_ctxt, data, len,
+					       &used);
+		data += used;
+		len -= used;
+
+		if (nb != NULL) {
+			zephyr_smp_rx_req(&smp_uart_transport, nb);
+		}
+	}
+
+	uart_mcumgr_free_rx_buf(rx_buf);
+#else
 	/* Decode the fragment and write the result to the global receive
 	 * context.
 	 */
@@ -50,6 +71,7 @@ static void smp_uart_process_frag(struct uart_mcumgr_rx_buf *rx_buf)
 	if (nb != NULL) {
 		zephyr_smp_rx_req(&smp_uart_transport, nb);
 	}
+#endif
 }
 
 static void smp_uart_process_rx_queue(struct k_work *work)
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief UDP transport for the mcumgr SMP protocol.
+ *
+ * Each request is a datagram, received directly into an mcumgr buffer, and
+ * each response is sent to the address the request came from. A thread
+ * waits for the datagrams of the IPv4 and IPv6 sockets.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr.h>
+#include <init.h>
+#include <net/socket.h>
+#include <net/buf.h>
+#include <mgmt/buf.h>
+#include <mgmt/smp.h>
+
+struct device;
+
+/* The client a request came from and its responses are sent to. */
+struct smp_udp_user_data {
+	struct sockaddr addr;
+	u16_t addrlen;
+};
+
+BUILD_ASSERT_MSG(sizeof(struct smp_udp_user_data) <=
+		 CONFIG_MCUMGR_BUF_USER_DATA_SIZE,
+		 "MCUMGR_BUF_USER_DATA_SIZE too small for a UDP address");
+
+struct smp_udp_sock {
+	struct zephyr_smp_transport zst;
+	int fd;
+};
+
+enum {
+#ifdef CONFIG_MCUMGR_SMP_UDP_IPV4
+	SMP_UDP_IPV4,
+#endif
+#ifdef CONFIG_MCUMGR_SMP_UDP_IPV6
+	SMP_UDP_IPV6,
+#endif
+	SMP_UDP_SOCK_COUNT
+};
+
+static struct smp_udp_sock smp_udp_socks[SMP_UDP_SOCK_COUNT];
+
+static K_THREAD_STACK_DEFINE(smp_udp_stack,
+			     CONFIG_MCUMGR_SMP_UDP_STACK_SIZE);
+static struct k_thread smp_udp_thread;
+
+static u16_t smp_udp_get_mtu(const struct net_buf *nb)
+{
+	ARG_UNUSED(nb);
+
+	return CONFIG_MCUMGR_SMP_UDP_MTU;
+}
+
+static int smp_udp_ud_copy(struct net_buf *dst, const struct net_buf *src)
+{
+	memcpy(net_buf_user_data(dst), net_buf_user_data(src),
+	       sizeof(struct smp_udp_user_data));
+
+	return 0;
+}
+
+static int smp_udp_tx_pkt(struct zephyr_smp_transport *zst,
+			  struct net_buf *nb)
+{
+	struct smp_udp_sock *sock = CONTAINER_OF(zst, struct smp_udp_sock,
+						 zst);
+	struct smp_udp_user_data *ud = net_buf_user_data(nb);
+	ssize_t rc;
+
+	rc = zsock_sendto(sock->fd, nb->data, nb->len, 0, &ud->addr,
+			  ud->addrlen);
+	mcumgr_buf_free(nb);
+
+	return rc < 0 ? -errno : 0;
+}
+
+/**
+ * Receives the next datagram of a socket as a request.
+ */
+static void smp_udp_receive(struct smp_udp_sock *sock)
+{
+	struct smp_udp_user_data *ud;
+	struct msghdr msg;
+	struct iovec iov;
+	struct net_buf *nb;
+	ssize_t len;
+
+	nb = mcumgr_buf_alloc();
+	if (nb == NULL) {
+		/* All buffers hold outstanding requests: leave the datagram
+		 * queued in the socket until one is processed.
+		 */
+		k_sleep(K_MSEC(CONFIG_MCUMGR_SMP_UDP_RETRY_MS));
+		return;
+	}
+
+	ud = net_buf_user_data(nb);
+
+	iov.iov_base = nb->data;
+	iov.iov_len = net_buf_tailroom(nb);
+
+	msg = (struct msghdr) {
+		.msg_name = &ud->addr,
+		.msg_namelen = sizeof(ud->addr),
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+
+	len = zsock_recvmsg(sock->fd, &msg, ZSOCK_MSG_DONTWAIT);
+	if (len <= 0 || (msg.msg_flags & ZSOCK_MSG_TRUNC)) {
+		/* Nothing to read, or a request larger than a buffer. */
+		mcumgr_buf_free(nb);
+		return;
+	}
+
+	ud->addrlen = msg.msg_namelen;
+	net_buf_add(nb, len);
+
+	zephyr_smp_rx_req(&sock->zst, nb);
+}
+
+static void smp_udp_receive_thread(void *p1, void *p2, void *p3)
+{
+	struct zsock_pollfd fds[SMP_UDP_SOCK_COUNT];
+	int i;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < SMP_UDP_SOCK_COUNT; i++) {
+		fds[i].fd = smp_udp_socks[i].fd;
+		fds[i].events = ZSOCK_POLLIN;
+	}
+
+	while (1) {
+		if (zsock_poll(fds, SMP_UDP_SOCK_COUNT, K_FOREVER) < 0) {
+			k_sleep(K_MSEC(CONFIG_MCUMGR_SMP_UDP_RETRY_MS));
+			continue;
+		}
+
+		for (i = 0; i < SMP_UDP_SOCK_COUNT; i++) {
+			if (fds[i].revents & ZSOCK_POLLIN) {
+				smp_udp_receive(&smp_udp_socks[i]);
+			}
+		}
+	}
+}
+
+static int smp_udp_open(struct smp_udp_sock *sock, struct sockaddr *addr,
+			socklen_t addrlen)
+{
+	sock->fd = zsock_socket(addr->sa_family, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock->fd < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(sock->fd, addr, addrlen) < 0) {
+		int rc = -errno;
+
+		(void)zsock_close(sock->fd);
+		return rc;
+	}
+
+	zephyr_smp_transport_init(&sock->zst, smp_udp_tx_pkt,
+				  smp_udp_get_mtu, smp_udp_ud_copy, NULL);
+
+	return 0;
+}
+
+static int smp_udp_init(struct device *dev)
+{
+#ifdef CONFIG_MCUMGR_SMP_UDP_IPV4
+	struct sockaddr_in addr4 = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_MCUMGR_SMP_UDP_PORT),
+		.sin_addr = INADDR_ANY_INIT,
+	};
+#endif
+#ifdef CONFIG_MCUMGR_SMP_UDP_IPV6
+	struct sockaddr_in6 addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(CONFIG_MCUMGR_SMP_UDP_PORT),
+		.sin6_addr = IN6ADDR_ANY_INIT,
+	};
+#endif
+	int rc;
+
+	ARG_UNUSED(dev);
+
+#ifdef CONFIG_MCUMGR_SMP_UDP_IPV4
+	rc = smp_udp_open(&smp_udp_socks[SMP_UDP_IPV4],
+			  (struct sockaddr *)&addr4, sizeof(addr4));
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
+#ifdef CONFIG_MCUMGR_SMP_UDP_IPV6
+	rc = smp_udp_open(&smp_udp_socks[SMP_UDP_IPV6],
+			  (struct sockaddr *)&addr6, sizeof(addr6));
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
+	k_thread_create(&smp_udp_thread, smp_udp_stack,
+			K_THREAD_STACK_SIZEOF(smp_udp_stack),
+			smp_udp_receive_thread, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(CONFIG_MCUMGR_SMP_UDP_THREAD_PRIO), 0,
+			K_NO_WAIT);
+	k_thread_name_set(&smp_udp_thread, "smp_udp");
+
+	return 0;
+}
+
+SYS_INIT(smp_udp_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
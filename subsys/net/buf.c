@@ -20,6 +20,10 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #include <net/buf.h>
 
+#if defined(CONFIG_NET_BUF_DMA_LINEARIZE)
+#include <dma.h>
+#endif
+
 #if defined(CONFIG_NET_BUF_LOG)
 #define NET_BUF_DBG(fmt, ...) LOG_DBG("(%p) " fmt, k_current_get(), \
 				      ##__VA_ARGS__)
@@ -76,6 +80,63 @@ static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 	return buf;
 }
 
+#if defined(CONFIG_NET_BUF_POOL_GROUP)
+void net_buf_pool_join(struct net_buf_pool *pool,
+		       struct net_buf_pool *sibling, u16_t reserve)
+{
+	NET_BUF_ASSERT(!pool->group_next && pool != sibling);
+
+	pool->reserve = reserve;
+
+	if (!sibling->group_next) {
+		sibling->group_next = sibling;
+	}
+
+	pool->group_next = sibling->group_next;
+	sibling->group_next = pool;
+}
+
+/* Take a free buffer of another pool of the group without waiting */
+static struct net_buf *pool_borrow(struct net_buf_pool *pool)
+{
+	struct net_buf_pool *lender;
+	struct net_buf *buf = NULL;
+	u16_t uninit_count;
+	unsigned int key;
+
+	for (lender = pool->group_next; lender && lender != pool;
+	     lender = lender->group_next) {
+		key = irq_lock();
+
+		if (lender->avail_count <= lender->reserve) {
+			irq_unlock(key);
+			continue;
+		}
+
+		buf = k_lifo_get(&lender->free, K_NO_WAIT);
+		if (!buf && lender->uninit_count) {
+			uninit_count = lender->uninit_count--;
+			buf = pool_get_uninit(lender, uninit_count);
+		}
+
+		if (buf) {
+			lender->lent++;
+			pool->borrowed++;
+		}
+
+		irq_unlock(key);
+
+		if (buf) {
+			NET_BUF_DBG("buf %p borrowed from pool %s", buf,
+				    lender->name);
+			break;
+		}
+	}
+
+	return buf;
+}
+#endif /* CONFIG_NET_BUF_POOL_GROUP */
+
 void net_buf_reset(struct net_buf *buf)
 {
 	NET_BUF_ASSERT(buf->flags == 0U);
@@ -275,6 +336,19 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	irq_unlock(key);
 
+#if defined(CONFIG_NET_BUF_POOL_GROUP)
+	if (pool->group_next) {
+		buf = k_lifo_get(&pool->free, K_NO_WAIT);
+		if (!buf) {
+			buf = pool_borrow(pool);
+		}
+
+		if (buf) {
+			goto success;
+		}
+	}
+#endif
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (timeout == K_FOREVER) {
 		u32_t ref = k_uptime_get_32();
@@ -306,6 +380,9 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #endif
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+		pool->alloc_failures++;
+#endif
 		return NULL;
 	}
 
@@ -324,6 +401,9 @@ success:
 			NET_BUF_ERR("%s():%d: Failed to allocate data",
 				    func, line);
 			net_buf_destroy(buf);
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+			pool->alloc_failures++;
+#endif
 			return NULL;
 		}
 	} else {
@@ -337,7 +417,16 @@ success:
 	net_buf_reset(buf);
 
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
+	/* The buffer may have been borrowed from another pool */
+	pool = net_buf_pool_get(buf->pool_id);
+
+	key = irq_lock();
 	pool->avail_count--;
+	if (pool->avail_count < pool->min_avail_count) {
+		pool->min_avail_count = pool->avail_count;
+	}
+	irq_unlock(key);
+
 	NET_BUF_ASSERT(pool->avail_count >= 0);
 #endif
 
@@ -674,6 +763,32 @@ struct net_buf *net_buf_frag_del(struct net_buf *parent, struct net_buf *frag)
 	return next_frag;
 }
 
+#if defined(CONFIG_NET_BUF_DMA_LINEARIZE)
+static void linearize_copy(void *dst, const void *src, size_t len)
+{
+	static struct device *dma;
+
+	if (len >= CONFIG_NET_BUF_DMA_LINEARIZE_THRESHOLD && !k_is_in_isr()) {
+		if (!dma) {
+			dma = device_get_binding(
+				CONFIG_NET_BUF_DMA_LINEARIZE_DEV_NAME);
+		}
+
+		/* fall back to the CPU when no channel is free */
+		if (dma && !dma_memcpy(dma, dst, src, len)) {
+			return;
+		}
+	}
+
+	memcpy(dst, src, len);
+}
+#else
+static inline void linearize_copy(void *dst, const void *src, size_t len)
+{
+	memcpy(dst, src, len);
+}
+#endif
+
 size_t net_buf_linearize(void *dst, size_t dst_len, struct net_buf *src,
 			 size_t offset, size_t len)
 {
@@ -695,7 +810,8 @@ size_t net_buf_linearize(void *dst, size_t dst_len, struct net_buf *src,
 	copied = 0;
 	while (frag && len > 0) {
 		to_copy = MIN(len, frag->len - offset);
-		memcpy((u8_t *)dst + copied, frag->data + offset, to_copy);
+		linearize_copy((u8_t *)dst + copied, frag->data + offset,
+			       to_copy);
 
 		copied += to_copy;
 
@@ -45,6 +45,44 @@ static inline u8_t get_6co_cid(struct net_icmpv6_nd_opt_6co *opt)
 static struct net_6lo_context ctx_6co[CONFIG_NET_MAX_6LO_CONTEXTS];
 #endif
 
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+/* Longest IPHC header the cache keeps: 2 bytes of IPHC, CID, 4 bytes of
+ * TF, NH, HLIM, both addresses inline, UDP NHC and both ports inline.
+ * The UDP checksum which follows changes with every packet.
+ */
+#define NET_6LO_TMPL_LEN (2 + 1 + 4 + 1 + 1 + 16 + 16 + 1 + 4)
+
+#define NET_6LO_TMPL_LLADDR_LEN 8
+
+/* Compressed header of a flow */
+struct net_6lo_tmpl {
+	struct net_if *iface;
+
+	/* IPv6 header of the flow, with the payload length cleared */
+	struct net_ipv6_hdr ipv6;
+	u16_t src_port;
+	u16_t dst_port;
+
+	u8_t lladdr_src[NET_6LO_TMPL_LLADDR_LEN];
+	u8_t lladdr_dst[NET_6LO_TMPL_LLADDR_LEN];
+	u8_t lladdr_src_len;
+	u8_t lladdr_dst_len;
+
+	/* The entry is valid if it matches tmpl_gen */
+	u32_t gen;
+	u32_t last_used;
+
+	u8_t len;
+	u8_t iphc[NET_6LO_TMPL_LEN];
+};
+
+static struct net_6lo_tmpl tmpl_cache[CONFIG_NET_6LO_COMPRESS_CACHE_SIZE];
+
+/* Bumped on 6CO changes, dropping all the templates at once */
+static u32_t tmpl_gen = 1U;
+static u32_t tmpl_stamp;
+#endif
+
 /* TODO: Unicast-Prefix based IPv6 Multicast(dst) address compression
  *       Mesh header compression
  */
@@ -107,6 +145,11 @@ void net_6lo_set_context(struct net_if *iface,
 	int unused = -1;
 	u8_t i;
 
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+	/* Compressed headers may depend on the context */
+	tmpl_gen++;
+#endif
+
 	/* If the context information already exists, update or remove
 	 * as per data.
 	 */
@@ -666,6 +709,127 @@ static inline bool is_src_and_dst_addr_ctx_based(struct net_ipv6_hdr *ipv6,
 
 #endif
 
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+static bool tmpl_lladdr_fits(struct net_linkaddr *lladdr)
+{
+	return !lladdr->addr || lladdr->len <= NET_6LO_TMPL_LLADDR_LEN;
+}
+
+static bool tmpl_lladdr_match(struct net_linkaddr *lladdr,
+			      const u8_t *addr, u8_t len)
+{
+	if (!lladdr->addr) {
+		return !len;
+	}
+
+	return lladdr->len == len && !memcmp(lladdr->addr, addr, len);
+}
+
+static void tmpl_lladdr_copy(struct net_linkaddr *lladdr, u8_t *addr,
+			     u8_t *len)
+{
+	*len = lladdr->addr ? lladdr->len : 0U;
+	memcpy(addr, lladdr->addr, *len);
+}
+
+static bool tmpl_match(struct net_6lo_tmpl *tmpl, struct net_pkt *pkt,
+		       struct net_ipv6_hdr *ipv6, struct net_udp_hdr *udp)
+{
+	if (tmpl->gen != tmpl_gen || tmpl->iface != net_pkt_iface(pkt)) {
+		return false;
+	}
+
+	/* Everything but the payload length decides the compression */
+	if (memcmp(&tmpl->ipv6, ipv6, offsetof(struct net_ipv6_hdr, len)) ||
+	    memcmp(&tmpl->ipv6.nexthdr, &ipv6->nexthdr,
+		   NET_IPV6H_LEN - offsetof(struct net_ipv6_hdr, nexthdr))) {
+		return false;
+	}
+
+	if (udp && (tmpl->src_port != udp->src_port ||
+		    tmpl->dst_port != udp->dst_port)) {
+		return false;
+	}
+
+	return tmpl_lladdr_match(net_pkt_lladdr_src(pkt), tmpl->lladdr_src,
+				 tmpl->lladdr_src_len) &&
+		tmpl_lladdr_match(net_pkt_lladdr_dst(pkt), tmpl->lladdr_dst,
+				  tmpl->lladdr_dst_len);
+}
+
+/* Copy the compressed header of the flow of the packet, if cached */
+static u8_t tmpl_apply(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+		       struct net_udp_hdr *udp, struct net_buf *frag)
+{
+	unsigned int key;
+	u8_t len = 0U;
+	int i;
+
+	key = irq_lock();
+
+	for (i = 0; i < CONFIG_NET_6LO_COMPRESS_CACHE_SIZE; i++) {
+		if (tmpl_match(&tmpl_cache[i], pkt, ipv6, udp)) {
+			tmpl_cache[i].last_used = ++tmpl_stamp;
+			len = tmpl_cache[i].len;
+			memcpy(IPHC, tmpl_cache[i].iphc, len);
+			break;
+		}
+	}
+
+	irq_unlock(key);
+
+	return len;
+}
+
+/* Keep the compressed header, in the least recently used entry */
+static void tmpl_store(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+		       struct net_udp_hdr *udp, struct net_buf *frag, u8_t len)
+{
+	struct net_6lo_tmpl *tmpl = &tmpl_cache[0];
+	unsigned int key;
+	int i;
+
+	if (len > NET_6LO_TMPL_LEN ||
+	    !tmpl_lladdr_fits(net_pkt_lladdr_src(pkt)) ||
+	    !tmpl_lladdr_fits(net_pkt_lladdr_dst(pkt))) {
+		return;
+	}
+
+	key = irq_lock();
+
+	for (i = 0; i < CONFIG_NET_6LO_COMPRESS_CACHE_SIZE; i++) {
+		if (tmpl_cache[i].gen != tmpl_gen) {
+			tmpl = &tmpl_cache[i];
+			break;
+		}
+
+		if (tmpl_cache[i].last_used < tmpl->last_used) {
+			tmpl = &tmpl_cache[i];
+		}
+	}
+
+	tmpl->gen = tmpl_gen;
+	tmpl->last_used = ++tmpl_stamp;
+	tmpl->iface = net_pkt_iface(pkt);
+
+	memcpy(&tmpl->ipv6, ipv6, NET_IPV6H_LEN);
+	tmpl->ipv6.len = 0U;
+
+	tmpl->src_port = udp ? udp->src_port : 0U;
+	tmpl->dst_port = udp ? udp->dst_port : 0U;
+
+	tmpl_lladdr_copy(net_pkt_lladdr_src(pkt), tmpl->lladdr_src,
+			 &tmpl->lladdr_src_len);
+	tmpl_lladdr_copy(net_pkt_lladdr_dst(pkt), tmpl->lladdr_dst,
+			 &tmpl->lladdr_dst_len);
+
+	tmpl->len = len;
+	memcpy(tmpl->iphc, IPHC, len);
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0 */
+
 /* RFC 6282 LOWPAN IPHC Encoding format (3.1)
  *  Base Format
  *   0                                       1
@@ -681,6 +845,7 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 	struct net_6lo_context *dst = NULL;
 #endif
 	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
+	struct net_udp_hdr hdr, *udp = NULL;
 	u8_t offset = 0U;
 	struct net_buf *frag;
 	u8_t compressed;
@@ -703,6 +868,33 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 		return -ENOBUFS;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_UDP) && ipv6->nexthdr == IPPROTO_UDP) {
+		udp = net_udp_get_hdr(pkt, &hdr);
+		if (!udp) {
+			NET_ERR("could not get UDP header");
+			net_pkt_frag_unref(frag);
+			return -EINVAL;
+		}
+	}
+
+	compressed = NET_IPV6H_LEN;
+
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+	offset = tmpl_apply(pkt, ipv6, udp, frag);
+	if (offset) {
+		NET_DBG("Compressed header of the flow cached");
+
+		if (udp) {
+			memcpy(&IPHC[offset], &udp->chksum, 2);
+			offset += 2U;
+
+			compressed += NET_UDPH_LEN;
+		}
+
+		goto end;
+	}
+#endif
+
 	IPHC[offset++] = NET_6LO_DISPATCH_IPHC;
 	IPHC[offset++] = 0;
 
@@ -744,29 +936,25 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 		return -EFAULT;
 	}
 
-	compressed = NET_IPV6H_LEN;
-
 	if (ipv6->nexthdr != IPPROTO_UDP) {
 		NET_DBG("next header is not UDP (%u)", ipv6->nexthdr);
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+		tmpl_store(pkt, ipv6, NULL, frag, offset);
+#endif
 		goto end;
 	}
 
 	/* UDP header compression */
-	if (IS_ENABLED(CONFIG_NET_UDP)) {
-		struct net_udp_hdr hdr, *udp;
-
-		udp = net_udp_get_hdr(pkt, &hdr);
-		if (!udp) {
-			NET_ERR("could not get UDP header");
-			return -EINVAL;
-		}
-
+	if (udp) {
 		IPHC[offset] = NET_6LO_NHC_UDP_BARE;
 		offset = compress_nh_udp(udp, frag, offset);
 
 		compressed += NET_UDPH_LEN;
 
-		net_udp_set_hdr(pkt, udp);
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+		/* The checksum, last, is not part of the template */
+		tmpl_store(pkt, ipv6, udp, frag, offset - 2U);
+#endif
 	}
 
 end:
@@ -51,11 +51,19 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Both addresses and both ports specified, the highest rank */
+#define NET_CONN_FULLY_SPEC		0x78
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
+
+/* Connections with a wildcard, searched in order */
 static sys_slist_t conn_used;
 
+/* Fully specified UDP and TCP connections, by hash of their tuple */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -124,11 +132,81 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+/* FNV-1a */
+static u32_t conn_hash_add(u32_t hash, const void *data, size_t len)
+{
+	const u8_t *ptr = data;
+
+	while (len--) {
+		hash = (hash ^ *ptr++) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Ports are in network byte order */
+static sys_slist_t *conn_bucket(u16_t proto, sa_family_t family,
+				const void *remote_addr,
+				const void *local_addr,
+				u16_t remote_port, u16_t local_port)
+{
+	size_t addr_len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					       sizeof(struct in_addr);
+	u32_t hash = 2166136261U;
+
+	hash = conn_hash_add(hash, &proto, sizeof(proto));
+	hash = conn_hash_add(hash, remote_addr, addr_len);
+	hash = conn_hash_add(hash, local_addr, addr_len);
+	hash = conn_hash_add(hash, &remote_port, sizeof(remote_port));
+	hash = conn_hash_add(hash, &local_port, sizeof(local_port));
+
+	return &conn_hash[hash % CONFIG_NET_CONN_HASH_SIZE];
+}
+
+static bool conn_is_hashed(struct net_conn *conn)
+{
+	if (!(IS_ENABLED(CONFIG_NET_UDP) && conn->proto == IPPROTO_UDP) &&
+	    !(IS_ENABLED(CONFIG_NET_TCP) && conn->proto == IPPROTO_TCP)) {
+		return false;
+	}
+
+	if (NET_CONN_RANK(conn->flags) != NET_CONN_FULLY_SPEC) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->family == AF_INET6) {
+		return true;
+	}
+
+	return IS_ENABLED(CONFIG_NET_IPV4) && conn->family == AF_INET;
+}
+
+static sys_slist_t *conn_list(struct net_conn *conn)
+{
+	if (!conn_is_hashed(conn)) {
+		return &conn_used;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->family == AF_INET6) {
+		return conn_bucket(conn->proto, AF_INET6,
+				   &net_sin6(&conn->remote_addr)->sin6_addr,
+				   &net_sin6(&conn->local_addr)->sin6_addr,
+				   net_sin6(&conn->remote_addr)->sin6_port,
+				   net_sin6(&conn->local_addr)->sin6_port);
+	}
+
+	return conn_bucket(conn->proto, AF_INET,
+			   &net_sin(&conn->remote_addr)->sin_addr,
+			   &net_sin(&conn->local_addr)->sin_addr,
+			   net_sin(&conn->remote_addr)->sin_port,
+			   net_sin(&conn->local_addr)->sin_port);
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
 
-	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_list(conn), &conn->node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -146,8 +224,16 @@ static struct net_conn *conn_find_handler(u16_t proto, u8_t family,
 					  u16_t local_port)
 {
 	struct net_conn *conn;
+	int i;
+
+	/* Not on the data path, just check them all */
+	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
+		conn = &conns[i];
+
+		if (!(conn->flags & NET_CONN_IN_USE)) {
+			continue;
+		}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -365,7 +451,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	NET_DBG("Connection handler %p removed", conn);
 
-	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_list(conn), &conn->node);
 
 	conn_set_unused(conn);
 
@@ -445,6 +531,60 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+/* A fully specified connection has the highest rank, the wildcard
+ * connections need not be searched when one matches.
+ */
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 u8_t proto,
+					 u16_t src_port,
+					 u16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *conn;
+	sys_slist_t *bucket;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		bucket = conn_bucket(proto, family, &ip_hdr->ipv6->src,
+				     &ip_hdr->ipv6->dst, src_port, dst_port);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		bucket = conn_bucket(proto, family, &ip_hdr->ipv4->src,
+				     &ip_hdr->ipv4->dst, src_port, dst_port);
+	} else {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, node) {
+		if (conn->proto != proto || conn->family != family ||
+		    net_sin(&conn->remote_addr)->sin_port != src_port ||
+		    net_sin(&conn->local_addr)->sin_port != dst_port) {
+			continue;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+			if (net_ipv6_addr_cmp(
+				    &net_sin6(&conn->remote_addr)->sin6_addr,
+				    &ip_hdr->ipv6->src) &&
+			    net_ipv6_addr_cmp(
+				    &net_sin6(&conn->local_addr)->sin6_addr,
+				    &ip_hdr->ipv6->dst)) {
+				return conn;
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV4)) {
+			if (net_ipv4_addr_cmp(
+				    &net_sin(&conn->remote_addr)->sin_addr,
+				    &ip_hdr->ipv4->src) &&
+			    net_ipv4_addr_cmp(
+				    &net_sin(&conn->local_addr)->sin_addr,
+				    &ip_hdr->ipv4->dst)) {
+				return conn;
+			}
+		}
+	}
+
+	return NULL;
+}
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
@@ -542,6 +682,15 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		" family %d", net_proto2str(net_pkt_family(pkt), proto), pkt,
 		ntohs(src_port), ntohs(dst_port), net_pkt_family(pkt));
 
+	if ((IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+	    (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP)) {
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto, src_port,
+					      dst_port);
+		if (best_match) {
+			goto found;
+		}
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		if (conn->proto != proto) {
 			continue;
@@ -604,6 +753,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+found:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -652,10 +802,17 @@ drop:
 void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 {
 	struct net_conn *conn;
+	int i;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		cb(conn, user_data);
 	}
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_hash[i], conn, node) {
+			cb(conn, user_data);
+		}
+	}
 }
 
 void net_conn_init(void)
@@ -665,6 +822,10 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+	for (i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -29,6 +29,10 @@ LOG_MODULE_REGISTER(net_dhcpv4, CONFIG_NET_DHCPV4_LOG_LEVEL);
 #include "dhcpv4.h"
 #include "ipv4.h"
 
+#if defined(CONFIG_NET_DHCPV4_LEASE_CACHE)
+#include <settings/settings.h>
+#endif
+
 #define PKT_WAIT_TIME K_SECONDS(1)
 
 static sys_slist_t dhcpv4_ifaces;
@@ -117,6 +121,17 @@ static bool dhcpv4_add_req_ipaddr(struct net_pkt *pkt,
 					      4, addr->s4_addr);
 }
 
+/* RFC 4039, the option has no value */
+static bool dhcpv4_add_rapid_commit(struct net_pkt *pkt)
+{
+	if (net_pkt_write_u8(pkt, DHCPV4_OPTIONS_RAPID_COMMIT) ||
+	    net_pkt_write_u8(pkt, 0)) {
+		return false;
+	}
+
+	return true;
+}
+
 /* Add DHCPv4 Options end, rest of the message can be padded wit zeros */
 static inline bool dhcpv4_add_end(struct net_pkt *pkt)
 {
@@ -176,6 +191,10 @@ static struct net_pkt *dhcpv4_create_message(struct net_if *iface, u8_t type,
 
 	if (type == DHCPV4_MSG_TYPE_DISCOVER) {
 		size +=  DHCPV4_OLV_MSG_REQ_LIST;
+
+		if (IS_ENABLED(CONFIG_NET_DHCPV4_RAPID_COMMIT)) {
+			size += DHCPV4_OLV_MSG_RAPID_COMMIT;
+		}
 	}
 
 	pkt = net_pkt_alloc_with_buffer(iface, size, AF_INET,
@@ -232,6 +251,12 @@ static struct net_pkt *dhcpv4_create_message(struct net_if *iface, u8_t type,
 		goto fail;
 	}
 
+	if (type == DHCPV4_MSG_TYPE_DISCOVER &&
+	    IS_ENABLED(CONFIG_NET_DHCPV4_RAPID_COMMIT) &&
+	    !dhcpv4_add_rapid_commit(pkt)) {
+		goto fail;
+	}
+
 	if (!dhcpv4_add_end(pkt)) {
 		goto fail;
 	}
@@ -275,6 +300,12 @@ static u32_t dhcpv4_send_request(struct net_if *iface)
 		with_server_id = true;
 		with_requested_ip = true;
 		break;
+	case NET_DHCPV4_REBOOTING:
+		/* RFC2131 4.3.2 Client MUST NOT include server
+		 * identifier, and the ciaddr field is zero.
+		 */
+		with_requested_ip = true;
+		break;
 	case NET_DHCPV4_RENEWING:
 		/* Since we have an address populate the ciaddr field.
 		 */
@@ -511,6 +542,7 @@ static u32_t dhcph4_manage_timers(struct net_if *iface, s64_t timeout)
 		/* Failed to get OFFER message, send DISCOVER again */
 		return dhcpv4_send_discover(iface);
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 		/* Maximum number of renewal attempts failed, so start
 		 * from the beginning.
 		 */
@@ -587,7 +619,8 @@ static void dhcpv4_timeout(struct k_work *work)
  */
 static bool dhcpv4_parse_options(struct net_pkt *pkt,
 				 struct net_if *iface,
-				 enum dhcpv4_msg_type *msg_type)
+				 enum dhcpv4_msg_type *msg_type,
+				 bool *rapid_commit)
 {
 	u8_t cookie[4];
 	u8_t length;
@@ -778,6 +811,14 @@ static bool dhcpv4_parse_options(struct net_pkt *pkt,
 
 			break;
 		}
+		case DHCPV4_OPTIONS_RAPID_COMMIT:
+			if (length != 0U) {
+				NET_DBG("options_rapid_commit, bad length");
+				return false;
+			}
+
+			*rapid_commit = true;
+			break;
 		default:
 			NET_DBG("option unknown: %d", type);
 
@@ -794,12 +835,124 @@ static bool dhcpv4_parse_options(struct net_pkt *pkt,
 	return false;
 }
 
+#if defined(CONFIG_NET_DHCPV4_LEASE_CACHE)
+/* Saved as "dhcpv4/<iface index>", for the link address it was leased to */
+struct dhcpv4_lease {
+	u8_t lladdr[NET_LINK_ADDR_MAX_LENGTH];
+	u8_t lladdr_len;
+	struct in_addr addr;
+} __packed;
+
+/* Interface whose lease is being loaded */
+static struct net_if *lease_load_iface;
+
+static void dhcpv4_lease_name(struct net_if *iface, char *name, size_t size)
+{
+	snprintk(name, size, "dhcpv4/%d", net_if_get_by_iface(iface));
+}
+
+static int dhcpv4_lease_set(int argc, char **argv, size_t len,
+			    settings_read_cb read_cb, void *cb_arg)
+{
+	struct net_if *iface = lease_load_iface;
+	struct net_linkaddr *lladdr;
+	struct dhcpv4_lease lease;
+	char index[4];
+
+	if (!iface || argc != 1) {
+		return 0;
+	}
+
+	snprintk(index, sizeof(index), "%d", net_if_get_by_iface(iface));
+	if (strcmp(argv[0], index)) {
+		return 0;
+	}
+
+	if (len != sizeof(lease) ||
+	    read_cb(cb_arg, &lease, sizeof(lease)) != sizeof(lease)) {
+		NET_DBG("Invalid saved lease");
+		return -EINVAL;
+	}
+
+	lladdr = net_if_get_link_addr(iface);
+	if (lease.lladdr_len != lladdr->len ||
+	    memcmp(lease.lladdr, lladdr->addr, lladdr->len)) {
+		NET_DBG("Saved lease of another link address");
+		return 0;
+	}
+
+	net_ipaddr_copy(&iface->config.dhcpv4.requested_ip, &lease.addr);
+
+	return 0;
+}
+
+static struct settings_handler dhcpv4_settings = {
+	.name = "dhcpv4",
+	.h_set = dhcpv4_lease_set,
+};
+
+/* Set the requested address to the saved one, if any */
+static bool dhcpv4_lease_load(struct net_if *iface)
+{
+	static bool registered;
+
+	if (!registered) {
+		if (settings_subsys_init() ||
+		    settings_register(&dhcpv4_settings)) {
+			NET_ERR("Cannot register saved leases");
+			return false;
+		}
+
+		registered = true;
+	}
+
+	lease_load_iface = iface;
+	(void)settings_load_subtree(dhcpv4_settings.name);
+	lease_load_iface = NULL;
+
+	return !net_ipv4_is_addr_unspecified(
+		&iface->config.dhcpv4.requested_ip);
+}
+
+static void dhcpv4_lease_save(struct net_if *iface)
+{
+	struct net_linkaddr *lladdr = net_if_get_link_addr(iface);
+	struct dhcpv4_lease lease = {
+		.lladdr_len = lladdr->len,
+	};
+	char name[sizeof("dhcpv4/255")];
+
+	memcpy(lease.lladdr, lladdr->addr, lladdr->len);
+	net_ipaddr_copy(&lease.addr, &iface->config.dhcpv4.requested_ip);
+
+	dhcpv4_lease_name(iface, name, sizeof(name));
+	if (settings_save_one(name, &lease, sizeof(lease))) {
+		NET_DBG("Cannot save lease");
+	}
+}
+
+static void dhcpv4_lease_delete(struct net_if *iface)
+{
+	char name[sizeof("dhcpv4/255")];
+
+	dhcpv4_lease_name(iface, name, sizeof(name));
+	if (settings_delete(name)) {
+		NET_DBG("Cannot delete saved lease");
+	}
+}
+#else
+#define dhcpv4_lease_load(...) false
+#define dhcpv4_lease_save(...)
+#define dhcpv4_lease_delete(...)
+#endif /* CONFIG_NET_DHCPV4_LEASE_CACHE */
+
 static inline void dhcpv4_handle_msg_offer(struct net_if *iface)
 {
 	switch (iface->config.dhcpv4.state) {
 	case NET_DHCPV4_DISABLED:
 	case NET_DHCPV4_INIT:
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 	case NET_DHCPV4_RENEWING:
 	case NET_DHCPV4_REBINDING:
 	case NET_DHCPV4_BOUND:
@@ -810,15 +963,23 @@ static inline void dhcpv4_handle_msg_offer(struct net_if *iface)
 	}
 }
 
-static void dhcpv4_handle_msg_ack(struct net_if *iface)
+static void dhcpv4_handle_msg_ack(struct net_if *iface, bool rapid_commit)
 {
 	switch (iface->config.dhcpv4.state) {
 	case NET_DHCPV4_DISABLED:
 	case NET_DHCPV4_INIT:
-	case NET_DHCPV4_SELECTING:
 	case NET_DHCPV4_BOUND:
 		break;
+	case NET_DHCPV4_SELECTING:
+		/* RFC 4039, a server committed the address right away */
+		if (!IS_ENABLED(CONFIG_NET_DHCPV4_RAPID_COMMIT) ||
+		    !rapid_commit) {
+			break;
+		}
+
+		/* Fall through */
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 		NET_INFO("Received: %s",
 			 log_strdup(net_sprint_ipv4_addr(
 					 &iface->config.dhcpv4.requested_ip)));
@@ -831,6 +992,7 @@ static void dhcpv4_handle_msg_ack(struct net_if *iface)
 			return;
 		}
 
+		dhcpv4_lease_save(iface);
 		dhcpv4_enter_bound(iface);
 		break;
 
@@ -858,11 +1020,24 @@ static void dhcpv4_handle_msg_nak(struct net_if *iface)
 		/* Restart the configuration process. */
 		dhcpv4_enter_selecting(iface);
 		break;
+	case NET_DHCPV4_REBOOTING:
+		/* The saved lease is no longer valid, restart the
+		 * configuration process without waiting for the
+		 * request to time out, as in the event handler.
+		 */
+		dhcpv4_lease_delete(iface);
+		dhcpv4_enter_selecting(iface);
+
+		iface->config.dhcpv4.timer_start = k_uptime_get() - 1;
+		iface->config.dhcpv4.request_time = 0U;
+		dhcpv4_update_timeout_work(0U);
+		break;
 	}
 }
 
 static void dhcpv4_handle_reply(struct net_if *iface,
-				enum dhcpv4_msg_type msg_type)
+				enum dhcpv4_msg_type msg_type,
+				bool rapid_commit)
 {
 	NET_DBG("state=%s msg=%s",
 		net_dhcpv4_state_name(iface->config.dhcpv4.state),
@@ -873,7 +1048,7 @@ static void dhcpv4_handle_reply(struct net_if *iface,
 		dhcpv4_handle_msg_offer(iface);
 		break;
 	case DHCPV4_MSG_TYPE_ACK:
-		dhcpv4_handle_msg_ack(iface);
+		dhcpv4_handle_msg_ack(iface, rapid_commit);
 		break;
 	case DHCPV4_MSG_TYPE_NAK:
 		dhcpv4_handle_msg_nak(iface);
@@ -892,6 +1067,7 @@ static enum net_verdict net_dhcpv4_input(struct net_conn *conn,
 {
 	NET_PKT_DATA_ACCESS_DEFINE(dhcp_access, struct dhcp_msg);
 	enum dhcpv4_msg_type msg_type = 0;
+	bool rapid_commit = false;
 	struct dhcp_msg *msg;
 	struct net_if *iface;
 
@@ -966,13 +1142,13 @@ static enum net_verdict net_dhcpv4_input(struct net_conn *conn,
 		return NET_DROP;
 	}
 
-	if (!dhcpv4_parse_options(pkt, iface, &msg_type)) {
+	if (!dhcpv4_parse_options(pkt, iface, &msg_type, &rapid_commit)) {
 		return NET_DROP;
 	}
 
 	net_pkt_unref(pkt);
 
-	dhcpv4_handle_reply(iface, msg_type);
+	dhcpv4_handle_reply(iface, msg_type, rapid_commit);
 
 	return NET_OK;
 }
@@ -1024,6 +1200,7 @@ const char *net_dhcpv4_state_name(enum net_dhcpv4_state state)
 		"init",
 		"selecting",
 		"requesting",
+		"rebooting",
 		"renewing",
 		"rebinding",
 		"bound",
@@ -1064,14 +1241,29 @@ void net_dhcpv4_start(struct net_if *iface)
 		iface->config.dhcpv4.xid = entropy;
 
 
-		/* RFC2131 4.1.1 requires we wait a random period
-		 * between 1 and 10 seconds before sending the initial
-		 * discover.
-		 */
-		timeout = entropy %
-				(CONFIG_NET_DHCPV4_INITIAL_DELAY_MAX -
-				  DHCPV4_INITIAL_DELAY_MIN) +
-				DHCPV4_INITIAL_DELAY_MIN;
+		if (dhcpv4_lease_load(iface)) {
+			/* RFC2131 4.4.2, request the previous address
+			 * right away, the random delay of 4.4.1 only
+			 * applies to the initial discover.
+			 */
+			iface->config.dhcpv4.state = NET_DHCPV4_REBOOTING;
+			NET_DBG("iface %p state=%s requested-ip=%s", iface,
+				net_dhcpv4_state_name(
+					iface->config.dhcpv4.state),
+				log_strdup(net_sprint_ipv4_addr(
+					&iface->config.dhcpv4.requested_ip)));
+
+			timeout = 0U;
+		} else {
+			/* RFC2131 4.1.1 requires we wait a random period
+			 * between 1 and 10 seconds before sending the
+			 * initial discover.
+			 */
+			timeout = entropy %
+					(CONFIG_NET_DHCPV4_INITIAL_DELAY_MAX -
+					 DHCPV4_INITIAL_DELAY_MIN) +
+					DHCPV4_INITIAL_DELAY_MIN;
+		}
 
 		NET_DBG("wait timeout=%us", timeout);
 
@@ -1091,6 +1283,7 @@ void net_dhcpv4_start(struct net_if *iface)
 	case NET_DHCPV4_INIT:
 	case NET_DHCPV4_SELECTING:
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 	case NET_DHCPV4_RENEWING:
 	case NET_DHCPV4_REBINDING:
 	case NET_DHCPV4_BOUND:
@@ -1115,6 +1308,7 @@ void net_dhcpv4_stop(struct net_if *iface)
 	case NET_DHCPV4_INIT:
 	case NET_DHCPV4_SELECTING:
 	case NET_DHCPV4_REQUESTING:
+	case NET_DHCPV4_REBOOTING:
 	case NET_DHCPV4_REBINDING:
 		iface->config.dhcpv4.state = NET_DHCPV4_DISABLED;
 		NET_DBG("state=%s",
@@ -76,6 +76,7 @@ enum dhcpv4_msg_type {
 #define DHCPV4_OPTIONS_REQ_LIST		55
 #define DHCPV4_OPTIONS_RENEWAL		58
 #define DHCPV4_OPTIONS_REBINDING	59
+#define DHCPV4_OPTIONS_RAPID_COMMIT	80
 #define DHCPV4_OPTIONS_END		255
 
 /* Useful size macros */
@@ -83,6 +84,7 @@ enum dhcpv4_msg_type {
 #define DHCPV4_OLV_MSG_TYPE_SIZE	3
 #define DHCPV4_OLV_MSG_SERVER_ID	6
 #define DHCPV4_OLV_MSG_REQ_LIST		5
+#define DHCPV4_OLV_MSG_RAPID_COMMIT	2
 
 #define DHCPV4_OLV_END_SIZE		1
 
@@ -126,7 +126,14 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 
 	net_stats_update_ipv4_recv(net_pkt_iface(pkt));
 
-	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	net_pkt_hdr_cache_set(pkt);
+
+	hdr = net_pkt_hdr_cache_get(pkt, 0, sizeof(struct net_ipv4_hdr));
+	if (!hdr) {
+		hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt,
+							      &ipv4_access);
+	}
+
 	if (!hdr) {
 		NET_DBG("DROP: no buffer");
 		goto drop;
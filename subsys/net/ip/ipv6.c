@@ -364,7 +364,14 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 	net_stats_update_ipv6_recv(net_pkt_iface(pkt));
 
-	hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+	net_pkt_hdr_cache_set(pkt);
+
+	hdr = net_pkt_hdr_cache_get(pkt, 0, sizeof(struct net_ipv6_hdr));
+	if (!hdr) {
+		hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt,
+							      &ipv6_access);
+	}
+
 	if (!hdr) {
 		NET_DBG("DROP: no buffer");
 		goto drop;
@@ -479,8 +486,12 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 		case NET_IPV6_NEXTHDR_FRAG:
 			if (IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT)) {
+				/* The nexthdr of the fragment header has
+				 * already been read.
+				 */
 				net_pkt_set_ipv6_fragment_start(
-					pkt, net_pkt_get_current_offset(pkt));
+					pkt,
+					net_pkt_get_current_offset(pkt) - 1);
 				return net_ipv6_handle_fragment_hdr(pkt, hdr,
 								    nexthdr);
 			}
@@ -227,6 +227,18 @@ static inline enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Invalidate the destination cache of all the interfaces.
+ *
+ * To be called when a route, a neighbor, a prefix or a router is added
+ * or removed, as the next hop of any destination may change.
+ */
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+void net_ipv6_dst_cache_invalidate(void);
+#else
+#define net_ipv6_dst_cache_invalidate()
+#endif
+
 /**
  * @brief Look for a neighbor from it's address on an iface
  *
@@ -363,12 +375,19 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
  * This means that we should receive everything within first two fragments.
  * The first one being 1280 bytes and the second one 220 bytes.
  */
+#if defined(CONFIG_NET_IPV6_FRAGMENT_MAX_PKT)
+#define NET_IPV6_FRAGMENTS_MAX_PKT CONFIG_NET_IPV6_FRAGMENT_MAX_PKT
+#endif
+
 #if !defined(NET_IPV6_FRAGMENTS_MAX_PKT)
 #define NET_IPV6_FRAGMENTS_MAX_PKT 2
 #endif
 
 /** Store pending IPv6 fragment information that is needed for reassembly. */
 struct net_ipv6_reassembly {
+	/** Node in the hash bucket of the reassembly */
+	sys_snode_t node;
+
 	/** IPv6 source address of the fragment */
 	struct in6_addr src;
 
@@ -381,11 +400,26 @@ struct net_ipv6_reassembly {
 	 */
 	struct k_delayed_work timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[NET_IPV6_FRAGMENTS_MAX_PKT];
 
 	/** IPv6 fragment identification */
 	u32_t id;
+
+	/** Uptime when the reassembly started, in ms */
+	u32_t start;
+
+	/** Length of the original payload, 0 until the last fragment */
+	u16_t total_len;
+
+	/** Payload bytes received so far */
+	u16_t recv_len;
+
+	/** Network buffers held by the fragments */
+	u8_t bufs;
+
+	/** Number of pending fragments, 0 if the slot is free */
+	u8_t count;
 };
 
 /**
@@ -45,6 +45,15 @@ static bool reassembly_init_done;
 static struct net_ipv6_reassembly
 reassembly[CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT];
 
+/* Reassemblies hashed by (id, src, dst) */
+static sys_slist_t reassembly_buckets[CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT];
+
+/* Network buffers held by all the pending fragments */
+static u16_t reassembly_bufs;
+
+/* The timeouts run in the system work queue */
+static K_MUTEX_DEFINE(reassembly_lock);
+
 int net_ipv6_find_last_ext_hdr(struct net_pkt *pkt, u16_t *next_hdr_off,
 			       u16_t *last_hdr_off)
 {
@@ -119,97 +128,157 @@ fail:
 	return -EINVAL;
 }
 
-static struct net_ipv6_reassembly *reassembly_get(u32_t id,
-						  struct in6_addr *src,
-						  struct in6_addr *dst)
+static u32_t reassembly_hash_add(u32_t hash, const void *data, size_t len)
 {
-	int i, avail = -1;
+	const u8_t *ptr = data;
 
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
+	while (len--) {
+		hash = (hash ^ *ptr++) * 16777619U;
+	}
 
-		if (k_delayed_work_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv6_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			return &reassembly[i];
+	return hash;
+}
+
+static u32_t reassembly_hash(u32_t id, struct in6_addr *src,
+			     struct in6_addr *dst)
+{
+	u32_t hash = 2166136261U;
+
+	hash = reassembly_hash_add(hash, &id, sizeof(id));
+	hash = reassembly_hash_add(hash, src, sizeof(*src));
+	hash = reassembly_hash_add(hash, dst, sizeof(*dst));
+
+	return hash % CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT;
+}
+
+static void reassembly_info(char *str, struct net_ipv6_reassembly *reass)
+{
+	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
+		log_strdup(net_sprint_ipv6_addr(&reass->src)),
+		log_strdup(net_sprint_ipv6_addr(&reass->dst)),
+		k_delayed_work_remaining_get(&reass->timer));
+}
+
+static struct net_ipv6_reassembly *reassembly_find(sys_slist_t *bucket,
+						   u32_t id,
+						   struct in6_addr *src,
+						   struct in6_addr *dst)
+{
+	struct net_ipv6_reassembly *reass;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, reass, node) {
+		if (reass->id == id &&
+		    net_ipv6_addr_cmp(src, &reass->src) &&
+		    net_ipv6_addr_cmp(dst, &reass->dst)) {
+			return reass;
 		}
+	}
+
+	return NULL;
+}
+
+static void reassembly_free(struct net_ipv6_reassembly *reass)
+{
+	int i;
 
-		if (k_delayed_work_remaining_get(&reassembly[i].timer)) {
+	k_delayed_work_cancel(&reass->timer);
+
+	NET_DBG("IPv6 reassembly id 0x%x, %u fragments", reass->id,
+		reass->count);
+
+	for (i = 0; i < reass->count; i++) {
+		if (!reass->pkt[i]) {
 			continue;
 		}
 
-		if (avail < 0) {
-			avail = i;
-		}
-	}
+		NET_DBG("[%d] IPv6 reassembly pkt %p %zd bytes data",
+			i, reass->pkt[i], net_pkt_get_len(reass->pkt[i]));
 
-	if (avail < 0) {
-		return NULL;
+		net_pkt_unref(reass->pkt[i]);
+		reass->pkt[i] = NULL;
 	}
 
-	k_delayed_work_submit(&reassembly[avail].timer,
-			      IPV6_REASSEMBLY_TIMEOUT);
-
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+	sys_slist_find_and_remove(
+		&reassembly_buckets[reassembly_hash(reass->id, &reass->src,
+						    &reass->dst)],
+		&reass->node);
 
-	reassembly[avail].id = id;
+	reassembly_bufs -= reass->bufs;
 
-	return &reassembly[avail];
+	reass->id = 0U;
+	reass->count = 0U;
+	reass->bufs = 0U;
+	reass->recv_len = 0U;
+	reass->total_len = 0U;
 }
 
-static bool reassembly_cancel(u32_t id,
-			      struct in6_addr *src,
-			      struct in6_addr *dst)
+static struct net_ipv6_reassembly *reassembly_oldest(
+					struct net_ipv6_reassembly *except)
 {
-	int i, j;
-
-	NET_DBG("Cancel 0x%x", id);
+	struct net_ipv6_reassembly *oldest = NULL;
+	u32_t now = k_uptime_get_32();
+	int i;
 
 	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		s32_t remaining;
-
-		if (reassembly[i].id != id ||
-		    !net_ipv6_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
+		if (!reassembly[i].count || &reassembly[i] == except) {
 			continue;
 		}
 
-		remaining = k_delayed_work_remaining_get(&reassembly[i].timer);
-		if (remaining) {
-			k_delayed_work_cancel(&reassembly[i].timer);
+		if (!oldest || now - reassembly[i].start > now - oldest->start) {
+			oldest = &reassembly[i];
 		}
+	}
 
-		NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
-			reassembly[i].id, remaining);
+	return oldest;
+}
 
-		reassembly[i].id = 0U;
+static void reassembly_evict(struct net_ipv6_reassembly *reass)
+{
+	reassembly_info("Reassembly evicted", reass);
 
-		for (j = 0; j < NET_IPV6_FRAGMENTS_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
+	net_stats_update_ipv6_frag_evicted(net_pkt_iface(reass->pkt[0]));
 
-			NET_DBG("[%d] IPv6 reassembly pkt %p %zd bytes data",
-				j, reassembly[i].pkt[j],
-				net_pkt_get_len(reassembly[i].pkt[j]));
+	reassembly_free(reass);
+}
 
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
+static struct net_ipv6_reassembly *reassembly_get(u32_t id,
+						  struct in6_addr *src,
+						  struct in6_addr *dst)
+{
+	sys_slist_t *bucket = &reassembly_buckets[reassembly_hash(id, src,
+								   dst)];
+	struct net_ipv6_reassembly *reass;
+	int i;
+
+	reass = reassembly_find(bucket, id, src, dst);
+	if (reass) {
+		return reass;
+	}
+
+	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
+		if (!reassembly[i].count) {
+			reass = &reassembly[i];
+			break;
 		}
+	}
 
-		return true;
+	if (!reass) {
+		/* The oldest reassembly is the least likely to complete */
+		reass = reassembly_oldest(NULL);
+		reassembly_evict(reass);
 	}
 
-	return false;
-}
+	k_delayed_work_submit(&reass->timer, IPV6_REASSEMBLY_TIMEOUT);
 
-static void reassembly_info(char *str, struct net_ipv6_reassembly *reass)
-{
-	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
-		log_strdup(net_sprint_ipv6_addr(&reass->src)),
-		log_strdup(net_sprint_ipv6_addr(&reass->dst)),
-		k_delayed_work_remaining_get(&reass->timer));
+	net_ipaddr_copy(&reass->src, src);
+	net_ipaddr_copy(&reass->dst, dst);
+
+	reass->id = id;
+	reass->start = k_uptime_get_32();
+
+	sys_slist_prepend(bucket, &reass->node);
+
+	return reass;
 }
 
 static void reassembly_timeout(struct k_work *work)
@@ -217,9 +286,19 @@ static void reassembly_timeout(struct k_work *work)
 	struct net_ipv6_reassembly *reass =
 		CONTAINER_OF(work, struct net_ipv6_reassembly, timer);
 
-	reassembly_info("Reassembly cancelled", reass);
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	/* The slot may have been freed, or reused, meanwhile */
+	if (reass->count && !k_delayed_work_remaining_get(&reass->timer)) {
+		reassembly_info("Reassembly cancelled", reass);
+
+		net_stats_update_ipv6_frag_timeout(
+					net_pkt_iface(reass->pkt[0]));
 
-	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+		reassembly_free(reass);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
 }
 
 static void reassemble_packet(struct net_ipv6_reassembly *reass)
@@ -236,8 +315,6 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	u8_t next_hdr;
 	int i, len;
 
-	k_delayed_work_cancel(&reass->timer);
-
 	NET_ASSERT(reass->pkt[0]);
 
 	last = net_buf_frag_last(reass->pkt[0]->buffer);
@@ -245,7 +322,7 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	/* We start from 2nd packet which is then appended to
 	 * the first one.
 	 */
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
+	for (i = 1; i < reass->count; i++) {
 		int removed_len;
 
 		pkt = reass->pkt[i];
@@ -259,9 +336,11 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 		NET_DBG("Removing %d bytes from start of pkt %p",
 			removed_len, pkt->buffer);
 
+		net_pkt_cursor_init(pkt);
+
 		if (net_pkt_pull(pkt, removed_len)) {
 			NET_ERR("Failed to pull headers");
-			reassembly_cancel(reass->id, &reass->src, &reass->dst);
+			reassembly_free(reass);
 			return;
 		}
 
@@ -278,6 +357,8 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	pkt = reass->pkt[0];
 	reass->pkt[0] = NULL;
 
+	reassembly_free(reass);
+
 	/* Next we need to strip away the fragment header from the first packet
 	 * and set the various pointers and values in packet.
 	 */
@@ -335,6 +416,8 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	NET_DBG("New pkt %p IPv6 len is %d bytes", pkt,
 		len + NET_IPV6H_LEN);
 
+	net_stats_update_ipv6_frag_reassembled(net_pkt_iface(pkt));
+
 	/* We need to use the queue when feeding the packet back into the
 	 * IP stack as we might run out of stack if we call processing_data()
 	 * directly. As the packet does not contain link layer header, we
@@ -352,85 +435,167 @@ void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 {
 	int i;
 
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
 	for (i = 0; reassembly_init_done &&
 		     i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		if (!k_delayed_work_remaining_get(&reassembly[i].timer)) {
+		if (!reassembly[i].count) {
 			continue;
 		}
 
 		cb(&reassembly[i], user_data);
 	}
+
+	k_mutex_unlock(&reassembly_lock);
 }
 
-/* Verify that we have all the fragments received and in correct order.
- */
-static bool fragment_verify(struct net_ipv6_reassembly *reass)
+/* Fragmentable part carried by a fragment, after its fragment header */
+static u16_t fragment_len(struct net_pkt *pkt)
 {
-	u16_t offset;
-	int i, prev_len;
-
-	prev_len = net_pkt_get_len(reass->pkt[0]);
-	offset = net_pkt_ipv6_fragment_offset(reass->pkt[0]);
+	return net_pkt_get_len(pkt) - net_pkt_ipv6_fragment_start(pkt) -
+		sizeof(struct net_ipv6_frag_hdr);
+}
 
-	NET_DBG("pkt %p offset %u", reass->pkt[0], offset);
+static u8_t fragment_bufs(struct net_pkt *pkt)
+{
+	struct net_buf *buf;
+	u8_t count = 0U;
 
-	if (offset != 0U) {
-		return false;
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		count++;
 	}
 
-	for (i = 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		offset = net_pkt_ipv6_fragment_offset(reass->pkt[i]);
+	return count;
+}
 
-		NET_DBG("pkt %p offset %u prev_len %d", reass->pkt[i],
-			offset, prev_len);
+/* Index where a fragment at offset goes in the sorted fragments */
+static int fragment_pos(struct net_ipv6_reassembly *reass, u16_t offset)
+{
+	int low = 0, high = reass->count;
+	int mid;
 
-		if (prev_len < offset) {
-			/* Something wrong with the offset value */
-			return false;
-		}
+	while (low < high) {
+		mid = (low + high) / 2;
 
-		prev_len = net_pkt_get_len(reass->pkt[i]);
+		if (net_pkt_ipv6_fragment_offset(reass->pkt[mid]) < offset) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
 	}
 
-	return true;
+	return low;
 }
 
-static int shift_packets(struct net_ipv6_reassembly *reass, int pos)
+/* Insert a fragment, returning NET_OK if it was stored and NET_DROP if
+ * it is to be dropped, with the whole reassembly when it is freed.
+ */
+static enum net_verdict fragment_insert(struct net_ipv6_reassembly *reass,
+					struct net_pkt *pkt, bool more)
 {
-	int i;
+	u16_t offset = net_pkt_ipv6_fragment_offset(pkt);
+	u16_t len = fragment_len(pkt);
+	u32_t end = offset + len;
+	struct net_ipv6_reassembly *victim;
+	struct net_pkt *other;
+	u8_t bufs;
+	int pos;
+
+	pos = fragment_pos(reass, offset);
+
+	if (pos < reass->count) {
+		other = reass->pkt[pos];
+
+		if (net_pkt_ipv6_fragment_offset(other) == offset &&
+		    fragment_len(other) == len) {
+			NET_DBG("Duplicate fragment offset %u of 0x%x",
+				offset, reass->id);
+			net_stats_update_ipv6_frag_duplicate(
+							net_pkt_iface(pkt));
+			return NET_DROP;
+		}
 
-	for (i = pos + 1; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
-				pos, reass->pkt[pos],
-				net_pkt_ipv6_fragment_offset(reass->pkt[pos]),
-				i);
-
-			/* Do we have enough space in packet array to make
-			 * the move?
-			 */
-			if (((i - pos) + 1) >
-			    (NET_IPV6_FRAGMENTS_MAX_PKT - i)) {
-				return -ENOMEM;
-			}
+		if (end > net_pkt_ipv6_fragment_offset(other)) {
+			goto overlap;
+		}
+	}
 
-			memmove(&reass->pkt[i], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
+	if (pos > 0) {
+		other = reass->pkt[pos - 1];
 
-			return 0;
+		if (net_pkt_ipv6_fragment_offset(other) +
+		    fragment_len(other) > offset) {
+			goto overlap;
 		}
 	}
 
-	return -EINVAL;
+	/* The last fragment gives the length, which no other fragment may
+	 * go beyond.
+	 */
+	if (!more) {
+		if (reass->total_len || (pos < reass->count)) {
+			goto overlap;
+		}
+	} else if (reass->total_len && end > reass->total_len) {
+		goto overlap;
+	}
+
+	if (reass->count == NET_IPV6_FRAGMENTS_MAX_PKT) {
+		NET_DBG("No slots available for 0x%x", reass->id);
+		goto drop;
+	}
+
+	bufs = fragment_bufs(pkt);
+
+	while (reassembly_bufs + bufs > CONFIG_NET_IPV6_FRAGMENT_MAX_BUFS) {
+		victim = reassembly_oldest(reass);
+		if (!victim) {
+			NET_DBG("Out of fragment memory for 0x%x", reass->id);
+			goto drop;
+		}
+
+		reassembly_evict(victim);
+	}
+
+	memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
+		(reass->count - pos) * sizeof(struct net_pkt *));
+
+	NET_DBG("Storing pkt %p to slot %d offset %d", pkt, pos, offset);
+
+	reass->pkt[pos] = pkt;
+	reass->count++;
+	reass->bufs += bufs;
+	reass->recv_len += len;
+	reassembly_bufs += bufs;
+
+	if (!more) {
+		reass->total_len = end;
+	}
+
+	return NET_OK;
+
+overlap:
+	/* RFC 5722: overlapping fragments make the whole packet invalid */
+	NET_DBG("Overlapping fragment offset %u of 0x%x", offset, reass->id);
+	net_stats_update_ipv6_frag_overlap(net_pkt_iface(pkt));
+	reassembly_free(reass);
+
+	return NET_DROP;
+
+drop:
+	net_stats_update_ipv6_frag_drop(net_pkt_iface(pkt));
+	reassembly_free(reass);
+
+	return NET_DROP;
 }
 
 enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 					      struct net_ipv6_hdr *hdr,
 					      u8_t nexthdr)
 {
-	struct net_ipv6_reassembly *reass = NULL;
+	struct net_ipv6_reassembly *reass;
+	enum net_verdict verdict;
 	u16_t flag;
-	bool found;
 	u8_t more;
 	u32_t id;
 	int i;
@@ -455,109 +620,52 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 	if (net_pkt_skip(pkt, 1) || /* reserved */
 	    net_pkt_read_be16(pkt, &flag) ||
 	    net_pkt_read_be32(pkt, &id)) {
-		goto drop;
-	}
-
-	reass = reassembly_get(id, &hdr->src, &hdr->dst);
-	if (!reass) {
-		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
-		goto drop;
+		return NET_DROP;
 	}
 
 	more = flag & 0x01;
 	net_pkt_set_ipv6_fragment_offset(pkt, flag & 0xfff8);
 
-	if (!reass->pkt[0]) {
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, 0, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[0] = pkt;
-
-		reassembly_info("Reassembly 1st pkt", reass);
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
 
-		/* Wait for more fragments to receive. */
-		goto accept;
-	}
-
-	/* The fragments might come in wrong order so place them
-	 * in reassembly chain in correct order.
-	 */
-	for (i = 0, found = false; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv6_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv6_fragment_offset(pkt)) {
-				continue;
-			}
+	reass = reassembly_get(id, &hdr->src, &hdr->dst);
 
-			/* Make room for this fragment. If there is no room,
-			 * then it will discard the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
+	if (more && (fragment_len(pkt) % 8)) {
+		/* Fragment length is not multiple of 8, discard
+		 * the packet and send parameter problem error.
+		 */
+		net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
+				      NET_ICMPV6_PARAM_PROB_OPTION, 0);
+		reassembly_free(reass);
+		verdict = NET_DROP;
+		goto out;
+	}
+
+	verdict = fragment_insert(reass, pkt, more);
+	if (verdict != NET_OK) {
+		/* A duplicate leaves the reassembly going */
+		if (reass->count) {
+			reassembly_info("Reassembly duplicate pkt", reass);
 		}
 
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, i, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
+		goto out;
 	}
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment
-		 * list. We must discard the whole packet at this point.
-		 */
-		NET_DBG("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
-		goto drop;
-	}
-
-	if (more) {
-		if (net_pkt_get_len(pkt) % 8) {
-			/* Fragment length is not multiple of 8, discard
-			 * the packet and send parameter problem error.
-			 */
-			net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
-					      NET_ICMPV6_PARAM_PROB_OPTION, 0);
-			goto drop;
-		}
-
+	if (!reass->total_len || reass->recv_len != reass->total_len) {
 		reassembly_info("Reassembly nth pkt", reass);
-
 		NET_DBG("More fragments to be received");
-		goto accept;
+		goto out;
 	}
 
 	reassembly_info("Reassembly last pkt", reass);
 
-	if (!fragment_verify(reass)) {
-		NET_DBG("Reassembled IPv6 verify failed, dropping id %u",
-			reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < NET_IPV6_FRAGMENTS_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
-		net_pkt_unref(pkt);
-		goto drop;
-	}
-
-	/* The last fragment received, reassemble the packet */
+	/* No overlap and all the bytes of the payload: nothing is missing */
 	reassemble_packet(reass);
 
-accept:
-	return NET_OK;
-
-drop:
-	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
-	}
+out:
+	k_mutex_unlock(&reassembly_lock);
 
-	return NET_DROP;
+	return verdict;
 }
 
 #define BUF_ALLOC_TIMEOUT K_MSEC(100)
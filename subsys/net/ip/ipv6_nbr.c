@@ -301,6 +301,8 @@ static inline void nbr_free(struct net_nbr *nbr)
 
 	net_nbr_unref(nbr);
 	net_nbr_unlink(nbr, NULL);
+
+	net_ipv6_dst_cache_invalidate();
 }
 
 bool net_ipv6_nbr_rm(struct net_if *iface, struct in6_addr *addr)
@@ -397,6 +399,8 @@ static void ipv6_ns_reply_timeout(struct k_work *work)
 		data->pending = NULL;
 
 		net_nbr_unref(nbr);
+
+		net_ipv6_dst_cache_invalidate();
 	}
 }
 
@@ -594,6 +598,8 @@ struct net_nbr *net_ipv6_nbr_add(struct net_if *iface,
 		return NULL;
 	}
 
+	net_ipv6_dst_cache_invalidate();
+
 	if (net_nbr_link(nbr, iface, lladdr) == -EALREADY &&
 	    net_ipv6_nbr_data(nbr)->state != NET_IPV6_NBR_STATE_STATIC) {
 		/* Update the lladdr if the node was already known */
@@ -653,6 +659,8 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 void net_neighbor_table_clear(struct net_nbr_table *table)
 {
 	NET_DBG("Neighbor table %p cleared", table);
+
+	net_ipv6_dst_cache_invalidate();
 }
 
 struct in6_addr *net_ipv6_nbr_lookup_by_index(struct net_if *iface,
@@ -710,6 +718,81 @@ static inline bool dad_failed(struct net_if *iface, struct in6_addr *addr)
 #endif /* CONFIG_NET_IPV6_DAD */
 
 #if defined(CONFIG_NET_IPV6_NBR_CACHE)
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+/* Entries are valid while their generation is the current one, any change
+ * of the routes, prefixes, routers or neighbors bumps it.
+ */
+static atomic_t dst_cache_gen = ATOMIC_INIT(1);
+
+void net_ipv6_dst_cache_invalidate(void)
+{
+	atomic_inc(&dst_cache_gen);
+}
+
+static struct net_if_ipv6_dst *dst_cache_entry(struct net_if *iface,
+					       const struct in6_addr *dst)
+{
+	struct net_if_ipv6 *ipv6 = iface->config.ip.ipv6;
+	u32_t hash;
+
+	if (!ipv6) {
+		return NULL;
+	}
+
+	hash = UNALIGNED_GET(&dst->s6_addr32[2]) ^
+	       UNALIGNED_GET(&dst->s6_addr32[3]);
+	hash ^= hash >> 16;
+
+	return &ipv6->dst_cache[hash % CONFIG_NET_IPV6_DST_CACHE_SIZE];
+}
+
+static struct net_nbr *dst_cache_lookup(struct net_if *iface,
+					const struct in6_addr *dst,
+					struct net_if **nbr_iface)
+{
+	struct net_if_ipv6_dst *entry = dst_cache_entry(iface, dst);
+	struct net_nbr *nbr = NULL;
+	unsigned int key;
+
+	if (!entry) {
+		return NULL;
+	}
+
+	key = irq_lock();
+
+	if (entry->gen == (u32_t)atomic_get(&dst_cache_gen) &&
+	    net_ipv6_addr_cmp(&entry->addr, dst)) {
+		nbr = entry->nbr;
+		*nbr_iface = entry->iface;
+	}
+
+	irq_unlock(key);
+
+	return nbr;
+}
+
+static void dst_cache_store(struct net_if *iface, const struct in6_addr *dst,
+			    struct net_nbr *nbr, struct net_if *nbr_iface,
+			    u32_t gen)
+{
+	struct net_if_ipv6_dst *entry = dst_cache_entry(iface, dst);
+	unsigned int key;
+
+	if (!entry) {
+		return;
+	}
+
+	key = irq_lock();
+
+	net_ipaddr_copy(&entry->addr, dst);
+	entry->nbr = nbr;
+	entry->iface = nbr_iface;
+	entry->gen = gen;
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_NET_IPV6_DST_CACHE */
+
 static struct in6_addr *check_route(struct net_if *iface,
 				    struct in6_addr *dst,
 				    bool *try_route)
@@ -761,6 +844,32 @@ static struct in6_addr *check_route(struct net_if *iface,
 	return nexthop;
 }
 
+static enum net_verdict send_to_nbr(struct net_pkt *pkt, struct net_nbr *nbr)
+{
+	struct net_linkaddr_storage *lladdr;
+
+	lladdr = net_nbr_get_lladdr(nbr->idx);
+
+	net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
+	net_pkt_lladdr_dst(pkt)->len = lladdr->len;
+
+	NET_DBG("Neighbor %p addr %s", nbr,
+		log_strdup(net_sprint_ll_addr(lladdr->addr, lladdr->len)));
+
+	/* Start the NUD if we are in STALE state.
+	 * See RFC 4861 ch 7.3.3 for details.
+	 */
+#if defined(CONFIG_NET_IPV6_ND)
+	if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_STALE) {
+		ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_DELAY);
+
+		ipv6_nd_restart_reachable_timer(nbr, DELAY_FIRST_PROBE_TIME);
+	}
+#endif
+
+	return NET_OK;
+}
+
 enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
@@ -769,6 +878,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 	struct net_ipv6_hdr *ip_hdr;
 	struct net_nbr *nbr;
 	int ret;
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+	struct net_if *orig_iface;
+	u32_t gen;
+#endif
 
 	NET_ASSERT(pkt && pkt->buffer);
 
@@ -846,6 +959,23 @@ ignore_frag_error:
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+	/* The generation is read before the lookups, so that a change
+	 * done meanwhile makes the stored result stale at once.
+	 */
+	orig_iface = net_pkt_iface(pkt);
+	gen = (u32_t)atomic_get(&dst_cache_gen);
+
+	nbr = dst_cache_lookup(orig_iface, &ip_hdr->dst, &iface);
+	if (nbr && nbr->idx != NET_NBR_LLADDR_UNKNOWN) {
+		net_pkt_set_iface(pkt, iface);
+
+		return send_to_nbr(pkt, nbr);
+	}
+
+	iface = NULL;
+#endif
+
 	if (net_if_ipv6_addr_onlink(&iface, &ip_hdr->dst)) {
 		nexthop = &ip_hdr->dst;
 		net_pkt_set_iface(pkt, iface);
@@ -890,29 +1020,11 @@ try_send:
 		"-");
 
 	if (nbr && nbr->idx != NET_NBR_LLADDR_UNKNOWN) {
-		struct net_linkaddr_storage *lladdr;
-
-		lladdr = net_nbr_get_lladdr(nbr->idx);
-
-		net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
-		net_pkt_lladdr_dst(pkt)->len = lladdr->len;
-
-		NET_DBG("Neighbor %p addr %s", nbr,
-			log_strdup(net_sprint_ll_addr(lladdr->addr,
-						      lladdr->len)));
-
-		/* Start the NUD if we are in STALE state.
-		 * See RFC 4861 ch 7.3.3 for details.
-		 */
-#if defined(CONFIG_NET_IPV6_ND)
-		if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_STALE) {
-			ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_DELAY);
-
-			ipv6_nd_restart_reachable_timer(nbr,
-							DELAY_FIRST_PROBE_TIME);
-		}
+#if defined(CONFIG_NET_IPV6_DST_CACHE)
+		dst_cache_store(orig_iface, &ip_hdr->dst, nbr,
+				net_pkt_iface(pkt), gen);
 #endif
-		return NET_OK;
+		return send_to_nbr(pkt, nbr);
 	}
 
 #if defined(CONFIG_NET_IPV6_ND)
@@ -1349,6 +1461,13 @@ nexthop_found:
 	}
 
 send_na:
+	/* RFC 4429 ch 3.3, an optimistic address may still belong to another
+	 * node, the cache entries of our neighbors must not be overridden.
+	 */
+	if (ifaddr && ifaddr->is_optimistic) {
+		flags &= ~NET_ICMPV6_NA_FLAG_OVERRIDE;
+	}
+
 	if (!net_ipv6_send_na(net_pkt_iface(pkt), src,
 			      &ip_hdr->dst, tgt, flags)) {
 		net_pkt_unref(pkt);
@@ -1803,6 +1922,7 @@ int net_ipv6_send_ns(struct net_if *iface,
 	struct net_pkt *pkt = NULL;
 	int ret = -ENOBUFS;
 	struct net_icmpv6_ns_hdr *ns_hdr;
+	struct net_if_addr *ifaddr;
 	struct in6_addr node_dst;
 	struct net_nbr *nbr;
 	u8_t llao_len;
@@ -1828,6 +1948,12 @@ int net_ipv6_send_ns(struct net_if *iface,
 
 			goto drop;
 		}
+
+		/* RFC 4429 ch 3.3, no SLLAO from an optimistic address */
+		ifaddr = net_if_ipv6_addr_lookup_by_iface(iface, src);
+		if (ifaddr && ifaddr->is_optimistic) {
+			llao_len = 0U;
+		}
 	}
 
 	pkt = net_pkt_alloc_with_buffer(iface,
@@ -1859,7 +1985,7 @@ int net_ipv6_send_ns(struct net_if *iface,
 		goto drop;
 	}
 
-	if (!is_my_address) {
+	if (llao_len > 0U) {
 		if (!set_llao(pkt, net_if_get_link_addr(iface),
 			      llao_len, NET_ICMPV6_ND_OPT_SLLAO)) {
 			goto drop;
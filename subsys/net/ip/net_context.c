@@ -1113,10 +1113,48 @@ static int get_context_timepstamp(struct net_context *context,
 #endif
 }
 
+/* Write len bytes of payload, from buf or gathered from the I/O vector
+ * of msghdr if given.
+ */
+static int context_write_data(struct net_pkt *pkt, const void *buf,
+			      size_t len, const struct msghdr *msghdr,
+			      bool chksum)
+{
+	size_t i;
+	int ret;
+
+	if (!msghdr) {
+		return chksum ? net_pkt_write_chksum(pkt, buf, len) :
+			net_pkt_write(pkt, buf, len);
+	}
+
+	for (i = 0; i < msghdr->msg_iovlen && len > 0; i++) {
+		size_t iov_len = MIN(msghdr->msg_iov[i].iov_len, len);
+
+		if (chksum) {
+			ret = net_pkt_write_chksum(pkt,
+						   msghdr->msg_iov[i].iov_base,
+						   iov_len);
+		} else {
+			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
+					    iov_len);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		len -= iov_len;
+	}
+
+	return 0;
+}
+
 static int context_setup_udp_packet(struct net_context *context,
 				    struct net_pkt *pkt,
 				    const void *buf,
 				    size_t len,
+				    const struct msghdr *msghdr,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1158,7 +1196,12 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = net_pkt_write(pkt, buf, len);
+	/* Sum the payload while copying it, unless the checksum is
+	 * offloaded
+	 */
+	ret = context_write_data(pkt, buf, len, msghdr,
+				 net_if_need_calc_tx_checksum(
+					 net_pkt_iface(pkt)));
 	if (ret) {
 		return ret;
 	}
@@ -1184,11 +1227,60 @@ static void context_finalize_packet(struct net_context *context,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_TSO)
+/* One packet for all the data, cut into segments when sent */
+static struct net_pkt *context_alloc_tso_pkt(struct net_context *context,
+					     size_t len, u16_t mss,
+					     s32_t timeout)
+{
+	struct net_if *iface = net_context_get_iface(context);
+	struct net_pkt *pkt;
+
+#if defined(CONFIG_NET_CONTEXT_NET_PKT_POOL)
+	if (context->tx_slab) {
+		pkt = net_pkt_alloc_from_slab(context->tx_slab(), timeout);
+	} else
+#endif
+	{
+		pkt = net_pkt_alloc_on_iface(iface, timeout);
+	}
+
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_family(pkt, net_context_get_family(context));
+	net_pkt_set_context(pkt, context);
+	net_pkt_set_tso_mss(pkt, mss);
+
+	if (net_pkt_alloc_buffer(pkt, len, IPPROTO_TCP, timeout)) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 static struct net_pkt *context_alloc_pkt(struct net_context *context,
 					 size_t len, s32_t timeout)
 {
 	struct net_pkt *pkt;
 
+#if defined(CONFIG_NET_TCP_TSO)
+	if (net_context_get_ip_proto(context) == IPPROTO_TCP &&
+	    context->tcp &&
+	    !net_if_is_ip_offloaded(net_context_get_iface(context))) {
+		u16_t mss = MIN(context->tcp->send_mss,
+				net_tcp_get_recv_mss(context->tcp));
+
+		if (mss && len > mss) {
+			return context_alloc_tso_pkt(context, len, mss,
+						     timeout);
+		}
+	}
+#endif
 #if defined(CONFIG_NET_CONTEXT_NET_PKT_POOL)
 	if (context->tx_slab) {
 		pkt = net_pkt_alloc_from_slab(context->tx_slab(), timeout);
@@ -1225,6 +1317,7 @@ static struct net_pkt *context_alloc_pkt(struct net_context *context,
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  const struct msghdr *msghdr,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -1242,6 +1335,14 @@ static int context_sendto(struct net_context *context,
 		return -EBADF;
 	}
 
+	if (msghdr) {
+		size_t i;
+
+		for (i = 0, len = 0; i < msghdr->msg_iovlen; i++) {
+			len += msghdr->msg_iov[i].iov_len;
+		}
+	}
+
 	if (!dst_addr &&
 	    !(IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 	      net_context_get_ip_proto(context) == CAN_RAW)) {
@@ -1356,7 +1457,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = net_pkt_write(pkt, buf, len);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1373,7 +1474,7 @@ static int context_sendto(struct net_context *context,
 		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, pkt, buf, len,
+		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
 					       dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
@@ -1384,7 +1485,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_send_data(pkt);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
-		ret = net_pkt_write(pkt, buf, len);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1398,7 +1499,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = net_pkt_write(pkt, buf, len);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1409,7 +1510,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = net_pkt_write(pkt, buf, len);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1434,42 +1535,52 @@ fail:
 	return ret;
 }
 
-int net_context_send(struct net_context *context,
-		     const void *buf,
-		     size_t len,
-		     net_context_send_cb_t cb,
-		     s32_t timeout,
-		     void *user_data)
+/* Length of the address of the connected peer */
+static int context_remote_addrlen(struct net_context *context,
+				  socklen_t *addrlen)
 {
-	socklen_t addrlen;
-	int ret = 0;
-
-	k_mutex_lock(&context->lock, K_FOREVER);
-
 	if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
 	    !net_sin(&context->remote)->sin_port) {
-		ret = -EDESTADDRREQ;
-		goto unlock;
+		return -EDESTADDRREQ;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) &&
 	    net_context_get_family(context) == AF_INET6) {
-		addrlen = sizeof(struct sockaddr_in6);
+		*addrlen = sizeof(struct sockaddr_in6);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
 		   net_context_get_family(context) == AF_INET) {
-		addrlen = sizeof(struct sockaddr_in);
+		*addrlen = sizeof(struct sockaddr_in);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = -EOPNOTSUPP;
-		goto unlock;
+		return -EOPNOTSUPP;
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN) {
-		addrlen = sizeof(struct sockaddr_can);
+		*addrlen = sizeof(struct sockaddr_can);
 	} else {
-		addrlen = 0;
+		*addrlen = 0;
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	return 0;
+}
+
+int net_context_send(struct net_context *context,
+		     const void *buf,
+		     size_t len,
+		     net_context_send_cb_t cb,
+		     s32_t timeout,
+		     void *user_data)
+{
+	socklen_t addrlen;
+	int ret = 0;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = context_remote_addrlen(context, &addrlen);
+	if (ret < 0) {
+		goto unlock;
+	}
+
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
@@ -1491,7 +1602,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1499,6 +1610,38 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendmsg(struct net_context *context,
+			const struct msghdr *msghdr,
+			int flags,
+			net_context_send_cb_t cb,
+			s32_t timeout,
+			void *user_data)
+{
+	socklen_t addrlen;
+	int ret;
+
+	ARG_UNUSED(flags);
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (msghdr->msg_name) {
+		ret = context_sendto(context, NULL, 0, msghdr,
+				     msghdr->msg_name, msghdr->msg_namelen,
+				     cb, timeout, user_data, true);
+	} else {
+		ret = context_remote_addrlen(context, &addrlen);
+		if (ret == 0) {
+			ret = context_sendto(context, NULL, 0, msghdr,
+					     &context->remote, addrlen,
+					     cb, timeout, user_data, false);
+		}
+	}
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -68,6 +68,28 @@ void net_analyze_stack(const char *name, const char *stack, size_t size)
 }
 #endif /* CONFIG_INIT_STACKS */
 
+static enum net_verdict process_ip(struct net_pkt *pkt, bool is_loopback)
+{
+	/* IP version and header length. */
+	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
+#if defined(CONFIG_NET_IPV6)
+	case 0x60:
+		return net_ipv6_input(pkt, is_loopback);
+#endif
+#if defined(CONFIG_NET_IPV4)
+	case 0x40:
+		return net_ipv4_input(pkt);
+#endif
+	}
+
+	NET_DBG("Unknown IP family packet (0x%x)",
+		NET_IPV6_HDR(pkt)->vtc & 0xf0);
+	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
+	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
+
+	return NET_DROP;
+}
+
 static inline enum net_verdict process_data(struct net_pkt *pkt,
 					    bool is_loopback)
 {
@@ -120,24 +142,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	 */
 	net_pkt_cursor_init(pkt);
 
-	/* IP version and header length. */
-	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
-#if defined(CONFIG_NET_IPV6)
-	case 0x60:
-		return net_ipv6_input(pkt, is_loopback);
-#endif
-#if defined(CONFIG_NET_IPV4)
-	case 0x40:
-		return net_ipv4_input(pkt);
-#endif
+	if (!locally_routed && net_gro_receive(pkt, is_loopback) == NET_OK) {
+		return NET_OK;
 	}
 
-	NET_DBG("Unknown IP family packet (0x%x)",
-		NET_IPV6_HDR(pkt)->vtc & 0xf0);
-	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
-	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
-
-	return NET_DROP;
+	return process_ip(pkt, is_loopback);
 }
 
 static void processing_data(struct net_pkt *pkt, bool is_loopback)
@@ -154,6 +163,18 @@ static void processing_data(struct net_pkt *pkt, bool is_loopback)
 	}
 }
 
+#if defined(CONFIG_NET_GRO)
+void net_gro_deliver(struct net_pkt *pkt, bool is_loopback)
+{
+	net_pkt_cursor_init(pkt);
+
+	if (process_ip(pkt, is_loopback) != NET_OK) {
+		NET_DBG("Dropping pkt %p", pkt);
+		net_pkt_unref(pkt);
+	}
+}
+#endif /* CONFIG_NET_GRO */
+
 /* Things to setup after we are able to RX and TX */
 static void net_post_init(void)
 {
@@ -169,7 +190,11 @@ static void init_rx_queues(void)
 {
 	/* Starting TX side. The ordering is important here and the TX
 	 * can only be started when RX side is ready to receive packets.
+	 * The drivers register their polling while the interfaces are
+	 * initialized.
 	 */
+	net_napi_start();
+
 	net_if_init();
 
 	net_tc_rx_init();
@@ -364,6 +389,8 @@ static void process_rx_packet(struct k_work *work)
 	pkt = CONTAINER_OF(work, struct net_pkt, work);
 
 	net_rx(net_pkt_iface(pkt), pkt);
+
+	net_gro_burst_end();
 }
 
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
@@ -0,0 +1,430 @@
+/** @file
+ * @brief TCP receive coalescing
+ *
+ * The in-order TCP segments of a flow received in a burst are merged into
+ * one packet in the Rx thread, before the IP processing.  The first segment
+ * keeps its headers and the data of the next ones is appended to it, so the
+ * IP and TCP layers run, and the socket reader is woken up, once for all of
+ * them.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_core, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define GRO_QUEUE_COUNT (NET_TC_RX_COUNT * NET_RX_FLOW_QUEUES)
+
+struct gro_flow {
+	/* First segment, with the headers of the merged packet, NULL if
+	 * the flow is free
+	 */
+	struct net_pkt *pkt;
+	u32_t next_seq;
+	/* IP length of the merged packet */
+	u16_t len;
+	u8_t ip_hdr_len;
+	u8_t segs;
+	bool is_loopback;
+};
+
+struct gro_queue {
+	struct gro_flow flows[CONFIG_NET_GRO_FLOWS];
+	/* Packets held since the last flush */
+	u8_t held;
+	u8_t evict;
+	bool flushing;
+};
+
+/* One set of flows per Rx queue, only used by the thread of the queue */
+static struct gro_queue gro_queues[GRO_QUEUE_COUNT];
+
+struct gro_seg {
+	u8_t *ip;
+	struct net_tcp_hdr *tcp;
+	u16_t ip_len;
+	u16_t hdr_len;
+	u16_t data_len;
+	u8_t ip_hdr_len;
+	sa_family_t family;
+};
+
+/* Only plain data segments of the ACK state, for us, with their headers
+ * in the first buffer and no link layer padding are coalesced.
+ */
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_buf *buf = pkt->buffer;
+	u8_t tcp_hdr_len;
+
+	if (!buf || buf->len < 1) {
+		return false;
+	}
+
+	seg->ip = buf->data;
+
+	switch (seg->ip[0] >> 4) {
+#if defined(CONFIG_NET_IPV4)
+	case 4: {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)seg->ip;
+
+		if (buf->len < sizeof(*hdr) || hdr->vhl != 0x45 ||
+		    hdr->proto != IPPROTO_TCP ||
+		    (hdr->offset[0] & 0x3f) != 0U || hdr->offset[1] != 0U) {
+			return false;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_ROUTING) &&
+		    !net_ipv4_is_my_addr(&hdr->dst)) {
+			return false;
+		}
+
+		seg->family = AF_INET;
+		seg->ip_hdr_len = sizeof(*hdr);
+		seg->ip_len = ntohs(hdr->len);
+		break;
+	}
+#endif
+#if defined(CONFIG_NET_IPV6)
+	case 6: {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)seg->ip;
+
+		if (buf->len < sizeof(*hdr) || hdr->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_ROUTING) &&
+		    !net_ipv6_is_my_addr(&hdr->dst)) {
+			return false;
+		}
+
+		seg->family = AF_INET6;
+		seg->ip_hdr_len = sizeof(*hdr);
+		seg->ip_len = sizeof(*hdr) + ntohs(hdr->len);
+		break;
+	}
+#endif
+	default:
+		return false;
+	}
+
+	if (buf->len < seg->ip_hdr_len + sizeof(struct net_tcp_hdr)) {
+		return false;
+	}
+
+	seg->tcp = (struct net_tcp_hdr *)(seg->ip + seg->ip_hdr_len);
+
+	tcp_hdr_len = NET_TCP_HDR_LEN(seg->tcp);
+	if (tcp_hdr_len < sizeof(struct net_tcp_hdr) ||
+	    buf->len < seg->ip_hdr_len + tcp_hdr_len) {
+		return false;
+	}
+
+	/* FIN, SYN, RST, URG and the ECN flags all stop the coalescing */
+	if ((seg->tcp->flags & ~NET_TCP_PSH) != NET_TCP_ACK) {
+		return false;
+	}
+
+	seg->hdr_len = seg->ip_hdr_len + tcp_hdr_len;
+
+	if (seg->ip_len != net_pkt_get_len(pkt) ||
+	    seg->ip_len <= seg->hdr_len) {
+		return false;
+	}
+
+	seg->data_len = seg->ip_len - seg->hdr_len;
+
+	return true;
+}
+
+/* The checksums of the segments are verified here, as the merged packet
+ * has no valid TCP checksum.
+ */
+static bool gro_chksum_ok(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	if (!net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		return true;
+	}
+
+	net_pkt_set_family(pkt, seg->family);
+	net_pkt_set_ip_hdr_len(pkt, seg->ip_hdr_len);
+
+#if defined(CONFIG_NET_IPV4)
+	if (seg->family == AF_INET && net_calc_chksum_ipv4(pkt) != 0U) {
+		return false;
+	}
+#endif
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    net_calc_chksum_tcp(pkt) != 0U) {
+		return false;
+	}
+
+	return true;
+}
+
+static inline u8_t *gro_flow_ip(struct gro_flow *flow)
+{
+	return flow->pkt->buffer->data;
+}
+
+static inline struct net_tcp_hdr *gro_flow_tcp(struct gro_flow *flow)
+{
+	return (struct net_tcp_hdr *)(gro_flow_ip(flow) + flow->ip_hdr_len);
+}
+
+static bool gro_flow_match(struct gro_flow *flow, struct net_pkt *pkt,
+			   struct gro_seg *seg)
+{
+	u8_t *ip = gro_flow_ip(flow);
+
+	if (net_pkt_iface(flow->pkt) != net_pkt_iface(pkt) ||
+	    net_pkt_family(flow->pkt) != seg->family ||
+	    memcmp(gro_flow_tcp(flow), seg->tcp, 2 * sizeof(u16_t))) {
+		return false;
+	}
+
+	if (seg->family == AF_INET) {
+		return !memcmp(ip + offsetof(struct net_ipv4_hdr, src),
+			       seg->ip + offsetof(struct net_ipv4_hdr, src),
+			       2 * sizeof(struct in_addr));
+	}
+
+	return !memcmp(ip + offsetof(struct net_ipv6_hdr, src),
+		       seg->ip + offsetof(struct net_ipv6_hdr, src),
+		       2 * sizeof(struct in6_addr));
+}
+
+static struct gro_flow *gro_flow_find(struct gro_queue *q,
+				      struct net_pkt *pkt, struct gro_seg *seg)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_GRO_FLOWS; i++) {
+		if (q->flows[i].pkt &&
+		    gro_flow_match(&q->flows[i], pkt, seg)) {
+			return &q->flows[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Next segment of the flow, with the same headers apart from the
+ * sequence number, window and PSH flag
+ */
+static bool gro_can_merge(struct gro_flow *flow, struct gro_seg *seg,
+			  bool is_loopback)
+{
+	struct net_tcp_hdr *tcp = gro_flow_tcp(flow);
+	u8_t *ip = gro_flow_ip(flow);
+
+	if (flow->segs >= CONFIG_NET_GRO_MAX_SEGS ||
+	    flow->len + seg->data_len > UINT16_MAX ||
+	    flow->is_loopback != is_loopback ||
+	    sys_get_be32(seg->tcp->seq) != flow->next_seq ||
+	    memcmp(tcp->ack, seg->tcp->ack, sizeof(tcp->ack)) ||
+	    tcp->offset != seg->tcp->offset ||
+	    memcmp(tcp->optdata, seg->tcp->optdata,
+		   NET_TCP_HDR_LEN(tcp) - sizeof(struct net_tcp_hdr))) {
+		return false;
+	}
+
+	if (seg->family == AF_INET) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)ip;
+		struct net_ipv4_hdr *seg_hdr = (struct net_ipv4_hdr *)seg->ip;
+
+		return hdr->tos == seg_hdr->tos && hdr->ttl == seg_hdr->ttl;
+	}
+
+	/* Traffic class, flow label and hop limit */
+	return !memcmp(ip, seg->ip, 4) &&
+	       ((struct net_ipv6_hdr *)ip)->hop_limit ==
+	       ((struct net_ipv6_hdr *)seg->ip)->hop_limit;
+}
+
+static void gro_flow_flush(struct gro_queue *q, struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	flow->pkt = NULL;
+
+	if (flow->segs > 1) {
+#if defined(CONFIG_NET_IPV4)
+		if (net_pkt_family(pkt) == AF_INET) {
+			struct net_ipv4_hdr *hdr =
+				(struct net_ipv4_hdr *)pkt->buffer->data;
+
+			hdr->len = htons(flow->len);
+			hdr->chksum = 0U;
+			hdr->chksum = net_calc_chksum_ipv4(pkt);
+		}
+#endif
+#if defined(CONFIG_NET_IPV6)
+		if (net_pkt_family(pkt) == AF_INET6) {
+			struct net_ipv6_hdr *hdr =
+				(struct net_ipv6_hdr *)pkt->buffer->data;
+
+			hdr->len = htons(flow->len - sizeof(*hdr));
+		}
+#endif
+	}
+
+	net_pkt_set_gro_segs(pkt, flow->segs);
+
+	NET_DBG("pkt %p merged from %u segments, len %u", pkt, flow->segs,
+		flow->len);
+
+	/* Packets looped back meanwhile are not held, so that the flows
+	 * do not change under our feet.
+	 */
+	q->flushing = true;
+	net_gro_deliver(pkt, flow->is_loopback);
+	q->flushing = false;
+}
+
+static void gro_flush(struct gro_queue *q)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_GRO_FLOWS; i++) {
+		if (q->flows[i].pkt) {
+			gro_flow_flush(q, &q->flows[i]);
+		}
+	}
+
+	q->held = 0U;
+}
+
+static struct gro_flow *gro_flow_alloc(struct gro_queue *q)
+{
+	struct gro_flow *flow;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_GRO_FLOWS; i++) {
+		if (!q->flows[i].pkt) {
+			return &q->flows[i];
+		}
+	}
+
+	flow = &q->flows[q->evict];
+	q->evict = (q->evict + 1) % CONFIG_NET_GRO_FLOWS;
+
+	gro_flow_flush(q, flow);
+
+	return flow;
+}
+
+static void gro_flow_start(struct gro_flow *flow, struct net_pkt *pkt,
+			   struct gro_seg *seg, bool is_loopback)
+{
+	net_pkt_set_family(pkt, seg->family);
+	net_pkt_set_ip_hdr_len(pkt, seg->ip_hdr_len);
+
+	flow->pkt = pkt;
+	flow->next_seq = sys_get_be32(seg->tcp->seq) + seg->data_len;
+	flow->len = seg->ip_len;
+	flow->ip_hdr_len = seg->ip_hdr_len;
+	flow->segs = 1U;
+	flow->is_loopback = is_loopback;
+}
+
+static void gro_flow_merge(struct gro_flow *flow, struct net_pkt *pkt,
+			   struct gro_seg *seg)
+{
+	struct net_tcp_hdr *tcp = gro_flow_tcp(flow);
+
+	memcpy(tcp->wnd, seg->tcp->wnd, sizeof(tcp->wnd));
+	tcp->flags |= seg->tcp->flags & NET_TCP_PSH;
+
+	net_buf_pull(pkt->buffer, seg->hdr_len);
+	if (pkt->buffer->len == 0U) {
+		pkt->buffer = net_buf_frag_del(NULL, pkt->buffer);
+	}
+
+	net_pkt_append_buffer(flow->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	flow->next_seq += seg->data_len;
+	flow->len += seg->data_len;
+	flow->segs++;
+}
+
+enum net_verdict net_gro_receive(struct net_pkt *pkt, bool is_loopback)
+{
+	int idx = net_tc_rx_queue_current();
+	struct gro_flow *flow;
+	struct gro_seg seg;
+	struct gro_queue *q;
+
+	if (idx < 0 || gro_queues[idx].flushing || !gro_parse(pkt, &seg)) {
+		return NET_CONTINUE;
+	}
+
+	if (!gro_chksum_ok(pkt, &seg)) {
+		/* Dropped by the IP or TCP layer, with the statistics */
+		return NET_CONTINUE;
+	}
+
+	q = &gro_queues[idx];
+
+	flow = gro_flow_find(q, pkt, &seg);
+	if (flow) {
+		if (gro_can_merge(flow, &seg, is_loopback)) {
+			gro_flow_merge(flow, pkt, &seg);
+
+			if ((gro_flow_tcp(flow)->flags & NET_TCP_PSH) ||
+			    flow->segs >= CONFIG_NET_GRO_MAX_SEGS) {
+				gro_flow_flush(q, flow);
+			}
+
+			goto held;
+		}
+
+		gro_flow_flush(q, flow);
+	}
+
+	if (seg.tcp->flags & NET_TCP_PSH) {
+		net_pkt_set_gro_segs(pkt, 1U);
+		return NET_CONTINUE;
+	}
+
+	flow = gro_flow_alloc(q);
+	gro_flow_start(flow, pkt, &seg, is_loopback);
+
+held:
+	if (++q->held >= CONFIG_NET_GRO_BUDGET) {
+		gro_flush(q);
+	}
+
+	return NET_OK;
+}
+
+void net_gro_burst_end(void)
+{
+	int idx = net_tc_rx_queue_current();
+
+	if (idx < 0 || !gro_queues[idx].held) {
+		return;
+	}
+
+	if (net_tc_rx_queue_is_empty(idx)) {
+		gro_flush(&gro_queues[idx]);
+	}
+}
@@ -71,6 +71,176 @@ static struct {
 } ipv4_addresses[CONFIG_NET_IF_MAX_IPV4_COUNT];
 #endif /* CONFIG_NET_IPV4 */
 
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+/* The unicast and multicast addresses of all the interfaces are hashed on
+ * their last four bytes. The unicast address found by the previous lookup
+ * of each family is checked first, as most packets are for the same one.
+ */
+static sys_slist_t addr_hash[CONFIG_NET_IF_ADDR_HASH_SIZE];
+static sys_slist_t maddr_hash[CONFIG_NET_IF_ADDR_HASH_SIZE];
+static struct net_if_addr *ipv6_addr_last_hit;
+static struct net_if_addr *ipv4_addr_last_hit;
+
+static const u8_t *addr_hash_key(sa_family_t family, const void *addr)
+{
+	if (family == AF_INET6) {
+		return &((const struct in6_addr *)addr)->s6_addr[12];
+	}
+
+	return ((const struct in_addr *)addr)->s4_addr;
+}
+
+static bool addr_hash_cmp(const struct net_addr *entry, sa_family_t family,
+			  const void *addr)
+{
+	if (entry->family != family) {
+		return false;
+	}
+
+	if (family == AF_INET6) {
+		return !memcmp(&entry->in6_addr, addr, sizeof(struct in6_addr));
+	}
+
+	return !memcmp(&entry->in_addr, addr, sizeof(struct in_addr));
+}
+
+static sys_slist_t *addr_bucket(sys_slist_t *table, sa_family_t family,
+				const void *addr)
+{
+	const u8_t *key = addr_hash_key(family, addr);
+	u32_t hash = 2166136261U;
+	int i;
+
+	/* FNV-1a */
+	for (i = 0; i < 4; i++) {
+		hash = (hash ^ key[i]) * 16777619U;
+	}
+
+	return &table[hash % CONFIG_NET_IF_ADDR_HASH_SIZE];
+}
+
+static void addr_hash_add(struct net_if *iface, struct net_if_addr *ifaddr)
+{
+	ifaddr->iface = iface;
+	sys_slist_append(addr_bucket(addr_hash, ifaddr->address.family,
+				     &ifaddr->address.in6_addr),
+			 &ifaddr->hash_node);
+}
+
+static void addr_hash_del(struct net_if_addr *ifaddr)
+{
+	sys_slist_find_and_remove(addr_bucket(addr_hash,
+					      ifaddr->address.family,
+					      &ifaddr->address.in6_addr),
+				  &ifaddr->hash_node);
+
+	if (ipv6_addr_last_hit == ifaddr) {
+		ipv6_addr_last_hit = NULL;
+	}
+
+	if (ipv4_addr_last_hit == ifaddr) {
+		ipv4_addr_last_hit = NULL;
+	}
+}
+
+static struct net_if_addr *addr_hash_lookup(struct net_if_addr **last_hit,
+					    sa_family_t family,
+					    const void *addr,
+					    struct net_if **ret)
+{
+	struct net_if_addr *ifaddr = *last_hit;
+
+	if (!ifaddr || !addr_hash_cmp(&ifaddr->address, family, addr)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(addr_bucket(addr_hash, family,
+							 addr),
+					     ifaddr, hash_node) {
+			if (addr_hash_cmp(&ifaddr->address, family, addr)) {
+				break;
+			}
+		}
+
+		if (!ifaddr) {
+			return NULL;
+		}
+
+		*last_hit = ifaddr;
+	}
+
+	if (ret) {
+		*ret = ifaddr->iface;
+	}
+
+	return ifaddr;
+}
+
+static void maddr_hash_add(struct net_if *iface,
+			   struct net_if_mcast_addr *maddr)
+{
+	maddr->iface = iface;
+	sys_slist_append(addr_bucket(maddr_hash, maddr->address.family,
+				     &maddr->address.in6_addr),
+			 &maddr->hash_node);
+}
+
+static void maddr_hash_del(struct net_if_mcast_addr *maddr)
+{
+	sys_slist_find_and_remove(addr_bucket(maddr_hash,
+					      maddr->address.family,
+					      &maddr->address.in6_addr),
+				  &maddr->hash_node);
+}
+
+/* The same group may be joined on several interfaces, *ret selects one */
+static struct net_if_mcast_addr *maddr_hash_lookup(sa_family_t family,
+						   const void *addr,
+						   struct net_if **ret)
+{
+	struct net_if_mcast_addr *maddr;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(addr_bucket(maddr_hash, family, addr),
+				     maddr, hash_node) {
+		if (ret && *ret && maddr->iface != *ret) {
+			continue;
+		}
+
+		if (addr_hash_cmp(&maddr->address, family, addr)) {
+			if (ret) {
+				*ret = maddr->iface;
+			}
+
+			return maddr;
+		}
+	}
+
+	return NULL;
+}
+
+/* The addresses of an IP config released by its interface */
+static void addr_hash_del_all(struct net_if_addr *unicast, int unicast_count,
+			      struct net_if_mcast_addr *mcast, int mcast_count)
+{
+	int i;
+
+	for (i = 0; i < unicast_count; i++) {
+		if (unicast[i].is_used) {
+			addr_hash_del(&unicast[i]);
+		}
+	}
+
+	for (i = 0; i < mcast_count; i++) {
+		if (mcast[i].is_used) {
+			maddr_hash_del(&mcast[i]);
+		}
+	}
+}
+#else
+#define addr_hash_add(...)
+#define addr_hash_del(...)
+#define maddr_hash_add(...)
+#define maddr_hash_del(...)
+#define addr_hash_del_all(...)
+#endif /* CONFIG_NET_IF_ADDR_HASH */
+
 /* We keep track of the link callbacks in this list.
  */
 static sys_slist_t link_callbacks;
@@ -157,7 +327,11 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			net_pkt_set_queued(pkt, false);
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (net_pkt_tso_mss(pkt)) {
+			status = net_tcp_tso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 	} else {
 		/* Drop packet if interface is not up */
 		NET_WARN("iface %p is down", iface);
@@ -184,13 +358,60 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_L2_ETHERNET)
+/* Ethernet interface with packets sent from a TX queue since its last
+ * flush, only used from the thread of the queue.
+ */
+static struct net_if *tx_flush_iface[NET_TC_TX_COUNT];
+
+static void net_if_tx_flush(u8_t tc, struct net_if *iface)
+{
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		iface = NULL;
+	}
+
+	/* The packets of another interface are not held back until the
+	 * queue is empty.
+	 */
+	if (tx_flush_iface[tc] && tx_flush_iface[tc] != iface) {
+		net_eth_tx_flush(tx_flush_iface[tc]);
+		tx_flush_iface[tc] = NULL;
+	}
+
+	if (!iface) {
+		return;
+	}
+
+	if (net_tc_tx_queue_is_empty(tc)) {
+		net_eth_tx_flush(iface);
+		tx_flush_iface[tc] = NULL;
+	} else {
+		tx_flush_iface[tc] = iface;
+	}
+}
+#endif /* CONFIG_NET_L2_ETHERNET */
+
 static void process_tx_packet(struct k_work *work)
 {
 	struct net_pkt *pkt;
+	struct net_if *iface;
+#if defined(CONFIG_NET_L2_ETHERNET)
+	u8_t tc;
+#endif
 
 	pkt = CONTAINER_OF(work, struct net_pkt, work);
+	iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	/* The packet may be gone once sent */
+	tc = net_tx_priority2tc(net_pkt_priority(pkt));
+#endif
 
-	net_if_tx(net_pkt_iface(pkt), pkt);
+	net_if_tx(iface, pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	net_if_tx_flush(tc, iface);
+#endif
 }
 
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
@@ -451,6 +672,11 @@ int net_if_config_ipv6_put(struct net_if *iface)
 			continue;
 		}
 
+		addr_hash_del_all(ipv6_addresses[i].ipv6.unicast,
+				  NET_IF_MAX_IPV6_ADDR,
+				  ipv6_addresses[i].ipv6.mcast,
+				  NET_IF_MAX_IPV6_MADDR);
+
 		iface->config.ip.ipv6 = NULL;
 		ipv6_addresses[i].iface = NULL;
 
@@ -531,6 +757,7 @@ static void dad_timeout(struct k_work *work)
 		log_strdup(net_sprint_ipv6_addr(&ifaddr->address.in6_addr)));
 
 	ifaddr->addr_state = NET_ADDR_PREFERRED;
+	ifaddr->is_optimistic = false;
 
 	/* Because we do not know the interface at this point, we need to
 	 * lookup for it.
@@ -551,6 +778,12 @@ static void net_if_ipv6_start_dad(struct net_if *iface,
 {
 	ifaddr->addr_state = NET_ADDR_TENTATIVE;
 
+	/* RFC 4429 ch 3.1, only addresses unlikely to be duplicated, the
+	 * autoconfigured ones, may be optimistic.
+	 */
+	ifaddr->is_optimistic = IS_ENABLED(CONFIG_NET_IPV6_OPTIMISTIC_DAD) &&
+				ifaddr->addr_type == NET_ADDR_AUTOCONF;
+
 	if (net_if_is_up(iface)) {
 		NET_DBG("Interface %p ll addr %s tentative IPv6 addr %s",
 			iface,
@@ -687,7 +920,9 @@ void net_if_start_rs(struct net_if *iface)
 struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 					    struct net_if **ret)
 {
-#if defined(CONFIG_NET_IPV6)
+#if defined(CONFIG_NET_IPV6) && defined(CONFIG_NET_IF_ADDR_HASH)
+	return addr_hash_lookup(&ipv6_addr_last_hit, AF_INET6, addr, ret);
+#elif defined(CONFIG_NET_IPV6)
 	struct net_if *iface;
 
 	for (iface = __net_if_start; iface != __net_if_end; iface++) {
@@ -1007,6 +1242,7 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 
 		net_if_addr_init(&ipv6->unicast[i], addr, addr_type,
 				 vlifetime);
+		addr_hash_add(iface, &ipv6->unicast[i]);
 
 		NET_DBG("[%d] interface %p address %s type %s added", i,
 			iface, log_strdup(net_sprint_ipv6_addr(addr)),
@@ -1069,6 +1305,7 @@ bool net_if_ipv6_addr_rm(struct net_if *iface, const struct in6_addr *addr)
 		}
 
 		ipv6->unicast[i].is_used = false;
+		addr_hash_del(&ipv6->unicast[i]);
 
 		net_ipv6_addr_create_solicited_node(addr, &maddr);
 
@@ -1112,6 +1349,7 @@ struct net_if_mcast_addr *net_if_ipv6_maddr_add(struct net_if *iface,
 		ipv6->mcast[i].is_used = true;
 		ipv6->mcast[i].address.family = AF_INET6;
 		memcpy(&ipv6->mcast[i].address.in6_addr, addr, 16);
+		maddr_hash_add(iface, &ipv6->mcast[i]);
 
 		NET_DBG("[%d] interface %p address %s added", i, iface,
 			log_strdup(net_sprint_ipv6_addr(addr)));
@@ -1146,6 +1384,7 @@ bool net_if_ipv6_maddr_rm(struct net_if *iface, const struct in6_addr *addr)
 		}
 
 		ipv6->mcast[i].is_used = false;
+		maddr_hash_del(&ipv6->mcast[i]);
 
 		NET_DBG("[%d] interface %p address %s removed",
 			i, iface, log_strdup(net_sprint_ipv6_addr(addr)));
@@ -1162,7 +1401,9 @@ bool net_if_ipv6_maddr_rm(struct net_if *iface, const struct in6_addr *addr)
 struct net_if_mcast_addr *net_if_ipv6_maddr_lookup(const struct in6_addr *maddr,
 						   struct net_if **ret)
 {
-#if defined(CONFIG_NET_IPV6)
+#if defined(CONFIG_NET_IPV6) && defined(CONFIG_NET_IF_ADDR_HASH)
+	return maddr_hash_lookup(AF_INET6, maddr, ret);
+#elif defined(CONFIG_NET_IPV6)
 	struct net_if *iface;
 
 	for (iface = __net_if_start; iface != __net_if_end; iface++) {
@@ -1271,6 +1512,8 @@ static void prefix_lifetime_expired(struct net_if_ipv6_prefix *ifprefix)
 
 	ifprefix->is_used = false;
 
+	net_ipv6_dst_cache_invalidate();
+
 	if (net_if_config_ipv6_get(ifprefix->iface, &ipv6) < 0) {
 		return;
 	}
@@ -1476,6 +1719,8 @@ struct net_if_ipv6_prefix *net_if_ipv6_prefix_add(struct net_if *iface,
 		net_if_ipv6_prefix_init(iface, &ipv6->prefix[i], prefix,
 					len, lifetime);
 
+		net_ipv6_dst_cache_invalidate();
+
 		NET_DBG("[%d] interface %p prefix %s/%d added", i, iface,
 			log_strdup(net_sprint_ipv6_addr(prefix)), len);
 
@@ -1513,6 +1758,8 @@ bool net_if_ipv6_prefix_rm(struct net_if *iface, struct in6_addr *addr,
 
 		ipv6->prefix[i].is_used = false;
 
+		net_ipv6_dst_cache_invalidate();
+
 		/* Remove also all auto addresses if the they have the same
 		 * prefix.
 		 */
@@ -1709,6 +1956,8 @@ static void ipv6_router_expired(struct k_work *work)
 		log_strdup(net_sprint_ipv6_addr(&router->address.in6_addr)));
 
 	router->is_used = false;
+
+	net_ipv6_dst_cache_invalidate();
 }
 #endif /* CONFIG_NET_IPV6 */
 
@@ -1768,6 +2017,8 @@ struct net_if_router *net_if_ipv6_router_add(struct net_if *iface,
 
 		net_if_router_init(&routers[i], iface, addr, lifetime);
 
+		net_ipv6_dst_cache_invalidate();
+
 		NET_DBG("[%d] interface %p router %s lifetime %u default %d "
 			"added",
 			i, iface, log_strdup(net_sprint_ipv6_addr(addr)),
@@ -1800,6 +2051,8 @@ bool net_if_ipv6_router_rm(struct net_if_router *router)
 
 		routers[i].is_used = false;
 
+		net_ipv6_dst_cache_invalidate();
+
 		net_mgmt_event_notify(NET_EVENT_IPV6_ROUTER_DEL,
 				      routers[i].iface);
 
@@ -1926,9 +2179,15 @@ static u8_t get_diff_ipv6(const struct in6_addr *src,
 	return get_ipaddr_diff((const u8_t *)src, (const u8_t *)dst, 16);
 }
 
+static inline bool is_usable_ipv6_address(struct net_if_addr *addr)
+{
+	return addr->addr_state == NET_ADDR_PREFERRED ||
+	       (addr->addr_state == NET_ADDR_TENTATIVE && addr->is_optimistic);
+}
+
 static inline bool is_proper_ipv6_address(struct net_if_addr *addr)
 {
-	if (addr->is_used && addr->addr_state == NET_ADDR_PREFERRED &&
+	if (addr->is_used && is_usable_ipv6_address(addr) &&
 	    addr->address.family == AF_INET6 &&
 	    !net_ipv6_is_ll_addr(&addr->address.in6_addr)) {
 		return true;
@@ -1964,6 +2223,14 @@ static struct in6_addr *net_if_ipv6_get_best_match(struct net_if *iface,
 				continue;
 			}
 
+			/* RFC 4429 ch 3.2, an optimistic address does not
+			 * replace an equally good preferred one.
+			 */
+			if (ipv6->unicast[i].is_optimistic && src &&
+			    len == *best_so_far) {
+				continue;
+			}
+
 			*best_so_far = len;
 			src = &ipv6->unicast[i].address.in6_addr;
 		}
@@ -1971,6 +2238,31 @@ static struct in6_addr *net_if_ipv6_get_best_match(struct net_if *iface,
 
 	return src;
 }
+
+/* Link local address to use as a source, optimistic ones as a last resort */
+static struct in6_addr *net_if_ipv6_get_ll_src(struct net_if *iface)
+{
+	struct net_if_ipv6 *ipv6 = iface->config.ip.ipv6;
+	struct in6_addr *src;
+	int i;
+
+	src = net_if_ipv6_get_ll(iface, NET_ADDR_PREFERRED);
+	if (src || !IS_ENABLED(CONFIG_NET_IPV6_OPTIMISTIC_DAD) || !ipv6) {
+		return src;
+	}
+
+	for (i = 0; i < NET_IF_MAX_IPV6_ADDR; i++) {
+		if (ipv6->unicast[i].is_used &&
+		    ipv6->unicast[i].is_optimistic &&
+		    ipv6->unicast[i].addr_state == NET_ADDR_TENTATIVE &&
+		    ipv6->unicast[i].address.family == AF_INET6 &&
+		    net_ipv6_is_ll_addr(&ipv6->unicast[i].address.in6_addr)) {
+			return &ipv6->unicast[i].address.in6_addr;
+		}
+	}
+
+	return NULL;
+}
 #endif /* CONFIG_NET_IPV6 */
 
 const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
@@ -2007,7 +2299,7 @@ const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 		     iface++) {
 			struct in6_addr *addr;
 
-			addr = net_if_ipv6_get_ll(iface, NET_ADDR_PREFERRED);
+			addr = net_if_ipv6_get_ll_src(iface);
 			if (addr) {
 				src = addr;
 				break;
@@ -2015,7 +2307,7 @@ const struct in6_addr *net_if_ipv6_select_src_addr(struct net_if *dst_iface,
 		}
 
 		if (dst_iface) {
-			src = net_if_ipv6_get_ll(dst_iface, NET_ADDR_PREFERRED);
+			src = net_if_ipv6_get_ll_src(dst_iface);
 		}
 	}
 
@@ -2118,6 +2410,11 @@ int net_if_config_ipv4_put(struct net_if *iface)
 			continue;
 		}
 
+		addr_hash_del_all(ipv4_addresses[i].ipv4.unicast,
+				  NET_IF_MAX_IPV4_ADDR,
+				  ipv4_addresses[i].ipv4.mcast,
+				  NET_IF_MAX_IPV4_MADDR);
+
 		iface->config.ip.ipv4 = NULL;
 		ipv4_addresses[i].iface = NULL;
 
@@ -2447,7 +2744,9 @@ const struct in_addr *net_if_ipv4_select_src_addr(struct net_if *dst_iface,
 struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
 					    struct net_if **ret)
 {
-#if defined(CONFIG_NET_IPV4)
+#if defined(CONFIG_NET_IPV4) && defined(CONFIG_NET_IF_ADDR_HASH)
+	return addr_hash_lookup(&ipv4_addr_last_hit, AF_INET, addr, ret);
+#elif defined(CONFIG_NET_IPV4)
 	struct net_if *iface;
 
 	for (iface = __net_if_start; iface != __net_if_end; iface++) {
@@ -2538,11 +2837,17 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 	}
 
 	if (ifaddr) {
+		/* An overridable address is replaced in place */
+		if (ifaddr->is_used) {
+			addr_hash_del(ifaddr);
+		}
+
 		ifaddr->is_used = true;
 		ifaddr->address.family = AF_INET;
 		ifaddr->address.in_addr.s4_addr32[0] =
 						addr->s4_addr32[0];
 		ifaddr->addr_type = addr_type;
+		addr_hash_add(iface, ifaddr);
 
 		/* Caller has to take care of timers and their expiry */
 		if (vlifetime) {
@@ -2591,6 +2896,7 @@ bool net_if_ipv4_addr_rm(struct net_if *iface, struct in_addr *addr)
 		}
 
 		ipv4->unicast[i].is_used = false;
+		addr_hash_del(&ipv4->unicast[i]);
 
 		NET_DBG("[%d] interface %p address %s removed",
 			i, iface, log_strdup(net_sprint_ipv4_addr(addr)));
@@ -2657,6 +2963,7 @@ struct net_if_mcast_addr *net_if_ipv4_maddr_add(struct net_if *iface,
 		maddr->is_used = true;
 		maddr->address.family = AF_INET;
 		maddr->address.in_addr.s4_addr32[0] = addr->s4_addr32[0];
+		maddr_hash_add(iface, maddr);
 
 		NET_DBG("interface %p address %s added", iface,
 			log_strdup(net_sprint_ipv4_addr(addr)));
@@ -2676,6 +2983,7 @@ bool net_if_ipv4_maddr_rm(struct net_if *iface, const struct in_addr *addr)
 	maddr = ipv4_maddr_find(iface, true, addr);
 	if (maddr) {
 		maddr->is_used = false;
+		maddr_hash_del(maddr);
 
 		NET_DBG("interface %p address %s removed",
 			iface, log_strdup(net_sprint_ipv4_addr(addr)));
@@ -2690,7 +2998,9 @@ bool net_if_ipv4_maddr_rm(struct net_if *iface, const struct in_addr *addr)
 struct net_if_mcast_addr *net_if_ipv4_maddr_lookup(const struct in_addr *maddr,
 						   struct net_if **ret)
 {
-#if defined(CONFIG_NET_IPV4)
+#if defined(CONFIG_NET_IPV4) && defined(CONFIG_NET_IF_ADDR_HASH)
+	return maddr_hash_lookup(AF_INET, maddr, ret);
+#elif defined(CONFIG_NET_IPV4)
 	struct net_if_mcast_addr *addr;
 	struct net_if *iface;
 
@@ -156,6 +156,166 @@ static inline bool mgmt_is_event_handled(u32_t mgmt_event)
 		 NET_MGMT_GET_COMMAND(mgmt_event)));
 }
 
+static inline bool mgmt_event_matches(u32_t mgmt_event, u32_t event_mask)
+{
+	return (NET_MGMT_GET_LAYER(mgmt_event) ==
+		NET_MGMT_GET_LAYER(event_mask)) &&
+	       (NET_MGMT_GET_LAYER_CODE(mgmt_event) ==
+		NET_MGMT_GET_LAYER_CODE(event_mask)) &&
+	       !(NET_MGMT_GET_COMMAND(mgmt_event) &&
+		 NET_MGMT_GET_COMMAND(event_mask) &&
+		 !(NET_MGMT_GET_COMMAND(mgmt_event) &
+		   NET_MGMT_GET_COMMAND(event_mask)));
+}
+
+#if defined(CONFIG_NET_MGMT_EVENT_RING)
+static sys_slist_t event_rings;
+static K_MUTEX_DEFINE(event_rings_lock);
+
+static bool mgmt_ring_entry_is(struct net_mgmt_event_ring_entry *entry,
+			       u32_t mgmt_event, struct net_if *iface,
+			       void *info, size_t length)
+{
+	if (entry->event != mgmt_event || entry->iface != iface) {
+		return false;
+	}
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+	if (entry->info_length != length ||
+	    (length && memcmp(entry->info, info, length))) {
+		return false;
+	}
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+	return true;
+}
+
+static void mgmt_ring_push(struct net_mgmt_event_ring *ring,
+			   u32_t mgmt_event, struct net_if *iface,
+			   void *info, size_t length)
+{
+	struct net_mgmt_event_ring_entry *entry;
+
+	if (ring->count && ring->coalesce) {
+		entry = &ring->entries[(ring->head + ring->count - 1) %
+				       ring->size];
+
+		if (mgmt_ring_entry_is(entry, mgmt_event, iface,
+				       info, length)) {
+			if (entry->count < UINT16_MAX) {
+				entry->count++;
+			}
+
+			return;
+		}
+	}
+
+	if (ring->count == ring->size) {
+		ring->dropped++;
+		return;
+	}
+
+	entry = &ring->entries[(ring->head + ring->count) % ring->size];
+	entry->event = mgmt_event;
+	entry->iface = iface;
+	entry->count = 1U;
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+	if (info && length <= sizeof(entry->info)) {
+		memcpy(entry->info, info, length);
+		entry->info_length = length;
+	} else {
+		entry->info_length = 0U;
+	}
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+	ring->count++;
+
+	k_sem_give(&ring->sem);
+}
+
+static void mgmt_push_rings(u32_t mgmt_event, struct net_if *iface,
+			    void *info, size_t length)
+{
+	struct net_mgmt_event_ring *ring;
+
+#ifndef CONFIG_NET_MGMT_EVENT_INFO
+	info = NULL;
+	length = 0;
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+	k_mutex_lock(&event_rings_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&event_rings, ring, node) {
+		if (mgmt_event_matches(mgmt_event, ring->event_mask)) {
+			mgmt_ring_push(ring, mgmt_event, iface, info, length);
+		}
+	}
+
+	k_mutex_unlock(&event_rings_lock);
+}
+
+void net_mgmt_event_ring_init(struct net_mgmt_event_ring *ring,
+			      struct net_mgmt_event_ring_entry *entries,
+			      u16_t size, u32_t mgmt_event_mask,
+			      bool coalesce)
+{
+	__ASSERT(ring, "Ring pointer should not be NULL");
+	__ASSERT(entries && size, "Ring needs entries");
+
+	k_sem_init(&ring->sem, 0, size);
+	ring->event_mask = mgmt_event_mask;
+	ring->entries = entries;
+	ring->size = size;
+	ring->head = 0U;
+	ring->count = 0U;
+	ring->dropped = 0U;
+	ring->coalesce = coalesce;
+}
+
+void net_mgmt_add_event_ring(struct net_mgmt_event_ring *ring)
+{
+	NET_DBG("Adding event ring %p", ring);
+
+	k_mutex_lock(&event_rings_lock, K_FOREVER);
+	sys_slist_append(&event_rings, &ring->node);
+	k_mutex_unlock(&event_rings_lock);
+}
+
+void net_mgmt_del_event_ring(struct net_mgmt_event_ring *ring)
+{
+	NET_DBG("Deleting event ring %p", ring);
+
+	k_mutex_lock(&event_rings_lock, K_FOREVER);
+	sys_slist_find_and_remove(&event_rings, &ring->node);
+	k_mutex_unlock(&event_rings_lock);
+}
+
+int net_mgmt_event_ring_get(struct net_mgmt_event_ring *ring,
+			    struct net_mgmt_event_ring_entry *entry,
+			    s32_t timeout)
+{
+	int ret;
+
+	ret = k_sem_take(&ring->sem, timeout);
+	if (ret) {
+		return -EAGAIN;
+	}
+
+	k_mutex_lock(&event_rings_lock, K_FOREVER);
+
+	*entry = ring->entries[ring->head];
+	ring->head = (ring->head + 1) % ring->size;
+	ring->count--;
+
+	k_mutex_unlock(&event_rings_lock);
+
+	return 0;
+}
+#else
+#define mgmt_push_rings(...)
+#endif /* CONFIG_NET_MGMT_EVENT_RING */
+
 static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 {
 	sys_snode_t *prev = NULL;
@@ -167,14 +327,7 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
-		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER_CODE(cb->event_mask)) ||
-		    (NET_MGMT_GET_COMMAND(mgmt_event->event) &&
-		     NET_MGMT_GET_COMMAND(cb->event_mask) &&
-		     !(NET_MGMT_GET_COMMAND(mgmt_event->event) &
-		       NET_MGMT_GET_COMMAND(cb->event_mask)))) {
+		if (!mgmt_event_matches(mgmt_event->event, cb->event_mask)) {
 			continue;
 		}
 
@@ -332,6 +485,8 @@ void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 void net_mgmt_event_notify_with_info(u32_t mgmt_event, struct net_if *iface,
 				     void *info, size_t length)
 {
+	mgmt_push_rings(mgmt_event, iface, info, length);
+
 	if (mgmt_is_event_handled(mgmt_event)) {
 		NET_DBG("Notifying Event layer %u code %u type %u",
 			NET_MGMT_GET_LAYER(mgmt_event),
@@ -0,0 +1,118 @@
+/** @file
+ * @brief Polled reception for network drivers
+ *
+ * All the devices are polled from one work queue. A device which used
+ * up its budget is put back at the end of the queue, behind the other
+ * devices, after yielding to the threads of the same priority.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_core, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+#include <net/net_if.h>
+#include <net/net_napi.h>
+
+#include "net_private.h"
+
+NET_STACK_DEFINE(NAPI, napi_stack, CONFIG_NET_NAPI_STACK_SIZE,
+		 CONFIG_NET_NAPI_STACK_SIZE);
+static struct k_work_q napi_work_q;
+
+static sys_slist_t napi_list = SYS_SLIST_STATIC_INIT(&napi_list);
+static K_MUTEX_DEFINE(napi_lock);
+
+static void napi_poll(struct k_work *work)
+{
+	struct net_napi *napi = CONTAINER_OF(work, struct net_napi, work);
+	int budget = napi->budget;
+	int done;
+
+	done = napi->poll(napi, budget);
+
+	napi->stats.polls++;
+	napi->stats.frames += done;
+
+	if (done < budget) {
+		return;
+	}
+
+	/* Still scheduled, the device has more frames */
+	napi->stats.exhausted++;
+
+	k_work_submit_to_queue(&napi_work_q, &napi->work);
+	k_yield();
+}
+
+void net_napi_init(struct net_napi *napi, struct net_if *iface,
+		   net_napi_poll_t poll)
+{
+	k_work_init(&napi->work, napi_poll);
+	atomic_clear(&napi->scheduled);
+	(void)memset(&napi->stats, 0, sizeof(napi->stats));
+
+	napi->poll = poll;
+	napi->iface = iface;
+	napi->budget = CONFIG_NET_NAPI_BUDGET;
+
+	k_mutex_lock(&napi_lock, K_FOREVER);
+	sys_slist_append(&napi_list, &napi->node);
+	k_mutex_unlock(&napi_lock);
+}
+
+void net_napi_schedule(struct net_napi *napi)
+{
+	if (atomic_set(&napi->scheduled, 1)) {
+		return;
+	}
+
+	napi->stats.scheduled++;
+
+	k_work_submit_to_queue(&napi_work_q, &napi->work);
+}
+
+struct net_napi *net_napi_get(struct net_if *iface)
+{
+	struct net_napi *napi, *found = NULL;
+
+	k_mutex_lock(&napi_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&napi_list, napi, node) {
+		if (napi->iface == iface) {
+			found = napi;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&napi_lock);
+
+	return found;
+}
+
+void net_napi_foreach(net_napi_cb_t cb, void *user_data)
+{
+	struct net_napi *napi;
+
+	k_mutex_lock(&napi_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&napi_list, napi, node) {
+		cb(napi, user_data);
+	}
+
+	k_mutex_unlock(&napi_lock);
+}
+
+void net_napi_start(void)
+{
+	k_work_q_start(&napi_work_q, napi_stack,
+		       K_THREAD_STACK_SIZEOF(napi_stack),
+		       K_PRIO_PREEMPT(CONFIG_NET_NAPI_THREAD_PRIO));
+	k_thread_name_set(&napi_work_q.thread, "net_napi");
+}
@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #include <sys/types.h>
 
 #include <misc/util.h>
+#include <app_memory/app_memdomain.h>
 
 #include <net/net_core.h>
 #include <net/net_ip.h>
@@ -112,7 +113,20 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 K_MEM_SLAB_DEFINE(rx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_RX_COUNT, 4);
 K_MEM_SLAB_DEFINE(tx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_TX_COUNT, 4);
 
-#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_USER)
+
+/* Received data is handed to user mode threads by zero-copy receive, they
+ * need to be granted read access to it.
+ */
+K_APPMEM_PARTITION_DEFINE(net_zc_partition);
+
+NET_BUF_POOL_FIXED_DEFINE_IN(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
+			     CONFIG_NET_BUF_DATA_SIZE, NULL,
+			     K_APP_BMEM(net_zc_partition));
+NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
+			  CONFIG_NET_BUF_DATA_SIZE, NULL);
+
+#elif defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 
 NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
 			  CONFIG_NET_BUF_DATA_SIZE, NULL);
@@ -705,6 +719,8 @@ struct net_buf *net_pkt_frag_del(struct net_pkt *pkt,
 		tmp = net_buf_frag_del(NULL, frag);
 		pkt->frags = tmp;
 
+		net_pkt_hdr_cache_clear(pkt);
+
 		return tmp;
 	}
 
@@ -750,6 +766,8 @@ void net_pkt_frag_insert(struct net_pkt *pkt, struct net_buf *frag)
 
 	net_buf_frag_last(frag)->frags = pkt->frags;
 	pkt->frags = frag;
+
+	net_pkt_hdr_cache_clear(pkt);
 }
 
 bool net_pkt_compact(struct net_pkt *pkt)
@@ -972,6 +990,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_TSO)
+	/* A TCP segmentation offload packet is cut to the MTU later on */
+	if (net_pkt_tso_mss(pkt)) {
+		max_len = MAX(max_len, CONFIG_NET_TCP_TSO_MAX_SIZE);
+	}
+#endif
+
 	max_len -= existing;
 
 	return MIN(size, max_len);
@@ -1482,10 +1507,24 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_UDP)
+static void data_chksum_copy(struct net_pkt *pkt, void *dst, const void *src,
+			     size_t len)
+{
+	u16_t part = net_chksum_copy(0, dst, src, len);
+
+	pkt->data_chksum = net_chksum_append(pkt->data_chksum, part,
+					     pkt->data_chksum_len);
+	pkt->data_chksum_len += len;
+}
+#else
+#define data_chksum_copy(...)
+#endif
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
-				  bool copy, bool write)
+				  bool copy, bool write, bool chksum)
 {
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
@@ -1515,7 +1554,9 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			len = d_len;
 		}
 
-		if (copy) {
+		if (IS_ENABLED(CONFIG_NET_UDP) && chksum) {
+			data_chksum_copy(pkt, c_op->pos, data, len);
+		} else if (copy) {
 			memcpy(write ? c_op->pos : data,
 			       write ? data : c_op->pos,
 			       len);
@@ -1548,21 +1589,22 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
-	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
+	return net_pkt_cursor_operate(pkt, NULL, skip, false, true, false);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
-	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
+	return net_pkt_cursor_operate(pkt, &byte, amount, false, true,
+				      false);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	return net_pkt_cursor_operate(pkt, data, length, true, false);
+	return net_pkt_cursor_operate(pkt, data, length, true, false, false);
 }
 
 int net_pkt_read_be16(struct net_pkt *pkt, u16_t *data)
@@ -1597,7 +1639,33 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 		return net_pkt_skip(pkt, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      false);
+}
+
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data,
+			 size_t length)
+{
+#if defined(CONFIG_NET_UDP)
+	int ret;
+
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	if (!pkt->data_chksum_valid) {
+		pkt->data_chksum = 0U;
+		pkt->data_chksum_len = 0U;
+	}
+
+	ret = net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				     true);
+
+	/* A partial write leaves the sum unusable */
+	pkt->data_chksum_valid = (ret == 0);
+
+	return ret;
+#else
+	return net_pkt_write(pkt, data, length);
+#endif
 }
 
 int net_pkt_copy(struct net_pkt *pkt_dst,
@@ -1689,6 +1757,7 @@ struct net_pkt *net_pkt_clone(struct net_pkt *pkt, s32_t timeout)
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
+	net_pkt_set_tso_mss(clone_pkt, net_pkt_tso_mss(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -1746,6 +1815,14 @@ int net_pkt_update_length(struct net_pkt *pkt, size_t length)
 		}
 	}
 
+#if defined(CONFIG_NET_PKT_HDR_CACHE)
+	if (pkt->hdr_cache && pkt->buffer) {
+		pkt->hdr_cache_len = MIN(pkt->hdr_cache_len,
+					 pkt->buffer->data + pkt->buffer->len -
+					 pkt->hdr_cache);
+	}
+#endif
+
 	return !length ? 0 : -EINVAL;
 }
 
@@ -1754,10 +1831,12 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 	struct net_pkt_cursor *c_op = &pkt->cursor;
 	struct net_pkt_cursor backup;
 
+	net_pkt_hdr_cache_clear(pkt);
+
 	net_pkt_cursor_backup(pkt, &backup);
 
 	while (length) {
-		u8_t left, rem;
+		size_t left, rem;
 
 		pkt_cursor_advance(pkt, false);
 
@@ -1774,7 +1853,7 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 		c_op->buf->len -= rem;
 		left -= rem;
 		if (left) {
-			memmove(c_op->pos, c_op->pos+rem, rem);
+			memmove(c_op->pos, c_op->pos+rem, left);
 		}
 
 		/* For now, empty buffer are not freed, and there is no
@@ -1895,4 +1974,9 @@ void net_pkt_init(void)
 		get_frees(&rx_bufs), get_size(&rx_bufs),
 		get_frees(&tx_bufs), get_size(&tx_bufs));
 #endif
+
+#if defined(CONFIG_NET_BUF_BORROW)
+	net_buf_pool_join(&rx_bufs, &tx_bufs, CONFIG_NET_BUF_RX_RESERVE);
+	tx_bufs.reserve = CONFIG_NET_BUF_TX_RESERVE;
+#endif
 }
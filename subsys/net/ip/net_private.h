@@ -49,6 +49,15 @@ extern void net_tc_tx_init(void);
 extern void net_tc_rx_init(void);
 extern void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt);
+extern int net_tc_rx_queue_current(void);
+extern bool net_tc_rx_queue_is_empty(int idx);
+extern bool net_tc_tx_queue_is_empty(u8_t tc);
+
+#if defined(CONFIG_NET_NAPI)
+extern void net_napi_start(void);
+#else
+#define net_napi_start()
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -76,6 +85,37 @@ enum net_verdict net_gptp_recv(struct net_if *iface, struct net_pkt *pkt);
 #define net_gptp_recv(iface, pkt)
 #endif /* CONFIG_NET_GPTP */
 
+#if defined(CONFIG_NET_TCP_TSO)
+/**
+ * @brief Send a TCP segmentation offload packet.
+ *
+ * The packet is cut into segments of net_pkt_tso_mss() bytes unless the
+ * device does it. Same semantics as the send() of the L2.
+ */
+int net_tcp_tso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+#define net_tcp_tso_send(iface, pkt) -ENOTSUP
+#endif /* CONFIG_NET_TCP_TSO */
+
+#if defined(CONFIG_NET_GRO)
+/* Hold a received packet, its L2 header removed, for merging with the
+ * next segments of its TCP flow. Returns NET_OK if the packet is held,
+ * NET_CONTINUE if it is to be processed now.
+ */
+enum net_verdict net_gro_receive(struct net_pkt *pkt, bool is_loopback);
+
+/* Called after each packet processed by an Rx queue, delivers the held
+ * packets when the burst is over.
+ */
+void net_gro_burst_end(void);
+
+/* IP processing of a packet delivered by the receive coalescing */
+void net_gro_deliver(struct net_pkt *pkt, bool is_loopback);
+#else
+#define net_gro_receive(pkt, is_loopback) NET_CONTINUE
+#define net_gro_burst_end()
+#endif /* CONFIG_NET_GRO */
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 int net_ipv6_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
 				 u16_t pkt_len);
@@ -87,6 +127,15 @@ extern char *net_sprint_ll_addr_buf(const u8_t *ll, u8_t ll_len,
 				    char *buf, int buflen);
 extern u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto);
 
+/* Copy len bytes from src to dst, adding them to the one's complement sum */
+extern u16_t net_chksum_copy(u16_t sum, void *dst, const void *src,
+			     size_t len);
+
+/* Add the sum of some data found at the given offset from the start of
+ * the data summed so far.
+ */
+extern u16_t net_chksum_append(u16_t sum, u16_t part, size_t offset);
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -20,6 +20,7 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 #include <shell/shell_uart.h>
 
 #include <net/net_if.h>
+#include <net/net_napi.h>
 #include <net/dns_resolve.h>
 #include <misc/printk.h>
 
@@ -53,6 +54,9 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 #include "ethernet/gptp/gptp_state.h"
 #include "ethernet/gptp/gptp_data_set.h"
 #include "ethernet/gptp/gptp_private.h"
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+#include "ethernet/gptp/gptp_servo.h"
+#endif
 #endif
 
 #include "net_shell.h"
@@ -364,12 +368,13 @@ static void iface_cb(struct net_if *iface, void *user_data)
 			continue;
 		}
 
-		PR("\t%s %s %s%s%s\n",
+		PR("\t%s %s %s%s%s%s\n",
 		   net_sprint_ipv6_addr(&unicast->address.in6_addr),
 		   addrtype2str(unicast->addr_type),
 		   addrstate2str(unicast->addr_state),
 		   unicast->is_infinite ? " infinite" : "",
-		   unicast->is_mesh_local ? " meshlocal" : "");
+		   unicast->is_mesh_local ? " meshlocal" : "",
+		   unicast->is_optimistic ? " optimistic" : "");
 		count++;
 	}
 
@@ -704,6 +709,16 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv6_nd.sent),
 	   GET_STAT(iface, ipv6_nd.drop));
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+	PR("IPv6 frag reassembled %d\ttimeout\t%d\tevicted\t%d\n",
+	   GET_STAT(iface, ipv6_frag.reassembled),
+	   GET_STAT(iface, ipv6_frag.timeout),
+	   GET_STAT(iface, ipv6_frag.evicted));
+	PR("IPv6 frag overlap %d\tduplicate\t%d\tdrop\t%d\n",
+	   GET_STAT(iface, ipv6_frag.overlap),
+	   GET_STAT(iface, ipv6_frag.duplicate),
+	   GET_STAT(iface, ipv6_frag.drop));
+#endif /* CONFIG_NET_STATISTICS_IPV6_FRAGMENT */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	PR("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d\n",
 	   GET_STAT(iface, ipv6_mld.recv),
@@ -1435,6 +1450,82 @@ static int cmd_net_dns_cancel(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void dns_cache_cb(const char *name, enum dns_query_type type,
+			 const struct dns_addrinfo *info, u32_t ttl,
+			 void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	char addr[NET_IPV6_ADDR_LEN];
+
+	if (*count == 0) {
+		PR("     TTL  Type  Name -> Address\n");
+	}
+
+	(*count)++;
+
+	if (!info) {
+		strcpy(addr, "<no address>");
+	} else {
+		net_addr_ntop(info->ai_family,
+			      info->ai_family == AF_INET ?
+			      (void *)&net_sin(&info->ai_addr)->sin_addr :
+			      (void *)&net_sin6(&info->ai_addr)->sin6_addr,
+			      addr, sizeof(addr));
+	}
+
+	PR("%8u  %-4s  %s -> %s\n", ttl,
+	   type == DNS_QUERY_TYPE_A ? "A" : "AAAA", name, addr);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+static int cmd_net_dns_cache(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct net_shell_user_data user_data;
+	int count = 0;
+#endif
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	user_data.shell = shell;
+	user_data.user_data = &count;
+
+	dns_cache_foreach(dns_cache_cb, &user_data);
+
+	if (count == 0) {
+		PR("DNS cache is empty.\n");
+	}
+#else
+	PR_INFO("DNS cache not supported. Set CONFIG_DNS_RESOLVER_CACHE to "
+		"enable it.\n");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_dns_flush(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	dns_cache_flush();
+	PR("DNS cache flushed.\n");
+#else
+	PR_INFO("DNS cache not supported. Set CONFIG_DNS_RESOLVER_CACHE to "
+		"enable it.\n");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_query(const struct shell *shell, size_t argc,
 			     char *argv[])
 {
@@ -2054,6 +2145,56 @@ static int cmd_net_gptp_port(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+static void gptp_print_servo_hist(const struct shell *shell, const char *name,
+				  const u32_t *hist)
+{
+	int i;
+
+	PR("%s histogram:\n", name);
+
+	for (i = 0; i < GPTP_SERVO_HIST_BUCKETS - 1; i++) {
+		PR("\t< %6u ns : %u\n", 16U << i, hist[i]);
+	}
+
+	PR("\t>= %5u ns : %u\n", 16U << i >> 1, hist[i]);
+}
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
+static int cmd_net_gptp_servo(const struct shell *shell, size_t argc,
+			      char *argv[])
+{
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	const struct gptp_servo_stats *stats = gptp_servo_get_stats();
+
+	if (argv[1] && !strcmp(argv[1], "reset")) {
+		gptp_servo_clear_stats();
+		return 0;
+	}
+
+	PR("Offsets received          : %u\n", stats->samples);
+	PR("Offsets dropped (outlier) : %u\n", stats->outliers);
+	PR("Clock steps               : %u\n", stats->steps);
+
+	if (stats->samples > stats->outliers) {
+		PR("Last offset               : %d ns\n", stats->offset);
+		PR("Offset min / max          : %d / %d ns\n",
+		   stats->offset_min, stats->offset_max);
+		PR("Frequency correction      : %d ppb\n", stats->freq_ppb);
+	}
+
+	gptp_print_servo_hist(shell, "Offset", stats->offset_hist);
+	gptp_print_servo_hist(shell, "Jitter", stats->jitter_hist);
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set CONFIG_NET_GPTP_SERVO_PI to enable the clock servo.\n");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_gptp(const struct shell *shell, size_t argc, char *argv[])
 {
 #if defined(CONFIG_NET_GPTP)
@@ -2480,6 +2621,20 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 	PR("%p\t%d\t%d\tTX DATA (%s)\n",
 	       tx_data, tx_data->buf_count,
 	       tx_data->avail_count, tx_data->name);
+
+	PR("\nData pool\tMin avail\tFailures\n");
+	PR("RX DATA\t\t%d\t\t%u\n", rx_data->min_avail_count,
+	   rx_data->alloc_failures);
+	PR("TX DATA\t\t%d\t\t%u\n", tx_data->min_avail_count,
+	   tx_data->alloc_failures);
+
+#if defined(CONFIG_NET_BUF_POOL_GROUP)
+	PR("\nData pool\tBorrowed\tLent\tReserve\n");
+	PR("RX DATA\t\t%u\t\t%u\t%u\n", rx_data->borrowed, rx_data->lent,
+	   rx_data->reserve);
+	PR("TX DATA\t\t%u\t\t%u\t%u\n", tx_data->borrowed, tx_data->lent,
+	   tx_data->reserve);
+#endif
 #else
 	PR("(CONFIG_NET_BUF_POOL_USAGE to see free #s)\n");
 	PR("Address\t\tTotal\tName\n");
@@ -2986,6 +3141,105 @@ wait_reply:
 #endif
 }
 
+#if defined(CONFIG_NET_NAPI)
+static void napi_cb(struct net_napi *napi, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+
+	if (*count == 0) {
+		PR("Iface  Budget  Scheduled  Polls      Frames     Exhausted\n");
+	}
+
+	PR("%-5d  %-6u  %-9u  %-9u  %-9u  %u\n",
+	   net_if_get_by_iface(napi->iface), napi->budget,
+	   napi->stats.scheduled, napi->stats.polls, napi->stats.frames,
+	   napi->stats.exhausted);
+
+	(*count)++;
+}
+#endif /* CONFIG_NET_NAPI */
+
+static int cmd_net_napi(const struct shell *shell, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_NAPI)
+	struct net_shell_user_data user_data;
+	int count = 0;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	user_data.shell = shell;
+	user_data.user_data = &count;
+
+	net_napi_foreach(napi_cb, &user_data);
+
+	if (count == 0) {
+		PR("No interface polls its device.\n");
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set CONFIG_NET_NAPI to enable polled reception.\n");
+#endif /* CONFIG_NET_NAPI */
+
+	return 0;
+}
+
+static int cmd_net_napi_budget(const struct shell *shell, size_t argc,
+			       char *argv[])
+{
+#if defined(CONFIG_NET_NAPI)
+	struct net_napi *napi;
+	struct net_if *iface;
+	char *endptr;
+	long budget;
+	int idx;
+
+	/* napi budget <interface index> <frames> */
+	idx = get_iface_idx(shell, argv[1]);
+	if (idx < 0) {
+		return -ENOEXEC;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (!iface) {
+		PR_WARNING("No such interface in index %d\n", idx);
+		return -ENOEXEC;
+	}
+
+	napi = net_napi_get(iface);
+	if (!napi) {
+		PR_WARNING("Interface %d does not poll its device.\n", idx);
+		return -ENOEXEC;
+	}
+
+	if (!argv[2]) {
+		PR("Interface %d budget %u\n", idx, napi->budget);
+		return 0;
+	}
+
+	budget = strtol(argv[2], &endptr, 10);
+	if (*endptr != '\0' || budget < 1 || budget > UINT16_MAX) {
+		PR_WARNING("Invalid budget %s\n", argv[2]);
+		return -ENOEXEC;
+	}
+
+	net_napi_set_budget(napi, budget);
+
+	PR("Interface %d budget set to %ld\n", idx, budget);
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set CONFIG_NET_NAPI to enable polled reception.\n");
+#endif /* CONFIG_NET_NAPI */
+
+	return 0;
+}
+
 static int cmd_net_route(const struct shell *shell, size_t argc, char *argv[])
 {
 #if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
@@ -3708,8 +3962,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_arp,
 );
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, NULL, "Show the cached DNS answers.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
+	SHELL_CMD(flush, NULL, "Remove all entries from DNS cache.",
+		  cmd_net_dns_flush),
 	SHELL_CMD(query, NULL,
 		  "'net dns <hostname> [A or AAAA]' queries IPv4 address "
 		  "(default) or IPv6 address for a host name.",
@@ -3722,6 +3980,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_gptp,
 		  "'net gptp [<port>]' prints detailed information about "
 		  "gPTP port.",
 		  cmd_net_gptp_port),
+	SHELL_CMD(servo, NULL,
+		  "'net gptp servo [reset]' prints or clears the offset and "
+		  "jitter statistics of the clock servo.",
+		  cmd_net_gptp_servo),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -3859,6 +4121,14 @@ static void nbr_address_get(size_t idx, struct shell_static_entry *entry)
 #define NBR_ADDRESS_CMD NULL
 #endif /* CONFIG_NET_IPV6 && CONFIG_NET_SHELL_DYN_CMD_COMPLETION */
 
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_napi,
+	SHELL_CMD(budget, IFACE_DYN_CMD,
+		  "'net napi budget <index> [<frames>]' shows or sets the "
+		  "number of frames received per poll.",
+		  cmd_net_napi_budget),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_nbr,
 	SHELL_CMD(rm, NBR_ADDRESS_CMD,
 		  "'net nbr rm <address>' removes neighbor from cache.",
@@ -3939,6 +4209,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_commands,
 		  cmd_net_ipv6),
 	SHELL_CMD(mem, NULL, "Print information about network memory usage.",
 		  cmd_net_mem),
+	SHELL_CMD(napi, &net_cmd_napi,
+		  "Print polled reception statistics.", cmd_net_napi),
 	SHELL_CMD(nbr, &net_cmd_nbr, "Print neighbor information.",
 		  cmd_net_nbr),
 	SHELL_CMD(ping, &net_cmd_ping, "Ping a network host.", cmd_net_ping),
@@ -90,6 +90,16 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, ipv6_nd.sent),
 			 GET_STAT(iface, ipv6_nd.drop));
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+		NET_INFO("IPv6 frag reassembled %d\ttimeout\t%d\tevicted\t%d",
+			 GET_STAT(iface, ipv6_frag.reassembled),
+			 GET_STAT(iface, ipv6_frag.timeout),
+			 GET_STAT(iface, ipv6_frag.evicted));
+		NET_INFO("IPv6 frag overlap %d\tduplicate\t%d\tdrop\t%d",
+			 GET_STAT(iface, ipv6_frag.overlap),
+			 GET_STAT(iface, ipv6_frag.duplicate),
+			 GET_STAT(iface, ipv6_frag.drop));
+#endif /* CONFIG_NET_STATISTICS_IPV6_FRAGMENT */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 		NET_INFO("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d",
 			 GET_STAT(iface, ipv6_mld.recv),
@@ -266,6 +276,12 @@ static int net_stats_get(u32_t mgmt_request, struct net_if *iface,
 		src = GET_STAT_ADDR(iface, ipv6_nd);
 		break;
 #endif
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+	case NET_REQUEST_STATS_CMD_GET_IPV6_FRAG:
+		len_chk = sizeof(struct net_stats_ipv6_frag);
+		src = GET_STAT_ADDR(iface, ipv6_frag);
+		break;
+#endif
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 	case NET_REQUEST_STATS_CMD_GET_ICMP:
 		len_chk = sizeof(struct net_stats_icmp);
@@ -322,6 +338,11 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_ND,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_FRAG,
+				  net_stats_get);
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ICMP,
 				  net_stats_get);
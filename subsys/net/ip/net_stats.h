@@ -111,6 +111,47 @@ static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 #define net_stats_update_ipv6_nd_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_FRAGMENT)
+/* IPv6 fragment reassembly stats */
+
+static inline void net_stats_update_ipv6_frag_reassembled(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_frag.reassembled++);
+}
+
+static inline void net_stats_update_ipv6_frag_timeout(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_frag.timeout++);
+}
+
+static inline void net_stats_update_ipv6_frag_evicted(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_frag.evicted++);
+}
+
+static inline void net_stats_update_ipv6_frag_overlap(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_frag.overlap++);
+}
+
+static inline void net_stats_update_ipv6_frag_duplicate(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_frag.duplicate++);
+}
+
+static inline void net_stats_update_ipv6_frag_drop(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_frag.drop++);
+}
+#else
+#define net_stats_update_ipv6_frag_reassembled(iface)
+#define net_stats_update_ipv6_frag_timeout(iface)
+#define net_stats_update_ipv6_frag_evicted(iface)
+#define net_stats_update_ipv6_frag_overlap(iface)
+#define net_stats_update_ipv6_frag_duplicate(iface)
+#define net_stats_update_ipv6_frag_drop(iface)
+#endif /* CONFIG_NET_STATISTICS_IPV6_FRAGMENT */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4)
 /* IPv4 stats */
 
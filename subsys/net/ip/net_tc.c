@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -24,23 +25,163 @@ NET_STACK_ARRAY_DEFINE(TX, tx_stack,
 		       CONFIG_NET_TX_STACK_SIZE,
 		       NET_TC_TX_COUNT);
 
+/* Each RX traffic class has NET_RX_FLOW_QUEUES work queues */
+#define NET_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_RX_FLOW_QUEUES)
+
 /* Stacks for RX work queue */
 NET_STACK_ARRAY_DEFINE(RX, rx_stack,
 		       CONFIG_NET_RX_STACK_SIZE,
 		       CONFIG_NET_RX_STACK_SIZE,
-		       NET_TC_RX_COUNT);
+		       NET_RX_QUEUE_COUNT);
 
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_RX_QUEUE_COUNT];
 
 void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt)
 {
 	k_work_submit_to_queue(&tx_classes[tc].work_q, net_pkt_work(pkt));
 }
 
+#if NET_RX_FLOW_QUEUES > 1
+#define FLOW_HASH_INIT 2166136261U
+
+static u32_t flow_hash_add(u32_t hash, const u8_t *data, size_t len)
+{
+	/* FNV-1a */
+	while (len--) {
+		hash = (hash ^ *data++) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Hash the addresses, protocol and ports of a received packet, as found
+ * in its first buffer. The packet is not parsed yet, so the L2 header is
+ * skipped here for Ethernet. Packets which cannot be parsed all get the
+ * same hash.
+ */
+static u32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	u32_t hash = FLOW_HASH_INIT;
+	size_t off = 0;
+	size_t len;
+	u8_t *data;
+	u8_t proto;
+
+	if (net_pkt_rx_hash_is_set(pkt)) {
+		return net_pkt_rx_hash(pkt);
+	}
+
+	if (!buf) {
+		return 0;
+	}
+
+	data = buf->data;
+	len = buf->len;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		u16_t type;
+
+		off = sizeof(struct net_eth_hdr);
+		if (len < sizeof(struct net_eth_vlan_hdr)) {
+			return 0;
+		}
+
+		type = ntohs(((struct net_eth_hdr *)data)->type);
+		if (type == NET_ETH_PTYPE_VLAN) {
+			off = sizeof(struct net_eth_vlan_hdr);
+			type = ntohs(((struct net_eth_vlan_hdr *)data)->type);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0;
+		}
+	}
+#endif
+
+	if (len < off + 1) {
+		return 0;
+	}
+
+	switch (data[off] >> 4) {
+	case 4: {
+		size_t hdr_len = (data[off] & 0x0f) * 4U;
+
+		if (len < off + 20) {
+			return 0;
+		}
+
+		proto = data[off + 9];
+		hash = flow_hash_add(hash, &data[off + 12], 8);
+
+		/* Only the first fragment has the ports */
+		if ((data[off + 6] & 0x3f) != 0U || data[off + 7] != 0U) {
+			proto = 0U;
+		}
+
+		off += hdr_len;
+		break;
+	}
+	case 6:
+		if (len < off + 40) {
+			return 0;
+		}
+
+		proto = data[off + 6];
+		hash = flow_hash_add(hash, &data[off + 8], 32);
+		off += 40;
+		break;
+	default:
+		return 0;
+	}
+
+	hash = flow_hash_add(hash, &proto, 1);
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= off + 4) {
+		hash = flow_hash_add(hash, &data[off], 4);
+	}
+
+	return hash;
+}
+#endif /* NET_RX_FLOW_QUEUES > 1 */
+
 void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt)
 {
-	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+	int idx = tc * NET_RX_FLOW_QUEUES;
+
+#if NET_RX_FLOW_QUEUES > 1
+	idx += rx_flow_hash(pkt) % NET_RX_FLOW_QUEUES;
+#endif
+
+	k_work_submit_to_queue(&rx_classes[idx].work_q, net_pkt_work(pkt));
+}
+
+/* Index of the Rx queue whose thread is running, -1 outside of them */
+int net_tc_rx_queue_current(void)
+{
+	k_tid_t tid = k_current_get();
+	int i;
+
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		if (&rx_classes[i].work_q.thread == tid) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool net_tc_rx_queue_is_empty(int idx)
+{
+	return k_queue_is_empty(&rx_classes[idx].work_q.queue);
+}
+
+bool net_tc_tx_queue_is_empty(u8_t tc)
+{
+	return k_queue_is_empty(&tx_classes[tc].work_q.queue);
 }
 
 int net_tx_priority2tc(enum net_priority prio)
@@ -261,6 +402,19 @@ void net_tc_tx_init(void)
 	}
 }
 
+#if NET_RX_FLOW_QUEUES > 1 && defined(CONFIG_SCHED_CPU_MASK)
+/* Pin the thread of an RX flow queue, the thread has already been started
+ * so keep it from running meanwhile.
+ */
+static void rx_queue_pin(struct k_thread *thread, int cpu)
+{
+	k_thread_suspend(thread);
+	(void)k_thread_cpu_mask_clear(thread);
+	(void)k_thread_cpu_mask_enable(thread, cpu);
+	k_thread_resume(thread);
+}
+#endif
+
 void net_tc_rx_init(void)
 {
 	int i;
@@ -271,10 +425,10 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
 		u8_t thread_priority;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_RX_FLOW_QUEUES);
 		rx_classes[i].tc = thread_priority;
 
 #if defined(CONFIG_NET_SHELL)
@@ -297,5 +451,10 @@ void net_tc_rx_init(void)
 			       K_THREAD_STACK_SIZEOF(rx_stack[i]),
 			       K_PRIO_COOP(thread_priority));
 		k_thread_name_set(&rx_classes[i].work_q.thread, "rx_workq");
+
+#if NET_RX_FLOW_QUEUES > 1 && defined(CONFIG_SCHED_CPU_MASK)
+		rx_queue_pin(&rx_classes[i].work_q.thread,
+			     (i % NET_RX_FLOW_QUEUES) % CONFIG_MP_NUM_CPUS);
+#endif
 	}
 }
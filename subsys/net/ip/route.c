@@ -38,6 +38,15 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
  */
 static sys_slist_t routes;
 
+/* The routes are also hashed on the bytes of their prefix, and on the
+ * prefix length. A lookup tries the prefix lengths in use, longest first.
+ */
+#define ROUTE_PREFIX_LEN_WORDS ((128 + 1 + 31) / 32)
+
+static sys_slist_t route_hash[CONFIG_NET_ROUTE_HASH_SIZE];
+static u16_t route_prefix_len_count[128 + 1];
+static u32_t route_prefix_len_used[ROUTE_PREFIX_LEN_WORDS];
+
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Nexthop %p removed", nbr);
@@ -249,39 +258,96 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 			route->iface);					\
 	} while (0)
 
-/* Route was accessed, so place it in front of the routes list */
-static inline void update_route_access(struct net_route_entry *route)
+/* Only the whole bytes of the prefix are hashed, the bits of the last
+ * byte are compared by net_ipv6_is_prefix().
+ */
+static sys_slist_t *route_bucket(const struct in6_addr *addr, u8_t prefix_len)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	u32_t hash = 2166136261U;
+	int i;
+
+	/* FNV-1a */
+	hash = (hash ^ prefix_len) * 16777619U;
+
+	for (i = 0; i < prefix_len / 8; i++) {
+		hash = (hash ^ addr->s6_addr[i]) * 16777619U;
+	}
+
+	return &route_hash[hash % CONFIG_NET_ROUTE_HASH_SIZE];
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static void route_hash_add(struct net_route_entry *route)
 {
-	struct net_route_entry *route, *found = NULL;
-	u8_t longest_match = 0U;
-	int i;
+	u8_t len = route->prefix_len;
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	sys_slist_prepend(route_bucket(&route->addr, len), &route->hash_node);
 
-		if (!nbr->ref) {
+	if (route_prefix_len_count[len]++ == 0U) {
+		route_prefix_len_used[len / 32] |= BIT(len % 32);
+	}
+}
+
+static void route_hash_del(struct net_route_entry *route)
+{
+	u8_t len = route->prefix_len;
+
+	if (!sys_slist_find_and_remove(route_bucket(&route->addr, len),
+				       &route->hash_node)) {
+		return;
+	}
+
+	if (--route_prefix_len_count[len] == 0U) {
+		route_prefix_len_used[len / 32] &= ~BIT(len % 32);
+	}
+}
+
+static struct net_route_entry *route_hash_lookup(struct net_if *iface,
+						 struct in6_addr *dst,
+						 u8_t prefix_len)
+{
+	struct net_route_entry *route;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(route_bucket(dst, prefix_len), route,
+				     hash_node) {
+		if (route->prefix_len != prefix_len) {
 			continue;
 		}
 
-		if (iface && nbr->iface != iface) {
+		if (iface && route->iface != iface) {
 			continue;
 		}
 
-		route = net_route_data(nbr);
+		if (net_ipv6_is_prefix((u8_t *)dst, (u8_t *)&route->addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+/* Route was accessed, so place it in front of the routes list */
+static inline void update_route_access(struct net_route_entry *route)
+{
+	sys_slist_find_and_remove(&routes, &route->node);
+	sys_slist_prepend(&routes, &route->node);
+}
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix((u8_t *)dst,
-				       (u8_t *)&route->addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+	u32_t used;
+	int i, bit;
+
+	for (i = ROUTE_PREFIX_LEN_WORDS - 1; i >= 0 && !found; i--) {
+		used = route_prefix_len_used[i];
+
+		while (used && !found) {
+			bit = find_msb_set(used) - 1;
+			used &= ~BIT(bit);
+
+			found = route_hash_lookup(iface, dst, i * 32 + bit);
 		}
 	}
 
@@ -401,6 +467,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 
 	sys_slist_prepend(&routes, &route->node);
+	route_hash_add(route);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -413,6 +480,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_info("Added", route, addr);
 
+	net_ipv6_dst_cache_invalidate();
+
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
 	net_ipaddr_copy(&info.addr, addr);
 	net_ipaddr_copy(&info.nexthop, nexthop);
@@ -454,6 +523,9 @@ int net_route_del(struct net_route_entry *route)
 #endif
 
 	sys_slist_find_and_remove(&routes, &route->node);
+	route_hash_del(route);
+
+	net_ipv6_dst_cache_invalidate();
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -48,6 +48,9 @@ struct net_route_entry {
 	 */
 	sys_snode_t node;
 
+	/** Node in the hash table of the routes, by prefix. */
+	sys_snode_t hash_node;
+
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
@@ -52,6 +52,9 @@ static struct tcp_backlog_entry {
 	struct k_delayed_work ack_timer;
 	struct sockaddr remote;
 	u16_t send_mss;
+	u8_t snd_wscale;
+	u8_t wscale_ok : 1;
+	u8_t sack_ok : 1;
 } tcp_backlog[CONFIG_NET_TCP_BACKLOG_SIZE];
 
 #if defined(CONFIG_NET_TCP_ACK_TIMEOUT)
@@ -163,8 +166,8 @@ static void net_tcp_trace(struct net_pkt *pkt,
 
 static inline u32_t retry_timeout(const struct net_tcp *tcp)
 {
-	return ((u32_t)1 << tcp->retry_timeout_shift) *
-				CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+	return MIN((u64_t)tcp->rto << tcp->retry_timeout_shift,
+		   NET_TCP_RTO_MAX);
 }
 
 #define is_6lo_technology(pkt)						\
@@ -208,13 +211,216 @@ static void abort_connection(struct net_tcp *tcp)
 	net_context_unref(ctx);
 }
 
+/* Sequence number and length in sequence space of a packet of sent_list.
+ * The cursor is not used, the packet may be in the hands of a driver.
+ */
+static int tcp_sent_pkt_seq(struct net_pkt *pkt, u32_t *seq, u32_t *len,
+			    u8_t *flags)
+{
+	size_t offset = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv6_ext_len(pkt);
+	struct net_tcp_hdr hdr;
+
+	if (net_buf_linearize(&hdr, sizeof(hdr), pkt->buffer, offset,
+			      sizeof(hdr)) != sizeof(hdr)) {
+		return -EMSGSIZE;
+	}
+
+	*seq = sys_get_be32(hdr.seq);
+	*len = net_pkt_get_len(pkt) - offset - NET_TCP_HDR_LEN(&hdr);
+	*flags = hdr.flags;
+
+	/* Each of SYN and FIN flags are counted
+	 * as one sequence number.
+	 */
+	if (hdr.flags & NET_TCP_SYN) {
+		*len += 1U;
+	}
+	if (hdr.flags & NET_TCP_FIN) {
+		*len += 1U;
+	}
+
+	return 0;
+}
+
+/* Send again a packet of sent_list */
+static int tcp_retransmit(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	int ret;
+
+	if (net_pkt_sent(pkt)) {
+		do_ref_if_needed(tcp, pkt);
+		net_pkt_set_sent(pkt, false);
+	}
+
+	net_pkt_set_queued(pkt, true);
+
+	ret = net_tcp_send_pkt(pkt);
+	if (ret < 0 && !is_6lo_technology(pkt)) {
+		net_pkt_unref(pkt);
+	} else if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
+		   !is_6lo_technology(pkt)) {
+		net_stats_update_tcp_seg_rexmit(net_pkt_iface(pkt));
+	}
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static bool tcp_is_sacked(struct net_tcp *tcp, u32_t seq, u32_t len)
+{
+	int i;
+
+	for (i = 0; i < NET_TCP_MAX_SACK_BLOCKS; i++) {
+		struct net_tcp_sack_block *blk = &tcp->sacked[i];
+
+		if (blk->start != blk->end &&
+		    !net_tcp_seq_greater(blk->start, seq) &&
+		    !net_tcp_seq_greater(seq + len, blk->end)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Merge the SACK blocks of a received ACK in the scoreboard */
+static void tcp_sack_update(struct net_tcp *tcp,
+			    const struct net_tcp_options *opts)
+{
+	int i, j;
+
+	if (!(tcp->flags & NET_TCP_SACK_OK)) {
+		return;
+	}
+
+	for (i = 0; i < opts->sack_count; i++) {
+		struct net_tcp_sack_block blk = opts->sack[i];
+		int slot = NET_TCP_MAX_SACK_BLOCKS - 1;
+
+		/* Reports of duplicates (RFC 2883) or of acked data */
+		if (!net_tcp_seq_greater(blk.end, blk.start) ||
+		    !net_tcp_seq_greater(blk.start, tcp->snd_una) ||
+		    net_tcp_seq_greater(blk.end, tcp->snd_nxt)) {
+			continue;
+		}
+
+		/* Absorb the blocks it overlaps or touches */
+		for (j = 0; j < NET_TCP_MAX_SACK_BLOCKS; j++) {
+			struct net_tcp_sack_block *s = &tcp->sacked[j];
+
+			if (s->start == s->end) {
+				slot = j;
+				continue;
+			}
+
+			if (net_tcp_seq_greater(s->start, blk.end) ||
+			    net_tcp_seq_greater(blk.start, s->end)) {
+				continue;
+			}
+
+			if (net_tcp_seq_greater(blk.start, s->start)) {
+				blk.start = s->start;
+			}
+			if (net_tcp_seq_greater(s->end, blk.end)) {
+				blk.end = s->end;
+			}
+
+			s->start = s->end;
+			slot = j;
+		}
+
+		tcp->sacked[slot] = blk;
+	}
+}
+
+/* Forget what snd_una went past */
+static void tcp_sack_prune(struct net_tcp *tcp)
+{
+	int i;
+
+	for (i = 0; i < NET_TCP_MAX_SACK_BLOCKS; i++) {
+		struct net_tcp_sack_block *blk = &tcp->sacked[i];
+
+		if (!net_tcp_seq_greater(blk->end, tcp->snd_una)) {
+			blk->start = blk->end;
+		} else if (net_tcp_seq_greater(tcp->snd_una, blk->start)) {
+			blk->start = tcp->snd_una;
+		}
+	}
+}
+
+static void tcp_sack_clear(struct net_tcp *tcp)
+{
+	(void)memset(tcp->sacked, 0, sizeof(tcp->sacked));
+}
+#else
+#define tcp_is_sacked(...) false
+#define tcp_sack_update(...)
+#define tcp_sack_prune(...)
+#define tcp_sack_clear(...)
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Retransmit the first segment the peer did not get, for fast retransmit
+ * and partial acknowledgments
+ */
+static void tcp_retransmit_first(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+	u32_t seq, len;
+	u8_t flags;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (tcp_sent_pkt_seq(pkt, &seq, &len, &flags) < 0 ||
+		    tcp_is_sacked(tcp, seq, len)) {
+			continue;
+		}
+
+		if (net_tcp_seq_greater(seq + len, tcp->snd_nxt)) {
+			break;
+		}
+
+		/* Not sent yet by the driver, sending it once is enough */
+		if (net_pkt_queued(pkt) && !net_pkt_sent(pkt) &&
+		    !is_6lo_technology(pkt)) {
+			break;
+		}
+
+		NET_DBG("[%p] retransmit pkt %p seq %u", tcp, pkt, seq);
+		tcp_retransmit(tcp, pkt);
+		break;
+	}
+}
+
+/* RFC 5681 (3.1) and RFC 6298 (5.5 to 5.7) */
+static void tcp_cc_timeout(struct net_tcp *tcp)
+{
+	if (tcp->recovery != NET_TCP_RECOVERY_LOSS) {
+		tcp->ssthresh = tcp->cc->ssthresh(tcp);
+	}
+
+	tcp->cwnd = tcp->send_mss;
+	tcp->recovery = NET_TCP_RECOVERY_LOSS;
+	tcp->recover = tcp->snd_nxt;
+	tcp->dupacks = 0U;
+	tcp->rtt_active = 0U;
+
+	/* RFC 2018 (8), the peer may have dropped what it reported */
+	tcp_sack_clear(tcp);
+
+	/* Everything not acked is sent again as the window opens */
+	tcp->snd_nxt = tcp->snd_una;
+}
+
 static void tcp_retry_expired(struct k_work *work)
 {
 	struct net_tcp *tcp = CONTAINER_OF(work, struct net_tcp, retry_timer);
 	struct net_pkt *pkt;
+	u32_t seq, len;
+	u8_t flags;
 
 	/* Double the retry period for exponential backoff and resend
-	 * the first (only the first!) unack'd packet.
+	 * the first unack'd packet, the others follow as ACKs open the
+	 * congestion window.
 	 */
 	if (!sys_slist_is_empty(&tcp->sent_list)) {
 		tcp->retry_timeout_shift++;
@@ -226,28 +432,23 @@ static void tcp_retry_expired(struct k_work *work)
 
 		k_delayed_work_submit(&tcp->retry_timer, retry_timeout(tcp));
 
+		tcp_cc_timeout(tcp);
+
 		pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
 				   struct net_pkt, sent_list);
 
-		if (net_pkt_sent(pkt)) {
-			do_ref_if_needed(tcp, pkt);
-			net_pkt_set_sent(pkt, false);
+		if (tcp_sent_pkt_seq(pkt, &seq, &len, &flags) == 0 &&
+		    net_tcp_seq_greater(seq + len, tcp->snd_nxt)) {
+			tcp->snd_nxt = seq + len;
 		}
 
-		net_pkt_set_queued(pkt, true);
-
-		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
+		if (tcp_retransmit(tcp, pkt) < 0 &&
+		    !is_6lo_technology(pkt)) {
 			NET_DBG("retry %u: [%p] pkt %p send failed",
 				tcp->retry_timeout_shift, tcp, pkt);
-			net_pkt_unref(pkt);
 		} else {
 			NET_DBG("retry %u: [%p] sent pkt %p",
 				tcp->retry_timeout_shift, tcp, pkt);
-			if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
-			    !is_6lo_technology(pkt)) {
-				net_stats_update_tcp_seg_rexmit(
-							net_pkt_iface(pkt));
-			}
 		}
 	} else if (CONFIG_NET_TCP_TIME_WAIT_DELAY != 0) {
 		if (tcp->fin_sent && tcp->fin_rcvd) {
@@ -282,8 +483,14 @@ struct net_tcp *net_tcp_alloc(struct net_context *context)
 	tcp_context[i].context = context;
 
 	tcp_context[i].send_seq = tcp_init_isn();
+	tcp_context[i].snd_una = tcp_context[i].send_seq;
+	tcp_context[i].snd_nxt = tcp_context[i].send_seq;
 	tcp_context[i].recv_wnd = MIN(NET_TCP_MAX_WIN, NET_TCP_BUF_MAX_LEN);
+	tcp_context[i].snd_wnd = 0xffff;
 	tcp_context[i].send_mss = NET_TCP_DEFAULT_MSS;
+	tcp_context[i].rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+
+	net_tcp_cc_init(&tcp_context[i]);
 
 	tcp_context[i].accept_cb = NULL;
 
@@ -329,6 +536,12 @@ int net_tcp_release(struct net_tcp *tcp)
 		net_pkt_unref(pkt);
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	while (tcp->ooo_count) {
+		net_pkt_unref(tcp->ooo[--tcp->ooo_count].pkt);
+	}
+#endif
+
 	retry_timer_cancel(tcp);
 	k_sem_reset(&tcp->connect_wait);
 
@@ -562,7 +775,13 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 		}
 	}
 
-	wnd = net_tcp_get_recv_wnd(tcp);
+	/* RFC 7323 (2.2), the window of a SYN segment is never scaled */
+	if (flags & NET_TCP_SYN) {
+		wnd = MIN(net_tcp_get_recv_wnd(tcp), 0xffff);
+	} else {
+		wnd = MIN(net_tcp_get_recv_wnd(tcp) >> tcp->rcv_wscale,
+			  0xffff);
+	}
 
 	segment.src_addr = (struct sockaddr_ptr *)local;
 	segment.dst_addr = remote;
@@ -655,39 +874,141 @@ u16_t net_tcp_get_recv_mss(const struct net_tcp *tcp)
 	return 0;
 }
 
+/* Window shift we ask for, enough for the whole receive window */
+static u8_t tcp_rcv_wscale(void)
+{
+	u8_t shift = 0U;
+
+	while (shift < NET_TCP_MAX_WSCALE &&
+	       (NET_TCP_BUF_MAX_LEN >> shift) > 0xffff) {
+		shift++;
+	}
+
+	return shift;
+}
+
+/* Options of a SYN, or of a SYN-ACK answering the options of the peer
+ * when peer is set: window scaling and SACK are only used if both sides
+ * ask for them. Every option is padded to 4 bytes.
+ */
 static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
-				u8_t *optionlen)
+				u8_t *optionlen,
+				const struct net_tcp_options *peer)
 {
 	u32_t recv_mss;
 
 	*optionlen = 0U;
 
-	if (!(tcp->flags & NET_TCP_RECV_MSS_SET)) {
-		recv_mss = net_tcp_get_recv_mss(tcp);
-		tcp->flags |= NET_TCP_RECV_MSS_SET;
-	} else {
-		recv_mss = 0U;
-	}
+	recv_mss = net_tcp_get_recv_mss(tcp);
+	tcp->flags |= NET_TCP_RECV_MSS_SET;
 
 	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
 	UNALIGNED_PUT(htonl(recv_mss),
 		      (u32_t *)(options + *optionlen));
 
 	*optionlen += NET_TCP_MSS_SIZE;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    (!peer || peer->wscale_ok)) {
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_WINDOW_SCALE_OPT;
+		options[(*optionlen)++] = NET_TCP_WINDOW_SCALE_SIZE;
+		options[(*optionlen)++] = tcp_rcv_wscale();
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && (!peer || peer->sack_ok)) {
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_SACK_PERM_OPT;
+		options[(*optionlen)++] = NET_TCP_SACK_PERM_SIZE;
+	}
+}
+
+/* Take the options the peer sent in its SYN or SYN-ACK into use */
+static void tcp_set_peer_opts(struct net_tcp *tcp, u16_t mss,
+			      bool wscale_ok, u8_t wscale, bool sack_ok)
+{
+	tcp->send_mss = mss;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && wscale_ok) {
+		tcp->flags |= NET_TCP_WSCALE_OK;
+		tcp->snd_wscale = wscale;
+		tcp->rcv_wscale = tcp_rcv_wscale();
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && sack_ok) {
+		tcp->flags |= NET_TCP_SACK_OK;
+	}
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* SACK blocks of the segments kept out of order, the one with the latest
+ * segment received first (RFC 2018 section 4)
+ */
+static u8_t tcp_set_sack_opt(struct net_tcp *tcp, u8_t *options)
+{
+	struct net_tcp_sack_block blk[CONFIG_NET_TCP_OOO_MAX];
+	int i, count = 0, first = 0;
+	u8_t optionlen, n;
+
+	if (!(tcp->flags & NET_TCP_SACK_OK) || !tcp->ooo_count) {
+		return 0U;
+	}
+
+	/* Contiguous segments make one block */
+	for (i = 0; i < tcp->ooo_count; i++) {
+		u32_t start = tcp->ooo[i].seq;
+
+		if (count && blk[count - 1].end == start) {
+			blk[count - 1].end += tcp->ooo[i].len;
+		} else {
+			blk[count].start = start;
+			blk[count].end = start + tcp->ooo[i].len;
+			count++;
+		}
+
+		if (tcp->ooo[i].seq == tcp->ooo_last) {
+			first = count - 1;
+		}
+	}
+
+	n = MIN(count, NET_TCP_MAX_SACK_BLOCKS);
+
+	options[0] = NET_TCP_NOP_OPT;
+	options[1] = NET_TCP_NOP_OPT;
+	options[2] = NET_TCP_SACK_OPT;
+	options[3] = 2U + n * NET_TCP_SACK_BLOCK_SIZE;
+	optionlen = 4U;
+
+	for (i = 0; i < n; i++) {
+		/* The latest one, then the others in order */
+		int b = i == 0 ? first : (i <= first ? i - 1 : i);
+
+		sys_put_be32(blk[b].start, options + optionlen);
+		sys_put_be32(blk[b].end, options + optionlen + 4);
+		optionlen += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return optionlen;
 }
+#else
+#define tcp_set_sack_opt(...) 0U
+#endif /* CONFIG_NET_TCP_SACK */
 
 int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 			struct net_pkt **pkt)
 {
-	u8_t options[NET_TCP_MAX_OPT_SIZE];
+	u8_t options[NET_TCP_OPT_BUF_SIZE];
+	struct net_tcp_options no_opts = { 0 };
 	u8_t optionlen;
 
 	switch (net_tcp_get_state(tcp)) {
 	case NET_TCP_SYN_RCVD:
 		/* In the SYN_RCVD state acknowledgment must be with the
-		 * SYN flag.
+		 * SYN flag. The options of the peer are in the backlog,
+		 * only offer the MSS here.
 		 */
-		net_tcp_set_syn_opt(tcp, options, &optionlen);
+		net_tcp_set_syn_opt(tcp, options, &optionlen, &no_opts);
 
 		return net_tcp_prepare_segment(tcp, NET_TCP_SYN | NET_TCP_ACK,
 					       options, optionlen, NULL, remote,
@@ -700,8 +1021,11 @@ int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 		return net_tcp_prepare_segment(tcp, NET_TCP_FIN | NET_TCP_ACK,
 					       0, 0, NULL, remote, pkt);
 	default:
-		return net_tcp_prepare_segment(tcp, NET_TCP_ACK, 0, 0, NULL,
-					       remote, pkt);
+		optionlen = tcp_set_sack_opt(tcp, options);
+
+		return net_tcp_prepare_segment(tcp, NET_TCP_ACK,
+					       optionlen ? options : NULL,
+					       optionlen, NULL, remote, pkt);
 	}
 
 	return -EINVAL;
@@ -901,7 +1225,7 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 	 */
 	net_pkt_set_data(pkt, &tcp_access);
 
-	if (calc_chksum) {
+	if (calc_chksum && !net_pkt_tso_mss(pkt)) {
 		net_pkt_cursor_init(pkt);
 		net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
 			     net_pkt_ipv6_ext_len(pkt));
@@ -990,38 +1314,74 @@ static void restart_timer(struct net_tcp *tcp)
 	}
 }
 
-int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
-		      void *user_data)
+/* Transmit what the congestion window and the window of the peer allow
+ * from sent_list, new data or data sent again after a timeout.
+ */
+static void tcp_send_queued(struct net_tcp *tcp)
 {
+	u32_t wnd = MIN(tcp->cwnd, tcp->snd_wnd);
 	struct net_pkt *pkt;
+	u32_t seq, len;
+	u8_t flags;
+	int ret;
 
-	/* For now, just send all queued data synchronously.  Need to
-	 * add window handling and retry/ACK logic.
-	 */
-	SYS_SLIST_FOR_EACH_CONTAINER(&context->tcp->sent_list, pkt, sent_list) {
-		/* Do not resend packets that were sent by expire timer */
-		if (net_pkt_queued(pkt)) {
-			NET_DBG("[%p] Skipping pkt %p because it was already "
-				"sent.", context->tcp, pkt);
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (tcp_sent_pkt_seq(pkt, &seq, &len, &flags) < 0 ||
+		    !net_tcp_seq_greater(seq + len, tcp->snd_nxt)) {
 			continue;
 		}
 
-		if (!net_pkt_sent(pkt)) {
-			int ret;
+		/* At least one segment is always in flight */
+		if (tcp->snd_nxt != tcp->snd_una &&
+		    seq + len - tcp->snd_una > wnd) {
+			NET_DBG("[%p] pkt %p waits for window (cwnd %u wnd %u)",
+				tcp, pkt, tcp->cwnd, tcp->snd_wnd);
+			break;
+		}
 
-			NET_DBG("[%p] Sending pkt %p (%zd bytes)", context->tcp,
+		if (net_pkt_queued(pkt) || tcp_is_sacked(tcp, seq, len)) {
+			/* Do not resend packets that were sent by expire timer
+			 * or that the peer has
+			 */
+			NET_DBG("[%p] Skipping pkt %p because it was already "
+				"sent.", tcp, pkt);
+			tcp->snd_nxt = seq + len;
+			continue;
+		}
+
+		if (net_pkt_sent(pkt)) {
+			/* Going back after a retransmission timeout */
+			tcp_retransmit(tcp, pkt);
+		} else {
+			NET_DBG("[%p] Sending pkt %p (%zd bytes)", tcp,
 				pkt, net_pkt_get_len(pkt));
 
+			net_pkt_set_queued(pkt, true);
+
 			ret = net_tcp_send_pkt(pkt);
 			if (ret < 0 && !is_6lo_technology(pkt)) {
 				NET_DBG("[%p] pkt %p not sent (%d)",
-					context->tcp, pkt, ret);
+					tcp, pkt, ret);
 				net_pkt_unref(pkt);
 			}
 
-			net_pkt_set_queued(pkt, true);
+			/* Karn's algorithm, only time segments sent once */
+			if (!tcp->rtt_active &&
+			    tcp->recovery == NET_TCP_RECOVERY_NONE) {
+				tcp->rtt_active = 1U;
+				tcp->rtt_seq = seq + len;
+				tcp->rtt_start = k_uptime_get_32();
+			}
 		}
+
+		tcp->snd_nxt = seq + len;
 	}
+}
+
+int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
+		      void *user_data)
+{
+	tcp_send_queued(context->tcp);
 
 	/* Just make the callback synchronously even if it didn't
 	 * go over the wire.  In theory it would be nice to track
@@ -1036,6 +1396,95 @@ int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 	return 0;
 }
 
+/* New data acknowledged: RTT sample, window growth and the end of loss
+ * recovery, RFC 5681 and RFC 6582.
+ */
+static void tcp_new_ack(struct net_tcp *tcp, u32_t ack)
+{
+	u32_t acked = ack - tcp->snd_una;
+	u32_t flight;
+
+	tcp->snd_una = ack;
+	if (net_tcp_seq_greater(ack, tcp->snd_nxt)) {
+		tcp->snd_nxt = ack;
+	}
+
+	if (tcp->rtt_active && !net_tcp_seq_greater(tcp->rtt_seq, ack)) {
+		tcp->rtt_active = 0U;
+		net_tcp_rtt_update(tcp, k_uptime_get_32() - tcp->rtt_start);
+	}
+
+	tcp_sack_prune(tcp);
+
+	flight = tcp->snd_nxt - tcp->snd_una;
+
+	switch (tcp->recovery) {
+	case NET_TCP_RECOVERY_FAST:
+		if (!net_tcp_seq_greater(tcp->recover, ack)) {
+			/* Full acknowledgment, deflate the window */
+			tcp->cwnd = MIN(tcp->ssthresh,
+					MAX(flight, tcp->send_mss) +
+					tcp->send_mss);
+			tcp->recovery = NET_TCP_RECOVERY_NONE;
+			tcp->dupacks = 0U;
+
+			if (tcp->cc->recovered) {
+				tcp->cc->recovered(tcp);
+			}
+
+			NET_DBG("[%p] recovered, cwnd %u", tcp, tcp->cwnd);
+			break;
+		}
+
+		/* Partial acknowledgment, the next hole is lost as well */
+		tcp_retransmit_first(tcp);
+
+		tcp->cwnd = tcp->cwnd > acked ? tcp->cwnd - acked : 0;
+		if (acked >= tcp->send_mss) {
+			tcp->cwnd += tcp->send_mss;
+		}
+		break;
+	case NET_TCP_RECOVERY_LOSS:
+		if (!net_tcp_seq_greater(tcp->recover, ack)) {
+			tcp->recovery = NET_TCP_RECOVERY_NONE;
+		}
+
+		tcp->dupacks = 0U;
+		tcp->cc->cong_avoid(tcp, acked);
+		break;
+	default:
+		tcp->dupacks = 0U;
+		tcp->cc->cong_avoid(tcp, acked);
+		break;
+	}
+}
+
+/* Duplicate ACK, fast retransmit at the third, RFC 5681 (3.2) */
+static void tcp_dupack(struct net_tcp *tcp)
+{
+	if (tcp->recovery == NET_TCP_RECOVERY_FAST) {
+		/* A segment has left the network */
+		tcp->cwnd += tcp->send_mss;
+		return;
+	}
+
+	if (tcp->recovery != NET_TCP_RECOVERY_NONE ||
+	    ++tcp->dupacks < NET_TCP_DUPACK_THRESH) {
+		return;
+	}
+
+	tcp->ssthresh = tcp->cc->ssthresh(tcp);
+	tcp->recover = tcp->snd_nxt;
+	tcp->recovery = NET_TCP_RECOVERY_FAST;
+	tcp->rtt_active = 0U;
+
+	NET_DBG("[%p] fast retransmit, ssthresh %u", tcp, tcp->ssthresh);
+
+	tcp_retransmit_first(tcp);
+
+	tcp->cwnd = tcp->ssthresh + NET_TCP_DUPACK_THRESH * tcp->send_mss;
+}
+
 bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 {
 	struct net_tcp *tcp = ctx->tcp;
@@ -1055,27 +1504,15 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 	}
 
 	while (!sys_slist_is_empty(list)) {
-		NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
-		struct net_tcp_hdr *tcp_hdr;
 		u32_t last_seq;
 		u32_t seq_len;
+		u32_t seq;
+		u8_t flags;
 
 		head = sys_slist_peek_head(list);
 		pkt = CONTAINER_OF(head, struct net_pkt, sent_list);
 
-		net_pkt_cursor_init(pkt);
-		net_pkt_set_overwrite(pkt, true);
-
-		if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
-			 net_pkt_ipv6_ext_len(pkt))) {
-			sys_slist_remove(list, NULL, head);
-			net_pkt_unref(pkt);
-			continue;
-		}
-
-		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt,
-								 &tcp_access);
-		if (!tcp_hdr) {
+		if (tcp_sent_pkt_seq(pkt, &seq, &seq_len, &flags) < 0) {
 			/* The pkt does not contain TCP header, this should
 			 * not happen.
 			 */
@@ -1085,21 +1522,8 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 			continue;
 		}
 
-		net_pkt_acknowledge_data(pkt, &tcp_access);
-		seq_len = net_pkt_remaining_data(pkt);
-
-		/* Each of SYN and FIN flags are counted
-		 * as one sequence number.
-		 */
-		if (tcp_hdr->flags & NET_TCP_SYN) {
-			seq_len += 1U;
-		}
-		if (tcp_hdr->flags & NET_TCP_FIN) {
-			seq_len += 1U;
-		}
-
 		/* Last sequence number in this packet. */
-		last_seq = sys_get_be32(tcp_hdr->seq) + seq_len - 1;
+		last_seq = seq + seq_len - 1;
 
 		/* Ack number should be strictly greater to acknowleged numbers
 		 * below it. For example, ack no. 10 acknowledges all numbers up
@@ -1109,7 +1533,7 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 			break;
 		}
 
-		if (tcp_hdr->flags & NET_TCP_FIN) {
+		if (flags & NET_TCP_FIN) {
 			enum net_tcp_state s = net_tcp_get_state(tcp);
 
 			if (s == NET_TCP_FIN_WAIT_1) {
@@ -1124,6 +1548,10 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		valid_ack = true;
 	}
 
+	if (net_tcp_seq_greater(ack, tcp->snd_una)) {
+		tcp_new_ack(tcp, ack);
+	}
+
 	/* Restart the timer (if needed) on a valid inbound ACK.  This isn't
 	 * quite the same behavior as per-packet retry timers, but is close in
 	 * practice (it starts retries one timer period after the connection
@@ -1139,6 +1567,9 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 
 void net_tcp_init(void)
 {
+#if defined(CONFIG_NET_TCP_CUBIC)
+	net_tcp_cubic_register();
+#endif
 }
 
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -1275,7 +1706,9 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* Segmentation offload packets are summed segment by segment */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_tso_mss(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -1286,6 +1719,7 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 		       struct net_tcp_options *opts)
 {
 	u8_t opt, optlen;
+	int i;
 
 	while (opt_totlen) {
 		if (net_pkt_read_u8(pkt, &opt)) {
@@ -1336,6 +1770,47 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 				goto error;
 			}
 
+			break;
+		case NET_TCP_WINDOW_SCALE_OPT:
+			if (optlen != 1U) {
+				goto error;
+			}
+
+			if (net_pkt_read_u8(pkt, &opts->wscale)) {
+				goto error;
+			}
+
+			/* RFC 7323 (2.3), larger shifts are taken as 14 */
+			opts->wscale = MIN(opts->wscale, NET_TCP_MAX_WSCALE);
+			opts->wscale_ok = 1U;
+
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (optlen != 0U) {
+				goto error;
+			}
+
+			opts->sack_ok = 1U;
+
+			break;
+		case NET_TCP_SACK_OPT:
+			if (optlen % NET_TCP_SACK_BLOCK_SIZE) {
+				goto error;
+			}
+
+			for (i = 0; i < optlen / NET_TCP_SACK_BLOCK_SIZE; i++) {
+				struct net_tcp_sack_block blk;
+
+				if (net_pkt_read_be32(pkt, &blk.start) ||
+				    net_pkt_read_be32(pkt, &blk.end)) {
+					goto error;
+				}
+
+				if (opts->sack_count < NET_TCP_MAX_SACK_BLOCKS) {
+					opts->sack[opts->sack_count++] = blk;
+				}
+			}
+
 			break;
 		default:
 			if (net_pkt_skip(pkt, optlen)) {
@@ -1428,7 +1903,7 @@ int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta)
 	}
 
 	new_win = context->tcp->recv_wnd + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	if (new_win < 0 || new_win > NET_TCP_MAX_WIN) {
 		return -EINVAL;
 	}
 
@@ -1555,7 +2030,7 @@ static int tcp_backlog_syn(struct net_pkt *pkt,
 			   union net_ip_header *ip_hdr,
 			   struct net_tcp_hdr *tcp_hdr,
 			   struct net_context *context,
-			   u16_t send_mss)
+			   const struct net_tcp_options *opts)
 {
 	int empty_slot = -1;
 
@@ -1574,7 +2049,10 @@ static int tcp_backlog_syn(struct net_pkt *pkt,
 
 	tcp_backlog[empty_slot].send_seq = context->tcp->send_seq;
 	tcp_backlog[empty_slot].send_ack = context->tcp->send_ack;
-	tcp_backlog[empty_slot].send_mss = send_mss;
+	tcp_backlog[empty_slot].send_mss = opts->mss;
+	tcp_backlog[empty_slot].snd_wscale = opts->wscale;
+	tcp_backlog[empty_slot].wscale_ok = opts->wscale_ok;
+	tcp_backlog[empty_slot].sack_ok = opts->sack_ok;
 
 	k_delayed_work_init(&tcp_backlog[empty_slot].ack_timer,
 			    backlog_ack_timeout);
@@ -1604,7 +2082,15 @@ static int tcp_backlog_ack(struct net_pkt *pkt,
 		sizeof(struct sockaddr));
 	context->tcp->send_seq = tcp_backlog[r].send_seq + 1;
 	context->tcp->send_ack = tcp_backlog[r].send_ack;
-	context->tcp->send_mss = tcp_backlog[r].send_mss;
+	context->tcp->snd_una = context->tcp->send_seq;
+	context->tcp->snd_nxt = context->tcp->send_seq;
+
+	tcp_set_peer_opts(context->tcp, tcp_backlog[r].send_mss,
+			  tcp_backlog[r].wscale_ok, tcp_backlog[r].snd_wscale,
+			  tcp_backlog[r].sack_ok);
+	context->tcp->snd_wnd = (u32_t)sys_get_be16(tcp_hdr->wnd) <<
+				context->tcp->snd_wscale;
+	net_tcp_cc_init(context->tcp);
 
 	k_delayed_work_cancel(&tcp_backlog[r].ack_timer);
 	(void)memset(&tcp_backlog[r], 0, sizeof(struct tcp_backlog_entry));
@@ -1787,16 +2273,15 @@ static void print_send_info(struct net_pkt *pkt,
 static inline int send_syn_segment(struct net_context *context,
 				       const struct sockaddr_ptr *local,
 				       const struct sockaddr *remote,
-				       int flags, const char *msg)
+				       int flags, const char *msg,
+				       const struct net_tcp_options *peer)
 {
 	struct net_pkt *pkt = NULL;
 	int ret;
-	u8_t options[NET_TCP_MAX_OPT_SIZE];
+	u8_t options[NET_TCP_OPT_BUF_SIZE];
 	u8_t optionlen = 0U;
 
-	if (flags == NET_TCP_SYN) {
-		net_tcp_set_syn_opt(context->tcp, options, &optionlen);
-	}
+	net_tcp_set_syn_opt(context->tcp, options, &optionlen, peer);
 
 	ret = net_tcp_prepare_segment(context->tcp, flags, options, optionlen,
 				      local, remote, &pkt);
@@ -1822,16 +2307,18 @@ static inline int send_syn(struct net_context *context,
 {
 	net_tcp_change_state(context->tcp, NET_TCP_SYN_SENT);
 
-	return send_syn_segment(context, NULL, remote, NET_TCP_SYN, "SYN");
+	return send_syn_segment(context, NULL, remote, NET_TCP_SYN, "SYN",
+				NULL);
 }
 
 static inline int send_syn_ack(struct net_context *context,
 			       struct sockaddr_ptr *local,
-			       struct sockaddr *remote)
+			       struct sockaddr *remote,
+			       const struct net_tcp_options *peer)
 {
 	return send_syn_segment(context, local, remote,
 				    NET_TCP_SYN | NET_TCP_ACK,
-				    "SYN_ACK");
+				    "SYN_ACK", peer);
 }
 
 static int send_ack(struct net_context *context,
@@ -1884,6 +2371,134 @@ static int send_reset(struct net_context *context,
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Keep a segment received ahead of the next expected one (RFC 2018),
+ * unless it overlaps one already kept.
+ */
+static bool tcp_ooo_queue(struct net_tcp *tcp, struct net_pkt *pkt,
+			  u32_t seq, u32_t len)
+{
+	int i, pos;
+
+	if (!(tcp->flags & NET_TCP_SACK_OK) || len == 0U ||
+	    tcp->ooo_count >= CONFIG_NET_TCP_OOO_MAX ||
+	    net_tcp_seq_greater(seq + len, tcp->send_ack + tcp->recv_wnd)) {
+		return false;
+	}
+
+	for (pos = 0; pos < tcp->ooo_count; pos++) {
+		if (net_tcp_seq_greater(tcp->ooo[pos].seq, seq)) {
+			break;
+		}
+	}
+
+	if ((pos > 0 &&
+	     net_tcp_seq_greater(tcp->ooo[pos - 1].seq +
+				 tcp->ooo[pos - 1].len, seq)) ||
+	    (pos < tcp->ooo_count &&
+	     net_tcp_seq_greater(seq + len, tcp->ooo[pos].seq))) {
+		return false;
+	}
+
+	for (i = tcp->ooo_count; i > pos; i--) {
+		tcp->ooo[i] = tcp->ooo[i - 1];
+	}
+
+	tcp->ooo[pos].pkt = pkt;
+	tcp->ooo[pos].seq = seq;
+	tcp->ooo[pos].len = len;
+	tcp->ooo_count++;
+	tcp->ooo_last = seq;
+
+	NET_DBG("[%p] pkt %p seq %u len %u kept out of order (%u)", tcp, pkt,
+		seq, len, tcp->ooo_count);
+
+	return true;
+}
+
+/* The headers given to the receive callback are found again as they are
+ * only valid during the input of the packet.
+ */
+static enum net_verdict tcp_ooo_deliver(struct net_conn *conn,
+					struct net_context *context,
+					struct net_pkt *pkt, u32_t skip)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+					      struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+					      struct net_ipv6_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip_hdr.ipv4 = (struct net_ipv4_hdr *)
+			net_pkt_get_data(pkt, &ipv4_access);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		ip_hdr.ipv6 = (struct net_ipv6_hdr *)
+			net_pkt_get_data(pkt, &ipv6_access);
+	} else {
+		return NET_DROP;
+	}
+
+	if (!ip_hdr.ipv4 ||
+	    net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv6_ext_len(pkt))) {
+		return NET_DROP;
+	}
+
+	proto_hdr.tcp = (struct net_tcp_hdr *)net_pkt_get_data(pkt,
+							       &tcp_access);
+	if (!proto_hdr.tcp ||
+	    net_pkt_skip(pkt, NET_TCP_HDR_LEN(proto_hdr.tcp) + skip)) {
+		return NET_DROP;
+	}
+
+	return net_context_packet_received(conn, pkt, &ip_hdr, &proto_hdr,
+					   context->tcp->recv_user_data);
+}
+
+/* Hand the segments kept out of order that are now in sequence to the
+ * application
+ */
+static void tcp_ooo_flush(struct net_conn *conn, struct net_context *context)
+{
+	struct net_tcp *tcp = context->tcp;
+	struct net_pkt *pkt;
+	u32_t seq, len;
+
+	while (tcp->ooo_count &&
+	       !net_tcp_seq_greater(tcp->ooo[0].seq, tcp->send_ack)) {
+		pkt = tcp->ooo[0].pkt;
+		seq = tcp->ooo[0].seq;
+		len = tcp->ooo[0].len;
+
+		tcp->ooo_count--;
+		memmove(&tcp->ooo[0], &tcp->ooo[1],
+			tcp->ooo_count * sizeof(tcp->ooo[0]));
+
+		if (!net_tcp_seq_greater(seq + len, tcp->send_ack)) {
+			/* Received again in sequence meanwhile */
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		if (tcp_ooo_deliver(conn, context, pkt,
+				    tcp->send_ack - seq) == NET_DROP) {
+			net_pkt_unref(pkt);
+		}
+
+		tcp->send_ack = seq + len;
+	}
+}
+#else
+#define tcp_ooo_queue(...) false
+#define tcp_ooo_flush(...)
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* This is called when we receive data after the connection has been
  * established. The core TCP logic is located here.
  *
@@ -1898,9 +2513,12 @@ NET_CONN_CB(tcp_established)
 {
 	struct net_context *context = (struct net_context *)user_data;
 	struct net_tcp_hdr *tcp_hdr = proto_hdr->tcp;
+	struct net_tcp_options tcp_opts = { 0 };
 	enum net_verdict ret = NET_OK;
+	int opt_totlen;
 	u8_t tcp_flags;
 	u16_t data_len;
+	u32_t seq;
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
@@ -1916,9 +2534,19 @@ NET_CONN_CB(tcp_established)
 	net_tcp_print_recv_info("DATA", pkt, tcp_hdr->src_port);
 
 	tcp_flags = NET_TCP_FLAGS(tcp_hdr);
+	seq = sys_get_be32(tcp_hdr->seq);
 
-	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
-			    context->tcp->send_ack) < 0) {
+	/* The options are not part of the data */
+	opt_totlen = NET_TCP_HDR_LEN(tcp_hdr) - sizeof(struct net_tcp_hdr);
+	if (opt_totlen < 0 ||
+	    net_tcp_parse_opts(pkt, opt_totlen, &tcp_opts) < 0) {
+		ret = NET_DROP;
+		goto unlock;
+	}
+
+	data_len = net_pkt_remaining_data(pkt);
+
+	if (net_tcp_seq_cmp(seq, context->tcp->send_ack) < 0) {
 		/* Peer sent us packet we've already seen. Apparently,
 		 * our ack was lost.
 		 */
@@ -1932,13 +2560,25 @@ resend_ack:
 		goto unlock;
 	}
 
-	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
-			    context->tcp->send_ack) > 0) {
-		/* Don't try to reorder packets.  If it doesn't
-		 * match the next segment exactly, drop and wait for
-		 * retransmit
+	if (net_tcp_seq_cmp(seq, context->tcp->send_ack) > 0) {
+		/* A segment is missing before this one. It is kept if SACK
+		 * is in use, else dropped to wait for the retransmission.
+		 * Either way the peer gets a duplicate ACK right away to
+		 * trigger its fast retransmit (RFC 5681, 4.2).
 		 */
-		ret = NET_DROP;
+		if (tcp_flags & NET_TCP_RST) {
+			ret = NET_DROP;
+			goto unlock;
+		}
+
+		if (!(tcp_flags & (NET_TCP_SYN | NET_TCP_FIN)) &&
+		    tcp_ooo_queue(context->tcp, pkt, seq, data_len)) {
+			ret = NET_OK;
+		} else {
+			ret = NET_DROP;
+		}
+
+		send_ack(context, &conn->remote_addr, true);
 		goto unlock;
 	}
 
@@ -1971,12 +2611,34 @@ resend_ack:
 
 	/* Handle TCP state transition */
 	if (tcp_flags & NET_TCP_ACK) {
-		if (!net_tcp_ack_received(context,
-					  sys_get_be32(tcp_hdr->ack))) {
+		struct net_tcp *tcp = context->tcp;
+		u32_t ack = sys_get_be32(tcp_hdr->ack);
+		u32_t wnd = (u32_t)sys_get_be16(tcp_hdr->wnd) <<
+			    tcp->snd_wscale;
+		/* RFC 5681 (2) */
+		bool dupack = ack == tcp->snd_una && data_len == 0U &&
+			      !(tcp_flags & (NET_TCP_SYN | NET_TCP_FIN)) &&
+			      wnd == tcp->snd_wnd &&
+			      tcp->snd_nxt != tcp->snd_una;
+
+		tcp_sack_update(tcp, &tcp_opts);
+
+		if (!net_tcp_ack_received(context, ack)) {
 			ret = NET_DROP;
 			goto unlock;
 		}
 
+		if (!net_tcp_seq_greater(tcp->snd_una, ack)) {
+			tcp->snd_wnd = wnd;
+		}
+
+		if (dupack) {
+			tcp_dupack(tcp);
+		}
+
+		/* Send what the ACK allows now */
+		tcp_send_queued(tcp);
+
 		/* TCP state might be changed after maintaining the sent pkt
 		 * list, e.g., an ack of FIN is received.
 		 */
@@ -2018,7 +2680,6 @@ resend_ack:
 		context->tcp->fin_rcvd = 1U;
 	}
 
-	data_len = net_pkt_remaining_data(pkt);
 	if (data_len > net_tcp_get_recv_wnd(context->tcp)) {
 		/* In case we have zero window, we should still accept
 		 * Zero Window Probes from peer, which per convention
@@ -2055,6 +2716,9 @@ resend_ack:
 		context->tcp->send_ack += 1U;
 	}
 
+	/* The data kept out of order may follow now */
+	tcp_ooo_flush(conn, context);
+
 	send_ack(context, &conn->remote_addr, false);
 
 clean_up:
@@ -2138,8 +2802,28 @@ NET_CONN_CB(tcp_synack_received)
 		/* Remove the temporary connection handler and register
 		 * a proper now as we have an established connection.
 		 */
+		struct net_tcp_options tcp_opts = {
+			.mss = NET_TCP_DEFAULT_MSS,
+		};
 		struct sockaddr local_addr;
 		struct sockaddr remote_addr;
+		int opt_totlen;
+
+		opt_totlen = NET_TCP_HDR_LEN(tcp_hdr)
+			     - sizeof(struct net_tcp_hdr);
+		if (net_tcp_parse_opts(pkt, opt_totlen, &tcp_opts) < 0) {
+			return NET_DROP;
+		}
+
+		tcp_set_peer_opts(context->tcp, tcp_opts.mss,
+				  tcp_opts.wscale_ok, tcp_opts.wscale,
+				  tcp_opts.sack_ok);
+
+		/* The window of a SYN segment is not scaled */
+		context->tcp->snd_wnd = sys_get_be16(tcp_hdr->wnd);
+		context->tcp->snd_una = context->tcp->send_seq;
+		context->tcp->snd_nxt = context->tcp->send_seq;
+		net_tcp_cc_init(context->tcp);
 
 		tcp_copy_ip_addr_from_hdr(net_pkt_family(pkt), ip_hdr, tcp_hdr,
 					  &remote_addr, true);
@@ -2289,10 +2973,12 @@ NET_CONN_CB(tcp_syn_rcvd)
 		context->tcp->send_ack =
 			sys_get_be32(tcp_hdr->seq) + 1;
 
-		/* Get MSS from TCP options here*/
+		/* Get MSS, window scale and SACK permitted from TCP
+		 * options here
+		 */
 
 		r = tcp_backlog_syn(pkt, ip_hdr, tcp_hdr,
-				    context, tcp_opts.mss);
+				    context, &tcp_opts);
 		if (r < 0) {
 			if (r == -EADDRINUSE) {
 				NET_DBG("TCP connection already exists");
@@ -2306,7 +2992,7 @@ NET_CONN_CB(tcp_syn_rcvd)
 		get_sockaddr_ptr(ip_hdr, tcp_hdr,
 				 net_context_get_family(context),
 				 &pkt_src_addr);
-		send_syn_ack(context, &pkt_src_addr, &remote_addr);
+		send_syn_ack(context, &pkt_src_addr, &remote_addr, &tcp_opts);
 		net_pkt_unref(pkt);
 		return NET_OK;
 	}
@@ -2571,11 +3257,22 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
-	    net_calc_chksum_tcp(pkt) != 0U) {
+	    !net_pkt_gro_segs(pkt) && net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
 	}
 
+	tcp_hdr = net_pkt_hdr_cache_get(pkt, net_pkt_ip_hdr_len(pkt) +
+					net_pkt_ipv6_ext_len(pkt),
+					sizeof(struct net_tcp_hdr));
+	if (tcp_hdr) {
+		if (!net_pkt_skip(pkt, sizeof(struct net_tcp_hdr))) {
+			return tcp_hdr;
+		}
+
+		goto drop;
+	}
+
 	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, tcp_access);
 	if (tcp_hdr && !net_pkt_set_data(pkt, tcp_access)) {
 		return tcp_hdr;
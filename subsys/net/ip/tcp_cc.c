@@ -0,0 +1,163 @@
+/** @file
+ * @brief TCP congestion control
+ *
+ * Registry of the congestion control algorithms, NewReno, and the round
+ * trip time estimator.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+#include <errno.h>
+#include <misc/slist.h>
+
+#include "tcp_internal.h"
+
+static sys_slist_t cc_list = SYS_SLIST_STATIC_INIT(&cc_list);
+
+/* RFC 5681 (3.1), slow start with appropriate byte counting (RFC 3465)
+ * limited to one segment per ACK
+ */
+static void newreno_cong_avoid(struct net_tcp *tcp, u32_t acked)
+{
+	if (tcp->cwnd < tcp->ssthresh) {
+		tcp->cwnd += MIN(acked, tcp->send_mss);
+		return;
+	}
+
+	/* About one segment per round trip. The remainder of the division
+	 * is kept so that large windows still grow.
+	 */
+	tcp->cc_priv[0] += acked;
+	if (tcp->cc_priv[0] >= tcp->cwnd) {
+		tcp->cc_priv[0] -= tcp->cwnd;
+		tcp->cwnd += tcp->send_mss;
+	}
+}
+
+/* RFC 5681 (4) */
+static u32_t newreno_ssthresh(struct net_tcp *tcp)
+{
+	u32_t flight = tcp->snd_nxt - tcp->snd_una;
+
+	tcp->cc_priv[0] = 0U;
+
+	return MAX(flight / 2U, 2U * tcp->send_mss);
+}
+
+static struct net_tcp_cc tcp_newreno = {
+	.name = "newreno",
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
+
+void net_tcp_cc_register(struct net_tcp_cc *cc)
+{
+	sys_slist_append(&cc_list, &cc->node);
+}
+
+const struct net_tcp_cc *net_tcp_cc_find(const char *name)
+{
+	struct net_tcp_cc *cc;
+
+	/* NewReno is always there, even before net_tcp_init() */
+	if (!strcmp(name, tcp_newreno.name)) {
+		return &tcp_newreno;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&cc_list, cc, node) {
+		if (!strcmp(name, cc->name)) {
+			return cc;
+		}
+	}
+
+	return NULL;
+}
+
+/* RFC 3390 initial window */
+static u32_t initial_window(u16_t mss)
+{
+	return MIN(4U * mss, MAX(2U * mss, 4380U));
+}
+
+static void cc_start(struct net_tcp *tcp, const struct net_tcp_cc *cc)
+{
+	tcp->cc = cc;
+	tcp->cwnd = initial_window(tcp->send_mss);
+	tcp->ssthresh = UINT32_MAX;
+	(void)memset(tcp->cc_priv, 0, sizeof(tcp->cc_priv));
+
+	if (cc->init) {
+		cc->init(tcp);
+	}
+}
+
+int net_tcp_cc_set(struct net_tcp *tcp, const char *name)
+{
+	const struct net_tcp_cc *cc = net_tcp_cc_find(name);
+
+	if (!cc) {
+		return -ENOENT;
+	}
+
+	cc_start(tcp, cc);
+
+	return 0;
+}
+
+/* Called by the connection setup, once the MSS of the peer is known */
+void net_tcp_cc_init(struct net_tcp *tcp)
+{
+	const struct net_tcp_cc *cc = tcp->cc;
+
+	if (!cc) {
+		if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+			cc = net_tcp_cc_find("cubic");
+		}
+
+		if (!cc) {
+			cc = &tcp_newreno;
+		}
+	}
+
+	cc_start(tcp, cc);
+}
+
+void net_tcp_rtt_update(struct net_tcp *tcp, u32_t rtt)
+{
+	s32_t delta;
+	u32_t rto;
+
+	if (rtt == 0U) {
+		/* Below the clock granularity */
+		rtt = 1U;
+	}
+
+	if (tcp->srtt == 0U) {
+		/* RFC 6298 (2.2) */
+		tcp->srtt = rtt << 3;
+		tcp->rttvar = rtt << 1;
+	} else {
+		/* RFC 6298 (2.3), alpha = 1/8, beta = 1/4 */
+		delta = (s32_t)rtt - (s32_t)(tcp->srtt >> 3);
+		tcp->srtt += delta;
+		if (delta < 0) {
+			delta = -delta;
+		}
+		tcp->rttvar += delta - (s32_t)(tcp->rttvar >> 2);
+	}
+
+	rto = (tcp->srtt >> 3) + MAX(1U, tcp->rttvar);
+	tcp->rto = MIN(MAX(rto, CONFIG_NET_TCP_RTO_MIN), NET_TCP_RTO_MAX);
+
+	NET_DBG("[%p] rtt %u srtt %u rttvar %u rto %u", tcp, rtt,
+		tcp->srtt >> 3, tcp->rttvar >> 2, tcp->rto);
+}
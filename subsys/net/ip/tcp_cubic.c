@@ -0,0 +1,143 @@
+/** @file
+ * @brief CUBIC TCP congestion control
+ *
+ * CUBIC as described in RFC 8312, with fast convergence and the TCP
+ * friendly region, in integer arithmetic.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <kernel.h>
+
+#include "tcp_internal.h"
+
+/* C = 0.4 and beta = 0.7 as recommended by the RFC */
+#define BETA_NUM 7
+#define BETA_DEN 10
+
+/* State in the cc_priv words of the connection */
+#define W_MAX(tcp)       ((tcp)->cc_priv[0])
+#define W_LAST_MAX(tcp)  ((tcp)->cc_priv[1])
+#define EPOCH_START(tcp) ((tcp)->cc_priv[2])
+#define K_MS(tcp)        ((tcp)->cc_priv[3])
+
+static u32_t cbrt64(u64_t x)
+{
+	u64_t y = 0U;
+	int s;
+
+	for (s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		if ((x >> s) >= 3U * y * (y + 1U) + 1U) {
+			x -= (3U * y * (y + 1U) + 1U) << s;
+			y++;
+		}
+	}
+
+	return (u32_t)y;
+}
+
+static void cubic_epoch_start(struct net_tcp *tcp)
+{
+	u32_t now = k_uptime_get_32();
+
+	/* 0 means no epoch */
+	EPOCH_START(tcp) = now ? now : 1U;
+
+	if (tcp->cwnd < W_MAX(tcp)) {
+		/* K = cbrt((W_max - cwnd) / C), in ms with W in segments */
+		K_MS(tcp) = cbrt64((u64_t)(W_MAX(tcp) - tcp->cwnd) *
+				   2500000000ULL / tcp->send_mss);
+	} else {
+		W_MAX(tcp) = tcp->cwnd;
+		K_MS(tcp) = 0U;
+	}
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max, RFC 8312 (4.1) */
+static s64_t cubic_window(struct net_tcp *tcp, u32_t t)
+{
+	s64_t d = (s64_t)t - (s64_t)K_MS(tcp);
+	s64_t d3;
+
+	/* Keep d^3 * mss within 64 bits, the window is useless long
+	 * before anyway
+	 */
+	d = MIN(MAX(d, -100000), 100000);
+	d3 = d * d * d;
+
+	return (s64_t)W_MAX(tcp) + d3 / 1000000 * tcp->send_mss * 4 / 10000;
+}
+
+static void cubic_cong_avoid(struct net_tcp *tcp, u32_t acked)
+{
+	u32_t rtt = MAX(tcp->srtt >> 3, 1U);
+	s64_t target, w_est;
+	u32_t t;
+
+	if (tcp->cwnd < tcp->ssthresh) {
+		tcp->cwnd += MIN(acked, tcp->send_mss);
+		return;
+	}
+
+	if (!EPOCH_START(tcp)) {
+		cubic_epoch_start(tcp);
+	}
+
+	/* The window one round trip from now is aimed at */
+	t = k_uptime_get_32() - EPOCH_START(tcp) + rtt;
+	target = cubic_window(tcp, t);
+
+	/* TCP friendly region, RFC 8312 (4.2):
+	 * W_est = W_max * beta + 3 * (1 - beta) / (1 + beta) * t / RTT
+	 */
+	w_est = (s64_t)W_MAX(tcp) * BETA_NUM / BETA_DEN +
+		(s64_t)9 * tcp->send_mss * t / (17 * rtt);
+	if (w_est > target) {
+		target = w_est;
+	}
+
+	/* RFC 8312 (4.3), at most 1.5 times the window per round trip */
+	target = MIN(target, (s64_t)tcp->cwnd * 3 / 2);
+
+	if (target > tcp->cwnd) {
+		tcp->cwnd += MAX((u32_t)((target - tcp->cwnd) * acked /
+					 tcp->cwnd), 1U);
+	}
+}
+
+static u32_t cubic_ssthresh(struct net_tcp *tcp)
+{
+	EPOCH_START(tcp) = 0U;
+
+	/* Fast convergence, RFC 8312 (4.6) */
+	if (tcp->cwnd < W_LAST_MAX(tcp)) {
+		W_LAST_MAX(tcp) = tcp->cwnd;
+		W_MAX(tcp) = (u64_t)tcp->cwnd * (BETA_DEN + BETA_NUM) /
+			     (2 * BETA_DEN);
+	} else {
+		W_LAST_MAX(tcp) = tcp->cwnd;
+		W_MAX(tcp) = tcp->cwnd;
+	}
+
+	return MAX((u64_t)tcp->cwnd * BETA_NUM / BETA_DEN,
+		   2U * tcp->send_mss);
+}
+
+static struct net_tcp_cc tcp_cubic = {
+	.name = "cubic",
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
+
+void net_tcp_cubic_register(void)
+{
+	net_tcp_cc_register(&tcp_cubic);
+}
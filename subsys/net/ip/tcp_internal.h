@@ -29,7 +29,11 @@ extern "C" {
 /** Is this TCP context/socket used or not */
 #define NET_TCP_IN_USE BIT(0)
 
-/* BIT(1), BIT(2) are unused and available */
+/** Window scale option has been agreed on with the peer */
+#define NET_TCP_WSCALE_OK BIT(1)
+
+/** Selective acknowledgments have been agreed on with the peer */
+#define NET_TCP_SACK_OK BIT(2)
 
 /** Is the socket shutdown for read/write */
 #define NET_TCP_IS_SHUTDOWN BIT(3)
@@ -77,33 +81,114 @@ enum net_tcp_state {
  */
 #define NET_TCP_DEFAULT_MSS   536
 
+/* Largest window shift of RFC 7323 */
+#define NET_TCP_MAX_WSCALE 14
+
 /* TCP max window size */
-#define NET_TCP_MAX_WIN   (4 * 1024)
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN   (0xffff << NET_TCP_MAX_WSCALE)
+#else
+#define NET_TCP_MAX_WIN   0xffff
+#endif
 
 /* Maximal value of the sequence number */
 #define NET_TCP_MAX_SEQ   0xffffffff
 
 #define NET_TCP_MAX_OPT_SIZE  8
 
+/* Room for the options of any segment we send */
+#define NET_TCP_OPT_BUF_SIZE  40
+
 /* TCP Option codes */
 #define NET_TCP_END_OPT          0
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Max SACK blocks in a segment, with 2 bytes of padding and no other option */
+#define NET_TCP_MAX_SACK_BLOCKS 4
+
+/** Block of data received out of order, [start, end) */
+struct net_tcp_sack_block {
+	u32_t start;
+	u32_t end;
+};
 
 /** Parsed TCP option values for net_tcp_parse_opts()  */
 struct net_tcp_options {
 	u16_t mss;
+	/** Window shift of the peer, valid if wscale_ok */
+	u8_t wscale;
+	u8_t wscale_ok : 1;
+	u8_t sack_ok : 1;
+	/** Number of valid entries in sack */
+	u8_t sack_count;
+	struct net_tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
 };
 
 /* Max received bytes to buffer internally */
+#if defined(CONFIG_NET_TCP_RECV_WINDOW_SIZE)
+#define NET_TCP_BUF_MAX_LEN CONFIG_NET_TCP_RECV_WINDOW_SIZE
+#else
 #define NET_TCP_BUF_MAX_LEN 1280
+#endif
+
+/* Upper bound of the retransmission timeout, RFC 6298 (2.5) */
+#define NET_TCP_RTO_MAX K_SECONDS(60)
+
+/* Duplicate ACKs making a segment considered lost, RFC 5681 */
+#define NET_TCP_DUPACK_THRESH 3
+
+/** Loss recovery state of the sender */
+enum net_tcp_recovery {
+	NET_TCP_RECOVERY_NONE = 0,
+	/** Fast retransmit and fast recovery, RFC 6582 */
+	NET_TCP_RECOVERY_FAST,
+	/** After a retransmission timeout */
+	NET_TCP_RECOVERY_LOSS,
+};
+
+struct net_tcp;
+
+/**
+ * Congestion control algorithm.
+ *
+ * The stack takes care of loss detection and recovery; an algorithm only
+ * decides how the congestion window grows and how much it shrinks on a
+ * loss, through the cwnd and ssthresh fields of struct net_tcp. Its own
+ * state lives in the cc_priv field.
+ */
+struct net_tcp_cc {
+	sys_snode_t node;
+
+	/** Name to select the algorithm with net_tcp_cc_set() */
+	const char *name;
+
+	/** Connection starts, optional (cwnd and ssthresh are set) */
+	void (*init)(struct net_tcp *tcp);
+
+	/** New data of acked bytes was acknowledged outside of recovery */
+	void (*cong_avoid)(struct net_tcp *tcp, u32_t acked);
+
+	/** Loss detected, return the new slow start threshold */
+	u32_t (*ssthresh)(struct net_tcp *tcp);
+
+	/** Fast recovery is over, optional (cwnd is set to ssthresh) */
+	void (*recovered)(struct net_tcp *tcp);
+};
+
+/* Words of congestion control private state per connection */
+#define NET_TCP_CC_PRIV_WORDS 5
 
 /* Max segment lifetime, in seconds */
 #define NET_TCP_MAX_SEG_LIFETIME 60
@@ -154,13 +239,78 @@ struct net_tcp {
 	/**
 	 * Current TCP receive window for our side
 	 */
-	u16_t recv_wnd;
+	u32_t recv_wnd;
+
+	/** Oldest unacknowledged sequence number */
+	u32_t snd_una;
+
+	/** Next sequence number to transmit for the first time */
+	u32_t snd_nxt;
+
+	/** Send window of the peer, scaled */
+	u32_t snd_wnd;
+
+	/** Congestion window */
+	u32_t cwnd;
+
+	/** Slow start threshold */
+	u32_t ssthresh;
+
+	/** Highest sequence number sent when loss recovery started */
+	u32_t recover;
+
+	/** Congestion control algorithm and its state */
+	const struct net_tcp_cc *cc;
+	u32_t cc_priv[NET_TCP_CC_PRIV_WORDS];
+
+	/** Smoothed round trip time, in 1/8 ms */
+	u32_t srtt;
+
+	/** Round trip time variation, in 1/4 ms */
+	u32_t rttvar;
+
+	/** Retransmission timeout before backoff, in ms */
+	u32_t rto;
+
+	/** Segment being timed, ends at rtt_seq, sent at rtt_start */
+	u32_t rtt_seq;
+	u32_t rtt_start;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/** Segments received out of order, by increasing sequence */
+	struct {
+		struct net_pkt *pkt;
+		u32_t seq;
+		u32_t len;
+	} ooo[CONFIG_NET_TCP_OOO_MAX];
+
+	/** Data the peer reported as received out of order */
+	struct net_tcp_sack_block sacked[NET_TCP_MAX_SACK_BLOCKS];
+
+	/** Sequence number of the last segment queued out of order */
+	u32_t ooo_last;
+
+	u8_t ooo_count;
+#endif
 
 	/**
 	 * Send MSS for the peer
 	 */
 	u16_t send_mss;
 
+	/** Window shifts applied by the peer and by us (RFC 7323) */
+	u8_t snd_wscale : 4;
+	u8_t rcv_wscale : 4;
+
+	/** Duplicate ACKs received in a row */
+	u8_t dupacks;
+
+	/** A round trip time measurement is ongoing */
+	u8_t rtt_active : 1;
+
+	/** Loss recovery state, enum net_tcp_recovery */
+	u8_t recovery : 2;
+
 	/** Current retransmit period */
 	u32_t retry_timeout_shift : 5;
 	/** Flags for the TCP */
@@ -467,6 +617,61 @@ static inline bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP)
+/**
+ * @brief Make a congestion control algorithm available
+ *
+ * @param cc Algorithm, which must stay valid afterwards
+ */
+void net_tcp_cc_register(struct net_tcp_cc *cc);
+
+/**
+ * @brief Find a congestion control algorithm by name
+ *
+ * @param name Name of the algorithm
+ *
+ * @return Algorithm, or NULL if none is registered with that name
+ */
+const struct net_tcp_cc *net_tcp_cc_find(const char *name);
+
+/**
+ * @brief Change the congestion control algorithm of a connection
+ *
+ * The congestion window starts over from the initial window.
+ *
+ * @param tcp TCP context
+ * @param name Name of the algorithm
+ *
+ * @return 0 if ok, -ENOENT if there is no such algorithm
+ */
+int net_tcp_cc_set(struct net_tcp *tcp, const char *name);
+
+/**
+ * @brief Feed a round trip time measurement to the RTO estimator
+ *
+ * Update the smoothed round trip time, its variation and the
+ * retransmission timeout as of RFC 6298.
+ *
+ * @param tcp TCP context
+ * @param rtt Round trip time measured, in ms
+ */
+void net_tcp_rtt_update(struct net_tcp *tcp, u32_t rtt);
+
+/**
+ * @brief Start congestion control on a new connection
+ *
+ * Use the algorithm already selected on the context if any, else the
+ * default one from Kconfig.
+ *
+ * @param tcp TCP context
+ */
+void net_tcp_cc_init(struct net_tcp *tcp);
+#endif
+
+#if defined(CONFIG_NET_TCP_CUBIC)
+void net_tcp_cubic_register(void);
+#endif
+
 /**
  * @brief Calculates and returns the MSS for a given TCP context
  *
@@ -0,0 +1,216 @@
+/** @file
+ * @brief TCP segmentation offload
+ *
+ * A TCP packet larger than the MTU is built once by the TCP layer and
+ * cut into segments here, just before the L2 sends it, unless the
+ * Ethernet device segments it itself.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+#include <errno.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/ethernet.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define TSO_ALLOC_TIMEOUT K_MSEC(100)
+
+static bool tso_in_hw(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO;
+	}
+#endif
+
+	return false;
+}
+
+static void tso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	memcpy(&seg->lladdr_src, &pkt->lladdr_src, sizeof(seg->lladdr_src));
+	memcpy(&seg->lladdr_dst, &pkt->lladdr_dst, sizeof(seg->lladdr_dst));
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_orig_iface(seg, net_pkt_orig_iface(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Sequence number, flags, lengths and checksums of a segment */
+static int tso_finalize(struct net_pkt *seg, u32_t offset, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) +
+			 net_pkt_ipv6_ext_len(seg))) {
+		return -EMSGSIZE;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -EMSGSIZE;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	/* FIN and PSH belong to the end of the data only */
+	if (!last) {
+		tcp_hdr->flags &= ~(NET_TCP_FIN | NET_TCP_PSH);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -EMSGSIZE;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							seg, &ipv4_access);
+		if (!ipv4_hdr) {
+			return -EMSGSIZE;
+		}
+
+		ipv4_hdr->chksum = 0U;
+
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(seg) == AF_INET6) {
+		return net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	return -EAFNOSUPPORT;
+}
+
+static struct net_pkt *tso_segment(struct net_pkt *pkt,
+				   struct net_pkt_cursor *data,
+				   size_t hdr_len, u32_t offset, size_t len,
+				   bool last)
+{
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, TSO_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	tso_copy_attributes(seg, pkt);
+
+	/* The headers of the packet, then the data at the saved cursor */
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_copy(seg, pkt, hdr_len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_restore(pkt, data);
+	if (net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_backup(pkt, data);
+
+	if (tso_finalize(seg, offset, last) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_tcp_tso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t mss = net_pkt_tso_mss(pkt);
+	size_t hdr_len, data_len, len;
+	struct net_pkt_cursor data;
+	struct net_tcp_hdr hdr;
+	struct net_pkt *seg;
+	u32_t offset;
+	int sent = 0;
+	int ret;
+
+	if (tso_in_hw(iface)) {
+		return net_if_l2(iface)->send(iface, pkt);
+	}
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv6_ext_len(pkt);
+	if (net_buf_linearize(&hdr, sizeof(hdr), pkt->buffer, hdr_len,
+			      sizeof(hdr)) != sizeof(hdr)) {
+		return -EMSGSIZE;
+	}
+
+	hdr_len += NET_TCP_HDR_LEN(&hdr);
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	/* The packet stays in the sent list of TCP, it is only read */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	if (net_pkt_skip(pkt, hdr_len)) {
+		return -EMSGSIZE;
+	}
+
+	net_pkt_cursor_backup(pkt, &data);
+
+	for (offset = 0U; offset < data_len; offset += len) {
+		len = MIN(mss, data_len - offset);
+
+		seg = tso_segment(pkt, &data, hdr_len, offset, len,
+				  offset + len == data_len);
+		if (!seg) {
+			return -ENOMEM;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			NET_DBG("pkt %p segment at %u not sent (%d)", pkt,
+				offset, ret);
+			net_pkt_unref(seg);
+			return ret;
+		}
+
+		sent += ret;
+	}
+
+	NET_DBG("pkt %p sent as %u segments of %zu bytes", pkt,
+		(u32_t)((data_len + mss - 1) / mss), mss);
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
@@ -148,10 +148,20 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 {
 	struct net_udp_hdr *udp_hdr;
 
-	udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, udp_access);
-	if (!udp_hdr || net_pkt_set_data(pkt, udp_access)) {
-		NET_DBG("DROP: corrupted header");
-		goto drop;
+	udp_hdr = net_pkt_hdr_cache_get(pkt, net_pkt_ip_hdr_len(pkt) +
+					net_pkt_ipv6_ext_len(pkt),
+					sizeof(struct net_udp_hdr));
+	if (udp_hdr) {
+		if (net_pkt_skip(pkt, sizeof(struct net_udp_hdr))) {
+			goto drop;
+		}
+	} else {
+		udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt,
+								 udp_access);
+		if (!udp_hdr || net_pkt_set_data(pkt, udp_access)) {
+			NET_DBG("DROP: corrupted header");
+			goto drop;
+		}
 	}
 
 	if (ntohs(udp_hdr->len) != (net_pkt_get_len(pkt) -
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <stdbool.h>
 #include <string.h>
 #include <errno.h>
+#include <misc/byteorder.h>
 
 #include <net/net_ip.h>
 #include <net/net_pkt.h>
@@ -400,34 +401,112 @@ int net_addr_pton(sa_family_t family, const char *src,
 	return 0;
 }
 
-static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
+static inline u16_t chksum_add(u16_t sum, u16_t val)
+{
+	sum += val;
+	if (sum < val) {
+		sum++;
+	}
+
+	return sum;
+}
+
+/* Fold a sum of 32-bit native words into a 16-bit sum of big endian
+ * words. The one's complement sum does not depend on the byte order, so
+ * it only needs swapping on little endian CPUs.
+ */
+static inline u16_t chksum_fold(u64_t acc)
+{
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+
+	return sys_be16_to_cpu((u16_t)acc);
+}
+
+static u16_t calc_chksum_tail(u16_t sum, const u8_t *data, size_t len)
 {
 	const u8_t *end;
-	u16_t tmp;
 
 	end = data + len - 1;
 
 	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
-
+		sum = chksum_add(sum, (data[0] << 8) + data[1]);
 		data += 2;
 	}
 
 	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+		sum = chksum_add(sum, data[0] << 8);
 	}
 
 	return sum;
 }
 
+/* Sum a word at a time, the data may not be aligned */
+static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
+{
+	u64_t acc = 0U;
+
+	if (len < 8) {
+		return calc_chksum_tail(sum, data, len);
+	}
+
+	while (len >= 16) {
+		acc += UNALIGNED_GET((const u32_t *)data);
+		acc += UNALIGNED_GET((const u32_t *)(data + 4));
+		acc += UNALIGNED_GET((const u32_t *)(data + 8));
+		acc += UNALIGNED_GET((const u32_t *)(data + 12));
+		data += 16;
+		len -= 16;
+	}
+
+	while (len >= 4) {
+		acc += UNALIGNED_GET((const u32_t *)data);
+		data += 4;
+		len -= 4;
+	}
+
+	sum = chksum_add(sum, chksum_fold(acc));
+
+	return calc_chksum_tail(sum, data, len);
+}
+
+u16_t net_chksum_copy(u16_t sum, void *dst, const void *src, size_t len)
+{
+	const u8_t *s = src;
+	u8_t *d = dst;
+	u64_t acc = 0U;
+	u32_t word;
+
+	while (len >= 4) {
+		word = UNALIGNED_GET((const u32_t *)s);
+		UNALIGNED_PUT(word, (u32_t *)d);
+		acc += word;
+		s += 4;
+		d += 4;
+		len -= 4;
+	}
+
+	if (len) {
+		memcpy(d, s, len);
+	}
+
+	sum = chksum_add(sum, chksum_fold(acc));
+
+	return calc_chksum_tail(sum, s, len);
+}
+
+u16_t net_chksum_append(u16_t sum, u16_t part, size_t offset)
+{
+	/* Data summed at an odd offset is byte swapped */
+	if (offset & 1) {
+		part = (part << 8) | (part >> 8);
+	}
+
+	return chksum_add(sum, part);
+}
+
 static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
@@ -465,7 +544,42 @@ static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
 	return sum;
 }
 
-u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
+/* Sum the protocol header in front of the data which was summed as it
+ * was written, if any, then add that data sum.
+ */
+static bool pkt_calc_chksum_with_data(struct net_pkt *pkt, u16_t *sum)
+{
+#if defined(CONFIG_NET_UDP)
+	size_t hdr_len;
+
+	if (!net_pkt_data_chksum_valid(pkt)) {
+		return false;
+	}
+
+	hdr_len = net_pkt_remaining_data(pkt);
+	if (hdr_len < pkt->data_chksum_len) {
+		return false;
+	}
+
+	hdr_len -= pkt->data_chksum_len;
+	if (!net_pkt_is_contiguous(pkt, hdr_len)) {
+		return false;
+	}
+
+	*sum = calc_chksum(*sum, pkt->cursor.pos, hdr_len);
+	*sum = net_chksum_append(*sum, pkt->data_chksum, hdr_len);
+
+	return true;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+
+	return false;
+#endif
+}
+
+__hotfunc(net_calc_chksum) u16_t net_calc_chksum(struct net_pkt *pkt,
+						  u8_t proto)
 {
 	size_t len = 0U;
 	u16_t sum = 0U;
@@ -502,7 +616,9 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 
 	net_pkt_skip(pkt, len + net_pkt_ipv6_ext_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	if (!pkt_calc_chksum_with_data(pkt, &sum)) {
+		sum = pkt_calc_chksum(pkt, sum);
+	}
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
@@ -23,76 +23,88 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT K_SECONDS(2)
 
+#define ARP_HASH_BUCKETS CONFIG_NET_ARP_HASH_BUCKETS
+
+BUILD_ASSERT_MSG((ARP_HASH_BUCKETS & (ARP_HASH_BUCKETS - 1)) == 0,
+		 "NET_ARP_HASH_BUCKETS must be a power of two");
+
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
 static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+
+/* Entries in use, pending or resolved, hashed by their address */
+static sys_slist_t arp_table[ARP_HASH_BUCKETS];
 
 struct k_delayed_work arp_request_timer;
 
-static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
+static inline sys_slist_t *arp_bucket(const struct in_addr *addr)
+{
+	/* The hosts of a subnet differ in the last bytes of the address,
+	 * which the address may be unaligned to read as a word.
+	 */
+	u32_t hash = addr->s4_addr[3] | (addr->s4_addr[2] << 8);
+
+	hash ^= (addr->s4_addr[1] ^ addr->s4_addr[0]) << 4;
+
+	return &arp_table[hash & (ARP_HASH_BUCKETS - 1)];
+}
+
+static void arp_entry_cleanup(struct arp_entry *entry)
 {
+	int i;
+
 	NET_DBG("%p", entry);
 
-	if (pending) {
-		NET_DBG("Releasing pending pkt %p (ref %d)",
-			entry->pending,
-			atomic_get(&entry->pending->atomic_ref) - 1);
-		net_pkt_unref(entry->pending);
-		entry->pending = NULL;
+	sys_slist_find_and_remove(arp_bucket(&entry->ip), &entry->hash_node);
+
+	if (!entry->resolved) {
+		for (i = 0; i < entry->pending.count; i++) {
+			NET_DBG("Releasing pending pkt %p (ref %d)",
+				entry->pending.pkts[i],
+				atomic_get(&entry->pending.pkts[i]->atomic_ref)
+				- 1);
+			net_pkt_unref(entry->pending.pkts[i]);
+		}
 	}
 
 	entry->iface = NULL;
+	entry->resolved = false;
 
 	(void)memset(&entry->ip, 0, sizeof(struct in_addr));
-	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
+	(void)memset(&entry->pending, 0, sizeof(entry->pending));
 }
 
-static struct arp_entry *arp_entry_find(sys_slist_t *list,
-					struct net_if *iface,
+static struct arp_entry *arp_entry_find(struct net_if *iface,
 					struct in_addr *dst,
-					sys_snode_t **previous)
+					bool resolved)
 {
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(list, entry, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_bucket(dst), entry, hash_node) {
 		NET_DBG("iface %p dst %s",
 			iface, log_strdup(net_sprint_ipv4_addr(&entry->ip)));
 
-		if (entry->iface == iface &&
+		if (entry->iface == iface && entry->resolved == resolved &&
 		    net_ipv4_addr_cmp(&entry->ip, dst)) {
 			return entry;
 		}
-
-		if (previous) {
-			*previous = &entry->node;
-		}
 	}
 
 	return NULL;
 }
 
-static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
-							  struct in_addr *dst)
+static inline struct arp_entry *arp_entry_find_resolved(struct net_if *iface,
+							struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_entry_find(iface, dst, true);
 	if (entry) {
-		/* Let's assume the target is going to be accessed
-		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
-		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
-		}
+		entry->last_used = k_uptime_get_32();
 	}
 
 	return entry;
@@ -104,21 +116,20 @@ struct arp_entry *arp_entry_find_pending(struct net_if *iface,
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	return arp_entry_find(&arp_pending_entries, iface, dst, NULL);
+	return arp_entry_find(iface, dst, false);
 }
 
 static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 					       struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_pending_entries, iface, dst, &prev);
+	entry = arp_entry_find(iface, dst, false);
 	if (entry) {
 		/* We remove the entry from the pending list */
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
+		sys_slist_find_and_remove(&arp_pending_entries, &entry->node);
 	}
 
 	if (sys_slist_is_empty(&arp_pending_entries)) {
@@ -145,28 +156,36 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry = NULL;
+	int i;
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
+	/* The resolved entry used the longest ago is the preferred one
+	 * to be taken out. The table is only scanned once full.
 	 */
+	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		if (!arp_entries[i].resolved) {
+			continue;
+		}
 
-	node = sys_slist_peek_tail(&arp_table);
-	if (!node) {
-		return NULL;
+		if (!entry || (s32_t)(arp_entries[i].last_used -
+				      entry->last_used) < 0) {
+			entry = &arp_entries[i];
+		}
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	if (entry) {
+		arp_entry_cleanup(entry);
+	}
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return entry;
 }
 
-
 static void arp_entry_register_pending(struct arp_entry *entry)
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(&entry->ip)));
 
 	sys_slist_append(&arp_pending_entries, &entry->node);
+	sys_slist_prepend(arp_bucket(&entry->ip), &entry->hash_node);
 
 	entry->req_start = k_uptime_get_32();
 
@@ -177,6 +196,26 @@ static void arp_entry_register_pending(struct arp_entry *entry)
 	}
 }
 
+static bool arp_entry_queue_pending(struct arp_entry *entry,
+				    struct net_pkt *pkt)
+{
+	int i;
+
+	for (i = 0; i < entry->pending.count; i++) {
+		if (entry->pending.pkts[i] == pkt) {
+			return true;
+		}
+	}
+
+	if (entry->pending.count == CONFIG_NET_ARP_PENDING_PKTS) {
+		return false;
+	}
+
+	entry->pending.pkts[entry->pending.count++] = net_pkt_ref(pkt);
+
+	return true;
+}
+
 static void arp_request_timeout(struct k_work *work)
 {
 	u32_t current = k_uptime_get_32();
@@ -191,7 +230,7 @@ static void arp_request_timeout(struct k_work *work)
 			break;
 		}
 
-		arp_entry_cleanup(entry, true);
+		arp_entry_cleanup(entry);
 
 		sys_slist_remove(&arp_pending_entries, NULL, &entry->node);
 		sys_slist_append(&arp_free_entries, &entry->node);
@@ -266,7 +305,8 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	 * request and we want to send it again.
 	 */
 	if (entry) {
-		entry->pending = net_pkt_ref(pending);
+		entry->pending.pkts[0] = net_pkt_ref(pending);
+		entry->pending.count = 1U;
 		entry->iface = net_pkt_iface(pkt);
 
 		net_ipaddr_copy(&entry->ip, next_addr);
@@ -349,7 +389,7 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	/* If the destination address is already known, we do not need
 	 * to send any ARP packet.
 	 */
-	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
+	entry = arp_entry_find_resolved(net_pkt_iface(pkt), addr);
 	if (!entry) {
 		struct net_pkt *req;
 
@@ -362,7 +402,16 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				entry = arp_entry_get_last_from_table();
 			}
 		} else {
-			/* There is a pending already */
+			/* There is a pending already, the packet waits
+			 * for its reply along with the ones before.
+			 */
+			if (!current_ip &&
+			    !arp_entry_queue_pending(entry, pkt)) {
+				NET_DBG("Pending queue of %s full, dropping %p",
+					log_strdup(net_sprint_ipv4_addr(addr)),
+					pkt);
+			}
+
 			entry = NULL;
 		}
 
@@ -370,9 +419,9 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				  current_ip);
 
 		if (!entry) {
-			/* We cannot send the packet, the ARP cache is full
-			 * or there is already a pending query to this IP
-			 * address, so this packet must be discarded.
+			/* The ARP cache is full or there is already a pending
+			 * query to this IP address, so the request is sent
+			 * again. The packet is discarded unless queued.
 			 */
 			NET_DBG("Resending ARP %p", req);
 		}
@@ -399,10 +448,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find(iface, src, true);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -422,8 +470,10 @@ static void arp_update(struct net_if *iface,
 		       bool gratuitous,
 		       bool force)
 {
+	struct net_pkt *pkts[CONFIG_NET_ARP_PENDING_PKTS];
 	struct arp_entry *entry;
-	struct net_pkt *pkt;
+	int count;
+	int i;
 
 	NET_DBG("src %s", log_strdup(net_sprint_ipv4_addr(src)));
 
@@ -434,10 +484,9 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_entry_find(iface, src, true);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -453,10 +502,13 @@ static void arp_update(struct net_if *iface,
 
 				if (entry) {
 					entry->req_start = k_uptime_get_32();
+					entry->last_used = entry->req_start;
 					entry->iface = iface;
+					entry->resolved = true;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					sys_slist_prepend(arp_bucket(src),
+							  &entry->hash_node);
 				}
 			}
 		}
@@ -464,24 +516,28 @@ static void arp_update(struct net_if *iface,
 		return;
 	}
 
-	/* Set the dst in the pending packet */
-	net_pkt_lladdr_dst(entry->pending)->len = sizeof(struct net_eth_addr);
-	net_pkt_lladdr_dst(entry->pending)->addr =
-		(u8_t *) &NET_ETH_HDR(entry->pending)->dst.addr;
-
-	NET_DBG("dst %s pending %p frag %p",
-		log_strdup(net_sprint_ipv4_addr(&entry->ip)),
-		entry->pending, entry->pending->frags);
-
-	pkt = entry->pending;
-	entry->pending = NULL;
+	count = entry->pending.count;
+	memcpy(pkts, entry->pending.pkts, count * sizeof(pkts[0]));
 
+	/* The entry is already in the hash table, it only needs
+	 * to be marked as resolved.
+	 */
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+	entry->resolved = true;
+	entry->last_used = k_uptime_get_32();
+
+	for (i = 0; i < count; i++) {
+		/* Set the dst in the pending packet */
+		net_pkt_lladdr_dst(pkts[i])->len = sizeof(struct net_eth_addr);
+		net_pkt_lladdr_dst(pkts[i])->addr =
+			(u8_t *) &NET_ETH_HDR(pkts[i])->dst.addr;
 
-	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+		NET_DBG("dst %s pending %p frag %p",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)),
+			pkts[i], pkts[i]->frags);
 
-	net_if_queue_tx(iface, pkt);
+		net_if_queue_tx(iface, pkts[i]);
+	}
 }
 
 static inline struct net_pkt *arp_prepare_reply(struct net_if *iface,
@@ -671,23 +727,22 @@ void net_arp_clear_cache(struct net_if *iface)
 {
 	sys_snode_t *prev = NULL;
 	struct arp_entry *entry, *next;
+	int i;
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
-		if (iface && iface != entry->iface) {
-			prev = &entry->node;
+	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		entry = &arp_entries[i];
+
+		if (!entry->resolved || (iface && iface != entry->iface)) {
 			continue;
 		}
 
-		arp_entry_cleanup(entry, false);
+		arp_entry_cleanup(entry);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
 		sys_slist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	prev = NULL;
-
 	NET_DBG("Flushing ARP pending requests");
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
@@ -697,7 +752,7 @@ void net_arp_clear_cache(struct net_if *iface)
 			continue;
 		}
 
-		arp_entry_cleanup(entry, true);
+		arp_entry_cleanup(entry);
 
 		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
 		sys_slist_prepend(&arp_free_entries, &entry->node);
@@ -712,10 +767,17 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 {
 	int ret = 0;
 	struct arp_entry *entry;
+	int i;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
-		ret++;
-		cb(entry, user_data);
+	for (i = 0; i < ARP_HASH_BUCKETS; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, hash_node) {
+			if (!entry->resolved) {
+				continue;
+			}
+
+			ret++;
+			cb(entry, user_data);
+		}
 	}
 
 	return ret;
@@ -731,7 +793,9 @@ void net_arp_init(void)
 
 	sys_slist_init(&arp_free_entries);
 	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+	for (i = 0; i < ARP_HASH_BUCKETS; i++) {
+		sys_slist_init(&arp_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
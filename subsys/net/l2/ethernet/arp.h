@@ -50,12 +50,22 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 			       struct net_eth_hdr *eth_hdr);
 
 struct arp_entry {
+	/* Node in the free or pending list */
 	sys_snode_t node;
+	/* Node in the hash bucket of the address, while in use */
+	sys_snode_t hash_node;
 	u32_t req_start;
+	/* Uptime of the last lookup, to evict the oldest entry */
+	u32_t last_used;
 	struct net_if *iface;
 	struct in_addr ip;
+	bool resolved;
 	union {
-		struct net_pkt *pending;
+		/* Packets waiting for the resolution, in order */
+		struct {
+			struct net_pkt *pkts[CONFIG_NET_ARP_PENDING_PKTS];
+			u8_t count;
+		} pending;
 		struct net_eth_addr eth;
 	};
 };
@@ -965,6 +965,16 @@ void net_eth_carrier_off(struct net_if *iface)
 	handle_carrier(ctx, iface, carrier_off);
 }
 
+void net_eth_tx_flush(struct net_if *iface)
+{
+	struct device *dev = net_if_get_device(iface);
+	const struct ethernet_api *api = dev->driver_api;
+
+	if (api && api->tx_flush) {
+		api->tx_flush(dev);
+	}
+}
+
 struct device *net_eth_get_ptp_clock(struct net_if *iface)
 {
 #if defined(CONFIG_PTP_CLOCK)
@@ -13,6 +13,7 @@ LOG_MODULE_DECLARE(net_gptp, CONFIG_NET_GPTP_LOG_LEVEL);
 #include "gptp_data_set.h"
 #include "gptp_state.h"
 #include "gptp_private.h"
+#include "gptp_servo.h"
 
 #if CONFIG_NET_GPTP_LOG_LEVEL >= LOG_LEVEL_DBG
 static const char * const state2str(enum gptp_port_state state)
@@ -724,8 +725,6 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -NSEC_PER_SEC + nanosecond_diff;
 	}
 
-	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
-
 	/* If time difference is too high, set the clock value.
 	 * Otherwise, adjust it.
 	 */
@@ -734,6 +733,12 @@ static void gptp_update_local_port_clock(void)
 			     nanosecond_diff > 5000))) {
 		bool underflow = false;
 
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		gptp_servo_step();
+#endif
+
 		key = irq_lock();
 		ptp_clock_get(clk, &tm);
 
@@ -757,6 +762,22 @@ static void gptp_update_local_port_clock(void)
 		ptp_clock_set(clk, &tm);
 		irq_unlock(key);
 	} else {
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		s32_t freq_ppb;
+
+		/* The frequency is corrected by the clock hardware and
+		 * takes the offset back to zero over the next interval.
+		 */
+		if (gptp_servo_sample(nanosecond_diff,
+				      port_ds->cur_log_half_sync_itv + 1,
+				      &freq_ppb)) {
+			ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio *
+					      (1.0 + (double)freq_ppb /
+					       NSEC_PER_SEC));
+		}
+#else
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+
 		if (nanosecond_diff < -200) {
 			nanosecond_diff = -200;
 		} else if (nanosecond_diff > 200) {
@@ -764,6 +785,7 @@ static void gptp_update_local_port_clock(void)
 		}
 
 		ptp_clock_adjust(clk, nanosecond_diff);
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
 	}
 }
 #endif /* CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE */
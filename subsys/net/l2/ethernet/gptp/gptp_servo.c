@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_gptp, CONFIG_NET_GPTP_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+
+#include "gptp_servo.h"
+
+/* Bound of the correction, beyond the tolerance of 802.1AS clocks */
+#define GPTP_SERVO_MAX_PPB 200000
+
+#define GPTP_SERVO_WINDOW CONFIG_NET_GPTP_SERVO_FILTER_LEN
+
+static struct {
+	/* Last offsets, for the median of the outlier rejection */
+	s32_t window[GPTP_SERVO_WINDOW];
+	u8_t count;
+	u8_t next;
+
+	bool have_prev;
+	s32_t prev;
+
+	/* Integral term, in ppb */
+	s64_t integral;
+} servo;
+
+static struct gptp_servo_stats stats = {
+	.offset_min = INT32_MAX,
+	.offset_max = INT32_MIN,
+};
+
+static inline u32_t servo_abs(s32_t value)
+{
+	return value < 0 ? -(u32_t)value : (u32_t)value;
+}
+
+static void servo_hist_add(u32_t *hist, u32_t value)
+{
+	int bucket = 0;
+
+	/* Bucket 0 is below 16 ns, then every bucket doubles */
+	value >>= 4;
+	while (value && bucket < GPTP_SERVO_HIST_BUCKETS - 1) {
+		value >>= 1;
+		bucket++;
+	}
+
+	hist[bucket]++;
+}
+
+static s32_t servo_median(void)
+{
+	s32_t sorted[GPTP_SERVO_WINDOW];
+	s32_t tmp;
+	int i, j;
+
+	memcpy(sorted, servo.window, servo.count * sizeof(s32_t));
+
+	for (i = 1; i < servo.count; i++) {
+		tmp = sorted[i];
+
+		for (j = i; j > 0 && sorted[j - 1] > tmp; j--) {
+			sorted[j] = sorted[j - 1];
+		}
+
+		sorted[j] = tmp;
+	}
+
+	return sorted[servo.count / 2];
+}
+
+static bool servo_filter(s32_t offset)
+{
+	bool outlier = false;
+
+	/* Compare with the previous offsets only, so that a single wrong
+	 * timestamp does not move the reference it is compared with.
+	 */
+	if (servo.count == GPTP_SERVO_WINDOW &&
+	    servo_abs(offset - servo_median()) >
+	    CONFIG_NET_GPTP_SERVO_OUTLIER_NS) {
+		outlier = true;
+	}
+
+	/* Outliers enter the window too: after a genuine jump of the
+	 * offset, the median follows in half a window.
+	 */
+	servo.window[servo.next] = offset;
+	servo.next = (servo.next + 1) % GPTP_SERVO_WINDOW;
+	if (servo.count < GPTP_SERVO_WINDOW) {
+		servo.count++;
+	}
+
+	return !outlier;
+}
+
+void gptp_servo_reset(void)
+{
+	(void)memset(&servo, 0, sizeof(servo));
+}
+
+void gptp_servo_step(void)
+{
+	stats.steps++;
+
+	gptp_servo_reset();
+}
+
+bool gptp_servo_sample(s32_t offset, s8_t log_sync_itv, s32_t *freq_ppb)
+{
+	s64_t itv_ns, ppb, p;
+
+	stats.samples++;
+
+	if (GPTP_SERVO_WINDOW > 1 && !servo_filter(offset)) {
+		stats.outliers++;
+		NET_DBG("Offset %d ns dropped as outlier", offset);
+		return false;
+	}
+
+	stats.offset = offset;
+
+	stats.offset_min = MIN(stats.offset_min, offset);
+	stats.offset_max = MAX(stats.offset_max, offset);
+
+	servo_hist_add(stats.offset_hist, servo_abs(offset));
+
+	if (servo.have_prev) {
+		servo_hist_add(stats.jitter_hist, servo_abs(offset - servo.prev));
+	}
+
+	servo.have_prev = true;
+	servo.prev = offset;
+
+	/* The offset was accumulated over a sync interval: as a frequency
+	 * error it is offset / interval.
+	 */
+	if (log_sync_itv >= 0) {
+		itv_ns = (s64_t)NSEC_PER_SEC << MIN(log_sync_itv, 8);
+	} else {
+		itv_ns = (s64_t)NSEC_PER_SEC >> MIN(-log_sync_itv, 16);
+	}
+
+	p = (s64_t)offset * NSEC_PER_SEC / itv_ns;
+
+	servo.integral += p * CONFIG_NET_GPTP_SERVO_KI / 1000;
+	servo.integral = MAX(MIN(servo.integral, GPTP_SERVO_MAX_PPB),
+			     -GPTP_SERVO_MAX_PPB);
+
+	ppb = p * CONFIG_NET_GPTP_SERVO_KP / 1000 + servo.integral;
+	ppb = MAX(MIN(ppb, GPTP_SERVO_MAX_PPB), -GPTP_SERVO_MAX_PPB);
+
+	stats.freq_ppb = ppb;
+	*freq_ppb = ppb;
+
+	return true;
+}
+
+const struct gptp_servo_stats *gptp_servo_get_stats(void)
+{
+	return &stats;
+}
+
+void gptp_servo_clear_stats(void)
+{
+	(void)memset(&stats, 0, sizeof(stats));
+
+	stats.offset_min = INT32_MAX;
+	stats.offset_max = INT32_MIN;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief PI servo steering the local clock of a gPTP slave.
+ *
+ * This is not to be included by the application.
+ */
+
+#ifndef __GPTP_SERVO_H
+#define __GPTP_SERVO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <zephyr/types.h>
+
+/** Number of power of two buckets of the servo histograms, from 16 ns */
+#define GPTP_SERVO_HIST_BUCKETS 12
+
+/**
+ * @brief Statistics of the clock servo.
+ */
+struct gptp_servo_stats {
+	/** Offsets given to the servo. */
+	u32_t samples;
+
+	/** Offsets dropped as outliers. */
+	u32_t outliers;
+
+	/** Offsets too large for the servo, where the clock was set. */
+	u32_t steps;
+
+	/** Last offset from the master, in ns. */
+	s32_t offset;
+
+	/** Smallest and largest offsets since the last reset, in ns. */
+	s32_t offset_min;
+	s32_t offset_max;
+
+	/** Last frequency correction, in parts per billion. */
+	s32_t freq_ppb;
+
+	/** Absolute offsets, bucket i counting those below 2^(i + 4) ns. */
+	u32_t offset_hist[GPTP_SERVO_HIST_BUCKETS];
+
+	/** Absolute changes of offset between consecutive samples. */
+	u32_t jitter_hist[GPTP_SERVO_HIST_BUCKETS];
+};
+
+/**
+ * @brief Restart the servo, after the clock was set or the master changed.
+ */
+void gptp_servo_reset(void);
+
+/**
+ * @brief Count a clock step, the offset being too large for the servo.
+ */
+void gptp_servo_step(void);
+
+/**
+ * @brief Give an offset from the master to the servo.
+ *
+ * @param offset Master time minus local time, in ns.
+ * @param log_sync_itv Logarithm 2 of the sync interval, in seconds.
+ * @param freq_ppb Frequency correction to apply, in parts per billion.
+ *
+ * @return false if the offset was dropped as an outlier.
+ */
+bool gptp_servo_sample(s32_t offset, s8_t log_sync_itv, s32_t *freq_ppb);
+
+/**
+ * @brief Get the statistics of the servo.
+ *
+ * @return Pointer to the statistics.
+ */
+const struct gptp_servo_stats *gptp_servo_get_stats(void);
+
+/**
+ * @brief Clear the statistics of the servo.
+ */
+void gptp_servo_clear_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GPTP_SERVO_H */
@@ -224,6 +224,15 @@ static enum net_verdict ieee802154_recv(struct net_if *iface,
 
 }
 
+static void ieee802154_tx_done(int result, void *user_data)
+{
+	struct net_if *iface = user_data;
+
+	if (result) {
+		NET_DBG("iface %p frame not sent (%d)", iface, result);
+	}
+}
+
 static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
@@ -273,9 +282,14 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 			return -EINVAL;
 		}
 
-		if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
+		if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_TX_ASYNC) &&
 		    ieee802154_get_hw_capabilities(iface) &
-		    IEEE802154_HW_CSMA) {
+		    IEEE802154_HW_TX_ASYNC) {
+			ret = ieee802154_tx_async(iface, &frame_buf,
+						  ieee802154_tx_done, iface);
+		} else if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
+			   ieee802154_get_hw_capabilities(iface) &
+			   IEEE802154_HW_CSMA) {
 			ret = ieee802154_tx(iface, pkt, &frame_buf);
 		} else {
 			ret = ieee802154_radio_send(iface, pkt, &frame_buf);
@@ -76,6 +76,22 @@ static inline int ieee802154_tx(struct net_if *iface,
 	return radio->tx(net_if_get_device(iface), pkt, buf);
 }
 
+static inline int ieee802154_tx_async(struct net_if *iface,
+				      struct net_buf *buf,
+				      ieee802154_tx_done_t done_cb,
+				      void *user_data)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->driver_api;
+
+	if (!radio || !radio->tx_async) {
+		return -ENOTSUP;
+	}
+
+	return radio->tx_async(net_if_get_device(iface), buf,
+			       done_cb, user_data);
+}
+
 static inline int ieee802154_start(struct net_if *iface)
 {
 	const struct ieee802154_radio_api *radio =
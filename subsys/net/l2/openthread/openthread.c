@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_l2_openthread, CONFIG_OPENTHREAD_L2_LOG_LEVEL);
 #include <openthread/message.h>
 #include <openthread/tasklet.h>
 #include <openthread/thread.h>
+#include <openthread/platform/radio.h>
 #include <openthread/dataset.h>
 #include <openthread/joiner.h>
 #include <openthread-system.h>
@@ -235,9 +236,23 @@ static enum net_verdict openthread_recv(struct net_if *iface,
 
 	otRadioFrame recv_frame;
 
-	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
-	/* Length inc. CRC. */
-	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
+	/* Radio drivers receive into one buffer, which OT reads in place.
+	 * A frame spread over several buffers is copied out first.
+	 */
+	if (pkt->buffer->frags) {
+		static u8_t rx_psdu[OT_RADIO_FRAME_MAX_SIZE];
+
+		recv_frame.mPsdu = rx_psdu;
+		recv_frame.mLength = net_buf_linearize(rx_psdu,
+						       sizeof(rx_psdu),
+						       pkt->buffer, 0,
+						       sizeof(rx_psdu));
+	} else {
+		recv_frame.mPsdu = pkt->buffer->data;
+		/* Length inc. CRC. */
+		recv_frame.mLength = pkt->buffer->len;
+	}
+
 	recv_frame.mChannel = platformRadioChannelGet(ot_context->instance);
 	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
 	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(pkt);
@@ -305,13 +320,15 @@ exit:
 }
 
 enum net_verdict ieee802154_radio_handle_ack(struct net_if *iface,
-					     struct net_buf *buf)
+					     struct net_pkt *pkt)
 {
 	ARG_UNUSED(iface);
-	ARG_UNUSED(buf);
-	NET_DBG("");
 
-	return NET_CONTINUE;
+	if (platformRadioAckReceived(pkt)) {
+		return NET_CONTINUE;
+	}
+
+	return NET_OK;
 }
 
 static void openthread_start(struct openthread_context *ot_context)
@@ -139,6 +139,11 @@ int coap_packet_init(struct coap_packet *cpkt, u8_t *data,
 	/* Header length : (version + type + tkl) + code + id + [token] */
 	cpkt->hdr_len = 1 + 1 + 2 + tokenlen;
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	/* Kept up to date by coap_packet_append_option() */
+	cpkt->opt_indexed = true;
+#endif
+
 	return 0;
 }
 
@@ -235,6 +240,9 @@ static int encode_option(struct coap_packet *cpkt, u16_t code,
 int coap_packet_append_option(struct coap_packet *cpkt, u16_t code,
 			      const u8_t *value, u16_t len)
 {
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	u16_t start;
+#endif
 	int r;
 
 	if (!cpkt) {
@@ -255,6 +263,10 @@ int coap_packet_append_option(struct coap_packet *cpkt, u16_t code,
 		code = (code == cpkt->delta) ? 0 : code - cpkt->delta;
 	}
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	start = cpkt->offset;
+#endif
+
 	r = encode_option(cpkt, code, value, len);
 	if (r < 0) {
 		return -EINVAL;
@@ -263,6 +275,12 @@ int coap_packet_append_option(struct coap_packet *cpkt, u16_t code,
 	cpkt->opt_len += r;
 	cpkt->delta += code;
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	if (cpkt->opt_indexed) {
+		index_option(cpkt, cpkt->delta, start);
+	}
+#endif
+
 	return 0;
 }
 
@@ -561,6 +579,11 @@ int coap_packet_parse(struct coap_packet *cpkt, u8_t *data, u16_t len,
 		return -EINVAL;
 	}
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	cpkt->opt_count = 0U;
+	cpkt->opt_indexed = cpkt->hdr_len == len;
+#endif
+
 	cpkt->offset = cpkt->hdr_len;
 	if (cpkt->hdr_len == len) {
 		return 0;
@@ -571,15 +594,31 @@ int coap_packet_parse(struct coap_packet *cpkt, u8_t *data, u16_t len,
 	delta = 0U;
 	num = 0U;
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	cpkt->opt_indexed = true;
+#endif
+
 	while (1) {
 		struct coap_option *option;
+		u16_t start = offset;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
 				   &delta, &opt_len, option);
 		if (ret < 0) {
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+			cpkt->opt_indexed = false;
+#endif
 			return ret;
-		} else if (ret == 0) {
+		}
+
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+		if (cpkt->data[start] != COAP_MARKER) {
+			index_option(cpkt, delta, start);
+		}
+#endif
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -591,6 +630,59 @@ int coap_packet_parse(struct coap_packet *cpkt, u8_t *data, u16_t len,
 	return 0;
 }
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+/* Record where an option starts, for coap_find_options() */
+static void index_option(struct coap_packet *cpkt, u16_t num, u16_t offset)
+{
+	if (cpkt->opt_count == CONFIG_COAP_OPTION_INDEX_SIZE) {
+		/* Too many options, they are searched for */
+		cpkt->opt_indexed = false;
+		return;
+	}
+
+	cpkt->opt_index[cpkt->opt_count].num = num;
+	cpkt->opt_index[cpkt->opt_count].offset = offset;
+	cpkt->opt_count++;
+}
+
+static int find_indexed_options(const struct coap_packet *cpkt, u16_t code,
+				struct coap_option *options, u16_t veclen)
+{
+	const struct coap_option_index *index = cpkt->opt_index;
+	u8_t low = 0U, high = cpkt->opt_count;
+	u16_t opt_len = 0U;
+	u16_t offset;
+	u16_t delta;
+	u8_t mid;
+	int num;
+
+	/* First option with the code, the options are sorted */
+	while (low < high) {
+		mid = (low + high) / 2U;
+
+		if (index[mid].num < code) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (num = 0; num < veclen && low < cpkt->opt_count &&
+	     index[low].num == code; num++, low++) {
+		/* The delta of the option is relative to the previous one */
+		delta = low ? index[low - 1].num : 0U;
+
+		if (parse_option(cpkt->data, index[low].offset, &offset,
+				 cpkt->max_len, &delta, &opt_len,
+				 &options[num]) < 0) {
+			return -EINVAL;
+		}
+	}
+
+	return num;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX_SIZE > 0 */
+
 int coap_find_options(const struct coap_packet *cpkt, u16_t code,
 		      struct coap_option *options, u16_t veclen)
 {
@@ -600,6 +692,12 @@ int coap_find_options(const struct coap_packet *cpkt, u16_t code,
 	u8_t num;
 	int r;
 
+#if CONFIG_COAP_OPTION_INDEX_SIZE > 0
+	if (cpkt->opt_indexed) {
+		return find_indexed_options(cpkt, code, options, veclen);
+	}
+#endif
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
@@ -1048,6 +1146,101 @@ size_t coap_next_block(const struct coap_packet *cpkt,
 	return ctx->current;
 }
 
+void coap_block_window_init(struct coap_block_window *win,
+			    enum coap_block_size block_size, u8_t size)
+{
+	coap_block_transfer_init(&win->ctx, block_size, 0);
+
+	win->next = 0;
+	win->size = MAX(size, 1);
+}
+
+int coap_block_window_next(struct coap_block_window *win,
+			   struct coap_block_context *req)
+{
+	size_t bytes = coap_block_size_to_bytes(win->ctx.block_size);
+
+	if (win->ctx.total_size && win->next >= win->ctx.total_size) {
+		return -ENOENT;
+	}
+
+	/* Without the total size, the end is only known from the last
+	 * block, and the block size may still be lowered by the server:
+	 * one block at a time.
+	 */
+	if (win->next > win->ctx.current &&
+	    (!win->ctx.total_size ||
+	     win->next >= win->ctx.current + win->size * bytes)) {
+		return -EAGAIN;
+	}
+
+	req->block_size = win->ctx.block_size;
+	req->total_size = win->ctx.total_size;
+	req->current = win->next;
+
+	win->next += bytes;
+
+	return 0;
+}
+
+int coap_block_window_received(struct coap_block_window *win,
+			       const struct coap_packet *response,
+			       bool *last)
+{
+	int block, size;
+	size_t offset;
+
+	block = get_block_option(response, COAP_OPTION_BLOCK2);
+	if (block == -ENOENT) {
+		/* The whole resource in one response */
+		if (win->ctx.current) {
+			return -EINVAL;
+		}
+
+		*last = true;
+		return 0;
+	}
+
+	offset = GET_NUM(block) << (GET_BLOCK_SIZE(block) + 4);
+
+	if (offset < win->ctx.current) {
+		return -EALREADY;
+	}
+
+	if (offset > win->ctx.current) {
+		/* Requested again once the window reaches it */
+		win->next = MIN(win->next, offset);
+		return -EAGAIN;
+	}
+
+	if (GET_BLOCK_SIZE(block) != win->ctx.block_size) {
+		/* Only the first block may lower the size */
+		if (win->ctx.current ||
+		    GET_BLOCK_SIZE(block) > win->ctx.block_size) {
+			return -EINVAL;
+		}
+
+		win->ctx.block_size = GET_BLOCK_SIZE(block);
+		win->next = 0;
+	}
+
+	size = get_block_option(response, COAP_OPTION_SIZE2);
+	if (size > 0) {
+		if (win->ctx.total_size && win->ctx.total_size != size) {
+			return -EINVAL;
+		}
+
+		win->ctx.total_size = size;
+	}
+
+	*last = !GET_MORE(block);
+
+	win->ctx.current += coap_block_size_to_bytes(win->ctx.block_size);
+	win->next = MAX(win->next, win->ctx.current);
+
+	return 0;
+}
+
 int coap_pending_init(struct coap_pending *pending,
 		      const struct coap_packet *request,
 		      const struct sockaddr *addr)
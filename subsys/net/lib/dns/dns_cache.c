@@ -0,0 +1,270 @@
+/** @file
+ * @brief DNS answer cache
+ *
+ * Answers are kept until the smallest TTL of their records expires.
+ * Names without address are kept for a fixed negative TTL.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <strings.h>
+
+#include <net/net_core.h>
+#include <net/net_ip.h>
+#include <net/dns_resolve.h>
+
+#include "dns_cache.h"
+
+struct dns_cache_entry {
+	/** Resolved name, empty if the entry is free */
+	char name[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+
+	/** Cached addresses */
+	struct sockaddr addr[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+
+	/** Uptime in ms at which the entry expires */
+	s64_t expires;
+
+	/** Query type */
+	enum dns_query_type type;
+
+	/** Number of cached addresses, 0 for a negative entry */
+	u8_t count;
+};
+
+static struct dns_cache_entry dns_cache[CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES];
+static K_MUTEX_DEFINE(dns_cache_lock);
+
+static bool entry_is_valid(struct dns_cache_entry *entry, s64_t now)
+{
+	return entry->name[0] != '\0' && entry->expires > now;
+}
+
+static struct dns_cache_entry *entry_find(const char *name,
+					  enum dns_query_type type,
+					  s64_t now)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		if (entry_is_valid(&dns_cache[i], now) &&
+		    dns_cache[i].type == type &&
+		    !strcasecmp(dns_cache[i].name, name)) {
+			return &dns_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Returns the entry of the name, or the one that is free or expires first */
+static struct dns_cache_entry *entry_get(const char *name,
+					 enum dns_query_type type,
+					 s64_t now)
+{
+	struct dns_cache_entry *entry;
+	int i;
+
+	entry = entry_find(name, type, now);
+	if (entry) {
+		return entry;
+	}
+
+	entry = &dns_cache[0];
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		if (!entry_is_valid(&dns_cache[i], now)) {
+			entry = &dns_cache[i];
+			break;
+		}
+
+		if (dns_cache[i].expires < entry->expires) {
+			entry = &dns_cache[i];
+		}
+	}
+
+	strcpy(entry->name, name);
+	entry->type = type;
+
+	return entry;
+}
+
+static socklen_t addr_len(sa_family_t family)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		return sizeof(struct sockaddr_in6);
+	}
+
+	return sizeof(struct sockaddr_in);
+}
+
+int dns_cache_lookup(const char *name, enum dns_query_type type,
+		     dns_resolve_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry *entry;
+	struct dns_cache_entry found;
+	struct dns_addrinfo info;
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	entry = entry_find(name, type, k_uptime_get());
+	if (entry) {
+		found = *entry;
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+
+	if (!entry) {
+		return -ENOENT;
+	}
+
+	NET_DBG("Cache hit for %s (%d addresses)", log_strdup(name),
+		found.count);
+
+	if (found.count == 0U) {
+		cb(DNS_EAI_NODATA, NULL, user_data);
+		return 0;
+	}
+
+	(void)memset(&info, 0, sizeof(info));
+
+	for (i = 0; i < found.count; i++) {
+		memcpy(&info.ai_addr, &found.addr[i], sizeof(info.ai_addr));
+		info.ai_family = found.addr[i].sa_family;
+		info.ai_addrlen = addr_len(info.ai_family);
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+	}
+
+	cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+	return 0;
+}
+
+void dns_cache_add(const char *name, enum dns_query_type type,
+		   const struct dns_addrinfo *info, u32_t ttl, bool first)
+{
+	struct dns_cache_entry *entry;
+	s64_t now, expires;
+
+	if (strlen(name) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	now = k_uptime_get();
+	expires = now + (s64_t)MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL) *
+		MSEC_PER_SEC;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	if (first) {
+		entry = entry_get(name, type, now);
+		entry->count = 0U;
+		entry->expires = expires;
+	} else {
+		entry = entry_find(name, type, now);
+		if (!entry ||
+		    entry->count == CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES) {
+			goto out;
+		}
+
+		entry->expires = MIN(entry->expires, expires);
+	}
+
+	memcpy(&entry->addr[entry->count++], &info->ai_addr,
+	       sizeof(entry->addr[0]));
+
+	/* A record with TTL 0 must not be cached, drop the whole answer */
+	if (ttl == 0U) {
+		entry->name[0] = '\0';
+	}
+
+out:
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_add_negative(const char *name, enum dns_query_type type)
+{
+	struct dns_cache_entry *entry;
+	s64_t now;
+
+	if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL == 0 ||
+	    strlen(name) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	now = k_uptime_get();
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	entry = entry_get(name, type, now);
+	entry->count = 0U;
+	entry->expires = now +
+		(s64_t)CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL * MSEC_PER_SEC;
+
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry entry;
+	struct dns_addrinfo info;
+	s64_t now;
+	u32_t ttl;
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		/* Callbacks may print, copy the entry not to block the
+		 * resolver meanwhile.
+		 */
+		k_mutex_lock(&dns_cache_lock, K_FOREVER);
+		now = k_uptime_get();
+		entry = dns_cache[i];
+		k_mutex_unlock(&dns_cache_lock);
+
+		if (!entry_is_valid(&entry, now)) {
+			continue;
+		}
+
+		ttl = (entry.expires - now) / MSEC_PER_SEC;
+
+		if (entry.count == 0U) {
+			cb(entry.name, entry.type, NULL, ttl, user_data);
+			continue;
+		}
+
+		(void)memset(&info, 0, sizeof(info));
+
+		for (j = 0; j < entry.count; j++) {
+			memcpy(&info.ai_addr, &entry.addr[j],
+			       sizeof(info.ai_addr));
+			info.ai_family = entry.addr[j].sa_family;
+			info.ai_addrlen = addr_len(info.ai_family);
+
+			cb(entry.name, entry.type, &info, ttl, user_data);
+		}
+	}
+}
+
+void dns_cache_flush(void)
+{
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		dns_cache[i].name[0] = '\0';
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
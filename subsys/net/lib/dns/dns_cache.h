@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _DNS_CACHE_H_
+#define _DNS_CACHE_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include <net/dns_resolve.h>
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Return the cached answer of a query to the caller.
+ *
+ * @details The callback is called like for an answer received from the
+ * network: DNS_EAI_INPROGRESS for each address followed by
+ * DNS_EAI_ALLDONE, or DNS_EAI_NODATA for a negative entry.
+ *
+ * @param name Name to resolve.
+ * @param type Query type.
+ * @param cb Result callback of the query.
+ * @param user_data User data of the callback.
+ *
+ * @return 0 if the answer was cached, -ENOENT otherwise.
+ */
+int dns_cache_lookup(const char *name, enum dns_query_type type,
+		     dns_resolve_cb_t cb, void *user_data);
+
+/**
+ * @brief Cache one address of an answer.
+ *
+ * @param name Name that was resolved.
+ * @param type Query type.
+ * @param info Resolved address.
+ * @param ttl TTL of the record, in seconds. The entry expires with the
+ * smallest TTL of its records.
+ * @param first True for the first address of the answer, which replaces
+ * the previous answer for this name.
+ */
+void dns_cache_add(const char *name, enum dns_query_type type,
+		   const struct dns_addrinfo *info, u32_t ttl, bool first);
+
+/**
+ * @brief Cache that a name has no address of the given type.
+ *
+ * @param name Name that was resolved.
+ * @param type Query type.
+ */
+void dns_cache_add_negative(const char *name, enum dns_query_type type);
+#else
+static inline int dns_cache_lookup(const char *name, enum dns_query_type type,
+				   dns_resolve_cb_t cb, void *user_data)
+{
+	return -ENOENT;
+}
+
+static inline void dns_cache_add(const char *name, enum dns_query_type type,
+				 const struct dns_addrinfo *info, u32_t ttl,
+				 bool first)
+{
+}
+
+static inline void dns_cache_add_negative(const char *name,
+					  enum dns_query_type type)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+#endif /* _DNS_CACHE_H_ */
@@ -22,6 +22,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <net/net_pkt.h>
 #include <net/dns_resolve.h>
 #include "dns_pack.h"
+#include "dns_cache.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -329,7 +330,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 	struct dns_addrinfo info = { 0 };
 	/* Helper struct to track the dns msg received from the server */
 	struct dns_msg_t dns_msg;
-	u32_t ttl; /* RR ttl, so far it is not passed to caller */
+	u32_t ttl; /* RR ttl, only used by the cache */
 	u8_t *src, *addr;
 	int address_size;
 	/* index that points to the current answer being analyzed */
@@ -437,6 +438,10 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 			memcpy(addr, src, address_size);
 
+			dns_cache_add(ctx->queries[query_idx].query,
+				      ctx->queries[query_idx].query_type,
+				      &info, ttl, items == 0);
+
 			ctx->queries[query_idx].cb(DNS_EAI_INPROGRESS, &info,
 					ctx->queries[query_idx].user_data);
 			items++;
@@ -481,6 +486,16 @@ static int dns_read(struct dns_resolve_context *ctx,
 	}
 
 	if (items == 0) {
+		/* NXDOMAIN or no record of this type, but not a server
+		 * failure, which may be gone when asking again.
+		 */
+		if (dns_header_rcode(dns_msg.msg) == DNS_HEADER_NOERROR ||
+		    dns_header_rcode(dns_msg.msg) == DNS_HEADER_NAMEERROR) {
+			dns_cache_add_negative(
+				ctx->queries[query_idx].query,
+				ctx->queries[query_idx].query_type);
+		}
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -770,6 +785,15 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	/* Answered from the cache, there is no query to cancel */
+	if (dns_cache_lookup(query, type, cb, user_data) == 0) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
@@ -0,0 +1,577 @@
+/** @file
+ * @brief HTTP client API
+ *
+ * Connections are kept alive and reused for the next requests to the same
+ * host. Requests are pipelined on a connection and their responses are
+ * matched in order, the bodies being streamed to the response callbacks
+ * as they are parsed.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_http_client, CONFIG_HTTP_CLIENT_LOG_LEVEL);
+
+#include <kernel.h>
+#include <init.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include <net/net_core.h>
+#include <net/socket.h>
+#include <net/http_client.h>
+
+#define HTTP_PROTOCOL "HTTP/1.1"
+
+/* Requests are built in this buffer, so that the request line and the
+ * headers do not need one send() each.
+ */
+#define HTTP_SEND_BUF_SIZE 128
+
+struct send_buf {
+	int sock;
+	int err;
+	size_t len;
+	u8_t data[HTTP_SEND_BUF_SIZE];
+};
+
+static struct http_client_conn conns[CONFIG_HTTP_CLIENT_MAX_CONNECTIONS];
+static K_MUTEX_DEFINE(conns_lock);
+
+static int sendall(int sock, const void *buf, size_t len)
+{
+	while (len) {
+		ssize_t out_len = send(sock, buf, len, 0);
+
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		buf = (const char *)buf + out_len;
+		len -= out_len;
+	}
+
+	return 0;
+}
+
+/* Once a send fails, the following calls do nothing and the first error
+ * is kept in sbuf->err.
+ */
+static void send_buf_flush(struct send_buf *sbuf)
+{
+	if (sbuf->err == 0) {
+		sbuf->err = sendall(sbuf->sock, sbuf->data, sbuf->len);
+	}
+
+	sbuf->len = 0;
+}
+
+static void send_buf_add(struct send_buf *sbuf, const void *data, size_t len)
+{
+	size_t copy;
+
+	while (len && sbuf->err == 0) {
+		if (sbuf->len == sizeof(sbuf->data)) {
+			send_buf_flush(sbuf);
+		}
+
+		copy = MIN(len, sizeof(sbuf->data) - sbuf->len);
+		memcpy(sbuf->data + sbuf->len, data, copy);
+
+		sbuf->len += copy;
+		data = (const u8_t *)data + copy;
+		len -= copy;
+	}
+}
+
+static void send_buf_add_str(struct send_buf *sbuf, const char *str)
+{
+	send_buf_add(sbuf, str, strlen(str));
+}
+
+static struct http_request *pipeline_head(struct http_client_conn *conn)
+{
+	if (conn->pipeline_count == 0U) {
+		return NULL;
+	}
+
+	return conn->pipeline[conn->pipeline_head];
+}
+
+static void pipeline_pop(struct http_client_conn *conn)
+{
+	conn->pipeline_head = (conn->pipeline_head + 1) %
+		CONFIG_HTTP_CLIENT_PIPELINE_DEPTH;
+	conn->pipeline_count--;
+}
+
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_client_conn *conn =
+		CONTAINER_OF(parser, struct http_client_conn, parser);
+	struct http_request *req = pipeline_head(conn);
+
+	if (!req) {
+		return -EINVAL;
+	}
+
+	req->rsp.http_status_code = parser->status_code;
+	req->rsp.chunked = !!(parser->flags & F_CHUNKED);
+
+	if (parser->flags & F_CONTENTLENGTH) {
+		req->rsp.content_length = parser->content_length;
+	}
+
+	/* Tell the parser that a response to HEAD has no body */
+	return req->method == HTTP_HEAD ? 1 : 0;
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_conn *conn =
+		CONTAINER_OF(parser, struct http_client_conn, parser);
+	struct http_request *req = pipeline_head(conn);
+
+	if (!req) {
+		return -EINVAL;
+	}
+
+	req->rsp.body_frag_start = (const u8_t *)at;
+	req->rsp.body_frag_len = length;
+	req->rsp.processed += length;
+
+	req->response(&req->rsp, HTTP_DATA_MORE, req->user_data);
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_client_conn *conn =
+		CONTAINER_OF(parser, struct http_client_conn, parser);
+	struct http_request *req = pipeline_head(conn);
+
+	if (!req) {
+		return -EINVAL;
+	}
+
+	if (!http_should_keep_alive(parser)) {
+		conn->keep_alive = false;
+	}
+
+	pipeline_pop(conn);
+
+	req->rsp.body_frag_start = NULL;
+	req->rsp.body_frag_len = 0;
+	req->rsp.message_complete = 1U;
+
+	req->response(&req->rsp, HTTP_DATA_FINAL, req->user_data);
+
+	return 0;
+}
+
+static const struct http_parser_settings parser_settings = {
+	.on_headers_complete = on_headers_complete,
+	.on_body = on_body,
+	.on_message_complete = on_message_complete,
+};
+
+static void conn_close(struct http_client_conn *conn)
+{
+	if (conn->sock >= 0) {
+		NET_DBG("Closing connection to %s:%u", log_strdup(conn->host),
+			conn->port);
+
+		(void)close(conn->sock);
+		conn->sock = -1;
+	}
+
+	conn->pipeline_count = 0U;
+	conn->host[0] = '\0';
+}
+
+/* An idle connection is readable only if the server closed it, or sent
+ * something it should not have.
+ */
+static bool conn_is_alive(struct http_client_conn *conn)
+{
+	struct pollfd fds = {
+		.fd = conn->sock,
+		.events = POLLIN,
+	};
+
+	if (k_uptime_get() - conn->last_used >
+	    CONFIG_HTTP_CLIENT_KEEPALIVE_TIMEOUT) {
+		return false;
+	}
+
+	return poll(&fds, 1, 0) == 0;
+}
+
+static int conn_open(struct http_client_conn *conn, const char *host,
+		     u16_t port, const sec_tag_t *sec_tags,
+		     size_t sec_tag_count)
+{
+	struct addrinfo hints = {
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct addrinfo *res;
+	char service[sizeof("65535")];
+	int proto = IPPROTO_TCP;
+	int ret;
+
+	snprintk(service, sizeof(service), "%u", port);
+
+	ret = getaddrinfo(host, service, &hints, &res);
+	if (ret != 0) {
+		NET_DBG("Cannot resolve %s (%d)", log_strdup(host), ret);
+		return -EHOSTUNREACH;
+	}
+
+	if (sec_tags) {
+#if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
+		proto = IPPROTO_TLS_1_2;
+#else
+		ret = -EPROTONOSUPPORT;
+		goto out;
+#endif
+	}
+
+	conn->sock = socket(res->ai_family, SOCK_STREAM, proto);
+	if (conn->sock < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
+	if (sec_tags) {
+		ret = setsockopt(conn->sock, SOL_TLS, TLS_SEC_TAG_LIST,
+				 sec_tags, sizeof(sec_tag_t) * sec_tag_count);
+		if (ret < 0) {
+			ret = -errno;
+			goto error;
+		}
+
+		ret = setsockopt(conn->sock, SOL_TLS, TLS_HOSTNAME,
+				 host, strlen(host));
+		if (ret < 0) {
+			ret = -errno;
+			goto error;
+		}
+	}
+#endif
+
+	ret = connect(conn->sock, res->ai_addr, res->ai_addrlen);
+	if (ret < 0) {
+		ret = -errno;
+		goto error;
+	}
+
+	NET_DBG("Connected to %s:%u", log_strdup(host), port);
+
+	strcpy(conn->host, host);
+	conn->port = port;
+	conn->tls = sec_tags != NULL;
+	conn->keep_alive = true;
+	conn->pipeline_head = 0U;
+	conn->pipeline_count = 0U;
+
+	http_parser_init(&conn->parser, HTTP_RESPONSE);
+
+	ret = 0;
+	goto out;
+
+error:
+	(void)close(conn->sock);
+	conn->sock = -1;
+
+out:
+	freeaddrinfo(res);
+
+	return ret;
+}
+
+int http_client_connect(const char *host, u16_t port,
+			const sec_tag_t *sec_tags, size_t sec_tag_count,
+			struct http_client_conn **conn)
+{
+	struct http_client_conn *found = NULL;
+	struct http_client_conn *idle = NULL;
+	int ret, i;
+
+	if (!host || !conn || strlen(host) > CONFIG_HTTP_CLIENT_HOST_LEN) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct http_client_conn *c = &conns[i];
+
+		if (c->in_use) {
+			continue;
+		}
+
+		if (c->sock >= 0 && c->port == port &&
+		    c->tls == (sec_tags != NULL) &&
+		    !strcasecmp(c->host, host)) {
+			if (conn_is_alive(c)) {
+				found = c;
+				break;
+			}
+
+			conn_close(c);
+		}
+
+		/* Prefer a closed slot, or else the least recently used */
+		if (!idle || (idle->sock >= 0 &&
+			      (c->sock < 0 || c->last_used < idle->last_used))) {
+			idle = c;
+		}
+	}
+
+	if (!found && idle) {
+		conn_close(idle);
+		found = idle;
+	}
+
+	if (found) {
+		found->in_use = true;
+	}
+
+	k_mutex_unlock(&conns_lock);
+
+	if (!found) {
+		return -ENOMEM;
+	}
+
+	if (found->sock < 0) {
+		ret = conn_open(found, host, port, sec_tags, sec_tag_count);
+		if (ret < 0) {
+			found->in_use = false;
+			return ret;
+		}
+	} else {
+		NET_DBG("Reusing connection to %s:%u", log_strdup(host), port);
+	}
+
+	*conn = found;
+
+	return 0;
+}
+
+int http_client_send(struct http_client_conn *conn, struct http_request *req)
+{
+	struct send_buf sbuf;
+	char len_str[sizeof("4294967295")];
+	int i;
+
+	if (!conn || conn->sock < 0 || !req || !req->url || !req->response) {
+		return -EINVAL;
+	}
+
+	if (!conn->keep_alive && conn->pipeline_count) {
+		/* The server closes the connection after the pending
+		 * response.
+		 */
+		return -ENOTCONN;
+	}
+
+	if (conn->pipeline_count == CONFIG_HTTP_CLIENT_PIPELINE_DEPTH) {
+		return -EAGAIN;
+	}
+
+	sbuf.sock = conn->sock;
+	sbuf.err = 0;
+	sbuf.len = 0;
+
+	send_buf_add_str(&sbuf, http_method_str(req->method));
+	send_buf_add_str(&sbuf, " ");
+	send_buf_add_str(&sbuf, req->url);
+	send_buf_add_str(&sbuf, " " HTTP_PROTOCOL "\r\nHost: ");
+	send_buf_add_str(&sbuf, conn->host);
+	send_buf_add_str(&sbuf, "\r\n");
+
+	for (i = 0; req->header_fields && req->header_fields[i]; i++) {
+		send_buf_add_str(&sbuf, req->header_fields[i]);
+	}
+
+	if (req->content_type_value) {
+		send_buf_add_str(&sbuf, "Content-Type: ");
+		send_buf_add_str(&sbuf, req->content_type_value);
+		send_buf_add_str(&sbuf, "\r\n");
+	}
+
+	if (req->payload || req->content_type_value) {
+		snprintk(len_str, sizeof(len_str), "%zu", req->payload_len);
+
+		send_buf_add_str(&sbuf, "Content-Length: ");
+		send_buf_add_str(&sbuf, len_str);
+		send_buf_add_str(&sbuf, "\r\n");
+	}
+
+	send_buf_add_str(&sbuf, "\r\n");
+
+	/* A small body goes out with the headers */
+	if (req->payload_len <= sizeof(sbuf.data) - sbuf.len) {
+		send_buf_add(&sbuf, req->payload, req->payload_len);
+		send_buf_flush(&sbuf);
+	} else {
+		send_buf_flush(&sbuf);
+
+		if (sbuf.err == 0) {
+			sbuf.err = sendall(conn->sock, req->payload,
+					   req->payload_len);
+		}
+	}
+
+	if (sbuf.err < 0) {
+		NET_DBG("Cannot send request (%d)", sbuf.err);
+		conn->keep_alive = false;
+		return sbuf.err;
+	}
+
+	(void)memset(&req->rsp, 0, sizeof(req->rsp));
+
+	conn->pipeline[(conn->pipeline_head + conn->pipeline_count) %
+		       CONFIG_HTTP_CLIENT_PIPELINE_DEPTH] = req;
+	conn->pipeline_count++;
+
+	return 0;
+}
+
+int http_client_process(struct http_client_conn *conn, s32_t timeout)
+{
+	struct pollfd fds;
+	s64_t end = k_uptime_get() + timeout;
+	size_t parsed;
+	ssize_t len;
+	int ret;
+
+	if (!conn || conn->sock < 0) {
+		return -EINVAL;
+	}
+
+	fds.fd = conn->sock;
+	fds.events = POLLIN;
+
+	while (conn->pipeline_count) {
+		if (timeout != K_FOREVER) {
+			s64_t remaining = end - k_uptime_get();
+
+			if (remaining <= 0) {
+				return -ETIMEDOUT;
+			}
+
+			ret = poll(&fds, 1, (int)remaining);
+		} else {
+			ret = poll(&fds, 1, -1);
+		}
+
+		if (ret < 0) {
+			ret = -errno;
+			goto error;
+		}
+
+		if (ret == 0) {
+			return -ETIMEDOUT;
+		}
+
+		len = recv(conn->sock, conn->recv_buf, sizeof(conn->recv_buf),
+			   0);
+		if (len < 0) {
+			ret = -errno;
+			goto error;
+		}
+
+		/* A zero length marks the end of a body delimited by the
+		 * connection close.
+		 */
+		parsed = http_parser_execute(&conn->parser, &parser_settings,
+					     (const char *)conn->recv_buf,
+					     len);
+		if (conn->parser.http_errno != HPE_OK || parsed != len) {
+			NET_DBG("Cannot parse response (%s)",
+				http_errno_name(conn->parser.http_errno));
+			ret = -EBADMSG;
+			goto error;
+		}
+
+		if (len == 0) {
+			conn->keep_alive = false;
+
+			if (conn->pipeline_count) {
+				ret = -ECONNRESET;
+				goto error;
+			}
+		}
+	}
+
+	conn->last_used = k_uptime_get();
+
+	return 0;
+
+error:
+	conn->keep_alive = false;
+
+	return ret;
+}
+
+void http_client_release(struct http_client_conn *conn)
+{
+	if (!conn) {
+		return;
+	}
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	if (!conn->keep_alive || conn->pipeline_count) {
+		conn_close(conn);
+	}
+
+	conn->in_use = false;
+
+	k_mutex_unlock(&conns_lock);
+}
+
+int http_client_req(const char *host, u16_t port,
+		    const sec_tag_t *sec_tags, size_t sec_tag_count,
+		    struct http_request *req, s32_t timeout)
+{
+	struct http_client_conn *conn;
+	int ret;
+
+	ret = http_client_connect(host, port, sec_tags, sec_tag_count, &conn);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = http_client_send(conn, req);
+	if (ret == 0) {
+		ret = http_client_process(conn, timeout);
+	}
+
+	http_client_release(conn);
+
+	return ret;
+}
+
+static int http_client_init(struct device *dev)
+{
+	int i;
+
+	ARG_UNUSED(dev);
+
+	for (i = 0; i < ARRAY_SIZE(conns); i++) {
+		conns[i].sock = -1;
+	}
+
+	return 0;
+}
+
+SYS_INIT(http_client_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -49,6 +49,12 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #ifdef CONFIG_LWM2M_RW_JSON_SUPPORT
 #include "lwm2m_rw_json.h"
 #endif
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+#include "lwm2m_rw_cbor.h"
+#endif
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+#include "lwm2m_rw_senml_cbor.h"
+#endif
 #ifdef CONFIG_LWM2M_RD_CLIENT_SUPPORT
 #include "lwm2m_rd_client.h"
 #endif
@@ -91,6 +97,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 struct observe_node {
 	sys_snode_t node;
+	sys_snode_t dirty_node;
 	struct lwm2m_ctx *ctx;
 	struct lwm2m_obj_path path;
 	u8_t  token[MAX_TOKEN_LEN];
@@ -101,6 +108,7 @@ struct observe_node {
 	u32_t counter;
 	u16_t format;
 	u8_t  tkl;
+	bool  dirty;
 };
 
 struct notification_attrs {
@@ -127,8 +135,12 @@ struct service_node {
 static struct service_node service_node_data[MAX_PERIODIC_SERVICE];
 
 static sys_slist_t engine_obj_list;
+/* sorted by object ID, then by instance ID */
 static sys_slist_t engine_obj_inst_list;
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_OBJ_INST_HASH_SIZE];
 static sys_slist_t engine_observer_list;
+/* observers with a notify event pending */
+static sys_slist_t engine_dirty_list;
 static sys_slist_t engine_service_list;
 
 static K_THREAD_STACK_DEFINE(engine_thread_stack,
@@ -390,6 +402,12 @@ int lwm2m_notify_observer(u16_t obj_id, u16_t obj_inst_id, u16_t res_id)
 			/* update the event time for this observer */
 			obs->event_timestamp = k_uptime_get();
 
+			if (!obs->dirty) {
+				obs->dirty = true;
+				sys_slist_append(&engine_dirty_list,
+						 &obs->dirty_node);
+			}
+
 			LOG_DBG("NOTIFY EVENT %u/%u/%u",
 				obj_id, obj_inst_id, res_id);
 
@@ -400,6 +418,16 @@ int lwm2m_notify_observer(u16_t obj_id, u16_t obj_inst_id, u16_t res_id)
 	return ret;
 }
 
+static void engine_observer_free(struct observe_node *obs)
+{
+	if (obs->dirty) {
+		sys_slist_find_and_remove(&engine_dirty_list,
+					  &obs->dirty_node);
+	}
+
+	(void)memset(obs, 0, sizeof(*obs));
+}
+
 int lwm2m_notify_observer_path(struct lwm2m_obj_path *path)
 {
 	return lwm2m_notify_observer(path->obj_id, path->obj_inst_id,
@@ -581,7 +609,7 @@ static int engine_remove_observer(const u8_t *token, u8_t tkl)
 	}
 
 	sys_slist_remove(&engine_observer_list, prev_node, &found_obj->node);
-	(void)memset(found_obj, 0, sizeof(*found_obj));
+	engine_observer_free(found_obj);
 
 	LOG_DBG("observer '%s' removed", log_strdup(sprint_token(token, tkl)));
 
@@ -603,7 +631,7 @@ static void engine_remove_observer_by_id(u16_t obj_id, s32_t obj_inst_id)
 		}
 
 		sys_slist_remove(&engine_observer_list, prev_node, &obs->node);
-		(void)memset(obs, 0, sizeof(*obs));
+		engine_observer_free(obs);
 	}
 }
 
@@ -651,15 +679,53 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 
 /* engine object instance */
 
+static sys_slist_t *obj_inst_bucket(int obj_id, int obj_inst_id)
+{
+	u32_t hash = ((u32_t)obj_id << 16) ^ (u16_t)obj_inst_id;
+
+	hash ^= hash >> 13;
+	hash *= 0x5bd1e995U;
+	hash ^= hash >> 15;
+
+	return &engine_obj_inst_hash[hash %
+				     CONFIG_LWM2M_ENGINE_OBJ_INST_HASH_SIZE];
+}
+
+static bool obj_inst_is_before(struct lwm2m_engine_obj_inst *a,
+			       struct lwm2m_engine_obj_inst *b)
+{
+	return a->obj->obj_id < b->obj->obj_id ||
+		(a->obj->obj_id == b->obj->obj_id &&
+		 a->obj_inst_id < b->obj_inst_id);
+}
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
-	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	struct lwm2m_engine_obj_inst *iter;
+	sys_snode_t *prev_node = NULL;
+
+	/* keep the list sorted, for next_engine_obj_inst() */
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, iter, node) {
+		if (obj_inst_is_before(obj_inst, iter)) {
+			break;
+		}
+
+		prev_node = &iter->node;
+	}
+
+	sys_slist_insert(&engine_obj_inst_list, prev_node, &obj_inst->node);
+	sys_slist_prepend(obj_inst_bucket(obj_inst->obj->obj_id,
+					  obj_inst->obj_inst_id),
+			  &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
 	engine_remove_observer_by_id(
 			obj_inst->obj->obj_id, obj_inst->obj_inst_id);
+	sys_slist_find_and_remove(obj_inst_bucket(obj_inst->obj->obj_id,
+						  obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
 }
 
@@ -668,8 +734,8 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_bucket(obj_id, obj_inst_id),
+				     obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id &&
 		    obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -682,18 +748,21 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 static struct lwm2m_engine_obj_inst *
 next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
-	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
+	struct lwm2m_engine_obj_inst *obj_inst;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
 				     node) {
+		if (obj_inst->obj->obj_id > obj_id) {
+			break;
+		}
+
 		if (obj_inst->obj->obj_id == obj_id &&
-		    obj_inst->obj_inst_id > obj_inst_id &&
-		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
-			next = obj_inst;
+		    obj_inst->obj_inst_id > obj_inst_id) {
+			return obj_inst;
 		}
 	}
 
-	return next;
+	return NULL;
 }
 
 int lwm2m_create_obj_inst(u16_t obj_id, u16_t obj_inst_id,
@@ -1023,6 +1092,8 @@ cleanup:
 
 int lwm2m_send_message(struct lwm2m_message *msg)
 {
+	int flags = 0;
+
 	if (!msg || !msg->ctx) {
 		LOG_ERR("LwM2M message is invalid.");
 		return -EINVAL;
@@ -1034,12 +1105,25 @@ int lwm2m_send_message(struct lwm2m_message *msg)
 
 	msg->send_attempts++;
 
-	if (send(msg->ctx->sock_fd, msg->cpkt.data, msg->cpkt.offset, 0) < 0) {
-		if (msg->type == COAP_TYPE_CON) {
-			coap_pending_clear(msg->pending);
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+	/* Do not wait for the DTLS handshake, it runs in the background */
+	if (msg->ctx->use_dtls) {
+		flags = MSG_DONTWAIT;
+	}
+#endif
+
+	if (send(msg->ctx->sock_fd, msg->cpkt.data, msg->cpkt.offset,
+		 flags) < 0) {
+		if (errno != EAGAIN || msg->type != COAP_TYPE_CON) {
+			if (msg->type == COAP_TYPE_CON) {
+				coap_pending_clear(msg->pending);
+			}
+
+			return -errno;
 		}
 
-		return -errno;
+		/* Sent again by the retransmission */
+		LOG_DBG("Message deferred, socket not ready");
 	}
 
 	if (msg->type == COAP_TYPE_CON) {
@@ -1143,6 +1227,18 @@ static int select_writer(struct lwm2m_output_context *out, u16_t accept)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_CBOR:
+		out->writer = &cbor_writer;
+		break;
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		out->writer = &senml_cbor_writer;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", accept);
 		return -ENOMSG;
@@ -1174,6 +1270,19 @@ static int select_reader(struct lwm2m_input_context *in, u16_t format)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_CBOR:
+		in->reader = &cbor_reader;
+		break;
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	/* the values of the records are plain CBOR items */
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		in->reader = &cbor_reader;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", format);
 		return -ENOMSG;
@@ -2665,6 +2774,16 @@ static int do_read_op(struct lwm2m_engine_obj *obj,
 		return do_read_op_json(obj, msg, content_format);
 #endif
 
+#if defined(CONFIG_LWM2M_RW_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_CBOR:
+		return do_read_op_cbor(obj, msg, content_format);
+#endif
+
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_read_op_senml_cbor(obj, msg, content_format);
+#endif
+
 	default:
 		LOG_ERR("Unsupported content-format: %u", content_format);
 		return -ENOMSG;
@@ -3070,6 +3189,16 @@ static int do_write_op(struct lwm2m_engine_obj *obj,
 		return do_write_op_json(obj, msg);
 #endif
 
+#ifdef CONFIG_LWM2M_RW_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_CBOR:
+		return do_write_op_cbor(obj, msg);
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_write_op_senml_cbor(obj, msg);
+#endif
+
 	default:
 		LOG_ERR("Unsupported format: %u", format);
 		return -ENOMSG;
@@ -3767,7 +3896,7 @@ int lwm2m_engine_add_service(k_work_handler_t service, u32_t period_ms)
 
 static int lwm2m_engine_service(void)
 {
-	struct observe_node *obs;
+	struct observe_node *obs, *tmp;
 	struct service_node *srv;
 	s64_t timestamp, service_due_timestamp;
 
@@ -3778,7 +3907,8 @@ static int lwm2m_engine_service(void)
 	 *    attaching the notify response handler
 	 */
 	timestamp = k_uptime_get();
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&engine_dirty_list, obs, tmp,
+					  dirty_node) {
 		/*
 		 * manual notify requirements:
 		 * - event_timestamp > last_timestamp
@@ -3789,17 +3919,30 @@ static int lwm2m_engine_service(void)
 				K_SECONDS(obs->min_period_sec)) {
 			obs->last_timestamp = k_uptime_get();
 			generate_notify_message(obs, true);
+		}
+
+		if (obs->event_timestamp <= obs->last_timestamp) {
+			sys_slist_find_and_remove(&engine_dirty_list,
+						  &obs->dirty_node);
+			obs->dirty = false;
+		}
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		/* event still waiting for min_period_sec */
+		if (obs->dirty) {
+			continue;
+		}
 
 		/*
 		 * automatic time-based notify requirements:
 		 * - current timestamp > last_timestamp + max_period_sec
 		 */
-		} else if (timestamp > obs->last_timestamp +
+		if (timestamp > obs->last_timestamp +
 				K_SECONDS(obs->min_period_sec)) {
 			obs->last_timestamp = k_uptime_get();
 			generate_notify_message(obs, false);
 		}
-
 	}
 
 	timestamp = k_uptime_get();
@@ -3829,7 +3972,7 @@ int lwm2m_engine_context_close(struct lwm2m_ctx *client_ctx)
 		if (obs->ctx == client_ctx) {
 			sys_slist_remove(&engine_observer_list, prev_node,
 					 &obs->node);
-			(void)memset(obs, 0, sizeof(*obs));
+			engine_observer_free(obs);
 		} else {
 			prev_node = &obs->node;
 		}
@@ -31,7 +31,7 @@ static struct k_work firmware_work;
 static char firmware_uri[URI_LEN];
 static struct lwm2m_ctx firmware_ctx;
 static int firmware_retry;
-static struct coap_block_context firmware_block_ctx;
+static struct coap_block_window firmware_window;
 
 #if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_COAP_PROXY_SUPPORT)
 #define COAP2COAP_PROXY_URI_PATH	"coap2coap"
@@ -193,6 +193,23 @@ cleanup:
 	return ret;
 }
 
+/* Request the blocks the window allows */
+static int transfer_requests(coap_reply_t reply_cb)
+{
+	struct coap_block_context block_ctx;
+	int ret;
+
+	while (coap_block_window_next(&firmware_window, &block_ctx) == 0) {
+		ret = transfer_request(&block_ctx, coap_next_token(), 8,
+				       reply_cb);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 static int transfer_empty_ack(u16_t mid)
 {
 	struct lwm2m_message *msg;
@@ -241,7 +258,6 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 	lwm2m_engine_set_data_cb_t write_cb;
 	size_t write_buflen;
 	u8_t resp_code, *write_buf;
-	struct coap_block_context received_block_ctx;
 
 	/* token is used to determine a valid ACK vs a separated response */
 	tkl = coap_header_get_token(check_response, token);
@@ -268,40 +284,28 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 		goto error;
 	}
 
-	/* save main firmware block context */
-	memcpy(&received_block_ctx, &firmware_block_ctx,
-	       sizeof(firmware_block_ctx));
-
-	ret = coap_update_from_block(check_response, &firmware_block_ctx);
-	if (ret < 0) {
+	ret = coap_block_window_received(&firmware_window, check_response,
+					 &last_block);
+	if (ret == -EALREADY) {
+		LOG_WRN("Duplicate packet ignored");
+		return 0;
+	} else if (ret == -EAGAIN) {
+		/* A previous block is missing, this one is requested again */
+		LOG_DBG("Out of order block ignored");
+		goto next;
+	} else if (ret < 0) {
 		LOG_ERR("Error from block update: %d", ret);
 		ret = -EFAULT;
 		goto error;
 	}
 
-	/* test for duplicate transfer */
-	if (firmware_block_ctx.current < received_block_ctx.current) {
-		LOG_WRN("Duplicate packet ignored");
-
-		/* restore main firmware block context */
-		memcpy(&firmware_block_ctx, &received_block_ctx,
-		       sizeof(firmware_block_ctx));
-
-		/* set reply->user_data to error to avoid releasing */
-		reply->user_data = (void *)COAP_REPLY_STATUS_ERROR;
-		return 0;
-	}
-
-	/* Reach last block if ret equals to 0 */
-	last_block = !coap_next_block(check_response, &firmware_block_ctx);
-
 	/* Process incoming data */
 	payload_offset = response->hdr_len + response->opt_len;
 	coap_packet_get_payload(response, &payload_len);
 	if (payload_len > 0) {
 		LOG_DBG("total: %zd, current: %zd",
-			firmware_block_ctx.total_size,
-			firmware_block_ctx.current);
+			firmware_window.ctx.total_size,
+			firmware_window.ctx.current);
 
 		/* look up firmware package resource */
 		ret = lwm2m_engine_get_resource("5/0/0", &res);
@@ -335,7 +339,7 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 				}
 
 				ret = write_cb(0, write_buf, len, last_block,
-					       firmware_block_ctx.total_size);
+					       firmware_window.ctx.total_size);
 				if (ret < 0) {
 					goto error;
 				}
@@ -343,16 +347,17 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 		}
 	}
 
-	if (!last_block) {
-		/* More block(s) to come, setup next transfer */
-		ret = transfer_request(&firmware_block_ctx, token, tkl,
-				       do_firmware_transfer_reply_cb);
-		if (ret < 0) {
-			goto error;
-		}
-	} else {
+	if (last_block) {
 		/* Download finished */
 		lwm2m_firmware_set_update_state(STATE_DOWNLOADED);
+		return 0;
+	}
+
+next:
+	/* More block(s) to come, setup next transfers */
+	ret = transfer_requests(do_firmware_transfer_reply_cb);
+	if (ret < 0) {
+		goto error;
 	}
 
 	return 0;
@@ -367,12 +372,11 @@ static void do_transmit_timeout_cb(struct lwm2m_message *msg)
 	int ret;
 
 	if (firmware_retry < PACKET_TRANSFER_RETRY_MAX) {
-		/* retry block */
+		/* retry the blocks not received */
 		LOG_WRN("TIMEOUT - Sending a retry packet!");
 
-		ret = transfer_request(&firmware_block_ctx,
-				       msg->token, msg->tkl,
-				       do_firmware_transfer_reply_cb);
+		coap_block_window_rewind(&firmware_window);
+		ret = transfer_requests(do_firmware_transfer_reply_cb);
 		if (ret < 0) {
 			/* abort retries / transfer */
 			set_update_result_from_error(ret);
@@ -425,10 +429,9 @@ static void firmware_transfer(struct k_work *work)
 	LOG_INF("Connecting to server %s", firmware_uri);
 
 	/* reset block transfer context */
-	coap_block_transfer_init(&firmware_block_ctx,
-				 lwm2m_default_block_size(), 0);
-	ret = transfer_request(&firmware_block_ctx, coap_next_token(), 8,
-			       do_firmware_transfer_reply_cb);
+	coap_block_window_init(&firmware_window, lwm2m_default_block_size(),
+			       CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_WINDOW);
+	ret = transfer_requests(do_firmware_transfer_reply_cb);
 	if (ret < 0) {
 		goto error;
 	}
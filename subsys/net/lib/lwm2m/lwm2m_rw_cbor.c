@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CBOR content format (application/cbor) of a single resource value, and
+ * the CBOR primitives shared with the SenML-CBOR formatter. The items are
+ * encoded straight into the CoAP packet and decoded in place with the CBOR
+ * library, there is no intermediate text representation.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <misc/byteorder.h>
+#include <cbor_codec.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_cbor.h"
+#include "lwm2m_rw_plain_text.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_util.h"
+
+static inline void put_be64(u64_t val, u8_t dst[8])
+{
+	sys_put_be32(val >> 32, dst);
+	sys_put_be32(val, &dst[4]);
+}
+
+static int write_to_cpkt(struct cbor_writer *writer, const u8_t *data,
+			 size_t len)
+{
+	struct coap_packet *cpkt = writer->user_data;
+
+	if (len > UINT16_MAX) {
+		return -ENOMEM;
+	}
+
+	return buf_append(CPKT_BUF_WRITE(cpkt), (u8_t *)data, len);
+}
+
+static void out_writer(struct lwm2m_output_context *out,
+		       struct cbor_writer *writer)
+{
+	cbor_writer_init(writer, write_to_cpkt, out->out_cpkt);
+}
+
+/* the number of bytes written, 0 on error as the writer ops expect */
+static size_t out_len(struct cbor_writer *writer, int ret)
+{
+	return ret < 0 ? 0 : writer->len;
+}
+
+static size_t cbor_put(struct lwm2m_output_context *out, u8_t *buf,
+		       u16_t buflen)
+{
+	int ret;
+
+	ret = buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, buflen);
+	if (ret < 0) {
+		LOG_ERR("No room for %u bytes of CBOR: %d", buflen, ret);
+		return 0;
+	}
+
+	return buflen;
+}
+
+size_t cbor_put_head(struct lwm2m_output_context *out, u8_t major,
+		     u64_t value)
+{
+	struct cbor_writer writer;
+
+	out_writer(out, &writer);
+
+	return out_len(&writer, cbor_write_head(&writer, major, value));
+}
+
+size_t cbor_put_indefinite(struct lwm2m_output_context *out, u8_t major)
+{
+	u8_t head = (major << 5) | CBOR_AI_INDEFINITE;
+
+	return cbor_put(out, &head, sizeof(head));
+}
+
+size_t cbor_put_break(struct lwm2m_output_context *out)
+{
+	struct cbor_writer writer;
+
+	out_writer(out, &writer);
+
+	return out_len(&writer, cbor_write_break(&writer));
+}
+
+size_t cbor_put_int(struct lwm2m_output_context *out, s64_t value)
+{
+	struct cbor_writer writer;
+
+	out_writer(out, &writer);
+
+	return out_len(&writer, cbor_write_int(&writer, value));
+}
+
+size_t cbor_put_tstr(struct lwm2m_output_context *out, const char *buf,
+		     size_t buflen)
+{
+	struct cbor_writer writer;
+
+	out_writer(out, &writer);
+
+	return out_len(&writer, cbor_write_tstr(&writer, buf, buflen));
+}
+
+/* The library reads in place from the packet data between the offset of
+ * the input context and the end of the packet.
+ */
+static void in_reader(struct lwm2m_input_context *in,
+		      struct cbor_reader *reader)
+{
+	u16_t end = MAX(in->offset, in->in_cpkt->offset);
+
+	cbor_reader_init(reader, in->in_cpkt->data + in->offset,
+			 end - in->offset);
+}
+
+static void in_advance(struct lwm2m_input_context *in,
+		       const struct cbor_reader *reader)
+{
+	in->offset = reader->pos - in->in_cpkt->data;
+}
+
+int cbor_get_head(struct lwm2m_input_context *in, u8_t *major, u8_t *ai,
+		  u64_t *value)
+{
+	struct cbor_reader reader;
+	int ret;
+
+	in_reader(in, &reader);
+
+	ret = cbor_read_head(&reader, major, ai, value);
+	if (ret < 0) {
+		return ret;
+	}
+
+	in_advance(in, &reader);
+
+	return 0;
+}
+
+int cbor_get_int(struct lwm2m_input_context *in, s64_t *value)
+{
+	struct cbor_reader reader;
+	int ret;
+
+	in_reader(in, &reader);
+
+	ret = cbor_read_int(&reader, value);
+	if (ret < 0) {
+		return ret;
+	}
+
+	in_advance(in, &reader);
+
+	return 0;
+}
+
+int cbor_get_skip(struct lwm2m_input_context *in)
+{
+	struct cbor_reader reader;
+	int ret;
+
+	in_reader(in, &reader);
+
+	ret = cbor_skip(&reader);
+	if (ret < 0) {
+		return ret;
+	}
+
+	in_advance(in, &reader);
+
+	return 0;
+}
+
+/* writer */
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s64_t value)
+{
+	return cbor_put_int(out, value);
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s32_t value)
+{
+	return cbor_put_int(out, value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s16_t value)
+{
+	return cbor_put_int(out, value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, s8_t value)
+{
+	return cbor_put_int(out, value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	return cbor_put_tstr(out, buf, buflen);
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	struct cbor_writer writer;
+
+	out_writer(out, &writer);
+
+	return out_len(&writer, cbor_write_bstr(&writer, buf, buflen));
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	u8_t buf[5];
+	int ret;
+
+	buf[0] = (CBOR_MAJOR_SIMPLE << 5) | CBOR_AI_FLOAT32;
+
+	ret = lwm2m_f32_to_b32(value, &buf[1], 4);
+	if (ret < 0) {
+		LOG_ERR("float32 conversion error: %d", ret);
+		return 0;
+	}
+
+	return cbor_put(out, buf, sizeof(buf));
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	u8_t buf[9];
+	int ret;
+
+	buf[0] = (CBOR_MAJOR_SIMPLE << 5) | CBOR_AI_FLOAT64;
+
+	ret = lwm2m_f64_to_b64(value, &buf[1], 8);
+	if (ret < 0) {
+		LOG_ERR("float64 conversion error: %d", ret);
+		return 0;
+	}
+
+	return cbor_put(out, buf, sizeof(buf));
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	struct cbor_writer writer;
+
+	out_writer(out, &writer);
+
+	return out_len(&writer, cbor_write_bool(&writer, value));
+}
+
+/* reader */
+
+static size_t get_s64(struct lwm2m_input_context *in, s64_t *value)
+{
+	u16_t start = in->offset;
+
+	if (cbor_get_int(in, value) < 0) {
+		return 0;
+	}
+
+	return in->offset - start;
+}
+
+static size_t get_s32(struct lwm2m_input_context *in, s32_t *value)
+{
+	s64_t tmp = 0;
+	size_t len;
+
+	len = get_s64(in, &tmp);
+	if (len > 0) {
+		*value = (s32_t)tmp;
+	}
+
+	return len;
+}
+
+static size_t get_string(struct lwm2m_input_context *in,
+			 u8_t *buf, size_t buflen)
+{
+	u16_t start = in->offset;
+	struct cbor_reader reader;
+	struct cbor_str str;
+	size_t len;
+
+	if (buflen == 0) {
+		return 0;
+	}
+
+	in_reader(in, &reader);
+
+	if (cbor_read_tstr(&reader, &str) < 0 &&
+	    cbor_read_bstr(&reader, &str) < 0) {
+		return 0;
+	}
+
+	len = MIN(str.len, buflen - 1);
+	if (len < str.len) {
+		LOG_WRN("String truncated from %u to %u bytes",
+			(unsigned int)str.len, (unsigned int)len);
+	}
+
+	memcpy(buf, str.data, len);
+	buf[len] = '\0';
+
+	in_advance(in, &reader);
+
+	return in->offset - start;
+}
+
+/* A number of any encoding, scaled to the precision of the fraction */
+static int get_fixed(struct lwm2m_input_context *in, s64_t *val1,
+		     s64_t *val2, s64_t dec_max)
+{
+	float64_value_t f64;
+	float32_value_t f32;
+	u8_t buf[8];
+	u64_t val;
+	u8_t major, ai;
+	u16_t start;
+	int ret;
+
+	start = in->offset;
+	ret = cbor_get_head(in, &major, &ai, &val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major == CBOR_MAJOR_UINT || major == CBOR_MAJOR_NINT) {
+		in->offset = start;
+		*val2 = 0;
+		return cbor_get_int(in, val1);
+	}
+
+	if (major != CBOR_MAJOR_SIMPLE) {
+		return -EINVAL;
+	}
+
+	if (ai == CBOR_AI_FLOAT32) {
+		sys_put_be32((u32_t)val, buf);
+		ret = lwm2m_b32_to_f32(buf, 4, &f32);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*val1 = f32.val1;
+		*val2 = (s64_t)f32.val2 * (dec_max / LWM2M_FLOAT32_DEC_MAX);
+	} else if (ai == CBOR_AI_FLOAT64) {
+		put_be64(val, buf);
+		ret = lwm2m_b64_to_f64(buf, 8, &f64);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*val1 = f64.val1;
+		*val2 = f64.val2 / (LWM2M_FLOAT64_DEC_MAX / dec_max);
+	} else {
+		/* half precision floats are not produced by servers */
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static size_t get_float32fix(struct lwm2m_input_context *in,
+			     float32_value_t *value)
+{
+	u16_t start = in->offset;
+	s64_t tmp1, tmp2;
+
+	if (get_fixed(in, &tmp1, &tmp2, LWM2M_FLOAT32_DEC_MAX) < 0) {
+		return 0;
+	}
+
+	value->val1 = (s32_t)tmp1;
+	value->val2 = (s32_t)tmp2;
+
+	return in->offset - start;
+}
+
+static size_t get_float64fix(struct lwm2m_input_context *in,
+			     float64_value_t *value)
+{
+	u16_t start = in->offset;
+
+	if (get_fixed(in, &value->val1, &value->val2,
+		      LWM2M_FLOAT64_DEC_MAX) < 0) {
+		return 0;
+	}
+
+	return in->offset - start;
+}
+
+static size_t get_bool(struct lwm2m_input_context *in, bool *value)
+{
+	struct cbor_reader reader;
+
+	in_reader(in, &reader);
+
+	if (cbor_read_bool(&reader, value) < 0) {
+		return 0;
+	}
+
+	in_advance(in, &reader);
+
+	return 1;
+}
+
+static size_t get_opaque(struct lwm2m_input_context *in,
+			 u8_t *value, size_t buflen, bool *last_block)
+{
+	u64_t len;
+	u8_t major, ai;
+
+	if (cbor_get_head(in, &major, &ai, &len) < 0 ||
+	    major != CBOR_MAJOR_BSTR || ai == CBOR_AI_INDEFINITE) {
+		return 0;
+	}
+
+	/* the rest of a block-wise transfer follows in the next blocks */
+	in->opaque_len = MIN(len, (u64_t)(in->in_cpkt->offset - in->offset));
+	return lwm2m_engine_get_opaque_more(in, value, buflen, last_block);
+}
+
+const struct lwm2m_writer cbor_writer = {
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+};
+
+const struct lwm2m_reader cbor_reader = {
+	.get_s32 = get_s32,
+	.get_s64 = get_s64,
+	.get_string = get_string,
+	.get_float32fix = get_float32fix,
+	.get_float64fix = get_float64fix,
+	.get_bool = get_bool,
+	.get_opaque = get_opaque,
+};
+
+int do_read_op_cbor(struct lwm2m_engine_obj *obj, struct lwm2m_message *msg,
+		    int content_format)
+{
+	/* A single CBOR item can only hold a single resource */
+	if (msg->path.level != 3U) {
+		return -EPERM; /* NOT_ALLOWED */
+	}
+
+	return lwm2m_perform_read_op(obj, msg, content_format);
+}
+
+int do_write_op_cbor(struct lwm2m_engine_obj *obj, struct lwm2m_message *msg)
+{
+	/* the single resource write is the same as in plain text */
+	return do_write_op_plain_text(obj, msg);
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LWM2M_RW_CBOR_H_
+#define LWM2M_RW_CBOR_H_
+
+#include <cbor_codec.h>
+
+#include "lwm2m_object.h"
+
+extern const struct lwm2m_writer cbor_writer;
+extern const struct lwm2m_reader cbor_reader;
+
+/* encoding helpers, writing straight into the CoAP packet */
+size_t cbor_put_head(struct lwm2m_output_context *out, u8_t major,
+		     u64_t value);
+size_t cbor_put_indefinite(struct lwm2m_output_context *out, u8_t major);
+size_t cbor_put_break(struct lwm2m_output_context *out);
+size_t cbor_put_int(struct lwm2m_output_context *out, s64_t value);
+size_t cbor_put_tstr(struct lwm2m_output_context *out, const char *buf,
+		     size_t buflen);
+
+/* decoding helpers, reading at the offset of the input context */
+int cbor_get_head(struct lwm2m_input_context *in, u8_t *major, u8_t *ai,
+		  u64_t *value);
+int cbor_get_int(struct lwm2m_input_context *in, s64_t *value);
+int cbor_get_skip(struct lwm2m_input_context *in);
+
+int do_read_op_cbor(struct lwm2m_engine_obj *obj, struct lwm2m_message *msg,
+		    int content_format);
+int do_write_op_cbor(struct lwm2m_engine_obj *obj, struct lwm2m_message *msg);
+
+#endif /* LWM2M_RW_CBOR_H_ */
@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SenML-CBOR content format (RFC 8428). The records are streamed into the
+ * CoAP packet as the resources are read: the pack is an indefinite length
+ * array terminated in put_end(), so nothing has to be counted or buffered
+ * beforehand, and the base name is carried by the first record only.
+ * Values are plain CBOR items, so the CBOR reader is used for the values
+ * of a write.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_senml_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ctype.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_cbor.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_engine.h"
+
+/* SenML labels */
+#define SENML_LABEL_BN		-2
+#define SENML_LABEL_N		0
+#define SENML_LABEL_V		2
+#define SENML_LABEL_VS		3
+#define SENML_LABEL_VB		4
+#define SENML_LABEL_VD		8
+
+/* "65535/65535/65535/" */
+#define NAME_BUF_LEN		24
+
+struct senml_cbor_out_formatter_data {
+	/* flags */
+	u8_t writer_flags;
+
+	/* path storage */
+	u8_t path_level;
+
+	/* the first record carries the base name */
+	bool base_written;
+};
+
+static u16_t put_id(char *buf, u16_t id)
+{
+	char digits[5];
+	u16_t len = 0U, i;
+
+	do {
+		digits[len++] = '0' + id % 10U;
+		id /= 10U;
+	} while (id);
+
+	for (i = 0U; i < len; i++) {
+		buf[i] = digits[len - i - 1];
+	}
+
+	return len;
+}
+
+/* Text string of the IDs, separated and optionally surrounded by '/' */
+static size_t put_name(struct lwm2m_output_context *out, u16_t *ids,
+		       int count, bool base)
+{
+	char name[NAME_BUF_LEN];
+	u16_t len = 0U;
+	int i;
+
+	if (base) {
+		name[len++] = '/';
+	}
+
+	for (i = 0; i < count; i++) {
+		if (i > 0) {
+			name[len++] = '/';
+		}
+
+		len += put_id(&name[len], ids[i]);
+	}
+
+	if (base) {
+		name[len++] = '/';
+	}
+
+	return cbor_put_tstr(out, name, len);
+}
+
+static size_t put_record(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path, s8_t value_label)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	u16_t ids[4];
+	int count = 0, base_count;
+	size_t len;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	/* base name, name and value */
+	len = cbor_put_head(out, CBOR_MAJOR_MAP, fd->base_written ? 2 : 3);
+
+	ids[count++] = path->obj_id;
+	ids[count++] = path->obj_inst_id;
+	base_count = fd->path_level >= 2U ? 2 : 1;
+
+	if (!fd->base_written) {
+		len += cbor_put_int(out, SENML_LABEL_BN);
+		len += put_name(out, ids, base_count, true);
+		fd->base_written = true;
+	}
+
+	ids[count++] = path->res_id;
+	if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+		ids[count++] = path->res_inst_id;
+	}
+
+	len += cbor_put_int(out, SENML_LABEL_N);
+	len += put_name(out, &ids[base_count], count - base_count, false);
+	len += cbor_put_int(out, value_label);
+
+	return len;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	return cbor_put_indefinite(out, CBOR_MAJOR_ARRAY);
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	return cbor_put_break(out);
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s64_t value)
+{
+	size_t len;
+
+	len = put_record(out, path, SENML_LABEL_V);
+	len += cbor_put_int(out, value);
+
+	return len;
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s32_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, s16_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, s8_t value)
+{
+	return put_s64(out, path, (s64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_record(out, path, SENML_LABEL_VS);
+	len += cbor_writer.put_string(out, path, buf, buflen);
+
+	return len;
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_record(out, path, SENML_LABEL_VD);
+	len += cbor_writer.put_opaque(out, path, buf, buflen);
+
+	return len;
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	size_t len;
+
+	len = put_record(out, path, SENML_LABEL_V);
+	len += cbor_writer.put_float32fix(out, path, value);
+
+	return len;
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	size_t len;
+
+	len = put_record(out, path, SENML_LABEL_V);
+	len += cbor_writer.put_float64fix(out, path, value);
+
+	return len;
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	size_t len;
+
+	len = put_record(out, path, SENML_LABEL_VB);
+	len += cbor_writer.put_bool(out, path, value);
+
+	return len;
+}
+
+const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+};
+
+int do_read_op_senml_cbor(struct lwm2m_engine_obj *obj,
+			  struct lwm2m_message *msg, int content_format)
+{
+	struct senml_cbor_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	/* save the level for output processing */
+	fd.path_level = msg->path.level;
+	ret = lwm2m_perform_read_op(obj, msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+/* Append the '/' separated IDs of a name to the path */
+static int parse_name(const char *name, struct lwm2m_obj_path *path)
+{
+	u32_t val;
+
+	while (*name) {
+		if (*name == '/') {
+			name++;
+			continue;
+		}
+
+		if (!isdigit((unsigned char)*name)) {
+			LOG_ERR("Error: illegal char '%c' in name", *name);
+			return -EINVAL;
+		}
+
+		for (val = 0U; isdigit((unsigned char)*name); name++) {
+			val = val * 10U + (*name - '0');
+			if (val > UINT16_MAX) {
+				return -EINVAL;
+			}
+		}
+
+		switch (path->level) {
+		case 0:
+			path->obj_id = val;
+			break;
+		case 1:
+			path->obj_inst_id = val;
+			break;
+		case 2:
+			path->res_id = val;
+			break;
+		case 3:
+			path->res_inst_id = val;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		path->level++;
+	}
+
+	return 0;
+}
+
+/* Walk a record, leaving the input at the start of its value */
+static int parse_record(struct lwm2m_input_context *in, char *base_name,
+			char *name, u16_t *value_offset)
+{
+	u8_t major, ai;
+	u64_t pairs;
+	s64_t label;
+	int ret;
+
+	ret = cbor_get_head(in, &major, &ai, &pairs);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major != CBOR_MAJOR_MAP || ai == CBOR_AI_INDEFINITE) {
+		return -EINVAL;
+	}
+
+	*value_offset = 0U;
+
+	while (pairs--) {
+		/* only the integer labels of SenML-CBOR are understood */
+		ret = cbor_get_int(in, &label);
+		if (ret < 0) {
+			return ret;
+		}
+
+		switch (label) {
+		case SENML_LABEL_BN:
+			if (!cbor_reader.get_string(in, (u8_t *)base_name,
+						    MAX_RESOURCE_LEN)) {
+				return -EINVAL;
+			}
+			break;
+
+		case SENML_LABEL_N:
+			if (!cbor_reader.get_string(in, (u8_t *)name,
+						    MAX_RESOURCE_LEN)) {
+				return -EINVAL;
+			}
+			break;
+
+		case SENML_LABEL_V:
+		case SENML_LABEL_VS:
+		case SENML_LABEL_VB:
+		case SENML_LABEL_VD:
+			*value_offset = in->offset;
+			/* fallthrough */
+
+		default:
+			ret = cbor_get_skip(in);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int do_write_op_senml_cbor(struct lwm2m_engine_obj *obj,
+			   struct lwm2m_message *msg)
+{
+	struct lwm2m_engine_obj_field *obj_field = NULL;
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res_inst *res;
+	struct lwm2m_obj_path orig_path;
+	char base_name[MAX_RESOURCE_LEN];
+	char name[MAX_RESOURCE_LEN];
+	u16_t value_offset, end_offset;
+	u64_t records;
+	u8_t major, ai;
+	u8_t created;
+	int ret, index;
+
+	/* store a copy of the original path */
+	memcpy(&orig_path, &msg->path, sizeof(msg->path));
+
+	ret = cbor_get_head(&msg->in, &major, &ai, &records);
+	if (ret < 0 || major != CBOR_MAJOR_ARRAY) {
+		LOG_ERR("Error parsing SenML pack!");
+		return -EINVAL;
+	}
+
+	base_name[0] = '\0';
+
+	while (ai == CBOR_AI_INDEFINITE || records--) {
+		if (ai == CBOR_AI_INDEFINITE) {
+			if (msg->in.offset >= msg->in.in_cpkt->offset) {
+				ret = -EINVAL;
+				break;
+			}
+
+			if (msg->in.in_cpkt->data[msg->in.offset] ==
+			    CBOR_BREAK) {
+				break;
+			}
+		}
+
+		/* the name is relative to the last base name */
+		name[0] = '\0';
+
+		ret = parse_record(&msg->in, base_name, name, &value_offset);
+		if (ret < 0) {
+			LOG_ERR("Error parsing SenML record!");
+			break;
+		}
+
+		if (value_offset == 0U) {
+			continue;
+		}
+
+		(void)memset(&msg->path, 0, sizeof(msg->path));
+		ret = parse_name(base_name, &msg->path);
+		if (ret == 0) {
+			ret = parse_name(name, &msg->path);
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		created = 0U;
+		ret = lwm2m_get_or_create_engine_obj(msg, &obj_inst, &created);
+		if (ret < 0) {
+			break;
+		}
+
+		obj_field = lwm2m_get_engine_obj_field(obj, msg->path.res_id);
+		/*
+		 * if obj_field is not found,
+		 * treat as an optional resource
+		 */
+		if (!obj_field) {
+			ret = -ENOENT;
+			break;
+		}
+
+		if (!LWM2M_HAS_PERM(obj_field, LWM2M_PERM_W)) {
+			ret = -EPERM;
+			break;
+		}
+
+		if (!obj_inst->resources || obj_inst->resource_count == 0U) {
+			ret = -EINVAL;
+			break;
+		}
+
+		res = NULL;
+		for (index = 0; index < obj_inst->resource_count; index++) {
+			if (obj_inst->resources[index].res_id ==
+			    msg->path.res_id) {
+				res = &obj_inst->resources[index];
+				break;
+			}
+		}
+
+		if (!res) {
+			ret = -ENOENT;
+			break;
+		}
+
+		/* decode the value in place, then move to the next record */
+		end_offset = msg->in.offset;
+		msg->in.offset = value_offset;
+		ret = lwm2m_write_handler(obj_inst, res, obj_field, msg);
+		msg->in.offset = end_offset;
+
+		if (orig_path.level == 3U && ret < 0) {
+			/* return errors on a single write */
+			break;
+		}
+	}
+
+	return ret;
+}
@@ -25,6 +25,8 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+	mqtt_topic_alias_reset(client, 0U);
 }
 
 /** @brief Initialize tx buffer. */
@@ -35,6 +37,17 @@ static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 	buf->end = client->tx_buf + client->tx_buf_size;
 }
 
+static int client_publish_encode(struct mqtt_client *client,
+				 const struct mqtt_publish_param *param,
+				 struct buf_ctx *buf)
+{
+	if (MQTT_IS_VERSION_5(client)) {
+		return publish_encode_v5(client, param, buf);
+	}
+
+	return publish_encode(param, buf);
+}
+
 /**@brief Notifies disconnection event to the application.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -157,6 +170,234 @@ static int client_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+static int client_write_msg(struct mqtt_client *client,
+			    struct msghdr *message)
+{
+	int err_code;
+
+	MQTT_TRC("[%p]: Transport writing message.", client);
+
+	err_code = mqtt_transport_write_msg(client, message);
+	if (err_code < 0) {
+		MQTT_TRC("TCP write failed, errno = %d, "
+			 "closing connection", errno);
+		client_disconnect(client, err_code);
+		return err_code;
+	}
+
+	MQTT_TRC("[%p]: Transport write complete.", client);
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+/** @brief Publish header from tx buffer, payload from the application. */
+static void publish_msg_init(struct buf_ctx *packet,
+			     const struct mqtt_publish_param *param,
+			     struct iovec io_vector[2], struct msghdr *msg)
+{
+	io_vector[0].iov_base = packet->cur;
+	io_vector[0].iov_len = packet->end - packet->cur;
+	io_vector[1].iov_base = param->message.payload.data;
+	io_vector[1].iov_len = param->message.payload.len;
+
+	memset(msg, 0, sizeof(*msg));
+	msg->msg_iov = io_vector;
+	msg->msg_iovlen = 2;
+}
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0
+enum mqtt_inflight_state {
+	MQTT_INFLIGHT_FREE,
+	MQTT_INFLIGHT_PUBLISHED,
+	MQTT_INFLIGHT_RELEASED,
+};
+
+static struct mqtt_inflight *inflight_find(struct mqtt_client *client,
+					   u16_t message_id)
+{
+	struct mqtt_inflight *entry;
+	int i;
+
+	for (i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW_SIZE; i++) {
+		entry = &client->internal.inflight[i];
+
+		if (entry->state != MQTT_INFLIGHT_FREE &&
+		    entry->param.message_id == message_id) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			struct mqtt_inflight **entry)
+{
+	int i;
+
+	*entry = NULL;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	if (inflight_find(client, param->message_id)) {
+		return -EBUSY;
+	}
+
+	for (i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW_SIZE; i++) {
+		if (client->internal.inflight[i].state == MQTT_INFLIGHT_FREE) {
+			*entry = &client->internal.inflight[i];
+			(*entry)->param = *param;
+			(*entry)->state = MQTT_INFLIGHT_PUBLISHED;
+			return 0;
+		}
+	}
+
+	return -EAGAIN;
+}
+
+static void inflight_free(struct mqtt_inflight *entry)
+{
+	if (entry) {
+		entry->state = MQTT_INFLIGHT_FREE;
+	}
+}
+
+static bool inflight_is_released(struct mqtt_client *client,
+				 u16_t message_id)
+{
+	struct mqtt_inflight *entry = inflight_find(client, message_id);
+
+	return entry && entry->state == MQTT_INFLIGHT_RELEASED;
+}
+
+void mqtt_inflight_complete(struct mqtt_client *client, u16_t message_id)
+{
+	inflight_free(inflight_find(client, message_id));
+}
+
+static int inflight_write_release(struct mqtt_client *client,
+				  u16_t message_id)
+{
+	const struct mqtt_pubrel_param param = {
+		.message_id = message_id,
+	};
+	struct buf_ctx packet;
+	int err_code;
+
+	tx_buf_init(client, &packet);
+
+	err_code = publish_release_encode(&param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return mqtt_transport_write(client, packet.cur,
+				    packet.end - packet.cur);
+}
+
+static int inflight_write_publish(struct mqtt_client *client,
+				  const struct mqtt_publish_param *param)
+{
+	struct iovec io_vector[2];
+	struct buf_ctx packet;
+	struct msghdr msg;
+	int err_code;
+
+	tx_buf_init(client, &packet);
+
+	err_code = client_publish_encode(client, param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	publish_msg_init(&packet, param, io_vector, &msg);
+
+	return mqtt_transport_write_msg(client, &msg);
+}
+
+int mqtt_inflight_release(struct mqtt_client *client, u16_t message_id)
+{
+	struct mqtt_inflight *entry = inflight_find(client, message_id);
+	int err_code;
+
+	if (!entry || entry->param.message.topic.qos !=
+					MQTT_QOS_2_EXACTLY_ONCE) {
+		return 0;
+	}
+
+	err_code = inflight_write_release(client, message_id);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	entry->state = MQTT_INFLIGHT_RELEASED;
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+int mqtt_inflight_resend(struct mqtt_client *client, bool session_present)
+{
+	struct mqtt_inflight *entry;
+	int err_code = 0;
+	int i;
+
+	for (i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW_SIZE; i++) {
+		entry = &client->internal.inflight[i];
+
+		if (entry->state == MQTT_INFLIGHT_RELEASED) {
+			/* A new session has no state left to release. */
+			if (!session_present) {
+				inflight_free(entry);
+				continue;
+			}
+
+			err_code = inflight_write_release(
+					client, entry->param.message_id);
+		} else if (entry->state == MQTT_INFLIGHT_PUBLISHED) {
+			entry->param.dup_flag = 1U;
+			err_code = inflight_write_publish(client,
+							  &entry->param);
+		} else {
+			continue;
+		}
+
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		MQTT_TRC("[CID %p]: Message id 0x%04x retransmitted", client,
+			 entry->param.message_id);
+
+		client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+	}
+
+	return 0;
+}
+#else
+static inline int inflight_add(struct mqtt_client *client,
+			       const struct mqtt_publish_param *param,
+			       struct mqtt_inflight **entry)
+{
+	*entry = NULL;
+	return 0;
+}
+
+static inline void inflight_free(struct mqtt_inflight *entry)
+{
+}
+
+static inline bool inflight_is_released(struct mqtt_client *client,
+					u16_t message_id)
+{
+	return false;
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0 */
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -208,8 +449,11 @@ static int verify_tx_state(const struct mqtt_client *client)
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
-	int err_code;
+	struct mqtt_inflight *entry;
+	struct iovec io_vector[2];
 	struct buf_ctx packet;
+	struct msghdr msg;
+	int err_code;
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -228,18 +472,25 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
-	err_code = publish_encode(param, &packet);
+	err_code = inflight_add(client, param, &entry);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = client_write(client, packet.cur, packet.end - packet.cur);
+	/* Encoded last, as it may assign a topic alias. */
+	err_code = client_publish_encode(client, param, &packet);
 	if (err_code < 0) {
+		inflight_free(entry);
 		goto error;
 	}
 
-	err_code = client_write(client, param->message.payload.data,
-				param->message.payload.len);
+	publish_msg_init(&packet, param, io_vector, &msg);
+
+	err_code = client_write_msg(client, &msg);
+	if (err_code < 0) {
+		/* Not sent, so not retransmitted either. */
+		inflight_free(entry);
+	}
 
 error:
 	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -345,6 +596,11 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 		goto error;
 	}
 
+	/* Sent already on PUBREC by the inflight window. */
+	if (inflight_is_released(client, param->message_id)) {
+		goto error;
+	}
+
 	err_code = publish_release_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -457,7 +713,12 @@ int mqtt_subscribe(struct mqtt_client *client,
 		goto error;
 	}
 
-	err_code = subscribe_encode(param, &packet);
+	if (MQTT_IS_VERSION_5(client)) {
+		err_code = subscribe_encode_v5(param, &packet);
+	} else {
+		err_code = subscribe_encode(param, &packet);
+	}
+
 	if (err_code < 0) {
 		goto error;
 	}
@@ -491,7 +752,12 @@ int mqtt_unsubscribe(struct mqtt_client *client,
 		goto error;
 	}
 
-	err_code = unsubscribe_encode(param, &packet);
+	if (MQTT_IS_VERSION_5(client)) {
+		err_code = unsubscribe_encode_v5(param, &packet);
+	} else {
+		err_code = unsubscribe_encode(param, &packet);
+	}
+
 	if (err_code < 0) {
 		goto error;
 	}
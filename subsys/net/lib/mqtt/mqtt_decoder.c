@@ -197,6 +197,139 @@ int fixed_header_decode(struct buf_ctx *buf, u8_t *type_and_flags,
 	return packet_length_decode(buf, length);
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**
+ * @brief Skips or decodes one MQTT 5.0 property.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position, limited to the properties.
+ * @param[out] connack CONNACK parameters updated by the properties the
+ *                     client uses, may be NULL.
+ *
+ * @retval 0 if the procedure is successful.
+ * @retval -EINVAL if the property is unknown or exceeds the buffer.
+ */
+static int property_decode(struct buf_ctx *buf,
+			   struct mqtt_connack_param *connack)
+{
+	struct mqtt_utf8 str;
+	u32_t length;
+	u16_t val16;
+	u8_t id;
+	int err_code;
+
+	err_code = unpack_uint8(buf, &id);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	switch (id) {
+	case 0x01: case 0x17: case 0x19: case 0x24: case 0x25: case 0x28:
+	case 0x29: case 0x2A:
+		/* Byte */
+		length = sizeof(u8_t);
+		break;
+
+	case 0x02: case 0x11: case 0x18: case 0x27:
+		/* Four Byte Integer */
+		length = sizeof(u32_t);
+		break;
+
+	case 0x13: case 0x21: case 0x23:
+		/* Two Byte Integer */
+		length = sizeof(u16_t);
+		break;
+
+	case MQTT_PROP_TOPIC_ALIAS_MAXIMUM:
+		err_code = unpack_uint16(buf, &val16);
+		if (err_code == 0 && connack != NULL) {
+			connack->topic_alias_maximum = val16;
+		}
+
+		return err_code;
+
+	case 0x0B:
+		/* Variable Byte Integer */
+		err_code = packet_length_decode(buf, &length);
+		return (err_code == -EAGAIN) ? -EINVAL : err_code;
+
+	case 0x26:
+		/* UTF-8 String Pair */
+		err_code = unpack_utf8_str(buf, &str);
+		if (err_code != 0) {
+			return err_code;
+		}
+
+		/* Fall through */
+	case 0x03: case 0x08: case 0x09: case 0x12: case 0x15: case 0x16:
+	case 0x1A: case 0x1C: case 0x1F:
+		/* UTF-8 String or Binary Data */
+		return unpack_utf8_str(buf, &str);
+
+	default:
+		MQTT_ERR("Unknown property 0x%02x", id);
+		return -EINVAL;
+	}
+
+	if ((buf->end - buf->cur) < length) {
+		return -EINVAL;
+	}
+
+	buf->cur += length;
+
+	return 0;
+}
+
+/**
+ * @brief Decodes the MQTT 5.0 properties of a packet, skipping those the
+ *        client does not use.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] connack CONNACK parameters updated by the properties, may be
+ *                     NULL.
+ * @param[out] prop_length Total size of the properties, with their length.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+static int properties_decode(struct buf_ctx *buf,
+			     struct mqtt_connack_param *connack,
+			     u32_t *prop_length)
+{
+	struct buf_ctx props;
+	u8_t *start = buf->cur;
+	u32_t length;
+	int err_code;
+
+	err_code = packet_length_decode(buf, &length);
+	if (err_code != 0) {
+		return (err_code == -EAGAIN) ? -EINVAL : err_code;
+	}
+
+	if ((buf->end - buf->cur) < length) {
+		return -EINVAL;
+	}
+
+	props.cur = buf->cur;
+	props.end = buf->cur + length;
+
+	while (props.cur < props.end) {
+		err_code = property_decode(&props, connack);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
+	buf->cur = props.end;
+
+	if (prop_length != NULL) {
+		*prop_length = buf->cur - start;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
 int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 		       struct mqtt_connack_param *param)
 {
@@ -213,7 +346,7 @@ int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 		return err_code;
 	}
 
-	if (client->protocol_version == MQTT_VERSION_3_1_1) {
+	if (client->protocol_version != MQTT_VERSION_3_1_0) {
 		param->session_present_flag =
 			flags & MQTT_CONNACK_FLAG_SESSION_PRESENT;
 
@@ -223,6 +356,14 @@ int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 
 	param->return_code = (enum mqtt_conn_return_code)ret_code;
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	param->topic_alias_maximum = 0U;
+
+	if (MQTT_IS_VERSION_5(client)) {
+		return properties_decode(buf, param, NULL);
+	}
+#endif
+
 	return 0;
 }
 
@@ -258,6 +399,33 @@ int publish_decode(u8_t flags, u32_t var_length, struct buf_ctx *buf,
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int publish_decode_v5(u8_t flags, u32_t var_length, struct buf_ctx *buf,
+		      struct mqtt_publish_param *param)
+{
+	u32_t prop_length;
+	int err_code;
+
+	err_code = publish_decode(flags, var_length, buf, param);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	err_code = properties_decode(buf, NULL, &prop_length);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	if (prop_length > param->message.payload.len) {
+		return -EINVAL;
+	}
+
+	param->message.payload.len -= prop_length;
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
 int publish_ack_decode(struct buf_ctx *buf, struct mqtt_puback_param *param)
 {
 	return unpack_uint16(buf, &param->message_id);
@@ -291,6 +459,38 @@ int subscribe_ack_decode(struct buf_ctx *buf, struct mqtt_suback_param *param)
 	return unpack_data(buf->end - buf->cur, buf, &param->return_codes);
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int subscribe_ack_decode_v5(struct buf_ctx *buf,
+			    struct mqtt_suback_param *param)
+{
+	int err_code;
+
+	err_code = unpack_uint16(buf, &param->message_id);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	err_code = properties_decode(buf, NULL, NULL);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	return unpack_data(buf->end - buf->cur, buf, &param->return_codes);
+}
+
+int ack_reason_code_decode(struct buf_ctx *buf)
+{
+	u8_t reason_code;
+
+	/* The Reason Code may be omitted when it is 0x00 (Success). */
+	if (unpack_uint8(buf, &reason_code) != 0) {
+		return 0;
+	}
+
+	return reason_code;
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param)
 {
@@ -291,10 +291,10 @@ int connect_request_encode(const struct mqtt_client *client,
 	int err_code;
 	u8_t *start;
 
-	if (client->protocol_version == MQTT_VERSION_3_1_1) {
-		mqtt_proto_desc = &mqtt_3_1_1_proto_desc;
-	} else {
+	if (client->protocol_version == MQTT_VERSION_3_1_0) {
 		mqtt_proto_desc = &mqtt_3_1_0_proto_desc;
+	} else {
+		mqtt_proto_desc = &mqtt_3_1_1_proto_desc;
 	}
 
 	/* Reserve space for fixed header. */
@@ -331,6 +331,14 @@ int connect_request_encode(const struct mqtt_client *client,
 		return err_code;
 	}
 
+	if (MQTT_IS_VERSION_5(client)) {
+		/* No CONNECT properties, the broker uses the defaults. */
+		err_code = pack_uint8(0, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
 	MQTT_TRC("Encoding Client Id. Str:%s Size:%08x.",
 		 client->client_id.utf8, client->client_id.size);
 	err_code = pack_utf8_str(&client->client_id, buf);
@@ -345,6 +353,14 @@ int connect_request_encode(const struct mqtt_client *client,
 		connect_flags |= ((client->will_topic->qos & 0x03) << 3);
 		connect_flags |= client->will_retain << 5;
 
+		if (MQTT_IS_VERSION_5(client)) {
+			/* No Will properties. */
+			err_code = pack_uint8(0, buf);
+			if (err_code != 0) {
+				return err_code;
+			}
+		}
+
 		MQTT_TRC("Encoding Will Topic. Str:%s Size:%08x.",
 			 client->will_topic->topic.utf8,
 			 client->will_topic->topic.size);
@@ -444,6 +460,131 @@ int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf)
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**
+ * @brief Finds the topic alias of a publish, or assigns a new one.
+ *
+ * @param[inout] client Client instance holding the alias table.
+ * @param[in] topic Topic of the publish.
+ * @param[out] alias Alias of the topic, 0 if the topic is sent in full
+ *                   without an alias.
+ *
+ * @return true if the alias is already known by the broker and the topic
+ *         may be left empty, false otherwise.
+ */
+static bool topic_alias_get(struct mqtt_client *client,
+			    const struct mqtt_utf8 *topic, u16_t *alias)
+{
+	u16_t max = MIN(client->internal.topic_alias_max,
+			CONFIG_MQTT_TOPIC_ALIAS_MAX);
+	struct mqtt_topic_alias *entry;
+	u16_t i;
+
+	*alias = 0U;
+
+	if (max == 0U || topic->size == 0U ||
+	    topic->size > CONFIG_MQTT_TOPIC_ALIAS_TOPIC_SIZE) {
+		return false;
+	}
+
+	for (i = 0U; i < max; i++) {
+		entry = &client->internal.topic_alias[i];
+
+		if (entry->size == topic->size &&
+		    memcmp(entry->topic, topic->utf8, topic->size) == 0) {
+			*alias = i + 1;
+			return true;
+		}
+	}
+
+	/* Not known, reuse the aliases in a round robin fashion. */
+	i = client->internal.topic_alias_next % max;
+	client->internal.topic_alias_next = (i + 1) % max;
+
+	entry = &client->internal.topic_alias[i];
+	memcpy(entry->topic, topic->utf8, topic->size);
+	entry->size = topic->size;
+
+	*alias = i + 1;
+
+	return false;
+}
+
+int publish_encode_v5(struct mqtt_client *client,
+		      const struct mqtt_publish_param *param,
+		      struct buf_ctx *buf)
+{
+	const u8_t message_type = MQTT_MESSAGES_OPTIONS(
+			MQTT_PKT_TYPE_PUBLISH, param->dup_flag,
+			param->message.topic.qos, param->retain_flag);
+	const struct mqtt_utf8 *topic = &param->message.topic.topic;
+	u16_t alias;
+	int err_code;
+	u8_t *start;
+
+	/* Message id zero is not permitted by spec. */
+	if ((param->message.topic.qos) && (param->message_id == 0U)) {
+		return -EINVAL;
+	}
+
+	/* Reserve space for fixed header. */
+	buf->cur += MQTT_FIXED_HEADER_MAX_SIZE;
+	start = buf->cur;
+
+	if (topic_alias_get(client, topic, &alias)) {
+		err_code = zero_len_str_encode(buf);
+	} else {
+		err_code = pack_utf8_str(topic, buf);
+	}
+
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	if (param->message.topic.qos) {
+		err_code = pack_uint16(param->message_id, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
+	if (alias != 0U) {
+		/* Property length, Topic Alias identifier and value. */
+		err_code = pack_uint8(sizeof(u8_t) + sizeof(u16_t), buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+
+		err_code = pack_uint8(MQTT_PROP_TOPIC_ALIAS, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+
+		err_code = pack_uint16(alias, buf);
+	} else {
+		err_code = pack_uint8(0, buf);
+	}
+
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	/* Do not copy payload. We move the buffer pointer to ensure that
+	 * message length in fixed header is encoded correctly.
+	 */
+	buf->cur += param->message.payload.len;
+
+	err_code = mqtt_encode_fixed_header(message_type, start, buf);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	buf->end -= param->message.payload.len;
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
 int publish_ack_encode(const struct mqtt_puback_param *param,
 		       struct buf_ctx *buf)
 {
@@ -492,8 +633,8 @@ int disconnect_encode(struct buf_ctx *buf)
 	return 0;
 }
 
-int subscribe_encode(const struct mqtt_subscription_list *param,
-		     struct buf_ctx *buf)
+static int subscribe_enc(const struct mqtt_subscription_list *param,
+			 bool v5, struct buf_ctx *buf)
 {
 	const u8_t message_type = MQTT_MESSAGES_OPTIONS(
 			MQTT_PKT_TYPE_SUBSCRIBE, 0, 1, 0);
@@ -514,6 +655,14 @@ int subscribe_encode(const struct mqtt_subscription_list *param,
 		return err_code;
 	}
 
+	if (v5) {
+		/* No SUBSCRIBE properties. */
+		err_code = pack_uint8(0, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
 	for (i = 0; i < param->list_count; i++) {
 		err_code = pack_utf8_str(&param->list[i].topic, buf);
 		if (err_code != 0) {
@@ -529,8 +678,22 @@ int subscribe_encode(const struct mqtt_subscription_list *param,
 	return mqtt_encode_fixed_header(message_type, start, buf);
 }
 
-int unsubscribe_encode(const struct mqtt_subscription_list *param,
-		       struct buf_ctx *buf)
+int subscribe_encode(const struct mqtt_subscription_list *param,
+		     struct buf_ctx *buf)
+{
+	return subscribe_enc(param, false, buf);
+}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int subscribe_encode_v5(const struct mqtt_subscription_list *param,
+			struct buf_ctx *buf)
+{
+	return subscribe_enc(param, true, buf);
+}
+#endif
+
+static int unsubscribe_enc(const struct mqtt_subscription_list *param,
+			   bool v5, struct buf_ctx *buf)
 {
 	const u8_t message_type = MQTT_MESSAGES_OPTIONS(
 		MQTT_PKT_TYPE_UNSUBSCRIBE, 0, MQTT_QOS_1_AT_LEAST_ONCE, 0);
@@ -546,6 +709,14 @@ int unsubscribe_encode(const struct mqtt_subscription_list *param,
 		return err_code;
 	}
 
+	if (v5) {
+		/* No UNSUBSCRIBE properties. */
+		err_code = pack_uint8(0, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
 	for (i = 0; i < param->list_count; i++) {
 		err_code = pack_utf8_str(&param->list[i].topic, buf);
 		if (err_code != 0) {
@@ -556,6 +727,20 @@ int unsubscribe_encode(const struct mqtt_subscription_list *param,
 	return mqtt_encode_fixed_header(message_type, start, buf);
 }
 
+int unsubscribe_encode(const struct mqtt_subscription_list *param,
+		       struct buf_ctx *buf)
+{
+	return unsubscribe_enc(param, false, buf);
+}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int unsubscribe_encode_v5(const struct mqtt_subscription_list *param,
+			  struct buf_ctx *buf)
+{
+	return unsubscribe_enc(param, true, buf);
+}
+#endif
+
 int ping_request_encode(struct buf_ctx *buf)
 {
 	if (buf->end - buf->cur < sizeof(ping_packet)) {
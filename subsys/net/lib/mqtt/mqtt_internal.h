@@ -64,6 +64,20 @@ extern "C" {
 
 #define MQTT_CONNACK_FLAG_SESSION_PRESENT 0x01
 
+/**@brief MQTT 5.0 property identifiers used by the client. */
+#define MQTT_PROP_TOPIC_ALIAS_MAXIMUM 0x22
+#define MQTT_PROP_TOPIC_ALIAS         0x23
+
+/**@brief First MQTT 5.0 reason code indicating a failure. */
+#define MQTT_REASON_CODE_FAILURE 0x80
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+#define MQTT_IS_VERSION_5(CLIENT) \
+	((CLIENT)->protocol_version == MQTT_VERSION_5_0)
+#else
+#define MQTT_IS_VERSION_5(CLIENT) false
+#endif
+
 /**@brief Maximum payload size of MQTT packet. */
 #define MQTT_MAX_PAYLOAD_SIZE 0x0FFFFFFF
 
@@ -161,6 +175,50 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0
+/**@brief Frees the inflight publish acknowledged by PUBACK or PUBCOMP.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] message_id Message id of the acknowledgment.
+ */
+void mqtt_inflight_complete(struct mqtt_client *client, u16_t message_id);
+
+/**@brief Sends PUBREL for the inflight publish acknowledged by PUBREC.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] message_id Message id of the acknowledgment.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_release(struct mqtt_client *client, u16_t message_id);
+
+/**@brief Retransmits the inflight publishes once connected again.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] session_present Whether the broker kept the session state.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_resend(struct mqtt_client *client, bool session_present);
+#else
+static inline void mqtt_inflight_complete(struct mqtt_client *client,
+					  u16_t message_id)
+{
+}
+
+static inline int mqtt_inflight_release(struct mqtt_client *client,
+					u16_t message_id)
+{
+	return 0;
+}
+
+static inline int mqtt_inflight_resend(struct mqtt_client *client,
+				       bool session_present)
+{
+	return 0;
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW_SIZE > 0 */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -190,6 +248,22 @@ int connect_request_encode(const struct mqtt_client *client,
  */
 int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf);
 
+/**@brief Constructs/encodes MQTT 5.0 Publish packet, replacing the topic by
+ *        an alias when the broker accepts them.
+ *
+ * @param[inout] client Client instance holding the topic aliases.
+ * @param[in] param Publish message parameters.
+ * @param[inout] buf_ctx Pointer to the buffer context structure,
+ *                       containing buffer for the encoded message.
+ *                       As output points to the beginning and end of
+ *                       the frame.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int publish_encode_v5(struct mqtt_client *client,
+		      const struct mqtt_publish_param *param,
+		      struct buf_ctx *buf);
+
 /**@brief Constructs/encodes Publish Ack packet.
  *
  * @param[in] param Publish Ack message parameters.
@@ -279,6 +353,28 @@ int subscribe_encode(const struct mqtt_subscription_list *param,
 int unsubscribe_encode(const struct mqtt_subscription_list *param,
 		       struct buf_ctx *buf);
 
+/**@brief Constructs/encodes MQTT 5.0 Subscribe packet, without properties.
+ *
+ * @param[in] param Subscribe message parameters.
+ * @param[inout] buf_ctx Pointer to the buffer context structure,
+ *                       containing buffer for the encoded message.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int subscribe_encode_v5(const struct mqtt_subscription_list *param,
+			struct buf_ctx *buf);
+
+/**@brief Constructs/encodes MQTT 5.0 Unsubscribe packet, without properties.
+ *
+ * @param[in] param Unsubscribe message parameters.
+ * @param[inout] buf_ctx Pointer to the buffer context structure,
+ *                       containing buffer for the encoded message.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int unsubscribe_encode_v5(const struct mqtt_subscription_list *param,
+			  struct buf_ctx *buf);
+
 /**@brief Constructs/encodes Ping Request packet.
  *
  * @param[inout] buf_ctx Pointer to the buffer context structure,
@@ -290,6 +386,18 @@ int unsubscribe_encode(const struct mqtt_subscription_list *param,
  */
 int ping_request_encode(struct buf_ctx *buf);
 
+/**@brief Decode MQTT Variable Byte Integer, as in the MQTT fixed header.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] length Decoded value.
+ *
+ * @retval 0 if the procedure is successful.
+ * @retval -EINVAL if the length decoding would use more that 4 bytes.
+ * @retval -EAGAIN if the buffer would be exceeded during the read.
+ */
+int packet_length_decode(struct buf_ctx *buf, u32_t *length);
+
 /**@brief Decode MQTT Packet Type and Length in the MQTT fixed header.
  *
  * @param[inout] buf A pointer to the buf_ctx structure containing current
@@ -327,6 +435,19 @@ int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 int publish_decode(u8_t flags, u32_t var_length, struct buf_ctx *buf,
 		   struct mqtt_publish_param *param);
 
+/**@brief Decode MQTT 5.0 Publish packet, skipping its properties.
+ *
+ * @param[in] flags Byte containing message type and flags.
+ * @param[in] var_length Length of the variable part of the message.
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] param Pointer to buffer for decoded Publish parameters.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int publish_decode_v5(u8_t flags, u32_t var_length, struct buf_ctx *buf,
+		      struct mqtt_publish_param *param);
+
 /**@brief Decode MQTT Publish Ack packet.
  *
  * @param[inout] buf A pointer to the buf_ctx structure containing current
@@ -381,6 +502,26 @@ int publish_complete_decode(struct buf_ctx *buf,
 int subscribe_ack_decode(struct buf_ctx *buf,
 			 struct mqtt_suback_param *param);
 
+/**@brief Decode MQTT 5.0 Subscribe packet, skipping its properties.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] param Pointer to buffer for decoded Subscribe parameters.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int subscribe_ack_decode_v5(struct buf_ctx *buf,
+			    struct mqtt_suback_param *param);
+
+/**@brief Decode the Reason Code of MQTT 5.0 publish acknowledgments.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position, after the message id.
+ *
+ * @return The Reason Code, 0 (Success) if it is omitted.
+ */
+int ack_reason_code_decode(struct buf_ctx *buf);
+
 /**@brief Decode MQTT Unsubscribe packet.
  *
  * @param[inout] buf A pointer to the buf_ctx structure containing current
@@ -392,6 +533,27 @@ int subscribe_ack_decode(struct buf_ctx *buf,
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param);
 
+/**@brief Forgets the topic aliases of outgoing publishes, as done for every
+ *        new network connection.
+ *
+ * @param[inout] client Client instance.
+ * @param[in] max Topic Alias Maximum of the broker.
+ */
+static inline void mqtt_topic_alias_reset(struct mqtt_client *client,
+					  u16_t max)
+{
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	int i;
+
+	client->internal.topic_alias_max = max;
+	client->internal.topic_alias_next = 0U;
+
+	for (i = 0; i < CONFIG_MQTT_TOPIC_ALIAS_MAX; i++) {
+		client->internal.topic_alias[i].size = 0U;
+	}
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,14 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+				mqtt_topic_alias_reset(client,
+					evt.param.connack.topic_alias_maximum);
+#endif
+
+				err_code = mqtt_inflight_resend(client,
+					evt.param.connack.session_present_flag);
 			}
 
 			evt.result = evt.param.connack.return_code;
@@ -55,8 +63,14 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		MQTT_TRC("[CID %p]: Received MQTT_PKT_TYPE_PUBLISH", client);
 
 		evt.type = MQTT_EVT_PUBLISH;
-		err_code = publish_decode(type_and_flags, var_length, buf,
-					  &evt.param.publish);
+		if (MQTT_IS_VERSION_5(client)) {
+			err_code = publish_decode_v5(type_and_flags, var_length,
+						     buf, &evt.param.publish);
+		} else {
+			err_code = publish_decode(type_and_flags, var_length,
+						  buf, &evt.param.publish);
+		}
+
 		evt.result = err_code;
 
 		client->internal.remaining_payload =
@@ -75,6 +89,15 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+		if (err_code == 0 && MQTT_IS_VERSION_5(client)) {
+			evt.result = ack_reason_code_decode(buf);
+		}
+
+		if (err_code == 0) {
+			mqtt_inflight_complete(client,
+					       evt.param.puback.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -83,6 +106,16 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBREC;
 		err_code = publish_receive_decode(buf, &evt.param.pubrec);
 		evt.result = err_code;
+
+		if (err_code == 0 && MQTT_IS_VERSION_5(client)) {
+			evt.result = ack_reason_code_decode(buf);
+		}
+
+		/* Failure reason codes end the QoS 2 flow, no PUBREL. */
+		if (err_code == 0 && evt.result < MQTT_REASON_CODE_FAILURE) {
+			err_code = mqtt_inflight_release(client,
+						evt.param.pubrec.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -99,13 +132,28 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+		if (err_code == 0 && MQTT_IS_VERSION_5(client)) {
+			evt.result = ack_reason_code_decode(buf);
+		}
+
+		if (err_code == 0) {
+			mqtt_inflight_complete(client,
+					       evt.param.pubcomp.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
 		MQTT_TRC("[CID %p]: Received MQTT_PKT_TYPE_SUBACK!", client);
 
 		evt.type = MQTT_EVT_SUBACK;
-		err_code = subscribe_ack_decode(buf, &evt.param.suback);
+		if (MQTT_IS_VERSION_5(client)) {
+			err_code = subscribe_ack_decode_v5(buf,
+							   &evt.param.suback);
+		} else {
+			err_code = subscribe_ack_decode(buf, &evt.param.suback);
+		}
+
 		evt.result = err_code;
 		break;
 
@@ -180,6 +228,40 @@ static int mqtt_read_message_chunk(struct mqtt_client *client,
 	return 0;
 }
 
+static int mqtt_read_publish_properties(struct mqtt_client *client,
+					struct buf_ctx *buf,
+					u32_t variable_header_length)
+{
+	struct buf_ctx props;
+	u32_t prop_length;
+	u32_t chunk_size = variable_header_length + 1;
+	int err_code;
+
+	/* The property length is encoded on up to 4 bytes, read them one by
+	 * one, as done for the fixed header.
+	 */
+	do {
+		err_code = mqtt_read_message_chunk(client, buf, chunk_size);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		props.cur = buf->cur + variable_header_length;
+		props.end = buf->end;
+		chunk_size++;
+
+		err_code = packet_length_decode(&props, &prop_length);
+	} while (err_code == -EAGAIN);
+
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	/* Now we can read the whole header with the properties. */
+	return mqtt_read_message_chunk(client, buf,
+				       props.cur - buf->cur + prop_length);
+}
+
 static int mqtt_read_publish_var_header(struct mqtt_client *client,
 					u8_t type_and_flags,
 					struct buf_ctx *buf)
@@ -205,6 +287,11 @@ static int mqtt_read_publish_var_header(struct mqtt_client *client,
 		variable_header_length += sizeof(u16_t);
 	}
 
+	if (MQTT_IS_VERSION_5(client)) {
+		return mqtt_read_publish_properties(client, buf,
+						    variable_header_length);
+	}
+
 	/* Now we can read the whole header. */
 	err_code = mqtt_read_message_chunk(client, buf,
 					   variable_header_length);
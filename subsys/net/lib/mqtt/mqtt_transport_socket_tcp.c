@@ -81,6 +81,54 @@ int mqtt_client_tcp_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+/**@brief Handles write message requests on TCP socket transport.
+ *
+ * @param[in] client Identifies the client on which the procedure is requested.
+ * @param[in] message Buffers to be written on the transport.
+ *
+ * @retval 0 or an error code indicating reason for failure.
+ */
+int mqtt_client_tcp_write_msg(struct mqtt_client *client,
+			      struct msghdr *message)
+{
+	size_t offset = 0;
+	size_t total_len = 0;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < message->msg_iovlen; i++) {
+		total_len += message->msg_iov[i].iov_len;
+	}
+
+	while (offset < total_len) {
+		ret = sendmsg(client->transport.tcp.sock, message, 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		offset += ret;
+		if (offset >= total_len) {
+			break;
+		}
+
+		/* Skip what was sent for the next iteration. */
+		for (i = 0; i < message->msg_iovlen; i++) {
+			if ((size_t)ret < message->msg_iov[i].iov_len) {
+				message->msg_iov[i].iov_len -= ret;
+				message->msg_iov[i].iov_base =
+					(u8_t *)message->msg_iov[i].iov_base +
+					ret;
+				break;
+			}
+
+			ret -= message->msg_iov[i].iov_len;
+			message->msg_iov[i].iov_len = 0;
+		}
+	}
+
+	return 0;
+}
+
 /**@brief Handles read requests on TCP socket transport.
  *
  * @param[in] client Identifies the client on which the procedure is requested.
@@ -120,6 +120,34 @@ int mqtt_client_tls_write(struct mqtt_client *client, const u8_t *data,
 	return 0;
 }
 
+/**@brief Handles write message requests on TLS socket transport.
+ *
+ * @note TLS sockets have no sendmsg, the buffers are written one after
+ *       the other.
+ *
+ * @param[in] client Identifies the client on which the procedure is requested.
+ * @param[in] message Buffers to be written on the transport.
+ *
+ * @retval 0 or an error code indicating reason for failure.
+ */
+int mqtt_client_tls_write_msg(struct mqtt_client *client,
+			      struct msghdr *message)
+{
+	size_t i;
+	int ret;
+
+	for (i = 0; i < message->msg_iovlen; i++) {
+		ret = mqtt_client_tls_write(client,
+					    message->msg_iov[i].iov_base,
+					    message->msg_iov[i].iov_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 /**@brief Handles read requests on TLS socket transport.
  *
  * @param[in] client Identifies the client on which the procedure is requested.
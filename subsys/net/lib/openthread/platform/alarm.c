@@ -17,6 +17,11 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <openthread/platform/alarm-milli.h>
 #include <openthread-system.h>
 
+#if defined(CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER)
+#include <counter.h>
+#include <openthread/platform/alarm-micro.h>
+#endif
+
 #include <stdio.h>
 
 #include "platform-zephyr.h"
@@ -33,10 +38,139 @@ static void ot_timer_fired(struct k_timer *timer)
 
 K_TIMER_DEFINE(ot_timer, ot_timer_fired, NULL);
 
+#if defined(CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER)
+#define USEC_TIMER_CHANNEL CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER_CHANNEL
+
+static struct device *usec_counter;
+static bool usec_timer_fired;
+static bool usec_timer_armed;
+static u32_t usec_timer_target;
+
+/* The counter is extended to 64 bits by accumulating the ticks elapsed
+ * since the previous reading, which happens at least at each alarm.
+ */
+static u64_t usec_ticks;
+static u32_t usec_last_read;
+
+static u64_t usec_now(void)
+{
+	unsigned int key = irq_lock();
+	u32_t top = counter_get_top_value(usec_counter);
+	u32_t cur = counter_read(usec_counter);
+	u32_t freq = counter_get_frequency(usec_counter);
+	u32_t elapsed;
+	u64_t ticks;
+
+	if (cur >= usec_last_read) {
+		elapsed = cur - usec_last_read;
+	} else {
+		elapsed = top - usec_last_read + cur + 1;
+	}
+
+	usec_last_read = cur;
+	usec_ticks += elapsed;
+	ticks = usec_ticks;
+
+	irq_unlock(key);
+
+	return (ticks / freq) * USEC_PER_SEC +
+	       (ticks % freq) * USEC_PER_SEC / freq;
+}
+
+static void usec_timer_arm(void);
+
+static void usec_timer_handler(struct device *dev, u8_t chan_id,
+			       u32_t ticks, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(chan_id);
+	ARG_UNUSED(ticks);
+	ARG_UNUSED(user_data);
+
+	/* Alarms beyond the counter range come back here early */
+	if ((s32_t)(usec_timer_target - (u32_t)usec_now()) > 0) {
+		usec_timer_arm();
+		return;
+	}
+
+	usec_timer_armed = false;
+	usec_timer_fired = true;
+	otSysEventSignalPending();
+}
+
+static void usec_timer_arm(void)
+{
+	s32_t delta = usec_timer_target - (u32_t)usec_now();
+	struct counter_alarm_cfg cfg = {
+		.callback = usec_timer_handler,
+		.absolute = false,
+	};
+
+	if (delta <= 0) {
+		usec_timer_armed = false;
+		usec_timer_fired = true;
+		otSysEventSignalPending();
+		return;
+	}
+
+	cfg.ticks = MIN(counter_us_to_ticks(usec_counter, delta),
+			counter_get_max_relative_alarm(usec_counter));
+	cfg.ticks = MAX(cfg.ticks, 1);
+
+	if (counter_set_channel_alarm(usec_counter, USEC_TIMER_CHANNEL,
+				      &cfg)) {
+		LOG_ERR("Cannot set the microsecond alarm");
+	}
+}
+
+uint32_t otPlatAlarmMicroGetNow(void)
+{
+	return (uint32_t)usec_now();
+}
+
+void otPlatAlarmMicroStartAt(otInstance *aInstance, uint32_t aT0,
+			     uint32_t aDt)
+{
+	ARG_UNUSED(aInstance);
+
+	if (usec_timer_armed) {
+		counter_cancel_channel_alarm(usec_counter, USEC_TIMER_CHANNEL);
+	}
+
+	usec_timer_target = aT0 + aDt;
+	usec_timer_armed = true;
+	usec_timer_arm();
+}
+
+void otPlatAlarmMicroStop(otInstance *aInstance)
+{
+	ARG_UNUSED(aInstance);
+
+	if (usec_timer_armed) {
+		counter_cancel_channel_alarm(usec_counter, USEC_TIMER_CHANNEL);
+		usec_timer_armed = false;
+	}
+
+	usec_timer_fired = false;
+}
+
+void platformAlarmInit(void)
+{
+	usec_counter =
+		device_get_binding(CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER_DEV);
+	__ASSERT(usec_counter, "Microsecond timer counter not found");
+	__ASSERT(counter_get_frequency(usec_counter),
+		 "Microsecond timer counter is not clock driven");
+
+	counter_start(usec_counter);
+	usec_last_read = counter_read(usec_counter);
+}
+#else
 void platformAlarmInit(void)
 {
 	/* Intentionally empty */
 }
+#endif /* CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER */
 
 uint32_t otPlatAlarmMilliGetNow(void)
 {
@@ -71,4 +205,11 @@ void platformAlarmProcess(otInstance *aInstance)
 		timer_fired = false;
 		otPlatAlarmMilliFired(aInstance);
 	}
+
+#if defined(CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER)
+	if (usec_timer_fired) {
+		usec_timer_fired = false;
+		otPlatAlarmMicroFired(aInstance);
+	}
+#endif
 }
@@ -96,6 +96,10 @@
  * implemented in platform.
  *
  */
+#if defined(CONFIG_OPENTHREAD_PLATFORM_USEC_TIMER)
+#define OPENTHREAD_CONFIG_ENABLE_PLATFORM_USEC_TIMER            1
+#else
 #define OPENTHREAD_CONFIG_ENABLE_PLATFORM_USEC_TIMER            0
+#endif
 
 #endif  /* OPENTHREAD_CORE_NRF52840_CONFIG_H_ */
@@ -17,6 +17,8 @@
 
 #include <openthread/instance.h>
 
+struct net_pkt;
+
 /**
  * This function initializes the alarm service used by OpenThread.
  *
@@ -45,6 +47,18 @@ void platformRadioInit(void);
  */
 void platformRadioProcess(otInstance *aInstance);
 
+/**
+ * This function passes the ACK received by the radio driver for the frame
+ * being transmitted.
+ *
+ * @param[in]  aPkt  The packet holding the ACK frame, FCS included.
+ *
+ * @retval 0        The ACK was stored for the transmit done callback.
+ * @retval -EINVAL  No frame is being transmitted or the ACK is too long.
+ *
+ */
+int platformRadioAckReceived(struct net_pkt *aPkt);
+
 /**
  * Get current channel from radio driver.
  *
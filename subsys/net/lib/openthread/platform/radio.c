@@ -17,6 +17,7 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
+#include <errno.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -43,6 +44,11 @@ static otRadioState sState = OT_RADIO_STATE_DISABLED;
 
 static otRadioFrame sTransmitFrame;
 
+/* ACK of the frame being transmitted, when the radio driver reports it */
+static otRadioFrame ack_frame;
+static u8_t ack_psdu[OT_RADIO_FRAME_MAX_SIZE];
+static bool ack_received;
+
 static struct net_pkt *tx_pkt;
 static struct net_buf *tx_payload;
 
@@ -98,6 +104,7 @@ void platformRadioProcess(otInstance *aInstance)
 		tx_payload->len = sTransmitFrame.mLength - FCS_SIZE;
 
 		channel = sTransmitFrame.mChannel;
+		ack_received = false;
 
 		radio_api->set_channel(radio_dev, sTransmitFrame.mChannel);
 		radio_api->set_txpower(radio_dev, tx_power);
@@ -123,10 +130,14 @@ void platformRadioProcess(otInstance *aInstance)
 		} else
 #endif
 		{
-			if (sTransmitFrame.mPsdu[0] & 0x20) {
+			if ((sTransmitFrame.mPsdu[0] & 0x20) &&
+			    ack_received) {
+				otPlatRadioTxDone(aInstance, &sTransmitFrame,
+					&ack_frame, result);
+			} else if (sTransmitFrame.mPsdu[0] & 0x20) {
 				/*
-				 * TODO: Get real ACK frame
-				 * instead of making a spoofed one
+				 * The radio driver did not report the ACK,
+				 * make a spoofed one.
 				 */
 				otRadioFrame ackFrame;
 				u8_t ackPsdu[] = {0x02, 0x00, 0x00, 0x00, 0x00};
@@ -147,6 +158,29 @@ void platformRadioProcess(otInstance *aInstance)
 	}
 }
 
+int platformRadioAckReceived(struct net_pkt *aPkt)
+{
+	size_t len = net_pkt_get_len(aPkt);
+
+	if (sState != OT_RADIO_STATE_TRANSMIT || len > sizeof(ack_psdu)) {
+		return -EINVAL;
+	}
+
+	if (net_pkt_read(aPkt, ack_psdu, len)) {
+		return -EINVAL;
+	}
+
+	ack_frame.mPsdu = ack_psdu;
+	ack_frame.mLength = len;
+	ack_frame.mChannel = channel;
+	ack_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(aPkt);
+	ack_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(aPkt);
+
+	ack_received = true;
+
+	return 0;
+}
+
 uint16_t platformRadioChannelGet(otInstance *aInstance)
 {
 	ARG_UNUSED(aInstance);
@@ -7,6 +7,9 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(net_socket_offload, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
+#include <errno.h>
+#include <string.h>
+#include <init.h>
 #include <net/socket_offload.h>
 
 /* Only one provider may register socket operations upon boot. */
@@ -34,3 +37,293 @@ int fcntl(int fd, int cmd, ...)
 
 	return res;
 }
+
+static ssize_t offload_send_buf(int sock, const void *buf, size_t len,
+				int flags, const struct msghdr *msg)
+{
+	if (msg->msg_name != NULL) {
+		__ASSERT_NO_MSG(socket_ops->sendto);
+
+		return socket_ops->sendto(sock, buf, len, flags,
+					  msg->msg_name, msg->msg_namelen);
+	}
+
+	__ASSERT_NO_MSG(socket_ops->send);
+
+	return socket_ops->send(sock, buf, len, flags);
+}
+
+static ssize_t sendmsg_each(int sock, const struct msghdr *msg, int flags)
+{
+	ssize_t total = 0;
+	ssize_t ret;
+	size_t i;
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len == 0) {
+			continue;
+		}
+
+		ret = offload_send_buf(sock, msg->msg_iov[i].iov_base,
+				       msg->msg_iov[i].iov_len, flags, msg);
+		if (ret < 0) {
+			return total > 0 ? total : ret;
+		}
+
+		total += ret;
+
+		if (ret < msg->msg_iov[i].iov_len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+#if CONFIG_NET_SOCKETS_OFFLOAD_BATCH_SIZE > 0
+static u8_t batch_buf[CONFIG_NET_SOCKETS_OFFLOAD_BATCH_SIZE];
+static K_MUTEX_DEFINE(batch_lock);
+
+static ssize_t sendmsg_batched(int sock, const struct msghdr *msg, int flags)
+{
+	size_t len = 0;
+	ssize_t ret;
+	size_t i;
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		len += msg->msg_iov[i].iov_len;
+	}
+
+	/* Splitting the message would not keep datagram boundaries, so a
+	 * message which does not fit is sent buffer by buffer as before.
+	 */
+	if (len > sizeof(batch_buf) || msg->msg_iovlen == 1) {
+		return sendmsg_each(sock, msg, flags);
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	len = 0;
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		memcpy(batch_buf + len, msg->msg_iov[i].iov_base,
+		       msg->msg_iov[i].iov_len);
+		len += msg->msg_iov[i].iov_len;
+	}
+
+	ret = offload_send_buf(sock, batch_buf, len, flags, msg);
+
+	k_mutex_unlock(&batch_lock);
+
+	return ret;
+}
+#else
+#define sendmsg_batched sendmsg_each
+#endif /* CONFIG_NET_SOCKETS_OFFLOAD_BATCH_SIZE > 0 */
+
+ssize_t socket_offload_sendmsg(int sock, const struct msghdr *msg, int flags)
+{
+	__ASSERT_NO_MSG(socket_ops);
+
+	if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (socket_ops->sendmsg) {
+		return socket_ops->sendmsg(sock, msg, flags);
+	}
+
+	return sendmsg_batched(sock, msg, flags);
+}
+
+#if defined(CONFIG_NET_SOCKETS_OFFLOAD_ASYNC)
+struct offload_async_op {
+	struct k_delayed_work work;
+	const struct msghdr *msg;
+	void *buf;
+	size_t len;
+	socket_offload_cb_t cb;
+	void *user_data;
+	int sock;
+	int flags;
+	bool recv;
+	bool in_use;
+};
+
+static K_THREAD_STACK_DEFINE(offload_async_stack,
+			     CONFIG_NET_SOCKETS_OFFLOAD_ASYNC_STACK_SIZE);
+static struct k_work_q offload_async_work_q;
+
+static struct offload_async_op
+	async_ops[CONFIG_NET_SOCKETS_OFFLOAD_ASYNC_MAX_OPS];
+static K_MUTEX_DEFINE(async_lock);
+
+static bool async_recv_ready(struct offload_async_op *op)
+{
+	struct pollfd fds = {
+		.fd = op->sock,
+		.events = POLLIN,
+	};
+
+	__ASSERT_NO_MSG(socket_ops->poll);
+
+	/* An error is reported by the recv() itself */
+	return socket_ops->poll(&fds, 1, 0) != 0;
+}
+
+static void async_op_handler(struct k_work *work)
+{
+	struct offload_async_op *op =
+		CONTAINER_OF(work, struct offload_async_op, work);
+	socket_offload_cb_t cb;
+	void *user_data;
+	ssize_t ret;
+	int sock;
+
+	if (op->recv) {
+		if (!async_recv_ready(op)) {
+			k_delayed_work_submit_to_queue(
+				&offload_async_work_q, &op->work,
+				K_MSEC(CONFIG_NET_SOCKETS_OFFLOAD_ASYNC_POLL_INTERVAL));
+			return;
+		}
+
+		__ASSERT_NO_MSG(socket_ops->recv);
+
+		ret = socket_ops->recv(op->sock, op->buf, op->len, op->flags);
+	} else {
+		ret = socket_offload_sendmsg(op->sock, op->msg, op->flags);
+	}
+
+	if (ret < 0) {
+		ret = -errno;
+	}
+
+	cb = op->cb;
+	user_data = op->user_data;
+	sock = op->sock;
+
+	/* Released first so that the callback can queue the next one */
+	k_mutex_lock(&async_lock, K_FOREVER);
+	op->in_use = false;
+	k_mutex_unlock(&async_lock);
+
+	cb(sock, ret, user_data);
+}
+
+static struct offload_async_op *async_op_alloc(int sock, int flags,
+					       socket_offload_cb_t cb,
+					       void *user_data)
+{
+	struct offload_async_op *op = NULL;
+	int i;
+
+	k_mutex_lock(&async_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(async_ops); i++) {
+		if (!async_ops[i].in_use) {
+			op = &async_ops[i];
+			op->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&async_lock);
+
+	if (op == NULL) {
+		return NULL;
+	}
+
+	op->sock = sock;
+	op->flags = flags;
+	op->cb = cb;
+	op->user_data = user_data;
+
+	return op;
+}
+
+int socket_offload_sendmsg_async(int sock, const struct msghdr *msg,
+				 int flags, socket_offload_cb_t cb,
+				 void *user_data)
+{
+	struct offload_async_op *op;
+
+	__ASSERT_NO_MSG(socket_ops);
+
+	if (msg == NULL || cb == NULL) {
+		return -EINVAL;
+	}
+
+	if (socket_ops->sendmsg_async) {
+		return socket_ops->sendmsg_async(sock, msg, flags, cb,
+						 user_data);
+	}
+
+	op = async_op_alloc(sock, flags, cb, user_data);
+	if (op == NULL) {
+		return -EAGAIN;
+	}
+
+	op->recv = false;
+	op->msg = msg;
+
+	/* One work queue keeps the sends of a socket in order */
+	k_delayed_work_submit_to_queue(&offload_async_work_q, &op->work,
+				       K_NO_WAIT);
+
+	return 0;
+}
+
+int socket_offload_recv_async(int sock, void *buf, size_t max_len,
+			      int flags, socket_offload_cb_t cb,
+			      void *user_data)
+{
+	struct offload_async_op *op;
+
+	__ASSERT_NO_MSG(socket_ops);
+
+	if (buf == NULL || cb == NULL) {
+		return -EINVAL;
+	}
+
+	if (socket_ops->recv_async) {
+		return socket_ops->recv_async(sock, buf, max_len, flags, cb,
+					      user_data);
+	}
+
+	op = async_op_alloc(sock, flags, cb, user_data);
+	if (op == NULL) {
+		return -EAGAIN;
+	}
+
+	op->recv = true;
+	op->buf = buf;
+	op->len = max_len;
+
+	k_delayed_work_submit_to_queue(&offload_async_work_q, &op->work,
+				       K_NO_WAIT);
+
+	return 0;
+}
+
+static int socket_offload_async_init(struct device *dev)
+{
+	int i;
+
+	ARG_UNUSED(dev);
+
+	for (i = 0; i < ARRAY_SIZE(async_ops); i++) {
+		k_delayed_work_init(&async_ops[i].work, async_op_handler);
+	}
+
+	k_work_q_start(&offload_async_work_q, offload_async_stack,
+		       K_THREAD_STACK_SIZEOF(offload_async_stack),
+		       K_PRIO_PREEMPT(CONFIG_NET_SOCKETS_OFFLOAD_ASYNC_PRIO));
+	k_thread_name_set(&offload_async_work_q.thread, "sock_offload");
+
+	return 0;
+}
+
+SYS_INIT(socket_offload_async_init, APPLICATION,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_NET_SOCKETS_OFFLOAD_ASYNC */
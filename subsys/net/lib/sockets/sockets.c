@@ -30,11 +30,14 @@ extern struct net_socket_register __net_socket_register_end[];
 #define VTABLE_CALL(fn, sock, ...) \
 	do { \
 		const struct socket_op_vtable *vtable; \
-		void *ctx = get_sock_vtable(sock, &vtable); \
+		void *ctx = get_sock_vtable_ref(sock, &vtable); \
+		ssize_t ret; \
 		if (ctx == NULL) { \
 			return -1; \
 		} \
-		return vtable->fn(ctx, __VA_ARGS__); \
+		ret = vtable->fn(ctx, __VA_ARGS__); \
+		z_put_fd_obj(sock); \
+		return ret; \
 	} while (0)
 
 const struct socket_op_vtable sock_fd_op_vtable;
@@ -46,6 +49,13 @@ static inline void *get_sock_vtable(
 				       (const struct fd_op_vtable **)vtable);
 }
 
+/* Same, keeping the fd from being reused until z_put_fd_obj() */
+static inline void *get_sock_vtable_ref(
+			int sock, const struct socket_op_vtable **vtable)
+{
+	return z_get_fd_obj_ref(sock, (const struct fd_op_vtable **)vtable);
+}
+
 static void zsock_received_cb(struct net_context *ctx,
 			      struct net_pkt *pkt,
 			      union net_ip_header *ip_hdr,
@@ -83,6 +93,311 @@ static void zsock_flush_queue(struct net_context *ctx)
 	k_fifo_cancel_wait(&ctx->recv_q);
 }
 
+#ifdef CONFIG_NET_SOCKETS_POLL_PERSISTENT
+/* Threads usually call poll() in a loop on the same sockets: keep the
+ * events of each such thread registered in a k_poll_set between calls,
+ * and only register them again when the set of events changes.
+ */
+struct zsock_poll_cache {
+	struct k_thread *owner;
+	struct k_poll_set set;
+	struct k_poll_event events[CONFIG_NET_SOCKETS_POLL_MAX];
+	int num_events;
+	/* pollfd array of the last call, set only if the fast path can
+	 * serve the next calls with the same array
+	 */
+	struct zsock_pollfd fds[CONFIG_NET_SOCKETS_POLL_MAX];
+	int nfds;
+	u32_t last_used;
+	bool busy;
+	bool stale;
+};
+
+static struct zsock_poll_cache
+	poll_cache[CONFIG_NET_SOCKETS_POLL_PERSISTENT_THREADS];
+static K_MUTEX_DEFINE(poll_cache_lock);
+
+static void poll_cache_detach(struct zsock_poll_cache *pc)
+{
+	for (int i = 0; i < pc->num_events; i++) {
+		k_poll_set_remove(&pc->set, &pc->events[i]);
+	}
+
+	pc->num_events = 0;
+	pc->nfds = 0;
+	pc->stale = false;
+}
+
+static bool poll_cache_matches(struct zsock_poll_cache *pc,
+			       struct k_poll_event *events, int num_events)
+{
+	if (pc->stale || pc->num_events != num_events) {
+		return false;
+	}
+
+	for (int i = 0; i < num_events; i++) {
+		if (pc->events[i].obj != events[i].obj ||
+		    pc->events[i].type != events[i].type) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Make the cached events mirror the ones poll() prepared */
+static void poll_cache_sync(struct zsock_poll_cache *pc,
+			    struct k_poll_event *events, int num_events)
+{
+	k_mutex_lock(&poll_cache_lock, K_FOREVER);
+
+	if (!poll_cache_matches(pc, events, num_events)) {
+		poll_cache_detach(pc);
+
+		for (int i = 0; i < num_events; i++) {
+			pc->events[i] = events[i];
+			pc->events[i].poller = NULL;
+			k_poll_set_add(&pc->set, &pc->events[i]);
+		}
+
+		pc->num_events = num_events;
+	}
+
+	k_mutex_unlock(&poll_cache_lock);
+}
+
+static struct zsock_poll_cache *poll_cache_get(void)
+{
+	struct k_thread *self = k_current_get();
+	struct zsock_poll_cache *pc, *victim = NULL;
+
+	k_mutex_lock(&poll_cache_lock, K_FOREVER);
+
+	for (pc = poll_cache; pc < poll_cache + ARRAY_SIZE(poll_cache); pc++) {
+		if (pc->owner == self) {
+			victim = pc;
+			break;
+		}
+
+		if (pc->busy) {
+			continue;
+		}
+
+		/* Prefer unused entries, then the least recently used one */
+		if (victim == NULL || pc->owner == NULL ||
+		    (victim->owner != NULL &&
+		     (s32_t)(pc->last_used - victim->last_used) < 0)) {
+			victim = pc;
+		}
+	}
+
+	if (victim == NULL) {
+		k_mutex_unlock(&poll_cache_lock);
+		return NULL;
+	}
+
+	pc = victim;
+
+	if (pc->owner != self) {
+		poll_cache_detach(pc);
+		k_poll_set_init(&pc->set);
+		pc->owner = self;
+	}
+
+	pc->busy = true;
+	pc->last_used = k_uptime_get_32();
+
+	k_mutex_unlock(&poll_cache_lock);
+
+	return pc;
+}
+
+static void poll_cache_put(struct zsock_poll_cache *pc)
+{
+	k_mutex_lock(&poll_cache_lock, K_FOREVER);
+
+	pc->busy = false;
+	if (pc->stale) {
+		poll_cache_detach(pc);
+	}
+
+	k_mutex_unlock(&poll_cache_lock);
+}
+
+/* A closed socket may be referenced by any entry.  Closing is rare next to
+ * polling, so simply drop everything; entries in use are dropped by their
+ * owner once its poll() returns.
+ */
+static void poll_cache_flush(void)
+{
+	struct zsock_poll_cache *pc;
+
+	k_mutex_lock(&poll_cache_lock, K_FOREVER);
+
+	for (pc = poll_cache; pc < poll_cache + ARRAY_SIZE(poll_cache); pc++) {
+		if (pc->busy) {
+			pc->stale = true;
+		} else {
+			poll_cache_detach(pc);
+		}
+	}
+
+	k_mutex_unlock(&poll_cache_lock);
+}
+
+/* Only plain sockets polled for POLLIN, and not at EOF yet, can be served
+ * by the fast path: each of them has exactly one event, tagged with its
+ * index in the pollfd array, and becomes readable only when it fires.
+ */
+static bool poll_fd_is_fast(struct zsock_pollfd *pfd, int idx,
+			    const struct fd_op_vtable *vtable,
+			    int num_events)
+{
+	return idx <= UINT8_MAX && pfd->events == ZSOCK_POLLIN &&
+	       num_events == 1 &&
+	       vtable == (const struct fd_op_vtable *)&sock_fd_op_vtable;
+}
+
+/* Remember the pollfd array of a call, if the fast path can serve it */
+static void poll_cache_set_fds(struct zsock_poll_cache *pc,
+			       struct zsock_pollfd *fds, int nfds,
+			       struct k_poll_event *events, bool fast)
+{
+	int i;
+
+	k_mutex_lock(&poll_cache_lock, K_FOREVER);
+
+	pc->nfds = 0;
+
+	if (fast && !pc->stale && nfds > 0 && nfds <= ARRAY_SIZE(pc->fds)) {
+		for (i = 0; i < pc->num_events; i++) {
+			/* Opaque to the kernel, fine to set while
+			 * registered
+			 */
+			pc->events[i].tag = events[i].tag;
+		}
+
+		for (i = 0; i < nfds; i++) {
+			pc->fds[i].fd = fds[i].fd;
+			pc->fds[i].events = fds[i].events;
+		}
+
+		pc->nfds = nfds;
+	}
+
+	k_mutex_unlock(&poll_cache_lock);
+}
+
+static bool poll_cache_fds_match(struct zsock_poll_cache *pc,
+				 struct zsock_pollfd *fds, int nfds)
+{
+	int i;
+
+	if (pc->stale || pc->nfds == 0 || pc->nfds != nfds) {
+		return false;
+	}
+
+	for (i = 0; i < nfds; i++) {
+		if (pc->fds[i].fd != fds[i].fd ||
+		    pc->fds[i].events != fds[i].events) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Same pollfd array as last time: the registrations are already there,
+ * and only the sockets whose event fired are visited, without any fd
+ * table lookup.
+ */
+static int zsock_poll_fast(struct zsock_poll_cache *pc,
+			   struct zsock_pollfd *fds, int nfds, int timeout)
+{
+	struct k_poll_event *ready[CONFIG_NET_SOCKETS_POLL_MAX];
+	int num_ready, i;
+
+	for (i = 0; i < nfds; i++) {
+		fds[i].revents = 0;
+	}
+
+	num_ready = k_poll_set_wait(&pc->set, ready, ARRAY_SIZE(ready),
+				    timeout);
+	if (num_ready == -EAGAIN) {
+		return 0;
+	}
+
+	if (num_ready < 0) {
+		errno = -num_ready;
+		return -1;
+	}
+
+	for (i = 0; i < num_ready; i++) {
+		fds[ready[i]->tag].revents = ZSOCK_POLLIN;
+
+		/* The socket reached EOF: it stays readable without
+		 * event, leave it to the regular path from now on.
+		 */
+		if (ready[i]->state & K_POLL_STATE_CANCELLED) {
+			pc->nfds = 0;
+		}
+	}
+
+	return num_ready;
+}
+
+static int zsock_poll_wait(struct zsock_poll_cache *pc,
+			   struct k_poll_event *events, int num_events,
+			   int timeout)
+{
+	struct k_poll_event *ready[CONFIG_NET_SOCKETS_POLL_MAX];
+	int ret;
+
+	if (pc == NULL) {
+		return k_poll(events, num_events, timeout);
+	}
+
+	poll_cache_sync(pc, events, num_events);
+
+	ret = k_poll_set_wait(&pc->set, ready, ARRAY_SIZE(ready), timeout);
+
+	/* Update callbacks may modify the events, they only see a copy */
+	for (int i = 0; i < num_events; i++) {
+		events[i].state = pc->events[i].state;
+	}
+
+	return ret > 0 ? 0 : ret;
+}
+#else
+struct zsock_poll_cache;
+
+static inline int zsock_poll_wait(struct zsock_poll_cache *pc,
+				  struct k_poll_event *events,
+				  int num_events, int timeout)
+{
+	ARG_UNUSED(pc);
+
+	return k_poll(events, num_events, timeout);
+}
+
+static inline bool poll_fd_is_fast(struct zsock_pollfd *pfd, int idx,
+				   const struct fd_op_vtable *vtable,
+				   int num_events)
+{
+	return false;
+}
+
+static inline void poll_cache_set_fds(struct zsock_poll_cache *pc,
+				      struct zsock_pollfd *fds, int nfds,
+				      struct k_poll_event *events, bool fast)
+{
+}
+
+static inline void poll_cache_put(struct zsock_poll_cache *pc)
+{
+}
+#endif /* CONFIG_NET_SOCKETS_POLL_PERSISTENT */
+
 int zsock_socket_internal(int family, int type, int proto)
 {
 	int fd = z_reserve_fd();
@@ -201,7 +516,15 @@ int z_impl_zsock_close(int sock)
 
 	NET_DBG("close: ctx=%p, fd=%d", ctx, sock);
 
+#ifdef CONFIG_NET_SOCKETS_POLL_PERSISTENT
+	int ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_CLOSE);
+
+	poll_cache_flush();
+
+	return ret;
+#else
 	return z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_CLOSE);
+#endif
 }
 
 #ifdef CONFIG_USERSPACE
@@ -515,6 +838,36 @@ Z_SYSCALL_HANDLER(zsock_sendto, sock, buf, len, flags, dest_addr, addrlen)
 }
 #endif /* CONFIG_USERSPACE */
 
+ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
+			  int flags)
+{
+	s32_t timeout = K_FOREVER;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	status = net_context_sendmsg(ctx, msg, flags, NULL, timeout,
+				     ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	return status;
+}
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -617,16 +970,19 @@ error:
 }
 
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
+				       const struct iovec *iov,
+				       size_t iovlen,
 				       int flags,
 				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       socklen_t *addrlen,
+				       int *msg_flags)
 {
 	s32_t timeout = K_FOREVER;
 	size_t recv_len = 0;
+	size_t remaining;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	size_t i;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -677,14 +1033,22 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		}
 	}
 
-	recv_len = net_pkt_remaining_data(pkt);
-	if (recv_len > max_len) {
-		recv_len = max_len;
+	remaining = net_pkt_remaining_data(pkt);
+
+	for (i = 0; i < iovlen && remaining > 0; i++) {
+		size_t len = MIN(iov[i].iov_len, remaining);
+
+		if (net_pkt_read(pkt, iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
+		recv_len += len;
+		remaining -= len;
 	}
 
-	if (net_pkt_read(pkt, buf, recv_len)) {
-		errno = ENOBUFS;
-		return -1;
+	if (remaining > 0 && msg_flags) {
+		*msg_flags |= ZSOCK_MSG_TRUNC;
 	}
 
 	if (!(flags & ZSOCK_MSG_PEEK)) {
@@ -789,7 +1153,13 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	enum net_sock_type sock_type = net_context_get_type(ctx);
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		struct iovec iov = {
+			.iov_base = buf,
+			.iov_len = max_len,
+		};
+
+		return zsock_recv_dgram(ctx, &iov, 1, flags, src_addr, addrlen,
+					NULL);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -838,104 +1208,771 @@ Z_SYSCALL_HANDLER(zsock_recvfrom, sock, buf, max_len, flags, src_addr,
 }
 #endif /* CONFIG_USERSPACE */
 
-/* As this is limited function, we don't follow POSIX signature, with
- * "..." instead of last arg.
- */
-int z_impl_zsock_fcntl(int sock, int cmd, int flags)
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
 {
-	const struct fd_op_vtable *vtable;
-	void *obj;
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	ssize_t total = 0;
+	ssize_t ret;
+	size_t i;
 
-	obj = z_get_fd_obj_and_vtable(sock, &vtable);
-	if (obj == NULL) {
-		return -1;
+	msg->msg_flags = 0;
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg->msg_iov, msg->msg_iovlen,
+					flags, msg->msg_name,
+					msg->msg_name ? &msg->msg_namelen : NULL,
+					&msg->msg_flags);
+	} else if (sock_type != SOCK_STREAM) {
+		__ASSERT(0, "Unknown socket type");
+		return 0;
 	}
 
-	return z_fdtable_call_ioctl(vtable, obj, cmd, flags);
-}
+	/* Fill the buffers with the data already received once the first
+	 * one got some. Peeking past the first buffer would read the same
+	 * data again.
+	 */
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len == 0) {
+			continue;
+		}
 
-#ifdef CONFIG_USERSPACE
-Z_SYSCALL_HANDLER(zsock_fcntl, sock, cmd, flags)
-{
-	return z_impl_zsock_fcntl(sock, cmd, flags);
+		ret = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					msg->msg_iov[i].iov_len, flags);
+		if (ret < 0) {
+			return total > 0 ? total : ret;
+		}
+
+		total += ret;
+		if (ret < msg->msg_iov[i].iov_len || ret == 0 ||
+		    (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return total;
 }
-#endif
 
-static int zsock_poll_prepare_ctx(struct net_context *ctx,
-				  struct zsock_pollfd *pfd,
-				  struct k_poll_event **pev,
-				  struct k_poll_event *pev_end)
+static void *zsock_msg_lookup(int sock,
+			      const struct socket_op_vtable **vtable,
+			      bool send)
 {
-	if (pfd->events & ZSOCK_POLLIN) {
-		if (*pev == pev_end) {
-			errno = ENOMEM;
-			return -1;
-		}
+	void *ctx = get_sock_vtable(sock, vtable);
 
-		(*pev)->obj = &ctx->recv_q;
-		(*pev)->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
-		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
-		(*pev)->state = K_POLL_STATE_NOT_READY;
-		(*pev)++;
+	if (ctx == NULL) {
+		return NULL;
 	}
 
-	/* If socket is already in EOF, it can be reported
-	 * immediately, so we tell poll() to short-circuit wait.
-	 */
-	if (sock_is_eof(ctx)) {
-		errno = EALREADY;
-		return -1;
+	if ((send && (*vtable)->sendmsg == NULL) ||
+	    (!send && (*vtable)->recvmsg == NULL)) {
+		errno = ENOTSUP;
+		return NULL;
 	}
 
-	return 0;
+	return ctx;
 }
 
-static int zsock_poll_update_ctx(struct net_context *ctx,
-				 struct zsock_pollfd *pfd,
-				 struct k_poll_event **pev)
+/* Same, the reference must be dropped with z_put_fd_obj() on success */
+static void *zsock_msg_lookup_ref(int sock,
+				  const struct socket_op_vtable **vtable,
+				  bool send)
 {
-	ARG_UNUSED(ctx);
+	void *ctx = get_sock_vtable_ref(sock, vtable);
 
-	/* For now, assume that socket is always writable */
-	if (pfd->events & ZSOCK_POLLOUT) {
-		pfd->revents |= ZSOCK_POLLOUT;
+	if (ctx == NULL) {
+		return NULL;
 	}
 
-	if (pfd->events & ZSOCK_POLLIN) {
-		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
-			pfd->revents |= ZSOCK_POLLIN;
-		}
-		(*pev)++;
+	if ((send && (*vtable)->sendmsg == NULL) ||
+	    (!send && (*vtable)->recvmsg == NULL)) {
+		z_put_fd_obj(sock);
+		errno = ENOTSUP;
+		return NULL;
 	}
 
-	return 0;
+	return ctx;
 }
 
-static inline int time_left(u32_t start, u32_t timeout)
+ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 {
-	u32_t elapsed = k_uptime_get_32() - start;
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup_ref(sock, &vtable, true);
+	ssize_t ret;
 
-	return timeout - elapsed;
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	ret = vtable->sendmsg(ctx, msg, flags);
+	z_put_fd_obj(sock);
+
+	return ret;
 }
 
-int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 {
-	bool retry;
-	int ret = 0;
-	int i, remaining_time;
-	struct zsock_pollfd *pfd;
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup_ref(sock, &vtable, false);
+	ssize_t ret;
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	ret = vtable->recvmsg(ctx, msg, flags);
+	z_put_fd_obj(sock);
+
+	return ret;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup_ref(sock, &vtable, true);
+	unsigned int i;
+	ssize_t ret = 0;
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	z_put_fd_obj(sock);
+
+	return (i == 0 && ret < 0) ? -1 : i;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup_ref(sock, &vtable, false);
+	unsigned int i;
+	ssize_t ret = 0;
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->recvmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		/* Only wait for the first message */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	z_put_fd_obj(sock);
+
+	return (i == 0 && ret < 0) ? -1 : i;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Kernel copy of a user mode message */
+struct zsock_user_msg {
+	struct msghdr msg;
+	struct iovec iov[CONFIG_NET_SOCKETS_MSG_IOV_MAX];
+	struct sockaddr_storage addr;
+};
+
+static int user_msg_copy_in(struct zsock_user_msg *kmsg,
+			    const struct msghdr *umsg, bool write)
+{
+	size_t i;
+
+	if (z_user_from_copy(&kmsg->msg, (void *)umsg, sizeof(kmsg->msg))) {
+		return -EFAULT;
+	}
+
+	if (kmsg->msg.msg_iovlen > ARRAY_SIZE(kmsg->iov)) {
+		return -EMSGSIZE;
+	}
+
+	if (z_user_from_copy(kmsg->iov, kmsg->msg.msg_iov,
+			     kmsg->msg.msg_iovlen * sizeof(struct iovec))) {
+		return -EFAULT;
+	}
+
+	for (i = 0; i < kmsg->msg.msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY(kmsg->iov[i].iov_base,
+				     kmsg->iov[i].iov_len, write)) {
+			return -EFAULT;
+		}
+	}
+
+	kmsg->msg.msg_iov = kmsg->iov;
+	kmsg->msg.msg_control = NULL;
+	kmsg->msg.msg_controllen = 0;
+
+	if (kmsg->msg.msg_name) {
+		if (kmsg->msg.msg_namelen > sizeof(kmsg->addr)) {
+			return -EINVAL;
+		}
+
+		if (write) {
+			if (Z_SYSCALL_MEMORY_WRITE(kmsg->msg.msg_name,
+						   kmsg->msg.msg_namelen)) {
+				return -EFAULT;
+			}
+		} else if (z_user_from_copy(&kmsg->addr, kmsg->msg.msg_name,
+					    kmsg->msg.msg_namelen)) {
+			return -EFAULT;
+		}
+	}
+
+	return 0;
+}
+
+/* Send or receive a user mode message, through a socket already looked up */
+static ssize_t user_msg_call(void *ctx, const struct socket_op_vtable *vtable,
+			     struct msghdr *umsg, int flags, bool send,
+			     void *ssf)
+{
+	struct zsock_user_msg kmsg;
+	socklen_t unamelen;
+	void *uname;
+	ssize_t ret;
+
+	ret = user_msg_copy_in(&kmsg, umsg, !send);
+	Z_OOPS(ret == -EFAULT);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	uname = kmsg.msg.msg_name;
+	unamelen = kmsg.msg.msg_namelen;
+	if (uname) {
+		kmsg.msg.msg_name = &kmsg.addr;
+	}
+
+	if (send) {
+		return vtable->sendmsg(ctx, &kmsg.msg, flags);
+	}
+
+	ret = vtable->recvmsg(ctx, &kmsg.msg, flags);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (uname) {
+		Z_OOPS(z_user_to_copy(uname, &kmsg.addr,
+				      MIN(kmsg.msg.msg_namelen, unamelen)));
+		Z_OOPS(z_user_to_copy(&umsg->msg_namelen,
+				      &kmsg.msg.msg_namelen,
+				      sizeof(socklen_t)));
+	}
+
+	Z_OOPS(z_user_to_copy(&umsg->msg_flags, &kmsg.msg.msg_flags,
+			      sizeof(int)));
+
+	return ret;
+}
+
+static int user_mmsg_call(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags, bool send, void *ssf)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup(sock, &vtable, send);
+	unsigned int i;
+	ssize_t ret;
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct zsock_mmsghdr)));
+
+	for (i = 0; i < vlen; i++) {
+		ret = user_msg_call(ctx, vtable, &msgvec[i].msg_hdr, flags,
+				    send, ssf);
+		if (ret < 0) {
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (!send) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return i;
+}
+
+Z_SYSCALL_HANDLER(zsock_sendmsg, sock, msg, flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup(sock, &vtable, true);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	return user_msg_call(ctx, vtable, (struct msghdr *)msg, flags, true,
+			     ssf);
+}
+
+Z_SYSCALL_HANDLER(zsock_recvmsg, sock, msg, flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = zsock_msg_lookup(sock, &vtable, false);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(msg, sizeof(struct msghdr)));
+
+	return user_msg_call(ctx, vtable, (struct msghdr *)msg, flags, false,
+			     ssf);
+}
+
+Z_SYSCALL_HANDLER(zsock_sendmmsg, sock, msgvec, vlen, flags)
+{
+	return user_mmsg_call(sock, (struct zsock_mmsghdr *)msgvec, vlen,
+			      flags, true, ssf);
+}
+
+Z_SYSCALL_HANDLER(zsock_recvmmsg, sock, msgvec, vlen, flags)
+{
+	return user_mmsg_call(sock, (struct zsock_mmsghdr *)msgvec, vlen,
+			      flags, false, ssf);
+}
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* Packets whose data was handed out by zsock_recv_zc(), each holding a
+ * reference until released by the receiving thread.
+ */
+static struct zsock_zc_handle {
+	struct net_pkt *pkt;
+	k_tid_t owner;
+} zc_handles[CONFIG_NET_SOCKETS_ZEROCOPY_HANDLES];
+
+static struct k_spinlock zc_lock;
+
+static int zc_handle_alloc(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&zc_lock);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(zc_handles); i++) {
+		if (zc_handles[i].owner == NULL) {
+			zc_handles[i].owner = k_current_get();
+			zc_handles[i].pkt = NULL;
+			break;
+		}
+	}
+
+	k_spin_unlock(&zc_lock, key);
+
+	return i < ARRAY_SIZE(zc_handles) ? i : -1;
+}
+
+static void zc_handle_free(int idx)
+{
+	k_spinlock_key_t key = k_spin_lock(&zc_lock);
+
+	zc_handles[idx].pkt = NULL;
+	zc_handles[idx].owner = NULL;
+
+	k_spin_unlock(&zc_lock, key);
+}
+
+/* Describe the data from the packet cursor onwards, without moving it */
+static size_t zc_fill_segs(struct net_pkt *pkt, struct zsock_zc_seg *segs,
+			   int *nsegs)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+	u8_t *pos = pkt->cursor.pos;
+	size_t total = 0;
+	int n = 0;
+
+	while (buf && n < *nsegs) {
+		size_t len = buf->len - (pos - buf->data);
+
+		if (len) {
+			segs[n].data = pos;
+			segs[n].len = len;
+			total += len;
+			n++;
+		}
+
+		buf = buf->frags;
+		if (buf) {
+			pos = buf->data;
+		}
+	}
+
+	*nsegs = n;
+
+	return total;
+}
+
+static struct net_pkt *zc_recv_dgram(struct net_context *ctx,
+				     struct zsock_zc_seg *segs, int *nsegs,
+				     s32_t timeout, ssize_t *recv_len)
+{
+	struct net_pkt *pkt;
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		*recv_len = -EAGAIN;
+		return NULL;
+	}
+
+	/* Data not fitting in the segments is discarded, as with recv() */
+	*recv_len = zc_fill_segs(pkt, segs, nsegs);
+
+	return pkt;
+}
+
+static struct net_pkt *zc_recv_stream(struct net_context *ctx,
+				      struct zsock_zc_seg *segs, int *nsegs,
+				      s32_t timeout, ssize_t *recv_len)
+{
+	struct net_pkt *pkt;
+	size_t data_len;
+	size_t len;
+	int res;
+
+	do {
+		if (sock_is_eof(ctx)) {
+			*recv_len = 0;
+			*nsegs = 0;
+			return NULL;
+		}
+
+		res = k_fifo_wait_non_empty(&ctx->recv_q, timeout);
+		/* EAGAIN when timeout expired, EINTR when cancelled */
+		if (res && res != -EAGAIN && res != -EINTR) {
+			*recv_len = res;
+			return NULL;
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			*recv_len = sock_is_eof(ctx) ? 0 : -EAGAIN;
+			*nsegs = 0;
+			return NULL;
+		}
+
+		data_len = net_pkt_remaining_data(pkt);
+		len = zc_fill_segs(pkt, segs, nsegs);
+
+		if (len == data_len) {
+			/* The queue reference is handed over to the caller */
+			k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			if (len == 0) {
+				net_pkt_unref(pkt);
+				pkt = NULL;
+			}
+		} else {
+			/* The rest stays queued for the next call, the
+			 * caller gets a reference of its own.
+			 */
+			net_pkt_set_overwrite(pkt, true);
+			net_pkt_skip(pkt, len);
+			net_pkt_ref(pkt);
+		}
+	} while (len == 0);
+
+	net_context_update_recv_wnd(ctx, len);
+	*recv_len = len;
+
+	return pkt;
+}
+
+ssize_t z_impl_zsock_recv_zc(int sock, struct zsock_zc_seg *segs, int *nsegs,
+			     int flags, int *handle)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	s32_t timeout = K_FOREVER;
+	ssize_t recv_len;
+	int idx;
+
+	ctx = z_get_fd_obj(sock, (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			   ENOTSOCK);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (!sock_is_zerocopy(ctx) || (flags & ZSOCK_MSG_PEEK) ||
+	    *nsegs <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	/* Reserve the handle first, so that no data is lost for the lack
+	 * of one.
+	 */
+	idx = zc_handle_alloc();
+	if (idx < 0) {
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	switch (net_context_get_type(ctx)) {
+	case SOCK_DGRAM:
+		pkt = zc_recv_dgram(ctx, segs, nsegs, timeout, &recv_len);
+		break;
+	case SOCK_STREAM:
+		pkt = zc_recv_stream(ctx, segs, nsegs, timeout, &recv_len);
+		break;
+	default:
+		pkt = NULL;
+		recv_len = -ENOTSUP;
+		break;
+	}
+
+	if (!pkt) {
+		zc_handle_free(idx);
+
+		if (recv_len < 0) {
+			errno = -recv_len;
+			return -1;
+		}
+
+		*handle = 0;
+		return recv_len;
+	}
+
+	zc_handles[idx].pkt = pkt;
+	*handle = idx + 1;
+
+	return recv_len;
+}
+
+int z_impl_zsock_recv_zc_release(int handle)
+{
+	struct net_pkt *pkt = NULL;
+	k_spinlock_key_t key;
+
+	if (handle == 0) {
+		/* Nothing was returned */
+		return 0;
+	}
+
+	if (handle < 0 || handle > ARRAY_SIZE(zc_handles)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	key = k_spin_lock(&zc_lock);
+
+	if (zc_handles[handle - 1].owner == k_current_get()) {
+		pkt = zc_handles[handle - 1].pkt;
+		zc_handles[handle - 1].pkt = NULL;
+		zc_handles[handle - 1].owner = NULL;
+	}
+
+	k_spin_unlock(&zc_lock, key);
+
+	if (!pkt) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_recv_zc, sock, segs, nsegs, flags, handle)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_USER)
+	struct zsock_zc_seg segs_copy[CONFIG_NET_SOCKETS_ZEROCOPY_MAX_SEGS];
+	int nsegs_copy;
+	int handle_copy;
+	ssize_t ret;
+
+	Z_OOPS(z_user_from_copy(&nsegs_copy, (int *)nsegs, sizeof(int)));
+	if (nsegs_copy > ARRAY_SIZE(segs_copy)) {
+		nsegs_copy = ARRAY_SIZE(segs_copy);
+	}
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(segs, nsegs_copy,
+					    sizeof(struct zsock_zc_seg)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(handle, sizeof(int)));
+
+	ret = z_impl_zsock_recv_zc(sock, segs_copy, &nsegs_copy, flags,
+				   &handle_copy);
+	if (ret < 0) {
+		return ret;
+	}
+
+	Z_OOPS(z_user_to_copy((void *)segs, segs_copy,
+			      nsegs_copy * sizeof(struct zsock_zc_seg)));
+	Z_OOPS(z_user_to_copy((int *)nsegs, &nsegs_copy, sizeof(int)));
+	Z_OOPS(z_user_to_copy((int *)handle, &handle_copy, sizeof(int)));
+
+	return ret;
+#else
+	/* Network buffers are not readable from user mode */
+	errno = ENOTSUP;
+	return -1;
+#endif
+}
+
+Z_SYSCALL_HANDLER(zsock_recv_zc_release, handle)
+{
+	return z_impl_zsock_recv_zc_release(handle);
+}
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_USER)
+/* User threads may read the received data, but not change it under the
+ * feet of the stack.
+ */
+static int zc_partition_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	net_zc_partition.attr = K_MEM_PARTITION_P_RW_U_RO;
+
+	return 0;
+}
+
+SYS_INIT(zc_partition_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_USER */
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+/* As this is limited function, we don't follow POSIX signature, with
+ * "..." instead of last arg.
+ */
+int z_impl_zsock_fcntl(int sock, int cmd, int flags)
+{
+	const struct fd_op_vtable *vtable;
+	void *obj;
+
+	obj = z_get_fd_obj_and_vtable(sock, &vtable);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	return z_fdtable_call_ioctl(vtable, obj, cmd, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_fcntl, sock, cmd, flags)
+{
+	return z_impl_zsock_fcntl(sock, cmd, flags);
+}
+#endif
+
+static int zsock_poll_prepare_ctx(struct net_context *ctx,
+				  struct zsock_pollfd *pfd,
+				  struct k_poll_event **pev,
+				  struct k_poll_event *pev_end)
+{
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		(*pev)->obj = &ctx->recv_q;
+		(*pev)->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+	}
+
+	/* If socket is already in EOF, it can be reported
+	 * immediately, so we tell poll() to short-circuit wait.
+	 */
+	if (sock_is_eof(ctx)) {
+		errno = EALREADY;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int zsock_poll_update_ctx(struct net_context *ctx,
+				 struct zsock_pollfd *pfd,
+				 struct k_poll_event **pev)
+{
+	ARG_UNUSED(ctx);
+
+	/* For now, assume that socket is always writable */
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+
+	return 0;
+}
+
+static inline int time_left(u32_t start, u32_t timeout)
+{
+	u32_t elapsed = k_uptime_get_32() - start;
+
+	return timeout - elapsed;
+}
+
+int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
+{
+	bool retry;
+	int ret = 0;
+	int i, remaining_time;
+	struct zsock_pollfd *pfd;
 	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
 	struct k_poll_event *pev;
 	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
 	const struct fd_op_vtable *vtable;
+	struct zsock_poll_cache *pc = NULL;
 	u32_t entry_time = k_uptime_get_32();
+	bool fast = true;
 
 	if (timeout < 0) {
 		timeout = K_FOREVER;
 	}
 
+#ifdef CONFIG_NET_SOCKETS_POLL_PERSISTENT
+	pc = poll_cache_get();
+	if (pc != NULL && poll_cache_fds_match(pc, fds, nfds)) {
+		ret = zsock_poll_fast(pc, fds, nfds, timeout);
+		poll_cache_put(pc);
+		return ret;
+	}
+#endif
+
 	pev = poll_events;
 	for (pfd = fds, i = nfds; i--; pfd++) {
+		struct k_poll_event *pev_start = pev;
 		struct net_context *ctx;
 
 		/* Per POSIX, negative fd's are just ignored */
@@ -946,11 +1983,21 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 		ctx = z_get_fd_obj_and_vtable(pfd->fd, &vtable);
 		if (ctx == NULL) {
 			/* Will set POLLNVAL in return loop */
+			fast = false;
 			continue;
 		}
 
-		if (z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE,
-					 pfd, &pev, pev_end) < 0) {
+		ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE,
+					   pfd, &pev, pev_end);
+
+		if (ret == 0 && poll_fd_is_fast(pfd, pfd - fds, vtable,
+						pev - pev_start)) {
+			pev_start->tag = pfd - fds;
+		} else {
+			fast = false;
+		}
+
+		if (ret < 0) {
 			/* If POLL_PREPARE returned with EALREADY, it means
 			 * it already detected that some socket is ready. In
 			 * this case, we still perform a k_poll to pick up
@@ -963,18 +2010,21 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 				continue;
 			}
 
-			return -1;
+			ret = -1;
+			goto out;
 		}
 	}
 
 	remaining_time = timeout;
 
 	do {
-		ret = k_poll(poll_events, pev - poll_events, remaining_time);
+		ret = zsock_poll_wait(pc, poll_events, pev - poll_events,
+				      remaining_time);
 		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
 		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
 			errno = -ret;
-			return -1;
+			ret = -1;
+			goto out;
 		}
 
 		retry = false;
@@ -1004,12 +2054,21 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 					continue;
 				}
 
-				return -1;
+				ret = -1;
+				goto out;
 			}
 
 			if (pfd->revents != 0) {
 				ret++;
 			}
+
+			/* An EOF is only signalled once by the event */
+			if ((pfd->revents & ZSOCK_POLLIN) &&
+			    vtable == (const struct fd_op_vtable *)
+							&sock_fd_op_vtable &&
+			    sock_is_eof(ctx)) {
+				fast = false;
+			}
 		}
 
 		if (retry) {
@@ -1031,6 +2090,13 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 		}
 	} while (retry);
 
+out:
+	if (pc != NULL) {
+		poll_cache_set_fds(pc, fds, nfds, poll_events,
+				   fast && ret >= 0);
+		poll_cache_put(pc);
+	}
+
 	return ret;
 }
 
@@ -1124,6 +2190,18 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+		case SO_ZEROCOPY:
+			if (optlen != sizeof(int)) {
+				errno = EINVAL;
+				return -1;
+			}
+
+			sock_set_flag(ctx, SOCK_ZEROCOPY,
+				      *(const int *)optval ? SOCK_ZEROCOPY : 0);
+			return 0;
+#endif
 		}
 		break;
 
@@ -1357,6 +2435,17 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
+				  int flags)
+{
+	return zsock_sendmsg_ctx(obj, msg, flags);
+}
+
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -1384,4 +2473,6 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
+	.sendmsg = sock_sendmsg_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 };
@@ -26,6 +26,105 @@ extern const struct socket_op_vtable sock_fd_op_vtable;
 
 static const struct socket_op_vtable can_sock_fd_op_vtable;
 
+#if defined(CONFIG_NET_SOCKETS_CAN_FAST_PATH)
+/* Received frame queued to the recv_q of a socket in place of a net_pkt */
+struct can_rx_frame {
+	void *fifo_reserved;
+	struct zcan_frame frame;
+};
+
+K_MEM_SLAB_DEFINE(can_rx_frame_slab, sizeof(struct can_rx_frame),
+		  CONFIG_NET_SOCKETS_CAN_RX_FRAMES, 4);
+
+/* Hardware filters attached on behalf of sockets, ctx is NULL if free */
+static struct {
+	struct net_context *ctx;
+	struct device *dev;
+	int filter_id;
+} can_rx_filters[CONFIG_NET_SOCKETS_CAN_RX_FILTERS];
+
+static void zcan_rx_frame_cb(struct zcan_frame *frame, void *arg)
+{
+	struct net_context *ctx = arg;
+	struct can_rx_frame *rx;
+
+	/* Called from the CAN driver ISR, drop the frame if the pool is
+	 * exhausted as the application is not keeping up.
+	 */
+	if (k_mem_slab_alloc(&can_rx_frame_slab, (void **)&rx, K_NO_WAIT)) {
+		return;
+	}
+
+	memcpy(&rx->frame, frame, sizeof(rx->frame));
+
+	k_fifo_put(&ctx->recv_q, rx);
+}
+
+static int zcan_filter_attach(struct net_context *ctx,
+			      const struct zcan_filter *zfilter)
+{
+	const struct canbus_api *api;
+	struct device *dev;
+	int ret;
+	int i;
+
+	dev = net_if_get_device(net_context_get_iface(ctx));
+	api = dev->driver_api;
+
+	if (!api || !api->attach_isr) {
+		return -ENOTSUP;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(can_rx_filters); i++) {
+		if (!can_rx_filters[i].ctx) {
+			break;
+		}
+	}
+
+	if (i == ARRAY_SIZE(can_rx_filters)) {
+		return -ENOSPC;
+	}
+
+	ret = api->attach_isr(dev, zcan_rx_frame_cb, ctx, zfilter);
+	if (ret < 0) {
+		return ret;
+	}
+
+	can_rx_filters[i].ctx = ctx;
+	can_rx_filters[i].dev = dev;
+	can_rx_filters[i].filter_id = ret;
+
+	return 0;
+}
+
+static void zcan_filters_detach(struct net_context *ctx)
+{
+	struct can_rx_frame *rx;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(can_rx_filters); i++) {
+		const struct canbus_api *api;
+
+		if (can_rx_filters[i].ctx != ctx) {
+			continue;
+		}
+
+		api = can_rx_filters[i].dev->driver_api;
+		api->detach(can_rx_filters[i].dev,
+			    can_rx_filters[i].filter_id);
+
+		can_rx_filters[i].ctx = NULL;
+	}
+
+	/* Frames are not net_pkt, so release them before the generic close
+	 * flushes the queue.
+	 */
+	while ((rx = k_fifo_get(&ctx->recv_q, K_NO_WAIT)) != NULL) {
+		k_mem_slab_free(&can_rx_frame_slab, (void **)&rx);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_CAN_FAST_PATH */
+
 static inline int k_fifo_wait_non_empty(struct k_fifo *fifo, int32_t timeout)
 {
 	struct k_poll_event events[] = {
@@ -129,6 +228,13 @@ static int zcan_bind_ctx(struct net_context *ctx, const struct sockaddr *addr,
 		return -1;
 	}
 
+	/* With the fast path, frames are received once a filter is set and
+	 * not through the network stack.
+	 */
+	if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN_FAST_PATH)) {
+		return 0;
+	}
+
 	/* For CAN socket, we expect to receive packets after call to bind().
 	 */
 	ret = net_context_recv(ctx, zcan_received_cb, K_NO_WAIT,
@@ -178,6 +284,32 @@ ssize_t zcan_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 
 	can_copy_frame_to_zframe((struct can_frame *)buf, &zframe);
 
+#if defined(CONFIG_NET_SOCKETS_CAN_FAST_PATH)
+	{
+		struct net_if *iface = net_context_get_iface(ctx);
+		const struct canbus_api *api;
+		struct device *dev;
+
+		if (!iface) {
+			errno = EDESTADDRREQ;
+			return -1;
+		}
+
+		dev = net_if_get_device(iface);
+		api = dev->driver_api;
+
+		if (api && api->send_frame) {
+			ret = api->send_frame(dev, &zframe, timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return len;
+		}
+	}
+#endif /* CONFIG_NET_SOCKETS_CAN_FAST_PATH */
+
 	ret = net_context_sendto(ctx, (void *)&zframe, sizeof(zframe),
 				 dest_addr, addrlen, NULL, timeout,
 				 ctx->user_data);
@@ -223,6 +355,22 @@ static ssize_t zcan_recvfrom_ctx(struct net_context *ctx, void *buf,
 		return -1;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_CAN_FAST_PATH)
+	{
+		struct can_rx_frame *rx = (void *)pkt;
+
+		NET_ASSERT(max_len >= sizeof(struct can_frame));
+
+		can_copy_zframe_to_frame(&rx->frame, (struct can_frame *)buf);
+
+		if (!(flags & ZSOCK_MSG_PEEK)) {
+			k_mem_slab_free(&can_rx_frame_slab, (void **)&rx);
+		}
+
+		return sizeof(struct can_frame);
+	}
+#endif /* CONFIG_NET_SOCKETS_CAN_FAST_PATH */
+
 	/* We do not handle any headers here, just pass the whole packet to
 	 * the caller.
 	 */
@@ -281,6 +429,12 @@ static ssize_t can_sock_write_vmeth(void *obj, const void *buffer,
 
 static int can_sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_CAN_FAST_PATH)
+	if (request == ZFD_IOCTL_CLOSE) {
+		zcan_filters_detach(obj);
+	}
+#endif /* CONFIG_NET_SOCKETS_CAN_FAST_PATH */
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
@@ -387,6 +541,24 @@ static int can_sock_setsockopt_vmeth(void *obj, int level, int optname,
 		dev = net_if_get_device(iface);
 		api = dev->driver_api;
 
+#if defined(CONFIG_NET_SOCKETS_CAN_FAST_PATH)
+		if (optname == CAN_RAW_FILTER) {
+			struct zcan_filter zfilter;
+			int ret;
+
+			can_copy_filter_to_zfilter((struct can_filter *)optval,
+						   &zfilter);
+
+			ret = zcan_filter_attach(obj, &zfilter);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
+		}
+#endif /* CONFIG_NET_SOCKETS_CAN_FAST_PATH */
+
 		if (!api || !api->setsockopt) {
 			errno = ENOTSUP;
 			return -1;
@@ -11,6 +11,7 @@
 
 #define SOCK_EOF 1
 #define SOCK_NONBLOCK 2
+#define SOCK_ZEROCOPY 4
 
 static inline void sock_set_flag(struct net_context *ctx, u32_t mask,
 				 u32_t flag)
@@ -29,6 +30,7 @@ static inline u32_t sock_get_flag(struct net_context *ctx, u32_t mask)
 #define sock_is_eof(ctx) sock_get_flag(ctx, SOCK_EOF)
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
+#define sock_is_zerocopy(ctx) sock_get_flag(ctx, SOCK_ZEROCOPY)
 
 struct socket_op_vtable {
 	struct fd_op_vtable fd_vtable;
@@ -45,6 +47,9 @@ struct socket_op_vtable {
 			  void *optval, socklen_t *optlen);
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
+	/* Optional, sendmsg()/recvmsg() fail with ENOTSUP when not set */
+	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
 };
 
 #endif /* _SOCKETS_INTERNAL_H_ */
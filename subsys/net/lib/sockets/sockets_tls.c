@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <init.h>
 #include <entropy.h>
+#include <random/rand32.h>
 #include <misc/util.h>
 #include <net/net_context.h>
 #include <net/socket.h>
@@ -34,6 +35,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include <mbedtls/ssl_cache.h>
+#endif
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -116,6 +120,26 @@ struct tls_context {
 
 	/** DTLS peer address length. */
 	socklen_t dtls_peer_addrlen;
+
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+	/** Handshake run in the handshake work queue. */
+	struct k_work handshake_work;
+
+	/** Socket of the handshake. */
+	struct net_context *handshake_ctx;
+
+	/** Available unless a handshake is queued or running. */
+	struct k_sem handshake_idle;
+
+	/** Error of the last handshake run in the work queue. */
+	int handshake_err;
+
+	/** Information whether the handshake runs in the work queue. */
+	bool handshake_in_work_q;
+
+	/** Information whether the socket is closing. */
+	bool handshake_abort;
+#endif /* CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD */
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
 #if defined(CONFIG_MBEDTLS)
@@ -139,6 +163,47 @@ struct tls_context {
 #endif /* CONFIG_MBEDTLS */
 };
 
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+static K_THREAD_STACK_DEFINE(dtls_handshake_stack,
+			     CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_STACK_SIZE);
+static struct k_work_q dtls_handshake_work_q;
+
+static void dtls_handshake_work(struct k_work *work);
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+/* Longest hostname whose session is kept */
+#define TLS_SESSION_HOSTNAME_LEN 64
+
+/** A session established by a client, resumed by the next connection. */
+struct tls_session_entry {
+	/** Session ID or ticket, and master secret. */
+	mbedtls_ssl_session session;
+
+	/** Hostname of the server, empty if not set on the socket. */
+	char hostname[TLS_SESSION_HOSTNAME_LEN];
+
+	/** Address of the server, if no hostname was set. */
+	struct sockaddr peer;
+
+	/** Time of the last use, for replacement. */
+	u32_t last_used;
+
+	/** Information whether the entry is used. */
+	bool is_used;
+};
+
+static struct tls_session_entry
+	tls_sessions[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE];
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static mbedtls_ssl_cache_context tls_server_cache;
+#endif
+
+/* A mutex for protecting the session caches. */
+static struct k_mutex session_lock;
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 static mbedtls_ctr_drbg_context tls_ctr_drbg;
 
 /* A global pool of TLS contexts. */
@@ -174,7 +239,14 @@ static void tls_debug(void *ctx, int level, const char *file,
 }
 #endif /* defined(MBEDTLS_DEBUG_C) && (CONFIG_NET_SOCKETS_LOG_LEVEL >= LOG_LEVEL_DBG) */
 
-#if defined(CONFIG_ENTROPY_HAS_DRIVER)
+#if defined(CONFIG_CSPRNG_ENABLED)
+static int tls_entropy_func(void *ctx, unsigned char *buf, size_t len)
+{
+	ARG_UNUSED(ctx);
+
+	return sys_csrand_get(buf, len);
+}
+#elif defined(CONFIG_ENTROPY_HAS_DRIVER)
 static int tls_entropy_func(void *ctx, unsigned char *buf, size_t len)
 {
 	return entropy_get_entropy(ctx, buf, len);
@@ -275,6 +347,17 @@ static int tls_init(struct device *unused)
 
 	k_mutex_init(&context_lock);
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	k_mutex_init(&session_lock);
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_init(&tls_server_cache);
+	mbedtls_ssl_cache_set_max_entries(
+		&tls_server_cache,
+		CONFIG_NET_SOCKETS_TLS_SERVER_SESSION_CACHE_SIZE);
+#endif
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 	mbedtls_ctr_drbg_init(&tls_ctr_drbg);
 
 	ret = mbedtls_ctr_drbg_seed(&tls_ctr_drbg, tls_entropy_func, dev,
@@ -289,6 +372,13 @@ static int tls_init(struct device *unused)
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #endif
 
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+	k_work_q_start(&dtls_handshake_work_q, dtls_handshake_stack,
+		       K_THREAD_STACK_SIZEOF(dtls_handshake_stack),
+		       K_PRIO_PREEMPT(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_PRIO));
+	k_thread_name_set(&dtls_handshake_work_q.thread, "dtls_handshake");
+#endif
+
 	return 0;
 }
 
@@ -323,6 +413,10 @@ static struct tls_context *tls_alloc(void)
 
 	if (tls) {
 		k_sem_init(&tls->tls_established, 0, 1);
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+		k_sem_init(&tls->handshake_idle, 1, 1);
+		k_work_init(&tls->handshake_work, dtls_handshake_work);
+#endif
 
 		mbedtls_ssl_init(&tls->ssl);
 		mbedtls_ssl_config_init(&tls->config);
@@ -399,6 +493,193 @@ static int tls_release(struct tls_context *tls)
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+static bool tls_session_addr_cmp(const struct sockaddr *addr1,
+				 const struct sockaddr *addr2)
+{
+	if (addr1->sa_family != addr2->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr1->sa_family == AF_INET6) {
+		return (net_sin6(addr1)->sin6_port ==
+			net_sin6(addr2)->sin6_port) &&
+			net_ipv6_addr_cmp(&net_sin6(addr1)->sin6_addr,
+					  &net_sin6(addr2)->sin6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   addr1->sa_family == AF_INET) {
+		return (net_sin(addr1)->sin_port ==
+			net_sin(addr2)->sin_port) &&
+			net_ipv4_addr_cmp(&net_sin(addr1)->sin_addr,
+					  &net_sin(addr2)->sin_addr);
+	}
+
+	return false;
+}
+
+/* Address of the server a client connects to. */
+static const struct sockaddr *tls_session_peer(struct net_context *context)
+{
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
+	if (net_context_get_type(context) == SOCK_DGRAM) {
+		return &context->tls->dtls_peer_addr;
+	}
+#endif
+
+	return &context->remote;
+}
+
+static const char *tls_session_hostname(struct net_context *context)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (context->tls->options.is_hostname_set &&
+	    context->tls->ssl.hostname) {
+		return context->tls->ssl.hostname;
+	}
+#endif
+
+	return "";
+}
+
+/* Find the session of the server of the context, called locked. */
+static struct tls_session_entry *tls_session_find(struct net_context *context)
+{
+	const char *hostname = tls_session_hostname(context);
+	struct tls_session_entry *entry;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(tls_sessions); i++) {
+		entry = &tls_sessions[i];
+
+		if (!entry->is_used || strcmp(entry->hostname, hostname)) {
+			continue;
+		}
+
+		if (*hostname ||
+		    tls_session_addr_cmp(&entry->peer,
+					 tls_session_peer(context))) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Offer the session kept for the server, if any, in the Client Hello. */
+static void tls_session_restore(struct net_context *context)
+{
+	struct tls_session_entry *entry;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (entry) {
+		if (mbedtls_ssl_set_session(&context->tls->ssl,
+					    &entry->session) == 0) {
+			entry->last_used = k_uptime_get_32();
+
+			NET_DBG("Resuming TLS session for %p", context);
+		}
+	}
+
+	k_mutex_unlock(&session_lock);
+}
+
+/* Keep the session of a client once its handshake completed. */
+static void tls_session_save(struct net_context *context)
+{
+	const char *hostname = tls_session_hostname(context);
+	struct tls_session_entry *entry;
+	int i;
+
+	if (strlen(hostname) >= TLS_SESSION_HOSTNAME_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (!entry) {
+		entry = &tls_sessions[0];
+
+		for (i = 0; i < ARRAY_SIZE(tls_sessions); i++) {
+			if (!tls_sessions[i].is_used) {
+				entry = &tls_sessions[i];
+				break;
+			}
+
+			if ((s32_t)(tls_sessions[i].last_used -
+				    entry->last_used) < 0) {
+				entry = &tls_sessions[i];
+			}
+		}
+	}
+
+	if (entry->is_used) {
+		mbedtls_ssl_session_free(&entry->session);
+	}
+
+	mbedtls_ssl_session_init(&entry->session);
+
+	if (mbedtls_ssl_get_session(&context->tls->ssl,
+				    &entry->session) != 0) {
+		mbedtls_ssl_session_free(&entry->session);
+		entry->is_used = false;
+		goto out;
+	}
+
+	strcpy(entry->hostname, hostname);
+	memcpy(&entry->peer, tls_session_peer(context), sizeof(entry->peer));
+	entry->last_used = k_uptime_get_32();
+	entry->is_used = true;
+
+out:
+	k_mutex_unlock(&session_lock);
+}
+
+/* Forget the session of a server which refused the handshake. */
+static void tls_session_remove(struct net_context *context)
+{
+	struct tls_session_entry *entry;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (entry) {
+		mbedtls_ssl_session_free(&entry->session);
+		entry->is_used = false;
+	}
+
+	k_mutex_unlock(&session_lock);
+}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+/* The server cache is shared by the handshakes of all the threads. */
+static int tls_server_cache_get(void *data, mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_server_cache_set(void *data,
+				const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE */
+
 static inline int time_left(u32_t start, u32_t timeout)
 {
 	u32_t elapsed = k_uptime_get_32() - start;
@@ -475,11 +756,27 @@ static int dtls_tx(void *ctx, const unsigned char *buf, size_t len)
 	return sent;
 }
 
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+static inline bool dtls_handshake_in_work_q(struct net_context *context)
+{
+	return context->tls->handshake_in_work_q;
+}
+
+static inline bool dtls_handshake_aborted(struct net_context *context)
+{
+	return context->tls->handshake_abort;
+}
+#else
+#define dtls_handshake_in_work_q(...) false
+#define dtls_handshake_aborted(...) false
+#endif /* CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD */
+
 static int dtls_rx(void *ctx, unsigned char *buf, size_t len, uint32_t timeout)
 {
 	struct net_context *net_ctx = ctx;
 	bool is_block = !((net_ctx->tls->flags & ZSOCK_MSG_DONTWAIT) ||
-			  sock_is_nonblock(net_ctx));
+			  sock_is_nonblock(net_ctx)) ||
+			dtls_handshake_in_work_q(net_ctx);
 	int remaining_time = (timeout == 0U) ? K_FOREVER : timeout;
 	u32_t entry_time = k_uptime_get_32();
 	socklen_t addrlen = sizeof(struct sockaddr);
@@ -501,7 +798,12 @@ static int dtls_rx(void *ctx, unsigned char *buf, size_t len, uint32_t timeout)
 			pev.mode = K_POLL_MODE_NOTIFY_ONLY;
 			pev.state = K_POLL_STATE_NOT_READY;
 
-			if (k_poll(&pev, 1, remaining_time) == -EAGAIN) {
+			if (dtls_handshake_aborted(net_ctx)) {
+				return MBEDTLS_ERR_SSL_TIMEOUT;
+			}
+
+			if (k_poll(&pev, 1, remaining_time) == -EAGAIN ||
+			    dtls_handshake_aborted(net_ctx)) {
 				return MBEDTLS_ERR_SSL_TIMEOUT;
 			}
 		}
@@ -803,6 +1105,16 @@ static int tls_mbedtls_handshake(struct net_context *context, bool block)
 		break;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	if (context->tls->config.endpoint == MBEDTLS_SSL_IS_CLIENT) {
+		if (ret == 0) {
+			tls_session_save(context);
+		} else if (ret == -ECONNABORTED) {
+			tls_session_remove(context);
+		}
+	}
+#endif
+
 	if (ret == 0) {
 		k_sem_give(&context->tls->tls_established);
 	}
@@ -810,6 +1122,65 @@ static int tls_mbedtls_handshake(struct net_context *context, bool block)
 	return ret;
 }
 
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+static void dtls_handshake_work(struct k_work *work)
+{
+	struct tls_context *tls = CONTAINER_OF(work, struct tls_context,
+					       handshake_work);
+	int ret;
+
+	/* The receive waits in dtls_rx() block here, whatever the flags
+	 * of the socket.
+	 */
+	tls->handshake_in_work_q = true;
+	ret = tls_mbedtls_handshake(tls->handshake_ctx, true);
+	tls->handshake_in_work_q = false;
+
+	tls->handshake_err = ret < 0 ? ret : 0;
+
+	k_sem_give(&tls->handshake_idle);
+}
+
+/* Start the handshake in the work queue, or report how it ended. */
+static int dtls_handshake_offload(struct net_context *context)
+{
+	struct tls_context *tls = context->tls;
+	int ret;
+
+	if (k_sem_take(&tls->handshake_idle, K_NO_WAIT) != 0) {
+		/* Still running */
+		return -EAGAIN;
+	}
+
+	if (is_handshake_complete(context)) {
+		k_sem_give(&tls->handshake_idle);
+		return 0;
+	}
+
+	if (tls->handshake_err < 0) {
+		/* Reported once, the next send tries again */
+		ret = tls->handshake_err;
+		tls->handshake_err = 0;
+		k_sem_give(&tls->handshake_idle);
+		return ret;
+	}
+
+	tls->handshake_ctx = context;
+	k_work_submit_to_queue(&dtls_handshake_work_q, &tls->handshake_work);
+
+	return -EAGAIN;
+}
+
+/* Stop a handshake run in the work queue and wait for its end. */
+static void dtls_handshake_cancel(struct net_context *context)
+{
+	context->tls->handshake_abort = true;
+	k_fifo_cancel_wait(&context->recv_q);
+
+	k_sem_take(&context->tls->handshake_idle, K_FOREVER);
+}
+#endif /* CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD */
+
 static int tls_mbedtls_init(struct net_context *context, bool is_server)
 {
 	int role, type, ret;
@@ -893,6 +1264,16 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 			     mbedtls_ctr_drbg_random,
 			     &tls_ctr_drbg);
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE) && \
+	defined(MBEDTLS_SSL_CACHE_C)
+	if (is_server) {
+		mbedtls_ssl_conf_session_cache(&context->tls->config,
+					       &tls_server_cache,
+					       tls_server_cache_get,
+					       tls_server_cache_set);
+	}
+#endif
+
 	ret = tls_mbedtls_set_credentials(context->tls);
 	if (ret != 0) {
 		return ret;
@@ -907,6 +1288,12 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 		return -ENOMEM;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE)
+	if (!is_server) {
+		tls_session_restore(context);
+	}
+#endif
+
 	context->tls->is_initialized = true;
 
 	return 0;
@@ -1179,6 +1566,12 @@ int ztls_close_ctx(struct net_context *ctx)
 
 
 	if (ctx->tls != NULL) {
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+		if (net_context_get_type(ctx) == SOCK_DGRAM) {
+			dtls_handshake_cancel(ctx);
+		}
+#endif
+
 		/* Try to send close notification. */
 		ctx->tls->flags = 0;
 		(void)mbedtls_ssl_close_notify(&ctx->tls->ssl);
@@ -1385,10 +1778,27 @@ static ssize_t sendto_dtls_client(struct net_context *ctx, const void *buf,
 	}
 
 	if (!is_handshake_complete(ctx)) {
+#if defined(CONFIG_NET_SOCKETS_DTLS_HANDSHAKE_OFFLOAD)
+		if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+			ret = dtls_handshake_offload(ctx);
+			if (ret < 0) {
+				goto error;
+			}
+
+			return send_tls(ctx, buf, len, flags);
+		}
+
+		/* Wait for a handshake run in the work queue */
+		k_sem_take(&ctx->tls->handshake_idle, K_FOREVER);
+		ret = is_handshake_complete(ctx) ? 0 :
+			tls_mbedtls_handshake(ctx, true);
+		k_sem_give(&ctx->tls->handshake_idle);
+#else
 		/* TODO For simplicity, TLS handshake blocks the socket even for
 		 * non-blocking socket.
 		 */
 		ret = tls_mbedtls_handshake(ctx, true);
+#endif
 		if (ret < 0) {
 			goto error;
 		}
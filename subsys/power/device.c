@@ -45,14 +45,57 @@ static int device_retval[MAX_PM_DEVICES];
 static struct device *pm_device_list;
 static int device_count;
 
+/* Set in device_retval[] for the devices left as they are */
+#define DEVICE_RETVAL_SKIPPED	1
+
+#ifdef CONFIG_DEVICE_IDLE_PM
+/*
+ * Devices under idle PM that are already suspended are left as they are,
+ * and those not in use are left suspended on resume, for their next
+ * device_pm_get() to resume them from the PM work queue rather than from
+ * the kernel idle path.
+ */
+static bool device_idle_pm_suspended(struct device *dev)
+{
+	struct device_pm *pm = dev->config->pm;
+
+	return pm->enable && pm->dev != NULL &&
+	       atomic_get(&pm->fsm_state) == DEVICE_PM_FSM_STATE_SUSPENDED;
+}
+
+static bool device_idle_pm_keep_suspended(struct device *dev)
+{
+	struct device_pm *pm = dev->config->pm;
+
+	if (!pm->enable || pm->dev == NULL || atomic_get(&pm->usage) > 0) {
+		return false;
+	}
+
+	atomic_set(&pm->fsm_state, DEVICE_PM_FSM_STATE_SUSPENDED);
+	return true;
+}
+#else
+static inline bool device_idle_pm_suspended(struct device *dev)
+{
+	return false;
+}
+
+static inline bool device_idle_pm_keep_suspended(struct device *dev)
+{
+	return false;
+}
+#endif /* CONFIG_DEVICE_IDLE_PM */
+
 int sys_pm_suspend_devices(void)
 {
 	for (int i = device_count - 1; i >= 0; i--) {
 		int idx = device_ordered_list[i];
 
-		/* TODO: Improve the logic by checking device status
-		 * and set the device states accordingly.
-		 */
+		if (device_idle_pm_suspended(&pm_device_list[idx])) {
+			device_retval[i] = DEVICE_RETVAL_SKIPPED;
+			continue;
+		}
+
 		device_retval[i] = device_set_power_state(&pm_device_list[idx],
 						DEVICE_PM_SUSPEND_STATE,
 						NULL, NULL);
@@ -91,9 +134,14 @@ void sys_pm_resume_devices(void)
 	for (i = 0; i < device_count; i++) {
 		if (!device_retval[i]) {
 			int idx = device_ordered_list[i];
+			struct device *dev = &pm_device_list[idx];
+
+			if (device_idle_pm_keep_suspended(dev)) {
+				continue;
+			}
 
-			device_set_power_state(&pm_device_list[idx],
-					DEVICE_PM_ACTIVE_STATE, NULL, NULL);
+			device_set_power_state(dev, DEVICE_PM_ACTIVE_STATE,
+					       NULL, NULL);
 		}
 	}
 }
@@ -31,13 +31,13 @@ static void device_pm_callback(struct device *dev,
 				DEVICE_PM_FSM_STATE_SUSPENDED);
 	}
 
-	k_work_submit(&dev->config->pm->work);
+	k_delayed_work_submit(&dev->config->pm->work, 0);
 }
 
 static void pm_work_handler(struct k_work *work)
 {
 	struct device_pm *pm = CONTAINER_OF(work,
-					struct device_pm, work);
+					struct device_pm, work.work);
 	struct device *dev = pm->dev;
 	int ret = 0;
 	u8_t pm_state;
@@ -89,6 +89,7 @@ static int device_pm_request(struct device *dev,
 			     u32_t target_state, u32_t pm_flags)
 {
 	int result, signaled = 0;
+	u32_t delay = 0U;
 
 	__ASSERT((target_state == DEVICE_PM_ACTIVE_STATE) ||
 			(target_state == DEVICE_PM_SUSPEND_STATE),
@@ -102,9 +103,14 @@ static int device_pm_request(struct device *dev,
 		if (atomic_dec(&dev->config->pm->usage) > 1) {
 			return 0;
 		}
+
+		if (pm_flags & DEVICE_PM_ASYNC) {
+			delay = dev->config->pm->autosuspend_delay;
+		}
 	}
 
-	k_work_submit(&dev->config->pm->work);
+	/* Also cancels a delayed suspend, on get */
+	k_delayed_work_submit(&dev->config->pm->work, delay);
 
 	/* Return in case of Async request */
 	if (pm_flags & DEVICE_PM_ASYNC) {
@@ -160,9 +166,9 @@ void device_pm_enable(struct device *dev)
 		dev->config->pm->dev = dev;
 		atomic_set(&dev->config->pm->fsm_state,
 					DEVICE_PM_FSM_STATE_SUSPENDED);
-		k_work_init(&dev->config->pm->work, pm_work_handler);
+		k_delayed_work_init(&dev->config->pm->work, pm_work_handler);
 	} else {
-		k_work_submit(&dev->config->pm->work);
+		k_delayed_work_submit(&dev->config->pm->work, 0);
 	}
 	k_sem_give(&dev->config->pm->lock);
 }
@@ -172,6 +178,11 @@ void device_pm_disable(struct device *dev)
 	k_sem_take(&dev->config->pm->lock, K_FOREVER);
 	dev->config->pm->enable = false;
 	/* Bring up the device before disabling the Idle PM */
-	k_work_submit(&dev->config->pm->work);
+	k_delayed_work_submit(&dev->config->pm->work, 0);
 	k_sem_give(&dev->config->pm->lock);
 }
+
+void device_pm_autosuspend_delay_set(struct device *dev, u32_t delay)
+{
+	dev->config->pm->autosuspend_delay = delay;
+}
@@ -38,6 +38,13 @@ extern void sys_pm_resume_devices(void);
  */
 extern enum power_states sys_pm_policy_next_state(s32_t ticks);
 
+/**
+ * @brief Function to account for the exit of a PM state after idle_ticks,
+ * out of the ticks it was entered for
+ */
+extern void sys_pm_policy_state_exit(enum power_states state, s32_t ticks,
+				     u32_t idle_ticks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * PM policy choosing the power state from the predicted idle duration.
+ *
+ * An idle period ends at the next kernel timeout, or before at the next
+ * interrupt. The intervals between the wakeups of each interrupt source
+ * are learned as a histogram, from which the probability that the source
+ * has not interrupted x ticks from now is derived, given the time since
+ * its last wakeup. The expected idle duration integrates the probability
+ * that no source has, up to the kernel timeout.
+ *
+ * With the energy spent in a state linear in the idle duration and the
+ * minimum residency of a state its break-even time against the shallower
+ * ones, the state of least expected energy is the deepest whose minimum
+ * residency and exit latency fit in the expected idle duration. Otherwise
+ * the shallowest state fitting before the kernel timeout is entered, so
+ * that the wakeups keep being learned.
+ */
+
+#include <zephyr.h>
+#include <kernel.h>
+#include "pm_policy.h"
+
+#define LOG_LEVEL CONFIG_SYS_PM_LOG_LEVEL /* From power module Kconfig */
+#include <logging/log.h>
+LOG_MODULE_DECLARE(power);
+
+#define MS_TO_TICKS(ms) \
+	((u64_t)(ms) * CONFIG_SYS_CLOCK_TICKS_PER_SEC / MSEC_PER_SEC)
+#define US_TO_TICKS(us) \
+	(((u64_t)(us) * CONFIG_SYS_CLOCK_TICKS_PER_SEC + USEC_PER_SEC - 1) / \
+	 USEC_PER_SEC)
+
+#define PM_STATE(name) {						\
+	MS_TO_TICKS(CONFIG_SYS_PM_MIN_RESIDENCY_##name),		\
+	US_TO_TICKS(CONFIG_SYS_PM_EXIT_LATENCY_##name)			\
+}
+
+struct pm_state_params {
+	u32_t min_residency;
+	u32_t exit_latency;
+};
+
+static const struct pm_state_params pm_states[] = {
+#ifdef CONFIG_SYS_POWER_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_1
+	PM_STATE(SLEEP_1),
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_2
+	PM_STATE(SLEEP_2),
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_3
+	PM_STATE(SLEEP_3),
+#endif
+#endif /* CONFIG_SYS_POWER_SLEEP_STATES */
+
+#ifdef CONFIG_SYS_POWER_DEEP_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_1
+	PM_STATE(DEEP_SLEEP_1),
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_2
+	PM_STATE(DEEP_SLEEP_2),
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_3
+	PM_STATE(DEEP_SLEEP_3),
+#endif
+#endif /* CONFIG_SYS_POWER_DEEP_SLEEP_STATES */
+};
+
+/*
+ * Intervals fall in buckets of [2^i, 2^(i+1)) ticks, the first holding
+ * those shorter than 2 ticks and the last the longer ones.
+ */
+#define PM_BUCKETS 16
+#define PM_BUCKET_MAX (1U << (PM_BUCKETS - 1))
+
+struct pm_source {
+	/* Learned intervals between consecutive wakeups, per bucket */
+	u16_t count[PM_BUCKETS];
+	u16_t total;
+	bool seen;
+
+	/* Uptime of the last wakeup, in ticks */
+	u32_t last;
+};
+
+static struct pm_source pm_sources[CONFIG_SYS_PM_POLICY_PREDICTIVE_SOURCES];
+
+__weak unsigned int sys_pm_wakeup_source_get(void)
+{
+	/* This function can be overridden by the application. */
+	return 0;
+}
+
+static unsigned int pm_bucket(u32_t ticks)
+{
+	unsigned int i = 0U;
+
+	while (i < PM_BUCKETS - 1 && ticks >= (2U << i)) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Number of the learned intervals longer than t ticks, in 1/256 */
+static u32_t pm_tail(const struct pm_source *src, u32_t t)
+{
+	unsigned int b = pm_bucket(t);
+	u32_t lo = (b == 0U) ? 0 : (1U << b);
+	u32_t hi = 2U << b;
+	u32_t n = 0U;
+	unsigned int i;
+
+	for (i = b + 1; i < PM_BUCKETS; i++) {
+		n += src->count[i];
+	}
+
+	n <<= 8;
+
+	/* Intervals spread evenly in their bucket, the last unbounded */
+	if (b == PM_BUCKETS - 1) {
+		n += (u32_t)src->count[b] << 8;
+	} else {
+		n += ((u32_t)src->count[b] << 8) * (hi - t) / (hi - lo);
+	}
+
+	return n;
+}
+
+/*
+ * Probability, in 1/65536, that no source interrupts in the next x ticks.
+ */
+static u32_t pm_survival(u32_t now, u32_t x)
+{
+	u32_t survival = 1U << 16;
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(pm_sources); i++) {
+		const struct pm_source *src = &pm_sources[i];
+		u32_t elapsed;
+		u32_t tail;
+
+		if (!src->seen || src->total == 0U) {
+			continue;
+		}
+
+		elapsed = MIN(now - src->last, PM_BUCKET_MAX);
+		tail = pm_tail(src, elapsed);
+
+		/* Overdue beyond the learned intervals, nothing known */
+		if (tail == 0U) {
+			continue;
+		}
+
+		survival = ((u64_t)survival *
+			    pm_tail(src, elapsed + x) + tail / 2U) / tail;
+	}
+
+	return survival;
+}
+
+/*
+ * Expected idle duration, in ticks, capped at max: the sum of the survival
+ * over intervals doubling in length, taken at their end.
+ */
+static u32_t pm_expected_idle(u32_t max)
+{
+	u32_t now = z_tick_get_32();
+	u64_t sum = 0U;
+	u32_t survival;
+	u32_t from = 0U;
+	u32_t to = 1U;
+
+	while (from < max) {
+		/* Beyond the last bucket the survival no longer changes */
+		to = (from >= PM_BUCKET_MAX) ? max : MIN(to, max);
+
+		survival = pm_survival(now, to);
+		if (survival == 0U) {
+			break;
+		}
+
+		sum += (u64_t)survival * (to - from);
+		from = to;
+		to <<= 1;
+	}
+
+	return sum >> 16;
+}
+
+enum power_states sys_pm_policy_next_state(s32_t ticks)
+{
+	int state = SYS_POWER_STATE_ACTIVE;
+	u32_t horizon = 0U;
+	u32_t expected;
+	u32_t needed;
+	int i;
+
+	if ((ticks != K_FOREVER) &&
+	    ((u32_t)ticks < pm_states[0].min_residency)) {
+		LOG_DBG("Not enough time for PM operations: %d", ticks);
+		return SYS_POWER_STATE_ACTIVE;
+	}
+
+	/* Nothing to learn beyond the needs of the deepest state */
+	for (i = 0; i < ARRAY_SIZE(pm_states); i++) {
+		needed = pm_states[i].min_residency + pm_states[i].exit_latency;
+		horizon = MAX(horizon, needed);
+	}
+
+	if (ticks != K_FOREVER) {
+		horizon = MIN(horizon, (u32_t)ticks);
+	}
+
+	expected = pm_expected_idle(horizon);
+
+	for (i = ARRAY_SIZE(pm_states) - 1; i >= 0; i--) {
+#ifdef CONFIG_SYS_PM_STATE_LOCK
+		if (!sys_pm_ctrl_is_state_enabled((enum power_states)(i))) {
+			continue;
+		}
+#endif
+		needed = pm_states[i].min_residency + pm_states[i].exit_latency;
+
+		if ((ticks != K_FOREVER) && ((u32_t)ticks < needed)) {
+			continue;
+		}
+
+		if (expected >= needed) {
+			LOG_DBG("Selected power state %d "
+				"(ticks: %d, expected: %u, needed: %u)",
+				i, ticks, expected, needed);
+			return (enum power_states)(i);
+		}
+
+		state = i;
+	}
+
+	LOG_DBG("Selected shallowest power state %d "
+		"(ticks: %d, expected: %u)", state, ticks, expected);
+	return (enum power_states)state;
+}
+
+void sys_pm_policy_state_exit(enum power_states state, s32_t ticks,
+			      u32_t idle_ticks)
+{
+	struct pm_source *src;
+	unsigned int i;
+	u32_t now;
+
+	ARG_UNUSED(state);
+
+	if ((ticks != K_FOREVER) && (idle_ticks + 1 >= (u32_t)ticks)) {
+		/* Woken by the kernel timeout */
+		return;
+	}
+
+	i = sys_pm_wakeup_source_get();
+	if (i >= ARRAY_SIZE(pm_sources)) {
+		LOG_ERR("Invalid wakeup source %u", i);
+		return;
+	}
+
+	src = &pm_sources[i];
+	now = z_tick_get_32();
+
+	if (src->seen) {
+		/* Forget the older intervals as the newer come */
+		if (src->total >= CONFIG_SYS_PM_POLICY_PREDICTIVE_WINDOW) {
+			src->total = 0U;
+			for (i = 0; i < PM_BUCKETS; i++) {
+				src->count[i] = (src->count[i] + 1U) / 2U;
+				src->total += src->count[i];
+			}
+		}
+
+		src->count[pm_bucket(now - src->last)]++;
+		src->total++;
+	}
+
+	src->seen = true;
+	src->last = now;
+}
@@ -23,8 +23,9 @@ static enum power_states pm_state;
 
 struct pm_debug_info {
 	u32_t count;
+	u32_t early;
 	u32_t last_res;
-	u32_t total_res;
+	u64_t total_res;
 };
 
 static struct pm_debug_info pm_dbg_info[SYS_POWER_STATE_MAX];
@@ -40,11 +41,12 @@ static inline void sys_pm_debug_stop_timer(void)
 	timer_end = k_cycle_get_32();
 }
 
-static void sys_pm_log_debug_info(enum power_states state)
+static void sys_pm_log_debug_info(enum power_states state, bool early)
 {
 	u32_t res = timer_end - timer_start;
 
 	pm_dbg_info[state].count++;
+	pm_dbg_info[state].early += early;
 	pm_dbg_info[state].last_res = res;
 	pm_dbg_info[state].total_res += res;
 }
@@ -52,15 +54,17 @@ static void sys_pm_log_debug_info(enum power_states state)
 void sys_pm_dump_debug_info(void)
 {
 	for (int i = 0; i < SYS_POWER_STATE_MAX; i++) {
-		LOG_DBG("PM:state = %d, count = %d last_res = %d, "
-			"total_res = %d\n", i, pm_dbg_info[i].count,
-			pm_dbg_info[i].last_res, pm_dbg_info[i].total_res);
+		LOG_DBG("PM:state = %d, count = %u early = %u last_res = %u, "
+			"total_res = %u us\n", i, pm_dbg_info[i].count,
+			pm_dbg_info[i].early, pm_dbg_info[i].last_res,
+			(u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(
+				pm_dbg_info[i].total_res) / NSEC_PER_USEC));
 	}
 }
 #else
 static inline void sys_pm_debug_start_timer(void) { }
 static inline void sys_pm_debug_stop_timer(void) { }
-static void sys_pm_log_debug_info(enum power_states state) { }
+static void sys_pm_log_debug_info(enum power_states state, bool early) { }
 void sys_pm_dump_debug_info(void) { }
 #endif
 
@@ -85,6 +89,7 @@ void sys_pm_force_power_state(enum power_states state)
 
 enum power_states _sys_suspend(s32_t ticks)
 {
+	u32_t idle_ticks;
 	bool deep_sleep;
 
 	pm_state = (forced_pm_state == SYS_POWER_STATE_AUTO) ?
@@ -120,7 +125,9 @@ enum power_states _sys_suspend(s32_t ticks)
 
 	/* Enter power state */
 	sys_pm_debug_start_timer();
+	idle_ticks = z_tick_get_32();
 	sys_set_power_state(pm_state);
+	idle_ticks = z_tick_get_32() - idle_ticks;
 	sys_pm_debug_stop_timer();
 
 #if CONFIG_DEVICE_POWER_MANAGEMENT
@@ -129,7 +136,12 @@ enum power_states _sys_suspend(s32_t ticks)
 		sys_pm_resume_devices();
 	}
 #endif
-	sys_pm_log_debug_info(pm_state);
+	/* Woken by an interrupt rather than by the timeout */
+	sys_pm_log_debug_info(pm_state, ticks == K_FOREVER ||
+			      idle_ticks + 1 < (u32_t)ticks);
+#ifdef CONFIG_SYS_PM_POLICY_PREDICTIVE
+	sys_pm_policy_state_exit(pm_state, ticks, idle_ticks);
+#endif
 
 	if (!post_ops_done) {
 		post_ops_done = 1;
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CTR-DRBG (NIST SP 800-90A) based on the TinyCrypt AES-128 CTR PRNG.
+ *
+ * The generator is seeded from the entropy driver at boot and reseeded
+ * from the system workqueue, so requests never wait on the entropy
+ * source and can be served from interrupt context.
+ */
+
+#include <init.h>
+#include <device.h>
+#include <entropy.h>
+#include <kernel.h>
+#include <string.h>
+#include <random/rand32.h>
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ctr_prng.h>
+
+/* Entropy input of a seed, AES key plus counter block */
+#define CTR_DRBG_SEED_LEN	(TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE)
+
+/* Largest output generated with interrupts locked */
+#define CTR_DRBG_CHUNK_LEN	256
+
+static TCCtrPrng_t ctr_ctx;
+static struct device *entropy_dev;
+static bool ctr_seeded;
+
+static const u8_t ctr_personalization[] = "zephyr ctr-drbg";
+
+static int ctr_drbg_entropy_get(u8_t *seed, size_t len)
+{
+	int rc;
+
+	rc = entropy_get_entropy_isr(entropy_dev, seed, len, ENTROPY_BUSYWAIT);
+	if (rc == -ENOTSUP) {
+		/* Driver does not provide an ISR-specific API, assume it can
+		 * be called from ISR context
+		 */
+		rc = entropy_get_entropy(entropy_dev, seed, len);
+	}
+
+	return (rc < 0) ? rc : 0;
+}
+
+#if CONFIG_CSPRNG_RESEED_INTERVAL > 0
+static struct k_delayed_work reseed_work;
+
+static void ctr_drbg_reseed(struct k_work *work)
+{
+	u8_t seed[CTR_DRBG_SEED_LEN];
+	u32_t extra = k_cycle_get_32();
+	unsigned int key;
+
+	ARG_UNUSED(work);
+
+	/* the blocking call only runs in thread context */
+	if (entropy_get_entropy(entropy_dev, seed, sizeof(seed)) == 0) {
+		key = irq_lock();
+		(void)tc_ctr_prng_reseed(&ctr_ctx, seed, sizeof(seed),
+					 (u8_t *)&extra, sizeof(extra));
+		irq_unlock(key);
+	}
+
+	(void)memset(seed, 0, sizeof(seed));
+
+	k_delayed_work_submit(&reseed_work,
+			      K_SECONDS(CONFIG_CSPRNG_RESEED_INTERVAL));
+}
+#endif /* CONFIG_CSPRNG_RESEED_INTERVAL > 0 */
+
+int sys_csrand_get(void *dst, size_t len)
+{
+	u8_t *out = dst;
+	unsigned int key;
+	size_t chunk;
+	int rc;
+
+	if (!ctr_seeded) {
+		return -EIO;
+	}
+
+	while (len > 0) {
+		chunk = MIN(len, CTR_DRBG_CHUNK_LEN);
+
+		key = irq_lock();
+		rc = tc_ctr_prng_generate(&ctr_ctx, NULL, 0, out, chunk);
+		irq_unlock(key);
+
+		if (rc != TC_CRYPTO_SUCCESS) {
+			/* TC_CTR_PRNG_RESEED_REQ after 2^48 requests */
+			return -EIO;
+		}
+
+		out += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_CSPRNG_RANDOM_GENERATOR
+u32_t sys_rand32_get(void)
+{
+	u32_t ret = k_cycle_get_32();
+
+	(void)sys_csrand_get(&ret, sizeof(ret));
+
+	return ret;
+}
+#endif
+
+static int ctr_drbg_initialize(struct device *dev)
+{
+	u8_t seed[CTR_DRBG_SEED_LEN];
+	int rc;
+
+	ARG_UNUSED(dev);
+
+	entropy_dev = device_get_binding(CONFIG_ENTROPY_NAME);
+	if (entropy_dev == NULL) {
+		return -ENODEV;
+	}
+
+	rc = ctr_drbg_entropy_get(seed, sizeof(seed));
+	if (rc < 0) {
+		return -EIO;
+	}
+
+	rc = tc_ctr_prng_init(&ctr_ctx, seed, sizeof(seed),
+			      ctr_personalization,
+			      sizeof(ctr_personalization));
+	(void)memset(seed, 0, sizeof(seed));
+	if (rc != TC_CRYPTO_SUCCESS) {
+		return -EIO;
+	}
+
+	ctr_seeded = true;
+
+	return 0;
+}
+
+/* In-tree entropy drivers will initialize in PRE_KERNEL_1; ensure that they're
+ * initialized properly before initializing ourselves.
+ */
+SYS_INIT(ctr_drbg_initialize, PRE_KERNEL_2,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#if CONFIG_CSPRNG_RESEED_INTERVAL > 0
+static int ctr_drbg_reseed_start(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_delayed_work_init(&reseed_work, ctr_drbg_reseed);
+	k_delayed_work_submit(&reseed_work,
+			      K_SECONDS(CONFIG_CSPRNG_RESEED_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(ctr_drbg_reseed_start, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
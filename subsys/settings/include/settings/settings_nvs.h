@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __SETTINGS_NVS_H_
+#define __SETTINGS_NVS_H_
+
+#include <nvs/nvs.h>
+#include "settings/settings.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Settings are stored as one NVS entry each, holding the name, a '\0' and
+ * the value. The entry id is a hash of the name within
+ * [SETTINGS_NVS_ID_FIRST, SETTINGS_NVS_ID_FIRST + CONFIG_SETTINGS_NVS_ID_COUNT),
+ * collisions are resolved by using the next id. A deleted setting keeps its
+ * entry with an empty value, so that the names stored after it stay found.
+ */
+#define SETTINGS_NVS_ID_FIRST 0x8000
+
+struct settings_nvs {
+	struct settings_store cf_store;
+	struct nvs_fs cf_nvs;
+	const char *flash_dev_name;
+};
+
+extern int settings_nvs_src(struct settings_nvs *cf);
+extern int settings_nvs_dst(struct settings_nvs *cf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SETTINGS_NVS_H_ */
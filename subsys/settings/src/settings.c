@@ -19,6 +19,9 @@ LOG_MODULE_REGISTER(settings, CONFIG_SETTINGS_LOG_LEVEL);
 
 sys_slist_t settings_handlers;
 
+/* subtree loaded by settings_load_subtree(), NULL when loading all */
+const char *settings_load_filter;
+
 static u8_t settings_cmd_inited;
 
 static struct settings_handler *settings_handler_lookup(char *name);
@@ -102,7 +105,57 @@ struct settings_handler *settings_parse_and_lookup(char *name,
 	return settings_handler_lookup(name_argv[0]);
 }
 
-int settings_commit(void)
+/*
+ * Check if name is subtree itself or an item under it.
+ */
+bool settings_name_in_subtree(const char *name, const char *subtree)
+{
+	size_t len;
+
+	if (!subtree) {
+		return true;
+	}
+
+	len = strlen(subtree);
+	if (strncmp(name, subtree, len)) {
+		return false;
+	}
+
+	return name[len] == '\0' || name[len] == *SETTINGS_NAME_SEPARATOR;
+}
+
+int settings_call_set_handler(char *name, size_t len,
+			      settings_read_cb read_cb, void *read_cb_arg)
+{
+	int name_argc;
+	char *name_argv[SETTINGS_MAX_DIR_DEPTH];
+	struct settings_handler *ch;
+	int rc;
+
+	if (!settings_name_in_subtree(name, settings_load_filter)) {
+		return 0;
+	}
+
+	ch = settings_parse_and_lookup(name, &name_argc, name_argv);
+	if (!ch) {
+		return 0;
+	}
+
+	rc = ch->h_set(name_argc - 1, &name_argv[1], len, read_cb,
+		       read_cb_arg);
+
+	if (rc != 0) {
+		LOG_ERR("set-value failure. key: %s error(%d)",
+			log_strdup(name), rc);
+	} else {
+		LOG_DBG("set-value OK. key: %s",
+			log_strdup(name));
+	}
+
+	return rc;
+}
+
+int settings_commit_subtree(const char *subtree)
 {
 	struct settings_handler *ch;
 	int rc;
@@ -110,6 +163,12 @@ int settings_commit(void)
 
 	rc = 0;
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
+		/* the handler of the subtree or of any subtree under it */
+		if (subtree && !settings_name_in_subtree(subtree, ch->name) &&
+		    !settings_name_in_subtree(ch->name, subtree)) {
+			continue;
+		}
+
 		if (ch->h_commit) {
 			rc2 = ch->h_commit();
 			if (!rc) {
@@ -119,3 +178,8 @@ int settings_commit(void)
 	}
 	return rc;
 }
+
+int settings_commit(void)
+{
+	return settings_commit_subtree(NULL);
+}
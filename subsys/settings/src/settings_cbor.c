@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Binary settings format: a CBOR map of the setting names, as text strings,
+ * to their values, as byte strings. It carries the values as exported by
+ * the handlers, without the base64 encoding of the text line format.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <cbor_codec.h>
+
+#include "settings/settings.h"
+#include "settings_priv.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+/* the export callback of the handlers takes no context */
+static K_MUTEX_DEFINE(settings_cbor_lock);
+static struct cbor_writer *settings_cbor_out;
+static const char *settings_cbor_subtree;
+
+static int settings_cbor_export_one(const char *name, const void *val,
+				    size_t val_len)
+{
+	int rc;
+
+	if (!settings_name_in_subtree(name, settings_cbor_subtree)) {
+		return 0;
+	}
+
+	rc = cbor_write_tstr(settings_cbor_out, name, strlen(name));
+	if (rc) {
+		return rc;
+	}
+
+	if (!val) {
+		return cbor_write_null(settings_cbor_out);
+	}
+
+	return cbor_write_bstr(settings_cbor_out, val, val_len);
+}
+
+int settings_cbor_export(const char *subtree, struct cbor_writer *writer)
+{
+	struct settings_handler *ch;
+	int rc;
+
+	k_mutex_lock(&settings_cbor_lock, K_FOREVER);
+
+	settings_cbor_out = writer;
+	settings_cbor_subtree = subtree;
+
+	rc = cbor_write_map_start(writer, CBOR_INDEFINITE);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
+		if (rc) {
+			break;
+		}
+
+		if (!ch->h_export) {
+			continue;
+		}
+
+		/* the handler of the subtree or of any subtree under it */
+		if (subtree && !settings_name_in_subtree(subtree, ch->name) &&
+		    !settings_name_in_subtree(ch->name, subtree)) {
+			continue;
+		}
+
+		rc = ch->h_export(settings_cbor_export_one);
+	}
+
+	if (!rc) {
+		rc = cbor_write_break(writer);
+	}
+
+	settings_cbor_out = NULL;
+	settings_cbor_subtree = NULL;
+
+	k_mutex_unlock(&settings_cbor_lock);
+
+	return rc;
+}
+
+static ssize_t settings_cbor_read_cb(void *cb_arg, void *data, size_t len)
+{
+	const struct cbor_str *val = cb_arg;
+
+	len = MIN(len, val->len);
+	memcpy(data, val->data, len);
+
+	return len;
+}
+
+static int settings_cbor_import_one(struct cbor_reader *reader, bool save)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
+	struct cbor_str key, val;
+	int rc;
+
+	rc = cbor_read_tstr(reader, &key);
+	if (rc) {
+		return rc;
+	}
+
+	if (key.len >= sizeof(name)) {
+		return -ENAMETOOLONG;
+	}
+
+	memcpy(name, key.data, key.len);
+	name[key.len] = '\0';
+
+	/* a null value deletes the setting */
+	if (!cbor_read_null(reader)) {
+		val.data = NULL;
+		val.len = 0;
+	} else {
+		rc = cbor_read_bstr(reader, &val);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	if (save) {
+		rc = settings_save_one(name, val.data, val.len);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	/* the name is split in place by the lookup */
+	return settings_call_set_handler(name, val.len, settings_cbor_read_cb,
+					 &val);
+}
+
+int settings_cbor_import(const void *data, size_t len, bool save)
+{
+	struct cbor_reader reader;
+	size_t count, i;
+	int rc;
+
+	cbor_reader_init(&reader, data, len);
+
+	rc = cbor_read_map_start(&reader, &count);
+	if (rc) {
+		return rc;
+	}
+
+	for (i = 0; count == CBOR_INDEFINITE ? !cbor_read_break(&reader) :
+	     i < count; i++) {
+		rc = settings_cbor_import_one(&reader, save);
+		if (rc) {
+			LOG_ERR("CBOR settings import failed (%d)", rc);
+			return rc;
+		}
+	}
+
+	return 0;
+}
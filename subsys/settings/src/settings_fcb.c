@@ -131,7 +131,11 @@ static int settings_fcb_load_priv(struct settings_store *cs, line_load_cb cb,
 
 static int settings_fcb_load(struct settings_store *cs)
 {
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+	return settings_line_load_latest(cs, settings_fcb_load_priv);
+#else
 	return settings_fcb_load_priv(cs, settings_line_load_cb, NULL);
+#endif
 }
 
 
@@ -111,7 +111,11 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
  */
 static int settings_file_load(struct settings_store *cs)
 {
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+	return settings_line_load_latest(cs, settings_file_load_priv);
+#else
 	return settings_file_load_priv(cs, settings_line_load_cb, NULL);
+#endif
 }
 
 static void settings_tmpfile(char *dst, const char *src, char *pfx)
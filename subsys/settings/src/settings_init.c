@@ -126,6 +126,54 @@ int settings_backend_init(void)
 
 	return rc;
 }
+#elif defined(CONFIG_SETTINGS_NVS)
+#include <flash.h>
+#include <flash_map.h>
+#include "settings/settings_nvs.h"
+
+static struct settings_nvs config_init_settings_nvs;
+
+int settings_backend_init(void)
+{
+	int rc;
+	const struct flash_area *fap;
+	struct flash_pages_info info;
+	struct device *dev;
+
+	rc = flash_area_open(FLASH_AREA_STORAGE_ID, &fap);
+	if (rc) {
+		k_panic();
+	}
+
+	dev = device_get_binding(fap->fa_dev_name);
+	if (!dev) {
+		k_panic();
+	}
+
+	rc = flash_get_page_info_by_offs(dev, fap->fa_off, &info);
+	if (rc) {
+		k_panic();
+	}
+
+	config_init_settings_nvs.flash_dev_name = fap->fa_dev_name;
+	config_init_settings_nvs.cf_nvs.offset = fap->fa_off;
+	config_init_settings_nvs.cf_nvs.sector_size = info.size;
+	config_init_settings_nvs.cf_nvs.sector_count = fap->fa_size / info.size;
+
+	flash_area_close(fap);
+
+	rc = settings_nvs_src(&config_init_settings_nvs);
+	if (rc) {
+		k_panic();
+	}
+
+	rc = settings_nvs_dst(&config_init_settings_nvs);
+	if (rc) {
+		k_panic();
+	}
+
+	return rc;
+}
 #elif defined(CONFIG_SETTINGS_NONE)
 int settings_backend_init(void)
 {
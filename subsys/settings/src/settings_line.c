@@ -533,15 +533,11 @@ static ssize_t settings_line_read_cb(void *cb_arg, void *data, size_t len)
 void settings_line_load_cb(char *name, void *val_read_cb_ctx, off_t off,
 			   void *cb_arg)
 {
-	int name_argc;
-	char *name_argv[SETTINGS_MAX_DIR_DEPTH];
-	struct settings_handler *ch;
 	struct settings_line_read_value_cb_ctx value_ctx;
-	int rc;
 	size_t len;
 
-	ch = settings_parse_and_lookup(name, &name_argc, name_argv);
-	if (!ch) {
+	if (!settings_name_in_subtree(name, settings_load_filter)) {
+		/* skip reading the value length */
 		return;
 	}
 
@@ -550,15 +546,119 @@ void settings_line_load_cb(char *name, void *val_read_cb_ctx, off_t off,
 
 	len = settings_line_val_get_len(off, val_read_cb_ctx);
 
-	rc = ch->h_set(name_argc - 1, &name_argv[1], len, settings_line_read_cb,
-		       (void *)&value_ctx);
+	(void)settings_call_set_handler(name, len, settings_line_read_cb,
+					(void *)&value_ctx);
+}
 
-	if (rc != 0) {
-		LOG_ERR("set-value failure. key: %s error(%d)",
-			log_strdup(name), rc);
-	} else {
-		LOG_DBG("set-value OK. key: %s",
-			log_strdup(name));
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+/* Index of the latest record of every name, built by a first walk through
+ * the records reading only the names. Names are told apart by a 32-bit
+ * hash, records are identified by their position in the walk.
+ */
+struct settings_line_index_entry {
+	u32_t hash;
+	u32_t seq; /* position of the latest record, 0 for a free entry */
+};
+
+static struct {
+	struct settings_line_index_entry entry[CONFIG_SETTINGS_LOAD_INDEX_SIZE];
+	u32_t seq;
+	bool full;
+} line_index;
+
+/* FNV-1a */
+static u32_t settings_line_name_hash(const char *name)
+{
+	u32_t hash = 2166136261U;
+
+	while (*name) {
+		hash ^= (u8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static struct settings_line_index_entry *settings_line_index_get(u32_t hash)
+{
+	struct settings_line_index_entry *entry;
+	size_t pos = hash % CONFIG_SETTINGS_LOAD_INDEX_SIZE;
+	size_t i;
+
+	for (i = 0; i < CONFIG_SETTINGS_LOAD_INDEX_SIZE; i++) {
+		entry = &line_index.entry[pos];
+		if (!entry->seq || entry->hash == hash) {
+			return entry;
+		}
+
+		pos = (pos + 1) % CONFIG_SETTINGS_LOAD_INDEX_SIZE;
+	}
+
+	return NULL;
+}
+
+static void settings_line_index_cb(char *name, void *val_read_cb_ctx,
+				   off_t off, void *cb_arg)
+{
+	struct settings_line_index_entry *entry;
+	u32_t hash;
+
+	line_index.seq++;
+
+	if (!settings_name_in_subtree(name, settings_load_filter)) {
+		return;
+	}
+
+	hash = settings_line_name_hash(name);
+	entry = settings_line_index_get(hash);
+	if (!entry) {
+		line_index.full = true;
+		return;
 	}
-	(void)rc;
+
+	entry->hash = hash;
+	entry->seq = line_index.seq;
+}
+
+static void settings_line_load_latest_cb(char *name, void *val_read_cb_ctx,
+					 off_t off, void *cb_arg)
+{
+	struct settings_line_index_entry *entry;
+
+	line_index.seq++;
+
+	if (!settings_name_in_subtree(name, settings_load_filter)) {
+		return;
+	}
+
+	entry = settings_line_index_get(settings_line_name_hash(name));
+	if (entry && entry->seq != line_index.seq) {
+		/* superseded by a later record */
+		return;
+	}
+
+	settings_line_load_cb(name, val_read_cb_ctx, off, cb_arg);
+}
+
+int settings_line_load_latest(struct settings_store *cs,
+			      line_load_priv_cb load_priv)
+{
+	int rc;
+
+	(void)memset(&line_index, 0, sizeof(line_index));
+
+	rc = load_priv(cs, settings_line_index_cb, NULL);
+	if (rc) {
+		return rc;
+	}
+
+	if (line_index.full) {
+		LOG_WRN("load index full, loading all records");
+		return load_priv(cs, settings_line_load_cb, NULL);
+	}
+
+	line_index.seq = 0U;
+
+	return load_priv(cs, settings_line_load_latest_cb, NULL);
 }
+#endif /* CONFIG_SETTINGS_LOAD_INDEX */
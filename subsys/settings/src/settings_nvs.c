@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "settings/settings.h"
+#include "settings/settings_nvs.h"
+#include "settings_priv.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+/* name, '\0', value */
+#define SETTINGS_NVS_REC_LEN_MAX (SETTINGS_MAX_NAME_LEN + 1 + \
+				  SETTINGS_MAX_VAL_LEN)
+
+struct settings_nvs_read_fn_arg {
+	const char *data;
+	size_t len;
+};
+
+static int settings_nvs_load(struct settings_store *cs);
+static int settings_nvs_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len);
+
+static struct settings_store_itf settings_nvs_itf = {
+	.csi_load = settings_nvs_load,
+	.csi_save = settings_nvs_save,
+};
+
+/* FNV-1a */
+static u32_t settings_nvs_name_hash(const char *name)
+{
+	u32_t hash = 2166136261U;
+
+	while (*name) {
+		hash ^= (u8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
+{
+	struct settings_nvs_read_fn_arg *rd_fn_arg = back_end;
+
+	len = MIN(len, rd_fn_arg->len);
+	memcpy(data, rd_fn_arg->data, len);
+
+	return len;
+}
+
+int settings_nvs_src(struct settings_nvs *cf)
+{
+	int rc;
+
+	rc = nvs_init(&cf->cf_nvs, cf->flash_dev_name);
+	if (rc) {
+		return rc;
+	}
+
+	cf->cf_store.cs_itf = &settings_nvs_itf;
+	settings_src_register(&cf->cf_store);
+
+	return 0;
+}
+
+int settings_nvs_dst(struct settings_nvs *cf)
+{
+	cf->cf_store.cs_itf = &settings_nvs_itf;
+	settings_dst_register(&cf->cf_store);
+
+	return 0;
+}
+
+/*
+ * Find the entry of name, probing from the id its hash maps to.
+ * Returns 1 with the id of the entry if found, 0 with an id to store it
+ * otherwise, -ERRNO on failure.
+ */
+static int settings_nvs_find(struct settings_nvs *cf, const char *name,
+			     u16_t *id)
+{
+	char buf[SETTINGS_MAX_NAME_LEN + 1];
+	size_t name_len = strlen(name);
+	int free_id = -1;
+	u16_t pos, cur;
+	char *name_end;
+	ssize_t rc;
+	size_t i;
+
+	pos = settings_nvs_name_hash(name) % CONFIG_SETTINGS_NVS_ID_COUNT;
+
+	for (i = 0; i < CONFIG_SETTINGS_NVS_ID_COUNT; i++) {
+		cur = SETTINGS_NVS_ID_FIRST + pos;
+		pos = (pos + 1) % CONFIG_SETTINGS_NVS_ID_COUNT;
+
+		rc = nvs_read(&cf->cf_nvs, cur, buf, sizeof(buf));
+		if (rc == -ENOENT) {
+			/* never used, name is not stored further on */
+			*id = (free_id >= 0) ? free_id : cur;
+			return 0;
+		}
+		if (rc < 0) {
+			return rc;
+		}
+
+		name_end = memchr(buf, '\0', MIN(rc, sizeof(buf)));
+		if (!name_end) {
+			/* not a settings entry */
+			continue;
+		}
+
+		if (((size_t)(name_end - buf) == name_len) &&
+		    !memcmp(buf, name, name_len)) {
+			*id = cur;
+			return 1;
+		}
+
+		if ((free_id < 0) && ((name_end - buf) + 1 == rc)) {
+			/* deletion of another name, can be used */
+			free_id = cur;
+		}
+	}
+
+	if (free_id >= 0) {
+		*id = free_id;
+		return 0;
+	}
+
+	return -ENOSPC;
+}
+
+static int settings_nvs_load(struct settings_store *cs)
+{
+	struct settings_nvs *cf = (struct settings_nvs *)cs;
+	struct settings_nvs_read_fn_arg read_fn_arg;
+	char buf[SETTINGS_NVS_REC_LEN_MAX];
+	char *name_end;
+	size_t len;
+	ssize_t rc;
+	u16_t i;
+
+	for (i = 0; i < CONFIG_SETTINGS_NVS_ID_COUNT; i++) {
+		rc = nvs_read(&cf->cf_nvs, SETTINGS_NVS_ID_FIRST + i, buf,
+			      sizeof(buf));
+		if (rc <= 0) {
+			/* unused id */
+			continue;
+		}
+
+		len = MIN(rc, sizeof(buf));
+		name_end = memchr(buf, '\0', len);
+		if (!name_end || (name_end + 1 == buf + len)) {
+			/* not a settings entry, or deleted */
+			continue;
+		}
+
+		read_fn_arg.data = name_end + 1;
+		read_fn_arg.len = len - (read_fn_arg.data - buf);
+
+		(void)settings_call_set_handler(buf, read_fn_arg.len,
+						settings_nvs_read_fn,
+						(void *)&read_fn_arg);
+	}
+
+	return 0;
+}
+
+static int settings_nvs_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len)
+{
+	struct settings_nvs *cf = (struct settings_nvs *)cs;
+	char buf[SETTINGS_NVS_REC_LEN_MAX];
+	size_t name_len;
+	ssize_t rc;
+	u16_t id;
+
+	if (!name || (val_len > 0 && value == NULL)) {
+		return -EINVAL;
+	}
+
+	name_len = strlen(name);
+	if (!name_len || name_len > SETTINGS_MAX_NAME_LEN ||
+	    val_len > SETTINGS_MAX_VAL_LEN) {
+		return -EINVAL;
+	}
+
+	rc = settings_nvs_find(cf, name, &id);
+	if (rc < 0) {
+		LOG_ERR("no NVS id left for %s", log_strdup(name));
+		return rc;
+	}
+
+	if (!rc && !val_len) {
+		/* deleting a name that is not stored */
+		return 0;
+	}
+
+	memcpy(buf, name, name_len + 1);
+	memcpy(&buf[name_len + 1], value, val_len);
+
+	/* NVS does not write an unchanged entry again */
+	rc = nvs_write(&cf->cf_nvs, id, buf, name_len + 1 + val_len);
+	if (rc < 0) {
+		return rc;
+	}
+
+	return 0;
+}
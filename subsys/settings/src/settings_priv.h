@@ -10,6 +10,7 @@
 
 #include <sys/types.h>
 #include <errno.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,6 +45,46 @@ void settings_line_load_cb(char *name, void *val_read_cb_ctx, off_t off,
 typedef void (*line_load_cb)(char *name, void *val_read_cb_ctx, off_t off,
 			     void *cb_arg);
 
+struct settings_store;
+
+/* walk through all records of a line based backend calling cb for each */
+typedef int (*line_load_priv_cb)(struct settings_store *cs, line_load_cb cb,
+				 void *cb_arg);
+
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+/**
+ * Load only the latest record of every name from a line based backend.
+ *
+ * The records are walked twice, first reading only the names to index the
+ * latest record of each, then loading the indexed records. When the index
+ * is too small all records are loaded.
+ *
+ * @param cs Backend
+ * @param load_priv Record walk of the backend
+ *
+ * @retval 0 on success, -ERCODE on storage errors
+ */
+int settings_line_load_latest(struct settings_store *cs,
+			      line_load_priv_cb load_priv);
+#endif
+
+/* Check if name is subtree or an item under it, any name if subtree is NULL */
+bool settings_name_in_subtree(const char *name, const char *subtree);
+
+/**
+ * Pass a loaded value to the handler of its name, if the name is part of the
+ * subtree being loaded.
+ *
+ * @param name Name of the value, modified while parsing it
+ * @param len Length of the value
+ * @param read_cb Function reading the value
+ * @param read_cb_arg Argument of read_cb
+ *
+ * @return return value of the handler, 0 if there is none
+ */
+int settings_call_set_handler(char *name, size_t len,
+			      settings_read_cb read_cb, void *read_cb_arg);
+
 struct settings_line_read_value_cb_ctx {
 	void *read_cb_ctx;
 	off_t off;
@@ -119,6 +160,7 @@ void settings_line_io_init(int (*read_cb)(void *ctx, off_t off, char *buf,
 			  u8_t io_rwbs);
 
 
+extern const char *settings_load_filter;
 extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
 extern struct settings_store *settings_save_dst;
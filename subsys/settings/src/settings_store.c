@@ -12,6 +12,8 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <errno.h>
+#include <kernel.h>
+#include <misc/byteorder.h>
 
 #include "settings/settings.h"
 #include "settings_priv.h"
@@ -41,22 +43,201 @@ void settings_dst_register(struct settings_store *cs)
 }
 
 int settings_load(void)
+{
+	return settings_load_subtree(NULL);
+}
+
+int settings_load_subtree(const char *subtree)
 {
 	struct settings_store *cs;
 
 	/*
 	 * for every config store
-	 *    load config
+	 *    load config of the subtree
 	 *    apply config
-	 *    commit all
+	 *    commit handlers of the subtree
 	 */
 
+	settings_load_filter = subtree;
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs);
 	}
-	return settings_commit();
+	settings_load_filter = NULL;
+
+	return settings_commit_subtree(subtree);
+}
+
+#ifdef CONFIG_SETTINGS_BATCH
+/*
+ * Values saved within a batch are kept in RAM as records of
+ * name length (1 byte), value length (2 bytes), name and value, with at most
+ * one record per name.
+ */
+#define SETTINGS_BATCH_HDR_LEN 3
+
+static struct {
+	u8_t buf[CONFIG_SETTINGS_BATCH_BUF_SIZE];
+	size_t used;
+	u8_t depth; /* nesting level of settings_batch_begin() */
+} settings_batch;
+
+static K_MUTEX_DEFINE(settings_batch_lock);
+
+static size_t settings_batch_rec_len(const u8_t *rec)
+{
+	return SETTINGS_BATCH_HDR_LEN + rec[0] + sys_get_le16(&rec[1]);
+}
+
+/* write out the buffered values, settings_batch_lock held */
+static int settings_batch_flush(struct settings_store *cs)
+{
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+	const u8_t *rec;
+	size_t off;
+	u16_t val_len;
+	int rc = 0;
+	int rc2;
+
+	if (cs->cs_itf->csi_save_start) {
+		cs->cs_itf->csi_save_start(cs);
+	}
+
+	for (off = 0; off < settings_batch.used;
+	     off += settings_batch_rec_len(rec)) {
+		rec = &settings_batch.buf[off];
+		val_len = sys_get_le16(&rec[1]);
+
+		memcpy(name, &rec[SETTINGS_BATCH_HDR_LEN], rec[0]);
+		name[rec[0]] = '\0';
+
+		rc2 = cs->cs_itf->csi_save(cs, name,
+			val_len ? (const char *)&rec[SETTINGS_BATCH_HDR_LEN +
+						     rec[0]] : NULL,
+			val_len);
+		if (!rc) {
+			rc = rc2;
+		}
+	}
+
+	if (cs->cs_itf->csi_save_end) {
+		cs->cs_itf->csi_save_end(cs);
+	}
+
+	settings_batch.used = 0;
+
+	return rc;
+}
+
+/* buffer a value, replacing an earlier value of the same name */
+static int settings_batch_add(struct settings_store *cs, const char *name,
+			      const void *value, size_t val_len)
+{
+	size_t name_len = strlen(name);
+	size_t rec_len = SETTINGS_BATCH_HDR_LEN + name_len + val_len;
+	size_t off, len;
+	u8_t *rec;
+	int rc;
+
+	if (name_len > SETTINGS_MAX_NAME_LEN ||
+	    rec_len > sizeof(settings_batch.buf)) {
+		/* can't be buffered, write it out in order */
+		rc = settings_batch_flush(cs);
+		if (rc) {
+			return rc;
+		}
+
+		return cs->cs_itf->csi_save(cs, name, value, val_len);
+	}
+
+	for (off = 0; off < settings_batch.used; off += len) {
+		rec = &settings_batch.buf[off];
+		len = settings_batch_rec_len(rec);
+
+		if (rec[0] == name_len &&
+		    !memcmp(&rec[SETTINGS_BATCH_HDR_LEN], name, name_len)) {
+			/* superseded */
+			memmove(rec, rec + len, settings_batch.used - off - len);
+			settings_batch.used -= len;
+			break;
+		}
+	}
+
+	if (settings_batch.used + rec_len > sizeof(settings_batch.buf)) {
+		rc = settings_batch_flush(cs);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rec = &settings_batch.buf[settings_batch.used];
+	rec[0] = name_len;
+	sys_put_le16(val_len, &rec[1]);
+	memcpy(&rec[SETTINGS_BATCH_HDR_LEN], name, name_len);
+	memcpy(&rec[SETTINGS_BATCH_HDR_LEN + name_len], value, val_len);
+	settings_batch.used += rec_len;
+
+	return 0;
+}
+
+int settings_batch_begin(void)
+{
+	k_mutex_lock(&settings_batch_lock, K_FOREVER);
+
+	if (settings_batch.depth == UINT8_MAX) {
+		k_mutex_unlock(&settings_batch_lock);
+		return -EBUSY;
+	}
+
+	settings_batch.depth++;
+
+	k_mutex_unlock(&settings_batch_lock);
+
+	return 0;
 }
 
+int settings_batch_commit(void)
+{
+	struct settings_store *cs;
+	int rc = 0;
+
+	k_mutex_lock(&settings_batch_lock, K_FOREVER);
+
+	if (!settings_batch.depth) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	if (--settings_batch.depth) {
+		/* committed by the outermost batch */
+		goto out;
+	}
+
+	cs = settings_save_dst;
+	if (!cs) {
+		settings_batch.used = 0;
+		rc = -ENOENT;
+		goto out;
+	}
+
+	rc = settings_batch_flush(cs);
+
+out:
+	k_mutex_unlock(&settings_batch_lock);
+
+	return rc;
+}
+
+void settings_batch_abort(void)
+{
+	k_mutex_lock(&settings_batch_lock, K_FOREVER);
+
+	settings_batch.used = 0;
+	settings_batch.depth = 0U;
+
+	k_mutex_unlock(&settings_batch_lock);
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 /*
  * Append a single value to persisted config. Don't store duplicate value.
  */
@@ -69,6 +250,25 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 		return -ENOENT;
 	}
 
+#ifdef CONFIG_SETTINGS_BATCH
+	k_mutex_lock(&settings_batch_lock, K_FOREVER);
+
+	if (settings_batch.depth) {
+		int rc;
+
+		if (!name || (val_len > 0 && value == NULL)) {
+			rc = -EINVAL;
+		} else {
+			rc = settings_batch_add(cs, name, value, val_len);
+		}
+
+		k_mutex_unlock(&settings_batch_lock);
+		return rc;
+	}
+
+	k_mutex_unlock(&settings_batch_lock);
+#endif
+
 	return cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 }
 
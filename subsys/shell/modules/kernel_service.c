@@ -13,6 +13,9 @@
 #include <misc/stack.h>
 #include <string.h>
 #include <device.h>
+#if defined(CONFIG_TRACING_THREAD_STATS)
+#include <tracing.h>
+#endif
 
 static int cmd_kernel_version(const struct shell *shell,
 			      size_t argc, char **argv)
@@ -123,6 +126,110 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SCHED_DEADLINE_CBS) && defined(CONFIG_THREAD_MONITOR)
+static void shell_edf_dump(const struct k_thread *thread, void *user_data)
+{
+	struct k_thread_reservation_stats stats;
+	const char *tname;
+
+	if (k_thread_reservation_stats_get((k_tid_t)thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get((struct k_thread *)thread);
+
+	shell_fprintf((const struct shell *)user_data, SHELL_NORMAL,
+		      "%p %-10s period %u budget %u ticks, missed %u / %u "
+		      "(last %u: %u)\n",
+		      thread, tname ? tname : "NA",
+		      thread->base.cbs.period, thread->base.cbs.budget,
+		      stats.missed, stats.periods,
+		      stats.recent_periods, stats.recent_missed);
+}
+
+static int cmd_kernel_edf(const struct shell *shell,
+			  size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_fprintf(shell, SHELL_NORMAL, "Reservations:\n");
+	k_thread_foreach(shell_edf_dump, (void *)shell);
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_TRACING_THREAD_STATS)
+static void shell_thread_stats_dump(const struct k_thread *thread,
+				    void *user_data)
+{
+	struct thread_stats stats;
+	struct cpu_stats total;
+	u64_t total_ns;
+	const char *tname;
+	unsigned int pcnt;
+
+	thread_stats_get((struct k_thread *)thread, &stats);
+	cpu_stats_get_ns(&total);
+	total_ns = total.idle + total.non_idle + total.sched;
+	pcnt = total_ns ? (stats.execution_ns * 100U) / total_ns : 0;
+
+	tname = k_thread_name_get((struct k_thread *)thread);
+
+	shell_fprintf((const struct shell *)user_data, SHELL_NORMAL,
+		      "%s%p %-10s cpu %3u %%, %u us, switches %u, "
+		      "max latency %u us\n",
+		      (thread == k_current_get()) ? "*" : " ",
+		      thread, tname ? tname : "NA", pcnt,
+		      (u32_t)(stats.execution_ns / NSEC_PER_USEC),
+		      stats.switches, stats.latency_max_ns / NSEC_PER_USEC);
+}
+
+static int cmd_kernel_thread_stats(const struct shell *shell,
+				   size_t argc, char **argv)
+{
+	struct cpu_stats stats;
+	u64_t total;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_fprintf(shell, SHELL_NORMAL, "Threads:\n");
+	k_thread_foreach(shell_thread_stats_dump, (void *)shell);
+
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cpu_stats_cpu_get_ns(i, &stats);
+		total = stats.idle + stats.non_idle + stats.sched;
+		shell_fprintf(shell, SHELL_NORMAL, "CPU %u usage: %u %%\n", i,
+			      total ? (u32_t)(((stats.non_idle + stats.sched) *
+					       100U) / total) : 0);
+	}
+	return 0;
+}
+
+static int cmd_kernel_thread_stats_reset(const struct shell *shell,
+					 size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	cpu_stats_reset_counters();
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_thread_stats,
+	SHELL_CMD(reset, NULL, "Reset statistics.",
+		  cmd_kernel_thread_stats_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_thread,
+	SHELL_CMD(stats, &sub_kernel_thread_stats,
+		  "List threads runtime statistics.", cmd_kernel_thread_stats),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -151,6 +258,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_SCHED_DEADLINE_CBS) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD(edf, NULL, "List EDF reservations and missed deadlines.",
+		  cmd_kernel_edf),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
@@ -158,6 +269,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 				&& defined(CONFIG_THREAD_STACK_INFO)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
 	SHELL_CMD(threads, NULL, "List kernel threads.", cmd_kernel_threads),
+#endif
+#if defined(CONFIG_TRACING_THREAD_STATS)
+	SHELL_CMD(thread, &sub_kernel_thread, "Thread commands.", NULL),
 #endif
 	SHELL_CMD(uptime, NULL, "Kernel uptime.", cmd_kernel_uptime),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
@@ -1024,6 +1024,31 @@ static void transport_evt_handler(enum shell_transport_evt evt_type, void *ctx)
 			&shell->ctx->signals[SHELL_SIGNAL_RXRDY] :
 			&shell->ctx->signals[SHELL_SIGNAL_TXDONE];
 	k_poll_signal_raise(signal, 0);
+
+	/* Resume log output deferred for lack of transport room. */
+	if ((evt_type == SHELL_TRANSPORT_EVT_TX_RDY) &&
+	    shell->ctx->internal.flags.log_deferred) {
+		k_poll_signal_raise(&shell->ctx->signals[SHELL_SIGNAL_LOG_MSG],
+				    0);
+	}
+}
+
+/* Check if the transport can take a log message without blocking. */
+static bool log_tx_room(const struct shell *shell)
+{
+#ifdef CONFIG_SHELL_LOG_BACKEND
+	if (shell->iface->api->tx_free_get == NULL) {
+		return true;
+	}
+
+	shell->ctx->internal.flags.log_deferred = 1;
+	if (shell->iface->api->tx_free_get(shell->iface) <
+	    CONFIG_SHELL_LOG_BACKEND_TX_THRESHOLD) {
+		return false;
+	}
+	shell->ctx->internal.flags.log_deferred = 0;
+#endif
+	return true;
 }
 
 static void shell_log_process(const struct shell *shell)
@@ -1034,6 +1059,10 @@ static void shell_log_process(const struct shell *shell)
 
 	do {
 		if (!IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
+			if (!log_tx_room(shell)) {
+				break;
+			}
+
 			shell_cmd_line_erase(shell);
 
 			processed = shell_log_backend_process(shell->log_backend);
@@ -131,6 +131,129 @@ static void uart_callback(void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+/* Start sending the next contiguous chunk of the TX ring buffer, if idle.
+ * Called from both the shell thread and the UART callback.
+ */
+static void async_tx_start(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	unsigned int key;
+	u8_t *data;
+	u32_t len;
+	int err;
+
+	key = irq_lock();
+
+	if (ctrl_blk->tx_len == 0U) {
+		len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+					 sh_uart->tx_ringbuf->size);
+		if (len) {
+			ctrl_blk->tx_len = len;
+			err = uart_tx(ctrl_blk->dev, data, len, K_FOREVER);
+			if (err) {
+				LOG_ERR("TX failed (%d)", err);
+				(void)ring_buf_get_finish(sh_uart->tx_ringbuf,
+							  len);
+				ctrl_blk->tx_len = 0U;
+			}
+		} else {
+			ctrl_blk->tx_busy = 0;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+static void async_rx_handle(const struct shell_uart *sh_uart, u8_t *data,
+			    size_t len)
+{
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+	/* Divert bytes from shell handling if they are part of an mcumgr
+	 * frame.
+	 */
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (!smp_shell_rx_byte(&sh_uart->ctrl_blk->smp, data[i])) {
+			break;
+		}
+	}
+	data += i;
+	len -= i;
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+
+	if (len == 0) {
+		return;
+	}
+
+	if (ring_buf_put(sh_uart->rx_ringbuf, data, len) < len) {
+		LOG_WRN("RX ring buffer full.");
+	}
+
+	sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				   sh_uart->ctrl_blk->context);
+}
+
+static void async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	ctrl_blk->rx_buf_idx = 0U;
+	err = uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_buf[0],
+			     sizeof(ctrl_blk->rx_buf[0]),
+			     CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_TIMEOUT);
+	if (err) {
+		LOG_ERR("RX enable failed (%d)", err);
+	}
+}
+
+static void async_callback(struct uart_event *evt, void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		err = ring_buf_get_finish(sh_uart->tx_ringbuf,
+					  ctrl_blk->tx_len);
+		__ASSERT_NO_MSG(err == 0);
+		ctrl_blk->tx_len = 0U;
+
+		if (!ctrl_blk->blocking_tx) {
+			async_tx_start(sh_uart);
+		}
+
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
+				  ctrl_blk->context);
+		break;
+
+	case UART_RX_RDY:
+		async_rx_handle(sh_uart, evt->data.rx.buf + evt->data.rx.offset,
+				evt->data.rx.len);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		ctrl_blk->rx_buf_idx ^= 1U;
+		err = uart_rx_buf_rsp(ctrl_blk->dev,
+				      ctrl_blk->rx_buf[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_buf[0]));
+		__ASSERT_NO_MSG(err == 0);
+		break;
+
+	case UART_RX_DISABLED:
+		async_rx_enable(sh_uart);
+		break;
+
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -169,6 +292,12 @@ static int init(const struct shell_transport *transport,
 
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		uart_callback_set(sh_uart->ctrl_blk->dev, async_callback,
+				  (void *)sh_uart);
+		async_rx_enable(sh_uart);
+#endif
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
 		k_timer_user_data_set(sh_uart->timer, (void *)sh_uart);
@@ -192,6 +321,9 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 	if (blocking_tx) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
+#endif
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
 #endif
 	}
 
@@ -210,6 +342,24 @@ static void irq_write(const struct shell_uart *sh_uart, const void *data,
 	}
 }
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+static void async_write(const struct shell_uart *sh_uart, const void *data,
+			size_t length, size_t *cnt)
+{
+	*cnt = ring_buf_put(sh_uart->tx_ringbuf, data, length);
+
+	atomic_set(&sh_uart->ctrl_blk->tx_busy, 1);
+	async_tx_start(sh_uart);
+}
+
+static size_t tx_free_get(const struct shell_transport *transport)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
+
+	return ring_buf_space_get(sh_uart->tx_ringbuf);
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static int write(const struct shell_transport *transport,
 		 const void *data, size_t length, size_t *cnt)
 {
@@ -219,6 +369,10 @@ static int write(const struct shell_transport *transport,
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	} else if (!sh_uart->ctrl_blk->blocking_tx) {
+		async_write(sh_uart, data, length, cnt);
+#endif
 	} else {
 		for (size_t i = 0; i < length; i++) {
 			uart_poll_out(sh_uart->ctrl_blk->dev, data8[i]);
@@ -261,6 +415,9 @@ const struct shell_transport_api shell_uart_transport_api = {
 #ifdef CONFIG_MCUMGR_SMP_SHELL
 	.update = update,
 #endif /* CONFIG_MCUMGR_SMP_SHELL */
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	.tx_free_get = tx_free_get,
+#endif
 };
 
 static int enable_shell_uart(struct device *arg)
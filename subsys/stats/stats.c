@@ -10,35 +10,63 @@
 #include <errno.h>
 #include <zephyr/types.h>
 #include <stats.h>
+#include <misc/byteorder.h>
 
-#define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
+/* Holds generated names, "s<idx>" or "<histogram>_<bucket>" */
+#define STATS_GEN_NAME_MAX_LEN  32
 
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
-static const char *
-stats_get_name(const struct stats_hdr *hdr, int idx)
-{
 #ifdef CONFIG_STATS_NAMES
+/* Finds the name map entry covering entry idx, be it a histogram bucket. */
+static const struct stats_name_map *
+stats_get_map(const struct stats_hdr *hdr, int idx)
+{
 	const struct stats_name_map *cur;
 	u16_t off;
 	int i;
 
-	/* The stats name map contains two elements, an offset into the
-	 * statistics entry structure, and the name corresponding to that
-	 * offset.  This annotation allows for naming only certain statistics,
-	 * and doesn't enforce ordering restrictions on the stats name map.
+	/* The stats name map contains an offset into the statistics entry
+	 * structure, the name corresponding to that offset and, for
+	 * histograms, the number of buckets.  This annotation allows for
+	 * naming only certain statistics, and doesn't enforce ordering
+	 * restrictions on the stats name map.
 	 */
 	off = sizeof(*hdr) + idx * hdr->s_size;
 	for (i = 0; i < hdr->s_map_cnt; i++) {
 		cur = hdr->s_map + i;
-		if (cur->snm_off == off) {
-			return cur->snm_name;
+		if (off >= cur->snm_off &&
+		    off < cur->snm_off + MAX(cur->snm_cnt, 1) * hdr->s_size) {
+			return cur;
 		}
 	}
+
+	return NULL;
+}
 #endif
 
+static const char *
+stats_get_name(const struct stats_hdr *hdr, int idx, char *buf)
+{
+#ifdef CONFIG_STATS_NAMES
+	const struct stats_name_map *cur = stats_get_map(hdr, idx);
+	u16_t off = sizeof(*hdr) + idx * hdr->s_size;
+
+	if (cur == NULL) {
+		return NULL;
+	}
+
+	if (cur->snm_cnt == 0) {
+		return cur->snm_name;
+	}
+
+	snprintf(buf, STATS_GEN_NAME_MAX_LEN, "%s_%u", cur->snm_name,
+		 (off - cur->snm_off) / hdr->s_size);
+	return buf;
+#else
 	return NULL;
+#endif
 }
 
 static u16_t
@@ -102,7 +130,7 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 	int i;
 
 	for (i = 0; i < hdr->s_cnt; i++) {
-		name = stats_get_name(hdr, i);
+		name = stats_get_name(hdr, i, name_buf);
 		if (name == NULL) {
 			/* No assigned name; generate a temporary s<#> name. */
 			stats_gen_name(i, name_buf);
@@ -118,6 +146,147 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 	return 0;
 }
 
+#ifdef CONFIG_STATS_BINARY
+/* Gets the span of the schema record starting at entry idx, and its name. */
+static u16_t
+stats_get_record(const struct stats_hdr *hdr, int idx, const char **name,
+		 char *buf)
+{
+#ifdef CONFIG_STATS_NAMES
+	const struct stats_name_map *cur = stats_get_map(hdr, idx);
+
+	if (cur != NULL) {
+		*name = cur->snm_name;
+		return MAX(cur->snm_cnt, 1);
+	}
+#endif
+
+	stats_gen_name(idx, buf);
+	*name = buf;
+	return 1;
+}
+
+/* FNV-1a hash of the layout and names of the entries. */
+static u32_t
+stats_schema_id(const struct stats_hdr *hdr)
+{
+	char name_buf[STATS_GEN_NAME_MAX_LEN];
+	const char *name;
+	u32_t hash = 2166136261U;
+	u16_t span;
+	int i;
+
+	hash = (hash ^ hdr->s_size) * 16777619U;
+	hash = (hash ^ hdr->s_cnt) * 16777619U;
+
+	for (i = 0; i < hdr->s_cnt; i += span) {
+		span = stats_get_record(hdr, i, &name, name_buf);
+		hash = (hash ^ span) * 16777619U;
+		while (*name != '\0') {
+			hash = (hash ^ (u8_t)*name++) * 16777619U;
+		}
+	}
+
+	return hash;
+}
+
+int
+stats_schema_encode(const struct stats_hdr *hdr, u8_t *buf, size_t len)
+{
+	char name_buf[STATS_GEN_NAME_MAX_LEN];
+	const char *name;
+	size_t name_len;
+	size_t pos;
+	u16_t span;
+	int i;
+
+	if (len < 7) {
+		return -ENOMEM;
+	}
+
+	sys_put_le32(hdr->s_schema_id, buf);
+	buf[4] = hdr->s_size;
+	sys_put_le16(hdr->s_cnt, &buf[5]);
+	pos = 7;
+
+	for (i = 0; i < hdr->s_cnt; i += span) {
+		span = stats_get_record(hdr, i, &name, name_buf);
+		name_len = MIN(strlen(name), UINT8_MAX);
+
+		if (pos + 3 + name_len > len) {
+			return -ENOMEM;
+		}
+
+		sys_put_le16(span, &buf[pos]);
+		buf[pos + 2] = name_len;
+		memcpy(&buf[pos + 3], name, name_len);
+		pos += 3 + name_len;
+	}
+
+	return pos;
+}
+
+int
+stats_values_encode(const struct stats_hdr *hdr, u8_t *buf, size_t len)
+{
+	size_t pos;
+	u64_t val;
+	int i;
+
+	if (len < 4 + (size_t)hdr->s_size * hdr->s_cnt) {
+		return -ENOMEM;
+	}
+
+	sys_put_le32(hdr->s_schema_id, buf);
+	pos = 4;
+
+	for (i = 0; i < hdr->s_cnt; i++) {
+		val = stats_value_get(hdr, stats_get_off(hdr, i));
+
+		switch (hdr->s_size) {
+		case sizeof(u16_t):
+			sys_put_le16(val, &buf[pos]);
+			break;
+		case sizeof(u32_t):
+			sys_put_le32(val, &buf[pos]);
+			break;
+		default:
+			sys_put_le64(val, &buf[pos]);
+			break;
+		}
+		pos += hdr->s_size;
+	}
+
+	return pos;
+}
+#endif /* CONFIG_STATS_BINARY */
+
+u64_t
+stats_value_get(const struct stats_hdr *hdr, u16_t off)
+{
+	const u8_t *val = (const u8_t *)hdr + off;
+	/* The copies of the CPUs follow each other */
+	size_t stride = hdr->s_size * hdr->s_cnt;
+	u64_t sum = 0U;
+	int cpu;
+
+	for (cpu = 0; cpu < Z_STATS_NUM_CPUS; cpu++, val += stride) {
+		switch (hdr->s_size) {
+		case sizeof(u16_t):
+			sum += *(const u16_t *)val;
+			break;
+		case sizeof(u32_t):
+			sum += *(const u32_t *)val;
+			break;
+		default:
+			sum += *(const u64_t *)val;
+			break;
+		}
+	}
+
+	return sum;
+}
+
 /**
  * Initialize a statistics structure, pointed to by hdr.
  *
@@ -140,6 +309,9 @@ stats_init(struct stats_hdr *hdr, u8_t size, u16_t cnt,
 	hdr->s_map = map;
 	hdr->s_map_cnt = map_cnt;
 #endif
+#ifdef CONFIG_STATS_BINARY
+	hdr->s_schema_id = stats_schema_id(hdr);
+#endif
 
 	stats_reset(hdr);
 }
@@ -281,5 +453,5 @@ stats_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
 void
 stats_reset(struct stats_hdr *hdr)
 {
-	(void)memset(hdr + 1, 0, hdr->s_size * hdr->s_cnt);
+	(void)memset(hdr + 1, 0, hdr->s_size * hdr->s_cnt * Z_STATS_NUM_CPUS);
 }
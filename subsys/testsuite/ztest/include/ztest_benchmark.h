@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Zephyr testing framework benchmarks.
+ *
+ * A benchmark runs a function a number of times after some untimed warmup
+ * runs, timing each run in cycles of the finest counter of the CPU. The
+ * statistics of the runs are printed as a line starting with BENCH: and
+ * holding a JSON object, or BENCH_CSV: and the comma-separated values,
+ * for a test runner to collect from the console.
+ */
+
+#ifndef __ZTEST_BENCHMARK_H__
+#define __ZTEST_BENCHMARK_H__
+
+#include <zephyr/types.h>
+
+/**
+ * @defgroup ztest_benchmark Ztest benchmarks
+ * @ingroup ztest
+ *
+ * This module times functions and reports their statistics in a
+ * machine-readable form.
+ *
+ * @{
+ */
+
+struct ztest_benchmark {
+	const char *name;
+	u32_t warmup;
+	u32_t iterations;
+	u32_t *samples;
+};
+
+/** Statistics of the runs of a benchmark, in cycles */
+struct ztest_benchmark_stats {
+	u32_t iterations;
+	u32_t min;
+	u32_t max;
+	u32_t mean;
+	u32_t p50;
+	u32_t p99;
+	u32_t stddev;
+};
+
+enum ztest_benchmark_format {
+	ZTEST_BENCHMARK_JSON,
+	ZTEST_BENCHMARK_CSV,
+};
+
+/**
+ * @brief Define a benchmark
+ *
+ * @param _name Name of the benchmark, as reported
+ * @param _warmup Number of untimed runs before the timed ones
+ * @param _iterations Number of timed runs
+ */
+#define ZTEST_BENCHMARK_DEFINE(_name, _warmup, _iterations)		\
+	static u32_t _ztest_benchmark_samples_##_name[_iterations];	\
+	static struct ztest_benchmark _name = {				\
+		.name = #_name,						\
+		.warmup = _warmup,					\
+		.iterations = _iterations,				\
+		.samples = _ztest_benchmark_samples_##_name,		\
+	}
+
+/**
+ * @brief Read the benchmark cycle counter
+ *
+ * The cycle counter of the CPU where there is one, the DWT cycle counter
+ * on Cortex-M3 and later, otherwise the system timer.
+ */
+u32_t ztest_benchmark_cycles(void);
+
+/** @brief Frequency of the benchmark cycle counter, in Hz */
+u32_t ztest_benchmark_cycles_per_sec(void);
+
+/**
+ * @brief Select the format of the reports
+ *
+ * @param format ZTEST_BENCHMARK_JSON, the default, or ZTEST_BENCHMARK_CSV
+ */
+void ztest_benchmark_format_set(enum ztest_benchmark_format format);
+
+/**
+ * @brief Compute the statistics of samples
+ *
+ * @param samples Cycles of each run, sorted on return
+ * @param count Number of samples
+ * @param stats Statistics of the samples
+ */
+void ztest_benchmark_stats_compute(u32_t *samples, u32_t count,
+				   struct ztest_benchmark_stats *stats);
+
+/**
+ * @brief Report the statistics of a benchmark
+ *
+ * @param name Name of the benchmark
+ * @param stats Statistics of its runs
+ */
+void ztest_benchmark_report(const char *name,
+			    const struct ztest_benchmark_stats *stats);
+
+/**
+ * @brief Report a single measured value
+ *
+ * For the results that are not cycles per run, such as a throughput. The
+ * value is reported as the statistics of one run.
+ *
+ * @param name Name of the benchmark
+ * @param unit Unit of the value
+ * @param value Measured value
+ */
+void ztest_benchmark_report_value(const char *name, const char *unit,
+				  u32_t value);
+
+/**
+ * @brief Run a benchmark
+ *
+ * Runs @a fn the number of warmup times, then the number of iterations
+ * times, each timed, and reports the statistics of the timed runs. The
+ * cost of reading the cycle counter is deducted from each run.
+ *
+ * @param bench Benchmark, as defined by ZTEST_BENCHMARK_DEFINE()
+ * @param fn Function to time
+ * @param arg Argument of @a fn
+ * @param stats Statistics of the runs if not NULL
+ */
+void ztest_benchmark_run(struct ztest_benchmark *bench,
+			 void (*fn)(void *arg), void *arg,
+			 struct ztest_benchmark_stats *stats);
+
+/**
+ * @}
+ */
+
+#endif /* __ZTEST_BENCHMARK_H__ */
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <ztest_benchmark.h>
+
+#ifdef KERNEL
+#include <test_asm_inline_gcc.h>
+
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+#include <arch/arm/cortex_m/cmsis.h>
+
+/* Not provided by the SoCs without a CMSIS system file */
+extern uint32_t SystemCoreClock __weak;
+#endif
+#endif
+
+static enum ztest_benchmark_format format;
+static bool csv_header;
+
+/*
+ * The DWT cycle counter is not implemented on all parts, nor emulated by
+ * QEMU: it is used only once seen counting.
+ */
+static bool dwt_counting;
+static bool timer_ready;
+
+static void timer_init(void)
+{
+#if defined(KERNEL) && defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+	u32_t start;
+
+	if (&SystemCoreClock != NULL && SystemCoreClock != 0U) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+		start = DWT->CYCCNT;
+		for (volatile int i = 0; i < 16; i++) {
+		}
+		dwt_counting = DWT->CYCCNT != start;
+	}
+#endif
+	timer_ready = true;
+}
+
+u32_t ztest_benchmark_cycles(void)
+{
+#ifdef KERNEL
+	timestamp_serialize();
+
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+	if (dwt_counting) {
+		return DWT->CYCCNT;
+	}
+#endif
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+u32_t ztest_benchmark_cycles_per_sec(void)
+{
+	if (!timer_ready) {
+		timer_init();
+	}
+
+#if defined(KERNEL) && defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+	if (dwt_counting) {
+		return SystemCoreClock;
+	}
+#endif
+#ifdef KERNEL
+	return sys_clock_hw_cycles_per_sec();
+#else
+	return 0;
+#endif
+}
+
+void ztest_benchmark_format_set(enum ztest_benchmark_format f)
+{
+	format = f;
+}
+
+/* Shell sort, there is no qsort() in the minimal libc */
+static void samples_sort(u32_t *samples, u32_t count)
+{
+	u32_t gap, i, j, v;
+
+	for (gap = count / 2U; gap > 0U; gap /= 2U) {
+		for (i = gap; i < count; i++) {
+			v = samples[i];
+			for (j = i; j >= gap && samples[j - gap] > v;
+			     j -= gap) {
+				samples[j] = samples[j - gap];
+			}
+			samples[j] = v;
+		}
+	}
+}
+
+static u32_t isqrt(u64_t n)
+{
+	u64_t bit = 1ULL << 62;
+	u64_t root = 0U;
+
+	while (bit > n) {
+		bit >>= 2;
+	}
+
+	while (bit != 0U) {
+		if (n >= root + bit) {
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (u32_t)root;
+}
+
+void ztest_benchmark_stats_compute(u32_t *samples, u32_t count,
+				   struct ztest_benchmark_stats *stats)
+{
+	u64_t sum = 0U;
+	u64_t var = 0U;
+	u32_t i;
+	s64_t d;
+
+	*stats = (struct ztest_benchmark_stats) { .iterations = count };
+	if (count == 0U) {
+		return;
+	}
+
+	samples_sort(samples, count);
+
+	for (i = 0U; i < count; i++) {
+		sum += samples[i];
+	}
+	stats->mean = (u32_t)((sum + count / 2U) / count);
+
+	for (i = 0U; i < count; i++) {
+		d = (s64_t)samples[i] - stats->mean;
+		var += (u64_t)(d * d);
+	}
+
+	stats->min = samples[0];
+	stats->max = samples[count - 1U];
+	/* Nearest-rank percentiles */
+	stats->p50 = samples[(count * 50U + 99U) / 100U - 1U];
+	stats->p99 = samples[(count * 99U + 99U) / 100U - 1U];
+	stats->stddev = isqrt(var / count);
+}
+
+static void report(const char *name, const char *unit, u32_t hz,
+		   const struct ztest_benchmark_stats *stats)
+{
+	if (format == ZTEST_BENCHMARK_CSV) {
+		if (!csv_header) {
+			printk("BENCH_CSV:name,unit,hz,iterations,min,max,"
+			       "mean,p50,p99,stddev\n");
+			csv_header = true;
+		}
+		printk("BENCH_CSV:%s,%s,%u,%u,%u,%u,%u,%u,%u,%u\n",
+		       name, unit, hz, stats->iterations, stats->min,
+		       stats->max, stats->mean, stats->p50, stats->p99,
+		       stats->stddev);
+		return;
+	}
+
+	printk("BENCH:{\"name\":\"%s\",\"unit\":\"%s\",\"hz\":%u,"
+	       "\"iterations\":%u,\"min\":%u,\"max\":%u,\"mean\":%u,"
+	       "\"p50\":%u,\"p99\":%u,\"stddev\":%u}\n",
+	       name, unit, hz, stats->iterations, stats->min, stats->max,
+	       stats->mean, stats->p50, stats->p99, stats->stddev);
+}
+
+void ztest_benchmark_report(const char *name,
+			    const struct ztest_benchmark_stats *stats)
+{
+	report(name, "cycles", ztest_benchmark_cycles_per_sec(), stats);
+}
+
+void ztest_benchmark_report_value(const char *name, const char *unit,
+				  u32_t value)
+{
+	struct ztest_benchmark_stats stats = {
+		.iterations = 1U,
+		.min = value,
+		.max = value,
+		.mean = value,
+		.p50 = value,
+		.p99 = value,
+	};
+
+	report(name, unit, 0U, &stats);
+}
+
+void ztest_benchmark_run(struct ztest_benchmark *bench,
+			 void (*fn)(void *arg), void *arg,
+			 struct ztest_benchmark_stats *stats)
+{
+	struct ztest_benchmark_stats local;
+	u32_t overhead = UINT32_MAX;
+	u32_t start, end;
+	u32_t i;
+
+	if (!timer_ready) {
+		timer_init();
+	}
+
+	for (i = 0U; i < 16U; i++) {
+		start = ztest_benchmark_cycles();
+		end = ztest_benchmark_cycles();
+		overhead = MIN(overhead, end - start);
+	}
+
+	for (i = 0U; i < bench->warmup; i++) {
+		fn(arg);
+	}
+
+	for (i = 0U; i < bench->iterations; i++) {
+		start = ztest_benchmark_cycles();
+		fn(arg);
+		end = ztest_benchmark_cycles();
+
+		end -= start;
+		bench->samples[i] = (end > overhead) ? end - overhead : 0U;
+	}
+
+	if (stats == NULL) {
+		stats = &local;
+	}
+
+	ztest_benchmark_stats_compute(bench->samples, bench->iterations,
+				      stats);
+	ztest_benchmark_report(bench->name, stats);
+}
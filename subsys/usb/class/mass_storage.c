@@ -55,6 +55,9 @@ LOG_MODULE_REGISTER(usb_msc);
 #define DISK_THREAD_STACK_SZ	512
 #define DISK_THREAD_PRIO	-5
 
+#define MSC_BUF_SECTORS		CONFIG_MASS_STORAGE_BUF_SECTORS
+#define MSC_BUF_SIZE		(MSC_BUF_SECTORS * BLOCK_SIZE)
+
 #define THREAD_OP_READ_QUEUED		1
 #define THREAD_OP_WRITE_QUEUED		3
 #define THREAD_OP_WRITE_DONE		4
@@ -107,13 +110,18 @@ static volatile int thread_op;
 static K_THREAD_STACK_DEFINE(mass_thread_stack, DISK_THREAD_STACK_SZ);
 static struct k_thread mass_thread_data;
 static struct k_sem disk_wait_sem;
-static volatile u32_t defered_wr_sz;
 
-static u8_t page[BLOCK_SIZE];
+/* Data stage buffers, one moved by USB while the disk uses the other */
+static u8_t __aligned(4) msc_buf[2][MSC_BUF_SIZE];
+
+/* Completion of the data stage transfer, negative length if cancelled */
+static struct k_sem xfer_sem;
+static volatile int xfer_len;
 
 /* Initialized during mass_storage_init() */
 static u32_t memory_size;
 static u32_t block_count;
+static u32_t erase_block_count;
 static const char *disk_pdrv = CONFIG_MASS_STORAGE_DISK_NAME;
 
 #define MSD_OUT_EP_IDX			0
@@ -181,7 +189,7 @@ static void msd_init(void)
 {
 	(void)memset((void *)&cbw, 0, sizeof(struct CBW));
 	(void)memset((void *)&csw, 0, sizeof(struct CSW));
-	(void)memset(page, 0, sizeof(page));
+	(void)memset(msc_buf, 0, sizeof(msc_buf));
 	addr = 0U;
 	length = 0U;
 }
@@ -365,63 +373,192 @@ static bool readCapacity(void)
 	return write(capacity, sizeof(capacity));
 }
 
-static void thread_memory_read_done(void)
+static void msd_xfer_done(u8_t ep, int tsize, void *priv)
 {
-	u32_t n;
+	ARG_UNUSED(ep);
+	ARG_UNUSED(priv);
 
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
+	xfer_len = tsize;
+	k_sem_give(&xfer_sem);
+}
+
+/* Unblocks the disk thread waiting for a transfer cancelled by the stack */
+static void msd_xfer_abort(void)
+{
+	usb_cancel_transfer(mass_ep_data[MSD_IN_EP_IDX].ep_addr);
+	usb_cancel_transfer(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+	xfer_len = -ECANCELED;
+	k_sem_give(&xfer_sem);
+}
+
+static bool msd_range_valid(u32_t sector, u32_t count)
+{
+	return count <= block_count && sector <= block_count - count;
+}
+
+static void msd_data_stage_end(u8_t ep, int rc)
+{
+	if (rc) {
+		LOG_ERR("Data stage error %d", rc);
+		usb_cancel_transfer(ep);
+		LOG_WRN("Stall EP 0x%x", ep);
+		usb_ep_set_stall(ep);
+		csw.Status = CSW_FAILED;
+	} else {
+		csw.Status = CSW_PASSED;
 	}
 
-	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		&page[addr % BLOCK_SIZE], n, NULL) != 0) {
-		LOG_ERR("Failed to write EP 0x%x",
-			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
+	sendCSW();
+}
+
+/*
+ * Sends the sectors of a READ, the disk reading the next chunk while USB
+ * sends the previous one.
+ */
+static void thread_memory_read(void)
+{
+	u8_t ep = mass_ep_data[MSD_IN_EP_IDX].ep_addr;
+	u32_t sector = addr / BLOCK_SIZE;
+	u32_t count = length / BLOCK_SIZE;
+	u32_t n = MIN(count, MSC_BUF_SECTORS);
+	int buf = 0;
+	int rc;
+
+	k_sem_reset(&xfer_sem);
+
+	if (!msd_range_valid(sector, count)) {
+		msd_data_stage_end(ep, -EINVAL);
+		return;
 	}
-	addr += n;
-	length -= n;
 
-	csw.DataResidue -= n;
+	rc = disk_access_read(disk_pdrv, msc_buf[buf], sector, n);
 
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
+	while (!rc) {
+		u32_t len = n * BLOCK_SIZE;
+
+		/* the host asked for the exact length, no ZLP */
+		rc = usb_transfer(ep, msc_buf[buf], len,
+				  USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+				  msd_xfer_done, NULL);
+		if (rc) {
+			break;
+		}
+
+		sector += n;
+		count -= n;
+		n = MIN(count, MSC_BUF_SECTORS);
+		buf = !buf;
+
+		if (n) {
+			rc = disk_access_read(disk_pdrv, msc_buf[buf],
+					      sector, n);
+		}
+
+		k_sem_take(&xfer_sem, K_FOREVER);
+		if (xfer_len < 0) {
+			/* USB reset, no CSW */
+			return;
+		}
+
+		csw.DataResidue -= xfer_len;
+		if ((u32_t)xfer_len != len) {
+			rc = -EIO;
+		}
+
+		if (!n) {
+			break;
+		}
 	}
-}
 
+	msd_data_stage_end(ep, rc);
+}
 
-static void memoryRead(void)
+/* Sectors of the next chunk to write, up to an erase block boundary */
+static u32_t msd_write_chunk(u32_t sector, u32_t count)
 {
-	u32_t n;
+	u32_t n = MIN(count, MSC_BUF_SECTORS);
+	u32_t end = ROUND_DOWN(sector + n, erase_block_count);
 
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
+	if (n == MSC_BUF_SECTORS && end > sector) {
+		n = end - sector;
 	}
 
-	/* we read an entire block */
-	if (!(addr % BLOCK_SIZE)) {
-		thread_op = THREAD_OP_READ_QUEUED;
-		LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
-		k_sem_give(&disk_wait_sem);
-		return;
+	return n;
+}
+
+/*
+ * Receives the sectors of a WRITE, USB receiving the next chunk while the
+ * disk writes the previous one.
+ */
+static void thread_memory_write(void)
+{
+	u8_t ep = mass_ep_data[MSD_OUT_EP_IDX].ep_addr;
+	u32_t sector = addr / BLOCK_SIZE;
+	u32_t count = length / BLOCK_SIZE;
+	u32_t n = msd_write_chunk(sector, count);
+	int buf = 0;
+	int rc;
+
+	k_sem_reset(&xfer_sem);
+
+	if (!msd_range_valid(sector, count)) {
+		rc = -EINVAL;
+	} else if (disk_access_status(disk_pdrv) & DISK_STATUS_WR_PROTECT) {
+		rc = -EROFS;
+	} else {
+		rc = usb_transfer(ep, msc_buf[buf], n * BLOCK_SIZE,
+				  USB_TRANS_READ, msd_xfer_done, NULL);
 	}
-	usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		  &page[addr % BLOCK_SIZE], n, NULL);
-	addr += n;
-	length -= n;
 
-	csw.DataResidue -= n;
+	while (!rc) {
+		u32_t len = n * BLOCK_SIZE;
+		u32_t next;
 
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
+		k_sem_take(&xfer_sem, K_FOREVER);
+		if (xfer_len < 0) {
+			/* USB reset, no CSW */
+			return;
+		}
+
+		csw.DataResidue -= xfer_len;
+		if ((u32_t)xfer_len != len) {
+			rc = -EIO;
+			break;
+		}
+
+		next = msd_write_chunk(sector + n, count - n);
+		if (next) {
+			rc = usb_transfer(ep, msc_buf[!buf], next * BLOCK_SIZE,
+					  USB_TRANS_READ, msd_xfer_done, NULL);
+		}
+
+		if (!rc) {
+			rc = disk_access_write(disk_pdrv, msc_buf[buf],
+					       sector, n);
+		}
+
+		sector += n;
+		count -= n;
+		n = next;
+		buf = !buf;
+
+		if (!n) {
+			break;
+		}
+	}
+
+	/*
+	 * The host assumes there is no write cache, the data is on the disk
+	 * once the CSW is sent.
+	 */
+	if (!rc) {
+		rc = disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL);
 	}
+
+	thread_op = THREAD_OP_WRITE_DONE;
+	usb_ep_read_continue(ep);
+
+	msd_data_stage_end(ep, rc);
 }
 
 static bool infoTransfer(void)
@@ -534,7 +671,8 @@ static void CBWDecode(u8_t *buf, u16_t size)
 			if (infoTransfer()) {
 				if ((cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
-					memoryRead();
+					thread_op = THREAD_OP_READ_QUEUED;
+					k_sem_give(&disk_wait_sem);
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
@@ -550,6 +688,8 @@ static void CBWDecode(u8_t *buf, u16_t size)
 			if (infoTransfer()) {
 				if (!(cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
+					thread_op = THREAD_OP_WRITE_QUEUED;
+					k_sem_give(&disk_wait_sem);
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_IN_EP_IDX].ep_addr);
@@ -607,14 +747,15 @@ static void memoryVerify(u8_t *buf, u16_t size)
 	/* beginning of a new block -> load a whole block in RAM */
 	if (!(addr % BLOCK_SIZE)) {
 		LOG_DBG("Disk READ sector %d", addr/BLOCK_SIZE);
-		if (disk_access_read(disk_pdrv, page, addr/BLOCK_SIZE, 1)) {
+		if (disk_access_read(disk_pdrv, msc_buf[0], addr/BLOCK_SIZE,
+				     1)) {
 			LOG_ERR("---- Disk Read Error %d", addr/BLOCK_SIZE);
 		}
 	}
 
 	/* info are in RAM -> no need to re-read memory */
 	for (n = 0U; n < size; n++) {
-		if (page[addr%BLOCK_SIZE + n] != buf[n]) {
+		if (msc_buf[0][addr%BLOCK_SIZE + n] != buf[n]) {
 			LOG_DBG("Mismatch sector %d offset %d",
 				addr/BLOCK_SIZE, n);
 			memOK = false;
@@ -633,50 +774,17 @@ static void memoryVerify(u8_t *buf, u16_t size)
 	}
 }
 
-static void memoryWrite(u8_t *buf, u16_t size)
-{
-	if ((addr + size) > memory_size) {
-		size = memory_size - addr;
-		stage = MSC_ERROR;
-		usb_ep_set_stall(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
-		LOG_WRN("Stall OUT endpoint");
-	}
-
-	/* we fill an array in RAM of 1 block before writing it in memory */
-	for (int i = 0; i < size; i++) {
-		page[addr % BLOCK_SIZE + i] = buf[i];
-	}
-
-	/* if the array is filled, write it in memory */
-	if (!((addr + size) % BLOCK_SIZE)) {
-		if (!(disk_access_status(disk_pdrv) &
-					DISK_STATUS_WR_PROTECT)) {
-			LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
-			thread_op = THREAD_OP_WRITE_QUEUED;  /* write_queued */
-			defered_wr_sz = size;
-			k_sem_give(&disk_wait_sem);
-			return;
-		}
-	}
-
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
-
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
-	}
-}
-
-
 static void mass_storage_bulk_out(u8_t ep,
 		enum usb_dc_ep_cb_status_code ep_status)
 {
 	u32_t bytes_read = 0U;
 	u8_t bo_buf[CONFIG_MASS_STORAGE_BULK_EP_MPS];
 
-	ARG_UNUSED(ep_status);
+	if (usb_transfer_is_busy(ep)) {
+		/* data stage, moved by the disk thread */
+		usb_transfer_ep_callback(ep, ep_status);
+		return;
+	}
 
 	usb_ep_read_wait(ep, bo_buf, CONFIG_MASS_STORAGE_BULK_EP_MPS,
 			 &bytes_read);
@@ -691,11 +799,6 @@ static void mass_storage_bulk_out(u8_t ep,
 	/*the device has to receive data from the host*/
 	case MSC_PROCESS_CBW:
 		switch (cbw.CB[0]) {
-		case WRITE10:
-		case WRITE12:
-			/* LOG_DBG("> BO - PROC_CBW WR");*/
-			memoryWrite(bo_buf, bytes_read);
-			break;
 		case VERIFY10:
 			LOG_DBG("> BO - PROC_CBW VER");
 			memoryVerify(bo_buf, bytes_read);
@@ -723,25 +826,6 @@ static void mass_storage_bulk_out(u8_t ep,
 
 }
 
-static void thread_memory_write_done(void)
-{
-	u32_t size = defered_wr_sz;
-
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
-
-
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
-	}
-
-	thread_op = THREAD_OP_WRITE_DONE;
-
-	usb_ep_read_continue(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
-}
-
 /**
  * @brief EP Bulk IN handler, used to send data to the Host
  *
@@ -753,22 +837,16 @@ static void thread_memory_write_done(void)
 static void mass_storage_bulk_in(u8_t ep,
 				 enum usb_dc_ep_cb_status_code ep_status)
 {
-	ARG_UNUSED(ep_status);
-	ARG_UNUSED(ep);
+	if (usb_transfer_is_busy(ep)) {
+		/* data stage, moved by the disk thread */
+		usb_transfer_ep_callback(ep, ep_status);
+		return;
+	}
 
 	switch (stage) {
-	/*the device has to send data to the host*/
+	/*the data stage is moved by the disk thread*/
 	case MSC_PROCESS_CBW:
-		switch (cbw.CB[0]) {
-		case READ10:
-		case READ12:
-			/* LOG_DBG("< BI - PROC_CBW  READ"); */
-			memoryRead();
-			break;
-		default:
-			LOG_ERR("< BI-PROC_CBW default <<ERROR!!>>");
-			break;
-		}
+		LOG_ERR("< BI-PROC_CBW no transfer <<ERROR!!>>");
 		break;
 
 	/*the device has to send a CSW*/
@@ -815,6 +893,7 @@ static void mass_storage_status_cb(struct usb_cfg_data *cfg,
 		break;
 	case USB_DC_RESET:
 		LOG_DBG("USB device reset detected");
+		msd_xfer_abort();
 		msd_state_machine_reset();
 		msd_init();
 		break;
@@ -826,6 +905,7 @@ static void mass_storage_status_cb(struct usb_cfg_data *cfg,
 		break;
 	case USB_DC_DISCONNECTED:
 		LOG_DBG("USB device disconnected");
+		msd_xfer_abort();
 		break;
 	case USB_DC_SUSPEND:
 		LOG_DBG("USB device supended");
@@ -878,21 +958,10 @@ static void mass_thread_main(int arg1, int unused)
 
 		switch (thread_op) {
 		case THREAD_OP_READ_QUEUED:
-			if (disk_access_read(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!! Disk Read Error %d !",
-					addr/BLOCK_SIZE);
-			}
-
-			thread_memory_read_done();
+			thread_memory_read();
 			break;
 		case THREAD_OP_WRITE_QUEUED:
-			if (disk_access_write(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
-					addr/BLOCK_SIZE);
-			}
-			thread_memory_write_done();
+			thread_memory_write();
 			break;
 		default:
 			LOG_ERR("XXXXXX thread_op  %d ! XXXXX", thread_op);
@@ -942,6 +1011,13 @@ static int mass_storage_init(struct device *dev)
 	}
 
 
+	if (disk_access_ioctl(disk_pdrv, DISK_IOCTL_GET_ERASE_BLOCK_SZ,
+			      &erase_block_count) || !erase_block_count ||
+	    erase_block_count > MSC_BUF_SECTORS) {
+		/* not cut on boundaries out of reach of a buffer */
+		erase_block_count = 1U;
+	}
+
 	LOG_INF("Sect Count %d", block_count);
 	memory_size = block_count * BLOCK_SIZE;
 	LOG_INF("Memory Size %d", memory_size);
@@ -950,6 +1026,7 @@ static int mass_storage_init(struct device *dev)
 	msd_init();
 
 	k_sem_init(&disk_wait_sem, 0, 1);
+	k_sem_init(&xfer_sem, 0, 1);
 
 	/* Start a thread to offload disk ops */
 	k_thread_create(&mass_thread_data, mass_thread_stack,
@@ -0,0 +1,754 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_LEVEL CONFIG_USB_DEVICE_NETWORK_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(usb_ncm);
+
+/* Enable verbose debug printing extra hexdumps */
+#define VERBOSE_DEBUG	0
+
+#include <net/net_pkt.h>
+#include <net/ethernet.h>
+#include <net_private.h>
+
+#include <usb/usb_device.h>
+#include <usb/usb_common.h>
+#include <usb/class/usb_cdc.h>
+#include <usb_descriptor.h>
+
+#include "netusb.h"
+
+#define USB_CDC_NCM_REQ_TYPE_OUT	0x21
+#define USB_CDC_NCM_REQ_TYPE_IN		0xA1
+
+#define NCM_INT_EP_IDX			0
+#define NCM_OUT_EP_IDX			1
+#define NCM_IN_EP_IDX			2
+
+/* NCM10.pdf, 3.2.1 and 3.3.1: 16-bit NTB header and datagram pointers */
+#define NTH16_SIGNATURE			0x484D434E /* "NCMH" */
+#define NDP16_NOCRC_SIGNATURE		0x304D434E /* "NCM0" */
+
+#define NTB16_FORMAT			BIT(0)
+#define NTB_MIN_SIZE			2048
+
+/* Datagrams start on multiples of the divisor in both directions */
+#define NDP_DIVISOR			4
+#define NDP_ALIGNMENT			4
+
+#define NTB_IN_MAX_DATAGRAMS		CONFIG_CDC_NCM_NTB_IN_MAX_DATAGRAMS
+
+struct ncm_nth16 {
+	u32_t dwSignature;
+	u16_t wHeaderLength;
+	u16_t wSequence;
+	u16_t wBlockLength;
+	u16_t wNdpIndex;
+} __packed;
+
+struct ncm_dpe16 {
+	u16_t wDatagramIndex;
+	u16_t wDatagramLength;
+} __packed;
+
+struct ncm_ndp16 {
+	u32_t dwSignature;
+	u16_t wLength;
+	u16_t wNextNdpIndex;
+	struct ncm_dpe16 dpe[];
+} __packed;
+
+struct ncm_notification {
+	u8_t bmRequestType;
+	u8_t bNotificationType;
+	u16_t wValue;
+	u16_t wIndex;
+	u16_t wLength;
+} __packed;
+
+/*
+ * The NTBs sent to the host have a single NDP, just after the header and
+ * sized for the maximum number of datagrams, followed by the datagrams.
+ */
+#define NTB_IN_NDP_SIZE		(sizeof(struct ncm_ndp16) +		\
+				 (NTB_IN_MAX_DATAGRAMS + 1) *		\
+				 sizeof(struct ncm_dpe16))
+#define NTB_IN_DATA_OFFSET	ROUND_UP(sizeof(struct ncm_nth16) +	\
+					 NTB_IN_NDP_SIZE, NDP_DIVISOR)
+
+struct ncm_ntb {
+	u8_t __aligned(4) buf[CONFIG_CDC_NCM_NTB_IN_SIZE];
+	u16_t len;
+	u16_t count;
+};
+
+/*
+ * Frames are appended to the NTB being filled while the other one is sent,
+ * and the filled one is sent as soon as the endpoint is free.
+ */
+static struct {
+	struct ncm_ntb ntb[2];
+	/* index of the NTB being filled */
+	u8_t fill;
+	bool busy;
+	u16_t seq;
+} tx;
+
+static K_MUTEX_DEFINE(tx_lock);
+static K_SEM_DEFINE(tx_done, 0, 1);
+
+static u8_t __aligned(4) rx_buf[CONFIG_CDC_NCM_NTB_OUT_SIZE];
+
+/* Maximum size of the NTBs sent, as set by the host */
+static u32_t ntb_in_size = CONFIG_CDC_NCM_NTB_IN_SIZE;
+
+static const struct cdc_ncm_ntb_parameters ntb_params = {
+	.wLength = sys_cpu_to_le16(sizeof(struct cdc_ncm_ntb_parameters)),
+	.bmNtbFormatsSupported = sys_cpu_to_le16(NTB16_FORMAT),
+	.dwNtbInMaxSize = sys_cpu_to_le32(CONFIG_CDC_NCM_NTB_IN_SIZE),
+	.wNdpInDivisor = sys_cpu_to_le16(NDP_DIVISOR),
+	.wNdpInPayloadRemainder = sys_cpu_to_le16(0),
+	.wNdpInAlignment = sys_cpu_to_le16(NDP_ALIGNMENT),
+	.dwNtbOutMaxSize = sys_cpu_to_le32(CONFIG_CDC_NCM_NTB_OUT_SIZE),
+	.wNdpOutDivisor = sys_cpu_to_le16(NDP_DIVISOR),
+	.wNdpOutPayloadRemainder = sys_cpu_to_le16(0),
+	.wNdpOutAlignment = sys_cpu_to_le16(NDP_ALIGNMENT),
+	.wNtbOutMaxDatagrams = sys_cpu_to_le16(0), /* No limit */
+};
+
+struct usb_cdc_ncm_config {
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	struct usb_association_descriptor iad;
+#endif
+	struct usb_if_descriptor if0;
+	struct cdc_header_descriptor if0_header;
+	struct cdc_union_descriptor if0_union;
+	struct cdc_ecm_descriptor if0_netfun_ecm;
+	struct cdc_ncm_descriptor if0_netfun_ncm;
+	struct usb_ep_descriptor if0_int_ep;
+
+	struct usb_if_descriptor if1_0;
+
+	struct usb_if_descriptor if1_1;
+	struct usb_ep_descriptor if1_1_in_ep;
+	struct usb_ep_descriptor if1_1_out_ep;
+} __packed;
+
+USBD_CLASS_DESCR_DEFINE(primary, 0) struct usb_cdc_ncm_config cdc_ncm_cfg = {
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	.iad = {
+		.bLength = sizeof(struct usb_association_descriptor),
+		.bDescriptorType = USB_ASSOCIATION_DESC,
+		.bFirstInterface = 0,
+		.bInterfaceCount = 0x02,
+		.bFunctionClass = COMMUNICATION_DEVICE_CLASS,
+		.bFunctionSubClass = NCM_SUBCLASS,
+		.bFunctionProtocol = 0,
+		.iFunction = 0,
+	},
+#endif
+	/* Interface descriptor 0 */
+	/* CDC Communication interface */
+	.if0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_INTERFACE_DESC,
+		.bInterfaceNumber = 0,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 1,
+		.bInterfaceClass = COMMUNICATION_DEVICE_CLASS,
+		.bInterfaceSubClass = NCM_SUBCLASS,
+		.bInterfaceProtocol = 0,
+		.iInterface = 0,
+	},
+	/* Header Functional Descriptor */
+	.if0_header = {
+		.bFunctionLength = sizeof(struct cdc_header_descriptor),
+		.bDescriptorType = CS_INTERFACE,
+		.bDescriptorSubtype = HEADER_FUNC_DESC,
+		.bcdCDC = sys_cpu_to_le16(USB_1_1),
+	},
+	/* Union Functional Descriptor */
+	.if0_union = {
+		.bFunctionLength = sizeof(struct cdc_union_descriptor),
+		.bDescriptorType = CS_INTERFACE,
+		.bDescriptorSubtype = UNION_FUNC_DESC,
+		.bControlInterface = 0,
+		.bSubordinateInterface0 = 1,
+	},
+	/* Ethernet Networking Functional descriptor */
+	.if0_netfun_ecm = {
+		.bFunctionLength = sizeof(struct cdc_ecm_descriptor),
+		.bDescriptorType = CS_INTERFACE,
+		.bDescriptorSubtype = ETHERNET_FUNC_DESC,
+		.iMACAddress = 4,
+		.bmEthernetStatistics = sys_cpu_to_le32(0), /* None */
+		.wMaxSegmentSize = sys_cpu_to_le16(NET_ETH_MAX_FRAME_SIZE),
+		.wNumberMCFilters = sys_cpu_to_le16(0), /* None */
+		.bNumberPowerFilters = 0, /* No wake up */
+	},
+	/* NCM Functional descriptor */
+	.if0_netfun_ncm = {
+		.bFunctionLength = sizeof(struct cdc_ncm_descriptor),
+		.bDescriptorType = CS_INTERFACE,
+		.bDescriptorSubtype = NCM_FUNC_DESC,
+		.bcdNcmVersion = sys_cpu_to_le16(0x0100),
+		/* SetEthernetPacketFilter only */
+		.bmNetworkCapabilities = BIT(0),
+	},
+	/* Notification EP Descriptor */
+	.if0_int_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_ENDPOINT_DESC,
+		.bEndpointAddress = CDC_NCM_INT_EP_ADDR,
+		.bmAttributes = USB_DC_EP_INTERRUPT,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_INTERRUPT_EP_MPS),
+		.bInterval = 0x09,
+	},
+
+	/* Interface descriptor 1/0 */
+	/* CDC Data Interface */
+	.if1_0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_INTERFACE_DESC,
+		.bInterfaceNumber = 1,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 0,
+		.bInterfaceClass = COMMUNICATION_DEVICE_CLASS_DATA,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,
+		.iInterface = 0,
+	},
+
+	/* Interface descriptor 1/1 */
+	/* CDC Data Interface */
+	.if1_1 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_INTERFACE_DESC,
+		.bInterfaceNumber = 1,
+		.bAlternateSetting = 1,
+		.bNumEndpoints = 2,
+		.bInterfaceClass = COMMUNICATION_DEVICE_CLASS_DATA,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,
+		.iInterface = 0,
+	},
+	/* Data Endpoint IN */
+	.if1_1_in_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_ENDPOINT_DESC,
+		.bEndpointAddress = CDC_NCM_IN_EP_ADDR,
+		.bmAttributes = USB_DC_EP_BULK,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_BULK_EP_MPS),
+		.bInterval = 0x00,
+	},
+	/* Data Endpoint OUT */
+	.if1_1_out_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_ENDPOINT_DESC,
+		.bEndpointAddress = CDC_NCM_OUT_EP_ADDR,
+		.bmAttributes = USB_DC_EP_BULK,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_BULK_EP_MPS),
+		.bInterval = 0x00,
+	},
+};
+
+static u8_t ncm_get_first_iface_number(void)
+{
+	return cdc_ncm_cfg.if0.bInterfaceNumber;
+}
+
+static struct usb_ep_cfg_data ncm_ep_data[] = {
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_INT_EP_ADDR
+	},
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_OUT_EP_ADDR
+	},
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_IN_EP_ADDR
+	},
+};
+
+static int ncm_class_handler(struct usb_setup_packet *setup, s32_t *len,
+			     u8_t **data)
+{
+	static u8_t ctrl_buf[4];
+	u32_t size;
+
+	LOG_DBG("len %d req_type 0x%x req 0x%x",
+		*len, setup->bmRequestType, setup->bRequest);
+
+	/* the NTB parameters are negotiated before the data interface is on */
+	if (setup->bmRequestType == USB_CDC_NCM_REQ_TYPE_IN) {
+		switch (setup->bRequest) {
+		case GET_NTB_PARAMETERS:
+			*data = (u8_t *)&ntb_params;
+			*len = MIN(*len, sizeof(ntb_params));
+			return 0;
+		case GET_NTB_FORMAT:
+			/* NTB16 */
+			sys_put_le16(0, ctrl_buf);
+			*data = ctrl_buf;
+			*len = MIN(*len, 2);
+			return 0;
+		case GET_NTB_INPUT_SIZE:
+			sys_put_le32(ntb_in_size, ctrl_buf);
+			*data = ctrl_buf;
+			*len = MIN(*len, 4);
+			return 0;
+		default:
+			break;
+		}
+	} else if (setup->bmRequestType == USB_CDC_NCM_REQ_TYPE_OUT) {
+		switch (setup->bRequest) {
+		case SET_ETHERNET_PACKET_FILTER:
+			LOG_DBG("intf 0x%x filter 0x%x", setup->wIndex,
+				setup->wValue);
+			return 0;
+		case SET_NTB_FORMAT:
+			return sys_le16_to_cpu(setup->wValue) == 0 ? 0 : -EINVAL;
+		case SET_NTB_INPUT_SIZE:
+			if (*len < 4) {
+				return -EINVAL;
+			}
+
+			size = sys_get_le32(*data);
+			if (size < NTB_MIN_SIZE ||
+			    size > CONFIG_CDC_NCM_NTB_IN_SIZE) {
+				LOG_WRN("Unsupported NTB input size %u", size);
+				return -EINVAL;
+			}
+
+			/* applies from the next NTB filled */
+			ntb_in_size = size;
+			return 0;
+		default:
+			break;
+		}
+	}
+
+	LOG_WRN("Unhandled req_type 0x%x req 0x%x", setup->bmRequestType,
+		setup->bRequest);
+
+	return -ENOTSUP;
+}
+
+static void ncm_ntb_reset(struct ncm_ntb *ntb)
+{
+	ntb->len = NTB_IN_DATA_OFFSET;
+	ntb->count = 0U;
+}
+
+static bool ncm_ntb_fits(struct ncm_ntb *ntb, size_t len)
+{
+	return ntb->count < NTB_IN_MAX_DATAGRAMS &&
+	       ROUND_UP(ntb->len, NDP_DIVISOR) + len <= ntb_in_size;
+}
+
+/* Writes the header and the NDP of the datagrams appended, to be sent */
+static void ncm_ntb_close(struct ncm_ntb *ntb)
+{
+	struct ncm_nth16 *nth = (struct ncm_nth16 *)ntb->buf;
+	struct ncm_ndp16 *ndp = (struct ncm_ndp16 *)(nth + 1);
+
+	nth->dwSignature = sys_cpu_to_le32(NTH16_SIGNATURE);
+	nth->wHeaderLength = sys_cpu_to_le16(sizeof(*nth));
+	nth->wSequence = sys_cpu_to_le16(tx.seq++);
+	nth->wBlockLength = sys_cpu_to_le16(ntb->len);
+	nth->wNdpIndex = sys_cpu_to_le16(sizeof(*nth));
+
+	ndp->dwSignature = sys_cpu_to_le32(NDP16_NOCRC_SIGNATURE);
+	ndp->wLength = sys_cpu_to_le16(sizeof(*ndp) + (ntb->count + 1) *
+				       sizeof(struct ncm_dpe16));
+	ndp->wNextNdpIndex = 0U;
+	ndp->dpe[ntb->count].wDatagramIndex = 0U;
+	ndp->dpe[ntb->count].wDatagramLength = 0U;
+}
+
+static void ncm_tx_start(void);
+
+static void ncm_tx_cb(u8_t ep, int size, void *priv)
+{
+	ARG_UNUSED(ep);
+	ARG_UNUSED(priv);
+
+	LOG_DBG("NTB sent, size %d", size);
+
+	k_mutex_lock(&tx_lock, K_FOREVER);
+
+	tx.busy = false;
+
+	/* frames appended while this NTB was sent */
+	if (tx.ntb[tx.fill].count) {
+		ncm_tx_start();
+	}
+
+	k_mutex_unlock(&tx_lock);
+
+	k_sem_give(&tx_done);
+}
+
+/* Sends the NTB being filled, with tx_lock held */
+static void ncm_tx_start(void)
+{
+	struct ncm_ntb *ntb = &tx.ntb[tx.fill];
+	unsigned int flags = USB_TRANS_WRITE;
+	int ret;
+
+	ncm_ntb_close(ntb);
+
+	/* the host knows an NTB of the maximum size is complete */
+	if (ntb->len == ntb_in_size) {
+		flags |= USB_TRANS_NO_ZLP;
+	}
+
+	tx.busy = true;
+	tx.fill = !tx.fill;
+	ncm_ntb_reset(&tx.ntb[tx.fill]);
+
+	ret = usb_transfer(ncm_ep_data[NCM_IN_EP_IDX].ep_addr, ntb->buf,
+			   ntb->len, flags, ncm_tx_cb, NULL);
+	if (ret) {
+		LOG_ERR("Transfer failure, ret %d", ret);
+		tx.busy = false;
+	}
+}
+
+static int ncm_send(struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	struct ncm_ndp16 *ndp;
+	struct ncm_ntb *ntb;
+	u16_t offset;
+	int ret = 0;
+
+	if (IS_ENABLED(VERBOSE_DEBUG)) {
+		net_pkt_hexdump(pkt, "<");
+	}
+
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
+		LOG_WRN("Trying to send too large packet, drop");
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&tx_lock, K_FOREVER);
+
+	while (!ncm_ntb_fits(&tx.ntb[tx.fill], len)) {
+		if (!tx.busy) {
+			ncm_tx_start();
+			continue;
+		}
+
+		/* both NTBs are in use, wait for the one being sent */
+		k_mutex_unlock(&tx_lock);
+		k_sem_take(&tx_done, K_FOREVER);
+		k_mutex_lock(&tx_lock, K_FOREVER);
+	}
+
+	ntb = &tx.ntb[tx.fill];
+	offset = ROUND_UP(ntb->len, NDP_DIVISOR);
+
+	if (net_pkt_read(pkt, &ntb->buf[offset], len)) {
+		ret = -ENOBUFS;
+		goto done;
+	}
+
+	ndp = (struct ncm_ndp16 *)&ntb->buf[sizeof(struct ncm_nth16)];
+	ndp->dpe[ntb->count].wDatagramIndex = sys_cpu_to_le16(offset);
+	ndp->dpe[ntb->count].wDatagramLength = sys_cpu_to_le16(len);
+
+	ntb->len = offset + len;
+	ntb->count++;
+
+	/* otherwise sent with the following frames when the endpoint is free */
+	if (!tx.busy) {
+		ncm_tx_start();
+	}
+
+done:
+	k_mutex_unlock(&tx_lock);
+
+	return ret;
+}
+
+static void ncm_recv_datagram(u8_t *data, u16_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(netusb_net_iface(), len,
+					AF_UNSPEC, 0, K_FOREVER);
+	if (!pkt) {
+		LOG_ERR("no memory for network packet");
+		return;
+	}
+
+	if (net_pkt_write(pkt, data, len)) {
+		LOG_ERR("Unable to write into pkt");
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	if (IS_ENABLED(VERBOSE_DEBUG)) {
+		net_pkt_hexdump(pkt, ">");
+	}
+
+	netusb_recv(pkt);
+}
+
+/* Passes the datagrams of an NTB received to the network stack */
+static int ncm_recv_ntb(u8_t *buf, size_t size)
+{
+	struct ncm_nth16 *nth = (struct ncm_nth16 *)buf;
+	u16_t ndp_index;
+	size_t ndps;
+
+	if (size < sizeof(*nth) ||
+	    nth->dwSignature != sys_cpu_to_le32(NTH16_SIGNATURE) ||
+	    sys_le16_to_cpu(nth->wHeaderLength) != sizeof(*nth) ||
+	    sys_le16_to_cpu(nth->wBlockLength) > size) {
+		LOG_WRN("Invalid NTB header");
+		return -EINVAL;
+	}
+
+	size = sys_le16_to_cpu(nth->wBlockLength);
+	ndp_index = sys_le16_to_cpu(nth->wNdpIndex);
+
+	/* the NDPs are chained, at most as many as fit in the NTB */
+	for (ndps = 0; ndp_index && ndps < size / sizeof(struct ncm_ndp16);
+	     ndps++) {
+		struct ncm_ndp16 *ndp;
+		size_t ndp_len;
+
+		if (size < sizeof(*ndp) || ndp_index > size - sizeof(*ndp)) {
+			LOG_WRN("Invalid NDP index %u", ndp_index);
+			return -EINVAL;
+		}
+
+		ndp = (struct ncm_ndp16 *)&buf[ndp_index];
+		ndp_len = sys_le16_to_cpu(ndp->wLength);
+
+		if (ndp->dwSignature != sys_cpu_to_le32(NDP16_NOCRC_SIGNATURE) ||
+		    ndp_len < sizeof(*ndp) + 2 * sizeof(struct ncm_dpe16) ||
+		    ndp_len > size - ndp_index) {
+			LOG_WRN("Invalid NDP at %u", ndp_index);
+			return -EINVAL;
+		}
+
+		for (size_t i = 0; i < (ndp_len - sizeof(*ndp)) /
+				      sizeof(struct ncm_dpe16); i++) {
+			u16_t index = sys_le16_to_cpu(ndp->dpe[i].wDatagramIndex);
+			u16_t len = sys_le16_to_cpu(ndp->dpe[i].wDatagramLength);
+
+			if (!index || !len) {
+				break;
+			}
+
+			if (index > size || len > size - index) {
+				LOG_WRN("Invalid datagram at %u", index);
+				break;
+			}
+
+			ncm_recv_datagram(&buf[index], len);
+		}
+
+		ndp_index = sys_le16_to_cpu(ndp->wNextNdpIndex);
+	}
+
+	return 0;
+}
+
+static void ncm_read_cb(u8_t ep, int size, void *priv)
+{
+	if (size > 0) {
+		ncm_recv_ntb(rx_buf, size);
+	}
+
+	usb_transfer(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr, rx_buf,
+		     sizeof(rx_buf), USB_TRANS_READ, ncm_read_cb, NULL);
+}
+
+static void ncm_notify_cb(u8_t ep, int size, void *priv)
+{
+	LOG_DBG("Notification sent, size %d", size);
+}
+
+/* Tells the host the link is up, see ECM120.pdf, 6.3.1 */
+static void ncm_notify_connection(bool connected)
+{
+	static struct ncm_notification notification;
+	int ret;
+
+	notification.bmRequestType = USB_CDC_NCM_REQ_TYPE_IN;
+	notification.bNotificationType = NETWORK_CONNECTION;
+	notification.wValue = sys_cpu_to_le16(connected);
+	notification.wIndex = sys_cpu_to_le16(ncm_get_first_iface_number());
+	notification.wLength = 0U;
+
+	ret = usb_transfer(ncm_ep_data[NCM_INT_EP_IDX].ep_addr,
+			   (u8_t *)&notification, sizeof(notification),
+			   USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+			   ncm_notify_cb, NULL);
+	if (ret < 0) {
+		LOG_ERR("Transfer failure, ret %d", ret);
+	}
+}
+
+static int ncm_connect(bool connected)
+{
+	unsigned int key;
+
+	if (connected) {
+		ncm_read_cb(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr, 0, NULL);
+		ncm_notify_connection(true);
+	} else {
+		/* Cancel any transfer */
+		usb_cancel_transfer(ncm_ep_data[NCM_INT_EP_IDX].ep_addr);
+		usb_cancel_transfer(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr);
+		usb_cancel_transfer(ncm_ep_data[NCM_IN_EP_IDX].ep_addr);
+
+		/*
+		 * The cancelled NTB is not completed, release the senders.
+		 * May be called in IRQ context, tx_lock is not taken.
+		 */
+		key = irq_lock();
+		tx.busy = false;
+		irq_unlock(key);
+		k_sem_give(&tx_done);
+	}
+
+	return 0;
+}
+
+static struct netusb_function ncm_function = {
+	.connect_media = ncm_connect,
+	.send_pkt = ncm_send,
+};
+
+static inline void ncm_status_interface(const u8_t *desc)
+{
+	const struct usb_if_descriptor *if_desc = (void *)desc;
+	u8_t iface_num = if_desc->bInterfaceNumber;
+	u8_t alt_set = if_desc->bAlternateSetting;
+
+	LOG_DBG("iface %u alt_set %u", iface_num, if_desc->bAlternateSetting);
+
+	/* First interface is CDC Comm interface */
+	if (iface_num != ncm_get_first_iface_number() + 1) {
+		LOG_DBG("Skip iface_num %u alt_set %u", iface_num, alt_set);
+		return;
+	}
+
+	/* the host resets the function by selecting the alternate setting 0 */
+	if (!alt_set) {
+		netusb_disable();
+		return;
+	}
+
+	netusb_enable(&ncm_function);
+}
+
+static void ncm_status_cb(struct usb_cfg_data *cfg,
+			  enum usb_dc_status_code status,
+			  const u8_t *param)
+{
+	ARG_UNUSED(cfg);
+
+	/* Check the USB status and do needed action if required */
+	switch (status) {
+	case USB_DC_DISCONNECTED:
+		LOG_DBG("USB device disconnected");
+		netusb_disable();
+		break;
+
+	case USB_DC_INTERFACE:
+		LOG_DBG("USB interface selected");
+		ncm_status_interface(param);
+		break;
+
+	case USB_DC_RESET:
+		LOG_DBG("USB device reset detected");
+		ntb_in_size = CONFIG_CDC_NCM_NTB_IN_SIZE;
+		break;
+
+	case USB_DC_ERROR:
+	case USB_DC_CONNECTED:
+	case USB_DC_CONFIGURED:
+	case USB_DC_SUSPEND:
+	case USB_DC_RESUME:
+		LOG_DBG("USB unhandlded state: %d", status);
+		break;
+
+	case USB_DC_SOF:
+		break;
+
+	case USB_DC_UNKNOWN:
+	default:
+		LOG_DBG("USB unknown state: %d", status);
+		break;
+	}
+}
+
+struct usb_cdc_ncm_mac_descr {
+	u8_t bLength;
+	u8_t bDescriptorType;
+	u8_t bString[USB_BSTRING_LENGTH(CONFIG_USB_DEVICE_NETWORK_NCM_MAC)];
+} __packed;
+
+USBD_STRING_DESCR_DEFINE(primary) struct usb_cdc_ncm_mac_descr utf16le_mac = {
+	.bLength = USB_STRING_DESCRIPTOR_LENGTH(
+			CONFIG_USB_DEVICE_NETWORK_NCM_MAC),
+	.bDescriptorType = USB_STRING_DESC,
+	.bString = CONFIG_USB_DEVICE_NETWORK_NCM_MAC
+};
+
+static void ncm_interface_config(struct usb_desc_header *head,
+				 u8_t bInterfaceNumber)
+{
+	int idx = usb_get_str_descriptor_idx(&utf16le_mac);
+
+	ARG_UNUSED(head);
+
+	if (idx) {
+		LOG_DBG("fixup string %d", idx);
+		cdc_ncm_cfg.if0_netfun_ecm.iMACAddress = idx;
+	}
+
+	cdc_ncm_cfg.if0.bInterfaceNumber = bInterfaceNumber;
+	cdc_ncm_cfg.if0_union.bControlInterface = bInterfaceNumber;
+	cdc_ncm_cfg.if0_union.bSubordinateInterface0 = bInterfaceNumber + 1;
+	cdc_ncm_cfg.if1_0.bInterfaceNumber = bInterfaceNumber + 1;
+	cdc_ncm_cfg.if1_1.bInterfaceNumber = bInterfaceNumber + 1;
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	cdc_ncm_cfg.iad.bFirstInterface = bInterfaceNumber;
+#endif
+}
+
+USBD_CFG_DATA_DEFINE(netusb) struct usb_cfg_data netusb_config = {
+	.usb_device_description = NULL,
+	.interface_config = ncm_interface_config,
+	.interface_descriptor = &cdc_ncm_cfg.if0,
+	.cb_usb_status = ncm_status_cb,
+	.interface = {
+		.class_handler = ncm_class_handler,
+		.custom_handler = NULL,
+		.vendor_handler = NULL,
+	},
+	.num_endpoints = ARRAY_SIZE(ncm_ep_data),
+	.endpoint = ncm_ep_data,
+};
@@ -69,6 +69,9 @@
 #include <usb/usbstruct.h>
 #include <usb/usb_common.h>
 #include <usb_descriptor.h>
+#ifdef CONFIG_NET_BUF
+#include <net/buf.h>
+#endif
 
 #define LOG_LEVEL CONFIG_USB_DEVICE_LOG_LEVEL
 #include <logging/log.h>
@@ -131,6 +134,10 @@ struct usb_transfer_data {
 	struct k_work work;
 	/** Transfer flags */
 	unsigned int flags;
+	/** Transfer moved by the controller, see usb_dc_ep_xfer() */
+	bool xfer;
+	/** Buffer of usb_transfer_buf(), owned until completion */
+	struct net_buf *nbuf;
 };
 
 static void usb_transfer_work(struct k_work *item);
@@ -1076,13 +1083,24 @@ int usb_ep_read_continue(u8_t ep)
 /* Transfer management */
 static struct usb_transfer_data *usb_ep_get_transfer(u8_t ep)
 {
+	struct usb_transfer_data *found = NULL;
+
+	/* the ongoing transfer, rather than a completed one */
 	for (int i = 0; i < ARRAY_SIZE(usb_dev.transfer); i++) {
-		if (usb_dev.transfer[i].ep == ep) {
+		if (usb_dev.transfer[i].ep != ep) {
+			continue;
+		}
+
+		if (usb_dev.transfer[i].status == -EBUSY) {
 			return &usb_dev.transfer[i];
 		}
+
+		if (!found) {
+			found = &usb_dev.transfer[i];
+		}
 	}
 
-	return NULL;
+	return found;
 }
 
 bool usb_transfer_is_busy(u8_t ep)
@@ -1096,6 +1114,19 @@ bool usb_transfer_is_busy(u8_t ep)
 	return false;
 }
 
+static void usb_transfer_buf_done(struct net_buf *buf, int status,
+				  unsigned int flags, int tsize)
+{
+#ifdef CONFIG_NET_BUF
+	if (status == -ECANCELED) {
+		/* no callback to hand the buffer back to */
+		net_buf_unref(buf);
+	} else if (flags & USB_TRANS_READ) {
+		net_buf_add(buf, tsize);
+	}
+#endif
+}
+
 static void usb_transfer_work(struct k_work *item)
 {
 	struct usb_transfer_data *trans;
@@ -1111,6 +1142,11 @@ static void usb_transfer_work(struct k_work *item)
 		goto done;
 	}
 
+	if (trans->xfer) {
+		/* completed by usb_transfer_xfer_cb() */
+		return;
+	}
+
 	if (trans->flags & USB_TRANS_WRITE) {
 		if (!trans->bsize) {
 			if (!(trans->flags & USB_TRANS_NO_ZLP)) {
@@ -1160,6 +1196,9 @@ done:
 		usb_transfer_callback cb = trans->cb;
 		int tsize = trans->tsize;
 		void *priv = trans->priv;
+		struct net_buf *nbuf = trans->nbuf;
+		unsigned int flags = trans->flags;
+		int status = trans->status;
 
 		if (k_is_in_isr()) {
 			/* reschedule completion in thread context */
@@ -1171,15 +1210,98 @@ done:
 			trans->ep, trans->status, trans->tsize);
 
 		trans->cb = NULL;
+		trans->nbuf = NULL;
 		k_sem_give(&trans->sem);
 
+		if (nbuf) {
+			usb_transfer_buf_done(nbuf, status, flags, tsize);
+		}
+
 		/* Transfer completion callback */
-		if (trans->status != -ECANCELED) {
+		if (status != -ECANCELED) {
 			cb(ep, tsize, priv);
 		}
 	}
 }
 
+#ifdef CONFIG_USB_DC_HAS_XFER
+/* Completion of a transfer moved by the controller, maybe in IRQ context */
+static void usb_transfer_xfer_cb(u8_t ep, int status, u32_t len, void *priv)
+{
+	struct usb_transfer_data *trans = priv;
+
+	trans->xfer = false;
+	trans->tsize = len;
+
+	/* not overriding a cancellation */
+	if (trans->status == -EBUSY) {
+		if (status == 0 || status == -ECANCELED) {
+			trans->status = status;
+		} else {
+			LOG_ERR("Transfer error %d", status);
+			trans->status = -EINVAL;
+		}
+	}
+
+	/* the callback runs in thread context */
+	k_work_submit(&trans->work);
+}
+#endif
+
+/*
+ * Hands the whole buffer of the transfer to the controller, or returns an
+ * error for the transfer to be moved packet by packet.
+ */
+static int usb_transfer_start_xfer(struct usb_transfer_data *trans)
+{
+#ifdef CONFIG_USB_DC_HAS_XFER
+	unsigned int flags = 0U;
+	bool queued = false;
+	int ret;
+
+	/* mixing with the packets of an ongoing transfer would reorder data */
+	for (int i = 0; i < ARRAY_SIZE(usb_dev.transfer); i++) {
+		struct usb_transfer_data *other = &usb_dev.transfer[i];
+
+		if (other == trans || other->ep != trans->ep ||
+		    other->status != -EBUSY) {
+			continue;
+		}
+
+		if (!other->xfer) {
+			return -EBUSY;
+		}
+
+		queued = true;
+	}
+
+	if (!trans->bsize) {
+		return queued ? -EBUSY : -ENOTSUP;
+	}
+
+	if ((trans->flags & USB_TRANS_WRITE) &&
+	    !(trans->flags & USB_TRANS_NO_ZLP)) {
+		flags |= USB_DC_XFER_ZLP;
+	}
+
+	trans->xfer = true;
+	ret = usb_dc_ep_xfer(trans->ep, trans->buffer, trans->bsize, flags,
+			     usb_transfer_xfer_cb, trans);
+	if (ret) {
+		trans->xfer = false;
+	}
+
+	/* nor can packets overtake the queued transfers */
+	if (ret && queued) {
+		return -EBUSY;
+	}
+
+	return ret;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 void usb_transfer_ep_callback(u8_t ep, enum usb_dc_ep_cb_status_code status)
 {
 	struct usb_transfer_data *trans = usb_ep_get_transfer(ep);
@@ -1217,8 +1339,9 @@ void usb_transfer_ep_callback(u8_t ep, enum usb_dc_ep_cb_status_code status)
 	}
 }
 
-int usb_transfer(u8_t ep, u8_t *data, size_t dlen, unsigned int flags,
-		 usb_transfer_callback cb, void *cb_data)
+static int usb_transfer_start(u8_t ep, u8_t *data, size_t dlen,
+			      unsigned int flags, usb_transfer_callback cb,
+			      void *cb_data, struct net_buf *nbuf)
 {
 	struct usb_transfer_data *trans = NULL;
 	int i, key, ret = 0;
@@ -1255,6 +1378,7 @@ int usb_transfer(u8_t ep, u8_t *data, size_t dlen, unsigned int flags,
 	trans->cb = cb;
 	trans->flags = flags;
 	trans->priv = cb_data;
+	trans->nbuf = nbuf;
 	trans->status = -EBUSY;
 
 	if (usb_dc_ep_mps(ep) && (dlen % usb_dc_ep_mps(ep))) {
@@ -1262,7 +1386,20 @@ int usb_transfer(u8_t ep, u8_t *data, size_t dlen, unsigned int flags,
 		trans->flags |= USB_TRANS_NO_ZLP;
 	}
 
-	if (flags & USB_TRANS_WRITE) {
+	ret = usb_transfer_start_xfer(trans);
+	if (ret == -EBUSY) {
+		/* the controller already queues two transfers */
+		trans->status = 0;
+		trans->cb = NULL;
+		trans->nbuf = NULL;
+		k_sem_give(&trans->sem);
+		goto done;
+	}
+
+	ret = 0;
+	if (trans->xfer) {
+		/* completed by usb_transfer_xfer_cb() */
+	} else if (flags & USB_TRANS_WRITE) {
 		/* start writing first chunk */
 		k_work_submit(&trans->work);
 	} else {
@@ -1275,26 +1412,54 @@ done:
 	return ret;
 }
 
+int usb_transfer(u8_t ep, u8_t *data, size_t dlen, unsigned int flags,
+		 usb_transfer_callback cb, void *cb_data)
+{
+	return usb_transfer_start(ep, data, dlen, flags, cb, cb_data, NULL);
+}
+
+#ifdef CONFIG_NET_BUF
+int usb_transfer_buf(u8_t ep, struct net_buf *buf, unsigned int flags,
+		     usb_transfer_callback cb)
+{
+	if (flags & USB_TRANS_WRITE) {
+		return usb_transfer_start(ep, buf->data, buf->len, flags, cb,
+					  buf, buf);
+	}
+
+	return usb_transfer_start(ep, net_buf_tail(buf),
+				  net_buf_tailroom(buf), flags, cb, buf, buf);
+}
+#endif
+
+/* Cancels the transfers the controller moves, it no longer uses them */
+static void usb_cancel_xfer(struct usb_transfer_data *trans)
+{
+#ifdef CONFIG_USB_DC_HAS_XFER
+	if (trans->xfer) {
+		usb_dc_ep_xfer_cancel(trans->ep);
+	}
+#endif
+}
+
 void usb_cancel_transfer(u8_t ep)
 {
-	struct usb_transfer_data *trans;
 	unsigned int key;
 
 	key = irq_lock();
 
-	trans = usb_ep_get_transfer(ep);
-	if (!trans) {
-		goto done;
-	}
+	for (int i = 0; i < ARRAY_SIZE(usb_dev.transfer); i++) {
+		struct usb_transfer_data *trans = &usb_dev.transfer[i];
 
-	if (trans->status != -EBUSY) {
-		goto done;
-	}
+		if (trans->ep != ep || trans->status != -EBUSY) {
+			continue;
+		}
 
-	trans->status = -ECANCELED;
-	k_work_submit(&trans->work);
+		usb_cancel_xfer(trans);
+		trans->status = -ECANCELED;
+		k_work_submit(&trans->work);
+	}
 
-done:
 	irq_unlock(key);
 }
 
@@ -1307,6 +1472,7 @@ void usb_cancel_transfers(void)
 		key = irq_lock();
 
 		if (trans->status == -EBUSY) {
+			usb_cancel_xfer(trans);
 			trans->status = -ECANCELED;
 			k_work_submit(&trans->work);
 			LOG_DBG("Cancel transfer");
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpp/kernel.h>
+#include <ztest.h>
+
+#define STACK_SIZE 1024
+#define PERIOD 10
+
+struct sample {
+	u32_t seq;
+	u32_t value;
+};
+
+struct counter {
+	void on_expiry(zephyr::timer &t)
+	{
+		expired++;
+		if (expired == 3) {
+			t.stop();
+		}
+	}
+
+	volatile int expired;
+};
+
+static volatile int stopped;
+
+static void on_stop(zephyr::timer &t)
+{
+	stopped++;
+}
+
+zephyr::sem done CPP_KOBJ_SECTION(k_sem, done) = { 0, 1 };
+zephyr::timer periodic CPP_KOBJ_SECTION(k_timer, periodic) = {
+	zephyr::timer::member_handler<counter, &counter::on_expiry>,
+	zephyr::timer::handler<on_stop> };
+CPP_MSGQ_DEFINE(samples, sample, 4);
+
+extern struct k_sem _k_sem_list_start[];
+extern struct k_sem _k_sem_list_end[];
+
+static zephyr::thread<STACK_SIZE> producer;
+
+static void produce(sample &first)
+{
+	sample s = first;
+
+	for (u32_t i = 0; i < samples.capacity() + 1; i++) {
+		s.seq = i;
+		samples.put(s, K_FOREVER);
+	}
+
+	done.give();
+}
+
+void test_sem(void)
+{
+	struct k_sem *sem;
+	bool found = false;
+
+	/* constant initialized, in the section of the C semaphores */
+	for (sem = _k_sem_list_start; sem < _k_sem_list_end; sem++) {
+		found |= sem == done.native();
+	}
+
+	zassert_true(found, "Semaphore not in the k_sem section");
+	zassert_equal(done.take(K_NO_WAIT), -EBUSY, NULL);
+	done.give();
+	done.give();
+	zassert_equal(done.count(), 1, "Limit not initialized");
+	zassert_equal(done.take(K_NO_WAIT), 0, NULL);
+}
+
+void test_msgq_thread(void)
+{
+	sample first = { 0, 42 };
+	sample s;
+
+	producer.start<sample, produce>(first, K_PRIO_PREEMPT(0));
+
+	for (u32_t i = 0; i < samples.capacity() + 1; i++) {
+		zassert_equal(samples.get(s, K_FOREVER), 0, NULL);
+		zassert_equal(s.seq, i, "Messages out of order");
+		zassert_equal(s.value, 42, "Message not copied");
+	}
+
+	zassert_equal(done.take(K_FOREVER), 0, NULL);
+	zassert_equal(samples.num_used(), 0, NULL);
+	producer.abort();
+}
+
+void test_timer(void)
+{
+	counter c = { 0 };
+
+	periodic.user_data_set(&c);
+	periodic.start(PERIOD, PERIOD);
+	k_sleep(PERIOD * 5);
+
+	zassert_equal(c.expired, 3, "Member handler not called");
+	zassert_equal(stopped, 1, "Stop handler not called");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(cpp_kernel,
+			 ztest_unit_test(test_sem),
+			 ztest_unit_test(test_msgq_thread),
+			 ztest_unit_test(test_timer));
+	ztest_run_test_suite(cpp_kernel);
+}
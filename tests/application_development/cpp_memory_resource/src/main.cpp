@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpp/memory_resource.h>
+#include <ztest.h>
+
+#define BLOCKS 4
+
+struct item {
+	CPP_MEMORY_RESOURCE_NEW(item_resource)
+
+	item(u32_t v) : value(v) {}
+
+	u32_t value;
+	static zephyr::memory_resource &item_resource;
+};
+
+K_MEM_SLAB_DEFINE(item_slab, 8, BLOCKS, 4);
+static zephyr::slab_resource slab_res(&item_slab);
+zephyr::memory_resource &item::item_resource = slab_res;
+
+K_MEM_POOL_DEFINE(test_pool, 16, 128, 2, 16);
+static zephyr::pool_resource pool_res(&test_pool);
+
+static u8_t __aligned(8) arena[64];
+
+void test_slab_resource(void)
+{
+	item *items[BLOCKS];
+	int i;
+
+	for (i = 0; i < BLOCKS; i++) {
+		items[i] = new item(i);
+		zassert_not_null(items[i], "Slab exhausted too early");
+	}
+
+	zassert_equal(k_mem_slab_num_used_get(&item_slab), BLOCKS, NULL);
+	zassert_is_null(new item(BLOCKS), "Slab not exhausted");
+	zassert_is_null(slab_res.allocate(16), "Larger than a block");
+
+	for (i = 0; i < BLOCKS; i++) {
+		zassert_equal(items[i]->value, (u32_t)i, NULL);
+		delete items[i];
+	}
+
+	zassert_equal(k_mem_slab_num_used_get(&item_slab), 0, NULL);
+}
+
+void test_pool_resource(void)
+{
+	void *p, *q;
+
+	p = pool_res.allocate(24, 16);
+	zassert_not_null(p, NULL);
+	zassert_true(((uintptr_t)p & 15) == 0, "Allocation not aligned");
+
+	q = pool_res.allocate(100);
+	zassert_not_null(q, NULL);
+	zassert_is_null(pool_res.allocate(100), "Pool not exhausted");
+
+	pool_res.deallocate(q, 100);
+	pool_res.deallocate(p, 24, 16);
+
+	/* both blocks are back in the pool */
+	p = pool_res.allocate(100);
+	q = pool_res.allocate(100);
+	zassert_not_null(p, "Block not freed");
+	zassert_not_null(q, "Block not freed");
+	pool_res.deallocate(p, 100);
+	pool_res.deallocate(q, 100);
+}
+
+void test_monotonic_buffer_resource(void)
+{
+	zephyr::monotonic_buffer_resource res(arena, sizeof(arena));
+	zephyr::polymorphic_allocator<u32_t> alloc(&res);
+	zephyr::polymorphic_allocator<u8_t> alloc8(alloc);
+	u8_t *c;
+	u32_t *w;
+
+	zassert_true(alloc == alloc8, "Rebound allocator differs");
+
+	c = alloc8.allocate(1);
+	w = alloc.allocate(2);
+	zassert_equal((u8_t *)c, arena, NULL);
+	zassert_equal((u8_t *)w, arena + 4, "Allocation not aligned");
+	zassert_equal(res.used(), 12, NULL);
+
+	zassert_not_null(alloc.allocate(13), NULL);
+	zassert_is_null(alloc.allocate(1), "Buffer not exhausted");
+
+	res.release();
+	zassert_equal((u8_t *)alloc.allocate(16), arena, "Buffer not released");
+	zassert_is_null(alloc.allocate((size_t)-1), "Size overflow");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(cpp_memory_resource,
+			 ztest_unit_test(test_slab_resource),
+			 ztest_unit_test(test_pool_resource),
+			 ztest_unit_test(test_monotonic_buffer_resource));
+	ztest_run_test_suite(cpp_memory_resource);
+}
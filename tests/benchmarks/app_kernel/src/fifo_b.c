@@ -10,6 +10,67 @@
 
 #ifdef FIFO_BENCH
 
+/* k_fifo items, the first word is reserved for the kernel */
+static struct {
+	void *reserved;
+	u32_t data;
+} fifo_items[NR_OF_FIFO_RUNS];
+
+/**
+ *
+ * @brief k_fifo append and drain speed test
+ *
+ * Compares k_fifo_put(), which takes the lock-free append path with
+ * CONFIG_QUEUE_LOCKFREE_APPEND when nobody waits, to k_queue_prepend(),
+ * which always takes the queue lock, and draining item by item to
+ * k_fifo_get_all().
+ *
+ * @return N/A
+ */
+static void kfifo_test(void)
+{
+	u32_t et; /* elapsed time */
+	int i;
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&DEMOFIFO, &fifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+
+	PRINT_F(output_file, FORMAT, IS_ENABLED(CONFIG_QUEUE_LOCKFREE_APPEND) ?
+		"append to k_fifo (lock-free)" : "append to k_fifo (locked)",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_fifo_get(&DEMOFIFO, K_NO_WAIT);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "get one item from k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_queue_prepend(&DEMOFIFO._queue, &fifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "prepend to k_fifo (locked)",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	(void)k_fifo_get_all(&DEMOFIFO);
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "get all items from k_fifo, per item",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+}
+
 /**
  *
  * @brief Queue transfer speed test
@@ -84,6 +145,9 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT,
 			"enqueue 4 bytes in FIFO to a waiting higher priority task",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	PRINT_STRING(dashline, output_file);
+	kfifo_test();
 }
 
 #endif /* FIFO_BENCH */
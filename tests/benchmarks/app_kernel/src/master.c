@@ -44,6 +44,8 @@ K_MSGQ_DEFINE(DEMOQX4, 4, 500, 4);
 K_MSGQ_DEFINE(MB_COMM, 12, 1, 4);
 K_MSGQ_DEFINE(CH_COMM, 12, 1, 4);
 
+K_FIFO_DEFINE(DEMOFIFO);
+
 K_MEM_SLAB_DEFINE(MAP1, 16, 2, 4);
 
 K_SEM_DEFINE(SEM0, 0, 1);
@@ -137,6 +137,8 @@ extern struct k_msgq DEMOQX4;
 extern struct k_msgq MB_COMM;
 extern struct k_msgq CH_COMM;
 
+extern struct k_fifo DEMOFIFO;
+
 extern struct k_mbox MAILB1;
 
 
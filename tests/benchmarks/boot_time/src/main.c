@@ -14,9 +14,12 @@
  *  2. From __start to main()
  *  3. From __start to task
  *  4. From __start to idle
+ *  5. Device initialization at the POST_KERNEL and APPLICATION levels
+ *  6. With CONFIG_BOOT_TIME_PROFILE, each init level and device
  */
 
 #include <zephyr.h>
+#include <device.h>
 
 #include <tc_util.h>
 
@@ -24,6 +27,48 @@
 extern u64_t __start_time_stamp;    /* timestamp when kernel begins executing */
 extern u64_t __main_time_stamp;     /* timestamp when main() begins executing */
 extern u64_t __idle_time_stamp;     /* timestamp when CPU went idle */
+extern u64_t __post_kernel_init_cycles;  /* POST_KERNEL device init time */
+extern u64_t __application_init_cycles;  /* APPLICATION device init time */
+
+#ifdef CONFIG_BOOT_TIME_PROFILE
+extern u32_t z_init_level_cycles[4][2];
+extern u32_t z_device_init_cycles[CONFIG_BOOT_TIME_PROFILE_DEVICES][2];
+extern struct device __device_init_start[];
+extern struct device __device_init_end[];
+
+static void profile_report(int freq)
+{
+	static const char * const levels[] = {
+		"PRE_KERNEL_1", "PRE_KERNEL_2", "POST_KERNEL", "APPLICATION"
+	};
+	struct device *dev;
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(levels); i++) {
+		u32_t start = z_init_level_cycles[i][0];
+		u32_t end = z_init_level_cycles[i][1];
+
+		TC_PRINT("%-13s : at %u us, %u us\n", levels[i],
+			 start / freq, (end - start) / freq);
+	}
+
+	for (dev = __device_init_start, i = 0;
+	     dev < __device_init_end &&
+	     i < ARRAY_SIZE(z_device_init_cycles); dev++, i++) {
+		if (dev->config->name[0] != '\0') {
+			TC_PRINT("  %-20s: at %u us, %u cycles\n",
+				 dev->config->name,
+				 z_device_init_cycles[i][0] / freq,
+				 z_device_init_cycles[i][1]);
+		} else {
+			TC_PRINT("  init %p       : at %u us, %u cycles\n",
+				 dev->config->init,
+				 z_device_init_cycles[i][0] / freq,
+				 z_device_init_cycles[i][1]);
+		}
+	}
+}
+#endif
 
 void main(void)
 {
@@ -72,6 +117,17 @@ void main(void)
 		 (u32_t)(s_idle_time_stamp & 0xFFFFFFFFULL),
 		 (u32_t)  (idle_us  & 0xFFFFFFFFULL));
 
+	TC_PRINT("POST_KERNEL   : %u cycles, %u us\n",
+		 (u32_t)(__post_kernel_init_cycles & 0xFFFFFFFFULL),
+		 (u32_t)((__post_kernel_init_cycles / freq) & 0xFFFFFFFFULL));
+	TC_PRINT("APPLICATION   : %u cycles, %u us\n",
+		 (u32_t)(__application_init_cycles & 0xFFFFFFFFULL),
+		 (u32_t)((__application_init_cycles / freq) & 0xFFFFFFFFULL));
+
+#ifdef CONFIG_BOOT_TIME_PROFILE
+	profile_report(freq);
+#endif
+
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	/* for sanity regression test utility. */
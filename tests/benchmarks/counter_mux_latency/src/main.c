@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Lateness of alarm callbacks, from the time they were due to the time
+ * they ran: for alarms multiplexed on one counter channel and for kernel
+ * timers. Several alarms are pending at once, spread over a period, to
+ * exercise the queue of the multiplexer.
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <counter.h>
+#include <counter_mux.h>
+#include <misc/printk.h>
+
+#ifndef COUNTER_DEV_NAME
+#define COUNTER_DEV_NAME "RTC_2"
+#endif
+
+#define ALARMS 8
+#define ROUNDS 16
+#define SPREAD_US 16000 /* Delays in whole milliseconds, for k_timer */
+
+struct lateness {
+	u32_t count;
+	u64_t total_us;
+	u32_t max_us;
+};
+
+struct bench_alarm {
+	struct counter_mux_alarm alarm;
+	struct k_timer timer;
+	u32_t start;
+	u32_t delay_us;
+	struct lateness *lateness;
+};
+
+static struct counter_mux mux;
+static struct bench_alarm alarms[ALARMS];
+static struct lateness mux_lateness;
+static struct lateness timer_lateness;
+static K_SEM_DEFINE(done_sem, 0, ALARMS);
+
+static void record(struct bench_alarm *ba)
+{
+	u32_t us = (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() -
+						       ba->start) /
+			   NSEC_PER_USEC);
+	u32_t late = (us > ba->delay_us) ? us - ba->delay_us : 0U;
+
+	ba->lateness->count++;
+	ba->lateness->total_us += late;
+	ba->lateness->max_us = MAX(ba->lateness->max_us, late);
+
+	k_sem_give(&done_sem);
+}
+
+static void mux_cb(struct counter_mux_alarm *alarm, void *user_data)
+{
+	ARG_UNUSED(alarm);
+
+	record(user_data);
+}
+
+static void timer_cb(struct k_timer *timer)
+{
+	record(CONTAINER_OF(timer, struct bench_alarm, timer));
+}
+
+static void wait_round(void)
+{
+	int i;
+
+	for (i = 0; i < ALARMS; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+}
+
+static void bench_mux(struct device *dev)
+{
+	int i, round;
+
+	for (round = 0; round < ROUNDS; round++) {
+		for (i = 0; i < ALARMS; i++) {
+			struct bench_alarm *ba = &alarms[i];
+
+			/* Started out of order, to be sorted by the queue */
+			ba->delay_us = SPREAD_US * ((i * 5) % ALARMS + 1) /
+				       ALARMS;
+			ba->lateness = &mux_lateness;
+			ba->start = k_cycle_get_32();
+			counter_mux_alarm_start(&mux, &ba->alarm,
+						counter_us_to_ticks(dev,
+								ba->delay_us),
+						false);
+		}
+
+		wait_round();
+	}
+}
+
+static void bench_timer(void)
+{
+	int i, round;
+
+	for (round = 0; round < ROUNDS; round++) {
+		for (i = 0; i < ALARMS; i++) {
+			struct bench_alarm *ba = &alarms[i];
+
+			ba->delay_us = SPREAD_US * ((i * 5) % ALARMS + 1) /
+				       ALARMS;
+			ba->lateness = &timer_lateness;
+			ba->start = k_cycle_get_32();
+			k_timer_start(&ba->timer, ba->delay_us / USEC_PER_MSEC,
+				      0);
+		}
+
+		wait_round();
+	}
+}
+
+static void report(const char *what, const struct lateness *l)
+{
+	printk("%-8s %u alarms, late by %u us on average, %u us at most\n",
+	       what, l->count, (u32_t)(l->total_us / MAX(l->count, 1U)),
+	       l->max_us);
+}
+
+void main(void)
+{
+	struct device *dev = device_get_binding(COUNTER_DEV_NAME);
+	int i;
+
+	if (dev == NULL) {
+		printk("Counter %s not found\n", COUNTER_DEV_NAME);
+		return;
+	}
+
+	if (counter_mux_init(&mux, dev, 0) != 0) {
+		printk("Counter %s has no alarm channel\n", COUNTER_DEV_NAME);
+		return;
+	}
+
+	for (i = 0; i < ALARMS; i++) {
+		counter_mux_alarm_init(&alarms[i].alarm, mux_cb, &alarms[i]);
+		k_timer_init(&alarms[i].timer, timer_cb, NULL);
+	}
+
+	bench_mux(dev);
+	bench_timer();
+
+	report("mux", &mux_lateness);
+	report("k_timer", &timer_lateness);
+}
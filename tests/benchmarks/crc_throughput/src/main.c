@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of the CRC routines over a buffer at an aligned and an
+ * unaligned offset. The implementations compared are selected with the
+ * CRC32_IEEE_IMPL choice and the CRC16_TABLE and CRC8_TABLE options.
+ */
+
+#include <zephyr.h>
+#include <crc.h>
+#include <misc/printk.h>
+
+#define BUF_SIZE 4096
+#define ROUNDS 16
+
+static u8_t data[BUF_SIZE + 1] __aligned(4);
+
+static u32_t elapsed_us(u32_t start)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+		       NSEC_PER_USEC);
+}
+
+static void report(const char *what, const u8_t *buf, u32_t us, u32_t crc)
+{
+	printk("%-12s %s %u bytes in %u us: %u KiB/s (crc 0x%08x)\n", what,
+	       (((uintptr_t)buf & 0x3) == 0U) ? "aligned  " : "unaligned",
+	       BUF_SIZE * ROUNDS, us,
+	       (unsigned int)((u64_t)BUF_SIZE * ROUNDS * USEC_PER_SEC /
+			      1024U / MAX(us, 1U)), crc);
+}
+
+static void bench_crc32_ieee(const u8_t *buf)
+{
+	u32_t start, crc = 0;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		crc = crc32_ieee_update(crc, buf, BUF_SIZE);
+	}
+
+	report("crc32_ieee", buf, elapsed_us(start), crc);
+}
+
+static void bench_crc16(const u8_t *buf)
+{
+	u32_t start;
+	u16_t crc = 0;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		crc = crc16(buf, BUF_SIZE, 0x1021, crc, true);
+	}
+
+	report("crc16", buf, elapsed_us(start), crc);
+}
+
+static void bench_crc16_ccitt(const u8_t *buf)
+{
+	u32_t start;
+	u16_t crc = 0;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		crc = crc16_ccitt(crc, buf, BUF_SIZE);
+	}
+
+	report("crc16_ccitt", buf, elapsed_us(start), crc);
+}
+
+static void bench_crc8_ccitt(const u8_t *buf)
+{
+	u32_t start;
+	u8_t crc = CRC8_CCITT_INITIAL_VALUE;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		crc = crc8_ccitt(crc, buf, BUF_SIZE);
+	}
+
+	report("crc8_ccitt", buf, elapsed_us(start), crc);
+}
+
+void main(void)
+{
+	int i, offset;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = (u8_t)(i * 31U + 7U);
+	}
+
+	for (offset = 0; offset < 2; offset++) {
+		bench_crc32_ieee(&data[offset]);
+		bench_crc16(&data[offset]);
+		bench_crc16_ccitt(&data[offset]);
+		bench_crc8_ccitt(&data[offset]);
+	}
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Mount time and sequential write and read throughput of the flash file
+ * system built in, littlefs or NFFS, on the storage partition. Build it
+ * once per file system to compare them on the same board.
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <fs.h>
+#include <misc/printk.h>
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+#include <fs/littlefs.h>
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(storage);
+
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.mnt_point = "/lfs",
+	.fs_data = &storage,
+	.storage_dev = (void *)DT_FLASH_AREA_STORAGE_ID,
+};
+#define FS_NAME "littlefs"
+#define FILE_NAME "/lfs/bench"
+
+#elif defined(CONFIG_FILE_SYSTEM_NFFS)
+#include <nffs/nffs.h>
+
+static struct nffs_flash_desc flash_desc;
+
+static struct fs_mount_t mnt = {
+	.type = FS_NFFS,
+	.mnt_point = "/nffs",
+	.fs_data = &flash_desc,
+};
+#define FS_NAME "NFFS"
+#define FILE_NAME "/nffs/bench"
+
+#else
+#error "No flash file system enabled"
+#endif
+
+#define FILE_SIZE (32 * 1024)
+#define CHUNK_SIZE 256
+
+static u8_t chunk[CHUNK_SIZE];
+
+static u32_t elapsed_us(u32_t start)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+		       NSEC_PER_USEC);
+}
+
+static void report(const char *what, size_t bytes, u32_t us)
+{
+	printk("%-6s %u bytes in %u us: %u KiB/s\n", what,
+	       (unsigned int)bytes, us,
+	       (unsigned int)((u64_t)bytes * USEC_PER_SEC / 1024U /
+			      MAX(us, 1U)));
+}
+
+static int bench_write(void)
+{
+	struct fs_file_t file;
+	u32_t start;
+	size_t off;
+	int rc;
+
+	(void)fs_unlink(FILE_NAME);
+
+	start = k_cycle_get_32();
+
+	rc = fs_open(&file, FILE_NAME);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (off = 0; off < FILE_SIZE; off += CHUNK_SIZE) {
+		(void)memset(chunk, (u8_t)(off / CHUNK_SIZE), sizeof(chunk));
+		rc = fs_write(&file, chunk, sizeof(chunk));
+		if (rc != sizeof(chunk)) {
+			(void)fs_close(&file);
+			return (rc < 0) ? rc : -ENOSPC;
+		}
+	}
+
+	rc = fs_close(&file);
+	report("write", FILE_SIZE, elapsed_us(start));
+
+	return rc;
+}
+
+static int bench_read(void)
+{
+	struct fs_file_t file;
+	u32_t start;
+	size_t off;
+	int rc;
+
+	start = k_cycle_get_32();
+
+	rc = fs_open(&file, FILE_NAME);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (off = 0; off < FILE_SIZE; off += CHUNK_SIZE) {
+		rc = fs_read(&file, chunk, sizeof(chunk));
+		if (rc != sizeof(chunk) ||
+		    chunk[0] != (u8_t)(off / CHUNK_SIZE)) {
+			(void)fs_close(&file);
+			return (rc < 0) ? rc : -EIO;
+		}
+	}
+
+	rc = fs_close(&file);
+	report("read", FILE_SIZE, elapsed_us(start));
+
+	return rc;
+}
+
+void main(void)
+{
+	u32_t start;
+	int rc;
+
+#if defined(CONFIG_FILE_SYSTEM_NFFS)
+	mnt.storage_dev = device_get_binding(CONFIG_FS_NFFS_FLASH_DEV_NAME);
+#endif
+
+	printk("File system throughput: %s\n", FS_NAME);
+
+	start = k_cycle_get_32();
+	rc = fs_mount(&mnt);
+	if (rc < 0) {
+		printk("mount failed (%d)\n", rc);
+		return;
+	}
+	printk("mount  %u us\n", elapsed_us(start));
+
+	rc = bench_write();
+	if (rc < 0) {
+		printk("write failed (%d)\n", rc);
+		return;
+	}
+
+	rc = bench_read();
+	if (rc < 0) {
+		printk("read failed (%d)\n", rc);
+		return;
+	}
+
+	/* the mount time of a file system holding data is the one to compare */
+	printk("Reset the board to measure the mount time with data\n");
+}
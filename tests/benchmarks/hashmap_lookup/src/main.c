@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Lookup time of sys_hashmap against the red/black tree of rb.c and a
+ * linear scan of a sys_slist, for a range of sizes. Each structure holds
+ * the same nodes keyed by a sparse 32-bit identifier, and is queried with
+ * a mix of hits and misses, as connection or key tables are.
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <misc/hashmap.h>
+#include <misc/rb.h>
+#include <misc/slist.h>
+
+#define MAX_NODES 256
+#define LOOKUPS 4096
+
+struct node {
+	u32_t key;
+	struct sys_hashmap_node hnode;
+	struct rbnode rbnode;
+	sys_snode_t snode;
+};
+
+static struct node nodes[MAX_NODES];
+static u32_t queries[LOOKUPS];
+
+/* twice as many slots as nodes, for a load factor of one half */
+static struct sys_hashmap_node *slots[2 * MAX_NODES];
+static struct sys_hashmap map;
+static struct rbtree tree;
+static sys_slist_t list;
+
+static u32_t hash_key(const void *key)
+{
+	return sys_hash32_u32(*(const u32_t *)key);
+}
+
+static bool hnode_eq(const struct sys_hashmap_node *hnode, const void *key)
+{
+	return CONTAINER_OF(hnode, struct node, hnode)->key ==
+	       *(const u32_t *)key;
+}
+
+static bool rbnode_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct node, rbnode)->key <
+	       CONTAINER_OF(b, struct node, rbnode)->key;
+}
+
+static struct node *rb_lookup(u32_t key)
+{
+	struct rbnode *n = tree.root;
+	struct node *found;
+
+	while (n) {
+		found = CONTAINER_OF(n, struct node, rbnode);
+		if (found->key == key) {
+			return found;
+		}
+
+		n = z_rb_child(n, key > found->key);
+	}
+
+	return NULL;
+}
+
+static struct node *hashmap_lookup(u32_t key)
+{
+	struct sys_hashmap_node *hnode = sys_hashmap_get(&map, &key);
+
+	return hnode ? CONTAINER_OF(hnode, struct node, hnode) : NULL;
+}
+
+static struct node *list_lookup(u32_t key)
+{
+	struct node *n;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&list, n, snode) {
+		if (n->key == key) {
+			return n;
+		}
+	}
+
+	return NULL;
+}
+
+static u32_t next_rand(u32_t *state)
+{
+	/* xorshift32, reproducible across runs */
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+static void setup(size_t count)
+{
+	u32_t state = 0x2545f491;
+	size_t i;
+
+	sys_hashmap_init(&map, slots, ARRAY_SIZE(slots), hash_key, hnode_eq);
+	tree = (struct rbtree){ .lessthan_fn = rbnode_lessthan };
+	sys_slist_init(&list);
+
+	for (i = 0; i < count; i++) {
+		do {
+			nodes[i].key = next_rand(&state);
+		} while (hashmap_lookup(nodes[i].key));
+
+		sys_hashmap_insert(&map, &nodes[i].hnode, &nodes[i].key);
+		rb_insert(&tree, &nodes[i].rbnode);
+		sys_slist_append(&list, &nodes[i].snode);
+	}
+
+	/* three hits for one miss */
+	for (i = 0; i < LOOKUPS; i++) {
+		if (i % 4 == 3) {
+			queries[i] = next_rand(&state);
+		} else {
+			queries[i] = nodes[next_rand(&state) % count].key;
+		}
+	}
+}
+
+static void bench(const char *what, size_t count,
+		  struct node *(*lookup)(u32_t key))
+{
+	u32_t start, cycles;
+	size_t i, hits = 0;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < LOOKUPS; i++) {
+		if (lookup(queries[i])) {
+			hits++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	printk("%-8s %3u nodes: %u cycles per lookup (%u hits)\n", what,
+	       (unsigned int)count, cycles / LOOKUPS, (unsigned int)hits);
+}
+
+void main(void)
+{
+	static const size_t sizes[] = { 8, 32, 128, MAX_NODES };
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+		setup(sizes[i]);
+		bench("hashmap", sizes[i], hashmap_lookup);
+		bench("rbtree", sizes[i], rb_lookup);
+		bench("slist", sizes[i], list_lookup);
+	}
+}
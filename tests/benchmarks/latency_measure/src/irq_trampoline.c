@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure interrupt entry through the ISR wrapper and a trampoline
+ *
+ * This file contains the test that measures the time from pending an
+ * interrupt to executing its ISR, for an interrupt dispatched by the common
+ * _isr_wrapper and for one dispatched by its own trampoline
+ * (CONFIG_ARM_ISR_TRAMPOLINES).
+ */
+
+#include <zephyr.h>
+#include <irq.h>
+
+#include "timestamp.h"
+#include "utils.h"
+
+#if defined(CONFIG_ARM_ISR_TRAMPOLINES)
+#include <arch/arm/cortex_m/cmsis.h>
+
+#define N_TEST_IRQ 1000
+
+/* Two lines at the top of the range, unused by the test platforms */
+#define WRAPPER_IRQ	(CONFIG_NUM_IRQS - 1)
+#define TRAMPOLINE_IRQ	(CONFIG_NUM_IRQS - 2)
+
+static volatile u32_t isr_timestamp;
+
+static void latency_isr(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	isr_timestamp = TIME_STAMP_DELTA_GET(0);
+}
+
+static u32_t irq_entry_time(int irq)
+{
+	u32_t total = 0U;
+	u32_t start;
+	int i;
+
+	irq_enable(irq);
+	for (i = 0; i < N_TEST_IRQ; i++) {
+		start = TIME_STAMP_DELTA_GET(0);
+		NVIC_SetPendingIRQ(irq);
+		/* The ISR runs before the next instruction completes */
+		__ISB();
+		total += isr_timestamp - start;
+	}
+	irq_disable(irq);
+
+	return total;
+}
+
+/**
+ *
+ * @brief The function measures interrupt entry latency
+ *
+ * @return 0 on success
+ */
+int irq_trampoline_latency(void)
+{
+	u32_t wrapper, trampoline;
+
+	PRINT_FORMAT(" 9 - Measure time from pending an interrupt to its ISR");
+
+	IRQ_CONNECT(WRAPPER_IRQ, 0, latency_isr, NULL, 0);
+	IRQ_CONNECT(TRAMPOLINE_IRQ, 0, latency_isr, NULL, IRQ_TRAMPOLINE);
+
+	bench_test_start();
+	wrapper = irq_entry_time(WRAPPER_IRQ);
+	trampoline = irq_entry_time(TRAMPOLINE_IRQ);
+	if (bench_test_end() != 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+		return 0;
+	}
+
+	PRINT_FORMAT(" Through _isr_wrapper %u tcs = %u nsec",
+		     wrapper / N_TEST_IRQ,
+		     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(wrapper, N_TEST_IRQ));
+	PRINT_FORMAT(" Through trampoline %u tcs = %u nsec",
+		     trampoline / N_TEST_IRQ,
+		     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(trampoline, N_TEST_IRQ));
+	PRINT_FORMAT(" Delta %d tcs",
+		     (int)(wrapper - trampoline) / N_TEST_IRQ);
+
+	return 0;
+}
+
+#endif /* CONFIG_ARM_ISR_TRAMPOLINES */
@@ -25,6 +25,9 @@ extern void int_to_thread_evt(void);
 extern void sema_lock_unlock(void);
 extern void mutex_lock_unlock(void);
 extern int coop_ctx_switch(void);
+extern int user_sema_give_take(void);
+extern int user_thread_switch_yield(void);
+extern int irq_trampoline_latency(void);
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
 	PRINT_BANNER();
@@ -50,6 +53,19 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 	coop_ctx_switch();
 	print_dash_line();
 
+#ifdef CONFIG_USERSPACE
+	user_sema_give_take();
+	print_dash_line();
+
+	user_thread_switch_yield();
+	print_dash_line();
+#endif
+
+#ifdef CONFIG_ARM_ISR_TRAMPOLINES
+	irq_trampoline_latency();
+	print_dash_line();
+#endif
+
 	TC_END_REPORT(error_count);
 }
 
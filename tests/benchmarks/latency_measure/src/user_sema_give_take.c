@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for sema give and take from user mode
+ *
+ * This file contains the test that measures semaphore give and take time
+ * when the calls are system calls made by a user mode thread, so that the
+ * cost of kernel object validation is part of the figure. Building with
+ * CONFIG_USERSPACE_OBJ_HANDLES shows the gain of the per-thread handle
+ * table over looking the semaphore up on every call.
+ */
+
+#include <zephyr.h>
+
+#include "timestamp.h"
+#include "utils.h"
+
+#ifdef CONFIG_USERSPACE
+
+/* the number of semaphore give/take cycles */
+#define N_TEST_USER_SEMA 1000
+
+#define USER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_DEFINE(user_stack, USER_STACK_SIZE);
+static struct k_thread user_thread;
+
+K_SEM_DEFINE(user_sema, 0, N_TEST_USER_SEMA);
+K_SEM_DEFINE(user_start_sema, 0, 1);
+K_SEM_DEFINE(user_done_sema, 0, 1);
+
+static void user_sema_loop(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&user_start_sema, K_FOREVER);
+	for (i = 0; i < N_TEST_USER_SEMA; i++) {
+		k_sem_give(&user_sema);
+	}
+	k_sem_give(&user_done_sema);
+
+	k_sem_take(&user_start_sema, K_FOREVER);
+	for (i = 0; i < N_TEST_USER_SEMA; i++) {
+		k_sem_take(&user_sema, K_FOREVER);
+	}
+	k_sem_give(&user_done_sema);
+}
+
+/* The user thread can't read the cycle counter on all architectures, so
+ * each run is timed from the supervisor side, from starting the user
+ * thread until it reports completion. Two context switches are included
+ * in the total and amortized over the loop.
+ */
+static u32_t user_sema_run(void)
+{
+	u32_t timestamp;
+
+	timestamp = TIME_STAMP_DELTA_GET(0);
+	k_sem_give(&user_start_sema);
+	k_sem_take(&user_done_sema, K_FOREVER);
+
+	return TIME_STAMP_DELTA_GET(timestamp);
+}
+
+/**
+ *
+ * @brief The function tests semaphore give/take time from user mode
+ *
+ * The routine starts a user mode thread giving the semaphore many times,
+ * then taking it as many times, and measures the time of each loop.
+ *
+ * @return 0 on success
+ */
+int user_sema_give_take(void)
+{
+	u32_t timestamp;
+
+	PRINT_FORMAT(" 7 - Measure average time to signal a sema then test"
+		     " that sema from user mode");
+
+	k_thread_create(&user_thread, user_stack, USER_STACK_SIZE,
+			user_sema_loop, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), K_USER, K_FOREVER);
+	k_object_access_grant(&user_sema, &user_thread);
+	k_object_access_grant(&user_start_sema, &user_thread);
+	k_object_access_grant(&user_done_sema, &user_thread);
+	k_thread_start(&user_thread);
+
+	bench_test_start();
+	timestamp = user_sema_run();
+	if (bench_test_end() == 0) {
+		PRINT_FORMAT(" Average user semaphore signal time %u tcs = %u"
+			     " nsec",
+			     timestamp / N_TEST_USER_SEMA,
+			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp,
+							   N_TEST_USER_SEMA));
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+
+	bench_test_start();
+	timestamp = user_sema_run();
+	if (bench_test_end() == 0) {
+		PRINT_FORMAT(" Average user semaphore test time %u tcs = %u"
+			     " nsec",
+			     timestamp / N_TEST_USER_SEMA,
+			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp,
+							   N_TEST_USER_SEMA));
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+
+	k_thread_abort(&user_thread);
+
+	return 0;
+}
+
+#endif /* CONFIG_USERSPACE */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure context switch time between user mode threads
+ *
+ * This file contains the test that measures the average time of a context
+ * switch using k_yield() between two user mode threads of the same memory
+ * domain. On a switch the MPU regions of the incoming thread are
+ * programmed, those of the domain partitions being the same for both
+ * threads, which CONFIG_ARM_MPU_REGION_CACHE avoids writing again.
+ */
+
+#include <zephyr.h>
+#include <stdlib.h>
+
+#include "timestamp.h"
+#include "utils.h"
+
+#ifdef CONFIG_USERSPACE
+
+/* the number of yields of each thread */
+#define N_TEST_USER_YIELD 1000
+
+#define USER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+/* below the priority of the test thread, which starts both threads before
+ * they run
+ */
+#define USER_PRIORITY 11
+
+/* smallest partition all MPUs accept */
+#define USER_PART_SIZE 32
+
+static K_THREAD_STACK_ARRAY_DEFINE(user_yield_stacks, 2, USER_STACK_SIZE);
+static struct k_thread user_yield_threads[2];
+
+/* iterations of each thread, in the partition of their memory domain */
+static union {
+	u32_t iterations[2];
+	u8_t data[USER_PART_SIZE];
+} __aligned(USER_PART_SIZE) user_yield_data;
+
+K_MEM_PARTITION_DEFINE(user_yield_part, &user_yield_data,
+		       sizeof(user_yield_data), K_MEM_PARTITION_P_RW_U_RW);
+
+static struct k_mem_partition *user_yield_parts[] = {
+	&user_yield_part,
+};
+
+static struct k_mem_domain user_yield_domain;
+
+K_SEM_DEFINE(user_yield_start_sema, 0, 2);
+K_SEM_DEFINE(user_yield_done_sema, 0, 2);
+
+static void user_yield_loop(void *p1, void *p2, void *p3)
+{
+	u32_t *iterations = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&user_yield_start_sema, K_FOREVER);
+	while (*iterations < N_TEST_USER_YIELD) {
+		k_yield();
+		(*iterations)++;
+	}
+	k_sem_give(&user_yield_done_sema);
+}
+
+/**
+ *
+ * @brief The function tests context switch time between user threads
+ *
+ * The routine starts two user mode threads of the same memory domain
+ * yielding to each other, and measures the time until both are done from
+ * the supervisor side.
+ *
+ * @return 0 on success
+ */
+int user_thread_switch_yield(void)
+{
+	u32_t timestamp;
+	u32_t total;
+	s32_t delta;
+	int i;
+
+	PRINT_FORMAT(" 8 - Measure average context switch time between user"
+		     " threads of a memory domain using (k_yield)");
+
+	k_mem_domain_init(&user_yield_domain, ARRAY_SIZE(user_yield_parts),
+			  user_yield_parts);
+
+	for (i = 0; i < 2; i++) {
+		k_thread_create(&user_yield_threads[i], user_yield_stacks[i],
+				USER_STACK_SIZE, user_yield_loop,
+				&user_yield_data.iterations[i], NULL, NULL,
+				USER_PRIORITY, K_USER, K_FOREVER);
+		k_mem_domain_add_thread(&user_yield_domain,
+					&user_yield_threads[i]);
+		k_object_access_grant(&user_yield_start_sema,
+				      &user_yield_threads[i]);
+		k_object_access_grant(&user_yield_done_sema,
+				      &user_yield_threads[i]);
+		k_thread_start(&user_yield_threads[i]);
+	}
+
+	bench_test_start();
+
+	/* The switches to and from the test thread are included in the
+	 * total and amortized over the loop.
+	 */
+	timestamp = TIME_STAMP_DELTA_GET(0);
+	k_sem_give(&user_yield_start_sema);
+	k_sem_give(&user_yield_start_sema);
+	k_sem_take(&user_yield_done_sema, K_FOREVER);
+	k_sem_take(&user_yield_done_sema, K_FOREVER);
+	timestamp = TIME_STAMP_DELTA_GET(timestamp);
+
+	total = user_yield_data.iterations[0] + user_yield_data.iterations[1];
+	delta = user_yield_data.iterations[0] - user_yield_data.iterations[1];
+
+	if (bench_test_end() < 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	} else if (abs(delta) > 1) {
+		error_count++;
+		PRINT_FORMAT(" Error, iterations:%u and %u",
+			     user_yield_data.iterations[0],
+			     user_yield_data.iterations[1]);
+	} else {
+		PRINT_FORMAT(" Average user thread context switch using "
+			     "yield %u tcs = %u nsec",
+			     timestamp / total,
+			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp, total));
+	}
+
+	for (i = 0; i < 2; i++) {
+		k_thread_abort(&user_yield_threads[i]);
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_USERSPACE */
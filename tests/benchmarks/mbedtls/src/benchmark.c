@@ -69,6 +69,7 @@
 
 #include <zephyr/types.h>
 #include <misc/byteorder.h>
+#include <zephyr_mbedtls.h>
 
 #include "kernel.h"
 
@@ -288,6 +289,151 @@ typedef struct {
 	     havege, ctr_drbg, hmac_drbg, rsa, dhm, ecdsa, ecdh;
 } todo_list;
 
+#if defined(MBEDTLS_AES_C)
+/* The AES modes, run again in software when accelerated */
+static void bench_aes(const todo_list *todo, const char *suffix)
+{
+	unsigned char tmp[200];
+	char title[TITLE_LEN];
+
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+	if (todo->aes_cbc) {
+		int keysize;
+		mbedtls_aes_context aes;
+
+		mbedtls_aes_init(&aes);
+
+		for (keysize = 128; keysize <= 256; keysize += 64) {
+			snprintk(title, sizeof(title),
+				 "AES-CBC-%d%s", keysize, suffix);
+
+			memset(buf, 0, sizeof(buf));
+			memset(tmp, 0, sizeof(tmp));
+			mbedtls_aes_setkey_enc(&aes, tmp, keysize);
+
+			TIME_AND_TSC(title,
+				     mbedtls_aes_crypt_cbc(&aes,
+						   MBEDTLS_AES_ENCRYPT,
+						   BUFSIZE, tmp, buf, buf));
+		}
+
+		mbedtls_aes_free(&aes);
+	}
+#endif
+#if defined(MBEDTLS_CIPHER_MODE_XTS)
+	if (todo->aes_xts) {
+		int keysize;
+		mbedtls_aes_xts_context ctx;
+
+		mbedtls_aes_xts_init(&ctx);
+
+		for (keysize = 128; keysize <= 256; keysize += 128) {
+			snprintk(title, sizeof(title),
+				 "AES-XTS-%d%s", keysize, suffix);
+
+			memset(buf, 0, sizeof(buf));
+			memset(tmp, 0, sizeof(tmp));
+
+			mbedtls_aes_xts_setkey_enc(&ctx, tmp, keysize * 2);
+
+			TIME_AND_TSC(title,
+				     mbedtls_aes_crypt_xts(&ctx,
+						MBEDTLS_AES_ENCRYPT, BUFSIZE,
+						tmp, buf, buf));
+
+			mbedtls_aes_xts_free(&ctx);
+		}
+	}
+#endif
+#if defined(MBEDTLS_GCM_C)
+	if (todo->aes_gcm) {
+		int keysize;
+		mbedtls_gcm_context gcm;
+
+		mbedtls_gcm_init(&gcm);
+
+		for (keysize = 128; keysize <= 256; keysize += 64) {
+			snprintk(title, sizeof(title), "AES-GCM-%d%s",
+				 keysize, suffix);
+
+			memset(buf, 0, sizeof(buf));
+			memset(tmp, 0, sizeof(tmp));
+			mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, tmp,
+					   keysize);
+
+			TIME_AND_TSC(title,
+				     mbedtls_gcm_crypt_and_tag(&gcm,
+							MBEDTLS_GCM_ENCRYPT,
+							BUFSIZE, tmp,
+							12, NULL, 0, buf, buf,
+							16, tmp));
+			mbedtls_gcm_free(&gcm);
+		}
+	}
+#endif
+#if defined(MBEDTLS_CCM_C)
+	if (todo->aes_ccm) {
+		int keysize;
+		mbedtls_ccm_context ccm;
+
+		mbedtls_ccm_init(&ccm);
+
+		for (keysize = 128; keysize <= 256; keysize += 64) {
+			snprintk(title, sizeof(title), "AES-CCM-%d%s",
+				 keysize, suffix);
+
+			memset(buf, 0, sizeof(buf));
+			memset(tmp, 0, sizeof(tmp));
+			mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES, tmp,
+					   keysize);
+
+			TIME_AND_TSC(title,
+				     mbedtls_ccm_encrypt_and_tag(&ccm, BUFSIZE,
+							tmp, 12, NULL, 0, buf,
+							buf, tmp, 16));
+
+			mbedtls_ccm_free(&ccm);
+		}
+	}
+#endif
+#if defined(MBEDTLS_CMAC_C)
+	if (todo->aes_cmac) {
+		unsigned char output[16];
+		const mbedtls_cipher_info_t *cipher_info;
+		mbedtls_cipher_type_t cipher_type;
+		int keysize;
+
+		for (keysize = 128, cipher_type = MBEDTLS_CIPHER_AES_128_ECB;
+		     keysize <= 256; keysize += 64, cipher_type++) {
+			snprintk(title, sizeof(title), "AES-CMAC-%d%s",
+				 keysize, suffix);
+
+			memset(buf, 0, sizeof(buf));
+			memset(tmp, 0, sizeof(tmp));
+
+			cipher_info = mbedtls_cipher_info_from_type(
+							cipher_type);
+
+			TIME_AND_TSC(title,
+				     mbedtls_cipher_cmac(cipher_info,
+							 tmp, keysize,
+							 buf, BUFSIZE,
+							 output));
+		}
+
+		memset(buf, 0, sizeof(buf));
+		memset(tmp, 0, sizeof(tmp));
+
+		snprintk(title, sizeof(title), "AES-CMAC-PRF-128%s", suffix);
+
+		TIME_AND_TSC(title,
+			     mbedtls_aes_cmac_prf_128(tmp, 16, buf, BUFSIZE,
+						      output));
+	}
+#endif /* MBEDTLS_CMAC_C */
+}
+#endif /* MBEDTLS_AES_C */
+
 int main(int argc, char *argv[])
 {
 	mbedtls_ssl_config conf;
@@ -297,6 +443,7 @@ int main(int argc, char *argv[])
 	int i;
 
 	printk("\tMBEDTLS Benchmark sample\n");
+	zephyr_mbedtls_accel_report();
 
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #if defined(MBEDTLS_PLATFORM_PRINTF_ALT)
@@ -411,105 +558,7 @@ int main(int argc, char *argv[])
 #endif /* MBEDTLS_DES_C */
 
 #if defined(MBEDTLS_AES_C)
-#if defined(MBEDTLS_CIPHER_MODE_CBC)
-	if (todo.aes_cbc) {
-		int keysize;
-		mbedtls_aes_context aes;
-
-		mbedtls_aes_init(&aes);
-
-		for (keysize = 128; keysize <= 256; keysize += 64) {
-			snprintk(title, sizeof(title),
-				 "AES-CBC-%d", keysize);
-
-			memset(buf, 0, sizeof(buf));
-			memset(tmp, 0, sizeof(tmp));
-			mbedtls_aes_setkey_enc(&aes, tmp, keysize);
-
-			TIME_AND_TSC(title,
-				     mbedtls_aes_crypt_cbc(&aes,
-						   MBEDTLS_AES_ENCRYPT,
-						   BUFSIZE, tmp, buf, buf));
-		}
-
-		mbedtls_aes_free(&aes);
-	}
-#endif
-#if defined(MBEDTLS_CIPHER_MODE_XTS)
-	if (todo.aes_xts) {
-		int keysize;
-		mbedtls_aes_xts_context ctx;
-
-		mbedtls_aes_xts_init(&ctx);
-
-		for (keysize = 128; keysize <= 256; keysize += 128) {
-			snprintk(title, sizeof(title),
-				 "AES-XTS-%d", keysize);
-
-			memset(buf, 0, sizeof(buf));
-			memset(tmp, 0, sizeof(tmp));
-
-			mbedtls_aes_xts_setkey_enc(&ctx, tmp, keysize * 2);
-
-			TIME_AND_TSC(title,
-				     mbedtls_aes_crypt_xts(&ctx,
-						MBEDTLS_AES_ENCRYPT, BUFSIZE,
-						tmp, buf, buf));
-
-			mbedtls_aes_xts_free(&ctx);
-		}
-	}
-#endif
-#if defined(MBEDTLS_GCM_C)
-	if (todo.aes_gcm) {
-		int keysize;
-		mbedtls_gcm_context gcm;
-
-		mbedtls_gcm_init(&gcm);
-
-		for (keysize = 128; keysize <= 256; keysize += 64) {
-			snprintk(title, sizeof(title), "AES-GCM-%d",
-				 keysize);
-
-			memset(buf, 0, sizeof(buf));
-			memset(tmp, 0, sizeof(tmp));
-			mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, tmp,
-					   keysize);
-
-			TIME_AND_TSC(title,
-				     mbedtls_gcm_crypt_and_tag(&gcm,
-							MBEDTLS_GCM_ENCRYPT,
-							BUFSIZE, tmp,
-							12, NULL, 0, buf, buf,
-							16, tmp));
-			mbedtls_gcm_free(&gcm);
-		}
-	}
-#endif
-#if defined(MBEDTLS_CCM_C)
-	if (todo.aes_ccm) {
-		int keysize;
-		mbedtls_ccm_context ccm;
-
-		mbedtls_ccm_init(&ccm);
-
-		for (keysize = 128; keysize <= 256; keysize += 64) {
-			snprintk(title, sizeof(title), "AES-CCM-%d",
-				 keysize);
-
-			memset(buf, 0, sizeof(buf));
-			memset(tmp, 0, sizeof(tmp));
-			mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES, tmp,
-					   keysize);
-
-			TIME_AND_TSC(title,
-				     mbedtls_ccm_encrypt_and_tag(&ccm, BUFSIZE,
-							tmp, 12, NULL, 0, buf,
-							buf, tmp, 16));
-
-			mbedtls_ccm_free(&ccm);
-		}
-	}
+	bench_aes(&todo, "");
 #endif
 #if defined(MBEDTLS_CHACHAPOLY_C)
 	if (todo.chachapoly) {
@@ -531,40 +580,6 @@ int main(int argc, char *argv[])
 		mbedtls_chachapoly_free(&chachapoly);
 	}
 #endif
-#if defined(MBEDTLS_CMAC_C)
-	if (todo.aes_cmac) {
-		unsigned char output[16];
-		const mbedtls_cipher_info_t *cipher_info;
-		mbedtls_cipher_type_t cipher_type;
-		int keysize;
-
-		for (keysize = 128, cipher_type = MBEDTLS_CIPHER_AES_128_ECB;
-		     keysize <= 256; keysize += 64, cipher_type++) {
-			snprintk(title, sizeof(title), "AES-CMAC-%d",
-				 keysize);
-
-			memset(buf, 0, sizeof(buf));
-			memset(tmp, 0, sizeof(tmp));
-
-			cipher_info = mbedtls_cipher_info_from_type(
-							cipher_type);
-
-			TIME_AND_TSC(title,
-				     mbedtls_cipher_cmac(cipher_info,
-							 tmp, keysize,
-							 buf, BUFSIZE,
-							 output));
-		}
-
-		memset(buf, 0, sizeof(buf));
-		memset(tmp, 0, sizeof(tmp));
-
-		TIME_AND_TSC("AES-CMAC-PRF-128",
-			     mbedtls_aes_cmac_prf_128(tmp, 16, buf, BUFSIZE,
-						      output));
-	}
-#endif /* MBEDTLS_CMAC_C */
-#endif /* MBEDTLS_AES_C */
 
 #if defined(MBEDTLS_ARIA_C) && defined(MBEDTLS_CIPHER_MODE_CBC)
 	if (todo.aria) {
@@ -1061,6 +1076,15 @@ int main(int argc, char *argv[])
 		}
 	}
 #endif
+#if defined(MBEDTLS_AES_C)
+	/* Software numbers of the accelerated paths, on the same board */
+	if (zephyr_mbedtls_accel_get() & ZEPHYR_MBEDTLS_ACCEL_AES) {
+		zephyr_mbedtls_accel_set(0);
+		bench_aes(&todo, " (sw)");
+		zephyr_mbedtls_accel_set(ZEPHYR_MBEDTLS_ACCEL_AES);
+	}
+#endif
+
 	mbedtls_printf("\n       Done\n");
 
 	return 0;
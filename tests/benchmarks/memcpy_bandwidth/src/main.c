@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Bandwidth of memcpy(), memmove() and memset() for a range of sizes, with
+ * the source and destination aligned to each other and misaligned by one
+ * byte. Build with and without CONFIG_MINIMAL_LIBC_OPTIMIZED_MEM, or with
+ * newlib, to compare the implementations.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <misc/printk.h>
+
+#define BUF_SIZE 4096
+#define BYTES_PER_RUN (64 * 1024)
+
+static u8_t src_buf[BUF_SIZE + 8] __aligned(4);
+static u8_t dst_buf[BUF_SIZE + 8] __aligned(4);
+
+static const size_t sizes[] = { 16, 64, 256, 1024, BUF_SIZE };
+
+static u32_t elapsed_us(u32_t start)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+		       NSEC_PER_USEC);
+}
+
+static void report(const char *what, size_t size, int offset, u32_t us)
+{
+	printk("%-8s %4u bytes, offset %d: %u KiB/s\n", what,
+	       (unsigned int)size, offset,
+	       (unsigned int)((u64_t)BYTES_PER_RUN * USEC_PER_SEC / 1024U /
+			      MAX(us, 1U)));
+}
+
+static void bench_memcpy(size_t size, int offset)
+{
+	u32_t start;
+	size_t i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < BYTES_PER_RUN / size; i++) {
+		memcpy(dst_buf, src_buf + offset, size);
+	}
+
+	report("memcpy", size, offset, elapsed_us(start));
+
+	if (memcmp(dst_buf, src_buf + offset, size) != 0) {
+		printk("memcpy of %u bytes corrupted data\n",
+		       (unsigned int)size);
+	}
+}
+
+static void bench_memmove(size_t size, int offset)
+{
+	u32_t start;
+	size_t i;
+
+	memcpy(dst_buf, src_buf, sizeof(dst_buf));
+	start = k_cycle_get_32();
+
+	/* overlapping backward copies, the worst case of memmove() */
+	for (i = 0; i < BYTES_PER_RUN / size; i++) {
+		memmove(dst_buf + 4 + offset, dst_buf, size);
+	}
+
+	report("memmove", size, offset, elapsed_us(start));
+}
+
+static void bench_memset(size_t size, int offset)
+{
+	u32_t start;
+	size_t i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < BYTES_PER_RUN / size; i++) {
+		memset(dst_buf + offset, (int)i, size);
+	}
+
+	report("memset", size, offset, elapsed_us(start));
+}
+
+void main(void)
+{
+	int i, offset;
+
+	for (i = 0; i < sizeof(src_buf); i++) {
+		src_buf[i] = (u8_t)(i * 31U + 7U);
+	}
+
+	for (offset = 0; offset < 2; offset++) {
+		for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+			bench_memcpy(sizes[i], offset);
+			bench_memmove(sizes[i], offset);
+			bench_memset(sizes[i], offset);
+		}
+	}
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Throughput, packet rate and latency of the network stack.
+ *
+ * The UDP measures go through an echo server, on UDP port 7, and the TCP
+ * one into a discard server, on TCP port 9. Both run in this application
+ * over the loopback interface, or on a peer given as NET_BENCH_PEER when
+ * building, for instance with socat:
+ *
+ *   socat UDP4-RECVFROM:7,fork EXEC:cat
+ *   socat TCP4-LISTEN:9,fork,reuseaddr OPEN:/dev/null
+ *
+ * The results are reported through the ztest benchmark harness.
+ */
+
+#include <ztest.h>
+#include <ztest_benchmark.h>
+#include <net/socket.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+
+#include "../../../net/socket/socket_helpers.h"
+
+#define ECHO_PORT 7
+#define DISCARD_PORT 9
+
+#if defined(NET_BENCH_PEER)
+#define PEER_ADDR NET_BENCH_PEER
+#else
+#define PEER_ADDR "127.0.0.1"
+#define LOCAL_SERVERS
+#endif
+
+#define UDP_PAYLOAD 512
+#define UDP_BATCH 8
+#define UDP_DATAGRAMS 2048
+#define UDP_TIMEOUT_MS 100
+
+#define TCP_TRANSFER_SIZE (256 * 1024)
+#define TCP_CHUNK_SIZE 1024
+
+#define PKT_SIZE 128
+
+#define SERVER_STACK_SIZE 1024
+#define SERVER_PRIORITY K_PRIO_PREEMPT(8)
+
+ZTEST_BENCHMARK_DEFINE(net_pkt_alloc_free, 16, 256);
+ZTEST_BENCHMARK_DEFINE(net_pkt_alloc_buffer_free, 16, 256);
+ZTEST_BENCHMARK_DEFINE(udp_poll_round_trip, 8, 128);
+
+static u8_t buf[TCP_CHUNK_SIZE];
+static int udp_sock;
+static struct sockaddr_in echo_addr;
+
+#if defined(LOCAL_SERVERS)
+static K_THREAD_STACK_DEFINE(echo_stack, SERVER_STACK_SIZE);
+static struct k_thread echo_thread;
+static K_THREAD_STACK_DEFINE(discard_stack, SERVER_STACK_SIZE);
+static struct k_thread discard_thread;
+static K_SEM_DEFINE(discard_done, 0, 1);
+
+static u8_t echo_buf[UDP_PAYLOAD];
+static u8_t discard_buf[TCP_CHUNK_SIZE];
+
+static void echo_server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	struct sockaddr addr;
+	socklen_t addrlen;
+	ssize_t len;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		addrlen = sizeof(addr);
+		len = recvfrom(sock, echo_buf, sizeof(echo_buf), 0, &addr,
+			       &addrlen);
+		if (len > 0) {
+			(void)sendto(sock, echo_buf, len, 0, &addr, addrlen);
+		}
+	}
+}
+
+static void discard_server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	struct sockaddr addr;
+	socklen_t addrlen;
+	int conn;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		addrlen = sizeof(addr);
+		conn = accept(sock, &addr, &addrlen);
+		if (conn < 0) {
+			continue;
+		}
+
+		while (recv(conn, discard_buf, sizeof(discard_buf), 0) > 0) {
+		}
+
+		(void)close(conn);
+		k_sem_give(&discard_done);
+	}
+}
+
+static void start_servers(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(ECHO_PORT),
+		.sin_addr = INADDR_ANY_INIT,
+	};
+	int sock;
+
+	sock = prepare_listen_sock_udp_v4(&addr);
+	k_thread_create(&echo_thread, echo_stack,
+			K_THREAD_STACK_SIZEOF(echo_stack), echo_server,
+			INT_TO_POINTER(sock), NULL, NULL,
+			SERVER_PRIORITY, 0, K_NO_WAIT);
+
+	addr.sin_port = htons(DISCARD_PORT);
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed");
+	zassert_equal(bind(sock, (struct sockaddr *)&addr, sizeof(addr)), 0,
+		      "bind failed");
+	zassert_equal(listen(sock, 1), 0, "listen failed");
+	k_thread_create(&discard_thread, discard_stack,
+			K_THREAD_STACK_SIZEOF(discard_stack), discard_server,
+			INT_TO_POINTER(sock), NULL, NULL,
+			SERVER_PRIORITY, 0, K_NO_WAIT);
+}
+#endif /* LOCAL_SERVERS */
+
+static void pkt_alloc_free(void *arg)
+{
+	struct net_pkt *pkt;
+
+	ARG_UNUSED(arg);
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	zassert_not_null(pkt, "packet allocation failed");
+	net_pkt_unref(pkt);
+}
+
+static void pkt_alloc_buffer_free(void *arg)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(arg, PKT_SIZE, AF_INET, IPPROTO_UDP,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "packet allocation failed");
+	net_pkt_unref(pkt);
+}
+
+void test_net_pkt(void)
+{
+	ztest_benchmark_run(&net_pkt_alloc_free, pkt_alloc_free, NULL, NULL);
+	ztest_benchmark_run(&net_pkt_alloc_buffer_free, pkt_alloc_buffer_free,
+			    net_if_get_default(), NULL);
+}
+
+static bool udp_wait(int timeout)
+{
+	struct pollfd pfd = {
+		.fd = udp_sock,
+		.events = POLLIN,
+	};
+
+	return poll(&pfd, 1, timeout) == 1 && (pfd.revents & POLLIN);
+}
+
+static void udp_round_trip(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	zassert_equal(sendto(udp_sock, buf, 1, 0,
+			     (struct sockaddr *)&echo_addr, sizeof(echo_addr)),
+		      1, "send failed (%d)", errno);
+	zassert_true(udp_wait(UDP_TIMEOUT_MS), "no echo");
+	zassert_equal(recv(udp_sock, buf, sizeof(buf), 0), 1,
+		      "recv failed (%d)", errno);
+}
+
+void test_udp_latency(void)
+{
+	ztest_benchmark_run(&udp_poll_round_trip, udp_round_trip, NULL, NULL);
+}
+
+void test_udp_throughput(void)
+{
+	u32_t sent = 0U, received = 0U;
+	u32_t start, elapsed;
+	int i;
+
+	start = k_uptime_get_32();
+
+	/* Batches small enough for the echoes not to overflow the queues */
+	while (sent < UDP_DATAGRAMS) {
+		for (i = 0; i < UDP_BATCH; i++) {
+			if (sendto(udp_sock, buf, UDP_PAYLOAD, 0,
+				   (struct sockaddr *)&echo_addr,
+				   sizeof(echo_addr)) == UDP_PAYLOAD) {
+				sent++;
+			}
+		}
+
+		while (received < sent && udp_wait(UDP_TIMEOUT_MS) &&
+		       recv(udp_sock, buf, sizeof(buf), 0) > 0) {
+			received++;
+		}
+	}
+
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+
+	zassert_true(received > 0, "no datagram echoed");
+
+	ztest_benchmark_report_value("udp_echo_pps", "pps",
+				     (u64_t)received * MSEC_PER_SEC / elapsed);
+	ztest_benchmark_report_value("udp_echo_throughput", "kbit/s",
+				     (u64_t)received * UDP_PAYLOAD * 8U /
+				     elapsed);
+	ztest_benchmark_report_value("udp_echo_loss", "permille",
+				     (sent - received) * 1000U / sent);
+}
+
+void test_tcp_throughput(void)
+{
+	struct sockaddr_in addr;
+	u32_t start, elapsed, offset = 0U;
+	int sock;
+
+	prepare_sock_tcp_v4(PEER_ADDR, DISCARD_PORT, &sock, &addr);
+	zassert_equal(connect(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+
+	start = k_uptime_get_32();
+
+	while (offset < TCP_TRANSFER_SIZE) {
+		zassert_equal(send(sock, buf, TCP_CHUNK_SIZE, 0),
+			      TCP_CHUNK_SIZE, "send failed (%d)", errno);
+		offset += TCP_CHUNK_SIZE;
+	}
+
+	zassert_equal(close(sock), 0, "close failed");
+
+#if defined(LOCAL_SERVERS)
+	/* Until all the data is received */
+	zassert_equal(k_sem_take(&discard_done, K_SECONDS(10)), 0,
+		      "transfer did not finish");
+#endif
+
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+
+	ztest_benchmark_report_value("tcp_bulk_throughput", "kbit/s",
+				     (u64_t)offset * 8U / elapsed);
+}
+
+void test_main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_addr = INADDR_ANY_INIT,
+	};
+
+#if defined(LOCAL_SERVERS)
+	start_servers();
+#endif
+
+	udp_sock = prepare_listen_sock_udp_v4(&addr);
+	echo_addr.sin_family = AF_INET;
+	echo_addr.sin_port = htons(ECHO_PORT);
+	zassert_equal(inet_pton(AF_INET, PEER_ADDR, &echo_addr.sin_addr), 1,
+		      "invalid peer address");
+
+	ztest_test_suite(net_throughput,
+			 ztest_unit_test(test_net_pkt),
+			 ztest_unit_test(test_udp_latency),
+			 ztest_unit_test(test_udp_throughput),
+			 ztest_unit_test(test_tcp_throughput));
+
+	ztest_run_test_suite(net_throughput);
+}
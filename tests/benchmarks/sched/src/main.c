@@ -8,6 +8,7 @@
 #include <misc/printk.h>
 #include <wait_q.h>
 #include <ksched.h>
+#include <timeout_q.h>
 
 /* This is a scheduler microbenchmark, designed to measure latencies
  * of specific low level scheduling primitives independent of overhead
@@ -42,9 +43,30 @@
 #define N_SETTLE 10
 
 
+/* Number of extra lower priority threads kept runnable so the ready
+ * queue backend has more than one entry to search
+ */
+#define N_FILLERS 8
+
+#if defined(CONFIG_SCHED_DUMB)
+#define RUNQ_NAME "dumb"
+#elif defined(CONFIG_SCHED_SCALABLE)
+#define RUNQ_NAME "rb"
+#elif defined(CONFIG_SCHED_MULTIQ)
+#define RUNQ_NAME "multiq"
+#endif
+
+/* Number of timeouts kept live while measuring the timeout queue,
+ * the list backend is linear in this and the wheel is not.
+ */
+#define N_TIMEOUTS 256
+
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
 static struct k_thread partner_thread;
 
+static K_THREAD_STACK_ARRAY_DEFINE(filler_stacks, N_FILLERS, 512);
+static struct k_thread filler_threads[N_FILLERS];
+
 _wait_q_t waitq;
 
 enum {
@@ -79,6 +101,57 @@ static inline int _stamp(int state)
 /* #define stamp(s) printk("%s @ %d\n", #s, _stamp(s)) */
 #define stamp(s) _stamp(s)
 
+static struct _timeout timeouts[N_TIMEOUTS];
+
+static void timeout_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+/* Measures z_add_timeout()/z_abort_timeout() against a queue holding
+ * N_TIMEOUTS entries spread over ~50k ticks of expiries, which is
+ * what CONFIG_TIMEOUT_WHEEL is meant to make constant time.
+ */
+static void bench_timeouts(void)
+{
+	struct _timeout probe;
+	u32_t add_tot = 0U, abort_tot = 0U;
+
+	for (int i = 0; i < N_TIMEOUTS; i++) {
+		z_init_timeout(&timeouts[i], timeout_fn);
+		z_add_timeout(&timeouts[i], timeout_fn,
+			      1000 + (i * 97) % 50000);
+	}
+
+	z_init_timeout(&probe, timeout_fn);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		u32_t t0 = k_cycle_get_32();
+
+		/* Far enough out to land at the tail of a sorted list */
+		z_add_timeout(&probe, timeout_fn, 100000 + i);
+
+		u32_t t1 = k_cycle_get_32();
+
+		z_abort_timeout(&probe);
+
+		u32_t t2 = k_cycle_get_32();
+
+		if (i >= N_SETTLE) {
+			add_tot += t1 - t0;
+			abort_tot += t2 - t1;
+		}
+	}
+
+	for (int i = 0; i < N_TIMEOUTS; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+
+	printk("timeouts %d: add avg %d abort avg %d (%s)\n", N_TIMEOUTS,
+	       add_tot / N_RUNS, abort_tot / N_RUNS,
+	       IS_ENABLED(CONFIG_TIMEOUT_WHEEL) ? "wheel" : "list");
+}
+
 static void partner_fn(void *arg1, void *arg2, void *arg3)
 {
 	ARG_UNUSED(arg1);
@@ -95,6 +168,17 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+static void filler_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_yield();
+	}
+}
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -107,6 +191,16 @@ void main(void)
 				     partner_fn, NULL, NULL, NULL,
 				     partner_prio, 0, 0);
 
+	for (int i = 0; i < N_FILLERS; i++) {
+		k_thread_create(&filler_threads[i], filler_stacks[i],
+				K_THREAD_STACK_SIZEOF(filler_stacks[i]),
+				filler_fn, NULL, NULL, NULL,
+				main_prio + 1 + i, 0, 0);
+	}
+
+	printk("ready queue backend: %s, %d filler threads\n", RUNQ_NAME,
+	       N_FILLERS);
+
 	/* Let it start running and pend */
 	k_sleep(100);
 
@@ -157,5 +251,8 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+	bench_timeouts();
+
 	printk("fin\n");
 }
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of back-to-back SPI transfers, issued synchronously, with the
+ * asynchronous API waiting on each completion, and through the transaction
+ * queue. Short MISO to MOSI to check the received data.
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <spi.h>
+#include <string.h>
+#include <misc/printk.h>
+
+#ifndef SPI_DRV_NAME
+#define SPI_DRV_NAME "SPI_1"
+#endif
+
+#ifndef SPI_FREQUENCY
+#define SPI_FREQUENCY 8000000
+#endif
+
+#define XFER_SIZE 1024
+#define XFER_COUNT 64
+#define QUEUE_DEPTH 4
+
+static u8_t tx_data[XFER_SIZE];
+static u8_t rx_data[QUEUE_DEPTH][XFER_SIZE];
+
+static const struct spi_config spi_cfg = {
+	.frequency = SPI_FREQUENCY,
+	.operation = SPI_OP_MODE_MASTER | SPI_MODE_CPOL | SPI_MODE_CPHA |
+		     SPI_WORD_SET(8) | SPI_LINES_SINGLE,
+};
+
+static const struct spi_buf tx_buf = {
+	.buf = tx_data,
+	.len = XFER_SIZE,
+};
+static const struct spi_buf_set tx = {
+	.buffers = &tx_buf,
+	.count = 1,
+};
+
+static struct spi_buf rx_buf[QUEUE_DEPTH];
+static struct spi_buf_set rx[QUEUE_DEPTH];
+
+static u32_t elapsed_us(u32_t start)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+		       NSEC_PER_USEC);
+}
+
+static void report(const char *what, size_t bytes, u32_t us)
+{
+	printk("%-6s %u bytes in %u us: %u KiB/s\n", what,
+	       (unsigned int)bytes, us,
+	       (unsigned int)((u64_t)bytes * USEC_PER_SEC / 1024U /
+			      MAX(us, 1U)));
+}
+
+static int check_rx(int slot)
+{
+	if (memcmp(tx_data, rx_data[slot], XFER_SIZE) != 0) {
+		printk("rx data mismatch, is MISO wired to MOSI?\n");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int bench_sync(struct device *dev)
+{
+	u32_t start;
+	int i, rc;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < XFER_COUNT; i++) {
+		rc = spi_transceive(dev, &spi_cfg, &tx, &rx[0]);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	report("sync", XFER_SIZE * XFER_COUNT, elapsed_us(start));
+
+	return check_rx(0);
+}
+
+#ifdef CONFIG_SPI_ASYNC
+static struct k_poll_signal signals[QUEUE_DEPTH];
+
+static int wait_signal(int slot)
+{
+	struct k_poll_event evt = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &signals[slot]);
+	unsigned int signaled;
+	int result;
+
+	if (k_poll(&evt, 1, K_MSEC(1000)) < 0) {
+		return -ETIMEDOUT;
+	}
+
+	k_poll_signal_check(&signals[slot], &signaled, &result);
+	k_poll_signal_reset(&signals[slot]);
+
+	return result;
+}
+
+static int bench_async(struct device *dev)
+{
+	u32_t start;
+	int i, rc;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < XFER_COUNT; i++) {
+		rc = spi_transceive_async(dev, &spi_cfg, &tx, &rx[0],
+					  &signals[0]);
+		if (rc < 0) {
+			return rc;
+		}
+
+		rc = wait_signal(0);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	report("async", XFER_SIZE * XFER_COUNT, elapsed_us(start));
+
+	return check_rx(0);
+}
+#endif /* CONFIG_SPI_ASYNC */
+
+#ifdef CONFIG_SPI_QUEUE
+static struct spi_transaction transactions[QUEUE_DEPTH];
+
+/* Keep QUEUE_DEPTH transactions in flight, so that the bus never idles */
+static int bench_queued(struct device *dev)
+{
+	u32_t start;
+	int i, slot, rc;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < XFER_COUNT + QUEUE_DEPTH; i++) {
+		slot = i % QUEUE_DEPTH;
+
+		if (i >= QUEUE_DEPTH) {
+			rc = wait_signal(slot);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+
+		if (i >= XFER_COUNT) {
+			continue;
+		}
+
+		transactions[slot].config = &spi_cfg;
+		transactions[slot].tx_bufs = &tx;
+		transactions[slot].rx_bufs = &rx[slot];
+		transactions[slot].signal = &signals[slot];
+
+		rc = spi_transceive_queued(dev, &transactions[slot]);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	report("queued", XFER_SIZE * XFER_COUNT, elapsed_us(start));
+
+	for (slot = 0; slot < QUEUE_DEPTH; slot++) {
+		rc = check_rx(slot);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SPI_QUEUE */
+
+void main(void)
+{
+	struct device *dev;
+	int i, rc;
+
+	dev = device_get_binding(SPI_DRV_NAME);
+	if (!dev) {
+		printk("%s not found\n", SPI_DRV_NAME);
+		return;
+	}
+
+	for (i = 0; i < XFER_SIZE; i++) {
+		tx_data[i] = (u8_t)i;
+	}
+
+	for (i = 0; i < QUEUE_DEPTH; i++) {
+		rx_buf[i].buf = rx_data[i];
+		rx_buf[i].len = XFER_SIZE;
+		rx[i].buffers = &rx_buf[i];
+		rx[i].count = 1;
+#ifdef CONFIG_SPI_ASYNC
+		k_poll_signal_init(&signals[i]);
+#endif
+	}
+
+	printk("SPI throughput: %s at %u Hz\n", SPI_DRV_NAME, SPI_FREQUENCY);
+
+	rc = bench_sync(dev);
+	if (rc < 0) {
+		printk("sync failed (%d)\n", rc);
+		return;
+	}
+
+#ifdef CONFIG_SPI_ASYNC
+	rc = bench_async(dev);
+	if (rc < 0) {
+		printk("async failed (%d)\n", rc);
+		return;
+	}
+#endif
+
+#ifdef CONFIG_SPI_QUEUE
+	rc = bench_queued(dev);
+	if (rc < 0) {
+		printk("queued failed (%d)\n", rc);
+		return;
+	}
+#endif
+}
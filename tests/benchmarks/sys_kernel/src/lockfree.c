@@ -0,0 +1,161 @@
+/* lockfree.c */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#include <misc/lf_stack.h>
+#include <misc/lf_queue.h>
+
+#define LF_DEPTH 8
+
+SYS_LF_STACK_DEFINE(lf_stack, LF_DEPTH);
+SYS_LF_QUEUE_DEFINE(lf_queue, LF_DEPTH);
+
+/* Same operations done the traditional way, under an irq lock */
+static void *irq_stack[LF_DEPTH];
+static int irq_stack_top;
+
+static void *irq_queue[LF_DEPTH];
+static u32_t irq_queue_head, irq_queue_tail;
+
+static int irq_stack_push(void *value)
+{
+	unsigned int key = irq_lock();
+	int ret = -ENOMEM;
+
+	if (irq_stack_top < LF_DEPTH) {
+		irq_stack[irq_stack_top++] = value;
+		ret = 0;
+	}
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int irq_stack_pop(void **value)
+{
+	unsigned int key = irq_lock();
+	int ret = -EAGAIN;
+
+	if (irq_stack_top > 0) {
+		*value = irq_stack[--irq_stack_top];
+		ret = 0;
+	}
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int irq_queue_put(void *value)
+{
+	unsigned int key = irq_lock();
+	int ret = -ENOMEM;
+
+	if (irq_queue_tail - irq_queue_head < LF_DEPTH) {
+		irq_queue[irq_queue_tail++ % LF_DEPTH] = value;
+		ret = 0;
+	}
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int irq_queue_get(void **value)
+{
+	unsigned int key = irq_lock();
+	int ret = -EAGAIN;
+
+	if (irq_queue_tail != irq_queue_head) {
+		*value = irq_queue[irq_queue_head++ % LF_DEPTH];
+		ret = 0;
+	}
+	irq_unlock(key);
+
+	return ret;
+}
+
+static void print_case(const char *name, const char *apis)
+{
+	fprintf(output_file, sz_test_case_fmt, name);
+	fprintf(output_file, sz_description, apis);
+	printf(sz_test_start_fmt);
+}
+
+/**
+ *
+ * @brief Lock-free primitives compared to an irq lock
+ *
+ * Pushes and pops (or puts and gets) one value per iteration in a single
+ * thread, so the figures only show the cost of the operations themselves.
+ *
+ * @return number of successful tests
+ *
+ */
+int lockfree_test(void)
+{
+	int return_value = 0;
+	void *data;
+	u32_t t;
+	int i;
+
+	print_case("Lock-free stack",
+		   "\n\tsys_lf_stack_push"
+		   "\n\tsys_lf_stack_pop");
+	t = BENCH_START();
+	for (i = 0; i < number_of_loops; i++) {
+		if (sys_lf_stack_push(&lf_stack, (void *)i) != 0 ||
+		    sys_lf_stack_pop(&lf_stack, &data) != 0 ||
+		    data != (void *)i) {
+			break;
+		}
+	}
+	t = TIME_STAMP_DELTA_GET(t);
+	return_value += check_result(i, t);
+
+	print_case("irq_lock stack",
+		   "\n\tirq_lock"
+		   "\n\tirq_unlock");
+	t = BENCH_START();
+	for (i = 0; i < number_of_loops; i++) {
+		if (irq_stack_push((void *)i) != 0 ||
+		    irq_stack_pop(&data) != 0 || data != (void *)i) {
+			break;
+		}
+	}
+	t = TIME_STAMP_DELTA_GET(t);
+	return_value += check_result(i, t);
+
+	print_case("Lock-free queue",
+		   "\n\tsys_lf_queue_put"
+		   "\n\tsys_lf_queue_get");
+	t = BENCH_START();
+	for (i = 0; i < number_of_loops; i++) {
+		if (sys_lf_queue_put(&lf_queue, (void *)i) != 0 ||
+		    sys_lf_queue_get(&lf_queue, &data) != 0 ||
+		    data != (void *)i) {
+			break;
+		}
+	}
+	t = TIME_STAMP_DELTA_GET(t);
+	return_value += check_result(i, t);
+
+	print_case("irq_lock queue",
+		   "\n\tirq_lock"
+		   "\n\tirq_unlock");
+	t = BENCH_START();
+	for (i = 0; i < number_of_loops; i++) {
+		if (irq_queue_put((void *)i) != 0 ||
+		    irq_queue_get(&data) != 0 || data != (void *)i) {
+			break;
+		}
+	}
+	t = TIME_STAMP_DELTA_GET(t);
+	return_value += check_result(i, t);
+
+	return return_value;
+}
@@ -178,10 +178,13 @@ void main(void)
 		test_result += lifo_test();
 		test_result += fifo_test();
 		test_result += stack_test();
+		test_result += lockfree_test();
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack account for 12 tests in total */
-			if (test_result == 12) {
+			/* sema/lifo/fifo/stack/lockfree account for 16 tests
+			 * in total
+			 */
+			if (test_result == 16) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
@@ -51,6 +51,7 @@ int sema_test(void);
 int lifo_test(void);
 int fifo_test(void);
 int stack_test(void);
+int lockfree_test(void);
 void begin_test(void);
 
 static inline u32_t BENCH_START(void)
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Run the Bluetooth benchmark on two boards and collect its results.
+
+Optionally flashes the peripheral and the central with the given commands,
+waits for the peripheral to advertise, then reads the console of the
+central until the end of the test suite. The BENCH: lines of the central
+are written out as a JSON list or a CSV file.
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+import time
+
+import serial
+
+PERIPHERAL_READY = "Benchmark peripheral ready"
+SUITE_END = "PROJECT EXECUTION "
+CSV_FIELDS = ["name", "unit", "hz", "iterations", "min", "max", "mean",
+              "p50", "p99", "stddev"]
+
+
+def flash(cmd):
+    if cmd:
+        subprocess.run(cmd, shell=True, check=True)
+
+
+def lines(port, timeout):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        line = port.readline().decode("utf-8", "replace").strip()
+        if line:
+            yield line
+    sys.exit("timeout")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--central", required=True,
+                        help="serial port of the central")
+    parser.add_argument("--peripheral", required=True,
+                        help="serial port of the peripheral")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--flash-central", help="command flashing the "
+                        "central, run once the peripheral is ready")
+    parser.add_argument("--flash-peripheral",
+                        help="command flashing the peripheral")
+    parser.add_argument("--timeout", type=int, default=1800,
+                        help="seconds allowed for the whole run")
+    parser.add_argument("--format", choices=["json", "csv"], default="json")
+    parser.add_argument("-o", "--output", help="output file, default stdout")
+    args = parser.parse_args()
+
+    periph = serial.Serial(args.peripheral, args.baudrate, timeout=1)
+    central = serial.Serial(args.central, args.baudrate, timeout=1)
+
+    flash(args.flash_peripheral)
+    if args.flash_peripheral:
+        for line in lines(periph, 60):
+            if PERIPHERAL_READY in line:
+                break
+
+    central.reset_input_buffer()
+    flash(args.flash_central)
+
+    results = []
+    passed = False
+    for line in lines(central, args.timeout):
+        print(line, file=sys.stderr)
+        if line.startswith("BENCH:"):
+            results.append(json.loads(line[len("BENCH:"):]))
+        elif SUITE_END in line:
+            passed = "SUCCESSFUL" in line
+            break
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    if args.format == "json":
+        json.dump(results, out, indent=2)
+        out.write("\n")
+    else:
+        out.write(",".join(CSV_FIELDS) + "\n")
+        for r in results:
+            out.write(",".join(str(r[f]) for f in CSV_FIELDS) + "\n")
+
+    if not passed:
+        sys.exit("benchmark failed")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Central of the Bluetooth benchmark.
+ *
+ * Connects to the benchmark peripheral and, for each connection interval,
+ * PHY, data length and payload of the sweep, measures the throughput of
+ * GATT notifications and of an L2CAP LE credit based channel, and the
+ * round trip time of a write without response echoed as a notification.
+ * Where the controller implements the Read Controller Profile vendor
+ * command, the share of the connection events spent on the air is
+ * reported as well.
+ *
+ * The results are reported through the ztest benchmark harness, with the
+ * configuration in their names.
+ */
+
+#include <ztest.h>
+#include <ztest_benchmark.h>
+#include <misc/byteorder.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/gatt.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/hci_vs.h>
+#include <bluetooth/l2cap.h>
+#include <bluetooth/uuid.h>
+
+#include "bench.h"
+
+#define NOTIFY_COUNT 200
+#define L2CAP_TRANSFER_SIZE (32 * 1024)
+#define TIMEOUT K_SECONDS(30)
+
+/* PHY and data length updates have no completion callback */
+#define SETTLE_TIME K_MSEC(500)
+
+/* Connection intervals in units of 1.25 ms */
+static const u16_t intervals[] = { 6, 12, 24, 40 };
+static const u8_t phys[] = { BT_HCI_LE_PHY_PREFER_1M,
+			     BT_HCI_LE_PHY_PREFER_2M };
+static const u16_t data_lens[] = { 27, 251 };
+/* ATT payloads, bounded by the exchanged MTU */
+static const u16_t payloads[] = { 20, 128, 244 };
+
+static struct bt_uuid_128 bench_uuid = BT_UUID_INIT_128(
+	BENCH_UUID_SERVICE_VAL);
+static struct bt_uuid_128 bench_data_uuid = BT_UUID_INIT_128(
+	BENCH_UUID_DATA_VAL);
+
+ZTEST_BENCHMARK_DEFINE(gatt_echo, 4, 64);
+
+static struct bt_conn *bench_conn;
+static u16_t data_handle;
+
+static K_SEM_DEFINE(connected_sem, 0, 1);
+static K_SEM_DEFINE(step_sem, 0, 1);
+static K_SEM_DEFINE(param_sem, 0, 1);
+
+static enum bench_op mode;
+static u32_t notify_count;
+static u32_t notify_bytes;
+
+static struct bt_gatt_exchange_params exchange_params;
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_subscribe_params subscribe_params;
+
+static char name[64];
+static u8_t sdu[BENCH_L2CAP_MTU];
+
+NET_BUF_POOL_DEFINE(sdu_pool, 2, BT_L2CAP_BUF_SIZE(BENCH_L2CAP_MTU),
+		    BT_BUF_USER_DATA_MIN, NULL);
+
+static void l2cap_connected(struct bt_l2cap_chan *chan)
+{
+	k_sem_give(&step_sem);
+}
+
+static struct bt_l2cap_chan_ops l2cap_ops = {
+	.connected = l2cap_connected,
+};
+
+static struct bt_l2cap_le_chan l2cap_chan = {
+	.chan.ops = &l2cap_ops,
+	.rx.mtu = BENCH_L2CAP_MTU,
+};
+
+static void connected(struct bt_conn *conn, u8_t err)
+{
+	if (err) {
+		bt_conn_unref(bench_conn);
+		bench_conn = NULL;
+		return;
+	}
+
+	k_sem_give(&connected_sem);
+}
+
+static void disconnected(struct bt_conn *conn, u8_t reason)
+{
+	TC_PRINT("Disconnected (reason %u)\n", reason);
+}
+
+static void le_param_updated(struct bt_conn *conn, u16_t interval,
+			     u16_t latency, u16_t timeout)
+{
+	k_sem_give(&param_sem);
+}
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+};
+
+static bool ad_found(struct bt_data *data, void *user_data)
+{
+	bool *found = user_data;
+
+	if (data->type == BT_DATA_UUID128_ALL &&
+	    data->data_len == sizeof(bench_uuid.val) &&
+	    memcmp(data->data, bench_uuid.val, sizeof(bench_uuid.val)) == 0) {
+		*found = true;
+		return false;
+	}
+
+	return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, s8_t rssi, u8_t type,
+			 struct net_buf_simple *ad)
+{
+	bool found = false;
+
+	if (bench_conn || type != BT_LE_ADV_IND) {
+		return;
+	}
+
+	bt_data_parse(ad, ad_found, &found);
+	if (!found || bt_le_scan_stop()) {
+		return;
+	}
+
+	bench_conn = bt_conn_create_le(addr, BT_LE_CONN_PARAM_DEFAULT);
+}
+
+static u8_t notified(struct bt_conn *conn,
+		     struct bt_gatt_subscribe_params *params,
+		     const void *data, u16_t length)
+{
+	const struct bench_cmd *cmd = data;
+
+	if (!data) {
+		return BT_GATT_ITER_STOP;
+	}
+
+	switch (mode) {
+	case BENCH_OP_NOTIFY:
+		notify_bytes += length;
+		if (++notify_count == NOTIFY_COUNT) {
+			k_sem_give(&step_sem);
+		}
+		break;
+	case BENCH_OP_ECHO:
+		k_sem_give(&step_sem);
+		break;
+	case BENCH_OP_L2CAP:
+		if (length == sizeof(*cmd) &&
+		    cmd->op == BENCH_OP_L2CAP_DONE) {
+			k_sem_give(&step_sem);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void mtu_exchanged(struct bt_conn *conn, u8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	k_sem_give(&step_sem);
+}
+
+static u8_t discovered(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+		       struct bt_gatt_discover_params *params)
+{
+	if (attr) {
+		/* The value follows the declaration in the peripheral */
+		data_handle = attr->handle + 1;
+	}
+
+	k_sem_give(&step_sem);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static void send_cmd(u8_t op, u16_t len, u32_t count)
+{
+	struct bench_cmd cmd = {
+		.op = op,
+		.len = sys_cpu_to_le16(len),
+		.count = sys_cpu_to_le32(count),
+	};
+
+	zassert_equal(bt_gatt_write_without_response(bench_conn, data_handle,
+						     &cmd, sizeof(cmd), false),
+		      0, "command not sent");
+}
+
+/* Radio time of the connections since the last call, in microseconds */
+static int radio_time_get(u32_t *radio_us)
+{
+	struct bt_hci_rp_vs_read_ctlr_prof *rp;
+	struct bt_hci_cp_vs_read_ctlr_prof *cp;
+	struct net_buf *buf, *rsp;
+	int err;
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_VS_READ_CTLR_PROF, sizeof(*cp));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->reset = 1U;
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_READ_CTLR_PROF, buf, &rsp);
+	if (err) {
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+	*radio_us = sys_le32_to_cpu(
+		rp->role[BT_HCI_VS_PROF_ROLE_CONN].radio_us);
+	net_buf_unref(rsp);
+
+	return 0;
+}
+
+static void report_rate(const char *measure, const char *config,
+			u32_t bytes, u32_t elapsed)
+{
+	snprintk(name, sizeof(name), "%s/%s", measure, config);
+	ztest_benchmark_report_value(name, "kbit/s",
+				     (u64_t)bytes * 8U / MAX(elapsed, 1U));
+}
+
+static void measure_notify(const char *config, u16_t len)
+{
+	u32_t start, elapsed, radio_us;
+	int prof;
+
+	notify_count = 0U;
+	notify_bytes = 0U;
+	mode = BENCH_OP_NOTIFY;
+
+	prof = radio_time_get(&radio_us);
+	start = k_uptime_get_32();
+
+	send_cmd(BENCH_OP_NOTIFY, len, NOTIFY_COUNT);
+	zassert_equal(k_sem_take(&step_sem, TIMEOUT), 0,
+		      "notifications missing");
+
+	elapsed = k_uptime_get_32() - start;
+	report_rate("gatt_notify", config, notify_bytes, elapsed);
+
+	if (prof == 0 && radio_time_get(&radio_us) == 0) {
+		snprintk(name, sizeof(name), "conn_event_util/%s", config);
+		ztest_benchmark_report_value(name, "permille",
+					     radio_us / MAX(elapsed, 1U));
+	}
+}
+
+static void measure_l2cap(const char *config, u16_t len)
+{
+	u32_t start, elapsed, sent = 0U;
+	struct net_buf *buf;
+	int err;
+
+	mode = BENCH_OP_L2CAP;
+	len = MIN(len, l2cap_chan.tx.mtu);
+
+	start = k_uptime_get_32();
+	send_cmd(BENCH_OP_L2CAP, 0, L2CAP_TRANSFER_SIZE);
+
+	while (sent < L2CAP_TRANSFER_SIZE) {
+		buf = net_buf_alloc(&sdu_pool, K_FOREVER);
+		net_buf_reserve(buf, BT_L2CAP_CHAN_SEND_RESERVE);
+		net_buf_add_mem(buf, sdu, len);
+
+		/* Blocks on the credits of the peripheral */
+		err = bt_l2cap_chan_send(&l2cap_chan.chan, buf);
+		if (err < 0) {
+			net_buf_unref(buf);
+			zassert_unreachable("L2CAP send failed (err %d)", err);
+		}
+
+		sent += len;
+	}
+
+	zassert_equal(k_sem_take(&step_sem, TIMEOUT), 0,
+		      "L2CAP transfer not acknowledged");
+
+	elapsed = k_uptime_get_32() - start;
+	report_rate("l2cap_coc", config, sent, elapsed);
+}
+
+static void echo(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	send_cmd(BENCH_OP_ECHO, 0, 0);
+	zassert_equal(k_sem_take(&step_sem, TIMEOUT), 0, "no echo");
+}
+
+static void measure_echo(const char *config)
+{
+	mode = BENCH_OP_ECHO;
+
+	snprintk(name, sizeof(name), "gatt_echo/%s", config);
+	gatt_echo.name = name;
+	ztest_benchmark_run(&gatt_echo, echo, NULL, NULL);
+}
+
+static void configure(u16_t interval, u8_t phy, u16_t data_len)
+{
+	const struct bt_le_conn_param param = {
+		.interval_min = interval,
+		.interval_max = interval,
+		.latency = 0,
+		.timeout = 400,
+	};
+	int err;
+
+	k_sem_reset(&param_sem);
+	err = bt_conn_le_param_update(bench_conn, &param);
+	if (err == 0) {
+		zassert_equal(k_sem_take(&param_sem, TIMEOUT), 0,
+			      "connection parameters not updated");
+	} else {
+		zassert_equal(err, -EALREADY, "parameter update failed");
+	}
+
+	err = bt_conn_le_phy_update(bench_conn, phy, phy);
+	zassert_true(err == 0 || err == -ENOTSUP, "PHY update failed");
+
+	/* Time of a PDU of data_len octets on the 1M PHY */
+	err = bt_conn_le_data_len_update(bench_conn, data_len,
+					 (data_len + 14) * 8);
+	zassert_true(err == 0 || err == -ENOTSUP,
+		     "data length update failed");
+
+	k_sleep(SETTLE_TIME);
+}
+
+void test_connect(void)
+{
+	int err;
+
+	bt_conn_cb_register(&conn_callbacks);
+
+	zassert_equal(bt_enable(NULL), 0, "Bluetooth init failed");
+	zassert_equal(bt_le_scan_start(BT_LE_SCAN_ACTIVE, device_found), 0,
+		      "scan failed to start");
+	zassert_equal(k_sem_take(&connected_sem, TIMEOUT), 0,
+		      "peripheral not found");
+
+	exchange_params.func = mtu_exchanged;
+	zassert_equal(bt_gatt_exchange_mtu(bench_conn, &exchange_params), 0,
+		      "MTU exchange failed");
+	zassert_equal(k_sem_take(&step_sem, TIMEOUT), 0, "no MTU exchange");
+
+	discover_params.uuid = &bench_data_uuid.uuid;
+	discover_params.func = discovered;
+	discover_params.start_handle = 0x0001;
+	discover_params.end_handle = 0xffff;
+	discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+	zassert_equal(bt_gatt_discover(bench_conn, &discover_params), 0,
+		      "discovery failed");
+	zassert_equal(k_sem_take(&step_sem, TIMEOUT), 0, "no discovery");
+	zassert_not_equal(data_handle, 0, "benchmark service not found");
+
+	/* The CCC follows the value in the peripheral */
+	subscribe_params.notify = notified;
+	subscribe_params.value = BT_GATT_CCC_NOTIFY;
+	subscribe_params.value_handle = data_handle;
+	subscribe_params.ccc_handle = data_handle + 1;
+	err = bt_gatt_subscribe(bench_conn, &subscribe_params);
+	zassert_true(err == 0 || err == -EALREADY, "subscription failed");
+
+	zassert_equal(bt_l2cap_chan_connect(bench_conn, &l2cap_chan.chan,
+					    BENCH_L2CAP_PSM), 0,
+		      "L2CAP connection failed");
+	zassert_equal(k_sem_take(&step_sem, TIMEOUT), 0,
+		      "L2CAP channel not connected");
+
+	TC_PRINT("Connected, ATT MTU %u, L2CAP MTU %u\n",
+		 bt_gatt_get_mtu(bench_conn), l2cap_chan.tx.mtu);
+}
+
+static void run_config(u16_t interval, u8_t phy, u16_t data_len)
+{
+	const char *phy_name = (phy == BT_HCI_LE_PHY_PREFER_2M) ? "2m" : "1m";
+	u16_t max_len = bt_gatt_get_mtu(bench_conn) - 3;
+	char config[32];
+	u16_t len;
+	int i;
+
+	configure(interval, phy, data_len);
+
+	snprintk(config, sizeof(config), "ci%u_%s_dle%u", interval, phy_name,
+		 data_len);
+	measure_echo(config);
+
+	for (i = 0; i < ARRAY_SIZE(payloads); i++) {
+		len = MIN(payloads[i], max_len);
+
+		snprintk(config, sizeof(config), "ci%u_%s_dle%u_len%u",
+			 interval, phy_name, data_len, len);
+		measure_notify(config, len);
+		measure_l2cap(config, len);
+	}
+}
+
+void test_sweep(void)
+{
+	int i, j, k;
+
+	zassert_not_null(bench_conn, "not connected");
+
+	for (i = 0; i < ARRAY_SIZE(intervals); i++) {
+		for (j = 0; j < ARRAY_SIZE(phys); j++) {
+			for (k = 0; k < ARRAY_SIZE(data_lens); k++) {
+				run_config(intervals[i], phys[j],
+					   data_lens[k]);
+			}
+		}
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(bt_benchmark,
+			 ztest_unit_test(test_connect),
+			 ztest_unit_test(test_sweep));
+
+	ztest_run_test_suite(bt_benchmark);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Protocol between the benchmark central and peripheral.
+ *
+ * The peripheral exposes one characteristic, written without response by
+ * the central with commands and notified by the peripheral with their
+ * results, and an L2CAP LE credit based server.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <zephyr/types.h>
+
+#define BENCH_UUID_SERVICE_VAL \
+	0x10, 0xbe, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12, \
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12
+
+#define BENCH_UUID_DATA_VAL \
+	0x11, 0xbe, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12, \
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12
+
+#define BENCH_L2CAP_PSM 0x0080
+#define BENCH_L2CAP_MTU 512
+
+enum bench_op {
+	/* Notify the command back, for the round trip time */
+	BENCH_OP_ECHO = 1,
+	/* Notify count values of len bytes */
+	BENCH_OP_NOTIFY,
+	/* Notify BENCH_OP_L2CAP_DONE once count bytes are received over
+	 * the L2CAP channel
+	 */
+	BENCH_OP_L2CAP,
+	BENCH_OP_L2CAP_DONE,
+};
+
+/* Fields in little endian */
+struct bench_cmd {
+	u8_t op;
+	u8_t reserved;
+	u16_t len;
+	u32_t count;
+} __packed;
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Peripheral of the Bluetooth benchmark, serving the commands of the
+ * central, see bench.h.
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <misc/printk.h>
+#include <misc/byteorder.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/gatt.h>
+#include <bluetooth/l2cap.h>
+#include <bluetooth/uuid.h>
+
+#include "bench.h"
+
+static struct bt_uuid_128 bench_uuid = BT_UUID_INIT_128(
+	BENCH_UUID_SERVICE_VAL);
+static struct bt_uuid_128 bench_data_uuid = BT_UUID_INIT_128(
+	BENCH_UUID_DATA_VAL);
+
+K_MSGQ_DEFINE(cmd_msgq, sizeof(struct bench_cmd), 8, 4);
+
+static struct bt_conn *bench_conn;
+static u8_t notify_buf[BENCH_L2CAP_MTU];
+
+static u32_t l2cap_expected;
+static u32_t l2cap_received;
+
+static ssize_t write_cmd(struct bt_conn *conn,
+			 const struct bt_gatt_attr *attr, const void *buf,
+			 u16_t len, u16_t offset, u8_t flags)
+{
+	struct bench_cmd cmd;
+
+	if (offset != 0U || len != sizeof(cmd)) {
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+	}
+
+	memcpy(&cmd, buf, sizeof(cmd));
+
+	/* In the RX thread as the L2CAP data, which follows the command */
+	if (cmd.op == BENCH_OP_L2CAP) {
+		l2cap_received = 0U;
+		l2cap_expected = sys_le32_to_cpu(cmd.count);
+		return len;
+	}
+
+	if (k_msgq_put(&cmd_msgq, &cmd, K_NO_WAIT) != 0) {
+		return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+	}
+
+	return len;
+}
+
+static struct bt_gatt_ccc_cfg bench_ccc_cfg[BT_GATT_CCC_MAX] = {};
+
+static void bench_ccc_cfg_changed(const struct bt_gatt_attr *attr,
+				  u16_t value)
+{
+	ARG_UNUSED(attr);
+
+	printk("Notifications %s\n",
+	       value == BT_GATT_CCC_NOTIFY ? "enabled" : "disabled");
+}
+
+BT_GATT_SERVICE_DEFINE(bench_svc,
+	BT_GATT_PRIMARY_SERVICE(&bench_uuid),
+	BT_GATT_CHARACTERISTIC(&bench_data_uuid.uuid,
+			       BT_GATT_CHRC_WRITE_WITHOUT_RESP |
+			       BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_WRITE, NULL, write_cmd, NULL),
+	BT_GATT_CCC(bench_ccc_cfg, bench_ccc_cfg_changed),
+);
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BENCH_UUID_SERVICE_VAL),
+};
+
+static int l2cap_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	struct bench_cmd done = {
+		.op = BENCH_OP_L2CAP_DONE,
+	};
+
+	l2cap_received += buf->len;
+
+	if (l2cap_expected != 0U && l2cap_received >= l2cap_expected) {
+		done.count = sys_cpu_to_le32(l2cap_received);
+		l2cap_expected = 0U;
+		(void)k_msgq_put(&cmd_msgq, &done, K_NO_WAIT);
+	}
+
+	return 0;
+}
+
+static struct bt_l2cap_chan_ops l2cap_ops = {
+	.recv = l2cap_recv,
+};
+
+static struct bt_l2cap_le_chan l2cap_chan = {
+	.chan.ops = &l2cap_ops,
+	.rx.mtu = BENCH_L2CAP_MTU,
+};
+
+static int l2cap_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	if (l2cap_chan.chan.conn) {
+		return -ENOMEM;
+	}
+
+	*chan = &l2cap_chan.chan;
+
+	return 0;
+}
+
+static struct bt_l2cap_server l2cap_server = {
+	.psm = BENCH_L2CAP_PSM,
+	.accept = l2cap_accept,
+};
+
+static void connected(struct bt_conn *conn, u8_t err)
+{
+	if (err) {
+		printk("Connection failed (err %u)\n", err);
+		return;
+	}
+
+	printk("Connected\n");
+	bench_conn = bt_conn_ref(conn);
+}
+
+static void disconnected(struct bt_conn *conn, u8_t reason)
+{
+	int err;
+
+	printk("Disconnected (reason %u)\n", reason);
+
+	if (bench_conn) {
+		bt_conn_unref(bench_conn);
+		bench_conn = NULL;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		printk("Advertising failed to start (err %d)\n", err);
+	}
+}
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void notify(const void *data, u16_t len)
+{
+	/* Until the buffers of the notification are freed by the TX */
+	while (bench_conn &&
+	       bt_gatt_notify(bench_conn, &bench_svc.attrs[2], data,
+			      len) == -ENOMEM) {
+		k_yield();
+	}
+}
+
+void main(void)
+{
+	struct bench_cmd cmd;
+	u32_t i;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	bt_conn_cb_register(&conn_callbacks);
+
+	err = bt_l2cap_server_register(&l2cap_server);
+	if (err) {
+		printk("L2CAP server registration failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		printk("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	printk("Benchmark peripheral ready\n");
+
+	while (1) {
+		k_msgq_get(&cmd_msgq, &cmd, K_FOREVER);
+
+		switch (cmd.op) {
+		case BENCH_OP_ECHO:
+		case BENCH_OP_L2CAP_DONE:
+			notify(&cmd, sizeof(cmd));
+			break;
+		case BENCH_OP_NOTIFY:
+			cmd.len = MIN(sys_le16_to_cpu(cmd.len),
+				      sizeof(notify_buf));
+			for (i = 0U; i < sys_le32_to_cpu(cmd.count); i++) {
+				notify(notify_buf, cmd.len);
+			}
+			break;
+		default:
+			printk("Unknown command %u\n", cmd.op);
+			break;
+		}
+	}
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <crypto/cipher.h>
+
+#if defined(CONFIG_CRYPTO_NRF_ECB)
+#define CRYPTO_DRV_NAME CONFIG_CRYPTO_NRF_ECB_DRV_NAME
+#else
+#define CRYPTO_DRV_NAME CONFIG_CRYPTO_TINYCRYPT_SHIM_DRV_NAME
+#endif
+
+#define REQS 4
+#define LEN 40
+
+static u8_t key[16] = {
+	0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88,
+	0x09, 0xcf, 0x4f, 0x3c
+};
+
+static u8_t iv[REQS][12];
+static u8_t plaintext[REQS][LEN];
+static u8_t queued[REQS][LEN];
+static u8_t expected[REQS][LEN];
+
+static struct cipher_pkt pkts[REQS];
+static struct cipher_req reqs[REQS];
+
+static K_SEM_DEFINE(done_sem, 0, REQS);
+static int done_order[REQS];
+static int done_count;
+
+static void req_done(struct cipher_req *req, int status)
+{
+	zassert_equal(status, 0, "Request failed");
+
+	done_order[done_count++] = (int)(uintptr_t)req->user_data;
+	k_sem_give(&done_sem);
+}
+
+static void ctr_session(struct device *dev, struct cipher_ctx *ctx,
+			enum cipher_op op)
+{
+	*ctx = (struct cipher_ctx) {
+		.keylen = sizeof(key),
+		.key.bit_stream = key,
+		.mode_params.ctr_info.ctr_len = 32,
+		.flags = CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS,
+	};
+
+	zassert_equal(cipher_begin_session(dev, ctx, CRYPTO_CIPHER_ALGO_AES,
+					   CRYPTO_CIPHER_MODE_CTR, op), 0,
+		      "Session setup failed");
+}
+
+void test_queue_ctr(void)
+{
+	struct device *dev = device_get_binding(CRYPTO_DRV_NAME);
+	struct cipher_ctx enc, dec;
+	struct cipher_pkt pkt;
+	int i, j;
+
+	zassert_not_null(dev, "Crypto device not found");
+
+	for (i = 0; i < REQS; i++) {
+		for (j = 0; j < LEN; j++) {
+			plaintext[i][j] = i * LEN + j;
+		}
+		(void)memset(iv[i], i + 1, sizeof(iv[i]));
+	}
+
+	/* Reference results of the synchronous operations */
+	ctr_session(dev, &enc, CRYPTO_CIPHER_OP_ENCRYPT);
+	for (i = 0; i < REQS; i++) {
+		pkt = (struct cipher_pkt) {
+			.in_buf = plaintext[i],
+			.in_len = LEN,
+			.out_buf = expected[i],
+			.out_buf_max = LEN,
+		};
+		zassert_equal(cipher_ctr_op(&enc, &pkt, iv[i]), 0, NULL);
+	}
+
+	/* A batch of requests submitted back to back */
+	for (i = 0; i < REQS; i++) {
+		pkts[i] = (struct cipher_pkt) {
+			.in_buf = plaintext[i],
+			.in_len = LEN,
+			.out_buf = queued[i],
+			.out_buf_max = LEN,
+		};
+		reqs[i] = (struct cipher_req) {
+			.ctx = &enc,
+			.pkt = &pkts[i],
+			.iv = iv[i],
+			.cb = req_done,
+			.user_data = (void *)(uintptr_t)i,
+		};
+		zassert_equal(cipher_req_submit(&reqs[i]), 0, "Submit failed");
+	}
+
+	for (i = 0; i < REQS; i++) {
+		zassert_equal(k_sem_take(&done_sem, K_SECONDS(1)), 0,
+			      "Request not completed");
+	}
+
+	for (i = 0; i < REQS; i++) {
+		zassert_equal(done_order[i], i, "Completed out of order");
+		zassert_equal(pkts[i].out_len, LEN, NULL);
+		zassert_mem_equal(queued[i], expected[i], LEN,
+				  "Queued result differs");
+	}
+
+	/* Decrypted back to the plaintext */
+	ctr_session(dev, &dec, CRYPTO_CIPHER_OP_DECRYPT);
+	for (i = 0; i < REQS; i++) {
+		pkt = (struct cipher_pkt) {
+			.in_buf = queued[i],
+			.in_len = LEN,
+			.out_buf = expected[i],
+			.out_buf_max = LEN,
+		};
+		zassert_equal(cipher_ctr_op(&dec, &pkt, iv[i]), 0, NULL);
+		zassert_mem_equal(expected[i], plaintext[i], LEN,
+				  "Round trip failed");
+	}
+
+	cipher_free_session(dev, &enc);
+	cipher_free_session(dev, &dec);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(crypto_queue,
+			 ztest_unit_test(test_queue_ctr));
+	ztest_run_test_suite(crypto_queue);
+}
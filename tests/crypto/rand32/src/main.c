@@ -15,6 +15,8 @@
 
 #include <ztest.h>
 #include <kernel_internal.h>
+#include <string.h>
+#include <random/rand32.h>
 
 #define N_VALUES 10
 
@@ -66,11 +68,50 @@ void test_rand32(void)
 	}
 }
 
+#if defined(CONFIG_CSPRNG_ENABLED)
+static struct k_timer csrand_timer;
+static u8_t csrand_isr_buf[16];
+static int csrand_isr_ret = -1;
+
+static void csrand_timer_expiry(struct k_timer *timer)
+{
+	csrand_isr_ret = sys_csrand_get(csrand_isr_buf,
+					sizeof(csrand_isr_buf));
+}
+
+void test_csrand(void)
+{
+	static const u8_t zeros[sizeof(csrand_isr_buf)];
+	u8_t buf1[300], buf2[300];
+
+	/* longer than one generator chunk, not a multiple of a block */
+	zassert_equal(sys_csrand_get(buf1, sizeof(buf1)), 0,
+		      "sys_csrand_get failed");
+	zassert_equal(sys_csrand_get(buf2, sizeof(buf2)), 0,
+		      "sys_csrand_get failed");
+	zassert_true(memcmp(buf1, buf2, sizeof(buf1)) != 0,
+		     "sys_csrand_get repeated its output");
+
+	k_timer_init(&csrand_timer, csrand_timer_expiry, NULL);
+	k_timer_start(&csrand_timer, 1, 0);
+	k_sleep(10);
+
+	zassert_equal(csrand_isr_ret, 0, "sys_csrand_get failed in ISR");
+	zassert_true(memcmp(csrand_isr_buf, zeros, sizeof(zeros)) != 0,
+		     "sys_csrand_get output not filled in ISR");
+}
+#else
+void test_csrand(void)
+{
+	ztest_test_skip();
+}
+#endif
 
 void test_main(void)
 {
 	ztest_test_suite(common_test,
-			 ztest_unit_test(test_rand32)
+			 ztest_unit_test(test_rand32),
+			 ztest_unit_test(test_csrand)
 			 );
 
 	ztest_run_test_suite(common_test);
@@ -535,3 +535,82 @@ void test_adc_invalid_request(void)
 {
 	zassert_true(test_task_invalid_request() == TC_PASS, NULL);
 }
+
+
+/*******************************************************************************
+ * test_adc_continuous_sampling
+ */
+#if defined(CONFIG_ADC_CONTINUOUS)
+static volatile u32_t m_halves_done;
+static volatile u32_t m_halves_wrong;
+
+static void continuous_callback(struct device *dev, void *buffer,
+				size_t samplings, void *user_data)
+{
+	/* Halves come alternately, starting with the first one */
+	if (buffer != (s16_t *)user_data + (m_halves_done % 2) * samplings ||
+	    samplings != BUFFER_SIZE / 2) {
+		++m_halves_wrong;
+	}
+
+	++m_halves_done;
+}
+
+static int test_task_continuous_sampling(void)
+{
+	int ret;
+	const struct adc_sequence sequence = {
+		.channels    = BIT(ADC_1ST_CHANNEL_ID),
+		.buffer      = m_sample_buffer,
+		.buffer_size = sizeof(m_sample_buffer),
+		.resolution  = ADC_RESOLUTION,
+	};
+	const struct adc_continuous_config config = {
+		.sequence    = &sequence,
+		.interval_us = 100,
+		.callback    = continuous_callback,
+		.user_data   = m_sample_buffer,
+	};
+	struct device *adc_dev = init_adc();
+
+	if (!adc_dev) {
+		return TC_FAIL;
+	}
+
+	m_halves_done = 0U;
+	m_halves_wrong = 0U;
+
+	ret = adc_continuous_start(adc_dev, &config);
+	zassert_equal(ret, 0, "adc_continuous_start() failed with code %d",
+		      ret);
+
+	/* 3 samplings per half, at 10 kHz */
+	k_sleep(K_MSEC(10));
+
+	ret = adc_continuous_stop(adc_dev);
+	zassert_equal(ret, 0, "adc_continuous_stop() failed with code %d",
+		      ret);
+
+	TC_PRINT("%u halves filled\n", m_halves_done);
+	zassert_true(m_halves_done > 10U, "Too few halves filled");
+	zassert_equal(m_halves_wrong, 0U, "%u unexpected halves",
+		      m_halves_wrong);
+
+	ret = adc_continuous_stop(adc_dev);
+	zassert_equal(ret, -EALREADY, "Second stop returned %d", ret);
+
+	/* The ADC is usable for regular reads again */
+	ret = adc_read(adc_dev, &sequence);
+	zassert_equal(ret, 0, "adc_read() failed with code %d", ret);
+
+	return TC_PASS;
+}
+#endif /* defined(CONFIG_ADC_CONTINUOUS) */
+void test_adc_continuous_sampling(void)
+{
+#if defined(CONFIG_ADC_CONTINUOUS)
+	zassert_true(test_task_continuous_sampling() == TC_PASS, NULL);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_CONTINUOUS) */
+}
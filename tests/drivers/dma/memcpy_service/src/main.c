@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <dma.h>
+#include <string.h>
+
+#if defined(CONFIG_DMA_STM32F4X)
+/* only DMA2 does memory to memory transfers */
+#define DMA_DEVICE_NAME CONFIG_DMA_2_NAME
+#else
+#define DMA_DEVICE_NAME CONFIG_DMA_0_NAME
+#endif
+
+/* more than one block, not a multiple of the word size */
+#define COPY_SIZE (CONFIG_DMA_MEMCPY_BLOCK_SIZE + 301)
+
+static u8_t __aligned(32) src_buf[COPY_SIZE];
+static u8_t __aligned(32) dst_buf[COPY_SIZE];
+
+static struct device *get_dma(void)
+{
+	struct device *dma = device_get_binding(DMA_DEVICE_NAME);
+
+	zassert_not_null(dma, "Cannot get DMA device");
+
+	return dma;
+}
+
+static void fill(void)
+{
+	size_t i;
+
+	for (i = 0; i < COPY_SIZE; i++) {
+		src_buf[i] = (u8_t)(i * 7U);
+	}
+
+	(void)memset(dst_buf, 0, sizeof(dst_buf));
+}
+
+void test_memcpy_words(void)
+{
+	struct device *dma = get_dma();
+	size_t len = COPY_SIZE & ~3U;
+
+	fill();
+
+	zassert_equal(dma_memcpy(dma, dst_buf, src_buf, len), 0, NULL);
+	zassert_mem_equal(dst_buf, src_buf, len, "Data mismatch");
+	zassert_equal(dst_buf[len], 0, "Copied past the end");
+}
+
+void test_memcpy_bytes(void)
+{
+	struct device *dma = get_dma();
+
+	fill();
+
+	zassert_equal(dma_memcpy(dma, dst_buf + 1, src_buf + 3,
+				 COPY_SIZE - 3), 0, NULL);
+	zassert_mem_equal(dst_buf + 1, src_buf + 3, COPY_SIZE - 3,
+			  "Data mismatch");
+	zassert_equal(dst_buf[0], 0, "Copied before the start");
+}
+
+static K_SEM_DEFINE(async_done, 0, 1);
+static int async_result;
+
+static void async_callback(struct dma_memcpy *copy, int result)
+{
+	async_result = result;
+	k_sem_give(&async_done);
+}
+
+void test_memcpy_async(void)
+{
+	struct device *dma = get_dma();
+	struct dma_memcpy copy = {
+		.callback = async_callback,
+	};
+
+	fill();
+
+	zassert_equal(dma_memcpy_async(dma, &copy, dst_buf, src_buf,
+				       COPY_SIZE), 0, NULL);
+	zassert_equal(k_sem_take(&async_done, K_MSEC(1000)), 0,
+		      "Copy not completed");
+	zassert_equal(async_result, 0, NULL);
+	zassert_mem_equal(dst_buf, src_buf, COPY_SIZE, "Data mismatch");
+}
+
+void test_channel_alloc(void)
+{
+	struct device *dma = get_dma();
+	int any, ret;
+
+	any = dma_request_channel(dma, DMA_CHANNEL_ANY);
+	zassert_true(any >= 0, "No free channel (%d)", any);
+
+	ret = dma_request_channel(dma, any);
+	zassert_equal(ret, -EBUSY, "Channel %d allocated twice", any);
+
+	ret = dma_request_channel(dma, DMA_CHANNEL_ANY);
+	zassert_not_equal(ret, any, "Channel %d allocated twice", any);
+	if (ret >= 0) {
+		dma_release_channel(dma, ret);
+	}
+
+	dma_release_channel(dma, any);
+
+	ret = dma_request_channel(dma, any);
+	zassert_equal(ret, any, "Channel %d not released", any);
+	dma_release_channel(dma, any);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(dma_memcpy_service,
+			 ztest_unit_test(test_channel_alloc),
+			 ztest_unit_test(test_memcpy_words),
+			 ztest_unit_test(test_memcpy_bytes),
+			 ztest_unit_test(test_memcpy_async));
+	ztest_run_test_suite(dma_memcpy_service);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput of erase, write and read, small and large, on the storage
+ * partition of the board flash.
+ */
+
+#include <ztest.h>
+#include <flash.h>
+#include <flash_map.h>
+#include <device.h>
+
+#define TEST_AREA_ID DT_FLASH_AREA_STORAGE_ID
+#define TEST_BUF_SIZE 4096
+#define TEST_SMALL_READ 16
+
+static const struct flash_area *fa;
+static struct flash_sector sector;
+static u8_t buf[TEST_BUF_SIZE];
+
+static u32_t test_cycles_to_us(u32_t cycles)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NSEC_PER_USEC);
+}
+
+static void test_report(const char *what, size_t bytes, u32_t cycles)
+{
+	u32_t us = test_cycles_to_us(cycles);
+
+	if (!us) {
+		us = 1U;
+	}
+
+	TC_PRINT("%-12s %6u bytes in %8u us: %6u KiB/s\n", what,
+		 (unsigned int)bytes, us,
+		 (unsigned int)(((u64_t)bytes * USEC_PER_SEC / 1024U) / us));
+}
+
+static void test_setup(void)
+{
+	u32_t sector_cnt = 1U;
+	int rc;
+
+	rc = flash_area_open(TEST_AREA_ID, &fa);
+	zassert_equal(0, rc, "flash_area_open failed");
+
+	/* the first sector of the area is used */
+	rc = flash_area_get_sectors(TEST_AREA_ID, &sector_cnt, &sector);
+	zassert_true(rc == 0 || rc == -ENOMEM, "flash_area_get_sectors failed");
+	zassert_true(sector.fs_size <= fa->fa_size, "sector larger than area");
+}
+
+static void test_erase_throughput(void)
+{
+	u32_t start;
+	int rc;
+
+	start = k_cycle_get_32();
+	rc = flash_area_erase(fa, 0, sector.fs_size);
+	test_report("erase", sector.fs_size, k_cycle_get_32() - start);
+	zassert_equal(0, rc, "flash_area_erase failed");
+}
+
+static void test_write_throughput(void)
+{
+	size_t len = MIN(sizeof(buf), sector.fs_size);
+	u32_t start;
+	size_t i;
+	int rc;
+
+	for (i = 0; i < len; i++) {
+		buf[i] = i;
+	}
+
+	start = k_cycle_get_32();
+	rc = flash_area_write(fa, 0, buf, len);
+	test_report("write", len, k_cycle_get_32() - start);
+	zassert_equal(0, rc, "flash_area_write failed");
+}
+
+static void test_read_throughput(void)
+{
+	size_t len = MIN(sizeof(buf), sector.fs_size);
+	u32_t start;
+	size_t i;
+	int rc;
+
+	(void)memset(buf, 0, sizeof(buf));
+
+	start = k_cycle_get_32();
+	rc = flash_area_read(fa, 0, buf, len);
+	test_report("read", len, k_cycle_get_32() - start);
+	zassert_equal(0, rc, "flash_area_read failed");
+
+	for (i = 0; i < len; i++) {
+		zassert_equal((u8_t)i, buf[i], "wrong data at %u",
+			      (unsigned int)i);
+	}
+
+	/* the same data read in small pieces, as file systems do */
+	start = k_cycle_get_32();
+	for (i = 0; i < len; i += TEST_SMALL_READ) {
+		rc = flash_area_read(fa, i, &buf[i], TEST_SMALL_READ);
+		if (rc) {
+			break;
+		}
+	}
+	test_report("small read", len, k_cycle_get_32() - start);
+	zassert_equal(0, rc, "flash_area_read failed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(flash_throughput,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_erase_throughput),
+			 ztest_unit_test(test_write_throughput),
+			 ztest_unit_test(test_read_throughput));
+
+	ztest_run_test_suite(flash_throughput);
+}
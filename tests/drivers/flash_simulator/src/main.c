@@ -261,6 +261,70 @@ static void test_double_write(void)
 	zassert_equal(-EIO, rc, "Unexpected error code (%d)", rc);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+static K_SEM_DEFINE(async_cb_sem, 0, 1);
+static int async_cb_result;
+
+static void async_cb(struct device *dev, struct flash_async_op *op,
+		     int result)
+{
+	async_cb_result = result;
+	k_sem_give(&async_cb_sem);
+}
+
+static void test_async(void)
+{
+	struct flash_async_op op = {0};
+	struct k_poll_signal signal;
+	struct k_poll_event evt;
+	u8_t data[4] = {0xAA, 0x55, 0xAA, 0x55};
+	u8_t r_data[4];
+	int rc;
+
+	rc = flash_write_protection_set(flash_dev, false);
+	zassert_equal(0, rc, NULL);
+
+	/* erase, completion through the callback */
+	op.type = FLASH_ASYNC_ERASE;
+	op.offset = FLASH_SIMULATOR_BASE_OFFSET;
+	op.len = FLASH_SIMULATOR_ERASE_UNIT;
+	op.cb = async_cb;
+	rc = flash_async_submit(flash_dev, &op);
+	zassert_equal(0, rc, "flash_async_submit should succeed");
+	zassert_equal(-EBUSY, flash_async_submit(flash_dev, &op),
+		      "op submitted twice");
+	zassert_equal(0, k_sem_take(&async_cb_sem, K_SECONDS(1)),
+		      "no completion callback");
+	zassert_equal(0, async_cb_result, "async erase failed");
+	zassert_equal(0, op.result, "async erase failed");
+
+	/* write, completion through the signal */
+	k_poll_signal_init(&signal);
+	k_poll_event_init(&evt, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &signal);
+
+	op.type = FLASH_ASYNC_WRITE;
+	op.src = data;
+	op.len = sizeof(data);
+	op.cb = NULL;
+	op.signal = &signal;
+	rc = flash_async_submit(flash_dev, &op);
+	zassert_equal(0, rc, "flash_async_submit should succeed");
+	zassert_equal(0, k_poll(&evt, 1, K_SECONDS(1)), "no signal raised");
+	zassert_equal(0, signal.result, "async write failed");
+
+	rc = flash_read(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, r_data,
+			sizeof(r_data));
+	zassert_equal(0, rc, "flash_read should succeed");
+	zassert_mem_equal(data, r_data, sizeof(data), "wrong data written");
+}
+#else
+static void test_async(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -270,7 +334,8 @@ void test_main(void)
 			 ztest_unit_test(test_access),
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
-			 ztest_unit_test(test_double_write));
+			 ztest_unit_test(test_double_write),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(flash_sim_api);
 }
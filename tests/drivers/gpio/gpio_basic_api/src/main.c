@@ -49,6 +49,7 @@ void test_main(void)
 {
 	ztest_test_suite(gpio_basic_test,
 			 ztest_unit_test(test_gpio_pin_read_write),
+			 ztest_unit_test(test_gpio_port_set_clear),
 			 ztest_unit_test(test_gpio_callback_edge_high),
 			 ztest_unit_test(test_gpio_callback_edge_low),
 			 ztest_unit_test(test_gpio_callback_level_high),
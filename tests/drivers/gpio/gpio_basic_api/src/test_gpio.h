@@ -65,6 +65,7 @@ struct drv_data {
 };
 
 void test_gpio_pin_read_write(void);
+void test_gpio_port_set_clear(void);
 void test_gpio_callback_edge_high(void);
 void test_gpio_callback_edge_low(void);
 void test_gpio_callback_level_high(void);
@@ -45,3 +45,43 @@ void test_gpio_pin_read_write(void)
 			    "Inconsistent GPIO read/write value");
 	}
 }
+
+void test_gpio_port_set_clear(void)
+{
+	struct device *dev = device_get_binding(DEV_NAME);
+	u32_t val_read = 0U;
+	int ret;
+
+	zassert_true(gpio_pins_configure(dev, BIT(PIN_OUT), GPIO_DIR_OUT) == 0,
+		     "configure fail");
+	gpio_pin_configure(dev, PIN_IN, GPIO_DIR_IN);
+	gpio_pin_disable_callback(dev, PIN_IN);
+
+	zassert_true(gpio_port_set_bits(dev, BIT(PIN_OUT)) == 0, "set fail");
+	k_sleep(10);
+	gpio_pin_read(dev, PIN_IN, &val_read);
+	zassert_equal(val_read, 1, "set bits not applied");
+
+	zassert_true(gpio_port_clear_bits(dev, BIT(PIN_OUT)) == 0,
+		     "clear fail");
+	k_sleep(10);
+	gpio_pin_read(dev, PIN_IN, &val_read);
+	zassert_equal(val_read, 0, "clear bits not applied");
+
+	/* pins outside the mask are left as they are */
+	zassert_true(gpio_port_set_masked(dev, BIT(PIN_OUT), UINT32_MAX) == 0,
+		     "set masked fail");
+	k_sleep(10);
+	gpio_pin_read(dev, PIN_IN, &val_read);
+	zassert_equal(val_read, 1, "set masked not applied");
+
+	ret = gpio_port_toggle_bits(dev, BIT(PIN_OUT));
+	if (ret == -ENOTSUP) {
+		return;
+	}
+
+	zassert_true(ret == 0, "toggle fail");
+	k_sleep(10);
+	gpio_pin_read(dev, PIN_IN, &val_read);
+	zassert_equal(val_read, 0, "toggle not applied");
+}
@@ -132,6 +132,36 @@ void test_clock_cycle(void)
 	}
 }
 
+/**
+ * @brief Test the 64-bit clock cycle counter
+ *
+ * @see k_cycle_get_64(), k_cycle_to_ns_64()
+ */
+void test_clock_cycle_64(void)
+{
+	u64_t c0, c1;
+	u32_t t32;
+
+	/**TESTPOINT: low word is the 32-bit counter*/
+	c0 = k_cycle_get_64();
+	t32 = k_cycle_get_32();
+	zassert_true(t32 - (u32_t)c0 < sys_clock_hw_cycles_per_tick(), NULL);
+
+	/**TESTPOINT: monotonic over a millisecond*/
+	ALIGN_MS_BOUNDARY;
+	c0 = k_cycle_get_64();
+	ALIGN_MS_BOUNDARY;
+	c1 = k_cycle_get_64();
+	zassert_true(c1 > c0, NULL);
+	zassert_true(k_cycle_to_ns_64(c1 - c0) >=
+		     (NSEC_PER_SEC / MSEC_PER_SEC) / 2, NULL);
+
+	/**TESTPOINT: conversion does not overflow*/
+	c0 = (u64_t)sys_clock_hw_cycles_per_sec() * 3600U * 24U * 365U;
+	zassert_equal(k_cycle_to_ns_64(c0),
+		      (u64_t)NSEC_PER_SEC * 3600U * 24U * 365U, NULL);
+}
+
 /**
  * @}
  */
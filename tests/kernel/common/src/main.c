@@ -18,6 +18,7 @@ extern void test_slist(void);
 extern void test_dlist(void);
 extern void test_timeout_order(void);
 extern void test_clock_cycle(void);
+extern void test_clock_cycle_64(void);
 extern void test_clock_uptime(void);
 extern void test_multilib(void);
 extern void test_thread_context(void);
@@ -84,6 +85,7 @@ void test_main(void)
 			 ztest_unit_test(test_timeout_order),
 			 ztest_unit_test(test_clock_uptime),
 			 ztest_unit_test(test_clock_cycle),
+			 ztest_unit_test(test_clock_cycle_64),
 			 ztest_unit_test(test_version),
 			 ztest_unit_test(test_multilib),
 			 ztest_unit_test(test_thread_context)
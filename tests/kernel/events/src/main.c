@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE 512
+#define TIMEOUT 50
+
+#define EV_A BIT(0)
+#define EV_B BIT(1)
+
+K_EVENT_DEFINE(kevent);
+static struct k_event event;
+
+static K_THREAD_STACK_DEFINE(tstack1, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(tstack2, STACK_SIZE);
+static struct k_thread tdata1, tdata2;
+
+static volatile u32_t woken1, woken2;
+
+static void tisr_entry(void *p)
+{
+	k_event_post((struct k_event *)p, EV_B);
+}
+
+/* waits for both events, and consumes them */
+static void waiter_all(void *p1, void *p2, void *p3)
+{
+	woken1 = k_event_wait(&event, EV_A | EV_B,
+			      K_EVENT_WAIT_ALL | K_EVENT_WAIT_CLEAR,
+			      K_FOREVER);
+}
+
+static void waiter_any(void *p1, void *p2, void *p3)
+{
+	woken2 = k_event_wait(&event, EV_B, K_EVENT_WAIT_ANY, K_FOREVER);
+}
+
+void test_event_no_wait(void)
+{
+	k_event_init(&event);
+
+	zassert_equal(k_event_post(&event, EV_A | EV_B), EV_A | EV_B, NULL);
+	zassert_equal(k_event_wait(&event, EV_A, K_EVENT_WAIT_ANY, K_NO_WAIT),
+		      EV_A | EV_B, "Posted event not found");
+	zassert_equal(k_event_wait(&event, EV_A | BIT(2), K_EVENT_WAIT_ALL,
+				   K_NO_WAIT), 0, "Missing event found");
+	zassert_equal(k_event_wait(&event, EV_A, K_EVENT_WAIT_CLEAR,
+				   K_NO_WAIT), EV_A | EV_B, NULL);
+	zassert_equal(k_event_get(&event), EV_B, "Event not consumed");
+	zassert_equal(k_event_clear(&event, EV_B), EV_B, NULL);
+	zassert_equal(k_event_get(&event), 0, "Event not cleared");
+	zassert_equal(k_event_wait(&event, EV_A, K_EVENT_WAIT_ANY, TIMEOUT),
+		      0, "Wait did not time out");
+}
+
+void test_event_wakeup_order(void)
+{
+	k_tid_t tid1, tid2;
+
+	k_event_init(&event);
+	woken1 = 0;
+	woken2 = 0;
+
+	/* both wait at once, the higher priority one is served first */
+	tid1 = k_thread_create(&tdata1, tstack1, STACK_SIZE, waiter_all,
+			       NULL, NULL, NULL, K_PRIO_COOP(1), 0, 0);
+	tid2 = k_thread_create(&tdata2, tstack2, STACK_SIZE, waiter_any,
+			       NULL, NULL, NULL, K_PRIO_COOP(2), 0, 0);
+	k_sleep(TIMEOUT);
+
+	zassert_equal(k_event_post(&event, EV_A), EV_A, NULL);
+	zassert_equal(woken1, 0, "Woken without all its events");
+	zassert_equal(woken2, 0, "Woken without its event");
+
+	/* the first waiter consumes EV_B before the second can see it */
+	zassert_equal(k_event_post(&event, EV_B), 0, "Events not consumed");
+	zassert_equal(woken1, EV_A | EV_B, "All waiter not woken");
+	zassert_equal(woken2, 0, "Woken by a consumed event");
+
+	k_event_post(&event, EV_B);
+	zassert_equal(woken2, EV_B, "Any waiter not woken");
+	zassert_equal(k_event_get(&event), EV_B, "Event consumed");
+
+	k_thread_abort(tid1);
+	k_thread_abort(tid2);
+}
+
+void test_event_isr_post(void)
+{
+	k_event_clear(&kevent, ~0U);
+
+	irq_offload(tisr_entry, &kevent);
+	zassert_equal(k_event_wait(&kevent, EV_B, K_EVENT_WAIT_CLEAR,
+				   K_FOREVER), EV_B, "ISR event not found");
+	zassert_equal(k_event_get(&kevent), 0, "Event not consumed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(events,
+			 ztest_unit_test(test_event_no_wait),
+			 ztest_unit_test(test_event_wakeup_order),
+			 ztest_unit_test(test_event_isr_post));
+	ztest_run_test_suite(events);
+}
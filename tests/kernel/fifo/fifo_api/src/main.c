@@ -13,6 +13,7 @@
  *   -# k_fifo_init K_FIFO_DEFINE
  *   -# k_fifo_put k_fifo_put_list k_fifo_put_slist
  *   -# k_fifo_get *
+ *   -# k_fifo_get_all
  *
  * @defgroup kernel_fifo_tests FIFOs
  * @ingroup all_tests
@@ -29,6 +30,7 @@ extern void test_fifo_loop(void);
 extern void test_fifo_cancel_wait(void);
 extern void test_fifo_is_empty_thread(void);
 extern void test_fifo_is_empty_isr(void);
+extern void test_fifo_get_all(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -41,6 +43,7 @@ void test_main(void)
 			 ztest_unit_test(test_fifo_loop),
 			 ztest_unit_test(test_fifo_cancel_wait),
 			 ztest_unit_test(test_fifo_is_empty_thread),
-			 ztest_unit_test(test_fifo_is_empty_isr));
+			 ztest_unit_test(test_fifo_is_empty_isr),
+			 ztest_unit_test(test_fifo_get_all));
 	ztest_run_test_suite(fifo_api);
 }
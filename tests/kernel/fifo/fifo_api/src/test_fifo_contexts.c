@@ -125,6 +125,37 @@ static void tfifo_is_empty(void *p)
 	zassert_true(k_fifo_is_empty(pfifo), NULL);
 }
 
+static void tfifo_get_all(struct k_fifo *pfifo)
+{
+	fdata_t *node;
+	int i = 0;
+
+	tfifo_put(pfifo);
+	/**TESTPOINT: fifo get all*/
+	node = k_fifo_get_all(pfifo);
+	zassert_true(k_fifo_is_empty(pfifo), NULL);
+
+	/*items come back in put order: data, data_l, data_sl*/
+	for (; node != NULL; node = (fdata_t *)node->snode.next, i++) {
+		if (i < LIST_LEN) {
+			zassert_equal(node, &data[i], NULL);
+		} else if (i < 2 * LIST_LEN) {
+			zassert_equal(node, &data_l[i - LIST_LEN], NULL);
+		} else {
+			zassert_equal(node, &data_sl[i - 2 * LIST_LEN], NULL);
+		}
+	}
+	zassert_equal(i, 3 * LIST_LEN, NULL);
+
+	/**TESTPOINT: fifo get all on empty fifo*/
+	zassert_is_null(k_fifo_get_all(pfifo), NULL);
+}
+
+static void tIsr_entry_get_all(void *p)
+{
+	tfifo_get_all((struct k_fifo *)p);
+}
+
 /**
  * @addtogroup kernel_fifo_tests
  * @{
@@ -196,6 +227,19 @@ void test_fifo_is_empty_isr(void)
 	/**TESTPOINT: check fifo is empty from isr*/
 	irq_offload(tfifo_is_empty, &fifo);
 }
+
+/**
+ * @brief Test draining a fifo in one call
+ * @see k_fifo_get_all(), k_fifo_put(), k_fifo_put_list()
+ */
+void test_fifo_get_all(void)
+{
+	k_fifo_init(&fifo);
+	tfifo_get_all(&fifo);
+
+	/**TESTPOINT: drain fifo from isr*/
+	irq_offload(tIsr_entry_get_all, &fifo);
+}
 /**
  * @}
  */
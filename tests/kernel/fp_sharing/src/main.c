@@ -99,6 +99,7 @@ static volatile unsigned int load_store_high_count;
 
 extern void calculate_pi_low(void);
 extern void calculate_pi_high(void);
+extern void fp_switch_cost_report(void);
 
 /**
  *
@@ -335,6 +336,7 @@ void load_store_high(void)
 		/* terminate testing if specified limit has been reached */
 
 		if (load_store_high_count == MAX_TESTS) {
+			fp_switch_cost_report();
 			TC_END_RESULT(TC_PASS);
 			TC_END_REPORT(TC_PASS);
 			return;
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @brief context switch cost portion of FPU sharing test
+ *
+ * @ingroup kernel_fpsharing_tests
+ *
+ * @details This module measures the average cost of a context switch
+ * between two cooperative threads yielding to each other, first when
+ * neither uses the FPU, then when one of them does. The difference is the
+ * cost of preserving the FP context of the thread using it. On Cortex-M,
+ * building with CONFIG_ARM_FP_LAZY_SWITCH shows the gain of not reloading
+ * the FP registers of a thread no other thread used them since.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define N_SWITCHES 1000
+#define SWITCH_STACKSIZE 1024
+#define SWITCH_PRI K_PRIO_COOP(1)
+
+#if defined(CONFIG_ISA_IA32)
+#define THREAD_FP_FLAGS (K_FP_REGS | K_SSE_REGS)
+#else
+#define THREAD_FP_FLAGS (K_FP_REGS)
+#endif
+
+static K_THREAD_STACK_DEFINE(ping_stack, SWITCH_STACKSIZE);
+static K_THREAD_STACK_DEFINE(pong_stack, SWITCH_STACKSIZE);
+static struct k_thread ping_thread;
+static struct k_thread pong_thread;
+
+static K_SEM_DEFINE(switch_done, 0, 2);
+
+static volatile float pong_float;
+static u32_t switch_cycles;
+
+static void ping(void *p1, void *p2, void *p3)
+{
+	u32_t start;
+	int i;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_SWITCHES; i++) {
+		k_yield();
+	}
+	switch_cycles = k_cycle_get_32() - start;
+
+	k_sem_give(&switch_done);
+}
+
+static void pong(void *use_fp, void *p2, void *p3)
+{
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_SWITCHES; i++) {
+		if (use_fp != NULL) {
+			pong_float += 1.0f;
+		}
+		k_yield();
+	}
+
+	k_sem_give(&switch_done);
+}
+
+/* Each iteration of the ping loop is two context switches */
+static u32_t switch_cost_run(bool use_fp)
+{
+	k_thread_create(&ping_thread, ping_stack, SWITCH_STACKSIZE,
+			ping, NULL, NULL, NULL,
+			SWITCH_PRI, 0, K_FOREVER);
+	k_thread_create(&pong_thread, pong_stack, SWITCH_STACKSIZE,
+			pong, use_fp ? (void *)1 : NULL, NULL, NULL,
+			SWITCH_PRI, use_fp ? THREAD_FP_FLAGS : 0, K_FOREVER);
+
+	k_sched_lock();
+	k_thread_start(&ping_thread);
+	k_thread_start(&pong_thread);
+	k_sched_unlock();
+
+	k_sem_take(&switch_done, K_FOREVER);
+	k_sem_take(&switch_done, K_FOREVER);
+
+	return switch_cycles / (2 * N_SWITCHES);
+}
+
+/**
+ *
+ * @brief Report the cost of context switches with and without FP context
+ *
+ * @ingroup kernel_fpsharing_tests
+ */
+void fp_switch_cost_report(void)
+{
+	u32_t plain = switch_cost_run(false);
+	u32_t fp = switch_cost_run(true);
+
+	PRINT_DATA("Context switch: %u cycles, %u cycles with one thread "
+		   "using the FPU\n", plain, fp);
+}
@@ -26,6 +26,7 @@ extern void test_mbox_async_put_to_waiting_get(void);
 extern void test_mbox_get_waiting_put_incorrect_tid(void);
 extern void test_mbox_async_multiple_put(void);
 extern void test_mbox_multiple_waiting_get(void);
+extern void test_mbox_async_msg_put(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -53,6 +54,7 @@ void test_main(void)
 			 ztest_unit_test(
 				test_mbox_get_waiting_put_incorrect_tid),
 			 ztest_unit_test(test_mbox_async_multiple_put),
-			 ztest_unit_test(test_mbox_multiple_waiting_get));
+			 ztest_unit_test(test_mbox_multiple_waiting_get),
+			 ztest_unit_test(test_mbox_async_msg_put));
 	ztest_run_test_suite(mbox_api);
 }
@@ -672,3 +672,42 @@ void test_mbox_multiple_waiting_get(void)
 	info_type = MULTIPLE_WAITING_GET;
 	tmbox(&mbox);
 }
+
+void test_mbox_async_msg_put(void)
+{
+	static struct k_mbox_async async[2];
+	struct k_mbox_msg mmsg = {0};
+	char rxdata[MAIL_LEN];
+	static struct k_mbox tmbox;
+
+	k_mbox_init(&tmbox);
+	k_sem_reset(&sync_sema);
+
+	/**TESTPOINT: async put from a caller descriptor, to another thread*/
+	async[0].tx_msg.size = 0;
+	async[0].tx_msg.tx_data = NULL;
+	async[0].tx_msg.tx_block.data = NULL;
+	async[0].tx_msg.tx_target_thread = &tdata;
+	k_mbox_async_msg_put(&tmbox, &async[0], NULL);
+
+	/**TESTPOINT: async put from a caller descriptor, to this thread*/
+	async[1].tx_msg.info = PUT_GET_BUFFER;
+	async[1].tx_msg.size = sizeof(data[PUT_GET_BUFFER]);
+	async[1].tx_msg.tx_data = data[PUT_GET_BUFFER];
+	async[1].tx_msg.tx_block.data = NULL;
+	async[1].tx_msg.tx_target_thread = k_current_get();
+	k_mbox_async_msg_put(&tmbox, &async[1], &sync_sema);
+
+	/* only the message to this thread is received */
+	mmsg.rx_source_thread = K_ANY;
+	mmsg.size = MAIL_LEN;
+	zassert_equal(k_mbox_get(&tmbox, &mmsg, rxdata, K_NO_WAIT), 0, NULL);
+	zassert_equal(mmsg.info, PUT_GET_BUFFER, NULL);
+	zassert_true(memcmp(rxdata, data[PUT_GET_BUFFER], MAIL_LEN) == 0, NULL);
+	zassert_equal(k_sem_take(&sync_sema, K_NO_WAIT), 0,
+		      "Descriptor not released");
+
+	mmsg.size = MAIL_LEN;
+	zassert_equal(k_mbox_get(&tmbox, &mmsg, rxdata, K_NO_WAIT), -ENOMSG,
+		      "Received a message to another thread");
+}
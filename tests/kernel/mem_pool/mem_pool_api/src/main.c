@@ -20,6 +20,7 @@ extern void test_mpool_kdefine_extern(void);
 extern void test_mpool_alloc_size(void);
 extern void test_mpool_alloc_timeout(void);
 extern void test_sys_heap_mem_pool_assign(void);
+extern void test_mpool_alloc_frag(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -30,7 +31,8 @@ void test_main(void)
 			 ztest_unit_test(test_mpool_kdefine_extern),
 			 ztest_unit_test(test_mpool_alloc_size),
 			 ztest_unit_test(test_mpool_alloc_timeout),
-			 ztest_unit_test(test_sys_heap_mem_pool_assign)
+			 ztest_unit_test(test_sys_heap_mem_pool_assign),
+			 ztest_unit_test(test_mpool_alloc_frag)
 			 );
 	ztest_run_test_suite(mpool_api);
 }
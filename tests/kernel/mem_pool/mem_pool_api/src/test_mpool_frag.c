@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include "test_mpool.h"
+
+#define FRAG_BLK_MIN	16
+#define FRAG_BLK_MAX	1024
+#define FRAG_BLK_NUM	4
+#define FRAG_NUM_ALLOCS	128
+
+K_MEM_POOL_DEFINE(fragpool, FRAG_BLK_MIN, FRAG_BLK_MAX, FRAG_BLK_NUM, 4);
+
+/* Request sizes which are not powers of two (nor 4x multiples of the
+ * minimum size), the typical worst case for a buddy allocator
+ */
+static const size_t frag_sizes[] = { 20, 100, 36, 300, 52, 70, 150, 24 };
+
+static struct k_mem_block frag_blocks[FRAG_NUM_ALLOCS];
+
+struct frag_stats {
+	u32_t min;
+	u32_t max;
+	u32_t total;
+	u32_t count;
+};
+
+static void stats_add(struct frag_stats *s, u32_t cycles)
+{
+	s->min = MIN(s->min, cycles);
+	s->max = MAX(s->max, cycles);
+	s->total += cycles;
+	s->count++;
+}
+
+static void stats_print(const char *what, struct frag_stats *s)
+{
+	TC_PRINT("%s: %u ops, cycles min %u max %u avg %u\n", what, s->count,
+		 s->min, s->max, s->count ? s->total / s->count : 0);
+}
+
+/**
+ * @brief Measure fragmentation and latency of the pool allocator
+ *
+ * @details Fill a pool with odd sized requests until the first failure,
+ * free every other block and refill, reporting the payload bytes the pool
+ * could hold and the cycles spent per allocation and free. The actual
+ * figures depend on the allocator backend and are only printed; the test
+ * checks that everything freed is merged back into maximum sized blocks.
+ */
+void test_mpool_alloc_frag(void)
+{
+	struct frag_stats alloc_st = { .min = UINT32_MAX };
+	struct frag_stats free_st = { .min = UINT32_MAX };
+	size_t used = 0;
+	int n, i;
+	u32_t t;
+
+	for (n = 0; n < FRAG_NUM_ALLOCS; n++) {
+		size_t sz = frag_sizes[n % ARRAY_SIZE(frag_sizes)];
+		int ret;
+
+		t = k_cycle_get_32();
+		ret = k_mem_pool_alloc(&fragpool, &frag_blocks[n], sz,
+				       K_NO_WAIT);
+		t = k_cycle_get_32() - t;
+		if (ret != 0) {
+			break;
+		}
+		stats_add(&alloc_st, t);
+		used += sz;
+	}
+
+	zassert_true(n > 0, "no allocation succeeded");
+	TC_PRINT("first fill: %d blocks, %u of %u bytes used (%u%%)\n", n,
+		 (u32_t)used, FRAG_BLK_MAX * FRAG_BLK_NUM,
+		 (u32_t)(used * 100 / (FRAG_BLK_MAX * FRAG_BLK_NUM)));
+
+	/* Punch holes and try to refill them with larger requests */
+	for (i = 0; i < n; i += 2) {
+		t = k_cycle_get_32();
+		k_mem_pool_free(&frag_blocks[i]);
+		t = k_cycle_get_32() - t;
+		stats_add(&free_st, t);
+		used -= frag_sizes[i % ARRAY_SIZE(frag_sizes)];
+		frag_blocks[i].data = NULL;
+	}
+
+	for (i = 0; i < n; i += 2) {
+		size_t sz = frag_sizes[(i + 1) % ARRAY_SIZE(frag_sizes)];
+
+		t = k_cycle_get_32();
+		if (k_mem_pool_alloc(&fragpool, &frag_blocks[i], sz,
+				     K_NO_WAIT) != 0) {
+			frag_blocks[i].data = NULL;
+			continue;
+		}
+		t = k_cycle_get_32() - t;
+		stats_add(&alloc_st, t);
+		used += sz;
+	}
+
+	TC_PRINT("after refill: %u bytes used\n", (u32_t)used);
+	stats_print("alloc", &alloc_st);
+
+	for (i = 0; i < n; i++) {
+		if (frag_blocks[i].data == NULL) {
+			continue;
+		}
+		t = k_cycle_get_32();
+		k_mem_pool_free(&frag_blocks[i]);
+		t = k_cycle_get_32() - t;
+		stats_add(&free_st, t);
+		frag_blocks[i].data = NULL;
+	}
+
+	stats_print("free", &free_st);
+
+	/* Everything was coalesced back */
+	zassert_true(k_mem_pool_alloc(&fragpool, &frag_blocks[0],
+				      FRAG_BLK_MAX / 2, K_NO_WAIT) == 0, NULL);
+	zassert_true(k_mem_pool_alloc(&fragpool, &frag_blocks[1],
+				      FRAG_BLK_MAX / 2, K_NO_WAIT) == 0, NULL);
+	k_mem_pool_free(&frag_blocks[0]);
+	k_mem_pool_free(&frag_blocks[1]);
+}
@@ -222,3 +222,109 @@ void test_mslab_used_get(void)
 	tmslab_used_get(&mslab);
 	tmslab_used_get(&kmslab);
 }
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define CACHE_BLK_NUM (CONFIG_MEM_SLAB_CPU_CACHE_SIZE * 2)
+K_MEM_SLAB_DEFINE(cache_mslab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+
+#define CACHE_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+static K_THREAD_STACK_DEFINE(cache_stack, CACHE_STACK_SIZE);
+static struct k_thread cache_thread;
+static void *cache_waiter_block;
+
+static void tmslab_cache_waiter(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mem_slab_alloc(&cache_mslab, &cache_waiter_block,
+				       K_FOREVER), 0, NULL);
+}
+#endif
+
+/**
+ * @brief Verify the per-CPU block cache of memory slabs
+ *
+ * @details Allocate and free every block of a memory slab, then do
+ * back to back allocations and frees of a single block.  Block counts
+ * must not be affected by blocks sitting in the cache, and the back to
+ * back operations must be served by the cache.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_cpu_cache(void)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cache_stats before, after;
+	void *block[CACHE_BLK_NUM];
+	void *b;
+
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_mslab, &block[i],
+					       K_NO_WAIT), 0, NULL);
+		zassert_equal(k_mem_slab_num_used_get(&cache_mslab), i + 1,
+			      NULL);
+	}
+	zassert_equal(k_mem_slab_alloc(&cache_mslab, &b, K_NO_WAIT), -ENOMEM,
+		      NULL);
+
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cache_mslab, &block[i]);
+		zassert_equal(k_mem_slab_num_free_get(&cache_mslab), i + 1,
+			      NULL);
+	}
+
+	k_mem_slab_cache_stats_get(&cache_mslab, &before);
+	zassert_true(before.refills > 0, NULL);
+	zassert_true(before.flushes > 0, NULL);
+
+	for (int i = 0; i < 100; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_mslab, &b, K_NO_WAIT), 0,
+			      NULL);
+		k_mem_slab_free(&cache_mslab, &b);
+	}
+
+	k_mem_slab_cache_stats_get(&cache_mslab, &after);
+	zassert_equal(after.allocs - before.allocs, 100, NULL);
+	zassert_equal(after.hits - before.hits, 100, NULL);
+	zassert_equal(after.refills, before.refills, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&cache_mslab), 0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Verify a thread waiting on a memory slab with per-CPU caches
+ *
+ * @details Allocate every block, so that a higher priority thread waits
+ * for one, then free a block.  The waiting thread must get it, rather
+ * than it staying in the cache of the freeing CPU.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_cpu_cache_waiter(void)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	void *block[CACHE_BLK_NUM];
+
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_equal(k_mem_slab_alloc(&cache_mslab, &block[i],
+					       K_NO_WAIT), 0, NULL);
+	}
+
+	cache_waiter_block = NULL;
+	k_thread_create(&cache_thread, cache_stack, CACHE_STACK_SIZE,
+			tmslab_cache_waiter, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* the waiter preempts us as soon as it gets the block */
+	k_mem_slab_free(&cache_mslab, &block[0]);
+	zassert_equal_ptr(cache_waiter_block, block[0], NULL);
+
+	k_mem_slab_free(&cache_mslab, &cache_waiter_block);
+	for (int i = 1; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cache_mslab, &block[i]);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&cache_mslab), 0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 8
+
+K_MSGQ_DEFINE(many_msgq, MSG_SIZE, MANY_LEN, 4);
+static K_THREAD_STACK_DEFINE(many_stack, STACK_SIZE);
+static struct k_thread many_thread;
+static K_SEM_DEFINE(many_sema, 0, 1);
+
+static u32_t many_rx[MANY_LEN];
+
+static void fill(u32_t *msgs, int n, u32_t first)
+{
+	for (int i = 0; i < n; i++) {
+		msgs[i] = first + i;
+	}
+}
+
+static void check(const u32_t *msgs, int n, u32_t first)
+{
+	for (int i = 0; i < n; i++) {
+		zassert_equal(msgs[i], first + i, "message %d out of order", i);
+	}
+}
+
+static void tmany_receiver(void *p1, void *p2, void *p3)
+{
+	/* Blocks on the empty queue, then gets everything that was sent */
+	zassert_equal(k_msgq_get_many(&many_msgq, many_rx, MANY_LEN,
+				      K_FOREVER), 3, NULL);
+	check(many_rx, 3, 100);
+	k_sem_give(&many_sema);
+}
+
+/**
+ * @brief Test batched send and receive of messages
+ *
+ * @ingroup kernel_message_queue_tests
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_put_get_many(void)
+{
+	u32_t tx[MANY_LEN + 2], rx[2 * MANY_LEN];
+
+	zassert_equal(k_msgq_get_many(&many_msgq, rx, 1, K_NO_WAIT), -ENOMSG,
+		      NULL);
+
+	/**TESTPOINT: only what fits is sent */
+	fill(tx, MANY_LEN + 2, 0);
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, MANY_LEN + 2, K_NO_WAIT),
+		      MANY_LEN, NULL);
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, 1, K_NO_WAIT), -ENOMSG,
+		      NULL);
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, 1, TIMEOUT / 10),
+		      -EAGAIN, NULL);
+
+	zassert_equal(k_msgq_get_many(&many_msgq, rx, 5, K_NO_WAIT), 5, NULL);
+	check(rx, 5, 0);
+
+	/**TESTPOINT: the ring buffer wraps in the middle of a batch */
+	fill(tx, 4, MANY_LEN);
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, 4, K_NO_WAIT), 4, NULL);
+	zassert_equal(k_msgq_num_used_get(&many_msgq), 7, NULL);
+
+	zassert_equal(k_msgq_get_many(&many_msgq, rx, 2 * MANY_LEN,
+				      K_NO_WAIT), 7, NULL);
+	check(rx, 7, 5);
+
+	/**TESTPOINT: a blocked receiver is served by one batch */
+	k_thread_create(&many_thread, many_stack, STACK_SIZE,
+			tmany_receiver, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT / 2);
+
+	fill(tx, 3, 100);
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_sem_take(&many_sema, TIMEOUT), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&many_msgq), 0, NULL);
+
+	k_thread_abort(&many_thread);
+}
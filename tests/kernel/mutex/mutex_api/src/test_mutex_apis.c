@@ -15,6 +15,37 @@ static struct k_mutex mutex;
 static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 static struct k_thread tdata;
 
+static K_THREAD_STACK_DEFINE(tstack_mid, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(tstack_high, STACK_SIZE);
+static struct k_thread tdata_mid;
+static struct k_thread tdata_high;
+static struct k_mutex chain_mutex_a, chain_mutex_b;
+
+#define PRIO_MAIN 5
+#define PRIO_HIGH 6
+#define PRIO_MID 11
+#define PRIO_LOW 12
+
+static void tThread_entry_chain_low(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&chain_mutex_b, K_FOREVER);
+	k_sleep(TIMEOUT * 2);
+	k_mutex_unlock(&chain_mutex_b);
+}
+
+static void tThread_entry_chain_mid(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&chain_mutex_a, K_FOREVER);
+	k_mutex_lock(&chain_mutex_b, K_FOREVER);
+	k_mutex_unlock(&chain_mutex_b);
+	k_mutex_unlock(&chain_mutex_a);
+}
+
+static void tThread_entry_chain_high(void *p1, void *p2, void *p3)
+{
+	zassert_true(k_mutex_lock(&chain_mutex_a, TIMEOUT / 2) != 0, NULL);
+}
+
 static void tThread_entry_lock_forever(void *p1, void *p2, void *p3)
 {
 	zassert_false(k_mutex_lock((struct k_mutex *)p1, K_FOREVER) == 0,
@@ -138,3 +169,66 @@ void test_mutex_lock_unlock(void)
 	/**TESTPOINT: test K_MUTEX_DEFINE mutex*/
 	tmutex_test_lock_unlock(&kmutex);
 }
+
+/**
+ * @brief Test priority inheritance along a chain of mutexes
+ *
+ * A low priority thread holds mutex B, a mid priority thread holds mutex
+ * A and waits for B.  When a high priority thread blocks on A, the low
+ * priority thread must be boosted as well, and dropped back down once
+ * the high priority thread gives up.
+ *
+ * @see k_mutex_lock(), k_mutex_unlock()
+ */
+void test_mutex_priority_inheritance_chain(void)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	int boosted = CONFIG_PRIORITY_INHERITANCE_DEPTH > 1 ?
+		      PRIO_HIGH : PRIO_MID;
+
+	k_thread_priority_set(k_current_get(), PRIO_MAIN);
+	k_mutex_init(&chain_mutex_a);
+	k_mutex_init(&chain_mutex_b);
+
+	k_tid_t low = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      tThread_entry_chain_low,
+				      NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(PRIO_LOW), 0, 0);
+	k_sleep(10);
+	k_tid_t mid = k_thread_create(&tdata_mid, tstack_mid, STACK_SIZE,
+				      tThread_entry_chain_mid,
+				      NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(PRIO_MID), 0, 0);
+	k_sleep(10);
+	zassert_equal(k_thread_priority_get(low), PRIO_MID, NULL);
+
+	k_tid_t high = k_thread_create(&tdata_high, tstack_high, STACK_SIZE,
+				       tThread_entry_chain_high,
+				       NULL, NULL, NULL,
+				       K_PRIO_PREEMPT(PRIO_HIGH), 0, 0);
+	k_sleep(10);
+	/**TESTPOINT: owner of the mutex the owner waits for is boosted*/
+	zassert_equal(k_thread_priority_get(mid), PRIO_HIGH, NULL);
+	zassert_equal(k_thread_priority_get(low), boosted, NULL);
+
+	/**TESTPOINT: boost is undone along the chain on timeout*/
+	k_sleep(TIMEOUT);
+	zassert_equal(k_thread_priority_get(mid), PRIO_MID, NULL);
+	zassert_equal(k_thread_priority_get(low), PRIO_MID, NULL);
+
+#ifdef CONFIG_MUTEX_STATS
+	struct k_mutex_stats stats;
+
+	k_mutex_stats_get(&chain_mutex_a, &stats);
+	zassert_equal(stats.acquisitions, 1, NULL);
+	zassert_equal(stats.contended, 1, NULL);
+	k_mutex_stats_get(&chain_mutex_b, &stats);
+	zassert_equal(stats.contended, 1, NULL);
+#endif
+
+	/* teardown */
+	k_thread_abort(high);
+	k_thread_abort(mid);
+	k_thread_abort(low);
+	k_thread_priority_set(k_current_get(), old_prio);
+}
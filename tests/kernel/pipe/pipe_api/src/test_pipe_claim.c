@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define CLAIM_PIPE_LEN	16
+#define TIMEOUT		100
+
+#ifdef CONFIG_PIPE_CLAIM
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_LEN, 4);
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static K_SEM_DEFINE(claim_sema, 0, 1);
+
+static const u8_t pattern[] = "0123456789abcdef";
+
+/* Blocks in k_pipe_get_claim() until the main thread publishes data */
+static void tclaim_reader(void *p1, void *p2, void *p3)
+{
+	size_t claimed;
+	u8_t *rd;
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &rd, CLAIM_PIPE_LEN,
+				       &claimed, K_FOREVER), 0, NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_true(memcmp(rd, pattern, 4) == 0, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, claimed), 0, NULL);
+
+	k_sem_give(&claim_sema);
+}
+#endif
+
+/**
+ * @brief Test zero-copy access to a pipe's buffer
+ *
+ * Writes in place and reads back with k_pipe_get(), checks that claims
+ * stop at the end of the ring buffer and that a blocked claiming reader
+ * is woken up by a writer finishing its claim.
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim(void)
+{
+#ifdef CONFIG_PIPE_CLAIM
+	u8_t rx[CLAIM_PIPE_LEN];
+	size_t claimed, rd_bytes;
+	u8_t *wr, *rd;
+
+	/* Nothing to read yet */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &rd, 1, &claimed,
+				       K_NO_WAIT), -EIO, NULL);
+
+	/* Write 12 bytes in place, read them with a copying reader */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &wr, 12, &claimed,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, 12, NULL);
+	memcpy(wr, pattern, 12);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, claimed + 1), -EINVAL,
+		      NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, claimed), 0, NULL);
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 12, &rd_bytes, 12,
+				 K_NO_WAIT), 0, NULL);
+	zassert_true(memcmp(rx, pattern, 12) == 0, NULL);
+
+	/* The free space wraps: only the 4 bytes up to the end are
+	 * contiguous
+	 */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &wr, CLAIM_PIPE_LEN,
+				       &claimed, K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), 0, NULL);
+
+	/* A claiming reader waits for data, then reads it in place */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			tclaim_reader, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT / 2);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &wr, 4, &claimed,
+				       K_NO_WAIT), 0, NULL);
+	memcpy(wr, pattern, claimed);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, claimed), 0, NULL);
+
+	zassert_equal(k_sem_take(&claim_sema, TIMEOUT), 0, NULL);
+	k_thread_abort(&claim_thread);
+
+	/* The pipe is empty again */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &rd, 1, &claimed,
+				       TIMEOUT / 10), -EAGAIN, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
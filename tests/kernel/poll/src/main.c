@@ -11,6 +11,7 @@ extern void test_poll_cancel_main_low_prio(void);
 extern void test_poll_cancel_main_high_prio(void);
 extern void test_poll_multi(void);
 extern void test_poll_threadstate(void);
+extern void test_poll_set(void);
 extern void test_poll_grant_access(void);
 
 K_MEM_POOL_DEFINE(test_pool, 128, 128, 4, 4);
@@ -28,6 +29,7 @@ void test_main(void)
 			 ztest_unit_test(test_poll_cancel_main_low_prio),
 			 ztest_unit_test(test_poll_cancel_main_high_prio),
 			 ztest_unit_test(test_poll_multi),
-			 ztest_unit_test(test_poll_threadstate));
+			 ztest_unit_test(test_poll_threadstate),
+			 ztest_unit_test(test_poll_set));
 	ztest_run_test_suite(poll_api);
 }
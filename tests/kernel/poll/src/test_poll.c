@@ -579,6 +579,116 @@ void test_poll_threadstate(void)
 	k_thread_priority_set(k_current_get(), old_prio);
 }
 
+#ifdef CONFIG_POLL_SET
+static struct k_sem set_sem[2];
+static struct k_fifo set_fifo;
+static struct fifo_msg set_msg = { NULL, FIFO_MSG_VALUE };
+static struct fifo_msg *set_msg_rx;
+
+static void poll_set_put_helper(void *p1, void *p2, void *p3)
+{
+	(void)p1; (void)p2; (void)p3;
+
+	k_sleep(100);
+	k_fifo_put(&set_fifo, &set_msg);
+}
+
+static void poll_set_get_helper(void *p1, void *p2, void *p3)
+{
+	(void)p1; (void)p2; (void)p3;
+
+	set_msg_rx = k_fifo_get(&set_fifo, K_SECONDS(1));
+}
+#endif
+
+/**
+ * @brief Test waiting on a persistent poll set
+ *
+ * Verify that only ready events are returned, that they are reported
+ * for as long as their condition holds, and that events of a set do not
+ * steal wakeups from other threads waiting on the same object.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait(),
+ * k_poll_set_remove()
+ */
+void test_poll_set(void)
+{
+#ifdef CONFIG_POLL_SET
+	struct k_poll_set set;
+	struct k_poll_event events[3];
+	struct k_poll_event *ready[ARRAY_SIZE(events)];
+
+	k_sem_init(&set_sem[0], 0, 1);
+	k_sem_init(&set_sem[1], 0, 1);
+	k_fifo_init(&set_fifo);
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem[0]);
+	k_poll_event_init(&events[1], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem[1]);
+	k_poll_event_init(&events[2], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+
+	k_poll_set_init(&set);
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_set_add(&set, &events[i]);
+	}
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+
+	/* only the ready event is returned, until it is drained */
+	k_sem_give(&set_sem[1]);
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+					      K_NO_WAIT), 1, "");
+		zassert_equal(ready[0], &events[1], "");
+		zassert_equal(events[1].state, K_POLL_STATE_SEM_AVAILABLE, "");
+	}
+	zassert_equal(k_sem_take(&set_sem[1], K_NO_WAIT), 0, "");
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+
+	/* blocking wait */
+	k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack),
+			poll_set_put_helper, 0, 0, 0,
+			K_PRIO_PREEMPT(0), 0, 0);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_SECONDS(1)), 1, "");
+	zassert_equal(ready[0], &events[2], "");
+	zassert_equal(events[2].state, K_POLL_STATE_FIFO_DATA_AVAILABLE, "");
+	zassert_equal(k_fifo_get(&set_fifo, K_NO_WAIT), &set_msg, "");
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+
+	/* a getter blocked on the fifo still gets the data */
+	set_msg_rx = NULL;
+	k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack),
+			poll_set_get_helper, 0, 0, 0,
+			K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(50);
+	k_fifo_put(&set_fifo, &set_msg);
+	k_sleep(50);
+	zassert_equal(set_msg_rx, &set_msg, "");
+
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_set_remove(&set, &events[i]);
+	}
+
+	/* removed events are not reported anymore */
+	k_sem_give(&set_sem[0]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_poll_grant_access(void)
 {
 	k_thread_access_grant(k_current_get(), &no_wait_sem, &no_wait_fifo,
@@ -90,9 +90,136 @@ void test_deadline(void)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+#define PERIOD_MS 100
+#define BUDGET_MS 20
+
+volatile u32_t spins;
+
+void spinner(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		spins++;
+	}
+}
+
+void test_reservation_admission(void)
+{
+	zassert_equal(k_thread_reservation_set(&worker_threads[0], 0, 1),
+		      -EINVAL, "zero period accepted");
+	zassert_equal(k_thread_reservation_set(&worker_threads[0], 10, 20),
+		      -EINVAL, "budget larger than period accepted");
+
+	/* Two 60% reservations can't both fit */
+	zassert_equal(k_thread_reservation_set(&worker_threads[0],
+					       PERIOD_MS, 60), 0, "");
+	zassert_equal(k_thread_reservation_set(&worker_threads[1],
+					       PERIOD_MS, 60), -EBUSY,
+		      "overload admitted");
+
+	/* Shrinking an existing reservation frees room */
+	zassert_equal(k_thread_reservation_set(&worker_threads[0],
+					       PERIOD_MS, 20), 0, "");
+	zassert_equal(k_thread_reservation_set(&worker_threads[1],
+					       PERIOD_MS, 60), 0, "");
+
+	zassert_equal(k_thread_reservation_clear(&worker_threads[0]), 0, "");
+	zassert_equal(k_thread_reservation_clear(&worker_threads[1]), 0, "");
+	zassert_equal(k_thread_reservation_clear(&worker_threads[1]), -EINVAL,
+		      "cleared twice");
+}
+
+void test_reservation_throttle(void)
+{
+	struct k_thread_reservation_stats stats;
+	static struct k_thread spin_thread;
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+
+	/* A higher priority thread that never blocks would starve us
+	 * forever; with a 20% reservation we get the other 80%.
+	 */
+	k_thread_create(&spin_thread, worker_stacks[NUM_THREADS - 1],
+			STACK_SIZE, spinner, NULL, NULL, NULL,
+			prio, 0, K_FOREVER);
+	zassert_equal(k_thread_reservation_set(&spin_thread, PERIOD_MS,
+					       BUDGET_MS), 0, "");
+	k_thread_start(&spin_thread);
+
+	k_sleep(5 * PERIOD_MS + PERIOD_MS / 2);
+
+	zassert_true(spins > 0, "reserved thread never ran");
+	zassert_equal(k_thread_reservation_stats_get(&spin_thread, &stats),
+		      0, "");
+	zassert_true(stats.periods >= 4, "periods not accounted");
+
+	/* It never blocks, so every deadline is missed */
+	zassert_equal(stats.missed, stats.periods, "");
+	zassert_equal(stats.recent_missed, stats.recent_periods, "");
+
+	k_thread_abort(&spin_thread);
+}
+
+void test_reservation_suspend(void)
+{
+	static struct k_thread spin_thread;
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+	u32_t throttled_spins;
+
+	spins = 0U;
+	k_thread_create(&spin_thread, worker_stacks[NUM_THREADS - 1],
+			STACK_SIZE, spinner, NULL, NULL, NULL,
+			prio, 0, K_FOREVER);
+	zassert_equal(k_thread_reservation_set(&spin_thread, PERIOD_MS,
+					       BUDGET_MS), 0, "");
+	k_thread_start(&spin_thread);
+
+	/* We only get here once it is throttled */
+	throttled_spins = spins;
+	zassert_true(throttled_spins > 0, "reserved thread never ran");
+
+	/* Resuming doesn't lift the throttling */
+	k_thread_suspend(&spin_thread);
+	k_thread_resume(&spin_thread);
+	zassert_equal(spins, throttled_spins, "resume unthrottled the thread");
+
+	/* The end of the period doesn't lift the suspension */
+	k_thread_suspend(&spin_thread);
+	k_sleep(2 * PERIOD_MS);
+	zassert_equal(spins, throttled_spins, "period end resumed the thread");
+
+	k_thread_resume(&spin_thread);
+	k_sleep(2 * PERIOD_MS);
+	zassert_true(spins > throttled_spins, "thread did not run again");
+
+	k_thread_abort(&spin_thread);
+}
+#else
+void test_reservation_admission(void)
+{
+	ztest_test_skip();
+}
+
+void test_reservation_throttle(void)
+{
+	ztest_test_skip();
+}
+
+void test_reservation_suspend(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(suite_deadline,
-			 ztest_unit_test(test_deadline));
+			 ztest_unit_test(test_deadline),
+			 ztest_unit_test(test_reservation_admission),
+			 ztest_unit_test(test_reservation_throttle),
+			 ztest_unit_test(test_reservation_suspend));
 	ztest_run_test_suite(suite_deadline);
 }
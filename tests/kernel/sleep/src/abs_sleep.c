@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zephyr.h>
+
+#define PERIODS		10
+#define PERIOD_TICKS	(CONFIG_SYS_CLOCK_TICKS_PER_SEC / 10)
+
+/*
+ * Sleeping until deadlines a period apart must not drift, whatever is
+ * done between the sleeps: each wakeup happens on the tick of its
+ * deadline, so the loop ends exactly PERIODS periods after it started.
+ */
+void test_sleep_abs(void)
+{
+#ifdef CONFIG_TIMEOUT_ABSOLUTE
+	s64_t deadline = k_uptime_ticks();
+	s64_t start = deadline;
+	s64_t now;
+	int i;
+
+	for (i = 0; i < PERIODS; i++) {
+		/* Work taking a part of the period */
+		k_busy_wait(USEC_PER_SEC / CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+
+		deadline += PERIOD_TICKS;
+		k_sleep(K_TIMEOUT_ABS_TICKS(deadline));
+
+		now = k_uptime_ticks();
+		zassert_true(now >= deadline, "woke up %lld ticks early",
+			     deadline - now);
+		zassert_true(now <= deadline + 1, "woke up %lld ticks late",
+			     now - deadline);
+	}
+
+	zassert_true(now - start <= PERIODS * PERIOD_TICKS + 1,
+		     "drifted by %lld ticks",
+		     now - start - PERIODS * PERIOD_TICKS);
+
+	/* Passed deadlines do not wait */
+	zassert_equal(k_sleep(K_TIMEOUT_ABS_TICKS(start)), 0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -234,12 +234,14 @@ void test_sleep(void)
 }
 
 extern void test_usleep(void);
+extern void test_sleep_abs(void);
 
 /*test case main entry*/
 void test_main(void)
 {
 	ztest_test_suite(sleep,
 			 ztest_unit_test(test_sleep),
-			 ztest_unit_test(test_usleep));
+			 ztest_unit_test(test_usleep),
+			 ztest_unit_test(test_sleep_abs));
 	ztest_run_test_suite(sleep);
 }
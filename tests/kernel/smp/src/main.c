@@ -430,6 +430,73 @@ void test_wakeup_threads(void)
 	cleanup_resources();
 }
 
+#define BENCH_THREADS (2 * CONFIG_MP_NUM_CPUS)
+#define BENCH_MS 1000
+
+static struct k_thread bench_threads[BENCH_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, BENCH_THREADS, STACK_SIZE);
+static volatile u32_t bench_yields[BENCH_THREADS];
+static volatile u32_t bench_migrations[BENCH_THREADS];
+static volatile bool bench_stop;
+
+static void bench_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	int n = (int)p1;
+	int cpu = z_arch_curr_cpu()->id;
+
+	while (!bench_stop) {
+		k_yield();
+		bench_yields[n]++;
+
+		if (z_arch_curr_cpu()->id != cpu) {
+			cpu = z_arch_curr_cpu()->id;
+			bench_migrations[n]++;
+		}
+	}
+}
+
+/**
+ * @brief Measure scheduler throughput across all CPUs
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Spawn two equal priority preemptible threads per CPU that
+ * do nothing but k_yield(), so every iteration is a trip through the
+ * scheduler.  Report the aggregate context switch rate and how often
+ * threads migrated between CPUs, and check that every thread made
+ * progress (i.e. that idle CPUs pick up work).
+ */
+void test_sched_throughput(void)
+{
+	u32_t total = 0U, migrations = 0U;
+
+	bench_stop = false;
+	for (int i = 0; i < BENCH_THREADS; i++) {
+		bench_yields[i] = 0U;
+		bench_migrations[i] = 0U;
+		k_thread_create(&bench_threads[i], bench_stacks[i], STACK_SIZE,
+				bench_entry, (void *)i, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	k_sleep(BENCH_MS);
+	bench_stop = true;
+
+	for (int i = 0; i < BENCH_THREADS; i++) {
+		k_thread_abort(&bench_threads[i]);
+		zassert_true(bench_yields[i] > 0, "thread %d starved", i);
+		total += bench_yields[i];
+		migrations += bench_migrations[i];
+	}
+
+	TC_PRINT("%d threads on %d CPUs: %u yields/s, %u migrations (%s)\n",
+		 BENCH_THREADS, CONFIG_MP_NUM_CPUS, total * 1000U / BENCH_MS,
+		 migrations, IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ?
+		 "per-CPU runq" : "global runq");
+}
+
 void test_main(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -445,7 +512,8 @@ void test_main(void)
 			 ztest_unit_test(test_preempt_resched_threads),
 			 ztest_unit_test(test_yield_threads),
 			 ztest_unit_test(test_sleep_threads),
-			 ztest_unit_test(test_wakeup_threads)
+			 ztest_unit_test(test_wakeup_threads),
+			 ztest_unit_test(test_sched_throughput)
 			 );
 	ztest_run_test_suite(smp);
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+#include <spinlock.h>
+
+#define NUM_CONTENDERS	CONFIG_MP_NUM_CPUS
+#define NUM_ITERATIONS	10000
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(contender_stacks, NUM_CONTENDERS,
+				   STACK_SIZE);
+static struct k_thread contender_threads[NUM_CONTENDERS];
+static K_SEM_DEFINE(contender_done, 0, NUM_CONTENDERS);
+
+static struct k_spinlock contended_lock;
+static volatile u32_t contended_count;
+static u32_t contender_cycles[NUM_CONTENDERS];
+
+static void contender(void *p1, void *p2, void *p3)
+{
+	int id = (int)p1;
+	k_spinlock_key_t key;
+	u32_t start;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < NUM_ITERATIONS; i++) {
+		key = k_spin_lock(&contended_lock);
+		contended_count++;
+		k_spin_unlock(&contended_lock, key);
+	}
+	contender_cycles[id] = k_cycle_get_32() - start;
+
+	k_sem_give(&contender_done);
+}
+
+/**
+ * @brief Stress a spinlock from all CPUs at once
+ *
+ * @details One thread per CPU takes and releases the same lock in a
+ * tight loop around a counter increment.  The test checks that no
+ * increment was lost and prints the cycles per acquisition seen by each
+ * thread, plus the contention statistics of the lock when they are
+ * enabled, to compare the spinlock implementations.
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_lock(), k_spin_unlock()
+ */
+void test_spinlock_contention(void)
+{
+	int i;
+
+	if (NUM_CONTENDERS < 2) {
+		ztest_test_skip();
+		return;
+	}
+
+	for (i = 0; i < NUM_CONTENDERS; i++) {
+		k_thread_create(&contender_threads[i], contender_stacks[i],
+				STACK_SIZE, contender, (void *)i, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < NUM_CONTENDERS; i++) {
+		k_sem_take(&contender_done, K_FOREVER);
+	}
+
+	zassert_equal(contended_count, NUM_CONTENDERS * NUM_ITERATIONS,
+		      "lost updates under contention");
+
+	for (i = 0; i < NUM_CONTENDERS; i++) {
+		TC_PRINT("thread %d: %u cycles per lock/unlock\n", i,
+			 contender_cycles[i] / NUM_ITERATIONS);
+	}
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+	TC_PRINT("contended %u of %u, %u spins, max wait %u cycles\n",
+		 contended_lock.contended, NUM_CONTENDERS * NUM_ITERATIONS,
+		 contended_lock.spins, contended_lock.max_wait);
+#endif
+}
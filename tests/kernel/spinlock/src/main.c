@@ -35,6 +35,7 @@ volatile int bounce_owner, bounce_done;
  *
  * @see k_spin_lock(), k_spin_unlock()
  */
+#ifdef CONFIG_SPIN_LOCK_TAS
 void test_spinlock_basic(void)
 {
 	k_spinlock_key_t key;
@@ -50,6 +51,53 @@ void test_spinlock_basic(void)
 
 	zassert_true(!l.locked, "Spinlock failed to unlock");
 }
+#else
+void test_spinlock_basic(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+/**
+ * @brief Test the lock state with every spinlock implementation
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @details Two locks are held at once and released out of order, as
+ * the MCS locks queue each acquisition on a node of the locking CPU
+ * rather than of the lock.
+ *
+ * @see k_spin_lock(), k_spin_unlock()
+ */
+#ifdef CONFIG_SMP
+void test_spinlock_state(void)
+{
+	k_spinlock_key_t key1, key2;
+	static struct k_spinlock l1, l2;
+
+	zassert_true(!z_spin_is_locked(&l1), "Spinlock initialized to locked");
+
+	key1 = k_spin_lock(&l1);
+	zassert_true(z_spin_is_locked(&l1), "Spinlock failed to lock");
+
+	key2 = k_spin_lock(&l2);
+	zassert_true(z_spin_is_locked(&l2), "Nested spinlock failed to lock");
+
+	k_spin_unlock(&l1, key2);
+	zassert_true(!z_spin_is_locked(&l1), "Spinlock failed to unlock");
+	zassert_true(z_spin_is_locked(&l2), "Nested spinlock was unlocked");
+
+	k_spin_unlock(&l2, key1);
+	zassert_true(!z_spin_is_locked(&l2),
+		     "Nested spinlock failed to unlock");
+}
+#else
+void test_spinlock_state(void)
+{
+	/* Without SMP a spinlock only masks interrupts, it has no state */
+	ztest_test_skip();
+}
+#endif
 
 void bounce_once(int id)
 {
@@ -123,10 +171,14 @@ void test_spinlock_bounce(void)
 	bounce_done = 1;
 }
 
+extern void test_spinlock_contention(void);
+
 void test_main(void)
 {
 	ztest_test_suite(spinlock,
 			 ztest_unit_test(test_spinlock_basic),
+			 ztest_unit_test(test_spinlock_state),
+			 ztest_unit_test(test_spinlock_contention),
 			 ztest_unit_test(test_spinlock_bounce));
 	ztest_run_test_suite(spinlock);
 }
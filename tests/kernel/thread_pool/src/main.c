@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define POOL_SIZE 2
+#define STACK_SIZE 512
+#define TIMEOUT 50
+
+K_THREAD_POOL_DEFINE(pool, POOL_SIZE, STACK_SIZE);
+
+static K_SEM_DEFINE(go, 0, POOL_SIZE);
+static volatile int runs;
+
+static void entry(void *p1, void *p2, void *p3)
+{
+	runs += POINTER_TO_INT(p1);
+}
+
+/* runs until go is given */
+static void blocked_entry(void *p1, void *p2, void *p3)
+{
+	k_sem_take(&go, K_FOREVER);
+	runs++;
+}
+
+void test_pool_join(void)
+{
+	k_tid_t tid;
+	int i;
+
+	runs = 0;
+
+	/* more spawns than threads, as each is joined before the next */
+	for (i = 0; i < 4 * POOL_SIZE; i++) {
+		tid = k_thread_pool_spawn(&pool, entry, INT_TO_POINTER(1),
+					  NULL, NULL, K_PRIO_PREEMPT(1),
+					  K_NO_WAIT);
+		zassert_not_null(tid, "No idle thread");
+		zassert_equal(k_thread_pool_join(&pool, tid, K_FOREVER), 0,
+			      NULL);
+		zassert_equal(k_thread_pool_join(&pool, tid, K_NO_WAIT),
+			      -EINVAL, "Joined twice");
+	}
+
+	zassert_equal(runs, 4 * POOL_SIZE, "Entry points not run");
+}
+
+void test_pool_exhausted(void)
+{
+	struct k_thread_pool_stats stats;
+	k_tid_t tid[POOL_SIZE];
+	int i;
+
+	runs = 0;
+
+	for (i = 0; i < POOL_SIZE; i++) {
+		tid[i] = k_thread_pool_spawn(&pool, blocked_entry, NULL, NULL,
+					     NULL, K_PRIO_PREEMPT(1),
+					     K_NO_WAIT);
+		zassert_not_null(tid[i], "No idle thread");
+	}
+
+	zassert_is_null(k_thread_pool_spawn(&pool, entry, NULL, NULL, NULL,
+					    K_PRIO_PREEMPT(1), TIMEOUT),
+			"Spawned more threads than the pool has");
+	zassert_equal(k_thread_pool_join(&pool, tid[0], TIMEOUT), -EAGAIN,
+		      "Joined a running thread");
+
+	k_thread_pool_stats_get(&pool, &stats);
+	zassert_equal(stats.busy, POOL_SIZE, NULL);
+	zassert_equal(stats.max_busy, POOL_SIZE, NULL);
+	zassert_equal(stats.exhausted, 1, NULL);
+
+	for (i = 0; i < POOL_SIZE; i++) {
+		k_sem_give(&go);
+		zassert_equal(k_thread_pool_join(&pool, tid[i], K_FOREVER), 0,
+			      NULL);
+	}
+
+	zassert_equal(runs, POOL_SIZE, "Entry points not run");
+}
+
+void test_pool_detach(void)
+{
+	struct k_thread_pool_stats stats;
+	k_tid_t tid;
+
+	runs = 0;
+
+	/* detached while running, released by itself */
+	tid = k_thread_pool_spawn(&pool, blocked_entry, NULL, NULL, NULL,
+				  K_PRIO_PREEMPT(1), K_NO_WAIT);
+	zassert_not_null(tid, "No idle thread");
+	zassert_equal(k_thread_pool_detach(&pool, tid), 0, NULL);
+	zassert_equal(k_thread_pool_detach(&pool, tid), -EINVAL,
+		      "Detached twice");
+	zassert_equal(k_thread_pool_join(&pool, tid, K_NO_WAIT), -EINVAL,
+		      "Joined a detached thread");
+	k_sem_give(&go);
+	k_sleep(TIMEOUT);
+
+	/* detached once done, released at once */
+	tid = k_thread_pool_spawn(&pool, entry, INT_TO_POINTER(1), NULL, NULL,
+				  K_PRIO_PREEMPT(1), K_NO_WAIT);
+	zassert_not_null(tid, "No idle thread");
+	k_sleep(TIMEOUT);
+	zassert_equal(k_thread_pool_detach(&pool, tid), 0, NULL);
+
+	k_thread_pool_stats_get(&pool, &stats);
+	zassert_equal(stats.busy, 0, "Detached threads not released");
+	zassert_equal(runs, 2, "Entry points not run");
+}
+
+void test_main(void)
+{
+	k_thread_pool_start(&pool, K_PRIO_PREEMPT(1));
+
+	ztest_test_suite(thread_pool,
+			 ztest_unit_test(test_pool_join),
+			 ztest_unit_test(test_pool_exhausted),
+			 ztest_unit_test(test_pool_detach));
+	ztest_run_test_suite(thread_pool);
+}
@@ -529,6 +529,53 @@ void test_timer_remaining_get(void)
 	zassert_true(remaining <= (DURATION / 2) + __ticks_to_ms(1), NULL);
 }
 
+static struct k_timer slack_timer;
+static struct k_timer strict_timer;
+static s64_t slack_stamp, strict_stamp;
+
+static void slack_expire(struct k_timer *timer)
+{
+	*(s64_t *)k_timer_user_data_get(timer) = k_uptime_get();
+}
+
+/**
+ * @brief Test batching of timer expiries with slack
+ *
+ * Starts a timer allowed to expire late and, a bit later, a timer
+ * which must be on time.  The first expiry can be deferred to the
+ * second one, so both must run in the same tick and the kernel must
+ * report the avoided timer interrupt.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_slack(), k_timeout_slack_wakeups_avoided()
+ */
+void test_timer_slack(void)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	u32_t avoided = k_timeout_slack_wakeups_avoided();
+
+	k_timer_init(&slack_timer, slack_expire, NULL);
+	k_timer_init(&strict_timer, slack_expire, NULL);
+	k_timer_user_data_set(&slack_timer, &slack_stamp);
+	k_timer_user_data_set(&strict_timer, &strict_stamp);
+
+	/* Align to a tick so both timeouts are added in the same one */
+	k_sleep(1);
+	k_timer_start_slack(&slack_timer, DURATION, 0, DURATION);
+	k_timer_start(&strict_timer, DURATION + DURATION / 2, 0);
+
+	zassert_equal(k_timer_status_sync(&strict_timer), 1, NULL);
+	zassert_equal(k_timer_status_get(&slack_timer), 1, NULL);
+
+	zassert_true(slack_stamp == strict_stamp,
+		     "slack expiry was not batched");
+	zassert_true(k_timeout_slack_wakeups_avoided() > avoided, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -561,6 +608,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_status_sync),
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
-			 ztest_user_unit_test(test_timer_remaining_get));
+			 ztest_user_unit_test(test_timer_remaining_get),
+			 ztest_unit_test(test_timer_slack));
 	ztest_run_test_suite(timer_api);
 }
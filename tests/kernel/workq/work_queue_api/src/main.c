@@ -503,6 +503,54 @@ void test_delayed_work_cancel_isr(void)
 	}
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+K_WORK_POOL_DEFINE(workpool, 2, STACK_SIZE);
+static struct k_work pool_work_slow, pool_work_fast;
+static struct k_sem pool_fast_sema;
+
+static void pool_fast_handler(struct k_work *w)
+{
+	k_sem_give(&pool_fast_sema);
+}
+#endif
+
+/**
+ * @brief Test that a long item does not stall a workqueue pool
+ *
+ * Submits an item sleeping for TIMEOUT, then a short one, to a pool with
+ * two workers: the short item must be run by the idle worker without
+ * waiting for the first one to complete.
+ *
+ * @ingroup kernel_workqueue_tests
+ *
+ * @see k_work_pool_start(), k_work_pool_submit()
+ */
+void test_work_pool_long_item(void)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	static bool started;
+
+	if (!started) {
+		k_work_pool_start(&workpool, k_thread_priority_get(
+					  k_current_get()), 0);
+		started = true;
+	}
+
+	k_sem_reset(&sync_sema);
+	k_sem_init(&pool_fast_sema, 0, 1);
+	k_work_init(&pool_work_slow, work_sleepy);
+	k_work_init(&pool_work_fast, pool_fast_handler);
+
+	k_work_pool_submit(&workpool, &pool_work_slow);
+	k_work_pool_submit(&workpool, &pool_work_fast);
+
+	zassert_equal(k_sem_take(&pool_fast_sema, TIMEOUT / 2), 0,
+		      "short item waited for the long one");
+	zassert_equal(k_sem_take(&sync_sema, 2 * TIMEOUT), 0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
 
 void test_main(void)
 {
@@ -535,6 +583,7 @@ void test_main(void)
 			 ztest_unit_test(test_delayed_work_cancel_from_queue_thread),
 			 ztest_unit_test(test_delayed_work_cancel_from_queue_isr),
 			 ztest_unit_test(test_delayed_work_cancel_thread),
-			 ztest_unit_test(test_delayed_work_cancel_isr));
+			 ztest_unit_test(test_delayed_work_cancel_isr),
+			 ztest_unit_test(test_work_pool_long_item));
 	ztest_run_test_suite(workqueue_api);
 }
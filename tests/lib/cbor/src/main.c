@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <ztest.h>
+#include <cbor_codec.h>
+
+struct test_nested {
+	s32_t nested_int;
+	bool nested_bool;
+	struct cbor_str nested_str;
+};
+
+struct test_struct {
+	struct cbor_str some_string;
+	s32_t some_int;
+	s64_t some_int64;
+	u32_t some_uint;
+	double some_double;
+	bool some_bool;
+	struct test_nested some_nested;
+	s32_t some_array[8];
+	size_t some_array_len;
+	struct cbor_str some_bytes;
+	s32_t labelled;
+	struct test_nested nested_obj_array[2];
+	size_t obj_array_len;
+};
+
+static const struct cbor_obj_descr nested_descr[] = {
+	CBOR_OBJ_DESCR_PRIM(struct test_nested, nested_int, CBOR_TYPE_INT),
+	CBOR_OBJ_DESCR_PRIM(struct test_nested, nested_bool, CBOR_TYPE_BOOL),
+	CBOR_OBJ_DESCR_PRIM(struct test_nested, nested_str, CBOR_TYPE_TSTR),
+};
+
+static const struct cbor_obj_descr test_descr[] = {
+	CBOR_OBJ_DESCR_PRIM(struct test_struct, some_string, CBOR_TYPE_TSTR),
+	CBOR_OBJ_DESCR_PRIM(struct test_struct, some_int, CBOR_TYPE_INT),
+	CBOR_OBJ_DESCR_PRIM(struct test_struct, some_int64, CBOR_TYPE_INT64),
+	CBOR_OBJ_DESCR_PRIM(struct test_struct, some_uint, CBOR_TYPE_UINT),
+	CBOR_OBJ_DESCR_PRIM(struct test_struct, some_double, CBOR_TYPE_DOUBLE),
+	CBOR_OBJ_DESCR_PRIM(struct test_struct, some_bool, CBOR_TYPE_BOOL),
+	CBOR_OBJ_DESCR_OBJECT(struct test_struct, some_nested, nested_descr),
+	CBOR_OBJ_DESCR_ARRAY(struct test_struct, some_array, 8,
+			     some_array_len, CBOR_TYPE_INT),
+	CBOR_OBJ_DESCR_PRIM_NAMED(struct test_struct, "bytes", some_bytes,
+				  CBOR_TYPE_BSTR),
+	CBOR_OBJ_DESCR_PRIM_LABEL(struct test_struct, -3, labelled,
+				  CBOR_TYPE_INT),
+	CBOR_OBJ_DESCR_OBJ_ARRAY(struct test_struct, nested_obj_array, 2,
+				 obj_array_len, nested_descr,
+				 ARRAY_SIZE(nested_descr)),
+};
+
+static void check_encoding(const u8_t *expected, size_t len,
+			   const u8_t *buf, const struct cbor_writer *writer)
+{
+	zassert_equal(writer->err, 0, "Encoding failed");
+	zassert_equal(writer->len, len, "Encoded length differs");
+	zassert_true(!memcmp(buf, expected, len), "Encoding differs");
+}
+
+static void test_cbor_encoding(void)
+{
+	/* examples of RFC 7049 appendix A */
+	static const u8_t expected[] = {
+		0x00, 0x17, 0x18, 0x18, 0x19, 0x03, 0xe8,
+		0x1a, 0x00, 0x0f, 0x42, 0x40,
+		0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00,
+		0x20, 0x38, 0x63,
+		0x3b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0x40, 0x44, 0x01, 0x02, 0x03, 0x04,
+		0x64, 'I', 'E', 'T', 'F',
+		0xf4, 0xf5, 0xf6,
+		0xfa, 0x47, 0xc3, 0x50, 0x00,
+		0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a,
+		0x83, 0x01, 0x02, 0x03,
+		0x9f, 0xbf, 0x61, 'a', 0x01, 0xff, 0xff,
+	};
+	static const u8_t bytes[] = { 1, 2, 3, 4 };
+	struct cbor_writer writer;
+	u8_t buf[128];
+
+	cbor_writer_init_buf(&writer, buf, sizeof(buf));
+
+	cbor_write_uint(&writer, 0);
+	cbor_write_uint(&writer, 23);
+	cbor_write_uint(&writer, 24);
+	cbor_write_uint(&writer, 1000);
+	cbor_write_uint(&writer, 1000000);
+	cbor_write_uint(&writer, 1000000000000ULL);
+	cbor_write_int(&writer, -1);
+	cbor_write_int(&writer, -100);
+	cbor_write_int(&writer, INT64_MIN);
+	cbor_write_bstr(&writer, NULL, 0);
+	cbor_write_bstr(&writer, bytes, sizeof(bytes));
+	cbor_write_tstr(&writer, "IETF", 4);
+	cbor_write_bool(&writer, false);
+	cbor_write_bool(&writer, true);
+	cbor_write_null(&writer);
+	cbor_write_double(&writer, 100000.0);
+	cbor_write_double(&writer, 1.1);
+	cbor_write_array_start(&writer, 3);
+	cbor_write_uint(&writer, 1);
+	cbor_write_uint(&writer, 2);
+	cbor_write_uint(&writer, 3);
+	cbor_write_array_start(&writer, CBOR_INDEFINITE);
+	cbor_write_map_start(&writer, CBOR_INDEFINITE);
+	cbor_write_tstr(&writer, "a", 1);
+	cbor_write_uint(&writer, 1);
+	cbor_write_break(&writer);
+	cbor_write_break(&writer);
+
+	check_encoding(expected, sizeof(expected), buf, &writer);
+}
+
+static void test_cbor_encoding_overflow(void)
+{
+	struct cbor_writer writer;
+	u8_t buf[4];
+	int ret;
+
+	cbor_writer_init_buf(&writer, buf, sizeof(buf));
+
+	ret = cbor_write_uint(&writer, 1000);
+	zassert_equal(ret, 0, "Head fits");
+
+	ret = cbor_write_tstr(&writer, "IETF", 4);
+	zassert_equal(ret, -ENOMEM, "Overflow detected");
+
+	ret = cbor_write_null(&writer);
+	zassert_equal(ret, -ENOMEM, "Error is latched");
+	/* the string head fitted, not the string */
+	zassert_equal(writer.len, 4, "Nothing written after the error");
+}
+
+static void test_cbor_decoding(void)
+{
+	static const u8_t data[] = {
+		0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00,
+		0x38, 0x63,
+		0x44, 0x01, 0x02, 0x03, 0x04,
+		0x64, 'I', 'E', 'T', 'F',
+		0xf5,
+		0xf9, 0x3c, 0x00,
+		0xf9, 0xc4, 0x00,
+		0xfa, 0x47, 0xc3, 0x50, 0x00,
+		0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a,
+		0x18, 0x64,
+		0x9f, 0x01, 0xff,
+		0xa1, 0x61, 'a', 0x01,
+		0xf6,
+	};
+	struct cbor_reader reader;
+	struct cbor_str str;
+	size_t count;
+	u64_t uvalue;
+	s64_t value;
+	double d;
+	bool b;
+
+	cbor_reader_init(&reader, data, sizeof(data));
+
+	zassert_equal(cbor_read_uint(&reader, &uvalue), 0, "uint read");
+	zassert_equal(uvalue, 1000000000000ULL, "uint value");
+	zassert_equal(cbor_read_uint(&reader, &uvalue), -EINVAL,
+		      "Negative integer is not an uint");
+	zassert_equal(cbor_read_int(&reader, &value), 0, "Failed read kept");
+	zassert_equal(value, -100, "int value");
+
+	zassert_equal(cbor_read_tstr(&reader, &str), -EINVAL,
+		      "Bytes are not text");
+	zassert_equal(cbor_read_bstr(&reader, &str), 0, "bstr read");
+	zassert_equal(str.len, 4, "bstr length");
+	zassert_equal(str.data, &data[12], "bstr read in place");
+
+	zassert_equal(cbor_read_tstr(&reader, &str), 0, "tstr read");
+	zassert_true(str.len == 4 && !memcmp(str.data, "IETF", 4),
+		     "tstr value");
+
+	zassert_equal(cbor_read_bool(&reader, &b), 0, "bool read");
+	zassert_true(b, "bool value");
+
+	zassert_equal(cbor_read_double(&reader, &d), 0, "half read");
+	zassert_true(d == 1.0, "half value");
+	zassert_equal(cbor_read_double(&reader, &d), 0, "half read");
+	zassert_true(d == -4.0, "half value");
+	zassert_equal(cbor_read_double(&reader, &d), 0, "float read");
+	zassert_true(d == 100000.0, "float value");
+	zassert_equal(cbor_read_double(&reader, &d), 0, "double read");
+	zassert_true(d == 1.1, "double value");
+	zassert_equal(cbor_read_double(&reader, &d), 0, "int as double");
+	zassert_true(d == 100.0, "int as double value");
+
+	zassert_equal(cbor_read_array_start(&reader, &count), 0, "array");
+	zassert_equal(count, CBOR_INDEFINITE, "Indefinite array");
+	zassert_false(cbor_read_break(&reader), "Array has an item");
+	zassert_equal(cbor_read_uint(&reader, &uvalue), 0, "array item");
+	zassert_true(cbor_read_break(&reader), "Array ends");
+
+	zassert_equal(cbor_read_map_start(&reader, &count), 0, "map");
+	zassert_equal(count, 1, "Map of one pair");
+	zassert_equal(cbor_skip(&reader), 0, "Key skipped");
+	zassert_equal(cbor_skip(&reader), 0, "Value skipped");
+
+	zassert_equal(cbor_read_null(&reader), 0, "null read");
+	zassert_equal(cbor_peek(&reader), -ENODATA, "End of data");
+}
+
+static void test_cbor_skip(void)
+{
+	static const u8_t nested[] = {
+		/* [1, {"a": [h'00', [_ "b"]]}, 0(2)], 7 */
+		0x83, 0x01, 0xa1, 0x61, 'a', 0x82, 0x41, 0x00,
+		0x9f, 0x61, 'b', 0xff, 0xc0, 0x02, 0x07,
+	};
+	static u8_t deep[2 * CONFIG_CBOR_MAX_DEPTH + 2];
+	struct cbor_reader reader;
+	u64_t value;
+	int i;
+
+	cbor_reader_init(&reader, nested, sizeof(nested));
+	zassert_equal(cbor_skip(&reader), 0, "Nested item skipped");
+	zassert_equal(cbor_read_uint(&reader, &value), 0, "Next item read");
+	zassert_equal(value, 7, "Skipped to the next item");
+
+	/* truncated */
+	cbor_reader_init(&reader, nested, sizeof(nested) - 2);
+	zassert_equal(cbor_skip(&reader), -EINVAL, "Truncated item");
+
+	for (i = 0; i <= CONFIG_CBOR_MAX_DEPTH; i++) {
+		deep[i] = 0x81;
+	}
+
+	cbor_reader_init(&reader, deep, sizeof(deep));
+	zassert_equal(cbor_skip(&reader), -E2BIG, "Nesting limited");
+}
+
+static void test_cbor_obj_encoding(void)
+{
+	struct test_struct ts = {
+		.some_string = { (const u8_t *)"zephyr", 6 },
+		.some_int = -42,
+		.some_int64 = 1LL << 40,
+		.some_uint = 4000000000U,
+		.some_double = 0.5,
+		.some_bool = true,
+		.some_nested = {
+			.nested_int = 1,
+			.nested_str = { (const u8_t *)"x", 1 },
+		},
+		.some_array = { 1, -1, 1000 },
+		.some_array_len = 3,
+		.some_bytes = { (const u8_t *)"\x01\x02", 2 },
+		.labelled = 5,
+		.nested_obj_array = { { .nested_int = 7 } },
+		.obj_array_len = 1,
+	};
+	struct test_struct decoded;
+	struct cbor_reader reader;
+	struct cbor_writer writer;
+	u8_t buf[256];
+	int ret;
+
+	cbor_writer_init_buf(&writer, buf, sizeof(buf));
+	ret = cbor_obj_encode(&writer, test_descr, ARRAY_SIZE(test_descr),
+			      &ts);
+	zassert_equal(ret, 0, "Encoding succeeded");
+	zassert_equal(buf[0], 0xa0 | ARRAY_SIZE(test_descr),
+		      "Map of all fields");
+
+	memset(&decoded, 0, sizeof(decoded));
+	cbor_reader_init(&reader, buf, writer.len);
+	ret = cbor_obj_decode(&reader, test_descr, ARRAY_SIZE(test_descr),
+			      &decoded);
+	zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+		      "All fields decoded");
+
+	zassert_true(decoded.some_string.len == 6 &&
+		     !memcmp(decoded.some_string.data, "zephyr", 6),
+		     "String decoded");
+	zassert_equal(decoded.some_int, -42, "int decoded");
+	zassert_equal(decoded.some_int64, 1LL << 40, "int64 decoded");
+	zassert_equal(decoded.some_uint, 4000000000U, "uint decoded");
+	zassert_true(decoded.some_double == 0.5, "double decoded");
+	zassert_true(decoded.some_bool, "bool decoded");
+	zassert_equal(decoded.some_nested.nested_int, 1, "Nested decoded");
+	zassert_false(decoded.some_nested.nested_bool, "Nested decoded");
+	zassert_equal(decoded.some_array_len, 3, "Array length decoded");
+	zassert_equal(decoded.some_array[2], 1000, "Array decoded");
+	zassert_true(decoded.some_bytes.len == 2 &&
+		     !memcmp(decoded.some_bytes.data, "\x01\x02", 2),
+		     "Bytes decoded");
+	zassert_equal(decoded.labelled, 5, "Labelled field decoded");
+	zassert_equal(decoded.obj_array_len, 1, "Object array decoded");
+	zassert_equal(decoded.nested_obj_array[0].nested_int, 7,
+		      "Object array element decoded");
+}
+
+static void test_cbor_obj_decoding_errors(void)
+{
+	/* {"some_int": 1, "unknown": [1, 2], -3: 2} */
+	static const u8_t partial[] = {
+		0xa3, 0x68, 's', 'o', 'm', 'e', '_', 'i', 'n', 't', 0x01,
+		0x67, 'u', 'n', 'k', 'n', 'o', 'w', 'n', 0x82, 0x01, 0x02,
+		0x22, 0x02,
+	};
+	/* {"some_int": "1"} */
+	static const u8_t wrong_type[] = {
+		0xa1, 0x68, 's', 'o', 'm', 'e', '_', 'i', 'n', 't', 0x61, '1',
+	};
+	/* {"some_int": 2^32} */
+	static const u8_t out_of_range[] = {
+		0xa1, 0x68, 's', 'o', 'm', 'e', '_', 'i', 'n', 't',
+		0x1b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+	};
+	/* {"some_array": [0, 0, 0, 0, 0, 0, 0, 0, 0]} */
+	static const u8_t too_long[] = {
+		0xa1, 0x6a, 's', 'o', 'm', 'e', '_', 'a', 'r', 'r', 'a', 'y',
+		0x89, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	};
+	struct test_struct ts;
+	struct cbor_reader reader;
+	int ret;
+
+	cbor_reader_init(&reader, partial, sizeof(partial));
+	ret = cbor_obj_decode(&reader, test_descr, ARRAY_SIZE(test_descr),
+			      &ts);
+	zassert_equal(ret, BIT(1) | BIT(9), "Unknown key skipped");
+	zassert_equal(ts.some_int, 1, "Field decoded");
+	zassert_equal(ts.labelled, 2, "Labelled field decoded");
+
+	cbor_reader_init(&reader, wrong_type, sizeof(wrong_type));
+	ret = cbor_obj_decode(&reader, test_descr, ARRAY_SIZE(test_descr),
+			      &ts);
+	zassert_equal(ret, -EINVAL, "Wrong type detected");
+
+	cbor_reader_init(&reader, out_of_range, sizeof(out_of_range));
+	ret = cbor_obj_decode(&reader, test_descr, ARRAY_SIZE(test_descr),
+			      &ts);
+	zassert_equal(ret, -ERANGE, "Out of range detected");
+
+	cbor_reader_init(&reader, too_long, sizeof(too_long));
+	ret = cbor_obj_decode(&reader, test_descr, ARRAY_SIZE(test_descr),
+			      &ts);
+	zassert_equal(ret, -ENOSPC, "Array overflow detected");
+
+	cbor_reader_init(&reader, partial, sizeof(partial) - 1);
+	ret = cbor_obj_decode(&reader, test_descr, ARRAY_SIZE(test_descr),
+			      &ts);
+	zassert_true(ret < 0, "Truncated map detected");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lib_cbor_test,
+			 ztest_unit_test(test_cbor_encoding),
+			 ztest_unit_test(test_cbor_encoding_overflow),
+			 ztest_unit_test(test_cbor_decoding),
+			 ztest_unit_test(test_cbor_skip),
+			 ztest_unit_test(test_cbor_obj_encoding),
+			 ztest_unit_test(test_cbor_obj_decoding_errors)
+			 );
+
+	ztest_run_test_suite(lib_cbor_test);
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <misc/cbprintf.h>
+
+struct out_buf {
+	char buf[128];
+	size_t len;
+};
+
+static struct out_buf out;
+
+static int buf_out(int c, void *ctx)
+{
+	struct out_buf *ob = ctx;
+
+	if (ob->len < sizeof(ob->buf) - 1) {
+		ob->buf[ob->len++] = c;
+		ob->buf[ob->len] = '\0';
+	}
+
+	return c;
+}
+
+static void reset(void)
+{
+	out.len = 0;
+	out.buf[0] = '\0';
+}
+
+#define CHECK(expected, fmt, ...) do {					\
+		reset();						\
+		zassert_equal(cbprintf(buf_out, &out, fmt, ##__VA_ARGS__), \
+			      strlen(expected), "Wrong count for " fmt); \
+		zassert_true(strcmp(out.buf, expected) == 0,		\
+			     "'%s' instead of '%s'", out.buf, expected); \
+	} while (false)
+
+void test_cbprintf_conversions(void)
+{
+	/* same output as printk has always had */
+	CHECK("22 113 10000 32768 40000 22", "%zu %hhu %hu %u %lu %llu",
+	      (size_t)22, (unsigned char)'q', (unsigned short)10000,
+	      32768U, 40000UL, 22ULL);
+	CHECK("p 112 -10000 -32768 -40000 -22", "%c %hhd %hd %d %ld %lld",
+	      'p', 'p', (short)-10000, -32768, -40000L, -22LL);
+	CHECK("0xcafebabe 0x0000beef", "0x%x %p", 0xCAFEBABE,
+	      (void *)0xBEEF);
+	CHECK("0x1 0x01 0x0001 0x00000001 0x0000000000000001",
+	      "0x%x 0x%02x 0x%04x 0x%08x 0x%016x", 1, 1, 1, 1, 1);
+	CHECK("0x1 0x 1 0x   1 0x       1", "0x%x 0x%2x 0x%4x 0x%8x",
+	      1, 1, 1, 1);
+	CHECK("42 42 0042 00000042", "%d %02d %04d %08d", 42, 42, 42, 42);
+	CHECK("-42 -42 -042 -0000042", "%d %02d %04d %08d",
+	      -42, -42, -42, -42);
+	CHECK("42 42   42       42", "%u %2u %4u %8u", 42, 42, 42, 42);
+	CHECK("255     42    abcdef  0x0000002a      42",
+	      "%-8u%-6d%-4x%-2p%8d", 0xFF, 42, 0xABCDEF, (char *)42, 42);
+	CHECK("ERR -1 ERR ffffffffffffffff", "%lld %lld %llu %llx",
+	      0xFFFFFFFFFULL, -1LL, -1ULL, -1ULL);
+	CHECK("-2147483648 4294967295", "%d %u", INT32_MIN, UINT32_MAX);
+	CHECK("[ab  ] 100% %q", "[%-4s] 100%% %q", "ab");
+	CHECK("end", "end%");
+}
+
+static void check_package(const char *expected, const void *package)
+{
+	reset();
+	zassert_equal(cbpprintf(buf_out, &out, package), strlen(expected),
+		      "Wrong count");
+	zassert_true(strcmp(out.buf, expected) == 0,
+		     "'%s' instead of '%s'", out.buf, expected);
+}
+
+void test_cbprintf_static_package(void)
+{
+	static const char str[] = "str";
+	u8_t package[64];
+	char c = 'c';
+	short sh = -3;
+	long long ll = 0x123456789aLL;
+	int len;
+
+	BUILD_ASSERT(Z_CBPRINTF_ARG_COUNT("%d %s", 1, str) == 2);
+	BUILD_ASSERT(Z_CBPRINTF_STR_ARG_COUNT("%d %s", 1, str) == 1);
+	BUILD_ASSERT(Z_CBPRINTF_STR_ARG_COUNT("%p", (void *)str) == 0);
+	BUILD_ASSERT(CBPRINTF_STATIC_PACKAGE_SIZE("%c%hd", c, sh) ==
+		     sizeof(char *) + 2 * sizeof(int));
+	BUILD_ASSERT(CBPRINTF_STATIC_PACKAGE_SIZE("none") == sizeof(char *));
+
+	CBPRINTF_STATIC_PACKAGE(NULL, 0, len, "%c %hd %llx %s %p",
+				c, sh, ll, str, &c);
+	zassert_equal(len, sizeof(char *) + 2 * sizeof(int) +
+		      sizeof(long long) + 2 * sizeof(void *), "Wrong size");
+
+	CBPRINTF_STATIC_PACKAGE(package, sizeof(char *), len, "%c", c);
+	zassert_equal(len, -ENOSPC, "Package overflow");
+
+	CBPRINTF_STATIC_PACKAGE(package, sizeof(package), len,
+				"%c %hd %llx %s", c, sh, ll, str);
+	zassert_true(len > 0, "Packaging failed");
+
+	/* the package does not depend on the variables anymore */
+	c = 'x';
+	sh = 0;
+	check_package("c -3 123456789a str", package);
+
+	CBPRINTF_STATIC_PACKAGE(package, sizeof(package), len, "no args");
+	zassert_equal(len, sizeof(char *), "Wrong size");
+	check_package("no args", package);
+}
+
+static int runtime_package(void *package, size_t len, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = cbvprintf_package(package, len, fmt, ap);
+	va_end(ap);
+
+	return ret;
+}
+
+void test_cbprintf_runtime_package(void)
+{
+	u8_t package[64];
+	int len;
+
+	len = runtime_package(NULL, 0, "%d %lx %s %p %%", -1, 0xabcL, "s",
+			      (void *)1);
+	zassert_equal(len, sizeof(char *) + sizeof(int) + sizeof(long) +
+		      2 * sizeof(void *), "Wrong size");
+	zassert_equal(runtime_package(package, len - 1, "%d %lx %s %p %%",
+				      -1, 0xabcL, "s", (void *)1),
+		      -ENOSPC, "Package overflow");
+	zassert_equal(runtime_package(package, sizeof(package),
+				      "%d %lx %s %p %%", -1, 0xabcL, "s",
+				      (void *)1),
+		      len, "Packaging failed");
+	check_package("-1 abc s 0x00000001 %", package);
+}
+
+void test_cbprintf_words(void)
+{
+	u32_t args[] = { 0xffffffff, 10, 0x1234 };
+
+	reset();
+	z_cbprintf_words(buf_out, &out, "%d %u %x %d", args,
+			 ARRAY_SIZE(args));
+	zassert_true(strcmp(out.buf, "-1 10 1234 0") == 0,
+		     "'%s' from words", out.buf);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(cbprintf,
+			 ztest_unit_test(test_cbprintf_conversions),
+			 ztest_unit_test(test_cbprintf_static_package),
+			 ztest_unit_test(test_cbprintf_runtime_package),
+			 ztest_unit_test(test_cbprintf_words));
+	ztest_run_test_suite(cbprintf);
+}
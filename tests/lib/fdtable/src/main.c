@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <errno.h>
+#include <misc/fdtable.h>
+
+static const struct fd_op_vtable vtable;
+static int obj_a, obj_b;
+
+void test_fdtable_lowest_fd(void)
+{
+	int fd1, fd2, fd3;
+
+	fd1 = z_alloc_fd(&obj_a, &vtable);
+	fd2 = z_alloc_fd(&obj_b, &vtable);
+	zassert_true(fd1 >= 0 && fd2 >= 0, "Allocation failed");
+	zassert_not_equal(fd1, fd2, "Same fd allocated twice");
+
+	zassert_equal(z_get_fd_obj(fd1, &vtable, EINVAL), &obj_a, NULL);
+	zassert_equal(z_get_fd_obj(fd2, &vtable, EINVAL), &obj_b, NULL);
+
+	/* the lowest free fd is given out first */
+	z_free_fd(fd1);
+	zassert_is_null(z_get_fd_obj(fd1, NULL, 0), "Freed fd found");
+	zassert_equal(errno, EBADF, NULL);
+
+	fd3 = z_alloc_fd(&obj_b, &vtable);
+	zassert_equal(fd3, fd1, "Lowest fd not reused");
+
+	z_free_fd(fd2);
+	z_free_fd(fd3);
+}
+
+void test_fdtable_reserved(void)
+{
+	int fd = z_reserve_fd();
+
+	zassert_true(fd >= 0, "Reservation failed");
+
+	/* not usable before being finalized */
+	zassert_is_null(z_get_fd_obj(fd, NULL, 0), "Reserved fd found");
+
+	z_free_fd(fd);
+	zassert_equal(z_reserve_fd(), fd, "Reserved fd not freed");
+	z_free_fd(fd);
+}
+
+void test_fdtable_ref(void)
+{
+	const struct fd_op_vtable *vt;
+	int fd, fd2;
+
+	fd = z_alloc_fd(&obj_a, &vtable);
+	zassert_equal(z_get_fd_obj_ref(fd, &vt), &obj_a, "No reference");
+	zassert_equal(vt, &vtable, "Wrong vtable");
+
+	/* closed while referenced: unusable, but the number stays taken */
+	z_free_fd(fd);
+	zassert_is_null(z_get_fd_obj_ref(fd, &vt), "Closed fd referenced");
+	zassert_is_null(z_get_fd_obj(fd, NULL, 0), "Closed fd found");
+
+	fd2 = z_alloc_fd(&obj_b, &vtable);
+	zassert_not_equal(fd2, fd, "Referenced fd reused");
+
+	/* dropping the last reference frees the number */
+	z_put_fd_obj(fd);
+	zassert_equal(z_alloc_fd(&obj_a, &vtable), fd, "fd not freed");
+
+	z_free_fd(fd);
+	z_free_fd(fd2);
+}
+
+void test_fdtable_bad_fd(void)
+{
+	const struct fd_op_vtable *vt;
+
+	zassert_is_null(z_get_fd_obj(-1, NULL, 0), NULL);
+	zassert_equal(errno, EBADF, NULL);
+	zassert_is_null(z_get_fd_obj_ref(CONFIG_POSIX_MAX_FDS, &vt), NULL);
+	zassert_equal(errno, EBADF, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(fdtable,
+			 ztest_unit_test(test_fdtable_lowest_fd),
+			 ztest_unit_test(test_fdtable_reserved),
+			 ztest_unit_test(test_fdtable_ref),
+			 ztest_unit_test(test_fdtable_bad_fd));
+	ztest_run_test_suite(fdtable);
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <misc/hashmap.h>
+#include <misc/lru.h>
+
+#define CAPACITY 64
+#define MAX_NODES (CAPACITY - 1)
+
+struct entry {
+	u32_t key;
+	struct sys_hashmap_node node;
+};
+
+struct cached {
+	u32_t key;
+	struct sys_lru_node node;
+};
+
+static struct entry entries[MAX_NODES];
+static struct sys_hashmap_node *slots[CAPACITY];
+static struct sys_hashmap map;
+
+static u32_t hash_u32(const void *key)
+{
+	return sys_hash32_u32(*(const u32_t *)key);
+}
+
+/* sends all keys to a few home slots, to exercise the probing */
+static u32_t hash_collide(const void *key)
+{
+	return *(const u32_t *)key % 4U;
+}
+
+static u32_t hash_last(const void *key)
+{
+	ARG_UNUSED(key);
+
+	return CAPACITY - 1;
+}
+
+static bool entry_eq(const struct sys_hashmap_node *node, const void *key)
+{
+	return CONTAINER_OF(node, struct entry, node)->key ==
+	       *(const u32_t *)key;
+}
+
+static bool cached_eq(const struct sys_hashmap_node *node, const void *key)
+{
+	const struct cached *c = CONTAINER_OF(node, struct cached, node.hnode);
+
+	return c->key == *(const u32_t *)key;
+}
+
+static void check_contents(u32_t present_mask_lo, u32_t present_mask_hi)
+{
+	struct sys_hashmap_node *node;
+	size_t count = 0;
+	u32_t i;
+
+	for (i = 0; i < MAX_NODES; i++) {
+		bool present = i < 32 ? present_mask_lo & BIT(i) :
+				present_mask_hi & BIT(i - 32);
+
+		node = sys_hashmap_get(&map, &entries[i].key);
+		if (present) {
+			zassert_equal(node, &entries[i].node,
+				      "Key %u not found", i);
+			count++;
+		} else {
+			zassert_is_null(node, "Removed key %u found", i);
+		}
+	}
+
+	zassert_equal(sys_hashmap_size(&map), count, "Wrong size");
+
+	count = 0;
+	SYS_HASHMAP_FOR_EACH(&map, node) {
+		count++;
+	}
+
+	zassert_equal(sys_hashmap_size(&map), count, "Wrong iteration");
+}
+
+static void fill_and_empty(sys_hashmap_hash_t hash_fn)
+{
+	u32_t lo = 0, hi = 0;
+	u32_t i, key;
+
+	sys_hashmap_init(&map, slots, CAPACITY, hash_fn, entry_eq);
+
+	for (i = 0; i < MAX_NODES; i++) {
+		entries[i].key = i * 7U + 1000U;
+		zassert_equal(sys_hashmap_insert(&map, &entries[i].node,
+						 &entries[i].key), 0,
+			      "Insertion failed");
+	}
+
+	zassert_true(sys_hashmap_is_full(&map), "Map not full");
+	key = 1;
+	zassert_equal(sys_hashmap_insert(&map, &entries[0].node, &key),
+		      -ENOSPC, "Insertion in a full map");
+	zassert_equal(sys_hashmap_insert(&map, &entries[1].node,
+					 &entries[1].key),
+		      -EEXIST, "Duplicate key inserted");
+
+	lo = 0xffffffff;
+	hi = 0x7fffffff;
+	check_contents(lo, hi);
+
+	/* remove every third node, then the rest */
+	for (i = 0; i < MAX_NODES; i += 3) {
+		zassert_true(sys_hashmap_remove(&map, &entries[i].node),
+			     "Node not removed");
+		if (i < 32) {
+			lo &= ~BIT(i);
+		} else {
+			hi &= ~BIT(i - 32);
+		}
+	}
+
+	zassert_false(sys_hashmap_remove(&map, &entries[0].node),
+		      "Node removed twice");
+	check_contents(lo, hi);
+
+	for (i = 0; i < MAX_NODES; i++) {
+		if (i % 3) {
+			sys_hashmap_remove(&map, &entries[i].node);
+		}
+	}
+
+	check_contents(0, 0);
+}
+
+void test_hashmap_spread(void)
+{
+	fill_and_empty(hash_u32);
+}
+
+void test_hashmap_collisions(void)
+{
+	fill_and_empty(hash_collide);
+}
+
+void test_hashmap_wraparound(void)
+{
+	u32_t keys[] = { CAPACITY - 1, 2 * CAPACITY - 1, 3 * CAPACITY - 1 };
+	int i;
+
+	/* the keys all hash to the last slot, their cluster wraps around */
+	sys_hashmap_init(&map, slots, CAPACITY, hash_last, entry_eq);
+
+	for (i = 0; i < ARRAY_SIZE(keys); i++) {
+		entries[i].key = keys[i];
+		zassert_equal(sys_hashmap_insert(&map, &entries[i].node,
+						 &entries[i].key), 0,
+			      "Insertion failed");
+	}
+
+	zassert_equal(slots[1], &entries[2].node, "Probing did not wrap");
+
+	zassert_true(sys_hashmap_remove(&map, &entries[0].node),
+		     "Node not removed");
+	zassert_equal(slots[CAPACITY - 1], &entries[1].node,
+		      "Node not shifted back across the end");
+	zassert_equal(slots[0], &entries[2].node, "Node not shifted back");
+	zassert_is_null(slots[1], "Hole not moved");
+}
+
+void test_hash_functions(void)
+{
+	/* reference values of the 32-bit FNV-1a */
+	zassert_equal(sys_hash32_fnv1a("", 0), 0x811c9dc5U, "FNV-1a of ''");
+	zassert_equal(sys_hash32_fnv1a("a", 1), 0xe40c292cU, "FNV-1a of 'a'");
+	zassert_equal(sys_hash32_str("foobar"), 0xbf9cf968U,
+		      "FNV-1a of 'foobar'");
+	zassert_not_equal(sys_hash32_u32(1), sys_hash32_u32(2),
+			  "Integer hash collides");
+}
+
+void test_lru(void)
+{
+	static struct cached pool[4];
+	static struct sys_hashmap_node *lru_slots[8];
+	struct sys_lru lru;
+	struct sys_lru_node *node;
+	struct cached *c;
+	u32_t key;
+	int i;
+
+	sys_lru_init(&lru, lru_slots, ARRAY_SIZE(lru_slots),
+		     ARRAY_SIZE(pool), hash_u32, cached_eq);
+
+	for (i = 0; i < ARRAY_SIZE(pool); i++) {
+		pool[i].key = i;
+		zassert_equal(sys_lru_put(&lru, &pool[i].node, &pool[i].key),
+			      0, "Insertion failed");
+	}
+
+	zassert_true(sys_lru_is_full(&lru), "Cache not full");
+	zassert_equal(sys_lru_put(&lru, &pool[0].node, &key), -ENOSPC,
+		      "Insertion in a full cache");
+
+	/* use 0, so that 1 becomes the least recently used */
+	key = 0;
+	zassert_equal(sys_lru_get(&lru, &key), &pool[0].node, "0 not cached");
+
+	/* peeking does not change the order */
+	key = 1;
+	zassert_equal(sys_lru_peek(&lru, &key), &pool[1].node,
+		      "1 not cached");
+
+	node = sys_lru_evict(&lru);
+	zassert_equal(node, &pool[1].node, "Wrong node evicted");
+	zassert_is_null(sys_lru_peek(&lru, &key), "Evicted node cached");
+
+	c = CONTAINER_OF(node, struct cached, node);
+	c->key = 10;
+	zassert_equal(sys_lru_put(&lru, &c->node, &c->key), 0,
+		      "Reinsertion failed");
+
+	zassert_equal(sys_lru_evict(&lru), &pool[2].node, "Wrong order");
+	zassert_equal(sys_lru_evict(&lru), &pool[3].node, "Wrong order");
+	zassert_equal(sys_lru_evict(&lru), &pool[0].node, "Wrong order");
+	zassert_equal(sys_lru_evict(&lru), &pool[1].node, "Wrong order");
+	zassert_is_null(sys_lru_evict(&lru), "Empty cache evicted");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(hashmap,
+			 ztest_unit_test(test_hashmap_spread),
+			 ztest_unit_test(test_hashmap_collisions),
+			 ztest_unit_test(test_hashmap_wraparound),
+			 ztest_unit_test(test_hash_functions),
+			 ztest_unit_test(test_lru));
+	ztest_run_test_suite(hashmap);
+}
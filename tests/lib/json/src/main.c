@@ -494,6 +494,358 @@ static void test_json_escape_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check OK");
 }
 
+struct test_numbers {
+	s64_t some_int64;
+	double some_float;
+	double float_array[4];
+	size_t float_array_len;
+};
+
+static const struct json_obj_descr numbers_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct test_numbers, some_int64, JSON_TOK_INT64),
+	JSON_OBJ_DESCR_PRIM(struct test_numbers, some_float, JSON_TOK_FLOAT),
+	JSON_OBJ_DESCR_ARRAY(struct test_numbers, float_array, 4,
+			     float_array_len, JSON_TOK_FLOAT),
+};
+
+static void test_json_numbers_decoding(void)
+{
+	struct test_numbers tn;
+	char encoded[] = "{\"some_int64\":-9223372036854775808,"
+		"\"some_float\":-12.5e-1,"
+		"\"float_array\":[0.5,1E3,2e+2,-0]}";
+	int ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, numbers_descr,
+			     ARRAY_SIZE(numbers_descr), &tn);
+
+	zassert_equal(ret, (1 << ARRAY_SIZE(numbers_descr)) - 1,
+		      "All fields decoded correctly");
+	zassert_equal(tn.some_int64, INT64_MIN, "64-bit integer decoded");
+	zassert_true(tn.some_float == -1.25, "Float decoded");
+	zassert_equal(tn.float_array_len, 4, "Float array decoded");
+	zassert_true(tn.float_array[0] == 0.5 && tn.float_array[1] == 1000.0 &&
+		     tn.float_array[2] == 200.0 && tn.float_array[3] == 0.0,
+		     "Float array decoded with expected values");
+}
+
+static void test_json_numbers_out_of_range(void)
+{
+	struct test_numbers tn;
+	struct test_struct ts;
+	char int32[] = "{\"some_int\":2147483648}";
+	char int64[] = "{\"some_int64\":9223372036854775808}";
+	char fraction[] = "{\"some_int\":1.5}";
+	int ret;
+
+	ret = json_obj_parse(int32, sizeof(int32) - 1, test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+	zassert_equal(ret, -ERANGE, "32-bit overflow detected");
+
+	ret = json_obj_parse(int64, sizeof(int64) - 1, numbers_descr,
+			     ARRAY_SIZE(numbers_descr), &tn);
+	zassert_equal(ret, -ERANGE, "64-bit overflow detected");
+
+	ret = json_obj_parse(fraction, sizeof(fraction) - 1, test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+	zassert_equal(ret, -EINVAL, "Fraction rejected for an integer");
+}
+
+static void test_json_numbers_encoding(void)
+{
+	struct test_numbers tn = {
+		.some_int64 = 1099511627776LL,
+		.some_float = -0.375,
+		.float_array = { 1e300, 1e-7, 123.25, 0.1 },
+		.float_array_len = 4,
+	};
+	const char encoded[] = "{\"some_int64\":1099511627776,"
+		"\"some_float\":-0.375,"
+		"\"float_array\":[1e300,1e-7,123.25,0.1]}";
+	char buffer[sizeof(encoded)];
+	int ret;
+
+	ret = json_obj_encode_buf(numbers_descr, ARRAY_SIZE(numbers_descr),
+				  &tn, buffer, sizeof(buffer));
+	zassert_equal(ret, 0, "Encoding function returned no errors");
+	zassert_true(!strcmp(buffer, encoded), "Encoded contents consistent");
+}
+
+struct stream_log {
+	char buf[256];
+	size_t len;
+};
+
+static int stream_log(struct stream_log *log, const char *event,
+		      const char *text, size_t len)
+{
+	int ret;
+
+	ret = snprintk(log->buf + log->len, sizeof(log->buf) - log->len,
+		       "%s%.*s ", event, (int)len, text);
+	if (ret >= sizeof(log->buf) - log->len) {
+		return -ENOMEM;
+	}
+
+	log->len += ret;
+
+	return 0;
+}
+
+static int log_object_start(void *user_data)
+{
+	return stream_log(user_data, "{", "", 0);
+}
+
+static int log_object_end(void *user_data)
+{
+	return stream_log(user_data, "}", "", 0);
+}
+
+static int log_array_start(void *user_data)
+{
+	return stream_log(user_data, "[", "", 0);
+}
+
+static int log_array_end(void *user_data)
+{
+	return stream_log(user_data, "]", "", 0);
+}
+
+static int log_key(const char *key, size_t len, void *user_data)
+{
+	return stream_log(user_data, "k:", key, len);
+}
+
+static int log_string(const char *str, size_t len, void *user_data)
+{
+	return stream_log(user_data, "s:", str, len);
+}
+
+static int log_number(const char *num, size_t len, void *user_data)
+{
+	return stream_log(user_data, "n:", num, len);
+}
+
+static int log_boolean(bool value, void *user_data)
+{
+	return stream_log(user_data, value ? "true" : "false", "", 0);
+}
+
+static int log_null(void *user_data)
+{
+	return stream_log(user_data, "null", "", 0);
+}
+
+static const struct json_stream_cb log_cb = {
+	.object_start = log_object_start,
+	.object_end = log_object_end,
+	.array_start = log_array_start,
+	.array_end = log_array_end,
+	.key = log_key,
+	.string = log_string,
+	.number = log_number,
+	.boolean = log_boolean,
+	.null = log_null,
+};
+
+static int stream_feed_chunks(struct json_stream *stream, const char *json,
+			      size_t len, size_t chunk)
+{
+	size_t pos;
+	int ret;
+
+	for (pos = 0; pos < len; pos += chunk) {
+		ret = json_stream_feed(stream, json + pos,
+				       MIN(chunk, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(stream);
+}
+
+static void test_json_stream_tokens(void)
+{
+	const char json[] = "{\"a\":[1,-2.5e3,{}],\"b\\\"c\": \"d\\u00e9\","
+		" \"e\":true,\"f\":false,\"g\":null,\"h\":[]}";
+	const char expected[] = "{ k:a [ n:1 n:-2.5e3 { } ] k:b\\\"c "
+		"s:d\\u00e9 k:e true k:f false k:g null k:h [ ] } ";
+	struct json_stream stream;
+	struct stream_log log;
+	char buf[16];
+	size_t chunk;
+	int ret;
+
+	for (chunk = 1; chunk < sizeof(json); chunk++) {
+		log.len = 0;
+		json_stream_init(&stream, &log_cb, &log, buf, sizeof(buf));
+
+		ret = stream_feed_chunks(&stream, json, sizeof(json) - 1,
+					 chunk);
+		zassert_equal(ret, 0, "Tokens parsed in chunks of %u bytes",
+			      (unsigned int)chunk);
+		zassert_true(!strcmp(log.buf, expected),
+			     "Tokens consistent in chunks of %u bytes",
+			     (unsigned int)chunk);
+	}
+}
+
+static void test_json_stream_errors(void)
+{
+	const char *invalid[] = {
+		"{\"a\":1,}", "{\"a\" 1}", "[1 2]", "{\"a\":01}",
+		"{\"a\":tru}", "{]", "{\"a\":\"\\x\"}", "{} x", "[-]",
+		"{\"a\":\"\\u12g4\"}", "{\"a\":1",
+	};
+	const char deep[] = "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[";
+	const char long_string[] = "[\"0123456789abcdefg\"]";
+	struct json_stream stream;
+	struct stream_log log;
+	char buf[16];
+	size_t i;
+	int ret;
+
+	for (i = 0; i < ARRAY_SIZE(invalid); i++) {
+		log.len = 0;
+		json_stream_init(&stream, &log_cb, &log, buf, sizeof(buf));
+
+		ret = stream_feed_chunks(&stream, invalid[i],
+					 strlen(invalid[i]), 1);
+		zassert_equal(ret, -EINVAL, "Invalid JSON %s rejected",
+			      invalid[i]);
+	}
+
+	json_stream_init(&stream, &log_cb, &log, buf, sizeof(buf));
+	ret = json_stream_feed(&stream, deep, sizeof(deep) - 1);
+	zassert_equal(ret, -E2BIG, "Nesting depth limited");
+
+	/* Tokens contained in a chunk do not use the token buffer */
+	log.len = 0;
+	json_stream_init(&stream, &log_cb, &log, buf, sizeof(buf));
+	ret = stream_feed_chunks(&stream, long_string,
+				 sizeof(long_string) - 1,
+				 sizeof(long_string) - 1);
+	zassert_equal(ret, 0, "Long string parsed in one chunk");
+
+	log.len = 0;
+	json_stream_init(&stream, &log_cb, &log, buf, sizeof(buf));
+	ret = stream_feed_chunks(&stream, long_string,
+				 sizeof(long_string) - 1, 4);
+	zassert_equal(ret, -ENOMEM, "Token buffer overflow detected");
+}
+
+static void test_json_stream_obj_decoding(void)
+{
+	const char encoded[] = "{\"some_string\":\"zephyr 123\","
+		"\"unknown\":{\"a\":[1,{\"b\":null}],\"c\":\"d\"},"
+		"\"some_int\":\t42\n,"
+		"\"some_bool\":null,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\"},"
+		"\"some_array\":[11,22, 33,\t45,\n299],"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\"}"
+		"}";
+	const int expected_array[] = { 11, 22, 33, 45, 299 };
+	const int expected_other_array[] = { 2, 3, 5, 7 };
+	struct json_stream_obj obj;
+	struct test_struct ts;
+	char buf[96];
+	size_t chunk, pos;
+	int ret;
+
+	for (chunk = 1; chunk < sizeof(encoded); chunk++) {
+		(void)memset(&ts, 0, sizeof(ts));
+		json_stream_obj_init(&obj, test_descr, ARRAY_SIZE(test_descr),
+				     &ts, buf, sizeof(buf));
+
+		for (pos = 0; pos < sizeof(encoded) - 1; pos += chunk) {
+			ret = json_stream_obj_feed(&obj, encoded + pos,
+					MIN(chunk, sizeof(encoded) - 1 - pos));
+			zassert_equal(ret, 0, "Chunk decoded");
+		}
+
+		ret = json_stream_obj_finish(&obj);
+
+		/* some_bool is null */
+		zassert_equal(ret,
+			      ((1 << ARRAY_SIZE(test_descr)) - 1) & ~BIT(2),
+			      "Fields decoded in chunks of %u bytes",
+			      (unsigned int)chunk);
+		zassert_true(!strcmp(ts.some_string, "zephyr 123"),
+			     "String decoded correctly");
+		zassert_equal(ts.some_int, 42, "Integer decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int, -1234,
+			      "Nested integer decoded correctly");
+		zassert_true(!strcmp(ts.some_nested_struct.nested_string,
+				     "this should be escaped: \\t"),
+			     "Nested string decoded correctly");
+		zassert_equal(ts.some_array_len, 5,
+			      "Array has correct number of items");
+		zassert_true(!memcmp(ts.some_array, expected_array,
+				     sizeof(expected_array)),
+			     "Array decoded with expected values");
+		zassert_true(ts.another_bxxl, "Named boolean decoded");
+		zassert_equal(ts.another_array_len, 4,
+			      "Named array has correct number of items");
+		zassert_true(!memcmp(ts.another_array, expected_other_array,
+				     sizeof(expected_other_array)),
+			     "Named array decoded with expected values");
+		zassert_true(ts.xnother_nexx.nested_bool,
+			     "Named nested boolean decoded correctly");
+		zassert_true(!strcmp(ts.xnother_nexx.nested_string,
+				     "no escape necessary"),
+			     "Named nested string decoded correctly");
+	}
+}
+
+static void test_json_stream_obj_errors(void)
+{
+	const char too_many[] = "{\"float_array\":[1,2,3,4,5]}";
+	const char wrong_type[] = "{\"some_float\":\"1\"}";
+	const char strings[] = "{\"some_string\":\"0123456789\"}";
+	struct json_stream_obj obj;
+	struct test_numbers tn;
+	struct test_struct ts;
+	char buf[8];
+	int ret;
+
+	json_stream_obj_init(&obj, numbers_descr, ARRAY_SIZE(numbers_descr),
+			     &tn, buf, sizeof(buf));
+	ret = json_stream_obj_feed(&obj, too_many, sizeof(too_many) - 1);
+	zassert_equal(ret, -ENOSPC, "Array overflow detected");
+
+	json_stream_obj_init(&obj, numbers_descr, ARRAY_SIZE(numbers_descr),
+			     &tn, buf, sizeof(buf));
+	ret = json_stream_obj_feed(&obj, wrong_type, sizeof(wrong_type) - 1);
+	zassert_equal(ret, -EINVAL, "Wrong type detected");
+
+	json_stream_obj_init(&obj, test_descr, ARRAY_SIZE(test_descr),
+			     &ts, buf, sizeof(buf));
+	ret = json_stream_obj_feed(&obj, strings, sizeof(strings) - 1);
+	zassert_equal(ret, -ENOMEM, "String buffer overflow detected");
+
+	json_stream_obj_init(&obj, test_descr, ARRAY_SIZE(test_descr),
+			     &ts, buf, sizeof(buf));
+	ret = json_stream_obj_feed(&obj, "[]", 2);
+	zassert_equal(ret, -EINVAL, "Only objects are decoded");
+
+	json_stream_obj_init(&obj, test_descr, ARRAY_SIZE(test_descr),
+			     &ts, buf, sizeof(buf));
+	ret = json_stream_obj_feed(&obj, "{", 1);
+	zassert_equal(ret, 0, "Partial object fed");
+	ret = json_stream_obj_finish(&obj);
+	zassert_equal(ret, -EINVAL, "Incomplete object detected");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -511,7 +863,14 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_one),
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
-			 ztest_unit_test(test_json_escape_bounds_check)
+			 ztest_unit_test(test_json_escape_bounds_check),
+			 ztest_unit_test(test_json_numbers_decoding),
+			 ztest_unit_test(test_json_numbers_out_of_range),
+			 ztest_unit_test(test_json_numbers_encoding),
+			 ztest_unit_test(test_json_stream_tokens),
+			 ztest_unit_test(test_json_stream_errors),
+			 ztest_unit_test(test_json_stream_obj_decoding),
+			 ztest_unit_test(test_json_stream_obj_errors)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <misc/lf_stack.h>
+#include <misc/lf_queue.h>
+
+#define DEPTH 8
+
+SYS_LF_STACK_DEFINE(stack, DEPTH);
+SYS_LF_QUEUE_DEFINE(queue, DEPTH);
+
+/**
+ * @brief Test lock-free stack ordering and bounds
+ *
+ * @see sys_lf_stack_push(), sys_lf_stack_pop()
+ */
+void test_lf_stack(void)
+{
+	void *data;
+	int i;
+
+	zassert_true(sys_lf_stack_is_empty(&stack), NULL);
+	zassert_equal(sys_lf_stack_pop(&stack, &data), -EAGAIN, NULL);
+
+	for (i = 0; i < DEPTH; i++) {
+		zassert_equal(sys_lf_stack_push(&stack, (void *)i), 0, NULL);
+	}
+	zassert_equal(sys_lf_stack_push(&stack, NULL), -ENOMEM, NULL);
+
+	for (i = DEPTH - 1; i >= 0; i--) {
+		zassert_equal(sys_lf_stack_pop(&stack, &data), 0, NULL);
+		zassert_equal(data, (void *)i, NULL);
+	}
+	zassert_true(sys_lf_stack_is_empty(&stack), NULL);
+
+	/* Slots went back to the free list and are reused */
+	for (i = 0; i < 2 * DEPTH; i++) {
+		zassert_equal(sys_lf_stack_push(&stack, (void *)i), 0, NULL);
+		zassert_equal(sys_lf_stack_pop(&stack, &data), 0, NULL);
+		zassert_equal(data, (void *)i, NULL);
+	}
+}
+
+/**
+ * @brief Test lock-free queue ordering and bounds
+ *
+ * @see sys_lf_queue_put(), sys_lf_queue_get()
+ */
+void test_lf_queue(void)
+{
+	void *data;
+	int i, lap;
+
+	zassert_equal(sys_lf_queue_get(&queue, &data), -EAGAIN, NULL);
+
+	/* Several laps, for the sequence numbers to wrap around the cells */
+	for (lap = 0; lap < 3; lap++) {
+		for (i = 0; i < DEPTH; i++) {
+			zassert_equal(sys_lf_queue_put(&queue, (void *)i), 0,
+				      NULL);
+		}
+		zassert_equal(sys_lf_queue_put(&queue, NULL), -ENOMEM, NULL);
+
+		for (i = 0; i < DEPTH; i++) {
+			zassert_equal(sys_lf_queue_get(&queue, &data), 0,
+				      NULL);
+			zassert_equal(data, (void *)i, NULL);
+		}
+		zassert_equal(sys_lf_queue_get(&queue, &data), -EAGAIN, NULL);
+	}
+}
+
+static void isr_put(void *arg)
+{
+	zassert_equal(sys_lf_stack_push(&stack, arg), 0, NULL);
+	zassert_equal(sys_lf_queue_put(&queue, arg), 0, NULL);
+}
+
+/**
+ * @brief Test lock-free primitives filled from ISR context
+ *
+ * @see sys_lf_stack_push(), sys_lf_queue_put()
+ */
+void test_lf_isr(void)
+{
+	void *data;
+
+	irq_offload(isr_put, (void *)1);
+	irq_offload(isr_put, (void *)2);
+
+	zassert_equal(sys_lf_queue_get(&queue, &data), 0, NULL);
+	zassert_equal(data, (void *)1, NULL);
+	zassert_equal(sys_lf_queue_get(&queue, &data), 0, NULL);
+	zassert_equal(data, (void *)2, NULL);
+
+	zassert_equal(sys_lf_stack_pop(&stack, &data), 0, NULL);
+	zassert_equal(data, (void *)2, NULL);
+	zassert_equal(sys_lf_stack_pop(&stack, &data), 0, NULL);
+	zassert_equal(data, (void *)1, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_lockfree,
+			 ztest_unit_test(test_lf_stack),
+			 ztest_unit_test(test_lf_queue),
+			 ztest_unit_test(test_lf_isr));
+	ztest_run_test_suite(test_lockfree);
+}
@@ -20,6 +20,9 @@
 #include <ztest.h>
 #include <stdlib.h>
 #include <errno.h>
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES
+#include <malloc.h>
+#endif
 #include <kernel_internal.h>
 
 #define BUF_LEN 10
@@ -197,6 +200,48 @@ void test_memalloc_max(void)
 	ptr = NULL;
 }
 
+/**
+ * @brief Test the size class caches and their statistics
+ *
+ * @see malloc(), free(), malloc_stats_get()
+ */
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_SIZE_CLASSES
+void test_malloc_stats(void)
+{
+	struct malloc_stats before, stats;
+	void *small, *large, *again;
+
+	zassert_equal(malloc_stats_get(&before), 0, NULL);
+
+	small = malloc(20);
+	large = malloc(300);
+	zassert_not_null(small, "malloc failed, errno: %d", errno);
+	zassert_not_null(large, "malloc failed, errno: %d", errno);
+
+	zassert_equal(malloc_stats_get(&stats), 0, NULL);
+	zassert_equal(stats.used, before.used + 320, NULL);
+	zassert_true(stats.peak_used >= stats.used, NULL);
+	zassert_true(stats.arena_used >= stats.used, NULL);
+
+	/* a freed object is handed out again for the same class */
+	free(small);
+	again = malloc(32);
+	zassert_equal(again, small, "object of the class not reused");
+
+	free(again);
+	free(large);
+
+	zassert_equal(malloc_stats_get(&stats), 0, NULL);
+	zassert_equal(stats.used, before.used, NULL);
+	zassert_true(stats.peak_used >= before.used + 320, NULL);
+}
+#else
+void test_malloc_stats(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(test_c_lib_dynamic_memalloc,
@@ -206,7 +251,8 @@ void test_main(void)
 			 ztest_user_unit_test(test_realloc),
 			 ztest_user_unit_test(test_reallocarray),
 			 ztest_user_unit_test(test_memalloc_all),
-			 ztest_user_unit_test(test_memalloc_max)
+			 ztest_user_unit_test(test_memalloc_max),
+			 ztest_user_unit_test(test_malloc_stats)
 			 );
 	ztest_run_test_suite(test_c_lib_dynamic_memalloc);
 }
@@ -139,7 +139,11 @@ void _check_tree(int size, int use_foreach)
 
 	(void)memset(walked_nodes, 0, sizeof(walked_nodes));
 
-	if (use_foreach) {
+	if (use_foreach == 2) {
+		RB_FOR_EACH_SAFE(&tree, n) {
+			visit_node(n, &nwalked);
+		}
+	} else if (use_foreach) {
 		RB_FOR_EACH(&tree, n) {
 			visit_node(n, &nwalked);
 		}
@@ -147,6 +151,9 @@ void _check_tree(int size, int use_foreach)
 		rb_walk(&tree, visit_node, &nwalked);
 	}
 
+	/* The cached minimum is the leftmost node */
+	CHECK(rb_get_min(&tree) == z_rb_get_minmax(&tree, 0));
+
 	/* Make sure all found nodes are in-order and marked in the tree */
 	for (i = 0; i < nwalked; i++) {
 		n = walked_nodes[i];
@@ -158,9 +165,14 @@ void _check_tree(int size, int use_foreach)
 
 		CHECK(get_node_mask(ni));
 
+		/* Stepping back finds the same order */
+		CHECK(rb_prev(&tree, n) == last);
+
 		last = n;
 	}
 
+	CHECK(rb_prev(&tree, NULL) == last);
+
 	/* Make sure all tree bits properly reflect the set of nodes we found */
 	ni = 0;
 	for (i = 0; i < MAX_NODES; i++) {
@@ -181,9 +193,10 @@ void _check_tree(int size, int use_foreach)
 
 void check_tree(int size)
 {
-	/* Do it with both enumeration mechanisms */
+	/* Do it with all enumeration mechanisms */
 	_check_tree(size, 0);
 	_check_tree(size, 1);
+	_check_tree(size, 2);
 }
 
 void checked_insert(struct rbtree *tree, struct rbnode *node)
@@ -245,9 +258,49 @@ void test_rbtree_spam(void)
 	} while (size < MAX_NODES);
 }
 
+void test_rbtree_build(void)
+{
+	static struct rbnode *sorted[MAX_NODES];
+	struct rbnode *n;
+	int size, i;
+
+	for (size = 0; size <= MAX_NODES; size++) {
+		(void)memset(&tree, 0, sizeof(tree));
+		tree.lessthan_fn = node_lessthan;
+		(void)memset(node_mask, 0, sizeof(node_mask));
+
+		/* nodes sort by address */
+		for (i = 0; i < size; i++) {
+			sorted[i] = &nodes[i];
+			set_node_mask(i, 1);
+		}
+
+		rb_build(&tree, sorted, size);
+		check_tree(size);
+
+		/* the built tree supports the usual operations */
+		for (i = 0; i < size; i += 3) {
+			rb_remove(&tree, &nodes[i]);
+			set_node_mask(i, 0);
+		}
+
+		check_tree(size);
+	}
+
+	/* removing the current node while walking */
+	RB_FOR_EACH_SAFE(&tree, n) {
+		rb_remove(&tree, n);
+		set_node_mask(node_index(n), 0);
+	}
+
+	CHECK(tree.root == NULL);
+	CHECK(rb_get_min(&tree) == NULL);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_rbtree,
-			 ztest_unit_test(test_rbtree_spam));
+			 ztest_unit_test(test_rbtree_spam),
+			 ztest_unit_test(test_rbtree_build));
 	ztest_run_test_suite(test_rbtree);
 }
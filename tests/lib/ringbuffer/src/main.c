@@ -443,6 +443,99 @@ void test_reset(void)
 	zassert_true(granted == RINGBUFFER_SIZE - 1, NULL);
 }
 
+#define SPSC_SIZE 8
+
+RING_BUF_SPSC_DECLARE(ringbuf_spsc, SPSC_SIZE);
+
+void test_spsc_put_get(void)
+{
+	u8_t indata[3 * SPSC_SIZE];
+	u8_t outdata[3 * SPSC_SIZE];
+	u8_t *buf;
+	u32_t len, i;
+
+	for (i = 0; i < sizeof(indata); i++) {
+		indata[i] = i;
+	}
+
+	/* the whole buffer is usable */
+	zassert_true(ring_buf_spsc_is_empty(&ringbuf_spsc), NULL);
+	zassert_equal(ring_buf_spsc_capacity_get(&ringbuf_spsc), SPSC_SIZE,
+		      NULL);
+	len = ring_buf_spsc_put(&ringbuf_spsc, indata, sizeof(indata));
+	zassert_equal(len, SPSC_SIZE, NULL);
+	zassert_equal(ring_buf_spsc_space_get(&ringbuf_spsc), 0, NULL);
+	zassert_equal(ring_buf_spsc_put_claim(&ringbuf_spsc, &buf, 1), 0,
+		      NULL);
+
+	/* move the indices off the start, then wrap around */
+	len = ring_buf_spsc_get(&ringbuf_spsc, outdata, 5);
+	zassert_equal(len, 5, NULL);
+	zassert_equal(memcmp(outdata, indata, 5), 0, NULL);
+
+	len = ring_buf_spsc_put(&ringbuf_spsc, &indata[SPSC_SIZE], 5);
+	zassert_equal(len, 5, NULL);
+
+	/* a claim stops at the end of the buffer */
+	len = ring_buf_spsc_get_claim(&ringbuf_spsc, &buf, SPSC_SIZE);
+	zassert_equal(len, 3, NULL);
+	zassert_equal(memcmp(buf, &indata[5], 3), 0, NULL);
+	zassert_equal(ring_buf_spsc_get_finish(&ringbuf_spsc, SPSC_SIZE + 1),
+		      -EINVAL, NULL);
+	zassert_equal(ring_buf_spsc_get_finish(&ringbuf_spsc, 3), 0, NULL);
+
+	len = ring_buf_spsc_get(&ringbuf_spsc, outdata, sizeof(outdata));
+	zassert_equal(len, 5, NULL);
+	zassert_equal(memcmp(outdata, &indata[SPSC_SIZE], 5), 0, NULL);
+	zassert_true(ring_buf_spsc_is_empty(&ringbuf_spsc), NULL);
+
+	zassert_equal(ring_buf_spsc_put_finish(&ringbuf_spsc, SPSC_SIZE + 1),
+		      -EINVAL, NULL);
+}
+
+void test_spsc_index_overflow(void)
+{
+	static u8_t data[SPSC_SIZE];
+	struct ring_buf_spsc rb;
+	u8_t in = 0x5a, out;
+
+	/* the free-running indices wrap around 2^32 */
+	ring_buf_spsc_init(&rb, sizeof(data), data);
+	rb.producer.tail = rb.producer.tmp_tail = UINT32_MAX - 1;
+	rb.consumer.head = rb.consumer.tmp_head = UINT32_MAX - 1;
+
+	zassert_equal(ring_buf_spsc_space_get(&rb), SPSC_SIZE, NULL);
+	zassert_equal(ring_buf_spsc_put(&rb, &in, 1), 1, NULL);
+	zassert_equal(ring_buf_spsc_put(&rb, &in, 1), 1, NULL);
+	zassert_equal(ring_buf_spsc_put(&rb, &in, 1), 1, NULL);
+	zassert_equal(ring_buf_spsc_space_get(&rb), SPSC_SIZE - 3, NULL);
+	zassert_equal(ring_buf_spsc_get(&rb, &out, 1), 1, NULL);
+	zassert_equal(out, in, NULL);
+	zassert_equal(ring_buf_spsc_space_get(&rb), SPSC_SIZE - 2, NULL);
+}
+
+static void spsc_isr_put(void *arg)
+{
+	u8_t *val = arg;
+
+	zassert_equal(ring_buf_spsc_put(&ringbuf_spsc, val, 1), 1, NULL);
+}
+
+void test_spsc_put_isr_get_thread(void)
+{
+	u8_t i, out;
+
+	/* an ISR producer and a thread consumer, without any lock */
+	for (i = 0; i < 3 * SPSC_SIZE; i++) {
+		irq_offload(spsc_isr_put, &i);
+		zassert_equal(ring_buf_spsc_get(&ringbuf_spsc, &out, 1), 1,
+			      NULL);
+		zassert_equal(out, i, NULL);
+	}
+
+	zassert_true(ring_buf_spsc_is_empty(&ringbuf_spsc), NULL);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -461,7 +554,10 @@ void test_main(void)
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_capacity),
-			 ztest_unit_test(test_reset)
+			 ztest_unit_test(test_reset),
+			 ztest_unit_test(test_spsc_put_get),
+			 ztest_unit_test(test_spsc_index_overflow),
+			 ztest_unit_test(test_spsc_put_isr_get_thread)
 			 );
 	ztest_run_test_suite(test_ringbuffer_api);
 }
@@ -939,9 +939,76 @@ void test_loop(void)
 	net_pkt_print();
 }
 
+#define REPEAT_COUNT 100
+
+/* The packets of a flow after the first one are compressed from the
+ * cached header, which must give the same result.
+ */
+static u32_t test_6lo_repeat(struct net_6lo_data *data, int count)
+{
+	/* The IPv6 dispatch adds a byte to the header */
+	u8_t first[SIZE_OF_LARGE_DATA + NET_IPV6UDPH_LEN + 1];
+	u8_t next[SIZE_OF_LARGE_DATA + NET_IPV6UDPH_LEN + 1];
+	u32_t start, cycles = 0U;
+	struct net_pkt *pkt;
+	size_t len = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		pkt = create_pkt(data);
+		zassert_not_null(pkt, "failed to create buffer");
+
+		start = k_cycle_get_32();
+		zassert_true((net_6lo_compress(pkt, data->iphc) >= 0),
+			     "compression failed");
+		if (i) {
+			cycles += k_cycle_get_32() - start;
+		}
+
+		if (!i) {
+			len = net_pkt_get_len(pkt);
+			zassert_true(len <= sizeof(first), "packet too long");
+			net_buf_linearize(first, sizeof(first), pkt->frags, 0,
+					  len);
+		} else {
+			zassert_equal(net_pkt_get_len(pkt), len,
+				      "compressed length differs");
+			net_buf_linearize(next, sizeof(next), pkt->frags, 0,
+					  len);
+			zassert_true(!memcmp(first, next, len),
+				     "compressed data differs");
+		}
+
+		zassert_true(net_6lo_uncompress(pkt),
+			     "uncompression failed");
+		zassert_true(compare_data(pkt, data), NULL);
+
+		net_pkt_unref(pkt);
+	}
+
+	return cycles / MAX(count - 1, 1);
+}
+
+void test_repeated_flow(void)
+{
+	u32_t cycles;
+	int count;
+
+	for (count = 0; count < ARRAY_SIZE(tests); count++) {
+		TC_START(tests[count].name);
+
+		test_6lo_repeat(tests[count].data, 2);
+	}
+
+	cycles = test_6lo_repeat(&test_data_2, REPEAT_COUNT);
+
+	TC_PRINT("%u cycles per compression of a repeated flow\n", cycles);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
-	ztest_test_suite(test_6lo, ztest_unit_test(test_loop));
+	ztest_test_suite(test_6lo, ztest_unit_test(test_loop),
+			 ztest_unit_test(test_repeated_flow));
 	ztest_run_test_suite(test_6lo);
 }
@@ -633,9 +633,99 @@ void test_arp(void)
 	}
 }
 
+static struct net_pkt *prepare_ipv4_pkt(struct net_if *iface,
+					struct in_addr *src,
+					struct in_addr *dst)
+{
+	struct net_ipv4_hdr *ipv4;
+	struct net_pkt *pkt;
+	int len = strlen(app_data);
+
+	pkt = net_pkt_alloc_with_buffer(iface, 0, AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	net_pkt_lladdr_src(pkt)->addr = (u8_t *)net_if_get_link_addr(iface);
+	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipaddr_copy(&ipv4->src, src);
+	net_ipaddr_copy(&ipv4->dst, dst);
+
+	memcpy(net_buf_add(pkt->buffer, len), app_data, len);
+
+	return pkt;
+}
+
+void test_arp_pending_queue(void)
+{
+	struct in_addr dst = { { { 192, 168, 0, 3 } } };
+	struct in_addr src = { { { 192, 168, 0, 1 } } };
+	struct net_pkt *pkts[CONFIG_NET_ARP_PENDING_PKTS + 1];
+	struct net_eth_hdr *eth_hdr = NULL;
+	struct net_pkt *req = NULL;
+	struct net_pkt *reply;
+	struct net_pkt *pkt2;
+	struct net_if *iface;
+	int i;
+
+	iface = net_if_get_default();
+
+	net_arp_clear_cache(iface);
+
+	/* All the packets sent before the reply but the last one, beyond
+	 * the size of the queue, are to be kept until the reply.
+	 */
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = prepare_ipv4_pkt(iface, &src, &dst);
+
+		pkt2 = net_arp_prepare(pkts[i], &NET_IPV4_HDR(pkts[i])->dst,
+				       NULL);
+		zassert_not_null(pkt2, "ARP request not sent");
+		zassert_not_equal((void *)pkt2, (void *)pkts[i],
+				  "Packet sent before the reply");
+
+		if (req) {
+			net_pkt_unref(pkt2);
+		} else {
+			req = pkt2;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pkts) - 1; i++) {
+		zassert_equal(atomic_get(&pkts[i]->atomic_ref), 2,
+			      "ARP cache should own the queued packet");
+	}
+
+	zassert_equal(atomic_get(&pkts[i]->atomic_ref), 1,
+		      "ARP cache should not own a packet beyond its queue");
+
+	reply = prepare_arp_reply(iface, req, &hwaddr, &eth_hdr);
+	net_pkt_unref(req);
+
+	(void)net_arp_input(reply, eth_hdr);
+
+	/* Letting the network interface TX thread send the packets. */
+	k_sleep(K_MSEC(50));
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(atomic_get(&pkts[i]->atomic_ref), 1,
+			      "ARP cache should no longer own the packet");
+		net_pkt_unref(pkts[i]);
+	}
+
+	/* The packets to the destination are now sent right away. */
+	pkts[0] = prepare_ipv4_pkt(iface, &src, &dst);
+	pkt2 = net_arp_prepare(pkts[0], &NET_IPV4_HDR(pkts[0])->dst, NULL);
+	zassert_equal((void *)pkt2, (void *)pkts[0],
+		      "ARP entry was not resolved");
+	net_pkt_unref(pkts[0]);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_arp_fn,
-		ztest_unit_test(test_arp));
+		ztest_unit_test(test_arp),
+		ztest_unit_test(test_arp_pending_queue));
 	ztest_run_test_suite(test_arp_fn);
 }
@@ -2039,6 +2039,103 @@ static void test_recv_ipv6_fragment(void)
 	zassert_true(ret == NET_OK, "IPv6 frag2 reassembly failed");
 }
 
+static struct net_pkt *reass_frag_create(u32_t id, u16_t offset, bool more,
+					 u16_t len)
+{
+	struct net_ipv6_frag_hdr frag_hdr;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(struct net_ipv6_hdr) +
+					sizeof(frag_hdr) + len, AF_UNSPEC,
+					0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_cursor_init(pkt);
+
+	frag_hdr.nexthdr = IPPROTO_ICMPV6;
+	frag_hdr.reserved = 0U;
+	frag_hdr.offset = htons(offset | more);
+	frag_hdr.id = htonl(id);
+
+	ret = net_pkt_write(pkt, ipv6_reass_frag1,
+			    sizeof(struct net_ipv6_hdr));
+	zassert_true(ret == 0, "IPv6 header append failed");
+
+	ret = net_pkt_write(pkt, &frag_hdr, 1);
+	zassert_true(ret == 0, "IPv6 fragment header append failed");
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	ret = net_pkt_write(pkt, (u8_t *)&frag_hdr + 1, sizeof(frag_hdr) - 1);
+	zassert_true(ret == 0, "IPv6 fragment header append failed");
+
+	ret = net_pkt_memset(pkt, 0xaa, len);
+	zassert_true(ret == 0, "IPv6 payload append failed");
+
+	net_pkt_set_ipv6_fragment_start(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_overwrite(pkt, true);
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return pkt;
+}
+
+static void reass_count_cb(struct net_ipv6_reassembly *reass,
+			   void *user_data)
+{
+	int *count = user_data;
+
+	if (reass->id == 0x1234) {
+		(*count)++;
+	}
+}
+
+static int reass_frag_send(u16_t offset, bool more, u16_t len)
+{
+	struct net_ipv6_hdr ipv6_hdr;
+	struct net_pkt *pkt;
+	int ret;
+
+	memcpy(&ipv6_hdr, ipv6_reass_frag1, sizeof(struct net_ipv6_hdr));
+
+	pkt = reass_frag_create(0x1234, offset, more, len);
+
+	ret = net_ipv6_handle_fragment_hdr(pkt, &ipv6_hdr,
+					   NET_IPV6_NEXTHDR_FRAG);
+	if (ret != NET_OK) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static void test_recv_ipv6_fragment_dup_overlap(void)
+{
+	int count = 0;
+
+	zassert_equal(reass_frag_send(0, true, 64), NET_OK,
+		      "1st fragment not stored");
+
+	/* The same fragment again is dropped alone */
+	zassert_equal(reass_frag_send(0, true, 64), NET_DROP,
+		      "Duplicate fragment stored");
+
+	net_ipv6_frag_foreach(reass_count_cb, &count);
+	zassert_equal(count, 1, "Reassembly dropped for a duplicate");
+
+	/* A fragment overlapping the first one drops the whole packet */
+	zassert_equal(reass_frag_send(32, true, 64), NET_DROP,
+		      "Overlapping fragment stored");
+
+	count = 0;
+	net_ipv6_frag_foreach(reass_count_cb, &count);
+	zassert_equal(count, 0, "Reassembly kept after an overlap");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_ipv6_fragment_test,
@@ -2055,7 +2152,8 @@ void test_main(void)
 			 ztest_unit_test(test_send_ipv6_fragment),
 			 ztest_unit_test(test_send_ipv6_fragment_large_hbho),
 			 ztest_unit_test(test_send_ipv6_fragment_without_hbho),
-			 ztest_unit_test(test_recv_ipv6_fragment)
+			 ztest_unit_test(test_recv_ipv6_fragment),
+			 ztest_unit_test(test_recv_ipv6_fragment_dup_overlap)
 			 );
 
 	ztest_run_test_suite(net_ipv6_fragment_test);
@@ -1067,6 +1067,213 @@ done:
 	return result;
 }
 
+/* Response carrying the block at @a num of a 256 bytes resource */
+static int prepare_window_response(struct coap_packet *rsp, u8_t *data,
+				   int num)
+{
+	struct coap_block_context ctx;
+	u8_t payload[64] = { 0 };
+	int r;
+
+	coap_block_transfer_init(&ctx, COAP_BLOCK_64, 256);
+	ctx.current = num * sizeof(payload);
+
+	r = coap_packet_init(rsp, data, COAP_BUF_SIZE, 1, COAP_TYPE_ACK,
+			     0, NULL, COAP_RESPONSE_CODE_CONTENT, num);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_block2_option(rsp, &ctx);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_size2_option(rsp, &ctx);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload_marker(rsp);
+	if (r < 0) {
+		return r;
+	}
+
+	return coap_packet_append_payload(rsp, payload, sizeof(payload));
+}
+
+static int window_receive(struct coap_block_window *win, int num,
+			  bool *last)
+{
+	u8_t data[COAP_BUF_SIZE];
+	struct coap_packet rsp;
+	int r;
+
+	r = prepare_window_response(&rsp, data, num);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_parse(&rsp, data, rsp.offset, NULL, 0);
+	if (r < 0) {
+		return r;
+	}
+
+	return coap_block_window_received(win, &rsp, last);
+}
+
+static int test_block2_window(void)
+{
+	struct coap_block_context req;
+	struct coap_block_window win;
+	int result = TC_FAIL;
+	bool last;
+	int i;
+
+	coap_block_window_init(&win, COAP_BLOCK_64, 3);
+
+	/* One block at a time until the size is known */
+	if (coap_block_window_next(&win, &req) != 0 || req.current != 0 ||
+	    coap_block_window_next(&win, &req) != -EAGAIN) {
+		TC_PRINT("First block not requested alone\n");
+		goto done;
+	}
+
+	if (window_receive(&win, 0, &last) != 0 || last) {
+		TC_PRINT("First block not received\n");
+		goto done;
+	}
+
+	/* Then the next three blocks at once */
+	for (i = 1; i <= 3; i++) {
+		if (coap_block_window_next(&win, &req) != 0 ||
+		    req.current != i * 64) {
+			TC_PRINT("Block %d not requested\n", i);
+			goto done;
+		}
+	}
+
+	if (coap_block_window_next(&win, &req) != -ENOENT) {
+		TC_PRINT("Block requested past the end\n");
+		goto done;
+	}
+
+	/* Block 1 lost: block 2 is dropped and requested again */
+	if (window_receive(&win, 2, &last) != -EAGAIN ||
+	    coap_block_window_next(&win, &req) != 0 || req.current != 128) {
+		TC_PRINT("Block received ahead not requested again\n");
+		goto done;
+	}
+
+	if (window_receive(&win, 0, &last) != -EALREADY) {
+		TC_PRINT("Duplicate block not detected\n");
+		goto done;
+	}
+
+	coap_block_window_rewind(&win);
+
+	for (i = 1; i <= 3; i++) {
+		if (coap_block_window_next(&win, &req) != 0 ||
+		    req.current != i * 64) {
+			TC_PRINT("Block %d not requested again\n", i);
+			goto done;
+		}
+
+		if (window_receive(&win, i, &last) != 0 || last != (i == 3)) {
+			TC_PRINT("Block %d not received\n", i);
+			goto done;
+		}
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
+static int test_find_options(void)
+{
+	static const char * const path[] = { "a", "bc", "def", "gh" };
+	struct coap_option options[4];
+	u8_t data[COAP_BUF_SIZE];
+	struct coap_packet cpkt;
+	int result = TC_FAIL;
+	int r, i;
+
+	r = coap_packet_init(&cpkt, data, sizeof(data), 1, COAP_TYPE_CON, 0,
+			     NULL, COAP_METHOD_GET, 0x1234);
+	if (r < 0) {
+		goto done;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(path); i++) {
+		r = coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+					      (const u8_t *)path[i],
+					      strlen(path[i]));
+		if (r < 0) {
+			goto done;
+		}
+	}
+
+	r = coap_append_option_int(&cpkt, COAP_OPTION_CONTENT_FORMAT, 42);
+	if (r < 0) {
+		goto done;
+	}
+
+	r = coap_append_option_int(&cpkt, COAP_OPTION_BLOCK2, 0x123);
+	if (r < 0) {
+		goto done;
+	}
+
+	r = coap_packet_parse(&cpkt, data, cpkt.offset, NULL, 0);
+	if (r < 0) {
+		TC_PRINT("Could not parse packet\n");
+		goto done;
+	}
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_PATH, options,
+			      ARRAY_SIZE(options));
+	if (r != ARRAY_SIZE(path)) {
+		TC_PRINT("Found %d URI paths\n", r);
+		goto done;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(path); i++) {
+		if (options[i].len != strlen(path[i]) ||
+		    memcmp(options[i].value, path[i], options[i].len)) {
+			TC_PRINT("Wrong URI path %d\n", i);
+			goto done;
+		}
+	}
+
+	if (coap_find_options(&cpkt, COAP_OPTION_CONTENT_FORMAT, options,
+			      1) != 1 ||
+	    coap_option_value_to_int(&options[0]) != 42) {
+		TC_PRINT("Wrong content format\n");
+		goto done;
+	}
+
+	if (coap_find_options(&cpkt, COAP_OPTION_BLOCK2, options, 1) != 1 ||
+	    coap_option_value_to_int(&options[0]) != 0x123) {
+		TC_PRINT("Wrong block2\n");
+		goto done;
+	}
+
+	if (coap_find_options(&cpkt, COAP_OPTION_OBSERVE, options, 1) != 0) {
+		TC_PRINT("Found missing option\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static int test_retransmit_second_round(void)
 {
 	struct coap_packet cpkt;
@@ -1475,6 +1682,8 @@ static const struct {
 	{ "Test match path uri", test_match_path_uri, },
 	{ "Test block sized 1 transfer", test_block1_size, },
 	{ "Test block sized 2 transfer", test_block2_size, },
+	{ "Test block2 window", test_block2_window, },
+	{ "Test find options", test_find_options, },
 	{ "Test retransmission", test_retransmit_second_round, },
 	{ "Test observer server", test_observer_server, },
 	{ "Test observer client", test_observer_client, },
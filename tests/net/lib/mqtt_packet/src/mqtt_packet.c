@@ -1048,6 +1048,275 @@ static int eval_msg_unsuback(struct mqtt_test *mqtt_test)
 	return TC_PASS;
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/*
+ * MQTT 5.0 CONNACK msg:
+ * Session present: 0, Reason code: 0x00 (Success)
+ * Properties: Receive Maximum: 10, Topic Alias Maximum: 2
+ */
+static ZTEST_DMEM
+u8_t connack_v5_1[] = {0x20, 0x09, 0x00, 0x00, 0x06, 0x21, 0x00, 0x0a,
+		       0x22, 0x00, 0x02};
+
+/*
+ * MQTT 5.0 CONNACK msg:
+ * Unknown property identifier 0x7f
+ */
+static ZTEST_DMEM
+u8_t connack_v5_2[] = {0x20, 0x05, 0x00, 0x00, 0x02, 0x7f, 0x00};
+
+/*
+ * MQTT 5.0 CONNACK msg:
+ * Topic Alias Maximum truncated by the length of the properties
+ */
+static ZTEST_DMEM
+u8_t connack_v5_3[] = {0x20, 0x06, 0x00, 0x00, 0x02, 0x22, 0x00, 0x02};
+
+/*
+ * MQTT 5.0 CONNACK msg:
+ * Length of the properties exceeds the packet
+ */
+static ZTEST_DMEM
+u8_t connack_v5_4[] = {0x20, 0x04, 0x00, 0x00, 0x05, 0x22};
+
+/*
+ * MQTT 5.0 PUBLISH msg:
+ * DUP: 0, QoS: 1, Retain: 0, topic: sensors, message: OK, pkt_id: 1
+ * Properties: Payload Format Indicator: 1, Message Expiry Interval: 60,
+ * User Property: a = b
+ */
+static ZTEST_DMEM
+u8_t publish_v5_1[] = {0x32, 0x1c, 0x00, 0x07, 0x73, 0x65, 0x6e, 0x73,
+		       0x6f, 0x72, 0x73, 0x00, 0x01, 0x0e, 0x01, 0x01,
+		       0x02, 0x00, 0x00, 0x00, 0x3c, 0x26, 0x00, 0x01,
+		       0x61, 0x00, 0x01, 0x62, 0x4f, 0x4b};
+
+/*
+ * MQTT 5.0 PUBLISH msg:
+ * DUP: 0, QoS: 0, Retain: 0, topic: sensors, message: OK, no properties
+ */
+static ZTEST_DMEM
+u8_t publish_v5_2[] = {0x30, 0x0c, 0x00, 0x07, 0x73, 0x65, 0x6e, 0x73,
+		       0x6f, 0x72, 0x73, 0x00, 0x4f, 0x4b};
+
+/*
+ * MQTT 5.0 PUBLISH msgs:
+ * DUP: 0, QoS: 0, Retain: 0, message: OK
+ * Topic: sensors, sent in full with Topic Alias: 1 (publish_v5_3), then
+ * replaced by the alias (publish_v5_4). Topics: quitting and zephyr, sent
+ * in full with Topic Alias: 2 (publish_v5_5) and 1 (publish_v5_6).
+ * Topic: sensors, sent in full with Topic Alias: 2 (publish_v5_7).
+ */
+static ZTEST_DMEM
+u8_t publish_v5_3[] = {0x30, 0x0f, 0x00, 0x07, 0x73, 0x65, 0x6e, 0x73,
+		       0x6f, 0x72, 0x73, 0x03, 0x23, 0x00, 0x01, 0x4f,
+		       0x4b};
+
+static ZTEST_DMEM
+u8_t publish_v5_4[] = {0x30, 0x08, 0x00, 0x00, 0x03, 0x23, 0x00, 0x01,
+		       0x4f, 0x4b};
+
+static ZTEST_DMEM
+u8_t publish_v5_5[] = {0x30, 0x10, 0x00, 0x08, 0x71, 0x75, 0x69, 0x74,
+		       0x74, 0x69, 0x6e, 0x67, 0x03, 0x23, 0x00, 0x02,
+		       0x4f, 0x4b};
+
+static ZTEST_DMEM
+u8_t publish_v5_6[] = {0x30, 0x0e, 0x00, 0x06, 0x7a, 0x65, 0x70, 0x68,
+		       0x79, 0x72, 0x03, 0x23, 0x00, 0x01, 0x4f, 0x4b};
+
+static ZTEST_DMEM
+u8_t publish_v5_7[] = {0x30, 0x0f, 0x00, 0x07, 0x73, 0x65, 0x6e, 0x73,
+		       0x6f, 0x72, 0x73, 0x03, 0x23, 0x00, 0x02, 0x4f,
+		       0x4b};
+
+static void client_v5_init(u16_t topic_alias_max)
+{
+	mqtt_client_init(&client);
+	client.protocol_version = MQTT_VERSION_5_0;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	mqtt_topic_alias_reset(&client, topic_alias_max);
+}
+
+static int eval_msg_connack_v5(u8_t *expected, u16_t expected_len,
+			       struct mqtt_connack_param *param)
+{
+	u8_t type_and_flags;
+	u32_t length;
+	struct buf_ctx buf;
+	int rc;
+
+	memset(param, 0, sizeof(*param));
+
+	buf.cur = expected;
+	buf.end = expected + expected_len;
+
+	rc = fixed_header_decode(&buf, &type_and_flags, &length);
+
+	zassert_false(rc, "fixed_header_decode failed");
+
+	return connect_ack_decode(&client, &buf, param);
+}
+
+static void eval_msg_publish_v5(const char *topic, u8_t *expected,
+				u16_t expected_len)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = 0,
+		.message.topic.topic.utf8 = (u8_t *)topic,
+		.message.topic.topic.size = strlen(topic),
+		.message.payload.data = (u8_t *)"OK",
+		.message.payload.len = 2,
+	};
+	struct mqtt_publish_param dec_param;
+	u8_t type_and_flags;
+	u32_t length;
+	struct buf_ctx buf;
+	int rc;
+
+	memset(&dec_param, 0, sizeof(dec_param));
+
+	buf.cur = client.tx_buf;
+	buf.end = client.tx_buf + client.tx_buf_size;
+
+	rc = publish_encode_v5(&client, &param, &buf);
+
+	/* Payload is not copied, copy it manually just after the header.*/
+	memcpy(buf.end, param.message.payload.data,
+	       param.message.payload.len);
+	buf.end += param.message.payload.len;
+
+	/**TESTPOINT: Check publish_encode_v5 function*/
+	zassert_false(rc, "publish_encode_v5 failed");
+
+	rc = eval_buffers(&buf, expected, expected_len);
+
+	zassert_false(rc, "eval_buffers failed");
+
+	rc = fixed_header_decode(&buf, &type_and_flags, &length);
+
+	zassert_false(rc, "fixed_header_decode failed");
+
+	rc = publish_decode_v5(type_and_flags, length, &buf, &dec_param);
+
+	zassert_false(rc, "publish_decode_v5 failed");
+	zassert_equal(dec_param.message.payload.len,
+		      param.message.payload.len, "payload len error");
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
+void test_mqtt_packet_v5_connack(void)
+{
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	struct mqtt_connack_param param;
+	int rc;
+
+	client_v5_init(0);
+
+	rc = eval_msg_connack_v5(connack_v5_1, sizeof(connack_v5_1), &param);
+
+	/**TESTPOINT: Check connect_ack_decode function*/
+	zassert_false(rc, "connect_ack_decode failed");
+	zassert_equal(param.session_present_flag, 0,
+		      "session present flag error");
+	zassert_equal(param.return_code, MQTT_CONNECTION_ACCEPTED,
+		      "reason code error");
+	zassert_equal(param.topic_alias_maximum, 2,
+		      "topic alias maximum error");
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_mqtt_packet_v5_bad_property(void)
+{
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	struct mqtt_connack_param param;
+	int rc;
+
+	client_v5_init(0);
+
+	rc = eval_msg_connack_v5(connack_v5_2, sizeof(connack_v5_2), &param);
+	zassert_equal(rc, -EINVAL, "unknown property accepted");
+
+	rc = eval_msg_connack_v5(connack_v5_3, sizeof(connack_v5_3), &param);
+	zassert_equal(rc, -EINVAL, "truncated property accepted");
+
+	rc = eval_msg_connack_v5(connack_v5_4, sizeof(connack_v5_4), &param);
+	zassert_equal(rc, -EINVAL, "properties past the packet accepted");
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_mqtt_packet_v5_publish(void)
+{
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	struct mqtt_publish_param param;
+	u8_t type_and_flags;
+	u32_t length;
+	struct buf_ctx buf;
+	int rc;
+
+	client_v5_init(0);
+
+	memset(&param, 0, sizeof(param));
+
+	buf.cur = publish_v5_1;
+	buf.end = publish_v5_1 + sizeof(publish_v5_1);
+
+	rc = fixed_header_decode(&buf, &type_and_flags, &length);
+
+	zassert_false(rc, "fixed_header_decode failed");
+
+	rc = publish_decode_v5(type_and_flags, length, &buf, &param);
+
+	/**TESTPOINT: Check publish_decode_v5 function*/
+	zassert_false(rc, "publish_decode_v5 failed");
+	zassert_equal(param.message_id, 1, "message_id error");
+	zassert_equal(param.message.topic.qos, 1, "topic qos error");
+	zassert_equal(param.message.topic.topic.size, TOPIC_LEN,
+		      "topic len error");
+	if (memcmp(param.message.topic.topic.utf8, TOPIC, TOPIC_LEN) != 0) {
+		zassert_unreachable("topic content error");
+	}
+	zassert_equal(param.message.payload.len, 2, "payload len error");
+	zassert_equal_ptr(buf.cur, publish_v5_1 + sizeof(publish_v5_1) - 2,
+			  "properties not skipped");
+
+	/* Without topic aliases, the topic is sent in full. */
+	eval_msg_publish_v5(TOPIC, publish_v5_2, sizeof(publish_v5_2));
+	eval_msg_publish_v5(TOPIC, publish_v5_2, sizeof(publish_v5_2));
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_mqtt_packet_v5_topic_alias(void)
+{
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	client_v5_init(2);
+
+	/**TESTPOINT: Check the aliases are reused, then reassigned*/
+	eval_msg_publish_v5(TOPIC, publish_v5_3, sizeof(publish_v5_3));
+	eval_msg_publish_v5(TOPIC, publish_v5_4, sizeof(publish_v5_4));
+	eval_msg_publish_v5(WILL_TOPIC, publish_v5_5, sizeof(publish_v5_5));
+	eval_msg_publish_v5(TOPIC, publish_v5_4, sizeof(publish_v5_4));
+	eval_msg_publish_v5(CLIENTID, publish_v5_6, sizeof(publish_v5_6));
+	eval_msg_publish_v5(TOPIC, publish_v5_7, sizeof(publish_v5_7));
+
+	/**TESTPOINT: Check the aliases are forgotten on reset*/
+	mqtt_topic_alias_reset(&client, 2);
+	eval_msg_publish_v5(TOPIC, publish_v5_3, sizeof(publish_v5_3));
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_mqtt_packet(void)
 {
 	TC_START("MQTT Library test");
@@ -1086,6 +1355,10 @@ void test_mqtt_packet(void)
 void test_main(void)
 {
 	ztest_test_suite(test_mqtt_packet_fn,
-		ztest_user_unit_test(test_mqtt_packet));
+		ztest_user_unit_test(test_mqtt_packet),
+		ztest_user_unit_test(test_mqtt_packet_v5_connack),
+		ztest_user_unit_test(test_mqtt_packet_v5_bad_property),
+		ztest_user_unit_test(test_mqtt_packet_v5_publish),
+		ztest_user_unit_test(test_mqtt_packet_v5_topic_alias));
 	ztest_run_test_suite(test_mqtt_packet_fn);
 }
@@ -629,6 +629,79 @@ void test_net_pkt_copy(void)
 		     "Pkt not properly unreferenced");
 }
 
+#if defined(CONFIG_NET_UDP)
+/* Reference one's complement sum, 16 bits at a time */
+static u16_t ref_chksum(const u8_t *data, size_t len)
+{
+	u32_t sum = 0U;
+	size_t i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += (data[i] << 8) | data[i + 1];
+	}
+
+	if (len & 1) {
+		sum += data[len - 1] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+#endif
+
+void test_net_pkt_write_chksum(void)
+{
+#if defined(CONFIG_NET_UDP)
+	static const size_t chunks[] = { 1, 7, 64, 3, 255, 16, 2, 164 };
+	static u8_t readback[sizeof(small_buffer)];
+	struct net_pkt *pkt;
+	size_t offset = 0;
+	u16_t sum;
+	int i;
+
+	for (i = 0; i < sizeof(small_buffer); i++) {
+		small_buffer[i] = i * 7 + 3;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, sizeof(small_buffer),
+					AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+
+	/* Chunks of odd and even sizes, unaligned and across buffers */
+	for (i = 0; i < ARRAY_SIZE(chunks); i++) {
+		zassert_true(net_pkt_write_chksum(pkt, small_buffer + offset,
+						  chunks[i]) == 0,
+			     "Pkt write failed");
+		offset += chunks[i];
+	}
+
+	zassert_equal(offset, sizeof(small_buffer), "Wrong chunk sizes");
+	zassert_true(net_pkt_data_chksum_valid(pkt), "Sum not valid");
+	zassert_equal(pkt->data_chksum_len, offset, "Wrong sum length");
+
+	/* 0x0000 and 0xffff are the same one's complement value */
+	sum = ref_chksum(small_buffer, sizeof(small_buffer));
+	zassert_equal(pkt->data_chksum == 0xffff ? 0 : pkt->data_chksum,
+		      sum == 0xffff ? 0 : sum,
+		      "Wrong sum 0x%04x, expected 0x%04x",
+		      pkt->data_chksum, sum);
+
+	/* The data must also be written as is */
+	net_pkt_cursor_init(pkt);
+	zassert_true(net_pkt_read(pkt, readback, sizeof(readback)) == 0,
+		     "Pkt read failed");
+	zassert_true(memcmp(readback, small_buffer, sizeof(readback)) == 0,
+		     "Data corrupted");
+
+	net_pkt_unref(pkt);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	eth_if = net_if_get_default();
@@ -639,7 +712,8 @@ void test_main(void)
 			 ztest_unit_test(test_net_pkt_basics_of_rw),
 			 ztest_unit_test(test_net_pkt_advanced_basics),
 			 ztest_unit_test(test_net_pkt_easier_rw_usage),
-			 ztest_unit_test(test_net_pkt_copy)
+			 ztest_unit_test(test_net_pkt_copy),
+			 ztest_unit_test(test_net_pkt_write_chksum)
 		);
 
 	ztest_run_test_suite(net_pkt_tests);
@@ -301,6 +301,165 @@ void test_send_recv_2_sock(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+void test_sendmsg_recvmsg(void)
+{
+	int sock1, sock2;
+	struct sockaddr_in bind_addr, conn_addr, src_addr;
+	struct iovec iov[2];
+	struct msghdr msg;
+	struct mmsghdr msgs[3];
+	char buf[10], buf2[10];
+	int len, rv, i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55557,
+			    &sock1, &bind_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55557,
+			    &sock2, &conn_addr);
+
+	rv = bind(sock1, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* Gathered into a single datagram */
+	iov[0].iov_base = (void *)TEST_STR_SMALL;
+	iov[0].iov_len = 2;
+	iov[1].iov_base = (void *)(TEST_STR_SMALL + 2);
+	iov[1].iov_len = STRLEN(TEST_STR_SMALL) - 2;
+
+	(void)memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &conn_addr;
+	msg.msg_namelen = sizeof(conn_addr);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = 2;
+
+	len = sendmsg(sock2, &msg, 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid sendmsg len");
+
+	/* Scattered, and truncated */
+	clear_buf(buf);
+	clear_buf(buf2);
+	iov[0].iov_base = buf;
+	iov[0].iov_len = 1;
+	iov[1].iov_base = buf2;
+	iov[1].iov_len = 2;
+
+	(void)memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = 2;
+
+	len = recvmsg(sock1, &msg, 0);
+	zassert_equal(len, 3, "Invalid recvmsg len");
+	zassert_mem_equal(buf, "t", 1, "Wrong data");
+	zassert_mem_equal(buf2, "es", 2, "Wrong data");
+	zassert_true(msg.msg_flags & MSG_TRUNC, "Truncation not reported");
+	zassert_equal(msg.msg_namelen, sizeof(struct sockaddr_in),
+		      "Wrong source address length");
+
+	/* Batched */
+	rv = connect(sock2, (struct sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	(void)memset(msgs, 0, sizeof(msgs));
+	iov[0].iov_base = (void *)TEST_STR_SMALL;
+	iov[0].iov_len = STRLEN(TEST_STR_SMALL);
+	for (i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].msg_hdr.msg_iov = &iov[0];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(sock2, msgs, ARRAY_SIZE(msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(msgs), "sendmmsg failed");
+	for (i = 0; i < ARRAY_SIZE(msgs); i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "Invalid sendmmsg len");
+	}
+
+	clear_buf(buf);
+	iov[1].iov_base = buf;
+	iov[1].iov_len = sizeof(buf);
+	(void)memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].msg_hdr.msg_iov = &iov[1];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Let the datagrams go through the stack */
+	k_sleep(K_MSEC(10));
+
+	rv = recvmmsg(sock1, msgs, ARRAY_SIZE(msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(msgs), "recvmmsg failed");
+	for (i = 0; i < ARRAY_SIZE(msgs); i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "Invalid recvmmsg len");
+	}
+	zassert_mem_equal(buf, BUF_AND_SIZE(TEST_STR_SMALL), "Wrong data");
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_recv_zerocopy(void)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	int sock1, sock2;
+	struct sockaddr_in bind_addr, conn_addr;
+	struct zsock_zc_seg segs[CONFIG_NET_SOCKETS_ZEROCOPY_MAX_SEGS];
+	char buf[sizeof(TEST_STR2)];
+	int nsegs, handle, one = 1;
+	size_t off = 0;
+	int len, rv, i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55556,
+			    &sock1, &bind_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55556,
+			    &sock2, &conn_addr);
+
+	rv = bind(sock1, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = connect(sock2, (struct sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	nsegs = ARRAY_SIZE(segs);
+	len = zsock_recv_zc(sock1, segs, &nsegs, MSG_DONTWAIT, &handle);
+	zassert_equal(len, -1, "zero-copy recv without SO_ZEROCOPY");
+	zassert_equal(errno, EINVAL, "Invalid errno");
+
+	rv = setsockopt(sock1, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one));
+	zassert_equal(rv, 0, "setsockopt failed");
+
+	len = send(sock2, BUF_AND_SIZE(TEST_STR2), 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+
+	nsegs = ARRAY_SIZE(segs);
+	len = zsock_recv_zc(sock1, segs, &nsegs, 0, &handle);
+	zassert_equal(len, STRLEN(TEST_STR2), "Invalid recv len");
+	zassert_true(nsegs > 1, "Data should span several buffers");
+	zassert_not_equal(handle, 0, "No handle returned");
+
+	for (i = 0; i < nsegs; i++) {
+		memcpy(buf + off, segs[i].data, segs[i].len);
+		off += segs[i].len;
+	}
+	zassert_mem_equal(buf, BUF_AND_SIZE(TEST_STR2), "Wrong data");
+
+	rv = zsock_recv_zc_release(handle);
+	zassert_equal(rv, 0, "release failed");
+	rv = zsock_recv_zc_release(handle);
+	zassert_equal(rv, -1, "handle released twice");
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_udp,
@@ -308,7 +467,9 @@ void test_main(void)
 			 ztest_unit_test(test_v4_sendto_recvfrom),
 			 ztest_unit_test(test_v6_sendto_recvfrom),
 			 ztest_unit_test(test_v4_bind_sendto),
-			 ztest_unit_test(test_v6_bind_sendto));
+			 ztest_unit_test(test_v6_bind_sendto),
+			 ztest_unit_test(test_sendmsg_recvmsg),
+			 ztest_unit_test(test_recv_zerocopy));
 
 	ztest_run_test_suite(socket_udp);
 }
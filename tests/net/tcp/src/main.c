@@ -1533,6 +1533,195 @@ static bool test_tcp_seq_validity(void)
 	return true;
 }
 
+static bool test_tcp_parse_opts(void)
+{
+	static const u8_t opts[] = {
+		NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, 0x05, 0xb4,
+		NET_TCP_NOP_OPT, NET_TCP_WINDOW_SCALE_OPT,
+		NET_TCP_WINDOW_SCALE_SIZE, 7,
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE,
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_SACK_OPT, 2 + 2 * NET_TCP_SACK_BLOCK_SIZE,
+		0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+		0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x40, 0x00,
+	};
+	struct net_tcp_options tcp_opts = {
+		.mss = NET_TCP_DEFAULT_MSS,
+	};
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(), sizeof(opts),
+					AF_UNSPEC, 0, K_FOREVER);
+	if (!pkt) {
+		DBG("Cannot allocate pkt\n");
+		return false;
+	}
+
+	net_pkt_write(pkt, opts, sizeof(opts));
+	net_pkt_cursor_init(pkt);
+
+	ret = net_tcp_parse_opts(pkt, sizeof(opts), &tcp_opts);
+	net_pkt_unref(pkt);
+
+	if (ret < 0) {
+		DBG("Parsing options failed (%d)\n", ret);
+		return false;
+	}
+
+	if (tcp_opts.mss != 1460U || !tcp_opts.wscale_ok ||
+	    tcp_opts.wscale != 7U || !tcp_opts.sack_ok ||
+	    tcp_opts.sack_count != 2U) {
+		DBG("Invalid options parsed\n");
+		return false;
+	}
+
+	if (tcp_opts.sack[0].start != 0x1000 ||
+	    tcp_opts.sack[0].end != 0x2000 ||
+	    tcp_opts.sack[1].start != 0x3000 ||
+	    tcp_opts.sack[1].end != 0x4000) {
+		DBG("Invalid SACK blocks parsed\n");
+		return false;
+	}
+
+	return true;
+}
+
+static bool test_tcp_cc_newreno(void)
+{
+	struct net_tcp tcp = { 0 };
+	u32_t cwnd;
+
+	tcp.send_mss = 1000U;
+
+	if (net_tcp_cc_set(&tcp, "newreno") < 0) {
+		DBG("NewReno not found\n");
+		return false;
+	}
+
+	if (tcp.cwnd != 4000U || tcp.ssthresh != UINT32_MAX) {
+		DBG("Invalid initial window %u\n", tcp.cwnd);
+		return false;
+	}
+
+	/* Slow start, one segment per ACK */
+	tcp.cc->cong_avoid(&tcp, 2000U);
+	if (tcp.cwnd != 5000U) {
+		DBG("Invalid slow start window %u\n", tcp.cwnd);
+		return false;
+	}
+
+	/* Congestion avoidance, one segment per window acked */
+	tcp.ssthresh = tcp.cwnd;
+	cwnd = tcp.cwnd;
+	tcp.cc->cong_avoid(&tcp, 2500U);
+	if (tcp.cwnd != cwnd) {
+		DBG("Window grew too early %u\n", tcp.cwnd);
+		return false;
+	}
+
+	tcp.cc->cong_avoid(&tcp, 2500U);
+	if (tcp.cwnd != cwnd + 1000U) {
+		DBG("Invalid avoidance window %u\n", tcp.cwnd);
+		return false;
+	}
+
+	/* Half of the flight on a loss */
+	tcp.snd_una = 1000U;
+	tcp.snd_nxt = 11000U;
+	if (tcp.cc->ssthresh(&tcp) != 5000U) {
+		DBG("Invalid ssthresh\n");
+		return false;
+	}
+
+	tcp.snd_nxt = 2000U;
+	if (tcp.cc->ssthresh(&tcp) != 2000U) {
+		DBG("ssthresh below two segments\n");
+		return false;
+	}
+
+	if (net_tcp_cc_set(&tcp, "unknown") != -ENOENT) {
+		DBG("Unknown algorithm accepted\n");
+		return false;
+	}
+
+	return true;
+}
+
+static bool test_tcp_cc_cubic(void)
+{
+#if defined(CONFIG_NET_TCP_CUBIC)
+	struct net_tcp tcp = { 0 };
+	int i;
+
+	tcp.send_mss = 1000U;
+	tcp.srtt = 50U << 3;
+
+	if (net_tcp_cc_set(&tcp, "cubic") < 0) {
+		DBG("CUBIC not found\n");
+		return false;
+	}
+
+	tcp.cwnd = 10000U;
+
+	/* Multiplicative decrease by beta = 0.7 */
+	tcp.ssthresh = tcp.cc->ssthresh(&tcp);
+	if (tcp.ssthresh != 7000U) {
+		DBG("Invalid ssthresh %u\n", tcp.ssthresh);
+		return false;
+	}
+
+	tcp.cwnd = tcp.ssthresh;
+
+	/* Grows back towards the previous maximum, never above 1.5 times
+	 * the window per round trip
+	 */
+	for (i = 0; i < 10; i++) {
+		tcp.cc->cong_avoid(&tcp, tcp.send_mss);
+	}
+
+	if (tcp.cwnd <= 7000U || tcp.cwnd > 10500U) {
+		DBG("Invalid window %u\n", tcp.cwnd);
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+static bool test_tcp_rtt_update(void)
+{
+	struct net_tcp tcp = { 0 };
+
+	/* RFC 6298 (2.2), RTO = R + 4 * R / 2 */
+	net_tcp_rtt_update(&tcp, 100U);
+	if ((tcp.srtt >> 3) != 100U ||
+	    tcp.rto != MAX(300U, CONFIG_NET_TCP_RTO_MIN)) {
+		DBG("Invalid first estimate srtt %u rto %u\n",
+		    tcp.srtt >> 3, tcp.rto);
+		return false;
+	}
+
+	/* RFC 6298 (2.3), the variation decays by 1/4 per sample */
+	net_tcp_rtt_update(&tcp, 100U);
+	if ((tcp.srtt >> 3) != 100U ||
+	    tcp.rto != MAX(250U, CONFIG_NET_TCP_RTO_MIN)) {
+		DBG("Invalid estimate srtt %u rto %u\n",
+		    tcp.srtt >> 3, tcp.rto);
+		return false;
+	}
+
+	/* RFC 6298 (2.5), capped at 60 seconds */
+	net_tcp_rtt_update(&tcp, 1000000U);
+	if (tcp.rto != NET_TCP_RTO_MAX) {
+		DBG("RTO not capped %u\n", tcp.rto);
+		return false;
+	}
+
+	return true;
+}
+
 static bool test_init_tcp_reply_context(void)
 {
 	struct net_if *iface = peer_iface;
@@ -1817,6 +2006,10 @@ static const struct {
 	{ "test IPv6 TCP seq check", test_v6_seq_check },
 	{ "test IPv4 TCP seq check", test_v4_seq_check },
 	{ "test TCP seq validity", test_tcp_seq_validity },
+	{ "test TCP options parsing", test_tcp_parse_opts },
+	{ "test TCP NewReno congestion control", test_tcp_cc_newreno },
+	{ "test TCP CUBIC congestion control", test_tcp_cc_cubic },
+	{ "test TCP RTT estimation", test_tcp_rtt_update },
 	{ "test TCP reply context init", test_init_tcp_reply_context },
 	{ "test TCP accept init", test_init_tcp_accept },
 #if 0
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* iperf like TCP bulk transfer over the loopback interface. The sender
+ * and the receiver run in two threads; the data is checked and the
+ * throughput printed, so that regressions of the TCP stack show up.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <ztest.h>
+#include <net/socket.h>
+
+#include "../../socket/socket_helpers.h"
+
+#define ANY_PORT 0
+#define SERVER_PORT 5001
+
+#define TRANSFER_SIZE (256 * 1024)
+#define CHUNK_SIZE 1024
+
+#define SENDER_STACK_SIZE 1024
+#define SENDER_PRIORITY K_PRIO_PREEMPT(8)
+
+static K_THREAD_STACK_DEFINE(sender_stack, SENDER_STACK_SIZE);
+static struct k_thread sender_thread;
+static K_SEM_DEFINE(sender_done, 0, 1);
+
+static u8_t tx_buf[CHUNK_SIZE];
+static u8_t rx_buf[CHUNK_SIZE];
+
+/* Pattern that catches reordered, lost and duplicated data */
+static inline u8_t pattern(u32_t offset)
+{
+	return (u8_t)(offset ^ (offset >> 8) ^ (offset >> 16));
+}
+
+static void sender(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	u32_t offset = 0U;
+	ssize_t sent;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (offset < TRANSFER_SIZE) {
+		for (i = 0; i < CHUNK_SIZE; i++) {
+			tx_buf[i] = pattern(offset + i);
+		}
+
+		sent = send(sock, tx_buf, CHUNK_SIZE, 0);
+		zassert_equal(sent, CHUNK_SIZE, "send failed (%d)", errno);
+
+		offset += CHUNK_SIZE;
+	}
+
+	zassert_equal(close(sock), 0, "close failed");
+
+	k_sem_give(&sender_done);
+}
+
+static void run_throughput(int family, const char *addr_str)
+{
+	struct sockaddr_storage s_saddr, c_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int s_sock, c_sock, new_sock;
+	u32_t start, elapsed, offset = 0U;
+	ssize_t recved;
+	int i;
+
+	if (family == AF_INET6) {
+		prepare_sock_tcp_v6(addr_str, ANY_PORT, &c_sock,
+				    (struct sockaddr_in6 *)&c_saddr);
+		prepare_sock_tcp_v6(addr_str, SERVER_PORT, &s_sock,
+				    (struct sockaddr_in6 *)&s_saddr);
+		addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		prepare_sock_tcp_v4(addr_str, ANY_PORT, &c_sock,
+				    (struct sockaddr_in *)&c_saddr);
+		prepare_sock_tcp_v4(addr_str, SERVER_PORT, &s_sock,
+				    (struct sockaddr_in *)&s_saddr);
+		addrlen = sizeof(struct sockaddr_in);
+	}
+
+	zassert_equal(bind(s_sock, (struct sockaddr *)&s_saddr, addrlen), 0,
+		      "bind failed");
+	zassert_equal(listen(s_sock, 1), 0, "listen failed");
+	zassert_equal(connect(c_sock, (struct sockaddr *)&s_saddr, addrlen),
+		      0, "connect failed");
+
+	addrlen = sizeof(addr);
+	new_sock = accept(s_sock, &addr, &addrlen);
+	zassert_true(new_sock >= 0, "accept failed");
+
+	start = k_uptime_get_32();
+
+	k_thread_create(&sender_thread, sender_stack,
+			K_THREAD_STACK_SIZEOF(sender_stack), sender,
+			INT_TO_POINTER(c_sock), NULL, NULL,
+			SENDER_PRIORITY, 0, K_NO_WAIT);
+
+	while (offset < TRANSFER_SIZE) {
+		recved = recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+		zassert_true(recved > 0, "recv failed (%d)", errno);
+
+		for (i = 0; i < recved; i++) {
+			zassert_equal(rx_buf[i], pattern(offset + i),
+				      "data corrupted at %u", offset + i);
+		}
+
+		offset += recved;
+	}
+
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+
+	TC_PRINT("%s: %u bytes in %u ms, %u kbit/s\n",
+		 family == AF_INET6 ? "IPv6" : "IPv4", offset, elapsed,
+		 (u32_t)((u64_t)offset * 8U / elapsed));
+
+	zassert_equal(k_sem_take(&sender_done, K_SECONDS(10)), 0,
+		      "sender did not finish");
+
+	zassert_equal(close(new_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+}
+
+void test_v4_throughput(void)
+{
+	run_throughput(AF_INET, "127.0.0.1");
+}
+
+void test_v6_throughput(void)
+{
+	run_throughput(AF_INET6, "::1");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tcp_throughput,
+			 ztest_unit_test(test_v4_throughput),
+			 ztest_unit_test(test_v6_throughput));
+
+	ztest_run_test_suite(tcp_throughput);
+}
@@ -426,7 +426,7 @@ void test_udp(void)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface = net_if_get_default();
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *connected6, *connected4;
 	int ret, i = 0;
 	bool st;
 
@@ -613,10 +613,12 @@ void test_udp(void)
 	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1234, 4242);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4242);
 	TEST_IPV6_FAIL(ud, &in6addr_peer, &in6addr_my, 1234, 4243);
+	connected6 = ud;
 
 	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1234, 4242);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
 	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1234, 4243);
+	connected4 = ud;
 
 	ud = REGISTER(AF_UNSPEC, NULL, NULL, 1234, 42423);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42423);
@@ -636,6 +638,10 @@ void test_udp(void)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 	TEST_IPV6_LONG_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 
+	/* Connected handlers still win over the wildcard ones */
+	TEST_IPV6_OK(connected6, &in6addr_peer, &in6addr_my, 1234, 4242);
+	TEST_IPV4_OK(connected4, &in4addr_peer, &in4addr_my, 1234, 4242);
+
 	/* Remote addr same as local addr, these two will never match */
 	REGISTER(AF_INET6, &my_addr6, NULL, 1234, 4242);
 	REGISTER(AF_INET, &my_addr4, NULL, 1234, 4242);
@@ -9,6 +9,7 @@
 
 extern void test_posix_clock(void);
 extern void test_posix_mqueue(void);
+extern void test_posix_mqueue_priority(void);
 extern void test_posix_normal_mutex(void);
 extern void test_posix_recursive_mutex(void);
 extern void test_posix_semaphore(void);
@@ -32,6 +33,7 @@ void test_main(void)
 			ztest_unit_test(test_posix_normal_mutex),
 			ztest_unit_test(test_posix_recursive_mutex),
 			ztest_unit_test(test_posix_mqueue),
+			ztest_unit_test(test_posix_mqueue_priority),
 			ztest_unit_test(test_posix_realtime),
 			ztest_unit_test(test_posix_timer),
 			ztest_unit_test(test_posix_rw_lock)
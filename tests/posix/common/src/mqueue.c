@@ -105,3 +105,60 @@ void test_posix_mqueue(void)
 		      "unable to close message queue descriptor.");
 	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
 }
+
+void test_posix_mqueue_priority(void)
+{
+	static const unsigned int prios[] = { 1, 5, 1, 3 };
+	static const unsigned int order[] = { 1, 3, 0, 2 };
+	mqd_t mqd;
+	struct mq_attr attrs;
+	char data[MESSAGE_SIZE];
+	unsigned int prio;
+	int i;
+
+	attrs.mq_msgsize = MESSAGE_SIZE;
+	attrs.mq_maxmsg = MESG_COUNT_PERMQ;
+
+	mqd = mq_open(queue, O_RDWR | O_CREAT | O_NONBLOCK, 0777, &attrs);
+	zassert_not_equal(mqd, (mqd_t)-1, "Queue not created");
+
+	for (i = 0; i < ARRAY_SIZE(prios); i++) {
+		data[0] = i;
+		zassert_false(mq_send(mqd, data, 1, prios[i]),
+			      "Message not sent");
+	}
+
+	zassert_equal(mq_send(mqd, data, 1, 0), -1, "Full queue accepted");
+	zassert_equal(errno, EAGAIN, "Wrong error");
+	zassert_equal(mq_send(mqd, data, 1, MQ_PRIO_MAX), -1,
+		      "Invalid priority accepted");
+
+	/* highest priority first, in sending order within a priority */
+	for (i = 0; i < ARRAY_SIZE(order); i++) {
+		zassert_equal(mq_receive(mqd, data, MESSAGE_SIZE, &prio), 1,
+			      "Wrong length");
+		zassert_equal(data[0], order[i], "Wrong message");
+		zassert_equal(prio, prios[order[i]], "Wrong priority");
+	}
+
+	zassert_equal(mq_receive(mqd, data, MESSAGE_SIZE, &prio), -1,
+		      "Empty queue received");
+
+#ifdef CONFIG_POSIX_MQUEUE_LOAN
+	const char *loaned;
+
+	zassert_false(mq_send(mqd, send_data, MESSAGE_SIZE, 2),
+		      "Message not sent");
+	zassert_equal(mq_loan_receive(mqd, &loaned, &prio, NULL),
+		      MESSAGE_SIZE, "Message not lent");
+	zassert_false(strcmp(loaned, send_data), "Wrong message lent");
+	zassert_equal(prio, 2, "Wrong priority");
+	zassert_equal(mq_loan_return(mqd, send_data), -1,
+		      "Foreign buffer taken back");
+	zassert_false(mq_loan_return(mqd, loaned), "Message not given back");
+#endif
+
+	zassert_false(mq_close(mqd),
+		      "unable to close message queue descriptor.");
+	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
+}
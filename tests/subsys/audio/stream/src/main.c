@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <audio/stream.h>
+
+#define BLOCK_SAMPLES	16
+#define BLOCK_SIZE	(BLOCK_SAMPLES * sizeof(s16_t))
+#define NUM_BLOCKS	4
+
+AUDIO_POOL_DEFINE(test_pool, BLOCK_SIZE, NUM_BLOCKS);
+K_MSGQ_DEFINE(test_mix_queue, sizeof(void *), NUM_BLOCKS, 4);
+
+static void *alloc_filled(s16_t val)
+{
+	s16_t *block = audio_block_alloc(&test_pool, K_NO_WAIT);
+	int i;
+
+	zassert_not_null(block, "Pool exhausted");
+
+	for (i = 0; i < BLOCK_SAMPLES; i++) {
+		block[i] = val;
+	}
+
+	return block;
+}
+
+static void test_block_refs(void)
+{
+	void *block = alloc_filled(0);
+	void *copy = block;
+
+	audio_block_ref(&test_pool, block);
+	zassert_true(audio_block_shared(&test_pool, block), "Not shared");
+
+	zassert_equal(audio_block_writable(&test_pool, &copy, BLOCK_SIZE,
+					   K_NO_WAIT), 0, "No copy");
+	zassert_not_equal(copy, block, "Shared block modifiable");
+	zassert_false(audio_block_shared(&test_pool, block), "Still shared");
+
+	audio_block_unref(&test_pool, block);
+	audio_block_unref(&test_pool, copy);
+	zassert_equal(k_mem_slab_num_used_get(test_pool.slab), 0,
+		      "Blocks leaked");
+}
+
+static void test_mix_saturation(void)
+{
+	s16_t dst[5] = { 1000, 30000, -30000, 7, -1 };
+	s16_t src[5] = { 2000, 10000, -10000, -7, 1 };
+	s16_t exp[5] = { 3000, 32767, -32768, 0, 0 };
+
+	audio_mix_s16(dst, src, ARRAY_SIZE(dst));
+	zassert_mem_equal(dst, exp, sizeof(exp), "Wrong mix");
+}
+
+static void test_gain(void)
+{
+	s16_t buf[3] = { 1000, -20000, 20000 };
+	s16_t exp[3] = { 2000, -32768, 32767 };
+
+	audio_gain_s16(buf, ARRAY_SIZE(buf), 2 * AUDIO_GAIN_UNITY);
+	zassert_mem_equal(buf, exp, sizeof(exp), "Wrong gain");
+}
+
+static void test_resample(void)
+{
+	struct audio_resampler rs;
+	s16_t in[4] = { 100, 200, 300, 400 };
+	s16_t out[8];
+	size_t n;
+
+	zassert_equal(audio_resampler_init(&rs, 8000, 16000, 1), 0,
+		      "Init failed");
+
+	/* interpolates from the previous (zero) frame */
+	n = audio_resample_s16(&rs, in, ARRAY_SIZE(in), out, ARRAY_SIZE(out));
+	zassert_equal(n, 8, "Wrong frame count %u", n);
+	zassert_equal(out[0], 0, "Wrong frame 0");
+	zassert_equal(out[1], 50, "Wrong frame 1");
+	zassert_equal(out[2], 100, "Wrong frame 2");
+	zassert_equal(out[7], 350, "Wrong frame 7");
+
+	/* down by two keeps every other frame */
+	zassert_equal(audio_resampler_init(&rs, 16000, 8000, 1), 0,
+		      "Init failed");
+	n = audio_resample_s16(&rs, in, ARRAY_SIZE(in), out, ARRAY_SIZE(out));
+	zassert_equal(n, 2, "Wrong frame count %u", n);
+	zassert_equal(out[1], 200, "Wrong frame 1");
+
+	zassert_equal(audio_resampler_init(&rs, 8000, 16000, 3), -EINVAL,
+		      "Too many channels accepted");
+}
+
+static void test_pipeline(void)
+{
+	struct audio_gain_node gain;
+	struct audio_mix_node mix;
+	struct audio_node *const nodes[] = { &mix.node, &gain.node };
+	size_t size = BLOCK_SIZE;
+	s16_t *block;
+	void *other;
+
+	audio_mix_node_init(&mix, &test_pool, &test_mix_queue);
+	audio_gain_node_init(&gain, &test_pool, AUDIO_GAIN_UNITY / 2);
+
+	block = alloc_filled(100);
+	other = alloc_filled(300);
+	zassert_equal(audio_mix_node_feed(&mix, other), 0, "Feed failed");
+
+	zassert_equal(audio_pipeline_process(nodes, ARRAY_SIZE(nodes),
+					     (void **)&block, &size), 0,
+		      "Pipeline failed");
+	zassert_equal(size, BLOCK_SIZE, "Size changed");
+	zassert_equal(block[0], 200, "Wrong output %d", block[0]);
+	zassert_equal(block[BLOCK_SAMPLES - 1], 200, "Wrong output");
+
+	audio_block_unref(&test_pool, block);
+	zassert_equal(k_mem_slab_num_used_get(test_pool.slab), 0,
+		      "Blocks leaked");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(audio_stream,
+			 ztest_unit_test(test_block_refs),
+			 ztest_unit_test(test_mix_saturation),
+			 ztest_unit_test(test_gain),
+			 ztest_unit_test(test_resample),
+			 ztest_unit_test(test_pipeline));
+	ztest_run_test_suite(audio_stream);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <canbus/isotp.h>
+#include <ztest.h>
+#include <string.h>
+
+/*
+ * @addtogroup t_can_isotp
+ * @{
+ * @defgroup t_isotp_loopback test_isotp_loopback
+ * @brief TestPurpose: verify ISO-TP segmentation and reassembly
+ * @details
+ * - Test Steps
+ *   -# Set the CAN driver to loopback mode
+ *   -# Send and receive a single frame
+ *   -# Send and receive a message without block size limit
+ *   -# Send and receive a message with flow control every block
+ *   -# Receive a message as a chain of buffers
+ *   -# Send a message without a receiver
+ * - Expected Results
+ *   -# All tests MUST pass
+ * @}
+ */
+
+#if defined(CONFIG_CAN_LOOPBACK_DEV_NAME)
+#define CAN_DEVICE_NAME CONFIG_CAN_LOOPBACK_DEV_NAME
+#elif defined(DT_CAN_1_NAME)
+#define CAN_DEVICE_NAME DT_CAN_1_NAME
+#else
+#define CAN_DEVICE_NAME ""
+#endif
+
+#define TEST_RECEIVE_TIMEOUT K_MSEC(500)
+#define TEST_MSG_LEN         200
+
+static const struct isotp_msg_id rx_addr = {
+	.std_id = 0x10,
+	.id_type = CAN_STANDARD_IDENTIFIER,
+	.use_ext_addr = 0
+};
+
+static const struct isotp_msg_id tx_addr = {
+	.std_id = 0x11,
+	.id_type = CAN_STANDARD_IDENTIFIER,
+	.use_ext_addr = 0
+};
+
+static struct isotp_send_ctx send_ctx;
+static struct isotp_recv_ctx recv_ctx;
+static struct device *can_dev;
+static u8_t test_data[TEST_MSG_LEN];
+static u8_t rx_data[TEST_MSG_LEN];
+static struct k_sem send_sem;
+static int send_result;
+
+static void send_complete_cb(int error_nr, void *arg)
+{
+	ARG_UNUSED(arg);
+
+	send_result = error_nr;
+	k_sem_give(&send_sem);
+}
+
+static void send_receive(size_t len, const struct isotp_fc_opts *opts)
+{
+	int ret;
+
+	ret = isotp_bind(&recv_ctx, can_dev, &rx_addr, &tx_addr, opts);
+	zassert_equal(ret, ISOTP_N_OK, "Can't bind (%d)", ret);
+
+	ret = isotp_send(&send_ctx, can_dev, test_data, len, &rx_addr,
+			 &tx_addr, send_complete_cb, NULL);
+	zassert_equal(ret, ISOTP_N_OK, "Can't send (%d)", ret);
+
+	ret = k_sem_take(&send_sem, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(ret, 0, "Send not completed");
+	zassert_equal(send_result, ISOTP_N_OK, "Send failed (%d)",
+		      send_result);
+
+	(void)memset(rx_data, 0, sizeof(rx_data));
+	ret = isotp_recv(&recv_ctx, rx_data, sizeof(rx_data),
+			 TEST_RECEIVE_TIMEOUT);
+	zassert_equal(ret, len, "Received %d bytes, expected %u", ret,
+		      (unsigned int)len);
+	zassert_equal(memcmp(rx_data, test_data, len), 0, "Data differs");
+
+	isotp_unbind(&recv_ctx);
+}
+
+static void test_set_loopback(void)
+{
+	int ret;
+
+	ret = can_configure(can_dev, CAN_LOOPBACK_MODE, 0);
+	zassert_equal(ret, 0, "Can't set loopback-mode. Err: %d", ret);
+}
+
+static void test_single_frame(void)
+{
+	const struct isotp_fc_opts opts = { .bs = 0, .stmin = 0 };
+
+	send_receive(7, &opts);
+}
+
+static void test_multi_frame(void)
+{
+	const struct isotp_fc_opts opts = { .bs = 0, .stmin = 0 };
+
+	send_receive(TEST_MSG_LEN, &opts);
+}
+
+static void test_multi_frame_blocks(void)
+{
+	const struct isotp_fc_opts opts = { .bs = 4, .stmin = 1 };
+
+	send_receive(TEST_MSG_LEN, &opts);
+}
+
+static void test_recv_net(void)
+{
+	const struct isotp_fc_opts opts = { .bs = 8, .stmin = 0 };
+	struct net_buf *buf, *frag;
+	size_t pos = 0;
+	int ret;
+
+	ret = isotp_bind(&recv_ctx, can_dev, &rx_addr, &tx_addr, &opts);
+	zassert_equal(ret, ISOTP_N_OK, "Can't bind (%d)", ret);
+
+	ret = isotp_send(&send_ctx, can_dev, test_data, TEST_MSG_LEN,
+			 &rx_addr, &tx_addr, NULL, NULL);
+	zassert_equal(ret, ISOTP_N_OK, "Send failed (%d)", ret);
+
+	ret = isotp_recv_net(&recv_ctx, &buf, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(ret, TEST_MSG_LEN, "Received %d bytes", ret);
+
+	for (frag = buf; frag; frag = frag->frags) {
+		zassert_true(pos + frag->len <= TEST_MSG_LEN, "Too long");
+		zassert_equal(memcmp(frag->data, &test_data[pos], frag->len),
+			      0, "Data differs at %u",
+			      (unsigned int)pos);
+		pos += frag->len;
+	}
+
+	zassert_equal(pos, TEST_MSG_LEN, "Chain length %u",
+		      (unsigned int)pos);
+
+	net_buf_unref(buf);
+	isotp_unbind(&recv_ctx);
+}
+
+static void test_no_receiver(void)
+{
+	int ret;
+
+	ret = isotp_send(&send_ctx, can_dev, test_data, TEST_MSG_LEN,
+			 &rx_addr, &tx_addr, NULL, NULL);
+	zassert_equal(ret, ISOTP_N_TIMEOUT_BS, "Unexpected result (%d)", ret);
+}
+
+void test_main(void)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = i;
+	}
+
+	k_sem_init(&send_sem, 0, 1);
+	can_dev = device_get_binding(CAN_DEVICE_NAME);
+	zassert_not_null(can_dev, "Device not found");
+
+	ztest_test_suite(isotp,
+			 ztest_unit_test(test_set_loopback),
+			 ztest_unit_test(test_single_frame),
+			 ztest_unit_test(test_multi_frame),
+			 ztest_unit_test(test_multi_frame_blocks),
+			 ztest_unit_test(test_recv_net),
+			 ztest_unit_test(test_no_receiver));
+	ztest_run_test_suite(isotp);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <debug/stack_monitor.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define STACK_USED 512
+
+static K_THREAD_STACK_DEFINE(test_stack, STACK_SIZE);
+static struct k_thread test_thread;
+
+static struct stack_monitor_info found;
+static bool found_alive;
+
+static void stack_user(void *p1, void *p2, void *p3)
+{
+	volatile char buf[STACK_USED];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	(void)memset((char *)buf, 0x55, sizeof(buf));
+}
+
+static void find_thread(const struct stack_monitor_info *info,
+			void *user_data)
+{
+	if (info->thread == user_data) {
+		found = *info;
+		found_alive = true;
+	}
+}
+
+static void lookup(void)
+{
+	found_alive = false;
+	stack_monitor_foreach(find_thread, &test_thread);
+}
+
+/**
+ * @brief Test that the high-water mark of a thread is recorded
+ *
+ * The mark must cover the stack used by the thread, outlive the thread,
+ * and give a recommended size between the mark and the stack size.
+ */
+static void test_stack_monitor_high_water(void)
+{
+	size_t size;
+
+	k_thread_create(&test_thread, test_stack, STACK_SIZE,
+			stack_user, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_FOREVER);
+	k_thread_name_set(&test_thread, "stack_user");
+
+	stack_monitor_sample();
+	lookup();
+	zassert_true(found_alive, "new thread not monitored");
+	zassert_true(found.max_used < STACK_USED, "unexpected usage");
+
+	k_thread_start(&test_thread);
+	k_sleep(100);
+
+	stack_monitor_sample();
+	lookup();
+	zassert_true(found_alive, "exited thread not kept");
+	zassert_false(found.alive, "exited thread reported alive");
+	zassert_true(found.max_used >= STACK_USED, "usage not recorded");
+	if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+		zassert_equal(strcmp(found.name, "stack_user"), 0,
+			      "wrong name");
+	}
+
+	size = stack_monitor_recommended_size(&found);
+	zassert_true(size >= found.max_used, "recommended size too small");
+	zassert_true(size <= found.size, "recommended size too large");
+	zassert_equal(size % 16, 0, "recommended size not rounded");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(stack_monitor,
+			 ztest_unit_test(test_stack_monitor_high_water));
+	ztest_run_test_suite(stack_monitor);
+}
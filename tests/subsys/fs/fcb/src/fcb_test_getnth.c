@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+void fcb_test_getnth(void)
+{
+	const int ENTRIES = 100;
+	struct fcb *fcb;
+	int rc;
+	int i;
+	struct fcb_entry loc;
+	struct fcb_entry first;
+	u8_t test_data[128];
+
+	fcb = &test_fcb;
+
+	rc = fcb_getnth(fcb, 0, &loc);
+	zassert_true(rc == FCB_ERR_NOVAR, "fcb_getnth on an empty fcb");
+
+	/* enough entries to span several sectors */
+	for (i = 0; i < ENTRIES; i++) {
+		rc = fcb_append(fcb, sizeof(test_data), &loc);
+		if (rc == FCB_ERR_NOSPACE) {
+			break;
+		}
+		zassert_true(rc == 0, "fcb_append call failure");
+
+		(void)memset(test_data, i, sizeof(test_data));
+		rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc),
+				      test_data, sizeof(test_data));
+		zassert_true(rc == 0, "flash_area_write call failure");
+
+		rc = fcb_append_finish(fcb, &loc);
+		zassert_true(rc == 0, "fcb_append_finish call failure");
+	}
+	zassert_true(i > 1, "no entries appended");
+
+	/* each entry found by fcb_getnth is the one found by walking */
+	(void)memset(&first, 0, sizeof(first));
+	for (i = 0; !fcb_getnext(fcb, &first); i++) {
+		rc = fcb_getnth(fcb, i, &loc);
+		zassert_true(rc == 0, "fcb_getnth call failure");
+		zassert_true(loc.fe_sector == first.fe_sector &&
+			     loc.fe_elem_off == first.fe_elem_off &&
+			     loc.fe_data_len == first.fe_data_len,
+			     "fcb_getnth: fetched wrong location");
+	}
+
+	rc = fcb_getnth(fcb, i, &loc);
+	zassert_true(rc == FCB_ERR_NOVAR, "fcb_getnth past the last entry");
+}
@@ -19,6 +19,7 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <ztest.h>
 #include <json.h>
 #include <zephyr/jwt.h>
@@ -57,10 +58,88 @@ void test_jwt(void)
 	printk("len: %zd\n", jwt_payload_len(&build));
 }
 
+void test_jwt_signer(void)
+{
+	static char buf[460], ref[460];
+	struct jwt_builder build;
+	struct jwt_signer signer;
+	int res;
+
+	res = jwt_signer_init(&signer, jwt_test_private_der,
+			      jwt_test_private_der_len);
+	zassert_equal(res, 0, "Setting up signer");
+	zassert_equal(jwt_signer_precompute(&signer), 0, "Precomputing");
+
+	jwt_init_builder(&build, ref, sizeof(ref));
+	jwt_add_payload(&build, 1530312026, 1530308426, "iot-work-199419");
+	res = jwt_sign(&build, jwt_test_private_der, jwt_test_private_der_len);
+	zassert_equal(res, 0, "Signing payload");
+
+	/* RS256 signatures are deterministic */
+	jwt_init_builder(&build, buf, sizeof(buf));
+	jwt_add_payload(&build, 1530312026, 1530308426, "iot-work-199419");
+	res = jwt_signer_sign(&signer, &build);
+	zassert_equal(res, 0, "Signing payload with signer");
+	zassert_equal(strcmp(buf, ref), 0, "Tokens differ");
+
+	jwt_signer_free(&signer);
+}
+
+void test_jwt_cache(void)
+{
+	static char buf[460], first[460];
+	struct jwt_signer signer;
+	struct jwt_cache cache;
+	int res;
+
+	res = jwt_signer_init(&signer, jwt_test_private_der,
+			      jwt_test_private_der_len);
+	zassert_equal(res, 0, "Setting up signer");
+
+	jwt_cache_init(&cache, buf, sizeof(buf));
+
+	res = jwt_cache_get(&cache, &signer, 1000, 3600, "iot-work-199419");
+	zassert_equal(res, 0, "Getting token");
+	zassert_equal(cache.exp, 4600, NULL);
+	zassert_equal(cache.len, strlen(buf), NULL);
+	strcpy(first, buf);
+
+	/* Still valid, reused */
+	res = jwt_cache_get(&cache, &signer, 2000, 3600, "iot-work-199419");
+	zassert_equal(res, 0, "Getting cached token");
+	zassert_equal(cache.exp, 4600, "Token not reused");
+	zassert_equal(strcmp(buf, first), 0, NULL);
+
+	/* Expiring soon, replaced */
+	res = jwt_cache_get(&cache, &signer, 4600 - CONFIG_JWT_CACHE_MARGIN,
+			    3600, "iot-work-199419");
+	zassert_equal(res, 0, "Renewing token");
+	zassert_equal(cache.exp, 8200 - CONFIG_JWT_CACHE_MARGIN, NULL);
+	zassert_not_equal(strcmp(buf, first), 0, "Token not renewed");
+
+	/* Another audience, replaced */
+	res = jwt_cache_get(&cache, &signer, 4600 - CONFIG_JWT_CACHE_MARGIN,
+			    3600, "iot-work-2");
+	zassert_equal(res, 0, "Getting token");
+	zassert_equal(strcmp(cache.aud, "iot-work-2"), 0, NULL);
+
+	/* Invalidated, replaced */
+	strcpy(first, buf);
+	jwt_cache_invalidate(&cache);
+	res = jwt_cache_get(&cache, &signer, 5000, 3600, "iot-work-2");
+	zassert_equal(res, 0, "Getting token");
+	zassert_equal(cache.exp, 8600, NULL);
+	zassert_not_equal(strcmp(buf, first), 0, "Token not renewed");
+
+	jwt_signer_free(&signer);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_jwt_test,
-		ztest_unit_test(test_jwt));
+		ztest_unit_test(test_jwt),
+		ztest_unit_test(test_jwt_signer),
+		ztest_unit_test(test_jwt_cache));
 
 	ztest_run_test_suite(lib_jwt_test);
 }
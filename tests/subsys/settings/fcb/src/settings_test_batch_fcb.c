@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "settings_test.h"
+#include "settings/settings_fcb.h"
+
+#ifdef CONFIG_SETTINGS_BATCH
+void test_config_batch_fcb(void)
+{
+	int rc;
+	u8_t val;
+	struct settings_fcb cf;
+
+	config_wipe_srcs();
+	config_wipe_fcb(fcb_sectors, ARRAY_SIZE(fcb_sectors));
+
+	cf.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC;
+	cf.cf_fcb.f_sectors = fcb_sectors;
+	cf.cf_fcb.f_sector_cnt = ARRAY_SIZE(fcb_sectors);
+
+	rc = settings_fcb_src(&cf);
+	zassert_true(rc == 0, "can't register FCB as configuration source");
+
+	rc = settings_fcb_dst(&cf);
+	zassert_true(rc == 0,
+		     "can't register FCB as configuration destination");
+
+	val = 1U;
+	rc = settings_save_one("myfoo/mybar", &val, sizeof(val));
+	zassert_true(rc == 0, "fcb write error");
+
+	rc = settings_batch_begin();
+	zassert_true(rc == 0, "can't begin batch");
+
+	for (val = 2U; val < 10U; val++) {
+		rc = settings_save_one("myfoo/mybar", &val, sizeof(val));
+		zassert_true(rc == 0, "batch write error");
+	}
+
+	val8 = 0U;
+	rc = settings_load();
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val8 == 1U, "value of the batch written before commit");
+
+	rc = settings_batch_commit();
+	zassert_true(rc == 0, "can't commit batch");
+
+	rc = settings_load();
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val8 == 9U, "bad value read");
+
+	rc = settings_batch_begin();
+	zassert_true(rc == 0, "can't begin batch");
+
+	rc = settings_delete("myfoo/mybar");
+	zassert_true(rc == 0, "batch delete error");
+
+	settings_batch_abort();
+
+	val8 = 0U;
+	rc = settings_load();
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val8 == 9U, "aborted batch written");
+}
+#endif
@@ -356,6 +356,8 @@ void test_config_compress_deleted(void);
 void test_setting_raw_read(void);
 void test_setting_val_read(void);
 void test_config_save_fcb_unaligned(void);
+void test_config_load_subtree_fcb(void);
+void test_config_batch_fcb(void);
 
 void test_main(void)
 {
@@ -382,7 +384,11 @@ void test_main(void)
 			 ztest_unit_test(test_config_save_3_fcb),
 			 ztest_unit_test(test_config_compress_reset),
 			 ztest_unit_test(test_config_save_one_fcb),
-			 ztest_unit_test(test_config_compress_deleted)
+			 ztest_unit_test(test_config_compress_deleted),
+#ifdef CONFIG_SETTINGS_BATCH
+			 ztest_unit_test(test_config_batch_fcb),
+#endif
+			 ztest_unit_test(test_config_load_subtree_fcb)
 			);
 
 	ztest_run_test_suite(test_config_fcb);
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "settings_test.h"
+#include "settings/settings_fcb.h"
+
+void test_config_load_subtree_fcb(void)
+{
+	int rc;
+	struct settings_fcb cf;
+
+	config_wipe_srcs();
+	config_wipe_fcb(fcb_sectors, ARRAY_SIZE(fcb_sectors));
+
+	cf.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC;
+	cf.cf_fcb.f_sectors = fcb_sectors;
+	cf.cf_fcb.f_sector_cnt = ARRAY_SIZE(fcb_sectors);
+
+	rc = settings_fcb_src(&cf);
+	zassert_true(rc == 0, "can't register FCB as configuration source");
+
+	rc = settings_fcb_dst(&cf);
+	zassert_true(rc == 0,
+		     "can't register FCB as configuration destination");
+
+	val8 = 33U;
+	rc = settings_save();
+	zassert_true(rc == 0, "fcb write error");
+
+	val8 = 34U;
+	rc = settings_save();
+	zassert_true(rc == 0, "fcb write error");
+
+	val8 = 0U;
+	ctest_clear_call_state();
+
+	rc = settings_load_subtree("2nd");
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val8 == 0U, "value of another subtree loaded");
+	zassert_true(test_set_called == 0, "handler of another subtree set");
+	zassert_true(test_commit_called == 0,
+		     "handler of another subtree committed");
+
+	rc = settings_load_subtree("myfoo");
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val8 == 34U, "bad value read");
+	zassert_true(test_commit_called == 1, "commit not called");
+}
@@ -22,6 +22,42 @@ void test_crc32_ieee(void)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4, NULL);
 }
 
+static u32_t crc32_ieee_bitwise(u32_t crc, const u8_t *data, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0; i < len; i++) {
+		crc = crc ^ data[i];
+
+		for (u8_t j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+		}
+	}
+
+	return (~crc);
+}
+
+void test_crc32_ieee_update(void)
+{
+	u8_t data[259];
+	u32_t crc;
+	size_t i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = (u8_t)(i * 31U + 7U);
+	}
+
+	/* every length and offset of the word and table paths */
+	for (i = 0; i < 40; i++) {
+		zassert_equal(crc32_ieee(data + i % 8, sizeof(data) - i),
+			      crc32_ieee_bitwise(0, data + i % 8,
+						 sizeof(data) - i), NULL);
+	}
+
+	crc = crc32_ieee_update(0, data, 13);
+	crc = crc32_ieee_update(crc, data + 13, sizeof(data) - 13);
+	zassert_equal(crc, crc32_ieee(data, sizeof(data)), NULL);
+}
+
 void test_crc16(void)
 {
 	u8_t test0[] = { };
@@ -34,6 +70,10 @@ void test_crc16(void)
 		      0x9479, NULL);
 	zassert_equal(crc16(test2, sizeof(test2), 0x1021, 0xffff, true),
 		      0xe5cc, NULL);
+	zassert_equal(crc16(test2, sizeof(test2), 0x1021, 0, true),
+		      crc16_itu_t(0, test2, sizeof(test2)), NULL);
+	zassert_equal(crc16(test2, sizeof(test2), 0x1021, 0xffff, false),
+		      0xa69d, NULL);
 }
 
 void test_crc16_ansi(void)
@@ -125,6 +165,7 @@ void test_main(void)
 {
 	ztest_test_suite(test_crc,
 			 ztest_unit_test(test_crc32_ieee),
+			 ztest_unit_test(test_crc32_ieee_update),
 			 ztest_unit_test(test_crc16),
 			 ztest_unit_test(test_crc16_ansi),
 			 ztest_unit_test(test_crc16_ccitt),
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <ztest_benchmark.h>
+
+#define ITERATIONS 100
+
+ZTEST_BENCHMARK_DEFINE(busy_loop, 4, ITERATIONS);
+
+static void test_stats(void)
+{
+	u32_t samples[ITERATIONS];
+	struct ztest_benchmark_stats stats;
+	u32_t i;
+
+	/* 100 down to 1, in reverse order to exercise the sorting */
+	for (i = 0U; i < ITERATIONS; i++) {
+		samples[i] = ITERATIONS - i;
+	}
+
+	ztest_benchmark_stats_compute(samples, ITERATIONS, &stats);
+
+	zassert_equal(stats.iterations, ITERATIONS, NULL);
+	zassert_equal(stats.min, 1, NULL);
+	zassert_equal(stats.max, 100, NULL);
+	zassert_equal(stats.mean, 51, "mean of 50.5 not rounded");
+	zassert_equal(stats.p50, 50, NULL);
+	zassert_equal(stats.p99, 99, NULL);
+	/* sqrt((100^2 - 1) / 12) = 28.87 */
+	zassert_equal(stats.stddev, 28, NULL);
+
+	for (i = 1U; i < ITERATIONS; i++) {
+		zassert_true(samples[i - 1] <= samples[i], "not sorted");
+	}
+}
+
+static void test_stats_constant(void)
+{
+	u32_t samples[] = { 7, 7, 7 };
+	struct ztest_benchmark_stats stats;
+
+	ztest_benchmark_stats_compute(samples, ARRAY_SIZE(samples), &stats);
+
+	zassert_equal(stats.mean, 7, NULL);
+	zassert_equal(stats.p50, 7, NULL);
+	zassert_equal(stats.p99, 7, NULL);
+	zassert_equal(stats.stddev, 0, NULL);
+
+	ztest_benchmark_stats_compute(samples, 0, &stats);
+	zassert_equal(stats.iterations, 0, NULL);
+	zassert_equal(stats.max, 0, NULL);
+}
+
+static void busy(void *arg)
+{
+	volatile u32_t *n = arg;
+	u32_t i;
+
+	for (i = 0U; i < 100U; i++) {
+		(*n)++;
+	}
+}
+
+static void test_run(void)
+{
+	struct ztest_benchmark_stats stats;
+	volatile u32_t n = 0U;
+
+	ztest_benchmark_run(&busy_loop, busy, (void *)&n, &stats);
+
+	zassert_equal(n, 100 * (4 + ITERATIONS), "warmup or runs missing");
+	zassert_equal(stats.iterations, ITERATIONS, NULL);
+	zassert_true(stats.min <= stats.p50 && stats.p50 <= stats.p99 &&
+		     stats.p99 <= stats.max, "inconsistent statistics");
+	zassert_not_equal(ztest_benchmark_cycles_per_sec(), 0, NULL);
+
+	ztest_benchmark_format_set(ZTEST_BENCHMARK_CSV);
+	ztest_benchmark_report("busy_loop", &stats);
+	ztest_benchmark_format_set(ZTEST_BENCHMARK_JSON);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(framework_benchmark,
+			 ztest_unit_test(test_stats),
+			 ztest_unit_test(test_stats_constant),
+			 ztest_unit_test(test_run));
+
+	ztest_run_test_suite(framework_benchmark);
+}